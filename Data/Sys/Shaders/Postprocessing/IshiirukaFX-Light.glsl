@@ -712,6 +712,7 @@ EntryPoint = AmbientOcclusion
 DependantOption = A_SSAO_ENABLED
 DependantOption = A_SSGI_ENABLED
 OutputScale = 0.5
+MinOutputScale = 0.25
 Input0=ColorBuffer
 Input0Filter=Linear
 Input0Mode=Clamp
@@ -723,6 +724,7 @@ EntryPoint = AOBlur
 DependantOption = A_SSAO_ENABLED
 DependantOption = A_SSGI_ENABLED
 OutputScale = 0.5
+MinOutputScale = 0.25
 Input0=PreviousPass
 Input0Filter=Linear
 Input0Mode=Clamp
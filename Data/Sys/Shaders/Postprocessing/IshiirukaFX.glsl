@@ -708,6 +708,7 @@ DependentOption = A_FXAA_PASS
 EntryPoint = AmbientOcclusion
 DependantOption = A_SSAO_ENABLED
 DependantOption = A_SSGI_ENABLED
+MinOutputScale = 0.5
 Input0=ColorBuffer
 Input0Filter=Linear
 Input0Mode=Clamp
@@ -718,6 +719,7 @@ Input1Mode=Clamp
 EntryPoint = AOBlur
 DependantOption = A_SSAO_ENABLED
 DependantOption = A_SSGI_ENABLED
+MinOutputScale = 0.5
 Input0=PreviousPass
 Input0Filter=Linear
 Input0Mode=Clamp
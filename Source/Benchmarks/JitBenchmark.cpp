@@ -0,0 +1,372 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Replays an input movie on each CPU core, without drawing or audio, and reports how fast each
+// core emulates and what its JIT did meanwhile.
+
+#include <OptionParser.h>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <picojson/picojson.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Flag.h"
+#include "Common/StringUtil.h"
+#include "Common/Version.h"
+
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/SystemTimers.h"
+#include "Core/Host.h"
+#include "Core/Movie.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#include "UICommon/CommandLineParse.h"
+#include "UICommon/UICommon.h"
+
+static Common::Flag s_running{true};
+
+void Host_NotifyMapLoaded()
+{
+}
+void Host_RefreshDSPDebuggerWindow()
+{
+}
+void Host_Message(int id)
+{
+  if (id == WM_USER_STOP)
+    s_running.Clear();
+}
+void* Host_GetRenderHandle()
+{
+  return nullptr;
+}
+void Host_UpdateTitle(const std::string&)
+{
+}
+void Host_UpdateDisasmDialog()
+{
+}
+void Host_UpdateMainFrame()
+{
+}
+void Host_RequestRenderWindowSize(int, int)
+{
+}
+bool Host_UINeedsControllerState()
+{
+  return false;
+}
+bool Host_RendererHasFocus()
+{
+  return false;
+}
+bool Host_RendererIsFullscreen()
+{
+  return false;
+}
+void Host_ShowVideoConfig(void*, const std::string&)
+{
+}
+void Host_YieldToUI()
+{
+}
+void Host_UpdateProgressDialog(const char*, int, int)
+{
+}
+
+namespace
+{
+struct CoreName
+{
+  PowerPC::CPUCore core;
+  const char* name;
+};
+
+const CoreName CORE_NAMES[] = {
+    {PowerPC::CORE_INTERPRETER, "interpreter"},
+    {PowerPC::CORE_CACHEDINTERPRETER, "cachedinterpreter"},
+    {PowerPC::CORE_JIT64, "jit64"},
+    {PowerPC::CORE_JITARM64, "jitarm64"},
+};
+
+struct Snapshot
+{
+  u64 frame = 0;
+  u64 ticks = 0;
+  JitStats jit;
+  std::chrono::steady_clock::time_point time;
+};
+
+struct CoreResult
+{
+  std::string name;
+  u64 frames = 0;
+  double seconds = 0.0;
+  u64 cycles = 0;
+  u32 ticks_per_second = 1;
+  // The counters during the measured frames, except live_blocks, which is at the end.
+  JitStats jit;
+};
+
+Snapshot TakeSnapshot()
+{
+  Snapshot snapshot;
+  Core::RunAsCPUThread([&snapshot] {
+    snapshot.frame = Movie::GetCurrentFrame();
+    snapshot.ticks = CoreTiming::GetTicks();
+    JitInterface::GetStats(&snapshot.jit);
+  });
+  snapshot.time = std::chrono::steady_clock::now();
+  return snapshot;
+}
+
+template <typename Predicate>
+bool WaitUntil(Predicate done)
+{
+  while (s_running.IsSet() && !done())
+  {
+    Core::HostDispatchJobs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return s_running.IsSet();
+}
+
+// Measures from the first frame after booting, so booting and loading the savestate don't count.
+bool RunCore(PowerPC::CPUCore core, const std::string& game, const std::string& movie,
+             const std::optional<std::string>& savestate, u64 frames, CoreResult* result)
+{
+  std::optional<std::string> movie_savestate;
+  if (!Movie::PlayInput(movie, &movie_savestate))
+  {
+    fprintf(stderr, "Could not play the movie %s\n", movie.c_str());
+    return false;
+  }
+  std::unique_ptr<BootParameters> boot =
+      BootParameters::GenerateFromFile(game, savestate ? savestate : movie_savestate);
+
+  // Movies can carry the CPU core they were recorded with, the one measured wins.
+  SConfig::GetInstance().iCPUCore = core;
+  Config::SetCurrent(Config::MAIN_CPU_CORE, static_cast<int>(core));
+
+  s_running.Set();
+  if (!boot || !BootManager::BootCore(std::move(boot)))
+  {
+    fprintf(stderr, "Could not boot %s\n", game.c_str());
+    Movie::EndPlayInput(false);
+    return false;
+  }
+
+  bool finished = WaitUntil([] { return Core::IsRunning(); });
+  const u64 boot_frame = Movie::GetCurrentFrame();
+  finished = finished && WaitUntil([boot_frame] { return Movie::GetCurrentFrame() > boot_frame; });
+  if (finished)
+  {
+    const Snapshot start = TakeSnapshot();
+    const u64 end_frame = frames ? start.frame + frames : UINT64_MAX;
+    WaitUntil([end_frame] {
+      return Movie::GetCurrentFrame() >= end_frame || !Movie::IsPlayingInput();
+    });
+    if (Core::IsRunning())
+    {
+      const Snapshot end = TakeSnapshot();
+      Core::RunAsCPUThread([result] {
+        result->name = PowerPC::GetCPUName();
+        result->ticks_per_second = SystemTimers::GetTicksPerSecond();
+      });
+      result->frames = end.frame - start.frame;
+      result->seconds = std::chrono::duration<double>(end.time - start.time).count();
+      result->cycles = end.ticks - start.ticks;
+      result->jit.compile_time_ns = end.jit.compile_time_ns - start.jit.compile_time_ns;
+      result->jit.blocks_compiled = end.jit.blocks_compiled - start.jit.blocks_compiled;
+      result->jit.blocks_invalidated = end.jit.blocks_invalidated - start.jit.blocks_invalidated;
+      result->jit.cache_clears = end.jit.cache_clears - start.jit.cache_clears;
+      result->jit.slow_lookups = end.jit.slow_lookups - start.jit.slow_lookups;
+      result->jit.live_blocks = end.jit.live_blocks;
+    }
+    else
+    {
+      finished = false;
+    }
+  }
+
+  Core::Stop();
+  Core::Shutdown();
+  if (!finished)
+    fprintf(stderr, "The emulation stopped before the movie was played\n");
+  return finished;
+}
+
+void PrintResults(const std::vector<CoreResult>& results)
+{
+  printf("%-20s %8s %14s %8s %12s %10s %12s %8s %14s %10s\n", "Core", "Frames", "Cycles/s",
+         "Speed", "Compile ms", "Compiled", "Invalidated", "Clears", "Slow lookups", "Live");
+  for (const CoreResult& result : results)
+  {
+    const double cycles_per_second = result.cycles / std::max(result.seconds, 0.001);
+    printf("%-20s %8" PRIu64 " %14.0f %7.1f%% %12.1f %10" PRIu64 " %12" PRIu64 " %8" PRIu64
+           " %14" PRIu64 " %10" PRIu64 "\n",
+           result.name.c_str(), result.frames, cycles_per_second,
+           cycles_per_second * 100.0 / result.ticks_per_second,
+           result.jit.compile_time_ns / 1000000.0, result.jit.blocks_compiled,
+           result.jit.blocks_invalidated, result.jit.cache_clears, result.jit.slow_lookups,
+           result.jit.live_blocks);
+  }
+}
+
+std::string ToJSON(const std::vector<CoreResult>& results)
+{
+  picojson::array cores;
+  for (const CoreResult& result : results)
+  {
+    picojson::object core;
+    core["name"] = picojson::value(result.name);
+    core["frames"] = picojson::value(static_cast<double>(result.frames));
+    core["seconds"] = picojson::value(result.seconds);
+    core["cycles"] = picojson::value(static_cast<double>(result.cycles));
+    core["cycles_per_second"] =
+        picojson::value(result.cycles / std::max(result.seconds, 0.001));
+    core["compile_time_ms"] = picojson::value(result.jit.compile_time_ns / 1000000.0);
+    core["blocks_compiled"] = picojson::value(static_cast<double>(result.jit.blocks_compiled));
+    core["blocks_invalidated"] =
+        picojson::value(static_cast<double>(result.jit.blocks_invalidated));
+    core["cache_clears"] = picojson::value(static_cast<double>(result.jit.cache_clears));
+    core["slow_lookups"] = picojson::value(static_cast<double>(result.jit.slow_lookups));
+    core["live_blocks"] = picojson::value(static_cast<double>(result.jit.live_blocks));
+    cores.emplace_back(core);
+  }
+
+  picojson::object root;
+  root["revision"] = picojson::value(Common::scm_rev_str);
+  root["cores"] = picojson::value(cores);
+  return picojson::value(root).serialize(true);
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
+  parser->usage("usage: %prog [options] --movie <file> <game>");
+  parser->add_option("--savestate")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Start from this savestate instead of the one the movie starts from, if any");
+  parser->add_option("--frames")
+      .action("store")
+      .type("int")
+      .set_default(0)
+      .help("How many frames of the movie to measure, all of them by default");
+  parser->add_option("--cores")
+      .action("store")
+      .metavar("<core>,...")
+      .type("string")
+      .help("Which of interpreter, cachedinterpreter, jit64 and jitarm64 to measure, every one "
+            "the host supports by default");
+  parser->add_option("--json")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Also write the results to <file> as JSON");
+  optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
+  const std::vector<std::string> args = parser->args();
+
+  std::string game;
+  if (options.is_set("exec"))
+    game = static_cast<const char*>(options.get("exec"));
+  else if (!args.empty())
+    game = args.front();
+  if (game.empty() || !options.is_set("movie"))
+  {
+    parser->print_help();
+    return 1;
+  }
+  const std::string movie = static_cast<const char*>(options.get("movie"));
+  std::optional<std::string> savestate;
+  if (options.is_set("savestate"))
+    savestate = std::string(static_cast<const char*>(options.get("savestate")));
+  const u64 frames = std::max(static_cast<int>(options.get("frames")), 0);
+
+  const std::vector<PowerPC::CPUCore>& available = PowerPC::AvailableCPUCores();
+  std::vector<PowerPC::CPUCore> cores;
+  if (options.is_set("cores"))
+  {
+    for (const std::string& name :
+         SplitString(static_cast<const char*>(options.get("cores")), ','))
+    {
+      const auto it = std::find_if(std::begin(CORE_NAMES), std::end(CORE_NAMES),
+                                   [&name](const CoreName& core) { return name == core.name; });
+      if (it == std::end(CORE_NAMES) ||
+          std::find(available.begin(), available.end(), it->core) == available.end())
+      {
+        fprintf(stderr, "Unknown or unsupported CPU core %s\n", name.c_str());
+        return 1;
+      }
+      cores.push_back(it->core);
+    }
+  }
+  else
+  {
+    cores = available;
+  }
+
+  UICommon::SetUserDirectory(
+      options.is_set("user") ? static_cast<const char*>(options.get("user")) : "");
+  UICommon::Init();
+  Core::SetOnStateChangedCallback([](Core::State state) {
+    if (state == Core::State::Uninitialized)
+      s_running.Clear();
+  });
+
+  // Only the CPU is measured. The emulation runs as fast as it can, and stays paused at the end
+  // of the movie. Restored before the settings are saved on shutdown.
+  const std::string audio_backend = SConfig::GetInstance().sBackend;
+  const bool pause_movie = SConfig::GetInstance().m_PauseMovie;
+  SConfig::GetInstance().sBackend = BACKEND_NULLSOUND;
+  SConfig::GetInstance().m_PauseMovie = true;
+  Config::SetCurrent(Config::GFX_HACK_SKIP_DRAWING, true);
+  Core::SetIsCatchingUp(true);
+
+  std::vector<CoreResult> results;
+  for (PowerPC::CPUCore core : cores)
+  {
+    CoreResult result;
+    if (!RunCore(core, game, movie, savestate, frames, &result))
+      break;
+    results.push_back(std::move(result));
+  }
+
+  Core::SetIsCatchingUp(false);
+  SConfig::GetInstance().sBackend = audio_backend;
+  SConfig::GetInstance().m_PauseMovie = pause_movie;
+  UICommon::Shutdown();
+
+  PrintResults(results);
+  if (options.is_set("json"))
+  {
+    const std::string path = static_cast<const char*>(options.get("json"));
+    if (!File::WriteStringToFile(ToJSON(results), path))
+    {
+      fprintf(stderr, "Could not write %s\n", path.c_str());
+      return 1;
+    }
+  }
+  return results.size() == cores.size() ? 0 : 1;
+}
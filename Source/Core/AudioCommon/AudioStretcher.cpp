@@ -12,7 +12,8 @@
 
 namespace AudioCommon
 {
-AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_rate)
+AudioStretcher::AudioStretcher(unsigned int sample_rate)
+    : m_sample_rate(sample_rate), m_wsola(sample_rate)
 {
   m_sound_touch.setChannels(2);
   m_sound_touch.setSampleRate(sample_rate);
@@ -27,10 +28,18 @@ AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_
 void AudioStretcher::Clear()
 {
   m_sound_touch.clear();
+  m_wsola.Clear();
 }
 
 void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out)
 {
+  const bool use_wsola = SConfig::GetInstance().m_audio_stretch_wsola;
+  if (use_wsola != m_use_wsola)
+  {
+    Clear();
+    m_use_wsola = use_wsola;
+  }
+
   const double time_delta = static_cast<double>(num_out) / m_sample_rate;  // seconds
 
   // We were given actual_samples number of samples, and num_samples were requested from us.
@@ -38,7 +47,8 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
 
   const double max_latency = SConfig::GetInstance().m_audio_stretch_max_latency;
   const double max_backlog = m_sample_rate * max_latency / 1000.0 / m_stretch_ratio;
-  const double backlog_fullness = m_sound_touch.numSamples() / max_backlog;
+  const unsigned int backlog = m_use_wsola ? m_wsola.NumSamples() : m_sound_touch.numSamples();
+  const double backlog_fullness = backlog / max_backlog;
   if (backlog_fullness > 5.0)
   {
     // Too many samples in backlog: Don't push anymore on
@@ -60,17 +70,26 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
   // Place a lower limit of 10% speed.  When a game boots up, there will be
   // many silence samples.  These do not need to be timestretched.
   m_stretch_ratio = std::max(m_stretch_ratio, 0.1);
-  m_sound_touch.setTempo(m_stretch_ratio);
 
   DEBUG_LOG(AUDIO, "Audio stretching: samples:%u/%u ratio:%f backlog:%f gain: %f", num_in, num_out,
             m_stretch_ratio, backlog_fullness, lpf_gain);
 
-  m_sound_touch.putSamples(in, num_in);
+  if (m_use_wsola)
+  {
+    m_wsola.SetTempo(m_stretch_ratio);
+    m_wsola.PutSamples(in, num_in);
+  }
+  else
+  {
+    m_sound_touch.setTempo(m_stretch_ratio);
+    m_sound_touch.putSamples(in, num_in);
+  }
 }
 
 void AudioStretcher::GetStretchedSamples(short* out, unsigned int num_out)
 {
-  const size_t samples_received = m_sound_touch.receiveSamples(out, num_out);
+  const size_t samples_received = m_use_wsola ? m_wsola.ReceiveSamples(out, num_out) :
+                                                m_sound_touch.receiveSamples(out, num_out);
 
   if (samples_received != 0)
   {
@@ -8,6 +8,8 @@
 
 #include <soundtouch/SoundTouch.h>
 
+#include "AudioCommon/WSOLAStretcher.h"
+
 namespace AudioCommon
 {
 class AudioStretcher
@@ -22,6 +24,8 @@ private:
   unsigned int m_sample_rate;
   std::array<short, 2> m_last_stretched_sample = {};
   soundtouch::SoundTouch m_sound_touch;
+  WSOLAStretcher m_wsola;
+  bool m_use_wsola = false;
   double m_stretch_ratio = 1.0;
 };
 
@@ -10,11 +10,15 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
-#include <cstring>
 #include <functional>
-#include <numeric>
 #include <vector>
 
+#if defined(_M_X86_64)
+#include <xmmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "AudioCommon/DPL2Decoder.h"
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
@@ -34,41 +38,35 @@ static float l_fwr, r_fwr, lpr_fwr, lmr_fwr;
 static std::vector<float> fwrbuf_l, fwrbuf_r;
 static float adapt_l_gain, adapt_r_gain, adapt_lpr_gain, adapt_lmr_gain;
 static std::vector<float> lf, rf, lr, rr, cf, cr;
-static float LFE_buf[256];
-static unsigned int lfe_pos;
+// The LFE input of the current block, after the last len125 - 1 samples of the previous one.
+static std::vector<float> lfe_history;
 static std::vector<float> filter_coefs_lfe;
 static unsigned int len125;
 
-template <class T>
-static float DotProduct(int count, const T* buf, const std::vector<float>& coeffs, int offset)
+static float DotProduct(const float* a, const float* b, size_t count)
 {
-  return std::inner_product(buf, buf + count, coeffs.begin() + offset, T(0));
-}
-
-template <class T>
-static T FIRFilter(const T* buf, int pos, int len, int count, const std::vector<float>& coeffs)
-{
-  int count1, count2;
-
-  if (pos >= count)
-  {
-    pos -= count;
-    count1 = count;
-    count2 = 0;
-  }
-  else
+  size_t i = 0;
+  float sum = 0.0f;
+#if defined(_M_X86_64)
+  __m128 sum0 = _mm_setzero_ps();
+  __m128 sum1 = _mm_setzero_ps();
+  for (; i + 8 <= count; i += 8)
   {
-    count2 = pos;
-    count1 = count - pos;
-    pos = len - count1;
+    sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
   }
-
-  // high part of window
-  const T* ptr = &buf[pos];
-
-  float r1 = DotProduct(count1, ptr, coeffs, 0);
-  float r2 = DotProduct(count2, buf, coeffs, count1);
-  return T(r1 + r2);
+  alignas(16) float sums[4];
+  _mm_store_ps(sums, _mm_add_ps(sum0, sum1));
+  sum = sums[0] + sums[1] + sums[2] + sums[3];
+#elif defined(_M_ARM_64)
+  float32x4_t sum4 = vdupq_n_f32(0.0f);
+  for (; i + 4 <= count; i += 4)
+    sum4 = vmlaq_f32(sum4, vld1q_f32(a + i), vld1q_f32(b + i));
+  sum = vaddvq_f32(sum4);
+#endif
+  for (; i < count; i++)
+    sum += a[i] * b[i];
+  return sum;
 }
 
 /*
@@ -167,8 +165,7 @@ static void OnSeek()
   std::fill(rr.begin(), rr.end(), 0.0f);
   std::fill(cf.begin(), cf.end(), 0.0f);
   std::fill(cr.begin(), cr.end(), 0.0f);
-  lfe_pos = 0;
-  memset(LFE_buf, 0, sizeof(LFE_buf));
+  std::fill(lfe_history.begin(), lfe_history.end(), 0.0f);
 }
 
 static void Done()
@@ -188,6 +185,9 @@ static std::vector<float> CalculateCoefficients125HzLowpass(int rate)
   {
     coeffs[i] *= M3_01DB;
   }
+  // The filter has always applied the first coefficient to the newest sample and the others from
+  // the oldest sample on. Rotated, they line up with the history from oldest to newest.
+  std::rotate(coeffs.begin(), coeffs.begin() + 1, coeffs.end());
   return coeffs;
 }
 
@@ -307,9 +307,10 @@ void DPL2Decode(float* samples, int numsamples, float* out)
     cf.resize(dlbuflen);
     cr.resize(dlbuflen);
     filter_coefs_lfe = CalculateCoefficients125HzLowpass(fmt_freq);
-    lfe_pos = 0;
-    memset(LFE_buf, 0, sizeof(LFE_buf));
+    lfe_history.assign(len125 - 1, 0.0f);
   }
+  lfe_history.resize(len125 - 1 + numsamples);
+  float* lfe_in = &lfe_history[len125 - 1];
 
   float* in = samples;                           // Input audio data
   float* end = in + numsamples * fmt_nchannels;  // Loop end
@@ -336,13 +337,7 @@ void DPL2Decode(float* samples, int numsamples, float* out)
     out[cur + 0] = lf[k];
     out[cur + 1] = rf[k];
     out[cur + 2] = cf[k];
-    LFE_buf[lfe_pos] = (lf[k] + rf[k] + 2.0f * cf[k] + lr[k] + rr[k]) / 2.0f;
-    out[cur + 3] = FIRFilter(LFE_buf, lfe_pos, len125, len125, filter_coefs_lfe);
-    lfe_pos++;
-    if (lfe_pos == len125)
-    {
-      lfe_pos = 0;
-    }
+    *lfe_in++ = (lf[k] + rf[k] + 2.0f * cf[k] + lr[k] + rr[k]) / 2.0f;
     out[cur + 4] = lr[k];
     out[cur + 5] = rr[k];
     // Next sample...
@@ -354,6 +349,11 @@ void DPL2Decode(float* samples, int numsamples, float* out)
       cyc_pos += dlbuflen;
     }
   }
+
+  // The LFE low-pass runs over the whole block at once, on contiguous samples.
+  for (int i = 0; i < numsamples; i++)
+    out[i * 6 + 3] = DotProduct(&lfe_history[i], filter_coefs_lfe.data(), len125);
+  std::copy(lfe_history.end() - (len125 - 1), lfe_history.end(), lfe_history.begin());
 }
 
 void DPL2Reset()
@@ -0,0 +1,193 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#if defined(__FreeBSD__)
+#define __STDC_CONSTANT_MACROS 1
+#endif
+
+#include "AudioCommon/FLACEncoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+}
+
+#include "Common/Logging/Log.h"
+
+FLACEncoder::~FLACEncoder()
+{
+  Stop();
+}
+
+bool FLACEncoder::Start(const std::string& filename, int sample_rate)
+{
+#if LIBAVFORMAT_VERSION_INT < AV_VERSION_INT(58, 9, 100)
+  av_register_all();
+#endif
+
+  if (avformat_alloc_output_context2(&m_format_context, nullptr, "flac", filename.c_str()) < 0)
+  {
+    ERROR_LOG(AUDIO, "Could not allocate output context for %s", filename.c_str());
+    return false;
+  }
+
+  const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_FLAC);
+  if (!codec)
+  {
+    ERROR_LOG(AUDIO, "Could not find the FLAC encoder");
+    Close();
+    return false;
+  }
+
+  m_codec_context = avcodec_alloc_context3(codec);
+  m_codec_context->sample_fmt = AV_SAMPLE_FMT_S16;
+  m_codec_context->sample_rate = sample_rate;
+  m_codec_context->channels = 2;
+  m_codec_context->channel_layout = AV_CH_LAYOUT_STEREO;
+  m_codec_context->time_base = {1, sample_rate};
+  if (m_format_context->oformat->flags & AVFMT_GLOBALHEADER)
+    m_codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+  if (avcodec_open2(m_codec_context, codec, nullptr) < 0)
+  {
+    ERROR_LOG(AUDIO, "Could not open the FLAC encoder");
+    Close();
+    return false;
+  }
+
+  m_stream = avformat_new_stream(m_format_context, codec);
+  if (!m_stream)
+  {
+    ERROR_LOG(AUDIO, "Could not create stream");
+    Close();
+    return false;
+  }
+  m_stream->time_base = m_codec_context->time_base;
+#if (LIBAVCODEC_VERSION_MICRO >= 100 && LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 33, 100)) ||  \
+    (LIBAVCODEC_VERSION_MICRO < 100 && LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 5, 0))
+  avcodec_parameters_from_context(m_stream->codecpar, m_codec_context);
+#else
+  avcodec_copy_context(m_stream->codec, m_codec_context);
+#endif
+
+  if (avio_open(&m_format_context->pb, filename.c_str(), AVIO_FLAG_WRITE) < 0 ||
+      avformat_write_header(m_format_context, nullptr) < 0)
+  {
+    ERROR_LOG(AUDIO, "Could not open %s", filename.c_str());
+    Close();
+    return false;
+  }
+
+  m_frame = av_frame_alloc();
+  m_frame->format = m_codec_context->sample_fmt;
+  m_frame->channel_layout = m_codec_context->channel_layout;
+  m_frame->sample_rate = sample_rate;
+  m_frame->nb_samples = m_codec_context->frame_size;
+  if (av_frame_get_buffer(m_frame, 0) < 0)
+  {
+    ERROR_LOG(AUDIO, "Could not allocate an audio frame");
+    Close();
+    return false;
+  }
+
+  m_pending_samples.clear();
+  m_next_pts = 0;
+  return true;
+}
+
+void FLACEncoder::AddSamples(const s16* samples, size_t count)
+{
+  if (!m_frame)
+    return;
+
+  m_pending_samples.insert(m_pending_samples.end(), samples, samples + count * 2);
+
+  const size_t frame_size = static_cast<size_t>(m_codec_context->frame_size);
+  size_t consumed = 0;
+  while (m_pending_samples.size() - consumed >= frame_size * 2)
+  {
+    if (av_frame_make_writable(m_frame) < 0)
+      break;
+    std::memcpy(m_frame->data[0], &m_pending_samples[consumed], frame_size * 2 * sizeof(s16));
+    consumed += frame_size * 2;
+    EncodeFrame(m_frame);
+  }
+  m_pending_samples.erase(m_pending_samples.begin(), m_pending_samples.begin() + consumed);
+}
+
+void FLACEncoder::EncodeFrame(AVFrame* frame)
+{
+  if (frame)
+  {
+    frame->pts = m_next_pts;
+    m_next_pts += frame->nb_samples;
+  }
+
+  AVPacket packet;
+  av_init_packet(&packet);
+  packet.data = nullptr;
+  packet.size = 0;
+
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 37, 100)
+  if (avcodec_send_frame(m_codec_context, frame) < 0)
+  {
+    ERROR_LOG(AUDIO, "Error while encoding audio");
+    return;
+  }
+  while (avcodec_receive_packet(m_codec_context, &packet) == 0)
+  {
+#else
+  int got_packet = 0;
+  while (avcodec_encode_audio2(m_codec_context, &packet, frame, &got_packet) == 0 && got_packet)
+  {
+#endif
+    av_packet_rescale_ts(&packet, m_codec_context->time_base, m_stream->time_base);
+    packet.stream_index = m_stream->index;
+    av_interleaved_write_frame(m_format_context, &packet);
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 37, 100)
+    // Only flushing returns more than one packet per call.
+    if (frame)
+      break;
+#endif
+  }
+}
+
+void FLACEncoder::Stop()
+{
+  if (!m_frame)
+  {
+    Close();
+    return;
+  }
+
+  // FLAC allows a shorter last frame.
+  if (!m_pending_samples.empty() && av_frame_make_writable(m_frame) >= 0)
+  {
+    m_frame->nb_samples = static_cast<int>(m_pending_samples.size() / 2);
+    std::memcpy(m_frame->data[0], m_pending_samples.data(),
+                m_pending_samples.size() * sizeof(s16));
+    EncodeFrame(m_frame);
+  }
+  m_pending_samples.clear();
+  EncodeFrame(nullptr);
+
+  av_write_trailer(m_format_context);
+  Close();
+}
+
+void FLACEncoder::Close()
+{
+  av_frame_free(&m_frame);
+  avcodec_free_context(&m_codec_context);
+  if (m_format_context)
+  {
+    avio_closep(&m_format_context->pb);
+    avformat_free_context(m_format_context);
+    m_format_context = nullptr;
+  }
+  m_stream = nullptr;
+}
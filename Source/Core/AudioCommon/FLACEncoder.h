@@ -0,0 +1,45 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct AVStream;
+
+// Encodes 16-bit stereo samples into a FLAC file through FFmpeg.
+class FLACEncoder
+{
+public:
+  FLACEncoder() = default;
+  ~FLACEncoder();
+
+  FLACEncoder(const FLACEncoder&) = delete;
+  FLACEncoder& operator=(const FLACEncoder&) = delete;
+
+  bool Start(const std::string& filename, int sample_rate);
+  // Samples are in native endianness, left channel first.
+  void AddSamples(const s16* samples, size_t count);
+  void Stop();
+
+private:
+  // A null frame flushes the encoder.
+  void EncodeFrame(AVFrame* frame);
+  void Close();
+
+  AVFormatContext* m_format_context = nullptr;
+  AVCodecContext* m_codec_context = nullptr;
+  AVStream* m_stream = nullptr;
+  AVFrame* m_frame = nullptr;
+  // Samples that don't fill a whole encoder frame yet.
+  std::vector<s16> m_pending_samples;
+  s64 m_next_pts = 0;
+};
@@ -13,7 +13,9 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/Swap.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 
 Mixer::Mixer(unsigned int BackendSampleRate)
     : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate)
@@ -46,8 +48,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   // so we will just ignore new written data while interpolating.
   // Without this cache, the compiler wouldn't be allowed to optimize the
   // interpolation loop.
-  u32 indexR = m_indexR.load();
-  u32 indexW = m_indexW.load();
+  u32 indexR = m_indexR.load(std::memory_order_relaxed);
+  u32 indexW = m_indexW.load(std::memory_order_acquire);
 
   // render numleft sample pairs to samples[]
   // advance indexR with sample position
@@ -55,7 +57,24 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   float emulationspeed = SConfig::GetInstance().m_EmulationSpeed;
   float aid_sample_rate = static_cast<float>(m_input_sample_rate);
-  if (consider_framelimit && emulationspeed > 0.0f)
+  if (consider_framelimit && emulationspeed > 0.0f && SConfig::GetInstance().m_audio_low_latency)
+  {
+    // Dynamic rate control: instead of buffering enough to ride out the drift between the
+    // emulated and the host clocks, resample slightly faster or slower to hold a small fill.
+    const u32 target = std::max(m_input_sample_rate * LOW_LATENCY_TARGET_MS / 1000, 1u);
+    u32 numLeft = ((indexW - indexR) & INDEX_MASK) / 2;
+    if (numLeft > target * LOW_LATENCY_MAX_FILL)
+    {
+      indexR = indexW - target * 2;
+      numLeft = target;
+      m_numLeftI = static_cast<float>(target);
+    }
+
+    m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
+    const float deviation = MathUtil::Clamp((m_numLeftI - target) / target, -1.0f, 1.0f);
+    aid_sample_rate *= (1.0f + deviation * LOW_LATENCY_MAX_DEVIATION) * emulationspeed;
+  }
+  else if (consider_framelimit && emulationspeed > 0.0f)
   {
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
@@ -82,15 +101,15 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   {
     u32 indexR2 = indexR + 2;  // next sample
 
-    s16 l1 = Common::swap16(m_buffer[indexR & INDEX_MASK]);   // current
-    s16 l2 = Common::swap16(m_buffer[indexR2 & INDEX_MASK]);  // next
+    s16 l1 = m_buffer[indexR & INDEX_MASK];   // current
+    s16 l2 = m_buffer[indexR2 & INDEX_MASK];  // next
     int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
     sampleL = (sampleL * lvolume) >> 8;
     sampleL += samples[currentSample + 1];
     samples[currentSample + 1] = MathUtil::Clamp(sampleL, -32767, 32767);
 
-    s16 r1 = Common::swap16(m_buffer[(indexR + 1) & INDEX_MASK]);   // current
-    s16 r2 = Common::swap16(m_buffer[(indexR2 + 1) & INDEX_MASK]);  // next
+    s16 r1 = m_buffer[(indexR + 1) & INDEX_MASK];   // current
+    s16 r2 = m_buffer[(indexR2 + 1) & INDEX_MASK];  // next
     int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
     sampleR = (sampleR * rvolume) >> 8;
     sampleR += samples[currentSample];
@@ -106,8 +125,8 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   // Padding
   short s[2];
-  s[0] = Common::swap16(m_buffer[(indexR - 1) & INDEX_MASK]);
-  s[1] = Common::swap16(m_buffer[(indexR - 2) & INDEX_MASK]);
+  s[0] = m_buffer[(indexR - 1) & INDEX_MASK];
+  s[1] = m_buffer[(indexR - 2) & INDEX_MASK];
   s[0] = (s[0] * rvolume) >> 8;
   s[1] = (s[1] * lvolume) >> 8;
   for (; currentSample < numSamples * 2; currentSample += 2)
@@ -120,19 +139,21 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   }
 
   // Flush cached variable
-  m_indexR.store(indexR);
+  m_indexR.store(indexR, std::memory_order_release);
 
   return actual_sample_count;
 }
 
 unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 {
+  TRACE_SCOPE("Audio", "Mix");
   if (!samples)
     return 0;
 
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
-  if (SConfig::GetInstance().m_audio_stretch)
+  // Low latency mode replaces stretching with rate control.
+  if (SConfig::GetInstance().m_audio_stretch && !SConfig::GetInstance().m_audio_low_latency)
   {
     unsigned int available_samples =
         std::min(m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples());
@@ -185,35 +206,32 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
-  // Cache access in non-volatile variable
-  // indexR isn't allowed to cache in the audio throttling loop as it
-  // needs to get updates to not deadlock.
-  u32 indexW = m_indexW.load();
+  // Only this thread writes indexW.
+  const u32 indexW = m_indexW.load(std::memory_order_relaxed);
 
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
-  if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
-    return;
+  // The cached read index is never ahead of the real one, so it can only underestimate the space.
+  if (num_samples * 2 + ((indexW - m_cached_indexR) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  {
+    m_cached_indexR = m_indexR.load(std::memory_order_acquire);
+    if (num_samples * 2 + ((indexW - m_cached_indexR) & INDEX_MASK) >= MAX_SAMPLES * 2)
+      return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
-  // and we simply store raw data here to make fast mem copy
-  int over_bytes = num_samples * 4 - (MAX_SAMPLES * 2 - (indexW & INDEX_MASK)) * sizeof(short);
-  if (over_bytes > 0)
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4 - over_bytes);
-    memcpy(&m_buffer[0], samples + (num_samples * 4 - over_bytes) / sizeof(short), over_bytes);
-  }
-  else
-  {
-    memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
-  }
+  // and we simply store the samples here, swapped so the resampling doesn't have to.
+  for (u32 i = 0; i < num_samples * 2; ++i)
+    m_buffer[(indexW + i) & INDEX_MASK] = Common::swap16(samples[i]);
 
-  m_indexW.fetch_add(num_samples * 2);
+  m_indexW.store(indexW + num_samples * 2, std::memory_order_release);
 }
 
 void Mixer::PushSamples(const short* samples, unsigned int num_samples)
 {
+  if (Core::IsCatchingUp())
+    return;
   m_dma_mixer.PushSamples(samples, num_samples);
   int sample_rate = m_dma_mixer.GetInputSampleRate();
   if (m_log_dsp_audio)
@@ -222,6 +240,8 @@ void Mixer::PushSamples(const short* samples, unsigned int num_samples)
 
 void Mixer::PushStreamingSamples(const short* samples, unsigned int num_samples)
 {
+  if (Core::IsCatchingUp())
+    return;
   m_streaming_mixer.PushSamples(samples, num_samples);
   int sample_rate = m_streaming_mixer.GetInputSampleRate();
   if (m_log_dtk_audio)
@@ -366,7 +386,10 @@ void Mixer::MixerFifo::SetVolume(unsigned int lvolume, unsigned int rvolume)
 
 unsigned int Mixer::MixerFifo::AvailableSamples() const
 {
-  unsigned int samples_in_fifo = ((m_indexW.load() - m_indexR.load()) & INDEX_MASK) / 2;
+  unsigned int samples_in_fifo =
+      ((m_indexW.load(std::memory_order_acquire) - m_indexR.load(std::memory_order_relaxed)) &
+       INDEX_MASK) /
+      2;
   if (samples_in_fifo <= 1)
     return 0;  // Mixer::MixerFifo::Mix always keeps one sample in the buffer.
   return (samples_in_fifo - 1) * m_mixer->m_sampleRate / m_input_sample_rate;
@@ -50,6 +50,11 @@ private:
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
+  // Low latency mode keeps the FIFO around this fill, steering the rate by up to the deviation.
+  static constexpr u32 LOW_LATENCY_TARGET_MS = 8;
+  static constexpr float LOW_LATENCY_MAX_DEVIATION = 0.005f;
+  // Beyond this many times the target, after a hitch, the excess is dropped.
+  static constexpr u32 LOW_LATENCY_MAX_FILL = 4;
 
   class MixerFifo final
   {
@@ -68,9 +73,14 @@ private:
   private:
     Mixer* m_mixer;
     unsigned m_input_sample_rate;
+    // Native endian samples, swapped once when they are pushed.
     std::array<short, MAX_SAMPLES * 2> m_buffer{};
-    std::atomic<u32> m_indexW{0};
-    std::atomic<u32> m_indexR{0};
+    // Written by the emulation thread. It keeps the last read index it saw and only reloads it when
+    // the samples don't seem to fit, so it rarely touches the cache line of the audio thread.
+    alignas(64) std::atomic<u32> m_indexW{0};
+    u32 m_cached_indexR = 0;
+    // Written by the audio thread, once per Mix.
+    alignas(64) std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
@@ -13,6 +13,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPlacement.h"
 #include "Core/ConfigManager.h"
 
 static HMODULE s_openal_dll = nullptr;
@@ -218,6 +219,7 @@ static bool IsCreativeXFi()
 void OpenALStream::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - openal");
+  Common::PlaceCurrentThread(Common::ThreadRole::Audio);
 
   bool float32_capable = palIsExtensionPresent("AL_EXT_float32") != 0;
   bool surround_capable = palIsExtensionPresent("AL_EXT_MCFORMATS") || IsCreativeXFi();
@@ -42,6 +42,7 @@ PulseAudio::~PulseAudio()
 void PulseAudio::SoundLoop()
 {
   Common::SetCurrentThreadName("Audio thread - pulse");
+  Common::PlaceCurrentThread(Common::ThreadRole::Audio);
 
   if (PulseInit())
   {
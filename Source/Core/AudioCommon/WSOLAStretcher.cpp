@@ -0,0 +1,189 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "AudioCommon/WSOLAStretcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X86_64)
+#include <xmmintrin.h>
+#endif
+
+#include "Common/MathUtil.h"
+
+namespace AudioCommon
+{
+namespace
+{
+constexpr unsigned int SEQUENCE_MS = 40;
+constexpr unsigned int SEEK_MS = 15;
+constexpr unsigned int OVERLAP_MS = 8;
+// Tempos this close to 1 are copied through unchanged.
+constexpr double PASSTHROUGH_RANGE = 0.02;
+}
+
+WSOLAStretcher::WSOLAStretcher(unsigned int sample_rate)
+    : m_sequence_length(sample_rate * SEQUENCE_MS / 1000),
+      m_seek_length(sample_rate * SEEK_MS / 1000),
+      // Even, so the overlap fills whole vectors of four floats.
+      m_overlap_length(sample_rate * OVERLAP_MS / 1000 & ~1u)
+{
+  m_overlap.resize(m_overlap_length * 2);
+}
+
+void WSOLAStretcher::SetTempo(double tempo)
+{
+  m_tempo = tempo;
+}
+
+void WSOLAStretcher::Clear()
+{
+  m_input.clear();
+  m_output.clear();
+  m_output_read = 0;
+  m_has_overlap = false;
+  m_skip_fraction = 0.0;
+}
+
+void WSOLAStretcher::PutSamples(const short* in, unsigned int num_samples)
+{
+  m_input.insert(m_input.end(), in, in + num_samples * 2);
+  Process();
+}
+
+unsigned int WSOLAStretcher::NumSamples() const
+{
+  return static_cast<unsigned int>((m_output.size() - m_output_read) / 2);
+}
+
+unsigned int WSOLAStretcher::ReceiveSamples(short* out, unsigned int num_samples)
+{
+  const unsigned int count = std::min(num_samples, NumSamples());
+  std::copy_n(m_output.begin() + m_output_read, count * 2, out);
+  m_output_read += count * 2;
+
+  if (m_output_read == m_output.size())
+  {
+    m_output.clear();
+    m_output_read = 0;
+  }
+  return count;
+}
+
+void WSOLAStretcher::OutputOverlap(size_t offset)
+{
+  const float* input = &m_input[offset * 2];
+  for (size_t i = 0; i < m_overlap_length; ++i)
+  {
+    const float fade_in = static_cast<float>(i) / m_overlap_length;
+    for (size_t c = 0; c < 2; ++c)
+    {
+      const float previous = m_overlap[i * 2 + c];
+      const float sample = previous + (input[i * 2 + c] - previous) * fade_in;
+      m_output.push_back(static_cast<short>(MathUtil::Clamp(sample, -32768.0f, 32767.0f)));
+    }
+  }
+}
+
+void WSOLAStretcher::OutputInput(size_t begin, size_t end)
+{
+  for (size_t i = begin * 2; i < end * 2; ++i)
+    m_output.push_back(static_cast<short>(m_input[i]));
+}
+
+size_t WSOLAStretcher::FindBestOffset() const
+{
+  // The offset whose start correlates best with the tail of the previous sequence, normalized by
+  // its energy so loud parts don't win on volume alone.
+  const size_t count = m_overlap_length * 2;
+  size_t best_offset = 0;
+  float best_similarity = -std::numeric_limits<float>::max();
+  for (size_t offset = 0; offset < m_seek_length; ++offset)
+  {
+    const float* candidate = &m_input[offset * 2];
+    float correlation = 0.0f;
+    float energy = 0.0f;
+#if defined(_M_X86_64)
+    __m128 correlation4 = _mm_setzero_ps();
+    __m128 energy4 = _mm_setzero_ps();
+    for (size_t i = 0; i < count; i += 4)
+    {
+      const __m128 previous = _mm_loadu_ps(&m_overlap[i]);
+      const __m128 current = _mm_loadu_ps(candidate + i);
+      correlation4 = _mm_add_ps(correlation4, _mm_mul_ps(previous, current));
+      energy4 = _mm_add_ps(energy4, _mm_mul_ps(current, current));
+    }
+    alignas(16) float sums[8];
+    _mm_store_ps(sums, correlation4);
+    _mm_store_ps(sums + 4, energy4);
+    correlation = sums[0] + sums[1] + sums[2] + sums[3];
+    energy = sums[4] + sums[5] + sums[6] + sums[7];
+#else
+    for (size_t i = 0; i < count; ++i)
+    {
+      correlation += m_overlap[i] * candidate[i];
+      energy += candidate[i] * candidate[i];
+    }
+#endif
+
+    const float similarity = correlation / std::sqrt(energy + 1.0f);
+    if (similarity > best_similarity)
+    {
+      best_similarity = similarity;
+      best_offset = offset;
+    }
+  }
+  return best_offset;
+}
+
+void WSOLAStretcher::Process()
+{
+  if (std::abs(m_tempo - 1.0) < PASSTHROUGH_RANGE)
+  {
+    // Fade out of the last stretched sequence, then copy.
+    if (m_has_overlap)
+    {
+      if (m_input.size() < m_overlap_length * 2)
+        return;
+      OutputOverlap(0);
+      OutputInput(m_overlap_length, m_input.size() / 2);
+      m_has_overlap = false;
+    }
+    else
+    {
+      OutputInput(0, m_input.size() / 2);
+    }
+    m_input.clear();
+    m_skip_fraction = 0.0;
+    return;
+  }
+
+  while (m_input.size() / 2 >= m_seek_length + m_sequence_length)
+  {
+    size_t offset = 0;
+    if (m_has_overlap)
+    {
+      offset = FindBestOffset();
+      OutputOverlap(offset);
+    }
+    else
+    {
+      OutputInput(0, m_overlap_length);
+    }
+    OutputInput(offset + m_overlap_length, offset + m_sequence_length - m_overlap_length);
+
+    const auto tail = m_input.begin() + (offset + m_sequence_length - m_overlap_length) * 2;
+    std::copy(tail, tail + m_overlap_length * 2, m_overlap.begin());
+    m_has_overlap = true;
+
+    // Every sequence outputs the same length, the tempo decides how far the input moves on.
+    m_skip_fraction += m_tempo * (m_sequence_length - m_overlap_length);
+    const size_t skip = std::min(static_cast<size_t>(m_skip_fraction), m_input.size() / 2);
+    m_skip_fraction -= skip;
+    m_input.erase(m_input.begin(), m_input.begin() + skip * 2);
+  }
+}
+}  // namespace AudioCommon
@@ -0,0 +1,48 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace AudioCommon
+{
+// A lightweight time stretcher for stereo samples using waveform similarity overlap-add (WSOLA).
+// Each output sequence starts where the input looks most like the end of the previous sequence,
+// found with a cross-correlation search, and the two are cross-faded. Close to normal speed the
+// samples are only copied through.
+class WSOLAStretcher
+{
+public:
+  explicit WSOLAStretcher(unsigned int sample_rate);
+
+  void SetTempo(double tempo);
+  void PutSamples(const short* in, unsigned int num_samples);
+  unsigned int ReceiveSamples(short* out, unsigned int num_samples);
+  // Stretched samples ready to be received.
+  unsigned int NumSamples() const;
+  void Clear();
+
+private:
+  void Process();
+  size_t FindBestOffset() const;
+  // Cross-fades the tail of the previous sequence into the input at offset.
+  void OutputOverlap(size_t offset);
+  void OutputInput(size_t begin, size_t end);
+
+  size_t m_sequence_length;
+  size_t m_seek_length;
+  size_t m_overlap_length;
+  double m_tempo = 1.0;
+  double m_skip_fraction = 0.0;
+
+  // Interleaved stereo, as floats for the correlation search.
+  std::vector<float> m_input;
+  std::vector<float> m_overlap;
+  bool m_has_overlap = false;
+  std::vector<short> m_output;
+  size_t m_output_read = 0;
+};
+}  // namespace AudioCommon
@@ -6,16 +6,16 @@
 
 #include <string>
 
+#include "AudioCommon/FLACEncoder.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/ConfigManager.h"
 
-constexpr size_t WaveFileWriter::BUFFER_SIZE;
-
 WaveFileWriter::WaveFileWriter()
 {
 }
@@ -26,6 +26,26 @@ WaveFileWriter::~WaveFileWriter()
 }
 
 bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRate)
+{
+  if (writer_thread.joinable())
+  {
+    PanicAlertT("The file %s was already open, the file header will not be written.",
+                filename.c_str());
+    return false;
+  }
+
+  if (basename.empty())
+    SplitPath(filename, nullptr, &basename, &extension);
+
+  if (!OpenFile(filename, HLESampleRate))
+    return false;
+
+  writer_exiting.Clear();
+  writer_thread = std::thread(&WaveFileWriter::WriterThread, this);
+  return true;
+}
+
+bool WaveFileWriter::OpenFile(const std::string& filename, unsigned int HLESampleRate)
 {
   // Ask to delete file
   if (File::Exists(filename))
@@ -50,6 +70,23 @@ bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRa
     return false;
   }
 
+  audio_size = 0;
+  current_sample_rate = HLESampleRate;
+
+  if (extension == ".flac")
+  {
+#if defined(HAVE_FFMPEG)
+    flac_encoder = std::make_unique<FLACEncoder>();
+    if (flac_encoder->Start(filename, HLESampleRate))
+      return true;
+    flac_encoder.reset();
+    PanicAlertT("The file %s could not be opened for writing.", filename.c_str());
+#else
+    PanicAlertT("Dumping audio to FLAC requires Dolphin to be built with FFmpeg.");
+#endif
+    return false;
+  }
+
   file.Open(filename, "wb");
   if (!file)
   {
@@ -59,13 +96,6 @@ bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRa
     return false;
   }
 
-  audio_size = 0;
-
-  if (basename.empty())
-    SplitPath(filename, nullptr, &basename, nullptr);
-
-  current_sample_rate = HLESampleRate;
-
   // -----------------
   // Write file header
   // -----------------
@@ -94,6 +124,26 @@ bool WaveFileWriter::Start(const std::string& filename, unsigned int HLESampleRa
 
 void WaveFileWriter::Stop()
 {
+  if (writer_thread.joinable())
+  {
+    writer_exiting.Set();
+    chunk_pushed.Set();
+    writer_thread.join();
+  }
+  CloseFile();
+}
+
+void WaveFileWriter::CloseFile()
+{
+#if defined(HAVE_FFMPEG)
+  if (flac_encoder)
+  {
+    flac_encoder->Stop();
+    flac_encoder.reset();
+    return;
+  }
+#endif
+
   // u32 file_size = (u32)ftello(file);
   file.Seek(4, SEEK_SET);
   Write(audio_size + 36);
@@ -116,11 +166,11 @@ void WaveFileWriter::Write4(const char* ptr)
 
 void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count, int sample_rate)
 {
-  if (!file)
+  if (!writer_thread.joinable())
+  {
     PanicAlertT("WaveFileWriter - file not open.");
-
-  if (count > BUFFER_SIZE * 2)
-    PanicAlert("WaveFileWriter - buffer too small (count = %u).", count);
+    return;
+  }
 
   if (skip_silence)
   {
@@ -136,23 +186,57 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count, int
       return;
   }
 
+  Chunk chunk;
+  chunk.samples.resize(count * 2);
+  chunk.sample_rate = sample_rate;
   for (u32 i = 0; i < count; i++)
   {
     // Flip the audio channels from RL to LR
-    conv_buffer[2 * i] = Common::swap16((u16)sample_data[2 * i + 1]);
-    conv_buffer[2 * i + 1] = Common::swap16((u16)sample_data[2 * i]);
+    chunk.samples[2 * i] = Common::swap16((u16)sample_data[2 * i + 1]);
+    chunk.samples[2 * i + 1] = Common::swap16((u16)sample_data[2 * i]);
   }
 
-  if (sample_rate != current_sample_rate)
+  chunks.Push(std::move(chunk));
+  chunk_pushed.Set();
+}
+
+void WaveFileWriter::WriteChunk(const Chunk& chunk)
+{
+  if (chunk.sample_rate != current_sample_rate)
   {
-    Stop();
+    CloseFile();
     file_index++;
     std::stringstream filename;
-    filename << File::GetUserPath(D_DUMPAUDIO_IDX) << basename << file_index << ".wav";
-    Start(filename.str(), sample_rate);
-    current_sample_rate = sample_rate;
+    filename << File::GetUserPath(D_DUMPAUDIO_IDX) << basename << file_index << extension;
+    OpenFile(filename.str(), chunk.sample_rate);
+    current_sample_rate = chunk.sample_rate;
   }
 
-  file.WriteBytes(conv_buffer.data(), count * 4);
+  const u32 count = static_cast<u32>(chunk.samples.size() / 2);
+#if defined(HAVE_FFMPEG)
+  if (flac_encoder)
+    flac_encoder->AddSamples(chunk.samples.data(), count);
+  else
+#endif
+    file.WriteBytes(chunk.samples.data(), count * 4);
   audio_size += count * 4;
 }
+
+void WaveFileWriter::WriterThread()
+{
+  Common::SetCurrentThreadName("Audio dump writer");
+
+  while (true)
+  {
+    chunk_pushed.Wait();
+
+    // Everything pushed before Stop is still written.
+    const bool exiting = writer_exiting.IsSet();
+    Chunk chunk;
+    while (chunks.Pop(chunk))
+      WriteChunk(chunk);
+
+    if (exiting)
+      return;
+  }
+}
@@ -10,15 +10,24 @@
 // The float variant will convert from -1.0-1.0 range and clamp.
 // Alternatively, AddSamplesBE for big endian wave data.
 // If Stop is not called when it destructs, the destructor will call Stop().
+// The samples are written by a background thread, so the audio path never waits for the disk.
+// Files named .flac are encoded to FLAC through FFmpeg, if Dolphin was built with it.
 // ---------------------------------------------------------------------------------
 
 #pragma once
 
-#include <array>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Common/File.h"
+#include "Common/Flag.h"
+#include "Common/SPSCQueue.h"
+
+class FLACEncoder;
 
 class WaveFileWriter
 {
@@ -38,15 +47,33 @@ public:
   void AddStereoSamplesBE(const short* sample_data, u32 count, int sample_rate);  // big endian
   u32 GetAudioSize() const { return audio_size; }
 private:
-  static constexpr size_t BUFFER_SIZE = 32 * 1024;
+  // Converted samples waiting for the writer thread.
+  struct Chunk
+  {
+    std::vector<short> samples;
+    int sample_rate;
+  };
+
+  bool OpenFile(const std::string& filename, unsigned int sample_rate);
+  void CloseFile();
+  void WriteChunk(const Chunk& chunk);
+  void WriterThread();
 
   File::IOFile file;
+#if defined(HAVE_FFMPEG)
+  std::unique_ptr<FLACEncoder> flac_encoder;
+#endif
   bool skip_silence = false;
   u32 audio_size = 0;
-  std::array<short, BUFFER_SIZE> conv_buffer{};
   void Write(u32 value);
   void Write4(const char* ptr);
   std::string basename;
+  std::string extension;
   int current_sample_rate;
   int file_index = 0;
+
+  Common::SPSCQueue<Chunk, false> chunks;
+  Common::Event chunk_pushed;
+  Common::Flag writer_exiting;
+  std::thread writer_thread;
 };
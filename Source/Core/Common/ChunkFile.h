@@ -70,8 +70,16 @@ public:
 
 public:
   PointerWrap(u8** ptr_, Mode mode_) : ptr(ptr_), mode(mode_) {}
+  // Writing more than size bytes switches to measuring instead, which leaves *ptr at the size the
+  // buffer would have needed.
+  PointerWrap(u8** ptr_, size_t size, Mode mode_)
+      : ptr(ptr_), mode(mode_), end(*ptr_ + size), bounded(true)
+  {
+  }
   void SetMode(Mode mode_) { mode = mode_; }
   Mode GetMode() const { return mode; }
+  // Whether a write didn't fit the buffer.
+  bool IsOverflowed() const { return overflowed; }
   template <typename K, class V>
   void Do(std::map<K, V>& x)
   {
@@ -133,7 +141,7 @@ public:
   template <typename T>
   void Do(std::vector<T>& x)
   {
-    DoContainer(x);
+    DoContiguousContainer(x);
   }
 
   template <typename T>
@@ -151,7 +159,7 @@ public:
   template <typename T>
   void Do(std::basic_string<T>& x)
   {
-    DoContainer(x);
+    DoContiguousContainer(x);
   }
 
   template <typename T, typename U>
@@ -272,8 +280,41 @@ private:
     DoEachElement(x, [](PointerWrap& p, typename T::value_type& elem) { p.Do(elem); });
   }
 
+  // Elements that Do would copy byte for byte are copied all at once, which gives the same layout.
+  // Reading resizes the existing storage, so a container that keeps its size doesn't allocate.
+  template <typename T>
+  void DoContiguousContainer(T& x)
+  {
+    using V = typename T::value_type;
+    DoContiguousContainer(
+        x, std::integral_constant<bool, std::is_trivially_copyable<V>::value &&
+                                            !std::is_same<V, bool>::value>());
+  }
+
+  template <typename T>
+  void DoContiguousContainer(T& x, std::true_type)
+  {
+    u32 size = static_cast<u32>(x.size());
+    Do(size);
+    x.resize(size);
+    if (size != 0)
+      DoArray(&x[0], size);
+  }
+
+  template <typename T>
+  void DoContiguousContainer(T& x, std::false_type)
+  {
+    DoContainer(x);
+  }
+
   __forceinline void DoVoid(void* data, u32 size)
   {
+    if (bounded && mode == MODE_WRITE && size > static_cast<size_t>(end - *ptr))
+    {
+      mode = MODE_MEASURE;
+      overflowed = true;
+    }
+
     switch (mode)
     {
     case MODE_READ:
@@ -296,4 +337,9 @@ private:
 
     *ptr += size;
   }
+
+private:
+  u8* end = nullptr;
+  bool bounded = false;
+  bool overflowed = false;
 };
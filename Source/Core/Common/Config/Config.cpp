@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
 #include <tuple>
@@ -14,6 +15,7 @@ namespace Config
 {
 static Layers s_layers;
 static std::list<ConfigChangedCallback> s_callbacks;
+static std::atomic<u64> s_version{1};
 
 void InvokeConfigChangedCallbacks();
 
@@ -25,6 +27,7 @@ Layers* GetLayers()
 void AddLayer(std::unique_ptr<Layer> layer)
 {
   s_layers[layer->GetLayer()] = std::move(layer);
+  detail::IncrementConfigVersion();
   InvokeConfigChangedCallbacks();
 }
 
@@ -43,6 +46,7 @@ Layer* GetLayer(LayerType layer)
 void RemoveLayer(LayerType layer)
 {
   s_layers.erase(layer);
+  detail::IncrementConfigVersion();
   InvokeConfigChangedCallbacks();
 }
 bool LayerExists(LayerType layer)
@@ -50,6 +54,16 @@ bool LayerExists(LayerType layer)
   return s_layers.find(layer) != s_layers.end();
 }
 
+u64 GetConfigVersion()
+{
+  return s_version.load(std::memory_order_acquire);
+}
+
+void detail::IncrementConfigVersion()
+{
+  s_version.fetch_add(1, std::memory_order_release);
+}
+
 void AddConfigChangedCallback(ConfigChangedCallback func)
 {
   s_callbacks.emplace_back(func);
@@ -84,11 +98,13 @@ void Shutdown()
 {
   s_layers.clear();
   s_callbacks.clear();
+  detail::IncrementConfigVersion();
 }
 
 void ClearCurrentRunLayer()
 {
   s_layers[LayerType::CurrentRun] = std::make_unique<Layer>(LayerType::CurrentRun);
+  detail::IncrementConfigVersion();
 }
 
 static const std::map<System, std::string> system_to_name = {
@@ -10,6 +10,7 @@
 #include <optional>
 #include <string>
 
+#include "Common/CommonTypes.h"
 #include "Common/Config/ConfigInfo.h"
 #include "Common/Config/Enums.h"
 #include "Common/Config/Layer.h"
@@ -27,9 +28,13 @@ Layer* GetLayer(LayerType layer);
 void RemoveLayer(LayerType layer);
 bool LayerExists(LayerType layer);
 
+// The callbacks are only invoked when a setting actually changed.
 void AddConfigChangedCallback(ConfigChangedCallback func);
 void InvokeConfigChangedCallbacks();
 
+// Incremented whenever a setting of any layer may have changed.
+u64 GetConfigVersion();
+
 // Explicit load and save of layers
 void Load();
 void Save();
@@ -72,8 +77,8 @@ LayerType GetActiveLayerForConfig(const ConfigInfo<T>& info)
 template <typename T>
 void Set(LayerType layer, const ConfigInfo<T>& info, const T& value)
 {
-  GetLayer(layer)->Set(info, value);
-  InvokeConfigChangedCallbacks();
+  if (GetLayer(layer)->Set(info, value))
+    InvokeConfigChangedCallbacks();
 }
 
 template <typename T>
@@ -96,4 +101,30 @@ void SetBaseOrCurrent(const ConfigInfo<T>& info, const T& value)
   else
     Set<T>(LayerType::CurrentRun, info, value);
 }
+
+// Caches the value of a setting for code that reads it often. Reading it only costs a version
+// check unless the settings changed since the last read. Not thread-safe, so each thread that
+// reads the setting needs its own.
+template <typename T>
+class CachedValue
+{
+public:
+  explicit CachedValue(const ConfigInfo<T>& info) : m_info(info) {}
+
+  const T& Get() const
+  {
+    const u64 version = GetConfigVersion();
+    if (version != m_version)
+    {
+      m_value = Config::Get(m_info);
+      m_version = version;
+    }
+    return m_value;
+  }
+
+private:
+  const ConfigInfo<T> m_info;
+  mutable T m_value{};
+  mutable u64 m_version = 0;
+};
 }
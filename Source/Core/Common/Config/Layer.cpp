@@ -86,6 +86,8 @@ bool Layer::DeleteKey(const ConfigLocation& location)
   m_is_dirty = true;
   bool had_value = m_map[location].has_value();
   m_map[location].reset();
+  if (had_value)
+    detail::IncrementConfigVersion();
   return had_value;
 }
 
@@ -96,10 +98,13 @@ void Layer::DeleteAllKeys()
   {
     pair.second.reset();
   }
+  detail::IncrementConfigVersion();
 }
 
 Section Layer::GetSection(System system, const std::string& section)
 {
+  // The values can be changed through the section.
+  detail::IncrementConfigVersion();
   return Section{ m_map.lower_bound(ConfigLocation{ system, section, "" }),
     m_map.lower_bound(ConfigLocation{ system, section + '\001', "" }) };
 }
@@ -115,6 +120,7 @@ void Layer::Load()
   if (m_loader)
     m_loader->Load(this);
   m_is_dirty = false;
+  detail::IncrementConfigVersion();
   InvokeConfigChangedCallbacks();
 }
 
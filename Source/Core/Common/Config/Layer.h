@@ -18,6 +18,9 @@ namespace Config
 {
 namespace detail
 {
+// Called whenever a setting may have changed, see GetConfigVersion.
+void IncrementConfigVersion();
+
 std::string ValueToString(u16 value);
 std::string ValueToString(u32 value);
 std::string ValueToString(float value);
@@ -113,21 +116,24 @@ public:
     return detail::TryParse<T>(*str_value);
   }
 
+  // Returns whether the value changed.
   template <typename T>
-  void Set(const ConfigInfo<T>& config_info, const T& value)
+  bool Set(const ConfigInfo<T>& config_info, const T& value)
   {
-    Set<T>(config_info.location, value);
+    return Set<T>(config_info.location, value);
   }
 
   template <typename T>
-  void Set(const ConfigLocation& location, const T& value)
+  bool Set(const ConfigLocation& location, const T& value)
   {
     const std::string new_value = detail::ValueToString(value);
     std::optional<std::string>& current_value = m_map[location];
     if (current_value == new_value)
-      return;
+      return false;
     m_is_dirty = true;
     current_value = new_value;
+    detail::IncrementConfigVersion();
+    return true;
   }
 
   Section GetSection(System system, const std::string& section);
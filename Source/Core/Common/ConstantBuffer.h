@@ -32,53 +32,51 @@
 
 #pragma once
 #include <algorithm>
+#include <cstring>
 #include <utility>
 #include <vector>
+#include "BitHelpers.h"
 #include "Common.h"
 
 typedef std::vector<std::pair<u32, u32>> regionvector;
 
+// Shadow copy of a shader constant buffer made of 16-byte registers. Every register has a dirty
+// bit, the setters compare the new value against the current one and only flag registers that
+// really changed, so redundant updates from the shader managers don't cause an upload at all.
 struct ConstatBuffer
 {
 private:
   void* m_buffer;
   regionvector m_dirtyRegions;
-  //size_t m_size;
+  std::vector<u64> m_dirtyBits;
+  u32 m_registers;
   bool m_dirty;
   bool m_dirtyregiondisabled;
   __forceinline void AddDirtyRegion(u32 const_number, u32 size)
   {
     m_dirty = true;
-    if (m_dirtyregiondisabled)
+    for (u32 i = const_number; i < const_number + size; i++)
     {
-      return;
+      m_dirtyBits[i >> 6] |= 1ULL << (i & 63);
     }
-    u32 x = const_number;
-    u32 y = const_number + size - 1;
-    for (size_t i = 0; i < m_dirtyRegions.size(); i++)
+  }
+  template<typename T>
+  __forceinline void WriteRegister(u32 const_number, const T* values)
+  {
+    T* buff = &((T*)m_buffer)[const_number * 4];
+    if (memcmp(buff, values, sizeof(T) * 4) != 0)
     {
-      std::pair<u32, u32> &currentregion = m_dirtyRegions[i];
-      // overlaps
-      if (((x <= currentregion.second) && (currentregion.first <= y))
-        || (y + 1 == currentregion.first) || (currentregion.second + 1 == x))
-      {
-        currentregion.first = std::min(currentregion.first, x);
-        currentregion.second = std::max(currentregion.second, y);
-        return;
-      }
-      else if (currentregion.first > x)
-      {
-        std::swap(x, currentregion.first);
-        std::swap(y, currentregion.second);
-      }
+      memcpy(buff, values, sizeof(T) * 4);
+      AddDirtyRegion(const_number, 1);
     }
-    m_dirtyRegions.push_back(std::pair<u32, u32>(x, y));
   }
 public:
+  // size is the number of 32-bit components in the buffer.
   ConstatBuffer(void* buffer, size_t size) :
     m_buffer(buffer),
     m_dirtyRegions(),
-    //m_size(size),
+    m_dirtyBits((size / 4 + 63) / 64, 0),
+    m_registers(static_cast<u32>(size / 4)),
     m_dirty(false),
     m_dirtyregiondisabled(false)
   {
@@ -92,60 +90,48 @@ public:
   __forceinline void SetConstant(unsigned int const_number, unsigned int index, T f1)
   {
     u32 idx = const_number * 4 + index;
-    ((T*)m_buffer)[idx] =  f1;
-    AddDirtyRegion(const_number, 1);
+    if (memcmp(&((T*)m_buffer)[idx], &f1, sizeof(T)) != 0)
+    {
+      ((T*)m_buffer)[idx] = f1;
+      AddDirtyRegion(const_number, 1);
+    }
   }
   template<typename T>
   __forceinline void SetConstant4(unsigned int const_number, T f1, T f2, T f3, T f4)
   {
-    u32 idx = const_number * 4;
-    T* buff = &((T*)m_buffer)[idx];
-    *buff++ = f1;
-    *buff++ = f2;
-    *buff++ = f3;
-    *buff = f4;
-    AddDirtyRegion(const_number, 1);
+    const T values[4] = { f1, f2, f3, f4 };
+    WriteRegister(const_number, values);
   }
   template<typename T>
   __forceinline void SetConstant3v(unsigned int const_number, const T *f)
   {
-    u32 idx = const_number * 4;
-    T* buff = &((T*)m_buffer)[idx];
-    *buff++ = *f++;
-    *buff++ = *f++;
-    *buff++ = *f++;
-    *buff = T(0);
-    AddDirtyRegion(const_number, 1);
+    const T values[4] = { f[0], f[1], f[2], T(0) };
+    WriteRegister(const_number, values);
   }
   template<typename T>
   __forceinline void SetConstant4v(unsigned int const_number, const T *f)
   {
-    u32 idx = const_number * 4;
-    memcpy(&((T*)m_buffer)[idx], f, sizeof(T) * 4);
-    AddDirtyRegion(const_number, 1);
+    WriteRegister(const_number, f);
   }
   template<typename T>
   __forceinline void SetMultiConstant3v(unsigned int const_number, unsigned int count, const T *f)
   {
-    u32 idx = const_number * 4;
-    T* buff = &((T*)m_buffer)[idx];
-    for (unsigned int i = 0; i < count; i++)
+    for (unsigned int i = 0; i < count; i++, f += 3)
     {
-      *buff++ = *f++;
-      *buff++ = *f++;
-      *buff++ = *f++;
-      *buff++ = T(0);
+      const T values[4] = { f[0], f[1], f[2], T(0) };
+      WriteRegister(const_number + i, values);
     }
-    AddDirtyRegion(const_number, count);
   }
   template<typename T>
   __forceinline void SetMultiConstant4v(unsigned int const_number, unsigned int count, const T *f)
   {
-    u32 idx = const_number * 4;
-    memcpy(&((T*)m_buffer)[idx], f, sizeof(T) * 4 * count);
-    AddDirtyRegion(const_number, count);
+    for (unsigned int i = 0; i < count; i++, f += 4)
+    {
+      WriteRegister(const_number + i, f);
+    }
   }
 
+  // The caller writes the registers directly, so they are flagged whether they change or not.
   template<typename T>
   __forceinline T* GetBufferToUpdate(u32 const_number, u32 count)
   {
@@ -166,13 +152,68 @@ public:
     return m_dirty;
   }
 
-  __forceinline void Clear()
+  __forceinline bool IsRegisterDirty(u32 const_number) const
   {
-    m_dirty = false;
-    if (!m_dirtyregiondisabled)
+    return (m_dirtyBits[const_number >> 6] >> (const_number & 63)) & 1;
+  }
+
+  // Calls f(first, count) for every run of consecutive dirty registers, in ascending order.
+  template<typename F>
+  void ForEachDirtyRange(F f) const
+  {
+    if (!m_dirty)
+      return;
+    u32 first = 0;
+    u32 count = 0;
+    for (u32 word = 0; word < static_cast<u32>(m_dirtyBits.size()); word++)
     {
-      m_dirtyRegions.clear();
+      u64 bits = m_dirtyBits[word];
+      if (bits == ~0ULL)
+      {
+        if (count == 0)
+          first = word * 64;
+        count += 64;
+        continue;
+      }
+      for (u32 bit = 0; bit < 64; bit++)
+      {
+        if ((bits >> bit) & 1)
+        {
+          if (count == 0)
+            first = word * 64 + bit;
+          count++;
+        }
+        else if (count != 0)
+        {
+          f(first, count);
+          count = 0;
+        }
+        if ((bits >> bit) == 0)
+          break;
+      }
     }
+    if (count != 0)
+      f(first, count);
+  }
+
+  u32 GetDirtyRegisterCount() const
+  {
+    u32 count = 0;
+    for (u64 bits : m_dirtyBits)
+      count += CountSetBits(bits);
+    return count;
+  }
+
+  __forceinline void Clear()
+  {
+    m_dirty = false;
+    std::fill(m_dirtyBits.begin(), m_dirtyBits.end(), 0);
+  }
+
+  // Flags every register, for when the backend copy of the buffer is not known to match.
+  void MarkAllDirty()
+  {
+    AddDirtyRegion(0, m_registers);
   }
 
   __forceinline void EnableDirtyRegions()
@@ -185,8 +226,17 @@ public:
     m_dirtyregiondisabled = true;
   }
 
-  __forceinline const regionvector& GetRegions()
+  // Inclusive register ranges that changed since the last Clear, only for backends that upload
+  // individual registers.
+  const regionvector& GetRegions()
   {
+    m_dirtyRegions.clear();
+    if (!m_dirtyregiondisabled)
+    {
+      ForEachDirtyRange([this](u32 first, u32 count) {
+        m_dirtyRegions.emplace_back(first, first + count - 1);
+      });
+    }
     return m_dirtyRegions;
   }
 
@@ -4,12 +4,22 @@
 
 #include <mbedtls/aes.h>
 
+#include "Common/CPUDetect.h"
 #include "Common/Crypto/AES.h"
+#include "Common/Intrinsics.h"
+
+#if defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
 
 namespace Common
 {
 namespace AES
 {
+// For AES-128
+static constexpr size_t ROUND_KEYS = 11;
+static constexpr size_t PARALLEL_BLOCKS = 8;
+
 std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode)
 {
   mbedtls_aes_context aes_ctx;
@@ -35,5 +45,123 @@ std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size)
 {
   return DecryptEncrypt(key, iv, src, size, Mode::Encrypt);
 }
+
+#if defined(_M_X86_64)
+
+// mbedtls stores the round keys of the equivalent inverse cipher, which is what AESDEC uses.
+FUNCTION_TARGET_AES
+static void DecryptCBCAESNI(const u8* round_keys, u8* iv, const u8* src, u8* dst, size_t size)
+{
+  __m128i keys[ROUND_KEYS];
+  for (size_t i = 0; i < ROUND_KEYS; ++i)
+    keys[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(round_keys + i * 16));
+
+  __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  size_t offset = 0;
+
+  // The blocks are independent, so several can be in flight in the pipeline.
+  for (; offset + PARALLEL_BLOCKS * 16 <= size; offset += PARALLEL_BLOCKS * 16)
+  {
+    __m128i input[PARALLEL_BLOCKS];
+    __m128i state[PARALLEL_BLOCKS];
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+    {
+      input[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset + i * 16));
+      state[i] = _mm_xor_si128(input[i], keys[0]);
+    }
+    for (size_t round = 1; round < ROUND_KEYS - 1; ++round)
+    {
+      for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+        state[i] = _mm_aesdec_si128(state[i], keys[round]);
+    }
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+    {
+      state[i] = _mm_aesdeclast_si128(state[i], keys[ROUND_KEYS - 1]);
+      state[i] = _mm_xor_si128(state[i], i == 0 ? previous : input[i - 1]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset + i * 16), state[i]);
+    }
+    previous = input[PARALLEL_BLOCKS - 1];
+  }
+
+  for (; offset < size; offset += 16)
+  {
+    const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+    __m128i state = _mm_xor_si128(input, keys[0]);
+    for (size_t round = 1; round < ROUND_KEYS - 1; ++round)
+      state = _mm_aesdec_si128(state, keys[round]);
+    state = _mm_aesdeclast_si128(state, keys[ROUND_KEYS - 1]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), _mm_xor_si128(state, previous));
+    previous = input;
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), previous);
+}
+
+#elif defined(_M_ARM_64)
+
+// AESD adds the round key before the inverse rounds instead of after them, so every round key
+// moves one step earlier than with AESDEC and the last one is added separately.
+[[gnu::target("+crypto")]] static void DecryptCBCARMv8(const u8* round_keys, u8* iv,
+                                                       const u8* src, u8* dst, size_t size)
+{
+  uint8x16_t keys[ROUND_KEYS];
+  for (size_t i = 0; i < ROUND_KEYS; ++i)
+    keys[i] = vld1q_u8(round_keys + i * 16);
+
+  uint8x16_t previous = vld1q_u8(iv);
+  size_t offset = 0;
+
+  for (; offset + PARALLEL_BLOCKS * 16 <= size; offset += PARALLEL_BLOCKS * 16)
+  {
+    uint8x16_t input[PARALLEL_BLOCKS];
+    uint8x16_t state[PARALLEL_BLOCKS];
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+      state[i] = input[i] = vld1q_u8(src + offset + i * 16);
+    for (size_t round = 0; round < ROUND_KEYS - 2; ++round)
+    {
+      for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+        state[i] = vaesimcq_u8(vaesdq_u8(state[i], keys[round]));
+    }
+    for (size_t i = 0; i < PARALLEL_BLOCKS; ++i)
+    {
+      state[i] = veorq_u8(vaesdq_u8(state[i], keys[ROUND_KEYS - 2]), keys[ROUND_KEYS - 1]);
+      vst1q_u8(dst + offset + i * 16, veorq_u8(state[i], i == 0 ? previous : input[i - 1]));
+    }
+    previous = input[PARALLEL_BLOCKS - 1];
+  }
+
+  for (; offset < size; offset += 16)
+  {
+    const uint8x16_t input = vld1q_u8(src + offset);
+    uint8x16_t state = input;
+    for (size_t round = 0; round < ROUND_KEYS - 2; ++round)
+      state = vaesimcq_u8(vaesdq_u8(state, keys[round]));
+    state = veorq_u8(vaesdq_u8(state, keys[ROUND_KEYS - 2]), keys[ROUND_KEYS - 1]);
+    vst1q_u8(dst + offset, veorq_u8(state, previous));
+    previous = input;
+  }
+
+  vst1q_u8(iv, previous);
+}
+
+#endif
+
+void DecryptCBC(const mbedtls_aes_context* context, u8* iv, const u8* src, u8* dst, size_t size)
+{
+  if (cpu_info.bAES && context->nr == 10)
+  {
+    const u8* round_keys = reinterpret_cast<const u8*>(context->rk);
+#if defined(_M_X86_64)
+    DecryptCBCAESNI(round_keys, iv, src, dst, size);
+    return;
+#elif defined(_M_ARM_64)
+    DecryptCBCARMv8(round_keys, iv, src, dst, size);
+    return;
+#endif
+  }
+
+  mbedtls_aes_crypt_cbc(const_cast<mbedtls_aes_context*>(context), MBEDTLS_AES_DECRYPT, size, iv,
+                        src, dst);
+}
 }  // namespace AES
 }  // namespace Common
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <mbedtls/aes.h>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -23,5 +24,10 @@ std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size
 // Convenience functions
 std::vector<u8> Decrypt(const u8* key, u8* iv, const u8* src, size_t size);
 std::vector<u8> Encrypt(const u8* key, u8* iv, const u8* src, size_t size);
+
+// Same as mbedtls_aes_crypt_cbc with MBEDTLS_AES_DECRYPT, for a context set up by
+// mbedtls_aes_setkey_dec with a 128-bit key. Uses the AES instructions of the CPU if it has
+// them, which decrypt several blocks at once. size must be a multiple of 16.
+void DecryptCBC(const mbedtls_aes_context* context, u8* iv, const u8* src, u8* dst, size_t size);
 }  // namespace AES
 }  // namespace Common
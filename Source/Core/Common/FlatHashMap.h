@@ -0,0 +1,129 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Hash map for lookups on hot paths. The index is an open addressing table with linear probing
+// that keeps the full hash of every element, so a probe touches one contiguous array and only
+// compares keys whose hashes match. The elements themselves live in a deque and never move, so
+// references and pointers to them stay valid while the map grows, as they do with
+// std::unordered_map. Elements can't be erased one by one, only all at once with clear().
+template <typename K, typename V, typename Hasher>
+class FlatHashMap
+{
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using iterator = typename std::deque<value_type>::iterator;
+  using const_iterator = typename std::deque<value_type>::const_iterator;
+
+  V& operator[](const K& key)
+  {
+    const size_t hash = Hash(key);
+    if (!m_slots.empty())
+    {
+      const size_t slot = FindSlot(key, hash);
+      if (m_slots[slot].index != EMPTY)
+        return m_values[m_slots[slot].index].second;
+    }
+    if ((m_values.size() + 1) * 2 > m_slots.size())
+      Grow();
+    return Insert(key, hash).second;
+  }
+
+  value_type* find(const K& key)
+  {
+    return const_cast<value_type*>(static_cast<const FlatHashMap*>(this)->find(key));
+  }
+
+  const value_type* find(const K& key) const
+  {
+    if (m_slots.empty())
+      return nullptr;
+    const size_t slot = FindSlot(key, Hash(key));
+    return m_slots[slot].index != EMPTY ? &m_values[m_slots[slot].index] : nullptr;
+  }
+
+  void clear()
+  {
+    m_values.clear();
+    m_slots.clear();
+  }
+
+  size_t size() const { return m_values.size(); }
+  bool empty() const { return m_values.empty(); }
+
+  // In insertion order.
+  iterator begin() { return m_values.begin(); }
+  iterator end() { return m_values.end(); }
+  const_iterator begin() const { return m_values.begin(); }
+  const_iterator end() const { return m_values.end(); }
+
+private:
+  static constexpr uint32_t EMPTY = UINT32_MAX;
+  static constexpr size_t MIN_SLOTS = 64;
+
+  struct Slot
+  {
+    size_t hash;
+    uint32_t index;
+  };
+
+  // Some hashers return the key itself, spread the bits so the low ones pick the slot.
+  size_t Hash(const K& key) const
+  {
+    return static_cast<size_t>((static_cast<uint64_t>(m_hasher(key)) * 0x9E3779B97F4A7C15ull) >>
+                               16);
+  }
+
+  // The slot holding the key, or the empty slot where it would go.
+  size_t FindSlot(const K& key, size_t hash) const
+  {
+    const size_t mask = m_slots.size() - 1;
+    size_t slot = hash & mask;
+    while (m_slots[slot].index != EMPTY &&
+           (m_slots[slot].hash != hash || !(m_values[m_slots[slot].index].first == key)))
+    {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  value_type& Insert(const K& key, size_t hash)
+  {
+    const size_t slot = FindSlot(key, hash);
+    m_slots[slot] = {hash, static_cast<uint32_t>(m_values.size())};
+    m_values.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>());
+    return m_values.back();
+  }
+
+  // Keeps the table at most half full.
+  void Grow()
+  {
+    std::vector<Slot> slots(m_slots.empty() ? MIN_SLOTS : m_slots.size() * 2, Slot{0, EMPTY});
+    const size_t mask = slots.size() - 1;
+    for (const Slot& old : m_slots)
+    {
+      if (old.index == EMPTY)
+        continue;
+      size_t slot = old.hash & mask;
+      while (slots[slot].index != EMPTY)
+        slot = (slot + 1) & mask;
+      slots[slot] = old;
+    }
+    m_slots = std::move(slots);
+  }
+
+  std::deque<value_type> m_values;
+  std::vector<Slot> m_slots;
+  Hasher m_hasher;
+};
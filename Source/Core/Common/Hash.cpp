@@ -9,11 +9,14 @@
 #include "Common/CommonFuncs.h"
 #include "Common/Intrinsics.h"
 
+#include <xxhash.h>
+
 #ifdef _M_ARM_64
 #include <arm_acle.h>
 #endif
 
 static u64 (*ptrHashFunction)(const u8* src, u32 len, u32 samples) = nullptr;
+static bool s_hash64_samples = true;
 
 // uint32_t
 // WARNING - may read one more byte!
@@ -612,14 +615,42 @@ u64 GetHashHiresTexture(const u8* src, u32 len, u32 samples)
 }
 #endif
 
+u64 GetXXH3_64(const u8* src, size_t len, u64 seed)
+{
+  return XXH3_64bits_withSeed(src, len, seed);
+}
+
+Hash128 GetXXH3_128(const u8* src, size_t len, u64 seed)
+{
+  const XXH128_hash_t hash = XXH3_128bits_withSeed(src, len, seed);
+  return {hash.low64, hash.high64};
+}
+
+static u64 GetXXH3Hash64(const u8* src, u32 len, u32 samples)
+{
+  return GetXXH3_64(src, len);
+}
+
 u64 GetHash64(const u8* src, u32 len, u32 samples)
 {
   return ptrHashFunction(src, len, samples);
 }
 
+bool DoesHash64Sample()
+{
+  return s_hash64_samples;
+}
+
 // sets the hash function used for the texture cache
-void SetHash64Function()
+void SetHash64Function(Hash64Function function)
 {
+  s_hash64_samples = function == Hash64Function::Legacy;
+  if (function == Hash64Function::XXH3)
+  {
+    ptrHashFunction = &GetXXH3Hash64;
+    return;
+  }
+
 #if defined(_M_X86_64) || defined(_M_X86)
   if (cpu_info.bSSE4_2)  // sse crc32 version
   {
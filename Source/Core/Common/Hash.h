@@ -8,11 +8,32 @@
 
 #include "Common/CommonTypes.h"
 
+struct Hash128
+{
+  u64 low;
+  u64 high;
+};
+
+enum class Hash64Function
+{
+  // CRC32 where the CPU has an instruction for it, Murmur3 otherwise. Both hash only samples of
+  // the data when asked to.
+  Legacy,
+  // Fast enough to always hash all of the data.
+  XXH3,
+};
+
 u32 HashFletcher(const u8* data_u8, size_t length);  // FAST. Length & 1 == 0.
 u32 HashAdler32(const u8* data, size_t len);         // Fairly accurate, slightly slower
 u32 HashEctor(const u8* ptr, int length);            // JUNK. DO NOT USE FOR NEW THINGS
 u64 GetCRC32(const u8* src, u32 len, u32 samples);   // SSE4.2 version of CRC32
 u64 GetHashHiresTexture(const u8* src, u32 len, u32 samples = 0);
 u64 GetMurmurHash3(const u8* src, u32 len, u32 samples);
+// XXH3 from Externals/xxhash, with the default secret.
+u64 GetXXH3_64(const u8* src, size_t len, u64 seed = 0);
+Hash128 GetXXH3_128(const u8* src, size_t len, u64 seed = 0);
 u64 GetHash64(const u8* src, u32 len, u32 samples);
-void SetHash64Function();
+// Whether GetHash64 looks at only the samples of the data, for the callers that need to know if
+// equal hashes mean equal data.
+bool DoesHash64Sample();
+void SetHash64Function(Hash64Function function = Hash64Function::Legacy);
@@ -9,7 +9,10 @@
 #include <cstddef>
 #include <cstring>
 #include <fstream>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -292,9 +295,17 @@ bool IniFile::Section::GetLines(std::vector<std::string>* lines, const bool remo
 
 // IniFile
 
+void IniFile::MaterializeSections()
+{
+  if (!m_loaded_sections)
+    return;
+  sections = *m_loaded_sections;
+  m_loaded_sections.reset();
+}
+
 const IniFile::Section* IniFile::GetSection(const std::string& sectionName) const
 {
-  for (const Section& sect : sections)
+  for (const Section& sect : GetSections())
     if (!strcasecmp(sect.name.c_str(), sectionName.c_str()))
       return (&(sect));
   return nullptr;
@@ -302,6 +313,7 @@ const IniFile::Section* IniFile::GetSection(const std::string& sectionName) cons
 
 IniFile::Section* IniFile::GetSection(const std::string& sectionName)
 {
+  MaterializeSections();
   for (Section& sect : sections)
     if (!strcasecmp(sect.name.c_str(), sectionName.c_str()))
       return (&(sect));
@@ -390,83 +402,188 @@ bool IniFile::GetLines(const std::string& sectionName, std::vector<std::string>*
 
 void IniFile::SortSections()
 {
+  MaterializeSections();
   sections.sort();
 }
 
-bool IniFile::Load(const std::string& filename, bool keep_current_data)
+namespace
 {
-  if (!keep_current_data)
-    sections.clear();
-  // first section consists of the comments before the first real section
+// A part of the file being parsed, to avoid copying every line and key before it is kept.
+struct TextRange
+{
+  const char* begin;
+  const char* end;
 
-  // Open file
-  std::ifstream in;
-  File::OpenFStream(in, filename, std::ios::in);
+  bool empty() const { return begin == end; }
+  size_t size() const { return end - begin; }
+  std::string str() const { return std::string(begin, end); }
+};
 
-  if (in.fail())
-    return false;
+TextRange StripRangeSpaces(TextRange range)
+{
+  const auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+  while (!range.empty() && is_space(*range.begin))
+    range.begin++;
+  while (!range.empty() && is_space(range.end[-1]))
+    range.end--;
+  return range;
+}
 
-  Section* current_section = nullptr;
-  bool first_line = true;
-  while (!in.eof())
+TextRange StripRangeQuotes(TextRange range)
+{
+  if (!range.empty() && *range.begin == '"' && range.end[-1] == '"')
   {
-    std::string line;
+    range.begin++;
+    range.end = std::max(range.begin, range.end - 1);
+  }
+  return range;
+}
 
-    if (!std::getline(in, line))
-    {
-      if (in.eof())
-        return true;
-      else
-        return false;
-    }
+// Parsed files by path, for the game INIs that are loaded again and again. The modification time
+// and size tell when a file changed.
+struct CachedIniFile
+{
+  u64 modification_time;
+  u64 size;
+  std::list<IniFile::Section> sections;
+};
+
+// Only a few files are loaded repeatedly, the game list loads the INI of every game once.
+constexpr size_t MAX_CACHED_INI_FILES = 256;
+
+std::mutex s_cache_lock;
+std::map<std::string, std::shared_ptr<const CachedIniFile>> s_cache;
+}  // namespace
+
+std::list<IniFile::Section> IniFile::Parse(const std::string& contents)
+{
+  IniFile file;
+  Section* current_section = nullptr;
+  const char* position = contents.data();
+  const char* const end = position + contents.size();
 
-    // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
-    if (first_line && line.substr(0, 3) == "\xEF\xBB\xBF")
-      line = line.substr(3);
-    first_line = false;
+  // Skips the UTF-8 BOM at the start of files. Notepad likes to add this.
+  if (contents.compare(0, 3, "\xEF\xBB\xBF") == 0)
+    position += 3;
+
+  while (position < end)
+  {
+    const char* line_end = static_cast<const char*>(std::memchr(position, '\n', end - position));
+    if (!line_end)
+      line_end = end;
+    TextRange line{position, line_end};
+    position = line_end + 1;
 
-#ifndef _WIN32
     // Check for CRLF eol and convert it to LF
-    if (!line.empty() && line.back() == '\r')
-    {
-      line.pop_back();
-    }
-#endif
+    if (!line.empty() && line.end[-1] == '\r')
+      line.end--;
+    if (line.empty())
+      continue;
 
-    if (line.size() > 0)
+    if (*line.begin == '[')
     {
-      if (line[0] == '[')
+      const char* section_end = std::find(line.begin, line.end, ']');
+      if (section_end != line.end)
       {
-        size_t endpos = line.find(']');
-
-        if (endpos != std::string::npos)
-        {
-          // New section!
-          std::string sub = line.substr(1, endpos - 1);
-          current_section = GetOrCreateSection(sub);
-        }
+        // New section!
+        current_section = file.GetOrCreateSection(std::string(line.begin + 1, section_end));
       }
-      else
+      continue;
+    }
+    if (!current_section)
+      continue;
+
+    // The same as ParseLine, on the range.
+    TextRange key{line.begin, line.begin};
+    TextRange value = key;
+    if (*line.begin != '#')
+    {
+      const char* equals = std::find(line.begin, line.end, '=');
+      if (equals != line.end)
       {
-        if (current_section)
-        {
-          std::string key, value;
-          ParseLine(line, &key, &value);
-
-          // Lines starting with '$', '*' or '+' are kept verbatim.
-          // Kind of a hack, but the support for raw lines inside an
-          // INI is a hack anyway.
-          if ((key == "" && value == "") ||
-              (line.size() >= 1 && (line[0] == '$' || line[0] == '+' || line[0] == '*')))
-            current_section->m_lines.push_back(line);
-          else
-            current_section->Set(key, value);
-        }
+        key = StripRangeSpaces({line.begin, equals});
+        value = StripRangeQuotes(StripRangeSpaces({equals + 1, line.end}));
       }
     }
+
+    // Lines starting with '$', '*' or '+' are kept verbatim.
+    // Kind of a hack, but the support for raw lines inside an
+    // INI is a hack anyway.
+    if ((key.empty() && value.empty()) ||
+        (*line.begin == '$' || *line.begin == '+' || *line.begin == '*'))
+    {
+      current_section->m_lines.push_back(line.str());
+    }
+    else
+    {
+      current_section->Set(key.str(), value.str());
+    }
+  }
+  return std::move(file.sections);
+}
+
+bool IniFile::Load(const std::string& filename, bool keep_current_data)
+{
+  if (!keep_current_data)
+  {
+    sections.clear();
+    m_loaded_sections.reset();
   }
+  // first section consists of the comments before the first real section
 
-  in.close();
+  const File::FileInfo info(filename);
+  if (!info.IsFile())
+    return false;
+
+  std::shared_ptr<const CachedIniFile> cached;
+  {
+    std::lock_guard<std::mutex> guard(s_cache_lock);
+    const auto it = s_cache.find(filename);
+    if (it != s_cache.end() && it->second->modification_time == info.GetModificationTime() &&
+        it->second->size == info.GetSize())
+    {
+      cached = it->second;
+    }
+  }
+
+  if (!cached)
+  {
+    std::ifstream in;
+    File::OpenFStream(in, filename, std::ios::in | std::ios::binary);
+    if (in.fail())
+      return false;
+    std::string contents(static_cast<size_t>(info.GetSize()), '\0');
+    in.read(&contents[0], contents.size());
+    contents.resize(static_cast<size_t>(in.gcount()));
+    auto parsed = std::make_shared<CachedIniFile>();
+    parsed->modification_time = info.GetModificationTime();
+    parsed->size = info.GetSize();
+    parsed->sections = Parse(contents);
+    cached = parsed;
+
+    std::lock_guard<std::mutex> guard(s_cache_lock);
+    if (s_cache.size() >= MAX_CACHED_INI_FILES)
+      s_cache.clear();
+    s_cache[filename] = cached;
+  }
+
+  // The sections are shared with the cache until something changes them.
+  if (sections.empty() && !m_loaded_sections)
+  {
+    m_loaded_sections = std::shared_ptr<const std::list<Section>>(cached, &cached->sections);
+    return true;
+  }
+
+  // Merges the sections as if the file was parsed on top of the current ones.
+  MaterializeSections();
+  for (const Section& cached_section : cached->sections)
+  {
+    Section* section = GetOrCreateSection(cached_section.name);
+    for (const std::string& key : cached_section.keys_order)
+      section->Set(key, cached_section.values.at(key));
+    section->m_lines.insert(section->m_lines.end(), cached_section.m_lines.begin(),
+                            cached_section.m_lines.end());
+  }
   return true;
 }
 
@@ -481,7 +598,7 @@ bool IniFile::Save(const std::string& filename)
     return false;
   }
 
-  for (const Section& section : sections)
+  for (const Section& section : GetSections())
   {
     if (section.keys_order.size() != 0 || section.m_lines.size() != 0)
       out << '[' << section.name << ']' << std::endl;
@@ -503,7 +620,10 @@ bool IniFile::Save(const std::string& filename)
 
   out.close();
 
-  return File::RenameSync(temp, filename);
+  const bool renamed = File::RenameSync(temp, filename);
+  std::lock_guard<std::mutex> guard(s_cache_lock);
+  s_cache.erase(filename);
+  return renamed;
 }
 
 // Unit test. TODO: Move to the real unit test framework.
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -103,19 +104,20 @@ public:
   bool Exists(const std::string& sectionName, const std::string& key) const;
 
   template <typename T>
-  bool GetIfExists(const std::string& sectionName, const std::string& key, T* value)
+  bool GetIfExists(const std::string& sectionName, const std::string& key, T* value) const
   {
     if (Exists(sectionName, key))
-      return GetOrCreateSection(sectionName)->Get(key, value);
+      return GetSection(sectionName)->Get(key, value);
 
     return false;
   }
 
   template <typename T>
-  bool GetIfExists(const std::string& sectionName, const std::string& key, T* value, T defaultValue)
+  bool GetIfExists(const std::string& sectionName, const std::string& key, T* value,
+                   T defaultValue) const
   {
     if (Exists(sectionName, key))
-      return GetOrCreateSection(sectionName)->Get(key, value, defaultValue);
+      return GetSection(sectionName)->Get(key, value, defaultValue);
     else
       *value = defaultValue;
 
@@ -141,9 +143,20 @@ public:
   // In particular it is used in PostProcessing for its configuration
   static void ParseLine(const std::string& line, std::string* keyOut, std::string* valueOut);
 
-  const std::list<Section>& GetSections() const { return sections; }
+  const std::list<Section>& GetSections() const
+  {
+    return m_loaded_sections ? *m_loaded_sections : sections;
+  }
+
 private:
+  // Parses the contents of a file into sections.
+  static std::list<Section> Parse(const std::string& contents);
+  // Copies the sections shared with the cache of parsed files before they are changed.
+  void MaterializeSections();
+
   std::list<Section> sections;
+  // The sections of a loaded file as long as they are unchanged, sections is empty then.
+  std::shared_ptr<const std::list<Section>> m_loaded_sections;
 
   const Section* GetSection(const std::string& section) const;
   Section* GetSection(const std::string& section);
@@ -0,0 +1,100 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/LinearDiskCache.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Common/Thread.h"
+#include "Common/ThreadPlacement.h"
+
+namespace LinearDiskCacheWriter
+{
+namespace
+{
+class Writer
+{
+public:
+  ~Writer()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      if (!m_thread.joinable())
+        return;
+      m_quit = true;
+    }
+    m_work_available.notify_one();
+    m_thread.join();
+  }
+
+  void Queue(std::function<void()> write)
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      if (!m_thread.joinable())
+        m_thread = std::thread(&Writer::ThreadFunc, this);
+      m_queue.push_back(std::move(write));
+    }
+    m_work_available.notify_one();
+  }
+
+  void Flush()
+  {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+  }
+
+private:
+  void ThreadFunc()
+  {
+    Common::SetCurrentThreadName("Disk cache writer");
+    Common::PlaceCurrentThread(Common::ThreadRole::Worker);
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+      m_work_available.wait(lock, [this] { return m_quit || !m_queue.empty(); });
+      // Whatever is queued is written before quitting.
+      if (m_queue.empty())
+        return;
+      std::function<void()> write = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_busy = true;
+      lock.unlock();
+      write();
+      lock.lock();
+      m_busy = false;
+      if (m_queue.empty())
+        m_idle.notify_all();
+    }
+  }
+
+  std::mutex m_lock;
+  std::condition_variable m_work_available;
+  std::condition_variable m_idle;
+  std::deque<std::function<void()>> m_queue;
+  std::thread m_thread;
+  bool m_busy = false;
+  bool m_quit = false;
+};
+
+Writer& GetWriter()
+{
+  static Writer s_writer;
+  return s_writer;
+}
+}  // namespace
+
+void Queue(std::function<void()> write)
+{
+  GetWriter().Queue(std::move(write));
+}
+
+void Flush()
+{
+  GetWriter().Flush();
+}
+}  // namespace LinearDiskCacheWriter
@@ -4,27 +4,55 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
-// u32 'DCAC';
-// u32 version;  // svn_rev
+// u32 'DCA2';
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char version[40];  // scm_rev_cache_str unless the cache is opened with its own version
 //}
 
 // key_value_pair{
 // u32 value_size;
 // key_type   key;
 // value_type[value_size]   value;
+// u32 checksum;  // low half of the XXH3 of the fields above
+//}
+
+// The index, <filename>.idx, is written on Close:
+// index_header{
+// u32 'DCIX';
+// u32 entry_count;
+// u64 data_size;  // the part of the cache file the index covers
+// u32 last_checksum;  // of the last entry in that part, 0 if there is none
+// u32 superseded_count;  // entries in that part that were replaced by a newer one
+// header cache_header;
+//}
+
+// index_entry{  // entry_count of them, sorted by the bytes of the key
+// key_type key;
+// u32 value_size;
+// u64 offset;
 //}
 
 template <typename K, typename V>
@@ -34,14 +62,27 @@ public:
   virtual void Read(const K& key, const V* value, u32 value_size) = 0;
 };
 
-// Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+namespace LinearDiskCacheWriter
+{
+// Runs the writes of all disk caches in order on one background thread.
+void Queue(std::function<void()> write);
+// Waits until everything queued so far is written.
+void Flush();
+}
+
+// Unsorted key-value store with append functionality.
+// OpenAndRead passes every entry to a reader, Open only loads the index so that entries can be
+// looked up with Find and Get.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
-// Not tuned for extreme performance but should be reasonably fast.
+// Appended entries are written on a background thread, Sync and Close wait for them.
+// Entries that fail their checksum are dropped without affecting the others. A file with dropped
+// entries, or with many entries that were appended again under the same key, is rewritten with
+// only the newest copy of each key when it is opened.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
+// Append, Find and Get must not be called concurrently.
 
 // K and V are some POD type
 // K : the key type
@@ -50,11 +91,213 @@ template <typename K, typename V>
 class LinearDiskCache
 {
 public:
+  LinearDiskCache() = default;
+  LinearDiskCache(const LinearDiskCache&) = delete;
+  LinearDiskCache& operator=(const LinearDiskCache&) = delete;
+  ~LinearDiskCache() { Close(); }
+
   // return number of read entries
-  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader, std::string version = {})
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader,
+                  std::string version = {})
+  {
+    return OpenInternal(filename, &reader, version);
+  }
+
+  // Opens the file for Find and Get without reading the entries the index covers. Returns the
+  // number of keys in the file.
+  u32 Open(const std::string& filename, std::string version = {})
+  {
+    return OpenInternal(filename, nullptr, version);
+  }
+
+  bool Find(const K& key) const
+  {
+    Location location;
+    return FindEntry(ToKeyBytes(key), &location);
+  }
+
+  bool Get(const K& key, std::vector<V>* value)
+  {
+    const KeyBytes key_bytes = ToKeyBytes(key);
+    Location location;
+    if (!FindEntry(key_bytes, &location))
+      return false;
+
+    const u64 entry_size = GetEntrySize(location.value_size);
+    const u8* entry;
+    std::vector<u8> buffer;
+    if (location.offset + entry_size <= m_data.GetSize())
+    {
+      entry = m_data.GetData() + location.offset;
+    }
+    else
+    {
+      // Appended after the file was mapped.
+      if (location.offset + entry_size > m_written_size.load())
+        LinearDiskCacheWriter::Flush();
+      std::lock_guard<std::mutex> guard(m_file_lock);
+      buffer.resize(static_cast<size_t>(entry_size));
+      m_file.seekg(location.offset);
+      if (!m_file.read(reinterpret_cast<char*>(buffer.data()), buffer.size()))
+      {
+        m_file.clear();
+        return false;
+      }
+      entry = buffer.data();
+    }
+    if (!IsEntryValid(entry, entry_size) ||
+        std::memcmp(entry + sizeof(u32), key_bytes.data(), sizeof(K)) != 0)
+    {
+      return false;
+    }
+    value->resize(location.value_size);
+    if (location.value_size != 0)
+      std::memcpy(value->data(), entry + sizeof(u32) + sizeof(K), location.value_size * sizeof(V));
+    return true;
+  }
+
+  void Sync()
+  {
+    if (m_pending_writes)
+    {
+      LinearDiskCacheWriter::Flush();
+      m_pending_writes = false;
+    }
+    std::lock_guard<std::mutex> guard(m_file_lock);
+    m_file.flush();
+  }
+
+  void Close()
+  {
+    if (m_pending_writes)
+    {
+      LinearDiskCacheWriter::Flush();
+      m_pending_writes = false;
+    }
+    if (m_file.is_open())
+      m_file.close();
+    // clear any error flags
+    m_file.clear();
+    if (m_open && m_index_dirty)
+      WriteIndex();
+
+    m_data.Close();
+    m_index.Close();
+    m_index_count = 0;
+    m_unindexed.clear();
+    m_open = false;
+  }
+
+  // Appends a key-value pair to the store. The write happens in the background.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    if (!m_open)
+      return;
+
+    const u64 entry_size = GetEntrySize(value_size);
+    std::vector<u8> entry(static_cast<size_t>(entry_size));
+    std::memcpy(entry.data(), &value_size, sizeof(u32));
+    std::memcpy(entry.data() + sizeof(u32), &key, sizeof(K));
+    if (value_size != 0)
+      std::memcpy(entry.data() + sizeof(u32) + sizeof(K), value, value_size * sizeof(V));
+    const u32 checksum = GetChecksum(entry.data(), entry.size() - sizeof(u32));
+    std::memcpy(entry.data() + entry.size() - sizeof(u32), &checksum, sizeof(u32));
+
+    const KeyBytes key_bytes = ToKeyBytes(key);
+    Location location;
+    if (FindEntry(key_bytes, &location))
+      m_superseded_count++;
+    const u64 offset = m_file_size;
+    m_unindexed[key_bytes] = {offset, value_size};
+    m_file_size += entry_size;
+    m_last_checksum = checksum;
+    m_index_dirty = true;
+    m_pending_writes = true;
+
+    LinearDiskCacheWriter::Queue([this, offset, entry = std::move(entry)] {
+      std::lock_guard<std::mutex> guard(m_file_lock);
+      m_file.seekp(offset);
+      m_file.write(reinterpret_cast<const char*>(entry.data()), entry.size());
+      m_written_size.store(offset + entry.size());
+    });
+  }
+
+private:
+  using KeyBytes = std::array<u8, sizeof(K)>;
+
+  struct Location
+  {
+    u64 offset;
+    u32 value_size;
+  };
+
+  struct ScannedEntry
+  {
+    KeyBytes key;
+    Location location;
+  };
+
+  struct Header
+  {
+    void Init(const std::string& version)
+    {
+      // Null-terminator is intentionally not copied.
+      std::memcpy(&id, "DCA2", sizeof(u32));
+      std::memset(ver, 0, sizeof(ver));
+      std::memcpy(ver, version.c_str(), std::min(version.size(), sizeof(ver)));
+    }
+
+    u32 id;
+    const u16 key_t_size = sizeof(K);
+    const u16 value_t_size = sizeof(V);
+    char ver[40] = {};
+  };
+
+  struct IndexHeader
   {
-    using std::ios_base;
+    u32 id;
+    u32 entry_count;
+    u64 data_size;
+    u32 last_checksum;
+    u32 superseded_count;
+    char cache_header[sizeof(Header)];
+  };
 
+  static u64 GetEntrySize(u32 value_size)
+  {
+    return sizeof(u32) + sizeof(K) + static_cast<u64>(value_size) * sizeof(V) + sizeof(u32);
+  }
+
+  static u64 GetIndexEntrySize() { return sizeof(K) + sizeof(u32) + sizeof(u64); }
+  static u32 GetIndexId()
+  {
+    u32 id;
+    std::memcpy(&id, "DCIX", sizeof(u32));
+    return id;
+  }
+
+  static u32 GetChecksum(const u8* data, u64 size)
+  {
+    return static_cast<u32>(GetXXH3_64(data, static_cast<size_t>(size)));
+  }
+
+  static bool IsEntryValid(const u8* entry, u64 entry_size)
+  {
+    u32 checksum;
+    std::memcpy(&checksum, entry + entry_size - sizeof(u32), sizeof(u32));
+    return GetChecksum(entry, entry_size - sizeof(u32)) == checksum;
+  }
+
+  static KeyBytes ToKeyBytes(const K& key)
+  {
+    KeyBytes key_bytes;
+    std::memcpy(key_bytes.data(), &key, sizeof(K));
+    return key_bytes;
+  }
+
+  u32 OpenInternal(const std::string& filename, LinearDiskCacheReader<K, V>* reader,
+                   const std::string& version)
+  {
 // Since we're reading/writing directly to the storage of K instances,
 // K must be trivially copyable. TODO: Remove #if once GCC 5.0 is a
 // minimum requirement.
@@ -67,137 +310,342 @@ public:
 
     // close any currently opened file
     Close();
-    m_num_entries = 0;
-
-    // try opening for reading/writing
-    File::OpenFStream(m_file, filename, ios_base::in | ios_base::out | ios_base::binary);
+    m_filename = filename;
+    m_header.Init(version.empty() ? std::string(Common::scm_rev_cache_str) : version);
+    m_superseded_count = 0;
+    m_last_checksum = 0;
+    m_index_dirty = false;
 
-    m_file.seekg(0, std::ios::end);
-    std::fstream::pos_type end_pos = m_file.tellg();
-    m_file.seekg(0, std::ios::beg);
-    std::fstream::pos_type start_pos = m_file.tellg();
-    std::streamoff file_size = end_pos - start_pos;
-    if (version.empty())
+    u32 read_entries = 0;
+    if (m_data.Open(filename) && m_data.GetSize() >= sizeof(Header) &&
+        std::memcmp(m_data.GetData(), &m_header, sizeof(Header)) == 0)
     {
-    m_header.Init();
+      // Without a reader, only the entries appended after the index was written are read.
+      const u64 scan_start = !reader && LoadIndex() ? m_index_data_size : sizeof(Header);
+      if (scan_start == sizeof(Header))
+        m_index_dirty = true;
+      std::vector<ScannedEntry> entries;
+      u32 dropped = 0;
+      const u64 scan_end = Scan(scan_start, &entries, &dropped);
+      // A truncated entry at the end.
+      if (scan_end != m_data.GetSize())
+        dropped++;
+
+      Location location;
+      for (const ScannedEntry& entry : entries)
+      {
+        if (FindEntry(entry.key, &location))
+          m_superseded_count++;
+        m_unindexed[entry.key] = entry.location;
+      }
+      if (!entries.empty())
+      {
+        m_index_dirty = true;
+        std::memcpy(&m_last_checksum,
+                    m_data.GetData() + scan_end - sizeof(u32), sizeof(u32));
+      }
+
+      if (reader)
+      {
+        // Only the newest copy of each key is passed on, in the order of the file.
+        std::vector<V> aligned_value;
+        for (const ScannedEntry& entry : entries)
+        {
+          if (m_unindexed[entry.key].offset != entry.location.offset)
+            continue;
+          const u8* data = m_data.GetData() + entry.location.offset;
+          K key;
+          std::memcpy(&key, data + sizeof(u32), sizeof(K));
+          const u8* value = data + sizeof(u32) + sizeof(K);
+          const u32 value_size = entry.location.value_size;
+          if (reinterpret_cast<uintptr_t>(value) % alignof(V) != 0)
+          {
+            aligned_value.resize(value_size);
+            std::memcpy(aligned_value.data(), value, value_size * sizeof(V));
+            value = reinterpret_cast<const u8*>(aligned_value.data());
+          }
+          reader->Read(key, reinterpret_cast<const V*>(value), value_size);
+          read_entries++;
+        }
+      }
+
+      const u32 key_count = GetKeyCount();
+      if (dropped != 0 || m_superseded_count > key_count / 4)
+        Compact();
+      if (!reader)
+        read_entries = key_count;
+      m_file_size = m_data.GetSize();
+      m_written_size.store(m_file_size);
     }
     else
     {
-      m_header.Init(version);
+      // failed to open file for reading or bad header
+      // recreate file
+      m_data.Close();
+      std::ofstream file;
+      File::OpenFStream(file, filename, std::ios_base::out | std::ios_base::trunc |
+                                            std::ios_base::binary);
+      file.write(reinterpret_cast<const char*>(&m_header), sizeof(Header));
+      file.close();
+      File::Delete(filename + ".idx");
+      m_file_size = sizeof(Header);
+      m_written_size.store(m_file_size);
+      m_index_dirty = true;
     }
-    if (m_file.is_open() && ValidateHeader())
-    {
-      // good header, read some key/value pairs
-      K key;
-
-      V* value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
 
-      std::fstream::pos_type last_pos = m_file.tellg();
+    File::OpenFStream(m_file, filename,
+                      std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    m_open = m_file.is_open();
+    return read_entries;
+  }
 
-      while (Read(&value_size))
+  // Collects the valid entries from offset on. Returns where the last complete entry ends.
+  u64 Scan(u64 offset, std::vector<ScannedEntry>* entries, u32* dropped) const
+  {
+    const u8* data = m_data.GetData();
+    const u64 size = m_data.GetSize();
+    while (size - offset >= GetEntrySize(0))
+    {
+      u32 value_size;
+      std::memcpy(&value_size, data + offset, sizeof(u32));
+      const u64 entry_size = GetEntrySize(value_size);
+      if (entry_size > size - offset)
+        break;
+      if (IsEntryValid(data + offset, entry_size))
       {
-        std::streamoff next_extent = (last_pos - start_pos) + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        delete[] value;
-        value = new V[value_size];
-
-        // read key/value and pass to reader
-        if (Read(&key) && Read(value, value_size) && Read(&entry_number) &&
-            entry_number == m_num_entries + 1)
-        {
-          reader.Read(key, value, value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
-        last_pos = m_file.tellg();
+        ScannedEntry entry;
+        std::memcpy(entry.key.data(), data + offset + sizeof(u32), sizeof(K));
+        entry.location = {offset, value_size};
+        entries->push_back(entry);
       }
-      m_file.seekp(last_pos);
-      m_file.clear();
-
-      delete[] value;
-      return m_num_entries;
+      else
+      {
+        (*dropped)++;
+      }
+      offset += entry_size;
     }
+    return offset;
+  }
 
-    // failed to open file for reading or bad header
-    // close and recreate file
-    Close();
-    File::OpenFStream(m_file, filename, ios_base::out | ios_base::trunc | ios_base::binary);
-    WriteHeader();
-    return 0;
+  bool LoadIndex()
+  {
+    IndexHeader header;
+    if (!m_index.Open(m_filename + ".idx") || m_index.GetSize() < sizeof(IndexHeader))
+    {
+      m_index.Close();
+      return false;
+    }
+    std::memcpy(&header, m_index.GetData(), sizeof(IndexHeader));
+    // The index must describe the beginning of this very file, which the checksum of the entry
+    // before data_size confirms.
+    u32 last_checksum = 0;
+    if (header.data_size >= sizeof(Header) + GetEntrySize(0) &&
+        header.data_size <= m_data.GetSize())
+    {
+      std::memcpy(&last_checksum, m_data.GetData() + header.data_size - sizeof(u32),
+                  sizeof(u32));
+    }
+    if (header.id != GetIndexId() ||
+        std::memcmp(header.cache_header, &m_header, sizeof(Header)) != 0 ||
+        m_index.GetSize() != sizeof(IndexHeader) + header.entry_count * GetIndexEntrySize() ||
+        header.data_size < sizeof(Header) || header.data_size > m_data.GetSize() ||
+        last_checksum != header.last_checksum)
+    {
+      m_index.Close();
+      return false;
+    }
+    m_index_count = header.entry_count;
+    m_index_data_size = header.data_size;
+    m_last_checksum = header.last_checksum;
+    m_superseded_count = header.superseded_count;
+    return true;
   }
 
-  void Sync() { m_file.flush(); }
-  void Close()
+  const u8* GetIndexEntry(u32 i) const
   {
-    if (m_file.is_open())
-      m_file.close();
-    // clear any error flags
-    m_file.clear();
+    return m_index.GetData() + sizeof(IndexHeader) + i * GetIndexEntrySize();
   }
 
-  // Appends a key-value pair to the store.
-  void Append(const K& key, const V* value, u32 value_size)
+  Location GetIndexLocation(u32 i) const
   {
-    // TODO: Should do a check that we don't already have "key"? (I think each caller does that
-    // already.)
-    Write(&value_size);
-    Write(&key);
-    Write(value, value_size);
-    m_num_entries++;
-    Write(&m_num_entries);
+    const u8* entry = GetIndexEntry(i);
+    Location location;
+    std::memcpy(&location.value_size, entry + sizeof(K), sizeof(u32));
+    std::memcpy(&location.offset, entry + sizeof(K) + sizeof(u32), sizeof(u64));
+    return location;
   }
 
-private:
-  void WriteHeader() { Write(&m_header); }
-  bool ValidateHeader()
+  bool FindInIndex(const KeyBytes& key, Location* location) const
   {
-    char file_header[sizeof(Header)];
+    u32 first = 0;
+    u32 last = m_index_count;
+    while (first < last)
+    {
+      const u32 middle = first + (last - first) / 2;
+      const int order = std::memcmp(GetIndexEntry(middle), key.data(), sizeof(K));
+      if (order < 0)
+      {
+        first = middle + 1;
+      }
+      else if (order > 0)
+      {
+        last = middle;
+      }
+      else
+      {
+        *location = GetIndexLocation(middle);
+        return true;
+      }
+    }
+    return false;
+  }
 
-    return (Read(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
+  bool FindEntry(const KeyBytes& key, Location* location) const
+  {
+    auto it = m_unindexed.find(key);
+    if (it != m_unindexed.end())
+    {
+      *location = it->second;
+      return true;
+    }
+    return FindInIndex(key, location);
   }
 
-  template <typename D>
-  bool Write(const D* data, u32 count = 1)
+  u32 GetKeyCount() const
   {
-    return m_file.write(reinterpret_cast<const char*>(data), count * sizeof(D)).good();
+    u32 count = m_index_count;
+    Location location;
+    for (const auto& entry : m_unindexed)
+    {
+      if (!FindInIndex(entry.first, &location))
+        count++;
+    }
+    return count;
   }
 
-  template <typename D>
-  bool Read(D* data, u32 count = 1)
+  // The newest copy of each key, by key.
+  std::vector<ScannedEntry> GetLiveEntries() const
   {
-    return m_file.read(reinterpret_cast<char*>(data), count * sizeof(D)).good();
+    std::vector<ScannedEntry> entries;
+    entries.reserve(m_index_count + m_unindexed.size());
+    auto it = m_unindexed.begin();
+    for (u32 i = 0; i < m_index_count; i++)
+    {
+      ScannedEntry entry;
+      std::memcpy(entry.key.data(), GetIndexEntry(i), sizeof(K));
+      for (; it != m_unindexed.end() && it->first < entry.key; ++it)
+        entries.push_back({it->first, it->second});
+      if (it != m_unindexed.end() && it->first == entry.key)
+        continue;
+      entry.location = GetIndexLocation(i);
+      entries.push_back(entry);
+    }
+    for (; it != m_unindexed.end(); ++it)
+      entries.push_back({it->first, it->second});
+    return entries;
   }
 
-  struct Header
+  // Rewrites the file with only the newest copy of each key, in their original order.
+  void Compact()
   {
-    void Init(std::string version)
+    std::vector<ScannedEntry> entries = GetLiveEntries();
+    std::sort(entries.begin(), entries.end(), [](const ScannedEntry& a, const ScannedEntry& b) {
+      return a.location.offset < b.location.offset;
+    });
+
+    const std::string temp_filename = m_filename + ".tmp";
+    std::ofstream file;
+    File::OpenFStream(file, temp_filename,
+                      std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    file.write(reinterpret_cast<const char*>(&m_header), sizeof(Header));
+    u64 offset = sizeof(Header);
+    u32 last_checksum = 0;
+    for (ScannedEntry& entry : entries)
     {
-      // Null-terminator is intentionally not copied.
-      std::memcpy(&id, "DCAC", sizeof(u32));
-      std::memcpy(ver, version.c_str(), std::min(version.size(), sizeof(ver)));
+      const u64 entry_size = GetEntrySize(entry.location.value_size);
+      const u8* data = m_data.GetData() + entry.location.offset;
+      file.write(reinterpret_cast<const char*>(data), entry_size);
+      std::memcpy(&last_checksum, data + entry_size - sizeof(u32), sizeof(u32));
+      entry.location.offset = offset;
+      offset += entry_size;
     }
-    void Init()
+    file.close();
+
+    m_data.Close();
+    if (!file || !File::Rename(temp_filename, m_filename))
     {
-      // Null-terminator is intentionally not copied.
-      Init(Common::scm_rev_cache_str);
+      // Keep using the old file.
+      File::Delete(temp_filename);
+      m_data.Open(m_filename);
+      return;
     }
+    m_data.Open(m_filename);
+    m_index.Close();
+    m_index_count = 0;
+    m_unindexed.clear();
+    for (const ScannedEntry& entry : entries)
+      m_unindexed[entry.key] = entry.location;
+    m_last_checksum = last_checksum;
+    m_superseded_count = 0;
+    m_index_dirty = true;
+  }
 
-    u32 id;
-    const u16 key_t_size = sizeof(K);
-    const u16 value_t_size = sizeof(V);
-    char ver[40] = {};
+  void WriteIndex()
+  {
+    const std::vector<ScannedEntry> entries = GetLiveEntries();
+    m_index.Close();
+
+    IndexHeader header = {};
+    header.id = GetIndexId();
+    header.entry_count = static_cast<u32>(entries.size());
+    header.data_size = m_file_size;
+    header.last_checksum = m_last_checksum;
+    header.superseded_count = m_superseded_count;
+    std::memcpy(header.cache_header, &m_header, sizeof(Header));
+
+    std::vector<u8> data(static_cast<size_t>(sizeof(IndexHeader) +
+                                             entries.size() * GetIndexEntrySize()));
+    std::memcpy(data.data(), &header, sizeof(IndexHeader));
+    u8* out = data.data() + sizeof(IndexHeader);
+    for (const ScannedEntry& entry : entries)
+    {
+      std::memcpy(out, entry.key.data(), sizeof(K));
+      std::memcpy(out + sizeof(K), &entry.location.value_size, sizeof(u32));
+      std::memcpy(out + sizeof(K) + sizeof(u32), &entry.location.offset, sizeof(u64));
+      out += GetIndexEntrySize();
+    }
+
+    const std::string index_filename = m_filename + ".idx";
+    const std::string temp_filename = index_filename + ".tmp";
+    std::ofstream file;
+    File::OpenFStream(file, temp_filename,
+                      std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    file.close();
+    if (!file || !File::Rename(temp_filename, index_filename))
+      File::Delete(temp_filename);
+    m_index_dirty = false;
+  }
+
+  Header m_header;
+  std::string m_filename;
+  bool m_open = false;
 
-  } m_header;
+  // The file as it was when opened, or after compacting it.
+  Common::MappedFile m_data;
+  Common::MappedFile m_index;
+  u32 m_index_count = 0;
+  u64 m_index_data_size = 0;
+  // Entries the index doesn't cover, and those that replace an entry it does.
+  std::map<KeyBytes, Location> m_unindexed;
+  u32 m_superseded_count = 0;
+  u32 m_last_checksum = 0;
+  bool m_index_dirty = false;
 
+  // Appending takes place on the writer thread.
+  std::mutex m_file_lock;
   std::fstream m_file;
-  u32 m_num_entries;
+  u64 m_file_size = 0;
+  std::atomic<u64> m_written_size{0};
+  bool m_pending_writes = false;
 };
@@ -72,6 +72,10 @@ enum LOG_LEVELS
 
 static const char LOG_LEVEL_TO_CHAR[7] = "-NEWID";
 
+// Highest level logged for each log type, or 0 if nothing of that type gets logged. Kept up to
+// date by the LogManager, so that disabled log calls don't even evaluate their arguments.
+extern int g_max_levels[NUMBER_OF_LOGS];
+
 }  // namespace
 
 void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file, int line,
@@ -92,7 +96,7 @@ void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char*
 // Let the compiler optimize this out
 #define GENERIC_LOG(t, v, ...)                                                                     \
   {                                                                                                \
-    if (v <= MAX_LOGLEVEL)                                                                         \
+    if (v <= MAX_LOGLEVEL && v <= LogTypes::g_max_levels[t])                                       \
       GenericLog(v, t, __FILE__, __LINE__, __VA_ARGS__);                                           \
   }
 
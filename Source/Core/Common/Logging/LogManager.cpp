@@ -2,8 +2,11 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdarg>
 #include <cstring>
+#include <ctime>
 #include <mutex>
 #include <ostream>
 #include <string>
@@ -15,9 +18,16 @@
 #include "Common/Logging/Log.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/Timer.h"
 
 constexpr size_t MAX_MSGLEN = 1024;
+constexpr u32 LOG_RING_SIZE = 64;
+
+namespace LogTypes
+{
+int g_max_levels[NUMBER_OF_LOGS];
+}
 
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_FILE{
     {Config::System::Logger, "Options", "WriteToFile"}, false};
@@ -26,6 +36,8 @@ const Config::ConfigInfo<bool> LOGGER_WRITE_TO_CONSOLE{
 const Config::ConfigInfo<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
 const Config::ConfigInfo<int> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"}, 0};
+const Config::ConfigInfo<bool> LOGGER_ASYNCHRONOUS{
+    {Config::System::Logger, "Options", "Asynchronous"}, false};
 
 class FileLogListener : public LogListener
 {
@@ -64,6 +76,55 @@ void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char*
   va_end(args);
 }
 
+// Messages logged by one thread in asynchronous mode. Only the owning thread advances the write
+// index, and only the background thread advances the read index.
+struct LogManager::LogRing
+{
+  struct Record
+  {
+    std::chrono::system_clock::time_point time;
+    LogTypes::LOG_LEVELS level;
+    LogTypes::LOG_TYPE type;
+    const char* file;
+    int line;
+    char text[MAX_MSGLEN];
+  };
+
+  std::array<Record, LOG_RING_SIZE> records;
+  std::atomic<u32> read{0};
+  std::atomic<u32> write{0};
+  // Messages that didn't fit because the background thread fell behind.
+  std::atomic<u32> dropped{0};
+  // Set once the owning thread exited, so that the ring can be freed when empty.
+  std::atomic<bool> orphaned{false};
+};
+
+struct LogRingHolder
+{
+  ~LogRingHolder()
+  {
+    if (ring)
+      ring->orphaned = true;
+  }
+
+  std::shared_ptr<LogManager::LogRing> ring;
+  u32 instance_id = 0;
+};
+
+static thread_local LogRingHolder s_thread_log_ring;
+static std::atomic<u32> s_next_instance_id{1};
+
+static std::string FormatTime(std::chrono::system_clock::time_point time)
+{
+  const time_t seconds = std::chrono::system_clock::to_time_t(time);
+  const auto ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+
+  char tmp[6];
+  strftime(tmp, sizeof(tmp), "%M:%S", localtime(&seconds));
+  return StringFromFormat("%s:%03i", tmp, static_cast<int>(ms % 1000));
+}
+
 static size_t DeterminePathCutOffPoint()
 {
   constexpr const char* pattern = DIR_SEP "Source" DIR_SEP "Core" DIR_SEP;
@@ -73,7 +134,7 @@ static size_t DeterminePathCutOffPoint()
   return 0;
 }
 
-LogManager::LogManager()
+LogManager::LogManager() : m_instance_id(s_next_instance_id++)
 {
   // create log containers
   m_log[LogTypes::ACTIONREPLAY] = {"ActionReplay", "ActionReplay"};
@@ -147,12 +208,17 @@ LogManager::LogManager()
   for (LogContainer& container : m_log)
     container.m_enable = Config::Get(
         Config::ConfigInfo<bool>{{Config::System::Logger, "Logs", container.m_short_name}, false});
+  UpdateMaxLevels();
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+  SetAsynchronous(Config::Get(LOGGER_ASYNCHRONOUS));
 }
 
 LogManager::~LogManager()
 {
+  SetAsynchronous(false);
+  std::fill(std::begin(LogTypes::g_max_levels), std::end(LogTypes::g_max_levels), 0);
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -166,6 +232,7 @@ void LogManager::SaveSettings()
   Config::SetBaseOrCurrent(LOGGER_WRITE_TO_WINDOW,
                            IsListenerEnabled(LogListener::LOG_WINDOW_LISTENER));
   Config::SetBaseOrCurrent(LOGGER_VERBOSITY, static_cast<int>(GetLogLevel()));
+  Config::SetBaseOrCurrent(LOGGER_ASYNCHRONOUS, IsAsynchronous());
 
   for (const auto& container : m_log)
     Config::SetBaseOrCurrent({{Config::System::Logger, "Logs", container.m_short_name}, false},
@@ -186,6 +253,12 @@ void LogManager::LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE
   if (!IsEnabled(type, level) || !static_cast<bool>(m_listener_ids))
     return;
 
+  if (m_async.load(std::memory_order_relaxed))
+  {
+    PushRecord(level, type, file, line, format, args);
+    return;
+  }
+
   char temp[MAX_MSGLEN];
   CharArrayFromFormatV(temp, MAX_MSGLEN, format, args);
 
@@ -198,6 +271,166 @@ void LogManager::LogWithFullPath(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE
       m_listeners[listener_id]->Log(level, msg.c_str());
 }
 
+LogManager::LogRing* LogManager::GetThreadRing()
+{
+  if (s_thread_log_ring.instance_id != m_instance_id)
+  {
+    if (s_thread_log_ring.ring)
+      s_thread_log_ring.ring->orphaned = true;
+    s_thread_log_ring.ring = std::make_shared<LogRing>();
+    s_thread_log_ring.instance_id = m_instance_id;
+
+    std::lock_guard<std::mutex> lk(m_rings_lock);
+    m_rings.push_back(s_thread_log_ring.ring);
+  }
+  return s_thread_log_ring.ring.get();
+}
+
+void LogManager::PushRecord(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type,
+                            const char* file, int line, const char* format, va_list args)
+{
+  LogRing* ring = GetThreadRing();
+  const u32 write = ring->write.load(std::memory_order_relaxed);
+
+  // Never make the caller wait for slow listeners.
+  if (write - ring->read.load(std::memory_order_acquire) == LOG_RING_SIZE)
+  {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    // The arguments may not outlive the call, so the message text is formatted right away.
+    LogRing::Record& record = ring->records[write % LOG_RING_SIZE];
+    record.time = std::chrono::system_clock::now();
+    record.level = level;
+    record.type = type;
+    record.file = file;
+    record.line = line;
+    CharArrayFromFormatV(record.text, MAX_MSGLEN, format, args);
+    ring->write.store(write + 1, std::memory_order_release);
+  }
+
+  m_async_event.Set();
+}
+
+void LogManager::AsyncThreadFunc()
+{
+  Common::SetCurrentThreadName("Log thread");
+
+  while (m_async_running.IsSet())
+  {
+    m_async_event.Wait();
+    while (DrainRings())
+    {
+    }
+  }
+  DrainRings();
+}
+
+bool LogManager::DrainRings()
+{
+  std::vector<std::shared_ptr<LogRing>> rings;
+  {
+    std::lock_guard<std::mutex> lk(m_rings_lock);
+    m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+                                 [](const std::shared_ptr<LogRing>& ring) {
+                                   return ring->orphaned && ring->read == ring->write &&
+                                          ring->dropped == 0;
+                                 }),
+                  m_rings.end());
+    rings = m_rings;
+  }
+
+  bool wrote = false;
+  for (const auto& ring : rings)
+  {
+    const u32 dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped)
+    {
+      const std::string msg =
+          StringFromFormat("%s W[%s]: %u messages were dropped\n",
+                           Common::Timer::GetTimeFormatted().c_str(),
+                           GetShortName(LogTypes::MASTER_LOG), dropped);
+      Dispatch(LogTypes::LWARNING, msg.c_str());
+      wrote = true;
+    }
+  }
+
+  // Write the messages of all threads in the order they were logged in.
+  while (true)
+  {
+    LogRing* next = nullptr;
+    for (const auto& ring : rings)
+    {
+      const u32 read = ring->read.load(std::memory_order_relaxed);
+      if (read == ring->write.load(std::memory_order_acquire))
+        continue;
+      if (!next || ring->records[read % LOG_RING_SIZE].time <
+                       next->records[next->read % LOG_RING_SIZE].time)
+      {
+        next = ring.get();
+      }
+    }
+    if (!next)
+      break;
+
+    const u32 read = next->read.load(std::memory_order_relaxed);
+    const LogRing::Record& record = next->records[read % LOG_RING_SIZE];
+    const std::string msg = StringFromFormat(
+        "%s %s:%u %c[%s]: %s\n", FormatTime(record.time).c_str(), record.file, record.line,
+        LogTypes::LOG_LEVEL_TO_CHAR[(int)record.level], GetShortName(record.type), record.text);
+    Dispatch(record.level, msg.c_str());
+    next->read.store(read + 1, std::memory_order_release);
+    wrote = true;
+  }
+
+  return wrote;
+}
+
+void LogManager::Dispatch(LogTypes::LOG_LEVELS level, const char* msg)
+{
+  std::lock_guard<std::mutex> lk(m_listeners_lock);
+  for (auto listener_id : m_listener_ids)
+    if (m_listeners[listener_id])
+      m_listeners[listener_id]->Log(level, msg);
+}
+
+bool LogManager::IsAsynchronous() const
+{
+  return m_async;
+}
+
+void LogManager::SetAsynchronous(bool asynchronous)
+{
+  if (asynchronous == m_async)
+    return;
+
+  if (asynchronous)
+  {
+    m_async_running.Set();
+    m_async_thread = std::thread(&LogManager::AsyncThreadFunc, this);
+    m_async = true;
+  }
+  else
+  {
+    m_async = false;
+    m_async_running.Clear();
+    m_async_event.Set();
+    m_async_thread.join();
+    // Write what was logged while the thread was stopping.
+    DrainRings();
+  }
+}
+
+void LogManager::UpdateMaxLevels()
+{
+  for (size_t i = 0; i < m_log.size(); ++i)
+  {
+    const bool logged = m_log[i].m_enable && static_cast<bool>(m_listener_ids);
+    LogTypes::g_max_levels[i] = logged ? static_cast<int>(m_level) : 0;
+  }
+}
+
 LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
 {
   return m_level;
@@ -206,11 +439,13 @@ LogTypes::LOG_LEVELS LogManager::GetLogLevel() const
 void LogManager::SetLogLevel(LogTypes::LOG_LEVELS level)
 {
   m_level = level;
+  UpdateMaxLevels();
 }
 
 void LogManager::SetEnable(LogTypes::LOG_TYPE type, bool enable)
 {
   m_log[type].m_enable = enable;
+  UpdateMaxLevels();
 }
 
 bool LogManager::IsEnabled(LogTypes::LOG_TYPE type, LogTypes::LOG_LEVELS level) const
@@ -230,12 +465,17 @@ const char* LogManager::GetFullName(LogTypes::LOG_TYPE type) const
 
 void LogManager::RegisterListener(LogListener::LISTENER id, LogListener* listener)
 {
+  std::lock_guard<std::mutex> lk(m_listeners_lock);
   m_listeners[id] = listener;
 }
 
 void LogManager::EnableListener(LogListener::LISTENER id, bool enable)
 {
-  m_listener_ids[id] = enable;
+  {
+    std::lock_guard<std::mutex> lk(m_listeners_lock);
+    m_listener_ids[id] = enable;
+  }
+  UpdateMaxLevels();
 }
 
 bool LogManager::IsListenerEnabled(LogListener::LISTENER id) const
@@ -5,9 +5,16 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdarg>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Common/Logging/Log.h"
 
 // pure virtual interface
@@ -42,6 +49,11 @@ public:
   LogTypes::LOG_LEVELS GetLogLevel() const;
   void SetLogLevel(LogTypes::LOG_LEVELS level);
 
+  // In asynchronous mode, log calls only format the message into a ring buffer of the calling
+  // thread, and a background thread writes the messages to the listeners.
+  bool IsAsynchronous() const;
+  void SetAsynchronous(bool asynchronous);
+
   void SetEnable(LogTypes::LOG_TYPE type, bool enable);
   bool IsEnabled(LogTypes::LOG_TYPE type, LogTypes::LOG_LEVELS level = LogTypes::LNOTICE) const;
 
@@ -62,6 +74,9 @@ private:
     bool m_enable = false;
   };
 
+  struct LogRing;
+  friend struct LogRingHolder;
+
   LogManager();
   ~LogManager();
 
@@ -75,4 +90,25 @@ private:
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  void UpdateMaxLevels();
+  void Dispatch(LogTypes::LOG_LEVELS level, const char* msg);
+
+  LogRing* GetThreadRing();
+  void PushRecord(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type, const char* file, int line,
+                  const char* format, va_list args);
+  void AsyncThreadFunc();
+  bool DrainRings();
+
+  // Identifies this instance to the per-thread rings, which outlive it.
+  const u32 m_instance_id;
+  std::atomic<bool> m_async{false};
+  std::thread m_async_thread;
+  Common::Flag m_async_running;
+  Common::Event m_async_event;
+  // Guards the list of rings, which each thread adds its own to on its first asynchronous log.
+  std::mutex m_rings_lock;
+  std::vector<std::shared_ptr<LogRing>> m_rings;
+  // Keeps listeners from being replaced while the background thread writes to them.
+  std::mutex m_listeners_lock;
 };
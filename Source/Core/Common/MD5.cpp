@@ -2,13 +2,23 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
 #include <fstream>
 #include <functional>
 #include <mbedtls/md5.h>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <vector>
 
+#include "Common/Event.h"
+#include "Common/FileUtil.h"
 #include "Common/MD5.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "DiscIO/Blob.h"
 
 namespace MD5
@@ -49,4 +59,136 @@ std::string MD5Sum(const std::string& file_path, std::function<bool(int)> report
 
   return output_string;
 }
+
+// One line per file: size, modification time, sum and path, separated by spaces.
+static std::mutex s_tree_sum_cache_mutex;
+
+static std::string GetTreeSumCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "md5tree.cache";
+}
+
+static std::string FindCachedTreeSum(const std::string& file_path, u64 size, u64 modified)
+{
+  std::lock_guard<std::mutex> lock(s_tree_sum_cache_mutex);
+  std::ifstream cache;
+  File::OpenFStream(cache, GetTreeSumCachePath(), std::ios_base::in);
+  std::string line;
+  while (std::getline(cache, line))
+  {
+    std::istringstream entry(line);
+    u64 entry_size, entry_modified;
+    std::string entry_sum, entry_path;
+    if (entry >> entry_size >> entry_modified >> entry_sum && entry.get() == ' ' &&
+        std::getline(entry, entry_path) && entry_path == file_path && entry_size == size &&
+        entry_modified == modified)
+    {
+      return entry_sum;
+    }
+  }
+  return {};
+}
+
+static void CacheTreeSum(const std::string& file_path, u64 size, u64 modified,
+                         const std::string& sum)
+{
+  std::lock_guard<std::mutex> lock(s_tree_sum_cache_mutex);
+  std::vector<std::string> lines;
+  {
+    std::ifstream cache;
+    File::OpenFStream(cache, GetTreeSumCachePath(), std::ios_base::in);
+    std::string line;
+    const std::string path_suffix = " " + file_path;
+    while (std::getline(cache, line))
+    {
+      // Drop the outdated entry of this file
+      if (line.size() < path_suffix.size() ||
+          line.compare(line.size() - path_suffix.size(), path_suffix.size(), path_suffix) != 0)
+      {
+        lines.push_back(std::move(line));
+      }
+    }
+  }
+  lines.push_back(StringFromFormat("%" PRIu64 " %" PRIu64 " %s %s", size, modified, sum.c_str(),
+                                   file_path.c_str()));
+
+  std::ofstream cache;
+  File::OpenFStream(cache, GetTreeSumCachePath(), std::ios_base::out | std::ios_base::trunc);
+  for (const std::string& line : lines)
+    cache << line << '\n';
+}
+
+std::string MD5TreeSum(const std::string& file_path, std::function<bool(int)> report_progress)
+{
+  const File::FileInfo info(file_path);
+  const u64 file_size = info.GetSize();
+  const u64 modified = info.GetModificationTime();
+  std::string output_string = FindCachedTreeSum(file_path, file_size, modified);
+  if (!output_string.empty())
+  {
+    report_progress(100);
+    return output_string;
+  }
+
+  std::unique_ptr<DiscIO::BlobReader> file(DiscIO::CreateBlobReader(file_path));
+  if (!file)
+    return output_string;
+  const u64 game_size = file->GetDataSize();
+  const size_t num_chunks =
+      static_cast<size_t>((game_size + TREE_CHUNK_SIZE - 1) / TREE_CHUNK_SIZE);
+  std::vector<std::array<u8, 16>> chunk_sums(num_chunks);
+
+  // Every task has its own reader, so compressed images are also decompressed in parallel.
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<size_t> chunks_done{0};
+  // Set when the user aborts or a read fails
+  std::atomic<bool> stop{false};
+  Common::Event chunk_done;
+  auto worker = [&] {
+    std::unique_ptr<DiscIO::BlobReader> reader(DiscIO::CreateBlobReader(file_path));
+    std::vector<u8> data(TREE_CHUNK_SIZE);
+    for (size_t i = next_chunk++; i < num_chunks && !stop; i = next_chunk++)
+    {
+      const u64 offset = static_cast<u64>(i) * TREE_CHUNK_SIZE;
+      const size_t size = static_cast<size_t>(std::min<u64>(TREE_CHUNK_SIZE, game_size - offset));
+      if (!reader || !reader->Read(offset, size, data.data()))
+      {
+        stop = true;
+        chunk_done.Set();
+        return;
+      }
+      mbedtls_md5(data.data(), size, chunk_sums[i].data());
+      ++chunks_done;
+      chunk_done.Set();
+    }
+  };
+
+  // The calling thread reports the progress while the pool hashes.
+  Common::TaskGroup workers;
+  const size_t num_tasks = std::min(num_chunks, Common::ThreadPool::GetThreadCount());
+  for (size_t i = 0; i < num_tasks; ++i)
+    workers.Run(worker);
+
+  while (chunks_done < num_chunks && !stop)
+  {
+    chunk_done.Wait();
+    const int progress = static_cast<int>(chunks_done * 100 / num_chunks);
+    if (!report_progress(progress))
+      stop = true;
+  }
+  workers.Wait();
+  if (stop)
+    return output_string;
+
+  std::array<u8, 16> output;
+  mbedtls_md5(reinterpret_cast<const u8*>(chunk_sums.data()), chunk_sums.size() * 16,
+              output.data());
+
+  // Convert to hex
+  for (u8 n : output)
+    output_string += StringFromFormat("%02x", n);
+
+  CacheTreeSum(file_path, file_size, modified, output_string);
+  return output_string;
+}
 }
\ No newline at end of file
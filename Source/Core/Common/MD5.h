@@ -10,4 +10,10 @@
 namespace MD5
 {
 std::string MD5Sum(const std::string& file_name, std::function<bool(int)> progress);
-}
\ No newline at end of file
+
+// The MD5 of the MD5s of every TREE_CHUNK_SIZE bytes of the disc, which unlike MD5Sum can be
+// computed on all cores. Results are cached per file until its size or modification time changes.
+// Only comparable with other results of this function.
+constexpr size_t TREE_CHUNK_SIZE = 4 * 1024 * 1024;
+std::string MD5TreeSum(const std::string& file_name, std::function<bool(int)> progress);
+}
@@ -0,0 +1,102 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+// a bounded lockless thread-safe,
+// multiple producer, single consumer queue
+//
+// Every slot carries a sequence number that tells producers and the consumer whose turn it is,
+// so neither side ever takes a lock. A producer that finds the queue full spins until the
+// consumer catches up; the consumer never waits.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+
+namespace Common
+{
+template <typename T, size_t Capacity>
+class MPSCQueue
+{
+  static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  MPSCQueue()
+  {
+    for (size_t i = 0; i < Capacity; ++i)
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  // Safe to call from any number of threads at once.
+  bool TryPush(const T& t)
+  {
+    size_t pos = m_write_pos.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+      cell = &m_cells[pos & (Capacity - 1)];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const ptrdiff_t diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(pos);
+      if (diff == 0)
+      {
+        // The slot is free, try to claim it.
+        if (m_write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        // The consumer hasn't popped this slot since the last lap: full.
+        return false;
+      }
+      else
+      {
+        // Another producer claimed it first.
+        pos = m_write_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = t;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  void Push(const T& t)
+  {
+    while (!TryPush(t))
+      YieldCPU();
+  }
+
+  // Consumer only. Stops at the first slot that has been claimed but not written yet, which
+  // keeps the order the producers claimed their slots in.
+  bool Pop(T& t)
+  {
+    Cell& cell = m_cells[m_read_pos & (Capacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != m_read_pos + 1)
+      return false;
+
+    t = std::move(cell.value);
+    cell.sequence.store(m_read_pos + Capacity, std::memory_order_release);
+    m_read_pos++;
+    return true;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::array<Cell, Capacity> m_cells;
+
+  // Keep the producers' and the consumer's position on separate cache lines.
+  alignas(64) std::atomic<size_t> m_write_pos{0};
+  alignas(64) size_t m_read_pos = 0;
+};
+}  // namespace Common
@@ -0,0 +1,117 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/MappedFile.h"
+
+#include <cstdio>
+
+#include "Common/File.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+  Close();
+#ifdef _WIN32
+  // Sharing writes lets the owner of the file keep appending to it while it is mapped.
+  HANDLE file = CreateFile(UTF8ToTStr(filename).c_str(), GENERIC_READ,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  m_file_handle = file;
+  Map(file);
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  Map(fd);
+  // The mapping keeps the file referenced.
+  close(fd);
+#endif
+  if (!m_base)
+  {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+bool MappedFile::Open(File::IOFile& file)
+{
+  Close();
+  if (!file)
+    return false;
+#ifdef _WIN32
+  Map(reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle()))));
+#else
+  Map(fileno(file.GetHandle()));
+#endif
+  if (!m_base)
+  {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+#ifdef _WIN32
+void MappedFile::Map(void* file_handle)
+{
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart <= 0)
+    return;
+  m_size = static_cast<u64>(file_size.QuadPart);
+  m_mapping_handle = CreateFileMapping(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (m_mapping_handle)
+    m_base = static_cast<const u8*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+}
+#else
+void MappedFile::Map(int fd)
+{
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+    return;
+  m_size = static_cast<u64>(file_stat.st_size);
+  void* base = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_SHARED, fd, 0);
+  if (base != MAP_FAILED)
+    m_base = static_cast<const u8*>(base);
+}
+#endif
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+  if (m_base)
+    UnmapViewOfFile(m_base);
+  if (m_mapping_handle)
+    CloseHandle(m_mapping_handle);
+  if (m_file_handle)
+    CloseHandle(m_file_handle);
+  m_mapping_handle = nullptr;
+  m_file_handle = nullptr;
+#else
+  if (m_base)
+    munmap(const_cast<u8*>(m_base), static_cast<size_t>(m_size));
+#endif
+  m_base = nullptr;
+  m_size = 0;
+}
+}  // namespace Common
@@ -0,0 +1,50 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+}
+
+namespace Common
+{
+// A read-only view of a whole file. Empty files can't be mapped.
+class MappedFile final
+{
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  bool Open(const std::string& filename);
+  // Maps a file that is already open. The mapping doesn't need the file to stay open.
+  bool Open(File::IOFile& file);
+  void Close();
+
+  bool IsOpen() const { return m_base != nullptr; }
+  const u8* GetData() const { return m_base; }
+  u64 GetSize() const { return m_size; }
+
+private:
+#ifdef _WIN32
+  void Map(void* file_handle);
+#else
+  void Map(int fd);
+#endif
+
+  const u8* m_base = nullptr;
+  u64 m_size = 0;
+#ifdef _WIN32
+  void* m_file_handle = nullptr;
+  void* m_mapping_handle = nullptr;
+#endif
+};
+}  // namespace Common
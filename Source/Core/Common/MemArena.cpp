@@ -11,6 +11,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -104,6 +105,12 @@ void* MemArena::CreateView(s64 offset, size_t size, void* base)
   }
   else
   {
+#ifdef MADV_HUGEPAGE
+    // Shared memory only gets transparent huge pages when asked for, and only where the view and
+    // its offset in the segment are both aligned to them.
+    if (Common::AreHugePagesEnabled() && size >= Common::HUGE_PAGE_SIZE)
+      madvise(retval, size, MADV_HUGEPAGE);
+#endif
     return retval;
   }
 #endif
@@ -144,13 +151,20 @@ u8* MemArena::FindMemoryBase()
 #else
   const int flags = MAP_ANON | MAP_PRIVATE;
 #endif
-  void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  // With huge pages, the base is aligned to them so the views of the regions are too.
+  const size_t alignment = Common::AreHugePagesEnabled() ? Common::HUGE_PAGE_SIZE : 0;
+  void* base = mmap(nullptr, memory_size + alignment, PROT_NONE, flags, -1, 0);
   if (base == MAP_FAILED)
   {
     PanicAlert("Failed to map enough memory space: %s", LastStrerrorString().c_str());
     return nullptr;
   }
-  munmap(base, memory_size);
+  munmap(base, memory_size + alignment);
+  if (alignment)
+  {
+    return reinterpret_cast<u8*>((reinterpret_cast<uintptr_t>(base) + alignment - 1) &
+                                 ~(alignment - 1));
+  }
   return static_cast<u8*>(base);
 #endif
 }
@@ -2,8 +2,11 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "Common/CommonFuncs.h"
@@ -33,13 +36,108 @@ namespace Common
 // This is purposely not a full wrapper for virtualalloc/mmap, but it
 // provides exactly the primitive operations that Dolphin needs.
 
+static std::atomic<bool> s_huge_pages{false};
+
+void SetHugePagesEnabled(bool enabled)
+{
+  s_huge_pages.store(enabled);
+}
+
+bool AreHugePagesEnabled()
+{
+  return s_huge_pages.load();
+}
+
+#ifdef _WIN32
+// The protection of large pages can't be changed, protecting them is skipped instead.
+static std::mutex s_large_page_lock;
+static std::map<uintptr_t, size_t> s_large_page_allocations;
+
+static bool EnableLockMemoryPrivilege()
+{
+  HANDLE token;
+  if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    return false;
+  TOKEN_PRIVILEGES privileges{};
+  privileges.PrivilegeCount = 1;
+  privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  // AdjustTokenPrivileges succeeds with ERROR_NOT_ALL_ASSIGNED when the user lacks the privilege.
+  const bool result =
+      LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+      AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+      GetLastError() == ERROR_SUCCESS;
+  CloseHandle(token);
+  if (!result)
+    WARN_LOG(MEMMAP, "Large pages need the \"Lock pages in memory\" privilege, using normal pages");
+  return result;
+}
+
+static void* AllocateLargePages(size_t size, DWORD protect)
+{
+  static const size_t large_page_size = EnableLockMemoryPrivilege() ? GetLargePageMinimum() : 0;
+  if (!s_huge_pages.load() || !large_page_size || size < large_page_size)
+    return nullptr;
+  const size_t rounded_size = (size + large_page_size - 1) & ~(large_page_size - 1);
+  void* ptr =
+      VirtualAlloc(nullptr, rounded_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, protect);
+  if (!ptr)
+  {
+    // Physical memory gets too fragmented for large pages after a while.
+    INFO_LOG(MEMMAP, "Large page allocation failed: %s", GetLastErrorString().c_str());
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> guard(s_large_page_lock);
+  s_large_page_allocations[reinterpret_cast<uintptr_t>(ptr)] = rounded_size;
+  return ptr;
+}
+
+static bool IsInLargePages(void* ptr)
+{
+  std::lock_guard<std::mutex> guard(s_large_page_lock);
+  const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  auto it = s_large_page_allocations.upper_bound(address);
+  if (it == s_large_page_allocations.begin())
+    return false;
+  --it;
+  return address - it->first < it->second;
+}
+#else
+// Maps size bytes aligned to HUGE_PAGE_SIZE, so that the whole range can use huge pages.
+static void* MapHugePages(size_t size, int prot)
+{
+#ifdef MADV_HUGEPAGE
+  if (!s_huge_pages.load() || size < HUGE_PAGE_SIZE)
+    return nullptr;
+  const size_t padded_size = size + HUGE_PAGE_SIZE;
+  void* raw = mmap(nullptr, padded_size, prot, MAP_ANON | MAP_PRIVATE, -1, 0);
+  if (raw == MAP_FAILED)
+    return nullptr;
+  u8* const start = static_cast<u8*>(raw);
+  u8* const aligned = reinterpret_cast<u8*>(
+      (reinterpret_cast<uintptr_t>(start) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+  if (aligned != start)
+    munmap(start, aligned - start);
+  if (start + padded_size != aligned + size)
+    munmap(aligned + size, start + padded_size - (aligned + size));
+  // Only a hint, with transparent huge pages off it does nothing.
+  madvise(aligned, size, MADV_HUGEPAGE);
+  return aligned;
+#else
+  return nullptr;
+#endif
+}
+#endif
+
 void* AllocateExecutableMemory(size_t size)
 {
 #if defined(_WIN32)
-  void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+  void* ptr = AllocateLargePages(size, PAGE_EXECUTE_READWRITE);
+  if (!ptr)
+    ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
 #else
-  void* ptr =
-      mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_ANON | MAP_PRIVATE, -1, 0);
+  void* ptr = MapHugePages(size, PROT_READ | PROT_WRITE | PROT_EXEC);
+  if (!ptr)
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_ANON | MAP_PRIVATE, -1, 0);
 
   if (ptr == MAP_FAILED)
     ptr = nullptr;
@@ -89,6 +187,10 @@ void FreeMemoryPages(void* ptr, size_t size)
   if (ptr)
   {
 #ifdef _WIN32
+    {
+      std::lock_guard<std::mutex> guard(s_large_page_lock);
+      s_large_page_allocations.erase(reinterpret_cast<uintptr_t>(ptr));
+    }
     if (!VirtualFree(ptr, 0, MEM_RELEASE))
       PanicAlert("FreeMemoryPages failed!\nVirtualFree: %s", GetLastErrorString().c_str());
 #else
@@ -125,6 +227,8 @@ void ReadProtectMemory(void* ptr, size_t size)
 void WriteProtectMemory(void* ptr, size_t size, bool allowExecute)
 {
 #ifdef _WIN32
+  if (IsInLargePages(ptr))
+    return;
   DWORD oldValue;
   if (!VirtualProtect(ptr, size, allowExecute ? PAGE_EXECUTE_READ : PAGE_READONLY, &oldValue))
     PanicAlert("WriteProtectMemory failed!\nVirtualProtect: %s", GetLastErrorString().c_str());
@@ -137,6 +241,8 @@ void WriteProtectMemory(void* ptr, size_t size, bool allowExecute)
 void UnWriteProtectMemory(void* ptr, size_t size, bool allowExecute)
 {
 #ifdef _WIN32
+  if (IsInLargePages(ptr))
+    return;
   DWORD oldValue;
   if (!VirtualProtect(ptr, size, allowExecute ? PAGE_EXECUTE_READWRITE : PAGE_READWRITE, &oldValue))
     PanicAlert("UnWriteProtectMemory failed!\nVirtualProtect: %s", GetLastErrorString().c_str());
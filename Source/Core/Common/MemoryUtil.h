@@ -9,6 +9,13 @@
 
 namespace Common
 {
+// Backs the allocations of at least HUGE_PAGE_SIZE made from now on with huge pages where the OS
+// allows, falling back to normal pages: transparent huge pages on Linux, and large pages on Windows
+// when the user has the "Lock pages in memory" privilege.
+constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+void SetHugePagesEnabled(bool enabled);
+bool AreHugePagesEnabled();
+
 void* AllocateExecutableMemory(size_t size);
 void* AllocateMemoryPages(size_t size);
 void FreeMemoryPages(void* ptr, size_t size);
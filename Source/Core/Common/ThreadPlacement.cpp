@@ -0,0 +1,293 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/ThreadPlacement.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "Common/Logging/Log.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef __linux__
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __APPLE__
+#include <pthread/qos.h>
+#endif
+
+namespace Common
+{
+static std::mutex s_lock;
+static ThreadPlacement s_placement = ThreadPlacement::Off;
+static std::vector<ThreadRole> s_dedicated_roles;
+static std::vector<PhysicalCore> s_cores;
+static bool s_cores_detected = false;
+static std::atomic<u32> s_generation{0};
+
+static thread_local bool s_placed = false;
+
+#ifdef __linux__
+// Parses lists like "0-3,8,10-11".
+static u64 ParseCPUList(const std::string& list)
+{
+  u64 mask = 0;
+  size_t pos = 0;
+  while (pos < list.size())
+  {
+    unsigned int first, last;
+    int length;
+    if (std::sscanf(list.c_str() + pos, "%u-%u%n", &first, &last, &length) != 2)
+    {
+      if (std::sscanf(list.c_str() + pos, "%u%n", &first, &length) != 1)
+        break;
+      last = first;
+    }
+    for (unsigned int cpu = first; cpu <= last && cpu < 64; cpu++)
+      mask |= 1ull << cpu;
+    pos += length + 1;
+  }
+  return mask;
+}
+
+static bool ReadSysfsLine(const std::string& path, std::string* line)
+{
+  std::ifstream file(path);
+  return file && std::getline(file, *line);
+}
+#endif
+
+std::vector<PhysicalCore> DetectCPUTopology()
+{
+  std::vector<PhysicalCore> cores;
+#ifdef _WIN32
+  DWORD length = 0;
+  GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+  std::vector<u8> buffer(length);
+  if (!GetLogicalProcessorInformationEx(
+          RelationProcessorCore,
+          reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length))
+  {
+    return {};
+  }
+  for (DWORD offset = 0; offset < length;)
+  {
+    const auto* info =
+        reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+    // Threads are only placed within the first processor group.
+    if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+      cores.push_back({info->Processor.GroupMask[0].Mask, info->Processor.EfficiencyClass});
+    offset += info->Size;
+  }
+#elif defined __linux__
+  // Intel hybrid CPUs list their E-cores here, ARM big.LITTLE reports the capacity of each CPU.
+  std::string line;
+  const u64 atom_mask =
+      ReadSysfsLine("/sys/devices/cpu_atom/cpus", &line) ? ParseCPUList(line) : 0;
+  u64 seen = 0;
+  for (u32 cpu = 0; cpu < 64; cpu++)
+  {
+    const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    if ((seen >> cpu) & 1 || !ReadSysfsLine(path + "/topology/thread_siblings_list", &line))
+      continue;
+    const u64 mask = ParseCPUList(line) | (1ull << cpu);
+    seen |= mask;
+    u32 performance = (atom_mask >> cpu) & 1 ? 0 : 1;
+    if (ReadSysfsLine(path + "/cpu_capacity", &line))
+      performance = static_cast<u32>(std::strtoul(line.c_str(), nullptr, 10));
+    cores.push_back({mask, performance});
+  }
+#endif
+  std::stable_sort(cores.begin(), cores.end(), [](const PhysicalCore& a, const PhysicalCore& b) {
+    return a.performance > b.performance;
+  });
+  return cores;
+}
+
+void SetThreadPlacement(ThreadPlacement placement, const std::vector<ThreadRole>& dedicated_roles)
+{
+  std::lock_guard<std::mutex> guard(s_lock);
+  if (!s_cores_detected && placement == ThreadPlacement::Dedicated)
+  {
+    s_cores = DetectCPUTopology();
+    s_cores_detected = true;
+    const bool hybrid =
+        !s_cores.empty() && s_cores.front().performance != s_cores.back().performance;
+    INFO_LOG(COMMON, "Thread placement: %zu physical cores%s", s_cores.size(),
+             hybrid ? ", hybrid" : "");
+  }
+  if (placement == ThreadPlacement::Dedicated && s_cores.size() < 2)
+    WARN_LOG(COMMON, "Thread placement: too few physical cores to dedicate any");
+  s_placement = placement;
+  s_dedicated_roles = dedicated_roles;
+  s_generation.fetch_add(1);
+}
+
+u32 GetThreadPlacementGeneration()
+{
+  return s_generation.load(std::memory_order_relaxed);
+}
+
+// 0 leaves the thread on every CPU.
+static u64 GetAffinityMask(ThreadRole role)
+{
+  if (s_placement != ThreadPlacement::Dedicated || s_cores.size() < 2)
+    return 0;
+  // Each dedicated role takes the next fastest core, as long as one is left for everything else.
+  const size_t dedicated = std::min(s_dedicated_roles.size(), s_cores.size() - 1);
+  for (size_t i = 0; i < dedicated; i++)
+  {
+    if (s_dedicated_roles[i] == role)
+      return s_cores[i].logical_mask;
+  }
+  u64 mask = 0;
+  for (size_t i = dedicated; i < s_cores.size(); i++)
+    mask |= s_cores[i].logical_mask;
+  return mask;
+}
+
+static u64 GetAllCoresMask()
+{
+  u64 mask = 0;
+  for (const PhysicalCore& core : s_cores)
+    mask |= core.logical_mask;
+  return mask;
+}
+
+static void SetCurrentThreadAffinityMask(u64 mask)
+{
+  if (!mask)
+    return;
+#ifdef _WIN32
+  SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask));
+#elif defined __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int i = 0; i < 64; i++)
+  {
+    if ((mask >> i) & 1)
+      CPU_SET(i, &cpu_set);
+  }
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#endif
+}
+
+#ifdef _WIN32
+// MMCSS raises the thread above normal applications without the starvation of realtime
+// priorities. avrt.dll is loaded on demand so Dolphin doesn't need to link it.
+using AvSetMmThreadCharacteristicsWFunc = HANDLE(WINAPI*)(LPCWSTR, LPDWORD);
+using AvRevertMmThreadCharacteristicsFunc = BOOL(WINAPI*)(HANDLE);
+static thread_local HANDLE s_mmcss_handle = nullptr;
+
+static void SetCurrentThreadPriority(ThreadRole role, bool reset)
+{
+  static const HMODULE avrt = LoadLibraryW(L"avrt.dll");
+  static const auto set_characteristics =
+      avrt ? reinterpret_cast<AvSetMmThreadCharacteristicsWFunc>(
+                 GetProcAddress(avrt, "AvSetMmThreadCharacteristicsW")) :
+             nullptr;
+  static const auto revert_characteristics =
+      avrt ? reinterpret_cast<AvRevertMmThreadCharacteristicsFunc>(
+                 GetProcAddress(avrt, "AvRevertMmThreadCharacteristics")) :
+             nullptr;
+  if (s_mmcss_handle && revert_characteristics)
+    revert_characteristics(s_mmcss_handle);
+  s_mmcss_handle = nullptr;
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_NORMAL);
+  if (reset)
+    return;
+
+  if (role == ThreadRole::Worker)
+  {
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+    return;
+  }
+  DWORD task_index = 0;
+  if (set_characteristics)
+    s_mmcss_handle = set_characteristics(role == ThreadRole::Audio ? L"Pro Audio" : L"Games",
+                                         &task_index);
+  if (!s_mmcss_handle)
+  {
+    SetThreadPriority(GetCurrentThread(), role == ThreadRole::Audio ? THREAD_PRIORITY_HIGHEST :
+                                                                      THREAD_PRIORITY_ABOVE_NORMAL);
+  }
+}
+#elif defined __linux__
+static void SetCurrentThreadPriority(ThreadRole role, bool reset)
+{
+  const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+  sched_param param{};
+  pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+  setpriority(PRIO_PROCESS, tid, 0);
+  if (reset)
+    return;
+
+  // SCHED_BATCH only tells the scheduler the thread isn't interactive, it needs no privileges.
+  if (role == ThreadRole::Worker)
+  {
+    pthread_setschedparam(pthread_self(), SCHED_BATCH, &param);
+    return;
+  }
+  // Realtime scheduling and negative nice values need CAP_SYS_NICE or an RLIMIT_RTPRIO/NICE.
+  if (role == ThreadRole::Audio)
+  {
+    param.sched_priority = sched_get_priority_min(SCHED_RR);
+    if (pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0)
+      return;
+  }
+  if (setpriority(PRIO_PROCESS, tid, role == ThreadRole::Audio ? -10 : -5) != 0)
+  {
+    static std::once_flag warned;
+    std::call_once(warned, [] {
+      INFO_LOG(COMMON, "Thread placement: not allowed to raise thread priorities");
+    });
+  }
+}
+#elif defined __APPLE__
+static void SetCurrentThreadPriority(ThreadRole role, bool reset)
+{
+  qos_class_t qos_class = QOS_CLASS_DEFAULT;
+  if (!reset)
+    qos_class = role == ThreadRole::Worker ? QOS_CLASS_UTILITY : QOS_CLASS_USER_INTERACTIVE;
+  pthread_set_qos_class_self_np(qos_class, 0);
+}
+#else
+static void SetCurrentThreadPriority(ThreadRole role, bool reset)
+{
+}
+#endif
+
+void PlaceCurrentThread(ThreadRole role)
+{
+  std::lock_guard<std::mutex> guard(s_lock);
+  if (s_placement == ThreadPlacement::Off)
+  {
+    if (!s_placed)
+      return;
+    SetCurrentThreadAffinityMask(GetAllCoresMask());
+    SetCurrentThreadPriority(role, true);
+    s_placed = false;
+    return;
+  }
+  const u64 mask = GetAffinityMask(role);
+  SetCurrentThreadAffinityMask(mask ? mask : s_placed ? GetAllCoresMask() : 0);
+  SetCurrentThreadPriority(role, false);
+  s_placed = true;
+}
+
+}  // namespace Common
@@ -0,0 +1,56 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+enum class ThreadRole
+{
+  CPU,
+  GPU,
+  DSP,
+  Audio,
+  // The thread pool and other background work.
+  Worker,
+};
+
+enum class ThreadPlacement
+{
+  // The OS decides.
+  Off,
+  // Emulation and audio threads get a higher priority, workers a lower one.
+  Priority,
+  // Priorities, plus a physical core of its own for each emulation thread. Everything else
+  // shares the remaining cores.
+  Dedicated,
+};
+
+struct PhysicalCore
+{
+  // The logical CPUs of the core, more than one with SMT. Only the first 64 logical CPUs are
+  // looked at.
+  u64 logical_mask;
+  // Higher is faster. Only differs between the cores of hybrid CPUs.
+  u32 performance;
+};
+
+// The physical cores, fastest first. Empty when the OS doesn't tell.
+std::vector<PhysicalCore> DetectCPUTopology();
+
+// Sets the policy for the threads placed from now on. dedicated_roles are the emulation threads
+// that get a core of their own with ThreadPlacement::Dedicated, in order of importance.
+void SetThreadPlacement(ThreadPlacement placement, const std::vector<ThreadRole>& dedicated_roles);
+// Changes with each SetThreadPlacement, for long lived threads to place themselves again.
+u32 GetThreadPlacementGeneration();
+
+// Applies the policy to the calling thread, at the start of the thread. Undoes an earlier
+// placement of the thread when the policy is off.
+void PlaceCurrentThread(ThreadRole role);
+
+}  // namespace Common
@@ -1,17 +1,30 @@
+#include <algorithm>
+#include <chrono>
+
 #include "Common/Common.h"
 #include "Common/CPUDetect.h"
+#include "Common/Event.h"
+#include "Common/ThreadPlacement.h"
 #include "Common/ThreadPool.h"
+#include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 #ifdef _WIN32
 #include <windows.h>
 #endif
 using namespace Common;
 std::mutex ThreadPool::m_workerLock;
 
-ThreadPool::ThreadPool() : m_workflag(0), m_workercount(0), m_workers(16)
+// The index of the worker running on this thread.
+static constexpr size_t NOT_A_WORKER = SIZE_MAX;
+static thread_local size_t s_worker_id = NOT_A_WORKER;
+
+ThreadPool::ThreadPool() : m_workflag(0), m_workercount(0), m_workers(16), m_pending_tasks(0)
 {
   m_working.store(true);
   int workers = cpu_info.logical_cpu_count - 2;
   workers = workers < 1 ? 1 : workers;
+  for (int i = 0; i < workers; i++)
+    m_queues.push_back(std::make_unique<WorkerQueue>());
   for (size_t i = 0; i < workers; i++)
   {
     std::thread* current = new std::thread(&ThreadPool::Workloop, std::ref(*this), i);
@@ -25,6 +38,7 @@ ThreadPool::ThreadPool() : m_workflag(0), m_workercount(0), m_workers(16)
 ThreadPool::~ThreadPool()
 {
   m_working.store(false);
+  WakeWorkers(true);
   for (u32 i = 0; i < m_workerThreads.size(); i++)
   {
     std::thread* current = m_workerThreads[i].get();
@@ -43,7 +57,156 @@ ThreadPool& ThreadPool::Getinstance()
 
 void ThreadPool::NotifyWorkPending()
 {
-  ThreadPool::Getinstance().m_workflag.fetch_add(2);
+  ThreadPool& instance = ThreadPool::Getinstance();
+  instance.m_workflag.fetch_add(2);
+  instance.WakeWorkers(true);
+}
+
+void ThreadPool::WakeWorkers(bool all)
+{
+  // Taking the lock keeps a worker from missing the wake up between its check and its wait.
+  {
+    std::lock_guard<std::mutex> guard(m_wake_lock);
+  }
+  if (all)
+    m_wake.notify_all();
+  else
+    m_wake.notify_one();
+}
+
+bool ThreadPool::IsWorkerThread()
+{
+  return s_worker_id != NOT_A_WORKER;
+}
+
+void ThreadPool::Submit(std::function<void()> task, TaskPriority priority)
+{
+  ThreadPool& instance = ThreadPool::Getinstance();
+  // Counted first, a worker that finds the queue still empty just looks again.
+  instance.m_pending_tasks.fetch_add(1);
+  if (priority == TaskPriority::Normal && s_worker_id < instance.m_queues.size())
+  {
+    WorkerQueue& queue = *instance.m_queues[s_worker_id];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.tasks.push_back(std::move(task));
+  }
+  else
+  {
+    std::lock_guard<std::mutex> guard(instance.m_shared_lock);
+    instance.m_shared_queues[static_cast<size_t>(priority)].push_back(std::move(task));
+  }
+  instance.WakeWorkers(false);
+}
+
+bool ThreadPool::PopTask(size_t ID, bool background, std::function<void()>* task)
+{
+  if (m_pending_tasks.load() <= 0)
+    return false;
+  // Newest first from the own deque, as its data is the most likely to still be in the cache.
+  {
+    WorkerQueue& queue = *m_queues[ID];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (!queue.tasks.empty())
+    {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      m_pending_tasks.fetch_sub(1);
+      return true;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(m_shared_lock);
+    auto& normal = m_shared_queues[static_cast<size_t>(TaskPriority::Normal)];
+    if (!normal.empty())
+    {
+      *task = std::move(normal.front());
+      normal.pop_front();
+      m_pending_tasks.fetch_sub(1);
+      return true;
+    }
+  }
+  // Oldest first from the others, which tend to be the largest pieces of work.
+  for (size_t i = 1; i < m_queues.size(); i++)
+  {
+    WorkerQueue& queue = *m_queues[(ID + i) % m_queues.size()];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (!queue.tasks.empty())
+    {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      m_pending_tasks.fetch_sub(1);
+      return true;
+    }
+  }
+  if (!background)
+    return false;
+  std::lock_guard<std::mutex> guard(m_shared_lock);
+  auto& queue = m_shared_queues[static_cast<size_t>(TaskPriority::Background)];
+  if (queue.empty())
+    return false;
+  *task = std::move(queue.front());
+  queue.pop_front();
+  m_pending_tasks.fetch_sub(1);
+  return true;
+}
+
+bool ThreadPool::RunPendingTask()
+{
+  if (!IsWorkerThread())
+    return false;
+  std::function<void()> task;
+  if (!Getinstance().PopTask(s_worker_id, false, &task))
+    return false;
+  TRACE_SCOPE("Worker", "Task");
+  task();
+  return true;
+}
+
+void ThreadPool::ParallelFor(size_t begin, size_t end, size_t grain,
+                             const std::function<void(size_t, size_t)>& func)
+{
+  if (end <= begin)
+    return;
+  grain = std::max<size_t>(grain, 1);
+  const size_t ranges = (end - begin + grain - 1) / grain;
+  const size_t helpers = std::min(ranges - 1, GetThreadCount());
+  if (helpers == 0)
+  {
+    func(begin, end);
+    return;
+  }
+
+  // Helpers that only start after the last range was taken still look at the state, so they
+  // share it instead of it living on the stack.
+  struct State
+  {
+    std::atomic<size_t> next_range{0};
+    std::atomic<size_t> finished_ranges{0};
+    Common::Event done;
+  };
+  auto state = std::make_shared<State>();
+  const auto run_ranges = [=, &func] {
+    // func is gone once the last range finished, but by then there is no range left to take.
+    size_t range;
+    while ((range = state->next_range.fetch_add(1)) < ranges)
+    {
+      const size_t first = begin + range * grain;
+      func(first, std::min(first + grain, end));
+      if (state->finished_ranges.fetch_add(1) + 1 == ranges)
+        state->done.Set();
+    }
+  };
+  for (size_t i = 0; i < helpers; i++)
+  {
+    Submit(run_ranges, TaskPriority::Normal);
+  }
+  run_ranges();
+  // A helper that never got to run doesn't hold anything up, only the ranges in progress do.
+  while (state->finished_ranges.load() < ranges)
+  {
+    if (!RunPendingTask())
+      state->done.WaitFor(std::chrono::milliseconds(1));
+  }
 }
 
 void ThreadPool::RegisterWorker(IWorker* worker)
@@ -77,12 +240,27 @@ void ThreadPool::UnregisterWorker(IWorker* worker)
 
 void ThreadPool::Workloop(ThreadPool &state, size_t ID)
 {
-  u32 rest_time = 1;
+  s_worker_id = ID;
+  SetCurrentThreadName(StringFromFormat("Worker thread %zu", ID).c_str());
+  u32 placement_generation = 0;
   while (state.m_working.load())
   {
+    if (placement_generation != GetThreadPlacementGeneration())
+    {
+      placement_generation = GetThreadPlacementGeneration();
+      PlaceCurrentThread(ThreadRole::Worker);
+    }
+    bool worked = false;
+    std::function<void()> task;
+    if (state.PopTask(ID, true, &task))
+    {
+      TRACE_SCOPE("Worker", "Task");
+      task();
+      worked = true;
+    }
     if (state.m_workflag.load() > ID)
     {
-      bool worked = false;
+      bool polled = false;
       u32 count = state.m_workercount.load();
       for (u32 i = 0; i < count; i++)
       {
@@ -91,29 +269,57 @@ void ThreadPool::Workloop(ThreadPool &state, size_t ID)
         {
           if (worker->NextTask(ID))
           {
-            worked = true;
+            polled = true;
             state.m_workflag.fetch_sub(1);
           }
         }
       }
-      if (worked)
-      {
-        Common::YieldCPU();
-        continue;
-      }
+      if (polled)
+        worked = true;
       else if (state.m_workflag.load() > ID)
-      {
         state.m_workflag.fetch_sub(1);
-      }
-      rest_time = 1;
     }
-    else
+    if (worked)
+    {
+      Common::YieldCPU();
+      continue;
+    }
+    // The registered workers are still polled now and then, not all of them notify.
+    std::unique_lock<std::mutex> lock(state.m_wake_lock);
+    state.m_wake.wait_for(lock, std::chrono::milliseconds(5), [&] {
+      return !state.m_working.load() || state.m_pending_tasks.load() > 0 ||
+             state.m_workflag.load() > static_cast<s32>(ID);
+    });
+  }
+}
+
+void TaskGroup::Run(std::function<void()> task, TaskPriority priority)
+{
+  m_pending.fetch_add(1);
+  ThreadPool::Submit([this, task = std::move(task)] {
+    task();
+    // The waiter can only see the group finished after the lock is released, so the group
+    // outlives its use here.
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_pending.fetch_sub(1) == 1)
+      m_done.notify_all();
+  }, priority);
+}
+
+void TaskGroup::Wait()
+{
+  if (ThreadPool::IsWorkerThread())
+  {
+    while (m_pending.load() > 0)
     {
-      rest_time++;
-      rest_time = rest_time > 5 ? 5 : rest_time;
+      if (ThreadPool::RunPendingTask())
+        continue;
+      std::unique_lock<std::mutex> lock(m_lock);
+      m_done.wait_for(lock, std::chrono::milliseconds(1), [&] { return m_pending.load() == 0; });
     }
-    SleepCurrentThread(rest_time);
   }
+  std::unique_lock<std::mutex> lock(m_lock);
+  m_done.wait(lock, [&] { return m_pending.load() == 0; });
 }
 
 AsyncWorker& AsyncWorker::Getinstance()
@@ -32,6 +32,7 @@
 #pragma once
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -39,6 +40,7 @@
 #include <utility>
 #include <vector>
 
+#include "Common/Common.h"
 #include "Common/Thread.h"
 
 namespace Common
@@ -437,17 +439,43 @@ public:
   virtual bool NextTask(size_t ID) = 0;
 };
 
+enum class TaskPriority
+{
+  // Work somebody waits for, like the parts of a ParallelFor.
+  Normal,
+  // Work nobody waits for, like shader compiles and texture dumps. Only runs when there is no
+  // normal work left.
+  Background,
+};
+
+// Tasks submitted by a worker go to the back of its own deque, which it takes from the back again
+// while idle workers steal from the front. Tasks from other threads go to a shared queue per
+// priority. Two logical CPUs are left to the CPU and GPU threads of the emulation, and the pool
+// never runs a task on a thread that isn't one of its workers, so it stays out of their way.
 class ThreadPool
 {
 private:
+  struct WorkerQueue
+  {
+    std::mutex lock;
+    std::deque<std::function<void()>> tasks;
+  };
   std::vector<std::unique_ptr<std::thread>> m_workerThreads;
   std::vector<IWorker*> m_workers;
   std::atomic<s32> m_workflag;
   std::atomic<s32> m_workercount;
   std::atomic<bool> m_working;
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  std::mutex m_shared_lock;
+  std::deque<std::function<void()>> m_shared_queues[2];
+  std::atomic<s32> m_pending_tasks;
+  std::mutex m_wake_lock;
+  std::condition_variable m_wake;
   static std::mutex m_workerLock;
   static void Workloop(ThreadPool &state, size_t ID);
   static ThreadPool &Getinstance();
+  bool PopTask(size_t ID, bool background, std::function<void()>* task);
+  void WakeWorkers(bool all);
   ThreadPool(ThreadPool const&);
   void operator=(ThreadPool const&);
   ThreadPool();
@@ -459,6 +487,33 @@ public:
   static inline size_t GetThreadCount() {
     return Getinstance().m_workerThreads.size();
   }
+  static void Submit(std::function<void()> task, TaskPriority priority = TaskPriority::Background);
+  // Calls func(first, last) for consecutive ranges of at most grain indices, which together cover
+  // [begin, end). The calling thread takes ranges too, and returns once all of them are done.
+  static void ParallelFor(size_t begin, size_t end, size_t grain,
+                          const std::function<void(size_t, size_t)>& func);
+  // Runs one normal priority task from the queues, for a worker that waits for other tasks.
+  // Returns false on other threads and when there is none.
+  static bool RunPendingTask();
+  static bool IsWorkerThread();
+};
+
+// Tasks that are waited for together. Waiting on a worker runs other normal priority tasks in the
+// meantime, so tasks of a group can wait for a nested group without running out of workers.
+class TaskGroup
+{
+public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  ~TaskGroup() { Wait(); }
+  void Run(std::function<void()> task, TaskPriority priority = TaskPriority::Normal);
+  void Wait();
+
+private:
+  std::atomic<u32> m_pending{0};
+  std::mutex m_lock;
+  std::condition_variable m_done;
 };
 
 class AsyncWorker final : IWorker
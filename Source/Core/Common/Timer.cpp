@@ -62,6 +62,26 @@ u64 Timer::GetTimeUs()
 #endif
 }
 
+u64 Timer::GetThreadCPUTimeUs()
+{
+#ifdef _WIN32
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time, &kernel_time, &user_time))
+    return 0;
+  // In 100 ns units.
+  const u64 kernel = (u64(kernel_time.dwHighDateTime) << 32) | kernel_time.dwLowDateTime;
+  const u64 user = (u64(user_time.dwHighDateTime) << 32) | user_time.dwLowDateTime;
+  return (kernel + user) / 10;
+#elif defined CLOCK_THREAD_CPUTIME_ID
+  struct timespec t;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) != 0)
+    return 0;
+  return ((u64)(t.tv_sec * 1000000 + t.tv_nsec / 1000));
+#else
+  return 0;
+#endif
+}
+
 // --------------------------------------------
 // Initiate, Start, Stop, and Update the time
 // --------------------------------------------
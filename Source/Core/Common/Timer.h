@@ -38,6 +38,8 @@ public:
 
   static u32 GetTimeMs();
   static u64 GetTimeUs();
+  // The time the calling thread has been running for, 0 where that isn't known.
+  static u64 GetThreadCPUTimeUs();
 
   // Arbitrarily chosen value (38 years) that is subtracted in GetDoubleTime()
   // to increase sub-second precision of the resulting double timestamp
@@ -0,0 +1,204 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Tracing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+
+namespace Common
+{
+namespace Tracing
+{
+namespace detail
+{
+std::atomic<bool> s_recording{false};
+}
+
+namespace
+{
+// A few seconds of the busiest threads. Events past this are dropped.
+constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+struct Event
+{
+  const char* category;
+  const char* name;
+  u64 start_us;
+  // Instant events have none.
+  u64 duration_us;
+  bool instant;
+};
+
+// Each thread writes its own events, the lock is only contended while exporting.
+struct ThreadBuffer
+{
+  std::mutex lock;
+  u32 id;
+  std::string name;
+  std::vector<Event> events;
+  u64 dropped = 0;
+};
+
+std::mutex s_threads_lock;
+// Only threads that recorded events have one. They are kept after their threads exit, so their
+// events can still be exported, until the next recording starts.
+std::vector<std::shared_ptr<ThreadBuffer>> s_threads;
+u64 s_start_us = 0;
+
+std::mutex s_names_lock;
+std::unordered_set<std::string> s_names;
+
+u32 s_next_thread_id = 1;
+
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+thread_local std::string t_name;
+
+ThreadBuffer* GetThreadBuffer()
+{
+  if (!t_buffer)
+  {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> guard(s_threads_lock);
+    buffer->id = s_next_thread_id++;
+    buffer->name = t_name.empty() ? StringFromFormat("Thread %u", buffer->id) : t_name;
+    s_threads.push_back(buffer);
+    t_buffer = std::move(buffer);
+  }
+  return t_buffer.get();
+}
+
+void AddEvent(const Event& event)
+{
+  ThreadBuffer* buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> guard(buffer->lock);
+  if (buffer->events.size() < MAX_EVENTS_PER_THREAD)
+    buffer->events.push_back(event);
+  else
+    buffer->dropped++;
+}
+
+std::string EscapeJSON(const std::string& str)
+{
+  std::string escaped;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      escaped += c;
+  }
+  return escaped;
+}
+}  // namespace
+
+void StartRecording()
+{
+  std::lock_guard<std::mutex> guard(s_threads_lock);
+  // The buffers of threads that exited are only referenced from here.
+  s_threads.erase(std::remove_if(s_threads.begin(), s_threads.end(),
+                                 [](const auto& buffer) { return buffer.use_count() == 1; }),
+                  s_threads.end());
+  for (const auto& buffer : s_threads)
+  {
+    std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+    buffer->events.clear();
+    buffer->dropped = 0;
+  }
+  s_start_us = GetTimeUs();
+  detail::s_recording.store(true);
+}
+
+void StopRecording()
+{
+  detail::s_recording.store(false);
+}
+
+bool ExportChromeTrace(const std::string& filename)
+{
+  std::ofstream file;
+  File::OpenFStream(file, filename, std::ios_base::out | std::ios_base::trunc);
+  if (!file)
+    return false;
+
+  file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+  const auto separator = [&first]() {
+    const char* result = first ? "" : ",\n";
+    first = false;
+    return result;
+  };
+
+  std::lock_guard<std::mutex> guard(s_threads_lock);
+  for (const auto& buffer : s_threads)
+  {
+    std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+    file << separator() << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+         << buffer->id << ",\"args\":{\"name\":\"" << EscapeJSON(buffer->name) << "\"}}";
+    for (const Event& event : buffer->events)
+    {
+      // Events that started before the recording are clamped to its start.
+      const u64 start_us = event.start_us > s_start_us ? event.start_us - s_start_us : 0;
+      file << separator() << "{\"ph\":\"" << (event.instant ? "i" : "X") << "\",\"cat\":\""
+           << EscapeJSON(event.category) << "\",\"name\":\"" << EscapeJSON(event.name)
+           << "\",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":" << start_us;
+      if (event.instant)
+        file << ",\"s\":\"t\"}";
+      else
+        file << ",\"dur\":" << event.duration_us << "}";
+    }
+    if (buffer->dropped)
+    {
+      file << separator() << "{\"ph\":\"M\",\"name\":\"thread_dropped_events\",\"pid\":1,\"tid\":"
+           << buffer->id << ",\"args\":{\"count\":" << buffer->dropped << "}}";
+    }
+  }
+  file << "\n]}\n";
+  return static_cast<bool>(file);
+}
+
+void SetCurrentThreadName(const char* name)
+{
+  t_name = name;
+  if (t_buffer)
+  {
+    std::lock_guard<std::mutex> guard(t_buffer->lock);
+    t_buffer->name = name;
+  }
+}
+
+const char* InternName(const std::string& name)
+{
+  std::lock_guard<std::mutex> guard(s_names_lock);
+  return s_names.insert(name).first->c_str();
+}
+
+void AddCompleteEvent(const char* category, const char* name, u64 start_us, u64 end_us)
+{
+  AddEvent({category, name, start_us, end_us - start_us, false});
+}
+
+void AddInstantEvent(const char* category, const char* name)
+{
+  AddEvent({category, name, GetTimeUs(), 0, true});
+}
+
+u64 GetTimeUs()
+{
+  // Never 0, which ScopedEvent uses for not recording.
+  return static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count()) +
+         1;
+}
+}  // namespace Tracing
+}  // namespace Common
@@ -0,0 +1,110 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Scoped trace events of every thread on one timeline, written in the Chrome trace event format
+// that chrome://tracing and the Perfetto UI open.
+//
+// The TRACE_ macros are only compiled in debug builds and builds with ENABLE_TRACING. Even then
+// they only cost a check of a flag until recording starts.
+namespace Common
+{
+namespace Tracing
+{
+namespace detail
+{
+extern std::atomic<bool> s_recording;
+}
+
+// Starting again drops the events recorded before.
+void StartRecording();
+void StopRecording();
+inline bool IsRecording()
+{
+  return detail::s_recording.load(std::memory_order_relaxed);
+}
+
+// Writes the events recorded so far, false if the file couldn't be written.
+bool ExportChromeTrace(const std::string& filename);
+
+// Names the calling thread in the trace. SetCurrentThreadName calls this. Threads only take up
+// memory for the trace once they record an event.
+void SetCurrentThreadName(const char* name);
+
+// Returns a pointer to a copy of the name that stays valid until the process exits, for event
+// names that aren't literals.
+const char* InternName(const std::string& name);
+
+// The category and name have to stay valid until the trace is exported, like literals do.
+void AddCompleteEvent(const char* category, const char* name, u64 start_us, u64 end_us);
+void AddInstantEvent(const char* category, const char* name);
+
+u64 GetTimeUs();
+
+class ScopedEvent
+{
+public:
+  ScopedEvent(const char* category, const char* name)
+      : m_category(category), m_name(name), m_start_us(IsRecording() ? GetTimeUs() : 0)
+  {
+  }
+  ~ScopedEvent()
+  {
+    if (m_start_us)
+      AddCompleteEvent(m_category, m_name, m_start_us, GetTimeUs());
+  }
+  ScopedEvent(const ScopedEvent&) = delete;
+  ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+private:
+  const char* m_category;
+  const char* m_name;
+  u64 m_start_us;
+};
+}  // namespace Tracing
+}  // namespace Common
+
+#if defined(USE_TRACING) || defined(_DEBUG)
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+// Records the time until the end of the enclosing scope.
+#define TRACE_SCOPE(category, name)                                                                \
+  Common::Tracing::ScopedEvent TRACE_CONCAT(trace_scope_, __LINE__)(category, name)
+// Records an event that took duration_us and ended now, for code that already times itself.
+#define TRACE_COMPLETE(category, name, duration_us)                                                \
+  do                                                                                               \
+  {                                                                                                \
+    if (Common::Tracing::IsRecording())                                                            \
+    {                                                                                              \
+      const u64 trace_end_us = Common::Tracing::GetTimeUs();                                       \
+      Common::Tracing::AddCompleteEvent(category, name, trace_end_us - (duration_us),              \
+                                        trace_end_us);                                             \
+    }                                                                                              \
+  } while (0)
+#define TRACE_INSTANT(category, name)                                                              \
+  do                                                                                               \
+  {                                                                                                \
+    if (Common::Tracing::IsRecording())                                                            \
+      Common::Tracing::AddInstantEvent(category, name);                                            \
+  } while (0)
+#else
+#define TRACE_SCOPE(category, name)                                                                \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+#define TRACE_COMPLETE(category, name, duration_us)                                                \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+#define TRACE_INSTANT(category, name)                                                              \
+  do                                                                                               \
+  {                                                                                                \
+  } while (0)
+#endif
@@ -1795,12 +1795,11 @@ static int GetVEXpp(u8 opPrefix)
 }
 
 void XEmitter::WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   int mmmmm = GetVEXmmmmm(op);
   int pp = GetVEXpp(opPrefix);
-  // FIXME: we currently don't support 256-bit instructions, and "size" is not the vector size here
-  arg.WriteVEX(this, regOp1, regOp2, 0, pp, mmmmm, W);
+  arg.WriteVEX(this, regOp1, regOp2, L, pp, mmmmm, W);
   Write8(op & 0xFF);
   arg.WriteRest(this, extrabytes, regOp1);
 }
@@ -1813,11 +1812,19 @@ void XEmitter::WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, co
 }
 
 void XEmitter::WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   if (!cpu_info.bAVX)
     PanicAlert("Trying to use AVX on a system that doesn't support it. Bad programmer.");
-  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, W, extrabytes);
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, W, extrabytes, L);
+}
+
+void XEmitter::WriteAVX2Op(int size, u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2,
+                           const OpArg& arg, int extrabytes)
+{
+  if (size == 256 && !cpu_info.bAVX2)
+    PanicAlert("Trying to use AVX2 on a system that doesn't support it. Bad programmer.");
+  WriteAVXOp(opPrefix, op, regOp1, regOp2, arg, 0, extrabytes, size == 256);
 }
 
 void XEmitter::WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
@@ -2917,6 +2924,74 @@ void XEmitter::VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
   WriteAVXOp(0x66, 0xEF, regOp1, regOp2, arg);
 }
 
+void XEmitter::VMOVD_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0x66, 0x6E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVQ_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x7E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVDQU(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, sseMOVDQfromRM, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVSS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0xF3, sseMOVUPtoRM, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVLPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, sseMOVLPtoRM, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVUPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, sseMOVUPtoRM, src, INVALID_REG, arg);
+}
+void XEmitter::VZEROUPPER()
+{
+  if (!cpu_info.bAVX)
+    PanicAlert("Trying to use AVX on a system that doesn't support it. Bad programmer.");
+  Write8(0xC5);
+  Write8(0xF8);
+  Write8(0x77);
+}
+
+void XEmitter::VBROADCASTSS(int size, X64Reg dest, const OpArg& arg)
+{
+  // The register source form was only added with AVX2.
+  if (arg.IsSimpleReg() && !cpu_info.bAVX2)
+    PanicAlert("Trying to use AVX2 on a system that doesn't support it. Bad programmer.");
+  WriteAVXOp(0x66, 0x3818, dest, INVALID_REG, arg, 0, 0, size == 256);
+}
+void XEmitter::VCVTDQ2PS(int size, X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0x00, 0x5B, dest, INVALID_REG, arg, 0, 0, size == 256);
+}
+void XEmitter::VMULPS(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVXOp(0x00, sseMUL, regOp1, regOp2, arg, 0, 0, size == 256);
+}
+void XEmitter::VPSHUFB(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op(size, 0x66, 0x3800, regOp1, regOp2, arg);
+}
+void XEmitter::VPSRAD(int size, X64Reg dest, X64Reg reg, u8 shift)
+{
+  WriteAVX2Op(size, 0x66, 0x72, (X64Reg)4, dest, R(reg), 1);
+  Write8(shift);
+}
+void XEmitter::VINSERTI128(X64Reg dest, X64Reg regOp, const OpArg& arg, u8 lane)
+{
+  WriteAVX2Op(256, 0x66, 0x3A38, dest, regOp, arg, 1);
+  Write8(lane);
+}
+void XEmitter::VEXTRACTI128(const OpArg& arg, X64Reg src, u8 lane)
+{
+  WriteAVX2Op(256, 0x66, 0x3A39, src, INVALID_REG, arg, 1);
+  Write8(lane);
+}
+
 void XEmitter::VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
 {
   WriteFMA3Op(0x98, regOp1, regOp2, arg);
@@ -347,11 +347,13 @@ private:
   void WriteSSSE3Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteSSE41Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
   void WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
+  void WriteAVX2Op(int size, u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
+                   int extrabytes = 0);
   void WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
@@ -868,6 +870,27 @@ public:
   void VPOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
 
+  // VEX-encoded moves, for code that mixes in 256-bit instructions. The loads zero the upper
+  // bits of the destination.
+  void VMOVD_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVQ_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVDQU(X64Reg dest, const OpArg& arg);
+  void VMOVSS(const OpArg& arg, X64Reg src);
+  void VMOVLPS(const OpArg& arg, X64Reg src);
+  void VMOVUPS(const OpArg& arg, X64Reg src);
+  void VZEROUPPER();
+
+  // Instructions that can work on 256-bit registers. size is the vector width, 128 or 256; the
+  // 256-bit integer instructions need AVX2. There are no separate YMM register names, so the
+  // XMM ones are used for both.
+  void VBROADCASTSS(int size, X64Reg dest, const OpArg& arg);
+  void VCVTDQ2PS(int size, X64Reg dest, const OpArg& arg);
+  void VMULPS(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSHUFB(int size, X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSRAD(int size, X64Reg dest, X64Reg reg, u8 shift);
+  void VINSERTI128(X64Reg dest, X64Reg regOp, const OpArg& arg, u8 lane);
+  void VEXTRACTI128(const OpArg& arg, X64Reg src, u8 lane);
+
   // FMA3
   void VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VFMADD213PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
@@ -1074,6 +1097,17 @@ public:
     ABI_CallFunction(func);
   }
 
+  template <typename FunctionPointer>
+  void ABI_CallFunctionPCA(int bits, FunctionPointer func, const void* param1, u32 param2,
+                           const Gen::OpArg& arg3)
+  {
+    if (!arg3.IsSimpleReg(ABI_PARAM3))
+      MOV(bits, R(ABI_PARAM3), arg3);
+    MOV(64, R(ABI_PARAM1), Imm64(reinterpret_cast<u64>(param1)));
+    MOV(32, R(ABI_PARAM2), Imm32(param2));
+    ABI_CallFunction(func);
+  }
+
   template <typename FunctionPointer>
   void ABI_CallFunctionPPC(FunctionPointer func, const void* param1, const void* param2, u32 param3)
   {
@@ -1145,6 +1179,13 @@ public:
     auto trampoline = &XEmitter::CallLambdaTrampoline<T, Args...>;
     ABI_CallFunctionPC(trampoline, reinterpret_cast<const void*>(f), p1);
   }
+
+  template <typename T, typename... Args>
+  void ABI_CallLambdaCA(int bits, const std::function<T(Args...)>* f, u32 p1, const OpArg& p2)
+  {
+    auto trampoline = &XEmitter::CallLambdaTrampoline<T, Args...>;
+    ABI_CallFunctionPCA(bits, trampoline, reinterpret_cast<const void*>(f), p1, p2);
+  }
 };  // class XEmitter
 
 class X64CodeBlock : public CodeBlock<XEmitter>
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <array>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -227,6 +228,11 @@ bool BootCore(std::unique_ptr<BootParameters> boot)
   if (!boot)
     return false;
 
+  Core::StartBootTimings();
+  // Opening the disc and loading the game INIs.
+  std::optional<Core::BootStageTimer> settings_timer;
+  settings_timer.emplace("Game settings");
+
   SConfig& StartUp = SConfig::GetInstance();
 
   StartUp.bRunCompareClient = false;
@@ -385,6 +391,8 @@ bool BootCore(std::unique_ptr<BootParameters> boot)
   if (StartUp.bWii)
     ConfigLoaders::SaveToSYSCONF(Config::LayerType::Meta);
 
+  settings_timer.reset();
+
   const bool load_ipl = !StartUp.bWii && !StartUp.bHLE_BS2 &&
     std::holds_alternative<BootParameters::Disc>(boot->parameters);
   if (load_ipl)
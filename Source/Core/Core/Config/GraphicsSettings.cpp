@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "Common/Hash.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace Config
@@ -15,6 +16,8 @@ namespace Config
 // Graphics.Hardware
 
 const ConfigInfo<bool> GFX_VSYNC{{System::GFX, "Hardware", "VSync"}, false};
+const ConfigInfo<bool> GFX_LOW_LATENCY{{System::GFX, "Hardware", "LowLatency"}, false};
+const ConfigInfo<bool> GFX_PACE_PRESENTS{{System::GFX, "Hardware", "PacePresents"}, false};
 const ConfigInfo<int> GFX_ADAPTER{{System::GFX, "Hardware", "Adapter"}, 0};
 
 // Graphics.Settings
@@ -29,6 +32,8 @@ const ConfigInfo<bool> GFX_USE_XFB{{System::GFX, "Settings", "UseXFB"}, false};
 const ConfigInfo<bool> GFX_USE_REAL_XFB{{System::GFX, "Settings", "UseRealXFB"}, false};
 const ConfigInfo<int> GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES{
     {System::GFX, "Settings", "SafeTextureCacheColorSamples"}, 128};
+const ConfigInfo<int> GFX_TEXTURE_HASH_FUNCTION{{System::GFX, "Settings", "TextureHashFunction"},
+                                                static_cast<int>(Hash64Function::XXH3)};
 const ConfigInfo<bool> GFX_SHOW_FPS{{System::GFX, "Settings", "ShowFPS"}, false};
 const ConfigInfo<bool> GFX_SHOW_NETPLAY_PING{{System::GFX, "Settings", "ShowNetPlayPing"}, false};
 const ConfigInfo<bool> GFX_SHOW_NETPLAY_MESSAGES{{System::GFX, "Settings", "ShowNetPlayMessages"},
@@ -37,6 +42,10 @@ const ConfigInfo<bool> GFX_LOG_RENDER_TIME_TO_FILE{{System::GFX, "Settings", "Lo
                                                    false};
 const ConfigInfo<bool> GFX_OVERLAY_STATS{{System::GFX, "Settings", "OverlayStats"}, false};
 const ConfigInfo<bool> GFX_OVERLAY_PROJ_STATS{{System::GFX, "Settings", "OverlayProjStats"}, false};
+const ConfigInfo<bool> GFX_OVERLAY_FRAME_PROFILE{{System::GFX, "Settings", "OverlayFrameProfile"},
+                                                 false};
+const ConfigInfo<bool> GFX_LOG_FRAME_PROFILE_TO_FILE{
+    {System::GFX, "Settings", "LogFrameProfileToFile"}, false};
 const ConfigInfo<bool> GFX_DUMP_TEXTURES{{System::GFX, "Settings", "DumpTextures"}, false};
 const ConfigInfo<bool> GFX_HIRES_TEXTURES{{System::GFX, "Settings", "HiresTextures"}, false};
 const ConfigInfo<bool> GFX_HIRES_MATERIAL_MAPS{ { System::GFX, "Settings", "HiresMaterialMaps" }, false };
@@ -45,7 +54,19 @@ const ConfigInfo<bool> GFX_CACHE_HIRES_TEXTURES{{System::GFX, "Settings", "Cache
                                                 false};
 const ConfigInfo<bool> GFX_WAIT_CACHE_HIRES_TEXTURES{{System::GFX, "Settings", "WaitForCachedHiresTextures"},
                                                 false};
+const ConfigInfo<bool> GFX_PACK_HIRES_TEXTURES{{System::GFX, "Settings", "PackHiresTextures"},
+                                               false};
+const ConfigInfo<bool> GFX_COMPRESS_HIRES_TEXTURES{
+    {System::GFX, "Settings", "CompressHiresTextures"}, false};
+const ConfigInfo<int> GFX_HIRES_TEXTURE_NAME_VERSION{
+    {System::GFX, "Settings", "HiresTextureNameVersion"}, 1};
 const ConfigInfo<bool> GFX_DUMP_EFB_TARGET{{System::GFX, "Settings", "DumpEFBTarget"}, false};
+const ConfigInfo<bool> GFX_DUMP_VERTEX_LOADER_PROFILE{
+    {System::GFX, "Settings", "DumpVertexLoaderProfile"}, false};
+const ConfigInfo<bool> GFX_DUMP_SHADER_COMPILE_STATS{
+    {System::GFX, "Settings", "DumpShaderCompileStats"}, false};
+const ConfigInfo<bool> GFX_DUMP_TEXTURE_CACHE_STATS{
+    {System::GFX, "Settings", "DumpTextureCacheStats"}, false};
 const ConfigInfo<bool> GFX_DUMP_FRAMES_AS_IMAGES{{System::GFX, "Settings", "DumpFramesAsImages"},
                                                  false};
 const ConfigInfo<bool> GFX_FREE_LOOK{{System::GFX, "Settings", "FreeLook"}, false};
@@ -54,6 +75,7 @@ const ConfigInfo<bool> GFX_USE_BLACK_FRAME_INSERTION{ {System::GFX, "Settings",
 const ConfigInfo<bool> GFX_USE_FFV1{{System::GFX, "Settings", "UseFFV1"}, false};
 const ConfigInfo<std::string> GFX_DUMP_FORMAT{{System::GFX, "Settings", "DumpFormat"}, "avi"};
 const ConfigInfo<std::string> GFX_DUMP_CODEC{{System::GFX, "Settings", "DumpCodec"}, ""};
+const ConfigInfo<std::string> GFX_DUMP_ENCODER{{System::GFX, "Settings", "DumpEncoder"}, ""};
 const ConfigInfo<std::string> GFX_DUMP_PATH{{System::GFX, "Settings", "DumpPath"}, ""};
 const ConfigInfo<int> GFX_BITRATE_KBPS{{System::GFX, "Settings", "BitrateKbps"}, 2500};
 const ConfigInfo<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS{
@@ -61,6 +83,8 @@ const ConfigInfo<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS{
 const ConfigInfo<bool> GFX_ENABLE_GPU_TEXTURE_DECODING{
     {System::GFX, "Settings", "EnableGPUTextureDecoding"}, false};
 const ConfigInfo<bool> GFX_ENABLE_COMPUTE_TEXTURE_ENCODING{ { System::GFX, "Settings", "EnableComputeTextureEncoding" }, false };
+const ConfigInfo<bool> GFX_ENABLE_GPU_VERTEX_DECODING{
+    {System::GFX, "Settings", "EnableGPUVertexDecoding"}, false};
 const ConfigInfo<bool> GFX_ENABLE_PIXEL_LIGHTING{{System::GFX, "Settings", "EnablePixelLighting"},
                                                  false};
 const ConfigInfo<bool> GFX_FORCED_LIGHTING{ { System::GFX, "Settings", "ForcedLighting" },
@@ -84,6 +108,7 @@ const ConfigInfo<int> GFX_SIMULATE_BUMP_DETAIL_BLEND{ { System::GFX, "Settings",
 const ConfigInfo<bool> GFX_FAST_DEPTH_CALC{{System::GFX, "Settings", "FastDepthCalc"}, true};
 const ConfigInfo<u32> GFX_MSAA{{System::GFX, "Settings", "MSAA"}, 1};
 const ConfigInfo<bool> GFX_SSAA{{System::GFX, "Settings", "SSAA"}, false};
+const ConfigInfo<bool> GFX_POST_AA{{System::GFX, "Settings", "PostProcessingAA"}, false};
 const ConfigInfo<int> GFX_EFB_SCALE{{System::GFX, "Settings", "EFBScale"},
                                     static_cast<int>(SCALE_1X)};
 const ConfigInfo<bool> GFX_TEXFMT_OVERLAY_ENABLE{{System::GFX, "Settings", "TexFmtOverlayEnable"},
@@ -108,6 +133,8 @@ const ConfigInfo<bool> GFX_BACKGROUND_SHADER_COMPILING{
   { System::GFX, "Settings", "BackgroundShaderCompiling" }, false };
 const ConfigInfo<bool> GFX_DISABLE_SPECIALIZED_SHADERS{
   { System::GFX, "Settings", "DisableSpecializedShaders" }, false };
+const ConfigInfo<int> GFX_SHADER_COMPILER_THREADS{
+  { System::GFX, "Settings", "ShaderCompilerThreads" }, 0 };
 
 const ConfigInfo<bool> GFX_SW_ZCOMPLOC{{System::GFX, "Settings", "SWZComploc"}, true};
 const ConfigInfo<bool> GFX_SW_ZFREEZE{{System::GFX, "Settings", "SWZFreeze"}, true};
@@ -129,6 +156,10 @@ const ConfigInfo<int> GFX_ENHANCE_MAX_ANISOTROPY{{System::GFX, "Enhancements", "
 const ConfigInfo<bool> GFX_ENHANCE_POST_ENABLED{
     {System::GFX, "Enhancements", "PostProcessingEnable"}, false};
 const ConfigInfo<int> GFX_ENHANCE_POST_TRIGUER{ { System::GFX, "Enhancements", "PostProcessingTrigger" }, 0 };
+const ConfigInfo<bool> GFX_ENHANCE_POST_BAKE_OPTIONS{
+    {System::GFX, "Enhancements", "PostProcessingBakeOptions"}, false};
+const ConfigInfo<bool> GFX_ENHANCE_POST_DYNAMIC_SCALE{
+    {System::GFX, "Enhancements", "PostProcessingDynamicScale"}, false};
 const ConfigInfo<std::string> GFX_ENHANCE_POST_SHADERS{
   { System::GFX, "Enhancements", "PostProcessingShaders" }, "" };
 const ConfigInfo<std::string> GFX_ENHANCE_SCALING_SHADER{
@@ -143,6 +174,18 @@ const ConfigInfo<int> GFX_ENHANCE_TEXTURE_SCALING_TYPE{ { System::GFX, "Enhancem
 const ConfigInfo<int> GFX_ENHANCE_TEXTURE_SCALING_FACTOR{ { System::GFX, "Enhancements", "TextureScalingFactor" }, 2 };
 const ConfigInfo<bool> GFX_ENHANCE_USE_DEPOSTERIZE{ { System::GFX, "Enhancements", "UseDePosterize" },
 true };
+const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_ASYNC{
+    {System::GFX, "Enhancements", "TextureScalingAsync"}, false};
+const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_GPU{
+    {System::GFX, "Enhancements", "TextureScalingGPU"}, false};
+const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_CACHE{
+    {System::GFX, "Enhancements", "TextureScalingCache"}, false};
+const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_CACHE_COMPRESS{
+    {System::GFX, "Enhancements", "TextureScalingCacheCompress"}, true};
+const ConfigInfo<int> GFX_ENHANCE_TEXTURE_SCALING_CACHE_SIZE{
+    {System::GFX, "Enhancements", "TextureScalingCacheSize"}, 1024};
+const ConfigInfo<int> GFX_ENHANCE_TEXTURE_MEMORY_BUDGET{
+    {System::GFX, "Enhancements", "TextureMemoryBudget"}, 0};
 
 const ConfigInfo<bool> GFX_ENHANCE_TESSELLATION{ { System::GFX, "Enhancements", "Tessellation" }, true };
 const ConfigInfo<bool> GFX_ENHANCE_TESSELLATION_EARLY_CULLING{ { System::GFX, "Enhancements", "TessellationEarlyCulling" }, false };
@@ -170,9 +213,13 @@ const ConfigInfo<std::string> GFX_STEREO_SHADER{
 const ConfigInfo<bool> GFX_HACK_EFB_ACCESS_ENABLE{{System::GFX, "Hacks", "EFBAccessEnable"}, true};
 const ConfigInfo<bool> GFX_HACK_EFB_FAST_ACCESS_ENABLE{ { System::GFX, "Hacks", "EFBFastAccess" }, false };
 const ConfigInfo<int> GFX_HACK_BBOX_MODE{{System::GFX, "Hacks", "BoundingBoxMode"}, 0};
+const ConfigInfo<int> GFX_HACK_BBOX_PREDICTION_WINDOW{
+    {System::GFX, "Hacks", "BBoxPredictionWindow"}, 0};
 const ConfigInfo<bool> GFX_HACK_FORCE_PROGRESSIVE{{System::GFX, "Hacks", "ForceProgressive"}, true};
 const ConfigInfo<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM{{System::GFX, "Hacks", "EFBToTextureEnable"},
                                                      true};
+const ConfigInfo<bool> GFX_HACK_DEFER_EFB_COPIES{{System::GFX, "Hacks", "DeferEFBCopies"},
+                                                 false};
 const ConfigInfo<bool> GFX_HACK_COPY_EFB_SCALED{{System::GFX, "Hacks", "EFBScaledCopy"}, true};
 const ConfigInfo<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES{
     {System::GFX, "Hacks", "EFBEmulateFormatChanges"}, false};
@@ -182,6 +229,10 @@ const ConfigInfo<bool> GFX_HACK_FORCE_DUAL_SOURCE{ { System::GFX, "Hacks", "Forc
 const ConfigInfo<bool> GFX_HACK_FULL_ASYNC_SHADER_COMPILATION{ { System::GFX, "Hacks", "FullAsyncShaderCompilation" }, false };
 const ConfigInfo<bool> GFX_HACK_LAST_HISTORY_EFBTORAM{ { System::GFX, "Hacks", "LastStoryEFBToRam" }, false };
 const ConfigInfo<bool> GFX_HACK_FORCE_LOGICOP_BLEND{ { System::GFX, "Hacks", "ForceLogicOpBlend" }, false };
+const ConfigInfo<bool> GFX_HACK_DISPLAY_LIST_CACHE{ { System::GFX, "Hacks", "DisplayListCache" }, false };
+const ConfigInfo<bool> GFX_HACK_TRACK_TEXTURE_WRITES{ { System::GFX, "Hacks", "TrackTextureWrites" }, false };
+const ConfigInfo<bool> GFX_HACK_SKIP_DUPLICATE_FRAMES{ { System::GFX, "Hacks", "SkipDuplicateFrames" }, false };
+const ConfigInfo<bool> GFX_HACK_SKIP_DRAWING{ { System::GFX, "Hacks", "SkipDrawing" }, false };
 const ConfigInfo<int> GFX_HACK_CULL_MODE{ { System::GFX, "Hacks", "CullMode" }, 0 };
 
 // Graphics.GameSpecific
@@ -195,4 +246,6 @@ const ConfigInfo<std::string> GFX_PROJECTION_HACK_ZFAR{{System::GFX, "GameSpecif
                                                        ""};
 const ConfigInfo<bool> GFX_PERF_QUERIES_ENABLE{{System::GFX, "GameSpecific", "PerfQueriesEnable"},
                                                false};
+const ConfigInfo<bool> GFX_PERF_QUERIES_APPROXIMATE{
+    {System::GFX, "GameSpecific", "PerfQueriesApproximate"}, false};
 }  // namespace Config
@@ -15,6 +15,8 @@ namespace Config
 // Graphics.Hardware
 
 extern const ConfigInfo<bool> GFX_VSYNC;
+extern const ConfigInfo<bool> GFX_LOW_LATENCY;
+extern const ConfigInfo<bool> GFX_PACE_PRESENTS;
 extern const ConfigInfo<int> GFX_ADAPTER;
 
 // Graphics.Settings
@@ -26,19 +28,28 @@ extern const ConfigInfo<bool> GFX_CROP;
 extern const ConfigInfo<bool> GFX_USE_XFB;
 extern const ConfigInfo<bool> GFX_USE_REAL_XFB;
 extern const ConfigInfo<int> GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES;
+extern const ConfigInfo<int> GFX_TEXTURE_HASH_FUNCTION;
 extern const ConfigInfo<bool> GFX_SHOW_FPS;
 extern const ConfigInfo<bool> GFX_SHOW_NETPLAY_PING;
 extern const ConfigInfo<bool> GFX_SHOW_NETPLAY_MESSAGES;
 extern const ConfigInfo<bool> GFX_LOG_RENDER_TIME_TO_FILE;
 extern const ConfigInfo<bool> GFX_OVERLAY_STATS;
 extern const ConfigInfo<bool> GFX_OVERLAY_PROJ_STATS;
+extern const ConfigInfo<bool> GFX_OVERLAY_FRAME_PROFILE;
+extern const ConfigInfo<bool> GFX_LOG_FRAME_PROFILE_TO_FILE;
 extern const ConfigInfo<bool> GFX_DUMP_TEXTURES;
 extern const ConfigInfo<bool> GFX_HIRES_TEXTURES;
 extern const ConfigInfo<bool> GFX_HIRES_MATERIAL_MAPS;
 extern const ConfigInfo<bool> GFX_HIRES_MATERIAL_MAPS_BUILD;
 extern const ConfigInfo<bool> GFX_CACHE_HIRES_TEXTURES;
 extern const ConfigInfo<bool> GFX_WAIT_CACHE_HIRES_TEXTURES;
+extern const ConfigInfo<bool> GFX_PACK_HIRES_TEXTURES;
+extern const ConfigInfo<bool> GFX_COMPRESS_HIRES_TEXTURES;
+extern const ConfigInfo<int> GFX_HIRES_TEXTURE_NAME_VERSION;
 extern const ConfigInfo<bool> GFX_DUMP_EFB_TARGET;
+extern const ConfigInfo<bool> GFX_DUMP_VERTEX_LOADER_PROFILE;
+extern const ConfigInfo<bool> GFX_DUMP_SHADER_COMPILE_STATS;
+extern const ConfigInfo<bool> GFX_DUMP_TEXTURE_CACHE_STATS;
 extern const ConfigInfo<bool> GFX_DUMP_FRAMES_AS_IMAGES;
 extern const ConfigInfo<bool> GFX_FREE_LOOK;
 extern const ConfigInfo<bool> GFX_COMPILE_SHADERS_ON_STARTUP;
@@ -46,11 +57,13 @@ extern const ConfigInfo<bool> GFX_USE_BLACK_FRAME_INSERTION;
 extern const ConfigInfo<bool> GFX_USE_FFV1;
 extern const ConfigInfo<std::string> GFX_DUMP_FORMAT;
 extern const ConfigInfo<std::string> GFX_DUMP_CODEC;
+extern const ConfigInfo<std::string> GFX_DUMP_ENCODER;
 extern const ConfigInfo<std::string> GFX_DUMP_PATH;
 extern const ConfigInfo<int> GFX_BITRATE_KBPS;
 extern const ConfigInfo<bool> GFX_INTERNAL_RESOLUTION_FRAME_DUMPS;
 extern const ConfigInfo<bool> GFX_ENABLE_GPU_TEXTURE_DECODING;
 extern const ConfigInfo<bool> GFX_ENABLE_COMPUTE_TEXTURE_ENCODING;
+extern const ConfigInfo<bool> GFX_ENABLE_GPU_VERTEX_DECODING;
 extern const ConfigInfo<bool> GFX_ENABLE_PIXEL_LIGHTING;
 extern const ConfigInfo<bool> GFX_FORCED_LIGHTING;
 extern const ConfigInfo<bool> GFX_FORCED_DITHERING;
@@ -70,6 +83,7 @@ extern const ConfigInfo<int> GFX_SIMULATE_BUMP_DETAIL_BLEND;
 extern const ConfigInfo<bool> GFX_FAST_DEPTH_CALC;
 extern const ConfigInfo<u32> GFX_MSAA;
 extern const ConfigInfo<bool> GFX_SSAA;
+extern const ConfigInfo<bool> GFX_POST_AA;
 extern const ConfigInfo<int> GFX_EFB_SCALE;
 extern const ConfigInfo<bool> GFX_TEXFMT_OVERLAY_ENABLE;
 extern const ConfigInfo<bool> GFX_TEXFMT_OVERLAY_CENTER;
@@ -83,6 +97,7 @@ extern const ConfigInfo<int> GFX_COMMAND_BUFFER_EXECUTE_INTERVAL;
 extern const ConfigInfo<bool> GFX_SHADER_CACHE;
 extern const ConfigInfo<bool> GFX_BACKGROUND_SHADER_COMPILING;
 extern const ConfigInfo<bool> GFX_DISABLE_SPECIALIZED_SHADERS;
+extern const ConfigInfo<int> GFX_SHADER_COMPILER_THREADS;
 
 extern const ConfigInfo<bool> GFX_SW_ZCOMPLOC;
 extern const ConfigInfo<bool> GFX_SW_ZFREEZE;
@@ -100,6 +115,8 @@ extern const ConfigInfo<int> GFX_ENHANCE_FILTERING_MODE;
 extern const ConfigInfo<int> GFX_ENHANCE_MAX_ANISOTROPY;  // NOTE - this is x in (1 << x)
 extern const ConfigInfo<bool> GFX_ENHANCE_POST_ENABLED;
 extern const ConfigInfo<int> GFX_ENHANCE_POST_TRIGUER;
+extern const ConfigInfo<bool> GFX_ENHANCE_POST_BAKE_OPTIONS;
+extern const ConfigInfo<bool> GFX_ENHANCE_POST_DYNAMIC_SCALE;
 extern const ConfigInfo<std::string> GFX_ENHANCE_POST_SHADERS;
 extern const ConfigInfo<std::string> GFX_ENHANCE_SCALING_SHADER;
 extern const ConfigInfo<bool> GFX_ENHANCE_FORCE_TRUE_COLOR;
@@ -108,6 +125,12 @@ extern const ConfigInfo<bool> GFX_ENHANCE_USE_SCALING_FILTER;
 extern const ConfigInfo<int> GFX_ENHANCE_TEXTURE_SCALING_TYPE;
 extern const ConfigInfo<int> GFX_ENHANCE_TEXTURE_SCALING_FACTOR;
 extern const ConfigInfo<bool> GFX_ENHANCE_USE_DEPOSTERIZE;
+extern const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_ASYNC;
+extern const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_GPU;
+extern const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_CACHE;
+extern const ConfigInfo<bool> GFX_ENHANCE_TEXTURE_SCALING_CACHE_COMPRESS;
+extern const ConfigInfo<int> GFX_ENHANCE_TEXTURE_SCALING_CACHE_SIZE;
+extern const ConfigInfo<int> GFX_ENHANCE_TEXTURE_MEMORY_BUDGET;
 extern const ConfigInfo<bool> GFX_ENHANCE_TESSELLATION;
 extern const ConfigInfo<bool> GFX_ENHANCE_TESSELLATION_EARLY_CULLING;
 extern const ConfigInfo<int> GFX_ENHANCE_TESSELLATION_DISTANCE;
@@ -131,8 +154,10 @@ extern const ConfigInfo<std::string> GFX_STEREO_SHADER;
 extern const ConfigInfo<bool> GFX_HACK_EFB_ACCESS_ENABLE;
 extern const ConfigInfo<bool> GFX_HACK_EFB_FAST_ACCESS_ENABLE;
 extern const ConfigInfo<int> GFX_HACK_BBOX_MODE;
+extern const ConfigInfo<int> GFX_HACK_BBOX_PREDICTION_WINDOW;
 extern const ConfigInfo<bool> GFX_HACK_FORCE_PROGRESSIVE;
 extern const ConfigInfo<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM;
+extern const ConfigInfo<bool> GFX_HACK_DEFER_EFB_COPIES;
 extern const ConfigInfo<bool> GFX_HACK_COPY_EFB_SCALED;
 extern const ConfigInfo<bool> GFX_HACK_EFB_EMULATE_FORMAT_CHANGES;
 extern const ConfigInfo<bool> GFX_HACK_VERTEX_ROUDING;
@@ -140,6 +165,10 @@ extern const ConfigInfo<bool> GFX_HACK_FORCE_DUAL_SOURCE;
 extern const ConfigInfo<bool> GFX_HACK_FULL_ASYNC_SHADER_COMPILATION;
 extern const ConfigInfo<bool> GFX_HACK_LAST_HISTORY_EFBTORAM;
 extern const ConfigInfo<bool> GFX_HACK_FORCE_LOGICOP_BLEND;
+extern const ConfigInfo<bool> GFX_HACK_DISPLAY_LIST_CACHE;
+extern const ConfigInfo<bool> GFX_HACK_TRACK_TEXTURE_WRITES;
+extern const ConfigInfo<bool> GFX_HACK_SKIP_DUPLICATE_FRAMES;
+extern const ConfigInfo<bool> GFX_HACK_SKIP_DRAWING;
 extern const ConfigInfo<int> GFX_HACK_CULL_MODE;
 
 // Graphics.GameSpecific
@@ -150,6 +179,7 @@ extern const ConfigInfo<int> GFX_PROJECTION_HACK_SZFAR;
 extern const ConfigInfo<std::string> GFX_PROJECTION_HACK_ZNEAR;
 extern const ConfigInfo<std::string> GFX_PROJECTION_HACK_ZFAR;
 extern const ConfigInfo<bool> GFX_PERF_QUERIES_ENABLE;
+extern const ConfigInfo<bool> GFX_PERF_QUERIES_APPROXIMATE;
 
 
 
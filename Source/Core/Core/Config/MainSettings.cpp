@@ -94,6 +94,10 @@ const ConfigInfo<bool> MAIN_CUSTOM_RTC_ENABLE{{System::Main, "Core", "EnableCust
 const ConfigInfo<u32> MAIN_CUSTOM_RTC_VALUE{{System::Main, "Core", "CustomRTCValue"}, 946684800};
 const ConfigInfo<bool> MAIN_ENABLE_SIGNATURE_CHECKS{{System::Main, "Core", "EnableSignatureChecks"},
                                                     true};
+const ConfigInfo<bool> MAIN_PAD_SAMPLING_THREAD{{System::Main, "Core", "PadSamplingThread"}, false};
+// A Common::ThreadPlacement.
+const ConfigInfo<int> MAIN_THREAD_PLACEMENT{{System::Main, "Core", "ThreadPlacement"}, 0};
+const ConfigInfo<bool> MAIN_HUGE_PAGES{{System::Main, "Core", "HugePages"}, false};
 
 // Main.DSP
 
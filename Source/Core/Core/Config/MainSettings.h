@@ -67,6 +67,9 @@ extern const ConfigInfo<std::string> MAIN_PERF_MAP_DIR;
 extern const ConfigInfo<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const ConfigInfo<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const ConfigInfo<bool> MAIN_ENABLE_SIGNATURE_CHECKS;
+extern const ConfigInfo<bool> MAIN_PAD_SAMPLING_THREAD;
+extern const ConfigInfo<int> MAIN_THREAD_PLACEMENT;
+extern const ConfigInfo<bool> MAIN_HUGE_PAGES;
 
 // Main.DSP
 
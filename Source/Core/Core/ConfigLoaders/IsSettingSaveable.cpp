@@ -24,6 +24,8 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       // Graphics.Hardware
 
       Config::GFX_VSYNC.location,
+      Config::GFX_LOW_LATENCY.location,
+      Config::GFX_PACE_PRESENTS.location,
       Config::GFX_ADAPTER.location,
 
       // Graphics.Settings
@@ -35,30 +37,41 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_USE_REAL_XFB.location,
       Config::GFX_USE_BLACK_FRAME_INSERTION.location,
       Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES.location,
+      Config::GFX_TEXTURE_HASH_FUNCTION.location,
       Config::GFX_SHOW_FPS.location,
       Config::GFX_SHOW_NETPLAY_PING.location,
       Config::GFX_SHOW_NETPLAY_MESSAGES.location,
       Config::GFX_LOG_RENDER_TIME_TO_FILE.location,
       Config::GFX_OVERLAY_STATS.location,
       Config::GFX_OVERLAY_PROJ_STATS.location,
+      Config::GFX_OVERLAY_FRAME_PROFILE.location,
+      Config::GFX_LOG_FRAME_PROFILE_TO_FILE.location,
       Config::GFX_DUMP_TEXTURES.location,
       Config::GFX_HIRES_TEXTURES.location,
       Config::GFX_HIRES_MATERIAL_MAPS.location,
       Config::GFX_HIRES_MATERIAL_MAPS_BUILD.location,
       Config::GFX_CACHE_HIRES_TEXTURES.location,
       Config::GFX_WAIT_CACHE_HIRES_TEXTURES.location,
+      Config::GFX_PACK_HIRES_TEXTURES.location,
+      Config::GFX_COMPRESS_HIRES_TEXTURES.location,
+      Config::GFX_HIRES_TEXTURE_NAME_VERSION.location,
       Config::GFX_DUMP_EFB_TARGET.location,
+      Config::GFX_DUMP_VERTEX_LOADER_PROFILE.location,
+      Config::GFX_DUMP_SHADER_COMPILE_STATS.location,
+      Config::GFX_DUMP_TEXTURE_CACHE_STATS.location,
       Config::GFX_DUMP_FRAMES_AS_IMAGES.location,
       Config::GFX_FREE_LOOK.location,
       Config::GFX_COMPILE_SHADERS_ON_STARTUP.location,
       Config::GFX_USE_FFV1.location,
       Config::GFX_DUMP_FORMAT.location,
       Config::GFX_DUMP_CODEC.location,
+      Config::GFX_DUMP_ENCODER.location,
       Config::GFX_DUMP_PATH.location,
       Config::GFX_BITRATE_KBPS.location,
       Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS.location,
       Config::GFX_ENABLE_GPU_TEXTURE_DECODING.location,
       Config::GFX_ENABLE_COMPUTE_TEXTURE_ENCODING.location,
+      Config::GFX_ENABLE_GPU_VERTEX_DECODING.location,
       Config::GFX_ENABLE_PIXEL_LIGHTING.location,
       Config::GFX_FORCED_LIGHTING.location,
       Config::GFX_FORCED_DITHERING.location,
@@ -75,6 +88,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_FAST_DEPTH_CALC.location,
       Config::GFX_MSAA.location,
       Config::GFX_SSAA.location,
+      Config::GFX_POST_AA.location,
       Config::GFX_EFB_SCALE.location,
       Config::GFX_TEXFMT_OVERLAY_ENABLE.location,
       Config::GFX_TEXFMT_OVERLAY_CENTER.location,
@@ -96,12 +110,15 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_SW_DRAW_END.location,
       Config::GFX_BACKGROUND_SHADER_COMPILING.location,
       Config::GFX_DISABLE_SPECIALIZED_SHADERS.location,
+      Config::GFX_SHADER_COMPILER_THREADS.location,
       // Graphics.Enhancements
 
       Config::GFX_ENHANCE_FILTERING_MODE.location,
       Config::GFX_ENHANCE_MAX_ANISOTROPY.location,
       Config::GFX_ENHANCE_POST_ENABLED.location,
       Config::GFX_ENHANCE_POST_TRIGUER.location,
+      Config::GFX_ENHANCE_POST_BAKE_OPTIONS.location,
+      Config::GFX_ENHANCE_POST_DYNAMIC_SCALE.location,
       Config::GFX_ENHANCE_POST_SHADERS.location,
       Config::GFX_ENHANCE_SCALING_SHADER.location,
       Config::GFX_ENHANCE_FORCE_TRUE_COLOR.location,
@@ -110,6 +127,12 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_ENHANCE_TEXTURE_SCALING_TYPE.location,
       Config::GFX_ENHANCE_TEXTURE_SCALING_FACTOR.location,
       Config::GFX_ENHANCE_USE_DEPOSTERIZE.location,
+      Config::GFX_ENHANCE_TEXTURE_SCALING_ASYNC.location,
+      Config::GFX_ENHANCE_TEXTURE_SCALING_GPU.location,
+      Config::GFX_ENHANCE_TEXTURE_SCALING_CACHE.location,
+      Config::GFX_ENHANCE_TEXTURE_SCALING_CACHE_COMPRESS.location,
+      Config::GFX_ENHANCE_TEXTURE_SCALING_CACHE_SIZE.location,
+      Config::GFX_ENHANCE_TEXTURE_MEMORY_BUDGET.location,
       Config::GFX_ENHANCE_TESSELLATION.location,
       Config::GFX_ENHANCE_TESSELLATION_EARLY_CULLING.location,
       Config::GFX_ENHANCE_TESSELLATION_DISTANCE.location,
@@ -132,8 +155,10 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_HACK_EFB_ACCESS_ENABLE.location,
       Config::GFX_HACK_EFB_FAST_ACCESS_ENABLE.location,
       Config::GFX_HACK_BBOX_MODE.location,
+      Config::GFX_HACK_BBOX_PREDICTION_WINDOW.location,
       Config::GFX_HACK_FORCE_PROGRESSIVE.location,
       Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM.location,
+      Config::GFX_HACK_DEFER_EFB_COPIES.location,
       Config::GFX_HACK_COPY_EFB_SCALED.location,
       Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES.location,
       Config::GFX_HACK_VERTEX_ROUDING.location,
@@ -141,6 +166,10 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_HACK_FULL_ASYNC_SHADER_COMPILATION.location,
       Config::GFX_HACK_LAST_HISTORY_EFBTORAM.location,
       Config::GFX_HACK_FORCE_LOGICOP_BLEND.location,
+      Config::GFX_HACK_DISPLAY_LIST_CACHE.location,
+      Config::GFX_HACK_TRACK_TEXTURE_WRITES.location,
+      Config::GFX_HACK_SKIP_DUPLICATE_FRAMES.location,
+      Config::GFX_HACK_SKIP_DRAWING.location,
       Config::GFX_HACK_CULL_MODE.location,
 
       // Graphics.GameSpecific
@@ -151,6 +180,7 @@ bool IsSettingSaveable(const Config::ConfigLocation& config_location)
       Config::GFX_PROJECTION_HACK_ZNEAR.location,
       Config::GFX_PROJECTION_HACK_ZFAR.location,
       Config::GFX_PERF_QUERIES_ENABLE.location,
+      Config::GFX_PERF_QUERIES_APPROXIMATE.location,
 
   };
 
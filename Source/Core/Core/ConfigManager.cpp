@@ -239,6 +239,14 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("TimingVariance", iTimingVariance);
   core->Set("CPUCore", iCPUCore);
   core->Set("Fastmem", bFastmem);
+  core->Set("PageTableFastmem", bPageTableFastmem);
+  core->Set("JITPersistentCache", bJITPersistentCache);
+  core->Set("JITBLRShadowStack", bJITBLRShadowStack);
+  core->Set("JITRegisterCarryOver", bJITRegisterCarryOver);
+  core->Set("JITTraceFormation", bJITTraceFormation);
+  core->Set("JITBackgroundCompile", bJITBackgroundCompile);
+  core->Set("JITGenerationalCache", bJITGenerationalCache);
+  core->Set("JITIdleLoopDetection", bJITIdleLoopDetection);
   core->Set("CPUThread", bCPUThread);
   core->Set("DSPHLE", bDSPHLE);
   core->Set("SyncOnSkipIdle", bSyncGPUOnSkipIdleHack);
@@ -246,17 +254,23 @@ void SConfig::SaveCoreSettings(IniFile& ini)
   core->Set("SyncGpuMaxDistance", iSyncGpuMaxDistance);
   core->Set("SyncGpuMinDistance", iSyncGpuMinDistance);
   core->Set("SyncGpuOverclock", fSyncGpuOverclock);
+  core->Set("SyncGPUAdaptive", bSyncGPUAdaptive);
   core->Set("FPRF", bFPRF);
   core->Set("AccurateNaNs", bAccurateNaNs);
+  core->Set("DiscCacheSize", iDiscCacheSize);
+  core->Set("DiscReadAhead", bDiscReadAhead);
   core->Set("DefaultISO", m_strDefaultISO);
   core->Set("EnableCheats", bEnableCheats);
   core->Set("SelectedLanguage", SelectedLanguage);
   core->Set("OverrideGCLang", bOverrideGCLanguage);
   core->Set("DPL2Decoder", bDPL2Decoder);
   core->Set("DSPREHACK", bDSPREHACK);
+  core->Set("AXThread", bAXThread);
   core->Set("AudioLatency", iLatency);
   core->Set("AudioStretch", m_audio_stretch);
+  core->Set("AudioLowLatency", m_audio_low_latency);
   core->Set("AudioStretchMaxLatency", m_audio_stretch_max_latency);
+  core->Set("AudioStretchWSOLA", m_audio_stretch_wsola);
   core->Set("MemcardAPath", m_strMemoryCardA);
   core->Set("MemcardBPath", m_strMemoryCardB);
   core->Set("AgpCartAPath", m_strGbaCartA);
@@ -298,6 +312,7 @@ void SConfig::SaveMovieSettings(IniFile& ini)
   movie->Set("DumpFrames", m_DumpFrames);
   movie->Set("DumpFramesSilent", m_DumpFramesSilent);
   movie->Set("ShowInputDisplay", m_ShowInputDisplay);
+  movie->Set("Keyframes", m_MovieKeyframes);
   movie->Set("ShowRTC", m_ShowRTC);
 }
 
@@ -308,6 +323,7 @@ void SConfig::SaveDSPSettings(IniFile& ini)
   dsp->Set("EnableJIT", m_DSPEnableJIT);
   dsp->Set("DumpAudio", m_DumpAudio);
   dsp->Set("DumpAudioSilent", m_DumpAudioSilent);
+  dsp->Set("DumpAudioFLAC", m_DumpAudioFLAC);
   dsp->Set("DumpUCode", m_DumpUCode);
   dsp->Set("Backend", sBackend);
   dsp->Set("Volume", m_Volume);
@@ -534,6 +550,14 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("CPUCore", &iCPUCore, PowerPC::CORE_INTERPRETER);
 #endif
   core->Get("Fastmem", &bFastmem, true);
+  core->Get("PageTableFastmem", &bPageTableFastmem, false);
+  core->Get("JITPersistentCache", &bJITPersistentCache, false);
+  core->Get("JITBLRShadowStack", &bJITBLRShadowStack, false);
+  core->Get("JITRegisterCarryOver", &bJITRegisterCarryOver, false);
+  core->Get("JITTraceFormation", &bJITTraceFormation, false);
+  core->Get("JITBackgroundCompile", &bJITBackgroundCompile, false);
+  core->Get("JITGenerationalCache", &bJITGenerationalCache, false);
+  core->Get("JITIdleLoopDetection", &bJITIdleLoopDetection, false);
   core->Get("DSPHLE", &bDSPHLE, true);
   core->Get("TimingVariance", &iTimingVariance, 40);
   core->Get("CPUThread", &bCPUThread, true);
@@ -544,9 +568,12 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("OverrideGCLang", &bOverrideGCLanguage, false);
   core->Get("DPL2Decoder", &bDPL2Decoder, false);
   core->Get("DSPREHACK", &bDSPREHACK, false);
+  core->Get("AXThread", &bAXThread, false);
   core->Get("AudioLatency", &iLatency, 20);
   core->Get("AudioStretch", &m_audio_stretch, false);
+  core->Get("AudioLowLatency", &m_audio_low_latency, false);
   core->Get("AudioStretchMaxLatency", &m_audio_stretch_max_latency, 80);
+  core->Get("AudioStretchWSOLA", &m_audio_stretch_wsola, false);
   core->Get("MemcardAPath", &m_strMemoryCardA);
   core->Get("MemcardBPath", &m_strMemoryCardB);
   core->Get("AgpCartAPath", &m_strGbaCartA);
@@ -574,7 +601,10 @@ void SConfig::LoadCoreSettings(IniFile& ini)
   core->Get("SyncGpuMaxDistance", &iSyncGpuMaxDistance, 200000);
   core->Get("SyncGpuMinDistance", &iSyncGpuMinDistance, -200000);
   core->Get("SyncGpuOverclock", &fSyncGpuOverclock, 1.0f);
+  core->Get("SyncGPUAdaptive", &bSyncGPUAdaptive, false);
   core->Get("FastDiscSpeed", &bFastDiscSpeed, false);
+  core->Get("DiscCacheSize", &iDiscCacheSize, 32);
+  core->Get("DiscReadAhead", &bDiscReadAhead, true);
   core->Get("DCBZ", &bDCBZOFF, false);
   core->Get("LowDCBZHack", &bLowDCBZHack, false);
   core->Get("FPRF", &bFPRF, false);
@@ -601,6 +631,7 @@ void SConfig::LoadMovieSettings(IniFile& ini)
   movie->Get("DumpFrames", &m_DumpFrames, false);
   movie->Get("DumpFramesSilent", &m_DumpFramesSilent, false);
   movie->Get("ShowInputDisplay", &m_ShowInputDisplay, false);
+  movie->Get("Keyframes", &m_MovieKeyframes, false);
   movie->Get("ShowRTC", &m_ShowRTC, false);
 }
 
@@ -611,6 +642,7 @@ void SConfig::LoadDSPSettings(IniFile& ini)
   dsp->Get("EnableJIT", &m_DSPEnableJIT, true);
   dsp->Get("DumpAudio", &m_DumpAudio, false);
   dsp->Get("DumpAudioSilent", &m_DumpAudioSilent, false);
+  dsp->Get("DumpAudioFLAC", &m_DumpAudioFLAC, false);
   dsp->Get("DumpUCode", &m_DumpUCode, false);
   dsp->Get("Backend", &sBackend, AudioCommon::GetDefaultSoundBackend());
   dsp->Get("Volume", &m_Volume, 100);
@@ -802,6 +834,8 @@ void SConfig::LoadDefaults()
   iBBDumpPort = -1;
   bSyncGPU = false;
   bFastDiscSpeed = false;
+  iDiscCacheSize = 32;
+  bDiscReadAhead = true;
   m_strWiiSDCardPath = File::GetUserPath(F_WIISDCARD_IDX);
   bEnableMemcardSdWriting = true;
   SelectedLanguage = 0;
@@ -811,6 +845,8 @@ void SConfig::LoadDefaults()
   iLatency = 20;
   m_audio_stretch = false;
   m_audio_stretch_max_latency = 80;
+  m_audio_stretch_wsola = false;
+  m_audio_low_latency = false;
 
   iPosX = INT_MIN;
   iPosY = INT_MIN;
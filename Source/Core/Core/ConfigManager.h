@@ -92,6 +92,14 @@ struct SConfig
   bool bJITBranchOff = false;
 
   bool bFastmem;
+  bool bPageTableFastmem = false;
+  bool bJITPersistentCache = false;
+  bool bJITBLRShadowStack = false;
+  bool bJITRegisterCarryOver = false;
+  bool bJITTraceFormation = false;
+  bool bJITBackgroundCompile = false;
+  bool bJITGenerationalCache = false;
+  bool bJITIdleLoopDetection = false;
   bool bFPRF = false;
   bool bAccurateNaNs = false;
 
@@ -109,6 +117,8 @@ struct SConfig
   int iLatency = 20;
   bool m_audio_stretch = false;
   int m_audio_stretch_max_latency = 80;
+  bool m_audio_stretch_wsola = false;
+  bool m_audio_low_latency = false;
 
   bool bRunCompareServer = false;
   bool bRunCompareClient = false;
@@ -118,6 +128,9 @@ struct SConfig
   bool bLowDCBZHack = false;
   int iBBDumpPort = 0;
   bool bFastDiscSpeed = false;
+  // Decoded blocks of compressed disc images to keep, in MiB
+  int iDiscCacheSize = 32;
+  bool bDiscReadAhead = true;
   int iVideoRate = 8;
   bool bHalfAudioRate = false;
 
@@ -125,12 +138,14 @@ struct SConfig
   int iSyncGpuMaxDistance;
   int iSyncGpuMinDistance;
   float fSyncGpuOverclock;
+  bool bSyncGPUAdaptive = false;
 
   int SelectedLanguage = 0;
   bool bOverrideGCLanguage = false;
 
   bool bWii = false;
   bool bDSPREHACK = false;
+  bool bAXThread = false;
   bool m_is_mios = false;
 
   // Interface settings
@@ -291,6 +306,7 @@ struct SConfig
   bool m_DumpFrames;
   bool m_DumpFramesSilent;
   bool m_ShowInputDisplay;
+  bool m_MovieKeyframes;
 
   bool m_PauseOnFocusLost;
 
@@ -301,6 +317,7 @@ struct SConfig
   bool m_DSPCaptureLog;
   bool m_DumpAudio;
   bool m_DumpAudioSilent;
+  bool m_DumpAudioFLAC;
   bool m_IsMuted;
   bool m_DumpUCode;
   int m_Volume;
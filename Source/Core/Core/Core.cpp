@@ -11,6 +11,7 @@
 #include <queue>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -29,10 +30,14 @@
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPlacement.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
 
 #include "Core/Analytics.h"
 #include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/DSPEmulator.h"
@@ -102,7 +107,20 @@ static StateChangedCallbackFunc s_on_state_changed_callback;
 static std::thread s_cpu_thread;
 static bool s_request_refresh_info = false;
 static bool s_is_throttler_temp_disabled = false;
+static std::atomic<bool> s_is_catching_up{false};
 static bool s_frame_step = false;
+static std::string s_trace_export_path;
+
+struct BootStage
+{
+  const char* name;
+  u64 start_us;
+  u64 end_us;
+};
+static std::mutex s_boot_stages_lock;
+static std::vector<BootStage> s_boot_stages;
+static u64 s_boot_start_us = 0;
+static std::atomic<bool> s_boot_stages_pending{false};
 
 struct HostJob
 {
@@ -135,10 +153,23 @@ void SetIsThrottlerTempDisabled(bool disable)
   s_is_throttler_temp_disabled = disable;
 }
 
+bool IsCatchingUp()
+{
+  return s_is_catching_up.load(std::memory_order_relaxed);
+}
+
+void SetIsCatchingUp(bool catching_up)
+{
+  s_is_catching_up.store(catching_up, std::memory_order_relaxed);
+}
+
 void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
+  {
     NetPlayClient::SendTimeBase();
+    NetPlayClient::SendMemoryHashes();
+  }
 }
 
 // Display messages and return values
@@ -211,6 +242,79 @@ bool WantsDeterminism()
   return s_wants_determinism;
 }
 
+void StartBootTimings()
+{
+  std::lock_guard<std::mutex> guard(s_boot_stages_lock);
+  s_boot_stages.clear();
+  s_boot_start_us = Common::Timer::GetTimeUs();
+  s_boot_stages_pending.store(true);
+}
+
+BootStageTimer::BootStageTimer(const char* name)
+    : m_name(name), m_start_us(Common::Timer::GetTimeUs())
+{
+}
+
+BootStageTimer::~BootStageTimer()
+{
+  const u64 end_us = Common::Timer::GetTimeUs();
+  INFO_LOG(BOOT, "%s took %u ms", m_name, static_cast<u32>((end_us - m_start_us) / 1000));
+  TRACE_COMPLETE("Boot", m_name, end_us - m_start_us);
+  std::lock_guard<std::mutex> guard(s_boot_stages_lock);
+  s_boot_stages.push_back({m_name, m_start_us, end_us});
+}
+
+void SetTraceExportPath(const std::string& filename)
+{
+  s_trace_export_path = filename;
+  if (!s_trace_export_path.empty())
+    Common::Tracing::StartRecording();
+}
+
+void ToggleTraceRecordingOrExport()
+{
+  if (!Common::Tracing::IsRecording())
+  {
+    Common::Tracing::StartRecording();
+    DisplayMessage("Trace recording started.", 3000);
+    return;
+  }
+
+  Common::Tracing::StopRecording();
+  std::string filename = s_trace_export_path;
+  if (filename.empty())
+  {
+    filename = File::GetUserPath(D_DUMP_IDX) + "Debug/trace_" +
+               SConfig::GetInstance().GetGameID() + ".json";
+  }
+  File::CreateFullPath(filename);
+  if (Common::Tracing::ExportChromeTrace(filename))
+    DisplayMessage("Wrote trace to " + filename, 3000);
+  else
+    DisplayMessage("Could not write trace to " + filename, 3000);
+}
+
+// Each stage with the time it started and ended at since the boot started.
+static void LogBootStages()
+{
+  if (!s_boot_stages_pending.load(std::memory_order_relaxed) ||
+      !s_boot_stages_pending.exchange(false))
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(s_boot_stages_lock);
+  const u64 now_us = Common::Timer::GetTimeUs();
+  std::string stages;
+  for (const BootStage& stage : s_boot_stages)
+  {
+    stages += StringFromFormat("%s %u-%u ms, ", stage.name,
+                               static_cast<u32>((stage.start_us - s_boot_start_us) / 1000),
+                               static_cast<u32>((stage.end_us - s_boot_start_us) / 1000));
+  }
+  NOTICE_LOG(BOOT, "Boot stages: %sfirst frame at %u ms", stages.c_str(),
+             static_cast<u32>((now_us - s_boot_start_us) / 1000));
+}
+
 // This is called from the GUI thread. See the booting call schedule in
 // BootManager.cpp
 bool Init(std::unique_ptr<BootParameters> boot)
@@ -336,6 +440,7 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   const SConfig& _CoreParameter = SConfig::GetInstance();
 
   VideoBackendBase* video_backend = g_video_backend;
+  Common::PlaceCurrentThread(Common::ThreadRole::CPU);
   if (_CoreParameter.bCPUThread)
   {
     Common::SetCurrentThreadName("CPU thread");
@@ -343,7 +448,10 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
   else
   {
     Common::SetCurrentThreadName("CPU-GPU thread");
-    video_backend->Video_Prepare();
+    {
+      BootStageTimer timer("Video prepare");
+      video_backend->Video_Prepare();
+    }
     Host_Message(WM_USER_CREATE);
   }
 
@@ -402,13 +510,17 @@ static void FifoPlayerThread(const std::optional<std::string>& savestate_path,
   DeclareAsCPUThread();
   const SConfig& _CoreParameter = SConfig::GetInstance();
   VideoBackendBase* video_backend = g_video_backend;
+  Common::PlaceCurrentThread(Common::ThreadRole::CPU);
   if (_CoreParameter.bCPUThread)
   {
     Common::SetCurrentThreadName("FIFO player thread");
   }
   else
   {
-    video_backend->Video_Prepare();
+    {
+      BootStageTimer timer("Video prepare");
+      video_backend->Video_Prepare();
+    }
     Host_Message(WM_USER_CREATE);
     Common::SetCurrentThreadName("FIFO-GPU thread");
   }
@@ -464,6 +576,14 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     if (s_on_state_changed_callback)
       s_on_state_changed_callback(State::Uninitialized);
 
+    if (!s_trace_export_path.empty())
+    {
+      Common::Tracing::StopRecording();
+      File::CreateFullPath(s_trace_export_path);
+      if (!Common::Tracing::ExportChromeTrace(s_trace_export_path))
+        ERROR_LOG(CORE, "Could not write the trace to %s", s_trace_export_path.c_str());
+    }
+
     INFO_LOG(CONSOLE, "Stop\t\t---- Shutdown complete ----");
   } };
 
@@ -479,7 +599,25 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
   Movie::Init(*boot);
   Common::ScopeGuard movie_guard{ Movie::Shutdown };
 
-  HW::Init();
+  // Set before any of the emulation threads start, the thread pool follows on its own.
+  std::vector<Common::ThreadRole> dedicated_roles{ Common::ThreadRole::CPU };
+  if (core_parameter.bCPUThread)
+    dedicated_roles.push_back(Common::ThreadRole::GPU);
+  if (!core_parameter.bDSPHLE && core_parameter.bDSPThread)
+    dedicated_roles.push_back(Common::ThreadRole::DSP);
+  Common::SetThreadPlacement(
+      static_cast<Common::ThreadPlacement>(Config::Get(Config::MAIN_THREAD_PLACEMENT)),
+      dedicated_roles);
+  Common::ScopeGuard placement_guard{
+      [] { Common::SetThreadPlacement(Common::ThreadPlacement::Off, {}); } };
+
+  // For the emulated memory and the JIT code space, both allocated from here on.
+  Common::SetHugePagesEnabled(Config::Get(Config::MAIN_HUGE_PAGES));
+
+  {
+    BootStageTimer timer("HW");
+    HW::Init();
+  }
   Common::ScopeGuard hw_guard{ [] {
     // We must set up this flag before executing HW::Shutdown()
     s_hardware_initialized = false;
@@ -498,58 +636,67 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     HLE::Clear();
   } };
 
-  if (!video_backend->Initialize(s_window_handle))
-  {
-    PanicAlert("Failed to initialize video backend!");
-    return;
-  }
-  Common::ScopeGuard video_guard{ [&] { video_backend->Shutdown(); } };
-
-  OSD::AddMessage("Dolphin " + video_backend->GetName() + " Video Backend.", 5000);
-
   if (cpu_info.HTT)
     SConfig::GetInstance().bDSPThread = cpu_info.num_cores > 4;
   else
     SConfig::GetInstance().bDSPThread = cpu_info.num_cores > 2;
 
-  if (!DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread))
-  {
-    PanicAlert("Failed to initialize DSP emulation!");
-    return;
-  }
-
-  bool init_controllers = false;
-  if (!g_controller_interface.IsInit())
-  {
-    g_controller_interface.Initialize(s_window_handle);
-    Pad::Initialize();
-    Keyboard::Initialize();
-    init_controllers = true;
-  }
-  else
-  {
-    // Update references in case controllers were refreshed
-    Pad::LoadConfig();
-    Keyboard::LoadConfig();
-  }
-
   const std::optional<std::string> savestate_path = boot->savestate_path;
   const bool delete_savestate = boot->delete_savestate;
 
-  // Load and Init Wiimotes - only if we are booting in Wii mode
-  if (core_parameter.bWii && !SConfig::GetInstance().m_bt_passthrough_enabled)
-  {
-    if (init_controllers)
+  // The DSP and the controllers only need the hardware, so they start on the thread pool while
+  // the video backend, which has to stay on this thread, creates its device and loads its shader
+  // caches. The sound stream stays here too, some backends tie COM to the thread that creates it.
+  bool dsp_initialized = false;
+  bool init_controllers = false;
+  Common::TaskGroup init_tasks;
+  init_tasks.Run([&dsp_initialized, &core_parameter] {
+    BootStageTimer timer("DSP");
+    dsp_initialized =
+        DSP::GetDSPEmulator()->Initialize(core_parameter.bWii, core_parameter.bDSPThread);
+  });
+  init_tasks.Run([&init_controllers, &core_parameter, &savestate_path] {
+    BootStageTimer timer("Controllers");
+    if (!g_controller_interface.IsInit())
     {
-      Wiimote::Initialize(savestate_path ? Wiimote::InitializeMode::DO_WAIT_FOR_WIIMOTES :
-        Wiimote::InitializeMode::DO_NOT_WAIT_FOR_WIIMOTES);
+      g_controller_interface.Initialize(s_window_handle);
+      Pad::Initialize();
+      Keyboard::Initialize();
+      init_controllers = true;
     }
     else
     {
-      Wiimote::LoadConfig();
+      // Update references in case controllers were refreshed
+      Pad::LoadConfig();
+      Keyboard::LoadConfig();
+    }
+
+    // Load and Init Wiimotes - only if we are booting in Wii mode
+    if (core_parameter.bWii && !SConfig::GetInstance().m_bt_passthrough_enabled)
+    {
+      if (init_controllers)
+      {
+        Wiimote::Initialize(savestate_path ? Wiimote::InitializeMode::DO_WAIT_FOR_WIIMOTES :
+          Wiimote::InitializeMode::DO_NOT_WAIT_FOR_WIIMOTES);
+      }
+      else
+      {
+        Wiimote::LoadConfig();
+      }
     }
+  });
+
+  bool video_initialized;
+  {
+    BootStageTimer timer("Video backend");
+    video_initialized = video_backend->Initialize(s_window_handle);
   }
+  init_tasks.Wait();
 
+  Common::ScopeGuard video_guard{ [&] {
+    if (video_initialized)
+      video_backend->Shutdown();
+  } };
   Common::ScopeGuard controller_guard{ [init_controllers] {
     if (!init_controllers)
       return;
@@ -560,7 +707,28 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     g_controller_interface.Shutdown();
   } };
 
-  AudioCommon::InitSoundStream();
+  if (!video_initialized)
+  {
+    PanicAlert("Failed to initialize video backend!");
+    return;
+  }
+
+  OSD::AddMessage("Dolphin " + video_backend->GetName() + " Video Backend.", 5000);
+
+  if (!dsp_initialized)
+  {
+    PanicAlert("Failed to initialize DSP emulation!");
+    return;
+  }
+
+  if (Config::Get(Config::MAIN_PAD_SAMPLING_THREAD))
+    Pad::StartSampling();
+  Common::ScopeGuard sampling_guard{ Pad::StopSampling };
+
+  {
+    BootStageTimer timer("Audio");
+    AudioCommon::InitSoundStream();
+  }
   Common::ScopeGuard audio_guard{ AudioCommon::ShutdownSoundStream };
 
   // The hardware is initialized.
@@ -580,8 +748,11 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
   else
     cpuThreadFunc = CpuThread;
 
-  if (!CBoot::BootUp(std::move(boot)))
-    return;
+  {
+    BootStageTimer timer("Boot");
+    if (!CBoot::BootUp(std::move(boot)))
+      return;
+  }
 
   // This adds the SyncGPU handler to CoreTiming, so now CoreTiming::Advance might block.
   Fifo::Prepare();
@@ -610,8 +781,12 @@ static void EmuThread(std::unique_ptr<BootParameters> boot)
     // This thread, after creating the EmuWindow, spawns a CPU
     // thread, and then takes over and becomes the video thread
     Common::SetCurrentThreadName("Video thread");
+    Common::PlaceCurrentThread(Common::ThreadRole::GPU);
 
-    video_backend->Video_Prepare();
+    {
+      BootStageTimer timer("Video prepare");
+      video_backend->Video_Prepare();
+    }
     Host_Message(WM_USER_CREATE);
 
     // Spawn the CPU thread
@@ -878,6 +1053,8 @@ void Callback_VideoCopiedToXFB(bool video_update)
   if (video_update)
     s_drawn_frame++;
 
+  LogBootStages();
+
   if (s_frame_step)
   {
     s_frame_step = false;
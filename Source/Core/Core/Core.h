@@ -24,6 +24,11 @@ namespace Core
 bool GetIsThrottlerTempDisabled();
 void SetIsThrottlerTempDisabled(bool disable);
 
+// While set, frames are emulated unthrottled and neither shown nor heard. NetPlay uses this to
+// catch up again after rolling back.
+bool IsCatchingUp();
+void SetIsCatchingUp(bool catching_up);
+
 void Callback_VideoCopiedToXFB(bool video_update);
 
 enum class State
@@ -39,6 +44,30 @@ bool Init(std::unique_ptr<BootParameters> boot);
 void Stop();
 void Shutdown();
 
+// Times a stage of the boot from construction to destruction. The stages of a boot, some of which
+// run at the same time, are logged together once the first frame is out.
+class BootStageTimer
+{
+public:
+  explicit BootStageTimer(const char* name);
+  ~BootStageTimer();
+  BootStageTimer(const BootStageTimer&) = delete;
+  BootStageTimer& operator=(const BootStageTimer&) = delete;
+
+private:
+  const char* m_name;
+  u64 m_start_us;
+};
+// Starts timing a new boot, before its first stage.
+void StartBootTimings();
+
+// Set from the command line. Records trace events from now on and writes them to the file when
+// the emulation stops.
+void SetTraceExportPath(const std::string& filename);
+// Used by the export hotkey. Starts recording trace events of all threads if it isn't; otherwise
+// stops and writes them to the export path, or to the dump folder if there is none.
+void ToggleTraceRecordingOrExport();
+
 void DeclareAsCPUThread();
 void UndeclareAsCPUThread();
 
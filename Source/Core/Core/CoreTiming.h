@@ -84,6 +84,11 @@ void RemoveAllEvents(EventType* event_type);
 // NOTE: Advance updates the PowerPC downcount and performs a PPC external exception check.
 void Advance();
 void MoveEvents();
+
+// Runs the callback at the end of the current Advance, once its events are done. Nothing is in
+// progress there, so the whole state can be saved or loaded. CPU thread only.
+using SafePointCallback = void (*)();
+void RequestSafePoint(SafePointCallback callback);
 void ProcessFifoWaitEvents();
 
 // Pretend that the main CPU has executed enough cycles to reach the next event.
@@ -270,14 +270,7 @@ void DSPEmitter::Compile(u16 start_addr)
       DSPJitRegCache c(m_gpr);
       HandleLoop();
       m_gpr.SaveRegs();
-      if (!Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP)
-      {
-        MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-      }
-      else
-      {
-        MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-      }
+      MOV(16, R(EAX), Imm16(GetBlockExitCycles()));
       JMP(m_return_dispatcher, true);
       m_gpr.LoadRegs(false);
       m_gpr.FlushRegs(c, false);
@@ -304,14 +297,7 @@ void DSPEmitter::Compile(u16 start_addr)
         DSPJitRegCache c(m_gpr);
         // don't update g_dsp.pc -- the branch insn already did
         m_gpr.SaveRegs();
-        if (!Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP)
-        {
-          MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-        }
-        else
-        {
-          MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-        }
+        MOV(16, R(EAX), Imm16(GetBlockExitCycles()));
         JMP(m_return_dispatcher, true);
         m_gpr.LoadRegs(false);
         m_gpr.FlushRegs(c, false);
@@ -330,6 +316,9 @@ void DSPEmitter::Compile(u16 start_addr)
   if (fixup_pc)
   {
     MOV(16, M_SDSP_pc(), Imm16(m_compile_pc));
+
+    // Blocks cut off by the size limit or an idle skip address continue into the next one.
+    WriteLinkToBlock(m_compile_pc);
   }
 
   m_blocks[start_addr] = (DSPCompiledCode)entryPoint;
@@ -367,17 +356,19 @@ void DSPEmitter::Compile(u16 start_addr)
   }
 
   m_gpr.SaveRegs();
-  if (!Host::OnThread() && Analyzer::GetCodeFlags(start_addr) & Analyzer::CODE_IDLE_SKIP)
-  {
-    MOV(16, R(EAX), Imm16(DSP_IDLE_SKIP_CYCLES));
-  }
-  else
-  {
-    MOV(16, R(EAX), Imm16(m_block_size[start_addr]));
-  }
+  MOV(16, R(EAX), Imm16(GetBlockExitCycles()));
   JMP(m_return_dispatcher, true);
 }
 
+u16 DSPEmitter::GetBlockExitCycles() const
+{
+  // Mail wait loops burn the rest of their slice at once. This also holds on the DSP thread, which
+  // then sleeps until the CPU hands it more cycles instead of spinning through the loop.
+  if (Analyzer::GetCodeFlags(m_start_address) & Analyzer::CODE_IDLE_SKIP)
+    return DSP_IDLE_SKIP_CYCLES;
+  return m_block_size[m_start_address];
+}
+
 static void CompileCurrent(DSPEmitter& emitter)
 {
   emitter.Compile(g_dsp.pc);
@@ -212,6 +212,9 @@ public:
 private:
   void WriteBranchExit();
   void WriteBlockLink(u16 dest);
+  void WriteLinkToBlock(u16 dest);
+  // The cycles a block reports when it exits. Idle skip blocks give up a whole slice.
+  u16 GetBlockExitCycles() const;
 
   void ReJitConditional(UDSPInstruction opc, void (DSPEmitter::*conditional_fn)(UDSPInstruction));
   void r_jcc(UDSPInstruction opc);
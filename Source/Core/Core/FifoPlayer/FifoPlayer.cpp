@@ -29,6 +29,7 @@
 // We need to include TextureDecoder.h for the texMem array.
 // TODO: Move texMem somewhere else so this isn't an issue.
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TmemMirror.h"
 
 bool IsPlayingBackFifologWithBrokenEFBCopies = false;
 
@@ -486,6 +487,7 @@ void FifoPlayer::LoadTextureMemory()
   static_assert(static_cast<size_t>(TMEM_SIZE) == static_cast<size_t>(FifoDataFile::TEX_MEM_SIZE),
                 "TMEM_SIZE matches the size of texture memory in FifoDataFile");
   std::memcpy(texMem, m_File->GetTexMem(), FifoDataFile::TEX_MEM_SIZE);
+  TmemMirror::InvalidateAll();
 }
 
 void FifoPlayer::WriteCP(u32 address, u16 value)
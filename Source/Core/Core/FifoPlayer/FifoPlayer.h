@@ -92,6 +92,9 @@ public:
   // If enabled then all memory updates happen at once before the first frame
   // Default is disabled
   void SetEarlyMemoryUpdates(bool enabled) { m_EarlyMemoryUpdates = enabled; }
+  // Whether the frame range starts over at its end, instead of stopping the emulation. Defaults
+  // to the bLoopFifoReplay setting.
+  void SetLoop(bool loop) { m_Loop = loop; }
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback) { m_FileLoadedCb = callback; }
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = callback; }
@@ -37,6 +37,7 @@
 #include "Core/HW/MMIO.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/PowerPC/PowerPC.h"
 
 namespace DSP
@@ -494,6 +495,11 @@ static void Do_ARAM_DMA()
     s_arDMA.ARAddr &= 0x3ffffff;
     s_arDMA.MMAddr &= 0x3ffffff;
 
+    // Reported at once, instead of faulting on each watched page.
+    const u32 mm_address = s_arDMA.MMAddr;
+    const u32 mm_size = s_arDMA.Cnt.count;
+    WriteWatch::BeginWrite(mm_address, mm_size);
+
     if (s_arDMA.ARAddr < s_ARAM.size)
     {
       while (s_arDMA.Cnt.count)
@@ -530,6 +536,7 @@ static void Do_ARAM_DMA()
         s_arDMA.Cnt.count -= 8;
       }
     }
+    WriteWatch::Invalidate(mm_address, mm_size);
   }
   else
   {
@@ -541,6 +548,11 @@ static void Do_ARAM_DMA()
     s_arDMA.ARAddr &= 0x3ffffff;
     s_arDMA.MMAddr &= 0x3ffffff;
 
+    // Reported at once, instead of faulting on each watched page.
+    const u32 mm_address = s_arDMA.MMAddr;
+    const u32 mm_size = s_arDMA.Cnt.count;
+    WriteWatch::BeginWrite(mm_address, mm_size);
+
     if (s_arDMA.ARAddr < s_ARAM.size)
     {
       while (s_arDMA.Cnt.count)
@@ -95,6 +95,9 @@ void DSPHLE::SwapUCode(u32 crc)
 
 void DSPHLE::DoState(PointerWrap& p)
 {
+  if (m_ucode)
+    m_ucode->FinishPendingWork();
+
   bool is_hle = true;
   p.Do(is_hle);
   if (!is_hle && p.GetMode() == PointerWrap::MODE_READ)
@@ -144,6 +147,8 @@ u16 DSPHLE::DSP_ReadMailBoxHigh(bool cpu_mailbox)
   }
   else
   {
+    if (m_ucode)
+      m_ucode->FinishPendingWork();
     return AccessMailHandler().ReadDSPMailboxHigh();
   }
 }
@@ -156,6 +161,8 @@ u16 DSPHLE::DSP_ReadMailBoxLow(bool cpu_mailbox)
   }
   else
   {
+    if (m_ucode)
+      m_ucode->FinishPendingWork();
     return AccessMailHandler().ReadDSPMailboxLow();
   }
 }
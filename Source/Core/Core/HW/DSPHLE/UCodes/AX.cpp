@@ -11,6 +11,9 @@
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
@@ -30,6 +33,14 @@ AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc), m_cmdli
 
 AXUCode::~AXUCode()
 {
+  FinishPendingWork();
+  if (m_worker.joinable())
+  {
+    m_worker_quit = true;
+    m_work_ready.Set();
+    m_worker.join();
+  }
+
   m_mail_handler.Clear();
 }
 
@@ -90,7 +101,54 @@ void AXUCode::SignalWorkEnd()
   // For more information, see https://bugs.dolphin-emu.org/issues/10265.
   constexpr int AX_EMPTY_COMMAND_LIST_CYCLES = 2500;
 
-  m_mail_handler.PushMail(DSP_YIELD, true, AX_EMPTY_COMMAND_LIST_CYCLES);
+  PostMail(DSP_YIELD, true, AX_EMPTY_COMMAND_LIST_CYCLES);
+}
+
+void AXUCode::PostMail(u32 mail, bool interrupt, int cycles_into_future)
+{
+  if (m_work_pending)
+    m_deferred_mails.emplace_back(mail, interrupt, cycles_into_future);
+  else
+    m_mail_handler.PushMail(mail, interrupt, cycles_into_future);
+}
+
+void AXUCode::RunCommandListOnWorker()
+{
+  if (!m_worker.joinable())
+    m_worker = std::thread(&AXUCode::WorkerThread, this);
+
+  m_work_pending = true;
+  m_work_ready.Set();
+}
+
+void AXUCode::WorkerThread()
+{
+  Common::SetCurrentThreadName("AX worker");
+
+  while (true)
+  {
+    m_work_ready.Wait();
+    if (m_worker_quit)
+      return;
+
+    HandleCommandList();
+    m_cmdlist_size = 0;
+    SignalWorkEnd();
+    m_work_done.Set();
+  }
+}
+
+void AXUCode::FinishPendingWork()
+{
+  if (!m_work_pending)
+    return;
+
+  m_work_done.Wait();
+  m_work_pending = false;
+
+  for (const auto& mail : m_deferred_mails)
+    m_mail_handler.PushMail(std::get<0>(mail), std::get<1>(mail), std::get<2>(mail));
+  m_deferred_mails.clear();
 }
 
 void AXUCode::HandleCommandList()
@@ -620,12 +678,25 @@ void AXUCode::HandleMail(u32 mail)
 
   bool set_next_is_cmdlist = false;
 
+  // The CPU may read the results of the previous command list once it sends more mail.
+  FinishPendingWork();
+
   if (next_is_cmdlist)
   {
     CopyCmdList(mail, cmdlist_size);
-    HandleCommandList();
-    m_cmdlist_size = 0;
-    SignalWorkEnd();
+
+    // Games may touch the PBs while the list runs, which can race with the worker, so NetPlay and
+    // movies always process command lists here.
+    if (SConfig::GetInstance().bAXThread && !Core::WantsDeterminism())
+    {
+      RunCommandListOnWorker();
+    }
+    else
+    {
+      HandleCommandList();
+      m_cmdlist_size = 0;
+      SignalWorkEnd();
+    }
   }
   else if (m_upload_setup_in_progress)
   {
@@ -678,6 +749,8 @@ void AXUCode::CopyCmdList(u32 addr, u16 size)
 
 void AXUCode::Update()
 {
+  FinishPendingWork();
+
   // Used for UCode switching.
   if (NeedsResumeMail())
   {
@@ -12,7 +12,12 @@
 
 #pragma once
 
+#include <thread>
+#include <tuple>
+#include <vector>
+
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
 namespace DSP
@@ -64,6 +69,7 @@ public:
   void Initialize() override;
   void HandleMail(u32 mail) override;
   void Update() override;
+  void FinishPendingWork() override;
   void DoState(PointerWrap& p) override;
 
 protected:
@@ -114,6 +120,8 @@ protected:
 
   virtual void HandleCommandList();
   void SignalWorkEnd();
+  // Mails posted while a command list runs on the worker thread are held back until it finishes.
+  void PostMail(u32 mail, bool interrupt, int cycles_into_future = 0);
 
   void SetupProcessing(u32 init_addr);
   void DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16 vol_auxb);
@@ -131,6 +139,19 @@ protected:
   void DoAXState(PointerWrap& p);
 
 private:
+  // Command lists can run on a worker thread. Their results are handed to the CPU at the next DSP
+  // update, mail from the CPU or read of the DSP mailbox, which all happen at the same emulated
+  // time however long the list takes, so the CPU thread only waits if the list isn't done by then.
+  void RunCommandListOnWorker();
+  void WorkerThread();
+
+  std::thread m_worker;
+  Common::Event m_work_ready;
+  Common::Event m_work_done;
+  bool m_work_pending = false;
+  bool m_worker_quit = false;
+  std::vector<std::tuple<u32, bool, int>> m_deferred_mails;
+
   enum CmdType
   {
     CMD_SETUP = 0x00,
@@ -15,6 +15,10 @@
 #include <functional>
 #include <memory>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "Core/DSP/DSPAccelerator.h"
@@ -396,6 +400,28 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.adpcm.pred_scale = s_accelerator->GetPredScale();
 }
 
+#if defined(_M_X86_64)
+// The volumes of eight consecutive samples, starting at volume and changing by delta per sample.
+__m128i RampVolumes(u16 volume, u16 delta)
+{
+  return _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)),
+                       _mm_mullo_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7),
+                                       _mm_set1_epi16(static_cast<s16>(delta))));
+}
+
+// (sample * volume) >> 15 clamped to [-32767, 32767] for eight samples and unsigned volumes.
+__m128i ScaleSamples(__m128i samples, __m128i volumes)
+{
+  // The signed high half treats volumes from 0x8000 as negative, which is off by the sample.
+  const __m128i low = _mm_mullo_epi16(samples, volumes);
+  const __m128i high = _mm_add_epi16(_mm_mulhi_epi16(samples, volumes),
+                                     _mm_and_si128(samples, _mm_srai_epi16(volumes, 15)));
+  const __m128i scaled = _mm_packs_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(low, high), 15),
+                                         _mm_srai_epi32(_mm_unpackhi_epi16(low, high), 15));
+  return _mm_max_epi16(scaled, _mm_set1_epi16(-32767));
+}
+#endif
+
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
 {
@@ -408,7 +434,27 @@ void MixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ra
   if (!ramp)
     volume_delta = 0;
 
-  for (u32 i = 0; i < count; ++i)
+  u32 i = 0;
+#if defined(_M_X86_64)
+  // Eight samples at a time, with the same results as the loop below.
+  __m128i volumes = RampVolumes(volume, volume_delta);
+  const __m128i volume_step = _mm_set1_epi16(static_cast<s16>(volume_delta * 8));
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i scaled =
+        ScaleSamples(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), volumes);
+    __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst),
+                                        _mm_srai_epi32(_mm_unpacklo_epi16(scaled, scaled), 16)));
+    _mm_storeu_si128(dst + 1, _mm_add_epi32(_mm_loadu_si128(dst + 1),
+                                            _mm_srai_epi32(_mm_unpackhi_epi16(scaled, scaled), 16)));
+    volumes = _mm_add_epi16(volumes, volume_step);
+    *dpop = static_cast<s16>(_mm_extract_epi16(scaled, 7));
+  }
+  volume += volume_delta * i;
+#endif
+
+  for (; i < count; ++i)
   {
     s64 sample = input[i];
     sample *= volume;
@@ -445,7 +491,20 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
+  u32 i = 0;
+#if defined(_M_X86_64)
+  const u16 env_delta = static_cast<u16>(pb.vol_env.cur_volume_delta);
+  __m128i env_volumes = RampVolumes(pb.vol_env.cur_volume, env_delta);
+  const __m128i env_step = _mm_set1_epi16(static_cast<s16>(env_delta * 8));
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i* ptr = reinterpret_cast<__m128i*>(samples + i);
+    _mm_storeu_si128(ptr, ScaleSamples(_mm_loadu_si128(ptr), env_volumes));
+    env_volumes = _mm_add_epi16(env_volumes, env_step);
+  }
+  pb.vol_env.cur_volume += env_delta * i;
+#endif
+  for (; i < count; ++i)
   {
     samples[i] = MathUtil::Clamp(((s32)samples[i] * pb.vol_env.cur_volume) >> 15, -32767,
                                  32767);  // -32768 ?
@@ -33,6 +33,8 @@ AXWiiUCode::AXWiiUCode(DSPHLE* dsphle, u32 crc) : AXUCode(dsphle, crc), m_last_m
 
 AXWiiUCode::~AXWiiUCode()
 {
+  // The command list running on the worker may still use our buffers.
+  FinishPendingWork();
 }
 
 void AXWiiUCode::HandleCommandList()
@@ -613,7 +615,7 @@ void AXWiiUCode::OutputSamples(u32 lr_addr, u32 surround_addr, u16 volume, bool
   }
 
   memcpy(HLEMemory_Get_Pointer(lr_addr), buffer, sizeof(buffer));
-  m_mail_handler.PushMail(DSP_SYNC, true);
+  PostMail(DSP_SYNC, true);
 }
 
 void AXWiiUCode::OutputWMSamples(u32* addresses)
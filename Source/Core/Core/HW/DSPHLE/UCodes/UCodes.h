@@ -48,6 +48,9 @@ public:
   virtual void Initialize() = 0;
   virtual void HandleMail(u32 mail) = 0;
   virtual void Update() = 0;
+  // Finishes work running on another thread and posts its mails. Called before the CPU can see the
+  // mails of the DSP.
+  virtual void FinishPendingWork() {}
 
   virtual void DoState(PointerWrap& p) { DoStateShared(p); }
   static u32 GetCRC(UCodeInterface* ucode) { return ucode ? ucode->m_crc : UCODE_NULL; }
@@ -1506,25 +1506,8 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
   }
   else
   {
-    for (auto& dst_sample : *dst)
-    {
-      // We have 0x40 * 4 coeffs that need to be selected based on the
-      // most significant bits of the fractional part of the position. 12
-      // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
-      // consecutive coeffs.
-      u32 coeffs_idx = ((pos & 0xFFF) >> 6) * 4;
-      const s16* coeffs = &m_resampling_coeffs[coeffs_idx];
-      const s16* input = &src[pos >> 12];
-
-      s64 dst_sample_unclamped = 0;
-      for (size_t i = 0; i < 4; ++i)
-        dst_sample_unclamped += (s64)2 * coeffs[i] * input[i];
-      dst_sample_unclamped >>= 16;
-
-      dst_sample = (s16)MathUtil::Clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
-
-      pos += ratio;
-    }
+    pos = ResampleWithCoeffs(dst->data(), dst->size(), src, pos, ratio, m_resampling_coeffs,
+                             m_resampling_coeffs_fit_s32);
   }
 
   for (u32 i = 0; i < 4; ++i)
@@ -1834,6 +1817,7 @@ void ZeldaAudioRenderer::DoState(PointerWrap& p)
   p.Do(m_buf_unk2);
 
   p.Do(m_resampling_coeffs);
+  UpdateResamplingCoeffsFitS32();
   p.Do(m_const_patterns);
   p.Do(m_sine_table);
   p.Do(m_afc_coeffs);
@@ -4,8 +4,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -16,6 +23,218 @@ namespace HLE
 {
 class DSPHLE;
 
+// Utility functions for audio operations. They process eight samples at a time where SSE2 or NEON
+// is available and give the same results as the per sample loops.
+
+#if defined(_M_X86_64)
+// (samples * vol) >> shift, clamped to s16.
+inline __m128i MulVolumeClamped(__m128i samples, u16 vol, int shift)
+{
+  const __m128i volume = _mm_set1_epi16(static_cast<s16>(vol));
+  const __m128i low = _mm_mullo_epi16(samples, volume);
+  __m128i high = _mm_mulhi_epi16(samples, volume);
+  // mulhi takes volumes from 0x8000 up as negative, which is 0x10000 * samples off.
+  if (vol & 0x8000)
+    high = _mm_add_epi16(high, samples);
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(low, high), shift),
+                         _mm_srai_epi32(_mm_unpackhi_epi16(low, high), shift));
+}
+#elif defined(_M_ARM_64)
+inline int16x8_t MulVolumeClamped(int16x8_t samples, u16 vol, int shift)
+{
+  const int32x4_t volume = vdupq_n_s32(vol);
+  const int32x4_t right_shift = vdupq_n_s32(-shift);
+  const int32x4_t low = vshlq_s32(vmulq_s32(vmovl_s16(vget_low_s16(samples)), volume), right_shift);
+  const int32x4_t high =
+      vshlq_s32(vmulq_s32(vmovl_s16(vget_high_s16(samples)), volume), right_shift);
+  return vcombine_s16(vqmovn_s32(low), vqmovn_s32(high));
+}
+#endif
+
+// Apply volume to a buffer. The volume is a fixed point integer, usually
+// 1.15 or 4.12 in the DAC UCode.
+template <size_t N, size_t B>
+void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
+{
+  size_t i = 0;
+#if defined(_M_X86_64)
+  for (; i + 8 <= N; i += 8)
+  {
+    __m128i* samples = reinterpret_cast<__m128i*>(&(*buf)[i]);
+    _mm_storeu_si128(samples, MulVolumeClamped(_mm_loadu_si128(samples), vol, 16 - B));
+  }
+#elif defined(_M_ARM_64)
+  for (; i + 8 <= N; i += 8)
+    vst1q_s16(&(*buf)[i], MulVolumeClamped(vld1q_s16(&(*buf)[i]), vol, 16 - B));
+#endif
+  for (; i < N; ++i)
+  {
+    s32 tmp = (u32)(*buf)[i] * (u32)vol;
+    tmp >>= 16 - B;
+
+    (*buf)[i] = (s16)MathUtil::Clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+template <size_t N>
+void ApplyVolumeInPlace_1_15(std::array<s16, N>* buf, u16 vol)
+{
+  ApplyVolumeInPlace<N, 1>(buf, vol);
+}
+template <size_t N>
+void ApplyVolumeInPlace_4_12(std::array<s16, N>* buf, u16 vol)
+{
+  ApplyVolumeInPlace<N, 4>(buf, vol);
+}
+
+// Mixes two buffers together while applying a volume to one of them. The
+// volume ramps up/down in N steps using the provided step delta value.
+//
+// Note: On a real GC, the stepping happens in 32 steps instead. But hey,
+// we can do better here with very low risk. Why not? :)
+template <size_t N>
+s32 AddBuffersWithVolumeRamp(std::array<s16, N>* dst, const std::array<s16, N>& src, s32 vol,
+                             s32 step)
+{
+  if (!vol && !step)
+    return vol;
+
+  size_t i = 0;
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+  // The volumes of eight samples, in 1.31 format. Computed unsigned, they wrap around.
+  const u32 ustep = static_cast<u32>(step);
+  const s32 steps[8] = {0,
+                        static_cast<s32>(ustep),
+                        static_cast<s32>(ustep * 2),
+                        static_cast<s32>(ustep * 3),
+                        static_cast<s32>(ustep * 4),
+                        static_cast<s32>(ustep * 5),
+                        static_cast<s32>(ustep * 6),
+                        static_cast<s32>(ustep * 7)};
+#endif
+#if defined(_M_X86_64)
+  const __m128i steps_low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(steps));
+  const __m128i steps_high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(steps + 4));
+  for (; i + 8 <= N; i += 8)
+  {
+    const __m128i base = _mm_set1_epi32(vol);
+    const __m128i volumes =
+        _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(base, steps_low), 16),
+                        _mm_srai_epi32(_mm_add_epi32(base, steps_high), 16));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    __m128i* out = reinterpret_cast<__m128i*>(&(*dst)[i]);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_mulhi_epi16(volumes, samples)));
+    vol = static_cast<s32>(static_cast<u32>(vol) + ustep * 8);
+  }
+#elif defined(_M_ARM_64)
+  const int32x4_t steps_low = vld1q_s32(steps);
+  const int32x4_t steps_high = vld1q_s32(steps + 4);
+  for (; i + 8 <= N; i += 8)
+  {
+    const int32x4_t base = vdupq_n_s32(vol);
+    const int16x4_t volumes_low = vshrn_n_s32(vaddq_s32(base, steps_low), 16);
+    const int16x4_t volumes_high = vshrn_n_s32(vaddq_s32(base, steps_high), 16);
+    const int16x8_t samples = vld1q_s16(&src[i]);
+    const int16x8_t mixed =
+        vcombine_s16(vshrn_n_s32(vmull_s16(volumes_low, vget_low_s16(samples)), 16),
+                     vshrn_n_s32(vmull_s16(volumes_high, vget_high_s16(samples)), 16));
+    vst1q_s16(&(*dst)[i], vaddq_s16(vld1q_s16(&(*dst)[i]), mixed));
+    vol = static_cast<s32>(static_cast<u32>(vol) + ustep * 8);
+  }
+#endif
+  for (; i < N; ++i)
+  {
+    (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
+    vol += step;
+  }
+
+  return vol;
+}
+
+// Does not use std::array because it needs to be able to process partial
+// buffers. Volume is in 1.15 format.
+inline void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+#if defined(_M_X86_64)
+  for (; count >= 8; count -= 8, src += 8, dst += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i* out = reinterpret_cast<__m128i*>(dst);
+    _mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), MulVolumeClamped(samples, vol, 15)));
+  }
+#elif defined(_M_ARM_64)
+  for (; count >= 8; count -= 8, src += 8, dst += 8)
+    vst1q_s16(dst, vaddq_s16(vld1q_s16(dst), MulVolumeClamped(vld1q_s16(src), vol, 15)));
+#endif
+  while (count--)
+  {
+    s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
+    *dst++ += MathUtil::Clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
+// Interpolates count samples from src with the four tap filters in coeffs, selected by the top 6
+// bits of the fractional position. pos and ratio are in 20.12 format, returns the position after
+// the last sample. The SSE2 path sums pairs of products in 32 bits, which only overflows for
+// coefficients of -0x8000, so it is only used when coeffs_fit_s32 says there are none.
+inline u32 ResampleWithCoeffs(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                              const std::array<s16, 0x100>& coeffs, bool coeffs_fit_s32)
+{
+  size_t i = 0;
+#if defined(_M_X86_64)
+  if (coeffs_fit_s32)
+  {
+    for (; i + 2 <= count; i += 2)
+    {
+      const u32 next_pos = pos + ratio;
+      const __m128i input = _mm_unpacklo_epi64(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&src[pos >> 12])),
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&src[next_pos >> 12])));
+      const __m128i taps = _mm_unpacklo_epi64(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&coeffs[((pos & 0xFFF) >> 6) * 4])),
+          _mm_loadl_epi64(
+              reinterpret_cast<const __m128i*>(&coeffs[((next_pos & 0xFFF) >> 6) * 4])));
+      alignas(16) s32 sums[4];
+      _mm_store_si128(reinterpret_cast<__m128i*>(sums), _mm_madd_epi16(taps, input));
+      dst[i] = (s16)MathUtil::Clamp<s64>(((s64)2 * ((s64)sums[0] + sums[1])) >> 16, -0x8000,
+                                         0x7FFF);
+      dst[i + 1] = (s16)MathUtil::Clamp<s64>(((s64)2 * ((s64)sums[2] + sums[3])) >> 16,
+                                             -0x8000, 0x7FFF);
+      pos = next_pos + ratio;
+    }
+  }
+#elif defined(_M_ARM_64)
+  for (; i < count; ++i)
+  {
+    // The products are widened, so this is exact for any coefficients.
+    const int32x4_t products =
+        vmull_s16(vld1_s16(&coeffs[((pos & 0xFFF) >> 6) * 4]), vld1_s16(&src[pos >> 12]));
+    const s64 sum = vaddvq_s64(vpaddlq_s32(products));
+    dst[i] = (s16)MathUtil::Clamp<s64>((2 * sum) >> 16, -0x8000, 0x7FFF);
+    pos += ratio;
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    // We have 0x40 * 4 coeffs that need to be selected based on the
+    // most significant bits of the fractional part of the position. 12
+    // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
+    // consecutive coeffs.
+    u32 coeffs_idx = ((pos & 0xFFF) >> 6) * 4;
+    const s16* taps = &coeffs[coeffs_idx];
+    const s16* input = &src[pos >> 12];
+
+    s64 dst_sample_unclamped = 0;
+    for (size_t j = 0; j < 4; ++j)
+      dst_sample_unclamped += (s64)2 * taps[j] * input[j];
+    dst_sample_unclamped >>= 16;
+
+    dst[i] = (s16)MathUtil::Clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+
+    pos += ratio;
+  }
+  return pos;
+}
+
 class ZeldaAudioRenderer
 {
 public:
@@ -26,7 +245,11 @@ public:
   void SetFlags(u32 flags) { m_flags = flags; }
   void SetSineTable(std::array<s16, 0x80>&& sine_table) { m_sine_table = sine_table; }
   void SetConstPatterns(std::array<s16, 0x100>&& patterns) { m_const_patterns = patterns; }
-  void SetResamplingCoeffs(std::array<s16, 0x100>&& coeffs) { m_resampling_coeffs = coeffs; }
+  void SetResamplingCoeffs(std::array<s16, 0x100>&& coeffs)
+  {
+    m_resampling_coeffs = coeffs;
+    UpdateResamplingCoeffsFitS32();
+  }
   void SetAfcCoeffs(std::array<s16, 0x20>&& coeffs) { m_afc_coeffs = coeffs; }
   void SetVPBBaseAddress(u32 addr) { m_vpb_base_addr = addr; }
   void SetReverbPBBaseAddress(u32 addr) { m_reverb_pb_base_addr = addr; }
@@ -42,64 +265,6 @@ private:
   // See Zelda.cpp for the list of possible flags.
   u32 m_flags;
 
-  // Utility functions for audio operations.
-
-  // Apply volume to a buffer. The volume is a fixed point integer, usually
-  // 1.15 or 4.12 in the DAC UCode.
-  template <size_t N, size_t B>
-  void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
-  {
-    for (size_t i = 0; i < N; ++i)
-    {
-      s32 tmp = (u32)(*buf)[i] * (u32)vol;
-      tmp >>= 16 - B;
-
-      (*buf)[i] = (s16)MathUtil::Clamp(tmp, -0x8000, 0x7FFF);
-    }
-  }
-  template <size_t N>
-  void ApplyVolumeInPlace_1_15(std::array<s16, N>* buf, u16 vol)
-  {
-    ApplyVolumeInPlace<N, 1>(buf, vol);
-  }
-  template <size_t N>
-  void ApplyVolumeInPlace_4_12(std::array<s16, N>* buf, u16 vol)
-  {
-    ApplyVolumeInPlace<N, 4>(buf, vol);
-  }
-
-  // Mixes two buffers together while applying a volume to one of them. The
-  // volume ramps up/down in N steps using the provided step delta value.
-  //
-  // Note: On a real GC, the stepping happens in 32 steps instead. But hey,
-  // we can do better here with very low risk. Why not? :)
-  template <size_t N>
-  s32 AddBuffersWithVolumeRamp(std::array<s16, N>* dst, const std::array<s16, N>& src, s32 vol,
-                               s32 step)
-  {
-    if (!vol && !step)
-      return vol;
-
-    for (size_t i = 0; i < N; ++i)
-    {
-      (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
-      vol += step;
-    }
-
-    return vol;
-  }
-
-  // Does not use std::array because it needs to be able to process partial
-  // buffers. Volume is in 1.15 format.
-  void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
-  {
-    while (count--)
-    {
-      s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
-      *dst++ += MathUtil::Clamp(vol_src, -0x8000, 0x7FFF);
-    }
-  }
-
   // Whether the frame needs to be prepared or not.
   bool m_prepared = false;
 
@@ -156,6 +321,14 @@ private:
 
   // Coefficients used for resampling.
   std::array<s16, 0x100> m_resampling_coeffs{};
+  // Whether ResampleWithCoeffs can use its SSE2 path with these coefficients.
+  bool m_resampling_coeffs_fit_s32 = true;
+  void UpdateResamplingCoeffsFitS32()
+  {
+    m_resampling_coeffs_fit_s32 =
+        std::none_of(m_resampling_coeffs.begin(), m_resampling_coeffs.end(),
+                     [](s16 coeff) { return coeff == -0x8000; });
+  }
 
   // If non zero, base MRAM address for sound data transfers from ARAM. On
   // the Wii, this points to some MRAM location since there is no ARAM to be
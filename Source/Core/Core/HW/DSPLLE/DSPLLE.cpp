@@ -15,6 +15,8 @@
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPlacement.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/DSP/DSPAccelerator.h"
@@ -92,6 +94,7 @@ void DSPLLE::DoState(PointerWrap& p)
 void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 {
   Common::SetCurrentThreadName("DSP thread");
+  Common::PlaceCurrentThread(Common::ThreadRole::DSP);
 
   while (dsp_lle->m_is_running.IsSet())
   {
@@ -99,6 +102,7 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
     if (cycles > 0)
     {
       std::lock_guard<std::mutex> dsp_thread_lock(dsp_lle->m_dsp_thread_mutex);
+      TRACE_SCOPE("DSP", "Run cycles");
       if (g_dsp_jit)
       {
         DSPCore_RunCycles(cycles);
@@ -291,21 +291,12 @@ void DoState(PointerWrap& p)
 
 static size_t ProcessDTKSamples(std::vector<s16>* temp_pcm, const std::vector<u8>& audio_data)
 {
-  size_t samples_processed = 0;
-  size_t bytes_processed = 0;
-  while (samples_processed < temp_pcm->size() / 2 && bytes_processed < audio_data.size())
-  {
-    StreamADPCM::DecodeBlock(&(*temp_pcm)[samples_processed * 2], &audio_data[bytes_processed]);
-    for (size_t i = 0; i < StreamADPCM::SAMPLES_PER_BLOCK * 2; ++i)
-    {
-      // TODO: Fix the mixer so it can accept non-byte-swapped samples.
-      s16* sample = &(*temp_pcm)[samples_processed * 2 + i];
-      *sample = Common::swap16(*sample);
-    }
-    samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
-    bytes_processed += StreamADPCM::ONE_BLOCK_SIZE;
-  }
-  return samples_processed;
+  // TODO: Fix the mixer so it can accept non-byte-swapped samples.
+  const size_t block_count =
+      std::min(temp_pcm->size() / 2 / StreamADPCM::SAMPLES_PER_BLOCK,
+               audio_data.size() / StreamADPCM::ONE_BLOCK_SIZE);
+  StreamADPCM::DecodeBlocks(temp_pcm->data(), audio_data.data(), block_count);
+  return block_count * StreamADPCM::SAMPLES_PER_BLOCK;
 }
 
 static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
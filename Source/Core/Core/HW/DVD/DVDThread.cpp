@@ -4,6 +4,7 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <map>
 #include <memory>
@@ -18,10 +19,12 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -63,12 +66,21 @@ struct ReadRequest
 
 using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+struct QueuedRequest
+{
+  ReadRequest request;
+  // When the emulated software gets the result, in ticks
+  u64 deadline_ticks;
+};
+
 static void StartDVDThread();
 static void StopDVDThread();
 
 static void DVDThread();
 static void WaitUntilIdle();
 
+static const u8* GetMappedData(const ReadRequest& request);
+
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
   const DiscIO::Partition& partition,
   DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
@@ -83,12 +95,29 @@ static Common::Event s_request_queue_expanded;    // Is set by CPU thread
 static Common::Event s_result_queue_expanded;     // Is set by DVD thread
 static Common::Flag s_dvd_thread_exiting(false);  // Is set by CPU thread
 
-static Common::SPSCQueue<ReadRequest, false> s_request_queue;
+static Common::SPSCQueue<QueuedRequest, false> s_request_queue;
 static Common::SPSCQueue<ReadResult, false> s_result_queue;
 static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Streamed audio is read a few blocks at a time every few milliseconds. After answering such a
+// read, the DVD thread reads ahead of the stream, so the next ones are copies instead of waiting
+// for the disc image. Only used by the DVD thread, and by SetDisc while it is idle.
+static constexpr u32 DTK_PREFETCH_SIZE = 0x10000;
+static u64 s_dtk_prefetch_offset = 0;
+static std::vector<u8> s_dtk_prefetch_buffer;
+
+// Once reads follow each other on the disc, the blob is asked to decode what comes next in the
+// background. Only used by the DVD thread, and by SetDisc while it is idle.
+static constexpr u64 MIN_READ_AHEAD_SIZE = 0x40000;
+static constexpr u64 MAX_READ_AHEAD_SIZE = 0x400000;
+static bool s_read_ahead_enabled = false;
+// Limit for requests that are read from the disc at once
+static constexpr u64 MAX_COMBINED_READ_SIZE = 0x100000;
+static u64 s_last_read_end = 0;
+static DiscIO::Partition s_last_read_partition;
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -145,6 +174,16 @@ void DoState(PointerWrap& p)
   while (s_result_queue.Pop(result))
     s_result_map.emplace(result.first.id, std::move(result));
 
+  // Results that FinishRead would copy straight from the disc image get their data here,
+  // so that the savestate can be loaded with any format of the disc.
+  for (auto& entry : s_result_map)
+  {
+    ReadResult& pending_result = entry.second;
+    const u8* data = pending_result.second.empty() ? GetMappedData(pending_result.first) : nullptr;
+    if (data)
+      pending_result.second.assign(data, data + pending_result.first.length);
+  }
+
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(s_result_map);
   p.Do(s_next_id);
@@ -179,6 +218,16 @@ void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
   s_disc = std::move(disc);
+  s_dtk_prefetch_buffer.clear();
+
+  s_read_ahead_enabled = SConfig::GetInstance().bDiscReadAhead;
+  s_last_read_end = 0;
+  s_last_read_partition = DiscIO::Partition();
+  if (s_disc)
+  {
+    const int cache_size_mb = std::max(SConfig::GetInstance().iDiscCacheSize, 0);
+    s_disc->SetCacheSize(static_cast<u64>(cache_size_mb) << 20);
+  }
 }
 
 bool HasDisc()
@@ -268,7 +317,8 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   request.time_started_ticks = CoreTiming::GetTicks();
   request.realtime_started_us = Common::Timer::GetTimeUs();
 
-  s_request_queue.Push(std::move(request));
+  const u64 deadline_ticks = request.time_started_ticks + ticks_until_completion;
+  s_request_queue.Push(QueuedRequest{std::move(request), deadline_ticks});
   s_request_queue_expanded.Set();
 
   CoreTiming::ScheduleEvent(ticks_until_completion, s_finish_read, id);
@@ -310,6 +360,8 @@ static void FinishRead(u64 id, s64 cycles_late)
 
   const ReadRequest& request = result.first;
   const std::vector<u8>& buffer = result.second;
+  // The DVD thread skips reading data that can be copied straight from the disc image
+  const u8* mapped_data = buffer.empty() ? GetMappedData(request) : nullptr;
 
   DEBUG_LOG(DVDINTERFACE, "Disc has been read. Real time: %" PRIu64 " us. "
     "Real time including delay: %" PRIu64 " us. "
@@ -319,7 +371,11 @@ static void FinishRead(u64 id, s64 cycles_late)
     (CoreTiming::GetTicks() - request.time_started_ticks) /
     (SystemTimers::GetTicksPerSecond() / 1000000));
 
-  if (buffer.size() != request.length)
+  if (mapped_data)
+  {
+    Memory::CopyToEmu(request.output_address, mapped_data, request.length);
+  }
+  else if (buffer.size() != request.length)
   {
     PanicAlertT("The disc could not be read (at 0x%" PRIx64 " - 0x%" PRIx64 ").",
       request.dvd_offset, request.dvd_offset + request.length);
@@ -335,10 +391,163 @@ static void FinishRead(u64 id, s64 cycles_late)
     buffer);
 }
 
+// Can be called from the CPU thread while the DVD thread is running, because the mapping
+// of a disc image never changes while the volume exists.
+static const u8* GetMappedData(const ReadRequest& request)
+{
+  // Streamed audio is sent to DVDInterface, so it needs a buffer anyway
+  if (!s_disc || !request.copy_to_ram || request.reply_type == DVDInterface::ReplyType::DTK)
+    return nullptr;
+
+  return s_disc->GetMappedData(request.dvd_offset, request.length, request.partition);
+}
+
+static bool ReadPrefetchedDTK(u64 dvd_offset, u32 length, u8* buffer)
+{
+  if (dvd_offset < s_dtk_prefetch_offset ||
+      dvd_offset + length > s_dtk_prefetch_offset + s_dtk_prefetch_buffer.size())
+  {
+    return false;
+  }
+
+  std::copy_n(&s_dtk_prefetch_buffer[dvd_offset - s_dtk_prefetch_offset], length, buffer);
+  return true;
+}
+
+static void PrefetchDTK(u64 dvd_offset)
+{
+  // Refill once less than half of the buffer is left ahead of the stream.
+  if (dvd_offset >= s_dtk_prefetch_offset &&
+      dvd_offset + DTK_PREFETCH_SIZE / 2 <= s_dtk_prefetch_offset + s_dtk_prefetch_buffer.size())
+  {
+    return;
+  }
+
+  s_dtk_prefetch_buffer.resize(DTK_PREFETCH_SIZE);
+  s_dtk_prefetch_offset = dvd_offset;
+  // Near the end of the disc the stream is read directly again.
+  if (!s_disc->Read(dvd_offset, DTK_PREFETCH_SIZE, s_dtk_prefetch_buffer.data(),
+                    DiscIO::PARTITION_NONE))
+  {
+    s_dtk_prefetch_buffer.clear();
+  }
+}
+
+static void ReadAhead(const ReadRequest& request)
+{
+  const bool sequential = request.partition == s_last_read_partition &&
+                          request.dvd_offset == s_last_read_end;
+  s_last_read_partition = request.partition;
+  s_last_read_end = request.dvd_offset + request.length;
+  if (!sequential)
+    return;
+
+  // A few requests' worth, the game is likely to keep streaming.
+  const u64 size =
+      MathUtil::Clamp<u64>(request.length * 4ULL, MIN_READ_AHEAD_SIZE, MAX_READ_AHEAD_SIZE);
+  s_disc->ReadAhead(s_last_read_end, size, request.partition);
+}
+
+// Takes the most urgent request, and the requests that continue it on the disc. A DVD command
+// is split into one request per ECC block, so this turns them back into a single host read.
+static std::vector<ReadRequest> TakeNextRequests(std::vector<QueuedRequest>* pending)
+{
+  std::vector<ReadRequest> requests;
+  requests.push_back(std::move(pending->front().request));
+  pending->erase(pending->begin());
+
+  const ReadRequest& first = requests.front();
+  if (first.reply_type == DVDInterface::ReplyType::DTK || GetMappedData(first))
+    return requests;
+
+  u64 end_offset = first.dvd_offset + first.length;
+  u64 total_length = first.length;
+  for (auto it = pending->begin(); it != pending->end();)
+  {
+    const ReadRequest& request = it->request;
+    if (request.partition != first.partition || request.dvd_offset != end_offset ||
+        request.reply_type == DVDInterface::ReplyType::DTK ||
+        total_length + request.length > MAX_COMBINED_READ_SIZE || GetMappedData(request))
+    {
+      ++it;
+      continue;
+    }
+
+    end_offset += request.length;
+    total_length += request.length;
+    requests.push_back(std::move(it->request));
+    it = pending->erase(it);
+  }
+  return requests;
+}
+
+static void ProcessRequests(std::vector<ReadRequest> requests)
+{
+  TRACE_SCOPE("DVD", "Read");
+  const ReadRequest& first = requests.front();
+  const ReadRequest& last = requests.back();
+  std::vector<u8> combined;
+  bool combined_ok = false;
+  if (requests.size() > 1)
+  {
+    combined.resize(last.dvd_offset + last.length - first.dvd_offset);
+    combined_ok = s_disc->Read(first.dvd_offset, combined.size(), combined.data(), first.partition);
+  }
+
+  auto combined_it = combined.begin();
+  for (ReadRequest& request : requests)
+  {
+    FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
+
+    // FinishRead copies this straight from the disc image into emulated memory. Ask the OS to
+    // load it now, so that the CPU thread is less likely to wait for the disc image.
+    if (GetMappedData(request))
+    {
+      s_disc->ReadAhead(request.dvd_offset, request.length, request.partition);
+      request.realtime_done_us = Common::Timer::GetTimeUs();
+      s_result_queue.Push(ReadResult(std::move(request), std::vector<u8>()));
+      s_result_queue_expanded.Set();
+      continue;
+    }
+
+    const bool dtk = request.reply_type == DVDInterface::ReplyType::DTK;
+    const u64 end_offset = request.dvd_offset + request.length;
+
+    std::vector<u8> buffer(request.length);
+    if (combined_ok)
+    {
+      std::copy_n(combined_it, request.length, buffer.begin());
+      combined_it += request.length;
+    }
+    // If the combined read failed, find out which of the requests did.
+    else if (!(dtk && ReadPrefetchedDTK(request.dvd_offset, request.length, buffer.data())) &&
+             !s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+    {
+      buffer.resize(0);
+    }
+
+    request.realtime_done_us = Common::Timer::GetTimeUs();
+
+    const bool read_ok = !buffer.empty();
+    if (!dtk && read_ok && s_read_ahead_enabled && &request == &requests.back())
+      ReadAhead(request);
+
+    s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
+    s_result_queue_expanded.Set();
+
+    if (dtk && read_ok)
+      PrefetchDTK(end_offset);
+  }
+}
+
 static void DVDThread()
 {
   Common::SetCurrentThreadName("DVD thread");
 
+  // Requests taken off s_request_queue, ordered by when the emulated software needs them. They
+  // are all answered before the thread exits, since WaitUntilIdle only waits for the queue.
+  std::vector<QueuedRequest> pending;
+
   while (true)
   {
     s_request_queue_expanded.Wait();
@@ -346,22 +555,22 @@ static void DVDThread()
     if (s_dvd_thread_exiting.IsSet())
       return;
 
-    ReadRequest request;
-    while (s_request_queue.Pop(request))
+    while (true)
     {
-      FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
-
-      std::vector<u8> buffer(request.length);
-      if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
-
-      request.realtime_done_us = Common::Timer::GetTimeUs();
-
-      s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
-      s_result_queue_expanded.Set();
+      QueuedRequest queued;
+      while (s_request_queue.Pop(queued))
+      {
+        const auto it = std::upper_bound(pending.begin(), pending.end(), queued.deadline_ticks,
+                                         [](u64 deadline, const QueuedRequest& other) {
+                                           return deadline < other.deadline_ticks;
+                                         });
+        pending.insert(it, std::move(queued));
+      }
+
+      if (pending.empty())
+        break;
 
-      if (s_dvd_thread_exiting.IsSet())
-        return;
+      ProcessRequests(TakeNextRequests(&pending));
     }
   }
 }
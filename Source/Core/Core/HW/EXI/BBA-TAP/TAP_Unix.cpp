@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
+#include <cerrno>
 #include <cstring>
 
 #ifndef _WIN32
@@ -18,8 +20,9 @@
 #include <linux/if_tun.h>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
-#include <sys/select.h>
 #include <sys/socket.h>
 #endif
 
@@ -70,6 +73,18 @@ bool CEXIETHERNET::Activate()
   }
   ioctl(fd, TUNSETNOCSUM, 1);
 
+  // The read thread drains every queued frame before it waits again.
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (wakeup_fd < 0)
+  {
+    ERROR_LOG(SP1, "Couldn't create the BBA read thread eventfd");
+    close(fd);
+    fd = -1;
+    return false;
+  }
+
   INFO_LOG(SP1, "BBA initialized with associated tap %s", ifr.ifr_name);
   return RecvInit();
 #else
@@ -81,13 +96,22 @@ bool CEXIETHERNET::Activate()
 void CEXIETHERNET::Deactivate()
 {
 #ifdef __linux__
-  close(fd);
-  fd = -1;
+  if (!IsActivated())
+    return;
 
   readEnabled.Clear();
   readThreadShutdown.Set();
+  const u64 value = 1;
+  if (write(wakeup_fd, &value, sizeof(value)) != sizeof(value))
+    ERROR_LOG(SP1, "Couldn't wake the BBA read thread up");
   if (readThread.joinable())
     readThread.join();
+  readThreadShutdown.Clear();
+
+  close(wakeup_fd);
+  wakeup_fd = -1;
+  close(fd);
+  fd = -1;
 #else
   NOTIMPLEMENTED("Deactivate");
 #endif
@@ -129,27 +153,25 @@ static void ReadThreadHandler(CEXIETHERNET* self)
 {
   while (!self->readThreadShutdown.IsSet())
   {
-    fd_set rfds;
-    FD_ZERO(&rfds);
-    FD_SET(self->fd, &rfds);
-
-    struct timeval timeout;
-    timeout.tv_sec = 0;
-    timeout.tv_usec = 50000;
-    if (select(self->fd + 1, &rfds, nullptr, nullptr, &timeout) <= 0)
+    std::array<pollfd, 2> pollfds{{{self->fd, POLLIN, 0}, {self->wakeup_fd, POLLIN, 0}}};
+    if (poll(pollfds.data(), pollfds.size(), -1) <= 0 || pollfds[1].revents != 0)
       continue;
 
-    int readBytes = read(self->fd, self->mRecvBuffer.get(), BBA_RECV_SIZE);
-    if (readBytes < 0)
-    {
-      ERROR_LOG(SP1, "Failed to read from BBA, err=%d", readBytes);
-    }
-    else if (self->readEnabled.IsSet())
+    while (true)
     {
-      DEBUG_LOG(SP1, "Read data: %s",
-                ArrayToString(self->mRecvBuffer.get(), readBytes, 0x10).c_str());
-      self->mRecvBufferLength = readBytes;
-      self->RecvHandlePacket();
+      u8* const buffer = self->GetRecvSlot();
+      const ssize_t readBytes = read(self->fd, buffer, BBA_RECV_SIZE);
+      if (readBytes < 0)
+      {
+        bool would_block = errno == EAGAIN;
+#if EWOULDBLOCK != EAGAIN
+        would_block |= errno == EWOULDBLOCK;
+#endif
+        if (!would_block && errno != EINTR)
+          ERROR_LOG(SP1, "Failed to read from BBA, err=%d", errno);
+        break;
+      }
+      self->PushRecvFrame(buffer, static_cast<u32>(readBytes));
     }
   }
 }
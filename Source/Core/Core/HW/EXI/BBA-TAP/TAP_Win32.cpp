@@ -269,9 +269,9 @@ static void ReadThreadHandler(CEXIETHERNET* self)
   {
     DWORD transferred;
 
-    // Read from TAP into internal buffer.
-    if (ReadFile(self->mHAdapter, self->mRecvBuffer.get(), BBA_RECV_SIZE, &transferred,
-                 &self->mReadOverlapped))
+    // Read from TAP straight into the receive ring.
+    u8* const buffer = self->GetRecvSlot();
+    if (ReadFile(self->mHAdapter, buffer, BBA_RECV_SIZE, &transferred, &self->mReadOverlapped))
     {
       // Returning immediately is not likely to happen, but if so, reset the event state manually.
       ResetEvent(self->mReadOverlapped.hEvent);
@@ -298,14 +298,8 @@ static void ReadThreadHandler(CEXIETHERNET* self)
       }
     }
 
-    // Copy to BBA buffer, and fire interrupt if enabled.
-    DEBUG_LOG(SP1, "Received %u bytes:\n %s", transferred,
-              ArrayToString(self->mRecvBuffer.get(), transferred, 0x10).c_str());
-    if (self->readEnabled.IsSet())
-    {
-      self->mRecvBufferLength = transferred;
-      self->RecvHandlePacket();
-    }
+    // Hand the frame to the CPU thread, which copies it to the BBA buffer.
+    self->PushRecvFrame(buffer, transferred);
   }
 }
 
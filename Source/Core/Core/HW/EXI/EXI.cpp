@@ -13,6 +13,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/EXI/EXI_Channel.h"
+#include "Core/HW/EXI/EXI_DeviceEthernet.h"
 #include "Core/HW/EXI/EXI_DeviceMemoryCard.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/ProcessorInterface.h"
@@ -69,6 +70,7 @@ void Init()
   }
 
   CEXIMemoryCard::Init();
+  CEXIETHERNET::Init();
   for (u32 i = 0; i < MAX_EXI_CHANNELS; i++)
     g_Channels[i] = std::make_unique<CEXIChannel>(i);
 
@@ -89,6 +91,7 @@ void Shutdown()
     channel.reset();
 
   CEXIMemoryCard::Shutdown();
+  CEXIETHERNET::Shutdown();
 }
 
 void DoState(PointerWrap& p)
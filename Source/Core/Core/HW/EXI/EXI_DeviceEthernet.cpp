@@ -11,6 +11,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Network.h"
+#include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/EXI/EXI.h"
@@ -18,6 +19,8 @@
 
 namespace ExpansionInterface
 {
+static CoreTiming::EventType* s_et_recv;
+
 // XXX: The BBA stores multi-byte elements as little endian.
 // Multiple parts of this implementation depend on Dolphin
 // being compiled for a little endian host.
@@ -27,8 +30,8 @@ CEXIETHERNET::CEXIETHERNET()
   tx_fifo = std::make_unique<u8[]>(BBA_TXFIFO_SIZE);
   mBbaMem = std::make_unique<u8[]>(BBA_MEM_SIZE);
 
+  mRecvRing = std::make_unique<RecvFrame[]>(RECV_RING_SIZE);
   mRecvBuffer = std::make_unique<u8[]>(BBA_RECV_SIZE);
-  mRecvBufferLength = 0;
 
   MXHardReset();
 
@@ -57,6 +60,9 @@ CEXIETHERNET::CEXIETHERNET()
 #elif defined(__linux__) || defined(__APPLE__)
   fd = -1;
 #endif
+#ifdef __linux__
+  wakeup_fd = -1;
+#endif
 }
 
 CEXIETHERNET::~CEXIETHERNET()
@@ -64,6 +70,16 @@ CEXIETHERNET::~CEXIETHERNET()
   Deactivate();
 }
 
+void CEXIETHERNET::Init()
+{
+  s_et_recv = CoreTiming::RegisterEvent("BBARecv", RecvCallback);
+}
+
+void CEXIETHERNET::Shutdown()
+{
+  s_et_recv = nullptr;
+}
+
 void CEXIETHERNET::SetCS(int cs)
 {
   if (cs)
@@ -204,6 +220,10 @@ void CEXIETHERNET::DoState(PointerWrap& p)
 {
   p.DoArray(tx_fifo.get(), BBA_TXFIFO_SIZE);
   p.DoArray(mBbaMem.get(), BBA_MEM_SIZE);
+
+  // The event that was scheduled for pending frames may not be in the loaded state.
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    mRecvScheduled.Clear();
 }
 
 bool CEXIETHERNET::IsMXCommand(u32 const data)
@@ -441,7 +461,7 @@ inline u8 CEXIETHERNET::HashIndex(const u8* dest_eth_addr)
   return crc >> 26;
 }
 
-inline bool CEXIETHERNET::RecvMACFilter()
+inline bool CEXIETHERNET::RecvMACFilter(const u8* frame)
 {
   static u8 const broadcast[] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
 
@@ -450,11 +470,11 @@ inline bool CEXIETHERNET::RecvMACFilter()
     return true;
 
   // Unicast?
-  if ((mRecvBuffer[0] & 0x01) == 0)
+  if ((frame[0] & 0x01) == 0)
   {
-    return memcmp(mRecvBuffer.get(), &mBbaMem[BBA_NAFR_PAR0], 6) == 0;
+    return memcmp(frame, &mBbaMem[BBA_NAFR_PAR0], 6) == 0;
   }
-  else if (memcmp(mRecvBuffer.get(), broadcast, 6) == 0)
+  else if (memcmp(frame, broadcast, 6) == 0)
   {
     // Accept broadcast?
     return !!(mBbaMem[BBA_NCRB] & NCRB_AB);
@@ -467,7 +487,7 @@ inline bool CEXIETHERNET::RecvMACFilter()
   else
   {
     // Lookup the dest eth address in the hashmap
-    u16 index = HashIndex(mRecvBuffer.get());
+    u16 index = HashIndex(frame);
     return !!(mBbaMem[BBA_NAFR_MAR0 + index / 8] & (1 << (index % 8)));
   }
 }
@@ -484,7 +504,7 @@ inline void CEXIETHERNET::inc_rwp()
 
 // This function is on the critical path for receiving data.
 // Be very careful about calling into the logger and other slow things
-bool CEXIETHERNET::RecvHandlePacket()
+bool CEXIETHERNET::RecvHandlePacket(const u8* frame, u32 length)
 {
   u8* write_ptr;
   u8* end_ptr;
@@ -493,12 +513,11 @@ bool CEXIETHERNET::RecvHandlePacket()
   u32 status = 0;
   u16 rwp_initial = page_ptr(BBA_RWP);
 
-  if (!RecvMACFilter())
+  if (!RecvMACFilter(frame))
     goto wait_for_next;
 
 #ifdef BBA_TRACK_PAGE_PTRS
-  INFO_LOG(SP1, "RecvHandlePacket %x\n%s", mRecvBufferLength,
-           ArrayToString(mRecvBuffer, mRecvBufferLength, 0x100).c_str());
+  INFO_LOG(SP1, "RecvHandlePacket %x\n%s", length, ArrayToString(frame, length, 0x100).c_str());
 
   INFO_LOG(SP1, "%x %x %x %x", page_ptr(BBA_BP), page_ptr(BBA_RRP), page_ptr(BBA_RWP),
            page_ptr(BBA_RHBP));
@@ -511,9 +530,9 @@ bool CEXIETHERNET::RecvHandlePacket()
   descriptor = (Descriptor*)write_ptr;
   write_ptr += 4;
 
-  for (u32 i = 0, off = 4; i < mRecvBufferLength; ++i, ++off)
+  for (u32 i = 0, off = 4; i < length; ++i, ++off)
   {
-    *write_ptr++ = mRecvBuffer[i];
+    *write_ptr++ = frame[i];
 
     if (off == 0xff)
     {
@@ -544,7 +563,7 @@ bool CEXIETHERNET::RecvHandlePacket()
   }
 
   // Align up to next page
-  if ((mRecvBufferLength + 4) % 256)
+  if ((length + 4) % 256)
     inc_rwp();
 
 #ifdef BBA_TRACK_PAGE_PTRS
@@ -553,7 +572,7 @@ bool CEXIETHERNET::RecvHandlePacket()
 #endif
 
   // Is the current frame multicast?
-  if (mRecvBuffer[0] & 0x01)
+  if (frame[0] & 0x01)
     status |= DESC_MF;
 
   if (status & DESC_BF)
@@ -568,7 +587,7 @@ bool CEXIETHERNET::RecvHandlePacket()
     }
   }
 
-  descriptor->set(*(u16*)&mBbaMem[BBA_RWP], 4 + mRecvBufferLength, status);
+  descriptor->set(*(u16*)&mBbaMem[BBA_RWP], 4 + length, status);
 
   mBbaMem[BBA_LRPS] = status;
 
@@ -578,7 +597,7 @@ bool CEXIETHERNET::RecvHandlePacket()
     mBbaMem[BBA_IR] |= INT_R;
 
     exi_status.interrupt |= exi_status.TRANSFER;
-    ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::NON_CPU, 0);
+    ExpansionInterface::ScheduleUpdateInterrupts(CoreTiming::FromThread::CPU, 0);
   }
   else
   {
@@ -592,4 +611,58 @@ wait_for_next:
 
   return true;
 }
+
+// Called from the read thread.
+u8* CEXIETHERNET::GetRecvSlot()
+{
+  const u32 write = mRecvRingWrite.load(std::memory_order_relaxed);
+  if (write - mRecvRingRead.load(std::memory_order_acquire) == RECV_RING_SIZE)
+    return mRecvBuffer.get();
+  return mRecvRing[write % RECV_RING_SIZE].data;
+}
+
+// Called from the read thread once a frame was read into the buffer from GetRecvSlot.
+void CEXIETHERNET::PushRecvFrame(const u8* buffer, u32 length)
+{
+  DEBUG_LOG(SP1, "Read data: %s", ArrayToString(buffer, length, 0x10).c_str());
+  if (!readEnabled.IsSet())
+    return;
+
+  if (buffer == mRecvBuffer.get())
+  {
+    WARN_LOG(SP1, "Dropping received frame, %u frames are already pending", RECV_RING_SIZE);
+    return;
+  }
+
+  const u32 write = mRecvRingWrite.load(std::memory_order_relaxed);
+  mRecvRing[write % RECV_RING_SIZE].length = length;
+  mRecvRingWrite.store(write + 1);
+
+  if (mRecvScheduled.TestAndSet())
+    CoreTiming::ScheduleEvent(0, s_et_recv, 0, CoreTiming::FromThread::NON_CPU);
+}
+
+void CEXIETHERNET::RecvPendingFrames()
+{
+  mRecvScheduled.Clear();
+
+  u32 read = mRecvRingRead.load(std::memory_order_relaxed);
+  const u32 write = mRecvRingWrite.load();
+  for (; read != write; ++read)
+  {
+    // Frames that arrived before receiving was stopped are dropped.
+    const RecvFrame& frame = mRecvRing[read % RECV_RING_SIZE];
+    if (mBbaMem[BBA_NCRA] & NCRA_SR)
+      RecvHandlePacket(frame.data, frame.length);
+  }
+  mRecvRingRead.store(read, std::memory_order_release);
+}
+
+void CEXIETHERNET::RecvCallback(u64 userdata, s64 cycles_late)
+{
+  // The adapter may have been removed since the frames were read.
+  auto* const device = static_cast<CEXIETHERNET*>(ExpansionInterface::FindDevice(EXIDEVICE_ETH));
+  if (device)
+    device->RecvPendingFrames();
+}
 }  // namespace ExpansionInterface
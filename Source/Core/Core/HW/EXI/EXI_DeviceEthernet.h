@@ -210,6 +210,10 @@ public:
   void DMARead(u32 addr, u32 size) override;
   void DoState(PointerWrap& p) override;
 
+  // CoreTiming events need to be registered during boot, like the memory card ones.
+  static void Init();
+  static void Shutdown();
+
   // private:
   struct
   {
@@ -304,9 +308,9 @@ public:
   void SendFromPacketBuffer();
   void SendComplete();
   u8 HashIndex(const u8* dest_eth_addr);
-  bool RecvMACFilter();
+  bool RecvMACFilter(const u8* frame);
   void inc_rwp();
-  bool RecvHandlePacket();
+  bool RecvHandlePacket(const u8* frame, u32 length);
 
   std::unique_ptr<u8[]> mBbaMem;
   std::unique_ptr<u8[]> tx_fifo;
@@ -320,8 +324,27 @@ public:
   void RecvStart();
   void RecvStop();
 
+  // Frames are handed from the read thread to the CPU thread through a ring, without locking.
+  // The read thread reads each frame straight into a free slot, and the CPU thread copies it
+  // from there into the receive buffer in mBbaMem.
+  struct RecvFrame
+  {
+    u32 length;
+    u8 data[BBA_RECV_SIZE];
+  };
+  static constexpr u32 RECV_RING_SIZE = 32;
+
+  u8* GetRecvSlot();
+  void PushRecvFrame(const u8* buffer, u32 length);
+  void RecvPendingFrames();
+  static void RecvCallback(u64 userdata, s64 cycles_late);
+
+  std::unique_ptr<RecvFrame[]> mRecvRing;
+  std::atomic<u32> mRecvRingRead{0};
+  std::atomic<u32> mRecvRingWrite{0};
+  Common::Flag mRecvScheduled;
+  // Frames that don't fit in the ring are read in here and dropped.
   std::unique_ptr<u8[]> mRecvBuffer;
-  u32 mRecvBufferLength;
 
 #if defined(_WIN32)
   HANDLE mHAdapter;
@@ -332,6 +355,10 @@ public:
 #elif defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
   int fd;
 #endif
+#ifdef __linux__
+  // Wakes the read thread up to exit.
+  int wakeup_fd;
+#endif
 
 #if defined(WIN32) || defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__) ||          \
     defined(__OpenBSD__)
@@ -520,11 +520,29 @@ bool GCMemcardDirectory::SetUsedBlocks(int save_index)
   return true;
 }
 
+bool GCMemcardDirectory::WriteGCI(const PendingWrite& write)
+{
+  // Write to a temporary file and rename it, so that a crash can't leave a truncated save behind
+  const std::string temp_name = File::GetTempFilenameForAtomicWrite(write.filename);
+  {
+    File::IOFile gci(temp_name, "wb");
+    if (!gci)
+      return false;
+    gci.WriteBytes(&write.header, DENTRY_SIZE);
+    gci.WriteBytes(write.save_data.data(), BLOCK_SIZE * write.save_data.size());
+    if (!gci.Flush() || !gci.IsGood())
+      return false;
+  }
+  return File::RenameSync(temp_name, write.filename);
+}
+
 void GCMemcardDirectory::FlushToFile()
 {
+  std::lock_guard<std::mutex> flush_lock(m_flush_mutex);
   std::unique_lock<std::mutex> l(m_write_mutex);
-  int errors = 0;
-  DEntry invalid;
+  // Only the saves are copied while the CPU thread may have to wait for the lock.
+  // They are written to disk after it has been released.
+  std::vector<PendingWrite> writes;
   for (u16 i = 0; i < m_saves.size(); ++i)
   {
     if (m_saves[i].m_dirty)
@@ -557,27 +575,8 @@ void GCMemcardDirectory::FlushToFile()
                         default_save_name.c_str());
           m_saves[i].m_filename = default_save_name;
         }
-        File::IOFile gci(m_saves[i].m_filename, "wb");
-        if (gci)
-        {
-          gci.WriteBytes(&m_saves[i].m_gci_header, DENTRY_SIZE);
-          gci.WriteBytes(m_saves[i].m_save_data.data(), BLOCK_SIZE * m_saves[i].m_save_data.size());
-
-          if (gci.IsGood())
-          {
-            Core::DisplayMessage(
-                StringFromFormat("Wrote save contents to %s", m_saves[i].m_filename.c_str()), 4000);
-          }
-          else
-          {
-            ++errors;
-            Core::DisplayMessage(StringFromFormat("Failed to write save contents to %s",
-                                                  m_saves[i].m_filename.c_str()),
-                                 4000);
-            ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s",
-                      m_saves[i].m_filename.c_str());
-          }
-        }
+        writes.push_back(
+            {m_saves[i].m_filename, m_saves[i].m_gci_header, m_saves[i].m_save_data});
       }
       else if (m_saves[i].m_filename.length() != 0)
       {
@@ -612,6 +611,22 @@ void GCMemcardDirectory::FlushToFile()
   File::IOFile hdrfile(m_save_directory + MC_HDR, "wb");
   hdrfile.WriteBytes(mc, BLOCK_SIZE * MC_FST_BLOCKS);
 #endif
+  l.unlock();
+
+  for (const PendingWrite& write : writes)
+  {
+    if (WriteGCI(write))
+    {
+      Core::DisplayMessage(StringFromFormat("Wrote save contents to %s", write.filename.c_str()),
+                           4000);
+    }
+    else
+    {
+      Core::DisplayMessage(
+          StringFromFormat("Failed to write save contents to %s", write.filename.c_str()), 4000);
+      ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s", write.filename.c_str());
+    }
+  }
 }
 
 void GCMemcardDirectory::DoState(PointerWrap& p)
@@ -37,6 +37,16 @@ public:
   void DoState(PointerWrap& p) override;
 
 private:
+  // A copy of a save that FlushToFile writes after releasing m_write_mutex
+  struct PendingWrite
+  {
+    std::string filename;
+    DEntry header;
+    std::vector<GCMBlock> save_data;
+  };
+
+  static bool WriteGCI(const PendingWrite& write);
+
   int LoadGCI(const std::string& file_name, bool current_game_only);
   inline s32 SaveAreaRW(u32 block, bool writing = false);
   // s32 DirectoryRead(u32 offset, u32 length, u8* dest_address);
@@ -57,6 +67,8 @@ private:
   std::string m_save_directory;
   Common::Event m_flush_trigger;
   std::mutex m_write_mutex;
+  // Held for a whole flush, so that the files of an older flush can't overwrite newer ones
+  std::mutex m_flush_mutex;
   Common::Flag m_exiting;
   std::thread m_flush_thread;
 };
@@ -4,9 +4,16 @@
 
 #include "Core/HW/GCPad.h"
 
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <thread>
+#include <type_traits>
 
 #include "Common/Common.h"
+#include "Common/Flag.h"
+#include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/HW/GCPadEmu.h"
 #include "InputCommon/ControllerEmu/ControlGroup/ControlGroup.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
@@ -16,6 +23,75 @@
 namespace Pad
 {
 static InputConfig s_config("GCPadNew", _trans("Pad"), "GCPad");
+
+// The sampling thread is the only writer. Readers retry while the sequence is odd, or changed
+// while they were reading, which only happens while a sample is being written.
+static_assert(std::is_trivially_copyable_v<GCPadStatus>, "Samples are copied as raw words");
+constexpr size_t SAMPLE_WORDS = (sizeof(GCPadStatus) + 3) / 4;
+struct PadSample
+{
+  std::atomic<u32> sequence{0};
+  std::array<std::atomic<u32>, SAMPLE_WORDS> words{};
+  std::atomic<u64> timestamp_us{0};
+};
+
+static std::array<PadSample, 4> s_samples;
+static std::thread s_sampling_thread;
+static Common::Flag s_sampling;
+static std::atomic<u64> s_last_sample_age_us{0};
+
+static void StoreSample(PadSample& sample, const GCPadStatus& status, u64 timestamp_us)
+{
+  std::array<u32, SAMPLE_WORDS> words{};
+  std::memcpy(words.data(), &status, sizeof(status));
+
+  const u32 sequence = sample.sequence.load(std::memory_order_relaxed);
+  sample.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < words.size(); i++)
+    sample.words[i].store(words[i], std::memory_order_relaxed);
+  sample.timestamp_us.store(timestamp_us, std::memory_order_relaxed);
+  sample.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+static GCPadStatus LoadSample(const PadSample& sample, u64* timestamp_us)
+{
+  std::array<u32, SAMPLE_WORDS> words;
+  u32 sequence;
+  do
+  {
+    sequence = sample.sequence.load(std::memory_order_acquire);
+    for (size_t i = 0; i < words.size(); i++)
+      words[i] = sample.words[i].load(std::memory_order_relaxed);
+    *timestamp_us = sample.timestamp_us.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) || sample.sequence.load(std::memory_order_relaxed) != sequence);
+
+  std::array<u8, sizeof(GCPadStatus)> bytes;
+  std::memcpy(bytes.data(), words.data(), bytes.size());
+  GCPadStatus status;
+  std::memcpy(&status, bytes.data(), bytes.size());
+  return status;
+}
+
+static GCPadStatus ReadStatus(int pad_num)
+{
+  return static_cast<GCPad*>(s_config.GetController(pad_num))->GetInput();
+}
+
+static void SamplingThreadFunc()
+{
+  Common::SetCurrentThreadName("Pad sampling thread");
+  while (s_sampling.IsSet())
+  {
+    g_controller_interface.UpdateInput();
+    const u64 now = Common::Timer::GetTimeUs();
+    for (int i = 0; i < static_cast<int>(s_samples.size()); i++)
+      StoreSample(s_samples[i], ReadStatus(i), now);
+    Common::SleepCurrentThread(1);
+  }
+}
+
 InputConfig* GetConfig()
 {
   return &s_config;
@@ -23,6 +99,7 @@ InputConfig* GetConfig()
 
 void Shutdown()
 {
+  StopSampling();
   s_config.ClearControllers();
 }
 
@@ -52,7 +129,14 @@ bool IsInitialized()
 
 GCPadStatus GetStatus(int pad_num)
 {
-  return static_cast<GCPad*>(s_config.GetController(pad_num))->GetInput();
+  if (!IsSampling())
+    return ReadStatus(pad_num);
+
+  u64 timestamp_us;
+  const GCPadStatus status = LoadSample(s_samples[pad_num], &timestamp_us);
+  s_last_sample_age_us.store(Common::Timer::GetTimeUs() - timestamp_us,
+                             std::memory_order_relaxed);
+  return status;
 }
 
 ControllerEmu::ControlGroup* GetGroup(int pad_num, PadGroup group)
@@ -74,4 +158,36 @@ bool GetMicButton(const int pad_num)
 {
   return static_cast<GCPad*>(s_config.GetController(pad_num))->GetMicButton();
 }
+
+void StartSampling()
+{
+  if (s_sampling.IsSet() || !IsInitialized())
+    return;
+
+  // Taken here once, so that GetStatus has a sample as soon as it reads from them.
+  g_controller_interface.UpdateInput();
+  const u64 now = Common::Timer::GetTimeUs();
+  for (int i = 0; i < static_cast<int>(s_samples.size()); i++)
+    StoreSample(s_samples[i], ReadStatus(i), now);
+
+  s_sampling.Set();
+  s_sampling_thread = std::thread(SamplingThreadFunc);
+}
+
+void StopSampling()
+{
+  if (s_sampling.TestAndClear())
+    s_sampling_thread.join();
+  s_last_sample_age_us.store(0);
+}
+
+bool IsSampling()
+{
+  return s_sampling.IsSet();
+}
+
+u64 GetLastSampleAgeUs()
+{
+  return s_last_sample_age_us.load(std::memory_order_relaxed);
+}
 }
@@ -31,4 +31,12 @@ void Rumble(int pad_num, ControlState strength);
 void ResetRumble(int pad_num);
 
 bool GetMicButton(int pad_num);
+
+// A thread can sample the pads about once a millisecond, so that GetStatus returns the newest
+// sample without locking or going through the ControllerInterface.
+void StartSampling();
+void StopSampling();
+bool IsSampling();
+// How old the sample the last GetStatus returned was, in microseconds.
+u64 GetLastSampleAgeUs();
 }
@@ -4,6 +4,7 @@
 
 #include "Core/HW/GPFifo.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 
@@ -12,6 +13,7 @@
 #include "Common/Swap.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/CommandProcessor.h"
@@ -31,6 +33,8 @@ namespace GPFifo
 
 // More room for the fastmodes
 alignas(32) static u8 s_gather_pipe[GATHER_PIPE_SIZE * 16];
+static_assert(sizeof(s_gather_pipe) >= GATHER_PIPE_JIT_BURST_SIZE + 2 * GATHER_PIPE_SIZE,
+              "The gather pipe must hold the bytes JIT code writes between two checks");
 
 static size_t GetGatherPipeCount()
 {
@@ -69,33 +73,37 @@ void ResetGatherPipe()
 
 void UpdateGatherPipe()
 {
-  size_t pipe_count = GetGatherPipeCount();
-  size_t processed;
-  u8* cur_mem = Memory::GetPointer(ProcessorInterface::Fifo_CPUWritePointer);
-  for (processed = 0; pipe_count >= GATHER_PIPE_SIZE; processed += GATHER_PIPE_SIZE)
+  const size_t pipe_count = GetGatherPipeCount();
+  const size_t burst_bytes = pipe_count - pipe_count % GATHER_PIPE_SIZE;
+  if (burst_bytes == 0)
+    return;
+
+  // Copy all the complete bursts at once, in up to two parts when the FIFO wraps around.
+  size_t processed = 0;
+  while (processed < burst_bytes)
   {
-    // copy the GatherPipe
-    memcpy(cur_mem, s_gather_pipe + processed, GATHER_PIPE_SIZE);
-    pipe_count -= GATHER_PIPE_SIZE;
+    const u32 write_pointer = ProcessorInterface::Fifo_CPUWritePointer;
+    const u32 end = ProcessorInterface::Fifo_CPUEnd;
+    size_t bytes = burst_bytes - processed;
+    if (write_pointer <= end)
+      bytes = std::min<size_t>(bytes, end - write_pointer + GATHER_PIPE_SIZE);
+
+    memcpy(Memory::GetPointer(write_pointer), s_gather_pipe + processed, bytes);
+    WriteWatch::Invalidate(write_pointer, bytes);
+    processed += bytes;
 
     // increase the CPUWritePointer
-    if (ProcessorInterface::Fifo_CPUWritePointer == ProcessorInterface::Fifo_CPUEnd)
-    {
+    if (write_pointer + bytes - GATHER_PIPE_SIZE == end)
       ProcessorInterface::Fifo_CPUWritePointer = ProcessorInterface::Fifo_CPUBase;
-      cur_mem = Memory::GetPointer(ProcessorInterface::Fifo_CPUWritePointer);
-    }
     else
-    {
-      cur_mem += GATHER_PIPE_SIZE;
-      ProcessorInterface::Fifo_CPUWritePointer += GATHER_PIPE_SIZE;
-    }
-
-    CommandProcessor::GatherPipeBursted();
+      ProcessorInterface::Fifo_CPUWritePointer += static_cast<u32>(bytes);
   }
 
+  CommandProcessor::GatherPipeBursted(static_cast<u32>(burst_bytes / GATHER_PIPE_SIZE));
+
   // move back the spill bytes
-  memmove(s_gather_pipe, s_gather_pipe + processed, pipe_count);
-  SetGatherPipeCount(pipe_count);
+  memmove(s_gather_pipe, s_gather_pipe + burst_bytes, pipe_count - burst_bytes);
+  SetGatherPipeCount(pipe_count - burst_bytes);
 }
 
 void FastCheckGatherPipe()
@@ -12,7 +12,10 @@ namespace GPFifo
 {
 enum
 {
-  GATHER_PIPE_SIZE = 32
+  GATHER_PIPE_SIZE = 32,
+  // JIT code only checks the gather pipe once it wrote this many bytes to it since the last
+  // check, so that several bursts get moved to the FIFO at once.
+  GATHER_PIPE_JIT_BURST_SIZE = GATHER_PIPE_SIZE * 8
 };
 
 // Init
@@ -4,6 +4,8 @@
 
 #include "Core/HW/MMIO.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 
 #include "Common/Assert.h"
@@ -229,15 +231,79 @@ struct LargerAccessSize<u16>
   typedef u32 value;
 };
 
+// Visitors recording which handling method a handler uses. The converters use
+// them to build a constant or direct handler out of the parts when possible,
+// which the JIT can then inline instead of calling a lambda.
+template <typename T>
+class ReadMethodInfo : public ReadHandlingMethodVisitor<T>
+{
+public:
+  void VisitConstant(T constant) override
+  {
+    is_constant = true;
+    value = constant;
+  }
+  void VisitDirect(const T* direct_addr, u32 direct_mask) override
+  {
+    addr = direct_addr;
+    mask = direct_mask;
+  }
+  void VisitComplex(const std::function<T(u32)>* lambda) override {}
+
+  bool is_constant = false;
+  T value = 0;
+  const T* addr = nullptr;
+  u32 mask = 0;
+};
+
+template <typename T>
+class WriteMethodInfo : public WriteHandlingMethodVisitor<T>
+{
+public:
+  void VisitNop() override { is_nop = true; }
+  void VisitDirect(T* direct_addr, u32 direct_mask) override
+  {
+    addr = direct_addr;
+    mask = direct_mask;
+  }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override {}
+
+  bool is_nop = false;
+  T* addr = nullptr;
+  u32 mask = 0;
+};
+
+// Two direct parts can be accessed as one larger value if they are the two
+// halves of it in host memory.
+template <typename T, typename ST>
+static bool AreDirectHalves(const ST* high, const ST* low)
+{
+  return high && low && high == low + 1 && reinterpret_cast<uintptr_t>(low) % sizeof(T) == 0;
+}
+
 template <typename T>
 ReadHandlingMethod<T>* ReadToSmaller(Mapping* mmio, u32 high_part_addr, u32 low_part_addr)
 {
   typedef typename SmallerAccessSize<T>::value ST;
+  constexpr u32 shift = 8 * sizeof(ST);
+  constexpr u32 part_mask = static_cast<ST>(~0);
 
   ReadHandler<ST>* high_part = &mmio->GetHandlerForRead<ST>(high_part_addr);
   ReadHandler<ST>* low_part = &mmio->GetHandlerForRead<ST>(low_part_addr);
 
-  // TODO(delroth): optimize
+  ReadMethodInfo<ST> high_info, low_info;
+  high_part->Visit(high_info);
+  low_part->Visit(low_info);
+
+  if (high_info.is_constant && low_info.is_constant)
+    return Constant<T>(static_cast<T>(static_cast<u32>(high_info.value) << shift | low_info.value));
+
+  if (AreDirectHalves<T>(high_info.addr, low_info.addr))
+  {
+    return DirectRead<T>(reinterpret_cast<const T*>(low_info.addr),
+                         (high_info.mask & part_mask) << shift | (low_info.mask & part_mask));
+  }
+
   return ComplexRead<T>([=](u32 addr) {
     return ((T)high_part->Read(high_part_addr) << (8 * sizeof(ST))) | low_part->Read(low_part_addr);
   });
@@ -248,10 +314,25 @@ WriteHandlingMethod<T>* WriteToSmaller(Mapping* mmio, u32 high_part_addr, u32 lo
 {
   typedef typename SmallerAccessSize<T>::value ST;
 
+  constexpr u32 shift = 8 * sizeof(ST);
+  constexpr u32 part_mask = static_cast<ST>(~0);
+
   WriteHandler<ST>* high_part = &mmio->GetHandlerForWrite<ST>(high_part_addr);
   WriteHandler<ST>* low_part = &mmio->GetHandlerForWrite<ST>(low_part_addr);
 
-  // TODO(delroth): optimize
+  WriteMethodInfo<ST> high_info, low_info;
+  high_part->Visit(high_info);
+  low_part->Visit(low_info);
+
+  if (high_info.is_nop && low_info.is_nop)
+    return Nop<T>();
+
+  if (AreDirectHalves<T>(high_info.addr, low_info.addr))
+  {
+    return DirectWrite<T>(reinterpret_cast<T*>(low_info.addr),
+                          (high_info.mask & part_mask) << shift | (low_info.mask & part_mask));
+  }
+
   return ComplexWrite<T>([=](u32 addr, T val) {
     high_part->Write(high_part_addr, val >> (8 * sizeof(ST)));
     low_part->Write(low_part_addr, (ST)val);
@@ -263,9 +344,22 @@ ReadHandlingMethod<T>* ReadToLarger(Mapping* mmio, u32 larger_addr, u32 shift)
 {
   typedef typename LargerAccessSize<T>::value LT;
 
+  constexpr u32 part_mask = static_cast<T>(~0);
+
   ReadHandler<LT>* large = &mmio->GetHandlerForRead<LT>(larger_addr);
 
-  // TODO(delroth): optimize
+  ReadMethodInfo<LT> info;
+  large->Visit(info);
+
+  if (info.is_constant)
+    return Constant<T>(static_cast<T>(info.value >> shift));
+
+  if (info.addr)
+  {
+    const u8* part_addr = reinterpret_cast<const u8*>(info.addr) + shift / 8;
+    return DirectRead<T>(reinterpret_cast<const T*>(part_addr), (info.mask >> shift) & part_mask);
+  }
+
   return ComplexRead<T>(
       [large, shift](u32 addr) { return large->Read(addr & ~(sizeof(LT) - 1)) >> shift; });
 }
@@ -381,6 +475,36 @@ void WriteHandler<T>::ResetMethod(WriteHandlingMethod<T>* method)
   m_WriteFunc = v.ret;
 }
 
+static u32 AddressFromUniqueID(u32 id)
+{
+  return (id >> 16 ? 0x0D800000 : 0x0C000000) | (id & 0xFFFF);
+}
+
+std::vector<AccessCount> Mapping::GetAccessCounts() const
+{
+  std::vector<AccessCount> counts;
+  const auto add_counts = [&counts](const auto& handlers, bool write) {
+    const u32 size = static_cast<u32>(NUM_MMIOS / handlers.size());
+    for (size_t i = 0; i < handlers.size(); ++i)
+    {
+      const u64 count = handlers[i].GetAccessCount();
+      if (count)
+        counts.push_back({AddressFromUniqueID(static_cast<u32>(i) * size), size, write, count});
+    }
+  };
+
+  add_counts(m_read_handlers8, false);
+  add_counts(m_read_handlers16, false);
+  add_counts(m_read_handlers32, false);
+  add_counts(m_write_handlers8, true);
+  add_counts(m_write_handlers16, true);
+  add_counts(m_write_handlers32, true);
+
+  std::sort(counts.begin(), counts.end(),
+            [](const AccessCount& a, const AccessCount& b) { return a.count > b.count; });
+  return counts;
+}
+
 // Define all the public specializations that are exported in MMIOHandlers.h.
 #define MaybeExtern
 MMIO_PUBLIC_SPECIALIZATIONS()
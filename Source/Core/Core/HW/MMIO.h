@@ -8,6 +8,7 @@
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
@@ -92,6 +93,15 @@ inline u16* HighPart(volatile u32* ptr)
 }
 }
 
+// Number of accesses of one size and direction to an MMIO register.
+struct AccessCount
+{
+  u32 address;
+  u32 size;
+  bool write;
+  u64 count;
+};
+
 class Mapping
 {
 public:
@@ -153,6 +163,10 @@ public:
     return GetWriteHandler<Unit>(UniqueID(addr) / sizeof(Unit));
   }
 
+  // Lists the registers that were accessed at least once, most accessed
+  // first. Used by the JIT profiler to show the hot MMIO paths.
+  std::vector<AccessCount> GetAccessCounts() const;
+
 private:
   // These arrays contain the handlers for each MMIO access type: read/write
   // to 8/16/32 bits. They are indexed using the UniqueID(addr) function
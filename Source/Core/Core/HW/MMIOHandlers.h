@@ -139,9 +139,15 @@ public:
     if (!m_Method)
       InitializeInvalid();
 
+    ++m_access_count;
     return m_ReadFunc(addr);
   }
 
+  // Accesses made through Read(), plus the ones made by JIT code that was
+  // compiled while block profiling was enabled.
+  u64 GetAccessCount() const { return m_access_count; }
+  u64* GetAccessCounter() { return &m_access_count; }
+
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the read function is updated at the same time.
   void ResetMethod(ReadHandlingMethod<T>* method);
@@ -152,6 +158,7 @@ private:
   void InitializeInvalid() { ResetMethod(InvalidRead<T>()); }
   std::unique_ptr<ReadHandlingMethod<T>> m_Method;
   std::function<T(u32)> m_ReadFunc;
+  u64 m_access_count = 0;
 };
 template <typename T>
 class WriteHandler
@@ -175,9 +182,15 @@ public:
     if (!m_Method)
       InitializeInvalid();
 
+    ++m_access_count;
     m_WriteFunc(addr, val);
   }
 
+  // Accesses made through Write(), plus the ones made by JIT code that was
+  // compiled while block profiling was enabled.
+  u64 GetAccessCount() const { return m_access_count; }
+  u64* GetAccessCounter() { return &m_access_count; }
+
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the write function is updated at the same
   // time.
@@ -189,6 +202,7 @@ private:
   void InitializeInvalid() { ResetMethod(InvalidWrite<T>()); }
   std::unique_ptr<WriteHandlingMethod<T>> m_Method;
   std::function<void(u32, T)> m_WriteFunc;
+  u64 m_access_count = 0;
 };
 
 // Boilerplate boilerplate boilerplate.
@@ -11,12 +11,19 @@
 
 #include <algorithm>
 #include <cstring>
+#include <map>
 #include <memory>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/Swap.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/AudioInterface.h"
@@ -29,6 +36,7 @@
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "VideoCommon/CommandProcessor.h"
@@ -51,6 +59,8 @@ static MemArena g_arena;
 static bool m_IsInitialized = false;  // Save the Init(), Shutdown() state
 // END STATE_TO_SAVE
 
+static bool s_do_state_skips_ram = false;
+
 u8* m_pRAM;
 u8* m_pL1Cache;
 u8* m_pEXRAM;
@@ -113,6 +123,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 // Dolphin allocates memory to represent four regions:
@@ -140,7 +151,9 @@ struct LogicalMemoryView
 //
 // The 4GB starting at logical_base represents access from the CPU
 // with address translation turned on.  This mapping is computed based
-// on the BAT registers.
+// on the BAT registers. Optionally, the 4KB pages the page table translates
+// are mirrored into it as well (see PowerPC::PageTableUpdated), so translated
+// accesses outside of the BATs can also use fastmem.
 //
 // Each of these 4GB regions is followed by 4GB of empty space so overflows
 // in address computation in the JIT don't access the wrong memory.
@@ -163,6 +176,7 @@ static PhysicalMemoryRegion physical_regions[] = {
 };
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
+static std::map<u32, LogicalMemoryView> logical_page_mappings;
 
 void Init()
 {
@@ -186,6 +200,9 @@ void Init()
   {
     if ((flags & region.flags) != region.flags)
       continue;
+    // Huge pages need the offset in the segment aligned like the address of the view.
+    if (Common::AreHugePagesEnabled() && region.size >= Common::HUGE_PAGE_SIZE)
+      mem_size = Common::AlignUp(mem_size, Common::HUGE_PAGE_SIZE);
     region.shm_position = mem_size;
     mem_size += region.size;
   }
@@ -217,6 +234,7 @@ void Init()
     mmio_mapping = InitMMIO();
 
   Clear();
+  WriteWatch::Init();
 
   INFO_LOG(MEMMAP, "Memory system initialized. RAM at %p", m_pRAM);
   m_IsInitialized = true;
@@ -224,6 +242,9 @@ void Init()
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  // The page table mappings never overlap BAT mappings, which are about to change, so they
+  // have to go first. The MMU rebuilds them afterwards.
+  ClearPageTableMappings();
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -256,30 +277,145 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
             PanicAlert("MemoryMap_Setup: Failed finding a memory base.");
             exit(0);
           }
-          logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+          logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
+          // The new view isn't write protected.
+          WriteWatch::Invalidate(intersection_start, mapped_size);
         }
       }
     }
   }
 }
 
+bool IsPageTableMappingSupported()
+{
+#ifdef _WIN32
+  // Views on Windows have to be aligned to the 64KB allocation granularity.
+  return false;
+#else
+  return sysconf(_SC_PAGESIZE) == PAGE_TABLE_PAGE_SIZE;
+#endif
+}
+
+void MapPageTableEntry(u32 logical_address, u32 physical_address)
+{
+  UnmapPageTableEntry(logical_address);
+  for (const auto& physical_region : physical_regions)
+  {
+    if (!*physical_region.out_pointer || physical_address < physical_region.physical_address ||
+        physical_address - physical_region.physical_address >= physical_region.size)
+    {
+      continue;
+    }
+
+    u32 position =
+        physical_region.shm_position + physical_address - physical_region.physical_address;
+    void* mapped_pointer =
+        g_arena.CreateView(position, PAGE_TABLE_PAGE_SIZE, logical_base + logical_address);
+    // Not being able to map a page is harmless; accesses to it take the slow path instead.
+    if (mapped_pointer)
+    {
+      logical_page_mappings[logical_address] = {mapped_pointer, PAGE_TABLE_PAGE_SIZE,
+                                                physical_address};
+      WriteWatch::Invalidate(physical_address, PAGE_TABLE_PAGE_SIZE);
+    }
+    return;
+  }
+}
+
+void UnmapPageTableEntry(u32 logical_address)
+{
+  auto it = logical_page_mappings.find(logical_address);
+  if (it == logical_page_mappings.end())
+    return;
+  g_arena.ReleaseView(it->second.mapped_pointer, it->second.mapped_size);
+  logical_page_mappings.erase(it);
+}
+
+void UnmapPageTableEntries(u32 logical_address, u32 size)
+{
+  const auto begin = logical_page_mappings.lower_bound(logical_address);
+  const auto end = logical_page_mappings.upper_bound(logical_address + (size - 1));
+  for (auto it = begin; it != end; ++it)
+    g_arena.ReleaseView(it->second.mapped_pointer, it->second.mapped_size);
+  logical_page_mappings.erase(begin, end);
+}
+
+void ClearPageTableMappings()
+{
+  for (auto& entry : logical_page_mappings)
+    g_arena.ReleaseView(entry.second.mapped_pointer, entry.second.mapped_size);
+  logical_page_mappings.clear();
+}
+
+void WriteProtectLogicalViews(u32 physical_address, u32 size)
+{
+  const u32 end = physical_address + size;
+  for (const auto& entry : logical_mapped_entries)
+  {
+    const u32 start = std::max(entry.physical_address, physical_address);
+    const u32 stop = std::min(entry.physical_address + entry.mapped_size, end);
+    if (start < stop)
+    {
+      Common::WriteProtectMemory(
+          static_cast<u8*>(entry.mapped_pointer) + (start - entry.physical_address), stop - start);
+    }
+  }
+  for (const auto& entry : logical_page_mappings)
+  {
+    if (entry.second.physical_address >= physical_address && entry.second.physical_address < end)
+      Common::WriteProtectMemory(entry.second.mapped_pointer, entry.second.mapped_size);
+  }
+}
+
+bool GetLogicalViewPhysicalAddress(uintptr_t host_address, u32* physical_address)
+{
+  const uintptr_t base = reinterpret_cast<uintptr_t>(logical_base);
+  if (!logical_base || host_address < base || host_address - base >= 0x100000000)
+    return false;
+  for (const auto& entry : logical_mapped_entries)
+  {
+    const uintptr_t start = reinterpret_cast<uintptr_t>(entry.mapped_pointer);
+    if (host_address >= start && host_address - start < entry.mapped_size)
+    {
+      *physical_address = entry.physical_address + static_cast<u32>(host_address - start);
+      return true;
+    }
+  }
+  const u32 logical_address = static_cast<u32>(host_address - base);
+  auto it = logical_page_mappings.find(logical_address & ~(PAGE_TABLE_PAGE_SIZE - 1));
+  if (it == logical_page_mappings.end())
+    return false;
+  *physical_address =
+      it->second.physical_address + (logical_address & (PAGE_TABLE_PAGE_SIZE - 1));
+  return true;
+}
+
 void DoState(PointerWrap& p)
 {
   bool wii = SConfig::GetInstance().bWii;
-  p.DoArray(m_pRAM, RAM_SIZE);
+  if (p.GetMode() == PointerWrap::MODE_READ && !s_do_state_skips_ram)
+    WriteWatch::Reset();
+  if (!s_do_state_skips_ram)
+    p.DoArray(m_pRAM, RAM_SIZE);
   p.DoArray(m_pL1Cache, L1_CACHE_SIZE);
   p.DoMarker("Memory RAM");
   if (m_pFakeVMEM)
     p.DoArray(m_pFakeVMEM, FAKEVMEM_SIZE);
   p.DoMarker("Memory FakeVMEM");
-  if (wii)
+  if (wii && !s_do_state_skips_ram)
     p.DoArray(m_pEXRAM, EXRAM_SIZE);
   p.DoMarker("Memory EXRAM");
 }
 
+void SetDoStateSkipsRAM(bool skip)
+{
+  s_do_state_skips_ram = skip;
+}
+
 void Shutdown()
 {
   m_IsInitialized = false;
+  WriteWatch::Shutdown();
   u32 flags = 0;
   if (SConfig::GetInstance().bWii)
     flags |= PhysicalMemoryRegion::WII_ONLY;
@@ -292,6 +428,7 @@ void Shutdown()
     g_arena.ReleaseView(*region.out_pointer, region.size);
     *region.out_pointer = nullptr;
   }
+  ClearPageTableMappings();
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -306,6 +443,7 @@ void Shutdown()
 
 void Clear()
 {
+  WriteWatch::Reset();
   if (m_pRAM)
     memset(m_pRAM, 0, RAM_SIZE);
   if (m_pL1Cache)
@@ -355,7 +493,9 @@ void CopyToEmu(u32 address, const void* data, size_t size)
     PanicAlert("Invalid range in CopyToEmu. %zx bytes to 0x%08x", size, address);
     return;
   }
+  WriteWatch::BeginWrite(address, size);
   memcpy(pointer, data, size);
+  WriteWatch::Invalidate(address, size);
 }
 
 void Memset(u32 address, u8 value, size_t size)
@@ -369,7 +509,9 @@ void Memset(u32 address, u8 value, size_t size)
     PanicAlert("Invalid range in Memset. %zx bytes at 0x%08x", size, address);
     return;
   }
+  WriteWatch::BeginWrite(address, size);
   memset(pointer, value, size);
+  WriteWatch::Invalidate(address, size);
 }
 
 std::string GetString(u32 em_address, size_t size)
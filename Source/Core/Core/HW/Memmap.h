@@ -63,9 +63,26 @@ bool IsInitialized();
 void Init();
 void Shutdown();
 void DoState(PointerWrap& p);
+// Leaves RAM and EXRAM out of DoState, for callers that copy them on their own.
+void SetDoStateSkipsRAM(bool skip);
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+// Mirrors single page table translations into the logical address space, so that fastmem also
+// covers translated accesses outside of the BATs. The MMU is responsible for keeping these in
+// sync with the guest page table and for never passing addresses that are BAT-mapped.
+constexpr u32 PAGE_TABLE_PAGE_SIZE = 0x1000;
+bool IsPageTableMappingSupported();
+void MapPageTableEntry(u32 logical_address, u32 physical_address);
+void UnmapPageTableEntry(u32 logical_address);
+void UnmapPageTableEntries(u32 logical_address, u32 size);
+void ClearPageTableMappings();
+
+// Used by WriteWatch to write protect or find the logical views of physical memory. CPU thread
+// only, since the views change as the CPU runs.
+void WriteProtectLogicalViews(u32 physical_address, u32 size);
+bool GetLogicalViewPhysicalAddress(uintptr_t host_address, u32* physical_address);
+
 void Clear();
 
 // Routines to access physically addressed memory, designed for use by
@@ -6,13 +6,19 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <memory>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Timer.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/HW/GCPad.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/HW/SI/SI_DeviceGBA.h"
@@ -215,6 +221,12 @@ static USIStatusReg s_status_reg;
 static USIEXIClockCount s_exi_clock_count;
 static std::array<u8, 128> s_si_buffer;
 
+// In the low latency mode a due poll only marks the channel, and the controller is read once
+// the game reads the channel's input registers, at the latest possible moment.
+static std::array<bool, MAX_SI_CHANNELS> s_deferred_poll;
+// Host time of the latest controller read, for the input latency estimate.
+static std::atomic<u64> s_last_poll_time_us;
+
 void DoState(PointerWrap& p)
 {
   for (int i = 0; i < MAX_SI_CHANNELS; i++)
@@ -249,11 +261,33 @@ void DoState(PointerWrap& p)
   p.DoPOD(s_status_reg);
   p.Do(s_exi_clock_count);
   p.Do(s_si_buffer);
+  p.DoArray(s_deferred_poll);
 }
 
 static void ChangeDeviceCallback(u64 user_data, s64 cycles_late);
 static void RunSIBuffer(u64 user_data, s64 cycles_late);
 
+static int GetRDSTBit(int channel)
+{
+  // CH0 -> Bit 24 + 5
+  // CH1 -> Bit 16 + 5
+  // CH2 -> Bit 8 + 5
+  // CH3 -> Bit 0 + 5
+  return 8 * (3 - channel) + 5;
+}
+
+static void ReadDeferredPoll(int channel)
+{
+  if (!s_deferred_poll[channel])
+    return;
+
+  s_deferred_poll[channel] = false;
+  if (!Pad::IsSampling())
+    g_controller_interface.UpdateInput();
+  s_channel[channel].device->GetData(s_channel[channel].in_hi.hex, s_channel[channel].in_lo.hex);
+  s_last_poll_time_us.store(Common::Timer::GetTimeUs());
+}
+
 void Init()
 {
   for (int i = 0; i < MAX_SI_CHANNELS; i++)
@@ -261,6 +295,7 @@ void Init()
     s_channel[i].out.hex = 0;
     s_channel[i].in_hi.hex = 0;
     s_channel[i].in_lo.hex = 0;
+    s_deferred_poll[i] = false;
 
     if (Movie::IsMovieActive())
     {
@@ -324,17 +359,14 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
   for (int i = 0; i < MAX_SI_CHANNELS; ++i)
   {
     // We need to clear the RDST bit for the SI channel when reading.
-    // CH0 -> Bit 24 + 5
-    // CH1 -> Bit 16 + 5
-    // CH2 -> Bit 8 + 5
-    // CH3 -> Bit 0 + 5
-    int rdst_bit = 8 * (3 - i) + 5;
+    int rdst_bit = GetRDSTBit(i);
 
     mmio->Register(base | (SI_CHANNEL_0_OUT + 0xC * i),
                    MMIO::DirectRead<u32>(&s_channel[i].out.hex),
                    MMIO::DirectWrite<u32>(&s_channel[i].out.hex));
     mmio->Register(base | (SI_CHANNEL_0_IN_HI + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](u32) {
+                     ReadDeferredPoll(i);
                      s_status_reg.hex &= ~(1 << rdst_bit);
                      UpdateInterrupts();
                      return s_channel[i].in_hi.hex;
@@ -342,6 +374,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
                    MMIO::DirectWrite<u32>(&s_channel[i].in_hi.hex));
     mmio->Register(base | (SI_CHANNEL_0_IN_LO + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](u32) {
+                     ReadDeferredPoll(i);
                      s_status_reg.hex &= ~(1 << rdst_bit);
                      UpdateInterrupts();
                      return s_channel[i].in_lo.hex;
@@ -493,6 +526,7 @@ void AddDevice(std::unique_ptr<ISIDevice> device)
 
   // Set the new one
   s_channel.at(device_number).device = std::move(device);
+  s_deferred_poll.at(device_number) = false;
 }
 
 void AddDevice(const SIDevices device, int device_number)
@@ -568,17 +602,30 @@ void UpdateDevices()
 {
   // Update inputs at the rate of SI
   // Typically 120hz but is variable
-  g_controller_interface.UpdateInput();
+  if (!Pad::IsSampling())
+    g_controller_interface.UpdateInput();
+
+  // Reads for NetPlay and movies have to happen exactly when the poll is due.
+  static const Config::CachedValue<bool> low_latency(Config::GFX_LOW_LATENCY);
+  const bool defer = low_latency.Get() && !Core::WantsDeterminism();
 
   // Update channels and set the status bit if there's new data
-  s_status_reg.RDST0 =
-      !!s_channel[0].device->GetData(s_channel[0].in_hi.hex, s_channel[0].in_lo.hex);
-  s_status_reg.RDST1 =
-      !!s_channel[1].device->GetData(s_channel[1].in_hi.hex, s_channel[1].in_lo.hex);
-  s_status_reg.RDST2 =
-      !!s_channel[2].device->GetData(s_channel[2].in_hi.hex, s_channel[2].in_lo.hex);
-  s_status_reg.RDST3 =
-      !!s_channel[3].device->GetData(s_channel[3].in_hi.hex, s_channel[3].in_lo.hex);
+  for (int i = 0; i < MAX_SI_CHANNELS; i++)
+  {
+    // Only defer devices that always report new data, so the status bit can be set up front.
+    const SIDevices type = s_channel[i].device->GetDeviceType();
+    s_deferred_poll[i] = defer && (type == SIDEVICE_GC_CONTROLLER || type == SIDEVICE_WIIU_ADAPTER);
+
+    bool new_data = true;
+    if (!s_deferred_poll[i])
+      new_data = s_channel[i].device->GetData(s_channel[i].in_hi.hex, s_channel[i].in_lo.hex);
+
+    if (new_data)
+      s_status_reg.hex |= 1 << GetRDSTBit(i);
+    else
+      s_status_reg.hex &= ~(1 << GetRDSTBit(i));
+  }
+  s_last_poll_time_us.store(Common::Timer::GetTimeUs());
 
   UpdateInterrupts();
 }
@@ -632,4 +679,9 @@ u32 GetPollXLines()
   return s_poll.X;
 }
 
+u64 GetLastPollTimeUs()
+{
+  return s_last_poll_time_us.load();
+}
+
 }  // end of namespace SerialInterface
@@ -44,4 +44,7 @@ SIDevices GetDeviceType(int channel);
 
 u32 GetPollXLines();
 
+// Host time of the latest controller read. May be called from any thread.
+u64 GetLastPollTimeUs();
+
 }  // end of namespace SerialInterface
@@ -9,6 +9,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
+#include "Common/Swap.h"
 
 namespace StreamADPCM
 {
@@ -18,27 +19,26 @@ static s32 histl2;
 static s32 histr1;
 static s32 histr2;
 
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+// The prediction filters selected by the high nibble of a block's header byte, unknown filters
+// predict nothing.
+struct Filter
 {
-  s32 hist = 0;
-  switch (q >> 4)
-  {
-  case 0:
-    hist = 0;
-    break;
-  case 1:
-    hist = (hist1 * 0x3c);
-    break;
-  case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
-  case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
-  }
+  s32 coef1;
+  s32 coef2;
+};
+static constexpr Filter FILTERS[4] = {{0, 0}, {0x3c, 0}, {0x73, -0x34}, {0x62, -0x37}};
+
+static Filter GetFilter(u8 q)
+{
+  return (q >> 4) < 4 ? FILTERS[q >> 4] : Filter{0, 0};
+}
+
+static s16 ADPDecodeSample(s32 bits, s32 shift, const Filter& filter, s32& hist1, s32& hist2)
+{
+  s32 hist = hist1 * filter.coef1 + hist2 * filter.coef2;
   hist = MathUtil::Clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
 
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+  s32 cur = (((s16)(bits << 12) >> shift) << 6) + hist;
 
   hist2 = hist1;
   hist1 = cur;
@@ -65,14 +65,31 @@ void DoState(PointerWrap& p)
   p.Do(histr2);
 }
 
-void DecodeBlock(s16* pcm, const u8* adpcm)
+void DecodeBlocks(s16* pcm, const u8* adpcm, size_t block_count)
 {
-  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+  // The history is kept in locals and the filters are looked up once per block, so the sample
+  // loop only does the arithmetic.
+  s32 l1 = histl1, l2 = histl2, r1 = histr1, r2 = histr2;
+  for (size_t block = 0; block < block_count; ++block)
   {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-      histl1, histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-      histr1, histr2);
+    const Filter left_filter = GetFilter(adpcm[0]);
+    const Filter right_filter = GetFilter(adpcm[1]);
+    const s32 left_shift = adpcm[0] & 0xf;
+    const s32 right_shift = adpcm[1] & 0xf;
+    const u8* data = adpcm + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK);
+    for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+    {
+      pcm[i * 2] =
+          Common::swap16(ADPDecodeSample(data[i] & 0xf, left_shift, left_filter, l1, l2));
+      pcm[i * 2 + 1] =
+          Common::swap16(ADPDecodeSample(data[i] >> 4, right_shift, right_filter, r1, r2));
+    }
+    pcm += SAMPLES_PER_BLOCK * 2;
+    adpcm += ONE_BLOCK_SIZE;
   }
+  histl1 = l1;
+  histl2 = l2;
+  histr1 = r1;
+  histr2 = r2;
 }
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "Common/CommonTypes.h"
 
 class PointerWrap;
@@ -20,5 +22,7 @@ enum
 
 void InitFilter();
 void DoState(PointerWrap& p);
-void DecodeBlock(s16* pcm, const u8* adpcm);
+// Decodes block_count consecutive blocks. The samples are stored byte-swapped, as the mixer
+// expects them.
+void DecodeBlocks(s16* pcm, const u8* adpcm, size_t block_count);
 }
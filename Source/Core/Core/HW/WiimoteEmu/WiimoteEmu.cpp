@@ -237,6 +237,7 @@ void Wiimote::Reset()
   m_status.battery = (u8)(m_battery_setting->GetValue() * 100);
 
   memset(m_shake_step, 0, sizeof(m_shake_step));
+  m_ir_points.valid = false;
 
   // clear read request queue
   while (!m_read_requests.empty())
@@ -508,44 +509,21 @@ inline void LowPassFilter(double& var, double newval, double period)
   var = newval * alpha + var * (1.0 - alpha);
 }
 
-void Wiimote::GetIRData(u8* const data, bool use_accel)
+void Wiimote::ProjectIRPoints(ControlState xx, ControlState yy, ControlState zz)
 {
-  u16 x[4], y[4];
-  memset(x, 0xFF, sizeof(x));
-
-  ControlState xx = 10000, yy = 0, zz = 0;
-  double nsin, ncos;
-
-  if (use_accel)
-  {
-    double ax, az, len;
-    ax = m_accel.x;
-    az = m_accel.z;
-    len = sqrt(ax * ax + az * az);
-    if (len)
-    {
-      ax /= len;
-      az /= len;  // normalizing the vector
-      nsin = ax;
-      ncos = az;
-    }
-    else
-    {
-      nsin = 0;
-      ncos = 1;
-    }
-  }
-  else
-  {
-    // TODO m_tilt stuff
-    nsin = 0;
-    ncos = 1;
-  }
-
-  LowPassFilter(ir_sin, nsin, 1.0 / 60);
-  LowPassFilter(ir_cos, ncos, 1.0 / 60);
-
-  m_ir->GetState(&xx, &yy, &zz, true);
+  IRPoints& points = m_ir_points;
+  points.xx = xx;
+  points.yy = yy;
+  points.zz = zz;
+  points.sin = ir_sin;
+  points.cos = ir_cos;
+  points.sensor_bar_on_top = m_sensor_bar_on_top;
+  points.valid = true;
+
+  u16* const x = points.x;
+  u16* const y = points.y;
+  memset(x, 0xFF, sizeof(points.x));
+  memset(y, 0, sizeof(points.y));
 
   Vertex v[4];
 
@@ -573,10 +551,6 @@ void Wiimote::GetIRData(u8* const data, bool use_accel)
   v[2].x -= (zz * 0.5 + 1) * dist2;
   v[3].x += (zz * 0.5 + 1) * dist2;
 
-#define printmatrix(m)                                                                             \
-  PanicAlert("%f %f %f %f\n%f %f %f %f\n%f %f %f %f\n%f %f %f %f\n", m[0][0], m[0][1], m[0][2],    \
-             m[0][3], m[1][0], m[1][1], m[1][2], m[1][3], m[2][0], m[2][1], m[2][2], m[2][3],      \
-             m[3][0], m[3][1], m[3][2], m[3][3])
   Matrix rot, tot;
   static Matrix scale;
   MatrixScale(scale, 1, camWidth / camHeight, 1);
@@ -591,61 +565,113 @@ void Wiimote::GetIRData(u8* const data, bool use_accel)
     x[i] = (u16)lround((v[i].x + 1) / 2 * (camWidth - 1));
     y[i] = (u16)lround((v[i].y + 1) / 2 * (camHeight - 1));
   }
-  // Fill report with valid data when full handshake was done
-  if (m_reg_ir.data[0x30])
-    // ir mode
-    switch (m_reg_ir.mode)
+}
+
+void Wiimote::GetIRData(u8* const data, bool use_accel)
+{
+  ControlState xx = 10000, yy = 0, zz = 0;
+  double nsin, ncos;
+
+  if (use_accel)
+  {
+    double ax, az, len;
+    ax = m_accel.x;
+    az = m_accel.z;
+    len = sqrt(ax * ax + az * az);
+    if (len)
     {
-      // basic
-    case 1:
+      ax /= len;
+      az /= len;  // normalizing the vector
+      nsin = ax;
+      ncos = az;
+    }
+    else
+    {
+      nsin = 0;
+      ncos = 1;
+    }
+  }
+  else
+  {
+    // TODO m_tilt stuff
+    nsin = 0;
+    ncos = 1;
+  }
+
+  LowPassFilter(ir_sin, nsin, 1.0 / 60);
+  LowPassFilter(ir_cos, ncos, 1.0 / 60);
+
+  m_ir->GetState(&xx, &yy, &zz, true);
+
+  // Fill report with valid data when full handshake was done
+  if (!m_reg_ir.data[0x30])
+    return;
+
+  // Reports are generated several times per video frame, but the pointer and the filtered roll
+  // usually settle in between, so the points are only projected again when those change.
+  const IRPoints& points = m_ir_points;
+  if (!points.valid || points.xx != xx || points.yy != yy || points.zz != zz ||
+      points.sin != ir_sin || points.cos != ir_cos ||
+      points.sensor_bar_on_top != m_sensor_bar_on_top)
+  {
+    ProjectIRPoints(xx, yy, zz);
+  }
+  const u16* const x = points.x;
+  const u16* const y = points.y;
+
+  // ir mode
+  switch (m_reg_ir.mode)
+  {
+  // basic
+  case 1:
+  {
+    memset(data, 0xFF, 10);
+    wm_ir_basic* const irdata = reinterpret_cast<wm_ir_basic*>(data);
+    for (unsigned int i = 0; i < 2; ++i)
     {
-      memset(data, 0xFF, 10);
-      wm_ir_basic* const irdata = reinterpret_cast<wm_ir_basic*>(data);
-      for (unsigned int i = 0; i < 2; ++i)
+      if (x[i * 2] < 1024 && y[i * 2] < 768)
       {
-        if (x[i * 2] < 1024 && y[i * 2] < 768)
-        {
-          irdata[i].x1 = static_cast<u8>(x[i * 2]);
-          irdata[i].x1hi = x[i * 2] >> 8;
+        irdata[i].x1 = static_cast<u8>(x[i * 2]);
+        irdata[i].x1hi = x[i * 2] >> 8;
 
-          irdata[i].y1 = static_cast<u8>(y[i * 2]);
-          irdata[i].y1hi = y[i * 2] >> 8;
-        }
-        if (x[i * 2 + 1] < 1024 && y[i * 2 + 1] < 768)
-        {
-          irdata[i].x2 = static_cast<u8>(x[i * 2 + 1]);
-          irdata[i].x2hi = x[i * 2 + 1] >> 8;
+        irdata[i].y1 = static_cast<u8>(y[i * 2]);
+        irdata[i].y1hi = y[i * 2] >> 8;
+      }
+      if (x[i * 2 + 1] < 1024 && y[i * 2 + 1] < 768)
+      {
+        irdata[i].x2 = static_cast<u8>(x[i * 2 + 1]);
+        irdata[i].x2hi = x[i * 2 + 1] >> 8;
 
-          irdata[i].y2 = static_cast<u8>(y[i * 2 + 1]);
-          irdata[i].y2hi = y[i * 2 + 1] >> 8;
-        }
+        irdata[i].y2 = static_cast<u8>(y[i * 2 + 1]);
+        irdata[i].y2hi = y[i * 2 + 1] >> 8;
       }
     }
-    break;
-    // extended
-    case 3:
-    {
-      memset(data, 0xFF, 12);
-      wm_ir_extended* const irdata = reinterpret_cast<wm_ir_extended*>(data);
-      for (unsigned int i = 0; i < 4; ++i)
-        if (x[i] < 1024 && y[i] < 768)
-        {
-          irdata[i].x = static_cast<u8>(x[i]);
-          irdata[i].xhi = x[i] >> 8;
+  }
+  break;
+  // extended
+  case 3:
+  {
+    memset(data, 0xFF, 12);
+    wm_ir_extended* const irdata = reinterpret_cast<wm_ir_extended*>(data);
+    for (unsigned int i = 0; i < 4; ++i)
+      if (x[i] < 1024 && y[i] < 768)
+      {
+        irdata[i].x = static_cast<u8>(x[i]);
+        irdata[i].xhi = x[i] >> 8;
 
-          irdata[i].y = static_cast<u8>(y[i]);
-          irdata[i].yhi = y[i] >> 8;
+        irdata[i].y = static_cast<u8>(y[i]);
+        irdata[i].yhi = y[i] >> 8;
 
-          irdata[i].size = 10;
-        }
-    }
+        irdata[i].size = 10;
+      }
+  }
+  break;
+  // full
+  case 5:
+    PanicAlert("Full IR report");
+    // UNSUPPORTED
     break;
-    // full
-    case 5:
-      PanicAlert("Full IR report");
-      // UNSUPPORTED
-      break;
-    }
+  }
 }
 
 void Wiimote::GetExtData(u8* const data)
@@ -221,6 +221,7 @@ protected:
   void GetButtonData(u8* const data);
   void GetAccelData(u8* const data, const ReportFeatures& rptf);
   void GetIRData(u8* const data, bool use_accel);
+  void ProjectIRPoints(ControlState xx, ControlState yy, ControlState zz);
   void GetExtData(u8* const data);
 
   bool HaveExtension() const;
@@ -267,6 +268,17 @@ private:
 
   double ir_sin, ir_cos;  // for the low pass filter
 
+  // IR camera points of the last report and what they were projected from.
+  struct IRPoints
+  {
+    ControlState xx, yy, zz;
+    double sin, cos;
+    bool sensor_bar_on_top;
+    bool valid = false;
+    u16 x[4], y[4];
+  };
+  IRPoints m_ir_points;
+
   bool m_rumble_on;
   bool m_speaker_mute;
 
@@ -2,18 +2,204 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/hci.h>
 #include <bluetooth/hci_lib.h>
 #include <bluetooth/l2cap.h>
+#include <cerrno>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 #include "Core/HW/WiimoteReal/IOLinux.h"
 
 namespace WiimoteReal
 {
+// Rather than a thread per Wiimote, one thread waits on the interrupt sockets of all connected
+// Wiimotes and on queued output reports with epoll.
+class IOThreadLinux
+{
+public:
+  bool Add(WiimoteLinux* wiimote);
+  void Remove(WiimoteLinux* wiimote);
+  void Wakeup();
+
+private:
+  void ThreadFunc();
+  // Writes the queued reports of every Wiimote, and returns how long the thread may then wait
+  // for events, in milliseconds.
+  int ServiceWiimotes();
+  void Detach(WiimoteLinux* wiimote);
+
+  // Held while Wiimotes are added and removed, which also starts and stops the thread.
+  std::mutex m_lifetime_mutex;
+  // Held while the Wiimotes are serviced.
+  std::mutex m_wiimotes_mutex;
+  std::vector<WiimoteLinux*> m_wiimotes;
+  std::thread m_thread;
+  Common::Flag m_running;
+  int m_epoll_fd = -1;
+  std::atomic<int> m_wakeup_fd{-1};
+};
+
+static IOThreadLinux s_io_thread;
+
+bool IOThreadLinux::Add(WiimoteLinux* wiimote)
+{
+  std::lock_guard<std::mutex> lifetime_lock(m_lifetime_mutex);
+
+  if (m_epoll_fd == -1)
+  {
+    const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    const int wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    if (epoll_fd == -1 || wakeup_fd == -1 ||
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &event) != 0)
+    {
+      ERROR_LOG(WIIMOTE, "Unable to create the Wiimote I/O thread's epoll instance.");
+      close(epoll_fd);
+      close(wakeup_fd);
+      return false;
+    }
+    m_epoll_fd = epoll_fd;
+    m_wakeup_fd.store(wakeup_fd);
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(m_wiimotes_mutex);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = wiimote;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, wiimote->m_int_sock, &event) != 0)
+    {
+      ERROR_LOG(WIIMOTE, "Unable to watch Wiimote %i input socket.", wiimote->GetIndex() + 1);
+      return false;
+    }
+    m_wiimotes.push_back(wiimote);
+  }
+
+  if (m_running.TestAndSet())
+    m_thread = std::thread(&IOThreadLinux::ThreadFunc, this);
+  else
+    Wakeup();
+  return true;
+}
+
+void IOThreadLinux::Remove(WiimoteLinux* wiimote)
+{
+  std::lock_guard<std::mutex> lifetime_lock(m_lifetime_mutex);
+
+  bool stop;
+  {
+    std::lock_guard<std::mutex> lk(m_wiimotes_mutex);
+    Detach(wiimote);
+    stop = m_wiimotes.empty();
+  }
+
+  if (stop && m_running.TestAndClear())
+  {
+    Wakeup();
+    m_thread.join();
+  }
+}
+
+void IOThreadLinux::Wakeup()
+{
+  const int wakeup_fd = m_wakeup_fd.load();
+  if (wakeup_fd == -1)
+    return;
+
+  const u64 value = 1;
+  if (write(wakeup_fd, &value, sizeof(value)) != sizeof(value))
+    ERROR_LOG(WIIMOTE, "Unable to wake up the Wiimote I/O thread.");
+}
+
+void IOThreadLinux::Detach(WiimoteLinux* wiimote)
+{
+  const auto it = std::find(m_wiimotes.begin(), m_wiimotes.end(), wiimote);
+  if (it == m_wiimotes.end())
+    return;
+
+  // A closed socket has already left the epoll set.
+  if (wiimote->m_int_sock != -1)
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, wiimote->m_int_sock, nullptr);
+  m_wiimotes.erase(it);
+}
+
+void IOThreadLinux::ThreadFunc()
+{
+  Common::SetCurrentThreadName("Wiimote I/O Thread");
+
+  std::array<epoll_event, 8> events;
+  int timeout = 0;
+  while (m_running.IsSet())
+  {
+    const int count = epoll_wait(m_epoll_fd, events.data(), static_cast<int>(events.size()),
+                                 timeout);
+
+    std::lock_guard<std::mutex> lk(m_wiimotes_mutex);
+    for (int i = 0; i < count; ++i)
+    {
+      auto* const wiimote = static_cast<WiimoteLinux*>(events[i].data.ptr);
+      if (!wiimote)
+      {
+        u64 value;
+        if (read(m_wakeup_fd.load(), &value, sizeof(value)) != sizeof(value))
+        {
+        }
+        continue;
+      }
+
+      // The Wiimote may have been removed since epoll_wait returned.
+      if (std::find(m_wiimotes.begin(), m_wiimotes.end(), wiimote) != m_wiimotes.end())
+        wiimote->ReadReport();
+    }
+
+    timeout = ServiceWiimotes();
+  }
+}
+
+int IOThreadLinux::ServiceWiimotes()
+{
+  const auto now = std::chrono::steady_clock::now();
+  int timeout = -1;
+
+  for (size_t i = 0; i < m_wiimotes.size();)
+  {
+    WiimoteLinux* const wiimote = m_wiimotes[i];
+    if (!wiimote->IsConnected() || !wiimote->ServiceWrites(now))
+    {
+      Detach(wiimote);
+      wiimote->DisconnectInternal();
+      continue;
+    }
+
+    if (wiimote->m_preparing)
+    {
+      const auto remaining =
+          std::chrono::duration_cast<std::chrono::milliseconds>(wiimote->m_prepare_end - now);
+      const int wait = std::max(static_cast<int>(remaining.count()) + 1, 0);
+      timeout = timeout == -1 ? wait : std::min(timeout, wait);
+    }
+    ++i;
+  }
+
+  return timeout;
+}
+
 WiimoteScannerLinux::WiimoteScannerLinux() : m_device_id(-1), m_device_sock(-1)
 {
   // Get the id of the first Bluetooth device.
@@ -112,22 +298,73 @@ WiimoteLinux::WiimoteLinux(bdaddr_t bdaddr) : Wiimote(), m_bdaddr(bdaddr)
 
   m_cmd_sock = -1;
   m_int_sock = -1;
-
-  int fds[2];
-  if (pipe(fds))
-  {
-    ERROR_LOG(WIIMOTE, "pipe failed");
-    abort();
-  }
-  m_wakeup_pipe_w = fds[1];
-  m_wakeup_pipe_r = fds[0];
 }
 
 WiimoteLinux::~WiimoteLinux()
 {
   Shutdown();
-  close(m_wakeup_pipe_w);
-  close(m_wakeup_pipe_r);
+}
+
+void WiimoteLinux::StartThread()
+{
+  // Connecting blocks for a while, so it is done here rather than on the shared thread.
+  // Connect() waits for it either way.
+  const bool ok = ConnectWithRetry();
+  m_run_thread.Set();
+  if (ok && !s_io_thread.Add(this))
+    DisconnectInternal();
+  m_thread_ready_event.Set();
+}
+
+void WiimoteLinux::StopThread()
+{
+  if (!m_run_thread.TestAndClear())
+    return;
+  s_io_thread.Remove(this);
+  DisconnectInternal();
+}
+
+void WiimoteLinux::ReadReport()
+{
+  Report rpt(MAX_PAYLOAD);
+  const int result = ReadSocket(rpt.data());
+  if (result != -1)
+    ProcessRead(rpt, result);
+}
+
+bool WiimoteLinux::ServiceWrites(std::chrono::steady_clock::time_point now)
+{
+  // The rumble between the two halves is timed by the shared thread instead of sleeping.
+  if (m_need_prepare.TestAndClear())
+  {
+    m_preparing = true;
+    m_prepare_end = now + std::chrono::milliseconds(200);
+    if (!BeginPrepare())
+    {
+      ERROR_LOG(WIIMOTE, "Wiimote::PrepareOnThread failed.  Disconnecting Wiimote %d.",
+                m_index + 1);
+      return false;
+    }
+  }
+  if (m_preparing)
+  {
+    if (now < m_prepare_end)
+      return true;
+    m_preparing = false;
+    if (!FinishPrepare())
+    {
+      ERROR_LOG(WIIMOTE, "Wiimote::PrepareOnThread failed.  Disconnecting Wiimote %d.",
+                m_index + 1);
+      return false;
+    }
+  }
+
+  if (!Write())
+  {
+    ERROR_LOG(WIIMOTE, "Wiimote::Write failed.  Disconnecting Wiimote %d.", m_index + 1);
+    return false;
+  }
+  return true;
 }
 
 // Connect to a Wiimote with a known address.
@@ -210,11 +447,7 @@ bool WiimoteLinux::IsConnected() const
 
 void WiimoteLinux::IOWakeup()
 {
-  char c = 0;
-  if (write(m_wakeup_pipe_w, &c, 1) != 1)
-  {
-    ERROR_LOG(WIIMOTE, "Unable to write to wakeup pipe.");
-  }
+  s_io_thread.Wakeup();
 }
 
 // positive = read packet
@@ -222,12 +455,10 @@ void WiimoteLinux::IOWakeup()
 // zero = error
 int WiimoteLinux::IORead(u8* buf)
 {
-  // Block select for 1/2000th of a second
-
+  // Only used before the Wiimote is handed to the shared thread, so nothing needs to wake this.
   fd_set fds;
   FD_ZERO(&fds);
   FD_SET(m_int_sock, &fds);
-  FD_SET(m_wakeup_pipe_r, &fds);
 
   if (select(m_int_sock + 1, &fds, nullptr, nullptr, nullptr) == -1)
   {
@@ -235,23 +466,22 @@ int WiimoteLinux::IORead(u8* buf)
     return -1;
   }
 
-  if (FD_ISSET(m_wakeup_pipe_r, &fds))
-  {
-    char c;
-    if (read(m_wakeup_pipe_r, &c, 1) != 1)
-    {
-      ERROR_LOG(WIIMOTE, "Unable to read from wakeup pipe.");
-    }
-    return -1;
-  }
-
   if (!FD_ISSET(m_int_sock, &fds))
     return -1;
 
+  return ReadSocket(buf);
+}
+
+// Same results as IORead, without waiting.
+int WiimoteLinux::ReadSocket(u8* buf)
+{
   // Read the pending message into the buffer
-  int r = read(m_int_sock, buf, MAX_PAYLOAD);
+  int r = recv(m_int_sock, buf, MAX_PAYLOAD, MSG_DONTWAIT);
   if (r == -1)
   {
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      return -1;
+
     // Error reading data
     ERROR_LOG(WIIMOTE, "Receiving data from Wiimote %i.", m_index + 1);
 
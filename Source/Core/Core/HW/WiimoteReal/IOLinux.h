@@ -6,6 +6,7 @@
 
 #if defined(__linux__) && HAVE_BLUEZ
 #include <bluetooth/bluetooth.h>
+#include <chrono>
 
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
@@ -23,6 +24,10 @@ public:
     return bdaddr_str;
   }
 
+  // Connected Wiimotes are serviced by one shared I/O thread.
+  void StartThread() override;
+  void StopThread() override;
+
 protected:
   bool ConnectInternal() override;
   void DisconnectInternal() override;
@@ -32,11 +37,19 @@ protected:
   int IOWrite(u8 const* buf, size_t len) override;
 
 private:
+  friend class IOThreadLinux;
+
+  int ReadSocket(u8* buf);
+  // These are called from the shared I/O thread.
+  void ReadReport();
+  bool ServiceWrites(std::chrono::steady_clock::time_point now);
+
   bdaddr_t m_bdaddr;  // Bluetooth address
   int m_cmd_sock;     // Command socket
   int m_int_sock;     // Interrupt socket
-  int m_wakeup_pipe_w;
-  int m_wakeup_pipe_r;
+  // Set between the two halves of the preparation, while the Wiimote rumbles.
+  bool m_preparing = false;
+  std::chrono::steady_clock::time_point m_prepare_end;
 };
 
 class WiimoteScannerLinux final : public WiimoteScannerBackend
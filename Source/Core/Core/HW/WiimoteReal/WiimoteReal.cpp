@@ -203,7 +203,11 @@ void Wiimote::Read()
 {
   Report rpt(MAX_PAYLOAD);
   auto const result = IORead(rpt.data());
+  ProcessRead(rpt, result);
+}
 
+void Wiimote::ProcessRead(Report& rpt, int result)
+{
   if (result > 0 && m_channel > 0)
   {
     if (SConfig::GetInstance().iBBDumpPort > 0 && m_index == WIIMOTE_BALANCE_BOARD)
@@ -399,14 +403,24 @@ void Wiimote::Prepare()
 }
 
 bool Wiimote::PrepareOnThread()
+{
+  return BeginPrepare() && (Common::SleepCurrentThread(200), FinishPrepare());
+}
+
+bool Wiimote::BeginPrepare()
 {
   // core buttons, no continuous reporting
   u8 static const mode_report[] = {WR_SET_REPORT | BT_OUTPUT, RT_REPORT_MODE, 0, RT_REPORT_CORE};
 
   // Set the active LEDs and turn on rumble.
-  u8 static led_report[] = {WR_SET_REPORT | BT_OUTPUT, RT_LEDS, 0};
+  u8 led_report[] = {WR_SET_REPORT | BT_OUTPUT, RT_LEDS, 0};
   led_report[2] = u8(WiimoteLED::LED_1 << (m_index % WIIMOTE_BALANCE_BOARD) | 0x1);
 
+  return IOWrite(mode_report, sizeof(mode_report)) && IOWrite(led_report, sizeof(led_report));
+}
+
+bool Wiimote::FinishPrepare()
+{
   // Turn off rumble
   u8 static const rumble_report[] = {WR_SET_REPORT | BT_OUTPUT, RT_RUMBLE, 0};
 
@@ -414,9 +428,8 @@ bool Wiimote::PrepareOnThread()
   u8 static const req_status_report[] = {WR_SET_REPORT | BT_OUTPUT, RT_REQUEST_STATUS, 0};
   // TODO: check for sane response?
 
-  return (IOWrite(mode_report, sizeof(mode_report)) && IOWrite(led_report, sizeof(led_report)) &&
-          (Common::SleepCurrentThread(200), IOWrite(rumble_report, sizeof(rumble_report))) &&
-          IOWrite(req_status_report, sizeof(req_status_report)));
+  return IOWrite(rumble_report, sizeof(rumble_report)) &&
+         IOWrite(req_status_report, sizeof(req_status_report));
 }
 
 void Wiimote::EmuStart()
@@ -628,18 +641,21 @@ void Wiimote::StopThread()
   m_wiimote_thread.join();
 }
 
+bool Wiimote::ConnectWithRetry()
+{
+  if (ConnectInternal())
+    return true;
+
+  // try again, it might take a moment to settle
+  Common::SleepCurrentThread(100);
+  return ConnectInternal();
+}
+
 void Wiimote::ThreadFunc()
 {
   Common::SetCurrentThreadName("Wiimote Device Thread");
 
-  bool ok = ConnectInternal();
-
-  if (!ok)
-  {
-    // try again, it might take a moment to settle
-    Common::SleepCurrentThread(100);
-    ok = ConnectInternal();
-  }
+  const bool ok = ConnectWithRetry();
 
   m_thread_ready_event.Set();
   m_run_thread.Set();
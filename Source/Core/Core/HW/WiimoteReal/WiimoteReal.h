@@ -49,8 +49,9 @@ public:
 
   bool IsBalanceBoard();
 
-  void StartThread();
-  void StopThread();
+  // Backends may service their Wiimotes from a shared thread instead.
+  virtual void StartThread();
+  virtual void StopThread();
 
   // "handshake" / stop packets
   void EmuStart();
@@ -73,6 +74,9 @@ public:
 
   void Prepare();
   bool PrepareOnThread();
+  // The two halves of PrepareOnThread, which should be run about 200 ms apart.
+  bool BeginPrepare();
+  bool FinishPrepare();
 
   void DisableDataReporting();
   void EnableDataReporting(u8 mode);
@@ -92,6 +96,17 @@ protected:
   // This is not enabled on all platforms as connecting a Wiimote can be a pain on some platforms.
   bool m_really_disconnect = false;
 
+  bool ConnectWithRetry();
+  // Queues a report read with IORead, or disconnects if it failed.
+  void ProcessRead(Report& rpt, int result);
+
+  // Whether to keep running the thread.
+  Common::Flag m_run_thread;
+  // Whether to call PrepareOnThread.
+  Common::Flag m_need_prepare;
+  // Triggered when the thread has finished ConnectInternal.
+  Common::Event m_thread_ready_event;
+
 private:
   void ClearReadQueue();
   void WriteReport(Report rpt);
@@ -105,12 +120,6 @@ private:
   bool m_rumble_state;
 
   std::thread m_wiimote_thread;
-  // Whether to keep running the thread.
-  Common::Flag m_run_thread;
-  // Whether to call PrepareOnThread.
-  Common::Flag m_need_prepare;
-  // Triggered when the thread has finished ConnectInternal.
-  Common::Event m_thread_ready_event;
 
   Common::SPSCQueue<Report> m_read_reports;
   Common::SPSCQueue<Report> m_write_reports;
@@ -0,0 +1,395 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HW/WriteWatch.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "Common/MemoryUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemTools.h"
+
+namespace WriteWatch
+{
+constexpr u32 RAM_PAGES = Memory::RAM_SIZE >> WATCH_PAGE_SHIFT;
+constexpr u32 EXRAM_PAGES = Memory::EXRAM_SIZE >> WATCH_PAGE_SHIFT;
+constexpr u32 EXRAM_ADDRESS = 0x10000000;
+
+// Asking for the same textures again before the CPU thread got to it is common, and dropping
+// requests only delays watching them.
+constexpr size_t MAX_REQUESTS = 1024;
+
+// Odd while the page is watched. Each time a page starts or stops being watched the value goes
+// up, so equal sums of odd values mean that no page was written in between. Writes to pages
+// that aren't watched move it up by 2, which makes a Watch that started before them fail.
+static std::array<std::atomic<u32>, RAM_PAGES + EXRAM_PAGES> s_generations;
+// Whether the page may be write protected in the physical view, which is also what m_pRAM and
+// m_pEXRAM point to.
+static std::array<std::atomic<bool>, RAM_PAGES + EXRAM_PAGES> s_physical_protected;
+static u32 s_page_count = 0;
+static std::atomic<bool> s_enabled{false};
+
+static std::mutex s_requests_lock;
+static std::vector<std::pair<u32, u32>> s_requests;
+static std::atomic<bool> s_has_requests{false};
+
+// Finds the pages covering a range of the addresses Memory::GetPointer accepts.
+static bool GetPages(u32 address, size_t size, u32* first, u32* last)
+{
+  if (size == 0)
+    return false;
+  u32 offset;
+  u32 region_size;
+  u32 region_page;
+  address &= 0x3FFFFFFF;
+  if (address < Memory::RAM_SIZE)
+  {
+    offset = address;
+    region_size = Memory::RAM_SIZE;
+    region_page = 0;
+  }
+  else if (s_page_count > RAM_PAGES && (address >> 28) == 0x1 &&
+           (address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+  {
+    offset = address & 0x0FFFFFFF;
+    region_size = Memory::EXRAM_SIZE;
+    region_page = RAM_PAGES;
+  }
+  else
+  {
+    return false;
+  }
+  if (size > region_size - offset)
+    return false;
+  *first = region_page + (offset >> WATCH_PAGE_SHIFT);
+  *last = region_page + static_cast<u32>((offset + size - 1) >> WATCH_PAGE_SHIFT);
+  return true;
+}
+
+static u32 GetPhysicalAddress(u32 page)
+{
+  if (page < RAM_PAGES)
+    return page << WATCH_PAGE_SHIFT;
+  return EXRAM_ADDRESS + ((page - RAM_PAGES) << WATCH_PAGE_SHIFT);
+}
+
+static void StopWatching(u32 page)
+{
+  u32 generation = s_generations[page].load(std::memory_order_relaxed);
+  while (!s_generations[page].compare_exchange_weak(
+      generation, generation + ((generation & 1) ? 1 : 2), std::memory_order_acq_rel))
+  {
+  }
+}
+
+static bool IsHostPageSizeSupported()
+{
+#ifdef _WIN32
+  return true;
+#else
+  return sysconf(_SC_PAGESIZE) == WATCH_PAGE_SIZE;
+#endif
+}
+
+void Init()
+{
+  s_page_count = RAM_PAGES + (Memory::m_pEXRAM ? EXRAM_PAGES : 0);
+  for (u32 page = 0; page < s_page_count; page++)
+  {
+    s_generations[page].store(0, std::memory_order_relaxed);
+    s_physical_protected[page].store(false, std::memory_order_relaxed);
+  }
+  {
+    std::lock_guard<std::mutex> lock(s_requests_lock);
+    s_requests.clear();
+    s_has_requests.store(false);
+  }
+  s_enabled.store(SConfig::GetInstance().bFastmem && EMM::HandlesFaultsOnAllThreads() &&
+                  IsHostPageSizeSupported());
+}
+
+void Shutdown()
+{
+  s_enabled.store(false);
+  std::lock_guard<std::mutex> lock(s_requests_lock);
+  s_requests.clear();
+  s_has_requests.store(false);
+}
+
+bool IsEnabled()
+{
+  return s_enabled.load(std::memory_order_relaxed);
+}
+
+// Sums the generations of the pages, false if any of them isn't watched.
+static bool SumGenerations(u32 first, u32 last, u64* sum)
+{
+  bool watched = true;
+  *sum = 0;
+  for (u32 page = first; page <= last; page++)
+  {
+    const u32 generation = s_generations[page].load(std::memory_order_acquire);
+    watched &= (generation & 1) != 0;
+    *sum += generation;
+  }
+  return watched;
+}
+
+bool Snapshot(u32 address, u32 size, u64* snapshot)
+{
+  u32 first, last;
+  if (!IsEnabled() || !GetPages(address, size, &first, &last))
+    return false;
+  if (SumGenerations(first, last, snapshot))
+    return true;
+
+  std::lock_guard<std::mutex> lock(s_requests_lock);
+  if (s_requests.size() < MAX_REQUESTS)
+    s_requests.emplace_back(first, last);
+  s_has_requests.store(true, std::memory_order_release);
+  return false;
+}
+
+bool IsUnchanged(u32 address, u32 size, u64 snapshot)
+{
+  u32 first, last;
+  u64 sum;
+  return IsEnabled() && GetPages(address, size, &first, &last) &&
+         SumGenerations(first, last, &sum) && sum == snapshot;
+}
+
+void BeginWrite(u32 address, size_t size)
+{
+  u32 first, last;
+  if (!IsEnabled() || !GetPages(address, size, &first, &last))
+    return;
+  for (u32 page = first; page <= last; page++)
+  {
+    if (s_physical_protected[page].exchange(false))
+    {
+      Common::UnWriteProtectMemory(Memory::physical_base + GetPhysicalAddress(page),
+                                   WATCH_PAGE_SIZE);
+    }
+  }
+}
+
+void Invalidate(u32 address, size_t size)
+{
+  u32 first, last;
+  if (!IsEnabled() || !GetPages(address, size, &first, &last))
+    return;
+  for (u32 page = first; page <= last; page++)
+    StopWatching(page);
+}
+
+void Reset()
+{
+  if (!IsEnabled())
+    return;
+  for (u32 page = 0; page < s_page_count; page++)
+  {
+    StopWatching(page);
+    s_physical_protected[page].store(false);
+  }
+  Common::UnWriteProtectMemory(Memory::m_pRAM, Memory::RAM_SIZE);
+  if (Memory::m_pEXRAM)
+    Common::UnWriteProtectMemory(Memory::m_pEXRAM, Memory::EXRAM_SIZE);
+}
+
+// Write protects the pages that aren't watched yet in every view, then starts watching the ones
+// that weren't written in the meantime.
+static void Watch(u32 first, u32 last)
+{
+  static std::vector<u32> generations;
+  u32 page = first;
+  while (page <= last)
+  {
+    if (s_generations[page].load(std::memory_order_relaxed) & 1)
+    {
+      page++;
+      continue;
+    }
+
+    generations.clear();
+    u32 end = page;
+    for (; end <= last; end++)
+    {
+      const u32 generation = s_generations[end].load(std::memory_order_relaxed);
+      if (generation & 1)
+        break;
+      generations.push_back(generation);
+      s_physical_protected[end].store(true);
+    }
+
+    const u32 physical_address = GetPhysicalAddress(page);
+    const u32 size = (end - page) << WATCH_PAGE_SHIFT;
+    Common::WriteProtectMemory(Memory::physical_base + physical_address, size);
+    Memory::WriteProtectLogicalViews(physical_address, size);
+
+    // Fails for the pages written since their generation was read, which stay unwatched.
+    for (u32 i = page; i < end; i++)
+    {
+      u32 expected = generations[i - page];
+      s_generations[i].compare_exchange_strong(expected, expected + 1, std::memory_order_acq_rel);
+    }
+    page = end;
+  }
+}
+
+void Update()
+{
+  if (!s_has_requests.load(std::memory_order_acquire))
+    return;
+
+  static std::vector<std::pair<u32, u32>> requests;
+  {
+    std::lock_guard<std::mutex> lock(s_requests_lock);
+    requests.swap(s_requests);
+    s_has_requests.store(false);
+  }
+  for (const auto& request : requests)
+    Watch(request.first, request.second);
+  requests.clear();
+}
+
+size_t GetMemorySize()
+{
+  return static_cast<size_t>(s_page_count) << WATCH_PAGE_SHIFT;
+}
+
+u32 GetPageCount()
+{
+  return s_page_count;
+}
+
+static u8* GetHostPointer(u32 page)
+{
+  if (page < RAM_PAGES)
+    return Memory::m_pRAM + (page << WATCH_PAGE_SHIFT);
+  return Memory::m_pEXRAM + ((page - RAM_PAGES) << WATCH_PAGE_SHIFT);
+}
+
+// A page holds the same data as the copy while it stays watched with the generation it had when
+// it was copied.
+static bool IsCopyCurrent(u32 page, const u32* generations)
+{
+  const u32 generation = s_generations[page].load(std::memory_order_acquire);
+  return (generation & 1) && generation == generations[page];
+}
+
+// Calls update for every page that may have changed since generations was last updated, then
+// asks for all of memory to be watched.
+template <typename Func>
+static void UpdateChangedPages(u32* generations, Func update)
+{
+  for (u32 page = 0; page < s_page_count; page++)
+  {
+    if (IsCopyCurrent(page, generations))
+      continue;
+
+    // Taken first, so that a write during the update makes the page count as changed.
+    generations[page] = s_generations[page].load(std::memory_order_acquire);
+    update(page);
+  }
+
+  u64 snapshot;
+  Snapshot(0, Memory::RAM_SIZE, &snapshot);
+  if (s_page_count > RAM_PAGES)
+    Snapshot(EXRAM_ADDRESS, Memory::EXRAM_SIZE, &snapshot);
+}
+
+void SaveChangedPages(u8* copy, u32* generations)
+{
+  UpdateChangedPages(generations, [copy](u32 page) {
+    std::memcpy(copy + (static_cast<size_t>(page) << WATCH_PAGE_SHIFT), GetHostPointer(page),
+                WATCH_PAGE_SIZE);
+  });
+}
+
+const u8* GetPagePointer(u32 page)
+{
+  return GetHostPointer(page);
+}
+
+void RestoreChangedPages(const u8* copy, const u32* generations)
+{
+  u32 page = 0;
+  while (page < s_page_count)
+  {
+    if (IsCopyCurrent(page, generations))
+    {
+      page++;
+      continue;
+    }
+
+    // Runs of changed pages are copied at once, without crossing from RAM to EXRAM.
+    const u32 region_end = page < RAM_PAGES ? RAM_PAGES : s_page_count;
+    u32 end = page + 1;
+    while (end < region_end && !IsCopyCurrent(end, generations))
+      end++;
+
+    const u32 address = GetPhysicalAddress(page);
+    const size_t size = static_cast<size_t>(end - page) << WATCH_PAGE_SHIFT;
+    BeginWrite(address, size);
+    std::memcpy(GetHostPointer(page), copy + (static_cast<size_t>(page) << WATCH_PAGE_SHIFT), size);
+    Invalidate(address, size);
+    page = end;
+  }
+}
+
+const std::vector<u64>& Subscription::Poll()
+{
+  if (m_generations.size() != s_page_count)
+    m_generations.assign(s_page_count, 0);
+  m_changed.assign((s_page_count + 63) / 64, 0);
+  UpdateChangedPages(m_generations.data(),
+                     [this](u32 page) { m_changed[page / 64] |= 1ull << (page % 64); });
+  m_epoch++;
+  return m_changed;
+}
+
+void Subscription::Reset()
+{
+  m_generations.clear();
+  m_changed.clear();
+  m_epoch = 0;
+}
+
+bool HandleFault(uintptr_t address)
+{
+  if (!IsEnabled())
+    return false;
+
+  // Only the CPU thread writes through the logical views.
+  u32 physical_address;
+  const uintptr_t physical_base = reinterpret_cast<uintptr_t>(Memory::physical_base);
+  const bool physical_view = address >= physical_base && address - physical_base < 0x100000000;
+  if (physical_view)
+    physical_address = static_cast<u32>(address - physical_base);
+  else if (!Memory::GetLogicalViewPhysicalAddress(address, &physical_address))
+    return false;
+
+  u32 page, last;
+  if ((physical_address & 0xC0000000) != 0 || !GetPages(physical_address, 1, &page, &last))
+    return false;
+
+  if (physical_view)
+    s_physical_protected[page].store(false);
+  StopWatching(page);
+  Common::UnWriteProtectMemory(
+      reinterpret_cast<void*>(address & ~static_cast<uintptr_t>(WATCH_PAGE_SIZE - 1)),
+      WATCH_PAGE_SIZE);
+  return true;
+}
+}
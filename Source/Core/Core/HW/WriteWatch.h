@@ -0,0 +1,84 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Tracks writes to RAM and EXRAM in 4KB pages, so that the video backends can tell that data
+// they read before is unchanged without reading it again.
+//
+// Watched pages are write protected in every fastmem view. The first write to one of them faults,
+// which unprotects the page in the view that was written and stops watching it until it's asked
+// for again. Writes that may not fault, like the kernel filling a buffer through a system call,
+// are reported by the code doing them.
+//
+// Only available with fastmem on platforms whose exception handler sees the faults of every
+// thread, because the DSP and GPU threads write to RAM as well.
+namespace WriteWatch
+{
+constexpr u32 WATCH_PAGE_SHIFT = 12;
+constexpr u32 WATCH_PAGE_SIZE = 1 << WATCH_PAGE_SHIFT;
+
+void Init();
+void Shutdown();
+bool IsEnabled();
+
+// Returns true and a snapshot of the pages covering [address, address + size) if they are all
+// watched. Otherwise asks the CPU thread to watch them and returns false.
+bool Snapshot(u32 address, u32 size, u64* snapshot);
+// Whether none of the pages was written since Snapshot returned the snapshot.
+bool IsUnchanged(u32 address, u32 size, u64 snapshot);
+
+// Unprotects the pages covering the range in the physical view, so that a large copy doesn't
+// fault once per page and the kernel can write to them. Must be followed by Invalidate once the
+// data is written.
+void BeginWrite(u32 address, size_t size);
+// Stops watching the pages covering the range, counting it as a write.
+void Invalidate(u32 address, size_t size);
+// Stops watching every page, for when all of memory is replaced.
+void Reset();
+
+// Write protects the pages that were asked for since the last call. CPU thread only.
+void Update();
+
+// Size of a copy of memory made by SaveChangedPages: RAM, followed by EXRAM on Wii.
+size_t GetMemorySize();
+// Number of entries the generations of such a copy need, one per page.
+u32 GetPageCount();
+// Copies the pages that may have been written since the copy was last saved into it and asks for
+// all of memory to be watched. generations starts out zeroed, which copies every page.
+void SaveChangedPages(u8* copy, u32* generations);
+// Copies back the pages that may have been written since the copy was saved.
+void RestoreChangedPages(const u8* copy, const u32* generations);
+// The data of a page, by the numbering of the copy above.
+const u8* GetPagePointer(u32 page);
+
+// Tells a consumer that keeps something derived from each page, like a hash or a copy, which
+// pages it has to look at again. Each Poll starts a new epoch. CPU thread only.
+class Subscription
+{
+public:
+  // Returns a bitmap with a bit for each page that may have been written since the previous
+  // epoch, page % 64 of word page / 64, and asks for all of memory to be watched. Every page
+  // counts as written in the first epoch, and in all of them while watching is disabled.
+  const std::vector<u64>& Poll();
+  // Makes the next epoch count every page as written.
+  void Reset();
+  // Number of times Poll was called since the subscription was created or reset.
+  u64 GetEpoch() const { return m_epoch; }
+
+private:
+  std::vector<u32> m_generations;
+  std::vector<u64> m_changed;
+  u64 m_epoch = 0;
+};
+
+// Called by the exception handler before the JIT gets to see the fault.
+bool HandleFault(uintptr_t address);
+}
@@ -31,6 +31,8 @@ const std::string hotkey_labels[] = {
     _trans("Toggle Fullscreen"),
     _trans("Take Screenshot"),
     _trans("Exit"),
+    _trans("Export JIT Block Profile"),
+    _trans("Record/Export Trace"),
 
     _trans("Volume Down"),
     _trans("Volume Up"),
@@ -241,7 +243,7 @@ void Shutdown()
 }
 
 const std::array<HotkeyGroupInfo, NUM_HOTKEY_GROUPS> groups_info = {
-    {{_trans("General"), HK_OPEN, HK_EXIT},
+    {{_trans("General"), HK_OPEN, HK_EXPORT_TRACE},
      {_trans("Volume"), HK_VOLUME_DOWN, HK_VOLUME_TOGGLE_MUTE},
      {_trans("Emulation Speed"), HK_DECREASE_EMULATION_SPEED, HK_TOGGLE_THROTTLE},
      {_trans("Frame Advance"), HK_FRAME_ADVANCE, HK_FRAME_ADVANCE_RESET_SPEED},
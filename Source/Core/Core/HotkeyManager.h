@@ -29,6 +29,8 @@ enum Hotkey
   HK_FULLSCREEN,
   HK_SCREENSHOT,
   HK_EXIT,
+  HK_EXPORT_JIT_PROFILE,
+  HK_EXPORT_TRACE,
 
   HK_VOLUME_DOWN,
   HK_VOLUME_UP,
@@ -25,6 +25,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 #include "Core/IOS/ES/Formats.h"
+#include "Core/IOS/FS/FileIO.h"
 #include "Core/IOS/IOSC.h"
 #include "Core/IOS/VersionInfo.h"
 
@@ -79,6 +80,10 @@ ES::ES(Kernel& ios, const std::string& device_name) : Device(ios, device_name)
 
   FinishAllStaleImports();
 
+  // Build the title index up front rather than on the first query from the emulated software.
+  GetInstalledTitles();
+  GetTitlesWithTickets();
+
   if (s_title_to_launch != 0)
   {
     NOTICE_LOG(IOS, "Re-launching title after IOS reload.");
@@ -403,6 +408,9 @@ IPCCommandResult ES::IOCtlV(const IOCtlVRequest& request)
   if (context == m_contexts.end())
     return GetDefaultReply(ES_EINVAL);
 
+  // Titles, tickets and their data are installed and removed directly on the host.
+  CloseIdleFiles();
+
   switch (request.request)
   {
   case IOCTL_ES_ADDTICKET:
@@ -639,6 +647,7 @@ s32 ES::DIVerify(const IOS::ES::TMDReader& tmd, const IOS::ES::TicketReader& tic
 
   std::string tmd_path = Common::GetTMDFileName(tmd.GetTitleId(), Common::FROM_SESSION_ROOT);
 
+  InvalidateTitleIndex(tmd.GetTitleId());
   File::CreateFullPath(tmd_path);
   File::CreateFullPath(Common::GetTitleDataPath(tmd.GetTitleId(), Common::FROM_SESSION_ROOT));
 
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -89,6 +90,8 @@ public:
   std::vector<u64> GetTitleImports() const;
   // Get titles for which there is a ticket (in /ticket).
   std::vector<u64> GetTitlesWithTickets() const;
+  // Forget the cached titles, TMDs and tickets after /title or /ticket was changed outside of ES.
+  void InvalidateTitleIndex() const;
 
   std::vector<IOS::ES::Content> GetStoredContentsFromTMD(const IOS::ES::TMDReader& tmd) const;
   u32 GetSharedContentsCount() const;
@@ -339,6 +342,9 @@ private:
                              const IOS::ES::SharedContentMap& map = IOS::ES::SharedContentMap{
                                  Common::FROM_SESSION_ROOT}) const;
 
+  // Drop what is cached for a title after its TMD, ticket or directories were changed.
+  void InvalidateTitleIndex(u64 title_id) const;
+
   // TODO: reuse the FS code.
   struct OpenedContent
   {
@@ -355,6 +361,13 @@ private:
 
   ContextArray m_contexts;
   TitleContext m_title_context{};
+
+  // Index of /title and /ticket, so that title queries don't read the NAND every time.
+  // The lists are scanned at startup and TMDs and tickets are loaded on first use.
+  mutable std::optional<std::vector<u64>> m_installed_titles;
+  mutable std::optional<std::vector<u64>> m_titles_with_tickets;
+  mutable std::map<u64, IOS::ES::TMDReader> m_installed_tmds;
+  mutable std::map<u64, IOS::ES::TicketReader> m_tickets;
 };
 }  // namespace Device
 }  // namespace HLE
@@ -47,10 +47,17 @@ IOS::ES::TMDReader ES::FindImportTMD(u64 title_id) const
 
 IOS::ES::TMDReader ES::FindInstalledTMD(u64 title_id) const
 {
-  return FindTMD(title_id, Common::GetTMDFileName(title_id, Common::FROM_SESSION_ROOT));
+  const auto it = m_installed_tmds.find(title_id);
+  if (it != m_installed_tmds.end())
+    return it->second;
+
+  IOS::ES::TMDReader tmd =
+      FindTMD(title_id, Common::GetTMDFileName(title_id, Common::FROM_SESSION_ROOT));
+  m_installed_tmds.emplace(title_id, tmd);
+  return tmd;
 }
 
-IOS::ES::TicketReader ES::FindSignedTicket(u64 title_id) const
+static IOS::ES::TicketReader ReadTicket(u64 title_id)
 {
   const std::string path = Common::GetTicketFileName(title_id, Common::FROM_SESSION_ROOT);
   File::IOFile ticket_file(path, "rb");
@@ -64,6 +71,33 @@ IOS::ES::TicketReader ES::FindSignedTicket(u64 title_id) const
   return IOS::ES::TicketReader{std::move(signed_ticket)};
 }
 
+IOS::ES::TicketReader ES::FindSignedTicket(u64 title_id) const
+{
+  const auto it = m_tickets.find(title_id);
+  if (it != m_tickets.end())
+    return it->second;
+
+  IOS::ES::TicketReader ticket = ReadTicket(title_id);
+  m_tickets.emplace(title_id, ticket);
+  return ticket;
+}
+
+void ES::InvalidateTitleIndex() const
+{
+  m_installed_titles.reset();
+  m_titles_with_tickets.reset();
+  m_installed_tmds.clear();
+  m_tickets.clear();
+}
+
+void ES::InvalidateTitleIndex(u64 title_id) const
+{
+  m_installed_titles.reset();
+  m_titles_with_tickets.reset();
+  m_installed_tmds.erase(title_id);
+  m_tickets.erase(title_id);
+}
+
 static bool IsValidPartOfTitleID(const std::string& string)
 {
   if (string.length() != 8)
@@ -84,16 +118,15 @@ static std::vector<u64> GetTitlesInTitleOrImport(const std::string& titles_dir)
 
   // The /title and /import directories contain one directory per title type, and each of them has
   // a directory per title (where the name is the low 32 bits of the title ID in %08x format).
-  const auto entries = File::ScanDirectoryTree(titles_dir, true);
+  // Only these two levels are scanned, not the contents and save data of every title.
+  const auto entries = File::ScanDirectoryTree(titles_dir, false);
   for (const File::FSTEntry& title_type : entries.children)
   {
     if (!title_type.isDirectory || !IsValidPartOfTitleID(title_type.virtualName))
       continue;
 
-    if (title_type.children.empty())
-      continue;
-
-    for (const File::FSTEntry& title_identifier : title_type.children)
+    const auto titles = File::ScanDirectoryTree(title_type.physicalName, false);
+    for (const File::FSTEntry& title_identifier : titles.children)
     {
       if (!title_identifier.isDirectory || !IsValidPartOfTitleID(title_identifier.virtualName))
         continue;
@@ -115,7 +148,12 @@ static std::vector<u64> GetTitlesInTitleOrImport(const std::string& titles_dir)
 
 std::vector<u64> ES::GetInstalledTitles() const
 {
-  return GetTitlesInTitleOrImport(Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/title");
+  if (!m_installed_titles)
+  {
+    m_installed_titles =
+        GetTitlesInTitleOrImport(Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/title");
+  }
+  return *m_installed_titles;
 }
 
 std::vector<u64> ES::GetTitleImports() const
@@ -123,7 +161,7 @@ std::vector<u64> ES::GetTitleImports() const
   return GetTitlesInTitleOrImport(Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/import");
 }
 
-std::vector<u64> ES::GetTitlesWithTickets() const
+static std::vector<u64> ScanTitlesWithTickets()
 {
   const std::string tickets_dir = Common::RootUserPath(Common::FROM_SESSION_ROOT) + "/ticket";
   if (!File::IsDirectory(tickets_dir))
@@ -136,16 +174,14 @@ std::vector<u64> ES::GetTitlesWithTickets() const
 
   // The /ticket directory contains one directory per title type, and each of them contains
   // one ticket per title (where the name is the low 32 bits of the title ID in %08x format).
-  const auto entries = File::ScanDirectoryTree(tickets_dir, true);
+  const auto entries = File::ScanDirectoryTree(tickets_dir, false);
   for (const File::FSTEntry& title_type : entries.children)
   {
     if (!title_type.isDirectory || !IsValidPartOfTitleID(title_type.virtualName))
       continue;
 
-    if (title_type.children.empty())
-      continue;
-
-    for (const File::FSTEntry& ticket : title_type.children)
+    const auto tickets = File::ScanDirectoryTree(title_type.physicalName, false);
+    for (const File::FSTEntry& ticket : tickets.children)
     {
       const std::string name_without_ext = ticket.virtualName.substr(0, 8);
       if (ticket.isDirectory || !IsValidPartOfTitleID(name_without_ext) ||
@@ -163,6 +199,13 @@ std::vector<u64> ES::GetTitlesWithTickets() const
   return title_ids;
 }
 
+std::vector<u64> ES::GetTitlesWithTickets() const
+{
+  if (!m_titles_with_tickets)
+    m_titles_with_tickets = ScanTitlesWithTickets();
+  return *m_titles_with_tickets;
+}
+
 std::vector<IOS::ES::Content> ES::GetStoredContentsFromTMD(const IOS::ES::TMDReader& tmd) const
 {
   if (!tmd.IsValid())
@@ -201,6 +244,7 @@ std::vector<std::array<u8, 20>> ES::GetSharedContents() const
 
 bool ES::InitImport(u64 title_id)
 {
+  InvalidateTitleIndex(title_id);
   const std::string content_dir = Common::GetTitleContentPath(title_id, Common::FROM_SESSION_ROOT);
   const std::string data_dir = Common::GetTitleDataPath(title_id, Common::FROM_SESSION_ROOT);
   for (const auto& dir : {content_dir, data_dir})
@@ -234,6 +278,7 @@ bool ES::FinishImport(const IOS::ES::TMDReader& tmd)
 {
   const u64 title_id = tmd.GetTitleId();
   const std::string import_content_dir = Common::GetImportTitlePath(title_id) + "/content";
+  InvalidateTitleIndex(title_id);
 
   // Remove everything not listed in the TMD.
   std::unordered_set<std::string> expected_entries = {"title.tmd"};
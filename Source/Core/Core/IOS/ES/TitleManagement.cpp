@@ -84,6 +84,7 @@ ReturnCode ES::ImportTicket(const std::vector<u8>& ticket_bytes, const std::vect
   if (verify_ret != IPC_SUCCESS)
     return verify_ret;
 
+  InvalidateTitleIndex(ticket.GetTitleId());
   const ReturnCode write_ret = WriteTicket(ticket);
   if (write_ret != IPC_SUCCESS)
     return write_ret;
@@ -499,6 +500,7 @@ ReturnCode ES::DeleteTitle(u64 title_id)
   if (!File::IsDirectory(title_dir))
     return FS_ENOENT;
 
+  InvalidateTitleIndex(title_id);
   if (!File::DeleteDirRecursively(title_dir))
   {
     ERROR_LOG(IOS_ES, "DeleteTitle: Failed to delete title directory: %s", title_dir.c_str());
@@ -531,6 +533,7 @@ ReturnCode ES::DeleteTicket(const u8* ticket_view)
   const u64 ticket_id = Common::swap64(ticket_view + offsetof(IOS::ES::TicketView, ticket_id));
   ticket.DeleteTicket(ticket_id);
 
+  InvalidateTitleIndex(title_id);
   const std::vector<u8>& new_ticket = ticket.GetBytes();
   const std::string ticket_path = Common::GetTicketFileName(title_id, Common::FROM_SESSION_ROOT);
   {
@@ -47,6 +47,9 @@ void FS::DoState(PointerWrap& p)
 {
   DoStateShared(p);
 
+  // /tmp is read from and replaced on the host.
+  CloseIdleFiles();
+
   // handle /tmp
 
   std::string Path = File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/tmp";
@@ -255,6 +258,7 @@ IPCCommandResult FS::CreateDirectory(const IOCtlRequest& request)
 
   DirName += DIR_SEP;
   File::CreateFullPath(DirName);
+  InvalidateTitleIndex(m_ios, wii_path);
   DEBUG_ASSERT_MSG(IOS_FILEIO, File::IsDirectory(DirName), "FS: CREATE_DIR %s failed",
                    DirName.c_str());
 
@@ -389,6 +393,8 @@ IPCCommandResult FS::DeleteFile(const IOCtlRequest& request)
 
   std::string Filename = BuildFilename(wii_path);
   Offset += 64;
+  CloseIdleFiles();
+  InvalidateTitleIndex(m_ios, wii_path);
   if (File::Delete(Filename))
   {
     INFO_LOG(IOS_FILEIO, "FS: DeleteFile %s", Filename.c_str());
@@ -428,6 +434,9 @@ IPCCommandResult FS::RenameFile(const IOCtlRequest& request)
 
   std::string FilenameRename = BuildFilename(wii_path_rename);
   Offset += 64;
+  CloseIdleFiles();
+  InvalidateTitleIndex(m_ios, wii_path);
+  InvalidateTitleIndex(m_ios, wii_path_rename);
 
   // try to make the basis directory
   File::CreateFullPath(FilenameRename);
@@ -496,6 +505,7 @@ IPCCommandResult FS::CreateFile(const IOCtlRequest& request)
   }
 
   // create the file
+  InvalidateTitleIndex(m_ios, wii_path);
   File::CreateFullPath(Filename);  // just to be sure
   bool Result = File::CreateEmptyFile(Filename);
   if (!Result)
@@ -607,6 +617,7 @@ IPCCommandResult FS::GetUsage(const IOCtlVRequest& request)
   // this command sucks because it asks of the number of used
   // fsBlocks and inodes
   // It should be correct, but don't count on it...
+  FlushOpenFiles();
   std::string relativepath =
       Memory::GetString(request.in_vectors[0].address, request.in_vectors[0].size);
 
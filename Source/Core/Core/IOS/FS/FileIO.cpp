@@ -4,8 +4,10 @@
 
 #include "Core/IOS/FS/FileIO.h"
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
+#include <deque>
 #include <map>
 #include <memory>
 #include <utility>
@@ -16,15 +18,87 @@
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Common/NandPaths.h"
+#include "Common/StringUtil.h"
 #include "Core/CommonTitles.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/WriteWatch.h"
+#include "Core/IOS/ES/ES.h"
 #include "Core/IOS/IOS.h"
 
 namespace IOS
 {
 namespace HLE
 {
-static std::map<std::string, std::weak_ptr<File::IOFile>> openFiles;
+// A host file shared by all the handles to the same NAND file. The host position and the size
+// are tracked here so that the host file is only seeked when needed, which also lets consecutive
+// small writes stay in the stdio buffer until the file is read, closed or flushed.
+struct HostFile
+{
+  File::IOFile file;
+  u64 size = 0;
+  u64 position = 0;
+  bool last_access_was_write = false;
+  // When the file was last written on the host, recorded when it becomes idle.
+  u64 idle_modification_time = 0;
+};
+
+static std::map<std::string, std::weak_ptr<HostFile>> openFiles;
+
+// Titles often open the same few files again right after closing them, so the last files whose
+// handles were all closed are kept open on the host.
+static std::deque<std::shared_ptr<HostFile>> s_idle_files;
+constexpr size_t MAX_IDLE_FILES = 16;
+
+static void FlushHostFile(HostFile& host_file)
+{
+  if (!host_file.last_access_was_write)
+    return;
+  host_file.file.Flush();
+  host_file.last_access_was_write = false;
+}
+
+static void AddIdleFile(std::shared_ptr<HostFile> host_file)
+{
+  FlushHostFile(*host_file);
+  host_file->idle_modification_time =
+      File::FileInfo(fileno(host_file->file.GetHandle())).GetModificationTime();
+
+  s_idle_files.push_back(std::move(host_file));
+  if (s_idle_files.size() > MAX_IDLE_FILES)
+    s_idle_files.pop_front();
+}
+
+// Returns whether the host file is still the one that was kept open.
+static bool TakeIdleFile(const std::shared_ptr<HostFile>& host_file, const File::FileInfo& info)
+{
+  const auto it = std::find(s_idle_files.begin(), s_idle_files.end(), host_file);
+  if (it == s_idle_files.end())
+    return true;
+  s_idle_files.erase(it);
+  return info.GetSize() == host_file->size &&
+         info.GetModificationTime() == host_file->idle_modification_time;
+}
+
+void FlushOpenFiles()
+{
+  for (const auto& entry : openFiles)
+  {
+    if (const std::shared_ptr<HostFile> host_file = entry.second.lock())
+      FlushHostFile(*host_file);
+  }
+}
+
+void CloseIdleFiles()
+{
+  FlushOpenFiles();
+  s_idle_files.clear();
+}
+
+void InvalidateTitleIndex(Kernel& ios, const std::string& wii_path)
+{
+  if (StringBeginsWith(wii_path, "/title/") || StringBeginsWith(wii_path, "/ticket/"))
+    ios.GetES()->InvalidateTitleIndex();
+}
 
 // This is used by several of the FileIO and /dev/fs functions
 std::string BuildFilename(const std::string& wii_path)
@@ -82,10 +156,16 @@ FileIO::FileIO(Kernel& ios, const std::string& device_name)
 IPCCommandResult FileIO::Close(u32 fd)
 {
   INFO_LOG(IOS_FILEIO, "FileIO: Close %s", m_name.c_str());
+  if (m_Mode & IOS_OPEN_WRITE)
+    InvalidateTitleIndex(m_ios, m_name);
   m_Mode = 0;
 
-  // Let go of our pointer to the file, it will automatically close if we are the last handle
-  // accessing it.
+  // Let go of our pointer to the file. If we are the last handle accessing it, it is kept open
+  // on the host for a while in case it is opened again.
+  if (m_file && m_file.use_count() == 1 && m_file->file.IsOpen())
+    AddIdleFile(std::move(m_file));
+  else if (m_file)
+    FlushHostFile(*m_file);
   m_file.reset();
 
   m_is_active = false;
@@ -102,7 +182,8 @@ IPCCommandResult FileIO::Open(const OpenRequest& request)
 
   // The file must exist before we can open it
   // It should be created by ISFS_CreateFile, not here
-  if (!File::IsFile(m_filepath))
+  const File::FileInfo info(m_filepath);
+  if (!info.IsFile())
   {
     WARN_LOG(IOS_FILEIO, "FileIO: Open (%s) failed - File doesn't exist %s", Modes[m_Mode],
              m_filepath.c_str());
@@ -110,6 +191,14 @@ IPCCommandResult FileIO::Open(const OpenRequest& request)
   }
 
   INFO_LOG(IOS_FILEIO, "FileIO: Open %s (%s == %08X)", m_name.c_str(), Modes[m_Mode], m_Mode);
+  const auto search = openFiles.find(m_name);
+  if (search != openFiles.end())
+  {
+    const std::shared_ptr<HostFile> idle_file = search->second.lock();
+    // Changed on the host since it was kept open, so it is opened again.
+    if (!TakeIdleFile(idle_file, info))
+      openFiles.erase(search);
+  }
   OpenFile();
 
   m_is_active = true;
@@ -145,27 +234,50 @@ void FileIO::OpenFile()
   {
     std::string path = m_name;
     // This code will be called when all references to the shared pointer below have been removed.
-    auto deleter = [path](File::IOFile* ptr) {
+    auto deleter = [path](HostFile* ptr) {
+      // Another file may have been opened at this path since.
+      const auto it = openFiles.find(path);
+      if (it != openFiles.end() && it->second.expired())
+        openFiles.erase(it);  // erase the weak pointer from the list of open files.
       delete ptr;             // IOFile's deconstructor closes the file.
-      openFiles.erase(path);  // erase the weak pointer from the list of open files.
     };
 
     // All files are opened read/write. Actual access rights will be controlled per handle by the
     // read/write functions below
-    m_file = std::shared_ptr<File::IOFile>(new File::IOFile(m_filepath, "r+b"),
-                                           deleter);  // Use the custom deleter from above.
+    // Use the custom deleter from above.
+    m_file = std::shared_ptr<HostFile>(new HostFile, deleter);
+    m_file->file.Open(m_filepath, "r+b");
+    m_file->size = m_file->file.GetSize();
 
     // Store a weak pointer to our newly opened file in the cache.
-    openFiles[path] = std::weak_ptr<File::IOFile>(m_file);
+    openFiles[path] = std::weak_ptr<HostFile>(m_file);
+  }
+}
+
+// File might be opened twice, so the host file is moved to this handle's position before each
+// access, unless it is there already. Switching between reading and writing also needs a seek.
+bool FileIO::SeekHostFile(bool write)
+{
+  HostFile& host_file = *m_file;
+  if (host_file.position == m_SeekPos && host_file.last_access_was_write == write)
+    return true;
+
+  host_file.last_access_was_write = write;
+  if (!host_file.file.Seek(m_SeekPos, SEEK_SET))
+  {
+    host_file.position = UINT64_MAX;
+    return false;
   }
+  host_file.position = m_SeekPos;
+  return true;
 }
 
 IPCCommandResult FileIO::Seek(const SeekRequest& request)
 {
-  if (!m_file->IsOpen())
+  if (!m_file->file.IsOpen())
     return GetDefaultReply(FS_ENOENT);
 
-  const u32 file_size = static_cast<u32>(m_file->GetSize());
+  const u32 file_size = static_cast<u32>(m_file->size);
   DEBUG_LOG(IOS_FILEIO, "FileIO: Seek Pos: 0x%08x, Mode: %i (%s, Length=0x%08x)", request.offset,
             request.mode, m_name.c_str(), file_size);
 
@@ -197,7 +309,7 @@ IPCCommandResult FileIO::Seek(const SeekRequest& request)
 
 IPCCommandResult FileIO::Read(const ReadWriteRequest& request)
 {
-  if (!m_file->IsOpen())
+  if (!m_file->file.IsOpen())
   {
     ERROR_LOG(IOS_FILEIO, "Failed to read from %s (Addr=0x%08x Size=0x%x) - file could "
                           "not be opened or does not exist",
@@ -213,18 +325,27 @@ IPCCommandResult FileIO::Read(const ReadWriteRequest& request)
   }
 
   u32 requested_read_length = request.size;
-  const u32 file_size = static_cast<u32>(m_file->GetSize());
+  const u32 file_size = static_cast<u32>(m_file->size);
   // IOS has this check in the read request handler.
   if (requested_read_length + m_SeekPos > file_size)
     requested_read_length = file_size - m_SeekPos;
 
   DEBUG_LOG(IOS_FILEIO, "Read 0x%x bytes to 0x%08x from %s", request.size, request.buffer,
             m_name.c_str());
-  m_file->Seek(m_SeekPos, SEEK_SET);  // File might be opened twice, need to seek before we read
-  const u32 number_of_bytes_read = static_cast<u32>(
-      fread(Memory::GetPointer(request.buffer), 1, requested_read_length, m_file->GetHandle()));
+  SeekHostFile(false);
+  WriteWatch::BeginWrite(request.buffer, requested_read_length);
+  FILE* const handle = m_file->file.GetHandle();
+  const u32 number_of_bytes_read =
+      static_cast<u32>(fread(Memory::GetPointer(request.buffer), 1, requested_read_length, handle));
+  WriteWatch::Invalidate(request.buffer, requested_read_length);
+
+  // A short read leaves the end-of-file or error indicator set, which the next seek clears.
+  if (number_of_bytes_read == requested_read_length)
+    m_file->position = m_SeekPos + number_of_bytes_read;
+  else
+    m_file->position = UINT64_MAX;
 
-  if (number_of_bytes_read != requested_read_length && ferror(m_file->GetHandle()))
+  if (number_of_bytes_read != requested_read_length && ferror(handle))
     return GetDefaultReply(FS_EACCESS);
 
   // IOS returns the number of bytes read and adds that value to the seek position,
@@ -236,7 +357,7 @@ IPCCommandResult FileIO::Read(const ReadWriteRequest& request)
 IPCCommandResult FileIO::Write(const ReadWriteRequest& request)
 {
   s32 return_value = FS_EACCESS;
-  if (m_file->IsOpen())
+  if (m_file->file.IsOpen())
   {
     if (m_Mode == IOS_OPEN_READ)
     {
@@ -248,12 +369,17 @@ IPCCommandResult FileIO::Write(const ReadWriteRequest& request)
     {
       DEBUG_LOG(IOS_FILEIO, "FileIO: Write 0x%04x bytes from 0x%08x to %s", request.size,
                 request.buffer, m_name.c_str());
-      m_file->Seek(m_SeekPos,
-                   SEEK_SET);  // File might be opened twice, need to seek before we write
-      if (m_file->WriteBytes(Memory::GetPointer(request.buffer), request.size))
+      SeekHostFile(true);
+      if (m_file->file.WriteBytes(Memory::GetPointer(request.buffer), request.size))
       {
         return_value = request.size;
         m_SeekPos += request.size;
+        m_file->position = m_SeekPos;
+        m_file->size = std::max<u64>(m_file->size, m_SeekPos);
+      }
+      else
+      {
+        m_file->position = UINT64_MAX;
       }
     }
   }
@@ -308,12 +434,12 @@ void FileIO::DoState(PointerWrap& p)
 
 IPCCommandResult FileIO::GetFileStats(const IOCtlRequest& request)
 {
-  if (!m_file->IsOpen())
+  if (!m_file->file.IsOpen())
     return GetDefaultReply(FS_ENOENT);
 
-  DEBUG_LOG(IOS_FILEIO, "File: %s, Length: %" PRIu64 ", Pos: %u", m_name.c_str(), m_file->GetSize(),
+  DEBUG_LOG(IOS_FILEIO, "File: %s, Length: %" PRIu64 ", Pos: %u", m_name.c_str(), m_file->size,
             m_SeekPos);
-  Memory::Write_U32(static_cast<u32>(m_file->GetSize()), request.buffer_out);
+  Memory::Write_U32(static_cast<u32>(m_file->size), request.buffer_out);
   Memory::Write_U32(m_SeekPos, request.buffer_out + 4);
   return GetDefaultReply(IPC_SUCCESS);
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "Common/ChunkFile.h"
@@ -13,11 +14,6 @@
 
 class PointerWrap;
 
-namespace File
-{
-class IOFile;
-}
-
 namespace IOS
 {
 namespace HLE
@@ -25,6 +21,17 @@ namespace HLE
 std::string BuildFilename(const std::string& wii_path);
 void CreateVirtualFATFilesystem();
 
+// Writes back the data buffered for every open NAND file.
+void FlushOpenFiles();
+// Also closes the host files that were kept open after the emulated software closed them.
+// Must be called before the NAND is modified on the host by anything other than FileIO.
+void CloseIdleFiles();
+// ES keeps an index of /title and /ticket, which is dropped when the emulated software changes
+// anything in there through the FS.
+void InvalidateTitleIndex(Kernel& ios, const std::string& wii_path);
+
+struct HostFile;
+
 namespace Device
 {
 class FileIO : public Device
@@ -71,12 +78,13 @@ private:
   };
 
   IPCCommandResult GetFileStats(const IOCtlRequest& request);
+  bool SeekHostFile(bool write);
 
   u32 m_Mode = 0;
   u32 m_SeekPos = 0;
 
   std::string m_filepath;
-  std::shared_ptr<File::IOFile> m_file;
+  std::shared_ptr<HostFile> m_file;
 };
 }  // namespace Device
 }  // namespace HLE
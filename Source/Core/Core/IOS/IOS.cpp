@@ -195,6 +195,7 @@ Kernel::~Kernel()
       continue;
     device->Close(0);
   }
+  CloseIdleFiles();
 
   {
     std::lock_guard<std::mutex> lock(m_device_map_mutex);
@@ -12,6 +12,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/IOS/FS/FileIO.h"
 
 namespace IOS
 {
@@ -27,6 +28,7 @@ NWC24Config::NWC24Config()
 
 void NWC24Config::ReadConfig()
 {
+  FlushOpenFiles();
   if (!File::IOFile(m_path, "rb").ReadBytes(&m_data, sizeof(m_data)))
   {
     ResetConfig();
@@ -41,6 +43,7 @@ void NWC24Config::ReadConfig()
 
 void NWC24Config::WriteConfig() const
 {
+  CloseIdleFiles();
   if (!File::Exists(m_path))
   {
     if (!File::CreateFullPath(File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/" WII_WC24CONF_DIR))
@@ -54,6 +57,7 @@ void NWC24Config::WriteConfig() const
 
 void NWC24Config::ResetConfig()
 {
+  CloseIdleFiles();
   if (File::Exists(m_path))
     File::Delete(m_path);
 
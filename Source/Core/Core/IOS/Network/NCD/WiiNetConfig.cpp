@@ -12,6 +12,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Core/HW/Memmap.h"
+#include "Core/IOS/FS/FileIO.h"
 
 namespace IOS
 {
@@ -27,12 +28,14 @@ WiiNetConfig::WiiNetConfig()
 
 void WiiNetConfig::ReadConfig()
 {
+  FlushOpenFiles();
   if (!File::IOFile(m_path, "rb").ReadBytes(&m_data, sizeof(m_data)))
     ResetConfig();
 }
 
 void WiiNetConfig::WriteConfig() const
 {
+  CloseIdleFiles();
   if (!File::Exists(m_path))
   {
     if (!File::CreateFullPath(File::GetUserPath(D_SESSION_WIIROOT_IDX) + "/" WII_SYSCONF_DIR
@@ -47,6 +50,7 @@ void WiiNetConfig::WriteConfig() const
 
 void WiiNetConfig::ResetConfig()
 {
+  CloseIdleFiles();
   if (File::Exists(m_path))
     File::Delete(m_path);
 
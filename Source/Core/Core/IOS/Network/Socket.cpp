@@ -6,19 +6,21 @@
 #include "Core/IOS/Network/Socket.h"
 
 #include <algorithm>
+#include <array>
 #include <mbedtls/error.h>
 #ifndef _WIN32
 #include <arpa/inet.h>
 #include <unistd.h>
 #endif
-#ifdef __HAIKU__
-#include <sys/select.h>
+#ifdef __linux__
+#include <sys/epoll.h>
 #endif
 
 #include "Common/File.h"
 #include "Common/FileUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/IOS.h"
 
@@ -203,11 +205,18 @@ s32 WiiSocket::FCntl(u32 cmd, u32 arg)
   return ret;
 }
 
-void WiiSocket::Update(bool read, bool write, bool except)
+void WiiSocket::Update(u32 ready_events)
 {
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
+    // Leave the operations that the host socket isn't ready for yet alone.
+    if (it->wait_events != 0 && (it->wait_events & ready_events) == 0)
+    {
+      ++it;
+      continue;
+    }
+
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
     IPCCommandType ct = it->request.command;
@@ -554,9 +563,11 @@ void WiiSocket::Update(bool read, bool write, bool except)
           }
 #endif
           socklen_t addrlen = sizeof(sockaddr_in);
+          WriteWatch::BeginWrite(BufferOut, data_len);
           int ret = recvfrom(fd, data, data_len, flags,
                              BufferOutSize2 ? (struct sockaddr*)&local_name : nullptr,
                              BufferOutSize2 ? &addrlen : nullptr);
+          WriteWatch::Invalidate(BufferOut, data_len);
           ReturnValue =
               WiiSockMan::GetNetErrorCode(ret, BufferOutSize2 ? "SO_RECVFROM" : "SO_RECV", true);
 
@@ -596,11 +607,35 @@ void WiiSocket::Update(bool read, bool write, bool except)
     }
     else
     {
+      it->wait_events = GetWaitEvents(*it, ReturnValue);
       ++it;
     }
   }
 }
 
+u32 WiiSocket::GetWaitEvents() const
+{
+  u32 events = 0;
+  for (const sockop& op : pending_sockops)
+    events |= op.wait_events;
+  return events;
+}
+
+u32 WiiSocket::GetWaitEvents(const sockop& op, s32 return_value)
+{
+  if (op.is_ssl)
+    return return_value == SSL_ERR_WAGAIN ? WAIT_WRITE : WAIT_READ;
+
+  switch (op.net_type)
+  {
+  case IOCTL_SO_CONNECT:
+  case IOCTLV_SO_SENDTO:
+    return WAIT_WRITE;
+  default:
+    return WAIT_READ;
+  }
+}
+
 void WiiSocket::DoSock(Request request, NET_IOCTL type)
 {
   sockop so = {request, false};
@@ -673,59 +708,134 @@ s32 WiiSockMan::DeleteSocket(s32 s)
   auto socket_entry = WiiSockets.find(s);
   if (socket_entry != WiiSockets.end())
   {
+    WatchSocket(socket_entry->second, 0);
     ReturnValue = socket_entry->second.CloseFd();
     WiiSockets.erase(socket_entry);
   }
   return ReturnValue;
 }
 
+WiiSockMan::~WiiSockMan()
+{
+#ifdef __linux__
+  if (m_epoll_fd >= 0)
+    close(m_epoll_fd);
+#endif
+}
+
+void WiiSockMan::Clean()
+{
+  for (auto& entry : WiiSockets)
+    WatchSocket(entry.second, 0);
+  WiiSockets.clear();
+  m_sockets_with_new_ops.clear();
+}
+
 void WiiSockMan::Update()
 {
-  s32 nfds = 0;
-  fd_set read_fds, write_fds, except_fds;
-  struct timeval t = {0, 0};
-  FD_ZERO(&read_fds);
-  FD_ZERO(&write_fds);
-  FD_ZERO(&except_fds);
+  if (m_sockets_with_new_ops.empty() && m_watched_sockets == 0)
+    return;
+
+  // Operations that were just queued are tried right away.
+  std::vector<s32> sockets_with_new_ops;
+  sockets_with_new_ops.swap(m_sockets_with_new_ops);
+  for (const s32 wii_fd : sockets_with_new_ops)
+    UpdateSocket(wii_fd, 0);
+
+  if (m_watched_sockets == 0)
+    return;
+
+  constexpr u32 ALL_EVENTS = WiiSocket::WAIT_READ | WiiSocket::WAIT_WRITE;
+#ifdef __linux__
+  std::array<epoll_event, WII_SOCKET_FD_MAX> events;
+  const int count = epoll_wait(m_epoll_fd, events.data(), static_cast<int>(events.size()), 0);
+  for (int i = 0; i < count; ++i)
+  {
+    u32 ready_events = 0;
+    if (events[i].events & EPOLLIN)
+      ready_events |= WiiSocket::WAIT_READ;
+    if (events[i].events & EPOLLOUT)
+      ready_events |= WiiSocket::WAIT_WRITE;
+    if (events[i].events & (EPOLLERR | EPOLLHUP))
+      ready_events = ALL_EVENTS;
+    UpdateSocket(static_cast<s32>(events[i].data.u32), ready_events);
+  }
+#else
+  std::vector<pollfd_t> pollfds;
+  std::vector<s32> wii_fds;
+  for (const auto& entry : WiiSockets)
+  {
+    const WiiSocket& sock = entry.second;
+    if (sock.watched_events == 0)
+      continue;
+
+    pollfd_t socket_pollfd = {};
+    socket_pollfd.fd = sock.fd;
+    socket_pollfd.events = ((sock.watched_events & WiiSocket::WAIT_READ) ? POLLIN : 0) |
+                           ((sock.watched_events & WiiSocket::WAIT_WRITE) ? POLLOUT : 0);
+    pollfds.push_back(socket_pollfd);
+    wii_fds.push_back(entry.first);
+  }
 
-  auto socket_iter = WiiSockets.begin();
-  auto end_socks = WiiSockets.end();
+  if (poll(pollfds.data(), static_cast<int>(pollfds.size()), 0) <= 0)
+    return;
 
-  while (socket_iter != end_socks)
+  for (size_t i = 0; i < pollfds.size(); ++i)
   {
-    WiiSocket& sock = socket_iter->second;
-    if (sock.IsValid())
-    {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
-      ++socket_iter;
-    }
-    else
-    {
-      // Good time to clean up invalid sockets.
-      socket_iter = WiiSockets.erase(socket_iter);
-    }
+    u32 ready_events = 0;
+    if (pollfds[i].revents & POLLIN)
+      ready_events |= WiiSocket::WAIT_READ;
+    if (pollfds[i].revents & POLLOUT)
+      ready_events |= WiiSocket::WAIT_WRITE;
+    if (pollfds[i].revents & (POLLERR | POLLHUP | POLLNVAL))
+      ready_events = ALL_EVENTS;
+    if (ready_events != 0)
+      UpdateSocket(wii_fds[i], ready_events);
   }
-  s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
+#endif
+}
 
-  if (ret >= 0)
+void WiiSockMan::UpdateSocket(s32 wii_fd, u32 ready_events)
+{
+  const auto socket_entry = WiiSockets.find(wii_fd);
+  if (socket_entry == WiiSockets.end() || !socket_entry->second.IsValid())
+    return;
+
+  WiiSocket& sock = socket_entry->second;
+  sock.Update(ready_events);
+  WatchSocket(sock, sock.GetWaitEvents());
+}
+
+void WiiSockMan::WatchSocket(WiiSocket& socket, u32 events)
+{
+  if (socket.watched_events == events)
+    return;
+
+#ifdef __linux__
+  if (m_epoll_fd < 0)
   {
-    for (auto& pair : WiiSockets)
-    {
-      WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
-    }
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd < 0)
+      ERROR_LOG(IOS_NET, "Failed to create the socket epoll instance: %s", strerror(errno));
   }
-  else
+
+  epoll_event event = {};
+  event.events = ((events & WiiSocket::WAIT_READ) ? EPOLLIN : 0) |
+                 ((events & WiiSocket::WAIT_WRITE) ? EPOLLOUT : 0);
+  event.data.u32 = static_cast<u32>(socket.wii_fd);
+  const int op = socket.watched_events == 0 ? EPOLL_CTL_ADD :
+                                              events == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD;
+  if (epoll_ctl(m_epoll_fd, op, socket.fd, &event) != 0)
   {
-    for (auto& elem : WiiSockets)
-    {
-      elem.second.Update(false, false, false);
-    }
+    ERROR_LOG(IOS_NET, "Failed to watch socket %08x: %s", socket.wii_fd, strerror(errno));
   }
+#endif
+
+  if (socket.watched_events == 0)
+    ++m_watched_sockets;
+  else if (events == 0)
+    --m_watched_sockets;
+  socket.watched_events = events;
 }
 
 void WiiSockMan::Convert(WiiSockAddrIn const& from, sockaddr_in& to)
@@ -47,6 +47,7 @@ typedef struct pollfd pollfd_t;
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -182,6 +183,15 @@ class WiiSocket
       NET_IOCTL net_type;
       SSL_IOCTL ssl_type;
     };
+    // What the host socket has to become ready for before the operation is tried again.
+    // Operations that were just queued are tried on the next update.
+    u32 wait_events = 0;
+  };
+
+  enum : u32
+  {
+    WAIT_READ = 1,
+    WAIT_WRITE = 2,
   };
 
 private:
@@ -189,6 +199,8 @@ private:
   s32 wii_fd;
   bool nonBlock;
   std::list<sockop> pending_sockops;
+  // What the host socket is being watched for by WiiSockMan.
+  u32 watched_events = 0;
 
   friend class WiiSockMan;
   void SetFd(s32 s);
@@ -198,7 +210,9 @@ private:
 
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
-  void Update(bool read, bool write, bool except);
+  void Update(u32 ready_events);
+  u32 GetWaitEvents() const;
+  static u32 GetWaitEvents(const sockop& op, s32 return_value);
   bool IsValid() const { return fd >= 0; }
 public:
   WiiSocket() : fd(-1), nonBlock(false) {}
@@ -227,7 +241,7 @@ public:
   s32 DeleteSocket(s32 s);
   s32 GetLastNetError() const { return errno_last; }
   void SetLastNetError(s32 error) { errno_last = error; }
-  void Clean() { WiiSockets.clear(); }
+  void Clean();
   template <typename T>
   void DoSock(s32 sock, const Request& request, T type)
   {
@@ -241,6 +255,7 @@ public:
     else
     {
       socket_entry->second.DoSock(request, type);
+      m_sockets_with_new_ops.push_back(sock);
     }
   }
 
@@ -248,13 +263,25 @@ public:
 
 private:
   WiiSockMan() = default;
+  ~WiiSockMan();
   WiiSockMan(const WiiSockMan&) = delete;
   WiiSockMan& operator=(const WiiSockMan&) = delete;
   WiiSockMan(WiiSockMan&&) = delete;
   WiiSockMan& operator=(WiiSockMan&&) = delete;
 
+  void UpdateSocket(s32 wii_fd, u32 ready_events);
+  void WatchSocket(WiiSocket& socket, u32 events);
+
   std::unordered_map<s32, WiiSocket> WiiSockets;
   s32 errno_last;
+
+  // Sockets are only updated when operations were queued for them, or when the host reports
+  // them ready for what their pending operations are waiting for.
+  std::vector<s32> m_sockets_with_new_ops;
+  u32 m_watched_sockets = 0;
+#ifdef __linux__
+  int m_epoll_fd = -1;
+#endif
 };
 }  // namespace HLE
 }  // namespace IOS
@@ -17,6 +17,7 @@
 #include "Common/SDCardUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/VersionInfo.h"
 
@@ -255,7 +256,10 @@ s32 SDIOSlot0::ExecuteCommand(const Request& request, u32 _BufferIn, u32 _Buffer
       if (!m_card.Seek(address, SEEK_SET))
         ERROR_LOG(IOS_SD, "Seek failed WTF");
 
-      if (m_card.ReadBytes(Memory::GetPointer(req.addr), size))
+      WriteWatch::BeginWrite(req.addr, size);
+      const bool read = m_card.ReadBytes(Memory::GetPointer(req.addr), size);
+      WriteWatch::Invalidate(req.addr, size);
+      if (read)
       {
         DEBUG_LOG(IOS_SD, "Outbuffer size %i got %i", _rwBufferSize, size);
       }
@@ -19,6 +19,7 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/Debugger/Debugger_SymbolMap.h"
+#include "Core/HW/GCPad.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/Wiimote.h"
@@ -364,7 +365,9 @@ void BluetoothEmu::Update()
 
   if (now - m_last_ticks > interval)
   {
-    g_controller_interface.UpdateInput();
+    // The pad sampling thread already keeps the inputs fresh.
+    if (!Pad::IsSampling())
+      g_controller_interface.UpdateInput();
     for (unsigned int i = 0; i < m_WiiMotes.size(); i++)
       Wiimote::Update(i, m_WiiMotes[i].IsConnected());
     m_last_ticks = now;
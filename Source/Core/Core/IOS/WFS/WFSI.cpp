@@ -16,6 +16,7 @@
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/IOS/ES/ES.h"
 #include "Core/IOS/ES/Formats.h"
 #include "Core/IOS/WFS/WFSSRV.h"
@@ -469,7 +470,9 @@ IPCCommandResult WFSI::IOCtl(const IOCtlRequest& request)
     }
     else
     {
+      WriteWatch::BeginWrite(dol_addr, max_dol_size);
       fp.ReadBytes(Memory::GetPointer(dol_addr), max_dol_size);
+      WriteWatch::Invalidate(dol_addr, max_dol_size);
     }
     Memory::Write_U32(real_dol_size, request.buffer_out);
     break;
@@ -517,7 +520,9 @@ u32 WFSI::GetTmd(u16 group_id, u32 title_id, u64 subtitle_id, u32 address, u32*
   }
   if (address)
   {
+    WriteWatch::BeginWrite(address, fp.GetSize());
     fp.ReadBytes(Memory::GetPointer(address), fp.GetSize());
+    WriteWatch::Invalidate(address, fp.GetSize());
   }
   *size = fp.GetSize();
   return IPC_SUCCESS;
@@ -15,6 +15,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/NandPaths.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/WriteWatch.h"
 
 namespace IOS
 {
@@ -298,7 +299,9 @@ IPCCommandResult WFSSRV::IOCtl(const IOCtlRequest& request)
       fd_obj->file.Seek(position, SEEK_SET);
     }
     size_t read_bytes;
+    WriteWatch::BeginWrite(addr, size);
     fd_obj->file.ReadArray(Memory::GetPointer(addr), size, &read_bytes);
+    WriteWatch::Invalidate(addr, size);
     // TODO(wfs): Handle read errors.
     if (absolute)
     {
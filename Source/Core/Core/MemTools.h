@@ -8,4 +8,6 @@ namespace EMM
 {
 void InstallExceptionHandler();
 void UninstallExceptionHandler();
+// Whether faults on threads other than the one that installed the handler reach it too.
+bool HandlesFaultsOnAllThreads();
 }
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -12,11 +13,14 @@
 #include "Core/CoreTiming.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/MemoryWatcher.h"
 
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
 static CoreTiming::EventType* s_event;
 static const int MW_RATE = 600;  // Steps per second
+// Changes are sent in datagrams of at most this size.
+static constexpr size_t MAX_DATAGRAM_SIZE = 0x10000;
 
 static void MWCallback(u64 userdata, s64 cyclesLate)
 {
@@ -67,19 +71,19 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
   while (std::getline(locations, line))
     ParseLine(line);
 
-  return m_values.size() > 0;
+  return m_watches.size() > 0;
 }
 
 void MemoryWatcher::ParseLine(const std::string& line)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Watch& watch = m_watches[line];
+  watch = Watch();
 
   std::stringstream offsets(line);
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -92,19 +96,63 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const std::string& line)
+bool MemoryWatcher::IsUnchanged(const Watch& watch) const
 {
+  if (!watch.reads_watched)
+    return false;
+
+  return std::all_of(watch.reads.begin(), watch.reads.end(), [](const Read& read) {
+    return WriteWatch::IsUnchanged(read.address, sizeof(u32), read.snapshot);
+  });
+}
+
+u32 MemoryWatcher::ReadWatched(u32 address, Watch* watch)
+{
+  // The snapshot is taken first, so that a write racing with the read is seen next step.
+  Read read{address, 0};
+  watch->reads_watched &= WriteWatch::Snapshot(address, sizeof(u32), &read.snapshot);
+  watch->reads.push_back(read);
+
+  const auto cached = m_step_reads.find(address);
+  if (cached != m_step_reads.end())
+    return cached->second;
+
+  const u32 value = Memory::Read_U32(address);
+  m_step_reads.emplace(address, value);
+  return value;
+}
+
+u32 MemoryWatcher::ChasePointer(Watch* watch)
+{
+  watch->reads.clear();
+  watch->reads_watched = WriteWatch::IsEnabled();
+
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
-    value = Memory::Read_U32(value + offset);
+  for (u32 offset : watch->offsets)
+    value = ReadWatched(value + offset, watch);
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessage(const std::string& line, u32 value)
+void MemoryWatcher::AppendMessage(const std::string& line, u32 value)
 {
   std::stringstream message_stream;
   message_stream << line << '\n' << std::hex << value;
-  return message_stream.str();
+  const std::string message = message_stream.str();
+
+  if (m_messages.size() + message.size() + 1 > MAX_DATAGRAM_SIZE)
+    SendMessages();
+  m_messages += message;
+  m_messages += '\0';
+}
+
+void MemoryWatcher::SendMessages()
+{
+  if (m_messages.empty())
+    return;
+
+  sendto(m_fd, m_messages.data(), m_messages.size(), 0, reinterpret_cast<sockaddr*>(&m_addr),
+         sizeof(m_addr));
+  m_messages.clear();
 }
 
 void MemoryWatcher::Step()
@@ -112,19 +160,20 @@ void MemoryWatcher::Step()
   if (!m_running)
     return;
 
-  for (auto& entry : m_values)
+  m_step_reads.clear();
+  for (auto& entry : m_watches)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
+    Watch& watch = entry.second;
+    if (IsUnchanged(watch))
+      continue;
 
-    u32 new_value = ChasePointer(address);
-    if (new_value != current_value)
+    const u32 new_value = ChasePointer(&watch);
+    if (new_value != watch.value)
     {
-      // Update the value
-      current_value = new_value;
-      std::string message = ComposeMessage(address, new_value);
-      sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
-        sizeof(m_addr));
+      watch.value = new_value;
+      AppendMessage(entry.first, new_value);
     }
   }
+
+  SendMessages();
 }
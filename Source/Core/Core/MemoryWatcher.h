@@ -5,18 +5,26 @@
 #pragma once
 
 #include <map>
+#include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <unordered_map>
 #include <vector>
 
+#include "Common/CommonTypes.h"
+
 // MemoryWatcher reads a file containing in-game memory addresses and outputs
 // changes to those memory addresses to a unix domain socket as the game runs.
 //
 // The input file is a newline-separated list of hex memory addresses, without
 // the "0x". To follow pointers, separate addresses with a space. For example,
 // "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
-// The output to the socket is two lines. The first is the address from the
-// input file, and the second is the new value in hex.
+// Each change is two lines followed by a null character. The first is the address from the
+// input file, and the second is the new value in hex. All the changes of a step are sent
+// together in one datagram.
+//
+// When WriteWatch is available, a watch is only read again once one of the pages it was read
+// from has been written.
 class MemoryWatcher final
 {
 public:
@@ -28,20 +36,41 @@ public:
   static void Shutdown();
 
 private:
+  struct Read
+  {
+    u32 address;
+    u64 snapshot;
+  };
+
+  struct Watch
+  {
+    // List of offsets to follow
+    std::vector<u32> offsets;
+    u32 value = 0;
+    // The addresses the value was read from, and the WriteWatch snapshots of their pages.
+    std::vector<Read> reads;
+    bool reads_watched = false;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
 
   void ParseLine(const std::string& line);
-  u32 ChasePointer(const std::string& line);
-  std::string ComposeMessage(const std::string& line, u32 value);
+  bool IsUnchanged(const Watch& watch) const;
+  u32 ReadWatched(u32 address, Watch* watch);
+  u32 ChasePointer(Watch* watch);
+  void AppendMessage(const std::string& line, u32 value);
+  void SendMessages();
 
   bool m_running;
 
   int m_fd;
   sockaddr_un m_addr;
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  // Address as stored in the file -> watch
+  std::map<std::string, Watch> m_watches;
+  // Values read during the current step, shared by the pointer chains that go through them.
+  std::unordered_map<u32, u32> m_step_reads;
+  // Changes waiting to be sent, each terminated by a null character.
+  std::string m_messages;
 };
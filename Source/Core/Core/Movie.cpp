@@ -6,9 +6,13 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
+#include <cinttypes>
+#include <cstdio>
 #include <iomanip>
 #include <iterator>
+#include <map>
 #include <mbedtls/config.h>
 #include <mbedtls/md.h>
 #include <mutex>
@@ -23,6 +27,7 @@
 #include "Common/CommonPaths.h"
 #include "Common/Config/Config.h"
 #include "Common/File.h"
+#include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/NandPaths.h"
@@ -102,6 +107,25 @@ static WiiManipFunction s_wii_manip_func;
 
 static std::string s_current_file_name;
 
+// While a movie plays, a state is saved every KEYFRAME_INTERVAL frames to a directory next to
+// it, for seeking. Keyframes are named after their frame and the size and hash of the input
+// leading up to it, so that those of an older version of the movie are left out.
+static const u64 KEYFRAME_INTERVAL = 60 * 60;
+
+struct Keyframe
+{
+  u64 input_size;
+  u64 input_hash;
+  std::string path;
+};
+
+static std::mutex s_keyframes_lock;
+static std::map<u64, Keyframe> s_keyframes;
+static std::string s_keyframe_directory;
+static u64 s_keyframe_slot = 0;
+// The frame a seek stops at, or 0 when not seeking.
+static std::atomic<u64> s_seek_target{0};
+
 static void GetSettings();
 static bool IsMovieHeader(u8 magic[4])
 {
@@ -186,6 +210,13 @@ void FrameUpdate()
   if (!s_bPolled)
     s_currentLagCount++;
 
+  const u64 seek_target = s_seek_target.load();
+  if (seek_target != 0 && s_currentFrame >= seek_target)
+  {
+    s_seek_target.store(0);
+    Core::SetIsCatchingUp(false);
+  }
+
   if (IsRecordingInput())
   {
     s_totalFrames = s_currentFrame;
@@ -247,6 +278,81 @@ void Init(const BootParameters& boot)
   }
 }
 
+static u64 HashInput(u64 size)
+{
+  return GetMurmurHash3(s_temp_input.data(), static_cast<u32>(size), 0);
+}
+
+// NOTE: Host Thread
+static void LoadKeyframes(const std::string& movie_path)
+{
+  std::lock_guard<std::mutex> lk(s_keyframes_lock);
+  s_keyframes.clear();
+  s_keyframe_directory = movie_path + ".keyframes" DIR_SEP;
+  s_keyframe_slot = 0;
+  for (const std::string& path : Common::DoFileSearch({s_keyframe_directory}, {".sav"}))
+  {
+    std::string name;
+    SplitPath(path, nullptr, &name, nullptr);
+    u64 frame;
+    Keyframe keyframe;
+    if (std::sscanf(name.c_str(), "%" SCNu64 "_%" SCNu64 "_%" SCNx64, &frame,
+                    &keyframe.input_size, &keyframe.input_hash) != 3 ||
+        keyframe.input_size > s_temp_input.size() ||
+        HashInput(keyframe.input_size) != keyframe.input_hash)
+    {
+      continue;
+    }
+    keyframe.path = path;
+    s_keyframes.emplace(frame, std::move(keyframe));
+  }
+}
+
+// NOTE: CPU Thread (CoreTiming safe point)
+static void SaveKeyframe()
+{
+  if (!IsPlayingInput())
+    return;
+
+  const u64 frame = s_currentFrame;
+  Keyframe keyframe;
+  keyframe.input_size = s_currentByte;
+  keyframe.input_hash = HashInput(keyframe.input_size);
+  keyframe.path = s_keyframe_directory +
+                  StringFromFormat("%" PRIu64 "_%" PRIu64 "_%016" PRIx64 ".sav", frame,
+                                   keyframe.input_size, keyframe.input_hash);
+
+  // Later keyframes only store what differs from the first one.
+  std::string base;
+  {
+    std::lock_guard<std::mutex> lk(s_keyframes_lock);
+    if (!s_keyframes.empty())
+      base = s_keyframes.begin()->second.path;
+  }
+  File::CreateFullPath(s_keyframe_directory);
+  State::SaveKeyframe(keyframe.path, base);
+
+  std::lock_guard<std::mutex> lk(s_keyframes_lock);
+  s_keyframes[frame] = std::move(keyframe);
+}
+
+// NOTE: CPU Thread
+static void UpdateKeyframes()
+{
+  const u64 slot = s_currentFrame / KEYFRAME_INTERVAL;
+  if (slot == s_keyframe_slot)
+    return;
+  s_keyframe_slot = slot;
+
+  {
+    std::lock_guard<std::mutex> lk(s_keyframes_lock);
+    const auto next = s_keyframes.lower_bound(slot * KEYFRAME_INTERVAL);
+    if (next != s_keyframes.end() && next->first < (slot + 1) * KEYFRAME_INTERVAL)
+      return;
+  }
+  CoreTiming::RequestSafePoint(SaveKeyframe);
+}
+
 // NOTE: CPU Thread
 void InputUpdate()
 {
@@ -257,6 +363,11 @@ void InputUpdate()
     s_totalTickCount += CoreTiming::GetTicks() - s_tickCountAtLastInput;
     s_tickCountAtLastInput = CoreTiming::GetTicks();
   }
+  else if (IsPlayingInput() && s_bReadOnly && SConfig::GetInstance().m_MovieKeyframes &&
+           !NetPlay::IsNetPlayRunning())
+  {
+    UpdateKeyframes();
+  }
 }
 
 // NOTE: CPU Thread
@@ -274,6 +385,60 @@ void SetReadOnly(bool bEnabled)
   s_bReadOnly = bEnabled;
 }
 
+static void StopSeeking()
+{
+  if (s_seek_target.exchange(0) != 0)
+    Core::SetIsCatchingUp(false);
+}
+
+// NOTE: Host Thread
+bool SeekToFrame(u64 frame)
+{
+  if (!IsPlayingInput() || !s_bReadOnly || NetPlay::IsNetPlayRunning())
+  {
+    Core::DisplayMessage("Seeking needs a movie playing in read-only mode.", 2000);
+    return false;
+  }
+
+  bool found = false;
+  u64 keyframe_frame = 0;
+  std::string keyframe_path;
+  {
+    std::lock_guard<std::mutex> lk(s_keyframes_lock);
+    auto keyframe = s_keyframes.upper_bound(frame);
+    if (keyframe != s_keyframes.begin())
+    {
+      --keyframe;
+      found = true;
+      keyframe_frame = keyframe->first;
+      keyframe_path = keyframe->second.path;
+    }
+  }
+
+  StopSeeking();
+  const u64 current_frame = s_currentFrame;
+  if (found && (keyframe_frame > current_frame || frame < current_frame))
+  {
+    if (!State::LoadKeyframe(keyframe_path))
+    {
+      Core::DisplayMessage("Failed to load keyframe " + keyframe_path, 2000);
+      return false;
+    }
+  }
+  else if (frame < current_frame)
+  {
+    Core::DisplayMessage(StringFromFormat("No keyframe before frame %" PRIu64, frame), 2000);
+    return false;
+  }
+
+  if (s_currentFrame < frame)
+  {
+    s_seek_target.store(frame);
+    Core::SetIsCatchingUp(true);
+  }
+  return true;
+}
+
 bool IsRecordingInput()
 {
   return (s_playMode == MODE_RECORDING);
@@ -899,6 +1064,8 @@ bool PlayInput(const std::string& movie_path, std::optional<std::string>* savest
   s_currentByte = 0;
   recording_file.Close();
 
+  LoadKeyframes(movie_path);
+
   // Load savestate (and skip to frame data)
   if (tmpHeader.bFromSaveState && savestate_path)
   {
@@ -1267,6 +1434,7 @@ void EndPlayInput(bool cont)
     bool was_running = Core::IsRunningAndStarted() && !CPU::IsStepping();
     if (was_running)
       CPU::Break();
+    StopSeeking();
     s_rerecords = 0;
     s_currentByte = 0;
     s_playMode = MODE_NONE;
@@ -1479,6 +1647,7 @@ static void GetMD5()
 // NOTE: EmuThread
 void Shutdown()
 {
+  StopSeeking();
   s_currentInputCount = s_totalInputCount = s_totalFrames = s_tickCountAtLastInput = 0;
   s_temp_input.clear();
 }
@@ -154,6 +154,10 @@ void ChangeWiiPads(bool instantly = false);
 
 void SetReadOnly(bool bEnabled);
 
+// Loads the closest keyframe before the frame if that gets there sooner, then emulates the rest
+// of the way without showing it. Only works while playing in read-only mode.
+bool SeekToFrame(u64 frame);
+
 bool BeginRecordingInput(int controllers);
 void RecordInput(GCPadStatus* PadStatus, int controllerID);
 void RecordWiimote(int wiimote, u8* data, u8 size);
@@ -5,6 +5,7 @@
 #include "Core/NetPlayClient.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstddef>
 #include <cstring>
 #include <fstream>
@@ -13,11 +14,13 @@
 #include <sstream>
 #include <thread>
 
+#include <lzo/lzo1x.h>
 #include <mbedtls/md5.h>
 
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/ENetUtil.h"
+#include "Common/Hash.h"
 #include "Common/MD5.h"
 #include "Common/MsgHandler.h"
 #include "Common/QoSSession.h"
@@ -26,14 +29,19 @@
 #include "Common/Version.h"
 #include "Core/Config/NetplaySettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/SI/SI_DeviceGCController.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/Sram.h"
 #include "Core/HW/WiimoteEmu/WiimoteEmu.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/IOS/USB/Bluetooth/BTEmu.h"
 #include "Core/Movie.h"
+#include "Core/State.h"
 #include "InputCommon/GCAdapter.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
@@ -325,14 +333,11 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 
   case NP_MSG_PAD_DATA:
   {
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-      pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-
-    // Trusting server for good map value (>=0 && <4)
     // add to pad buffer
-    m_pad_buffer.at(map).Push(pad);
+    m_pad_decoder.Read(packet, [this](PadMapping map, const GCPadStatus& pad) {
+      m_pad_buffer[map].Push(pad);
+      return true;
+    });
     m_gc_pad_event.Set();
   }
   break;
@@ -429,6 +434,7 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
       g_NetPlaySettings.m_EXIDevice[0] = static_cast<ExpansionInterface::TEXIDevices>(tmp);
       packet >> tmp;
       g_NetPlaySettings.m_EXIDevice[1] = static_cast<ExpansionInterface::TEXIDevices>(tmp);
+      packet >> g_NetPlaySettings.m_Rollback;
 
       u32 time_low, time_high;
       packet >> time_low;
@@ -481,8 +487,10 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
   {
     int pid_to_blame;
     u32 frame;
+    int region;
     packet >> pid_to_blame;
     packet >> frame;
+    packet >> region;
 
     std::string player = "??";
     std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
@@ -491,10 +499,62 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
       if (it != m_players.end())
         player = it->second.name;
     }
+
+    if (region >= 0)
+    {
+      // Regions cover RAM, then EXRAM.
+      const u32 offset = static_cast<u32>(region) * MEMORY_HASH_REGION_PAGES * 4096;
+      const u32 address =
+          offset < Memory::RAM_SIZE ? offset : 0x10000000 + (offset - Memory::RAM_SIZE);
+      m_dialog->AppendChat(StringFromFormat(
+          GetStringT("Memory at 0x%08x-0x%08x differs first.").c_str(), address,
+          address + MEMORY_HASH_REGION_PAGES * 4096 - 1));
+    }
+    if (m_rollback)
+      m_awaiting_sync_state.Set();
     m_dialog->OnDesync(frame, player);
   }
   break;
 
+  case NP_MSG_SYNC_STATE_REQUEST:
+  {
+    m_sync_state_requested.Set();
+    m_dialog->AppendChat(GetStringT("Sending your state to the other players..."));
+  }
+  break;
+
+  case NP_MSG_SYNC_STATE:
+  {
+    u32 frame, size, compressed_size;
+    packet >> frame;
+    packet >> size;
+    packet >> compressed_size;
+
+    if (compressed_size > packet.getDataSize())
+      break;
+    const u8* compressed =
+        static_cast<const u8*>(packet.getData()) + packet.getDataSize() - compressed_size;
+
+    std::vector<u8> state(size);
+    lzo_uint out_len = size;
+    if (lzo1x_decompress_safe(compressed, compressed_size, state.data(), &out_len, nullptr) !=
+            LZO_E_OK ||
+        out_len != size)
+    {
+      ERROR_LOG(NETPLAY, "Couldn't decompress the sync state for frame %u", frame);
+      break;
+    }
+
+    {
+      std::lock_guard<std::mutex> lk(m_sync_state_lock);
+      m_sync_state = std::move(state);
+      m_sync_state_frame = frame;
+      m_has_sync_state = true;
+    }
+    m_dialog->AppendChat(GetStringT("Loading the state of another player..."));
+  }
+  break;
+
   case NP_MSG_SYNC_GC_SRAM:
   {
     u8 sram[sizeof(g_SRAM.p_SRAM)];
@@ -575,14 +635,40 @@ void NetPlayClient::Send(const sf::Packet& packet)
   enet_peer_send(m_server, 0, epac);
 }
 
+// called from ---NETPLAY--- thread
+void NetPlayClient::SendQueuedPackets()
+{
+  bool sent = false;
+  while (!m_pad_send_queue.Empty())
+  {
+    Send(m_pad_send_queue.Front());
+    m_pad_send_queue.Pop();
+    sent = true;
+  }
+  while (!m_async_queue.Empty())
+  {
+    Send(m_async_queue.Front());
+    m_async_queue.Pop();
+    sent = true;
+  }
+
+  // Put the packets on the wire now rather than at the next service call, which may be up to
+  // its timeout away when nothing is received.
+  if (sent)
+    enet_host_flush(m_client);
+}
+
 void NetPlayClient::DisplayPlayersPing()
 {
   if (!g_ActiveConfig.bShowNetPlayPing)
     return;
 
+  // ENet measures the round trip time of every acknowledged packet to the host; its variance
+  // is the jitter the pad buffer has to absorb.
   OSD::AddTypedMessage(OSD::MessageType::NetPlayPing,
-    StringFromFormat("Ping: %u", GetPlayersMaxPing()), OSD::Duration::SHORT,
-    OSD::Color::CYAN);
+    StringFromFormat("Ping: %u | RTT: %u ms | Jitter: %u ms", GetPlayersMaxPing(),
+      m_server->roundTripTime, m_server->roundTripTimeVariance),
+    OSD::Duration::SHORT, OSD::Color::CYAN);
 }
 
 u32 NetPlayClient::GetPlayersMaxPing() const
@@ -652,11 +738,7 @@ void NetPlayClient::ThreadFunc()
     if (m_traversal_client)
       m_traversal_client->HandleResends();
     net = enet_host_service(m_client, &netEvent, 250);
-    while (!m_async_queue.Empty())
-    {
-      Send(m_async_queue.Front());
-      m_async_queue.Pop();
-    }
+    SendQueuedPackets();
     if (net > 0)
     {
       sf::Packet rpac;
@@ -762,13 +844,21 @@ void NetPlayClient::SendChatMessage(const std::string& msg)
 // called from ---CPU--- thread
 void NetPlayClient::SendPadState(const int in_game_pad, const GCPadStatus& pad)
 {
+  m_pad_encoder.Add(static_cast<PadMapping>(in_game_pad), pad);
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendPadStates()
+{
+  if (m_pad_encoder.IsEmpty())
+    return;
+
   sf::Packet packet;
   packet << static_cast<MessageId>(NP_MSG_PAD_DATA);
-  packet << static_cast<PadMapping>(in_game_pad);
-  packet << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-    << pad.substickY << pad.triggerLeft << pad.triggerRight << pad.isConnected;
+  m_pad_encoder.Write(packet);
 
-  SendAsync(std::move(packet));
+  m_pad_send_queue.Push(std::move(packet));
+  ENetUtil::WakeupThread(m_client);
 }
 
 // called from ---CPU--- thread
@@ -818,11 +908,17 @@ bool NetPlayClient::StartGame(const std::string& path)
   }
 
   m_timebase_frame = 0;
+  m_memory_hash_frame = 0;
+  m_page_hashes.clear();
+  m_region_hashes.clear();
+  m_memory_subscription.Reset();
 
   m_is_running.Set();
   NetPlay_Enable(this);
 
   ClearBuffers();
+  ResetRollback();
+  m_pad_encoder.Reset();
 
   if (m_dialog->IsRecording())
   {
@@ -955,6 +1051,281 @@ void NetPlayClient::OnConnectFailed(u8 reason)
   }
 }
 
+static GCPadStatus GetLocalPadStatus(int local_pad)
+{
+  switch (SConfig::GetInstance().m_SIDevice[local_pad])
+  {
+  case SerialInterface::SIDEVICE_WIIU_ADAPTER:
+    return GCAdapter::Input(local_pad);
+  case SerialInterface::SIDEVICE_GC_CONTROLLER:
+  default:
+    return Pad::GetStatus(local_pad);
+  }
+}
+
+static bool IsSamePadStatus(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.isConnected == b.isConnected;
+}
+
+void NetPlayClient::ResetRollback()
+{
+  m_rollback = g_NetPlaySettings.m_Rollback &&
+               std::none_of(m_wiimote_map.begin(), m_wiimote_map.end(),
+                            [](auto mapping) { return mapping > 0; });
+  for (RollbackPad& pad : m_rollback_pads)
+  {
+    pad.confirmed.clear();
+    pad.used.clear();
+  }
+  m_rollback_first_frame = 0;
+  m_rollback_frame = 0;
+  m_rollback_resume_frame = 0;
+  m_rollback_local_frames = 0;
+  m_rollback_misprediction = NO_MISPREDICTION;
+  m_rollback_first_synced_frame = 0;
+  m_rollback_memory_hashes.clear();
+  m_sync_state_requested.Clear();
+  m_awaiting_sync_state.Clear();
+  {
+    std::lock_guard<std::mutex> lk(m_sync_state_lock);
+    m_sync_state.clear();
+    m_has_sync_state = false;
+  }
+  Core::SetIsCatchingUp(false);
+}
+
+// called from ---CPU--- thread
+// Local inputs are only taken when a frame is emulated for the first time, not again after
+// rolling back.
+void NetPlayClient::SendLocalRollbackPads()
+{
+  const u64 frame = m_rollback_frame - 1;
+  const int num_local_pads = NumLocalPads();
+  while (m_rollback_local_frames <= frame + m_target_buffer_size)
+  {
+    for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
+    {
+      const GCPadStatus pad_status = GetLocalPadStatus(local_pad);
+      const int ingame_pad = LocalPadToInGamePad(local_pad);
+      m_rollback_pads[ingame_pad].confirmed.push_back(pad_status);
+      SendPadState(ingame_pad, pad_status);
+    }
+    m_rollback_local_frames++;
+  }
+  SendPadStates();
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::ReceiveRollbackPad(int pad_nb)
+{
+  RollbackPad& pad = m_rollback_pads[pad_nb];
+  GCPadStatus pad_status;
+  while (m_pad_buffer[pad_nb].Pop(pad_status))
+  {
+    const size_t index = pad.confirmed.size();
+    pad.confirmed.push_back(pad_status);
+    const u64 frame = m_rollback_first_frame + index;
+    if (index < pad.used.size() && frame >= m_rollback_first_synced_frame &&
+        !IsSamePadStatus(pad.used[index], pad_status))
+    {
+      m_rollback_misprediction = std::min(m_rollback_misprediction, frame);
+    }
+  }
+}
+
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackPad(int pad_nb, GCPadStatus* pad_status)
+{
+  RollbackPad& pad = m_rollback_pads[pad_nb];
+  const u64 index = m_rollback_frame - 1 - m_rollback_first_frame;
+
+  // Predictions need an input to go from, and can't go further than a rollback can reach. The
+  // state sent to the other players after a desync mustn't depend on any.
+  ReceiveRollbackPad(pad_nb);
+  const u64 max_predicted = m_sync_state_requested.IsSet() ? 0 : MAX_ROLLBACK_FRAMES;
+  while (pad.confirmed.empty() || index >= pad.confirmed.size() + max_predicted)
+  {
+    if (!m_is_running.IsSet())
+      return false;
+
+    m_gc_pad_event.Wait();
+    ReceiveRollbackPad(pad_nb);
+  }
+
+  *pad_status = index < pad.confirmed.size() ? pad.confirmed[index] : pad.confirmed.back();
+  if (index < pad.used.size())
+    pad.used[index] = *pad_status;
+  else
+    pad.used.push_back(*pad_status);
+  return true;
+}
+
+// called from ---CPU--- thread
+// Runs at the end of the CoreTiming slice in which a frame started.
+void NetPlayClient::OnRollbackSafePoint()
+{
+  const u64 frame = m_rollback_frame - 1;
+  if (frame == 0)
+    State::InitSnapshots(MAX_ROLLBACK_FRAMES + 1);
+
+  for (int pad_nb = 0; pad_nb < 4; pad_nb++)
+  {
+    if (m_pad_map[pad_nb] > 0)
+      ReceiveRollbackPad(pad_nb);
+  }
+
+  if (LoadSyncState())
+    return;
+
+  if (m_rollback_misprediction != NO_MISPREDICTION)
+  {
+    // The snapshot after the frame before the misprediction.
+    const u64 target = m_rollback_misprediction;
+    m_rollback_misprediction = NO_MISPREDICTION;
+    if (target > 0 && State::LoadSnapshot(static_cast<u32>(frame - target)))
+    {
+      m_rollback_resume_frame = std::max(m_rollback_resume_frame, m_rollback_frame);
+      m_rollback_frame = target;
+      Core::SetIsCatchingUp(true);
+      return;
+    }
+    ERROR_LOG(NETPLAY, "Couldn't roll back from frame %" PRIu64 " to %" PRIu64, frame, target);
+  }
+
+  State::SaveSnapshot();
+  if (m_rollback_frame >= m_rollback_resume_frame)
+    Core::SetIsCatchingUp(false);
+
+  // Frames emulated again after a rollback replace the hashes they had before.
+  if (frame % MEMORY_HASH_INTERVAL == 0)
+  {
+    m_rollback_memory_hashes = HashMemory();
+    m_rollback_memory_hash_frame = frame;
+  }
+  if (!m_rollback_memory_hashes.empty() && m_rollback_memory_hash_frame <= frame &&
+      IsRollbackFrameConfirmed(m_rollback_memory_hash_frame))
+  {
+    SendMemoryHashes(m_rollback_memory_hash_frame, m_rollback_memory_hashes);
+    m_rollback_memory_hashes.clear();
+  }
+
+  if (m_sync_state_requested.IsSet() && IsRollbackFrameConfirmed(frame))
+  {
+    SendSyncState(frame);
+    m_sync_state_requested.Clear();
+    m_awaiting_sync_state.Clear();
+  }
+
+  // Inputs from before the oldest snapshot can't be used anymore, unless another player's state
+  // from before it may arrive.
+  const u64 kept_frames =
+      m_awaiting_sync_state.IsSet() ? MAX_SYNC_STATE_FRAMES : 2 * MAX_ROLLBACK_FRAMES;
+  while (m_rollback_first_frame + kept_frames < m_rollback_frame)
+  {
+    for (RollbackPad& pad : m_rollback_pads)
+    {
+      if (!pad.confirmed.empty())
+        pad.confirmed.pop_front();
+      if (!pad.used.empty())
+        pad.used.pop_front();
+    }
+    m_rollback_first_frame++;
+  }
+}
+
+// called from ---CPU--- thread
+// Whether the inputs of every pad are known up to the frame.
+bool NetPlayClient::IsRollbackFrameConfirmed(u64 frame) const
+{
+  for (int pad_nb = 0; pad_nb < 4; pad_nb++)
+  {
+    if (m_pad_map[pad_nb] > 0 &&
+        m_rollback_first_frame + m_rollback_pads[pad_nb].confirmed.size() <= frame)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// called from ---CPU--- thread
+// Replaces the state with the one another player sent after a desync, then emulates the frames
+// after it again.
+bool NetPlayClient::LoadSyncState()
+{
+  std::vector<u8> state;
+  u64 state_frame;
+  {
+    std::lock_guard<std::mutex> lk(m_sync_state_lock);
+    if (!m_has_sync_state)
+      return false;
+    m_has_sync_state = false;
+    state.swap(m_sync_state);
+    state_frame = m_sync_state_frame;
+  }
+  m_awaiting_sync_state.Clear();
+
+  const u64 target = state_frame + 1;
+  if (target < m_rollback_first_frame || !State::LoadNetPlaySyncState(state))
+  {
+    ERROR_LOG(NETPLAY, "Couldn't load the sync state for frame %" PRIu64, state_frame);
+    return false;
+  }
+  State::InitSnapshots(MAX_ROLLBACK_FRAMES + 1);
+  State::SaveSnapshot();
+
+  // The state may be ahead, in which case the frames up to it are never emulated here.
+  for (RollbackPad& pad : m_rollback_pads)
+    pad.used.resize(std::max<size_t>(pad.used.size(), target - m_rollback_first_frame));
+  if (m_rollback_memory_hash_frame < target)
+    m_rollback_memory_hashes.clear();
+
+  m_rollback_resume_frame = std::max(m_rollback_resume_frame, m_rollback_frame);
+  m_rollback_frame = target;
+  m_rollback_first_synced_frame = target;
+  m_rollback_misprediction = NO_MISPREDICTION;
+  Core::SetIsCatchingUp(m_rollback_frame < m_rollback_resume_frame);
+  return true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendSyncState(u64 frame)
+{
+  std::vector<u8> state;
+  State::SaveToBuffer(state);
+
+  std::vector<u8> compressed(state.size() + state.size() / 16 + 64 + 3);
+  std::vector<lzo_align_t> wrkmem((LZO1X_1_MEM_COMPRESS + sizeof(lzo_align_t) - 1) /
+                                  sizeof(lzo_align_t));
+  lzo_uint compressed_size = 0;
+  if (lzo1x_1_compress(state.data(), static_cast<lzo_uint>(state.size()), compressed.data(),
+                       &compressed_size, wrkmem.data()) != LZO_E_OK)
+  {
+    ERROR_LOG(NETPLAY, "Couldn't compress the sync state for frame %" PRIu64, frame);
+    return;
+  }
+
+  sf::Packet packet;
+  packet << static_cast<MessageId>(NP_MSG_SYNC_STATE);
+  packet << static_cast<u32>(frame);
+  packet << static_cast<u32>(state.size());
+  packet << static_cast<u32>(compressed_size);
+  packet.append(compressed.data(), compressed_size);
+  SendAsync(std::move(packet));
+}
+
+void NetPlayClient::RollbackSafePoint()
+{
+  std::lock_guard<std::mutex> lk(crit_netplay_client);
+
+  if (netplay_client)
+    netplay_client->OnRollbackSafePoint();
+}
+
 // called from ---CPU--- thread
 bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
 {
@@ -979,21 +1350,24 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
   // will be polled as well. To reduce latency, we poll all local
   // controllers at once and then send the status to the other
   // clients.
+  if (m_rollback)
+  {
+    if (IsFirstInGamePad(pad_nb))
+    {
+      m_rollback_frame++;
+      SendLocalRollbackPads();
+      CoreTiming::RequestSafePoint(RollbackSafePoint);
+    }
+    // The inputs may be predictions, which don't belong in a movie.
+    return GetRollbackPad(pad_nb, pad_status);
+  }
+
   if (IsFirstInGamePad(pad_nb))
   {
     const int num_local_pads = NumLocalPads();
     for (int local_pad = 0; local_pad < num_local_pads; local_pad++)
     {
-      switch (SConfig::GetInstance().m_SIDevice[local_pad])
-      {
-      case SerialInterface::SIDEVICE_WIIU_ADAPTER:
-        *pad_status = GCAdapter::Input(local_pad);
-        break;
-      case SerialInterface::SIDEVICE_GC_CONTROLLER:
-      default:
-        *pad_status = Pad::GetStatus(local_pad);
-        break;
-      }
+      *pad_status = GetLocalPadStatus(local_pad);
 
       int ingame_pad = LocalPadToInGamePad(local_pad);
 
@@ -1008,6 +1382,7 @@ bool NetPlayClient::GetNetPads(const int pad_nb, GCPadStatus* pad_status)
         SendPadState(ingame_pad, *pad_status);
       }
     }
+    SendPadStates();
   }
 
   // Now, we either use the data pushed earlier, or wait for the
@@ -1121,6 +1496,7 @@ bool NetPlayClient::StopGame()
   m_wii_pad_event.Set();
 
   NetPlay_Disable();
+  Core::SetIsCatchingUp(false);
 
   // stop game
   m_dialog->StopGame();
@@ -1210,6 +1586,10 @@ void NetPlayClient::SendTimeBase()
 {
   std::lock_guard<std::mutex> lk(crit_netplay_client);
 
+  // Frames emulated with predicted inputs would be reported as desyncs.
+  if (netplay_client->m_rollback)
+    return;
+
   u64 timebase = SystemTimers::GetFakeTimeBase();
 
   sf::Packet packet;
@@ -1221,6 +1601,71 @@ void NetPlayClient::SendTimeBase()
   netplay_client->SendAsync(std::move(packet));
 }
 
+void NetPlayClient::SendMemoryHashes()
+{
+  std::lock_guard<std::mutex> lk(crit_netplay_client);
+
+  // Rollback mode hashes the frames once their inputs are confirmed.
+  if (netplay_client->m_rollback)
+    return;
+
+  const u64 frame = netplay_client->m_memory_hash_frame++;
+  if (frame % MEMORY_HASH_INTERVAL == 0)
+    netplay_client->SendMemoryHashes(frame, netplay_client->HashMemory());
+}
+
+// called from ---CPU--- thread
+std::vector<u64> NetPlayClient::HashMemory()
+{
+  const u32 page_count = WriteWatch::GetPageCount();
+  const u32 region_count = (page_count + MEMORY_HASH_REGION_PAGES - 1) / MEMORY_HASH_REGION_PAGES;
+  if (m_page_hashes.size() != page_count)
+  {
+    m_page_hashes.assign(page_count, 0);
+    m_region_hashes.assign(region_count, 0);
+    m_memory_subscription.Reset();
+  }
+
+  // Only the regions with a written page are hashed again.
+  const std::vector<u64>& changed = m_memory_subscription.Poll();
+  for (u32 region = 0; region < region_count; region++)
+  {
+    const u32 first_page = region * MEMORY_HASH_REGION_PAGES;
+    const u32 num_pages = std::min(page_count - first_page, u32{MEMORY_HASH_REGION_PAGES});
+    bool region_changed = false;
+    for (u32 page = first_page; page < first_page + num_pages; page++)
+    {
+      if (!((changed[page / 64] >> (page % 64)) & 1))
+        continue;
+      m_page_hashes[page] =
+          GetMurmurHash3(WriteWatch::GetPagePointer(page), WriteWatch::WATCH_PAGE_SIZE, 0);
+      region_changed = true;
+    }
+    if (region_changed)
+    {
+      m_region_hashes[region] = GetMurmurHash3(
+          reinterpret_cast<const u8*>(&m_page_hashes[first_page]), num_pages * sizeof(u64), 0);
+    }
+  }
+
+  return m_region_hashes;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendMemoryHashes(u64 frame, const std::vector<u64>& hashes)
+{
+  sf::Packet packet;
+  packet << static_cast<MessageId>(NP_MSG_MEMORY_HASH);
+  packet << static_cast<u32>(frame);
+  packet << static_cast<u32>(hashes.size());
+  for (u64 hash : hashes)
+  {
+    packet << static_cast<u32>(hash);
+    packet << static_cast<u32>(hash >> 32);
+  }
+  SendAsync(std::move(packet));
+}
+
 bool NetPlayClient::DoAllPlayersHaveGame()
 {
   std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
@@ -1253,7 +1698,7 @@ void NetPlayClient::ComputeMD5(const std::string& file_identifier)
   }
 
   m_MD5_thread = std::thread([this, file]() {
-    std::string sum = MD5::MD5Sum(file, [&](int progress) {
+    std::string sum = MD5::MD5TreeSum(file, [&](int progress) {
       sf::Packet packet;
       packet << static_cast<MessageId>(NP_MSG_MD5_PROGRESS);
       packet << progress;
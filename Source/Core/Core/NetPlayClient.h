@@ -6,6 +6,7 @@
 
 #include <SFML/Network/Packet.hpp>
 #include <array>
+#include <deque>
 #include <map>
 #include <mutex>
 #include <string>
@@ -15,6 +16,8 @@
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/HW/WriteWatch.h"
+#include "Core/NetPlayPadData.h"
 #include "Core/NetPlayProto.h"
 #include "InputCommon/GCPadStatus.h"
 
@@ -96,6 +99,7 @@ public:
   int LocalPadToInGamePad(int localPad) const;
 
   static void SendTimeBase();
+  static void SendMemoryHashes();
   bool DoAllPlayersHaveGame();
 
 protected:
@@ -110,9 +114,14 @@ protected:
   } m_crit;
 
   Common::SPSCQueue<sf::Packet, false> m_async_queue;
+  // Pad data is only ever queued by the CPU thread, so it skips the lock above.
+  Common::SPSCQueue<sf::Packet, false> m_pad_send_queue;
 
   std::array<Common::SPSCQueue<GCPadStatus>, 4> m_pad_buffer;
   std::array<Common::SPSCQueue<NetWiimote>, 4> m_wiimote_buffer;
+  // Local pad states are batched up until SendPadStates.
+  NetPlay::PadDataEncoder m_pad_encoder;
+  NetPlay::PadDataDecoder m_pad_decoder;
 
   NetPlayUI* m_dialog = nullptr;
 
@@ -146,6 +155,40 @@ private:
     Failure
   };
 
+  // Rollback mode: a frame starts with each poll of the first in-game pad. The inputs of other
+  // players that haven't arrived yet are predicted to stay the same. A snapshot is saved after
+  // every frame, and when a prediction turns out wrong, the snapshot from before the frame is
+  // loaded and the frames since are emulated again. CPU thread only.
+  struct RollbackPad
+  {
+    // Inputs sent by the player the pad belongs to, by frame from m_rollback_first_frame on.
+    std::deque<GCPadStatus> confirmed;
+    // Inputs the emulated frames used, by frame from m_rollback_first_frame on.
+    std::deque<GCPadStatus> used;
+  };
+
+  // Unconfirmed frames emulated ahead at most, before waiting for the other players.
+  static constexpr u64 MAX_ROLLBACK_FRAMES = 8;
+  static constexpr u64 NO_MISPREDICTION = ~0ull;
+  // Inputs kept at most while waiting for a sync state after a desync.
+  static constexpr u64 MAX_SYNC_STATE_FRAMES = 600;
+
+  // Every MEMORY_HASH_INTERVAL frames, each player sends a hash of every MiB of RAM and EXRAM
+  // to the server, which reports the first region that differs. Only the pages written since
+  // the last time are hashed again.
+  static constexpr u64 MEMORY_HASH_INTERVAL = 60;
+  static constexpr u32 MEMORY_HASH_REGION_PAGES = 256;
+
+  void ResetRollback();
+  void SendLocalRollbackPads();
+  void ReceiveRollbackPad(int pad_nb);
+  bool GetRollbackPad(int pad_nb, GCPadStatus* pad_status);
+  bool IsRollbackFrameConfirmed(u64 frame) const;
+  void OnRollbackSafePoint();
+  bool LoadSyncState();
+  void SendSyncState(u64 frame);
+  static void RollbackSafePoint();
+
   bool LocalPlayerHasControllerMapped() const;
 
   void SendStartGamePacket();
@@ -153,13 +196,17 @@ private:
 
   void UpdateDevices();
   void SendPadState(int in_game_pad, const GCPadStatus& np);
+  void SendPadStates();
   void SendWiimoteState(int in_game_pad, const NetWiimote& nw);
   unsigned int OnData(sf::Packet& packet);
   void Send(const sf::Packet& packet);
+  void SendQueuedPackets();
   void Disconnect();
   bool Connect();
   void ComputeMD5(const std::string& file_identifier);
   void DisplayPlayersPing();
+  std::vector<u64> HashMemory();
+  void SendMemoryHashes(u64 frame, const std::vector<u64>& hashes);
   u32 GetPlayersMaxPing() const;
 
   bool m_is_connected = false;
@@ -177,6 +224,37 @@ private:
   Common::Event m_wii_pad_event;
 
   u32 m_timebase_frame = 0;
+
+  // Hash of each page and each region of memory, CPU thread only.
+  std::vector<u64> m_page_hashes;
+  std::vector<u64> m_region_hashes;
+  WriteWatch::Subscription m_memory_subscription;
+  u64 m_memory_hash_frame = 0;
+
+  bool m_rollback = false;
+  std::array<RollbackPad, 4> m_rollback_pads;
+  u64 m_rollback_first_frame = 0;
+  // Frames started so far, the last of which is being emulated, and the count to reach again
+  // after a rollback.
+  u64 m_rollback_frame = 0;
+  u64 m_rollback_resume_frame = 0;
+  // Local inputs sent so far, which are ahead of the frame by the pad buffer size.
+  u64 m_rollback_local_frames = 0;
+  u64 m_rollback_misprediction = NO_MISPREDICTION;
+  // Frames before a loaded sync state can't be mispredicted anymore.
+  u64 m_rollback_first_synced_frame = 0;
+  // The memory hashes of a frame are held back until its inputs are confirmed.
+  std::vector<u64> m_rollback_memory_hashes;
+  u64 m_rollback_memory_hash_frame = 0;
+
+  // Set by the NetPlay thread when the server asks for this player's state after a desync, and
+  // when another player's state is expected.
+  Common::Flag m_sync_state_requested;
+  Common::Flag m_awaiting_sync_state;
+  std::mutex m_sync_state_lock;
+  std::vector<u8> m_sync_state;
+  u64 m_sync_state_frame = 0;
+  bool m_has_sync_state = false;
 };
 
 void NetPlay_Enable(NetPlayClient* const np);
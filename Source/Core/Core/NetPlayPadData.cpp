@@ -0,0 +1,165 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/NetPlayPadData.h"
+
+namespace NetPlay
+{
+static const u8 RUN_HAS_FIELDS = 0x80;
+static const u8 MAX_RUN_LENGTH = 0x7F;
+
+enum PadField : u16
+{
+  FIELD_BUTTON = 1 << 0,
+  FIELD_ANALOG_A = 1 << 1,
+  FIELD_ANALOG_B = 1 << 2,
+  FIELD_STICK_X = 1 << 3,
+  FIELD_STICK_Y = 1 << 4,
+  FIELD_SUBSTICK_X = 1 << 5,
+  FIELD_SUBSTICK_Y = 1 << 6,
+  FIELD_TRIGGER_LEFT = 1 << 7,
+  FIELD_TRIGGER_RIGHT = 1 << 8,
+  FIELD_IS_CONNECTED = 1 << 9,
+  ALL_FIELDS = (1 << 10) - 1,
+};
+
+static u16 GetChangedFields(const GCPadStatus& a, const GCPadStatus& b)
+{
+  u16 fields = 0;
+  fields |= a.button != b.button ? FIELD_BUTTON : 0;
+  fields |= a.analogA != b.analogA ? FIELD_ANALOG_A : 0;
+  fields |= a.analogB != b.analogB ? FIELD_ANALOG_B : 0;
+  fields |= a.stickX != b.stickX ? FIELD_STICK_X : 0;
+  fields |= a.stickY != b.stickY ? FIELD_STICK_Y : 0;
+  fields |= a.substickX != b.substickX ? FIELD_SUBSTICK_X : 0;
+  fields |= a.substickY != b.substickY ? FIELD_SUBSTICK_Y : 0;
+  fields |= a.triggerLeft != b.triggerLeft ? FIELD_TRIGGER_LEFT : 0;
+  fields |= a.triggerRight != b.triggerRight ? FIELD_TRIGGER_RIGHT : 0;
+  fields |= a.isConnected != b.isConnected ? FIELD_IS_CONNECTED : 0;
+  return fields;
+}
+
+PadDataEncoder::PadDataEncoder()
+{
+  Reset();
+}
+
+void PadDataEncoder::Reset()
+{
+  m_runs.clear();
+  m_last_pads_known.fill(false);
+}
+
+void PadDataEncoder::Add(PadMapping map, const GCPadStatus& pad)
+{
+  const size_t index = static_cast<size_t>(map);
+  const u16 changed_fields =
+      m_last_pads_known[index] ? GetChangedFields(m_last_pads[index], pad) : ALL_FIELDS;
+  m_last_pads[index] = pad;
+  m_last_pads_known[index] = true;
+
+  // Runs of different pads can be in any order, only those of the same pad have to stay in order.
+  if (changed_fields == 0)
+  {
+    for (auto run = m_runs.rbegin(); run != m_runs.rend(); ++run)
+    {
+      if (run->map != map)
+        continue;
+      if (run->count < MAX_RUN_LENGTH)
+      {
+        run->count++;
+        return;
+      }
+      break;
+    }
+  }
+  m_runs.push_back({map, 1, changed_fields, pad});
+}
+
+void PadDataEncoder::Write(sf::Packet& packet)
+{
+  for (const Run& run : m_runs)
+  {
+    packet << run.map;
+    if (run.changed_fields == 0)
+    {
+      packet << run.count;
+      continue;
+    }
+
+    packet << static_cast<u8>(run.count | RUN_HAS_FIELDS) << run.changed_fields;
+    const GCPadStatus& pad = run.pad;
+    if (run.changed_fields & FIELD_BUTTON)
+      packet << pad.button;
+    if (run.changed_fields & FIELD_ANALOG_A)
+      packet << pad.analogA;
+    if (run.changed_fields & FIELD_ANALOG_B)
+      packet << pad.analogB;
+    if (run.changed_fields & FIELD_STICK_X)
+      packet << pad.stickX;
+    if (run.changed_fields & FIELD_STICK_Y)
+      packet << pad.stickY;
+    if (run.changed_fields & FIELD_SUBSTICK_X)
+      packet << pad.substickX;
+    if (run.changed_fields & FIELD_SUBSTICK_Y)
+      packet << pad.substickY;
+    if (run.changed_fields & FIELD_TRIGGER_LEFT)
+      packet << pad.triggerLeft;
+    if (run.changed_fields & FIELD_TRIGGER_RIGHT)
+      packet << pad.triggerRight;
+    if (run.changed_fields & FIELD_IS_CONNECTED)
+      packet << pad.isConnected;
+  }
+  m_runs.clear();
+}
+
+bool PadDataDecoder::Read(sf::Packet& packet,
+                          const std::function<bool(PadMapping, const GCPadStatus&)>& on_pad)
+{
+  while (!packet.endOfPacket())
+  {
+    PadMapping map;
+    u8 count;
+    packet >> map >> count;
+    if (!packet || map < 0 || static_cast<size_t>(map) >= m_last_pads.size())
+      return false;
+
+    GCPadStatus& pad = m_last_pads[map];
+    if (count & RUN_HAS_FIELDS)
+    {
+      u16 changed_fields;
+      packet >> changed_fields;
+      if (changed_fields & FIELD_BUTTON)
+        packet >> pad.button;
+      if (changed_fields & FIELD_ANALOG_A)
+        packet >> pad.analogA;
+      if (changed_fields & FIELD_ANALOG_B)
+        packet >> pad.analogB;
+      if (changed_fields & FIELD_STICK_X)
+        packet >> pad.stickX;
+      if (changed_fields & FIELD_STICK_Y)
+        packet >> pad.stickY;
+      if (changed_fields & FIELD_SUBSTICK_X)
+        packet >> pad.substickX;
+      if (changed_fields & FIELD_SUBSTICK_Y)
+        packet >> pad.substickY;
+      if (changed_fields & FIELD_TRIGGER_LEFT)
+        packet >> pad.triggerLeft;
+      if (changed_fields & FIELD_TRIGGER_RIGHT)
+        packet >> pad.triggerRight;
+      if (changed_fields & FIELD_IS_CONNECTED)
+        packet >> pad.isConnected;
+      if (!packet)
+        return false;
+    }
+
+    for (u8 i = 0; i < (count & MAX_RUN_LENGTH); i++)
+    {
+      if (!on_pad(map, pad))
+        return false;
+    }
+  }
+  return true;
+}
+}
@@ -0,0 +1,59 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <SFML/Network/Packet.hpp>
+#include <array>
+#include <functional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayProto.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// NP_MSG_PAD_DATA carries any number of runs, each one a pad mapping and a byte with the number
+// of frames in the run. When the top bit of that byte is set, a mask of the fields that changed
+// from the previous state of the pad and those fields follow; otherwise the run repeats the
+// previous state. The previous state is the one sent last over the same connection in the same
+// direction, which ENet's reliable ordered delivery keeps in step on both ends.
+class PadDataEncoder
+{
+public:
+  PadDataEncoder();
+
+  // The next state of every pad is sent in full, for a receiver that may have seen anything.
+  void Reset();
+  void Add(PadMapping map, const GCPadStatus& pad);
+  bool IsEmpty() const { return m_runs.empty(); }
+  // Appends the runs added since the last call to the packet.
+  void Write(sf::Packet& packet);
+
+private:
+  struct Run
+  {
+    PadMapping map;
+    u8 count;
+    u16 changed_fields;
+    GCPadStatus pad;
+  };
+
+  std::vector<Run> m_runs;
+  std::array<GCPadStatus, 4> m_last_pads;
+  std::array<bool, 4> m_last_pads_known;
+};
+
+class PadDataDecoder
+{
+public:
+  // Calls on_pad for every frame of every run in the rest of the packet, until it returns false.
+  // Returns false if on_pad did or the packet is malformed.
+  bool Read(sf::Packet& packet, const std::function<bool(PadMapping, const GCPadStatus&)>& on_pad);
+
+private:
+  std::array<GCPadStatus, 4> m_last_pads{};
+};
+}
@@ -25,6 +25,9 @@ struct NetSettings
   bool m_OCEnable;
   float m_OCFactor;
   ExpansionInterface::TEXIDevices m_EXIDevice[2];
+  // Predict the inputs of the other players instead of waiting for them, and roll back when they
+  // turn out different. GameCube controllers only.
+  bool m_Rollback;
 };
 
 struct NetTraversalConfig
@@ -72,6 +75,9 @@ enum
 
   NP_MSG_TIMEBASE = 0xB0,
   NP_MSG_DESYNC_DETECTED = 0xB1,
+  NP_MSG_MEMORY_HASH = 0xB2,
+  NP_MSG_SYNC_STATE_REQUEST = 0xB3,
+  NP_MSG_SYNC_STATE = 0xB4,
 
   NP_MSG_COMPUTE_MD5 = 0xC0,
   NP_MSG_MD5_PROGRESS = 0xC1,
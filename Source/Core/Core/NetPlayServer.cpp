@@ -41,6 +41,22 @@
 
 u64 g_netplay_initial_rtc = 1272737767;
 
+// Finds the player that is the only one to disagree with everyone else, or returns -1.
+template <typename T>
+static int FindOutlier(const std::vector<std::pair<PlayerId, T>>& values)
+{
+  for (const auto& pair : values)
+  {
+    if (std::all_of(values.begin(), values.end(), [&](const std::pair<PlayerId, T>& other) {
+          return other.first == pair.first || other.second != pair.second;
+        }))
+    {
+      return pair.first;
+    }
+  }
+  return -1;
+}
+
 NetPlayServer::~NetPlayServer()
 {
   if (is_connected)
@@ -519,30 +535,38 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 
   case NP_MSG_PAD_DATA:
   {
-    // if this is pad data from the last game still being received, ignore it
-    if (player.current_game != m_current_game)
-      break;
-
-    PadMapping map = 0;
-    GCPadStatus pad;
-    packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-      pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight >> pad.isConnected;
-
-    // If the data is not from the correct player,
-    // then disconnect them.
-    if (m_pad_map.at(map) != player.pid)
+    std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
+
+    // Pad data from the last game still being received is decoded, to keep the decoder in step
+    // with the client, but not relayed.
+    const bool is_current_game = player.current_game == m_current_game;
+    const bool valid =
+        player.pad_decoder.Read(packet, [&](PadMapping map, const GCPadStatus& pad) {
+          if (!is_current_game)
+            return true;
+
+          // If the data is not from the correct player,
+          // then disconnect them.
+          if (m_pad_map[map] != player.pid)
+            return false;
+
+          m_pad_encoder.Add(map, pad);
+          return true;
+        });
+
+    // Relay to clients, including what came before bad data, which the encoder already counts
+    // as sent.
+    if (!m_pad_encoder.IsEmpty())
     {
-      return 1;
-    }
+      sf::Packet spac;
+      spac << (MessageId)NP_MSG_PAD_DATA;
+      m_pad_encoder.Write(spac);
 
-    // Relay to clients
-    sf::Packet spac;
-    spac << (MessageId)NP_MSG_PAD_DATA;
-    spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
-      << pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight
-      << pad.isConnected;
+      SendToClients(spac, player.pid);
+    }
 
-    SendToClients(spac, player.pid);
+    if (!valid)
+      return 1;
   }
   break;
 
@@ -655,32 +679,53 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         return pair.second == timebases[0].second;
       }))
       {
-        int pid_to_blame = -1;
-        for (auto pair : timebases)
-        {
-          if (std::all_of(timebases.begin(), timebases.end(), [&](std::pair<PlayerId, u64> other) {
-            return other.first == pair.first || other.second != pair.second;
-          }))
-          {
-            // we are the only outlier
-            pid_to_blame = pair.first;
-            break;
-          }
-        }
-
-        sf::Packet spac;
-        spac << (MessageId)NP_MSG_DESYNC_DETECTED;
-        spac << pid_to_blame;
-        spac << frame;
-        SendToClients(spac);
-
-        m_desync_detected = true;
+        SendDesyncDetected(FindOutlier(timebases), frame, -1);
       }
       m_timebase_by_frame.erase(frame);
     }
   }
   break;
 
+  case NP_MSG_MEMORY_HASH:
+  {
+    u32 frame, count;
+    packet >> frame;
+    packet >> count;
+
+    if (m_desync_detected || frame < m_memory_hash_first_frame)
+      break;
+
+    std::vector<u64> hashes(count);
+    for (u64& hash : hashes)
+    {
+      u32 x, y;
+      packet >> x;
+      packet >> y;
+      hash = x | (static_cast<u64>(y) << 32);
+    }
+
+    auto& frame_hashes = m_memory_hashes_by_frame[frame];
+    frame_hashes.emplace_back(player.pid, std::move(hashes));
+    if (frame_hashes.size() >= m_players.size())
+      OnMemoryHashes(frame);
+  }
+  break;
+
+  case NP_MSG_SYNC_STATE:
+  {
+    u32 frame;
+    packet >> frame;
+
+    // Passed on as it is, since it holds a whole savestate.
+    SendToClients(packet, player.pid);
+
+    m_timebase_by_frame.clear();
+    m_memory_hashes_by_frame.clear();
+    m_memory_hash_first_frame = frame + 1;
+    m_desync_detected = false;
+  }
+  break;
+
   case NP_MSG_MD5_PROGRESS:
   {
     int progress;
@@ -791,6 +836,60 @@ bool NetPlayServer::AbortMD5()
   return true;
 }
 
+// called from ---NETPLAY--- thread
+// Compares the memory hashes all players sent for the frame, region by region.
+void NetPlayServer::OnMemoryHashes(u32 frame)
+{
+  auto& frame_hashes = m_memory_hashes_by_frame[frame];
+  size_t num_regions = frame_hashes[0].second.size();
+  for (const auto& pair : frame_hashes)
+    num_regions = std::min(num_regions, pair.second.size());
+
+  for (size_t region = 0; region < num_regions; region++)
+  {
+    std::vector<std::pair<PlayerId, u64>> region_hashes;
+    for (const auto& pair : frame_hashes)
+      region_hashes.emplace_back(pair.first, pair.second[region]);
+    if (std::all_of(region_hashes.begin(), region_hashes.end(),
+                    [&](const auto& pair) { return pair.second == region_hashes[0].second; }))
+    {
+      continue;
+    }
+
+    const int pid_to_blame = FindOutlier(region_hashes);
+    SendDesyncDetected(pid_to_blame, frame, static_cast<int>(region));
+
+    // In rollback mode, a player who agrees with the others sends their state to everyone.
+    if (m_settings.m_Rollback)
+    {
+      const auto reference =
+          std::find_if(m_players.begin(), m_players.end(),
+                       [&](const auto& entry) { return entry.first != pid_to_blame; });
+      if (reference != m_players.end())
+      {
+        sf::Packet spac;
+        spac << static_cast<MessageId>(NP_MSG_SYNC_STATE_REQUEST);
+        Send(reference->second.socket, spac);
+      }
+    }
+    break;
+  }
+  m_memory_hashes_by_frame.erase(frame);
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::SendDesyncDetected(int pid_to_blame, u32 frame, int region)
+{
+  sf::Packet spac;
+  spac << static_cast<MessageId>(NP_MSG_DESYNC_DETECTED);
+  spac << pid_to_blame;
+  spac << frame;
+  spac << region;
+  SendToClients(spac);
+
+  m_desync_detected = true;
+}
+
 // called from ---GUI--- thread
 void NetPlayServer::SetNetSettings(const NetSettings& settings)
 {
@@ -801,9 +900,12 @@ void NetPlayServer::SetNetSettings(const NetSettings& settings)
 bool NetPlayServer::StartGame()
 {
   m_timebase_by_frame.clear();
+  m_memory_hashes_by_frame.clear();
+  m_memory_hash_first_frame = 0;
   m_desync_detected = false;
   std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
   m_current_game = Common::Timer::GetTimeMs();
+  m_pad_encoder.Reset();
 
   // no change, just update with clients
   AdjustPadBufferSize(m_target_buffer_size);
@@ -832,6 +934,7 @@ bool NetPlayServer::StartGame()
   spac << m_settings.m_OCFactor;
   spac << m_settings.m_EXIDevice[0];
   spac << m_settings.m_EXIDevice[1];
+  spac << m_settings.m_Rollback;
   spac << (u32)g_netplay_initial_rtc;
   spac << (u32)(g_netplay_initial_rtc >> 32);
 
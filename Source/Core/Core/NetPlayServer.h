@@ -17,6 +17,7 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayPadData.h"
 #include "Core/NetPlayProto.h"
 
 enum class PlayerGameStatus;
@@ -74,6 +75,7 @@ private:
     u32 current_game;
 
     Common::QoSSession qos_session;
+    NetPlay::PadDataDecoder pad_decoder;
 
     bool operator==(const Client& other) const { return this == &other; }
   };
@@ -83,6 +85,8 @@ private:
   unsigned int OnConnect(ENetPeer* socket);
   unsigned int OnDisconnect(const Client& player);
   unsigned int OnData(sf::Packet& packet, Client& player);
+  void OnMemoryHashes(u32 frame);
+  void SendDesyncDetected(int pid_to_blame, u32 frame, int region);
 
   void OnTraversalStateChanged() override;
   void OnConnectReady(ENetAddress) override {}
@@ -102,10 +106,16 @@ private:
   unsigned int m_target_buffer_size = 0;
   PadMappingArray m_pad_map;
   PadMappingArray m_wiimote_map;
+  // Batches the pad states of each received packet for relaying, under m_crit.game.
+  NetPlay::PadDataEncoder m_pad_encoder;
 
   std::map<PlayerId, Client> m_players;
 
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
+  std::unordered_map<u32, std::vector<std::pair<PlayerId, std::vector<u64>>>>
+      m_memory_hashes_by_frame;
+  // Hashes from before the last sync state was sent are from a state that was replaced.
+  u32 m_memory_hash_first_frame = 0;
   bool m_desync_detected;
 
   struct
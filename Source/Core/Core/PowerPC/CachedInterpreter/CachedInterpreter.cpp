@@ -4,6 +4,7 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -15,10 +16,23 @@
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
+// Instruction fields extracted at compile time. What each field means is up to the callback;
+// immediates are stored already shifted and sign extended.
+struct DecodedOperands
+{
+  u8 d;
+  u8 a;
+  u8 d2;
+  u8 a2;
+  u32 imm;
+  u32 imm2;
+};
+
 struct CachedInterpreter::Instruction
 {
   using CommonCallback = void (*)(UGeckoInstruction);
   using ConditionalCallback = bool (*)(u32);
+  using DecodedCallback = void (*)(const DecodedOperands&);
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -31,20 +45,31 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  Instruction(const DecodedCallback c, const DecodedOperands& o)
+      : decoded_callback(c), operands(o), type(Type::Decoded)
+  {
+  }
+
   enum class Type
   {
     Abort,
     Common,
     Conditional,
+    Decoded,
   };
 
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const DecodedCallback decoded_callback;
   };
 
-  u32 data = 0;
+  union
+  {
+    u32 data = 0;
+    DecodedOperands operands;
+  };
   Type type = Type::Abort;
 };
 
@@ -83,7 +108,7 @@ void CachedInterpreter::ExecuteOneBlock()
   const u8* normal_entry = m_block_cache.Dispatch();
   if (!normal_entry)
   {
-    Jit(PC);
+    JitTrampoline(*this, PC);
     return;
   }
 
@@ -102,6 +127,10 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::Decoded:
+      code->decoded_callback(code->operands);
+      break;
+
     default:
       ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", code->type);
       break;
@@ -172,6 +201,185 @@ static bool CheckDSI(u32 data)
   return false;
 }
 
+static void LoadImmediate(const DecodedOperands& op)
+{
+  rGPR[op.d] = op.imm;
+}
+
+static void LoadImmediatePair(const DecodedOperands& op)
+{
+  rGPR[op.d] = op.imm;
+  rGPR[op.d2] = op.imm2;
+}
+
+static void AddImmediate(const DecodedOperands& op)
+{
+  rGPR[op.d] = rGPR[op.a] + op.imm;
+}
+
+static void OrImmediate(const DecodedOperands& op)
+{
+  rGPR[op.d] = rGPR[op.a] | op.imm;
+}
+
+static void RotateAndMask(const DecodedOperands& op)
+{
+  rGPR[op.d] = _rotl(rGPR[op.a], op.d2) & op.imm;
+}
+
+static void CompareImmediate(const DecodedOperands& op)
+{
+  const s32 a = rGPR[op.a];
+  const s32 b = op.imm;
+  int f = a < b ? 0x8 : (a > b ? 0x4 : 0x2);
+  if (PowerPC::GetXER_SO())
+    f |= 0x1;
+  PowerPC::SetCRField(op.d, f);
+}
+
+static void CompareLogicalImmediate(const DecodedOperands& op)
+{
+  const u32 a = rGPR[op.a];
+  const u32 b = op.imm;
+  int f = a < b ? 0x8 : (a > b ? 0x4 : 0x2);
+  if (PowerPC::GetXER_SO())
+    f |= 0x1;
+  PowerPC::SetCRField(op.d, f);
+}
+
+static void LoadWord(const DecodedOperands& op)
+{
+  const u32 temp = PowerPC::Read_U32((op.a ? rGPR[op.a] : 0) + op.imm);
+  if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+    rGPR[op.d] = temp;
+}
+
+static void LoadWordAndAddImmediate(const DecodedOperands& op)
+{
+  LoadWord(op);
+  rGPR[op.d2] = (op.a2 ? rGPR[op.a2] : 0) + op.imm2;
+}
+
+static void StoreWord(const DecodedOperands& op)
+{
+  PowerPC::Write_U32(rGPR[op.d], (op.a ? rGPR[op.a] : 0) + op.imm);
+}
+
+static u32 RotationMask(u32 mb, u32 me)
+{
+  const u32 mask = (0xFFFFFFFF >> mb) ^ (0x7FFFFFFF >> me);
+  return me < mb ? ~mask : mask;
+}
+
+// Whether the op is an addi or addis, returning its immediate.
+static bool IsAddImmediate(UGeckoInstruction inst, u32* imm)
+{
+  if (inst.OPCD == 14)
+    *imm = static_cast<u32>(static_cast<s32>(inst.SIMM_16));
+  else if (inst.OPCD == 15)
+    *imm = static_cast<u32>(inst.SIMM_16) << 16;
+  else
+    return false;
+  return true;
+}
+
+bool CachedInterpreter::EmitFusedOps(const PPCAnalyst::CodeOp& first,
+                                     const PPCAnalyst::CodeOp& second)
+{
+  const UGeckoInstruction a = first.inst;
+  const UGeckoInstruction b = second.inst;
+  u32 imm, imm2;
+
+  // lis/li followed by an ori or addi of the same register, the usual way of loading a
+  // 32-bit constant, or simply two constants in a row.
+  if (IsAddImmediate(a, &imm) && a.RA == 0)
+  {
+    if (b.OPCD == 24 && b.RS == a.RD)  // ori
+    {
+      const u32 value = imm | b.UIMM;
+      if (b.RA == a.RD)
+        m_code.emplace_back(LoadImmediate, DecodedOperands{u8(b.RA), 0, 0, 0, value, 0});
+      else
+        m_code.emplace_back(LoadImmediatePair,
+                            DecodedOperands{u8(a.RD), 0, u8(b.RA), 0, imm, value});
+      return true;
+    }
+    if (IsAddImmediate(b, &imm2) && (b.RA == 0 || b.RA == a.RD))
+    {
+      const u32 value = b.RA == 0 ? imm2 : imm + imm2;
+      if (b.RD == a.RD)
+        m_code.emplace_back(LoadImmediate, DecodedOperands{u8(b.RD), 0, 0, 0, value, 0});
+      else
+        m_code.emplace_back(LoadImmediatePair,
+                            DecodedOperands{u8(a.RD), 0, u8(b.RD), 0, imm, value});
+      return true;
+    }
+  }
+
+  // lwz followed by an addi, e.g. walking a list or bumping a pointer. The loaded register
+  // must not feed the addi, which could then see the value from before a failed load.
+  if (a.OPCD == 32 && !jo.memcheck && IsAddImmediate(b, &imm2) && (b.RA == 0 || b.RA != a.RD))
+  {
+    m_code.emplace_back(LoadWordAndAddImmediate,
+                        DecodedOperands{u8(a.RD), u8(a.RA), u8(b.RD), u8(b.RA),
+                                        static_cast<u32>(static_cast<s32>(a.SIMM_16)), imm2});
+    return true;
+  }
+
+  return false;
+}
+
+bool CachedInterpreter::EmitDecodedOp(const PPCAnalyst::CodeOp& op)
+{
+  const UGeckoInstruction inst = op.inst;
+  u32 imm;
+
+  if (IsAddImmediate(inst, &imm))
+  {
+    if (inst.RA == 0)
+      m_code.emplace_back(LoadImmediate, DecodedOperands{u8(inst.RD), 0, 0, 0, imm, 0});
+    else
+      m_code.emplace_back(AddImmediate, DecodedOperands{u8(inst.RD), u8(inst.RA), 0, 0, imm, 0});
+    return true;
+  }
+
+  switch (inst.OPCD)
+  {
+  case 10:  // cmpli
+    m_code.emplace_back(CompareLogicalImmediate,
+                        DecodedOperands{u8(inst.CRFD), u8(inst.RA), 0, 0, inst.UIMM, 0});
+    return true;
+  case 11:  // cmpi
+    m_code.emplace_back(CompareImmediate,
+                        DecodedOperands{u8(inst.CRFD), u8(inst.RA), 0, 0,
+                                        static_cast<u32>(static_cast<s32>(inst.SIMM_16)), 0});
+    return true;
+  case 21:  // rlwinm
+    if (inst.Rc)
+      return false;
+    m_code.emplace_back(RotateAndMask, DecodedOperands{u8(inst.RA), u8(inst.RS), u8(inst.SH), 0,
+                                                       RotationMask(inst.MB, inst.ME), 0});
+    return true;
+  case 24:  // ori
+  case 25:  // oris
+  {
+    const u32 value = inst.OPCD == 24 ? inst.UIMM : inst.UIMM << 16;
+    m_code.emplace_back(OrImmediate, DecodedOperands{u8(inst.RA), u8(inst.RS), 0, 0, value, 0});
+    return true;
+  }
+  case 32:  // lwz
+  case 36:  // stw
+    if (jo.memcheck)
+      return false;
+    m_code.emplace_back(inst.OPCD == 32 ? LoadWord : StoreWord,
+                        DecodedOperands{u8(inst.RD), u8(inst.RA), 0, 0,
+                                        static_cast<u32>(static_cast<s32>(inst.SIMM_16)), 0});
+    return true;
+  default:
+    return false;
+  }
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -242,9 +450,22 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
+      // The second op of a pair must be just as plain: no exits, checks or HLE hooks.
+      const bool can_fuse = !check_fpu && !endblock && !memcheck &&
+                            i + 1 < code_block.m_num_instructions && !ops[i + 1].skip &&
+                            !(ops[i + 1].opinfo->flags & (FL_ENDBLOCK | FL_USE_FPU)) &&
+                            !HLE::GetFirstFunctionIndex(ops[i + 1].address);
+      if (can_fuse && EmitFusedOps(ops[i], ops[i + 1]))
+      {
+        i++;
+        js.downcountAmount += ops[i].opinfo->numCycles;
+        continue;
+      }
+
       if (endblock || memcheck)
         m_code.emplace_back(WritePC, ops[i].address);
-      m_code.emplace_back(PPCTables::GetInterpreterOp(ops[i].inst), ops[i].inst);
+      if (check_fpu || endblock || memcheck || !EmitDecodedOp(ops[i]))
+        m_code.emplace_back(PPCTables::GetInterpreterOp(ops[i].inst), ops[i].inst);
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (endblock)
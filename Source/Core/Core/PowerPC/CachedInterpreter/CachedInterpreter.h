@@ -37,6 +37,11 @@ private:
   const u8* GetCodePtr() const;
   void ExecuteOneBlock();
 
+  // Emit simple integer instructions with their operands decoded up front, fusing common
+  // pairs into a single superinstruction. Return false if the op needs the interpreter.
+  bool EmitFusedOps(const PPCAnalyst::CodeOp& first, const PPCAnalyst::CodeOp& second);
+  bool EmitDecodedOp(const PPCAnalyst::CodeOp& op);
+
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
   PPCAnalyst::CodeBuffer code_buffer;
@@ -17,6 +17,9 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Runs instructions up to and including the next one that ends a block, without any timing
+  // or exception handling on top of SingleStepInner(). Returns the number of cycles taken.
+  int RunBlock();
 
   void Run() override;
   void ClearCache() override;
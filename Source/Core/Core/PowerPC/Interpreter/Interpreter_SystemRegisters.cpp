@@ -164,7 +164,11 @@ static void SetSR(int index, u32 value)
 {
   DEBUG_LOG(POWERPC, "%08x: MMU: Segment register %i set to %08x", PowerPC::ppcState.pc, index,
             value);
+  // Context switches tend to load the same segments again.
+  if (PowerPC::ppcState.sr[index] == value)
+    return;
   PowerPC::ppcState.sr[index] = value;
+  PowerPC::SegmentRegisterUpdated(index);
 }
 
 void Interpreter::mtsr(UGeckoInstruction inst)
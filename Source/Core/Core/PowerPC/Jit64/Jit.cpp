@@ -4,8 +4,11 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <string>
+#include <vector>
 
 // for the PROFILER stuff
 #ifdef _WIN32
@@ -18,6 +21,7 @@
 #include "Common/MemoryUtil.h"
 #include "Common/PerformanceCounter.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 #include "Common/x64ABI.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -26,6 +30,7 @@
 #include "Core/HW/GPFifo.h"
 #include "Core/HW/ProcessorInterface.h"
 #include "Core/PatchEngine.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/Jit64/JitAsm.h"
 #include "Core/PowerPC/Jit64/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/FarCodeCache.h"
@@ -180,6 +185,8 @@ bool Jit64::HandleStackFault()
 
   WARN_LOG(POWERPC, "BLR cache disabled due to excessive BL in the emulated program.");
   m_enable_blr_optimization = false;
+  // The shadow stack can't overflow, so it can take over once the cache has been cleared.
+  m_enable_shadow_blr_stack = SConfig::GetInstance().bJITBLRShadowStack;
 #ifndef _WIN32
   // Windows does this automatically.
   Common::UnWriteProtectMemory(m_stack + GUARD_OFFSET, GUARD_SIZE);
@@ -205,12 +212,17 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
   if (m_enable_blr_optimization && diff >= GUARD_OFFSET && diff < GUARD_OFFSET + GUARD_SIZE)
     return HandleStackFault();
 
+  // Backpatching emits code and reads the per-block fault info the compile thread writes.
+  if (Core::IsCPUThread())
+    SyncBackgroundCompile();
+
   return Jitx86Base::HandleFault(access_address, ctx);
 }
 
 void Jit64::Init()
 {
   InitializeInstructionTables();
+  m_compile_msr = &m_compile_state.msr;
   EnableBlockLink();
 
   jo.optimizeGatherPipe = true;
@@ -221,6 +233,7 @@ void Jit64::Init()
 
   gpr.SetEmitter(this);
   fpr.SetEmitter(this);
+  analyzer.SetHotBranches(&js.hotBranchAddresses);
 
   const size_t routines_size = asm_routines.CODE_SIZE;
   const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
@@ -229,7 +242,22 @@ void Jit64::Init()
   AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
-  AddChildCodeSpace(&m_far_code, farcode_size);
+
+  // The tenured generation takes a quarter of the existing near and far code spaces. Without
+  // a block cache there is nothing that could survive.
+  m_enable_generational_cache = SConfig::GetInstance().bJITGenerationalCache &&
+                                !SConfig::GetInstance().bJITNoBlockCache;
+  m_block_survivals.clear();
+  if (m_enable_generational_cache)
+  {
+    AddChildCodeSpace(&m_tenured_code, CODE_SIZE / 4);
+    AddChildCodeSpace(&m_tenured_far_code, farcode_size / 4);
+    AddChildCodeSpace(&m_far_code, farcode_size - farcode_size / 4);
+  }
+  else
+  {
+    AddChildCodeSpace(&m_far_code, farcode_size);
+  }
   m_const_pool.Init(AllocChildCodeSpace(constpool_size), constpool_size);
 
   // BLR optimization has the same consequences as block linking, as well as
@@ -238,6 +266,18 @@ void Jit64::Init()
                               !SConfig::GetInstance().bEnableDebugging;
   m_cleanup_after_stackfault = false;
 
+  // Without the host stack, fall back to the shadow stack if the user opted in. Like the BLR
+  // optimization, it bypasses the dispatcher's breakpoint checks.
+  m_enable_shadow_blr_stack = !m_enable_blr_optimization && jo.enableBlocklink &&
+                              SConfig::GetInstance().bJITBLRShadowStack &&
+                              !SConfig::GetInstance().bEnableDebugging;
+  ResetShadowBLRStack();
+
+  // Carrying registers across block boundaries only pays off with linked blocks.
+  m_enable_register_carry_over = jo.enableBlocklink &&
+                                 SConfig::GetInstance().bJITRegisterCarryOver &&
+                                 !SConfig::GetInstance().bEnableDebugging;
+
   m_stack = nullptr;
   if (m_enable_blr_optimization)
     AllocStack();
@@ -251,6 +291,20 @@ void Jit64::Init()
   m_far_code.Init();
   Clear();
 
+  // The game's code isn't in memory yet, so the cache is opened when the first block is compiled.
+  m_disk_cache_pending =
+      SConfig::GetInstance().bJITPersistentCache && !SConfig::GetInstance().bEnableDebugging;
+
+  // Without a block cache, every block would be thrown away right after being compiled.
+  m_enable_background_compile = SConfig::GetInstance().bJITBackgroundCompile &&
+                                !SConfig::GetInstance().bEnableDebugging &&
+                                !SConfig::GetInstance().bJITNoBlockCache;
+  if (m_enable_background_compile)
+  {
+    m_background_state = BackgroundState::Idle;
+    m_background_thread = std::thread(&Jit64::BackgroundCompileThread, this);
+  }
+
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
   code_block.m_fpa = &js.fpa;
@@ -259,17 +313,108 @@ void Jit64::Init()
 
 void Jit64::ClearCache()
 {
+  SyncBackgroundCompile();
+  {
+    // A finished block lives in the code space which is about to be cleared.
+    std::lock_guard<std::mutex> lock(m_background_mutex);
+    if (m_background_state == BackgroundState::Done)
+      m_background_state = BackgroundState::Idle;
+  }
+
   blocks.Clear();
   trampolines.ClearCodeSpace();
   m_far_code.ClearCodeSpace();
   m_const_pool.Clear();
   ClearCodeSpace();
+  if (m_enable_generational_cache)
+  {
+    m_tenured_code.ClearCodeSpace();
+    m_tenured_far_code.ClearCodeSpace();
+    m_block_survivals.clear();
+  }
   Clear();
   UpdateMemoryOptions();
+  // The shadow stack points into the code space that was just cleared.
+  ResetShadowBLRStack();
+}
+
+void Jit64::EvictYoungGeneration()
+{
+  SyncBackgroundCompile();
+  {
+    // A finished block lives in the young code space.
+    std::lock_guard<std::mutex> lock(m_background_mutex);
+    if (m_background_state == BackgroundState::Done)
+      m_background_state = BackgroundState::Idle;
+  }
+
+  blocks.RunOnBlocks([this](const JitBlock& block) {
+    if (IsInSpace(block.checkedEntry))
+      m_block_survivals[block.effectiveAddress]++;
+  });
+  blocks.EraseBlocks([this](const JitBlock& block) { return IsInSpace(block.checkedEntry); });
+
+  for (auto iter = m_back_patch_info.begin(); iter != m_back_patch_info.end();)
+  {
+    if (IsInSpace(iter->first))
+      iter = m_back_patch_info.erase(iter);
+    else
+      iter++;
+  }
+  for (auto iter = m_exception_handler_at_loc.begin(); iter != m_exception_handler_at_loc.end();)
+  {
+    if (IsInSpace(iter->first))
+      iter = m_exception_handler_at_loc.erase(iter);
+    else
+      iter++;
+  }
+
+  m_far_code.ClearCodeSpace();
+  ClearCodeSpace();
+  // Entries may point into the young code space. The host stack used by the BLR optimization
+  // is reset by the dispatcher before every compile, so it can't.
+  ResetShadowBLRStack();
+}
+
+bool Jit64::IsInCodeSpace(const u8* ptr) const
+{
+  return IsInSpace(ptr) || m_tenured_code.IsInSpace(ptr);
+}
+
+void Jit64::SwitchToTenuredCode()
+{
+  m_young_code_ptr = GetWritableCodePtr();
+  m_young_far_code_ptr = m_far_code.GetWritableCodePtr();
+  SetCodePtr(m_tenured_code.GetWritableCodePtr());
+  m_far_code.SetCodePtr(m_tenured_far_code.GetWritableCodePtr());
+}
+
+void Jit64::SwitchToYoungCode()
+{
+  m_tenured_code.SetCodePtr(GetWritableCodePtr());
+  m_tenured_far_code.SetCodePtr(m_far_code.GetWritableCodePtr());
+  SetCodePtr(m_young_code_ptr);
+  m_far_code.SetCodePtr(m_young_far_code_ptr);
+}
+
+void Jit64::ResetShadowBLRStack()
+{
+  m_shadow_blr_stack.top = 0;
+  for (ShadowBLRStack::Entry& entry : m_shadow_blr_stack.entries)
+  {
+    // No block exit can ever return to an unaligned address.
+    entry.pc = 0xFFFFFFFF;
+    entry.code = nullptr;
+  }
 }
 
 void Jit64::Shutdown()
 {
+  StopBackgroundCompileThread();
+
+  m_disk_cache.Close();
+  m_disk_cache_pending = false;
+
   FreeStack();
   FreeCodeSpace();
 
@@ -398,6 +543,15 @@ bool Jit64::Cleanup()
 
 void Jit64::FakeBLCall(u32 after)
 {
+  if (m_enable_shadow_blr_stack)
+  {
+    u8* continuation_ptr = WriteShadowBLRPush(after);
+    FixupBranch skip_exit = J();
+    WriteShadowBLRContinuation(continuation_ptr, after);
+    SetJumpTarget(skip_exit);
+    return;
+  }
+
   if (!m_enable_blr_optimization)
     return;
 
@@ -413,12 +567,27 @@ void Jit64::FakeBLCall(u32 after)
 
 void Jit64::WriteExit(u32 destination, bool bl, u32 after)
 {
-  if (!m_enable_blr_optimization)
+  if (!m_enable_blr_optimization && !m_enable_shadow_blr_stack)
     bl = false;
 
-  Cleanup();
+  // Cleanup() may call out to C++ code, which clobbers the registers left over by the flush.
+  JitBlock::RegisterBindings bindings;
+  if (!Cleanup() && m_enable_register_carry_over)
+  {
+    bindings.gpr = gpr.GetFlushedBindings();
+    bindings.fpr = fpr.GetFlushedBindings();
+    // The exit sequence itself may use RSCRATCH_EXTRA.
+    std::replace(bindings.gpr.begin(), bindings.gpr.end(), static_cast<s8>(RSCRATCH_EXTRA),
+                 static_cast<s8>(-1));
+  }
 
-  if (bl)
+  u8* continuation_ptr = nullptr;
+  if (bl && m_enable_shadow_blr_stack)
+  {
+    continuation_ptr = WriteShadowBLRPush(after);
+    bl = false;
+  }
+  else if (bl)
   {
     MOV(32, R(RSCRATCH2), Imm32(after));
     PUSH(RSCRATCH2);
@@ -426,16 +595,48 @@ void Jit64::WriteExit(u32 destination, bool bl, u32 after)
 
   SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
 
-  JustWriteExit(destination, bl, after);
+  JustWriteExit(destination, bl, after, bindings);
+
+  if (continuation_ptr)
+    WriteShadowBLRContinuation(continuation_ptr, after);
+}
+
+void Jit64::WriteBranchProfile(bool taken)
+{
+  u32* bias =
+      &js.curBlock->branch_bias.emplace(js.compilerPC, BRANCH_PROFILE_THRESHOLD).first->second;
+  MOV(64, R(RSCRATCH), ImmPtr(bias));
+  if (!taken)
+  {
+    ADD(32, MatR(RSCRATCH), Imm8(1));
+    return;
+  }
+
+  SUB(32, MatR(RSCRATCH), Imm8(1));
+  FixupBranch hot = J_CC(CC_Z, true);
+
+  SwitchToFarCode();
+  SetJumpTarget(hot);
+  BitSet32 registersInUse = CallerSavedRegistersInUse();
+  MOV(32, PPCSTATE(pc), Imm32(js.compilerPC));
+  ABI_PushRegistersAndAdjustStack(registersInUse, 0);
+  ABI_CallFunctionC(JitInterface::CompileExceptionCheck,
+                    static_cast<u32>(JitInterface::ExceptionType::HotBranch));
+  ABI_PopRegistersAndAdjustStack(registersInUse, 0);
+  FixupBranch back = J(true);
+  SwitchToNearCode();
+  SetJumpTarget(back);
 }
 
-void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
+void Jit64::JustWriteExit(u32 destination, bool bl, u32 after,
+                          const JitBlock::RegisterBindings& bindings)
 {
   // If nobody has taken care of this yet (this can be removed when all branches are done)
   JitBlock* b = js.curBlock;
   JitBlock::LinkData linkData;
   linkData.exitAddress = destination;
   linkData.linkStatus = false;
+  linkData.exitBindings = bindings;
 
   MOV(32, PPCSTATE(pc), Imm32(destination));
   linkData.exitPtrs = GetWritableCodePtr();
@@ -455,11 +656,21 @@ void Jit64::JustWriteExit(u32 destination, bool bl, u32 after)
 
 void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
 {
-  if (!m_enable_blr_optimization)
+  if (!m_enable_blr_optimization && !m_enable_shadow_blr_stack)
     bl = false;
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
   Cleanup();
 
+  if (bl && m_enable_shadow_blr_stack)
+  {
+    // The dispatcher reloads the destination from PPCSTATE(pc), so RSCRATCH is free here.
+    u8* continuation_ptr = WriteShadowBLRPush(after);
+    SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+    JMP(asm_routines.dispatcher, true);
+    WriteShadowBLRContinuation(continuation_ptr, after);
+    return;
+  }
+
   if (bl)
   {
     MOV(32, R(RSCRATCH2), Imm32(after));
@@ -481,6 +692,35 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
 
 void Jit64::WriteBLRExit()
 {
+  if (m_enable_shadow_blr_stack)
+  {
+    MOV(32, PPCSTATE(pc), R(RSCRATCH));
+    if (Cleanup())
+      MOV(32, R(RSCRATCH), PPCSTATE(pc));
+
+    constexpr s32 entries = static_cast<s32>(offsetof(ShadowBLRStack, entries));
+    MOV(64, R(RSCRATCH2), ImmPtr(&m_shadow_blr_stack));
+    MOVZX(32, 16, RSCRATCH_EXTRA, MDisp(RSCRATCH2, offsetof(ShadowBLRStack, top)));
+    ADD(64, R(RSCRATCH_EXTRA), R(RSCRATCH2));
+    CMP(32, R(RSCRATCH),
+        MDisp(RSCRATCH_EXTRA, entries + offsetof(ShadowBLRStack::Entry, pc)));
+    FixupBranch mispredicted = J_CC(CC_NE);
+
+    // Predicted correctly: pop the entry and jump to the code exiting to the return address.
+    MOV(64, R(RSCRATCH), MDisp(RSCRATCH_EXTRA, entries + offsetof(ShadowBLRStack::Entry, code)));
+    SUB(16, MDisp(RSCRATCH2, offsetof(ShadowBLRStack, top)), Imm8(sizeof(ShadowBLRStack::Entry)));
+    SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+    JMPptr(R(RSCRATCH));
+
+    // The emulated program didn't return where we expected it to, e.g. because of an exception
+    // or a longjmp. The entries below the top are likely just as wrong, so start over.
+    SetJumpTarget(mispredicted);
+    MOV(16, MDisp(RSCRATCH2, offsetof(ShadowBLRStack, top)), Imm16(0));
+    SUB(32, PPCSTATE(downcount), Imm32(js.downcountAmount));
+    JMP(asm_routines.dispatcher, true);
+    return;
+  }
+
   if (!m_enable_blr_optimization)
   {
     WriteExitDestInRSCRATCH();
@@ -497,6 +737,34 @@ void Jit64::WriteBLRExit()
   RET();
 }
 
+u8* Jit64::WriteShadowBLRPush(u32 after)
+{
+  // This may be emitted in the middle of a block (see FakeBLCall), so it must not touch the flags
+  // or any register besides RSCRATCH and RSCRATCH2.
+  constexpr s32 entries = static_cast<s32>(offsetof(ShadowBLRStack, entries));
+  MOV(64, R(RSCRATCH2), ImmPtr(&m_shadow_blr_stack));
+  MOVZX(32, 16, RSCRATCH, MDisp(RSCRATCH2, offsetof(ShadowBLRStack, top)));
+  LEA(32, RSCRATCH, MDisp(RSCRATCH, sizeof(ShadowBLRStack::Entry)));
+  MOV(16, MDisp(RSCRATCH2, offsetof(ShadowBLRStack, top)), R(RSCRATCH));
+  MOVZX(32, 16, RSCRATCH, R(RSCRATCH));
+  LEA(64, RSCRATCH2, MRegSum(RSCRATCH2, RSCRATCH));
+  MOV(32, MDisp(RSCRATCH2, entries + offsetof(ShadowBLRStack::Entry, pc)), Imm32(after));
+  // The continuation doesn't exist yet; WriteShadowBLRContinuation fills in the immediate.
+  MOV(64, R(RSCRATCH), Imm64(0));
+  u8* continuation_ptr = GetWritableCodePtr() - sizeof(u64);
+  MOV(64, MDisp(RSCRATCH2, entries + offsetof(ShadowBLRStack::Entry, code)), R(RSCRATCH));
+  return continuation_ptr;
+}
+
+void Jit64::WriteShadowBLRContinuation(u8* continuation_ptr, u32 after)
+{
+  // A predicted blr jumps here with the flags of its downcount subtraction, just like a linked
+  // exit, so this can simply be a linkable exit to the return address.
+  const u8* continuation = GetCodePtr();
+  std::memcpy(continuation_ptr, &continuation, sizeof(continuation));
+  JustWriteExit(after, false, 0);
+}
+
 void Jit64::WriteRfiExitDestInRSCRATCH()
 {
   MOV(32, PPCSTATE(pc), R(RSCRATCH));
@@ -571,6 +839,22 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
+  const bool background = m_enable_background_compile && !Profiler::g_ProfileBlocks;
+  if (m_enable_background_compile)
+  {
+    if (background && IsCompilingInBackground())
+    {
+      // Only one block is compiled at a time. Run this one with the interpreter, it'll be
+      // compiled once it comes up again.
+      PowerPC::ppcState.downcount -= Interpreter::getInstance()->RunBlock();
+      return;
+    }
+
+    FinishBackgroundCompile();
+    if (blocks.GetBlockFromStartAddress(em_address, MSR & JitBaseBlockCache::JIT_CACHE_MSR_MASK))
+      return;
+  }
+
   if (m_cleanup_after_stackfault)
   {
     ClearCache();
@@ -581,11 +865,27 @@ void Jit64::Jit(u32 em_address)
 #endif
   }
 
-  if (IsAlmostFull() || m_far_code.IsAlmostFull() || trampolines.IsAlmostFull() ||
-      SConfig::GetInstance().bJITNoBlockCache)
+  // Trampolines aren't tied to any one generation, so running out of them needs a full clear.
+  const bool tenured_full = m_enable_generational_cache &&
+                            (m_tenured_code.IsAlmostFull() || m_tenured_far_code.IsAlmostFull());
+  if (tenured_full || trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
   {
     ClearCache();
   }
+  else if (IsAlmostFull() || m_far_code.IsAlmostFull())
+  {
+    if (m_enable_generational_cache)
+      EvictYoungGeneration();
+    else
+      ClearCache();
+  }
+
+  if (m_disk_cache_pending)
+  {
+    m_disk_cache_pending = false;
+    m_disk_cache.Open("jit64", SConfig::GetInstance().GetGameID());
+    PrecompileCachedBlocks();
+  }
 
   int blockSize = code_buffer.GetSize();
 
@@ -609,6 +909,7 @@ void Jit64::Jit(u32 em_address)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_FORMATION);
       }
       Trace();
     }
@@ -629,9 +930,212 @@ void Jit64::Jit(u32 em_address)
     return;
   }
 
+  if (background)
+  {
+    StartBackgroundCompile(em_address, nextPC);
+    PowerPC::ppcState.downcount -= Interpreter::getInstance()->RunBlock();
+    return;
+  }
+
+  // Blocks which keep coming back after being evicted go into the tenured spaces.
+  const auto survivals = m_block_survivals.find(em_address);
+  const bool tenure = survivals != m_block_survivals.end() && survivals->second >= TENURE_EPOCHS;
+
   JitBlock* b = blocks.AllocateBlock(em_address);
+  if (m_enable_register_carry_over && !Profiler::g_ProfileBlocks && !ImHereDebug)
+    ComputeEntryBindings(b);
+  if (tenure)
+    SwitchToTenuredCode();
+  CopyCompileState();
   DoJit(em_address, &code_buffer, b, nextPC);
+  if (tenure)
+    SwitchToYoungCode();
   blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+  m_disk_cache.RecordBlock(*b);
+}
+
+void Jit64::ComputeEntryBindings(JitBlock* b)
+{
+  const JitBlock::RegisterBindings* incoming =
+      blocks.GetIncomingRegisterBindings(b->effectiveAddress, b->msrBits);
+  if (!incoming)
+    return;
+
+  // Only carry over what the block actually reads before writing it.
+  for (size_t i = 0; i < 32; i++)
+  {
+    if (code_block.m_gpr_inputs[i])
+      b->entryBindings.gpr[i] = incoming->gpr[i];
+    if (code_block.m_fpr_inputs[i])
+      b->entryBindings.fpr[i] = incoming->fpr[i];
+  }
+}
+
+void Jit64::CopyCompileState()
+{
+  m_compile_state.msr = MSR;
+  std::copy(std::begin(PowerPC::ppcState.gpr), std::end(PowerPC::ppcState.gpr),
+            m_compile_state.gpr.begin());
+  for (size_t i = 0; i < m_compile_state.gqr.size(); i++)
+    m_compile_state.gqr[i] = GQR(i);
+}
+
+void Jit64::BackgroundCompileThread()
+{
+  Common::SetCurrentThreadName("JIT64 compiler");
+
+  std::unique_lock<std::mutex> lock(m_background_mutex);
+  while (true)
+  {
+    m_background_cv.wait(lock, [this] {
+      return m_background_state == BackgroundState::Compiling ||
+             m_background_state == BackgroundState::Quit;
+    });
+    if (m_background_state == BackgroundState::Quit)
+      return;
+
+    lock.unlock();
+    DoJit(m_background_block.effectiveAddress, &code_buffer, &m_background_block,
+          m_background_next_pc);
+    lock.lock();
+
+    m_background_state = BackgroundState::Done;
+    m_background_cv.notify_all();
+  }
+}
+
+void Jit64::StopBackgroundCompileThread()
+{
+  if (!m_background_thread.joinable())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_background_mutex);
+    m_background_cv.wait(lock,
+                         [this] { return m_background_state != BackgroundState::Compiling; });
+    m_background_state = BackgroundState::Quit;
+  }
+  m_background_cv.notify_all();
+  m_background_thread.join();
+  m_background_state = BackgroundState::Idle;
+}
+
+void Jit64::SyncBackgroundCompile()
+{
+  if (!m_enable_background_compile)
+    return;
+
+  std::unique_lock<std::mutex> lock(m_background_mutex);
+  m_background_cv.wait(lock, [this] { return m_background_state != BackgroundState::Compiling; });
+}
+
+bool Jit64::IsCompilingInBackground()
+{
+  std::lock_guard<std::mutex> lock(m_background_mutex);
+  return m_background_state == BackgroundState::Compiling;
+}
+
+void Jit64::StartBackgroundCompile(u32 em_address, u32 next_pc)
+{
+  // Set up the block the same way AllocateBlock would, without making it visible yet.
+  m_background_block = JitBlock();
+  m_background_block.effectiveAddress = em_address;
+  m_background_block.physicalAddress = PowerPC::JitCache_TranslateAddress(em_address).address;
+  m_background_block.msrBits = MSR & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  if (m_enable_register_carry_over && !ImHereDebug)
+    ComputeEntryBindings(&m_background_block);
+
+  m_background_next_pc = next_pc;
+  CopyCompileState();
+  m_background_physical_addresses = code_block.m_physical_addresses;
+  m_background_instructions.clear();
+  for (u32 i = 0; i < code_block.m_num_instructions; i++)
+  {
+    const PPCAnalyst::CodeOp& op = code_buffer.codebuffer[i];
+    m_background_instructions.emplace_back(op.address, op.inst.hex);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_background_mutex);
+    m_background_state = BackgroundState::Compiling;
+  }
+  m_background_cv.notify_all();
+}
+
+void Jit64::PublishBackgroundBlock()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_background_mutex);
+    m_background_state = BackgroundState::Idle;
+  }
+
+  // The block was analyzed a while ago, so throw it away if the code or the address
+  // translation has changed since.
+  const u32 em_address = m_background_block.effectiveAddress;
+  const u32 msr_bits = MSR & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  if (m_background_block.msrBits != msr_bits ||
+      blocks.GetBlockFromStartAddress(em_address, msr_bits))
+  {
+    return;
+  }
+
+  auto translated = PowerPC::JitCache_TranslateAddress(em_address);
+  if (!translated.valid || translated.address != m_background_block.physicalAddress)
+    return;
+
+  for (const auto& instruction : m_background_instructions)
+  {
+    auto result = PowerPC::TryReadInstruction(instruction.first);
+    if (!result.valid || result.hex != instruction.second)
+      return;
+  }
+
+  JitBlock* b = blocks.AllocateBlock(em_address);
+  *b = std::move(m_background_block);
+  blocks.FinalizeBlock(*b, jo.enableBlocklink, m_background_physical_addresses);
+  m_disk_cache.RecordBlock(*b);
+}
+
+void Jit64::FinishBackgroundCompile()
+{
+  SyncBackgroundCompile();
+
+  bool done;
+  {
+    std::lock_guard<std::mutex> lock(m_background_mutex);
+    done = m_background_state == BackgroundState::Done;
+  }
+  if (done)
+    PublishBackgroundBlock();
+}
+
+void Jit64::PrecompileCachedBlocks()
+{
+  const u32 msr_bits = MSR & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  const std::vector<u32> addresses = m_disk_cache.GetValidBlocks(msr_bits);
+
+  u32 compiled = 0;
+  for (u32 address : addresses)
+  {
+    // Unlike a cache clear during gameplay, running out of space here isn't worth it.
+    if (IsAlmostFull() || m_far_code.IsAlmostFull() || trampolines.IsAlmostFull())
+      break;
+
+    if (blocks.GetBlockFromStartAddress(address, msr_bits))
+      continue;
+
+    u32 nextPC = analyzer.Analyze(address, &code_block, &code_buffer, code_buffer.GetSize());
+    if (code_block.m_memory_exception)
+      continue;
+
+    JitBlock* b = blocks.AllocateBlock(address);
+    CopyCompileState();
+    DoJit(address, &code_buffer, b, nextPC);
+    blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+    ++compiled;
+  }
+
+  NOTICE_LOG(DYNA_REC, "Precompiled %u of %zu cached JIT blocks", compiled, addresses.size());
 }
 
 const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBlock* b, u32 nextPC)
@@ -639,6 +1143,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
   js.firstFPInstructionFound = false;
   js.isLastInstruction = false;
   js.blockStart = em_address;
+  js.isIdleLoop = code_block.m_idle_loop && SConfig::GetInstance().bJITIdleLoopDetection;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
   js.curBlock = b;
@@ -661,6 +1166,20 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
   const u8* normalEntry = GetCodePtr();
   b->normalEntry = normalEntry;
 
+  // Linked predecessors whose exit leaves the entry bindings in host registers jump here
+  // instead, skipping the loads below.
+  FixupBranch bound_skip;
+  const bool has_entry_bindings = !b->entryBindings.IsEmpty();
+  if (has_entry_bindings)
+  {
+    SwitchToFarCode();
+    b->boundCheckedEntry = GetCodePtr();
+    bound_skip = J_CC(CC_G, true);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    JMP(asm_routines.doTiming, true);
+    SwitchToNearCode();
+  }
+
   // Used to get a trace of the last few blocks before a crash, sometimes VERY useful
   if (ImHereDebug)
   {
@@ -689,6 +1208,13 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
   gpr.Start();
   fpr.Start();
 
+  if (has_entry_bindings)
+  {
+    gpr.Preload(b->entryBindings.gpr);
+    fpr.Preload(b->entryBindings.fpr);
+    SetJumpTarget(bound_skip);
+  }
+
   js.downcountAmount = 0;
   js.skipInstructions = 0;
   js.carryFlagSet = false;
@@ -719,7 +1245,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
       // the start of the block in case our guess turns out wrong.
       for (int gqr : gqr_static)
       {
-        u32 value = GQR(gqr);
+        u32 value = m_compile_state.gqr[gqr];
         js.constantGqr[gqr] = value;
         CMP_or_TEST(32, PPCSTATE(spr[SPR_GQR0 + gqr]), Imm32(value));
         J_CC(CC_NZ, target);
@@ -760,7 +1286,8 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
         js.fifoWriteAddresses.find(ops[i].address) != js.fifoWriteAddresses.end();
 
     // Gather pipe writes using an immediate address are explicitly tracked.
-    if (jo.optimizeGatherPipe && (js.fifoBytesSinceCheck >= 32 || js.mustCheckFifo))
+    if (jo.optimizeGatherPipe &&
+        (js.fifoBytesSinceCheck >= GPFifo::GATHER_PIPE_JIT_BURST_SIZE || js.mustCheckFifo))
     {
       js.fifoBytesSinceCheck = 0;
       js.mustCheckFifo = false;
@@ -1000,6 +1527,8 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  if (SConfig::GetInstance().bJITTraceFormation)
+    analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_FORMATION);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -1013,7 +1542,7 @@ void Jit64::IntializeSpeculativeConstants()
   const u8* target = nullptr;
   for (auto i : code_block.m_gpr_inputs)
   {
-    u32 compileTimeValue = PowerPC::ppcState.gpr[i];
+    u32 compileTimeValue = m_compile_state.gpr[i];
     if (PowerPC::IsOptimizableGatherPipeWrite(compileTimeValue) ||
         PowerPC::IsOptimizableGatherPipeWrite(compileTimeValue - 0x8000) ||
         compileTimeValue == 0xCC000000)
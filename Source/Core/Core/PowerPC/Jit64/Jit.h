@@ -18,6 +18,15 @@
 // ----------
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64ABI.h"
 #include "Common/x64Emitter.h"
@@ -27,6 +36,7 @@
 #include "Core/PowerPC/Jit64/JitRegCache.h"
 #include "Core/PowerPC/Jit64Common/Jit64Base.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 class Jit64 : public Jitx86Base
@@ -39,6 +49,7 @@ public:
 
   bool HandleFault(uintptr_t access_address, SContext* ctx) override;
   bool HandleStackFault() override;
+  void SyncBackgroundCompile() override;
 
   void EnableOptimization();
   void EnableBlockLink();
@@ -68,9 +79,14 @@ public:
 
   void FakeBLCall(u32 after);
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
-  void JustWriteExit(u32 destination, bool bl, u32 after);
+  // Counts which way the current conditional branch goes, for trace formation.
+  void WriteBranchProfile(bool taken);
+  void JustWriteExit(u32 destination, bool bl, u32 after,
+                     const JitBlock::RegisterBindings& bindings = {});
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
   void WriteBLRExit();
+  u8* WriteShadowBLRPush(u32 after);
+  void WriteShadowBLRContinuation(u8* continuation_ptr, u32 after);
   void WriteExceptionExit();
   void WriteExternalExceptionExit();
   void WriteRfiExitDestInRSCRATCH();
@@ -237,6 +253,24 @@ private:
   void AllocStack();
   void FreeStack();
 
+  void PrecompileCachedBlocks();
+  void ComputeEntryBindings(JitBlock* b);
+  void CopyCompileState();
+
+  void BackgroundCompileThread();
+  void StopBackgroundCompileThread();
+  bool IsCompilingInBackground();
+  void StartBackgroundCompile(u32 em_address, u32 next_pc);
+  void PublishBackgroundBlock();
+  void FinishBackgroundCompile();
+
+  void ResetShadowBLRStack();
+
+  bool IsInCodeSpace(const u8* ptr) const override;
+  void EvictYoungGeneration();
+  void SwitchToTenuredCode();
+  void SwitchToYoungCode();
+
   GPRRegCache gpr{*this};
   FPURegCache fpr{*this};
 
@@ -245,7 +279,88 @@ private:
   PPCAnalyst::CodeBuffer code_buffer;
   Jit64AsmRoutineManager asm_routines{*this};
 
+  // Blocks compiled in earlier runs of the same game; see JitDiskCache.h.
+  JitDiskCache m_disk_cache;
+  bool m_disk_cache_pending = false;
+
+  // Background compilation. The CPU thread analyzes a missing block and hands it to the
+  // compile thread, then runs the block with the interpreter in the meantime. Only one block
+  // is compiled at a time: the compile thread uses the emitters, the register caches, js and
+  // code_block, none of which the CPU thread touches until the state leaves Compiling. The
+  // finished block is published into the block cache by the CPU thread, after checking that
+  // its code hasn't changed in the meantime.
+  enum class BackgroundState
+  {
+    Idle,
+    Compiling,
+    Done,
+    Quit
+  };
+  bool m_enable_background_compile = false;
+  std::thread m_background_thread;
+  std::mutex m_background_mutex;
+  std::condition_variable m_background_cv;
+  BackgroundState m_background_state = BackgroundState::Idle;
+  u32 m_background_next_pc = 0;
+  JitBlock m_background_block;
+  std::set<u32> m_background_physical_addresses;
+  // Address and instruction of every op in the block, as analyzed.
+  std::vector<std::pair<u32, u32>> m_background_instructions;
+
+  // The guest state DoJit specializes the block for, copied on the CPU thread before each
+  // compile. The interpreter keeps changing the live state during a background compile.
+  struct CompileState
+  {
+    u32 msr;
+    std::array<u32, 32> gpr;
+    std::array<u32, 8> gqr;
+  };
+  CompileState m_compile_state{};
+
   bool m_enable_blr_optimization;
   bool m_cleanup_after_stackfault;
   u8* m_stack;
+
+  // A software return address predictor, used instead of the BLR optimization when the latter
+  // isn't available (it relies on fastmem to catch host stack overflows). bl pushes the return
+  // address along with the host code that exits to it, and blr jumps straight to that code if
+  // the top entry matches. The ring simply wraps around instead of overflowing, and a stale
+  // entry can never be wrong: its code always exits to the very address it was compared with.
+  static constexpr size_t SHADOW_BLR_STACK_SIZE = 0x10000 / 16;
+  struct ShadowBLRStack
+  {
+    struct Entry
+    {
+      u32 pc;
+      u32 padding;
+      const u8* code;
+    };
+    static_assert(sizeof(Entry) == 16, "The emitted code relies on 16 byte entries");
+
+    // Byte offset of the top entry within entries. Being 16 bits wide, it wraps around at the
+    // end of the array without any masking.
+    u16 top;
+    u8 padding[14];
+    Entry entries[SHADOW_BLR_STACK_SIZE];
+  };
+  bool m_enable_shadow_blr_stack = false;
+  bool m_enable_register_carry_over = false;
+  ShadowBLRStack m_shadow_blr_stack;
+
+  // Generational code cache. New blocks go into the young code space (the regular near and far
+  // code), and filling it up only evicts the blocks in there. A block that keeps being compiled
+  // again after such evictions is placed in the tenured spaces instead, which are only emptied
+  // by a full cache clear.
+  static constexpr u32 TENURE_EPOCHS = 2;
+  bool m_enable_generational_cache = false;
+  Gen::X64CodeBlock m_tenured_code;
+  Gen::X64CodeBlock m_tenured_far_code;
+  // Entry address -> number of young evictions a block there has been through.
+  std::map<u32, u32> m_block_survivals;
+  u8* m_young_code_ptr = nullptr;
+  u8* m_young_far_code_ptr = nullptr;
+
+  // How many more times a conditional branch has to be taken than not before the block
+  // containing it is recompiled with the branch followed.
+  static constexpr u32 BRANCH_PROFILE_THRESHOLD = 256;
 };
@@ -109,20 +109,24 @@ void Jit64AsmRoutineManager::Generate()
   const bool assembly_dispatcher = true;
   if (assembly_dispatcher)
   {
-    // Fast block number lookup.
-    // ((PC >> 2) & mask) * sizeof(JitBlock*) = (PC & (mask << 2)) * 2
+    // Block page directory lookup.
+    // page = directory[PC >> BLOCK_PAGE_SHIFT]
     MOV(32, R(RSCRATCH), PPCSTATE(pc));
-    u64 icache = reinterpret_cast<u64>(m_jit.GetBlockCache()->GetFastBlockMap());
-    AND(32, R(RSCRATCH), Imm32(JitBaseBlockCache::FAST_BLOCK_MAP_MASK << 2));
-    if (icache <= INT_MAX)
+    MOV(32, R(RSCRATCH2), R(RSCRATCH));
+    SHR(32, R(RSCRATCH2), Imm8(JitBaseBlockCache::BLOCK_PAGE_SHIFT));
+    u64 directory = reinterpret_cast<u64>(m_jit.GetBlockCache()->GetBlockPageDirectory());
+    if (directory <= INT_MAX)
     {
-      MOV(64, R(RSCRATCH), MScaled(RSCRATCH, SCALE_2, static_cast<s32>(icache)));
+      MOV(64, R(RSCRATCH2), MScaled(RSCRATCH2, SCALE_8, static_cast<s32>(directory)));
     }
     else
     {
-      MOV(64, R(RSCRATCH2), Imm64(icache));
-      MOV(64, R(RSCRATCH), MComplex(RSCRATCH2, RSCRATCH, SCALE_2, 0));
+      MOV(64, R(RSCRATCH_EXTRA), Imm64(directory));
+      MOV(64, R(RSCRATCH2), MComplex(RSCRATCH_EXTRA, RSCRATCH2, SCALE_8, 0));
     }
+    // ((PC & mask) >> 2) * sizeof(JitBlock*) = (PC & mask & ~3) * 2
+    AND(32, R(RSCRATCH), Imm32(JitBaseBlockCache::BLOCK_PAGE_MASK & ~3));
+    MOV(64, R(RSCRATCH), MComplex(RSCRATCH2, RSCRATCH, SCALE_2, 0));
 
     // Check if we found a block.
     TEST(64, R(RSCRATCH), R(RSCRATCH));
@@ -185,9 +189,14 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
+  // Instead of compiling, Jit might have run the block with the interpreter, which can use up
+  // the remaining downcount.
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  FixupBranch bail_after_jit = J_CC(CC_LE, true);
   JMP(dispatcherNoCheck, true);
 
   SetJumpTarget(bail);
+  SetJumpTarget(bail_after_jit);
   doTiming = GetCodePtr();
 
   // make sure npc contains the next pc (needed for exception checking in CoreTiming::Advance)
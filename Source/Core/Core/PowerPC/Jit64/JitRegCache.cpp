@@ -39,6 +39,7 @@ void RegCache::Start()
     m_regs[i].away = false;
     m_regs[i].locked = false;
   }
+  m_flushed_bindings.fill(-1);
 
   // todo: sort to find the most popular regs
   /*
@@ -57,6 +58,25 @@ void RegCache::Start()
   // But only preload IF written OR reads >= 3
 }
 
+void RegCache::Preload(const Bindings& bindings)
+{
+  for (size_t i = 0; i < m_regs.size(); i++)
+  {
+    if (bindings[i] < 0)
+      continue;
+
+    X64Reg xr = static_cast<X64Reg>(bindings[i]);
+    if (!m_xregs[xr].free || m_regs[i].away)
+      PanicAlert("RegCache: preloading into a register that is in use");
+    LoadRegister(i, xr);
+    m_xregs[xr].free = false;
+    m_xregs[xr].dirty = false;
+    m_xregs[xr].ppcReg = i;
+    m_regs[i].away = true;
+    m_regs[i].location = ::Gen::R(xr);
+  }
+}
+
 void RegCache::DiscardRegContentsIfCached(size_t preg)
 {
   if (IsBound(preg))
@@ -83,6 +103,9 @@ void RegCache::Flush(FlushMode mode, BitSet32 regsToFlush)
       PanicAlert("Someone forgot to unlock X64 reg %zu", i);
   }
 
+  for (size_t i = 0; i < m_regs.size(); i++)
+    m_flushed_bindings[i] = IsBound(i) ? static_cast<s8>(RX(i)) : -1;
+
   for (unsigned int i : regsToFlush)
   {
     if (m_regs[i].locked)
@@ -172,6 +195,7 @@ void RegCache::BindToRegister(size_t i, bool doLoad, bool makeDirty)
 {
   if (!m_regs[i].away || m_regs[i].location.IsImm())
   {
+    m_flushed_bindings.fill(-1);
     X64Reg xr = GetFreeXReg();
     if (m_xregs[xr].dirty)
       PanicAlert("Xreg already dirty");
@@ -275,6 +299,7 @@ bool RegCache::IsBound(size_t preg) const
 
 X64Reg RegCache::GetFreeXReg()
 {
+  m_flushed_bindings.fill(-1);
   size_t aCount;
   const X64Reg* aOrder = GetAllocationOrder(&aCount);
   for (size_t i = 0; i < aCount; i++)
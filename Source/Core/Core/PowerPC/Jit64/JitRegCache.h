@@ -38,6 +38,9 @@ public:
 
   static constexpr size_t NUM_XREGS = 16;
 
+  // Host register of each guest register, or -1 if it isn't bound.
+  using Bindings = std::array<s8, 32>;
+
   explicit RegCache(Jit64& jit);
   virtual ~RegCache() = default;
 
@@ -46,12 +49,19 @@ public:
   virtual Gen::OpArg GetDefaultLocation(size_t reg) const = 0;
 
   void Start();
+  // Binds the given registers as clean, emitting loads from their default locations.
+  void Preload(const Bindings& bindings);
 
   void DiscardRegContentsIfCached(size_t preg);
   void SetEmitter(Gen::XEmitter* emitter);
 
   void Flush(FlushMode mode = FlushMode::All, BitSet32 regsToFlush = BitSet32::AllTrue(32));
 
+  // The registers which were bound right before the last Flush(). These still hold their
+  // (now written back) values in the emitted code, unless any register has been allocated or
+  // locked since. In that case, or if nothing was bound, all entries are -1.
+  const Bindings& GetFlushedBindings() const { return m_flushed_bindings; }
+
   void FlushR(Gen::X64Reg reg);
   void FlushR(Gen::X64Reg reg, Gen::X64Reg reg2);
 
@@ -88,6 +98,7 @@ public:
   template <typename T>
   void LockX(T x)
   {
+    m_flushed_bindings.fill(-1);
     if (m_xregs[x].locked)
       PanicAlert("RegCache: x %i already locked!", x);
     m_xregs[x].locked = true;
@@ -133,5 +144,6 @@ protected:
   Jit64& m_jit;
   std::array<PPCCachedReg, 32> m_regs;
   std::array<X64CachedReg, NUM_XREGS> m_xregs;
+  Bindings m_flushed_bindings;
   Gen::XEmitter* m_emitter = nullptr;
 };
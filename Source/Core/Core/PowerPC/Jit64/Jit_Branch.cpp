@@ -154,21 +154,59 @@ void Jit64::bcx(UGeckoInstruction inst)
     return;
   }
 
+  if (js.op->followBranch)
+  {
+    // The analyzer continued the block at the branch target, so the fallthrough path is the
+    // side exit.
+    SwitchToFarCode();
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+    gpr.Flush(RegCache::FlushMode::MaintainState);
+    fpr.Flush(RegCache::FlushMode::MaintainState);
+    WriteExit(js.compilerPC + 4);
+    SwitchToNearCode();
+    return;
+  }
+
   u32 destination;
   if (inst.AA)
     destination = SignExt16(inst.BD << 2);
   else
     destination = js.compilerPC + SignExt16(inst.BD << 2);
 
+  // Profile conditional branches that the analyzer could follow if they turn out to be hot.
+  const bool profile_branch =
+      analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_TRACE_FORMATION) && !inst.LK &&
+      destination != js.blockStart;
+
   gpr.Flush(RegCache::FlushMode::MaintainState);
   fpr.Flush(RegCache::FlushMode::MaintainState);
-  WriteExit(destination, inst.LK, js.compilerPC + 4);
+  if (profile_branch)
+    WriteBranchProfile(true);
+  if (js.isIdleLoop && js.isLastInstruction && destination == js.blockStart)
+  {
+    // Another iteration would read the same values again, so wait for the next event.
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunction(CoreTiming::Idle);
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    MOV(32, PPCSTATE(pc), Imm32(destination));
+    WriteExceptionExit();
+  }
+  else
+  {
+    WriteExit(destination, inst.LK, js.compilerPC + 4);
+  }
 
   if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
     SetJumpTarget(pConditionDontBranch);
   if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
     SetJumpTarget(pCTRDontBranch);
 
+  if (profile_branch)
+    WriteBranchProfile(false);
+
   if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
   {
     gpr.Flush();
@@ -640,7 +640,16 @@ void Jit64::frspx(UGeckoInstruction inst)
   fpr.Lock(b, d);
   OpArg src = fpr.R(b);
   fpr.BindToRegister(d, false);
-  ForceSinglePrecision(fpr.RX(d), src, packed, true);
+  if (js.op->fprIsSingle[b] && js.op->fprIsStoreSafe[b])
+  {
+    // The result of a single-precision instruction can't change by rounding it again. Such a
+    // result also can't be a signalling NaN, which the conversion would have quieted.
+    MOVDDUP(fpr.RX(d), src);
+  }
+  else
+  {
+    ForceSinglePrecision(fpr.RX(d), src, packed, true);
+  }
   SetFPRFIfNeeded(fpr.RX(d));
   fpr.UnlockAll();
 }
@@ -7,6 +7,7 @@
 
 #include "Core/PowerPC/Jit64/Jit.h"
 
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "Core/PowerPC/Jit64/JitRegCache.h"
@@ -24,7 +25,7 @@ void Jit64::psq_stXX(UGeckoInstruction inst)
   JITDISABLE(bJITLoadStorePairedOff);
 
   // For performance, the AsmCommon routines assume address translation is on.
-  FALLBACK_IF(!UReg_MSR(MSR).DR);
+  FALLBACK_IF(!IsDataTranslationOn());
 
   s32 offset = inst.SIMM_12;
   bool indexed = inst.OPCD == 4;
@@ -114,7 +115,7 @@ void Jit64::psq_lXX(UGeckoInstruction inst)
   JITDISABLE(bJITLoadStorePairedOff);
 
   // For performance, the AsmCommon routines assume address translation is on.
-  FALLBACK_IF(!UReg_MSR(MSR).DR);
+  FALLBACK_IF(!IsDataTranslationOn());
 
   s32 offset = inst.SIMM_12;
   bool indexed = inst.OPCD == 4;
@@ -130,6 +131,41 @@ void Jit64::psq_lXX(UGeckoInstruction inst)
   bool gqrIsConstant = it != js.constantGqr.end();
   u32 gqrValue = gqrIsConstant ? it->second >> 16 : 0;
 
+  if (gqrIsConstant && (gqrValue & 0x7) == QUANTIZE_FLOAT && !w && inst.OPCD == 56 &&
+      !jo.memcheck && cpu_info.bSSSE3 && CanMergeNextInstructions(1))
+  {
+    // Loading a matrix row (or any other pair of consecutive float pairs) takes two psq_l with
+    // the same base register. Load both pairs at once instead.
+    const UGeckoInstruction next = js.op[1].inst;
+    auto next_it = js.constantGqr.find(next.I);
+    if (next.OPCD == 56 && next.RA == a && next.SIMM_12 == offset + 8 && !next.W &&
+        next_it != js.constantGqr.end() && ((next_it->second >> 16) & 0x7) == QUANTIZE_FLOAT)
+    {
+      js.skipInstructions = 1;
+      js.downcountAmount += js.op[1].opinfo->numCycles;
+      int s2 = next.FS;
+
+      gpr.Lock(a);
+      gpr.FlushLockX(RSCRATCH_EXTRA);
+      fpr.Lock(s, s2);
+      fpr.BindToRegister(s, false, true);
+      fpr.BindToRegister(s2, false, true);
+
+      // Like the unfused load, this assumes the pairs are in RAM.
+      MOV_sum(32, RSCRATCH_EXTRA, gpr.R(a), Imm32((u32)offset));
+      MOVUPS(XMM0, MRegSum(RMEM, RSCRATCH_EXTRA));
+      PSHUFB(XMM0, MConst(pbswapShuffle4x4));
+      CVTPS2PD(fpr.RX(s), R(XMM0));
+      MOVHLPS(XMM0, XMM0);
+      CVTPS2PD(fpr.RX(s2), R(XMM0));
+
+      fpr.UnlockAll();
+      gpr.UnlockAll();
+      gpr.UnlockAllX();
+      return;
+    }
+  }
+
   gpr.Lock(a, b);
 
   gpr.FlushLockX(RSCRATCH_EXTRA);
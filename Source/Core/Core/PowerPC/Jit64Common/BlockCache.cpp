@@ -15,7 +15,11 @@ JitBlockCache::JitBlockCache(JitBase& jit) : JitBaseBlockCache{jit}
 void JitBlockCache::WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest)
 {
   u8* location = source.exitPtrs;
-  const u8* address = dest ? dest->checkedEntry : m_jit.GetAsmRoutines()->dispatcher;
+  const u8* address = m_jit.GetAsmRoutines()->dispatcher;
+  if (dest && dest->boundCheckedEntry && source.exitBindings.Contains(dest->entryBindings))
+    address = dest->boundCheckedEntry;
+  else if (dest)
+    address = dest->checkedEntry;
   Gen::XEmitter emit(location);
   if (*location == 0xE8)
   {
@@ -41,4 +45,9 @@ void JitBlockCache::WriteDestroyBlock(const JitBlock& block)
   emit.INT3();
   Gen::XEmitter emit2(const_cast<u8*>(block.normalEntry));
   emit2.INT3();
+  if (block.boundCheckedEntry)
+  {
+    Gen::XEmitter emit3(const_cast<u8*>(block.boundCheckedEntry));
+    emit3.INT3();
+  }
 }
@@ -17,6 +17,7 @@
 #include "Core/PowerPC/Jit64Common/Jit64Base.h"
 #include "Core/PowerPC/Jit64Common/Jit64PowerPCState.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/Profiler.h"
 
 using namespace Gen;
 
@@ -43,6 +44,11 @@ OpArg FixImmediate(int access_size, OpArg arg)
 }
 }  // Anonymous namespace
 
+bool EmuCodeBlock::IsDataTranslationOn() const
+{
+  return UReg_MSR(m_compile_msr ? *m_compile_msr : MSR).DR;
+}
+
 void EmuCodeBlock::MemoryExceptionCheck()
 {
   // TODO: We really should untangle the trampolines, exception handlers and
@@ -284,6 +290,66 @@ private:
   bool m_sign_extend;
 };
 
+// Visitor that generates code to write a MMIO value.
+template <typename T>
+class MMIOWriteCodeGenerator : public MMIO::WriteHandlingMethodVisitor<T>
+{
+public:
+  MMIOWriteCodeGenerator(Gen::X64CodeBlock* code, BitSet32 registers_in_use,
+                         const Gen::OpArg& value, u32 address)
+      : m_code(code), m_registers_in_use(registers_in_use), m_value(value), m_address(address)
+  {
+  }
+
+  void VisitNop() override {}
+  void VisitDirect(T* addr, u32 mask) override { WriteToAddrMask(8 * sizeof(T), addr, mask); }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    CallLambda(8 * sizeof(T), lambda);
+  }
+
+private:
+  void WriteToAddrMask(int sbits, void* ptr, u32 mask)
+  {
+    if (!m_value.IsSimpleReg(RSCRATCH))
+      m_code->MOV(sbits, R(RSCRATCH), m_value);
+    u32 all_ones = (1ULL << sbits) - 1;
+    if ((all_ones & mask) != all_ones)
+      m_code->AND(32, R(RSCRATCH), Imm32(all_ones & mask));
+    m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+    m_code->MOV(sbits, MatR(RSCRATCH2), R(RSCRATCH));
+  }
+
+  void CallLambda(int sbits, const std::function<void(u32, T)>* lambda)
+  {
+    m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
+    m_code->ABI_CallLambdaCA(sbits, lambda, m_address, m_value);
+    m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
+  }
+
+  Gen::X64CodeBlock* m_code;
+  BitSet32 m_registers_in_use;
+  Gen::OpArg m_value;
+  u32 m_address;
+};
+
+template <typename T>
+static void EmitMMIOLoad(EmuCodeBlock* emit, MMIO::Mapping* mmio, Gen::X64Reg reg_value,
+                          BitSet32 registers_in_use, u32 address, bool sign_extend)
+{
+  MMIO::ReadHandler<T>& handler = mmio->GetHandlerForRead<T>(address);
+
+  // The destination register is free until the value is loaded into it.
+  if (Profiler::g_ProfileBlocks)
+  {
+    emit->MOV(64, R(reg_value), ImmPtr(handler.GetAccessCounter()));
+    emit->ADD(64, MatR(reg_value), Imm8(1));
+  }
+
+  MMIOReadCodeGenerator<T> gen(emit, registers_in_use, reg_value, address, sign_extend);
+  handler.Visit(gen);
+}
+
 void EmuCodeBlock::MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value,
                                  BitSet32 registers_in_use, u32 address, int access_size,
                                  bool sign_extend)
@@ -291,23 +357,48 @@ void EmuCodeBlock::MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value,
   switch (access_size)
   {
   case 8:
-  {
-    MMIOReadCodeGenerator<u8> gen(this, registers_in_use, reg_value, address, sign_extend);
-    mmio->GetHandlerForRead<u8>(address).Visit(gen);
+    EmitMMIOLoad<u8>(this, mmio, reg_value, registers_in_use, address, sign_extend);
     break;
-  }
   case 16:
-  {
-    MMIOReadCodeGenerator<u16> gen(this, registers_in_use, reg_value, address, sign_extend);
-    mmio->GetHandlerForRead<u16>(address).Visit(gen);
+    EmitMMIOLoad<u16>(this, mmio, reg_value, registers_in_use, address, sign_extend);
     break;
-  }
   case 32:
-  {
-    MMIOReadCodeGenerator<u32> gen(this, registers_in_use, reg_value, address, sign_extend);
-    mmio->GetHandlerForRead<u32>(address).Visit(gen);
+    EmitMMIOLoad<u32>(this, mmio, reg_value, registers_in_use, address, sign_extend);
     break;
   }
+}
+
+template <typename T>
+static void EmitMMIOWrite(EmuCodeBlock* emit, MMIO::Mapping* mmio, const Gen::OpArg& value,
+                            BitSet32 registers_in_use, u32 address)
+{
+  MMIO::WriteHandler<T>& handler = mmio->GetHandlerForWrite<T>(address);
+
+  MMIOWriteCodeGenerator<T> gen(emit, registers_in_use, value, address);
+  handler.Visit(gen);
+
+  // The value may be in RSCRATCH2, so only count the access once it is written.
+  if (Profiler::g_ProfileBlocks)
+  {
+    emit->MOV(64, R(RSCRATCH2), ImmPtr(handler.GetAccessCounter()));
+    emit->ADD(64, MatR(RSCRATCH2), Imm8(1));
+  }
+}
+
+void EmuCodeBlock::MMIOWriteToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value,
+                                   BitSet32 registers_in_use, u32 address, int access_size)
+{
+  switch (access_size)
+  {
+  case 8:
+    EmitMMIOWrite<u8>(this, mmio, value, registers_in_use, address);
+    break;
+  case 16:
+    EmitMMIOWrite<u16>(this, mmio, value, registers_in_use, address);
+    break;
+  case 32:
+    EmitMMIOWrite<u32>(this, mmio, value, registers_in_use, address);
+    break;
   }
 }
 
@@ -364,7 +455,7 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
   }
 
   FixupBranch exit;
-  bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || UReg_MSR(MSR).DR;
+  bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || IsDataTranslationOn();
   bool fast_check_address = !slowmem && dr_set;
   if (fast_check_address)
   {
@@ -526,7 +617,7 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
   }
 
   FixupBranch exit;
-  bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || UReg_MSR(MSR).DR;
+  bool dr_set = (flags & SAFE_LOADSTORE_DR_ON) || IsDataTranslationOn();
   bool fast_check_address = !slowmem && dr_set;
   if (fast_check_address)
   {
@@ -602,6 +693,7 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
                                        BitSet32 registersInUse)
 {
   arg = FixImmediate(accessSize, arg);
+  u32 mmio_address = accessSize != 64 ? PowerPC::IsOptimizableMMIOAccess(address, accessSize) : 0;
 
   // If we already know the address through constant folding, we can do some
   // fun tricks...
@@ -630,6 +722,12 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
   }
+  else if (mmio_address)
+  {
+    // MMIO handlers never raise a DSI, so no exception check is needed.
+    MMIOWriteToAddr(Memory::mmio_mapping.get(), arg, registersInUse, mmio_address, accessSize);
+    return false;
+  }
   else
   {
     // Helps external systems know which instruction triggered the write
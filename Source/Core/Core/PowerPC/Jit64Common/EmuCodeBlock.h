@@ -66,6 +66,8 @@ public:
   // call for known addresses in MMIO range (MMIO::IsMMIOAddress).
   void MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value, BitSet32 registers_in_use,
                      u32 address, int access_size, bool sign_extend);
+  void MMIOWriteToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value, BitSet32 registers_in_use,
+                       u32 address, int access_size);
 
   enum SafeLoadStoreFlags
   {
@@ -123,6 +125,12 @@ public:
   void Clear();
 
 protected:
+  // Whether the code is compiled for data address translation, by the MSR in m_compile_msr or
+  // the current one if there is none.
+  bool IsDataTranslationOn() const;
+
+  // Jit64 points this at the copy of the MSR it compiles the block for.
+  const u32* m_compile_msr = nullptr;
   ConstantPool m_const_pool;
   FarCodeCache m_far_code;
   u8* m_near_code;  // Backed up when we switch to far code.
@@ -38,6 +38,8 @@ class Jitx86Base : public JitBase, public QuantizedMemoryRoutines
 {
 protected:
   bool BackPatch(u32 emAddress, SContext* ctx);
+  // Whether the pointer lies within any of the regions blocks are emitted into.
+  virtual bool IsInCodeSpace(const u8* ptr) const { return IsInSpace(ptr); }
   JitBlockCache blocks{*this};
   TrampolineCache trampolines;
 
@@ -127,6 +127,42 @@ void JitArm64::bcx(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITBranchOff);
 
+  // A condition on a constant CR field is resolved at compile time.
+  bool condition_set;
+  if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) == 0 &&
+      GetKnownCRFieldBit(inst.BI >> 2, 3 - (inst.BI & 3), &condition_set))
+  {
+    if (condition_set != !!(inst.BO_2 & BO_BRANCH_IF_TRUE))
+    {
+      if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_CONDITIONAL_CONTINUE))
+      {
+        gpr.Flush(FlushMode::FLUSH_ALL);
+        fpr.Flush(FlushMode::FLUSH_ALL);
+        WriteExit(js.compilerPC + 4);
+      }
+      return;
+    }
+
+    if (inst.LK)
+    {
+      ARM64Reg WA = gpr.GetReg();
+      MOVI2R(WA, js.compilerPC + 4);
+      STR(INDEX_UNSIGNED, WA, PPC_REG, PPCSTATE_OFF(spr[SPR_LR]));
+      gpr.Unlock(WA);
+    }
+
+    u32 destination;
+    if (inst.AA)
+      destination = SignExt16(inst.BD << 2);
+    else
+      destination = js.compilerPC + SignExt16(inst.BD << 2);
+
+    gpr.Flush(FlushMode::FLUSH_ALL);
+    fpr.Flush(FlushMode::FLUSH_ALL);
+    WriteExit(destination, inst.LK, js.compilerPC + 4);
+    return;
+  }
+
   ARM64Reg WA = gpr.GetReg();
   FixupBranch pCTRDontBranch;
   if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)  // Decrement and test CTR
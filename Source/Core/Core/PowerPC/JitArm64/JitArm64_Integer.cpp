@@ -23,10 +23,9 @@ void JitArm64::ComputeRC0(ARM64Reg reg)
 
 void JitArm64::ComputeRC0(u64 imm)
 {
-  gpr.BindCRToRegister(0, false);
-  MOVI2R(gpr.CR(0), imm);
   if (imm & 0x80000000)
-    SXTW(gpr.CR(0), DecodeReg(gpr.CR(0)));
+    imm = static_cast<u64>(static_cast<s64>(static_cast<s32>(imm)));
+  gpr.SetCRImmediate(0, imm);
 }
 
 void JitArm64::ComputeCarry(bool Carry)
@@ -412,17 +411,17 @@ void JitArm64::cmp(UGeckoInstruction inst)
   int crf = inst.CRFD;
   u32 a = inst.RA, b = inst.RB;
 
-  gpr.BindCRToRegister(crf, false);
-  ARM64Reg CR = gpr.CR(crf);
-
   if (gpr.IsImm(a) && gpr.IsImm(b))
   {
     s64 A = static_cast<s32>(gpr.GetImm(a));
     s64 B = static_cast<s32>(gpr.GetImm(b));
-    MOVI2R(CR, A - B);
+    gpr.SetCRImmediate(crf, A - B);
     return;
   }
 
+  gpr.BindCRToRegister(crf, false);
+  ARM64Reg CR = gpr.CR(crf);
+
   if (gpr.IsImm(b) && !gpr.GetImm(b))
   {
     SXTW(CR, gpr.R(a));
@@ -449,17 +448,17 @@ void JitArm64::cmpl(UGeckoInstruction inst)
   int crf = inst.CRFD;
   u32 a = inst.RA, b = inst.RB;
 
-  gpr.BindCRToRegister(crf, false);
-  ARM64Reg CR = gpr.CR(crf);
-
   if (gpr.IsImm(a) && gpr.IsImm(b))
   {
     u64 A = gpr.GetImm(a);
     u64 B = gpr.GetImm(b);
-    MOVI2R(CR, A - B);
+    gpr.SetCRImmediate(crf, A - B);
     return;
   }
 
+  gpr.BindCRToRegister(crf, false);
+  ARM64Reg CR = gpr.CR(crf);
+
   if (gpr.IsImm(b) && !gpr.GetImm(b))
   {
     MOV(DecodeReg(CR), gpr.R(a));
@@ -478,16 +477,16 @@ void JitArm64::cmpi(UGeckoInstruction inst)
   s64 B = inst.SIMM_16;
   int crf = inst.CRFD;
 
-  gpr.BindCRToRegister(crf, false);
-  ARM64Reg CR = gpr.CR(crf);
-
   if (gpr.IsImm(a))
   {
     s64 A = static_cast<s32>(gpr.GetImm(a));
-    MOVI2R(CR, A - B);
+    gpr.SetCRImmediate(crf, A - B);
     return;
   }
 
+  gpr.BindCRToRegister(crf, false);
+  ARM64Reg CR = gpr.CR(crf);
+
   SXTW(CR, gpr.R(a));
 
   if (B != 0)
@@ -506,16 +505,16 @@ void JitArm64::cmpli(UGeckoInstruction inst)
   u64 B = inst.UIMM;
   int crf = inst.CRFD;
 
-  gpr.BindCRToRegister(crf, false);
-  ARM64Reg CR = gpr.CR(crf);
-
   if (gpr.IsImm(a))
   {
     u64 A = gpr.GetImm(a);
-    MOVI2R(CR, A - B);
+    gpr.SetCRImmediate(crf, A - B);
     return;
   }
 
+  gpr.BindCRToRegister(crf, false);
+  ARM64Reg CR = gpr.CR(crf);
+
   if (!B)
   {
     MOV(DecodeReg(CR), gpr.R(a));
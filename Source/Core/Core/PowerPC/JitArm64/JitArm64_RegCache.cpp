@@ -120,6 +120,12 @@ const OpArg& Arm64GPRCache::GetGuestGPROpArg(size_t preg) const
   return m_guest_registers[preg];
 }
 
+const OpArg& Arm64GPRCache::GetGuestCROpArg(size_t preg) const
+{
+  ASSERT(preg < GUEST_CR_COUNT);
+  return m_guest_registers[GUEST_CR_OFFSET + preg];
+}
+
 Arm64GPRCache::GuestRegInfo Arm64GPRCache::GetGuestGPR(size_t preg)
 {
   ASSERT(preg < GUEST_GPR_COUNT);
@@ -287,7 +293,7 @@ ARM64Reg Arm64GPRCache::R(const GuestRegInfo& guest_reg)
   return INVALID_REG;
 }
 
-void Arm64GPRCache::SetImmediate(const GuestRegInfo& guest_reg, u32 imm)
+void Arm64GPRCache::SetImmediate(const GuestRegInfo& guest_reg, u64 imm)
 {
   OpArg& reg = guest_reg.reg;
   if (reg.GetType() == REG_REG)
@@ -303,7 +309,8 @@ void Arm64GPRCache::BindToRegister(const GuestRegInfo& guest_reg, bool do_load)
   reg.ResetLastUsed();
 
   reg.SetDirty(true);
-  if (reg.GetType() == REG_NOTLOADED)
+  // An immediate which is about to be overwritten doesn't have to be materialized first.
+  if (reg.GetType() == REG_NOTLOADED || (reg.GetType() == REG_IMM && !do_load))
   {
     ARM64Reg host_reg = bitsize != 64 ? GetReg() : EncodeRegTo64(GetReg());
     reg.Load(host_reg);
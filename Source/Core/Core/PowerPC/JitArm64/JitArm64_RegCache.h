@@ -57,13 +57,13 @@ public:
   OpArg() : m_type(REG_NOTLOADED), m_reg(Arm64Gen::INVALID_REG), m_value(0), m_last_used(0) {}
   RegType GetType() const { return m_type; }
   Arm64Gen::ARM64Reg GetReg() const { return m_reg; }
-  u32 GetImm() const { return m_value; }
+  u64 GetImm() const { return m_value; }
   void Load(Arm64Gen::ARM64Reg reg, RegType type = REG_REG)
   {
     m_type = type;
     m_reg = reg;
   }
-  void LoadToImm(u32 imm)
+  void LoadToImm(u64 imm)
   {
     m_type = REG_IMM;
     m_value = imm;
@@ -91,7 +91,7 @@ private:
   Arm64Gen::ARM64Reg m_reg;  // host register we are in
 
   // For REG_IMM
-  u32 m_value;  // IMM value
+  u64 m_value;  // IMM value
 
   u32 m_last_used;
 
@@ -227,6 +227,12 @@ public:
   void BindToRegister(size_t preg, bool do_load) { BindToRegister(GetGuestGPR(preg), do_load); }
   // Binds a guest CR to a host register, optionally loading its value
   void BindCRToRegister(size_t preg, bool do_load) { BindToRegister(GetGuestCR(preg), do_load); }
+  // Set a CR to an immediate, in the internal cr_val format
+  void SetCRImmediate(size_t preg, u64 imm) { SetImmediate(GetGuestCR(preg), imm); }
+  // Returns if a CR is set as an immediate
+  bool IsCRImm(size_t preg) const { return GetGuestCROpArg(preg).GetType() == REG_IMM; }
+  // Gets the immediate that a CR is set to
+  u64 GetCRImm(size_t preg) const { return GetGuestCROpArg(preg).GetImm(); }
   BitSet32 GetCallerSavedUsed() override;
 
   void StoreRegisters(BitSet32 regs) { FlushRegisters(regs, false); }
@@ -251,12 +257,13 @@ private:
   };
 
   const OpArg& GetGuestGPROpArg(size_t preg) const;
+  const OpArg& GetGuestCROpArg(size_t preg) const;
   GuestRegInfo GetGuestGPR(size_t preg);
   GuestRegInfo GetGuestCR(size_t preg);
   GuestRegInfo GetGuestByIndex(size_t index);
 
   Arm64Gen::ARM64Reg R(const GuestRegInfo& guest_reg);
-  void SetImmediate(const GuestRegInfo& guest_reg, u32 imm);
+  void SetImmediate(const GuestRegInfo& guest_reg, u64 imm);
   void BindToRegister(const GuestRegInfo& guest_reg, bool do_load);
 
   void FlushRegisters(BitSet32 regs, bool maintain_state);
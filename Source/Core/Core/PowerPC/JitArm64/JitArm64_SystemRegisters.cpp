@@ -35,6 +35,32 @@ FixupBranch JitArm64::JumpIfCRFieldBit(int field, int bit, bool jump_if_set)
   }
 }
 
+bool JitArm64::GetKnownCRFieldBit(int field, int bit, bool* is_set) const
+{
+  if (!gpr.IsCRImm(field))
+    return false;
+
+  const u64 cr_val = gpr.GetCRImm(field);
+  switch (bit)
+  {
+  case PowerPC::CR_SO_BIT:
+    *is_set = (cr_val & (1ULL << 61)) != 0;
+    return true;
+  case PowerPC::CR_EQ_BIT:
+    *is_set = static_cast<u32>(cr_val) == 0;
+    return true;
+  case PowerPC::CR_GT_BIT:
+    *is_set = static_cast<s64>(cr_val) > 0;
+    return true;
+  case PowerPC::CR_LT_BIT:
+    *is_set = (cr_val & (1ULL << 62)) != 0;
+    return true;
+  default:
+    ASSERT_MSG(DYNA_REC, false, "Invalid CR bit");
+    return false;
+  }
+}
+
 void JitArm64::mtmsr(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -67,11 +93,17 @@ void JitArm64::mcrf(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
 
-  if (inst.CRFS != inst.CRFD)
+  if (inst.CRFS == inst.CRFD)
+    return;
+
+  if (gpr.IsCRImm(inst.CRFS))
   {
-    gpr.BindCRToRegister(inst.CRFD, false);
-    MOV(gpr.CR(inst.CRFD), gpr.CR(inst.CRFS));
+    gpr.SetCRImmediate(inst.CRFD, gpr.GetCRImm(inst.CRFS));
+    return;
   }
+
+  gpr.BindCRToRegister(inst.CRFD, false);
+  MOV(gpr.CR(inst.CRFD), gpr.CR(inst.CRFS));
 }
 
 void JitArm64::mcrxr(UGeckoInstruction inst)
@@ -113,15 +145,6 @@ void JitArm64::mfsr(UGeckoInstruction inst)
   LDR(INDEX_UNSIGNED, gpr.R(inst.RD), PPC_REG, PPCSTATE_OFF(sr[inst.SR]));
 }
 
-void JitArm64::mtsr(UGeckoInstruction inst)
-{
-  INSTRUCTION_START
-  JITDISABLE(bJITSystemRegistersOff);
-
-  gpr.BindToRegister(inst.RS, true);
-  STR(INDEX_UNSIGNED, gpr.R(inst.RS), PPC_REG, PPCSTATE_OFF(sr[inst.SR]));
-}
-
 void JitArm64::mfsrin(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -141,25 +164,6 @@ void JitArm64::mfsrin(UGeckoInstruction inst)
   gpr.Unlock(index);
 }
 
-void JitArm64::mtsrin(UGeckoInstruction inst)
-{
-  INSTRUCTION_START
-  JITDISABLE(bJITSystemRegistersOff);
-
-  u32 b = inst.RB, d = inst.RD;
-  gpr.BindToRegister(d, d == b);
-
-  ARM64Reg index = gpr.GetReg();
-  ARM64Reg index64 = EncodeRegTo64(index);
-  ARM64Reg RB = gpr.R(b);
-
-  UBFM(index, RB, 28, 31);
-  ADD(index64, PPC_REG, index64, ArithOption(index64, ST_LSL, 2));
-  STR(INDEX_UNSIGNED, gpr.R(d), index64, PPCSTATE_OFF(sr[0]));
-
-  gpr.Unlock(index);
-}
-
 void JitArm64::twx(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -91,14 +91,15 @@ void JitArm64::GenerateAsm()
     MOVP2R(MEM_REG, Memory::logical_base);
     SetJumpTarget(membaseend);
 
-    // iCache[(address >> 2) & iCache_Mask];
+    // directory[address >> page_shift][(address & page_mask) >> 2];
     ARM64Reg pc_masked = W25;
     ARM64Reg cache_base = X27;
     ARM64Reg block = X30;
-    ORRI2R(pc_masked, WZR, JitBaseBlockCache::FAST_BLOCK_MAP_MASK << 3);
-    AND(pc_masked, pc_masked, DISPATCHER_PC, ArithOption(DISPATCHER_PC, ST_LSL, 1));
-    MOVP2R(cache_base, GetBlockCache()->GetFastBlockMap());
-    LDR(block, cache_base, EncodeRegTo64(pc_masked));
+    MOVP2R(cache_base, GetBlockCache()->GetBlockPageDirectory());
+    LSR(pc_masked, DISPATCHER_PC, JitBaseBlockCache::BLOCK_PAGE_SHIFT);
+    LDR(cache_base, cache_base, ArithOption(EncodeRegTo64(pc_masked), true));
+    UBFX(pc_masked, DISPATCHER_PC, 2, JitBaseBlockCache::BLOCK_PAGE_SHIFT - 2);
+    LDR(block, cache_base, ArithOption(EncodeRegTo64(pc_masked), true));
     FixupBranch not_found = CBZ(block);
 
     // b.effectiveAddress != addr || b.msrBits != msr
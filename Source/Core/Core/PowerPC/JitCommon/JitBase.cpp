@@ -4,7 +4,10 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <chrono>
+
 #include "Common/CommonTypes.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
@@ -14,12 +17,18 @@ JitBase* g_jit;
 
 const u8* JitBase::Dispatch(JitBase& jit)
 {
+  TRACE_SCOPE("JIT", "Dispatcher lookup");
   return jit.GetBlockCache()->Dispatch();
 }
 
 void JitTrampoline(JitBase& jit, u32 em_address)
 {
+  TRACE_SCOPE("JIT", "Compile block");
+  const auto start = std::chrono::steady_clock::now();
   jit.Jit(em_address);
+  jit.stats.compile_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
 }
 
 u32 Helper_Mask(u8 mb, u8 me)
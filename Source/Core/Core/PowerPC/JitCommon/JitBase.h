@@ -18,6 +18,7 @@
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/JitCommon/JitAsmCommon.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 
 // Use these to control the instruction selection
@@ -78,6 +79,8 @@ protected:
     std::map<u8, u32> constantGqr;
     bool firstFPInstructionFound;
     bool isLastInstruction;
+    // The block is a side effect free polling loop, see PPCAnalyst::CodeBlock::m_idle_loop.
+    bool isIdleLoop;
     int skipInstructions;
     bool carryFlagSet;
     bool carryFlagInverted;
@@ -99,6 +102,7 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    std::unordered_set<u32> hotBranchAddresses;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -112,6 +116,7 @@ public:
   // This should probably be removed from public:
   JitOptions jo{};
   JitState js{};
+  JitStats stats{};
 
   JitBase();
   ~JitBase() override;
@@ -125,8 +130,13 @@ public:
 
   virtual bool HandleFault(uintptr_t access_address, SContext* ctx) = 0;
   virtual bool HandleStackFault() { return false; }
+
+  // Waits until no block is being compiled on a background thread. Must be called before
+  // changing anything the compiler reads, such as the sets in JitState.
+  virtual void SyncBackgroundCompile() {}
 };
 
+// Compiles the block at the address, counting the time in the JIT stats.
 void JitTrampoline(JitBase& jit, u32 em_address);
 
 // Merged routines that should be moved somewhere better
@@ -15,13 +15,16 @@
 #include <functional>
 #include <map>
 #include <set>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -31,14 +34,59 @@
 
 using namespace Gen;
 
+static bool HashBlockCode(const JitBlock& block, u32* hash)
+{
+  const std::vector<u32> addresses(block.physical_addresses.begin(),
+                                   block.physical_addresses.end());
+  return JitDiskCache::HashPhysicalAddresses(addresses.data(), addresses.size(), hash);
+}
+
+// Removes all addresses within the range, without walking every address of a large range.
+static void EraseAddressRange(std::unordered_set<u32>& addresses, u32 address, u32 length)
+{
+  if (addresses.size() < length / 4)
+  {
+    for (auto iter = addresses.begin(); iter != addresses.end();)
+    {
+      if (*iter - address < length)
+        iter = addresses.erase(iter);
+      else
+        iter++;
+    }
+    return;
+  }
+
+  for (u32 i = address; i < address + length; i += 4)
+    addresses.erase(i);
+}
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
   return physical_addresses.lower_bound(address) !=
          physical_addresses.lower_bound(address + length);
 }
 
+bool JitBlock::RegisterBindings::IsEmpty() const
+{
+  return std::all_of(gpr.begin(), gpr.end(), [](s8 reg) { return reg < 0; }) &&
+         std::all_of(fpr.begin(), fpr.end(), [](s8 reg) { return reg < 0; });
+}
+
+bool JitBlock::RegisterBindings::Contains(const RegisterBindings& other) const
+{
+  for (size_t i = 0; i < gpr.size(); i++)
+  {
+    if (other.gpr[i] >= 0 && other.gpr[i] != gpr[i])
+      return false;
+    if (other.fpr[i] >= 0 && other.fpr[i] != fpr[i])
+      return false;
+  }
+  return true;
+}
+
 JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
 {
+  block_page_directory.fill(empty_block_page.data());
 }
 
 JitBaseBlockCache::~JitBaseBlockCache() = default;
@@ -53,6 +101,8 @@ void JitBaseBlockCache::Init()
 void JitBaseBlockCache::Shutdown()
 {
   JitRegister::Shutdown();
+  fastmem_fallback_counts.clear();
+  invalidation_counts.clear();
 }
 
 // This clears the JIT cache. It's called from JitCache.cpp when the JIT cache
@@ -62,8 +112,11 @@ void JitBaseBlockCache::Clear()
 #if defined(_DEBUG) || defined(DEBUGFAST)
   Core::DisplayMessage("Clearing code cache.", 3000);
 #endif
+  m_jit.SyncBackgroundCompile();
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
+  m_jit.js.hotBranchAddresses.clear();
+  m_jit.stats.cache_clears++;
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -73,8 +126,9 @@ void JitBaseBlockCache::Clear()
   block_range_map.clear();
 
   valid_block.ClearAll();
+  code_pages.reset();
 
-  fast_block_map.fill(nullptr);
+  ClearBlockPageDirectory();
 }
 
 void JitBaseBlockCache::Reset()
@@ -83,9 +137,9 @@ void JitBaseBlockCache::Reset()
   Init();
 }
 
-JitBlock** JitBaseBlockCache::GetFastBlockMap()
+JitBlock* const* const* JitBaseBlockCache::GetBlockPageDirectory() const
 {
-  return fast_block_map.data();
+  return block_page_directory.data();
 }
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
@@ -102,23 +156,23 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
   b.physicalAddress = physicalAddress;
   b.msrBits = MSR & JIT_CACHE_MSR_MASK;
   b.linkData.clear();
-  b.fast_block_map_index = 0;
   return &b;
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
-  size_t index = FastLookupIndexForAddress(block.effectiveAddress);
-  fast_block_map[index] = &block;
-  block.fast_block_map_index = index;
+  GetBlockPageDirectorySlot(block.effectiveAddress) = &block;
+  m_jit.stats.blocks_compiled++;
 
   block.physical_addresses = physical_addresses;
+  block.hasCodeHash = HashBlockCode(block, &block.codeHash);
 
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   for (u32 addr : physical_addresses)
   {
     valid_block.Set(addr / 32);
+    code_pages.set(addr >> CODE_PAGE_SHIFT);
     block_range_map[addr & range_mask].insert(&block);
   }
 
@@ -170,9 +224,32 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
   return nullptr;
 }
 
+const JitBlock::RegisterBindings*
+JitBaseBlockCache::GetIncomingRegisterBindings(u32 em_address, u32 msr_bits) const
+{
+  const JitBlock::RegisterBindings* result = nullptr;
+  auto range = links_to.equal_range(em_address);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    const JitBlock& source = *iter->second;
+    if (source.msrBits != msr_bits)
+      continue;
+
+    for (const auto& e : source.linkData)
+    {
+      if (e.exitAddress != em_address)
+        continue;
+      if (!e.exitBindings.IsEmpty())
+        return &e.exitBindings;
+      result = &e.exitBindings;
+    }
+  }
+  return result;
+}
+
 const u8* JitBaseBlockCache::Dispatch()
 {
-  JitBlock* block = fast_block_map[FastLookupIndexForAddress(PC)];
+  JitBlock* block = LookupBlockPageDirectory(PC);
 
   if (!block || block->effectiveAddress != PC || block->msrBits != (MSR & JIT_CACHE_MSR_MASK))
     block = MoveBlockIntoFastCache(PC, MSR & JIT_CACHE_MSR_MASK);
@@ -191,37 +268,48 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
   u32 pAddr = translated.address;
 
   // Optimize the common case of length == 32 which is used by Interpreter::dcb*
-  bool destroy_block = true;
-  if (length == 32)
+  if (length == 32 && !valid_block.Test(pAddr / 32))
+    return;
+  if (!ContainsCodePage(pAddr, length))
+    return;
+
+  m_jit.SyncBackgroundCompile();
+
+  // destroy JIT blocks. Code which was merely written again (e.g. the same overlay being
+  // loaded twice) doesn't need to be recompiled, but breakpoints and HLE hooks change what a
+  // block has to do without changing the code, so forced invalidations always destroy.
+  const bool kept_blocks = ErasePhysicalRange(pAddr, length, !forced);
+
+  // If the code was actually modified, we need to clear the relevant entries from the
+  // FIFO write address cache, so we don't end up with FIFO checks in places they shouldn't
+  // be (this can clobber flags, and thus break any optimization that relies on flags
+  // being in the right place between instructions).
+  if (!forced)
   {
-    if (!valid_block.Test(pAddr / 32))
-      destroy_block = false;
-    else
-      valid_block.Clear(pAddr / 32);
+    EraseAddressRange(m_jit.js.fifoWriteAddresses, address, length);
+    EraseAddressRange(m_jit.js.pairedQuantizeAddresses, address, length);
+    EraseAddressRange(m_jit.js.hotBranchAddresses, address, length);
   }
 
-  if (destroy_block)
+  if (!kept_blocks)
   {
-    // destroy JIT blocks
-    ErasePhysicalRange(pAddr, length);
-
-    // If the code was actually modified, we need to clear the relevant entries from the
-    // FIFO write address cache, so we don't end up with FIFO checks in places they shouldn't
-    // be (this can clobber flags, and thus break any optimization that relies on flags
-    // being in the right place between instructions).
+    if (length == 32)
+      valid_block.Clear(pAddr / 32);
+    // Only forget pages whose analysis hints were dropped along with their blocks.
     if (!forced)
-    {
-      for (u32 i = address; i < address + length; i += 4)
-      {
-        m_jit.js.fifoWriteAddresses.erase(i);
-        m_jit.js.pairedQuantizeAddresses.erase(i);
-      }
-    }
+      ClearCodePages(pAddr, length);
   }
 }
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
+  ErasePhysicalRange(address, length, false);
+}
+
+bool JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length, bool keep_unchanged)
+{
+  bool kept_blocks = false;
+
   // Iterate over all macro blocks which overlap the given range.
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   auto start = block_range_map.lower_bound(address & range_mask);
@@ -233,32 +321,42 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
     while (iter != start->second.end())
     {
       JitBlock* block = *iter;
-      if (block->OverlapsPhysicalRange(address, length))
+      if (!block->OverlapsPhysicalRange(address, length))
       {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
+        iter++;
+        continue;
       }
-      else
+
+      u32 hash;
+      if (keep_unchanged && block->hasCodeHash && HashBlockCode(*block, &hash) &&
+          hash == block->codeHash)
       {
+        kept_blocks = true;
         iter++;
+        continue;
       }
+
+      // If the block overlaps, also remove all other occupied slots in the other macro blocks.
+      // This will leak empty macro blocks, but they may be reused or cleared later on.
+      for (u32 addr : block->physical_addresses)
+        if ((addr & range_mask) != start->first)
+          block_range_map[addr & range_mask].erase(block);
+
+      // And remove the block.
+      invalidation_counts[block->physicalAddress]++;
+      m_jit.stats.blocks_invalidated++;
+      DestroyBlock(*block);
+      auto block_map_iter = block_map.equal_range(block->physicalAddress);
+      while (block_map_iter.first != block_map_iter.second)
+      {
+        if (&block_map_iter.first->second == block)
+        {
+          block_map.erase(block_map_iter.first);
+          break;
+        }
+        block_map_iter.first++;
+      }
+      iter = start->second.erase(iter);
     }
 
     // If the macro block is empty, drop it.
@@ -267,6 +365,84 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
     else
       start++;
   }
+
+  return kept_blocks;
+}
+
+bool JitBaseBlockCache::ContainsCodePage(u32 address, u32 length) const
+{
+  if (length == 0)
+    return false;
+
+  const u64 last_page = (static_cast<u64>(address) + length - 1) >> CODE_PAGE_SHIFT;
+  for (u64 page = address >> CODE_PAGE_SHIFT; page <= last_page; page++)
+  {
+    if (code_pages.test(page))
+      return true;
+  }
+  return false;
+}
+
+void JitBaseBlockCache::ClearCodePages(u32 address, u32 length)
+{
+  // A page which is only partially covered may still contain other blocks.
+  const u64 first_page = (static_cast<u64>(address) + CODE_PAGE_SIZE - 1) >> CODE_PAGE_SHIFT;
+  const u64 end_page = (static_cast<u64>(address) + length) >> CODE_PAGE_SHIFT;
+  for (u64 page = first_page; page < end_page; page++)
+    code_pages.reset(page);
+}
+
+void JitBaseBlockCache::RecordFastmemFallback(u32 em_address)
+{
+  auto translated = PowerPC::JitCache_TranslateAddress(em_address);
+  if (translated.valid)
+    fastmem_fallback_counts[translated.address]++;
+}
+
+u32 JitBaseBlockCache::GetFastmemFallbackCount(const JitBlock& block) const
+{
+  u32 count = 0;
+  for (u32 address : block.physical_addresses)
+  {
+    auto iter = fastmem_fallback_counts.find(address);
+    if (iter != fastmem_fallback_counts.end())
+      count += iter->second;
+  }
+  return count;
+}
+
+u32 JitBaseBlockCache::GetInvalidationCount(const JitBlock& block) const
+{
+  auto iter = invalidation_counts.find(block.physicalAddress);
+  return iter != invalidation_counts.end() ? iter->second : 0;
+}
+
+void JitBaseBlockCache::EraseBlocks(std::function<bool(const JitBlock&)> predicate)
+{
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  auto iter = block_map.begin();
+  while (iter != block_map.end())
+  {
+    JitBlock& block = iter->second;
+    if (!predicate(block))
+    {
+      iter++;
+      continue;
+    }
+
+    for (u32 addr : block.physical_addresses)
+    {
+      auto range = block_range_map.find(addr & range_mask);
+      if (range == block_range_map.end())
+        continue;
+      range->second.erase(&block);
+      if (range->second.empty())
+        block_range_map.erase(range);
+    }
+
+    DestroyBlock(block);
+    iter = block_map.erase(iter);
+  }
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
@@ -342,8 +518,8 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
 
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 {
-  if (fast_block_map[block.fast_block_map_index] == &block)
-    fast_block_map[block.fast_block_map_index] = nullptr;
+  if (LookupBlockPageDirectory(block.effectiveAddress) == &block)
+    GetBlockPageDirectorySlot(block.effectiveAddress) = nullptr;
 
   UnlinkBlock(block);
 
@@ -366,24 +542,38 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 
 JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, u32 msr)
 {
+  m_jit.stats.slow_lookups++;
   JitBlock* block = GetBlockFromStartAddress(addr, msr);
 
   if (!block)
     return nullptr;
 
-  // Drop old fast block map entry
-  if (fast_block_map[block->fast_block_map_index] == block)
-    fast_block_map[block->fast_block_map_index] = nullptr;
-
-  // And create a new one
-  size_t index = FastLookupIndexForAddress(addr);
-  fast_block_map[index] = block;
-  block->fast_block_map_index = index;
+  // A block only ever lives in the slot of its own address, replacing the block with the same
+  // address but other MSR bits.
+  GetBlockPageDirectorySlot(addr) = block;
 
   return block;
 }
 
-size_t JitBaseBlockCache::FastLookupIndexForAddress(u32 address)
+JitBlock* JitBaseBlockCache::LookupBlockPageDirectory(u32 address) const
+{
+  return block_page_directory[address >> BLOCK_PAGE_SHIFT][(address & BLOCK_PAGE_MASK) >> 2];
+}
+
+JitBlock*& JitBaseBlockCache::GetBlockPageDirectorySlot(u32 address)
+{
+  JitBlock**& page = block_page_directory[address >> BLOCK_PAGE_SHIFT];
+  if (page == empty_block_page.data())
+  {
+    block_pages.push_back(std::make_unique<BlockPage>());
+    block_pages.back()->fill(nullptr);
+    page = block_pages.back()->data();
+  }
+  return page[(address & BLOCK_PAGE_MASK) >> 2];
+}
+
+void JitBaseBlockCache::ClearBlockPageDirectory()
 {
-  return (address >> 2) & FAST_BLOCK_MAP_MASK;
+  block_page_directory.fill(empty_block_page.data());
+  block_pages.clear();
 }
@@ -28,11 +28,33 @@ struct JitBlock
 {
   bool OverlapsPhysicalRange(u32 address, u32 length) const;
 
+  // Which host register holds each guest register at a block boundary, or -1 if it only lives
+  // in ppcState. The host register numbering is up to the JIT.
+  struct RegisterBindings
+  {
+    RegisterBindings()
+    {
+      gpr.fill(-1);
+      fpr.fill(-1);
+    }
+
+    bool IsEmpty() const;
+    // True if every register bound in other is bound to the same host register here.
+    bool Contains(const RegisterBindings& other) const;
+
+    std::array<s8, 32> gpr;
+    std::array<s8, 32> fpr;
+  };
+
   // A special entry point for block linking; usually used to check the
   // downcount.
   const u8* checkedEntry;
   // The normal entry point for the block, returned by Dispatch().
   const u8* normalEntry;
+  // Like checkedEntry, but expects the registers in entryBindings to already hold their values,
+  // so the block can skip loading them. Null if the block doesn't have such an entry.
+  const u8* boundCheckedEntry = nullptr;
+  RegisterBindings entryBindings;
 
   // The effective address (PC) for the beginning of the block.
   u32 effectiveAddress;
@@ -58,11 +80,17 @@ struct JitBlock
     u32 exitAddress;
     bool linkStatus;  // is it already linked?
     bool call;
+    // Registers which still hold their values (already written back) when taking this exit.
+    RegisterBindings exitBindings;
   };
   std::vector<LinkData> linkData;
 
   // This set stores all physical addresses of all occupied instructions.
   std::set<u32> physical_addresses;
+  // Hash of the instructions at physical_addresses when the block was compiled, used to
+  // recognize code that was written again without being changed.
+  u32 codeHash = 0;
+  bool hasCodeHash = false;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -74,9 +102,10 @@ struct JitBlock
     u64 ticStop;
   } profile_data = {};
 
-  // This tracks the position if this block within the fast block cache.
-  // We allow each block to have only one map entry.
-  size_t fast_block_map_index;
+  // Per conditional branch address, how much more often its fallthrough path has been taken
+  // than its branch, plus a threshold. The emitted code counts down on every taken branch and
+  // asks for the branch to be followed once this reaches zero.
+  std::map<u32, u32> branch_bias;
 };
 
 typedef void (*CompiledCode)();
@@ -118,8 +147,14 @@ public:
   // is valid (MSR.IR and MSR.DR, the address translation bits).
   static constexpr u32 JIT_CACHE_MSR_MASK = 0x30;
 
-  static constexpr u32 FAST_BLOCK_MAP_ELEMENTS = 0x10000;
-  static constexpr u32 FAST_BLOCK_MAP_MASK = FAST_BLOCK_MAP_ELEMENTS - 1;
+  // The block page directory maps an effective address to its block in two steps: the upper
+  // bits select a page of the directory, the remaining instruction index selects the block
+  // within that page. Pages are allocated on first use; all other directory slots point to a
+  // shared empty page, so the dispatchers never have to check for a missing page.
+  static constexpr u32 BLOCK_PAGE_SHIFT = 16;
+  static constexpr u32 BLOCK_PAGE_MASK = (1 << BLOCK_PAGE_SHIFT) - 1;
+  static constexpr u32 BLOCK_PAGE_ELEMENTS = (1 << BLOCK_PAGE_SHIFT) / 4;
+  static constexpr u32 BLOCK_PAGE_DIRECTORY_ELEMENTS = 1 << (32 - BLOCK_PAGE_SHIFT);
 
   explicit JitBaseBlockCache(JitBase& jit);
   virtual ~JitBaseBlockCache();
@@ -130,27 +165,45 @@ public:
   void Reset();
 
   // Code Cache
-  JitBlock** GetFastBlockMap();
+  JitBlock* const* const* GetBlockPageDirectory() const;
   void RunOnBlocks(std::function<void(const JitBlock&)> f);
 
   JitBlock* AllocateBlock(u32 em_address);
   void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
 
   // Look for the block in the slow but accurate way.
-  // This function shall be used if FastLookupIndexForAddress() failed.
+  // This function shall be used if the block page directory lookup failed.
   // This might return nullptr if there is no such block.
   JitBlock* GetBlockFromStartAddress(u32 em_address, u32 msr);
 
+  // Returns the exit bindings of a compiled block exiting to the given address, preferring one
+  // that carries registers over. This might return nullptr if no block exits there.
+  const JitBlock::RegisterBindings* GetIncomingRegisterBindings(u32 em_address,
+                                                                u32 msr_bits) const;
+
   // Get the normal entry for the block associated with the current program
   // counter. This will JIT code if necessary. (This is the reference
   // implementation; high-performance JITs will want to use a custom
   // assembly version.)
   const u8* Dispatch();
 
+  // Unless forced, blocks whose code is unchanged in memory are kept.
   void InvalidateICache(u32 address, u32 length, bool forced);
   void ErasePhysicalRange(u32 address, u32 length);
+  // Destroys every block the predicate returns true for, e.g. all blocks within a code region
+  // which is about to be reused.
+  void EraseBlocks(std::function<bool(const JitBlock&)> predicate);
 
   u32* GetBlockBitSet() const;
+  size_t GetBlockCount() const { return block_map.size(); }
+
+  // Profiling counters. They are kept per physical address rather than in the blocks, so they
+  // survive the block being invalidated and recompiled.
+  void RecordFastmemFallback(u32 em_address);
+  // The number of fastmem accesses within the block that had to be backpatched to the slow path.
+  u32 GetFastmemFallbackCount(const JitBlock& block) const;
+  // The number of times a block at this address was destroyed by InvalidateICache.
+  u32 GetInvalidationCount(const JitBlock& block) const;
 
 protected:
   JitBase& m_jit;
@@ -166,8 +219,17 @@ private:
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
-  // Fast but risky block lookup based on fast_block_map.
-  size_t FastLookupIndexForAddress(u32 address);
+  // Returns whether any block was kept because its code is unchanged.
+  bool ErasePhysicalRange(u32 address, u32 length, bool keep_unchanged);
+  bool ContainsCodePage(u32 address, u32 length) const;
+  void ClearCodePages(u32 address, u32 length);
+
+  using BlockPage = std::array<JitBlock*, BLOCK_PAGE_ELEMENTS>;
+
+  // Returns the directory slot of an address. The writable variant allocates the page first.
+  JitBlock* LookupBlockPageDirectory(u32 address) const;
+  JitBlock*& GetBlockPageDirectorySlot(u32 address);
+  void ClearBlockPageDirectory();
 
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
@@ -187,7 +249,19 @@ private:
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
 
-  // This array is indexed with the masked PC and likely holds the correct block id.
-  // This is used as a fast cache of block_map used in the assembly dispatcher.
-  std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map;  // start_addr & mask -> number
+  // The same for physical pages, so that invalidating large ranges (e.g. after a DMA into
+  // RAM) only has to look at the block ranges of pages which contain code.
+  static constexpr u32 CODE_PAGE_SHIFT = 12;
+  static constexpr u32 CODE_PAGE_SIZE = 1 << CODE_PAGE_SHIFT;
+  std::bitset<(1ULL << 32) / CODE_PAGE_SIZE> code_pages;
+
+  // Indexed with PC >> BLOCK_PAGE_SHIFT, then (PC & BLOCK_PAGE_MASK) / 4. Each slot holds the
+  // last dispatched block for that effective address, so it only has to be checked against
+  // the MSR bits. This is used as a fast cache of block_map by the assembly dispatchers.
+  std::array<JitBlock**, BLOCK_PAGE_DIRECTORY_ELEMENTS> block_page_directory;
+  std::vector<std::unique_ptr<BlockPage>> block_pages;
+  BlockPage empty_block_page{};
+
+  std::map<u32, u32> fastmem_fallback_counts;  // physical instruction address -> count
+  std::map<u32, u32> invalidation_counts;      // physical entry address -> count
 };
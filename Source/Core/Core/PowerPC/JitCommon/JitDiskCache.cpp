@@ -0,0 +1,140 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Version.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+// Bump this whenever the meaning of the stored data changes.
+static const char JIT_DISK_CACHE_VERSION[] = "JITBLK1";
+
+// Like Memory::GetPointer, but quietly rejects anything outside of RAM (e.g. the locked L1
+// cache), since such code is not worth persisting and must not raise a panic alert.
+static const u8* GetCodePointer(u32 address)
+{
+  address &= 0x3FFFFFFF;
+  if (address < Memory::REALRAM_SIZE)
+    return Memory::m_pRAM + address;
+  if (Memory::m_pEXRAM && (address >> 28) == 0x1 && (address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+    return Memory::m_pEXRAM + (address & Memory::EXRAM_MASK);
+  return nullptr;
+}
+
+class JitDiskCache::Reader final : public LinearDiskCacheReader<Key, u32>
+{
+public:
+  explicit Reader(JitDiskCache& cache) : m_cache(cache) {}
+  void Read(const Key& key, const u32* value, u32 value_size) override
+  {
+    if (!m_cache.m_known_keys.insert(key).second)
+      return;
+
+    Entry entry;
+    entry.key = key;
+    entry.physical_addresses.assign(value, value + value_size);
+    m_cache.m_entries.push_back(std::move(entry));
+  }
+
+private:
+  JitDiskCache& m_cache;
+};
+
+u32 JitDiskCache::Open(const std::string& name, const std::string& game_id)
+{
+  Close();
+
+  const std::string directory = File::GetUserPath(D_CACHE_IDX) + "JIT" DIR_SEP;
+  if (!File::IsDirectory(directory))
+    File::CreateDir(directory);
+
+  const std::string filename =
+      StringFromFormat("%s%s-%s.cache", directory.c_str(), name.c_str(), game_id.c_str());
+
+  Reader reader(*this);
+  const u32 count = m_file.OpenAndRead(
+      filename, reader, std::string(JIT_DISK_CACHE_VERSION) + Common::scm_rev_cache_str);
+  m_open = true;
+  INFO_LOG(DYNA_REC, "Loaded %u cached JIT blocks from %s", count, filename.c_str());
+  return count;
+}
+
+void JitDiskCache::Close()
+{
+  if (!m_open)
+    return;
+
+  m_file.Sync();
+  m_file.Close();
+  m_entries.clear();
+  m_known_keys.clear();
+  m_open = false;
+}
+
+bool JitDiskCache::HashPhysicalAddresses(const u32* addresses, size_t count, u32* hash)
+{
+  std::vector<u32> code(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const u8* pointer = GetCodePointer(addresses[i]);
+    if (!pointer)
+      return false;
+    std::memcpy(&code[i], pointer, sizeof(u32));
+  }
+
+  *hash = HashAdler32(reinterpret_cast<const u8*>(code.data()), code.size() * sizeof(u32));
+  return true;
+}
+
+void JitDiskCache::RecordBlock(const JitBlock& block)
+{
+  if (!m_open || block.physical_addresses.empty())
+    return;
+
+  const std::vector<u32> addresses(block.physical_addresses.begin(),
+                                   block.physical_addresses.end());
+  Key key;
+  key.effective_address = block.effectiveAddress;
+  key.msr_bits = block.msrBits;
+  key.num_instructions = block.originalSize;
+  if (!HashPhysicalAddresses(addresses.data(), addresses.size(), &key.code_hash))
+    return;
+
+  if (!m_known_keys.insert(key).second)
+    return;
+
+  m_file.Append(key, addresses.data(), static_cast<u32>(addresses.size()));
+}
+
+std::vector<u32> JitDiskCache::GetValidBlocks(u32 msr_bits) const
+{
+  std::vector<u32> result;
+  for (const Entry& entry : m_entries)
+  {
+    if (entry.key.msr_bits != msr_bits)
+      continue;
+
+    u32 hash;
+    if (!HashPhysicalAddresses(entry.physical_addresses.data(), entry.physical_addresses.size(),
+                               &hash) ||
+        hash != entry.key.code_hash)
+    {
+      continue;
+    }
+
+    result.push_back(entry.key.effective_address);
+  }
+  return result;
+}
@@ -0,0 +1,73 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+struct JitBlock;
+
+// Remembers which blocks were compiled while a game was running, so that the next boot of
+// the same game can compile them up front instead of one at a time during gameplay.
+//
+// Emitted host code is not stored: it embeds absolute pointers into the code space, the far
+// code cache and the block links, none of which are stable between runs. What is stored is the
+// block boundary (entry address, MSR bits and every physical address the analyzer pulled into
+// the block) together with a hash of the PowerPC code. An entry is only used if the hash still
+// matches the code in memory; anything else falls back to compiling on demand.
+class JitDiskCache
+{
+public:
+  struct Key
+  {
+    u32 effective_address;
+    u32 msr_bits;
+    u32 code_hash;
+    u32 num_instructions;
+
+    bool operator<(const Key& other) const
+    {
+      return std::tie(effective_address, msr_bits, code_hash, num_instructions) <
+             std::tie(other.effective_address, other.msr_bits, other.code_hash,
+                      other.num_instructions);
+    }
+  };
+
+  // Opens (or creates) the cache file belonging to the given game. Returns the number of
+  // entries that were read.
+  u32 Open(const std::string& name, const std::string& game_id);
+  void Close();
+  bool IsOpen() const { return m_open; }
+
+  // Appends a freshly compiled block if it isn't already recorded.
+  void RecordBlock(const JitBlock& block);
+
+  // Returns the entry addresses of all cached blocks for the given MSR bits whose code is
+  // unchanged in memory.
+  std::vector<u32> GetValidBlocks(u32 msr_bits) const;
+
+  // Hashes the instructions at the given physical addresses. Fails if any of them is outside
+  // of RAM.
+  static bool HashPhysicalAddresses(const u32* addresses, size_t count, u32* hash);
+
+private:
+  struct Entry
+  {
+    Key key;
+    std::vector<u32> physical_addresses;
+  };
+
+  class Reader;
+
+  LinearDiskCache<Key, u32> m_file;
+  std::vector<Entry> m_entries;
+  std::set<Key> m_known_keys;
+  bool m_open = false;
+};
@@ -10,6 +10,8 @@
 #include <string>
 #include <unordered_set>
 
+#include <picojson/picojson.h>
+
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -20,8 +22,11 @@
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 
 #include "Core/Core.h"
+#include "Core/HW/MMIO.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -76,6 +81,87 @@ CPUCoreBase* GetCore()
   return g_jit;
 }
 
+static void WriteProfileResultsTable(FILE* file, const ProfileStats& prof_stats,
+                                     const std::vector<MMIO::AccessCount>& mmio_counts)
+{
+  fprintf(file, "origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAlli"
+                "nBlkTime(ms)\tblkCodeSize\n");
+  for (auto& stat : prof_stats.block_stats)
+  {
+    std::string name = g_symbolDB.GetDescription(stat.addr);
+    double percent = 100.0 * (double)stat.cost / (double)prof_stats.cost_sum;
+    double timePercent = 100.0 * (double)stat.tick_counter / (double)prof_stats.timecost_sum;
+    fprintf(file, "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%i\n",
+            stat.addr, name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent,
+            timePercent, (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec,
+            stat.block_size);
+  }
+
+  fprintf(file, "\nmmioAddr\tsize\taccess\tcount\n");
+  for (const MMIO::AccessCount& count : mmio_counts)
+  {
+    fprintf(file, "%08x\t%u\t%s\t%" PRIu64 "\n", count.address, count.size,
+            count.write ? "write" : "read", count.count);
+  }
+}
+
+static void WriteProfileResultsCSV(FILE* file, const ProfileStats& prof_stats)
+{
+  fprintf(file, "address,symbol,run_count,cost,host_ticks,host_time_ms,code_size,"
+                "fastmem_fallbacks,invalidations\n");
+  for (auto& stat : prof_stats.block_stats)
+  {
+    std::string name = g_symbolDB.GetDescription(stat.addr);
+    ReplaceAll(name, "\"", "\"\"");
+    fprintf(file, "%08x,\"%s\",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.3f,%u,%u,%u\n", stat.addr,
+            name.c_str(), stat.run_count, stat.cost, stat.tick_counter,
+            (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec, stat.block_size,
+            stat.fastmem_fallbacks, stat.invalidation_count);
+  }
+}
+
+static void WriteProfileResultsJSON(FILE* file, const ProfileStats& prof_stats,
+                                    const std::vector<MMIO::AccessCount>& mmio_counts)
+{
+  picojson::array blocks;
+  for (auto& stat : prof_stats.block_stats)
+  {
+    picojson::object block;
+    block["address"] = picojson::value(StringFromFormat("%08x", stat.addr));
+    block["symbol"] = picojson::value(g_symbolDB.GetDescription(stat.addr));
+    block["run_count"] = picojson::value(static_cast<double>(stat.run_count));
+    block["cost"] = picojson::value(static_cast<double>(stat.cost));
+    block["host_ticks"] = picojson::value(static_cast<double>(stat.tick_counter));
+    block["host_time_ms"] = picojson::value((double)stat.tick_counter * 1000.0 /
+                                            (double)prof_stats.countsPerSec);
+    block["code_size"] = picojson::value(static_cast<double>(stat.block_size));
+    block["fastmem_fallbacks"] = picojson::value(static_cast<double>(stat.fastmem_fallbacks));
+    block["invalidations"] = picojson::value(static_cast<double>(stat.invalidation_count));
+    blocks.emplace_back(block);
+  }
+
+  picojson::array mmio;
+  for (const MMIO::AccessCount& count : mmio_counts)
+  {
+    picojson::object access;
+    access["address"] = picojson::value(StringFromFormat("%08x", count.address));
+    access["size"] = picojson::value(static_cast<double>(count.size));
+    access["access"] = picojson::value(count.write ? "write" : "read");
+    access["count"] = picojson::value(static_cast<double>(count.count));
+    mmio.emplace_back(access);
+  }
+
+  picojson::object root;
+  root["cost_sum"] = picojson::value(static_cast<double>(prof_stats.cost_sum));
+  root["host_ticks_sum"] = picojson::value(static_cast<double>(prof_stats.timecost_sum));
+  root["host_ticks_per_second"] = picojson::value(static_cast<double>(prof_stats.countsPerSec));
+  root["blocks"] = picojson::value(blocks);
+  root["mmio"] = picojson::value(mmio);
+
+  const std::string json = picojson::value(root).serialize(true);
+  fwrite(json.data(), 1, json.size(), file);
+}
+
 void WriteProfileResults(const std::string& filename)
 {
   ProfileStats prof_stats;
@@ -87,18 +173,31 @@ void WriteProfileResults(const std::string& filename)
     PanicAlert("Failed to open %s", filename.c_str());
     return;
   }
-  fprintf(f.GetHandle(), "origAddr\tblkName\trunCount\tcost\ttimeCost\tpercent\ttimePercent\tOvAlli"
-                         "nBlkTime(ms)\tblkCodeSize\n");
-  for (auto& stat : prof_stats.block_stats)
-  {
-    std::string name = g_symbolDB.GetDescription(stat.addr);
-    double percent = 100.0 * (double)stat.cost / (double)prof_stats.cost_sum;
-    double timePercent = 100.0 * (double)stat.tick_counter / (double)prof_stats.timecost_sum;
-    fprintf(f.GetHandle(),
-            "%08x\t%s\t%" PRIu64 "\t%" PRIu64 "\t%" PRIu64 "\t%.2f\t%.2f\t%.2f\t%i\n", stat.addr,
-            name.c_str(), stat.run_count, stat.cost, stat.tick_counter, percent, timePercent,
-            (double)stat.tick_counter * 1000.0 / (double)prof_stats.countsPerSec, stat.block_size);
-  }
+
+  // Accesses to each MMIO register, to find the hot hardware register paths. The CSV dump
+  // only has room for the blocks.
+  std::vector<MMIO::AccessCount> mmio_counts;
+  if (Memory::mmio_mapping)
+    mmio_counts = Memory::mmio_mapping->GetAccessCounts();
+
+  std::string extension;
+  SplitPath(filename, nullptr, nullptr, &extension);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  if (extension == ".csv")
+    WriteProfileResultsCSV(f.GetHandle(), prof_stats);
+  else if (extension == ".json")
+    WriteProfileResultsJSON(f.GetHandle(), prof_stats, mmio_counts);
+  else
+    WriteProfileResultsTable(f.GetHandle(), prof_stats, mmio_counts);
+}
+
+void GetStats(JitStats* stats)
+{
+  *stats = {};
+  if (!g_jit)
+    return;
+  *stats = g_jit->stats;
+  stats->live_blocks = g_jit->GetBlockCache()->GetBlockCount();
 }
 
 void GetProfileResults(ProfileStats* prof_stats)
@@ -116,14 +215,19 @@ void GetProfileResults(ProfileStats* prof_stats)
     Core::SetState(Core::State::Paused);
 
   QueryPerformanceFrequency((LARGE_INTEGER*)&prof_stats->countsPerSec);
-  g_jit->GetBlockCache()->RunOnBlocks([&prof_stats](const JitBlock& block) {
+  JitBaseBlockCache* block_cache = g_jit->GetBlockCache();
+  block_cache->RunOnBlocks([&prof_stats, block_cache](const JitBlock& block) {
     const auto& data = block.profile_data;
     u64 cost = data.downcountCounter;
     u64 timecost = data.ticCounter;
     // Todo: tweak.
     if (data.runCount >= 1)
+    {
       prof_stats->block_stats.emplace_back(block.effectiveAddress, cost, timecost, data.runCount,
-                                           block.codeSize);
+                                           block.codeSize,
+                                           block_cache->GetFastmemFallbackCount(block),
+                                           block_cache->GetInvalidationCount(block));
+    }
     prof_stats->cost_sum += cost;
     prof_stats->timecost_sum += timecost;
   });
@@ -219,6 +323,8 @@ void CompileExceptionCheck(ExceptionType type)
   if (!g_jit)
     return;
 
+  g_jit->SyncBackgroundCompile();
+
   std::unordered_set<u32>* exception_addresses = nullptr;
 
   switch (type)
@@ -232,6 +338,9 @@ void CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &g_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBranch:
+    exception_addresses = &g_jit->js.hotBranchAddresses;
+    break;
   }
 
   if (PC != 0 && (exception_addresses->find(PC)) == (exception_addresses->end()))
@@ -246,7 +355,7 @@ void CompileExceptionCheck(ExceptionType type)
     exception_addresses->insert(PC);
 
     // Invalidate the JIT block so that it gets recompiled with the external exception check
-    // included.
+    // included (or, for hot branches, with the branch followed).
     g_jit->GetBlockCache()->InvalidateICache(PC, 4, true);
   }
 }
@@ -255,6 +364,9 @@ void Shutdown()
 {
   if (g_jit)
   {
+    if (!Profiler::GetExportPath().empty())
+      WriteProfileResults(Profiler::GetExportPath());
+
     g_jit->Shutdown();
     delete g_jit;
     g_jit = nullptr;
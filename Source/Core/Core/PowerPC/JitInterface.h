@@ -13,13 +13,29 @@ class CPUCoreBase;
 class PointerWrap;
 struct ProfileStats;
 
+// Counters of a JIT core since it started, for benchmarks.
+struct JitStats
+{
+  // The time the CPU thread spent compiling blocks.
+  u64 compile_time_ns = 0;
+  u64 blocks_compiled = 0;
+  // Blocks destroyed because the code they were compiled from was overwritten.
+  u64 blocks_invalidated = 0;
+  u64 cache_clears = 0;
+  // Dispatches that didn't find the block in the block page directory.
+  u64 slow_lookups = 0;
+  // The blocks in the cache when the counters were read.
+  u64 live_blocks = 0;
+};
+
 namespace JitInterface
 {
 enum class ExceptionType
 {
   FIFOWrite,
   PairedQuantize,
-  SpeculativeConstants
+  SpeculativeConstants,
+  HotBranch
 };
 
 void DoState(PointerWrap& p);
@@ -31,6 +47,8 @@ CPUCoreBase* GetCore();
 void WriteProfileResults(const std::string& filename);
 void GetProfileResults(ProfileStats* prof_stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
+// All zero without a JIT core. CPU thread only.
+void GetStats(JitStats* stats);
 
 // Memory Utilities
 bool HandleFault(uintptr_t access_address, SContext* ctx);
@@ -4,7 +4,9 @@
 
 #include <cstddef>
 #include <cstring>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "Common/Atomic.h"
 #include "Common/BitUtils.h"
@@ -945,6 +947,175 @@ static void GenerateISIException(u32 _EffectiveAddress)
   WARN_LOG(POWERPC, "ISI exception at 0x%08x", PC);
 }
 
+// Searches the page table for the entry translating the given effective address and returns the
+// physical address of its PTEG slot.
+static bool LookupPageTableEntry(const u32 address, const u32 sr, u32* pteg_addr_out)
+{
+  u32 page_index = EA_PageIndex(address);  // 16 bit
+  u32 VSID = SR_VSID(sr);                  // 24 bit
+  u32 api = EA_API(address);               //  6 bit (part of page_index)
+
+  // hash function no 1 "xor" .360
+  u32 hash = (VSID ^ page_index);
+  u32 pte1 = Common::swap32((VSID << 7) | api | PTE1_V);
+
+  for (int hash_func = 0; hash_func < 2; hash_func++)
+  {
+    // hash function no 2 "not" .360
+    if (hash_func == 1)
+    {
+      hash = ~hash;
+      pte1 |= PTE1_H << 24;
+    }
+
+    u32 pteg_addr =
+        ((hash & PowerPC::ppcState.pagetable_hashmask) << 6) | PowerPC::ppcState.pagetable_base;
+
+    for (int i = 0; i < 8; i++, pteg_addr += 8)
+    {
+      u32 pteg;
+      std::memcpy(&pteg, &Memory::physical_base[pteg_addr], sizeof(u32));
+
+      if (pte1 == pteg)
+      {
+        *pteg_addr_out = pteg_addr;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static bool IsPageTableFastmemEnabled()
+{
+#ifdef _ARCH_32
+  return false;
+#else
+  return SConfig::GetInstance().bPageTableFastmem && SConfig::GetInstance().bFastmem &&
+         Memory::logical_base && Memory::IsPageTableMappingSupported() &&
+         PowerPC::ppcState.pagetable_hashmask != 0;
+#endif
+}
+
+// Fastmem accesses bypass TranslatePageAddress, so they can neither fault nor update the
+// referenced and changed bits. Only pages that are already marked as both referenced and
+// changed can be mirrored; the rest keep faulting into the slow path, which sets the bits.
+static bool CanMapPageTableEntry(u32 logical_address, UPTE2 PTE2)
+{
+  if (!PTE2.R || !PTE2.C)
+    return false;
+  if (dbat_table[logical_address >> BAT_INDEX_SHIFT] & BAT_MAPPED_BIT)
+    return false;
+  return !PowerPC::memchecks.OverlapsMemcheck(logical_address, HW_PAGE_SIZE);
+}
+
+// Maps the page table translations of the given segments, grouped by their VSID.
+static void MapPageTableSegments(const std::map<u32, std::vector<u32>>& segments_by_vsid)
+{
+  if (segments_by_vsid.empty())
+    return;
+
+  const u32 pteg_count = PowerPC::ppcState.pagetable_hashmask + 1;
+  // Games place the page table in MEM1; don't walk off the end of RAM if one doesn't.
+  if (PowerPC::ppcState.pagetable_base + pteg_count * 64 > Memory::REALRAM_SIZE)
+    return;
+
+  // Mimic the lookup order of TranslatePageAddress: the primary hash is searched before the
+  // secondary hash, and the first matching entry of a PTEG wins.
+  std::map<u32, UPTE2> translations;
+  for (u32 hash_func = 0; hash_func < 2; ++hash_func)
+  {
+    for (u32 pteg_index = 0; pteg_index < pteg_count; ++pteg_index)
+    {
+      const u32 pteg_addr = (pteg_index << 6) | PowerPC::ppcState.pagetable_base;
+      for (u32 i = 0; i < 8; ++i)
+      {
+        UPTE1 PTE1;
+        PTE1.Hex = Common::swap32(&Memory::physical_base[pteg_addr + i * 8]);
+        if (!PTE1.V || PTE1.H != hash_func)
+          continue;
+
+        const auto segments = segments_by_vsid.find(PTE1.VSID);
+        if (segments == segments_by_vsid.end())
+          continue;
+
+        // Invert the hash function to recover the page index. Its low ten bits always come
+        // from the PTEG index; the upper six bits are the API.
+        const u32 hash = hash_func ? ~pteg_index : pteg_index;
+        const u32 page_index = (PTE1.API << 10) | ((hash ^ PTE1.VSID) & 0x3ff);
+
+        UPTE2 PTE2;
+        PTE2.Hex = Common::swap32(&Memory::physical_base[pteg_addr + i * 8 + 4]);
+        for (u32 segment : segments->second)
+          translations.emplace((segment << 28) | (page_index << HW_PAGE_INDEX_SHIFT), PTE2);
+      }
+    }
+  }
+
+  for (const auto& translation : translations)
+  {
+    if (CanMapPageTableEntry(translation.first, translation.second))
+    {
+      Memory::MapPageTableEntry(translation.first,
+                                translation.second.RPN << HW_PAGE_INDEX_SHIFT);
+    }
+  }
+}
+
+void PageTableUpdated()
+{
+  Memory::ClearPageTableMappings();
+  if (!IsPageTableFastmemEnabled())
+    return;
+
+  // Segments sharing a VSID alias the same virtual pages.
+  std::map<u32, std::vector<u32>> segments_by_vsid;
+  for (u32 i = 0; i < 16; ++i)
+  {
+    const u32 sr = PowerPC::ppcState.sr[i];
+    if (!(sr & SR_T))
+      segments_by_vsid[SR_VSID(sr)].push_back(i);
+  }
+  MapPageTableSegments(segments_by_vsid);
+}
+
+// A segment register only decides the translations of its own 256MB, so the mappings of the other
+// segments stay as they are.
+void SegmentRegisterUpdated(u32 index)
+{
+  Memory::UnmapPageTableEntries(index << 28, 0x10000000);
+  if (!IsPageTableFastmemEnabled())
+    return;
+
+  const u32 sr = PowerPC::ppcState.sr[index];
+  if (!(sr & SR_T))
+    MapPageTableSegments({{SR_VSID(sr), {index}}});
+}
+
+// tlbie only affects a single page, so only the mappings of that page index (in every segment)
+// need to be refreshed.
+static void PageTableEntryUpdated(u32 address)
+{
+  if (!IsPageTableFastmemEnabled())
+    return;
+
+  for (u32 i = 0; i < 16; ++i)
+  {
+    const u32 logical_address = (i << 28) | (address & 0x0ffff000);
+    Memory::UnmapPageTableEntry(logical_address);
+
+    const u32 sr = PowerPC::ppcState.sr[i];
+    u32 pteg_addr;
+    if ((sr & SR_T) || !LookupPageTableEntry(logical_address, sr, &pteg_addr))
+      continue;
+
+    UPTE2 PTE2;
+    PTE2.Hex = Common::swap32(&Memory::physical_base[pteg_addr + 4]);
+    if (CanMapPageTableEntry(logical_address, PTE2))
+      Memory::MapPageTableEntry(logical_address, PTE2.RPN << HW_PAGE_INDEX_SHIFT);
+  }
+}
+
 void SDRUpdated()
 {
   u32 htabmask = SDR1_HTABMASK(PowerPC::ppcState.spr[SPR_SDR]);
@@ -959,6 +1130,7 @@ void SDRUpdated()
   }
   PowerPC::ppcState.pagetable_base = htaborg << 16;
   PowerPC::ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+  PageTableUpdated();
 }
 
 enum class TLBLookupResult
@@ -1045,6 +1217,8 @@ void InvalidateTLBEntry(u32 address)
   TLBEntry& tlbe_i = ppcState.tlb[1][entry_index];
   tlbe_i.tag[0] = TLBEntry::INVALID_TAG;
   tlbe_i.tag[1] = TLBEntry::INVALID_TAG;
+
+  PageTableEntryUpdated(address);
 }
 
 // Page Address Translation
@@ -1073,71 +1247,43 @@ static TranslateAddressResult TranslatePageAddress(const u32 address, const XChe
     return TranslateAddressResult{TranslateAddressResult::PAGE_FAULT, 0};
   }
 
-  u32 offset = EA_Offset(address);         // 12 bit
-  u32 page_index = EA_PageIndex(address);  // 16 bit
-  u32 VSID = SR_VSID(sr);                  // 24 bit
-  u32 api = EA_API(address);               //  6 bit (part of page_index)
+  u32 pteg_addr;
+  if (!LookupPageTableEntry(address, sr, &pteg_addr))
+    return TranslateAddressResult{TranslateAddressResult::PAGE_FAULT, 0};
 
-  // hash function no 1 "xor" .360
-  u32 hash = (VSID ^ page_index);
-  u32 pte1 = Common::swap32((VSID << 7) | api | PTE1_V);
+  UPTE2 PTE2;
+  PTE2.Hex = Common::swap32(&Memory::physical_base[pteg_addr + 4]);
 
-  for (int hash_func = 0; hash_func < 2; hash_func++)
+  // set the access bits
+  switch (flag)
   {
-    // hash function no 2 "not" .360
-    if (hash_func == 1)
-    {
-      hash = ~hash;
-      pte1 |= PTE1_H << 24;
-    }
+  case XCheckTLBFlag::NoException:
+  case XCheckTLBFlag::OpcodeNoException:
+    break;
+  case XCheckTLBFlag::Read:
+    PTE2.R = 1;
+    break;
+  case XCheckTLBFlag::Write:
+    PTE2.R = 1;
+    PTE2.C = 1;
+    break;
+  case XCheckTLBFlag::Opcode:
+    PTE2.R = 1;
+    break;
+  }
 
-    u32 pteg_addr =
-        ((hash & PowerPC::ppcState.pagetable_hashmask) << 6) | PowerPC::ppcState.pagetable_base;
+  if (!IsNoExceptionFlag(flag))
+  {
+    const u32 swapped_pte2 = Common::swap32(PTE2.Hex);
+    std::memcpy(&Memory::physical_base[pteg_addr + 4], &swapped_pte2, sizeof(u32));
+  }
 
-    for (int i = 0; i < 8; i++, pteg_addr += 8)
-    {
-      u32 pteg;
-      std::memcpy(&pteg, &Memory::physical_base[pteg_addr], sizeof(u32));
+  // We already updated the TLB entry if this was caused by a C bit.
+  if (res != TLBLookupResult::UpdateC)
+    UpdateTLBEntry(flag, PTE2, address);
 
-      if (pte1 == pteg)
-      {
-        UPTE2 PTE2;
-        PTE2.Hex = Common::swap32(&Memory::physical_base[pteg_addr + 4]);
-
-        // set the access bits
-        switch (flag)
-        {
-        case XCheckTLBFlag::NoException:
-        case XCheckTLBFlag::OpcodeNoException:
-          break;
-        case XCheckTLBFlag::Read:
-          PTE2.R = 1;
-          break;
-        case XCheckTLBFlag::Write:
-          PTE2.R = 1;
-          PTE2.C = 1;
-          break;
-        case XCheckTLBFlag::Opcode:
-          PTE2.R = 1;
-          break;
-        }
-
-        if (!IsNoExceptionFlag(flag))
-        {
-          const u32 swapped_pte2 = Common::swap32(PTE2.Hex);
-          std::memcpy(&Memory::physical_base[pteg_addr + 4], &swapped_pte2, sizeof(u32));
-        }
-
-        // We already updated the TLB entry if this was caused by a C bit.
-        if (res != TLBLookupResult::UpdateC)
-          UpdateTLBEntry(flag, PTE2, address);
-
-        return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED,
-                                      (PTE2.RPN << 12) | offset};
-      }
-    }
-  }
-  return TranslateAddressResult{TranslateAddressResult::PAGE_FAULT, 0};
+  return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED,
+                                (PTE2.RPN << 12) | EA_Offset(address)};
 }
 
 static void UpdateBATs(BatTable& bat_table, u32 base_spr)
@@ -1247,6 +1393,7 @@ void DBATUpdated()
 #ifndef _ARCH_32
   Memory::UpdateLogicalMemory(dbat_table);
 #endif
+  PageTableUpdated();
 
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   JitInterface::ClearSafe();
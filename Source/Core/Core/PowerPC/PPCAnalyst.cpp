@@ -38,6 +38,8 @@ constexpr int CODEBUFFER_SIZE = 32000;
 
 // 0 does not perform block merging
 constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
+// Maximum number of hot conditional branches to follow into a single block.
+constexpr u32 TRACE_FOLLOWING_THRESHOLD = 4;
 
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
@@ -473,6 +475,60 @@ static bool isCror(const CodeOp& a)
   return a.inst.OPCD == 19 && a.inst.SUBOP10 == 449;
 }
 
+// Checks whether the block is a loop with no side effects other than loads, and without any
+// state carried from one iteration over to the next.
+static bool IsIdleLoop(const CodeBlock* block, const CodeOp* code)
+{
+  if (block->m_num_instructions < 2 || block->m_broken)
+    return false;
+
+  const CodeOp& branch = code[block->m_num_instructions - 1];
+  if (branch.inst.OPCD != 16 || branch.inst.LK ||
+      EvaluateBranchTarget(branch.inst, branch.address) != block->m_address ||
+      (branch.inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+  {
+    return false;
+  }
+
+  BitSet32 gpr_written;
+  for (u32 i = 0; i < block->m_num_instructions - 1; i++)
+    gpr_written |= code[i].regsOut;
+
+  // Every register the loop reads must either be loop-invariant or be computed again before
+  // being read in the same iteration.
+  BitSet32 gpr_defined;
+  for (u32 i = 0; i < block->m_num_instructions - 1; i++)
+  {
+    const CodeOp& op = code[i];
+    const u64 flags = op.opinfo->flags;
+    if (op.skip || op.followBranch || (flags & FL_EVIL))
+      return false;
+
+    if (op.opinfo->type == OpType::Load)
+    {
+      // Loads with update carry the address over.
+      if ((flags & (FL_OUT_A | FL_USE_FPU)) || !(flags & FL_OUT_D))
+        return false;
+    }
+    else if (op.opinfo->type == OpType::Integer)
+    {
+      if ((flags & (FL_SET_CA | FL_READ_CA)) || ((flags & FL_SET_OE) && op.inst.OE))
+        return false;
+    }
+    else
+    {
+      return false;
+    }
+
+    if (op.regsIn & gpr_written & ~gpr_defined)
+      return false;
+    gpr_defined |= op.regsOut;
+  }
+
+  // The branch condition needs no such check: whatever sets it comes before the branch.
+  return true;
+}
+
 void PPCAnalyzer::ReorderInstructionsCore(u32 instructions, CodeOp* code, bool reverse,
                                           ReorderType type)
 {
@@ -683,6 +739,11 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
   }
 }
 
+bool PPCAnalyzer::IsHotBranch(u32 address) const
+{
+  return m_hot_branches && m_hot_branches->find(address) != m_hot_branches->end();
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32 blockSize)
 {
   // Clear block stats
@@ -701,6 +762,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
   // Reset our block state
   block->m_broken = false;
   block->m_memory_exception = false;
+  block->m_idle_loop = false;
   block->m_num_instructions = 0;
   block->m_gqr_used = BitSet8(0);
   block->m_physical_addresses.clear();
@@ -711,6 +773,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
   bool found_call = false;
   size_t caller = 0;
   u32 numFollows = 0;
+  u32 numTraceFollows = 0;
   u32 num_inst = 0;
 
   for (u32 i = 0; i < blockSize; ++i)
@@ -805,6 +868,23 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
       }
     }
 
+    if (!follow && HasOption(OPTION_TRACE_FORMATION) &&
+        HasOption(OPTION_CONDITIONAL_CONTINUE) && numTraceFollows < TRACE_FOLLOWING_THRESHOLD &&
+        inst.OPCD == 16 && !inst.LK && blockSize > 1 && IsHotBranch(address))
+    {
+      // bcx with a hot taken path: keep compiling at the branch target, and let the JIT
+      // emit the fallthrough path as a side exit.
+      destination = SignExt16(inst.BD << 2) + (inst.AA ? 0 : address);
+      if (destination != block->m_address)
+      {
+        follow = true;
+        numTraceFollows++;
+        code[i].followBranch = true;
+        // The taken path might skip the matching return.
+        found_call = false;
+      }
+    }
+
     if (HasOption(OPTION_CONDITIONAL_CONTINUE))
     {
       if (inst.OPCD == 16 &&
@@ -910,11 +990,15 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
 
   // Forward scan, for flags that need the other direction for calculation.
   BitSet32 fprIsSingle, fprIsDuplicated, fprIsStoreSafe, gprDefined, gprBlockInputs;
+  BitSet32 fprWritten, fprBlockInputs;
   BitSet8 gqrUsed, gqrModified;
   for (u32 i = 0; i < block->m_num_instructions; i++)
   {
     gprBlockInputs |= code[i].regsIn & ~gprDefined;
     gprDefined |= code[i].regsOut;
+    fprBlockInputs |= code[i].fregsIn & ~fprWritten;
+    if (code[i].fregOut >= 0)
+      fprWritten[code[i].fregOut] = true;
 
     code[i].fprIsSingle = fprIsSingle;
     code[i].fprIsDuplicated = fprIsDuplicated;
@@ -946,6 +1030,32 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
         fprIsSingle[code[i].fregOut] = true;
         fprIsStoreSafe[code[i].fregOut] = true;
       }
+      if (code[i].inst.OPCD == 63)
+      {
+        const UGeckoInstruction inst = code[i].inst;
+        const int d = code[i].fregOut;
+        if (inst.SUBOP10 == 12)  // frsp
+        {
+          // Rounds like a single-precision arithmetic instruction and duplicates the result.
+          fprIsSingle[d] = true;
+          fprIsDuplicated[d] = true;
+          fprIsStoreSafe[d] = true;
+        }
+        else if (inst.SUBOP10 == 72 || inst.SUBOP10 == 40 || inst.SUBOP10 == 264 ||
+                 inst.SUBOP10 == 136)  // fmr, fneg, fabs, fnabs
+        {
+          // Only ps0 is replaced, by a copy of frB's with at most the sign changed.
+          fprIsSingle[d] = code[i].fprIsSingle[inst.FB] && code[i].fprIsSingle[d];
+          fprIsStoreSafe[d] = code[i].fprIsStoreSafe[inst.FB] && code[i].fprIsStoreSafe[d];
+        }
+        else if (inst.SUBOP5 == 23)  // fsel
+        {
+          fprIsSingle[d] = code[i].fprIsSingle[inst.FB] && code[i].fprIsSingle[inst.FC] &&
+                           code[i].fprIsSingle[d];
+          fprIsStoreSafe[d] = code[i].fprIsStoreSafe[inst.FB] &&
+                              code[i].fprIsStoreSafe[inst.FC] && code[i].fprIsStoreSafe[d];
+        }
+      }
       // Careful: changing the float mode in a block breaks this optimization, since
       // a previous float op might have had had FTZ off while the later store has FTZ
       // on. So, discard all information we have.
@@ -969,6 +1079,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
   block->m_gqr_used = gqrUsed;
   block->m_gqr_modified = gqrModified;
   block->m_gpr_inputs = gprBlockInputs;
+  block->m_fpr_inputs = fprBlockInputs;
+  block->m_idle_loop = IsIdleLoop(block, code);
   return address;
 }
 
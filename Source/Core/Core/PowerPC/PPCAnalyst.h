@@ -9,6 +9,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -44,6 +45,8 @@ struct CodeOp  // 16B
   bool canEndBlock;
   bool skipLRStack;
   bool skip;  // followed BL-s for example
+  // conditional branch whose taken path continues the block (trace formation)
+  bool followBranch;
   // which registers are still needed after this instruction in this block
   BitSet32 fprInUse;
   BitSet32 gprInUse;
@@ -160,8 +163,16 @@ struct CodeBlock
   // Which GPRs this block reads from before defining, if any.
   BitSet32 m_gpr_inputs;
 
+  // Which FPRs this block reads from before writing, if any.
+  BitSet32 m_fpr_inputs;
+
   // Which memory locations are occupied by this block.
   std::set<u32> m_physical_addresses;
+
+  // Whether the block is a loop back to its start which only reads memory. Every iteration
+  // behaves the same until a scheduled event changes what it reads, so the CPU can skip ahead
+  // to that event instead of spinning.
+  bool m_idle_loop;
 };
 
 class PPCAnalyzer
@@ -178,8 +189,11 @@ private:
   void ReorderInstructions(u32 instructions, CodeOp* code);
   void SetInstructionStats(CodeBlock* block, CodeOp* code, const GekkoOPInfo* opinfo, u32 index);
 
+  bool IsHotBranch(u32 address) const;
+
   // Options
   u32 m_options;
+  const std::unordered_set<u32>* m_hot_branches = nullptr;
 
 public:
   enum AnalystOption
@@ -218,6 +232,12 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Follow the taken path of conditional branches which runtime profiling found to be hot,
+    // turning the fallthrough path into a side exit. This forms longer traces, giving the
+    // register caches and the flag analysis more instructions to work with.
+    // Requires OPTION_CONDITIONAL_CONTINUE and a set of hot branches.
+    OPTION_TRACE_FORMATION = (1 << 7),
   };
 
   PPCAnalyzer() : m_options(0) {}
@@ -225,6 +245,11 @@ public:
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+  // The addresses of conditional branches whose taken path should be followed.
+  void SetHotBranches(const std::unordered_set<u32>* hot_branches)
+  {
+    m_hot_branches = hot_branches;
+  }
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32 blockSize);
 };
 
@@ -278,6 +278,11 @@ void ClearCacheLine(u32 address);  // Zeroes 32 bytes; address should be 32-byte
 // TLB functions
 void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
+// Rebuilds the fastmem mirror of the page table. Has to be called whenever SDR1 or the DBATs
+// change.
+void PageTableUpdated();
+// Refreshes the fastmem mirror of a single segment after its segment register changed.
+void SegmentRegisterUpdated(u32 index);
 void DBATUpdated();
 void IBATUpdated();
 
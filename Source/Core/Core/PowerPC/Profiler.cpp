@@ -5,16 +5,67 @@
 #include "Core/PowerPC/Profiler.h"
 
 #include <string>
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
 #include "Common/PerformanceCounter.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PowerPC.h"
 
 namespace Profiler
 {
 bool g_ProfileBlocks = false;
+static std::string s_export_path;
 
 void WriteProfileResults(const std::string& filename)
 {
   JitInterface::WriteProfileResults(filename);
 }
 
+void SetExportPath(const std::string& filename)
+{
+  s_export_path = filename;
+  if (!s_export_path.empty())
+    g_ProfileBlocks = true;
+}
+
+const std::string& GetExportPath()
+{
+  return s_export_path;
+}
+
+void ToggleProfilingOrExport()
+{
+  if (PowerPC::GetMode() != PowerPC::CoreMode::JIT)
+    return;
+
+  const bool was_running = Core::GetState() == Core::State::Running;
+  if (was_running)
+    Core::SetState(Core::State::Paused);
+
+  if (!g_ProfileBlocks)
+  {
+    // Blocks only collect profile data if they were compiled with profiling enabled.
+    JitInterface::ClearCache();
+    g_ProfileBlocks = true;
+    Core::DisplayMessage("JIT block profiling enabled.", 3000);
+  }
+  else
+  {
+    std::string filename = s_export_path;
+    if (filename.empty())
+    {
+      filename = File::GetUserPath(D_DUMP_IDX) + "Debug/profiler_" +
+                 SConfig::GetInstance().GetGameID() + ".json";
+    }
+    File::CreateFullPath(filename);
+    WriteProfileResults(filename);
+    Core::DisplayMessage("Wrote JIT block profile to " + filename, 3000);
+  }
+
+  if (was_running)
+    Core::SetState(Core::State::Running);
+}
+
 }  // namespace
@@ -12,8 +12,9 @@
 
 struct BlockStat
 {
-  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size)
-      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size)
+  BlockStat(u32 _addr, u64 c, u64 ticks, u64 run, u32 size, u32 fallbacks, u32 invalidations)
+      : addr(_addr), cost(c), tick_counter(ticks), run_count(run), block_size(size),
+        fastmem_fallbacks(fallbacks), invalidation_count(invalidations)
   {
   }
   u32 addr;
@@ -21,6 +22,8 @@ struct BlockStat
   u64 tick_counter;
   u64 run_count;
   u32 block_size;
+  u32 fastmem_fallbacks;
+  u32 invalidation_count;
 
   bool operator<(const BlockStat& other) const { return cost > other.cost; }
 };
@@ -36,5 +39,16 @@ namespace Profiler
 {
 extern bool g_ProfileBlocks;
 
+// The format is picked from the extension: ".csv" and ".json" produce machine-readable dumps,
+// anything else the tab-separated table shown by the debugger.
 void WriteProfileResults(const std::string& filename);
+
+// Set from the command line. Enables block profiling from boot on and writes the results to
+// the given file when the CPU core shuts down.
+void SetExportPath(const std::string& filename);
+const std::string& GetExportPath();
+
+// Used by the export hotkey. Turns block profiling on if it is off; otherwise writes the results
+// gathered so far to the export path, or to the dump folder if there is none.
+void ToggleProfilingOrExport();
 }
@@ -4,8 +4,12 @@
 
 #include "Core/State.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <lzo/lzo1x.h>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -17,10 +21,12 @@
 #include "Common/Event.h"
 #include "Common/File.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
 #include "Common/Version.h"
 
@@ -29,7 +35,9 @@
 #include "Core/CoreTiming.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/Wiimote.h"
+#include "Core/HW/WriteWatch.h"
 #include "Core/Host.h"
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
@@ -53,10 +61,56 @@ static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
 static unsigned char __LZO_MMODEL out[OUT_LEN];
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
+// Compressed states used to be a stream of LZO blocks, each preceded by its size. Now they start
+// with this in place of the size of the first block, followed by a StateChunkTable and the
+// compressed size of every chunk. The chunks are compressed independently, so that all of them
+// can be worked on at once, both when saving and loading.
+static const u32 CHUNKED_STATE_MAGIC = 0x4B4E4843;  // "CHNK"
+static const u32 STATE_CHUNK_SIZE = 4 * 1024 * 1024;
 
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+struct StateChunkTable
+{
+  u32 magic;
+  u32 chunk_size;
+  u32 num_chunks;
+};
+
+// Delta states start with this instead, followed by a DeltaStateHeader, the file name of the base
+// state, the indices of the pages that differ from the base and those pages, compressed like a
+// state of their own.
+static const u32 DELTA_STATE_MAGIC = 0x41544C44;  // "DLTA"
+static const u32 DELTA_PAGE_SIZE = 4096;
+
+struct DeltaStateHeader
+{
+  u32 magic;
+  u32 base_name_size;
+  // Of the uncompressed base state, to notice when it was saved over.
+  u64 base_hash;
+  u32 base_size;
+  u32 num_pages;
+};
+
+struct DeltaBase
+{
+  std::string filename;
+  double time = 0;
+  std::vector<u8> buffer;
+  u64 hash = 0;
+};
+
+// The base of the last delta state, which is usually the base of the next one too.
+static std::shared_ptr<const DeltaBase> s_delta_base;
+
+static u64 GetDeltaBaseHash(const std::vector<u8>& buffer)
+{
+  return GetMurmurHash3(buffer.data(), static_cast<u32>(buffer.size()), 0);
+}
+
+static constexpr size_t GetMaxCompressedSize(size_t size)
+{
+  return size + size / 16 + 64 + 3;
+}
 
 static std::string g_last_filename;
 
@@ -73,8 +127,20 @@ static Common::Event g_compressAndDumpStateSyncEvent;
 
 static std::thread g_save_thread;
 
+struct Snapshot
+{
+  // Everything but RAM and EXRAM.
+  std::vector<u8> state;
+  std::vector<u8> memory;
+  std::vector<u32> generations;
+};
+
+static std::vector<Snapshot> s_snapshots;
+static u32 s_next_snapshot = 0;
+static u32 s_snapshot_count = 0;
+
 // Don't forget to increase this after doing changes on the savestate system
-static const u32 STATE_VERSION = 94;  // Last changed in PR 6456
+static const u32 STATE_VERSION = 95;  // Last changed for deferred SI polls
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -215,20 +281,115 @@ void LoadFromBuffer(std::vector<u8>& buffer)
   });
 }
 
-void SaveToBuffer(std::vector<u8>& buffer)
+bool LoadNetPlaySyncState(std::vector<u8>& buffer)
 {
+  bool loaded = false;
   Core::RunAsCPUThread([&] {
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, PointerWrap::MODE_READ);
+    DoState(p);
+    loaded = p.GetMode() == PointerWrap::MODE_READ;
+  });
+  return loaded;
+}
 
+// Saves into the storage the buffer already has, and leaves the buffer at the size of the state.
+// The state rarely changes size, so the storage of the last save almost always fits and the
+// state doesn't need to be measured first.
+static bool SaveToReusedBuffer(std::vector<u8>& buffer)
+{
+  buffer.resize(buffer.capacity());
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::MODE_WRITE);
+  DoState(p);
+  size_t size = static_cast<size_t>(ptr - buffer.data());
+  if (p.IsOverflowed())
+  {
+    buffer.resize(size);
+    ptr = buffer.data();
+    p = PointerWrap(&ptr, size, PointerWrap::MODE_WRITE);
     DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-    buffer.resize(buffer_size);
+    size = static_cast<size_t>(ptr - buffer.data());
+  }
+  buffer.resize(size);
+  return p.GetMode() == PointerWrap::MODE_WRITE && !p.IsOverflowed();
+}
+
+void SaveToBuffer(std::vector<u8>& buffer)
+{
+  Core::RunAsCPUThread([&] { SaveToReusedBuffer(buffer); });
+}
+
+void InitSnapshots(u32 count)
+{
+  s_snapshots.clear();
+  s_snapshots.resize(count);
+  s_next_snapshot = 0;
+  s_snapshot_count = 0;
+}
+
+void ClearSnapshots()
+{
+  InitSnapshots(0);
+}
+
+u32 GetSnapshotCount()
+{
+  return s_snapshot_count;
+}
+
+void SaveSnapshot()
+{
+  if (s_snapshots.empty())
+    return;
+
+  Core::RunAsCPUThread([] {
+    Snapshot& snapshot = s_snapshots[s_next_snapshot];
+    Memory::SetDoStateSkipsRAM(true);
+    Common::ScopeGuard skip_guard{[] { Memory::SetDoStateSkipsRAM(false); }};
 
-    ptr = &buffer[0];
-    p.SetMode(PointerWrap::MODE_WRITE);
+    SaveToReusedBuffer(snapshot.state);
+
+    if (snapshot.memory.size() != WriteWatch::GetMemorySize())
+    {
+      snapshot.memory.resize(WriteWatch::GetMemorySize());
+      snapshot.generations.assign(WriteWatch::GetPageCount(), 0);
+    }
+    WriteWatch::SaveChangedPages(snapshot.memory.data(), snapshot.generations.data());
+
+    s_next_snapshot = (s_next_snapshot + 1) % static_cast<u32>(s_snapshots.size());
+    s_snapshot_count = std::min(s_snapshot_count + 1, static_cast<u32>(s_snapshots.size()));
+  });
+}
+
+bool LoadSnapshot(u32 age)
+{
+  if (age >= s_snapshot_count)
+    return false;
+
+  bool loaded = false;
+  Core::RunAsCPUThread([age, &loaded] {
+    const u32 ring_size = static_cast<u32>(s_snapshots.size());
+    const u32 index = (s_next_snapshot + ring_size - 1 - age) % ring_size;
+    Snapshot& snapshot = s_snapshots[index];
+    Memory::SetDoStateSkipsRAM(true);
+    Common::ScopeGuard skip_guard{[] { Memory::SetDoStateSkipsRAM(false); }};
+
+    u8* ptr = snapshot.state.data();
+    PointerWrap p(&ptr, PointerWrap::MODE_READ);
     DoState(p);
+    if (p.GetMode() != PointerWrap::MODE_READ)
+      return;
+
+    // After the rest of the state, so that nothing the video backend writes back to RAM while
+    // loading is left over.
+    WriteWatch::RestoreChangedPages(snapshot.memory.data(), snapshot.generations.data());
+
+    s_next_snapshot = (index + 1) % ring_size;
+    s_snapshot_count -= age;
+    loaded = true;
   });
+  return loaded;
 }
 // return state number not in map
 static int GetEmptySlot(std::map<double, int> m)
@@ -283,8 +444,175 @@ struct CompressAndDumpState_args
   std::mutex* buffer_mutex;
   std::string filename;
   bool wait;
+  // Set for delta states.
+  std::shared_ptr<const DeltaBase> base;
+  bool keyframe;
 };
 
+// Calls work for every item on the thread pool, until it returns false.
+template <typename Func>
+static bool RunOnWorkers(size_t num_items, Func work)
+{
+  std::atomic<bool> failed{false};
+  Common::ThreadPool::ParallelFor(0, num_items, 1, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last && !failed; ++i)
+    {
+      if (!work(i))
+        failed = true;
+    }
+  });
+  return !failed;
+}
+
+static bool WriteCompressedState(File::IOFile& f, const u8* buffer_data, size_t buffer_size)
+{
+  const u32 num_chunks = static_cast<u32>((buffer_size + STATE_CHUNK_SIZE - 1) / STATE_CHUNK_SIZE);
+  std::vector<std::vector<u8>> chunks(num_chunks);
+  const bool compressed = RunOnWorkers(num_chunks, [&](size_t i) {
+    std::vector<lzo_align_t> wrkmem(
+        (LZO1X_1_MEM_COMPRESS + sizeof(lzo_align_t) - 1) / sizeof(lzo_align_t));
+    const size_t offset = i * STATE_CHUNK_SIZE;
+    const size_t size = std::min<size_t>(STATE_CHUNK_SIZE, buffer_size - offset);
+    chunks[i].resize(GetMaxCompressedSize(size));
+    lzo_uint out_len = 0;
+    if (lzo1x_1_compress(buffer_data + offset, static_cast<lzo_uint>(size), chunks[i].data(),
+                         &out_len, wrkmem.data()) != LZO_E_OK)
+    {
+      return false;
+    }
+    chunks[i].resize(out_len);
+    return true;
+  });
+  if (!compressed)
+  {
+    PanicAlertT("Internal LZO Error - compression failed");
+    return false;
+  }
+
+  const StateChunkTable table{CHUNKED_STATE_MAGIC, STATE_CHUNK_SIZE, num_chunks};
+  std::vector<u32> chunk_sizes(num_chunks);
+  for (u32 i = 0; i < num_chunks; ++i)
+    chunk_sizes[i] = static_cast<u32>(chunks[i].size());
+  if (!f.WriteArray(&table, 1) || !f.WriteArray(chunk_sizes.data(), num_chunks))
+    return false;
+  for (const std::vector<u8>& chunk : chunks)
+  {
+    if (!f.WriteBytes(chunk.data(), chunk.size()))
+      return false;
+  }
+  return true;
+}
+
+static bool ReadCompressedState(File::IOFile& f, u8* buffer_data, size_t buffer_size)
+{
+  StateChunkTable table;
+  if (!f.ReadArray(&table, 1) || table.chunk_size == 0 ||
+      table.num_chunks != (buffer_size + table.chunk_size - 1) / table.chunk_size)
+  {
+    return false;
+  }
+
+  std::vector<u32> chunk_sizes(table.num_chunks);
+  if (!f.ReadArray(chunk_sizes.data(), table.num_chunks))
+    return false;
+  std::vector<size_t> chunk_offsets(table.num_chunks + 1);
+  for (u32 i = 0; i < table.num_chunks; ++i)
+    chunk_offsets[i + 1] = chunk_offsets[i] + chunk_sizes[i];
+
+  std::vector<u8> compressed(chunk_offsets.back());
+  if (!f.ReadBytes(compressed.data(), compressed.size()))
+    return false;
+
+  return RunOnWorkers(table.num_chunks, [&](size_t i) {
+    const size_t offset = i * table.chunk_size;
+    const size_t size = std::min<size_t>(table.chunk_size, buffer_size - offset);
+    lzo_uint out_len = static_cast<lzo_uint>(size);
+    return lzo1x_decompress_safe(compressed.data() + chunk_offsets[i], chunk_sizes[i],
+                                 buffer_data + offset, &out_len, nullptr) == LZO_E_OK &&
+           out_len == size;
+  });
+}
+
+static bool WriteDeltaState(File::IOFile& f, const u8* buffer_data, size_t buffer_size,
+                            const DeltaBase& base)
+{
+  std::vector<u32> pages;
+  std::vector<u8> page_data;
+  for (size_t offset = 0; offset < buffer_size; offset += DELTA_PAGE_SIZE)
+  {
+    const size_t size = std::min<size_t>(DELTA_PAGE_SIZE, buffer_size - offset);
+    if (offset + size <= base.buffer.size() &&
+        std::memcmp(buffer_data + offset, base.buffer.data() + offset, size) == 0)
+    {
+      continue;
+    }
+    pages.push_back(static_cast<u32>(offset / DELTA_PAGE_SIZE));
+    page_data.insert(page_data.end(), buffer_data + offset, buffer_data + offset + size);
+  }
+
+  const DeltaStateHeader header{DELTA_STATE_MAGIC, static_cast<u32>(base.filename.size()),
+                                base.hash, static_cast<u32>(base.buffer.size()),
+                                static_cast<u32>(pages.size())};
+  if (!f.WriteArray(&header, 1) || !f.WriteBytes(base.filename.data(), base.filename.size()) ||
+      !f.WriteArray(pages.data(), pages.size()))
+  {
+    return false;
+  }
+  return page_data.empty() || WriteCompressedState(f, page_data.data(), page_data.size());
+}
+
+static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data,
+                              bool allow_delta = true);
+
+static bool ReadDeltaState(File::IOFile& f, u8* buffer_data, size_t buffer_size)
+{
+  DeltaStateHeader header;
+  if (!f.ReadArray(&header, 1))
+    return false;
+  std::string base_filename(header.base_name_size, '\0');
+  std::vector<u32> pages(header.num_pages);
+  if (!f.ReadBytes(&base_filename[0], base_filename.size()) ||
+      !f.ReadArray(pages.data(), pages.size()))
+  {
+    return false;
+  }
+
+  // Bases are never deltas themselves, which also keeps a state from being its own base.
+  std::vector<u8> base;
+  LoadFileStateData(base_filename, base, false);
+  if (base.size() != header.base_size || GetDeltaBaseHash(base) != header.base_hash)
+  {
+    Core::DisplayMessage(
+        StringFromFormat("The base state %s has changed or is missing", base_filename.c_str()),
+        4000);
+    return false;
+  }
+  std::memcpy(buffer_data, base.data(), std::min(base.size(), buffer_size));
+
+  // Pages are whole except maybe the last one of the state.
+  size_t page_data_size = 0;
+  for (u32 page : pages)
+  {
+    const size_t offset = static_cast<size_t>(page) * DELTA_PAGE_SIZE;
+    if (offset >= buffer_size)
+      return false;
+    page_data_size += std::min<size_t>(DELTA_PAGE_SIZE, buffer_size - offset);
+  }
+  std::vector<u8> page_data(page_data_size);
+  if (!page_data.empty() && !ReadCompressedState(f, page_data.data(), page_data.size()))
+    return false;
+
+  const u8* src = page_data.data();
+  for (u32 page : pages)
+  {
+    const size_t offset = static_cast<size_t>(page) * DELTA_PAGE_SIZE;
+    const size_t size = std::min<size_t>(DELTA_PAGE_SIZE, buffer_size - offset);
+    std::memcpy(buffer_data + offset, src, size);
+    src += size;
+  }
+  return true;
+}
+
 static void CompressAndDumpState(CompressAndDumpState_args save_args)
 {
   std::lock_guard<std::mutex> lk(*save_args.buffer_mutex);
@@ -310,7 +638,7 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   Common::SetCurrentThreadName("SaveState thread");
 
   // Moving to last overwritten save-state
-  if (File::Exists(filename))
+  if (!save_args.keyframe && File::Exists(filename))
   {
     if (File::Exists(File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav"))
       File::Delete((File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav"));
@@ -323,10 +651,13 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
       File::Rename(filename + ".dtm", File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav.dtm");
   }
 
-  if ((Movie::IsMovieActive()) && !Movie::IsJustStartingRecordingInputFromSaveState())
-    Movie::SaveRecording(filename + ".dtm");
-  else if (!Movie::IsMovieActive())
-    File::Delete(filename + ".dtm");
+  if (!save_args.keyframe)
+  {
+    if ((Movie::IsMovieActive()) && !Movie::IsJustStartingRecordingInputFromSaveState())
+      Movie::SaveRecording(filename + ".dtm");
+    else if (!Movie::IsMovieActive())
+      File::Delete(filename + ".dtm");
+  }
 
   File::IOFile f(filename, "wb");
   if (!f)
@@ -338,39 +669,25 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   // Setting up the header
   StateHeader header;
   strncpy(header.gameID, SConfig::GetInstance().GetGameID().c_str(), 6);
-  header.size = g_use_compression ? (u32)buffer_size : 0;
+  header.size = g_use_compression || save_args.base ? (u32)buffer_size : 0;
   header.time = Common::Timer::GetDoubleTime();
 
   f.WriteArray(&header, 1);
 
-  if (header.size != 0)  // non-zero header size means the state is compressed
+  if (save_args.base)
   {
-    lzo_uint i = 0;
-    while (true)
+    if (!WriteDeltaState(f, buffer_data, buffer_size, *save_args.base))
     {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
+      Core::DisplayMessage("Could not save state", 2000);
+      return;
+    }
+  }
+  else if (header.size != 0)  // non-zero header size means the state is compressed
+  {
+    if (!WriteCompressedState(f, buffer_data, buffer_size))
+    {
+      Core::DisplayMessage("Could not save state", 2000);
+      return;
     }
   }
   else  // uncompressed
@@ -382,39 +699,70 @@ static void CompressAndDumpState(CompressAndDumpState_args save_args)
   Host_UpdateMainFrame();
 }
 
-void SaveAs(const std::string& filename, bool wait)
+static std::shared_ptr<const DeltaBase> GetDeltaBase(const std::string& base_filename)
+{
+  StateHeader header;
+  if (!ReadHeader(base_filename, header))
+    return nullptr;
+  if (s_delta_base && s_delta_base->filename == base_filename && s_delta_base->time == header.time)
+    return s_delta_base;
+
+  auto base = std::make_shared<DeltaBase>();
+  base->filename = base_filename;
+  base->time = header.time;
+  LoadFileStateData(base_filename, base->buffer, false);
+  if (base->buffer.empty())
+    return nullptr;
+  base->hash = GetDeltaBaseHash(base->buffer);
+  s_delta_base = base;
+  return base;
+}
+
+static void SaveAs(const std::string& filename, bool wait, const std::string& base_filename,
+                   bool keyframe)
 {
   Core::RunAsCPUThread([&] {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p(&ptr, PointerWrap::MODE_MEASURE);
-    DoState(p);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+    std::shared_ptr<const DeltaBase> base;
+    if (!base_filename.empty())
+    {
+      // Saving over the base would move it to lastState.sav.
+      if (base_filename == filename)
+      {
+        Core::DisplayMessage("Unable to save: A state can't be its own base", 4000);
+        return;
+      }
+      // The state is saved whole instead, which is always possible.
+      base = GetDeltaBase(base_filename);
+      if (!base)
+        WARN_LOG(CORE, "Saving %s without a base, %s can't be used", filename.c_str(),
+                 base_filename.c_str());
+    }
 
-    // Then actually do the write.
+    bool saved;
     {
       std::lock_guard<std::mutex> lk(g_cs_current_buffer);
-      g_current_buffer.resize(buffer_size);
-      ptr = &g_current_buffer[0];
-      p.SetMode(PointerWrap::MODE_WRITE);
-      DoState(p);
+      saved = SaveToReusedBuffer(g_current_buffer);
     }
 
-    if (p.GetMode() == PointerWrap::MODE_WRITE)
+    if (saved)
     {
-      Core::DisplayMessage("Saving State...", 1000);
+      if (!keyframe)
+        Core::DisplayMessage("Saving State...", 1000);
 
       CompressAndDumpState_args save_args;
       save_args.buffer_vector = &g_current_buffer;
       save_args.buffer_mutex = &g_cs_current_buffer;
       save_args.filename = filename;
       save_args.wait = wait;
+      save_args.base = std::move(base);
+      save_args.keyframe = keyframe;
 
       Flush();
       g_save_thread = std::thread(CompressAndDumpState, save_args);
       g_compressAndDumpStateSyncEvent.Wait();
 
-      g_last_filename = filename;
+      if (!keyframe)
+        g_last_filename = filename;
     }
     else
     {
@@ -424,6 +772,33 @@ void SaveAs(const std::string& filename, bool wait)
   });
 }
 
+void SaveAs(const std::string& filename, bool wait)
+{
+  SaveAs(filename, wait, "", false);
+}
+
+void SaveKeyframe(const std::string& filename, const std::string& base_filename)
+{
+  SaveAs(filename, false, base_filename, true);
+}
+
+bool LoadKeyframe(const std::string& filename)
+{
+  bool loaded = false;
+  Core::RunAsCPUThread([&] {
+    std::vector<u8> buffer;
+    LoadFileStateData(filename, buffer);
+    if (buffer.empty())
+      return;
+
+    u8* ptr = buffer.data();
+    PointerWrap p(&ptr, PointerWrap::MODE_READ);
+    DoState(p);
+    loaded = p.GetMode() == PointerWrap::MODE_READ;
+  });
+  return loaded;
+}
+
 bool ReadHeader(const std::string& filename, StateHeader& header)
 {
   Flush();
@@ -451,7 +826,8 @@ std::string GetInfoStringOfSlot(int slot, bool translate)
   return Common::Timer::GetDateTimeFormatted(header.time);
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data,
+                              bool allow_delta)
 {
   Flush();
   File::IOFile f(filename, "rb");
@@ -479,6 +855,36 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
     buffer.resize(header.size);
 
+    u32 magic = 0;
+    f.ReadArray(&magic, 1);
+    f.Seek(-static_cast<s64>(sizeof(magic)), SEEK_CUR);
+    if (magic == DELTA_STATE_MAGIC)
+    {
+      if (!allow_delta)
+      {
+        Core::DisplayMessage("The base of a delta state can't be a delta state", 4000);
+        return;
+      }
+      if (!ReadDeltaState(f, buffer.data(), buffer.size()))
+      {
+        Core::DisplayMessage("Unable to load the delta state", 4000);
+        return;
+      }
+      ret_data.swap(buffer);
+      return;
+    }
+    if (magic == CHUNKED_STATE_MAGIC)
+    {
+      if (!ReadCompressedState(f, buffer.data(), buffer.size()))
+      {
+        PanicAlertT("Internal LZO Error - decompression failed");
+        return;
+      }
+      ret_data.swap(buffer);
+      return;
+    }
+
+    // States from before chunking
     lzo_uint i = 0;
     while (true)
     {
@@ -609,6 +1015,9 @@ void Shutdown()
 {
   Flush();
 
+  // Their page generations don't carry over to the next session.
+  ClearSnapshots();
+
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
   // never)
@@ -46,9 +46,29 @@ void Load(int slot);
 
 void SaveAs(const std::string& filename, bool wait = false);
 void LoadAs(const std::string& filename);
+// Keyframes are states for seeking in movies. They don't keep a copy of the movie like other
+// states do, and loading one leaves the movie that is playing alone. The base is optional: if
+// it's given and is a whole state, only the pages that differ from it are saved, and loading
+// puts them back together. Otherwise the keyframe is saved whole.
+void SaveKeyframe(const std::string& filename, const std::string& base_filename);
+bool LoadKeyframe(const std::string& filename);
 
 void SaveToBuffer(std::vector<u8>& buffer);
 void LoadFromBuffer(std::vector<u8>& buffer);
+// Loads the state another NetPlay player sent to fix a desync, which LoadFromBuffer refuses to
+// do during NetPlay.
+bool LoadNetPlaySyncState(std::vector<u8>& buffer);
+
+// A ring of in-memory states that can be saved and loaded every frame, for rewinding and
+// rollback. The buffers of a slot are reused without measuring the state first, and only the
+// pages of RAM written since the slot was last saved get copied into it.
+void InitSnapshots(u32 count);
+void ClearSnapshots();
+u32 GetSnapshotCount();
+// Saves a snapshot, replacing the oldest one once the ring is full.
+void SaveSnapshot();
+// Loads the snapshot saved age snapshots ago, 0 being the newest, and drops the newer ones.
+bool LoadSnapshot(u32 age = 0);
 
 void LoadLastSaved(int i = 1);
 void SaveFirstSaved();
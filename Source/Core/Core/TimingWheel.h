@@ -0,0 +1,221 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include "Common/BitHelpers.h"
+#include "Common/CommonTypes.h"
+
+namespace CoreTiming
+{
+// A priority queue of timed events, ordered by (time, fifo_order) like the binary heap it
+// replaces. Event only needs public `s64 time` and `u64 fifo_order` members.
+//
+// The near future is covered by a wheel of NUM_SLOTS slots, each SLOT_CYCLES wide. Inserting
+// into the wheel is a push_back into the slot for the event's time; the slot is only sorted once
+// it becomes the earliest occupied one, and an occupancy bitmap finds that slot without looking
+// at empty ones. Events beyond the wheel's horizon sit in a second level, a min-heap, and move
+// into the wheel once it has turned far enough to reach them. Events that are already due are
+// filed into the current slot, which is always the earliest one.
+template <typename Event>
+class TimingWheel
+{
+public:
+  static constexpr int SLOT_SHIFT = 11;
+  static constexpr s64 SLOT_CYCLES = s64(1) << SLOT_SHIFT;
+  static constexpr size_t NUM_SLOTS = 512;
+  static constexpr s64 HORIZON = SLOT_CYCLES * NUM_SLOTS;
+
+  bool Empty() const { return m_wheel_count == 0 && m_overflow.empty(); }
+  size_t Size() const { return m_wheel_count + m_overflow.size(); }
+
+  void Push(const Event& event)
+  {
+    if (Empty())
+      m_base = AlignToSlot(event.time);
+
+    if (event.time >= m_base + HORIZON)
+    {
+      m_overflow.push_back(event);
+      std::push_heap(m_overflow.begin(), m_overflow.end(), Later);
+      return;
+    }
+
+    InsertIntoWheel(event);
+  }
+
+  // The earliest event. The queue must not be empty.
+  const Event& Front()
+  {
+    Slot& slot = m_slots[FindFrontSlot()];
+    if (!slot.sorted)
+    {
+      // Descending, so that the earliest event can be popped off the back.
+      std::sort(slot.events.begin(), slot.events.end(), Later);
+      slot.sorted = true;
+    }
+    return slot.events.back();
+  }
+
+  void PopFront()
+  {
+    Front();
+    const size_t index = SlotIndex(m_base);
+    m_slots[index].events.pop_back();
+    m_wheel_count--;
+    if (m_slots[index].events.empty())
+      m_occupied[index / 64] &= ~(u64(1) << (index % 64));
+  }
+
+  template <typename Predicate>
+  void RemoveIf(Predicate pred)
+  {
+    for (size_t i = 0; i < NUM_SLOTS; ++i)
+    {
+      std::vector<Event>& events = m_slots[i].events;
+      if (events.empty())
+        continue;
+
+      // remove_if is stable, so a sorted slot stays sorted.
+      const auto itr = std::remove_if(events.begin(), events.end(), pred);
+      m_wheel_count -= events.end() - itr;
+      events.erase(itr, events.end());
+      if (events.empty())
+        m_occupied[i / 64] &= ~(u64(1) << (i % 64));
+    }
+
+    const auto itr = std::remove_if(m_overflow.begin(), m_overflow.end(), pred);
+    if (itr != m_overflow.end())
+    {
+      m_overflow.erase(itr, m_overflow.end());
+      std::make_heap(m_overflow.begin(), m_overflow.end(), Later);
+    }
+  }
+
+  void Clear()
+  {
+    for (Slot& slot : m_slots)
+      slot.events.clear();
+    m_occupied.fill(0);
+    m_overflow.clear();
+    m_wheel_count = 0;
+  }
+
+  // All pending events, in no particular order.
+  std::vector<Event> ToVector() const
+  {
+    std::vector<Event> events(m_overflow);
+    for (const Slot& slot : m_slots)
+      events.insert(events.end(), slot.events.begin(), slot.events.end());
+    return events;
+  }
+
+  void Assign(const std::vector<Event>& events)
+  {
+    Clear();
+    if (events.empty())
+      return;
+
+    m_base = AlignToSlot(std::min_element(events.begin(), events.end(), Earlier)->time);
+    for (const Event& event : events)
+      Push(event);
+  }
+
+private:
+  struct Slot
+  {
+    std::vector<Event> events;
+    bool sorted = true;
+  };
+
+  static bool Earlier(const Event& left, const Event& right)
+  {
+    return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
+  }
+  static bool Later(const Event& left, const Event& right) { return Earlier(right, left); }
+
+  static s64 AlignToSlot(s64 time) { return time & ~(SLOT_CYCLES - 1); }
+  static size_t SlotIndex(s64 time) { return static_cast<size_t>(time >> SLOT_SHIFT) % NUM_SLOTS; }
+
+  void InsertIntoWheel(const Event& event)
+  {
+    const size_t index = SlotIndex(std::max(event.time, m_base));
+    Slot& slot = m_slots[index];
+    if (slot.events.empty())
+      slot.sorted = true;
+    else if (slot.sorted && Earlier(slot.events.back(), event))
+      slot.sorted = false;
+    slot.events.push_back(event);
+    m_occupied[index / 64] |= u64(1) << (index % 64);
+    m_wheel_count++;
+  }
+
+  // Turns the wheel forward to the earliest occupied slot and returns its index.
+  size_t FindFrontSlot()
+  {
+    if (m_wheel_count == 0)
+    {
+      m_base = AlignToSlot(m_overflow.front().time);
+      PullFromOverflow();
+    }
+
+    const size_t start = SlotIndex(m_base);
+    if (m_occupied[start / 64] & (u64(1) << (start % 64)))
+      return start;
+
+    size_t distance = NUM_SLOTS;
+    for (size_t i = 0; i <= NUM_WORDS; ++i)
+    {
+      // The first word is visited twice: from the current slot up, and at the end of the loop
+      // for the slots below the current one.
+      const size_t word = (start / 64 + i) % NUM_WORDS;
+      u64 bits = m_occupied[word];
+      if (i == 0)
+        bits &= ~u64(0) << (start % 64);
+      if (bits)
+      {
+        const size_t index = word * 64 + LeastSignificantSetBit(bits);
+        distance = (index + NUM_SLOTS - start) % NUM_SLOTS;
+        break;
+      }
+    }
+
+    if (distance != 0)
+    {
+      m_base += static_cast<s64>(distance) * SLOT_CYCLES;
+      PullFromOverflow();
+    }
+    return SlotIndex(m_base);
+  }
+
+  // Moves overflow events that are now within the horizon into the wheel. They always land in
+  // slots behind the current one, so they can't change which slot is at the front.
+  void PullFromOverflow()
+  {
+    while (!m_overflow.empty() && m_overflow.front().time < m_base + HORIZON)
+    {
+      std::pop_heap(m_overflow.begin(), m_overflow.end(), Later);
+      InsertIntoWheel(m_overflow.back());
+      m_overflow.pop_back();
+    }
+  }
+
+  static constexpr size_t NUM_WORDS = NUM_SLOTS / 64;
+
+  std::array<Slot, NUM_SLOTS> m_slots;
+  std::array<u64, NUM_WORDS> m_occupied{};
+  std::vector<Event> m_overflow;
+  size_t m_wheel_count = 0;
+
+  // Start time of the current slot. No event in the wheel is due before the current slot ends
+  // unless it was already due when it was pushed.
+  s64 m_base = 0;
+};
+}  // namespace CoreTiming
@@ -829,6 +829,9 @@ static NANDCheckResult CheckNAND(IOS::HLE::Kernel& ios, bool repair)
     }
   }
 
+  if (repair)
+    es->InvalidateTitleIndex();
+
   return result;
 }
 
@@ -12,10 +12,12 @@
 #include "Common/CDUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/Thread.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/CISOBlob.h"
 #include "DiscIO/CompressedBlob.h"
+#include "DiscIO/DCZBlob.h"
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/DriveBlob.h"
 #include "DiscIO/FileBlob.h"
@@ -27,49 +29,77 @@ namespace DiscIO
 void SectorReader::SetSectorSize(int blocksize)
 {
   m_block_size = std::max(blocksize, 0);
+  ResetCache();
+}
+
+void SectorReader::SetChunkSize(int block_cnt)
+{
+  m_chunk_blocks = std::max(block_cnt, 1);
+  // Clear cache, the data arrays are resized when lines are filled
+  ResetCache();
+}
+
+void SectorReader::SetCacheSize(u64 bytes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const u64 line_size = std::max<u64>(static_cast<u64>(m_chunk_blocks) * m_block_size, 1);
+  m_cache.resize(std::max<u64>(bytes / line_size, MIN_CACHE_LINES));
+  m_cache.shrink_to_fit();
+  ResetCache();
+}
+
+void SectorReader::ResetCache()
+{
   for (auto& cache_entry : m_cache)
   {
     cache_entry.Reset();
-    cache_entry.data.resize(m_chunk_blocks * m_block_size);
+    cache_entry.data.clear();
   }
+  m_cache_index.clear();
 }
 
-void SectorReader::SetChunkSize(int block_cnt)
+SectorReader::~SectorReader()
 {
-  m_chunk_blocks = std::max(block_cnt, 1);
-  // Clear cache and resize the data arrays
-  SetSectorSize(m_block_size);
+  StopReadAhead();
 }
 
-SectorReader::~SectorReader()
+void SectorReader::StopReadAhead()
 {
+  if (!m_read_ahead_thread.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_read_ahead_mutex);
+    m_read_ahead_exiting = true;
+  }
+  m_read_ahead_cv.notify_one();
+  m_read_ahead_thread.join();
 }
 
 const SectorReader::Cache* SectorReader::FindCacheLine(u64 block_num)
 {
-  auto itr = std::find_if(m_cache.begin(), m_cache.end(),
-                          [&](const Cache& entry) { return entry.Contains(block_num); });
-  if (itr == m_cache.end())
+  auto itr = m_cache_index.find(block_num / m_chunk_blocks);
+  if (itr == m_cache_index.end())
+    return nullptr;
+
+  Cache& line = m_cache[itr->second];
+  if (!line.Contains(block_num))
     return nullptr;
 
-  itr->MarkUsed();
-  return &*itr;
+  line.last_used = ++m_cache_clock;
+  return &line;
 }
 
 SectorReader::Cache* SectorReader::GetEmptyCacheLine()
 {
-  Cache* oldest = &m_cache[0];
-  // Find the Least Recently Used cache line to replace.
-  std::for_each(m_cache.begin() + 1, m_cache.end(), [&](Cache& line) {
-    if (line.IsLessRecentlyUsedThan(*oldest))
-    {
-      oldest->ShiftLRU();
-      oldest = &line;
-      return;
-    }
-    line.ShiftLRU();
-  });
+  // Find the Least Recently Used cache line to replace. Empty lines are never used.
+  Cache* oldest = &*std::min_element(
+      m_cache.begin(), m_cache.end(),
+      [](const Cache& a, const Cache& b) { return a.last_used < b.last_used; });
+  if (oldest->last_used != 0)
+    m_cache_index.erase(oldest->block_idx / m_chunk_blocks);
   oldest->Reset();
+  oldest->data.resize(static_cast<size_t>(m_chunk_blocks) * m_block_size);
   return oldest;
 }
 
@@ -85,7 +115,10 @@ const SectorReader::Cache* SectorReader::GetCacheLine(u64 block_num)
   u32 blocks_read = ReadChunk(cache->data.data(), chunk_idx);
   if (!blocks_read)
     return nullptr;
-  cache->Fill(chunk_idx * m_chunk_blocks, blocks_read);
+  cache->block_idx = chunk_idx * m_chunk_blocks;
+  cache->num_blocks = blocks_read;
+  cache->last_used = ++m_cache_clock;
+  m_cache_index[chunk_idx] = cache - m_cache.data();
 
   // Secondary check for out-of-bounds read.
   // If we got less than m_chunk_blocks, we may still have missed.
@@ -96,6 +129,8 @@ const SectorReader::Cache* SectorReader::GetCacheLine(u64 block_num)
 
 bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
 {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
   u64 remain = size;
   u64 block = 0;
   u32 position_in_block = static_cast<u32>(offset % m_block_size);
@@ -124,6 +159,51 @@ bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
   return true;
 }
 
+void SectorReader::ReadAhead(u64 offset, u64 size)
+{
+  const u64 chunk_size = static_cast<u64>(m_chunk_blocks) * m_block_size;
+  if (chunk_size == 0 || size == 0 || offset >= GetDataSize())
+    return;
+
+  // Leave most of the cache to the data that was already read.
+  const u64 max_chunks = m_cache.size() / 2;
+  const u64 first_chunk = offset / chunk_size;
+  const u64 end_offset = std::min(offset + size, GetDataSize());
+  const u64 end_chunk =
+      std::min((end_offset + chunk_size - 1) / chunk_size, first_chunk + max_chunks);
+  {
+    std::lock_guard<std::mutex> lock(m_read_ahead_mutex);
+    m_read_ahead_next = first_chunk;
+    m_read_ahead_end = end_chunk;
+  }
+
+  if (!m_read_ahead_thread.joinable())
+    m_read_ahead_thread = std::thread(&SectorReader::ReadAheadThread, this);
+  m_read_ahead_cv.notify_one();
+}
+
+void SectorReader::ReadAheadThread()
+{
+  Common::SetCurrentThreadName("Disc read-ahead");
+
+  while (true)
+  {
+    u64 chunk;
+    {
+      std::unique_lock<std::mutex> lock(m_read_ahead_mutex);
+      m_read_ahead_cv.wait(
+          lock, [this] { return m_read_ahead_exiting || m_read_ahead_next < m_read_ahead_end; });
+      if (m_read_ahead_exiting)
+        return;
+      chunk = m_read_ahead_next++;
+    }
+
+    // One chunk at a time, so reads only ever wait for a single chunk to be decoded.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    GetCacheLine(chunk * m_chunk_blocks);
+  }
+}
+
 // Crap default implementation if not overridden.
 bool SectorReader::ReadMultipleAlignedBlocks(u64 block_num, u64 cnt_blocks, u8* out_ptr)
 {
@@ -196,6 +276,8 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
   {
   case CISO_MAGIC:
     return CISOFileReader::Create(std::move(file));
+  case DCZ_MAGIC:
+    return DCZBlobReader::Create(std::move(file), filename);
   case GCZ_MAGIC:
     return CompressedBlobReader::Create(std::move(file), filename);
   case TGC_MAGIC:
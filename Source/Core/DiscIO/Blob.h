@@ -15,9 +15,13 @@
 // automatically do the right thing.
 
 #include <array>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -34,7 +38,8 @@ enum class BlobType
   GCZ,
   CISO,
   WBFS,
-  TGC
+  TGC,
+  DCZ
 };
 
 class BlobReader
@@ -62,6 +67,17 @@ public:
     return false;
   }
 
+  // Returns a pointer to the given range if the reader keeps all of its data in memory, for
+  // example in a mapping of the file, and nullptr otherwise. Unlike the other functions, this
+  // may be called from any thread, and the pointer is valid as long as the reader exists.
+  virtual const u8* GetMappedData(u64 offset, u64 size) const { return nullptr; }
+
+  // Hints that the given range will be read soon. Readers that have to decode blocks may load
+  // them into their cache in the background.
+  virtual void ReadAhead(u64 offset, u64 size) {}
+  // How many bytes of decoded blocks readers that have to decode blocks may keep around.
+  virtual void SetCacheSize(u64 bytes) {}
+
 protected:
   BlobReader() {}
 };
@@ -69,12 +85,16 @@ protected:
 // Provides caching and byte-operation-to-block-operations facilities.
 // Used for compressed blob and direct drive reading.
 // NOTE: GetDataSize() is expected to be evenly divisible by the sector size.
+// Reads and read-ahead may run on different threads, they are serialized internally.
 class SectorReader : public BlobReader
 {
 public:
   virtual ~SectorReader() = 0;
 
   bool Read(u64 offset, u64 size, u8* out_ptr) override;
+  // Both have to be called from the same thread.
+  void ReadAhead(u64 offset, u64 size) override;
+  void SetCacheSize(u64 bytes) override;
 
 protected:
   void SetSectorSize(int blocksize);
@@ -94,40 +114,26 @@ protected:
   // overridden in derived classes where possible.
   virtual bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr);
 
+  // The read-ahead thread calls GetBlock, so derived classes that used ReadAhead
+  // must stop it in their destructor, before their own members are destroyed.
+  void StopReadAhead();
+
 private:
   struct Cache
   {
     std::vector<u8> data;
     u64 block_idx = 0;
     u32 num_blocks = 0;
-
-    // [Pseudo-] Least Recently Used Shift Register
-    // When an empty cache line is needed, the line with the lowest value
-    // is taken and reset; the LRU register is then shifted down 1 place
-    // on all lines (low bit discarded). When a line is used, the high bit
-    // is set marking it as most recently used.
-    u32 lru_sreg = 0;
+    // Value of m_cache_clock when the line was last used, zero for empty lines.
+    u64 last_used = 0;
 
     void Reset()
     {
       block_idx = 0;
       num_blocks = 0;
-      lru_sreg = 0;
-    }
-    void Fill(u64 block, u32 count)
-    {
-      block_idx = block;
-      num_blocks = count;
-      // NOTE: Setting only the high bit means the newest line will
-      //   be selected for eviction if every line in the cache was
-      //   touched. This gives MRU behavior which is probably
-      //   desirable in that case.
-      MarkUsed();
+      last_used = 0;
     }
     bool Contains(u64 block) const { return block >= block_idx && block - block_idx < num_blocks; }
-    void MarkUsed() { lru_sreg |= 0x80000000; }
-    void ShiftLRU() { lru_sreg >>= 1; }
-    bool IsLessRecentlyUsedThan(const Cache& other) const { return lru_sreg < other.lru_sreg; }
   };
 
   // Gets the cache line that contains the given block, or nullptr.
@@ -142,16 +148,34 @@ private:
   // May return nullptr only if the cache missed and the read failed.
   const Cache* GetCacheLine(u64 block_num);
 
+  void ResetCache();
+  void ReadAheadThread();
+
   // Read all bytes from a chunk of blocks into a buffer.
   // Returns the number of blocks read (may be less than m_chunk_blocks
   // if chunk_num is the last chunk on the disk and the disk size is not
   // evenly divisible into chunks). Returns zero if it fails.
   u32 ReadChunk(u8* buffer, u64 chunk_num);
 
-  static constexpr int CACHE_LINES = 32;
+  static constexpr size_t DEFAULT_CACHE_LINES = 32;
+  static constexpr size_t MIN_CACHE_LINES = 8;
   u32 m_block_size = 0;    // Bytes in a sector/block
   u32 m_chunk_blocks = 1;  // Number of sectors/blocks in a chunk
-  std::array<Cache, CACHE_LINES> m_cache;
+  std::vector<Cache> m_cache = std::vector<Cache>(DEFAULT_CACHE_LINES);
+  // Chunk number -> index in m_cache
+  std::unordered_map<u64, size_t> m_cache_index;
+  u64 m_cache_clock = 0;
+  // Guards the cache and the GetBlock calls.
+  std::mutex m_mutex;
+
+  // Chunks [m_read_ahead_next, m_read_ahead_end) are still to be loaded. New hints replace
+  // older ones.
+  std::thread m_read_ahead_thread;
+  std::mutex m_read_ahead_mutex;
+  std::condition_variable m_read_ahead_cv;
+  u64 m_read_ahead_next = 0;
+  u64 m_read_ahead_end = 0;
+  bool m_read_ahead_exiting = false;
 };
 
 // Factory function - examines the path to choose the right type of BlobReader, and returns one.
@@ -162,6 +186,10 @@ typedef bool (*CompressCB)(const std::string& text, float percent, void* arg);
 bool CompressFileToBlob(const std::string& infile_path, const std::string& outfile_path,
                         u32 sub_type = 0, int sector_size = 16384, CompressCB callback = nullptr,
                         void* arg = nullptr);
+// Converts any disc image to DCZ, compressing on every core.
+bool ConvertToDCZ(const std::string& infile_path, const std::string& outfile_path,
+                  CompressCB callback = nullptr, void* arg = nullptr);
+// Decompresses GCZ and DCZ files.
 bool DecompressBlobToFile(const std::string& infile_path, const std::string& outfile_path,
                           CompressCB callback = nullptr, void* arg = nullptr);
 
@@ -53,9 +53,20 @@ bool CISOFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   {
     u64 const block = offset / m_block_size;
     u64 const data_offset = offset % m_block_size;
-    u64 const bytes_to_read = std::min(m_block_size - data_offset, nbytes);
+    const bool used = block < CISO_MAP_SIZE && UNUSED_BLOCK_ID != m_ciso_map[block];
+
+    // Handle the following blocks in the same step if they are stored right after this one,
+    // or are all unused, so that large reads need few host reads
+    u64 end_block = block + 1;
+    while (end_block * m_block_size < offset + nbytes && end_block < CISO_MAP_SIZE &&
+           (used ? m_ciso_map[end_block] == m_ciso_map[end_block - 1] + 1 :
+                   m_ciso_map[end_block] == UNUSED_BLOCK_ID))
+    {
+      ++end_block;
+    }
+    u64 const bytes_to_read = std::min(end_block * m_block_size - offset, nbytes);
 
-    if (block < CISO_MAP_SIZE && UNUSED_BLOCK_ID != m_ciso_map[block])
+    if (used)
     {
       // calculate the base address
       u64 const file_off = CISO_HEADER_SIZE + m_ciso_map[block] * (u64)m_block_size + data_offset;
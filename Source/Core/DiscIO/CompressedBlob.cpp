@@ -70,6 +70,7 @@ std::unique_ptr<CompressedBlobReader> CompressedBlobReader::Create(File::IOFile
 
 CompressedBlobReader::~CompressedBlobReader()
 {
+  StopReadAhead();
 }
 
 // IMPORTANT: Calling this function invalidates all earlier pointers gotten from this function.
@@ -337,21 +338,16 @@ bool CompressFileToBlob(const std::string& infile_path, const std::string& outfi
 bool DecompressBlobToFile(const std::string& infile_path, const std::string& outfile_path,
                           CompressCB callback, void* arg)
 {
-  std::unique_ptr<CompressedBlobReader> reader;
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
   {
-    File::IOFile infile(infile_path, "rb");
-    if (!IsGCZBlob(infile))
-    {
-      PanicAlertT("File not compressed");
-      return false;
-    }
-
-    reader = CompressedBlobReader::Create(std::move(infile), infile_path);
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
   }
 
-  if (!reader)
+  if (reader->GetBlobType() != BlobType::GCZ && reader->GetBlobType() != BlobType::DCZ)
   {
-    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    PanicAlertT("File not compressed");
     return false;
   }
 
@@ -365,12 +361,11 @@ bool DecompressBlobToFile(const std::string& infile_path, const std::string& out
     return false;
   }
 
-  const CompressedBlobHeader& header = reader->GetHeader();
-  static const size_t BUFFER_BLOCKS = 32;
-  size_t buffer_size = header.block_size * BUFFER_BLOCKS;
-  size_t last_buffer_size = header.block_size * (header.num_blocks % BUFFER_BLOCKS);
-  std::vector<u8> buffer(buffer_size);
-  u32 num_buffers = (header.num_blocks + BUFFER_BLOCKS - 1) / BUFFER_BLOCKS;
+  // A multiple of the GCZ and DCZ block sizes
+  static const size_t BUFFER_SIZE = 0x400000;
+  const u64 data_size = reader->GetDataSize();
+  std::vector<u8> buffer(BUFFER_SIZE);
+  u32 num_buffers = static_cast<u32>((data_size + BUFFER_SIZE - 1) / BUFFER_SIZE);
   int progress_monitor = std::max<int>(1, num_buffers / 100);
   bool success = true;
 
@@ -385,8 +380,14 @@ bool DecompressBlobToFile(const std::string& infile_path, const std::string& out
         break;
       }
     }
-    const size_t sz = i == num_buffers - 1 ? last_buffer_size : buffer_size;
-    reader->Read(i * buffer_size, sz, buffer.data());
+    const size_t sz =
+        static_cast<size_t>(std::min<u64>(BUFFER_SIZE, data_size - i * BUFFER_SIZE));
+    if (!reader->Read(i * BUFFER_SIZE, sz, buffer.data()))
+    {
+      PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+      success = false;
+      break;
+    }
     if (!outfile.WriteBytes(buffer.data(), sz))
     {
       PanicAlertT("Failed to write the output file \"%s\".\n"
@@ -403,10 +404,6 @@ bool DecompressBlobToFile(const std::string& infile_path, const std::string& out
     outfile.Close();
     File::Delete(outfile_path);
   }
-  else
-  {
-    outfile.Resize(header.data_size);
-  }
 
   return success;
 }
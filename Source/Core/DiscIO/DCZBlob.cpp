@@ -0,0 +1,393 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zlib.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DCZBlob.h"
+
+namespace DiscIO
+{
+namespace
+{
+// The lags of the padding generator, in bytes: x[n] = x[n - 521] ^ x[n - 32] on 32-bit words.
+constexpr u32 LFG_LONG_LAG = 521 * sizeof(u32);
+constexpr u32 LFG_SHORT_LAG = 32 * sizeof(u32);
+// Shorter runs aren't worth a table entry.
+constexpr u32 MIN_JUNK_RUN = 0x1000;
+constexpr u32 MAX_CHUNK_SIZE = 0x1000000;
+
+struct JunkRun
+{
+  u32 begin;
+  u32 end;
+};
+
+std::vector<JunkRun> FindJunkRuns(const u8* data, u32 size)
+{
+  std::vector<JunkRun> runs;
+  u32 run_begin = LFG_LONG_LAG;
+  for (u32 i = LFG_LONG_LAG; i <= size; ++i)
+  {
+    if (i < size && data[i] == (data[i - LFG_LONG_LAG] ^ data[i - LFG_SHORT_LAG]))
+      continue;
+
+    if (i - run_begin >= MIN_JUNK_RUN)
+      runs.push_back({run_begin, i});
+    run_begin = i + 1;
+  }
+  return runs;
+}
+
+void RegenerateJunk(u8* data, u32 begin, u32 end)
+{
+  // Every byte depends only on bytes at least LFG_SHORT_LAG back, so eight can be done at once.
+  u32 i = begin;
+  for (; i + sizeof(u64) <= end; i += sizeof(u64))
+  {
+    u64 long_lag, short_lag;
+    std::memcpy(&long_lag, &data[i - LFG_LONG_LAG], sizeof(u64));
+    std::memcpy(&short_lag, &data[i - LFG_SHORT_LAG], sizeof(u64));
+    const u64 value = long_lag ^ short_lag;
+    std::memcpy(&data[i], &value, sizeof(u64));
+  }
+  for (; i < end; ++i)
+    data[i] = data[i - LFG_LONG_LAG] ^ data[i - LFG_SHORT_LAG];
+}
+
+struct StoredChunk
+{
+  std::vector<u8> data;
+  bool compressed;
+};
+
+void CompressChunk(const u8* data, u32 chunk_size, std::vector<u8>* scratch, StoredChunk* out)
+{
+  const std::vector<JunkRun> runs = FindJunkRuns(data, chunk_size);
+  scratch->assign(data, data + chunk_size);
+  for (const JunkRun& run : runs)
+    std::fill(scratch->begin() + run.begin, scratch->begin() + run.end, 0);
+
+  const u32 run_count = static_cast<u32>(runs.size());
+  const size_t table_size = sizeof(u32) + sizeof(JunkRun) * run_count;
+  uLongf compressed_size = compressBound(chunk_size);
+  out->data.resize(table_size + compressed_size);
+  std::memcpy(out->data.data(), &run_count, sizeof(u32));
+  std::memcpy(out->data.data() + sizeof(u32), runs.data(), sizeof(JunkRun) * run_count);
+
+  const int status = compress2(out->data.data() + table_size, &compressed_size, scratch->data(),
+                               chunk_size, Z_BEST_COMPRESSION);
+  if (status != Z_OK || table_size + compressed_size >= chunk_size)
+  {
+    out->data.assign(data, data + chunk_size);
+    out->compressed = false;
+    return;
+  }
+  out->data.resize(table_size + compressed_size);
+  out->compressed = true;
+}
+
+// Chunks are read in batches on the calling thread and compressed on the thread pool, while the
+// next batch is read.
+struct Batch
+{
+  u32 first_chunk = 0;
+  u32 count = 0;
+  std::vector<u8> input;
+  std::vector<StoredChunk> output;
+  std::atomic<u32> next_chunk{0};
+};
+
+void CompressBatch(Batch* batch, u32 chunk_size)
+{
+  std::vector<u8> scratch;
+  u32 i;
+  while ((i = batch->next_chunk++) < batch->count)
+    CompressChunk(&batch->input[static_cast<size_t>(i) * chunk_size], chunk_size, &scratch,
+                  &batch->output[i]);
+}
+
+bool ReadBatch(BlobReader* reader, const DCZHeader& header, u32 first_chunk, u32 max_chunks,
+               Batch* batch)
+{
+  batch->first_chunk = first_chunk;
+  batch->count = std::min(max_chunks, header.num_chunks - first_chunk);
+  batch->output.resize(batch->count);
+
+  const u64 offset = static_cast<u64>(first_chunk) * header.chunk_size;
+  const size_t batch_size = static_cast<size_t>(batch->count) * header.chunk_size;
+  const size_t read_size =
+      static_cast<size_t>(std::min<u64>(batch_size, header.data_size - offset));
+  batch->input.resize(batch_size);
+  std::fill(batch->input.begin() + read_size, batch->input.end(), 0);
+  return reader->Read(offset, read_size, batch->input.data());
+}
+}  // namespace
+
+DCZBlobReader::DCZBlobReader(File::IOFile file, const std::string& filename,
+                             const DCZHeader& header, std::vector<DCZChunkEntry> chunks)
+    : m_header(header), m_chunks(std::move(chunks)), m_file(std::move(file)),
+      m_file_name(filename)
+{
+  m_file_size = m_file.GetSize();
+  // Chunks that don't get smaller are stored uncompressed.
+  m_buffer.resize(m_header.chunk_size);
+  SetSectorSize(m_header.chunk_size);
+}
+
+DCZBlobReader::~DCZBlobReader()
+{
+  StopReadAhead();
+}
+
+std::unique_ptr<DCZBlobReader> DCZBlobReader::Create(File::IOFile file,
+                                                     const std::string& filename)
+{
+  if (!IsDCZBlob(file))
+    return nullptr;
+
+  DCZHeader header;
+  if (!file.Seek(0, SEEK_SET) || !file.ReadArray(&header, 1))
+    return nullptr;
+
+  if (header.version != DCZ_VERSION || header.compression != DCZCompression::Deflate ||
+      header.chunk_size == 0 || header.chunk_size > MAX_CHUNK_SIZE ||
+      header.num_chunks != (header.data_size + header.chunk_size - 1) / header.chunk_size)
+  {
+    return nullptr;
+  }
+
+  std::vector<DCZChunkEntry> chunks(header.num_chunks);
+  if (!file.ReadArray(chunks.data(), chunks.size()))
+    return nullptr;
+
+  return std::unique_ptr<DCZBlobReader>(
+      new DCZBlobReader(std::move(file), filename, header, std::move(chunks)));
+}
+
+bool DCZBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  if (block_num >= m_chunks.size())
+    return false;
+
+  const DCZChunkEntry& chunk = m_chunks[block_num];
+  const bool compressed = !(chunk.stored_size & DCZ_STORED_UNCOMPRESSED);
+  const u32 stored_size = chunk.stored_size & ~DCZ_STORED_UNCOMPRESSED;
+  if (compressed ? stored_size > m_buffer.size() : stored_size != m_header.chunk_size)
+  {
+    PanicAlertT("The disc image \"%s\" is corrupt.", m_file_name.c_str());
+    return false;
+  }
+
+  // Uncompressed chunks go straight to the output.
+  u8* const stored = compressed ? m_buffer.data() : out_ptr;
+  if (!m_file.Seek(chunk.offset, SEEK_SET) || !m_file.ReadBytes(stored, stored_size))
+  {
+    PanicAlertT("The disc image \"%s\" is truncated, some of the data is missing.",
+                m_file_name.c_str());
+    m_file.Clear();
+    return false;
+  }
+
+  const u32 hash = HashAdler32(stored, stored_size);
+  if (hash != chunk.hash)
+  {
+    PanicAlertT("The disc image \"%s\" is corrupt.\n"
+                "Hash of block %" PRIu64 " is %08x instead of %08x.",
+                m_file_name.c_str(), block_num, hash, chunk.hash);
+    return false;
+  }
+
+  if (!compressed)
+    return true;
+
+  u32 run_count;
+  std::memcpy(&run_count, stored, sizeof(u32));
+  if (stored_size < sizeof(u32) || run_count > (stored_size - sizeof(u32)) / sizeof(JunkRun))
+  {
+    PanicAlertT("The disc image \"%s\" is corrupt.", m_file_name.c_str());
+    return false;
+  }
+  const size_t table_size = sizeof(u32) + sizeof(JunkRun) * run_count;
+
+  uLongf uncompressed_size = m_header.chunk_size;
+  if (uncompress(out_ptr, &uncompressed_size, stored + table_size,
+                 static_cast<uLong>(stored_size - table_size)) != Z_OK ||
+      uncompressed_size != m_header.chunk_size)
+  {
+    PanicAlert("Failure reading block %" PRIu64 " - decompression failed.", block_num);
+    return false;
+  }
+
+  u32 previous_end = LFG_LONG_LAG;
+  for (u32 i = 0; i < run_count; ++i)
+  {
+    JunkRun run;
+    std::memcpy(&run, stored + sizeof(u32) + sizeof(JunkRun) * i, sizeof(JunkRun));
+    if (run.begin < previous_end || run.begin > run.end || run.end > m_header.chunk_size)
+    {
+      PanicAlertT("The disc image \"%s\" is corrupt.", m_file_name.c_str());
+      return false;
+    }
+    RegenerateJunk(out_ptr, run.begin, run.end);
+    previous_end = run.end;
+  }
+  return true;
+}
+
+bool ConvertToDCZ(const std::string& infile_path, const std::string& outfile_path,
+                  CompressCB callback, void* arg)
+{
+  std::unique_ptr<BlobReader> reader = CreateBlobReader(infile_path);
+  if (!reader)
+  {
+    PanicAlertT("Failed to open the input file \"%s\".", infile_path.c_str());
+    return false;
+  }
+  if (reader->GetBlobType() == BlobType::DCZ)
+  {
+    PanicAlertT("\"%s\" is already compressed! Cannot compress it further.", infile_path.c_str());
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertT("Failed to open the output file \"%s\".\n"
+                "Check that you have permissions to write the target folder and that the media can "
+                "be written.",
+                outfile_path.c_str());
+    return false;
+  }
+
+  callback(GetStringT("Files opened, ready to compress."), 0, arg);
+
+  DCZHeader header = {};
+  header.magic = DCZ_MAGIC;
+  header.version = DCZ_VERSION;
+  header.compression = DCZCompression::Deflate;
+  header.chunk_size = DCZ_DEFAULT_CHUNK_SIZE;
+  header.data_size = reader->GetDataSize();
+  header.num_chunks =
+      static_cast<u32>((header.data_size + header.chunk_size - 1) / header.chunk_size);
+
+  std::vector<DCZChunkEntry> chunks(header.num_chunks);
+  u64 position = sizeof(DCZHeader) + sizeof(DCZChunkEntry) * chunks.size();
+  // seek past the header and the chunk index (we will write them at the end)
+  outfile.Seek(position, SEEK_SET);
+
+  const u32 num_tasks = static_cast<u32>(Common::ThreadPool::GetThreadCount());
+  const u32 batch_chunks = num_tasks * 4;
+  Batch batches[2];
+  Batch* current = &batches[0];
+  Batch* next = &batches[1];
+  bool success = true;
+
+  if (header.num_chunks != 0 && !ReadBatch(reader.get(), header, 0, batch_chunks, current))
+  {
+    PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+    success = false;
+  }
+
+  while (success && current->count != 0)
+  {
+    const u64 read_position = static_cast<u64>(current->first_chunk) * header.chunk_size;
+    const int ratio = read_position != 0 ? static_cast<int>(100 * position / read_position) : 0;
+    const std::string text =
+        StringFromFormat(GetStringT("%i of %i blocks. Compression ratio %i%%").c_str(),
+                         current->first_chunk, header.num_chunks, ratio);
+    if (!callback(text, static_cast<float>(current->first_chunk) / header.num_chunks, arg))
+    {
+      success = false;
+      break;
+    }
+
+    current->next_chunk = 0;
+    Common::TaskGroup workers;
+    for (u32 i = 0; i < num_tasks; ++i)
+      workers.Run([current, &header] { CompressBatch(current, header.chunk_size); });
+
+    const u32 next_first_chunk = current->first_chunk + current->count;
+    next->count = 0;
+    const bool read_ok =
+        next_first_chunk == header.num_chunks ||
+        ReadBatch(reader.get(), header, next_first_chunk, batch_chunks, next);
+
+    workers.Wait();
+
+    if (!read_ok)
+    {
+      PanicAlertT("Failed to read from the input file \"%s\".", infile_path.c_str());
+      success = false;
+      break;
+    }
+
+    for (u32 i = 0; i < current->count; ++i)
+    {
+      const StoredChunk& stored = current->output[i];
+      const u32 stored_size = static_cast<u32>(stored.data.size());
+      DCZChunkEntry& entry = chunks[current->first_chunk + i];
+      entry.offset = position;
+      entry.stored_size = stored.compressed ? stored_size : stored_size | DCZ_STORED_UNCOMPRESSED;
+      entry.hash = HashAdler32(stored.data.data(), stored_size);
+
+      if (!outfile.WriteBytes(stored.data.data(), stored_size))
+      {
+        PanicAlertT("Failed to write the output file \"%s\".\n"
+                    "Check that you have enough space available on the target drive.",
+                    outfile_path.c_str());
+        success = false;
+        break;
+      }
+      position += stored_size;
+    }
+
+    std::swap(current, next);
+  }
+
+  if (!success)
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  // Okay, go back and fill in headers
+  outfile.Seek(0, SEEK_SET);
+  outfile.WriteArray(&header, 1);
+  outfile.WriteArray(chunks.data(), chunks.size());
+
+  callback(GetStringT("Done compressing disc image."), 1.0f, arg);
+  return true;
+}
+
+bool IsDCZBlob(File::IOFile& file)
+{
+  const u64 position = file.Tell();
+  if (!file.Seek(0, SEEK_SET))
+    return false;
+  u32 magic;
+  const bool is_dcz = file.ReadArray(&magic, 1) && magic == DCZ_MAGIC;
+  file.Seek(position, SEEK_SET);
+  return is_dcz;
+}
+
+}  // namespace
@@ -0,0 +1,88 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// WARNING Code not big-endian safe.
+
+// To create new DCZ files, use ConvertToDCZ.
+
+// File format
+// * Header
+// * [Chunk index: file offset, stored size and hash of every chunk]
+// * [Chunks]
+//
+// Every chunk is compressed on its own so any part of the disc can be read by decompressing a
+// single chunk. A compressed chunk starts with a table of junk runs: ranges where every byte is
+// the XOR of the bytes 2084 and 128 positions before it. That is the lagged Fibonacci generator
+// Nintendo uses for the padding on GC and Wii discs, so those ranges are zeroed before
+// compression and regenerated from the preceding data on read, without knowing the seeds.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+static constexpr u32 DCZ_MAGIC = 0x015A4344;  // "DCZ\1"
+static constexpr u32 DCZ_VERSION = 1;
+static constexpr u32 DCZ_DEFAULT_CHUNK_SIZE = 0x20000;
+
+// Every chunk of a file uses the same method.
+enum class DCZCompression : u32
+{
+  Deflate = 1,
+};
+
+struct DCZHeader  // 32 bytes
+{
+  u32 magic;
+  u32 version;
+  DCZCompression compression;
+  u32 chunk_size;
+  u64 data_size;
+  u32 num_chunks;
+  u32 reserved;
+};
+
+struct DCZChunkEntry  // 16 bytes
+{
+  u64 offset;
+  // The top bit is set for chunks that are stored uncompressed.
+  u32 stored_size;
+  u32 hash;
+};
+
+static constexpr u32 DCZ_STORED_UNCOMPRESSED = 0x80000000;
+
+class DCZBlobReader : public SectorReader
+{
+public:
+  static std::unique_ptr<DCZBlobReader> Create(File::IOFile file, const std::string& filename);
+  ~DCZBlobReader();
+
+  BlobType GetBlobType() const override { return BlobType::DCZ; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  u64 GetRawSize() const override { return m_file_size; }
+  bool GetBlock(u64 block_num, u8* out_ptr) override;
+
+private:
+  DCZBlobReader(File::IOFile file, const std::string& filename, const DCZHeader& header,
+                std::vector<DCZChunkEntry> chunks);
+
+  DCZHeader m_header;
+  std::vector<DCZChunkEntry> m_chunks;
+  File::IOFile m_file;
+  u64 m_file_size;
+  std::vector<u8> m_buffer;
+  std::string m_file_name;
+};
+
+bool IsDCZBlob(File::IOFile& file);
+
+}  // namespace
@@ -28,6 +28,7 @@
 #include "Common/Swap.h"
 #include "Core/Boot/DolReader.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/FileBlob.h"
 #include "DiscIO/VolumeWii.h"
 
 namespace DiscIO
@@ -58,6 +59,39 @@ constexpr u8 ENTRY_SIZE = 0x0c;
 constexpr u8 FILE_ENTRY = 0;
 constexpr u8 DIRECTORY_ENTRY = 1;
 
+BlobReader* OpenFileCache::Get(const std::string& path)
+{
+  for (Entry& entry : m_entries)
+  {
+    if (entry.path == path)
+    {
+      entry.last_used = ++m_clock;
+      return entry.reader.get();
+    }
+  }
+
+  std::unique_ptr<BlobReader> reader = PlainFileReader::Create(File::IOFile(path, "rb"));
+  if (!reader)
+    return nullptr;
+
+  Entry* entry;
+  if (m_entries.size() < MAX_OPEN_FILES)
+  {
+    m_entries.emplace_back();
+    entry = &m_entries.back();
+  }
+  else
+  {
+    entry = &*std::min_element(
+        m_entries.begin(), m_entries.end(),
+        [](const Entry& a, const Entry& b) { return a.last_used < b.last_used; });
+  }
+  entry->path = path;
+  entry->reader = std::move(reader);
+  entry->last_used = ++m_clock;
+  return entry->reader.get();
+}
+
 DiscContent::DiscContent(u64 offset, u64 size, const std::string& path)
     : m_offset(offset), m_size(size), m_content_source(path)
 {
@@ -87,7 +121,7 @@ u64 DiscContent::GetSize() const
   return m_size;
 }
 
-bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
+bool DiscContent::Read(u64* offset, u64* length, u8** buffer, OpenFileCache* open_files) const
 {
   if (m_size == 0)
     return true;
@@ -101,9 +135,8 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
 
     if (std::holds_alternative<std::string>(m_content_source))
     {
-      File::IOFile file(std::get<std::string>(m_content_source), "rb");
-      file.Seek(offset_in_content, SEEK_SET);
-      if (!file.ReadBytes(*buffer, bytes_to_read))
+      BlobReader* file = open_files->Get(std::get<std::string>(m_content_source));
+      if (!file || !file->Read(offset_in_content, bytes_to_read, *buffer))
         return false;
     }
     else
@@ -156,7 +189,7 @@ bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
     // Zero fill to start of DiscContent data
     PadToAddress(it->GetOffset(), &offset, &length, &buffer);
 
-    if (!it->Read(&offset, &length, &buffer))
+    if (!it->Read(&offset, &length, &buffer, &m_open_files))
       return false;
 
     ++it;
@@ -728,18 +761,20 @@ void DirectoryBlobPartition::WriteDirectory(const File::FSTEntry& parent_entry,
                                             u32* name_offset, u64* data_offset,
                                             u32 parent_entry_index, u64 name_table_offset)
 {
-  std::vector<File::FSTEntry> sorted_entries = parent_entry.children;
-
-  // Sort for determinism
-  std::sort(sorted_entries.begin(), sorted_entries.end(), [](const File::FSTEntry& one,
-                                                             const File::FSTEntry& two) {
-    const std::string one_upper = ASCIIToUppercase(one.virtualName);
-    const std::string two_upper = ASCIIToUppercase(two.virtualName);
-    return one_upper == two_upper ? one.virtualName < two.virtualName : one_upper < two_upper;
+  // Sort for determinism. Only pointers are sorted, since copying the entries would copy
+  // the whole subtree, and every name is converted to uppercase once.
+  std::vector<std::pair<std::string, const File::FSTEntry*>> sorted_entries;
+  sorted_entries.reserve(parent_entry.children.size());
+  for (const File::FSTEntry& entry : parent_entry.children)
+    sorted_entries.emplace_back(ASCIIToUppercase(entry.virtualName), &entry);
+  std::sort(sorted_entries.begin(), sorted_entries.end(), [](const auto& one, const auto& two) {
+    return one.first == two.first ? one.second->virtualName < two.second->virtualName :
+                                    one.first < two.first;
   });
 
-  for (const File::FSTEntry& entry : sorted_entries)
+  for (const auto& sorted_entry : sorted_entries)
   {
+    const File::FSTEntry& entry = *sorted_entry.second;
     if (entry.isDirectory)
     {
       u32 entry_index = *fst_offset / ENTRY_SIZE;
@@ -30,6 +30,28 @@ enum class PartitionType : u32;
 // Returns true if the path is inside a DirectoryBlob and doesn't represent the DirectoryBlob itself
 bool ShouldHideFromGameList(const std::string& volume_path);
 
+// Keeps the most recently read files open, so that reads don't have to open them again.
+// Files are read through PlainFileReader, which maps them into memory when it can.
+class OpenFileCache
+{
+public:
+  // Returns nullptr if the file can't be opened.
+  BlobReader* Get(const std::string& path);
+
+private:
+  struct Entry
+  {
+    std::string path;
+    std::unique_ptr<BlobReader> reader;
+    // Value of m_clock when the file was last used
+    u64 last_used = 0;
+  };
+
+  static constexpr size_t MAX_OPEN_FILES = 16;
+  std::vector<Entry> m_entries;
+  u64 m_clock = 0;
+};
+
 class DiscContent
 {
 public:
@@ -44,7 +66,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, OpenFileCache* open_files) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -75,6 +97,7 @@ public:
 
 private:
   std::set<DiscContent> m_contents;
+  mutable OpenFileCache m_open_files;
 };
 
 class DirectoryBlobPartition
@@ -10,10 +10,13 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/File.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
 {
+// Reads through a memory mapping of the whole file when the OS allows it, and through
+// the file otherwise.
 class PlainFileReader : public BlobReader
 {
 public:
@@ -23,12 +26,17 @@ public:
   u64 GetDataSize() const override { return m_size; }
   u64 GetRawSize() const override { return m_size; }
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  const u8* GetMappedData(u64 offset, u64 nbytes) const override;
+  void ReadAhead(u64 offset, u64 size) override;
 
 private:
   PlainFileReader(File::IOFile file);
 
+  void MapFile();
+
   File::IOFile m_file;
   s64 m_size;
+  Common::MappedFile m_mapping;
 };
 
 }  // namespace
@@ -44,6 +44,13 @@ public:
   Volume() {}
   virtual ~Volume() {}
   virtual bool Read(u64 _Offset, u64 _Length, u8* _pBuffer, const Partition& partition) const = 0;
+  // See BlobReader::GetMappedData, BlobReader::ReadAhead and BlobReader::SetCacheSize
+  virtual const u8* GetMappedData(u64 offset, u64 length, const Partition& partition) const
+  {
+    return nullptr;
+  }
+  virtual void ReadAhead(u64 offset, u64 length, const Partition& partition) const {}
+  virtual void SetCacheSize(u64 bytes) {}
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset, const Partition& partition) const
   {
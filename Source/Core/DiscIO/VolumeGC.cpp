@@ -52,6 +52,25 @@ bool VolumeGC::Read(u64 _Offset, u64 _Length, u8* _pBuffer, const Partition& par
   return m_pReader->Read(_Offset, _Length, _pBuffer);
 }
 
+const u8* VolumeGC::GetMappedData(u64 offset, u64 length, const Partition& partition) const
+{
+  if (partition != PARTITION_NONE)
+    return nullptr;
+
+  return m_pReader->GetMappedData(offset, length);
+}
+
+void VolumeGC::ReadAhead(u64 offset, u64 length, const Partition& partition) const
+{
+  if (partition == PARTITION_NONE)
+    m_pReader->ReadAhead(offset, length);
+}
+
+void VolumeGC::SetCacheSize(u64 bytes)
+{
+  m_pReader->SetCacheSize(bytes);
+}
+
 const FileSystem* VolumeGC::GetFileSystem(const Partition& partition) const
 {
   return m_file_system->get();
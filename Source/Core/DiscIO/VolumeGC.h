@@ -32,6 +32,11 @@ public:
   ~VolumeGC();
   bool Read(u64 _Offset, u64 _Length, u8* _pBuffer,
             const Partition& partition = PARTITION_NONE) const override;
+  const u8* GetMappedData(u64 offset, u64 length,
+                          const Partition& partition = PARTITION_NONE) const override;
+  void ReadAhead(u64 offset, u64 length,
+                 const Partition& partition = PARTITION_NONE) const override;
+  void SetCacheSize(u64 bytes) override;
   const FileSystem* GetFileSystem(const Partition& partition = PARTITION_NONE) const override;
   std::string GetGameID(const Partition& partition = PARTITION_NONE) const override;
   std::string GetMakerID(const Partition& partition = PARTITION_NONE) const override;
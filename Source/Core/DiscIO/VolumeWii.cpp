@@ -19,6 +19,7 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -37,7 +38,7 @@ constexpr u64 PARTITION_DATA_OFFSET = 0x20000;
 
 VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
     : m_pReader(std::move(reader)), m_game_partition(PARTITION_NONE),
-      m_last_decrypted_block(UINT64_MAX)
+      m_block_cache(DECRYPTED_BLOCK_CACHE_SIZE)
 {
   ASSERT(m_pReader);
 
@@ -148,7 +149,6 @@ bool VolumeWii::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, const Partition
   if (!aes_context)
     return false;
 
-  std::vector<u8> read_buffer(BLOCK_TOTAL_SIZE);
   while (_Length > 0)
   {
     // Calculate offsets
@@ -156,30 +156,20 @@ bool VolumeWii::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, const Partition
         partition.offset + PARTITION_DATA_OFFSET + _ReadOffset / BLOCK_DATA_SIZE * BLOCK_TOTAL_SIZE;
     u64 data_offset_in_block = _ReadOffset % BLOCK_DATA_SIZE;
 
-    if (m_last_decrypted_block != block_offset_on_disc)
+    const DecryptedBlock* block = FindDecryptedBlock(block_offset_on_disc);
+    if (!block)
     {
-      // Read the current block
-      if (!m_pReader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.data()))
+      // Read all blocks that the rest of the request needs at once
+      const u64 blocks_left =
+          (data_offset_in_block + _Length + BLOCK_DATA_SIZE - 1) / BLOCK_DATA_SIZE;
+      if (!DecryptBlocks(block_offset_on_disc, blocks_left, aes_context))
         return false;
-
-      // Decrypt the block's data.
-      // 0x3D0 - 0x3DF in read_buffer will be overwritten,
-      // but that won't affect anything, because we won't
-      // use the content of read_buffer anymore after this
-      mbedtls_aes_crypt_cbc(aes_context, MBEDTLS_AES_DECRYPT, BLOCK_DATA_SIZE, &read_buffer[0x3D0],
-                            &read_buffer[BLOCK_HEADER_SIZE], m_last_decrypted_block_data);
-      m_last_decrypted_block = block_offset_on_disc;
-
-      // The only thing we currently use from the 0x000 - 0x3FF part
-      // of the block is the IV (at 0x3D0), but it also contains SHA-1
-      // hashes that IOS uses to check that discs aren't tampered with.
-      // http://wiibrew.org/wiki/Wii_Disc#Encrypted
+      block = FindDecryptedBlock(block_offset_on_disc);
     }
 
     // Copy the decrypted data
     u64 copy_size = std::min(_Length, BLOCK_DATA_SIZE - data_offset_in_block);
-    memcpy(_pBuffer, &m_last_decrypted_block_data[data_offset_in_block],
-           static_cast<size_t>(copy_size));
+    memcpy(_pBuffer, &block->data[data_offset_in_block], static_cast<size_t>(copy_size));
 
     // Update offsets
     _Length -= copy_size;
@@ -190,6 +180,93 @@ bool VolumeWii::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, const Partition
   return true;
 }
 
+const VolumeWii::DecryptedBlock* VolumeWii::FindDecryptedBlock(u64 offset_on_disc) const
+{
+  for (DecryptedBlock& block : m_block_cache)
+  {
+    if (block.last_used != 0 && block.offset_on_disc == offset_on_disc)
+    {
+      block.last_used = ++m_block_cache_clock;
+      return &block;
+    }
+  }
+  return nullptr;
+}
+
+bool VolumeWii::DecryptBlocks(u64 offset_on_disc, u64 num_blocks,
+                              mbedtls_aes_context* aes_context) const
+{
+  // Half of the cache, so that the blocks of one read don't evict each other
+  num_blocks = std::min<u64>(num_blocks, DECRYPTED_BLOCK_CACHE_SIZE / 2);
+  for (u64 i = 1; i < num_blocks; ++i)
+  {
+    if (FindDecryptedBlock(offset_on_disc + i * BLOCK_TOTAL_SIZE))
+    {
+      num_blocks = i;
+      break;
+    }
+  }
+
+  m_read_buffer.resize(num_blocks * BLOCK_TOTAL_SIZE);
+  if (!m_pReader->Read(offset_on_disc, m_read_buffer.size(), m_read_buffer.data()))
+    return false;
+
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    DecryptedBlock& block = *std::min_element(
+        m_block_cache.begin(), m_block_cache.end(),
+        [](const DecryptedBlock& a, const DecryptedBlock& b) { return a.last_used < b.last_used; });
+
+    // Decrypt the block's data.
+    // 0x3D0 - 0x3DF in the read buffer will be overwritten,
+    // but that won't affect anything, because we won't
+    // use the content of the read buffer anymore after this
+    u8* encrypted_block = &m_read_buffer[i * BLOCK_TOTAL_SIZE];
+    Common::AES::DecryptCBC(aes_context, &encrypted_block[0x3D0],
+                            &encrypted_block[BLOCK_HEADER_SIZE], block.data.data(),
+                            BLOCK_DATA_SIZE);
+    block.offset_on_disc = offset_on_disc + i * BLOCK_TOTAL_SIZE;
+    block.last_used = ++m_block_cache_clock;
+
+    // The only thing we currently use from the 0x000 - 0x3FF part
+    // of the block is the IV (at 0x3D0), but it also contains SHA-1
+    // hashes that IOS uses to check that discs aren't tampered with.
+    // http://wiibrew.org/wiki/Wii_Disc#Encrypted
+  }
+
+  return true;
+}
+
+const u8* VolumeWii::GetMappedData(u64 offset, u64 length, const Partition& partition) const
+{
+  // Partition data has to be decrypted
+  if (partition != PARTITION_NONE)
+    return nullptr;
+
+  return m_pReader->GetMappedData(offset, length);
+}
+
+void VolumeWii::ReadAhead(u64 offset, u64 length, const Partition& partition) const
+{
+  if (partition == PARTITION_NONE)
+  {
+    m_pReader->ReadAhead(offset, length);
+    return;
+  }
+
+  // The encrypted blocks that hold the data
+  const u64 data_offset = partition.offset + PARTITION_DATA_OFFSET;
+  const u64 first_block = offset / BLOCK_DATA_SIZE;
+  const u64 end_block = (offset + length + BLOCK_DATA_SIZE - 1) / BLOCK_DATA_SIZE;
+  m_pReader->ReadAhead(data_offset + first_block * BLOCK_TOTAL_SIZE,
+                       (end_block - first_block) * BLOCK_TOTAL_SIZE);
+}
+
+void VolumeWii::SetCacheSize(u64 bytes)
+{
+  m_pReader->SetCacheSize(bytes);
+}
+
 std::vector<Partition> VolumeWii::GetPartitions() const
 {
   std::vector<Partition> partitions;
@@ -384,7 +461,7 @@ bool VolumeWii::CheckIntegrity(const Partition& partition) const
       WARN_LOG(DISCIO, "Integrity Check: fail at cluster %d: could not read metadata", clusterID);
       return false;
     }
-    mbedtls_aes_crypt_cbc(aes_context, MBEDTLS_AES_DECRYPT, 0x400, IV, clusterMDCrypted, clusterMD);
+    Common::AES::DecryptCBC(aes_context, IV, clusterMDCrypted, clusterMD, 0x400);
 
     // Some clusters have invalid data and metadata because they aren't
     // meant to be read by the game (for example, holes between files). To
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <mbedtls/aes.h>
 #include <memory>
@@ -33,6 +34,9 @@ public:
   VolumeWii(std::unique_ptr<BlobReader> reader);
   ~VolumeWii();
   bool Read(u64 _Offset, u64 _Length, u8* _pBuffer, const Partition& partition) const override;
+  const u8* GetMappedData(u64 offset, u64 length, const Partition& partition) const override;
+  void ReadAhead(u64 offset, u64 length, const Partition& partition) const override;
+  void SetCacheSize(u64 bytes) override;
   std::vector<Partition> GetPartitions() const override;
   Partition GetGamePartition() const override;
   std::optional<u32> GetPartitionType(const Partition& partition) const override;
@@ -81,8 +85,23 @@ private:
   std::map<Partition, PartitionDetails> m_partitions;
   Partition m_game_partition;
 
-  mutable u64 m_last_decrypted_block;
-  mutable u8 m_last_decrypted_block_data[BLOCK_DATA_SIZE];
+  struct DecryptedBlock
+  {
+    u64 offset_on_disc = UINT64_MAX;
+    // Value of m_block_cache_clock when the block was last used, zero for empty entries.
+    u64 last_used = 0;
+    std::array<u8, BLOCK_DATA_SIZE> data;
+  };
+
+  const DecryptedBlock* FindDecryptedBlock(u64 offset_on_disc) const;
+  // Reads and decrypts up to num_blocks blocks, stopping early at blocks that are cached.
+  bool DecryptBlocks(u64 offset_on_disc, u64 num_blocks, mbedtls_aes_context* aes_context) const;
+
+  // Recently decrypted blocks, so that reads of nearby data don't decrypt them again.
+  static constexpr size_t DECRYPTED_BLOCK_CACHE_SIZE = 32;
+  mutable std::vector<DecryptedBlock> m_block_cache;
+  mutable u64 m_block_cache_clock = 0;
+  mutable std::vector<u8> m_read_buffer;
 };
 
 }  // namespace
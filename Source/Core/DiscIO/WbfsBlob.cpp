@@ -118,7 +118,7 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   while (nbytes)
   {
     u64 read_size;
-    File::IOFile& data_file = SeekToCluster(offset, &read_size);
+    File::IOFile& data_file = SeekToCluster(offset, nbytes, &read_size);
     if (read_size == 0)
       return false;
     read_size = std::min(read_size, nbytes);
@@ -137,7 +137,7 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   return true;
 }
 
-File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
+File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64 wanted, u64* available)
 {
   u64 base_cluster = (offset >> m_header.wbfs_sector_shift);
   if (base_cluster < m_blocks_per_disc)
@@ -155,6 +155,16 @@ File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
         {
           u64 till_end_of_file = file_entry.size - (final_address - file_entry.base_address);
           u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
+
+          // Include the following clusters that are stored right after this one
+          for (u64 cluster = base_cluster + 1;
+               till_end_of_sector < wanted && cluster < m_blocks_per_disc &&
+               m_wlba_table[cluster] == m_wlba_table[cluster - 1] + 1;
+               ++cluster)
+          {
+            till_end_of_sector += m_wbfs_sector_size;
+          }
+
           *available = std::min(till_end_of_file, till_end_of_sector);
         }
 
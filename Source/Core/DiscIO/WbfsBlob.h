@@ -39,7 +39,9 @@ private:
   bool AddFileToList(File::IOFile file);
   bool ReadHeader();
 
-  File::IOFile& SeekToCluster(u64 offset, u64* available);
+  // Seeks to the given offset. available is set to how much can be read from there with one
+  // read, up to wanted bytes, which may span clusters that follow each other in the file.
+  File::IOFile& SeekToCluster(u64 offset, u64 wanted, u64* available);
   bool IsGood() { return m_good; }
   struct FileEntry
   {
@@ -3,33 +3,51 @@
 // Refer to the license.txt file included.
 
 #include <OptionParser.h>
+#include <algorithm>
+#include <cinttypes>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <signal.h>
 #include <string>
 #include <thread>
 #include <unistd.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/Event.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
 #include "Common/Flag.h"
+#include "Common/Hash.h"
 #include "Common/Logging/LogManager.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "Common/Version.h"
 
 #include "Core/Analytics.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigLoaders/GameConfigLoader.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/HW/Memmap.h"
 #include "Core/Host.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/STM/STM.h"
+#include "Core/Movie.h"
 #include "Core/State.h"
 
 #include "UICommon/CommandLineParse.h"
 #include "UICommon/UICommon.h"
 
+#include "VideoCommon/AutoTuner.h"
+#include "VideoCommon/FrameBenchmark.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -358,9 +376,364 @@ static Platform* GetPlatform()
   return nullptr;
 }
 
+// Hashes RAM and EXRAM, which replays of the same movie should agree on.
+static u64 GetMemoryHash()
+{
+  u64 hash = GetMurmurHash3(Memory::m_pRAM, Memory::RAM_SIZE, 0);
+  if (Memory::m_pEXRAM)
+    hash = hash * 31 + GetMurmurHash3(Memory::m_pEXRAM, Memory::EXRAM_SIZE, 0);
+  return hash;
+}
+
+// Runs until the movie ends, or until asked to stop without one, then reports the speed and the
+// memory hash.
+static void RunTurbo(bool playing_movie)
+{
+  Common::Timer timer;
+  timer.Start();
+  const u64 start_frame = Movie::GetCurrentFrame();
+  while (s_running.IsSet() && !s_shutdown_requested.IsSet() &&
+         (!playing_movie || Movie::IsPlayingInput()))
+  {
+    Core::HostDispatchJobs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  const double seconds = std::max<u64>(timer.GetTimeElapsed(), 1) / 1000.0;
+  const u64 frames = Movie::GetCurrentFrame() - start_frame;
+  printf("%" PRIu64 " frames in %.2f s (%.1f FPS)\n", frames, seconds, frames / seconds);
+
+  if (Core::IsRunning())
+  {
+    u64 hash = 0;
+    Core::RunAsCPUThread([&hash] { hash = GetMemoryHash(); });
+    printf("Memory hash: %016" PRIx64 "\n", hash);
+  }
+}
+
+// Plays a FIFO log once as fast as possible, recording each frame.
+static std::optional<FrameBenchmark::Recording> PlayFifoLog(const std::string& file,
+                                                            bool hash_frames)
+{
+  s_running.Set();
+  FrameBenchmark::StartRecording(hash_frames);
+  if (!BootManager::BootCore(BootParameters::GenerateFromFile(file)))
+  {
+    FrameBenchmark::StopRecording();
+    return std::nullopt;
+  }
+  // The FIFO player stops the emulation at the end of the frame range.
+  while (s_running.IsSet() && !s_shutdown_requested.IsSet())
+  {
+    Core::HostDispatchJobs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  Core::Stop();
+  Core::Shutdown();
+  return FrameBenchmark::StopRecording();
+}
+
+// Parses --benchmark_frames, all frames if it isn't given.
+static bool GetBenchmarkFrames(optparse::Values& options, u32* frame_start, u32* frame_end)
+{
+  *frame_start = 0;
+  *frame_end = UINT32_MAX;
+  if (options.is_set("benchmark_frames") &&
+      sscanf(static_cast<const char*>(options.get("benchmark_frames")), "%u-%u", frame_start,
+             frame_end) != 2)
+  {
+    fprintf(stderr, "Invalid frame range, expected <first>-<end>\n");
+    return false;
+  }
+  return true;
+}
+
+// Plays each FIFO log a few times as fast as possible and writes a report of the frame times.
+// With a baseline report, returns 1 if anything got slower than it.
+static int RunFifoBenchmark(optparse::Values& options)
+{
+  const std::string path = static_cast<const char*>(options.get("fifo_benchmark"));
+  std::vector<std::string> files;
+  if (File::IsDirectory(path))
+    files = Common::DoFileSearch({path}, {".dff"});
+  else
+    files.push_back(path);
+  std::sort(files.begin(), files.end());
+  if (files.empty())
+  {
+    fprintf(stderr, "No FIFO logs found in %s\n", path.c_str());
+    return 1;
+  }
+
+  const int runs = std::max(static_cast<int>(options.get("benchmark_runs")), 1);
+  u32 frame_start, frame_end;
+  if (!GetBenchmarkFrames(options, &frame_start, &frame_end))
+    return 1;
+
+  FrameBenchmark::Report baseline;
+  if (options.is_set("benchmark_baseline"))
+  {
+    std::string json;
+    const std::string baseline_path = static_cast<const char*>(options.get("benchmark_baseline"));
+    if (!File::ReadFileToString(baseline_path, json) || !FrameBenchmark::FromJSON(json, &baseline))
+    {
+      fprintf(stderr, "Could not read the baseline report %s\n", baseline_path.c_str());
+      return 1;
+    }
+  }
+
+  // Frames are played back as fast as the backend can draw them.
+  const float emulation_speed = SConfig::GetInstance().m_EmulationSpeed;
+  SConfig::GetInstance().m_EmulationSpeed = 0.0f;
+  Config::SetCurrent(Config::GFX_VSYNC, false);
+
+  FrameBenchmark::Report report;
+  report.revision = Common::scm_rev_str;
+  report.backend = Config::Get(Config::MAIN_GFX_BACKEND);
+  FifoPlayer& player = FifoPlayer::GetInstance();
+  for (const std::string& file : files)
+  {
+    FrameBenchmark::FileResult result;
+    std::string name, extension;
+    SplitPath(file, nullptr, &name, &extension);
+    result.name = name + extension;
+    player.SetFileLoadedCallback([&player, &result, frame_start, frame_end] {
+      player.SetLoop(false);
+      player.SetFrameRangeEnd(frame_end);
+      player.SetFrameRangeStart(frame_start);
+      result.frame_start = player.GetFrameRangeStart();
+      result.frame_end = player.GetFrameRangeEnd();
+    });
+
+    for (int run = 0; run < runs && !s_shutdown_requested.IsSet(); run++)
+    {
+      const std::optional<FrameBenchmark::Recording> recording = PlayFifoLog(file, false);
+      if (!recording)
+      {
+        fprintf(stderr, "Could not play %s\n", file.c_str());
+        break;
+      }
+
+      result.runs.push_back(FrameBenchmark::Summarize(*recording));
+      const FrameBenchmark::RunResult& run_result = result.runs.back();
+      printf("%s run %d: %u frames, %.1f FPS\n", result.name.c_str(), run + 1, run_result.frames,
+             run_result.fps);
+    }
+    report.files.push_back(std::move(result));
+  }
+  player.SetFileLoadedCallback(nullptr);
+  player.SetLoop(SConfig::GetInstance().bLoopFifoReplay);
+  SConfig::GetInstance().m_EmulationSpeed = emulation_speed;
+
+  const std::string report_path =
+      options.is_set("benchmark_report") ?
+          std::string(static_cast<const char*>(options.get("benchmark_report"))) :
+          File::GetUserPath(D_LOGS_IDX) + "fifo_benchmark.json";
+  if (!File::WriteStringToFile(FrameBenchmark::ToJSON(report), report_path))
+  {
+    fprintf(stderr, "Could not write the report to %s\n", report_path.c_str());
+    return 1;
+  }
+  printf("Report written to %s\n", report_path.c_str());
+
+  if (!options.is_set("benchmark_baseline"))
+    return 0;
+  const double threshold = options.get("benchmark_threshold");
+  const std::vector<FrameBenchmark::Regression> regressions =
+      FrameBenchmark::Compare(baseline, report, threshold);
+  for (const FrameBenchmark::Regression& regression : regressions)
+  {
+    printf("Regression: %s %s %.3f -> %.3f (%+.1f%%)\n", regression.file.c_str(),
+           regression.metric.c_str(), regression.baseline, regression.current,
+           regression.percent);
+  }
+  if (regressions.empty())
+    printf("No regressions over %.1f%% against the baseline\n", threshold);
+  return regressions.empty() ? 0 : 1;
+}
+
+// Plays a FIFO log with the current settings and then with other values of the settings below,
+// and writes the fastest values that draw the same frames into the game's user INI.
+static int RunAutoTune(optparse::Values& options)
+{
+  const std::string file = static_cast<const char*>(options.get("autotune"));
+  if (!options.is_set("autotune_game"))
+  {
+    fprintf(stderr, "--autotune needs the ID of the game the FIFO log is from, --autotune_game\n");
+    return 1;
+  }
+  const std::string game_id = static_cast<const char*>(options.get("autotune_game"));
+  const int runs = std::max(static_cast<int>(options.get("benchmark_runs")), 1);
+  const double min_gain = options.get("autotune_min_gain");
+  u32 frame_start, frame_end;
+  if (!GetBenchmarkFrames(options, &frame_start, &frame_end))
+    return 1;
+
+  // Only settings whose effects show in the frames. FIFO playback doesn't run the emulated CPU,
+  // so the hacks that only break what it reads back, like skipping EFB copies to RAM, would
+  // always look safe here.
+  const std::vector<AutoTuner::Setting> settings = {
+      AutoTuner::MakeSetting("Background shader compiling", Config::GFX_BACKGROUND_SHADER_COMPILING,
+                             {false, true}),
+      AutoTuner::MakeSetting("Full async shader compilation",
+                             Config::GFX_HACK_FULL_ASYNC_SHADER_COMPILATION, {false, true}),
+      AutoTuner::MakeSetting("GPU vertex decoding", Config::GFX_ENABLE_GPU_VERTEX_DECODING,
+                             {false, true}),
+      AutoTuner::MakeSetting("GPU texture decoding", Config::GFX_ENABLE_GPU_TEXTURE_DECODING,
+                             {false, true}),
+      AutoTuner::MakeSetting("Display list cache", Config::GFX_HACK_DISPLAY_LIST_CACHE,
+                             {false, true}),
+  };
+
+  // Frames are played back as fast as the backend can draw them.
+  const float emulation_speed = SConfig::GetInstance().m_EmulationSpeed;
+  SConfig::GetInstance().m_EmulationSpeed = 0.0f;
+  Config::SetCurrent(Config::GFX_VSYNC, false);
+  FifoPlayer& player = FifoPlayer::GetInstance();
+  player.SetFileLoadedCallback([&player, frame_start, frame_end] {
+    player.SetLoop(false);
+    player.SetFrameRangeEnd(frame_end);
+    player.SetFrameRangeStart(frame_start);
+  });
+
+  // Each configuration is played a few times for the median FPS. Runs that don't draw the same
+  // frames as each other can't be compared to the reference.
+  Config::Layer* current_run = Config::GetLayer(Config::LayerType::CurrentRun);
+  const auto measure = [&](const AutoTuner::Configuration& configuration) {
+    std::optional<AutoTuner::Measurement> measurement;
+    if (s_shutdown_requested.IsSet())
+      return measurement;
+    for (const auto& setting : configuration)
+      current_run->Set(setting.first, setting.second);
+
+    std::vector<double> fps;
+    std::vector<u64> frame_hashes;
+    for (int run = 0; run < runs; run++)
+    {
+      const std::optional<FrameBenchmark::Recording> recording = PlayFifoLog(file, true);
+      if (!recording || s_shutdown_requested.IsSet())
+        return measurement;
+      if (run > 0 && !AutoTuner::FramesMatch(frame_hashes, recording->frame_hashes))
+      {
+        printf("  the runs drew different frames\n");
+        return measurement;
+      }
+      if (recording->frame_hashes.size() > frame_hashes.size())
+        frame_hashes = recording->frame_hashes;
+      fps.push_back(FrameBenchmark::Summarize(*recording).fps);
+    }
+    std::sort(fps.begin(), fps.end());
+    measurement = AutoTuner::Measurement{fps[fps.size() / 2], std::move(frame_hashes)};
+    printf("  %.1f FPS, %zu frames hashed\n", measurement->fps, measurement->frame_hashes.size());
+    return measurement;
+  };
+
+  const std::optional<AutoTuner::Result> result = AutoTuner::Tune(
+      settings,
+      [&](const AutoTuner::Configuration& configuration) {
+        std::string changes;
+        for (const AutoTuner::Setting& setting : settings)
+        {
+          const std::string& value = configuration.at(setting.location);
+          if (value != setting.current)
+            changes += (changes.empty() ? "" : ", ") + setting.name + " = " + value;
+        }
+        printf("%s:\n", changes.empty() ? "Current settings" : changes.c_str());
+        return measure(configuration);
+      },
+      min_gain);
+
+  for (const AutoTuner::Setting& setting : settings)
+    current_run->DeleteKey(setting.location);
+  player.SetFileLoadedCallback(nullptr);
+  player.SetLoop(SConfig::GetInstance().bLoopFifoReplay);
+  SConfig::GetInstance().m_EmulationSpeed = emulation_speed;
+
+  if (!result)
+  {
+    fprintf(stderr, "Could not play %s, or no frames were drawn\n", file.c_str());
+    return 1;
+  }
+  printf("Tried %u configurations, %u drew other frames or failed\n", result->tried,
+         result->mismatched);
+  if (result->best == AutoTuner::GetCurrentConfiguration(settings))
+  {
+    printf("Nothing was faster than the current settings by %.1f%%, %.1f FPS\n", min_gain,
+           result->reference_fps);
+    return 0;
+  }
+
+  // FIFO logs are played without the game's settings, so all of the values are written to take
+  // precedence over the ones the global game INIs may have, which weren't measured.
+  Config::Layer game_layer(ConfigLoaders::GenerateLocalGameConfigLoader(game_id, 0));
+  for (const AutoTuner::Setting& setting : settings)
+  {
+    const std::string& value = result->best.at(setting.location);
+    game_layer.Set(setting.location, value);
+    if (value != setting.current)
+      printf("%s = %s\n", setting.name.c_str(), value.c_str());
+  }
+  game_layer.Save();
+  printf("%.1f FPS instead of %.1f, written to the user settings of %s\n", result->best_fps,
+         result->reference_fps, game_id.c_str());
+  return 0;
+}
+
 int main(int argc, char* argv[])
 {
   auto parser = CommandLineParse::CreateParser(CommandLineParse::ParserOptions::OmitGUIOptions);
+  parser->add_option("--turbo")
+      .action("store_true")
+      .help("Emulate as fast as possible without drawing, presenting or playing audio, then "
+            "report the speed and a hash of memory");
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .metavar("<file or directory>")
+      .type("string")
+      .help("Play a FIFO log, or each one in a directory, as fast as possible and write a report "
+            "of the frame times");
+  parser->add_option("--benchmark_runs")
+      .action("store")
+      .type("int")
+      .set_default(3)
+      .help("How many times to play each FIFO log");
+  parser->add_option("--benchmark_frames")
+      .action("store")
+      .metavar("<first>-<end>")
+      .type("string")
+      .help("Only play the frames from <first> up to, but not including, <end>");
+  parser->add_option("--benchmark_report")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Where to write the JSON report, fifo_benchmark.json in the logs folder by default");
+  parser->add_option("--benchmark_baseline")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("A report of an earlier build to compare against");
+  parser->add_option("--benchmark_threshold")
+      .action("store")
+      .type("float")
+      .set_default(5.0)
+      .help("How many percent slower than the baseline counts as a regression");
+  parser->add_option("--autotune")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Play a FIFO log with the current settings and other values of the ones that matter "
+            "for speed, and write the fastest values that draw the same frames into the game's "
+            "user settings");
+  parser->add_option("--autotune_game")
+      .action("store")
+      .metavar("<game ID>")
+      .type("string")
+      .help("The game the FIFO log of --autotune is from");
+  parser->add_option("--autotune_min_gain")
+      .action("store")
+      .type("float")
+      .set_default(3.0)
+      .help("How many percent faster a value has to be for --autotune to change it");
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
@@ -386,7 +759,7 @@ int main(int argc, char* argv[])
     boot = BootParameters::GenerateFromFile(args.front());
     args.erase(args.begin());
   }
-  else
+  else if (!options.is_set("fifo_benchmark") && !options.is_set("autotune"))
   {
     parser->print_help();
     return 0;
@@ -408,6 +781,19 @@ int main(int argc, char* argv[])
   UICommon::SetUserDirectory(user_directory);
   UICommon::Init();
 
+  const bool turbo = options.is_set("turbo");
+  const bool play_movie = options.is_set("movie") && boot;
+  if (play_movie)
+  {
+    std::optional<std::string> savestate_path;
+    if (!Movie::PlayInput(static_cast<const char*>(options.get("movie")), &savestate_path))
+    {
+      fprintf(stderr, "Could not play the movie\n");
+      return 1;
+    }
+    boot->savestate_path = savestate_path;
+  }
+
   Core::SetOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_running.Clear();
@@ -424,6 +810,28 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance()->ReportDolphinStart("nogui");
 
+  if (options.is_set("fifo_benchmark") || options.is_set("autotune"))
+  {
+    const int result =
+        options.is_set("autotune") ? RunAutoTune(options) : RunFifoBenchmark(options);
+    platform->Shutdown();
+    UICommon::Shutdown();
+    delete platform;
+    return result;
+  }
+
+  // Restored before the settings are saved on shutdown.
+  const std::string audio_backend = SConfig::GetInstance().sBackend;
+  const bool pause_movie = SConfig::GetInstance().m_PauseMovie;
+  if (turbo)
+  {
+    // Keeps the emulation paused at the end of the movie, for the memory hash.
+    SConfig::GetInstance().m_PauseMovie = true;
+    SConfig::GetInstance().sBackend = BACKEND_NULLSOUND;
+    Config::SetCurrent(Config::GFX_HACK_SKIP_DRAWING, true);
+    Core::SetIsCatchingUp(true);
+  }
+
   if (!BootManager::BootCore(std::move(boot)))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -437,11 +845,19 @@ int main(int argc, char* argv[])
   }
 
   if (s_running.IsSet())
-    platform->MainLoop();
+  {
+    if (turbo)
+      RunTurbo(play_movie);
+    else
+      platform->MainLoop();
+  }
   Core::Stop();
 
   Core::Shutdown();
   platform->Shutdown();
+  Core::SetIsCatchingUp(false);
+  SConfig::GetInstance().sBackend = audio_backend;
+  SConfig::GetInstance().m_PauseMovie = pause_movie;
   UICommon::Shutdown();
 
   delete platform;
@@ -47,11 +47,17 @@ void AdvancedWidget::CreateWidgets()
       new GraphicsBool(tr("Texture Format Overlay"), Config::GFX_TEXFMT_OVERLAY_ENABLE);
   m_enable_api_validation =
       new GraphicsBool(tr("Enable API Validation Layers"), Config::GFX_ENABLE_VALIDATION_LAYER);
+  m_show_frame_profile =
+      new GraphicsBool(tr("Show Frame Profile"), Config::GFX_OVERLAY_FRAME_PROFILE);
+  m_log_frame_profile =
+      new GraphicsBool(tr("Log Frame Profile to File"), Config::GFX_LOG_FRAME_PROFILE_TO_FILE);
 
   debugging_layout->addWidget(m_enable_wireframe, 0, 0);
   debugging_layout->addWidget(m_show_statistics, 0, 1);
   debugging_layout->addWidget(m_enable_format_overlay, 1, 0);
   debugging_layout->addWidget(m_enable_api_validation, 1, 1);
+  debugging_layout->addWidget(m_show_frame_profile, 2, 0);
+  debugging_layout->addWidget(m_log_frame_profile, 2, 1);
 
   // Utility
   auto* utility_box = new QGroupBox(tr("Utility"));
@@ -136,6 +142,13 @@ void AdvancedWidget::AddDescriptions()
       QT_TR_NOOP("Render the scene as a wireframe.\n\nIf unsure, leave this unchecked.");
   static const char* TR_SHOW_STATS_DESCRIPTION =
       QT_TR_NOOP("Show various rendering statistics.\n\nIf unsure, leave this unchecked.");
+  static const char* TR_SHOW_FRAME_PROFILE_DESCRIPTION = QT_TR_NOOP(
+      "Show the CPU and GPU time spent on drawing the EFB, EFB copies, post-processing, scaling "
+      "and presenting each frame, and a graph of the last frames.\n\nIf unsure, leave this "
+      "unchecked.");
+  static const char* TR_LOG_FRAME_PROFILE_DESCRIPTION = QT_TR_NOOP(
+      "Log the CPU and GPU times of every frame to User/Logs/frame_profile.csv.\n\nIf unsure, "
+      "leave this unchecked.");
   static const char* TR_TEXTURE_FORMAT_DECRIPTION =
       QT_TR_NOOP("Modify textures to show the format they're encoded in. Needs an emulation reset "
                  "in most cases.\n\nIf unsure, leave this unchecked.");
@@ -192,6 +205,8 @@ void AdvancedWidget::AddDescriptions()
   AddDescription(m_show_statistics, TR_SHOW_STATS_DESCRIPTION);
   AddDescription(m_enable_format_overlay, TR_TEXTURE_FORMAT_DECRIPTION);
   AddDescription(m_enable_api_validation, TR_VALIDATION_LAYER_DESCRIPTION);
+  AddDescription(m_show_frame_profile, TR_SHOW_FRAME_PROFILE_DESCRIPTION);
+  AddDescription(m_log_frame_profile, TR_LOG_FRAME_PROFILE_DESCRIPTION);
   AddDescription(m_dump_textures, TR_DUMP_TEXTURE_DESCRIPTION);
   AddDescription(m_load_custom_textures, TR_LOAD_CUSTOM_TEXTURE_DESCRIPTION);
   AddDescription(m_prefetch_custom_textures, TR_CACHE_CUSTOM_TEXTURE_DESCRIPTION);
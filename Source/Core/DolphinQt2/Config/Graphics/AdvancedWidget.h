@@ -30,6 +30,8 @@ private:
   QCheckBox* m_show_statistics;
   QCheckBox* m_enable_format_overlay;
   QCheckBox* m_enable_api_validation;
+  QCheckBox* m_show_frame_profile;
+  QCheckBox* m_log_frame_profile;
 
   // Utility
   QCheckBox* m_dump_textures;
@@ -173,7 +173,7 @@ void GameList::ShowContextMenu(const QPoint&)
     AddAction(menu, tr("Set as &default ISO"), this, &GameList::SetDefaultISO);
     const auto blob_type = game->GetBlobType();
 
-    if (blob_type == DiscIO::BlobType::GCZ)
+    if (blob_type == DiscIO::BlobType::GCZ || blob_type == DiscIO::BlobType::DCZ)
       AddAction(menu, tr("Decompress ISO..."), this, &GameList::CompressISO);
     else if (blob_type == DiscIO::BlobType::PLAIN)
       AddAction(menu, tr("Compress ISO..."), this, &GameList::CompressISO);
@@ -276,9 +276,26 @@ void GameList::CompressISO()
   auto file = GetSelectedGame();
   const auto original_path = file->GetFilePath();
 
-  const bool compressed = (file->GetBlobType() == DiscIO::BlobType::GCZ);
+  const bool compressed = (file->GetBlobType() == DiscIO::BlobType::GCZ ||
+                           file->GetBlobType() == DiscIO::BlobType::DCZ);
 
-  if (!compressed && file->GetPlatform() == DiscIO::Platform::WiiDisc)
+  // DCZ keeps the image intact, GCZ scrubs Wii discs.
+  QString dst_path = QFileDialog::getSaveFileName(
+      this, compressed ? tr("Select where you want to save the decompressed image") :
+                         tr("Select where you want to save the compressed image"),
+      QFileInfo(QString::fromStdString(GetSelectedGame()->GetFilePath()))
+          .dir()
+          .absoluteFilePath(QString::fromStdString(file->GetGameID()))
+          .append(compressed ? QStringLiteral(".gcm") : QStringLiteral(".dcz")),
+      compressed ? tr("Uncompressed GC/Wii images (*.iso *.gcm)") :
+                   tr("DCZ GC/Wii images (*.dcz);;Compressed GC/Wii images (*.gcz)"));
+
+  if (dst_path.isEmpty())
+    return;
+
+  const bool use_gcz =
+      !compressed && dst_path.endsWith(QStringLiteral(".gcz"), Qt::CaseInsensitive);
+  if (use_gcz && file->GetPlatform() == DiscIO::Platform::WiiDisc)
   {
     QMessageBox wii_warning(this);
     wii_warning.setIcon(QMessageBox::Warning);
@@ -292,19 +309,6 @@ void GameList::CompressISO()
       return;
   }
 
-  QString dst_path = QFileDialog::getSaveFileName(
-      this, compressed ? tr("Select where you want to save the decompressed image") :
-                         tr("Select where you want to save the compressed image"),
-      QFileInfo(QString::fromStdString(GetSelectedGame()->GetFilePath()))
-          .dir()
-          .absoluteFilePath(QString::fromStdString(file->GetGameID()))
-          .append(compressed ? QStringLiteral(".gcm") : QStringLiteral(".gcz")),
-      compressed ? tr("Uncompressed GC/Wii images (*.iso *.gcm)") :
-                   tr("Compressed GC/Wii images (*.gcz)"));
-
-  if (dst_path.isEmpty())
-    return;
-
   QProgressDialog progress_dialog(compressed ? tr("Decompressing...") : tr("Compressing..."),
                                   tr("Abort"), 0, 100, this);
   progress_dialog.setWindowModality(Qt::WindowModal);
@@ -316,6 +320,11 @@ void GameList::CompressISO()
     good = DiscIO::DecompressBlobToFile(original_path, dst_path.toStdString(), &CompressCB,
                                         &progress_dialog);
   }
+  else if (!use_gcz)
+  {
+    good = DiscIO::ConvertToDCZ(original_path, dst_path.toStdString(), &CompressCB,
+                                &progress_dialog);
+  }
   else
   {
     good = DiscIO::CompressFileToBlob(original_path, dst_path.toStdString(),
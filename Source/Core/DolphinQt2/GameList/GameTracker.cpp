@@ -2,6 +2,9 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <string>
+#include <vector>
+
 #include <QDir>
 #include <QDirIterator>
 #include <QFile>
@@ -13,8 +16,9 @@
 
 static const QStringList game_filters{
     QStringLiteral("*.gcm"),  QStringLiteral("*.iso"), QStringLiteral("*.tgc"),
-    QStringLiteral("*.ciso"), QStringLiteral("*.gcz"), QStringLiteral("*.wbfs"),
-    QStringLiteral("*.wad"),  QStringLiteral("*.elf"), QStringLiteral("*.dol")};
+    QStringLiteral("*.ciso"), QStringLiteral("*.gcz"), QStringLiteral("*.dcz"),
+    QStringLiteral("*.wbfs"), QStringLiteral("*.wad"), QStringLiteral("*.elf"),
+    QStringLiteral("*.dol")};
 
 GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 {
@@ -98,6 +102,7 @@ void GameTracker::RemoveDirectoryInternal(const QString& dir)
 
 void GameTracker::UpdateDirectoryInternal(const QString& dir)
 {
+  QList<QString> new_paths;
   QDirIterator it(dir, game_filters, QDir::NoFilter, QDirIterator::Subdirectories);
   while (it.hasNext())
   {
@@ -113,10 +118,23 @@ void GameTracker::UpdateDirectoryInternal(const QString& dir)
     {
       addPath(path);
       m_tracked_files[path] = QSet<QString>{dir};
-      LoadGame(path);
+      new_paths.append(path);
     }
   }
 
+  // Probe all new or changed files at once, so that LoadGame only has to look them up
+  std::vector<std::string> paths_to_probe;
+  for (const QString& path : new_paths)
+  {
+    const std::string converted_path = path.toStdString();
+    if (!DiscIO::ShouldHideFromGameList(converted_path))
+      paths_to_probe.push_back(converted_path);
+  }
+  if (m_cache.AddOrUpdate(paths_to_probe))
+    m_cache.Save();
+  for (const QString& path : new_paths)
+    LoadGame(path);
+
   for (const auto& missing : FindMissingFiles(dir))
   {
     auto& tracked_file = m_tracked_files[missing];
@@ -16,6 +16,7 @@
 #include "Core/HotkeyManager.h"
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/USB/Bluetooth/BTBase.h"
+#include "Core/PowerPC/Profiler.h"
 #include "Core/State.h"
 #include "DolphinQt2/MainWindow.h"
 #include "DolphinQt2/Settings.h"
@@ -161,6 +162,12 @@ void HotkeyScheduler::Run()
       if (IsHotkey(HK_EXIT))
         emit ExitHotkey();
 
+      if (IsHotkey(HK_EXPORT_JIT_PROFILE))
+        Profiler::ToggleProfilingOrExport();
+
+      if (IsHotkey(HK_EXPORT_TRACE))
+        Core::ToggleTraceRecordingOrExport();
+
       auto& settings = Settings::Instance();
 
       // Recording
@@ -5,6 +5,7 @@
 #include "DolphinQt2/MenuBar.h"
 
 #include <cinttypes>
+#include <climits>
 
 #include <QAction>
 #include <QDesktopServices>
@@ -95,6 +96,7 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
 
   // Movie
   m_recording_read_only->setEnabled(running);
+  m_recording_seek->setEnabled(running);
   if (!running)
     m_recording_stop->setEnabled(false);
   m_recording_play->setEnabled(!running);
@@ -575,6 +577,8 @@ void MenuBar::AddMovieMenu()
 
   AddAction(movie_menu, tr("TAS Input"), this, [this] { emit ShowTASInput(); });
 
+  m_recording_seek = AddAction(movie_menu, tr("Seek to Frame..."), this, &MenuBar::SeekMovie);
+
   movie_menu->addSeparator();
 
   auto* pause_at_end = movie_menu->addAction(tr("Pause at End of Movie"));
@@ -583,6 +587,12 @@ void MenuBar::AddMovieMenu()
   connect(pause_at_end, &QAction::toggled,
           [](bool value) { SConfig::GetInstance().m_PauseMovie = value; });
 
+  auto* keyframes = movie_menu->addAction(tr("Save Keyframes for Seeking"));
+  keyframes->setCheckable(true);
+  keyframes->setChecked(SConfig::GetInstance().m_MovieKeyframes);
+  connect(keyframes, &QAction::toggled,
+          [](bool value) { SConfig::GetInstance().m_MovieKeyframes = value; });
+
   auto* lag_counter = movie_menu->addAction(tr("Show Lag Counter"));
   lag_counter->setCheckable(true);
   lag_counter->setChecked(SConfig::GetInstance().m_ShowLag);
@@ -832,6 +842,16 @@ void MenuBar::OnReadOnlyModeChanged(bool read_only)
   m_recording_read_only->setChecked(read_only);
 }
 
+void MenuBar::SeekMovie()
+{
+  bool good;
+  const int frame =
+      QInputDialog::getInt(this, tr("Seek to Frame"), tr("Frame:"),
+                           static_cast<int>(Movie::GetCurrentFrame()), 0, INT_MAX, 1, &good);
+  if (good)
+    Movie::SeekToFrame(static_cast<u64>(frame));
+}
+
 void MenuBar::ChangeDebugFont()
 {
   bool okay;
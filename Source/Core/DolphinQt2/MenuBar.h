@@ -129,6 +129,7 @@ private:
   void ExportWiiSaves();
   void CheckNAND();
   void NANDExtractCertificates();
+  void SeekMovie();
   void ChangeDebugFont();
 
   // Debugging UI
@@ -190,6 +191,7 @@ private:
   QAction* m_recording_start;
   QAction* m_recording_stop;
   QAction* m_recording_read_only;
+  QAction* m_recording_seek;
 
   // Options
   QAction* m_boot_to_pause;
@@ -63,6 +63,9 @@ void NetPlayDialog::CreateMainLayout()
   m_buffer_size_box = new QSpinBox;
   m_save_sd_box = new QCheckBox(tr("Write save/SD data"));
   m_load_wii_box = new QCheckBox(tr("Load Wii Save"));
+  m_rollback_box = new QCheckBox(tr("Rollback"));
+  m_rollback_box->setToolTip(tr("Predicts the inputs of the other players instead of waiting for "
+                                "them. GameCube controllers only."));
   m_record_input_box = new QCheckBox(tr("Record inputs"));
   m_buffer_label = new QLabel(tr("Buffer:"));
   m_quit_button = new QPushButton(tr("Quit"));
@@ -86,6 +89,7 @@ void NetPlayDialog::CreateMainLayout()
   options_widget->addWidget(m_buffer_size_box);
   options_widget->addWidget(m_save_sd_box);
   options_widget->addWidget(m_load_wii_box);
+  options_widget->addWidget(m_rollback_box);
   options_widget->addWidget(m_record_input_box);
   options_widget->addWidget(m_quit_button);
   m_main_layout->addLayout(options_widget, 2, 0, 1, -1, Qt::AlignRight);
@@ -236,6 +240,7 @@ void NetPlayDialog::OnStart()
   settings.m_OCFactor = instance.m_OCFactor;
   settings.m_EXIDevice[0] = instance.m_EXIDevice[0];
   settings.m_EXIDevice[1] = instance.m_EXIDevice[1];
+  settings.m_Rollback = m_rollback_box->isChecked();
 
   Settings::Instance().GetNetPlayServer()->SetNetSettings(settings);
   Settings::Instance().GetNetPlayServer()->StartGame();
@@ -307,6 +312,7 @@ void NetPlayDialog::show(std::string nickname, bool use_traversal)
   m_start_button->setHidden(!is_hosting);
   m_save_sd_box->setHidden(!is_hosting);
   m_load_wii_box->setHidden(!is_hosting);
+  m_rollback_box->setHidden(!is_hosting);
   m_buffer_size_box->setHidden(!is_hosting);
   m_buffer_label->setHidden(!is_hosting);
   m_kick_button->setHidden(!is_hosting);
@@ -458,6 +464,7 @@ void NetPlayDialog::GameStatusChanged(bool running)
       m_game_button->setEnabled(!running);
       m_load_wii_box->setEnabled(!running);
       m_save_sd_box->setEnabled(!running);
+      m_rollback_box->setEnabled(!running);
       m_assign_ports_button->setEnabled(!running);
     }
 
@@ -95,6 +95,7 @@ private:
   QSpinBox* m_buffer_size_box;
   QCheckBox* m_save_sd_box;
   QCheckBox* m_load_wii_box;
+  QCheckBox* m_rollback_box;
   QCheckBox* m_record_input_box;
   QPushButton* m_quit_button;
 
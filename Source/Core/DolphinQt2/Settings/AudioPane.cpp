@@ -83,7 +83,8 @@ void AudioPane::CreateWidgets()
   }
 
   m_dolby_pro_logic->setToolTip(
-      tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
+      tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only.\n"
+         "Decoding adds a small amount of CPU time on the audio thread."));
 
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
@@ -41,6 +41,7 @@ void AudioConfigPane::InitializeGUI()
       m_dsp_engine_strings, 0, wxRA_SPECIFY_ROWS);
   m_dpl2_decoder_checkbox = new wxCheckBox(this, wxID_ANY, _("Dolby Pro Logic II Decoder"));
   m_DSP_REHack_checkbox = new wxCheckBox(this, wxID_ANY, _("DSP Hack for RE"));
+  m_ax_thread_checkbox = new wxCheckBox(this, wxID_ANY, _("Mix AX Audio on a Worker Thread"));
   m_volume_slider = new DolphinSlider(this, wxID_ANY, 0, 0, 100, wxDefaultPosition, wxDefaultSize,
     wxSL_VERTICAL | wxSL_INVERSE);
   m_volume_text = new wxStaticText(this, wxID_ANY, "");
@@ -57,14 +58,27 @@ void AudioConfigPane::InitializeGUI()
   m_stretch_slider =
     new DolphinSlider(this, wxID_ANY, 80, 5, 300, wxDefaultPosition, wxDefaultSize);
   m_stretch_text = new wxStaticText(this, wxID_ANY, "");
+  m_stretch_wsola_checkbox = new wxCheckBox(this, wxID_ANY, _("Lightweight Stretching"));
+  m_low_latency_checkbox = new wxCheckBox(this, wxID_ANY, _("Low Latency Audio"));
   if (m_latency_control_supported)
   {
     m_audio_latency_spinctrl->SetToolTip(_("Sets the latency (in ms). Higher values may reduce audio "
       "crackling. Certain backends only."));
   }
   m_dpl2_decoder_checkbox->SetToolTip(
-    _("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
+    _("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only.\n"
+      "Decoding adds a small amount of CPU time on the audio thread."));
   m_stretch_checkbox->SetToolTip(_("Enables stretching of the audio to match emulation speed."));
+  m_stretch_wsola_checkbox->SetToolTip(
+    _("Uses a simpler and faster stretcher instead of SoundTouch, which only stretches while the "
+      "emulation runs slower or faster than full speed. Lower quality at low speeds."));
+  m_low_latency_checkbox->SetToolTip(
+    _("Keeps only a few milliseconds of audio buffered and adjusts the playback rate by up to "
+      "0.5% to follow the emulation, instead of buffering and stretching. Use with a low "
+      "backend latency. Replaces audio stretching."));
+  m_ax_thread_checkbox->SetToolTip(
+    _("Processes AX command lists of DSP HLE on a separate thread, so the CPU thread doesn't wait "
+      "for the audio mixing. Always off during NetPlay and movie recording or playback."));
   m_stretch_slider->SetToolTip(_("Size of stretch buffer in milliseconds. "
     "Values too low may cause audio crackling."));
 
@@ -113,6 +127,10 @@ void AudioConfigPane::InitializeGUI()
     wxALIGN_CENTER_VERTICAL);
   stretching_grid_sizer->Add(latency_sizer, wxGBPosition(1, 1), wxDefaultSpan,
     wxALIGN_CENTER_VERTICAL);
+  stretching_grid_sizer->Add(m_stretch_wsola_checkbox, wxGBPosition(2, 0), wxGBSpan(1, 2),
+    wxALIGN_CENTER_VERTICAL);
+  stretching_grid_sizer->Add(m_low_latency_checkbox, wxGBPosition(3, 0), wxGBSpan(1, 2),
+    wxALIGN_CENTER_VERTICAL);
 
   wxStaticBoxSizer* const stretching_box_sizer =
     new wxStaticBoxSizer(wxVERTICAL, this, _("Audio Stretching Settings"));
@@ -124,6 +142,8 @@ void AudioConfigPane::InitializeGUI()
   wxGridBagSizer* const Hack_grid_sizer = new wxGridBagSizer(space5, space5);
   Hack_grid_sizer->Add(m_DSP_REHack_checkbox, wxGBPosition(0, 0), wxGBSpan(1, 2),
                              wxALIGN_CENTER_VERTICAL);
+  Hack_grid_sizer->Add(m_ax_thread_checkbox, wxGBPosition(1, 0), wxGBSpan(1, 2),
+                       wxALIGN_CENTER_VERTICAL);
 
   wxStaticBoxSizer* const hack_box_sizer =
       new wxStaticBoxSizer(wxVERTICAL, this, _("Audio Hacks"));
@@ -161,6 +181,7 @@ void AudioConfigPane::LoadGUIValues()
   m_volume_text->SetLabel(wxString::Format("%d %%", SConfig::GetInstance().m_Volume));
   m_dpl2_decoder_checkbox->SetValue(startup_params.bDPL2Decoder);
   m_DSP_REHack_checkbox->SetValue(startup_params.bDSPREHACK);
+  m_ax_thread_checkbox->SetValue(startup_params.bAXThread);
   if (m_latency_control_supported)
   {
     m_audio_latency_spinctrl->SetValue(startup_params.iLatency);
@@ -171,6 +192,9 @@ void AudioConfigPane::LoadGUIValues()
   m_stretch_text->Enable(startup_params.m_audio_stretch);
   m_stretch_text->SetLabel(wxString::Format("%d ms", startup_params.m_audio_stretch_max_latency));
   m_stretch_label->Enable(startup_params.m_audio_stretch);
+  m_stretch_wsola_checkbox->SetValue(startup_params.m_audio_stretch_wsola);
+  m_stretch_wsola_checkbox->Enable(startup_params.m_audio_stretch);
+  m_low_latency_checkbox->SetValue(startup_params.m_audio_low_latency);
 }
 
 void AudioConfigPane::ToggleBackendSpecificControls(const std::string& backend)
@@ -202,6 +226,9 @@ void AudioConfigPane::BindEvents()
                                 this);
   m_DSP_REHack_checkbox->Bind(wxEVT_UPDATE_UI, &WxEventUtils::OnEnableIfCoreNotRunning);
 
+  m_ax_thread_checkbox->Bind(wxEVT_CHECKBOX, &AudioConfigPane::OnAXThreadCheckBoxChanged, this);
+  m_ax_thread_checkbox->Bind(wxEVT_UPDATE_UI, &WxEventUtils::OnEnableIfCoreNotRunning);
+
   
 
   m_volume_slider->Bind(wxEVT_SLIDER, &AudioConfigPane::OnVolumeSliderChanged, this);
@@ -215,6 +242,10 @@ void AudioConfigPane::BindEvents()
   }
   m_stretch_checkbox->Bind(wxEVT_CHECKBOX, &AudioConfigPane::OnStretchCheckBoxChanged, this);
   m_stretch_slider->Bind(wxEVT_SLIDER, &AudioConfigPane::OnStretchSliderChanged, this);
+  m_stretch_wsola_checkbox->Bind(wxEVT_CHECKBOX, &AudioConfigPane::OnStretchWSOLACheckBoxChanged,
+                                 this);
+  m_low_latency_checkbox->Bind(wxEVT_CHECKBOX, &AudioConfigPane::OnLowLatencyCheckBoxChanged,
+                               this);
 }
 
 void AudioConfigPane::OnDSPEngineRadioBoxChanged(wxCommandEvent& event)
@@ -234,6 +265,11 @@ void AudioConfigPane::OnDSKREHackCheckBoxChanged(wxCommandEvent&)
   SConfig::GetInstance().bDSPREHACK = m_DSP_REHack_checkbox->IsChecked();
 }
 
+void AudioConfigPane::OnAXThreadCheckBoxChanged(wxCommandEvent&)
+{
+  SConfig::GetInstance().bAXThread = m_ax_thread_checkbox->IsChecked();
+}
+
 void AudioConfigPane::OnVolumeSliderChanged(wxCommandEvent& event)
 {
   SConfig::GetInstance().m_Volume = m_volume_slider->GetValue();
@@ -263,6 +299,7 @@ void AudioConfigPane::OnStretchCheckBoxChanged(wxCommandEvent& event)
   m_stretch_slider->Enable(stretch_enabled);
   m_stretch_text->Enable(stretch_enabled);
   m_stretch_label->Enable(stretch_enabled);
+  m_stretch_wsola_checkbox->Enable(stretch_enabled);
 }
 
 void AudioConfigPane::OnStretchSliderChanged(wxCommandEvent& event)
@@ -271,6 +308,16 @@ void AudioConfigPane::OnStretchSliderChanged(wxCommandEvent& event)
   m_stretch_text->SetLabel(wxString::Format("%d ms", m_stretch_slider->GetValue()));
 }
 
+void AudioConfigPane::OnStretchWSOLACheckBoxChanged(wxCommandEvent&)
+{
+  SConfig::GetInstance().m_audio_stretch_wsola = m_stretch_wsola_checkbox->IsChecked();
+}
+
+void AudioConfigPane::OnLowLatencyCheckBoxChanged(wxCommandEvent&)
+{
+  SConfig::GetInstance().m_audio_low_latency = m_low_latency_checkbox->IsChecked();
+}
+
 void AudioConfigPane::PopulateBackendChoiceBox()
 {
   for (const std::string& backend : AudioCommon::GetSoundBackends())
@@ -32,17 +32,21 @@ private:
   void OnDSPEngineRadioBoxChanged(wxCommandEvent&);
   void OnDPL2DecoderCheckBoxChanged(wxCommandEvent&);
   void OnDSKREHackCheckBoxChanged(wxCommandEvent&);
+  void OnAXThreadCheckBoxChanged(wxCommandEvent&);
   void OnVolumeSliderChanged(wxCommandEvent&);
   void OnAudioBackendChanged(wxCommandEvent&);
   void OnLatencySpinCtrlChanged(wxCommandEvent&);
   void OnStretchCheckBoxChanged(wxCommandEvent&);
   void OnStretchSliderChanged(wxCommandEvent&);
+  void OnStretchWSOLACheckBoxChanged(wxCommandEvent&);
+  void OnLowLatencyCheckBoxChanged(wxCommandEvent&);
 
   wxArrayString m_dsp_engine_strings;
   wxArrayString m_audio_backend_strings;
 
   wxRadioBox* m_dsp_engine_radiobox;
   wxCheckBox* m_DSP_REHack_checkbox;
+  wxCheckBox* m_ax_thread_checkbox;
   wxCheckBox* m_dpl2_decoder_checkbox;
   DolphinSlider* m_volume_slider;
   wxStaticText* m_volume_text;
@@ -53,6 +57,8 @@ private:
   wxStaticText* m_stretch_label;
   DolphinSlider* m_stretch_slider;
   wxStaticText* m_stretch_text;
+  wxCheckBox* m_stretch_wsola_checkbox;
+  wxCheckBox* m_low_latency_checkbox;
 
   bool m_latency_control_supported;
 };
@@ -57,6 +57,7 @@
 #include "Core/IOS/IOS.h"
 #include "Core/IOS/USB/Bluetooth/BTBase.h"
 #include "Core/Movie.h"
+#include "Core/PowerPC/Profiler.h"
 #include "Core/State.h"
 
 #include "DolphinWX/Config/ConfigMain.h"
@@ -1321,6 +1322,10 @@ void CFrame::ParseHotkeys()
     Core::SaveScreenShot();
   if (IsHotkey(HK_EXIT))
     wxPostEvent(this, wxCommandEvent(wxEVT_MENU, wxID_EXIT));
+  if (IsHotkey(HK_EXPORT_JIT_PROFILE))
+    Profiler::ToggleProfilingOrExport();
+  if (IsHotkey(HK_EXPORT_TRACE))
+    Core::ToggleTraceRecordingOrExport();
   if (IsHotkey(HK_VOLUME_DOWN))
     AudioCommon::DecreaseVolume(3);
   if (IsHotkey(HK_VOLUME_UP))
@@ -982,7 +982,8 @@ void GameListCtrl::OnRightClick(wxMouseEvent& event)
 
       if (platform == DiscIO::Platform::GameCubeDisc || platform == DiscIO::Platform::WiiDisc)
       {
-        if (selected_iso->GetBlobType() == DiscIO::BlobType::GCZ)
+        if (selected_iso->GetBlobType() == DiscIO::BlobType::GCZ ||
+            selected_iso->GetBlobType() == DiscIO::BlobType::DCZ)
           popupMenu.Append(IDM_COMPRESS_ISO, _("Decompress ISO..."));
         else if (selected_iso->GetBlobType() == DiscIO::BlobType::PLAIN)
           popupMenu.Append(IDM_COMPRESS_ISO, _("Compress ISO..."));
@@ -1203,14 +1204,15 @@ void GameListCtrl::CompressSelection(bool _compress)
       iso->GetPlatform() != DiscIO::Platform::WiiDisc)
       continue;
     if (iso->GetBlobType() != DiscIO::BlobType::PLAIN &&
-      iso->GetBlobType() != DiscIO::BlobType::GCZ)
+      iso->GetBlobType() != DiscIO::BlobType::GCZ &&
+      iso->GetBlobType() != DiscIO::BlobType::DCZ)
       continue;
 
     items_to_compress.push_back(iso);
 
     // Show the Wii compression warning if it's relevant and it hasn't been shown already
     if (!wii_compression_warning_accepted && _compress &&
-      iso->GetBlobType() != DiscIO::BlobType::GCZ &&
+      iso->GetBlobType() == DiscIO::BlobType::PLAIN &&
       iso->GetPlatform() == DiscIO::Platform::WiiDisc)
     {
       if (WiiCompressWarning())
@@ -1241,7 +1243,7 @@ void GameListCtrl::CompressSelection(bool _compress)
 
     for (const UICommon::GameFile* iso : items_to_compress)
     {
-      if (iso->GetBlobType() != DiscIO::BlobType::GCZ && _compress)
+      if (iso->GetBlobType() == DiscIO::BlobType::PLAIN && _compress)
       {
         std::string FileName;
         SplitPath(iso->GetFilePath(), nullptr, &FileName, nullptr);
@@ -1263,7 +1265,7 @@ void GameListCtrl::CompressSelection(bool _compress)
           (iso->GetPlatform() == DiscIO::Platform::WiiDisc) ? 1 : 0,
             16384, &MultiCompressCB, &progress);
       }
-      else if (iso->GetBlobType() == DiscIO::BlobType::GCZ && !_compress)
+      else if (iso->GetBlobType() != DiscIO::BlobType::PLAIN && !_compress)
       {
         std::string FileName;
         SplitPath(iso->GetFilePath(), nullptr, &FileName, nullptr);
@@ -1308,7 +1310,8 @@ void GameListCtrl::OnCompressISO(wxCommandEvent& WXUNUSED(event))
   if (!iso)
     return;
 
-  bool is_compressed = iso->GetBlobType() == DiscIO::BlobType::GCZ;
+  bool is_compressed = iso->GetBlobType() == DiscIO::BlobType::GCZ ||
+                       iso->GetBlobType() == DiscIO::BlobType::DCZ;
   wxString path;
 
   std::string FileName, FilePath, FileExtension;
@@ -1330,11 +1333,10 @@ void GameListCtrl::OnCompressISO(wxCommandEvent& WXUNUSED(event))
     }
     else
     {
-      if (iso->GetPlatform() == DiscIO::Platform::WiiDisc && !WiiCompressWarning())
-        return;
-
+      // DCZ keeps the image intact, GCZ scrubs Wii discs.
       path = wxFileSelector(_("Save compressed GCM/ISO"), StrToWxStr(FilePath),
-        StrToWxStr(FileName) + ".gcz", wxEmptyString,
+        StrToWxStr(FileName) + ".dcz", wxEmptyString,
+        _("All DCZ compressed GC/Wii ISO files (dcz)") + "|*.dcz|" +
         _("All compressed GC/Wii ISO files (gcz)") +
         wxString::Format("|*.gcz|%s", wxGetTranslation(wxALL_FILES)),
         wxFD_SAVE, this);
@@ -1347,6 +1349,10 @@ void GameListCtrl::OnCompressISO(wxCommandEvent& WXUNUSED(event))
       path.c_str()),
       _("Confirm File Overwrite"), wxYES_NO) == wxNO);
 
+  const bool use_gcz = !is_compressed && path.Lower().EndsWith(".gcz");
+  if (use_gcz && iso->GetPlatform() == DiscIO::Platform::WiiDisc && !WiiCompressWarning())
+    return;
+
   bool all_good = false;
 
   {
@@ -1358,6 +1364,9 @@ void GameListCtrl::OnCompressISO(wxCommandEvent& WXUNUSED(event))
     if (is_compressed)
       all_good =
       DiscIO::DecompressBlobToFile(iso->GetFilePath(), WxStrToStr(path), &CompressCB, &dialog);
+    else if (!use_gcz)
+      all_good =
+      DiscIO::ConvertToDCZ(iso->GetFilePath(), WxStrToStr(path), &CompressCB, &dialog);
     else
       all_good = DiscIO::CompressFileToBlob(
         iso->GetFilePath(), WxStrToStr(path),
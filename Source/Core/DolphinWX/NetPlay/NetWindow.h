@@ -142,6 +142,7 @@ private:
   wxTextCtrl* m_chat_msg_text;
   wxCheckBox* m_memcard_write;
   wxCheckBox* m_copy_wii_save;
+  wxCheckBox* m_rollback;
   wxCheckBox* m_record_chkbox;
 
   std::string m_selected_game;
@@ -140,6 +140,17 @@ static wxString ws_hack_desc =
 static wxString vsync_desc =
     _("Wait for vertical blanks in order to reduce tearing.\nDecreases performance if emulation "
       "speed is below 100%.\n\nIf unsure, leave this unchecked.");
+static wxString low_latency_desc =
+    _("Reduces input latency by reading the controllers just before the game does instead of "
+      "at the start of each field, and by presenting frames without queueing them behind "
+      "V-Sync where the backend allows it. Shows an input latency estimate next to the FPS "
+      "counter.\nHas no effect on input during NetPlay and movie playback or "
+      "recording.\n\nIf unsure, leave this unchecked.");
+static wxString pace_presents_desc =
+    _("Presents each frame after the emulated time since the previous one has passed, instead "
+      "of as soon as it is drawn. Evens out frame times on variable refresh rate (G-Sync, "
+      "FreeSync) displays with V-Sync off. The frame profile overlay shows how steady the "
+      "presents are.\nAdds up to a frame of latency.\n\nIf unsure, leave this unchecked.");
 static wxString bfi_desc =
     _("Insert black frames to reduce motion blur in 120hz monitors");
 static wxString af_desc =
@@ -148,7 +159,8 @@ static wxString af_desc =
 static wxString aa_desc =
     _("Reduces the amount of aliasing caused by rasterizing 3D graphics.\nThis makes the rendered "
       "picture look less blocky.\nHeavily decreases emulation speed and sometimes causes "
-      "issues.\n\nIf unsure, select None.");
+      "issues.\nFXAA smooths edges in a post-processing pass at internal resolution, it is much "
+      "cheaper than MSAA but blurs some fine details.\n\nIf unsure, select None.");
 static wxString scaled_efb_copy_desc = _(
     "Greatly increases quality of textures generated using render to texture effects.\nRaising the "
     "internal resolution will improve the effect of this setting.\nSlightly decreases performance "
@@ -212,6 +224,10 @@ static wxString skip_efb_copy_to_ram_desc =
     _("Stores EFB Copies exclusively on the GPU, bypassing system memory. Causes graphical defects "
       "in a small number of games.\n\nEnabled = EFB Copies to Texture\nDisabled = EFB Copies to "
       "RAM (and Texture)\n\nIf unsure, leave this checked.");
+static wxString defer_efb_copies_desc =
+    _("Keeps EFB Copies to RAM on the GPU until a texture, the end of the frame or the game waiting "
+      "for the GPU needs them, instead of waiting for each one. Games that read copies without "
+      "waiting for the GPU see old data.\n\nIf unsure, leave this unchecked.");
 static wxString stc_desc =
     _("The safer you adjust this, the less likely the emulator will be missing any texture updates "
       "from RAM.\n\nIf unsure, use the rightmost value.");
@@ -250,6 +266,13 @@ static wxString log_render_time_to_file_desc =
                 "unsure, leave this unchecked.");
 static wxString show_stats_desc =
     wxTRANSLATE("Show various rendering statistics.\n\nIf unsure, leave this unchecked.");
+static wxString frame_profile_desc =
+    wxTRANSLATE("Show the CPU and GPU time spent on drawing the EFB, EFB copies, "
+                "post-processing, scaling and presenting each frame, and a graph of the last "
+                "frames.\n\nIf unsure, leave this unchecked.");
+static wxString log_frame_profile_desc =
+    wxTRANSLATE("Log the CPU and GPU times of every frame to User/Logs/frame_profile.csv.\n\nIf "
+                "unsure, leave this unchecked.");
 static wxString show_netplay_messages_desc =
     wxTRANSLATE("When playing on NetPlay, show chat messages, buffer changes and "
                 "desync alerts.\n\nIf unsure, leave this unchecked.");
@@ -281,6 +304,10 @@ static wxString compute_texture_decoding_desc =
     _("Decode Textures using compute shaders. Can Increase Performance in some scenarios.");
 static wxString Compute_texture_encoding_desc =
     _("Encode Textures using compute shaders. Can Increase Performance in some scenarios.");
+static wxString gpu_vertex_decoding_desc =
+    _("Converts large draws to the host vertex format using compute shaders instead of the CPU. "
+      "Can increase performance in games that draw a lot of geometry at once.\nNot used while "
+      "bounding box is emulated on the CPU.\n\nIf unsure, leave this unchecked.");
 static wxString waitforshadercompilation_desc =
     _("Wait for shader compilation in the cpu to avoid fifo problems. This option prevents loops "
       "in F-Zero, Metroid Prime fifo resets and others.");
@@ -300,8 +327,29 @@ static wxString wait_cache_hires_textures_desc =
     "but improves stability and reduces stuttering in-game. Most useful with textures on "
     "networked drive. "
     "\n\nIf unsure, leave this unchecked.");
+static wxString pack_hires_textures_desc =
+    _("Pack the custom textures of the game into a single file the next time it starts, to "
+      "User/Load/Textures/<game_id>.htp.\nPacked textures load much faster, are already "
+      "compressed and only take memory while in use. Delete the pack to use the texture "
+      "directories again.\n\nIf unsure, leave this unchecked.");
+static wxString compress_hires_textures_desc =
+    _("Compress the custom textures loaded from images to DXT5 in the background, once they are "
+      "in use.\nThey take a quarter of the video memory afterwards, at some loss of quality. "
+      "Packed textures are already compressed.\n\nIf unsure, leave this unchecked.");
 static wxString dump_efb_desc =
     _("Dump the contents of EFB copies to User/Dump/Textures/\n\nIf unsure, leave this unchecked.");
+static wxString dump_vertex_loader_profile_desc =
+    _("Record which vertex formats the game uses and how often to "
+      "User/Dump/VertexLoaders/.\nThese profiles are used to build precompiled vertex loaders."
+      "\n\nIf unsure, leave this unchecked.");
+static wxString dump_shader_compile_stats_desc =
+    _("Write how long shaders took to compile, how long draws waited for them and how often "
+      "the disk cache had them to User/Dump/ShaderStats/ when emulation stops."
+      "\n\nIf unsure, leave this unchecked.");
+static wxString dump_texture_cache_stats_desc =
+    _("Write how long loading textures took in hashing, custom texture lookups, decoding, "
+      "scaling and uploading, with the cache hits and misses of each texture format, to "
+      "User/Dump/TextureCacheStats/ when emulation stops.\n\nIf unsure, leave this unchecked.");
 static wxString internal_resolution_frame_dumping_desc = _(
     "Create frame dumps and screenshots at the internal resolution of the renderer, rather than "
     "the size of the window it is displayed within. If the aspect ratio is widescreen, the output "
@@ -338,6 +386,14 @@ static wxString pptrigger_desc =
       "post-processing when an EFB copy of a perspective scene is requested. This may work for for "
       "other games. After blit will apply post processing after bliting reducing gpu usage when "
       "using High efb scales.\n\nIf unsure, select On Swap.");
+static wxString ppbake_options_desc =
+    _("Compiles the options of the post-processing shaders into the shaders, so the disabled "
+      "effects are removed from them. Faster, but each option change compiles the shaders again, "
+      "which makes tuning the options slower.\n\nIf unsure, leave this unchecked.");
+static wxString ppdynamic_scale_desc =
+    _("Lowers the resolution of the post-processing passes that allow it, such as ambient "
+      "occlusion, when frames take longer than the refresh rate of the game, and raises it again "
+      "once there is time to spare.\n\nIf unsure, leave this unchecked.");
 static wxString ppshader_list_desc =
     _("Applies post-processing effects when the trigger chosen in the occurs, by default this is "
       "at the end of a frame.\n\nPost-processing is performed at the selected internal "
@@ -392,6 +448,16 @@ static wxString Tessellation_displacement_desc =
 static wxString scaling_factor_desc = _("Multiplier applied to the texture size.");
 static wxString texture_deposterize_desc =
     _("Decrease some gradient's artifacts caused by scaling.");
+static wxString texture_scaling_async_desc =
+    _("Scale textures in the background instead of stalling the frame that first uses them. "
+      "New textures show at native resolution for a few frames.\n\nIf unsure, leave this "
+      "unchecked.");
+static wxString texture_scaling_gpu_desc =
+    _("Scale textures with compute shaders instead of on the CPU. xBRZ, the hybrid filters and "
+      "deposterizing still run on the CPU.\n\nIf unsure, leave this unchecked.");
+static wxString texture_scaling_cache_desc =
+    _("Keeps the scaled textures of each game on disk, so that they don't have to be scaled "
+      "again the next time the game uses them.\n\nIf unsure, leave this unchecked.");
 static wxString stereoshader_desc =
     _("Selects which shader will be used to transform the two images when stereoscopy is enabled.");
 static wxString forcedLogivOp_desc =
@@ -400,6 +466,20 @@ static wxString forcedLogivOp_desc =
       "will allow you to test if your driver really supports logic blending, but it will crash the "
       "emulator if enabled in a platform that does not support it.\n\nIf unsure, leave this "
       "unchecked.");
+static wxString display_list_cache_desc =
+    _("Remembers the commands and converted vertices of display lists that games draw repeatedly, "
+      "so that unchanged lists don't have to be decoded again.\nSpeeds up games that draw most of "
+      "their geometry with display lists, at the cost of some memory.\n\nIf unsure, leave this "
+      "unchecked.");
+static wxString track_texture_writes_desc =
+    _("Watches the memory of textures for writes, so that textures that didn't change since they "
+      "were last used don't have to be hashed again.\nSpeeds up games with many large textures. "
+      "Requires fastmem and isn't available on macOS.\n\nIf unsure, leave this unchecked.");
+static wxString skip_duplicate_frames_desc =
+    _("Shows the last frame again instead of presenting a new one when nothing was drawn since it "
+      "and it comes from the same XFB. Halves the presentation cost of games that run at 30 FPS. "
+      "Animated post-processing effects stop on repeated frames.\n\nIf unsure, leave this "
+      "unchecked.");
 static wxString backend_multithreading_desc =
     _("Enables multi-threading in the video backend, which may result in performance "
       "gains in some scenarios.\n\nIf unsure, leave this unchecked.");
@@ -552,6 +632,10 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
         {
           szr_display->Add(
               CreateCheckBox(page_general, _("V-Sync"), (vsync_desc), Config::GFX_VSYNC));
+          szr_display->Add(CreateCheckBox(page_general, _("Low Latency"), (low_latency_desc),
+                                          Config::GFX_LOW_LATENCY));
+          szr_display->Add(CreateCheckBox(page_general, _("Pace Presents"),
+                                          (pace_presents_desc), Config::GFX_PACE_PRESENTS));
           szr_display->Add(
               CreateCheckBox(page_general, _("Black Frame insetion"), (bfi_desc), Config::GFX_USE_BLACK_FRAME_INSERTION));
           szr_display->Add(CreateCheckBoxRefBool(page_general, _("Use Fullscreen"),
@@ -799,6 +883,18 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
       wxStaticBoxSizer* const group_scaling =
           new wxStaticBoxSizer(wxVERTICAL, page_enh, _("Texture Scaling"));
       group_scaling->Add(szr_texturescaling, 1, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 5);
+      group_scaling->Add(CreateCheckBox(page_enh, _("Scale in Background"),
+                                        (texture_scaling_async_desc),
+                                        Config::GFX_ENHANCE_TEXTURE_SCALING_ASYNC),
+                         0, wxLEFT | wxRIGHT | wxBOTTOM, 5);
+      group_scaling->Add(GPU_Texture_scaling = CreateCheckBox(
+                             page_enh, _("Scale on GPU"), (texture_scaling_gpu_desc),
+                             Config::GFX_ENHANCE_TEXTURE_SCALING_GPU),
+                         0, wxLEFT | wxRIGHT | wxBOTTOM, 5);
+      group_scaling->Add(CreateCheckBox(page_enh, _("Cache Scaled Textures"),
+                                        (texture_scaling_cache_desc),
+                                        Config::GFX_ENHANCE_TEXTURE_SCALING_CACHE),
+                         0, wxLEFT | wxRIGHT | wxBOTTOM, 5);
       szr_enh_main->Add(group_scaling, 0, wxEXPAND | wxALL, 5);
     }
     {
@@ -1103,6 +1199,15 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
           wxALIGN_CENTER_VERTICAL, 0);
       szr_options->Add(choice_pptrigger, 1, wxEXPAND | wxALIGN_CENTER_VERTICAL);
 
+      szr_options->AddSpacer(1);
+      szr_options->Add(CreateCheckBox(page_postprocessing, _("Bake Shader Options"),
+                                      (ppbake_options_desc),
+                                      Config::GFX_ENHANCE_POST_BAKE_OPTIONS));
+      szr_options->AddSpacer(1);
+      szr_options->Add(CreateCheckBox(page_postprocessing, _("Dynamic Pass Resolution"),
+                                      (ppdynamic_scale_desc),
+                                      Config::GFX_ENHANCE_POST_DYNAMIC_SCALE));
+
       choice_scalingshader = new wxChoice(page_postprocessing, wxID_ANY);
       choice_scalingshader->Bind(wxEVT_CHOICE, &VideoConfigDiag::Event_ScalingShader, this);
       RegisterControl(choice_scalingshader, wxGetTranslation(scalingshader_desc));
@@ -1170,6 +1275,9 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
     szr_efb->Add(CreateCheckBox(page_hacks, _("Store EFB copies to Texture Only"),
                                 (skip_efb_copy_to_ram_desc), Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM),
                  0, wxBOTTOM | wxLEFT, 5);
+    szr_efb->Add(CreateCheckBox(page_hacks, _("Defer EFB Copies to RAM"), (defer_efb_copies_desc),
+                                Config::GFX_HACK_DEFER_EFB_COPIES),
+                 0, wxBOTTOM | wxLEFT, 5);
     szr_hacks->Add(szr_efb, 0, wxEXPAND | wxALL, 5);
 
     // Texture cache
@@ -1257,6 +1365,14 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
       szr_other->Add(Forced_LogicOp =
                          CreateCheckBox(page_hacks, _("Force Logic Blending"), (forcedLogivOp_desc),
                                         Config::GFX_HACK_FORCE_LOGICOP_BLEND));
+      szr_other->Add(CreateCheckBox(page_hacks, _("Cache Display Lists"), (display_list_cache_desc),
+                                    Config::GFX_HACK_DISPLAY_LIST_CACHE));
+      szr_other->Add(CreateCheckBox(page_hacks, _("Track Texture Writes"),
+                                    (track_texture_writes_desc),
+                                    Config::GFX_HACK_TRACK_TEXTURE_WRITES));
+      szr_other->Add(CreateCheckBox(page_hacks, _("Skip Duplicate Frames"),
+                                    (skip_duplicate_frames_desc),
+                                    Config::GFX_HACK_SKIP_DUPLICATE_FRAMES));
       szr_other->Add(Async_Shader_compilation =
                          CreateCheckBox(page_hacks, _("Full Async Shader Compilation"),
                                         (fullAsyncShaderCompilation_desc),
@@ -1267,6 +1383,9 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
       szr_other->Add(Compute_Shader_encoding = CreateCheckBox(
                          page_hacks, _("Compute Texture Encoding"), (Compute_texture_encoding_desc),
                          Config::GFX_ENABLE_COMPUTE_TEXTURE_ENCODING));
+      szr_other->Add(GPU_Vertex_decoding = CreateCheckBox(
+                         page_hacks, _("GPU Vertex Decoding"), (gpu_vertex_decoding_desc),
+                         Config::GFX_ENABLE_GPU_VERTEX_DECODING));
 
       wxStaticBoxSizer* const group_other =
           new wxStaticBoxSizer(wxVERTICAL, page_hacks, _("Other"));
@@ -1293,6 +1412,11 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
                                     Config::GFX_ENABLE_WIREFRAME));
       szr_debug->Add(CreateCheckBox(page_advanced, _("Show Statistics"), (show_stats_desc),
                                     Config::GFX_OVERLAY_STATS));
+      szr_debug->Add(CreateCheckBox(page_advanced, _("Show Frame Profile"), (frame_profile_desc),
+                                    Config::GFX_OVERLAY_FRAME_PROFILE));
+      szr_debug->Add(CreateCheckBox(page_advanced, _("Log Frame Profile to File"),
+                                    (log_frame_profile_desc),
+                                    Config::GFX_LOG_FRAME_PROFILE_TO_FILE));
       szr_debug->Add(CreateCheckBox(page_advanced, _("Texture Format Overlay"), (texfmt_desc),
                                     Config::GFX_TEXFMT_OVERLAY_ENABLE));
       if (vconfig.backend_info.bSupportsValidationLayer)
@@ -1326,8 +1450,16 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
       hires_texturemaps =
           CreateCheckBox(page_advanced, _("Load Custom Material Maps"),
                          load_hires_material_maps_desc, Config::GFX_HIRES_MATERIAL_MAPS);
+      pack_hires_textures =
+          CreateCheckBox(page_advanced, _("Pack Custom Textures"), pack_hires_textures_desc,
+                         Config::GFX_PACK_HIRES_TEXTURES);
+      compress_hires_textures =
+          CreateCheckBox(page_advanced, _("Compress Custom Textures"),
+                         compress_hires_textures_desc, Config::GFX_COMPRESS_HIRES_TEXTURES);
       szr_utility->Add(cache_hires_textures);
       szr_utility->Add(wait_cache_hires_textures);
+      szr_utility->Add(pack_hires_textures);
+      szr_utility->Add(compress_hires_textures);
       if (vconfig.backend_info.bSupportsInternalResolutionFrameDumps)
       {
         szr_utility->Add(CreateCheckBox(page_advanced, _("Full Resolution Frame Dumps"),
@@ -1337,6 +1469,15 @@ VideoConfigDiag::VideoConfigDiag(wxWindow* parent, const std::string& title)
       szr_utility->Add(hires_texturemaps);
       szr_utility->Add(CreateCheckBox(page_advanced, _("Dump EFB Target"), (dump_efb_desc),
                                       Config::GFX_DUMP_EFB_TARGET));
+      szr_utility->Add(CreateCheckBox(page_advanced, _("Dump Vertex Loader Profile"),
+                                      (dump_vertex_loader_profile_desc),
+                                      Config::GFX_DUMP_VERTEX_LOADER_PROFILE));
+      szr_utility->Add(CreateCheckBox(page_advanced, _("Dump Shader Compile Statistics"),
+                                      (dump_shader_compile_stats_desc),
+                                      Config::GFX_DUMP_SHADER_COMPILE_STATS));
+      szr_utility->Add(CreateCheckBox(page_advanced, _("Dump Texture Cache Statistics"),
+                                      (dump_texture_cache_stats_desc),
+                                      Config::GFX_DUMP_TEXTURE_CACHE_STATS));
       szr_utility->Add(
           CreateCheckBox(page_advanced, _("Free Look"), (free_look_desc), Config::GFX_FREE_LOOK));
       szr_utility->Add(shaderprecompile = CreateCheckBox(
@@ -1931,12 +2072,17 @@ void VideoConfigDiag::OnUpdateUI(wxUpdateUIEvent& ev)
   // custom textures
   cache_hires_textures->Enable(vconfig.bHiresTextures);
   wait_cache_hires_textures->Enable(vconfig.bHiresTextures);
+  pack_hires_textures->Enable(vconfig.bHiresTextures);
+  compress_hires_textures->Enable(vconfig.bHiresTextures &&
+                                  vconfig.backend_info.bSupportedFormats[PC_TEX_FMT_DXT5]);
   hires_texturemaps->Enable(vconfig.bHiresTextures && vconfig.bEnablePixelLighting);
   hires_texturemaps->Show(vconfig.backend_info.bSupportsNormalMaps);
 
   Async_Shader_compilation->Show(vconfig.backend_info.bSupportsAsyncShaderCompilation);
   GPU_Texture_decoding->Show(vconfig.backend_info.bSupportsGPUTextureDecoding);
+  GPU_Texture_scaling->Show(vconfig.backend_info.bSupportsGPUTextureScaling);
   Compute_Shader_encoding->Show(vconfig.backend_info.bSupportsComputeTextureEncoding);
+  GPU_Vertex_decoding->Show(vconfig.backend_info.bSupportsGPUVertexDecoding);
   Forced_LogicOp->Show(vconfig.backend_info.APIType == API_D3D11);
 
   /*Predictive_FIFO->Show(vconfig.backend_info.APIType != API_OPENGL);
@@ -2118,6 +2264,17 @@ void VideoConfigDiag::PopulateAAList()
     }
   }
 
+  // Post-processing anti-aliasing is the last entry
+  if (vconfig.backend_info.bSupportsPostProcessing)
+  {
+    choice_aamode->AppendString(_("FXAA"));
+    if (vconfig.bPostProcessingAA && vconfig.iMultisamples <= 1)
+    {
+      choice_aamode->SetSelection(choice_aamode->GetCount() - 1);
+      return;
+    }
+  }
+
   int selected_mode_index = 0;
 
   auto index = std::find(aa_modes.begin(), aa_modes.end(), vconfig.iMultisamples);
@@ -2136,6 +2293,15 @@ void VideoConfigDiag::OnAAChanged(wxCommandEvent& ev)
   int mode = ev.GetInt();
   ev.Skip();
   const std::vector<u32>& aa_modes = vconfig.backend_info.AAModes;
+  const bool post_aa = vconfig.backend_info.bSupportsPostProcessing &&
+                       mode == static_cast<int>(choice_aamode->GetCount()) - 1;
+  Config::SetBaseOrCurrent(Config::GFX_POST_AA, post_aa);
+  if (post_aa)
+  {
+    Config::SetBaseOrCurrent(Config::GFX_SSAA, false);
+    Config::SetBaseOrCurrent(Config::GFX_MSAA, 1u);
+    return;
+  }
   bool ssaa = mode >= aa_modes.size();
   Config::SetBaseOrCurrent(Config::GFX_SSAA, ssaa);
   mode -= ssaa * (aa_modes.size() - 1);
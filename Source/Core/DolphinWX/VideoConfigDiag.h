@@ -201,7 +201,9 @@ protected:
   SettingCheckBox* emulate_efb_format_changes;
   SettingCheckBox* Async_Shader_compilation;
   SettingCheckBox* GPU_Texture_decoding;
+  SettingCheckBox* GPU_Texture_scaling;
   SettingCheckBox* Compute_Shader_encoding;
+  SettingCheckBox* GPU_Vertex_decoding;
   SettingCheckBox* Forced_LogicOp;
   SettingCheckBox* Predictive_FIFO;
   SettingCheckBox* Wait_For_Shaders;
@@ -211,6 +213,8 @@ protected:
   SettingCheckBox* hires_texturemaps;
   SettingCheckBox* cache_hires_textures;
   SettingCheckBox* wait_cache_hires_textures;
+  SettingCheckBox* pack_hires_textures;
+  SettingCheckBox* compress_hires_textures;
   SettingCheckBox* shaderprecompile;
 
   wxButton* button_config_scalingshader;
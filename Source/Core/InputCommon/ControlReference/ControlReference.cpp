@@ -31,8 +31,12 @@ void ControlReference::UpdateReference(const ciface::Core::DeviceContainer& devi
                                        const ciface::Core::DeviceQualifier& default_device)
 {
   ControlFinder finder(devices, default_device, IsInput());
+  m_compiled_expression.Clear();
   if (m_parsed_expression)
+  {
     m_parsed_expression->UpdateReferences(finder);
+    m_parsed_expression->Compile(m_compiled_expression);
+  }
 }
 
 int ControlReference::BoundCount() const
@@ -57,6 +61,9 @@ void ControlReference::SetExpression(std::string expr)
 {
   m_expression = std::move(expr);
   std::tie(m_parse_status, m_parsed_expression) = ParseExpression(m_expression);
+  m_compiled_expression.Clear();
+  if (m_parsed_expression)
+    m_parsed_expression->Compile(m_compiled_expression);
 }
 
 ControlReference::ControlReference() : range(1), m_parsed_expression(nullptr)
@@ -91,7 +98,7 @@ bool OutputReference::IsInput() const
 ControlState InputReference::State(const ControlState ignore)
 {
   if (m_parsed_expression && InputGateOn())
-    return m_parsed_expression->GetValue() * range;
+    return m_compiled_expression.Evaluate() * range;
   return 0.0;
 }
 
@@ -43,6 +43,7 @@ protected:
   ControlReference();
   std::string m_expression;
   std::unique_ptr<ciface::ExpressionParser::Expression> m_parsed_expression;
+  ciface::ExpressionParser::CompiledExpression m_compiled_expression;
   ciface::ExpressionParser::ParseStatus m_parse_status;
 };
 
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
 #include <map>
@@ -229,6 +230,14 @@ public:
     m_device = finder.FindDevice(qualifier);
     control = finder.FindControl(qualifier);
   }
+  void Compile(CompiledExpression& compiled) const override
+  {
+    Device::Input* const input = control ? control->ToInput() : nullptr;
+    if (input)
+      compiled.Push(CompiledExpression::Op::Input, input);
+    else
+      compiled.Push(CompiledExpression::Op::Zero);
+  }
   operator std::string() const override { return "`" + static_cast<std::string>(qualifier) + "`"; }
 };
 
@@ -282,6 +291,26 @@ public:
     rhs->UpdateReferences(finder);
   }
 
+  void Compile(CompiledExpression& compiled) const override
+  {
+    lhs->Compile(compiled);
+    rhs->Compile(compiled);
+    switch (op)
+    {
+    case TOK_AND:
+      compiled.Push(CompiledExpression::Op::And);
+      break;
+    case TOK_OR:
+      compiled.Push(CompiledExpression::Op::Or);
+      break;
+    case TOK_ADD:
+      compiled.Push(CompiledExpression::Op::Add);
+      break;
+    default:
+      assert(false);
+    }
+  }
+
   operator std::string() const override
   {
     return OpName(op) + "(" + (std::string)(*lhs) + ", " + (std::string)(*rhs) + ")";
@@ -326,6 +355,11 @@ public:
 
   int CountNumControls() const override { return inner->CountNumControls(); }
   void UpdateReferences(ControlFinder& finder) override { inner->UpdateReferences(finder); }
+  void Compile(CompiledExpression& compiled) const override
+  {
+    inner->Compile(compiled);
+    compiled.Push(CompiledExpression::Op::Not);
+  }
   operator std::string() const override { return OpName(op) + "(" + (std::string)(*inner) + ")"; }
 };
 
@@ -359,6 +393,9 @@ public:
     m_rhs->UpdateReferences(finder);
   }
 
+  // Which child is active only changes when the references are updated.
+  void Compile(CompiledExpression& compiled) const override { GetActiveChild()->Compile(compiled); }
+
 private:
   const std::unique_ptr<Expression>& GetActiveChild() const
   {
@@ -369,6 +406,65 @@ private:
   std::unique_ptr<Expression> m_rhs;
 };
 
+void CompiledExpression::Clear()
+{
+  m_instructions.clear();
+  m_depth = 0;
+  m_max_depth = 0;
+}
+
+void CompiledExpression::Push(Op op, Device::Input* input)
+{
+  m_instructions.push_back({op, input});
+  if (op == Op::Input || op == Op::Zero)
+    m_max_depth = std::max(m_max_depth, ++m_depth);
+  else if (op != Op::Not)
+    m_depth--;
+}
+
+ControlState CompiledExpression::Evaluate() const
+{
+  // Expressions rarely nest deep enough to need more than this.
+  std::array<ControlState, 16> small_stack;
+  std::vector<ControlState> large_stack;
+  ControlState* stack = small_stack.data();
+  if (m_max_depth > small_stack.size())
+  {
+    large_stack.resize(m_max_depth);
+    stack = large_stack.data();
+  }
+
+  size_t top = 0;
+  for (const Instruction& instruction : m_instructions)
+  {
+    switch (instruction.op)
+    {
+    case Op::Input:
+      stack[top++] = instruction.input->GetState();
+      break;
+    case Op::Zero:
+      stack[top++] = 0.0;
+      break;
+    case Op::And:
+      top--;
+      stack[top - 1] = std::min(stack[top - 1], stack[top]);
+      break;
+    case Op::Or:
+      top--;
+      stack[top - 1] = std::max(stack[top - 1], stack[top]);
+      break;
+    case Op::Add:
+      top--;
+      stack[top - 1] = std::min(stack[top - 1] + stack[top], 1.0);
+      break;
+    case Op::Not:
+      stack[top - 1] = 1.0 - stack[top - 1];
+      break;
+    }
+  }
+  return top > 0 ? stack[0] : 0.0;
+}
+
 std::shared_ptr<Device> ControlFinder::FindDevice(ControlQualifier qualifier) const
 {
   if (qualifier.has_device)
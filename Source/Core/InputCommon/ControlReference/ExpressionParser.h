@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include "InputCommon/ControllerInterface/Device.h"
 
 namespace ciface
@@ -47,6 +48,37 @@ private:
   bool is_input;
 };
 
+// An input expression flattened into postfix order once its controls are bound, so that reading
+// it is a single loop over the inputs instead of a walk through the tree.
+class CompiledExpression
+{
+public:
+  enum class Op : u8
+  {
+    Input,
+    Zero,
+    And,
+    Or,
+    Add,
+    Not,
+  };
+
+  void Clear();
+  void Push(Op op, Core::Device::Input* input = nullptr);
+  ControlState Evaluate() const;
+
+private:
+  struct Instruction
+  {
+    Op op;
+    Core::Device::Input* input;
+  };
+
+  std::vector<Instruction> m_instructions;
+  size_t m_depth = 0;
+  size_t m_max_depth = 0;
+};
+
 class Expression
 {
 public:
@@ -55,6 +87,7 @@ public:
   virtual void SetValue(ControlState state) = 0;
   virtual int CountNumControls() const = 0;
   virtual void UpdateReferences(ControlFinder& finder) = 0;
+  virtual void Compile(CompiledExpression& compiled) const = 0;
   virtual operator std::string() const = 0;
 };
 
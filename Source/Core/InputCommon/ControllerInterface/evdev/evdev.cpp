@@ -2,14 +2,18 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <fcntl.h>
 #include <libudev.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unistd.h>
 
+#include <sys/epoll.h>
 #include <sys/eventfd.h>
 
 #include "Common/Assert.h"
@@ -29,6 +33,25 @@ static std::thread s_hotplug_thread;
 static Common::Flag s_hotplug_thread_running;
 static int s_wakeup_eventfd;
 
+// Every device fd is watched (edge triggered) by this epoll instance, which the hotplug thread
+// waits on, so that idle devices aren't read on every input update. Each event points to the
+// m_has_events flag of its device; the mutex keeps a device from being freed while it is set.
+static int s_events_epollfd = -1;
+static std::mutex s_events_mutex;
+
+static void DispatchDeviceEvents()
+{
+  std::array<epoll_event, 16> events;
+  std::lock_guard<std::mutex> lk(s_events_mutex);
+  int count;
+  do
+  {
+    count = epoll_wait(s_events_epollfd, events.data(), static_cast<int>(events.size()), 0);
+    for (int i = 0; i < count; i++)
+      static_cast<std::atomic<bool>*>(events[i].data.ptr)->store(true);
+  } while (count == static_cast<int>(events.size()));
+}
+
 // There is no easy way to get the device name from only a dev node
 // during a device removed event, since libevdev can't work on removed devices;
 // sysfs is not stable, so this is probably the easiest way to get a name for a node.
@@ -71,9 +94,17 @@ static void HotplugThreadFunc()
     FD_ZERO(&fds);
     FD_SET(monitor_fd, &fds);
     FD_SET(s_wakeup_eventfd, &fds);
+    FD_SET(s_events_epollfd, &fds);
+
+    const int max_fd = std::max({monitor_fd, s_wakeup_eventfd, s_events_epollfd});
+    int ret = select(max_fd + 1, &fds, nullptr, nullptr, nullptr);
+    if (ret < 1)
+      continue;
+
+    if (FD_ISSET(s_events_epollfd, &fds))
+      DispatchDeviceEvents();
 
-    int ret = select(std::max(monitor_fd, s_wakeup_eventfd) + 1, &fds, nullptr, nullptr, nullptr);
-    if (ret < 1 || !FD_ISSET(monitor_fd, &fds))
+    if (!FD_ISSET(monitor_fd, &fds))
       continue;
 
     std::unique_ptr<udev_device, decltype(&udev_device_unref)> dev{
@@ -142,6 +173,8 @@ static void StopHotplugThread()
 void Init()
 {
   s_devnode_name_map.clear();
+  s_events_epollfd = epoll_create1(EPOLL_CLOEXEC);
+  ASSERT_MSG(PAD, s_events_epollfd != -1, "Couldn't create epoll instance.");
   StartHotplugThread();
 }
 
@@ -192,6 +225,8 @@ void PopulateDevices()
 void Shutdown()
 {
   StopHotplugThread();
+  close(s_events_epollfd);
+  s_events_epollfd = -1;
 }
 
 evdevDevice::evdevDevice(const std::string& devnode) : m_devfile(devnode)
@@ -242,12 +277,25 @@ evdevDevice::evdevDevice(const std::string& devnode) : m_devfile(devnode)
 
   m_initialized = true;
   m_interesting = num_axis >= 2 || num_buttons >= 8;
+
+  // If the device can't be watched, it is simply read on every update.
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLET;
+  event.data.ptr = &m_has_events;
+  m_watched = s_events_epollfd != -1 &&
+              epoll_ctl(s_events_epollfd, EPOLL_CTL_ADD, m_fd, &event) == 0;
 }
 
 evdevDevice::~evdevDevice()
 {
   if (m_initialized)
   {
+    if (m_watched)
+    {
+      epoll_ctl(s_events_epollfd, EPOLL_CTL_DEL, m_fd, nullptr);
+      // Wait for the hotplug thread if it is still dispatching an event to this device.
+      std::lock_guard<std::mutex> lk(s_events_mutex);
+    }
     libevdev_free(m_dev);
     close(m_fd);
   }
@@ -255,6 +303,10 @@ evdevDevice::~evdevDevice()
 
 void evdevDevice::UpdateInput()
 {
+  // Nothing to read since the device fd was last drained.
+  if (m_watched && !m_has_events.exchange(false))
+    return;
+
   // Run through all evdev events
   // libevdev will keep track of the actual controller state internally which can be queried
   // later with libevdev_fetch_event_value()
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <libevdev/libevdev.h>
 #include <string>
 #include <vector>
@@ -81,6 +82,9 @@ private:
   std::string m_name;
   bool m_initialized;
   bool m_interesting;
+  bool m_watched = false;
+  // Set by the hotplug thread when the device fd becomes readable.
+  std::atomic<bool> m_has_events{true};
 };
 }
 }
@@ -3,6 +3,9 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <libusb.h>
 #include <mutex>
 
@@ -10,6 +13,7 @@
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -35,11 +39,34 @@ static u8 s_controller_type[SerialInterface::MAX_SI_CHANNELS] = {
     ControllerTypes::CONTROLLER_NONE, ControllerTypes::CONTROLLER_NONE};
 static u8 s_controller_rumble[4];
 
-static std::mutex s_mutex;
-static u8 s_controller_payload[37];
-static u8 s_controller_payload_swap[37];
+// Several input transfers are kept in flight, so that a report is never missed while the last one
+// is handled.
+constexpr int NUM_INPUT_TRANSFERS = 4;
+static std::array<libusb_transfer*, NUM_INPUT_TRANSFERS> s_input_transfers;
+static u8 s_input_transfer_buffers[NUM_INPUT_TRANSFERS][37];
+static std::atomic<int> s_input_transfers_in_flight{0};
 
-static std::atomic<int> s_controller_payload_size = {0};
+// An adapter that stops sending reports is reset, like one whose transfers fail.
+constexpr u64 INPUT_STALL_TIMEOUT_US = 1000000;
+
+struct InputReport
+{
+  u8 payload[37];
+  // 0 before the first report, -1 after a failed transfer.
+  int size;
+  // Host time the report arrived at, in microseconds.
+  u64 timestamp;
+};
+
+// The newest report is handed to Input without locking through three buffers. The transfer
+// callback fills the back buffer and swaps it with the middle one, and Input swaps the front
+// buffer with the middle one whenever that holds a newer report, so Input always reads the
+// freshest report there is at the time the game polls.
+constexpr u32 NEW_REPORT_FLAG = 4;
+static std::array<InputReport, 3> s_input_reports;
+static u32 s_back_report = 0;
+static std::atomic<u32> s_middle_report{1};
+static u32 s_front_report = 2;
 
 static std::thread s_adapter_input_thread;
 static std::thread s_adapter_output_thread;
@@ -69,22 +96,71 @@ static u8 s_endpoint_out = 0;
 
 static u64 s_last_init = 0;
 
-static void Read()
+// Set when the adapter is unplugged, since it can't be reset from inside the hotplug callback.
+static Common::Flag s_adapter_removed;
+
+static void ResetInputReports()
 {
-  int payload_size = 0;
-  while (s_adapter_thread_running.IsSet())
+  for (InputReport& report : s_input_reports)
   {
-    libusb_interrupt_transfer(s_handle, s_endpoint_in, s_controller_payload_swap,
-                              sizeof(s_controller_payload_swap), &payload_size, 16);
+    report.size = 0;
+    report.timestamp = Common::Timer::GetTimeUs();
+  }
+  s_back_report = 0;
+  s_middle_report.store(1);
+  s_front_report = 2;
+}
 
-    {
-      std::lock_guard<std::mutex> lk(s_mutex);
-      std::swap(s_controller_payload_swap, s_controller_payload);
-      s_controller_payload_size.store(payload_size);
-    }
+// Runs on whichever thread handles libusb events, one at a time.
+static void LIBUSB_CALL InputTransferCallback(libusb_transfer* transfer)
+{
+  if (transfer->status == LIBUSB_TRANSFER_CANCELLED)
+  {
+    s_input_transfers_in_flight--;
+    return;
+  }
 
-    Common::YieldCPU();
+  InputReport& report = s_input_reports[s_back_report];
+  const bool completed = transfer->status == LIBUSB_TRANSFER_COMPLETED;
+  if (completed)
+  {
+    std::memcpy(report.payload, transfer->buffer, transfer->actual_length);
+    report.size = transfer->actual_length;
   }
+  else
+  {
+    report.size = -1;
+  }
+  report.timestamp = Common::Timer::GetTimeUs();
+  s_back_report = s_middle_report.exchange(s_back_report | NEW_REPORT_FLAG) & ~NEW_REPORT_FLAG;
+
+  if (!completed || !s_adapter_thread_running.IsSet() || libusb_submit_transfer(transfer) != 0)
+    s_input_transfers_in_flight--;
+}
+
+static void Read()
+{
+  for (int i = 0; i < NUM_INPUT_TRANSFERS; i++)
+  {
+    s_input_transfers[i] = libusb_alloc_transfer(0);
+    libusb_fill_interrupt_transfer(s_input_transfers[i], s_handle, s_endpoint_in,
+                                   s_input_transfer_buffers[i], sizeof(s_input_transfer_buffers[i]),
+                                   InputTransferCallback, nullptr, 0);
+    s_input_transfers_in_flight++;
+    if (libusb_submit_transfer(s_input_transfers[i]) != 0)
+      s_input_transfers_in_flight--;
+  }
+
+  timeval tv = {0, 16000};
+  while (s_adapter_thread_running.IsSet())
+    libusb_handle_events_timeout_completed(s_libusb_context, &tv, nullptr);
+
+  for (libusb_transfer* transfer : s_input_transfers)
+    libusb_cancel_transfer(transfer);
+  while (s_input_transfers_in_flight > 0)
+    libusb_handle_events_timeout_completed(s_libusb_context, &tv, nullptr);
+  for (libusb_transfer* transfer : s_input_transfers)
+    libusb_free_transfer(transfer);
 }
 
 static void Write()
@@ -118,8 +194,9 @@ static int HotplugCallback(libusb_context* ctx, libusb_device* dev, libusb_hotpl
   }
   else if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT)
   {
+    // Reset waits for the input transfers to be cancelled, which takes handling events.
     if (s_handle != nullptr && libusb_get_device(s_handle) == dev)
-      Reset();
+      s_adapter_removed.Set();
   }
   return 0;
 }
@@ -153,6 +230,8 @@ static void ScanThreadFunc()
     {
       static timeval tv = {0, 500000};
       libusb_handle_events_timeout(s_libusb_context, &tv);
+      if (s_adapter_removed.TestAndClear())
+        Reset();
     }
     else
     {
@@ -336,6 +415,7 @@ static void AddGCAdapter(libusb_device* device)
   unsigned char payload = 0x13;
   libusb_interrupt_transfer(s_handle, s_endpoint_out, &payload, sizeof(payload), &tmp, 16);
 
+  ResetInputReports();
   s_adapter_thread_running.Set(true);
   s_adapter_input_thread = std::thread(Read);
   s_adapter_output_thread = std::thread(Write);
@@ -402,19 +482,20 @@ GCPadStatus Input(int chan)
   if (s_handle == nullptr || !s_detected)
     return {};
 
-  int payload_size = 0;
-  u8 controller_payload_copy[37];
+  if (s_middle_report.load(std::memory_order_relaxed) & NEW_REPORT_FLAG)
+    s_front_report = s_middle_report.exchange(s_front_report) & ~NEW_REPORT_FLAG;
+  const InputReport& report = s_input_reports[s_front_report];
+  const u8* controller_payload_copy = report.payload;
+  const int payload_size = report.size;
+  const bool stalled = Common::Timer::GetTimeUs() > report.timestamp + INPUT_STALL_TIMEOUT_US;
 
+  GCPadStatus pad = {};
+  if (payload_size == 0 && !stalled)
   {
-    std::lock_guard<std::mutex> lk(s_mutex);
-    std::copy(std::begin(s_controller_payload), std::end(s_controller_payload),
-              std::begin(controller_payload_copy));
-    payload_size = s_controller_payload_size.load();
+    // Nothing arrived since the adapter was attached yet.
   }
-
-  GCPadStatus pad = {};
-  if (payload_size != sizeof(controller_payload_copy) ||
-      controller_payload_copy[0] != LIBUSB_DT_HID)
+  else if (payload_size != sizeof(report.payload) || controller_payload_copy[0] != LIBUSB_DT_HID ||
+           stalled)
   {
     ERROR_LOG(SERIALINTERFACE, "error reading payload (size: %d, type: %02x)", payload_size,
               controller_payload_copy[0]);
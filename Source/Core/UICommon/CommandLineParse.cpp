@@ -14,6 +14,8 @@
 #include "Common/StringUtil.h"
 #include "Common/Version.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/Profiler.h"
 #include "UICommon/CommandLineParse.h"
 
 namespace CommandLineParse
@@ -89,6 +91,17 @@ std::unique_ptr<optparse::OptionParser> CreateParser(ParserOptions options)
       .metavar("<System>.<Section>.<Key>=<Value>")
       .type("string")
       .help("Set a configuration option");
+  parser->add_option("--profile_jit")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Profile JIT blocks and write the results to <file> (.csv or .json) on shutdown");
+  parser->add_option("--trace")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Record trace events of all threads and write them to <file> on shutdown, for "
+            "chrome://tracing or the Perfetto UI");
 
   if (options == ParserOptions::IncludeGUIOptions)
   {
@@ -121,10 +134,19 @@ static void AddConfigLayer(const optparse::Values& options)
   }
 }
 
+static void SetExportPaths(const optparse::Values& options)
+{
+  if (options.is_set("profile_jit"))
+    Profiler::SetExportPath(static_cast<const char*>(options.get("profile_jit")));
+  if (options.is_set("trace"))
+    Core::SetTraceExportPath(static_cast<const char*>(options.get("trace")));
+}
+
 optparse::Values& ParseArguments(optparse::OptionParser* parser, int argc, char** argv)
 {
   optparse::Values& options = parser->parse_args(argc, argv);
   AddConfigLayer(options);
+  SetExportPaths(options);
   return options;
 }
 
@@ -133,6 +155,7 @@ optparse::Values& ParseArguments(optparse::OptionParser* parser,
 {
   optparse::Values& options = parser->parse_args(arguments);
   AddConfigLayer(options);
+  SetExportPaths(options);
   return options;
 }
 }
@@ -77,6 +77,10 @@ GameFile::GameFile(const std::string& path)
     SplitPath(m_file_path, nullptr, &name, &extension);
     m_file_name = name + extension;
 
+    const File::FileInfo info(m_file_path);
+    m_size_on_disk = info.GetSize();
+    m_last_modified = info.GetModificationTime();
+
     std::unique_ptr<DiscIO::Volume> volume(DiscIO::CreateVolumeFromFilename(m_file_path));
     if (volume != nullptr)
     {
@@ -128,6 +132,12 @@ bool GameFile::IsValid() const
   return true;
 }
 
+bool GameFile::HasChangedOnDisk() const
+{
+  const File::FileInfo info(m_file_path);
+  return info.GetSize() != m_size_on_disk || info.GetModificationTime() != m_last_modified;
+}
+
 bool GameFile::CustomNameChanged(const Core::TitleDatabase& title_database)
 {
   const auto type = m_platform == DiscIO::Platform::WiiWAD ?
@@ -176,6 +186,8 @@ void GameFile::DoState(PointerWrap& p)
 
   p.Do(m_file_size);
   p.Do(m_volume_size);
+  p.Do(m_size_on_disk);
+  p.Do(m_last_modified);
 
   p.Do(m_short_names);
   p.Do(m_long_names);
@@ -46,6 +46,8 @@ public:
   ~GameFile() = default;
 
   bool IsValid() const;
+  // Whether the size or modification time of the file differs from when it was probed.
+  bool HasChangedOnDisk() const;
   const std::string& GetFilePath() const { return m_file_path; }
   const std::string& GetFileName() const { return m_file_name; }
   const std::string& GetName(bool long_name = true) const;
@@ -116,6 +118,9 @@ private:
 
   u64 m_file_size{};
   u64 m_volume_size{};
+  // As reported by the file system, unlike m_file_size, which comes from the volume
+  u64 m_size_on_disk{};
+  u64 m_last_modified{};
 
   std::map<DiscIO::Language, std::string> m_short_names{};
   std::map<DiscIO::Language, std::string> m_long_names{};
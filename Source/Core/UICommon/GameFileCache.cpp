@@ -11,6 +11,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -19,6 +20,7 @@
 #include "Common/File.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/TitleDatabase.h"
 
@@ -28,13 +30,13 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 8;  // Last changed in PR 6560
+static constexpr u32 CACHE_REVISION = 10;  // Last changed for file modification times
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
   static const std::vector<std::string> search_extensions = {
-      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wad", ".dol", ".elf"};
+      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".dcz", ".wbfs", ".wad", ".dol", ".elf"};
 
   // TODO: We could process paths iteratively as they are found
   return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
@@ -58,7 +60,12 @@ std::shared_ptr<const GameFile> GameFileCache::AddOrGet(const std::string& path,
   auto it = std::find_if(
       m_cached_files.begin(), m_cached_files.end(),
       [&path](const std::shared_ptr<GameFile>& file) { return file->GetFilePath() == path; });
-  const bool found = it != m_cached_files.cend();
+  bool found = it != m_cached_files.cend();
+  if (found && (*it)->HasChangedOnDisk())
+  {
+    m_cached_files.erase(it);
+    found = false;
+  }
   if (!found)
   {
     std::shared_ptr<UICommon::GameFile> game = std::make_shared<GameFile>(path);
@@ -110,18 +117,63 @@ bool GameFileCache::Update(const std::vector<std::string>& all_game_paths)
     m_cached_files.erase(it, m_cached_files.end());
   }
 
-  // Now that the previous loop has run, game_paths only contains paths that
-  // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const auto& path : game_paths)
+  // Check the files that are still there for changes, and add the paths that aren't cached.
+  std::vector<std::string> paths_to_add(game_paths.begin(), game_paths.end());
+  for (const std::shared_ptr<GameFile>& file : m_cached_files)
+    paths_to_add.push_back(file->GetFilePath());
+  cache_changed |= AddOrUpdate(paths_to_add);
+
+  return cache_changed;
+}
+
+bool GameFileCache::AddOrUpdate(const std::vector<std::string>& game_paths)
+{
+  std::unordered_map<std::string, size_t> cached_indices;
+  cached_indices.reserve(m_cached_files.size());
+  for (size_t i = 0; i < m_cached_files.size(); ++i)
+    cached_indices.emplace(m_cached_files[i]->GetFilePath(), i);
+
+  // Checking a file already has to ask the file system, which is slow on network storage,
+  // so the thread pool checks cached files as well as probing new ones.
+  std::vector<std::shared_ptr<GameFile>> probed(game_paths.size());
+  Common::ThreadPool::ParallelFor(0, game_paths.size(), 1, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i)
+    {
+      const auto cached = cached_indices.find(game_paths[i]);
+      if (cached != cached_indices.end() && !m_cached_files[cached->second]->HasChangedOnDisk())
+        continue;
+      probed[i] = std::make_shared<GameFile>(game_paths[i]);
+    }
+  });
+
+  bool cache_changed = false;
+  std::vector<size_t> indices_to_remove;
+  for (size_t i = 0; i < game_paths.size(); ++i)
   {
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    if (!probed[i])
+      continue;
+
+    const auto cached = cached_indices.find(game_paths[i]);
+    if (probed[i]->IsValid())
     {
+      if (cached != cached_indices.end())
+        m_cached_files[cached->second] = std::move(probed[i]);
+      else
+        m_cached_files.push_back(std::move(probed[i]));
+      cache_changed = true;
+    }
+    else if (cached != cached_indices.end())
+    {
+      // The file has changed into something that isn't a game
+      indices_to_remove.push_back(cached->second);
       cache_changed = true;
-      m_cached_files.push_back(std::move(file));
     }
   }
 
+  std::sort(indices_to_remove.rbegin(), indices_to_remove.rend());
+  for (size_t index : indices_to_remove)
+    m_cached_files.erase(m_cached_files.begin() + index);
+
   return cache_changed;
 }
 
@@ -41,6 +41,8 @@ public:
 
   // These functions return true if the call modified the cache.
   bool Update(const std::vector<std::string>& all_game_paths);
+  // Probes the given paths that aren't cached or have changed on disk, on several threads.
+  bool AddOrUpdate(const std::vector<std::string>& game_paths);
   bool UpdateAdditionalMetadata(const Core::TitleDatabase& title_database);
 
   bool Load();
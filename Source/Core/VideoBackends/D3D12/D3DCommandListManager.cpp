@@ -32,9 +32,12 @@ D3DCommandListManager::D3DCommandListManager(
   m_command_queue(command_queue)
 {
   // Create two lists, with two command allocators each. This corresponds to up to two frames in flight at once.
+  // Each recording lane gets its own allocators.
+  m_recording_lanes = g_ActiveConfig.bBackendMultithreading ? QUEUE_RECORDING_LANES : 1;
   m_current_command_allocator = 0;
   m_current_command_allocator_list = 0;
-  for (UINT i = 0; i < COMMAND_ALLOCATORS_PER_LIST; i++)
+  m_current_lane = 0;
+  for (UINT i = 0; i < COMMAND_ALLOCATORS_PER_LIST * m_recording_lanes; i++)
   {
     for (UINT j = 0; j < m_command_allocator_lists.size(); j++)
     {
@@ -50,7 +53,15 @@ D3DCommandListManager::D3DCommandListManager(
 
   if (g_ActiveConfig.bBackendMultithreading)
   {
-    m_queued_command_list = new ID3D12QueuedCommandList(m_backing_command_list, m_command_queue);
+    // The other lanes' lists start out closed, they are reset when their turn comes.
+    m_lane_command_lists[0] = m_backing_command_list;
+    for (UINT i = 1; i < m_recording_lanes; i++)
+    {
+      CheckHR(m_device->CreateCommandList(0, command_list_type, m_command_allocator_lists[m_current_command_allocator_list][i], nullptr, IID_PPV_ARGS(&m_lane_command_lists[i])));
+      CheckHR(m_lane_command_lists[i]->Close());
+    }
+
+    m_queued_command_list = new ID3D12QueuedCommandList(m_lane_command_lists, m_command_queue);
   }
 
   // Create fence that will be used to measure GPU progress of app rendering requests (e.g. CPU readback of GPU data).
@@ -306,7 +317,7 @@ void D3DCommandListManager::PerformGPURolloverChecks()
 void D3DCommandListManager::MoveToNextCommandAllocator()
 {
   // Move to the next allocator in the current allocator list.
-  m_current_command_allocator = (m_current_command_allocator + 1) % m_command_allocator_lists[m_current_command_allocator_list].size();
+  m_current_command_allocator = (m_current_command_allocator + 1) % COMMAND_ALLOCATORS_PER_LIST;
 
   // Did we wrap around? Move to the next set of allocators.
   if (m_current_command_allocator == 0)
@@ -317,14 +328,21 @@ void D3DCommandListManager::ResetCommandList()
 {
   if (g_ActiveConfig.bBackendMultithreading)
   {
-    CheckHR(m_queued_command_list->Reset(m_command_allocator_lists[m_current_command_allocator_list][m_current_command_allocator], nullptr));
+    // Record the next list on the next lane, while the last one may still be recording.
+    m_current_lane = (m_current_lane + 1) % m_recording_lanes;
+    m_queued_command_list->QueueReset(GetCurrentCommandAllocator(), m_current_lane);
   }
   else
   {
-    CheckHR(m_backing_command_list->Reset(m_command_allocator_lists[m_current_command_allocator_list][m_current_command_allocator], nullptr));
+    CheckHR(m_backing_command_list->Reset(GetCurrentCommandAllocator(), nullptr));
   }
 }
 
+ID3D12CommandAllocator* D3DCommandListManager::GetCurrentCommandAllocator() const
+{
+  return m_command_allocator_lists[m_current_command_allocator_list][m_current_command_allocator * m_recording_lanes + m_current_lane];
+}
+
 void D3DCommandListManager::DestroyResourceAfterCurrentCommandListExecuted(ID3D12Resource* resource)
 {
   CHECK(resource, "Null resource being inserted!");
@@ -358,6 +376,8 @@ D3DCommandListManager::~D3DCommandListManager()
   DestroyAllPendingResources();
 
   m_backing_command_list->Release();
+  for (UINT i = 1; i < m_recording_lanes; i++)
+    m_lane_command_lists[i]->Release();
 
   for (auto& allocator_list : m_command_allocator_lists)
   {
@@ -70,6 +70,7 @@ private:
   void PerformGPURolloverChecks();
   void MoveToNextCommandAllocator();
   void ResetCommandList();
+  ID3D12CommandAllocator* GetCurrentCommandAllocator() const;
 
   using PendingDescriptorFree = std::pair<D3DDescriptorHeapManager*, size_t>;
 
@@ -94,10 +95,15 @@ private:
 
   UINT m_current_command_allocator{};
   UINT m_current_command_allocator_list{};
+  // With backend multithreading, consecutive command lists are recorded on different lanes, each
+  // with its own allocators.
+  UINT m_recording_lanes = 1;
+  UINT m_current_lane{};
   std::array<std::vector<ID3D12CommandAllocator*>, 2> m_command_allocator_lists;
   std::array<UINT64, 2> m_command_allocator_list_fences{};
 
   ID3D12GraphicsCommandList* m_backing_command_list{};
+  std::array<ID3D12GraphicsCommandList*, QUEUE_RECORDING_LANES> m_lane_command_lists{};
   ID3D12QueuedCommandList* m_queued_command_list{};
 
   UINT m_current_deferred_destruction_list{};
@@ -14,379 +14,590 @@ constexpr size_t BufferOffsetForQueueItemType()
   return sizeof(T) + sizeof(D3DQueueItemType) * 2;
 }
 
-void ID3D12QueuedCommandList::BackgroundThreadFunction(ID3D12QueuedCommandList* parent_queued_command_list)
+static size_t QueueItemSize(D3DQueueItemType type)
 {
-  ID3D12GraphicsCommandList* command_list = parent_queued_command_list->m_command_list;
+  switch (type)
+  {
+  case D3DQueueItemType::SetPipelineState: return BufferOffsetForQueueItemType<SetPipelineStateArguments>();
+  case D3DQueueItemType::SetRenderTargets: return BufferOffsetForQueueItemType<SetRenderTargetsArguments>();
+  case D3DQueueItemType::SetVertexBuffers: return BufferOffsetForQueueItemType<SetVertexBuffersArguments>();
+  case D3DQueueItemType::SetIndexBuffer: return BufferOffsetForQueueItemType<SetIndexBufferArguments>();
+  case D3DQueueItemType::RSSetViewports: return BufferOffsetForQueueItemType<D3D12_VIEWPORT>();
+  case D3DQueueItemType::RSSetScissorRects: return BufferOffsetForQueueItemType<RSSetScissorRectsArguments>();
+  case D3DQueueItemType::SetGraphicsRootDescriptorTable: return BufferOffsetForQueueItemType<SetGraphicsRootDescriptorTableArguments>();
+  case D3DQueueItemType::SetGraphicsRootConstantBufferView: return BufferOffsetForQueueItemType<SetGraphicsRootConstantBufferViewArguments>();
+  case D3DQueueItemType::SetGraphicsRootSignature: return BufferOffsetForQueueItemType<SetGraphicsRootSignatureArguments>();
+  case D3DQueueItemType::ClearRenderTargetView: return BufferOffsetForQueueItemType<ClearRenderTargetViewArguments>();
+  case D3DQueueItemType::ClearDepthStencilView: return BufferOffsetForQueueItemType<ClearDepthStencilViewArguments>();
+  case D3DQueueItemType::DrawInstanced: return BufferOffsetForQueueItemType<DrawInstancedArguments>();
+  case D3DQueueItemType::DrawIndexedInstanced: return BufferOffsetForQueueItemType<DrawIndexedInstancedArguments>();
+  case D3DQueueItemType::IASetPrimitiveTopology: return BufferOffsetForQueueItemType<IASetPrimitiveTopologyArguments>();
+  case D3DQueueItemType::CopyBufferRegion: return BufferOffsetForQueueItemType<CopyBufferRegionArguments>();
+  case D3DQueueItemType::CopyResource: return BufferOffsetForQueueItemType<CopyResourceArguments>();
+  case D3DQueueItemType::CopyTextureRegion: return BufferOffsetForQueueItemType<CopyTextureRegionArguments>();
+  case D3DQueueItemType::SetDescriptorHeaps: return BufferOffsetForQueueItemType<SetDescriptorHeapsArguments>();
+  case D3DQueueItemType::ResourceBarrier: return BufferOffsetForQueueItemType<ResourceBarrierArguments>();
+  case D3DQueueItemType::ResolveSubresource: return BufferOffsetForQueueItemType<ResolveSubresourceArguments>();
+  case D3DQueueItemType::BeginQuery: return BufferOffsetForQueueItemType<BeginQueryArguments>();
+  case D3DQueueItemType::EndQuery: return BufferOffsetForQueueItemType<EndQueryArguments>();
+  case D3DQueueItemType::ResolveQueryData: return BufferOffsetForQueueItemType<ResolveQueryDataArguments>();
+  case D3DQueueItemType::ExecuteCommandList: return BufferOffsetForQueueItemType<ExecuteCommandListArguments>();
+  case D3DQueueItemType::CloseCommandList: return BufferOffsetForQueueItemType<CloseCommandListArguments>();
+  case D3DQueueItemType::Present: return BufferOffsetForQueueItemType<PresentArguments>();
+  case D3DQueueItemType::ResetCommandList: return BufferOffsetForQueueItemType<ResetCommandListArguments>();
+  case D3DQueueItemType::ResetCommandAllocator: return BufferOffsetForQueueItemType<ResetCommandAllocatorArguments>();
+  case D3DQueueItemType::FenceGpuSignal: return BufferOffsetForQueueItemType<FenceGpuSignalArguments>();
+  case D3DQueueItemType::FenceCpuSignal: return BufferOffsetForQueueItemType<FenceCpuSignalArguments>();
+  case D3DQueueItemType::Stop: return BufferOffsetForQueueItemType<StopArguments>();
+  default:
+    DEBUGCHECK(0, "Unknown queue item.");
+    return 0;
+  }
+}
 
-  byte* queue_array = parent_queued_command_list->m_queue_array;
+// Follows the queue back to its front after a stop, like the producer did.
+static byte* ItemAfterStop(byte* queue_array, byte* item)
+{
+  bool eligible_to_move_to_front_of_queue = reinterpret_cast<const D3DQueueItem*>(item)->Stop.eligible_to_move_to_front_of_queue;
 
-  unsigned int queue_array_front = 0;
+  item += BufferOffsetForQueueItemType<StopArguments>();
 
+  if (eligible_to_move_to_front_of_queue && item - queue_array > QUEUE_ARRAY_SIZE * 2 / 3)
+  {
+    item = queue_array;
+  }
+
+  return item;
+}
+
+void ID3D12QueuedCommandList::RecordSegment(ID3D12GraphicsCommandList* command_list, byte* queue_array, byte* item)
+{
   while (true)
   {
-    WaitForSingleObject(parent_queued_command_list->m_begin_execution_event, INFINITE);
+    const D3DQueueItem* qitem = reinterpret_cast<const D3DQueueItem*>(item);
+    switch (qitem->Type)
+    {
+    case D3DQueueItemType::ClearDepthStencilView:
+    {
+      command_list->ClearDepthStencilView(qitem->ClearDepthStencilView.DepthStencilView, D3D12_CLEAR_FLAG_DEPTH, 0.f, 0, 0, nullptr);
 
-    byte* item = &queue_array[queue_array_front];
+      item += BufferOffsetForQueueItemType<ClearDepthStencilViewArguments>();
+      break;
+    }
 
-    while (true)
+    case D3DQueueItemType::ClearRenderTargetView:
     {
-      const D3DQueueItem* qitem = reinterpret_cast<const D3DQueueItem*>(item);
-      switch (qitem->Type)
-      {
-      case D3DQueueItemType::ClearDepthStencilView:
-      {
-        command_list->ClearDepthStencilView(qitem->ClearDepthStencilView.DepthStencilView, D3D12_CLEAR_FLAG_DEPTH, 0.f, 0, 0, nullptr);
+      float clearColor[4] = { 0.f, 0.f, 0.f, 1.f };
+      command_list->ClearRenderTargetView(qitem->ClearRenderTargetView.RenderTargetView, clearColor, 0, nullptr);
 
-        item += BufferOffsetForQueueItemType<ClearDepthStencilViewArguments>();
-        break;
-      }
+      item += BufferOffsetForQueueItemType<ClearRenderTargetViewArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::ClearRenderTargetView:
-      {
-        float clearColor[4] = { 0.f, 0.f, 0.f, 1.f };
-        command_list->ClearRenderTargetView(qitem->ClearRenderTargetView.RenderTargetView, clearColor, 0, nullptr);
+    case D3DQueueItemType::CopyBufferRegion:
+    {
+      command_list->CopyBufferRegion(
+        qitem->CopyBufferRegion.pDstBuffer,
+        qitem->CopyBufferRegion.DstOffset,
+        qitem->CopyBufferRegion.pSrcBuffer,
+        qitem->CopyBufferRegion.SrcOffset,
+        qitem->CopyBufferRegion.NumBytes
+      );
+
+      item += BufferOffsetForQueueItemType<CopyBufferRegionArguments>();
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<ClearRenderTargetViewArguments>();
-        break;
-      }
+    case D3DQueueItemType::CopyResource:
+    {
+      command_list->CopyResource(
+        qitem->CopyResource.pDstResource,
+        qitem->CopyResource.pSrcResource);
 
-      case D3DQueueItemType::CopyBufferRegion:
-      {
-        command_list->CopyBufferRegion(
-          qitem->CopyBufferRegion.pDstBuffer,
-          qitem->CopyBufferRegion.DstOffset,
-          qitem->CopyBufferRegion.pSrcBuffer,
-          qitem->CopyBufferRegion.SrcOffset,
-          qitem->CopyBufferRegion.NumBytes
-        );
-
-        item += BufferOffsetForQueueItemType<CopyBufferRegionArguments>();
-        break;
-      }
+      item += BufferOffsetForQueueItemType<CopyResourceArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::CopyResource:
-      {
-        command_list->CopyResource(
-          qitem->CopyResource.pDstResource,
-          qitem->CopyResource.pSrcResource);
+    case D3DQueueItemType::CopyTextureRegion:
+    {
+      // If box is completely empty, assume that the original API call has a NULL box (which means
+      // copy from the entire resource.
+
+      const D3D12_BOX* src_box = &qitem->CopyTextureRegion.srcBox;
+
+      // Front/Back never used, so don't need to check.
+      bool empty_box =
+        src_box->bottom == 0 &&
+        src_box->left == 0 &&
+        src_box->right == 0 &&
+        src_box->top == 0;
+
+      command_list->CopyTextureRegion(
+        &qitem->CopyTextureRegion.dst,
+        qitem->CopyTextureRegion.DstX,
+        qitem->CopyTextureRegion.DstY,
+        qitem->CopyTextureRegion.DstZ,
+        &qitem->CopyTextureRegion.src,
+        empty_box ?
+        nullptr : src_box
+      );
+
+      item += BufferOffsetForQueueItemType<CopyTextureRegionArguments>();
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<CopyResourceArguments>();
-        break;
-      }
+    case D3DQueueItemType::DrawIndexedInstanced:
+    {
+      command_list->DrawIndexedInstanced(
+        qitem->DrawIndexedInstanced.IndexCount,
+        1,
+        qitem->DrawIndexedInstanced.StartIndexLocation,
+        qitem->DrawIndexedInstanced.BaseVertexLocation,
+        0
+      );
+
+      item += BufferOffsetForQueueItemType<DrawIndexedInstancedArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::CopyTextureRegion:
-      {
-        // If box is completely empty, assume that the original API call has a NULL box (which means
-        // copy from the entire resource.
-
-        const D3D12_BOX* src_box = &qitem->CopyTextureRegion.srcBox;
-
-        // Front/Back never used, so don't need to check.
-        bool empty_box =
-          src_box->bottom == 0 &&
-          src_box->left == 0 &&
-          src_box->right == 0 &&
-          src_box->top == 0;
-
-        command_list->CopyTextureRegion(
-          &qitem->CopyTextureRegion.dst,
-          qitem->CopyTextureRegion.DstX,
-          qitem->CopyTextureRegion.DstY,
-          qitem->CopyTextureRegion.DstZ,
-          &qitem->CopyTextureRegion.src,
-          empty_box ?
-          nullptr : src_box
-        );
-
-        item += BufferOffsetForQueueItemType<CopyTextureRegionArguments>();
-        break;
-      }
+    case D3DQueueItemType::DrawInstanced:
+    {
+      command_list->DrawInstanced(
+        qitem->DrawInstanced.VertexCount,
+        1,
+        qitem->DrawInstanced.StartVertexLocation,
+        0
+      );
+
+      item += BufferOffsetForQueueItemType<DrawInstancedArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::DrawIndexedInstanced:
-      {
-        command_list->DrawIndexedInstanced(
-          qitem->DrawIndexedInstanced.IndexCount,
-          1,
-          qitem->DrawIndexedInstanced.StartIndexLocation,
-          qitem->DrawIndexedInstanced.BaseVertexLocation,
-          0
-        );
-
-        item += BufferOffsetForQueueItemType<DrawIndexedInstancedArguments>();
-        break;
-      }
+    case D3DQueueItemType::IASetPrimitiveTopology:
+    {
+      command_list->IASetPrimitiveTopology(qitem->IASetPrimitiveTopology.PrimitiveTopology);
 
-      case D3DQueueItemType::DrawInstanced:
-      {
-        command_list->DrawInstanced(
-          qitem->DrawInstanced.VertexCount,
-          1,
-          qitem->DrawInstanced.StartVertexLocation,
-          0
-        );
-
-        item += BufferOffsetForQueueItemType<DrawInstancedArguments>();
-        break;
-      }
+      item += BufferOffsetForQueueItemType<IASetPrimitiveTopologyArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::IASetPrimitiveTopology:
-      {
-        command_list->IASetPrimitiveTopology(qitem->IASetPrimitiveTopology.PrimitiveTopology);
+    case D3DQueueItemType::ResourceBarrier:
+    {
+      command_list->ResourceBarrier(1, &qitem->ResourceBarrier.barrier);
 
-        item += BufferOffsetForQueueItemType<IASetPrimitiveTopologyArguments>();
-        break;
-      }
+      item += BufferOffsetForQueueItemType<ResourceBarrierArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::ResourceBarrier:
-      {
-        command_list->ResourceBarrier(1, &qitem->ResourceBarrier.barrier);
+    case D3DQueueItemType::RSSetScissorRects:
+    {
+      D3D12_RECT rect = {
+          qitem->RSSetScissorRects.left,
+          qitem->RSSetScissorRects.top,
+          qitem->RSSetScissorRects.right,
+          qitem->RSSetScissorRects.bottom
+      };
+
+      command_list->RSSetScissorRects(1, &rect);
+      item += BufferOffsetForQueueItemType<RSSetScissorRectsArguments>();
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<ResourceBarrierArguments>();
-        break;
-      }
+    case D3DQueueItemType::RSSetViewports:
+    {
+      command_list->RSSetViewports(1, &qitem->RSSetViewports);
+      item += BufferOffsetForQueueItemType<D3D12_VIEWPORT>();
+      break;
+    }
 
-      case D3DQueueItemType::RSSetScissorRects:
-      {
-        D3D12_RECT rect = {
-            qitem->RSSetScissorRects.left,
-            qitem->RSSetScissorRects.top,
-            qitem->RSSetScissorRects.right,
-            qitem->RSSetScissorRects.bottom
-        };
-
-        command_list->RSSetScissorRects(1, &rect);
-        item += BufferOffsetForQueueItemType<RSSetScissorRectsArguments>();
-        break;
-      }
+    case D3DQueueItemType::SetDescriptorHeaps:
+    {
+      command_list->SetDescriptorHeaps(
+        qitem->SetDescriptorHeaps.NumDescriptorHeaps,
+        qitem->SetDescriptorHeaps.DescriptorHeaps
+      );
+
+      item += BufferOffsetForQueueItemType<SetDescriptorHeapsArguments>();
+      break;
+    }
+
+    case D3DQueueItemType::SetGraphicsRootConstantBufferView:
+    {
+      command_list->SetGraphicsRootConstantBufferView(
+        qitem->SetGraphicsRootConstantBufferView.RootParameterIndex,
+        qitem->SetGraphicsRootConstantBufferView.BufferLocation
+      );
+
+      item += BufferOffsetForQueueItemType<SetGraphicsRootConstantBufferViewArguments>();
+      break;
+    }
+
+    case D3DQueueItemType::SetGraphicsRootDescriptorTable:
+    {
+      command_list->SetGraphicsRootDescriptorTable(
+        qitem->SetGraphicsRootDescriptorTable.RootParameterIndex,
+        qitem->SetGraphicsRootDescriptorTable.BaseDescriptor
+      );
+
+      item += BufferOffsetForQueueItemType<SetGraphicsRootDescriptorTableArguments>();
+      break;
+    }
+
+    case D3DQueueItemType::SetGraphicsRootSignature:
+    {
+      command_list->SetGraphicsRootSignature(
+        qitem->SetGraphicsRootSignature.pRootSignature
+      );
+
+      item += BufferOffsetForQueueItemType<SetGraphicsRootSignatureArguments>();
+      break;
+    }
+
+    case D3DQueueItemType::SetIndexBuffer:
+    {
+      command_list->IASetIndexBuffer(
+        &qitem->SetIndexBuffer.desc
+      );
+
+      item += BufferOffsetForQueueItemType<SetIndexBufferArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::RSSetViewports:
+    case D3DQueueItemType::SetVertexBuffers:
+    {
+      command_list->IASetVertexBuffers(
+        0,
+        1,
+        &qitem->SetVertexBuffers.desc
+      );
+
+      item += BufferOffsetForQueueItemType<SetVertexBuffersArguments>();
+      break;
+    }
+
+    case D3DQueueItemType::SetPipelineState:
+    {
+      command_list->SetPipelineState(qitem->SetPipelineState.pPipelineStateObject);
+      item += BufferOffsetForQueueItemType<SetPipelineStateArguments>();
+      break;
+    }
+
+    case D3DQueueItemType::SetRenderTargets:
+    {
+      unsigned int render_target_count = 0;
+
+      if (qitem->SetRenderTargets.RenderTargetDescriptor.ptr)
       {
-        command_list->RSSetViewports(1, &qitem->RSSetViewports);
-        item += BufferOffsetForQueueItemType<D3D12_VIEWPORT>();
-        break;
+        render_target_count = 1;
       }
 
-      case D3DQueueItemType::SetDescriptorHeaps:
-      {
-        command_list->SetDescriptorHeaps(
-          qitem->SetDescriptorHeaps.NumDescriptorHeaps,
-          qitem->SetDescriptorHeaps.DescriptorHeaps
-        );
+      command_list->OMSetRenderTargets(
+        render_target_count,
+        qitem->SetRenderTargets.RenderTargetDescriptor.ptr == NULL ?
+        nullptr :
+        &qitem->SetRenderTargets.RenderTargetDescriptor,
+        FALSE,
+        qitem->SetRenderTargets.DepthStencilDescriptor.ptr == NULL ?
+        nullptr :
+        &qitem->SetRenderTargets.DepthStencilDescriptor
+      );
+
+      item += BufferOffsetForQueueItemType<SetRenderTargetsArguments>();
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<SetDescriptorHeapsArguments>();
-        break;
-      }
+    case D3DQueueItemType::ResolveSubresource:
+    {
+      command_list->ResolveSubresource(
+        qitem->ResolveSubresource.pDstResource,
+        qitem->ResolveSubresource.DstSubresource,
+        qitem->ResolveSubresource.pSrcResource,
+        qitem->ResolveSubresource.SrcSubresource,
+        qitem->ResolveSubresource.Format
+      );
+
+      item += BufferOffsetForQueueItemType<ResolveSubresourceArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::SetGraphicsRootConstantBufferView:
-      {
-        command_list->SetGraphicsRootConstantBufferView(
-          qitem->SetGraphicsRootConstantBufferView.RootParameterIndex,
-          qitem->SetGraphicsRootConstantBufferView.BufferLocation
-        );
+    case D3DQueueItemType::BeginQuery:
+    {
+      command_list->BeginQuery(
+        qitem->BeginQuery.pQueryHeap,
+        qitem->BeginQuery.Type,
+        qitem->BeginQuery.Index
+      );
+
+      item += BufferOffsetForQueueItemType<BeginQueryArguments>();
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<SetGraphicsRootConstantBufferViewArguments>();
-        break;
-      }
+    case D3DQueueItemType::EndQuery:
+    {
+      command_list->EndQuery(
+        qitem->EndQuery.pQueryHeap,
+        qitem->EndQuery.Type,
+        qitem->EndQuery.Index
+      );
+
+      item += BufferOffsetForQueueItemType<EndQueryArguments>();
+      break;
+    }
 
-      case D3DQueueItemType::SetGraphicsRootDescriptorTable:
-      {
-        command_list->SetGraphicsRootDescriptorTable(
-          qitem->SetGraphicsRootDescriptorTable.RootParameterIndex,
-          qitem->SetGraphicsRootDescriptorTable.BaseDescriptor
-        );
+    case D3DQueueItemType::ResolveQueryData:
+    {
+      command_list->ResolveQueryData(
+        qitem->ResolveQueryData.pQueryHeap,
+        qitem->ResolveQueryData.Type,
+        qitem->ResolveQueryData.StartElement,
+        qitem->ResolveQueryData.ElementCount,
+        qitem->ResolveQueryData.pDestinationBuffer,
+        qitem->ResolveQueryData.AlignedDestinationBufferOffset
+      );
+
+      item += BufferOffsetForQueueItemType<ResolveQueryDataArguments>();
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<SetGraphicsRootDescriptorTableArguments>();
-        break;
-      }
+    case D3DQueueItemType::ResetCommandList:
+    {
+      CheckHR(command_list->Reset(qitem->ResetCommandList.allocator, nullptr));
 
-      case D3DQueueItemType::SetGraphicsRootSignature:
-      {
-        command_list->SetGraphicsRootSignature(
-          qitem->SetGraphicsRootSignature.pRootSignature
-        );
+      item += BufferOffsetForQueueItemType<ResetCommandListArguments>();
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<SetGraphicsRootSignatureArguments>();
-        break;
-      }
+    case D3DQueueItemType::CloseCommandList:
+    {
+      CheckHR(command_list->Close());
+      return;
+    }
 
-      case D3DQueueItemType::SetIndexBuffer:
-      {
-        command_list->IASetIndexBuffer(
-          &qitem->SetIndexBuffer.desc
-        );
+    case D3DQueueItemType::Stop:
+    {
+      // The queue was processed while the list was open, it may go on at the front.
+      item = ItemAfterStop(queue_array, item);
+      break;
+    }
 
-        item += BufferOffsetForQueueItemType<SetIndexBufferArguments>();
-        break;
-      }
+    default:
+    {
+      // Submissions are left to the background thread.
+      item += QueueItemSize(qitem->Type);
+      break;
+    }
+    }
+  }
+}
 
-      case D3DQueueItemType::SetVertexBuffers:
-      {
-        command_list->IASetVertexBuffers(
-          0,
-          1,
-          &qitem->SetVertexBuffers.desc
-        );
+void ID3D12QueuedCommandList::LaneThreadFunction(ID3D12QueuedCommandList* parent_queued_command_list, RecordingLane* lane)
+{
+  while (true)
+  {
+    WaitForSingleObject(lane->begin_event, INFINITE);
 
-        item += BufferOffsetForQueueItemType<SetVertexBuffersArguments>();
-        break;
-      }
+    if (!lane->segment)
+      return;
 
-      case D3DQueueItemType::SetPipelineState:
-      {
-        command_list->SetPipelineState(qitem->SetPipelineState.pPipelineStateObject);
-        item += BufferOffsetForQueueItemType<SetPipelineStateArguments>();
-        break;
-      }
+    RecordSegment(lane->command_list, parent_queued_command_list->m_queue_array, lane->segment);
 
-      case D3DQueueItemType::SetRenderTargets:
-      {
-        unsigned int render_target_count = 0;
+    lane->recording.store(false, std::memory_order_release);
+    SetEvent(lane->done_event);
+  }
+}
 
-        if (qitem->SetRenderTargets.RenderTargetDescriptor.ptr)
-        {
-          render_target_count = 1;
-        }
+void ID3D12QueuedCommandList::BeginRecording(UINT lane, byte* segment)
+{
+  m_lanes[lane].segment = segment;
+  m_lanes[lane].recording.store(true, std::memory_order_relaxed);
+  SetEvent(m_lanes[lane].begin_event);
+}
 
-        command_list->OMSetRenderTargets(
-          render_target_count,
-          qitem->SetRenderTargets.RenderTargetDescriptor.ptr == NULL ?
-          nullptr :
-          &qitem->SetRenderTargets.RenderTargetDescriptor,
-          FALSE,
-          qitem->SetRenderTargets.DepthStencilDescriptor.ptr == NULL ?
-          nullptr :
-          &qitem->SetRenderTargets.DepthStencilDescriptor
-        );
-
-        item += BufferOffsetForQueueItemType<SetRenderTargetsArguments>();
-        break;
-      }
+bool ID3D12QueuedCommandList::WaitForLane(RecordingLane& lane, bool wait)
+{
+  while (lane.recording.load(std::memory_order_acquire))
+  {
+    if (!wait)
+      return false;
 
-      case D3DQueueItemType::ResolveSubresource:
-      {
-        command_list->ResolveSubresource(
-          qitem->ResolveSubresource.pDstResource,
-          qitem->ResolveSubresource.DstSubresource,
-          qitem->ResolveSubresource.pSrcResource,
-          qitem->ResolveSubresource.SrcSubresource,
-          qitem->ResolveSubresource.Format
-        );
-
-        item += BufferOffsetForQueueItemType<ResolveSubresourceArguments>();
-        break;
-      }
+    WaitForSingleObject(lane.done_event, INFINITE);
+  }
 
-      case D3DQueueItemType::BeginQuery:
-      {
-        command_list->BeginQuery(
-          qitem->BeginQuery.pQueryHeap,
-          qitem->BeginQuery.Type,
-          qitem->BeginQuery.Index
-        );
+  return true;
+}
 
-        item += BufferOffsetForQueueItemType<BeginQueryArguments>();
-        break;
-      }
+bool ID3D12QueuedCommandList::SubmitNext(bool wait)
+{
+  if (m_pending_submissions.empty())
+    return false;
 
-      case D3DQueueItemType::EndQuery:
-      {
-        command_list->EndQuery(
-          qitem->EndQuery.pQueryHeap,
-          qitem->EndQuery.Type,
-          qitem->EndQuery.Index
-        );
+  const PendingSubmission& submission = m_pending_submissions.front();
+  const D3DQueueItem& item = submission.item;
+  switch (item.Type)
+  {
+  case D3DQueueItemType::ExecuteCommandList:
+  {
+    RecordingLane& lane = m_lanes[submission.lane];
+    if (!WaitForLane(lane, wait))
+      return false;
 
-        item += BufferOffsetForQueueItemType<EndQueryArguments>();
-        break;
-      }
+    m_command_queue->ExecuteCommandLists(1, reinterpret_cast<ID3D12CommandList**>(&lane.command_list));
+    lane.executed = true;
+    break;
+  }
 
-      case D3DQueueItemType::ResolveQueryData:
-      {
-        command_list->ResolveQueryData(
-          qitem->ResolveQueryData.pQueryHeap,
-          qitem->ResolveQueryData.Type,
-          qitem->ResolveQueryData.StartElement,
-          qitem->ResolveQueryData.ElementCount,
-          qitem->ResolveQueryData.pDestinationBuffer,
-          qitem->ResolveQueryData.AlignedDestinationBufferOffset
-        );
-
-        item += BufferOffsetForQueueItemType<ResolveQueryDataArguments>();
-        break;
-      }
+  case D3DQueueItemType::Present:
+  {
+    CheckHR(item.Present.swapChain->Present(item.Present.syncInterval, item.Present.flags));
+    break;
+  }
 
-      case D3DQueueItemType::CloseCommandList:
-      {
-        CheckHR(command_list->Close());
+  case D3DQueueItemType::ResetCommandAllocator:
+  {
+    CheckHR(item.ResetCommandAllocator.allocator->Reset());
+    break;
+  }
 
-        item += BufferOffsetForQueueItemType<CloseCommandListArguments>();
-        break;
-      }
+  case D3DQueueItemType::FenceGpuSignal:
+  {
+    CheckHR(m_command_queue->Signal(item.FenceGpuSignal.fence, item.FenceGpuSignal.fence_value));
+    break;
+  }
 
-      case D3DQueueItemType::ExecuteCommandList:
-      {
-        parent_queued_command_list->m_command_queue->ExecuteCommandLists(1, reinterpret_cast<ID3D12CommandList**>(&command_list));
+  case D3DQueueItemType::FenceCpuSignal:
+  {
+    CheckHR(item.FenceCpuSignal.fence->Signal(item.FenceCpuSignal.fence_value));
+    break;
+  }
 
-        item += BufferOffsetForQueueItemType<ExecuteCommandListArguments>();
-        break;
-      }
+  default:
+    break;
+  }
 
-      case D3DQueueItemType::Present:
-      {
-        CheckHR(qitem->Present.swapChain->Present(qitem->Present.syncInterval, qitem->Present.flags));
+  m_pending_submissions.pop_front();
+  return true;
+}
+
+void ID3D12QueuedCommandList::SubmitPending(bool wait)
+{
+  while (SubmitNext(wait))
+  {
+  }
+}
+
+void ID3D12QueuedCommandList::WaitForAllLanes()
+{
+  SubmitPending(true);
+
+  // A list may have been closed without being executed yet.
+  for (RecordingLane& lane : m_lanes)
+    WaitForLane(lane, true);
+}
 
-        item += BufferOffsetForQueueItemType<PresentArguments>();
+void ID3D12QueuedCommandList::BackgroundThreadFunction(ID3D12QueuedCommandList* parent_queued_command_list)
+{
+  byte* queue_array = parent_queued_command_list->m_queue_array;
+
+  unsigned int queue_array_front = 0;
+
+  // The first list is opened by its creation, not by a reset.
+  byte* segment = queue_array;
+  UINT segment_lane = 0;
+  parent_queued_command_list->m_lanes[0].executed = false;
+
+  while (true)
+  {
+    // Keep submitting the lists the lanes finish while waiting for more work.
+    while (true)
+    {
+      parent_queued_command_list->SubmitPending(false);
+      if (parent_queued_command_list->m_pending_submissions.empty())
+      {
+        WaitForSingleObject(parent_queued_command_list->m_begin_execution_event, INFINITE);
         break;
       }
 
+      const UINT waiting_lane = parent_queued_command_list->m_pending_submissions.front().lane;
+      HANDLE events[2] = { parent_queued_command_list->m_begin_execution_event, parent_queued_command_list->m_lanes[waiting_lane].done_event };
+      if (WaitForMultipleObjects(2, events, FALSE, INFINITE) == WAIT_OBJECT_0)
+        break;
+    }
+
+    byte* item = &queue_array[queue_array_front];
+
+    while (true)
+    {
+      const D3DQueueItem* qitem = reinterpret_cast<const D3DQueueItem*>(item);
+      switch (qitem->Type)
+      {
       case D3DQueueItemType::ResetCommandList:
       {
-        CheckHR(command_list->Reset(qitem->ResetCommandList.allocator, nullptr));
+        // The backing list can only be reset once it was executed.
+        segment_lane = qitem->ResetCommandList.lane;
+        RecordingLane& lane = parent_queued_command_list->m_lanes[segment_lane];
+        while (!lane.executed)
+        {
+          bool submitted = parent_queued_command_list->SubmitNext(true);
+          DEBUGCHECK(submitted, "Command list reset before it was executed.");
+        }
+        lane.executed = false;
+        segment = item;
 
         item += BufferOffsetForQueueItemType<ResetCommandListArguments>();
         break;
       }
 
-      case D3DQueueItemType::ResetCommandAllocator:
+      case D3DQueueItemType::CloseCommandList:
       {
-        CheckHR(qitem->ResetCommandAllocator.allocator->Reset());
+        parent_queued_command_list->BeginRecording(segment_lane, segment);
 
-        item += BufferOffsetForQueueItemType<ResetCommandAllocatorArguments>();
+        item += BufferOffsetForQueueItemType<CloseCommandListArguments>();
         break;
       }
 
+      case D3DQueueItemType::ExecuteCommandList:
+      case D3DQueueItemType::Present:
+      case D3DQueueItemType::ResetCommandAllocator:
       case D3DQueueItemType::FenceGpuSignal:
-      {
-        CheckHR(parent_queued_command_list->m_command_queue->Signal(qitem->FenceGpuSignal.fence, qitem->FenceGpuSignal.fence_value));
-
-        item += BufferOffsetForQueueItemType<FenceGpuSignalArguments>();
-        break;
-      }
-
       case D3DQueueItemType::FenceCpuSignal:
       {
-        CheckHR(qitem->FenceCpuSignal.fence->Signal(qitem->FenceCpuSignal.fence_value));
+        const size_t size = QueueItemSize(qitem->Type);
+
+        PendingSubmission submission;
+        memcpy(&submission.item, item, size);
+        submission.lane = segment_lane;
+        parent_queued_command_list->m_pending_submissions.push_back(submission);
 
-        item += BufferOffsetForQueueItemType<FenceCpuSignalArguments>();
+        item += size;
         break;
       }
 
       case D3DQueueItemType::Stop:
-
+      {
         // Use a goto to break out of the loop, since we can't exit the loop from
         // within a switch statement. We could use a separate 'if' after the switch,
         // but that was the highest source of overhead in the function after profiling.
         // http://stackoverflow.com/questions/1420029/how-to-break-out-of-a-loop-from-inside-a-switch
 
-        bool eligible_to_move_to_front_of_queue = qitem->Stop.eligible_to_move_to_front_of_queue;
         bool signal_stop_event = qitem->Stop.signal_stop_event;
         bool terminate_worker_thread = qitem->Stop.terminate_worker_thread;
 
-        item += BufferOffsetForQueueItemType<StopArguments>();
+        item = ItemAfterStop(queue_array, item);
 
-        if (eligible_to_move_to_front_of_queue && item - queue_array > QUEUE_ARRAY_SIZE * 2 / 3)
+        // The producer may reuse the queue once it is woken up.
+        if (signal_stop_event || terminate_worker_thread)
+        {
+          parent_queued_command_list->WaitForAllLanes();
+        }
+
+        if (terminate_worker_thread)
         {
-          item = queue_array;
+          for (RecordingLane& lane : parent_queued_command_list->m_lanes)
+          {
+            lane.segment = nullptr;
+            SetEvent(lane.begin_event);
+            lane.thread.join();
+          }
         }
 
         if (signal_stop_event)
@@ -399,6 +610,14 @@ void ID3D12QueuedCommandList::BackgroundThreadFunction(ID3D12QueuedCommandList*
 
         goto exitLoop;
       }
+
+      default:
+      {
+        // Recorded by the lanes.
+        item += QueueItemSize(qitem->Type);
+        break;
+      }
+      }
     }
 
   exitLoop:
@@ -407,8 +626,8 @@ void ID3D12QueuedCommandList::BackgroundThreadFunction(ID3D12QueuedCommandList*
   }
 }
 
-ID3D12QueuedCommandList::ID3D12QueuedCommandList(ID3D12GraphicsCommandList* backing_command_list, ID3D12CommandQueue* backing_command_queue) :
-  m_command_list(backing_command_list),
+ID3D12QueuedCommandList::ID3D12QueuedCommandList(const std::array<ID3D12GraphicsCommandList*, QUEUE_RECORDING_LANES>& backing_command_lists, ID3D12CommandQueue* backing_command_queue) :
+  m_command_list(backing_command_lists[0]),
   m_command_queue(backing_command_queue)
 {
   memset(m_queue_array, 0, sizeof(m_queue_array));
@@ -418,6 +637,14 @@ ID3D12QueuedCommandList::ID3D12QueuedCommandList(ID3D12GraphicsCommandList* back
   m_begin_execution_event = CreateSemaphore(nullptr, 0, 256, nullptr);
   m_stop_execution_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
 
+  for (size_t i = 0; i < m_lanes.size(); i++)
+  {
+    m_lanes[i].command_list = backing_command_lists[i];
+    m_lanes[i].begin_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    m_lanes[i].done_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    m_lanes[i].thread = std::thread(LaneThreadFunction, this, &m_lanes[i]);
+  }
+
   m_background_thread = std::thread(BackgroundThreadFunction, this);
 }
 
@@ -431,6 +658,12 @@ ID3D12QueuedCommandList::~ID3D12QueuedCommandList()
 
   CloseHandle(m_begin_execution_event);
   CloseHandle(m_stop_execution_event);
+
+  for (RecordingLane& lane : m_lanes)
+  {
+    CloseHandle(lane.begin_event);
+    CloseHandle(lane.done_event);
+  }
 }
 
 void ID3D12QueuedCommandList::CheckForOverflow()
@@ -453,6 +686,19 @@ void ID3D12QueuedCommandList::ResetQueueOverflowTracking()
   m_queue_array_back_at_start_of_frame = m_queue_array_back;
 }
 
+void ID3D12QueuedCommandList::QueueReset(ID3D12CommandAllocator* allocator, UINT lane)
+{
+  D3DQueueItem* item = reinterpret_cast<D3DQueueItem*>(m_queue_array_back);
+
+  item->Type = D3DQueueItemType::ResetCommandList;
+  item->ResetCommandList.allocator = allocator;
+  item->ResetCommandList.lane = lane;
+
+  m_queue_array_back += BufferOffsetForQueueItemType<ResetCommandListArguments>();
+
+  CheckForOverflow();
+}
+
 void ID3D12QueuedCommandList::QueueExecute()
 {
   reinterpret_cast<D3DQueueItem*>(m_queue_array_back)->Type = D3DQueueItemType::ExecuteCommandList;
@@ -677,12 +923,7 @@ HRESULT STDMETHODCALLTYPE ID3D12QueuedCommandList::Reset(
 {
   DEBUGCHECK(pInitialState == nullptr, "Error: Invalid assumption in ID3D12QueuedCommandList.");
 
-  reinterpret_cast<D3DQueueItem*>(m_queue_array_back)->Type = D3DQueueItemType::ResetCommandList;
-  reinterpret_cast<D3DQueueItem*>(m_queue_array_back)->ResetCommandList.allocator = pAllocator;
-
-  m_queue_array_back += BufferOffsetForQueueItemType<ResetCommandListArguments>();
-
-  CheckForOverflow();
+  QueueReset(pAllocator, 0);
 
   return S_OK;
 }
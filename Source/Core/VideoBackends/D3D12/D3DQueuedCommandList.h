@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <d3d12.h>
+#include <deque>
 #include <dxgi.h>
 #include <thread>
 
@@ -14,6 +16,10 @@ namespace DX12
 
 static const unsigned int QUEUE_ARRAY_SIZE = 24 * 1024 * 1024;
 
+// Each command list between a reset and a close is recorded from the queue into the backing list
+// of one of these lanes, so that the next lists can be recorded while the last one is.
+static const unsigned int QUEUE_RECORDING_LANES = 3;
+
 enum D3DQueueItemType
 {
   AbortProcessing = 0,
@@ -210,6 +216,7 @@ struct PresentArguments
 struct ResetCommandListArguments
 {
   ID3D12CommandAllocator* allocator;
+  UINT lane;
 };
 
 struct ResetCommandAllocatorArguments
@@ -280,10 +287,14 @@ class ID3D12QueuedCommandList : public ID3D12GraphicsCommandList
 {
 public:
 
-  ID3D12QueuedCommandList(ID3D12GraphicsCommandList* backing_command_list, ID3D12CommandQueue* backing_command_queue);
+  // The first backing list is open, the others are closed.
+  ID3D12QueuedCommandList(const std::array<ID3D12GraphicsCommandList*, QUEUE_RECORDING_LANES>& backing_command_lists, ID3D12CommandQueue* backing_command_queue);
 
   void ProcessQueuedItems(bool eligible_to_move_to_front_of_queue = false, bool wait_for_stop = false, bool terminate_worker_thread = false);
 
+  // Starts the next command list on the backing list of a lane, which must have been closed and
+  // executed before. The allocator must not be used by another lane.
+  void QueueReset(ID3D12CommandAllocator* allocator, UINT lane);
   void QueueExecute();
   void QueueFenceGpuSignal(ID3D12Fence* fence_to_signal, UINT64 fence_value);
   void QueueFenceCpuSignal(ID3D12Fence* fence_to_signal, UINT64 fence_value);
@@ -634,12 +645,42 @@ public:
   );
 
 private:
+  struct RecordingLane
+  {
+    ID3D12GraphicsCommandList* command_list = nullptr;
+    std::thread thread;
+    HANDLE begin_event = nullptr;
+    HANDLE done_event = nullptr;
+    // The reset of the list to record, nullptr tells the lane to exit.
+    byte* segment = nullptr;
+    std::atomic<bool> recording{false};
+    // Whether the last list recorded was executed, only used by the background thread.
+    bool executed = true;
+  };
+
+  // Executions, presents and fences are submitted in queue order once the lists before them are
+  // recorded.
+  struct PendingSubmission
+  {
+    D3DQueueItem item;
+    UINT lane;
+  };
+
   virtual ~ID3D12QueuedCommandList();
 
   void ResetQueueOverflowTracking();
   void CheckForOverflow();
 
   static void BackgroundThreadFunction(ID3D12QueuedCommandList* parent_queued_command_list);
+  static void LaneThreadFunction(ID3D12QueuedCommandList* parent_queued_command_list, RecordingLane* lane);
+  static void RecordSegment(ID3D12GraphicsCommandList* command_list, byte* queue_array, byte* item);
+
+  // These are only called on the background thread.
+  void BeginRecording(UINT lane, byte* segment);
+  bool WaitForLane(RecordingLane& lane, bool wait);
+  bool SubmitNext(bool wait);
+  void SubmitPending(bool wait);
+  void WaitForAllLanes();
 
   byte m_queue_array[QUEUE_ARRAY_SIZE];
   byte* m_queue_array_back = m_queue_array;
@@ -647,6 +688,8 @@ private:
   byte* m_queue_array_back_at_start_of_frame = m_queue_array_back;
 
   std::thread m_background_thread;
+  std::array<RecordingLane, QUEUE_RECORDING_LANES> m_lanes;
+  std::deque<PendingSubmission> m_pending_submissions;
 
   HANDLE m_begin_execution_event;
   HANDLE m_stop_execution_event;
@@ -2,12 +2,20 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/LinearDiskCache.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "Common/Logging/Log.h"
 
 #include "Core/ConfigManager.h"
@@ -27,17 +35,124 @@
 namespace DX12
 {
 
-static bool s_cache_is_corrupted = false;
+static std::atomic<bool> s_cache_is_corrupted{false};
 LinearDiskCache<SmallPsoDiskDesc, u8> s_pso_disk_cache;
+static std::mutex s_pso_disk_cache_lock;
+
+// Driver compiled PSOs of every game, keyed by a hash of their SmallPsoDiskDesc. Needs
+// ID3D12Device1, older runtimes fall back to the cached blobs in the PSO disk cache.
+static ComPtr<ID3D12PipelineLibrary> s_pso_library;
+static std::mutex s_pso_library_lock;
+// The library reads from this memory for as long as it lives.
+static std::string s_pso_library_data;
+
+static std::string GetPipelineLibraryFileName()
+{
+  return File::GetUserPath(D_SHADERCACHE_IDX) + "IDX12-pipelines.cache";
+}
+
+static void CreatePipelineLibrary()
+{
+  ComPtr<ID3D12Device1> device1;
+  if (FAILED(D3D::device->QueryInterface(IID_PPV_ARGS(device1.GetAddressOf()))))
+    return;
+
+  File::ReadFileToString(GetPipelineLibraryFileName(), s_pso_library_data);
+  HRESULT hr = device1->CreatePipelineLibrary(s_pso_library_data.data(),
+                                              s_pso_library_data.size(),
+                                              IID_PPV_ARGS(s_pso_library.ReleaseAndGetAddressOf()));
+  if (FAILED(hr) && !s_pso_library_data.empty())
+  {
+    // Written by another driver or adapter, start over.
+    s_pso_library_data.clear();
+    hr = device1->CreatePipelineLibrary(nullptr, 0,
+                                        IID_PPV_ARGS(s_pso_library.ReleaseAndGetAddressOf()));
+  }
+  if (FAILED(hr))
+    s_pso_library.Reset();
+}
+
+static void SavePipelineLibrary()
+{
+  if (!s_pso_library)
+    return;
+
+  std::string data(s_pso_library->GetSerializedSize(), '\0');
+  if (SUCCEEDED(s_pso_library->Serialize(&data[0], data.size())))
+    File::WriteStringToFile(data, GetPipelineLibraryFileName());
+}
+
+static std::wstring GetPipelineName(const SmallPsoDiskDesc& disk_desc)
+{
+  return UTF8ToUTF16(StringFromFormat(
+      "%016llx", GetXXH3_64(reinterpret_cast<const u8*>(&disk_desc), sizeof(disk_desc))));
+}
+
+// Creates the PSO, through the pipeline library when there is one, and records it in the PSO
+// disk cache. Called from the thread pool too.
+static HRESULT CreatePipelineState(D3D12_GRAPHICS_PIPELINE_STATE_DESC desc,
+                                   const SmallPsoDiskDesc& disk_desc,
+                                   ComPtr<ID3D12PipelineState>* pso, bool use_disk_cache)
+{
+  if (!use_disk_cache)
+    return D3D::device->CreateGraphicsPipelineState(&desc,
+                                                    IID_PPV_ARGS(pso->ReleaseAndGetAddressOf()));
+
+  if (s_pso_library)
+  {
+    const std::wstring name = GetPipelineName(disk_desc);
+    desc.CachedPSO = {};
+    std::lock_guard<std::mutex> guard(s_pso_library_lock);
+    HRESULT hr = s_pso_library->LoadGraphicsPipeline(
+        name.c_str(), &desc, IID_PPV_ARGS(pso->ReleaseAndGetAddressOf()));
+    if (SUCCEEDED(hr))
+      return hr;
+
+    hr = D3D::device->CreateGraphicsPipelineState(&desc,
+                                                  IID_PPV_ARGS(pso->ReleaseAndGetAddressOf()));
+    if (FAILED(hr))
+      return hr;
+    s_pso_library->StorePipeline(name.c_str(), pso->Get());
+    std::lock_guard<std::mutex> disk_guard(s_pso_disk_cache_lock);
+    // The library holds the compiled code, the disk cache only lists the PSOs to precreate.
+    s_pso_disk_cache.Append(disk_desc, nullptr, 0);
+    return hr;
+  }
+
+  const bool from_blob = desc.CachedPSO.CachedBlobSizeInBytes != 0;
+  HRESULT hr =
+      D3D::device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pso->ReleaseAndGetAddressOf()));
+  if (from_blob)
+  {
+    if (SUCCEEDED(hr))
+      return hr;
+    // Failure can occur if disk cache is corrupted, or a driver upgrade invalidates the existing
+    // blobs. Create the PSO from scratch and rebuild the disk cache next time.
+    s_cache_is_corrupted = true;
+    desc.CachedPSO = {};
+    hr = D3D::device->CreateGraphicsPipelineState(&desc,
+                                                  IID_PPV_ARGS(pso->ReleaseAndGetAddressOf()));
+    return hr;
+  }
+  if (FAILED(hr))
+    return hr;
+
+  // This shouldn't fail.. but if it does, don't cache to disk.
+  ComPtr<ID3DBlob> pso_blob;
+  if (SUCCEEDED((*pso)->GetCachedBlob(pso_blob.ReleaseAndGetAddressOf())))
+  {
+    std::lock_guard<std::mutex> guard(s_pso_disk_cache_lock);
+    s_pso_disk_cache.Append(disk_desc, reinterpret_cast<const u8*>(pso_blob->GetBufferPointer()),
+                            static_cast<u32>(pso_blob->GetBufferSize()));
+  }
+  return hr;
+}
 
 class PipelineStateCacheInserter : public LinearDiskCacheReader<SmallPsoDiskDesc, u8>
 {
 public:
   void Read(const SmallPsoDiskDesc &key, const u8* value, u32 value_size)
   {
-    if (s_cache_is_corrupted)
-      return;
-
     D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
     desc.GS = ShaderCache::GetGeometryShaderFromUid(key.gs_uid);
     if (key.using_uber_pixel_shader)
@@ -50,11 +165,11 @@ public:
     }
     if (key.using_uber_vertex_shader)
     {
-      desc.VS = ShaderCache::GetVertexShaderFromUid(key.vs_uid);
+      desc.VS = ShaderCache::GetVertexUberShaderFromUid(key.vus_uid);
     }
     else
     {
-      desc.VS = ShaderCache::GetVertexUberShaderFromUid(key.vus_uid);
+      desc.VS = ShaderCache::GetVertexShaderFromUid(key.vs_uid);
     }
     desc.HS = ShaderCache::GetHullShaderFromUid(key.hds_uid);
     desc.DS = ShaderCache::GetDomainShaderFromUid(key.hds_uid);
@@ -67,11 +182,9 @@ public:
     desc.SampleMask = UINT_MAX;
     desc.SampleDesc = key.sample_desc;
 
+    // The shaders it was built from are not in the shader caches anymore.
     if (!desc.PS.pShaderBytecode || !desc.VS.pShaderBytecode)
-    {
-      s_cache_is_corrupted = true;
       return;
-    }
 
     BlendingState blend_state = {};
     blend_state.hex = key.blend_state_hex;
@@ -93,20 +206,6 @@ public:
 
     desc.InputLayout = static_cast<D3DVertexFormat*>(native)->GetActiveInputLayout();
 
-    desc.CachedPSO.CachedBlobSizeInBytes = value_size;
-    desc.CachedPSO.pCachedBlob = value;
-
-    ComPtr<ID3D12PipelineState> pso;
-    HRESULT hr = D3D::device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(pso.ReleaseAndGetAddressOf()));
-
-    if (FAILED(hr))
-    {
-      // Failure can occur if disk cache is corrupted, or a driver upgrade invalidates the existing blobs.
-      // In this case, we need to clear the disk cache.
-      s_cache_is_corrupted = true;
-      return;
-    }
-
     SmallPsoDesc small_desc = {};
     small_desc.using_uber_pixel_shader = key.using_uber_pixel_shader;
     small_desc.using_uber_vertex_shader = key.using_uber_vertex_shader;
@@ -121,7 +220,8 @@ public:
     small_desc.input_Layout = static_cast<D3DVertexFormat*>(native);
     small_desc.sample_count = key.sample_desc.Count;
     small_desc.rtformat = key.rtformat;
-    s_gx_state_cache.m_small_pso_map[small_desc] = pso;
+    s_gx_state_cache.CreatePipelineStateAsync(small_desc, desc, key,
+                                              std::vector<u8>(value, value + value_size));
   }
 };
 
@@ -143,35 +243,35 @@ void StateCache::LoadFromDisk()
 {
   std::string cache_filename = GetDiskShaderCacheFileName(API_D3D11, "pso", true, true);
 
+  // Every PSO the game used before is created on the thread pool, the driver compile is the
+  // slow part.
   PipelineStateCacheInserter inserter;
   s_pso_disk_cache.OpenAndRead(cache_filename, inserter);
+}
+
+void StateCache::CloseDiskCache()
+{
+  WaitForPipelines();
+  s_pso_disk_cache.Sync();
+  s_pso_disk_cache.Close();
+  SavePipelineLibrary();
 
   if (s_cache_is_corrupted)
   {
-    // If a PSO fails to create, that means either:
+    // If a PSO fails to create from its blob, that means either:
     // - The file itself is corrupt.
     // - A driver/HW change has occured, causing the existing cache blobs to be invalid.
-    // 
+    //
     // In either case, we want to re-create the disk cache. This should not be a frequent occurence.
-
-    s_pso_disk_cache.Close();
-
-    s_gx_state_cache.m_small_pso_map.clear();
-
-    File::Delete(cache_filename);
-
-    s_pso_disk_cache.OpenAndRead(cache_filename, inserter);
-
+    File::Delete(GetDiskShaderCacheFileName(API_D3D11, "pso", true, true));
     s_cache_is_corrupted = false;
   }
 }
 
 void StateCache::Reload()
 {
+  CloseDiskCache();
   m_small_pso_map.clear();
-
-  s_pso_disk_cache.Sync();
-  s_pso_disk_cache.Close();
   LoadFromDisk();
 }
 
@@ -182,6 +282,7 @@ void StateCache::Init()
     return;
   }
 
+  CreatePipelineLibrary();
   LoadFromDisk();
 }
 
@@ -495,99 +596,142 @@ HRESULT StateCache::GetPipelineStateObjectFromCache(const D3D12_GRAPHICS_PIPELIN
   return S_OK;
 }
 
-HRESULT StateCache::GetPipelineStateObjectFromCache(const SmallPsoDesc& pso_desc, ID3D12PipelineState** pso, D3D12_PRIMITIVE_TOPOLOGY_TYPE topology)
+HRESULT StateCache::GetPipelineStateObjectFromCache(const SmallPsoDesc& pso_desc, ID3D12PipelineState** pso, D3D12_PRIMITIVE_TOPOLOGY_TYPE topology, bool async)
 {
-  auto it = m_small_pso_map.find(pso_desc);
-
-  if (it == m_small_pso_map.end())
   {
-    // Not found, create new PSO.
-
-    // RootSignature, SampleMask, NumRenderTargets, RTVFormats, DSVFormat
-    // never change so they are set in constructor and forgotten.
-    m_current_pso_desc.GS = pso_desc.gs_bytecode;
-    m_current_pso_desc.PS = pso_desc.ps_bytecode;
-    m_current_pso_desc.VS = pso_desc.vs_bytecode;
-    m_current_pso_desc.HS = pso_desc.hs_bytecode;
-    m_current_pso_desc.DS = pso_desc.ds_bytecode;
-    m_current_pso_desc.RTVFormats[0] = pso_desc.rtformat;
-    m_current_pso_desc.pRootSignature = D3D::GetRootSignature();
-
-    m_current_pso_desc.BlendState = GetDesc(pso_desc.blend_state);
-    m_current_pso_desc.DepthStencilState = GetDesc(pso_desc.depth_stencil_state);
-    m_current_pso_desc.RasterizerState = GetDesc(pso_desc.rasterizer_state);
-    m_current_pso_desc.PrimitiveTopologyType = topology;
-    m_current_pso_desc.InputLayout = pso_desc.input_Layout->GetActiveInputLayout();
-    m_current_pso_desc.SampleDesc.Count = pso_desc.sample_count;
-
-    ComPtr<ID3D12PipelineState> new_pso;
-    HRESULT hr = D3D::device->CreateGraphicsPipelineState(&m_current_pso_desc, IID_PPV_ARGS(new_pso.ReleaseAndGetAddressOf()));
-
-    if (FAILED(hr))
+    std::unique_lock<std::mutex> guard(m_small_pso_lock);
+    auto it = m_small_pso_map.find(pso_desc);
+    if (it != m_small_pso_map.end() && !it->second && !async)
     {
-      CheckHR(hr);
-      return hr;
+      // Still building on the thread pool, wait for it.
+      guard.unlock();
+      WaitForPipelines();
+      guard.lock();
+      it = m_small_pso_map.find(pso_desc);
     }
-
-    m_small_pso_map[pso_desc] = new_pso;
-    *pso = new_pso.Get();
-
-    if (m_enable_disk_cache)
+    if (it != m_small_pso_map.end())
     {
-      // This contains all of the information needed to reconstruct a PSO at startup.
-      SmallPsoDiskDesc disk_desc = {};
-      disk_desc.using_uber_pixel_shader = pso_desc.using_uber_pixel_shader;
-      disk_desc.using_uber_vertex_shader = pso_desc.using_uber_vertex_shader;
-      disk_desc.root_signature_index = static_cast<u32>(D3D::GetRootSignatureIndex());
-      disk_desc.blend_state_hex = pso_desc.blend_state.hex;
-      disk_desc.depth_stencil_state_hex = pso_desc.depth_stencil_state.hex;
-      disk_desc.rasterizer_state_hex = pso_desc.rasterizer_state.hex;
-      disk_desc.gs_uid = ShaderCache::GetActiveGeometryShaderUid();
-      if (pso_desc.using_uber_pixel_shader)
-      {
-        disk_desc.pus_uid = ShaderCache::GetActivePixelUberShaderUid();
-      }
-      else
-      {
-        disk_desc.ps_uid = ShaderCache::GetActivePixelShaderUid();
-      }
-      if (pso_desc.using_uber_vertex_shader)
-      {
-        disk_desc.vus_uid = ShaderCache::GetActiveVertexUberShaderUid();
-      }
-      else
-      {
-        disk_desc.vs_uid = ShaderCache::GetActiveVertexShaderUid();
-      }
-      
-      disk_desc.hds_uid = ShaderCache::GetActiveTessellationShaderUid();
-      disk_desc.vertex_declaration = pso_desc.input_Layout->GetVertexDeclaration();
-      disk_desc.topology = topology;
-      disk_desc.sample_desc.Count = g_ActiveConfig.iMultisamples;
-      disk_desc.rtformat = pso_desc.rtformat;
-      // This shouldn't fail.. but if it does, don't cache to disk.
-      ComPtr<ID3DBlob> psoBlob;
-      hr = new_pso->GetCachedBlob(psoBlob.ReleaseAndGetAddressOf());
-      if (SUCCEEDED(hr))
-      {
-        s_pso_disk_cache.Append(disk_desc, reinterpret_cast<const u8*>(psoBlob->GetBufferPointer()), static_cast<u32>(psoBlob->GetBufferSize()));
-      }
+      *pso = it->second.Get();
+      return *pso ? S_OK : S_FALSE;
     }
   }
+
+  // Not found, create new PSO.
+
+  // RootSignature, SampleMask, NumRenderTargets, RTVFormats, DSVFormat
+  // never change so they are set in constructor and forgotten.
+  m_current_pso_desc.GS = pso_desc.gs_bytecode;
+  m_current_pso_desc.PS = pso_desc.ps_bytecode;
+  m_current_pso_desc.VS = pso_desc.vs_bytecode;
+  m_current_pso_desc.HS = pso_desc.hs_bytecode;
+  m_current_pso_desc.DS = pso_desc.ds_bytecode;
+  m_current_pso_desc.RTVFormats[0] = pso_desc.rtformat;
+  m_current_pso_desc.pRootSignature = D3D::GetRootSignature();
+
+  m_current_pso_desc.BlendState = GetDesc(pso_desc.blend_state);
+  m_current_pso_desc.DepthStencilState = GetDesc(pso_desc.depth_stencil_state);
+  m_current_pso_desc.RasterizerState = GetDesc(pso_desc.rasterizer_state);
+  m_current_pso_desc.PrimitiveTopologyType = topology;
+  m_current_pso_desc.InputLayout = pso_desc.input_Layout->GetActiveInputLayout();
+  m_current_pso_desc.SampleDesc.Count = pso_desc.sample_count;
+
+  // This contains all of the information needed to reconstruct a PSO at startup.
+  SmallPsoDiskDesc disk_desc = {};
+  disk_desc.using_uber_pixel_shader = pso_desc.using_uber_pixel_shader;
+  disk_desc.using_uber_vertex_shader = pso_desc.using_uber_vertex_shader;
+  disk_desc.root_signature_index = static_cast<u32>(D3D::GetRootSignatureIndex());
+  disk_desc.blend_state_hex = pso_desc.blend_state.hex;
+  disk_desc.depth_stencil_state_hex = pso_desc.depth_stencil_state.hex;
+  disk_desc.rasterizer_state_hex = pso_desc.rasterizer_state.hex;
+  disk_desc.gs_uid = ShaderCache::GetActiveGeometryShaderUid();
+  if (pso_desc.using_uber_pixel_shader)
+  {
+    disk_desc.pus_uid = ShaderCache::GetActivePixelUberShaderUid();
+  }
   else
   {
-    *pso = it->second.Get();
+    disk_desc.ps_uid = ShaderCache::GetActivePixelShaderUid();
+  }
+  if (pso_desc.using_uber_vertex_shader)
+  {
+    disk_desc.vus_uid = ShaderCache::GetActiveVertexUberShaderUid();
+  }
+  else
+  {
+    disk_desc.vs_uid = ShaderCache::GetActiveVertexShaderUid();
+  }
+
+  disk_desc.hds_uid = ShaderCache::GetActiveTessellationShaderUid();
+  disk_desc.vertex_declaration = pso_desc.input_Layout->GetVertexDeclaration();
+  disk_desc.topology = topology;
+  disk_desc.sample_desc.Count = g_ActiveConfig.iMultisamples;
+  disk_desc.rtformat = pso_desc.rtformat;
+
+  if (async)
+  {
+    *pso = nullptr;
+    CreatePipelineStateAsync(pso_desc, m_current_pso_desc, disk_desc, {});
+    return S_FALSE;
   }
 
+  ComPtr<ID3D12PipelineState> new_pso;
+  HRESULT hr = CreatePipelineState(m_current_pso_desc, disk_desc, &new_pso, m_enable_disk_cache);
+
+  if (FAILED(hr))
+  {
+    CheckHR(hr);
+    return hr;
+  }
+
+  std::lock_guard<std::mutex> guard(m_small_pso_lock);
+  m_small_pso_map[pso_desc] = new_pso;
+  *pso = new_pso.Get();
   return S_OK;
 }
 
+void StateCache::CreatePipelineStateAsync(const SmallPsoDesc& small_desc,
+                                          const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+                                          const SmallPsoDiskDesc& disk_desc,
+                                          std::vector<u8>&& cached_blob)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_small_pso_lock);
+    // An empty entry marks the PSO as building.
+    if (!m_small_pso_map.emplace(small_desc, nullptr).second)
+      return;
+  }
+  m_pending_pipelines.fetch_add(1);
+  auto blob = std::make_shared<std::vector<u8>>(std::move(cached_blob));
+  Common::AsyncWorker::ExecuteAsync([this, small_desc, desc, disk_desc, blob] {
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC pso_desc = desc;
+    pso_desc.CachedPSO.CachedBlobSizeInBytes = blob->size();
+    pso_desc.CachedPSO.pCachedBlob = blob->empty() ? nullptr : blob->data();
+    ComPtr<ID3D12PipelineState> pso;
+    const HRESULT hr = CreatePipelineState(pso_desc, disk_desc, &pso, m_enable_disk_cache);
+    {
+      std::lock_guard<std::mutex> guard(m_small_pso_lock);
+      if (SUCCEEDED(hr))
+        m_small_pso_map[small_desc] = pso;
+      else
+        m_small_pso_map.erase(small_desc);
+    }
+    m_pending_pipelines.fetch_sub(1);
+  });
+}
+
+void StateCache::WaitForPipelines()
+{
+  u32 loopcount = 0;
+  while (m_pending_pipelines.load() > 0)
+    Common::cYield(loopcount++);
+}
+
 void StateCache::Clear()
 {
+  CloseDiskCache();
   m_pso_map.clear();
   m_small_pso_map.clear();
-
-  s_pso_disk_cache.Sync();
-  s_pso_disk_cache.Close();
+  s_pso_library.Reset();
+  s_pso_library_data.clear();
 }
 }  // namespace DX12
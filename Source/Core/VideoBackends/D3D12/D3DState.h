@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <stack>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/BitField.h"
 #include "Common/CommonTypes.h"
@@ -73,7 +76,11 @@ public:
   static D3D12_DEPTH_STENCIL_DESC GetDesc(DepthState state);
 
   HRESULT GetPipelineStateObjectFromCache(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& pso_desc, ID3D12PipelineState** pso);
-  HRESULT GetPipelineStateObjectFromCache(const SmallPsoDesc& pso_desc, ID3D12PipelineState** pso, D3D12_PRIMITIVE_TOPOLOGY_TYPE topology);
+  // With async set, a PSO that isn't cached yet is queued for the thread pool and S_FALSE is
+  // returned without one, so the draw can use the ubershader PSO meanwhile.
+  HRESULT GetPipelineStateObjectFromCache(const SmallPsoDesc& pso_desc, ID3D12PipelineState** pso, D3D12_PRIMITIVE_TOPOLOGY_TYPE topology, bool async = false);
+  // Blocks until the PSOs queued for the thread pool are created.
+  void WaitForPipelines();
 
   StateCache();
 
@@ -91,6 +98,10 @@ public:
   void Reload();
 private:
   static void LoadFromDisk();
+  void CloseDiskCache();
+  void CreatePipelineStateAsync(const SmallPsoDesc& small_desc,
+                                const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+                                const SmallPsoDiskDesc& disk_desc, std::vector<u8>&& cached_blob);
   friend DX12::PipelineStateCacheInserter;
 
   D3D12_GRAPHICS_PIPELINE_STATE_DESC m_current_pso_desc;
@@ -99,7 +110,7 @@ private:
   {
     size_t operator()(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& pso_desc) const
     {
-      return GetMurmurHash3(reinterpret_cast<const u8*>(&pso_desc), static_cast<u32>(sizeof(pso_desc)), 0);
+      return GetXXH3_64(reinterpret_cast<const u8*>(&pso_desc), sizeof(pso_desc));
     }
   };
 
@@ -186,6 +197,9 @@ private:
   };
 
   std::unordered_map<SmallPsoDesc, ComPtr<ID3D12PipelineState>, hash_small_pso_desc, equality_small_pipeline_state_desc> m_small_pso_map;
+  // The thread pool fills in the PSOs of m_small_pso_map it builds.
+  std::mutex m_small_pso_lock;
+  std::atomic<u32> m_pending_pipelines{};
   bool m_enable_disk_cache = true;
 };
 
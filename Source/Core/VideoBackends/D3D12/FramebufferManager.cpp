@@ -64,7 +64,14 @@ D3DTexture2D*& FramebufferManager::GetResolvedEFBDepthTexture()
 {
   if (g_ActiveConfig.iMultisamples > 1)
   {
-    ResolveDepthTexture();
+    // Nothing was drawn since the last resolve.
+    if (!m_efb.resolved_depth_valid ||
+        m_efb.resolved_depth_generation != g_renderer->GetEFBGeneration())
+    {
+      ResolveDepthTexture();
+      m_efb.resolved_depth_valid = true;
+      m_efb.resolved_depth_generation = g_renderer->GetEFBGeneration();
+    }
 
     return m_efb.resolved_depth_tex;
   }
@@ -119,6 +126,7 @@ FramebufferManager::FramebufferManager(u32 target_width, u32 target_height, DXGI
   m_target_width = std::max(target_width, 16u);
   m_target_height = std::max(target_height, 16u);
   m_format = format;
+  m_efb.resolved_depth_valid = false;
   DXGI_SAMPLE_DESC sample_desc;
   sample_desc.Count = g_ActiveConfig.iMultisamples;
   sample_desc.Quality = 0;
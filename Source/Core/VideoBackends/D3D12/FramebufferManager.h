@@ -108,6 +108,9 @@ private:
 
     D3DTexture2D* depth_tex{};
     D3DTexture2D* resolved_depth_tex{};
+    // The EFB generation resolved_depth_tex was resolved at.
+    u64 resolved_depth_generation{};
+    bool resolved_depth_valid{};
 
     D3DTexture2D* color_temp_tex{};
 
@@ -125,46 +125,53 @@ uintptr_t D3DPostProcessingShader::CreateBindingSampler(const PostProcessingShad
 
 bool D3DPostProcessingShader::RecompileShaders()
 {
-  static const char *inputs[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8" };
-  static D3D_SHADER_MACRO macros[] = {
-      { "API_D3D", "1" },
-      { "HLSL", "1" },
-      { "COLOR_BUFFER_INPUT_INDEX", 0 },
-      { "DEPTH_BUFFER_INPUT_INDEX", 0 },
-      { "PREV_OUTPUT_INPUT_INDEX", 0 },
-      { nullptr, nullptr }
-  };
-  std::string common_source = PostProcessor::GetCommonFragmentShaderSource(API_D3D11, m_config, 0);
-  for (size_t i = 0; i < m_passes.size(); i++)
-  {
-    RenderPassData& pass = m_passes[i];
-    const PostProcessingShaderConfiguration::RenderPass& pass_config = m_config->GetPass(i);
+  return RecompileShaderBinaries();
+}
 
-    int color_buffer_index = 0;
-    int depth_buffer_index = 0;
-    int prev_output_index = 0;
+static bool CompilePassShaderBinary(const std::string& source, std::vector<u8>* binary)
+{
+  D3DBlob* blob = nullptr;
+  D3D::CompilePixelShader(source, &blob, nullptr, "passmain");
+  if (!blob)
+    return false;
 
-    pass_config.GetInputLocations(color_buffer_index, depth_buffer_index, prev_output_index);
+  binary->assign(blob->Data(), blob->Data() + blob->Size());
+  blob->Release();
+  return true;
+}
 
-    macros[2].Definition = inputs[color_buffer_index];
-    macros[3].Definition = inputs[depth_buffer_index];
-    macros[4].Definition = inputs[prev_output_index];
+PostProcessingShader::ShaderBinaryCompiler D3DPostProcessingShader::GetShaderBinaryCompiler() const
+{
+  return CompilePassShaderBinary;
+}
 
-    std::string hlsl_source = PostProcessor::GetPassFragmentShaderSource(API_D3D11, m_config, &pass_config);
-    ReleasePassNativeResources(pass);
-    RenderPassDx12Data* pixel_shader = new RenderPassDx12Data();
-    pass.shader = reinterpret_cast<uintptr_t>(pixel_shader);
-    D3D::CompilePixelShader(common_source + hlsl_source, &pixel_shader->m_shader_blob, macros, "passmain");
-    if (pixel_shader->m_shader_blob == nullptr)
-    {
-      ReleasePassNativeResources(pass);
-      ERROR_LOG(VIDEO, "Failed to compile post-processing shader %s (pass %s)", m_config->GetShaderName().c_str(), pass_config.entry_point.c_str());
-      m_ready = false;
-      return false;
-    }
-    pixel_shader->m_shader_bytecode = { pixel_shader->m_shader_blob->Data(), pixel_shader->m_shader_blob->Size() };
+std::string D3DPostProcessingShader::GetPassShaderSource(size_t pass_index) const
+{
+  static const char* definitions =
+    "#define API_D3D 1\n"
+    "#define HLSL 1\n"
+    "#define COLOR_BUFFER_INPUT_INDEX %i\n"
+    "#define DEPTH_BUFFER_INPUT_INDEX %i\n"
+    "#define PREV_OUTPUT_INPUT_INDEX %i\n";
+
+  const PostProcessingShaderConfiguration::RenderPass& pass_config = m_config->GetPass(pass_index);
+  int color_buffer_index = 0;
+  int depth_buffer_index = 0;
+  int prev_output_index = 0;
+  pass_config.GetInputLocations(color_buffer_index, depth_buffer_index, prev_output_index);
+
+  return StringFromFormat(definitions, color_buffer_index, depth_buffer_index, prev_output_index) +
+    PostProcessor::GetCommonFragmentShaderSource(API_D3D11, m_config, 0) +
+    PostProcessor::GetPassFragmentShaderSource(API_D3D11, m_config, &pass_config);
+}
 
-  }
+bool D3DPostProcessingShader::CreatePassShader(RenderPassData& pass, const std::vector<u8>& binary)
+{
+  ReleasePassNativeResources(pass);
+  RenderPassDx12Data* pixel_shader = new RenderPassDx12Data();
+  pass.shader = reinterpret_cast<uintptr_t>(pixel_shader);
+  pixel_shader->m_shader_blob = new D3DBlob(static_cast<unsigned int>(binary.size()), binary.data());
+  pixel_shader->m_shader_bytecode = { pixel_shader->m_shader_blob->Data(), pixel_shader->m_shader_blob->Size() };
   return true;
 }
 
@@ -245,7 +252,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
 
     D3D12_CPU_DESCRIPTOR_HANDLE texture_cpu = { base_texture_cpu.ptr + pass_index * POST_PROCESSING_MAX_TEXTURE_INPUTS * D3D::resource_descriptor_size };
     D3D12_GPU_DESCRIPTOR_HANDLE texture_gpu = { base_texture_gpu.ptr + pass_index * POST_PROCESSING_MAX_TEXTURE_INPUTS * D3D::resource_descriptor_size };
-    std::vector<s32> InputsToRelease;
     // Bind inputs to pipeline
     for (size_t i = 0; i < pass.inputs.size(); i++)
     {
@@ -288,7 +294,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
         }
         else if (input.prev_texture >= 0)
         {
-          InputsToRelease.push_back(input.prev_texture);
           input_texture = reinterpret_cast<D3DTexture2D*>(m_passes[input.prev_texture].GetOutput()->GetInternalObject());
           input_sizes[i] = m_passes[input.prev_texture].output_size;
         }
@@ -359,10 +364,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
     D3D::DrawShadedTexQuad(nullptr, src_rect.AsRECT(), src_size.width, src_size.height,
       reinterpret_cast<RenderPassDx12Data*>(pass.shader)->m_shader_bytecode, parent->GetVertexShader(), StaticShaderCache::GetSimpleVertexShaderInputLayout(),
       geometry_shader, std::max(src_layer, 0), dst->GetFormat(), false, dst->GetMultisampled());
-    for (auto passidx : InputsToRelease)
-    {
-      m_passes[passidx].ClenaupOutput();
-    }
   }
 
   // Copy the last pass output to the target if not done already
@@ -389,10 +390,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
       parent->CopyTexture(dst, GetPrevColorFrame(0)->GetInternalObject(), output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer, false, true);
     }
     parent->CopyTexture(dst_rect, dst_tex, output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer);
-    if (!IsLastPassScaled())
-    {
-      final_pass.ClenaupOutput();
-    }
   }
 }
 
@@ -483,6 +480,11 @@ bool D3DPostProcessor::CreateUniformBuffer()
   return true;
 }
 
+std::string D3DPostProcessor::GetShaderBinaryCacheFileName() const
+{
+  return File::GetUserPath(D_SHADERCACHE_IDX) + "IDX12-PP.cache";
+}
+
 std::unique_ptr<PostProcessingShader> D3DPostProcessor::CreateShader(PostProcessingShaderConfiguration* config)
 {
   std::unique_ptr<PostProcessingShader> shader;
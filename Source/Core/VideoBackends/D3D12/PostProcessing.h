@@ -42,6 +42,9 @@ private:
   uintptr_t CreateBindingSampler(const PostProcessingShaderConfiguration::RenderPass::Input& input_config) override;
   void ReleasePassNativeResources(RenderPassData& pass) override;
   bool RecompileShaders() override;
+  ShaderBinaryCompiler GetShaderBinaryCompiler() const override;
+  std::string GetPassShaderSource(size_t pass_index) const override;
+  bool CreatePassShader(RenderPassData& pass, const std::vector<u8>& binary) override;
 };
 
 class D3DPostProcessor final : public PostProcessor
@@ -89,6 +92,7 @@ protected:
   bool CreateUniformBuffer();
 
   std::unique_ptr<PostProcessingShader> CreateShader(PostProcessingShaderConfiguration* config) override;
+  std::string GetShaderBinaryCacheFileName() const override;
 
   D3DBlob*  m_vertex_shader_blob{};
   D3D12_SHADER_BYTECODE m_vertex_shader{};
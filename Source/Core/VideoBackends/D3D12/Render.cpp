@@ -663,6 +663,7 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   }
 
   // Flip/present backbuffer to frontbuffer here
+  PacePresent();
   D3D::Present();
   bool hpchanged = m_last_hp_frame_buffer != g_ActiveConfig.UseHPFrameBuffer();
   // Resize the back buffers NOW to avoid flickering
@@ -1000,18 +1001,31 @@ void Renderer::ApplyState(bool use_dst_alpha)
         FramebufferManager::GetEFBColorTexture()->GetFormat()
     };
 
+    // In hybrid mode a specialized PSO builds on the thread pool while the ubershaders draw.
+    const bool async = g_ActiveConfig.bBackgroundShaderCompiling &&
+                       !g_ActiveConfig.bDisableSpecializedShaders &&
+                       (!b_use_p_uber_shader || !b_use_v_uber_shader) &&
+                       ShaderCache::GetActivePixelUberShaderBytecode().pShaderBytecode &&
+                       ShaderCache::GetActiveVertexUberShaderBytecode().pShaderBytecode;
     ID3D12PipelineState* pso = nullptr;
-    CheckHR(
-      s_gx_state_cache.GetPipelineStateObjectFromCache(
-        pso_desc,
-        &pso,
-        topologyType
-      )
-    );
+    HRESULT hr = s_gx_state_cache.GetPipelineStateObjectFromCache(pso_desc, &pso, topologyType,
+                                                                  async);
+    CheckHR(hr);
+    if (hr == S_FALSE)
+    {
+      pso_desc.using_uber_pixel_shader = true;
+      pso_desc.using_uber_vertex_shader = true;
+      pso_desc.ps_bytecode = ShaderCache::GetActivePixelUberShaderBytecode();
+      pso_desc.vs_bytecode = ShaderCache::GetActiveVertexUberShaderBytecode();
+      pso_desc.input_Layout = static_cast<D3DVertexFormat*>(VertexLoaderManager::GetUberVertexFormat(
+          VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration()));
+      CheckHR(s_gx_state_cache.GetPipelineStateObjectFromCache(pso_desc, &pso, topologyType));
+    }
 
     D3D::current_command_list->SetPipelineState(pso);
 
-    D3D::command_list_mgr->SetCommandListDirtyState(COMMAND_LIST_STATE_PSO, false);
+    // Keep checking for the specialized PSO on the next draws.
+    D3D::command_list_mgr->SetCommandListDirtyState(COMMAND_LIST_STATE_PSO, hr == S_FALSE);
   }
   FramebufferManager::InvalidateEFBCache();
   FramebufferManager::GetEFBDepthTexture()->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_DEPTH_WRITE);
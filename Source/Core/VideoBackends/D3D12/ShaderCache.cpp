@@ -1,9 +1,9 @@
 // Copyright 2015 Dolphin Emulator Project
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
+#include <deque>
 #include <unordered_map>
 
-#include "Common/LinearDiskCache.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
@@ -15,6 +15,7 @@
 
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/HLSLCompiler.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/ObjectUsageProfiler.h"
 
@@ -24,14 +25,15 @@ namespace DX12
 // Primitive topology type is always triangle, unless the GS stage is used. This is consumed
 // by the PSO created in Renderer::ApplyState.
 static D3D12_PRIMITIVE_TOPOLOGY_TYPE s_current_primitive_topology = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-static pKey_t gameid = 0;
 struct ByteCodeCacheEntry
 {
   D3D12_SHADER_BYTECODE m_shader_bytecode;
   bool m_compiled;
   std::atomic_flag m_initialized;
+  // Draws that fell back to the ubershader while this one was compiling.
+  std::atomic<u32> m_hits;
 
-  ByteCodeCacheEntry() : m_compiled(false), m_shader_bytecode({})
+  ByteCodeCacheEntry() : m_compiled(false), m_shader_bytecode({}), m_hits(0)
   {
     m_initialized.clear();
   }
@@ -62,13 +64,13 @@ VUSBytecodeCache vus_bytecode_cache;
 static std::vector<D3DBlob*> s_static_blob_list;
 static std::vector<D3DBlob*> s_host_blob_list;
 
-static LinearDiskCache<TessellationShaderUid, u8> s_hs_disk_cache;
-static LinearDiskCache<TessellationShaderUid, u8> s_ds_disk_cache;
-static LinearDiskCache<GeometryShaderUid, u8> s_gs_disk_cache;
-static LinearDiskCache<PixelShaderUid, u8> s_ps_disk_cache;
-static LinearDiskCache<VertexShaderUid, u8> s_vs_disk_cache;
-static LinearDiskCache<UberShader::PixelUberShaderUid, u8> s_pus_disk_cache;
-static LinearDiskCache<UberShader::VertexUberShaderUid, u8> s_vus_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<TessellationShaderUid, u8> s_hs_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<TessellationShaderUid, u8> s_ds_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<GeometryShaderUid, u8> s_gs_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<PixelShaderUid, u8> s_ps_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<VertexShaderUid, u8> s_vs_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<UberShader::PixelUberShaderUid, u8> s_pus_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<UberShader::VertexUberShaderUid, u8> s_vus_disk_cache;
 
 static ByteCodeCacheEntry* s_last_domain_shader_bytecode;
 static ByteCodeCacheEntry* s_last_hull_shader_bytecode;
@@ -82,8 +84,12 @@ static GeometryShaderUid s_last_geometry_shader_uid;
 static PixelShaderUid s_last_pixel_shader_uid;
 static VertexShaderUid s_last_vertex_shader_uid;
 static TessellationShaderUid s_last_tessellation_shader_uid;
+static ShaderUidTracker s_uid_tracker(SHADER_UID_ALL);
 static UberShader::PixelUberShaderUid s_last_pixel_uber_shader_uid;
 static UberShader::VertexUberShaderUid s_last_vertex_uber_shader_uid;
+// The uber shaders no game draw of the usage profile needs, compiled one at a time.
+static std::deque<UberShader::PixelUberShaderUid> s_background_pus_uids;
+static std::deque<UberShader::VertexUberShaderUid> s_background_vus_uids;
 static bool s_use_pixel_uber_shader = false;
 static bool s_use_vertex_uber_shader = false;
 
@@ -198,17 +204,8 @@ void ShaderCache::Init()
   vs_bytecode_cache = nullptr;
   ts_bytecode_cache = nullptr;
 
-  std::string title_unique_id = SConfig::GetInstance().GetGameID();
-
-
-  gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-
-  ts_bytecode_cache = TsBytecodeCache::Create(
-    gameid,
-    TESSELLATIONSHADERGEN_UID_VERSION,
-    "Ishiiruka.ts",
-    StringFromFormat("%s.ts", title_unique_id.c_str())
-  );
+  ts_bytecode_cache = ShaderCacheUtils::CreateUsageProfile<TsBytecodeCache>(
+    "ts", TESSELLATIONSHADERGEN_UID_VERSION);
 
   LoadFromDisk();
   LoadHostBasedFromDisk();
@@ -226,6 +223,10 @@ void ShaderCache::Init()
     CompileShaders();
     CompileHostBasedShaders();
   }
+  else if (!g_ActiveConfig.bDisableSpecializedShaders)
+  {
+    PrecompileShadersInBackground();
+  }
   if (g_ActiveConfig.CanPrecompileUberShaders())
   {
     CompileUberShaders();
@@ -250,62 +251,159 @@ void ShaderCache::Init()
 
 static size_t shader_count = 0;
 
+// Only the uber shaders the draws in the usage profile map to are waited for, so those never
+// stutter. The others are left for QueueBackgroundUberShaders, or compiled when a draw needs one.
 void ShaderCache::CompileUberShaders()
 {
+  std::vector<UberShader::VertexUberShaderUid> used_vus;
+  std::vector<UberShader::VertexUberShaderUid> unused_vus;
+  ShaderCacheUtils::GetUberShadersToPrecompile(
+    vs_bytecode_cache,
+    [](const VertexShaderUid& uid) { return UberShader::GetVertexUberShaderUid(uid); },
+    UberShader::EnumerateVertexUberShaderUids, &used_vus, &unused_vus);
+  std::vector<UberShader::PixelUberShaderUid> used_pus;
+  std::vector<UberShader::PixelUberShaderUid> unused_pus;
+  ShaderCacheUtils::GetUberShadersToPrecompile(
+    ps_bytecode_cache,
+    [](const PixelShaderUid& uid) { return UberShader::GetPixelUberShaderUid(uid); },
+    UberShader::EnumeratePixelUberShaderUids, &used_pus, &unused_pus);
+
+  size_t total = used_vus.size();
   shader_count = 0;
-  UberShader::EnumerateVertexUberShaderUids([&](const UberShader::VertexUberShaderUid& uid, size_t total) {
-    HandleVUSUIDChange(uid, [total]() {
+  for (const UberShader::VertexUberShaderUid& uid : used_vus)
+  {
+    HandleVUSUIDChange(uid, false, [total]() {
       shader_count++;
       Host_UpdateProgressDialog(GetStringT("Compiling Vertex Uber shaders...").c_str(),
         static_cast<int>(shader_count), static_cast<int>(total));
     });
-  });
+  }
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
+  total = used_pus.size();
   shader_count = 0;
-  UberShader::EnumeratePixelUberShaderUids([&](const UberShader::PixelUberShaderUid& uid, size_t total) {
-    HandlePUSUIDChange(uid, [total]() {
+  for (const UberShader::PixelUberShaderUid& uid : used_pus)
+  {
+    HandlePUSUIDChange(uid, false, [total]() {
       shader_count++;
       Host_UpdateProgressDialog(GetStringT("Compiling Pixel Uber shaders...").c_str(),
         static_cast<int>(shader_count), static_cast<int>(total));
     });
-  });
+  }
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
+
+  s_background_vus_uids.clear();
+  for (const UberShader::VertexUberShaderUid& uid : unused_vus)
+  {
+    auto it = vus_bytecode_cache.find(uid);
+    if (it == vus_bytecode_cache.end() || !it->second.m_compiled)
+      s_background_vus_uids.push_back(uid);
+  }
+  s_background_pus_uids.clear();
+  for (const UberShader::PixelUberShaderUid& uid : unused_pus)
+  {
+    auto it = pus_bytecode_cache.find(uid);
+    if (it == pus_bytecode_cache.end() || !it->second.m_compiled)
+      s_background_pus_uids.push_back(uid);
+  }
+}
+
+// Queues the next background uber shader whenever the compiler has nothing else waiting, so they
+// never hold up a shader a draw needs.
+void ShaderCache::QueueBackgroundUberShaders()
+{
+  if ((s_background_vus_uids.empty() && s_background_pus_uids.empty()) ||
+      s_compiler->HasQueuedUnits())
+  {
+    return;
+  }
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler, CompilePriority::Predicted);
+  if (!s_background_vus_uids.empty())
+  {
+    HandleVUSUIDChange(s_background_vus_uids.front(), true, {});
+    s_background_vus_uids.pop_front();
+  }
+  else
+  {
+    HandlePUSUIDChange(s_background_pus_uids.front(), true, {});
+    s_background_pus_uids.pop_front();
+  }
 }
 
 void ShaderCache::CompileShaders()
 {
-  ts_bytecode_cache->ForEachMostUsedByCategory(gameid,
-    [&](const TessellationShaderUid& it, size_t total)
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler, CompilePriority::Precompile);
+  ShaderCacheUtils::ForEachShaderToPrecompile(ts_bytecode_cache,
+    [](std::pair<ByteCodeCacheEntry, ByteCodeCacheEntry>& entry)
+  {
+    return !entry.first.m_shader_bytecode.pShaderBytecode;
+  },
+    [&](const TessellationShaderUid& item, size_t total)
   {
-    TessellationShaderUid item = it;
-    item.ClearHASH();
-    item.CalculateUIDHash();
     HandleTSUIDChange(item, [total]() {
       shader_count++;
       Host_UpdateProgressDialog(GetStringT("Compiling Tessellation shaders...").c_str(),
         static_cast<int>(shader_count), static_cast<int>(total * 2));
     });
-  },
-    [](std::pair<ByteCodeCacheEntry, ByteCodeCacheEntry>& entry)
-  {
-    return !entry.first.m_shader_bytecode.pShaderBytecode;
-  }
-  , true);
+  });
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
 }
 
+// Queues the most used shaders of the games whose profile was seeded, the draws pick them up once
+// the thread pool has compiled them.
+void ShaderCache::PrecompileShadersInBackground()
+{
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler, CompilePriority::Predicted);
+  if (ShaderCacheUtils::ShouldPrecompileInBackground(ts_bytecode_cache))
+  {
+    ShaderCacheUtils::ForEachShaderToPrecompile(ts_bytecode_cache,
+      [](std::pair<ByteCodeCacheEntry, ByteCodeCacheEntry>& entry)
+    {
+      return !entry.first.m_shader_bytecode.pShaderBytecode;
+    },
+      [](const TessellationShaderUid& item, size_t total)
+    {
+      HandleTSUIDChange(item, {});
+    }, ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT / 2);
+  }
+  if (ShaderCacheUtils::ShouldPrecompileInBackground(ps_bytecode_cache))
+  {
+    ShaderCacheUtils::ForEachShaderToPrecompile(ps_bytecode_cache,
+      [](ByteCodeCacheEntry& entry)
+    {
+      return !entry.m_shader_bytecode.pShaderBytecode;
+    },
+      [](const PixelShaderUid& item, size_t total)
+    {
+      HandlePSUIDChange(item, false, {});
+    }, ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT);
+  }
+  if (ShaderCacheUtils::ShouldPrecompileInBackground(vs_bytecode_cache))
+  {
+    ShaderCacheUtils::ForEachShaderToPrecompile(vs_bytecode_cache,
+      [](ByteCodeCacheEntry& entry)
+    {
+      return !entry.m_shader_bytecode.pShaderBytecode;
+    },
+      [](const VertexShaderUid& item, size_t total)
+    {
+      HandleVSUIDChange(item, false, {});
+    }, ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT);
+  }
+}
+
 void ShaderCache::CompileHostBasedShaders()
 {
   shader_count = 0;
-  ps_bytecode_cache->ForEachMostUsedByCategory(gameid,
-    [&](const PixelShaderUid& it, size_t total)
+  ShaderCacheUtils::ForEachShaderToPrecompile(ps_bytecode_cache,
+    [](ByteCodeCacheEntry& entry)
+  {
+    return !entry.m_shader_bytecode.pShaderBytecode;
+  },
+    [&](const PixelShaderUid& item, size_t total)
   {
-    PixelShaderUid item = it;
-    item.ClearHASH();
-    item.CalculateUIDHash();
     HandlePSUIDChange(item, true, [total]() {
       shader_count++;
       if ((shader_count & 7) == 0)
@@ -314,32 +412,22 @@ void ShaderCache::CompileHostBasedShaders()
           static_cast<int>(shader_count), static_cast<int>(total));
       }
     });
-    
-  },
+  });
+  s_compiler->WaitForFinish();
+  shader_count = 0;
+  ShaderCacheUtils::ForEachShaderToPrecompile(vs_bytecode_cache,
     [](ByteCodeCacheEntry& entry)
   {
     return !entry.m_shader_bytecode.pShaderBytecode;
-  }
-  , true);
-  s_compiler->WaitForFinish();
-  shader_count = 0;
-  vs_bytecode_cache->ForEachMostUsedByCategory(gameid,
-    [&](const VertexShaderUid& it, size_t total)
+  },
+    [&](const VertexShaderUid& item, size_t total)
   {
-    VertexShaderUid item = it;
-    item.ClearHASH();
-    item.CalculateUIDHash();
     HandleVSUIDChange(item, true, [total]() {
       shader_count++;
       Host_UpdateProgressDialog(GetStringT("Compiling Vertex shaders...").c_str(),
         static_cast<int>(shader_count), static_cast<int>(total));
     });
-  },
-    [](ByteCodeCacheEntry& entry)
-  {
-    return !entry.m_shader_bytecode.pShaderBytecode;
-  }
-  , true);
+  });
   s_compiler->WaitForFinish();
   shader_count = 0;
   EnumerateGeometryShaderUids([&](const GeometryShaderUid& it, size_t total)
@@ -365,19 +453,13 @@ void ShaderCache::LoadHostBasedFromDisk()
 {
   if (vs_bytecode_cache)
   {
-    vs_bytecode_cache->Persist([](VertexShaderUid& uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(vs_bytecode_cache);
     delete vs_bytecode_cache;
     vs_bytecode_cache = nullptr;
   }
   if (ps_bytecode_cache)
   {
-    ps_bytecode_cache->Persist([](PixelShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(ps_bytecode_cache);
     delete ps_bytecode_cache;
     ps_bytecode_cache = nullptr;
   }
@@ -388,21 +470,10 @@ void ShaderCache::LoadHostBasedFromDisk()
   for (auto& iter : s_host_blob_list)
     SAFE_RELEASE(iter);
 
-  std::string title_unique_id = SConfig::GetInstance().GetGameID();
-
-  vs_bytecode_cache = VsBytecodeCache::Create(
-    gameid,
-    VERTEXSHADERGEN_UID_VERSION,
-    "Ishiiruka.vs",
-    StringFromFormat("%s.vs", title_unique_id.c_str())
-  );
-
-  ps_bytecode_cache = PsBytecodeCache::Create(
-    gameid,
-    PIXELSHADERGEN_UID_VERSION,
-    "Ishiiruka.ps",
-    StringFromFormat("%s.ps", title_unique_id.c_str())
-  );
+  vs_bytecode_cache = ShaderCacheUtils::CreateUsageProfile<VsBytecodeCache>(
+    "vs", VERTEXSHADERGEN_UID_VERSION);
+  ps_bytecode_cache = ShaderCacheUtils::CreateUsageProfile<PsBytecodeCache>(
+    "ps", PIXELSHADERGEN_UID_VERSION);
   std::string pus_cache_filename = GetDiskShaderCacheFileName(API_D3D11, "ups", false, true);
   std::string vus_cache_filename = GetDiskShaderCacheFileName(API_D3D11, "uvs", false, true);
   std::string ps_cache_filename = GetDiskShaderCacheFileName(API_D3D11, "ps", true, true);
@@ -443,6 +514,7 @@ void ShaderCache::Reload()
 {
   if (s_compiler)
   {
+    s_compiler->CancelPendingUnits(CompilePriority::Predicted);
     s_compiler->WaitForFinish();
   }
   s_gs_disk_cache.Sync();
@@ -464,6 +536,10 @@ void ShaderCache::Reload()
   {
     CompileHostBasedShaders();
   }
+  else if (!g_ActiveConfig.bDisableSpecializedShaders)
+  {
+    PrecompileShadersInBackground();
+  }
   s_last_domain_shader_bytecode = &s_pass_entry;
   s_last_hull_shader_bytecode = &s_pass_entry;
   s_last_geometry_shader_bytecode = &s_pass_entry;
@@ -487,8 +563,11 @@ void ShaderCache::Clear()
 
 void ShaderCache::Shutdown()
 {
+  s_background_pus_uids.clear();
+  s_background_vus_uids.clear();
   if (s_compiler)
   {
+    s_compiler->CancelPendingUnits(CompilePriority::Predicted);
     s_compiler->WaitForFinish();
   }
 
@@ -502,24 +581,15 @@ void ShaderCache::Shutdown()
 
   s_host_blob_list.clear();
 
-  vs_bytecode_cache->Persist([](VertexShaderUid &uid) {
-    uid.ClearHASH();
-    uid.CalculateUIDHash();
-  });
+  ShaderCacheUtils::PersistUsageProfile(vs_bytecode_cache);
   delete vs_bytecode_cache;
   vs_bytecode_cache = nullptr;
 
-  ts_bytecode_cache->Persist([](TessellationShaderUid &uid) {
-    uid.ClearHASH();
-    uid.CalculateUIDHash();
-  });
+  ShaderCacheUtils::PersistUsageProfile(ts_bytecode_cache);
   delete ts_bytecode_cache;
   ts_bytecode_cache = nullptr;
 
-  ps_bytecode_cache->Persist([](PixelShaderUid &uid) {
-    uid.ClearHASH();
-    uid.CalculateUIDHash();
-  });
+  ShaderCacheUtils::PersistUsageProfile(ps_bytecode_cache);
   delete ps_bytecode_cache;
   ps_bytecode_cache = nullptr;
 
@@ -647,6 +717,9 @@ void ShaderCache::HandlePSUIDChange(const PixelShaderUid &ps_uid, bool forcecomp
   }
   // Need to compile a new shader
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  wunit->priority = &entry->m_hits;
+  // Compiled again the next time a draw needs it.
+  wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->m_initialized.clear(); };
   wunit->GenerateCodeHandler = [ps_uid](ShaderCompilerWorkUnit* wunit)
   {
     GeneratePixelShaderCode(wunit->code, ps_uid.GetUidData(), ShaderHostConfig::GetCurrent());
@@ -685,10 +758,11 @@ void ShaderCache::HandlePSUIDChange(const PixelShaderUid &ps_uid, bool forcecomp
   s_compiler->CompileShaderAsync(wunit);
 }
 
-void ShaderCache::HandlePUSUIDChange(const UberShader::PixelUberShaderUid &ps_uid, std::function<void()> oncompilationfinished = {})
+void ShaderCache::HandlePUSUIDChange(const UberShader::PixelUberShaderUid &ps_uid, bool background, std::function<void()> oncompilationfinished)
 {
   ByteCodeCacheEntry* entry = &pus_bytecode_cache[ps_uid];
-  s_last_pixel_uber_shader_bytecode = entry;
+  if (!background)
+    s_last_pixel_uber_shader_bytecode = entry;
   if (entry->m_initialized.test_and_set())
   {
     if (oncompilationfinished) oncompilationfinished();
@@ -696,6 +770,16 @@ void ShaderCache::HandlePUSUIDChange(const UberShader::PixelUberShaderUid &ps_ui
   }
   // Need to compile a new shader
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  if (background)
+  {
+    wunit->priority = &entry->m_hits;
+    // Compiled again the next time a draw needs it.
+    wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->m_initialized.clear(); };
+  }
+  else
+  {
+    wunit->priority = &HLSLAsyncCompiler::HIGHEST_PRIORITY;
+  }
   wunit->GenerateCodeHandler = [ps_uid](ShaderCompilerWorkUnit* wunit)
   {
     UberShader::GenPixelShader(wunit->code, API_D3D11, ShaderHostConfig::GetCurrent(), ps_uid.GetUidData());
@@ -747,6 +831,9 @@ void ShaderCache::HandleVSUIDChange(const VertexShaderUid& vs_uid, bool forcecom
     return;
   }
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  wunit->priority = &entry->m_hits;
+  // Compiled again the next time a draw needs it.
+  wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->m_initialized.clear(); };
   wunit->GenerateCodeHandler = [vs_uid](ShaderCompilerWorkUnit* wunit)
   {
     GenerateVertexShaderCode(wunit->code, vs_uid.GetUidData(), ShaderHostConfig::GetCurrent());
@@ -782,10 +869,11 @@ void ShaderCache::HandleVSUIDChange(const VertexShaderUid& vs_uid, bool forcecom
   s_compiler->CompileShaderAsync(wunit);
 }
 
-void ShaderCache::HandleVUSUIDChange(const UberShader::VertexUberShaderUid& vs_uid, std::function<void()> oncompilationfinished = {})
+void ShaderCache::HandleVUSUIDChange(const UberShader::VertexUberShaderUid& vs_uid, bool background, std::function<void()> oncompilationfinished)
 {
   ByteCodeCacheEntry* entry = &vus_bytecode_cache[vs_uid];
-  s_last_vertex_uber_shader_bytecode = entry;
+  if (!background)
+    s_last_vertex_uber_shader_bytecode = entry;
   // Compile only when we have a new instance
   if (entry->m_initialized.test_and_set())
   {
@@ -793,6 +881,16 @@ void ShaderCache::HandleVUSUIDChange(const UberShader::VertexUberShaderUid& vs_u
     return;
   }
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  if (background)
+  {
+    wunit->priority = &entry->m_hits;
+    // Compiled again the next time a draw needs it.
+    wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->m_initialized.clear(); };
+  }
+  else
+  {
+    wunit->priority = &HLSLAsyncCompiler::HIGHEST_PRIORITY;
+  }
   wunit->GenerateCodeHandler = [vs_uid](ShaderCompilerWorkUnit* wunit)
   {
     UberShader::GenVertexShader(wunit->code, API_D3D11, ShaderHostConfig::GetCurrent(), vs_uid.GetUidData());
@@ -933,22 +1031,32 @@ void ShaderCache::PrepareShaders(PIXEL_SHADER_RENDER_MODE render_mode,
   const BPMemory &bpm)
 {
   SetCurrentPrimitiveTopology(gs_primitive_type);
-  if (g_ActiveConfig.bBackgroundShaderCompiling || g_ActiveConfig.bDisableSpecializedShaders)
+  const bool use_uber_shaders =
+    g_ActiveConfig.bBackgroundShaderCompiling || g_ActiveConfig.bDisableSpecializedShaders;
+  // Nothing the uids depend on changed since the last draw.
+  if (s_uid_tracker.IsUnchanged(components, (render_mode << 8) | static_cast<u32>(gs_primitive_type)) &&
+    s_last_pixel_shader_bytecode && s_last_vertex_shader_bytecode &&
+    (!use_uber_shaders || (s_last_pixel_uber_shader_bytecode && s_last_vertex_uber_shader_bytecode)))
+  {
+    return;
+  }
+  if (use_uber_shaders)
   {
     auto vusid = UberShader::GetVertexUberShaderUid(components, xfr);
     if (!s_last_vertex_uber_shader_bytecode || s_last_vertex_uber_shader_uid != vusid)
     {
       D3D::command_list_mgr->SetCommandListDirtyState(COMMAND_LIST_STATE_PSO, true);
       s_last_vertex_uber_shader_uid = vusid;
-      HandleVUSUIDChange(vusid);
+      HandleVUSUIDChange(vusid, false, {});
     }
     auto pusid = UberShader::GetPixelUberShaderUid(components, xfr, bpm);
     if (!s_last_pixel_uber_shader_bytecode || s_last_pixel_uber_shader_uid != pusid)
     {
       s_last_pixel_uber_shader_uid = pusid;
       D3D::command_list_mgr->SetCommandListDirtyState(COMMAND_LIST_STATE_PSO, true);
-      HandlePUSUIDChange(pusid);
+      HandlePUSUIDChange(pusid, false, {});
     }
+    QueueBackgroundUberShaders();
   }
   GeometryShaderUid gs_uid;
   GetGeometryShaderUid(gs_uid, gs_primitive_type, xfr, components);
@@ -1034,12 +1142,29 @@ bool ShaderCache::TestShaders()
   s_compiler->ProcCompilationResults();  
   if (g_ActiveConfig.bBackgroundShaderCompiling || g_ActiveConfig.bDisableSpecializedShaders)
   {
-    s_use_pixel_uber_shader = g_ActiveConfig.bDisableSpecializedShaders
+    const bool use_pixel_uber_shader = g_ActiveConfig.bDisableSpecializedShaders
       || s_last_pixel_shader_bytecode == nullptr
       || !s_last_pixel_shader_bytecode->m_compiled;
-    s_use_vertex_uber_shader = g_ActiveConfig.bDisableSpecializedShaders
+    const bool use_vertex_uber_shader = g_ActiveConfig.bDisableSpecializedShaders
       || s_last_vertex_shader_bytecode == nullptr
       || !s_last_vertex_shader_bytecode->m_compiled;
+    if (use_pixel_uber_shader && s_last_pixel_shader_bytecode)
+      s_last_pixel_shader_bytecode->m_hits.fetch_add(1, std::memory_order_relaxed);
+    if (use_vertex_uber_shader && s_last_vertex_shader_bytecode)
+      s_last_vertex_shader_bytecode->m_hits.fetch_add(1, std::memory_order_relaxed);
+    if (!g_ActiveConfig.bDisableSpecializedShaders &&
+        (use_pixel_uber_shader || use_vertex_uber_shader))
+    {
+      ShaderCompileStats::AddUberShaderDraw();
+    }
+    // Swap the specialized shaders in on the first draw after they are ready.
+    if (use_pixel_uber_shader != s_use_pixel_uber_shader ||
+        use_vertex_uber_shader != s_use_vertex_uber_shader)
+    {
+      D3D::command_list_mgr->SetCommandListDirtyState(COMMAND_LIST_STATE_PSO, true);
+    }
+    s_use_pixel_uber_shader = use_pixel_uber_shader;
+    s_use_vertex_uber_shader = use_vertex_uber_shader;
     return true;
   }
   else
@@ -1052,10 +1177,15 @@ bool ShaderCache::TestShaders()
     || s_last_vertex_shader_bytecode == nullptr);
   if (shaders_available)
   {
+    const auto compiled = [] {
+      return s_last_geometry_shader_bytecode->m_compiled &&
+             s_last_pixel_shader_bytecode->m_compiled &&
+             s_last_vertex_shader_bytecode->m_compiled;
+    };
+    ShaderCompileStats::StallTimer stall(!compiled() &&
+                                         !g_ActiveConfig.bFullAsyncShaderCompilation);
     int count = 0;
-    while (!(s_last_geometry_shader_bytecode->m_compiled
-      && s_last_pixel_shader_bytecode->m_compiled
-      && s_last_vertex_shader_bytecode->m_compiled))
+    while (!compiled())
     {
       s_compiler->ProcCompilationResults();
       if (g_ActiveConfig.bFullAsyncShaderCompilation)
@@ -1064,9 +1194,7 @@ bool ShaderCache::TestShaders()
       }
       Common::cYield(count++);
     }
-    shaders_available = s_last_geometry_shader_bytecode->m_compiled
-      && s_last_pixel_shader_bytecode->m_compiled
-      && s_last_vertex_shader_bytecode->m_compiled;
+    shaders_available = compiled();
   }
   return shaders_available;
 }
@@ -75,6 +75,8 @@ private:
   static void CompileHostBasedShaders();
   static void CompileShaders();
   static void CompileUberShaders();
+  static void QueueBackgroundUberShaders();
+  static void PrecompileShadersInBackground();
   static void LoadFromDisk();
   static void LoadHostBasedFromDisk();
   static void SetCurrentPrimitiveTopology(PrimitiveType gs_primitive_type);
@@ -87,9 +89,9 @@ private:
 
   static void HandleTSUIDChange(const TessellationShaderUid& ts_uid, std::function<void()> oncompilationfinished);
 
-  static void HandlePUSUIDChange(const UberShader::PixelUberShaderUid& ps_uid, std::function<void()> oncompilationfinished);
+  static void HandlePUSUIDChange(const UberShader::PixelUberShaderUid& ps_uid, bool background, std::function<void()> oncompilationfinished);
 
-  static void HandleVUSUIDChange(const UberShader::VertexUberShaderUid& vs_uid, std::function<void()> oncompilationfinished);
+  static void HandleVUSUIDChange(const UberShader::VertexUberShaderUid& vs_uid, bool background, std::function<void()> oncompilationfinished);
 };
 
 }
@@ -26,14 +26,15 @@ namespace DX12
 {
 
 // EXISTINGD3D11TODO: Find sensible values for these two
+// Mapped batches reserve MAXVBUFFERSIZE and MAXIBUFFERSIZE up front, see ResetBuffer.
 static constexpr unsigned int MAX_IBUFFER_SIZE = VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 16;
-static constexpr unsigned int MAX_VBUFFER_SIZE = VertexManager::MAXVBUFFERSIZE * 2;
+static constexpr unsigned int MAX_VBUFFER_SIZE = VertexManager::MAXVBUFFERSIZE * 4;
 
 void VertexManager::SetIndexBuffer()
 {
   D3D12_INDEX_BUFFER_VIEW ibView = {
-      m_stream_buffer->GetBaseGPUAddress(),          // D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
-      static_cast<UINT>(m_stream_buffer->GetSize()), // UINT SizeInBytes;
+      m_index_stream_buffer->GetBaseGPUAddress(),          // D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+      static_cast<UINT>(m_index_stream_buffer->GetSize()), // UINT SizeInBytes;
       DXGI_FORMAT_R16_UINT                                 // DXGI_FORMAT Format;
   };
 
@@ -44,7 +45,8 @@ void VertexManager::CreateDeviceObjects()
 {
   m_vertex_draw_offset = 0;
   m_index_draw_offset = 0;
-  m_stream_buffer = std::make_unique<D3DStreamBuffer>((MAX_VBUFFER_SIZE + MAX_IBUFFER_SIZE) / 2, MAX_VBUFFER_SIZE + MAX_IBUFFER_SIZE, &m_stream_buffer_reallocated);
+  m_vertex_stream_buffer = std::make_unique<D3DStreamBuffer>(MAX_VBUFFER_SIZE / 2, MAX_VBUFFER_SIZE, &m_stream_buffer_reallocated);
+  m_index_stream_buffer = std::make_unique<D3DStreamBuffer>(MAX_IBUFFER_SIZE / 2, MAX_IBUFFER_SIZE, &m_stream_buffer_reallocated);
   m_stream_buffer_reallocated = true;
   m_vertex_cpu_buffer.resize(MAXVBUFFERSIZE);
   m_index_cpu_buffer.resize(MAXIBUFFERSIZE);
@@ -52,7 +54,8 @@ void VertexManager::CreateDeviceObjects()
 
 void VertexManager::DestroyDeviceObjects()
 {
-  m_stream_buffer.reset();
+  m_vertex_stream_buffer.reset();
+  m_index_stream_buffer.reset();
   m_vertex_cpu_buffer.clear();
   m_index_cpu_buffer.clear();
 }
@@ -71,8 +74,27 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
 {
   u32 vertex_data_size = IndexGenerator::GetNumVerts() * stride;
   u32 index_data_size = IndexGenerator::GetIndexLen() * sizeof(u16);
-  size_t total_size = vertex_data_size + index_data_size;
-  bool current_command_list_executed = m_stream_buffer->AllocateSpaceInBuffer(total_size, stride);
+
+  if (m_writing_stream_buffers)
+  {
+    // Give back what the batch didn't use of the conservative allocation.
+    m_vertex_stream_buffer->OverrideSizeOfPreviousAllocation(vertex_data_size);
+    m_index_stream_buffer->OverrideSizeOfPreviousAllocation(index_data_size);
+  }
+  else
+  {
+    bool current_command_list_executed = m_vertex_stream_buffer->AllocateSpaceInBuffer(vertex_data_size, stride);
+    current_command_list_executed |= m_index_stream_buffer->AllocateSpaceInBuffer(index_data_size, sizeof(u16));
+    if (current_command_list_executed)
+    {
+      g_renderer->RestoreAPIState();
+    }
+
+    m_vertex_draw_offset = static_cast<u32>(m_vertex_stream_buffer->GetOffsetOfCurrentAllocation());
+    m_index_draw_offset = static_cast<u32>(m_index_stream_buffer->GetOffsetOfCurrentAllocation());
+    memcpy(m_vertex_stream_buffer->GetCPUAddressOfCurrentAllocation(), m_vertex_cpu_buffer.data(), vertex_data_size);
+    memcpy(m_index_stream_buffer->GetCPUAddressOfCurrentAllocation(), m_index_cpu_buffer.data(), index_data_size);
+  }
 
   if (m_stream_buffer_reallocated)
   {
@@ -81,17 +103,6 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
     m_stream_buffer_reallocated = false;
   }
 
-  m_vertex_draw_offset = static_cast<u32>(m_stream_buffer->GetOffsetOfCurrentAllocation());
-  m_index_draw_offset = m_vertex_draw_offset + vertex_data_size;
-  u8* dest = static_cast<u8*>(m_stream_buffer->GetCPUAddressOfCurrentAllocation());
-  memcpy(dest, m_vertex_cpu_buffer.data(), vertex_data_size);
-  memcpy(dest + vertex_data_size, m_index_cpu_buffer.data(), index_data_size);
-
-  if (current_command_list_executed)
-  {
-    g_renderer->RestoreAPIState();
-  }
-
   ADDSTAT(stats.thisFrame.bytesVertexStreamed, vertex_data_size);
   ADDSTAT(stats.thisFrame.bytesIndexStreamed, index_data_size);
 }
@@ -105,8 +116,8 @@ void VertexManager::Draw(u32 stride)
   if (D3D::command_list_mgr->GetCommandListDirtyState(COMMAND_LIST_STATE_VERTEX_BUFFER) || s_previous_stride != stride)
   {
     D3D12_VERTEX_BUFFER_VIEW vbView = {
-        m_stream_buffer->GetBaseGPUAddress(),          // D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
-        static_cast<UINT>(m_stream_buffer->GetSize()), // UINT SizeInBytes;
+        m_vertex_stream_buffer->GetBaseGPUAddress(),          // D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+        static_cast<UINT>(m_vertex_stream_buffer->GetSize()), // UINT SizeInBytes;
         stride                                                // UINT StrideInBytes;
     };
 
@@ -184,11 +195,33 @@ u16* VertexManager::GetIndexBuffer()
 
 void VertexManager::ResetBuffer(u32 stride)
 {
-  m_pCurBufferPointer = m_vertex_cpu_buffer.data();
-  m_pBaseBufferPointer = m_vertex_cpu_buffer.data();
+  // The vertex loaders and the index generator write straight into the upload heaps, which stay
+  // mapped. Batches that are culled entirely never reach the GPU, they go to the CPU buffers.
+  m_writing_stream_buffers = !m_cull_all;
+  if (!m_writing_stream_buffers)
+  {
+    m_pCurBufferPointer = m_vertex_cpu_buffer.data();
+    m_pBaseBufferPointer = m_vertex_cpu_buffer.data();
+    m_pEndBufferPointer = m_pCurBufferPointer + MAXVBUFFERSIZE;
+
+    IndexGenerator::Start(reinterpret_cast<u16*>(m_index_cpu_buffer.data()));
+    return;
+  }
+
+  bool current_command_list_executed = m_vertex_stream_buffer->AllocateSpaceInBuffer(MAXVBUFFERSIZE, stride);
+  current_command_list_executed |= m_index_stream_buffer->AllocateSpaceInBuffer(MAXIBUFFERSIZE * sizeof(u16), sizeof(u16));
+  if (current_command_list_executed)
+  {
+    g_renderer->RestoreAPIState();
+  }
+
+  m_vertex_draw_offset = static_cast<u32>(m_vertex_stream_buffer->GetOffsetOfCurrentAllocation());
+  m_index_draw_offset = static_cast<u32>(m_index_stream_buffer->GetOffsetOfCurrentAllocation());
+  m_pCurBufferPointer = static_cast<u8*>(m_vertex_stream_buffer->GetCPUAddressOfCurrentAllocation());
+  m_pBaseBufferPointer = m_pCurBufferPointer;
   m_pEndBufferPointer = m_pCurBufferPointer + MAXVBUFFERSIZE;
 
-  IndexGenerator::Start(reinterpret_cast<u16*>(m_index_cpu_buffer.data()));
+  IndexGenerator::Start(static_cast<u16*>(m_index_stream_buffer->GetCPUAddressOfCurrentAllocation()));
 }
 
 }  // namespace
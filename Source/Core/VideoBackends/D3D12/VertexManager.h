@@ -39,10 +39,14 @@ private:
   u32 m_vertex_draw_offset;
   u32 m_index_draw_offset;
 
-  std::unique_ptr<D3DStreamBuffer> m_stream_buffer = nullptr;
+  std::unique_ptr<D3DStreamBuffer> m_vertex_stream_buffer = nullptr;
+  std::unique_ptr<D3DStreamBuffer> m_index_stream_buffer = nullptr;
 
   bool m_stream_buffer_reallocated = true;
+  // False while the current batch is written to the CPU buffers instead of the stream buffers.
+  bool m_writing_stream_buffers = false;
 
+  // For batches that are culled entirely.
   std::vector<u16, Common::aligned_allocator<u16, 256>> m_index_cpu_buffer;
   std::vector<u8, Common::aligned_allocator<u8, 256>> m_vertex_cpu_buffer;
 
@@ -28,6 +28,7 @@
 #include "VideoCommon/BPStructs.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameProfilerBase.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -96,7 +97,9 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsPixelLighting = true;
   g_Config.backend_info.bNeedBlendIndices = false;
   g_Config.backend_info.bSupportsOversizedViewports = false;
+  g_Config.backend_info.bSupportsPrimitiveRestart = false;
   g_Config.backend_info.bSupportsGeometryShaders = true;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
   g_Config.backend_info.bSupports3DVision = true;
   g_Config.backend_info.bSupportsPostProcessing = true;
   g_Config.backend_info.bSupportsClipControl = true;
@@ -108,7 +111,10 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsTessellation = true;
   g_Config.backend_info.bSupportsSSAA = true;
   g_Config.backend_info.bSupportsGPUTextureDecoding = false;
+  g_Config.backend_info.bSupportsGPUTextureScaling = false;
+  g_Config.backend_info.bSupportsGPUMipmapGeneration = false;
   g_Config.backend_info.bSupportsComputeTextureEncoding = false;
+  g_Config.backend_info.bSupportsGPUVertexDecoding = false;
   g_Config.backend_info.bSupportsDepthClamp = true;
   g_Config.backend_info.bSupportsMultithreading = true;
   g_Config.backend_info.bSupportsValidationLayer = true;
@@ -187,6 +193,8 @@ void VideoBackend::Video_Prepare()
   g_texture_cache = std::make_unique<TextureCache>();
   g_vertex_manager = std::make_unique<VertexManager>();
   g_perf_query = std::make_unique<PerfQuery>();
+  // Only the CPU times of the passes, there are no timestamp queries here yet.
+  g_frame_profiler = std::make_unique<FrameProfilerBase>();
   g_xfb_encoder = std::make_unique<XFBEncoder>();
   g_renderer->Init();
   ShaderCache::Init();
@@ -204,12 +212,15 @@ void VideoBackend::Shutdown()
 
   // internal interfaces
   D3D::ShutdownUtils();
+  // The PSOs still building use the shader bytecode freed below.
+  s_gx_state_cache.WaitForPipelines();
   ShaderCache::Shutdown();
   ShaderConstantsManager::Shutdown();
   StaticShaderCache::Shutdown();
   BBox::Shutdown();
 
   g_xfb_encoder.reset();
+  g_frame_profiler.reset();
   g_perf_query.reset();
   g_vertex_manager.reset();
   g_texture_cache.reset();
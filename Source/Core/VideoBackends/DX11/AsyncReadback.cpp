@@ -0,0 +1,79 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/DX11/AsyncReadback.h"
+
+#include "VideoBackends/DX11/D3DBase.h"
+#include "VideoBackends/DX11/D3DTexture.h"
+
+namespace DX11
+{
+AsyncReadback::AsyncReadback(size_t ring_size)
+  : AsyncReadbackBase(ring_size), m_staging_slots(GetSlotCount())
+{
+}
+
+AsyncReadback::~AsyncReadback()
+{
+  Discard();
+}
+
+bool AsyncReadback::CopyToSlot(size_t slot, uintptr_t texture,
+  const MathUtil::Rectangle<int>& rect)
+{
+  D3DTexture2D* src_texture = reinterpret_cast<D3DTexture2D*>(texture);
+  StagingSlot& staging = m_staging_slots[slot];
+  const u32 width = static_cast<u32>(rect.GetWidth());
+  const u32 height = static_cast<u32>(rect.GetHeight());
+  if (!staging.texture || staging.width != width || staging.height != height)
+  {
+    staging.texture.reset();
+    D3D11_TEXTURE2D_DESC desc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, width, height,
+      1, 1, 0, D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ);
+    HRESULT hr = D3D::device->CreateTexture2D(&desc, nullptr, D3D::ToAddr(staging.texture));
+    if (FAILED(hr))
+    {
+      PanicAlert("Failed to create readback texture.");
+      return false;
+    }
+    D3D::SetDebugObjectName(staging.texture.get(), "async readback texture");
+    staging.width = width;
+    staging.height = height;
+  }
+  if (!staging.query)
+  {
+    D3D11_QUERY_DESC desc = CD3D11_QUERY_DESC(D3D11_QUERY_EVENT, 0);
+    D3D::device->CreateQuery(&desc, D3D::ToAddr(staging.query));
+  }
+
+  const D3D11_BOX box = CD3D11_BOX(rect.left, rect.top, 0, rect.right, rect.bottom, 1);
+  D3D::context->CopySubresourceRegion(staging.texture.get(), 0, 0, 0, 0,
+    src_texture->GetTex(), 0, &box);
+  if (staging.query)
+    D3D::context->End(staging.query.get());
+  return true;
+}
+
+bool AsyncReadback::IsSlotReady(size_t slot)
+{
+  // Without a query mapping waits for the copy.
+  const StagingSlot& staging = m_staging_slots[slot];
+  return !staging.query ||
+    D3D::context->GetData(staging.query.get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK;
+}
+
+const u8* AsyncReadback::MapSlot(size_t slot, u32* stride)
+{
+  D3D11_MAPPED_SUBRESOURCE map;
+  if (FAILED(D3D::context->Map(m_staging_slots[slot].texture.get(), 0, D3D11_MAP_READ, 0, &map)))
+    return nullptr;
+  *stride = map.RowPitch;
+  return reinterpret_cast<const u8*>(map.pData);
+}
+
+void AsyncReadback::UnmapSlot(size_t slot)
+{
+  D3D::context->Unmap(m_staging_slots[slot].texture.get(), 0);
+}
+}  // namespace DX11
@@ -0,0 +1,39 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "VideoBackends/DX11/D3DPtr.h"
+#include "VideoCommon/AsyncReadbackBase.h"
+
+namespace DX11
+{
+// Reads D3DTexture2Ds back through staging textures, an event query after each copy tells when
+// it is done.
+class AsyncReadback final : public AsyncReadbackBase
+{
+public:
+  explicit AsyncReadback(size_t ring_size);
+  ~AsyncReadback();
+
+protected:
+  bool CopyToSlot(size_t slot, uintptr_t texture, const MathUtil::Rectangle<int>& rect) override;
+  bool IsSlotReady(size_t slot) override;
+  const u8* MapSlot(size_t slot, u32* stride) override;
+  void UnmapSlot(size_t slot) override;
+
+private:
+  struct StagingSlot
+  {
+    D3D::Texture2dPtr texture;
+    D3D::QueryPtr query;
+    u32 width = 0;
+    u32 height = 0;
+  };
+
+  std::vector<StagingSlot> m_staging_slots;
+};
+}  // namespace DX11
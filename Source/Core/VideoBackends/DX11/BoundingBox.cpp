@@ -65,11 +65,15 @@ void BBox::Shutdown()
   s_bbox_uav.reset();
 }
 
+bool BBox::IsActive()
+{
+  return g_ActiveConfig.backend_info.bSupportsBBox && BoundingBox::active &&
+    g_ActiveConfig.iBBoxMode == BBoxGPU;
+}
+
 void BBox::Update()
 {
-  if (g_ActiveConfig.backend_info.bSupportsBBox
-    && BoundingBox::active
-    && g_ActiveConfig.iBBoxMode == BBoxGPU)
+  if (IsActive())
   {
     if (s_cpu_dirty)
     {
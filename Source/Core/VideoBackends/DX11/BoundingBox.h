@@ -15,6 +15,8 @@ public:
   static void Shutdown();
 
   static void Update();
+  // Whether draws write the bounding box.
+  static bool IsActive();
   static void Set(s32 index, s32 value);
   static s32 Get(s32 index);
 };
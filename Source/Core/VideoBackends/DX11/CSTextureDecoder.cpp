@@ -228,7 +228,7 @@ uint4 DecodeCmpr( uint2 st ) {
 		// transparent case
 		uint3 result = (idx&1) ? c1 : c0;
 		if( idx == 2 ) {
-			result = (c0+c1)>>1;
+			result = (c0+c1+1)>>1;
 		}
 		return uint4(result,idx==3 ? 0 : 255);
 	} else {
@@ -438,7 +438,7 @@ const bool DecFuncSupported[] = {
     false,//
     false,//
     false,//
-    false,//GX_TF_CMPR   = 0xE,
+    true,//GX_TF_CMPR   = 0xE,
     false,//
 };
 
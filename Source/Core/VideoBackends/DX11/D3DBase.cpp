@@ -16,6 +16,7 @@
 
 #include "VideoBackends/DX11/D3DPtr.h"
 #include "VideoBackends/DX11/D3DBase.h"
+#include "VideoBackends/DX11/D3DDrawRecorder.h"
 #include "VideoBackends/DX11/D3DTexture.h"
 #include "VideoBackends/DX11/D3DState.h"
 
@@ -40,7 +41,7 @@ namespace D3D
 const DXGI_FORMAT DXGI_BaseFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
 ID3D11Device* device = nullptr;
 ID3D11Device1* device1 = nullptr;
-ID3D11DeviceContext* context;
+ImmediateContext context;
 ID3D11DeviceContext1* context1;
 IDXGISwapChain* swapchain = nullptr;
 D3D_FEATURE_LEVEL featlevel;
@@ -393,6 +394,15 @@ HRESULT Create(HWND wnd)
   hr = factory->MakeWindowAssociation(wnd, DXGI_MWA_NO_WINDOW_CHANGES);
   if (FAILED(hr)) MessageBox(wnd, _T("Failed to associate the window"), _T("Dolphin Direct3D 11 backend"), MB_OK | MB_ICONERROR);
 
+  // In the low latency mode, don't let the driver queue up frames ahead of the display. The
+  // blit swap chain can't do mailbox style presentation, so this is the part that applies here.
+  IDXGIDevice1* dxgi_device = nullptr;
+  if (SUCCEEDED(device->QueryInterface(__uuidof(IDXGIDevice1), (void**)&dxgi_device)))
+  {
+    dxgi_device->SetMaximumFrameLatency(g_ActiveConfig.bLowLatency ? 1 : 3);
+    SAFE_RELEASE(dxgi_device);
+  }
+
   SetDebugObjectName(context, "device context");
   SAFE_RELEASE(factory);
   SAFE_RELEASE(output);
@@ -466,7 +476,9 @@ HRESULT Create(HWND wnd)
   device->CheckFormatSupport(DXGI_FORMAT_R32G32B32A32_FLOAT, &format_support);
   g_Config.backend_info.bSupportedFormats[PC_TEX_FMT_RGBA_FLOAT] = (format_support & D3D11_FORMAT_SUPPORT_TEXTURE2D) != 0;
   UpdateActiveConfig();
-  stateman = new StateManager;
+  stateman = new StateManager(context.GetWithoutRecordedDraws(), context1);
+  if (g_ActiveConfig.bBackendMultithreading)
+    draw_recorder = DrawRecorder::Create();
   return S_OK;
 }
 
@@ -476,6 +488,7 @@ void Close()
   swapchain->SetFullscreenState(false, nullptr);
 
   // release all bound resources
+  draw_recorder.reset();
   context->ClearState();
   SAFE_RELEASE(backbuf);
   SAFE_RELEASE(swapchain);
@@ -7,6 +7,7 @@
 #include <d3d11_2.h>
 #include <d3dcompiler.h>
 #include <dxgi1_5.h>
+#include <cstddef>
 #include <vector>
 
 #include "Common/Common.h"
@@ -37,9 +38,41 @@ std::vector<DXGI_SAMPLE_DESC> EnumAAModes(IDXGIAdapter* adapter);
 HRESULT Create(HWND wnd);
 void Close();
 
+// Executes the draws the DrawRecorder recorded on its deferred context.
+void ExecuteRecordedDraws();
+
+// The immediate context. Draws recorded on another thread are executed before it's used, so the
+// code using it doesn't have to know about them. Setting state doesn't need to wait for them, the
+// command lists restore the state of the immediate context after executing.
+class ImmediateContext
+{
+public:
+  ID3D11DeviceContext* operator->() const { return Get(); }
+  ID3D11DeviceContext* Get() const
+  {
+    if (m_recorded_draws)
+      ExecuteRecordedDraws();
+    return m_context;
+  }
+  // For setting state and mapping streamed buffers without overwriting, which the recorded draws
+  // can be executed after.
+  ID3D11DeviceContext* GetWithoutRecordedDraws() const { return m_context; }
+  void SetRecordedDraws(bool recorded_draws) { m_recorded_draws = recorded_draws; }
+
+  // Helpers to keep the wrapper transparent to the code creating and releasing the context.
+  ID3D11DeviceContext** operator&() { return &m_context; }
+  void operator=(std::nullptr_t) { m_context = nullptr; }
+  explicit operator bool() const { return m_context != nullptr; }
+  operator ID3D11DeviceChild*() const { return m_context; }
+
+private:
+  ID3D11DeviceContext* m_context = nullptr;
+  bool m_recorded_draws = false;
+};
+
 extern ID3D11Device* device;
 extern ID3D11Device1* device1;
-extern ID3D11DeviceContext* context;
+extern ImmediateContext context;
 extern ID3D11DeviceContext1* context1;
 extern HWND hWnd;
 extern bool bFrameInProgress;
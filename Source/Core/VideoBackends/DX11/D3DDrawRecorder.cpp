@@ -0,0 +1,249 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/DX11/D3DDrawRecorder.h"
+
+#include <cstring>
+
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+namespace DX11
+{
+
+namespace D3D
+{
+
+std::unique_ptr<DrawRecorder> draw_recorder;
+
+void ExecuteRecordedDraws()
+{
+  if (draw_recorder)
+    draw_recorder->ExecuteDraws();
+}
+
+template <typename F>
+static void ForEachObject(const StateManager::DrawState& state, F function)
+{
+  const StateManager::Resources& resources = state.resources;
+  IUnknown* objects[] = {
+    resources.pixelConstants[0], resources.pixelConstants[1], resources.vertexConstants,
+    resources.geometryConstants, resources.hulldomainConstants[0],
+    resources.hulldomainConstants[1], resources.hulldomainConstants[2], resources.vertexBuffer,
+    resources.indexBuffer, resources.inputLayout, resources.pixelShader, resources.vertexShader,
+    resources.geometryShader, resources.hullShader, resources.domainShader, state.blendState,
+    state.depthState, state.rasterizerState};
+  for (IUnknown* object : objects)
+  {
+    if (object)
+      function(object);
+  }
+  for (ID3D11ShaderResourceView* texture : resources.textures)
+  {
+    if (texture)
+      function(texture);
+  }
+  for (ID3D11SamplerState* sampler : resources.samplers)
+  {
+    if (sampler)
+      function(sampler);
+  }
+}
+
+std::unique_ptr<DrawRecorder> DrawRecorder::Create()
+{
+  // Without partial constant buffer updates, every draw discards the constant buffers, which has
+  // to wait for the recorded draws.
+  if (!SupportPartialContantBufferUpdate())
+    return nullptr;
+
+  ID3D11DeviceContext* deferred_context;
+  HRESULT hr = device->CreateDeferredContext(0, &deferred_context);
+  if (FAILED(hr))
+  {
+    ERROR_LOG(VIDEO, "Failed to create deferred context (hr=%08X), drawing on the GPU thread", hr);
+    return nullptr;
+  }
+  ID3D11DeviceContext1* deferred_context1;
+  hr = deferred_context->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&deferred_context1);
+  if (FAILED(hr))
+  {
+    deferred_context->Release();
+    return nullptr;
+  }
+  SetDebugObjectName(deferred_context, "draw recording context");
+
+  return std::unique_ptr<DrawRecorder>(new DrawRecorder(deferred_context, deferred_context1));
+}
+
+DrawRecorder::DrawRecorder(ID3D11DeviceContext* context, ID3D11DeviceContext1* context1)
+  : m_context(context), m_context1(context1)
+{
+  m_open_batch.reserve(DRAWS_PER_BATCH);
+  m_thread = std::thread(&DrawRecorder::WorkerThread, this);
+}
+
+DrawRecorder::~DrawRecorder()
+{
+  ExecuteDraws();
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_exit = true;
+  }
+  m_work_cv.notify_one();
+  m_thread.join();
+
+  m_context1->Release();
+  m_context->Release();
+}
+
+void DrawRecorder::RecordDraw(const StateManager::DrawState& state, u32 index_count,
+  u32 start_index, s32 base_vertex)
+{
+  RecordedDraw draw = {};
+  draw.state = state;
+  ForEachObject(draw.state, [](IUnknown* object) { object->AddRef(); });
+
+  // Reading the state of the immediate context doesn't have to wait for the recorded draws.
+  ID3D11DeviceContext* immediate_context = context.GetWithoutRecordedDraws();
+  immediate_context->OMGetRenderTargets(1, &draw.render_target, &draw.depth_stencil);
+  UINT count = 1;
+  immediate_context->RSGetViewports(&count, &draw.viewport);
+  count = 1;
+  immediate_context->RSGetScissorRects(&count, &draw.scissor);
+  draw.index_count = index_count;
+  draw.start_index = start_index;
+  draw.base_vertex = base_vertex;
+
+  m_open_batch.push_back(draw);
+  context.SetRecordedDraws(true);
+
+  if (m_open_batch.size() >= DRAWS_PER_BATCH)
+    SubmitBatch();
+  ExecuteFinishedCommandLists();
+}
+
+void DrawRecorder::ExecuteDraws()
+{
+  if (!m_open_batch.empty())
+    SubmitBatch();
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this] { return m_batches_in_flight == 0; });
+  }
+  ExecuteFinishedCommandLists();
+  context.SetRecordedDraws(false);
+}
+
+void DrawRecorder::SubmitBatch()
+{
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_submitted_batches.push_back(std::move(m_open_batch));
+    m_batches_in_flight++;
+    if (!m_free_batches.empty())
+    {
+      m_open_batch = std::move(m_free_batches.back());
+      m_free_batches.pop_back();
+    }
+  }
+  m_open_batch.clear();
+  m_work_cv.notify_one();
+}
+
+void DrawRecorder::ExecuteFinishedCommandLists()
+{
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::swap(m_finished_lists, m_executing_lists);
+  }
+
+  // The command lists restore the state of the immediate context, which the state manager keeps
+  // track of.
+  ID3D11DeviceContext* immediate_context = context.GetWithoutRecordedDraws();
+  for (ID3D11CommandList* command_list : m_executing_lists)
+  {
+    if (!command_list)
+      continue;
+    immediate_context->ExecuteCommandList(command_list, TRUE);
+    command_list->Release();
+  }
+  m_executing_lists.clear();
+}
+
+void DrawRecorder::WorkerThread()
+{
+  Common::SetCurrentThreadName("DX11 draw recording thread");
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_work_cv.wait(lock, [this] { return m_exit || !m_submitted_batches.empty(); });
+    if (m_submitted_batches.empty())
+      return;
+
+    Batch batch = std::move(m_submitted_batches.front());
+    m_submitted_batches.pop_front();
+    lock.unlock();
+
+    ID3D11CommandList* command_list = RecordBatch(batch);
+    batch.clear();
+
+    lock.lock();
+    m_finished_lists.push_back(command_list);
+    m_free_batches.push_back(std::move(batch));
+    m_batches_in_flight--;
+    m_done_cv.notify_one();
+  }
+}
+
+ID3D11CommandList* DrawRecorder::RecordBatch(const Batch& batch)
+{
+  // Every command list starts with the default state of the deferred context.
+  StateManager state_manager(m_context, m_context1);
+  const RecordedDraw* previous = nullptr;
+  for (const RecordedDraw& draw : batch)
+  {
+    state_manager.SetDrawState(draw.state);
+    state_manager.Apply();
+
+    if (!previous || draw.render_target != previous->render_target ||
+      draw.depth_stencil != previous->depth_stencil)
+    {
+      m_context->OMSetRenderTargets(1, &draw.render_target, draw.depth_stencil);
+    }
+    if (!previous || std::memcmp(&draw.viewport, &previous->viewport, sizeof(draw.viewport)))
+      m_context->RSSetViewports(1, &draw.viewport);
+    if (!previous || std::memcmp(&draw.scissor, &previous->scissor, sizeof(draw.scissor)))
+      m_context->RSSetScissorRects(1, &draw.scissor);
+
+    m_context->DrawIndexed(draw.index_count, draw.start_index, draw.base_vertex);
+    previous = &draw;
+  }
+
+  ID3D11CommandList* command_list = nullptr;
+  HRESULT hr = m_context->FinishCommandList(FALSE, &command_list);
+  if (FAILED(hr))
+  {
+    ERROR_LOG(VIDEO, "Failed to finish recorded draws (hr=%08X)", hr);
+    command_list = nullptr;
+  }
+
+  // The command list holds its own references now.
+  for (const RecordedDraw& draw : batch)
+  {
+    ForEachObject(draw.state, [](IUnknown* object) { object->Release(); });
+    if (draw.render_target)
+      draw.render_target->Release();
+    if (draw.depth_stencil)
+      draw.depth_stencil->Release();
+  }
+
+  return command_list;
+}
+
+}  // namespace D3D
+
+}  // namespace DX11
@@ -0,0 +1,88 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/DX11/D3DBase.h"
+#include "VideoBackends/DX11/D3DState.h"
+
+namespace DX11
+{
+
+namespace D3D
+{
+
+// Records the draws of the vertex manager on a deferred context on a worker thread, so the GPU
+// thread only has to load the vertices and look up the shaders and states. The command lists are
+// executed on the immediate context in the order they were recorded, whenever a batch is done and
+// before anything else uses the immediate context.
+class DrawRecorder
+{
+public:
+  // Returns null if the device can't record draws without waiting for them on every draw.
+  static std::unique_ptr<DrawRecorder> Create();
+  ~DrawRecorder();
+
+  // Records a draw with the given state and the render targets, viewport and scissor rectangle
+  // currently set on the immediate context.
+  void RecordDraw(const StateManager::DrawState& state, u32 index_count, u32 start_index,
+    s32 base_vertex);
+  // Waits for the worker thread and executes all recorded draws on the immediate context.
+  void ExecuteDraws();
+
+private:
+  static constexpr size_t DRAWS_PER_BATCH = 64;
+
+  struct RecordedDraw
+  {
+    // The objects are referenced until the worker thread recorded the draw.
+    StateManager::DrawState state;
+    ID3D11RenderTargetView* render_target;
+    ID3D11DepthStencilView* depth_stencil;
+    D3D11_VIEWPORT viewport;
+    D3D11_RECT scissor;
+    u32 index_count;
+    u32 start_index;
+    s32 base_vertex;
+  };
+  using Batch = std::vector<RecordedDraw>;
+
+  DrawRecorder(ID3D11DeviceContext* context, ID3D11DeviceContext1* context1);
+
+  void SubmitBatch();
+  void ExecuteFinishedCommandLists();
+  void WorkerThread();
+  ID3D11CommandList* RecordBatch(const Batch& batch);
+
+  ID3D11DeviceContext* m_context;
+  ID3D11DeviceContext1* m_context1;
+
+  // Only used by the GPU thread.
+  Batch m_open_batch;
+  std::vector<ID3D11CommandList*> m_executing_lists;
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  std::deque<Batch> m_submitted_batches;
+  std::vector<Batch> m_free_batches;
+  std::vector<ID3D11CommandList*> m_finished_lists;
+  size_t m_batches_in_flight = 0;
+  bool m_exit = false;
+};
+
+extern std::unique_ptr<DrawRecorder> draw_recorder;
+
+}  // namespace D3D
+
+}  // namespace DX11
@@ -170,6 +170,7 @@ using SrvPtr = UniquePtr<ID3D11ShaderResourceView>;
 using UavPtr = UniquePtr<ID3D11UnorderedAccessView>;
 using Texture1dPtr = UniquePtr<ID3D11Texture1D>;
 using Texture2dPtr = UniquePtr<ID3D11Texture2D>;
+using QueryPtr = UniquePtr<ID3D11Query>;
 using RtvPtr = UniquePtr<ID3D11RenderTargetView>;
 using DsvPtr = UniquePtr<ID3D11DepthStencilView>;
 using ClkPtr = UniquePtr<ID3D11ClassLinkage>;
@@ -67,6 +67,7 @@ ComputeShaderPtr CompileAndCreateComputeShader(
   const D3D_SHADER_MACRO* pDefines = nullptr,
   const char* pEntry = nullptr);
 
+ID3D11PixelShader* CreatePixelShaderFromByteCodePtr(const void* bytecode, size_t len);
 ID3D11PixelShader* CompileAndCreatePixelShaderPtr(const std::string& code, const D3D_SHADER_MACRO* pDefines, const char* pEntry);
 
 inline VertexShaderPtr CreateVertexShaderFromByteCode(D3DBlob& bytecode)
@@ -37,11 +37,13 @@ template<typename T> AutoState<T>::~AutoState()
   state = nullptr;
 }
 
-StateManager::StateManager()
+StateManager::StateManager(ID3D11DeviceContext* context, ID3D11DeviceContext1* context1)
   : m_currentBlendState(nullptr)
   , m_currentDepthState(nullptr)
   , m_currentRasterizerState(nullptr)
   , m_dirtyFlags(~0u)
+  , m_context(context)
+  , m_context1(context1)
   , m_pending()
   , m_current()
 {
@@ -80,7 +82,7 @@ void StateManager::Apply()
     if (m_currentBlendState != m_blendStates.top().get())
     {
       m_currentBlendState = (ID3D11BlendState*)m_blendStates.top().get();
-      D3D::context->OMSetBlendState(m_currentBlendState, nullptr, 0xFFFFFFFF);
+      m_context->OMSetBlendState(m_currentBlendState, nullptr, 0xFFFFFFFF);
     }
   }
   else ERROR_LOG(VIDEO, "Tried to apply without blend state!");
@@ -90,7 +92,7 @@ void StateManager::Apply()
     if (m_currentDepthState != m_depthStates.top().get())
     {
       m_currentDepthState = (ID3D11DepthStencilState*)m_depthStates.top().get();
-      D3D::context->OMSetDepthStencilState(m_currentDepthState, 0);
+      m_context->OMSetDepthStencilState(m_currentDepthState, 0);
     }
   }
   else ERROR_LOG(VIDEO, "Tried to apply without depth state!");
@@ -100,7 +102,7 @@ void StateManager::Apply()
     if (m_currentRasterizerState != m_rasterizerStates.top().get())
     {
       m_currentRasterizerState = (ID3D11RasterizerState*)m_rasterizerStates.top().get();
-      D3D::context->RSSetState(m_currentRasterizerState);
+      m_context->RSSetState(m_currentRasterizerState);
     }
   }
   else ERROR_LOG(VIDEO, "Tried to apply without rasterizer state!");
@@ -118,11 +120,11 @@ void StateManager::Apply()
       {
         if (m_pending.pixelConstantsSize[0] == 0 && m_pending.pixelConstantsSize[1] == 0)
         {
-          D3D::context->PSSetConstantBuffers(0, m_pending.pixelConstants[1] ? 2 : 1, m_pending.pixelConstants);
+          m_context->PSSetConstantBuffers(0, m_pending.pixelConstants[1] ? 2 : 1, m_pending.pixelConstants);
         }
         else
         {
-          D3D::context1->PSSetConstantBuffers1(0, m_pending.pixelConstants[1] ? 2 : 1, m_pending.pixelConstants, m_pending.pixelConstantsOffset, m_pending.pixelConstantsSize);
+          m_context1->PSSetConstantBuffers1(0, m_pending.pixelConstants[1] ? 2 : 1, m_pending.pixelConstants, m_pending.pixelConstantsOffset, m_pending.pixelConstantsSize);
         }
         m_current.pixelConstants[0] = m_pending.pixelConstants[0];
         m_current.pixelConstantsOffset[0] = m_pending.pixelConstantsOffset[0];
@@ -135,11 +137,11 @@ void StateManager::Apply()
       {
         if (m_pending.vertexConstantsSize == 0)
         {
-          D3D::context->VSSetConstantBuffers(0, 1, &m_pending.vertexConstants);
+          m_context->VSSetConstantBuffers(0, 1, &m_pending.vertexConstants);
         }
         else
         {
-          D3D::context1->VSSetConstantBuffers1(0, 1, &m_pending.vertexConstants, &m_pending.vertexConstantsOffset, &m_pending.vertexConstantsSize);
+          m_context1->VSSetConstantBuffers1(0, 1, &m_pending.vertexConstants, &m_pending.vertexConstantsOffset, &m_pending.vertexConstantsSize);
         }
         m_current.vertexConstants = m_pending.vertexConstants;
         m_current.vertexConstantsOffset = m_pending.vertexConstantsOffset;
@@ -149,11 +151,11 @@ void StateManager::Apply()
       {
         if (m_pending.geometryConstantsSize == 0)
         {
-          D3D::context->GSSetConstantBuffers(0, 1, &m_pending.geometryConstants);
+          m_context->GSSetConstantBuffers(0, 1, &m_pending.geometryConstants);
         }
         else
         {
-          D3D::context1->GSSetConstantBuffers1(0, 1, &m_pending.geometryConstants, &m_pending.geometryConstantsOffset, &m_pending.geometryConstantsSize);
+          m_context1->GSSetConstantBuffers1(0, 1, &m_pending.geometryConstants, &m_pending.geometryConstantsOffset, &m_pending.geometryConstantsSize);
         }
         m_current.geometryConstants = m_pending.geometryConstants;
         m_current.geometryConstantsOffset = m_pending.geometryConstantsOffset;
@@ -165,13 +167,13 @@ void StateManager::Apply()
         {
           if (m_pending.hulldomainConstantsSize == 0)
           {
-            D3D::context->HSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
-            D3D::context->DSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
+            m_context->HSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
+            m_context->DSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
           }
           else
           {
-            D3D::context1->HSSetConstantBuffers1(0, 3, m_pending.hulldomainConstants, m_pending.hulldomainConstantsOffset, m_pending.hulldomainConstantsSize);
-            D3D::context1->DSSetConstantBuffers1(0, 3, m_pending.hulldomainConstants, m_pending.hulldomainConstantsOffset, m_pending.hulldomainConstantsSize);
+            m_context1->HSSetConstantBuffers1(0, 3, m_pending.hulldomainConstants, m_pending.hulldomainConstantsOffset, m_pending.hulldomainConstantsSize);
+            m_context1->DSSetConstantBuffers1(0, 3, m_pending.hulldomainConstants, m_pending.hulldomainConstantsOffset, m_pending.hulldomainConstantsSize);
           }
         }
         m_current.hulldomainConstants[0] = m_pending.hulldomainConstants[0];
@@ -189,26 +191,26 @@ void StateManager::Apply()
     {
       if (m_dirtyFlags & DirtyFlag_PixelConstants)
       {
-        D3D::context->PSSetConstantBuffers(0, m_pending.pixelConstants[1] ? 2 : 1, m_pending.pixelConstants);
+        m_context->PSSetConstantBuffers(0, m_pending.pixelConstants[1] ? 2 : 1, m_pending.pixelConstants);
         m_current.pixelConstants[0] = m_pending.pixelConstants[0];
         m_current.pixelConstants[1] = m_pending.pixelConstants[1];
       }
       if (m_dirtyFlags & DirtyFlag_VertexConstants)
       {
-        D3D::context->VSSetConstantBuffers(0, 1, &m_pending.vertexConstants);
+        m_context->VSSetConstantBuffers(0, 1, &m_pending.vertexConstants);
         m_current.vertexConstants = m_pending.vertexConstants;
       }
       if (m_dirtyFlags & DirtyFlag_GeometryConstants)
       {
-        D3D::context->GSSetConstantBuffers(0, 1, &m_pending.geometryConstants);
+        m_context->GSSetConstantBuffers(0, 1, &m_pending.geometryConstants);
         m_current.geometryConstants = m_pending.geometryConstants;
       }
       if (m_dirtyFlags & DirtyFlag_HullDomainConstants)
       {
         if (g_ActiveConfig.backend_info.bSupportsTessellation)
         {
-          D3D::context->HSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
-          D3D::context->DSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
+          m_context->HSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
+          m_context->DSSetConstantBuffers(0, 3, m_pending.hulldomainConstants);
         }
         m_current.hulldomainConstants[0] = m_pending.hulldomainConstants[0];
         m_current.hulldomainConstants[1] = m_pending.hulldomainConstants[1];
@@ -221,7 +223,7 @@ void StateManager::Apply()
   {
     if (m_dirtyFlags & DirtyFlag_VertexBuffer)
     {
-      D3D::context->IASetVertexBuffers(0, 1, &m_pending.vertexBuffer, &m_pending.vertexBufferStride, &m_pending.vertexBufferOffset);
+      m_context->IASetVertexBuffers(0, 1, &m_pending.vertexBuffer, &m_pending.vertexBufferStride, &m_pending.vertexBufferOffset);
       m_current.vertexBuffer = m_pending.vertexBuffer;
       m_current.vertexBufferStride = m_pending.vertexBufferStride;
       m_current.vertexBufferOffset = m_pending.vertexBufferOffset;
@@ -229,19 +231,19 @@ void StateManager::Apply()
 
     if (m_dirtyFlags & DirtyFlag_IndexBuffer)
     {
-      D3D::context->IASetIndexBuffer(m_pending.indexBuffer, DXGI_FORMAT_R16_UINT, 0);
+      m_context->IASetIndexBuffer(m_pending.indexBuffer, DXGI_FORMAT_R16_UINT, 0);
       m_current.indexBuffer = m_pending.indexBuffer;
     }
 
     if (m_current.topology != m_pending.topology)
     {
-      D3D::context->IASetPrimitiveTopology(m_pending.topology);
+      m_context->IASetPrimitiveTopology(m_pending.topology);
       m_current.topology = m_pending.topology;
     }
 
     if (m_current.inputLayout != m_pending.inputLayout)
     {
-      D3D::context->IASetInputLayout(m_pending.inputLayout);
+      m_context->IASetInputLayout(m_pending.inputLayout);
       m_current.inputLayout = m_pending.inputLayout;
     }
   }
@@ -252,8 +254,8 @@ void StateManager::Apply()
     {
       unsigned long index;
       _BitScanForward64(&index, dirty_elements);
-      D3D::context->PSSetShaderResources(index, 1, &m_pending.textures[index]);
-      D3D::context->DSSetShaderResources(index, 1, &m_pending.textures[index]);
+      m_context->PSSetShaderResources(index, 1, &m_pending.textures[index]);
+      m_context->DSSetShaderResources(index, 1, &m_pending.textures[index]);
       m_current.textures[index] = m_pending.textures[index];
       dirty_elements &= ~(1ull << index);
     }
@@ -265,8 +267,8 @@ void StateManager::Apply()
     {
       unsigned long index;
       _BitScanForward64(&index, dirty_elements);
-      D3D::context->PSSetSamplers(index, 1, &m_pending.samplers[index]);
-      D3D::context->DSSetSamplers(index, 1, &m_pending.samplers[index]);
+      m_context->PSSetSamplers(index, 1, &m_pending.samplers[index]);
+      m_context->DSSetSamplers(index, 1, &m_pending.samplers[index]);
       m_current.samplers[index] = m_pending.samplers[index];
       dirty_elements &= ~(1 << index);
     }
@@ -276,32 +278,32 @@ void StateManager::Apply()
   {
     if (m_current.pixelShader != m_pending.pixelShader)
     {
-      D3D::context->PSSetShader(m_pending.pixelShader, nullptr, 0);
+      m_context->PSSetShader(m_pending.pixelShader, nullptr, 0);
       m_current.pixelShader = m_pending.pixelShader;
     }
 
     if (m_current.vertexShader != m_pending.vertexShader)
     {
-      D3D::context->VSSetShader(m_pending.vertexShader, nullptr, 0);
+      m_context->VSSetShader(m_pending.vertexShader, nullptr, 0);
       m_current.vertexShader = m_pending.vertexShader;
     }
 
     if (m_current.geometryShader != m_pending.geometryShader)
     {
-      D3D::context->GSSetShader(m_pending.geometryShader, nullptr, 0);
+      m_context->GSSetShader(m_pending.geometryShader, nullptr, 0);
       m_current.geometryShader = m_pending.geometryShader;
     }
     if (g_ActiveConfig.backend_info.bSupportsTessellation)
     {
       if (m_current.hullShader != m_pending.hullShader)
       {
-        D3D::context->HSSetShader(m_pending.hullShader, nullptr, 0);
+        m_context->HSSetShader(m_pending.hullShader, nullptr, 0);
         m_current.hullShader = m_pending.hullShader;
       }
 
       if (m_current.domainShader != m_pending.domainShader)
       {
-        D3D::context->DSSetShader(m_pending.domainShader, nullptr, 0);
+        m_context->DSSetShader(m_pending.domainShader, nullptr, 0);
         m_current.domainShader = m_pending.domainShader;
       }
     }
@@ -310,6 +312,72 @@ void StateManager::Apply()
   m_dirtyFlags = 0;
 }
 
+StateManager::DrawState StateManager::GetDrawState() const
+{
+  DrawState state;
+  state.resources = m_pending;
+  state.blendState =
+    m_blendStates.empty() ? nullptr : (ID3D11BlendState*)m_blendStates.top().get();
+  state.depthState =
+    m_depthStates.empty() ? nullptr : (ID3D11DepthStencilState*)m_depthStates.top().get();
+  state.rasterizerState = m_rasterizerStates.empty() ?
+    nullptr : (ID3D11RasterizerState*)m_rasterizerStates.top().get();
+  return state;
+}
+
+template<typename T> static void ReplaceState(std::stack<AutoState<T>>& states, const T* state)
+{
+  if (!states.empty() && states.top().get() == state)
+    return;
+  if (!states.empty())
+    states.pop();
+  if (state)
+    states.push(AutoState<T>(state));
+}
+
+void StateManager::SetDrawState(const DrawState& state)
+{
+  const Resources& resources = state.resources;
+  for (u32 index = 0; index < 16; ++index)
+  {
+    SetTexture(index, resources.textures[index]);
+    SetSampler(index, resources.samplers[index]);
+  }
+  for (u32 index = 0; index < 2; ++index)
+  {
+    BufferDescriptor buffer(resources.pixelConstants[index],
+      resources.pixelConstantsOffset[index], resources.pixelConstantsSize[index]);
+    SetPixelConstants(index, buffer);
+  }
+  BufferDescriptor vertex_buffer(resources.vertexConstants, resources.vertexConstantsOffset,
+    resources.vertexConstantsSize);
+  SetVertexConstants(vertex_buffer);
+  BufferDescriptor geometry_buffer(resources.geometryConstants,
+    resources.geometryConstantsOffset, resources.geometryConstantsSize);
+  SetGeometryConstants(geometry_buffer);
+  for (u32 index = 0; index < 3; ++index)
+  {
+    BufferDescriptor buffer(resources.hulldomainConstants[index],
+      resources.hulldomainConstantsOffset[index], resources.hulldomainConstantsSize[index]);
+    SetHullDomainConstants(index, buffer);
+  }
+
+  SetVertexBuffer(resources.vertexBuffer, resources.vertexBufferStride,
+    resources.vertexBufferOffset);
+  SetIndexBuffer(resources.indexBuffer);
+  SetPrimitiveTopology(resources.topology);
+  SetInputLayout(resources.inputLayout);
+  SetPixelShader(resources.pixelShader);
+  SetVertexShader(resources.vertexShader);
+  SetGeometryShader(resources.geometryShader);
+  SetHullShader(resources.hullShader);
+  SetDomainShader(resources.domainShader);
+
+  ReplaceState(m_blendStates, (const ID3D11BlendState*)state.blendState);
+  ReplaceState(m_depthStates, (const ID3D11DepthStencilState*)state.depthState);
+  ReplaceState(m_rasterizerStates, (const ID3D11RasterizerState*)state.rasterizerState);
+}
+
 u64 StateManager::UnsetTexture(ID3D11ShaderResourceView* srv)
 {
   u64 mask = 0;
@@ -70,7 +70,49 @@ typedef AutoState<ID3D11RasterizerState> AutoRasterizerState;
 class StateManager
 {
 public:
-  StateManager();
+  struct Resources
+  {
+    ID3D11ShaderResourceView* textures[16];
+    ID3D11SamplerState* samplers[16];
+    ID3D11Buffer* pixelConstants[2];
+    UINT pixelConstantsOffset[2];
+    UINT pixelConstantsSize[2];
+    ID3D11Buffer* vertexConstants;
+    UINT vertexConstantsOffset;
+    UINT vertexConstantsSize;
+    ID3D11Buffer* geometryConstants;
+    UINT geometryConstantsOffset;
+    UINT geometryConstantsSize;
+
+    ID3D11Buffer* hulldomainConstants[3];
+    UINT hulldomainConstantsOffset[3];
+    UINT hulldomainConstantsSize[3];
+
+    ID3D11Buffer* vertexBuffer;
+    ID3D11Buffer* indexBuffer;
+    u32 vertexBufferStride;
+    u32 vertexBufferOffset;
+    D3D11_PRIMITIVE_TOPOLOGY topology;
+    ID3D11InputLayout* inputLayout;
+    ID3D11PixelShader* pixelShader;
+    ID3D11VertexShader* vertexShader;
+    ID3D11GeometryShader* geometryShader;
+    ID3D11HullShader* hullShader;
+    ID3D11DomainShader* domainShader;
+  };
+
+  // Everything Apply() sets, for recording a draw on another context.
+  struct DrawState
+  {
+    Resources resources;
+    ID3D11BlendState* blendState;
+    ID3D11DepthStencilState* depthState;
+    ID3D11RasterizerState* rasterizerState;
+  };
+
+  // Applies the state to the given context, which is only used by this state manager or has its
+  // state restored after being used otherwise.
+  StateManager(ID3D11DeviceContext* context, ID3D11DeviceContext1* context1);
   // call any of these to change the affected states
   void PushBlendState(const ID3D11BlendState* state);
   void PushDepthState(const ID3D11DepthStencilState* state);
@@ -225,7 +267,7 @@ public:
 
   void SetPixelShaderDynamic(ID3D11PixelShader* shader, ID3D11ClassInstance * const * classInstances, u32 classInstancesCount)
   {
-    D3D::context->PSSetShader(shader, classInstances, classInstancesCount);
+    m_context->PSSetShader(shader, classInstances, classInstancesCount);
     m_current.pixelShader = shader;
     m_pending.pixelShader = shader;
   }
@@ -269,6 +311,12 @@ public:
   // call this immediately before any drawing operation or to explicitly apply pending resource state changes
   void Apply();
 
+  // The state the next Apply() would set.
+  DrawState GetDrawState() const;
+  // Sets the pending state to one recorded by GetDrawState(), for replaying it on another context.
+  // The blend, depth and rasterizer states replace the current ones instead of being pushed.
+  void SetDrawState(const DrawState& state);
+
 private:
 
   std::stack<AutoBlendState> m_blendStates;
@@ -339,36 +387,9 @@ private:
 
   u64 m_dirtyFlags;
   bool use_partial_buffer_update;
-  struct Resources
-  {
-    ID3D11ShaderResourceView* textures[16];
-    ID3D11SamplerState* samplers[16];
-    ID3D11Buffer* pixelConstants[2];
-    UINT pixelConstantsOffset[2];
-    UINT pixelConstantsSize[2];
-    ID3D11Buffer* vertexConstants;
-    UINT vertexConstantsOffset;
-    UINT vertexConstantsSize;
-    ID3D11Buffer* geometryConstants;
-    UINT geometryConstantsOffset;
-    UINT geometryConstantsSize;
 
-    ID3D11Buffer* hulldomainConstants[3];
-    UINT hulldomainConstantsOffset[3];
-    UINT hulldomainConstantsSize[3];
-
-    ID3D11Buffer* vertexBuffer;
-    ID3D11Buffer* indexBuffer;
-    u32 vertexBufferStride;
-    u32 vertexBufferOffset;
-    D3D11_PRIMITIVE_TOPOLOGY topology;
-    ID3D11InputLayout* inputLayout;
-    ID3D11PixelShader* pixelShader;
-    ID3D11VertexShader* vertexShader;
-    ID3D11GeometryShader* geometryShader;
-    ID3D11HullShader* hullShader;
-    ID3D11DomainShader* domainShader;
-  };
+  ID3D11DeviceContext* m_context;
+  ID3D11DeviceContext1* m_context1;
 
   Resources m_pending;
   Resources m_current;
@@ -125,10 +125,11 @@ void ConstantStreamBuffer::AppendData(void* data, u32 size)
   }
   else
   {
-    context->Map(m_buf, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &map);
+    // Recorded draws use the data before the offset, they don't have to be executed first.
+    context.GetWithoutRecordedDraws()->Map(m_buf, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &map);
   }
   memcpy((u8*)map.pData + m_offset, data, size);
-  context->Unmap(m_buf, 0);
+  context.GetWithoutRecordedDraws()->Unmap(m_buf, 0);
   m_current_size = size;
   m_offset += size;
 }
@@ -278,4 +278,64 @@ void DXTexture::Load(const u8* src, u32 width, u32 height, u32 expanded_width, u
   D3D::ReplaceTexture2D(m_texture->GetTex(), src, width, height, expanded_width, level, layer,
                         m_config.levels, usage, m_texture->GetFormat(), swap_rg, convertrgb565);
 }
+
+bool DXTexture::GenerateMipmaps()
+{
+  DXGI_FORMAT srgb_format;
+  switch (m_texture->GetFormat())
+  {
+  case DXGI_FORMAT_R8G8B8A8_UNORM:
+    srgb_format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+    break;
+  case DXGI_FORMAT_B8G8R8A8_UNORM:
+    srgb_format = DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+    break;
+  default:
+    return false;
+  }
+  UINT support = 0;
+  if (m_config.enviroment || usage != D3D11_USAGE_DEFAULT ||
+      FAILED(D3D::device->CheckFormatSupport(srgb_format, &support)) ||
+      !(support & D3D11_FORMAT_SUPPORT_MIP_AUTOGEN))
+  {
+    return false;
+  }
+
+  // The levels are generated in an sRGB copy, which filters them in linear space.
+  const D3D11_TEXTURE2D_DESC srgb_desc = CD3D11_TEXTURE2D_DESC(
+      srgb_format, m_config.width, m_config.height, m_config.layers, m_config.levels,
+      D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET, D3D11_USAGE_DEFAULT, 0, 1, 0,
+      D3D11_RESOURCE_MISC_GENERATE_MIPS);
+  ID3D11Texture2D* srgb_texture = nullptr;
+  if (FAILED(D3D::device->CreateTexture2D(&srgb_desc, nullptr, &srgb_texture)))
+    return false;
+  const CD3D11_SHADER_RESOURCE_VIEW_DESC srv_desc(D3D11_SRV_DIMENSION_TEXTURE2DARRAY, srgb_format,
+                                                  0, m_config.levels, 0, m_config.layers);
+  ID3D11ShaderResourceView* srgb_srv = nullptr;
+  if (FAILED(D3D::device->CreateShaderResourceView(srgb_texture, &srv_desc, &srgb_srv)))
+  {
+    SAFE_RELEASE(srgb_texture);
+    return false;
+  }
+
+  for (u32 layer = 0; layer < m_config.layers; layer++)
+  {
+    const UINT subresource = D3D11CalcSubresource(0, layer, m_config.levels);
+    D3D::context->CopySubresourceRegion(srgb_texture, subresource, 0, 0, 0, m_texture->GetTex(),
+                                        subresource, nullptr);
+  }
+  D3D::context->GenerateMips(srgb_srv);
+  for (u32 layer = 0; layer < m_config.layers; layer++)
+  {
+    for (u32 level = 1; level < m_config.levels; level++)
+    {
+      const UINT subresource = D3D11CalcSubresource(level, layer, m_config.levels);
+      D3D::context->CopySubresourceRegion(m_texture->GetTex(), subresource, 0, 0, 0, srgb_texture,
+                                          subresource, nullptr);
+    }
+  }
+  SAFE_RELEASE(srgb_srv);
+  SAFE_RELEASE(srgb_texture);
+  return true;
+}
 }  // namespace DX11
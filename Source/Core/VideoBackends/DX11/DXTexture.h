@@ -31,6 +31,7 @@ public:
     const MathUtil::Rectangle<int>& srcrect, u32 srcwidth, u32 srcheight,
     const MathUtil::Rectangle<int>& dstrect, u32 dstwidth, u32 dstheight);
   void Load(const u8* src, u32 width, u32 height, u32 expanded_width, u32 level, u32 layer) override;
+  bool GenerateMipmaps() override;
 
   D3DTexture2D* GetRawTexIdentifier() const;
   uintptr_t GetInternalObject() const override { return reinterpret_cast<uintptr_t>(m_texture); };
@@ -0,0 +1,85 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/DX11/FrameProfiler.h"
+
+#include <algorithm>
+
+#include "VideoBackends/DX11/D3DBase.h"
+
+namespace DX11
+{
+FrameProfiler::FrameProfiler()
+{
+  const D3D11_QUERY_DESC disjoint_desc = CD3D11_QUERY_DESC(D3D11_QUERY_TIMESTAMP_DISJOINT, 0);
+  const D3D11_QUERY_DESC timestamp_desc = CD3D11_QUERY_DESC(D3D11_QUERY_TIMESTAMP, 0);
+  for (FrameQueries& queries : m_frame_queries)
+  {
+    if (FAILED(D3D::device->CreateQuery(&disjoint_desc, D3D::ToAddr(queries.disjoint))))
+      return;
+    queries.timestamps.resize(MAX_TIMESTAMPS);
+    for (D3D::QueryPtr& timestamp : queries.timestamps)
+    {
+      if (FAILED(D3D::device->CreateQuery(&timestamp_desc, D3D::ToAddr(timestamp))))
+        return;
+    }
+  }
+  m_supported = true;
+}
+
+FrameProfiler::~FrameProfiler()
+{
+}
+
+void FrameProfiler::BeginTimestamps(size_t frame)
+{
+  D3D::context->Begin(m_frame_queries[frame].disjoint.get());
+}
+
+void FrameProfiler::WriteTimestamp(size_t frame, u32 index)
+{
+  D3D::context->End(m_frame_queries[frame].timestamps[index].get());
+}
+
+void FrameProfiler::EndTimestamps(size_t frame)
+{
+  D3D::context->End(m_frame_queries[frame].disjoint.get());
+}
+
+bool FrameProfiler::ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns)
+{
+  const FrameQueries& queries = m_frame_queries[frame];
+  D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+  if (D3D::context->GetData(queries.disjoint.get(), &disjoint, sizeof(disjoint),
+                            D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+  {
+    return false;
+  }
+  for (u32 i = 0; i < count; i++)
+  {
+    UINT64 ticks = 0;
+    if (D3D::context->GetData(queries.timestamps[i].get(), &ticks, sizeof(ticks),
+                              D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+    {
+      return false;
+    }
+    timestamps_ns[i] = ticks;
+  }
+
+  // The clock changed its frequency, e.g. because the GPU was throttled.
+  if (disjoint.Disjoint || disjoint.Frequency == 0)
+  {
+    std::fill_n(timestamps_ns, count, 0);
+    return true;
+  }
+
+  const u64 frequency = disjoint.Frequency;
+  for (u32 i = 0; i < count; i++)
+  {
+    const u64 ticks = timestamps_ns[i];
+    timestamps_ns[i] = ticks / frequency * 1000000000 + ticks % frequency * 1000000000 / frequency;
+  }
+  return true;
+}
+}  // namespace DX11
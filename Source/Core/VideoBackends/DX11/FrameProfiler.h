@@ -0,0 +1,40 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "VideoBackends/DX11/D3DPtr.h"
+#include "VideoCommon/FrameProfilerBase.h"
+
+namespace DX11
+{
+// Takes the timestamps of a frame with timestamp queries inside of a disjoint query, which tells
+// their frequency and whether they can be compared.
+class FrameProfiler final : public FrameProfilerBase
+{
+public:
+  FrameProfiler();
+  ~FrameProfiler();
+
+protected:
+  bool SupportsTimestamps() const override { return m_supported; }
+  void BeginTimestamps(size_t frame) override;
+  void WriteTimestamp(size_t frame, u32 index) override;
+  void EndTimestamps(size_t frame) override;
+  bool ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns) override;
+
+private:
+  struct FrameQueries
+  {
+    D3D::QueryPtr disjoint;
+    std::vector<D3D::QueryPtr> timestamps;
+  };
+
+  std::array<FrameQueries, FRAME_COUNT> m_frame_queries;
+  bool m_supported = false;
+};
+}  // namespace DX11
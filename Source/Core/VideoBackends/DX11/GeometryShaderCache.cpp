@@ -6,7 +6,6 @@
 
 #include "Common/Align.h"
 #include "Common/FileUtil.h"
-#include "Common/LinearDiskCache.h"
 #include "Common/StringUtil.h"
 
 #include "Core/ConfigManager.h"
@@ -23,6 +22,7 @@
 #include "VideoCommon/GeometryShaderGen.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/HLSLCompiler.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -38,7 +38,7 @@ static HLSLAsyncCompiler *s_compiler;
 D3D::GeometryShaderPtr ClearGeometryShader;
 D3D::GeometryShaderPtr CopyGeometryShader;
 
-LinearDiskCache<GeometryShaderUid, u8> g_gs_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<GeometryShaderUid, u8> g_gs_disk_cache;
 
 ID3D11GeometryShader* GeometryShaderCache::GetClearGeometryShader()
 {
@@ -326,6 +326,8 @@ void GeometryShaderCache::PrepareShader(
 
 bool GeometryShaderCache::TestShader()
 {
+  ShaderCompileStats::StallTimer stall(!s_last_entry->compiled &&
+                                       !g_ActiveConfig.bFullAsyncShaderCompilation);
   int count = 0;
   while (!s_last_entry->compiled)
   {
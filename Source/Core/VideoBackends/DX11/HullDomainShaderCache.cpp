@@ -6,7 +6,6 @@
 
 #include "Common/Align.h"
 #include "Common/FileUtil.h"
-#include "Common/LinearDiskCache.h"
 #include "Common/StringUtil.h"
 
 #include "Core/ConfigManager.h"
@@ -22,6 +21,7 @@
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/TessellationShaderManager.h"
 #include "VideoCommon/HLSLCompiler.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -36,8 +36,8 @@ static HLSLAsyncCompiler *s_compiler;
 
 std::unique_ptr<D3D::ConstantStreamBuffer> hdscbuf;
 
-LinearDiskCache<TessellationShaderUid, u8> g_hs_disk_cache;
-LinearDiskCache<TessellationShaderUid, u8> g_ds_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<TessellationShaderUid, u8> g_hs_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<TessellationShaderUid, u8> g_ds_disk_cache;
 
 D3D::BufferDescriptor  HullDomainShaderCache::GetConstantBuffer()
 {
@@ -91,13 +91,8 @@ void HullDomainShaderCache::Init()
   if (!File::Exists(File::GetUserPath(D_SHADERCACHE_IDX)))
     File::CreateDir(File::GetUserPath(D_SHADERCACHE_IDX));
 
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  s_hulldomain_shaders = HDCache::Create(
-    gameid,
-    TESSELLATIONSHADERGEN_UID_VERSION,
-    "Ishiiruka.ts",
-    StringFromFormat("%s.ts", SConfig::GetInstance().GetGameID().c_str())
-  );
+  s_hulldomain_shaders = ShaderCacheUtils::CreateUsageProfile<HDCache>(
+    "ts", TESSELLATIONSHADERGEN_UID_VERSION);
 
   std::string h_cache_filename = StringFromFormat("%sIDX11-%s-hs.cache", File::GetUserPath(D_SHADERCACHE_IDX).c_str(),
     SConfig::GetInstance().GetGameID().c_str());
@@ -116,26 +111,36 @@ void HullDomainShaderCache::Init()
   {
     static size_t shader_count;
     shader_count = 0;
-    s_hulldomain_shaders->ForEachMostUsedByCategory(gameid,
-      [&](const TessellationShaderUid& it, size_t total)
+    HLSLAsyncCompiler::ScopedPriority priority(*s_compiler, CompilePriority::Precompile);
+    ShaderCacheUtils::ForEachShaderToPrecompile(s_hulldomain_shaders,
+      [](HDCacheEntry& entry)
+    {
+      return !entry.domainshader;
+    },
+      [&](const TessellationShaderUid& item, size_t total)
     {
-      TessellationShaderUid item = it;
-      item.ClearHASH();
-      item.CalculateUIDHash();
       CompileHDShader(item, [total]() {
         shader_count++;
         Host_UpdateProgressDialog(GetStringT("Compiling Tessellation shaders...").c_str(),
           static_cast<int>(shader_count), static_cast<int>(total * 2));
       });
-      
-    },
+    });
+    s_compiler->WaitForFinish();
+    Host_UpdateProgressDialog("", -1, -1);
+  }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(s_hulldomain_shaders))
+  {
+    // Only the most used shaders, the draws pick them up once the thread pool has compiled them.
+    HLSLAsyncCompiler::ScopedPriority priority(*s_compiler, CompilePriority::Predicted);
+    ShaderCacheUtils::ForEachShaderToPrecompile(s_hulldomain_shaders,
       [](HDCacheEntry& entry)
     {
       return !entry.domainshader;
-    }
-    , true);
-    s_compiler->WaitForFinish();
-    Host_UpdateProgressDialog("", -1, -1);
+    },
+      [](const TessellationShaderUid& item, size_t total)
+    {
+      CompileHDShader(item, {});
+    }, ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT / 2);
   }
   s_last_entry = nullptr;
 }
@@ -145,10 +150,7 @@ void HullDomainShaderCache::Clear()
 {
   if (s_hulldomain_shaders)
   {
-    s_hulldomain_shaders->Persist([](TessellationShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_hulldomain_shaders);
     s_hulldomain_shaders->Clear([](HDCacheEntry& item)
     {
       item.Destroy();
@@ -302,6 +304,8 @@ bool HullDomainShaderCache::TestShader()
   {
     return true;
   }
+  ShaderCompileStats::StallTimer stall(!(s_last_entry->hcompiled && s_last_entry->dcompiled) &&
+                                       !g_ActiveConfig.bFullAsyncShaderCompilation);
   int count = 0;
   while (!(s_last_entry->hcompiled && s_last_entry->dcompiled))
   {
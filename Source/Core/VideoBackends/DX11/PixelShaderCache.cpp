@@ -3,7 +3,6 @@
 // Refer to the license.txt file included.
 
 #include "Common/FileUtil.h"
-#include "Common/LinearDiskCache.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
@@ -18,6 +17,7 @@
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/HLSLCompiler.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoCommon/PixelShaderManager.h"
 
 
@@ -31,11 +31,13 @@ const PixelShaderCache::PSCacheEntry* PixelShaderCache::s_last_entry;
 const PixelShaderCache::PSCacheEntry* PixelShaderCache::s_last_uber_entry;
 PixelShaderUid PixelShaderCache::s_last_uid;
 UberShader::PixelUberShaderUid PixelShaderCache::s_last_uber_uid;
+std::deque<UberShader::PixelUberShaderUid> PixelShaderCache::s_background_uber_uids;
 
 static HLSLAsyncCompiler *s_compiler;
+static ShaderUidTracker s_uid_tracker(SHADER_UID_PIXEL);
 static bool s_previous_per_pixel_lighting = false;
-LinearDiskCache<PixelShaderUid, u8> g_ps_disk_cache;
-LinearDiskCache<UberShader::PixelUberShaderUid, u8> g_pus_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<PixelShaderUid, u8> g_ps_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<UberShader::PixelUberShaderUid, u8> g_pus_disk_cache;
 
 D3D::PixelShaderPtr s_ColorMatrixProgram[2];
 D3D::PixelShaderPtr s_ColorCopyProgram[3];
@@ -522,6 +524,11 @@ void PixelShaderCache::Init()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(s_pixel_shaders) &&
+           !g_ActiveConfig.bDisableSpecializedShaders)
+  {
+    CompileShaders(true);
+  }
   s_last_entry = nullptr;
   s_last_uber_entry = nullptr;
   SETSTAT(stats.numPixelShadersCreated, 0);
@@ -532,10 +539,7 @@ void PixelShaderCache::LoadFromDisk()
 {
   if (s_pixel_shaders)
   {
-    s_pixel_shaders->Persist([](PixelShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_pixel_shaders);
     s_pixel_shaders->Clear([](PSCacheEntry& item)
     {
       item.Destroy();
@@ -546,13 +550,7 @@ void PixelShaderCache::LoadFromDisk()
   for (auto& item : s_pixel_uber_shaders)
     item.second.Destroy();
   s_pixel_uber_shaders.clear();
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  s_pixel_shaders = PSCache::Create(
-    gameid,
-    PIXELSHADERGEN_UID_VERSION,
-    "Ishiiruka.ps",
-    StringFromFormat("%s.ps", SConfig::GetInstance().GetGameID().c_str())
-  );
+  s_pixel_shaders = ShaderCacheUtils::CreateUsageProfile<PSCache>("ps", PIXELSHADERGEN_UID_VERSION);
   std::string cache_filename = GetDiskShaderCacheFileName(API_D3D11, "ups", false, true);
   PixelUberShaderCacheInserter uinserter;
   g_pus_disk_cache.OpenAndRead(cache_filename, uinserter);
@@ -561,17 +559,26 @@ void PixelShaderCache::LoadFromDisk()
   g_ps_disk_cache.OpenAndRead(cache_filename, inserter);
 }
 static size_t shader_count = 0;
-void PixelShaderCache::CompileShaders()
+// In the background only the most used shaders are queued, they are picked up by the draws once
+// the thread pool has compiled them.
+void PixelShaderCache::CompileShaders(bool background)
 {
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler,
+    background ? CompilePriority::Predicted : CompilePriority::Precompile);
   shader_count = 0;
   const ShaderHostConfig& hostconfig = ShaderHostConfig::GetCurrent();
-  s_pixel_shaders->ForEachMostUsedByCategory(gameid,
-    [&](const PixelShaderUid& it, size_t total)
+  ShaderCacheUtils::ForEachShaderToPrecompile(s_pixel_shaders,
+    [](PSCacheEntry& entry)
   {
-    PixelShaderUid item = it;
-    item.ClearHASH();
-    item.CalculateUIDHash();
+    return !entry.shader;
+  },
+    [&](const PixelShaderUid& item, size_t total)
+  {
+    if (background)
+    {
+      CompilePShader(item, hostconfig, false, {});
+      return;
+    }
     CompilePShader(item, hostconfig, true, [total]() {
       shader_count++;
       if ((shader_count & 7) == 0)
@@ -580,35 +587,61 @@ void PixelShaderCache::CompileShaders()
           static_cast<int>(shader_count), static_cast<int>(total));
       }
     });
-
-  },
-    [](PSCacheEntry& entry)
-  {
-    return !entry.shader;
-  }
-  , true);
+  }, background ? ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT : SIZE_MAX);
+  if (background)
+    return;
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
 }
 
+// Only the uber shaders the draws in the usage profile map to are waited for, so those never
+// stutter. The others are left for QueueBackgroundUberShader, or compiled when a draw needs one.
 void PixelShaderCache::CompileUberShaders()
 {
+  std::vector<UberShader::PixelUberShaderUid> used;
+  std::vector<UberShader::PixelUberShaderUid> unused;
+  ShaderCacheUtils::GetUberShadersToPrecompile(
+    s_pixel_shaders,
+    [](const PixelShaderUid& uid) { return UberShader::GetPixelUberShaderUid(uid); },
+    UberShader::EnumeratePixelUberShaderUids, &used, &unused);
+
   const ShaderHostConfig& hostconfig = ShaderHostConfig::GetCurrent();
+  const size_t total = used.size();
   shader_count = 0;
-  UberShader::EnumeratePixelUberShaderUids([&](const UberShader::PixelUberShaderUid& uid, size_t total) {
-    CompileUberShader(uid, hostconfig, [total]() {
+  for (const UberShader::PixelUberShaderUid& uid : used)
+  {
+    CompileUberShader(uid, hostconfig, false, [total]() {
       shader_count++;
       Host_UpdateProgressDialog(GetStringT("Compiling Pixel Uber shaders...").c_str(),
         static_cast<int>(shader_count), static_cast<int>(total));
-
     });
-  });
+  }
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
+
+  s_background_uber_uids.clear();
+  for (const UberShader::PixelUberShaderUid& uid : unused)
+  {
+    auto it = s_pixel_uber_shaders.find(uid);
+    if (it == s_pixel_uber_shaders.end() || !it->second.compiled)
+      s_background_uber_uids.push_back(uid);
+  }
+}
+
+// Queues the next background uber shader whenever the compiler has nothing else waiting, so they
+// never hold up a shader a draw needs.
+void PixelShaderCache::QueueBackgroundUberShader()
+{
+  if (s_background_uber_uids.empty() || s_compiler->HasQueuedUnits())
+    return;
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler, CompilePriority::Predicted);
+  CompileUberShader(s_background_uber_uids.front(), ShaderHostConfig::GetCurrent(), true, {});
+  s_background_uber_uids.pop_front();
 }
 
 void PixelShaderCache::Reload()
 {
+  s_compiler->CancelPendingUnits(CompilePriority::Predicted);
   s_compiler->WaitForFinish();
   g_ps_disk_cache.Sync();
   g_ps_disk_cache.Close();
@@ -623,6 +656,11 @@ void PixelShaderCache::Reload()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(s_pixel_shaders) &&
+           !g_ActiveConfig.bDisableSpecializedShaders)
+  {
+    CompileShaders(true);
+  }
   s_last_entry = nullptr;
   s_last_uber_entry = nullptr;
   s_last_uid.ClearUID();
@@ -633,10 +671,7 @@ void PixelShaderCache::Clear()
 {
   if (s_pixel_shaders)
   {
-    s_pixel_shaders->Persist([](PixelShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_pixel_shaders);
     s_pixel_shaders->Clear([](PSCacheEntry& item)
     {
       item.Destroy();
@@ -664,8 +699,10 @@ void PixelShaderCache::InvalidateMSAAShaders()
 
 void PixelShaderCache::Shutdown()
 {
+  s_background_uber_uids.clear();
   if (s_compiler)
   {
+    s_compiler->CancelPendingUnits(CompilePriority::Predicted);
     s_compiler->WaitForFinish();
   }
   if (pscbuf != nullptr)
@@ -694,19 +731,28 @@ void PixelShaderCache::Shutdown()
   g_pus_disk_cache.Close();
 }
 
-void PixelShaderCache::CompileUberShader(const UberShader::PixelUberShaderUid& uid, const ShaderHostConfig& hostconfig, std::function<void()> oncompilationfinished = {})
+PixelShaderCache::PSCacheEntry* PixelShaderCache::CompileUberShader(const UberShader::PixelUberShaderUid& uid, const ShaderHostConfig& hostconfig, bool background, std::function<void()> oncompilationfinished)
 {
   PSCacheEntry* entry = &s_pixel_uber_shaders[uid];
-  s_last_uber_entry = entry;
   // Compile only when we have a new instance
   if (entry->initialized.test_and_set())
   {
     if (oncompilationfinished) oncompilationfinished();
-    return;
+    return entry;
   }
   // Need to compile a new shader
 
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  if (background)
+  {
+    wunit->priority = &entry->hits;
+    // Compiled again the next time a draw needs it.
+    wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->initialized.clear(); };
+  }
+  else
+  {
+    wunit->priority = &HLSLAsyncCompiler::HIGHEST_PRIORITY;
+  }
   wunit->GenerateCodeHandler = [uid, hostconfig](ShaderCompilerWorkUnit* wunit)
   {
     UberShader::GenPixelShader(wunit->code, API_D3D11, hostconfig, uid.GetUidData());
@@ -754,6 +800,7 @@ void PixelShaderCache::CompileUberShader(const UberShader::PixelUberShaderUid& u
     }
   };
   s_compiler->CompileShaderAsync(wunit);
+  return entry;
 }
 
 void PixelShaderCache::CompilePShader(const PixelShaderUid& uid, const ShaderHostConfig& hostconfig, bool forcecompile = false, std::function<void()> oncompilationfinished = {})
@@ -773,6 +820,9 @@ void PixelShaderCache::CompilePShader(const PixelShaderUid& uid, const ShaderHos
   // Need to compile a new shader
 
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  wunit->priority = &entry->hits;
+  // Compiled again the next time a draw needs it.
+  wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->initialized.clear(); };
   wunit->GenerateCodeHandler = [uid, hostconfig](ShaderCompilerWorkUnit* wunit)
   {
     GeneratePixelShaderCode(wunit->code, uid.GetUidData(), hostconfig);
@@ -827,14 +877,24 @@ void PixelShaderCache::PrepareShader(PIXEL_SHADER_RENDER_MODE render_mode,
   const XFMemory &xfr,
   const BPMemory &bpm)
 {
-  if (g_ActiveConfig.bBackgroundShaderCompiling || g_ActiveConfig.bDisableSpecializedShaders)
+  const bool use_uber_shaders =
+    g_ActiveConfig.bBackgroundShaderCompiling || g_ActiveConfig.bDisableSpecializedShaders;
+  // Nothing the uids depend on changed since the last draw.
+  if (s_uid_tracker.IsUnchanged(components, render_mode) && s_last_entry &&
+    (!use_uber_shaders || s_last_uber_entry))
+  {
+    s_compiler->ProcCompilationResults();
+    return;
+  }
+  if (use_uber_shaders)
   {
     auto uuid = UberShader::GetPixelUberShaderUid(components, xfr, bpm);
     if (!s_last_uber_entry || s_last_uber_uid != uuid)
     {
       s_last_uber_uid = uuid;
-      CompileUberShader(uuid, ShaderHostConfig::GetCurrent());
+      s_last_uber_entry = CompileUberShader(uuid, ShaderHostConfig::GetCurrent(), false, {});
     }
+    QueueBackgroundUberShader();
   }
   PixelShaderUid uid;
   GetPixelShaderUID(uid, render_mode, components, xfr, bpm);
@@ -858,6 +918,11 @@ void PixelShaderCache::SetActiveShader()
   }
   else if (s_last_uber_entry)
   {
+    if (s_last_entry)
+      s_last_entry->hits.fetch_add(1, std::memory_order_relaxed);
+    // Every draw sets a pixel shader, the draws are counted here.
+    if (!g_ActiveConfig.bDisableSpecializedShaders)
+      ShaderCompileStats::AddUberShaderDraw();
     shader = s_last_uber_entry->shader.get();
   }
   D3D::stateman->SetPixelShader(shader);
@@ -869,6 +934,8 @@ bool PixelShaderCache::TestShader()
   {
     return s_last_uber_entry && s_last_uber_entry->compiled;;
   }
+  ShaderCompileStats::StallTimer stall(!s_last_entry->compiled &&
+                                       !g_ActiveConfig.bFullAsyncShaderCompilation);
   int count = 0;
   while (!s_last_entry->compiled)
   {
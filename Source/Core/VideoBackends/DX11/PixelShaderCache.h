@@ -4,6 +4,7 @@
 
 #pragma once
 #include <atomic>
+#include <deque>
 #include <functional>
 #include <unordered_map>
 
@@ -49,9 +50,11 @@ public:
   static void InsertByteCode(const UberShader::PixelUberShaderUid &uid, const void* bytecode, u32 bytecodelen);
 private:
   static void LoadFromDisk();
-  static void CompileShaders();
+  static void CompileShaders(bool background = false);
   static void CompileUberShaders();
-  static void CompileUberShader(const UberShader::PixelUberShaderUid& uid, const ShaderHostConfig& hostconfig, std::function<void()> oncompilationfinished);
+  static void QueueBackgroundUberShader();
+  struct PSCacheEntry;
+  static PSCacheEntry* CompileUberShader(const UberShader::PixelUberShaderUid& uid, const ShaderHostConfig& hostconfig, bool background, std::function<void()> oncompilationfinished);
   static void CompilePShader(const PixelShaderUid& uid, const ShaderHostConfig& hostconfig, bool forcecompile, std::function<void()> oncompilationfinished);
   struct PSCacheEntry
   {
@@ -59,8 +62,10 @@ private:
     D3D::PixelShaderPtr shader;
     bool compiled;
     std::atomic_flag initialized;
+    // Draws that fell back to the ubershader while this one was compiling.
+    std::atomic<u32> hits;
 
-    PSCacheEntry() : compiled(false)
+    PSCacheEntry() : compiled(false), hits(0)
     {
       initialized.clear();
     }
@@ -78,6 +83,8 @@ private:
   static const PSCacheEntry* s_last_uber_entry;
   static PixelShaderUid s_last_uid;
   static UberShader::PixelUberShaderUid s_last_uber_uid;
+  // The uber shaders no game draw of the usage profile needs, compiled one at a time.
+  static std::deque<UberShader::PixelUberShaderUid> s_background_uber_uids;
 };
 
 }  // namespace DX11
@@ -19,6 +19,7 @@
 #include "VideoBackends/DX11/VertexShaderCache.h"
 
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/Statistics.h"
 
 namespace DX11
@@ -152,44 +153,51 @@ uintptr_t D3DPostProcessingShader::CreateBindingSampler(const PostProcessingShad
 
 bool D3DPostProcessingShader::RecompileShaders()
 {
-  static const char *inputs[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8" };
-  static D3D_SHADER_MACRO macros[] = {
-      { "API_D3D", "1" },
-      { "HLSL", "1" },
-      { "COLOR_BUFFER_INPUT_INDEX", 0 },
-      { "DEPTH_BUFFER_INPUT_INDEX", 0 },
-      { "PREV_OUTPUT_INPUT_INDEX", 0 },
-      { nullptr, nullptr }
-  };
-  std::string common_source = PostProcessor::GetCommonFragmentShaderSource(API_D3D11, m_config);
-  for (size_t i = 0; i < m_passes.size(); i++)
-  {
-    RenderPassData& pass = m_passes[i];
-    const PostProcessingShaderConfiguration::RenderPass& pass_config = m_config->GetPass(i);
+  return RecompileShaderBinaries();
+}
 
-    int color_buffer_index = 0;
-    int depth_buffer_index = 0;
-    int prev_output_index = 0;
+static bool CompilePassShaderBinary(const std::string& source, std::vector<u8>* binary)
+{
+  D3DBlob blob;
+  if (!D3D::CompileShader(D3D::ShaderType::Pixel, source, blob, nullptr, "passmain"))
+    return false;
 
-    pass_config.GetInputLocations(color_buffer_index, depth_buffer_index, prev_output_index);
+  binary->assign(blob.Data(), blob.Data() + blob.Size());
+  return true;
+}
 
-    macros[2].Definition = inputs[color_buffer_index];
-    macros[3].Definition = inputs[depth_buffer_index];
-    macros[4].Definition = inputs[prev_output_index];
+PostProcessingShader::ShaderBinaryCompiler D3DPostProcessingShader::GetShaderBinaryCompiler() const
+{
+  return CompilePassShaderBinary;
+}
 
-    std::string hlsl_source = PostProcessor::GetPassFragmentShaderSource(API_D3D11, m_config, &pass_config);
-    ReleasePassNativeResources(pass);
-    ID3D11PixelShader* ptr = D3D::CompileAndCreatePixelShaderPtr(common_source + hlsl_source, macros, "passmain");
-    pass.shader = reinterpret_cast<uintptr_t>(ptr);
-    if (!pass.shader)
-    {
-      ReleasePassNativeResources(pass);
-      ERROR_LOG(VIDEO, "Failed to compile post-processing shader %s (pass %s)", m_config->GetShaderName().c_str(), pass_config.entry_point.c_str());
-      m_ready = false;
-      return false;
-    }
-  }
-  return true;
+std::string D3DPostProcessingShader::GetPassShaderSource(size_t pass_index) const
+{
+  // The input locations are defines in the source, so the binary cache tells the passes apart.
+  static const char* definitions =
+    "#define API_D3D 1\n"
+    "#define HLSL 1\n"
+    "#define COLOR_BUFFER_INPUT_INDEX %i\n"
+    "#define DEPTH_BUFFER_INPUT_INDEX %i\n"
+    "#define PREV_OUTPUT_INPUT_INDEX %i\n";
+
+  const PostProcessingShaderConfiguration::RenderPass& pass_config = m_config->GetPass(pass_index);
+  int color_buffer_index = 0;
+  int depth_buffer_index = 0;
+  int prev_output_index = 0;
+  pass_config.GetInputLocations(color_buffer_index, depth_buffer_index, prev_output_index);
+
+  return StringFromFormat(definitions, color_buffer_index, depth_buffer_index, prev_output_index) +
+    PostProcessor::GetCommonFragmentShaderSource(API_D3D11, m_config) +
+    PostProcessor::GetPassFragmentShaderSource(API_D3D11, m_config, &pass_config);
+}
+
+bool D3DPostProcessingShader::CreatePassShader(RenderPassData& pass, const std::vector<u8>& binary)
+{
+  ReleasePassNativeResources(pass);
+  ID3D11PixelShader* ptr = D3D::CreatePixelShaderFromByteCodePtr(binary.data(), binary.size());
+  pass.shader = reinterpret_cast<uintptr_t>(ptr);
+  return pass.shader != 0;
 }
 
 void D3DPostProcessingShader::MapAndUpdateConfigurationBuffer()
@@ -260,7 +268,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
     D3D::stateman->UnsetTexture(rsrv);
     D3D::stateman->Apply();
     D3D::context->OMSetRenderTargets(1, &rtv, nullptr);
-    std::vector<s32> InputsToRelease;
     // Bind inputs to pipeline
     for (size_t i = 0; i < pass.inputs.size(); i++)
     {
@@ -300,7 +307,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
         }
         else if (input.prev_texture >= 0)
         {
-          InputsToRelease.push_back(input.prev_texture);
           input_srv = reinterpret_cast<D3DTexture2D*>(m_passes[input.prev_texture].GetOutput()->GetInternalObject())->GetSRV();
           input_sizes[i] = m_passes[input.prev_texture].output_size;
         }
@@ -332,10 +338,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
     D3D::drawShadedTexQuad(nullptr, src_rect.AsRECT(), src_size.width, src_size.height,
       reinterpret_cast<ID3D11PixelShader*>(pass.shader), parent->GetVertexShader(), VertexShaderCache::GetSimpleInputLayout(),
       geometry_shader, 1.0f, std::max(src_layer, 0));
-    for (auto passidx : InputsToRelease)
-    {
-      m_passes[passidx].ClenaupOutput();
-    }
   }
 
   // Unbind input textures after rendering, so that they can safely be used as outputs again.
@@ -367,10 +369,6 @@ void D3DPostProcessingShader::Draw(PostProcessor* p,
       parent->CopyTexture(dst, GetPrevColorFrame(0)->GetInternalObject(), output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer, false, true);
     }
     parent->CopyTexture(dst_rect, dst_tex, output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer);
-    if (!IsLastPassScaled())
-    {
-      final_pass.ClenaupOutput();
-    }
   }
 }
 
@@ -414,6 +412,11 @@ bool D3DPostProcessor::CreateUniformBuffer()
   return true;
 }
 
+std::string D3DPostProcessor::GetShaderBinaryCacheFileName() const
+{
+  return GetDiskShaderCacheFileName(API_D3D11, "PP", false, false);
+}
+
 std::unique_ptr<PostProcessingShader> D3DPostProcessor::CreateShader(PostProcessingShaderConfiguration* config)
 {
   std::unique_ptr<PostProcessingShader> shader;
@@ -514,7 +517,9 @@ void D3DPostProcessor::CopyTexture(const TargetRectangle& dst_rect, uintptr_t ds
 
   // If the dimensions are the same, we can copy instead of using a shader.
   bool scaling = (dst_rect.GetWidth() != src_rect.GetWidth() || dst_rect.GetHeight() != src_rect.GetHeight());
-  if (!scaling && !force_shader_copy && !is_depth_texture && dst_texture->GetFormat() == src_texture->GetFormat())
+  // Screen rectangles can start outside of the back buffer, only the draw clips those.
+  bool clipped = dst_rect.left < 0 || dst_rect.top < 0;
+  if (!scaling && !clipped && !force_shader_copy && !is_depth_texture && dst_texture->GetFormat() == src_texture->GetFormat())
   {
     CD3D11_BOX copy_box(src_rect.left, src_rect.top, 0, src_rect.right, src_rect.bottom, 1);
     if (src_layer < 0)
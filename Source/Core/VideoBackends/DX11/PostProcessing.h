@@ -35,6 +35,9 @@ private:
   uintptr_t CreateBindingSampler(const PostProcessingShaderConfiguration::RenderPass::Input& input_config) override;
   void ReleasePassNativeResources(RenderPassData& pass) override;
   bool RecompileShaders() override;
+  ShaderBinaryCompiler GetShaderBinaryCompiler() const override;
+  std::string GetPassShaderSource(size_t pass_index) const override;
+  bool CreatePassShader(RenderPassData& pass, const std::vector<u8>& binary) override;
 };
 
 class D3DPostProcessor final : public PostProcessor
@@ -77,6 +80,13 @@ protected:
   bool CreateUniformBuffer();
 
   std::unique_ptr<PostProcessingShader> CreateShader(PostProcessingShaderConfiguration* config) override;
+  std::string GetShaderBinaryCacheFileName() const override;
+  // Same sized copies to a back buffer of the same format use CopySubresourceRegion, the rest
+  // fall back to the plain copy shader.
+  bool SupportsDirectScreenBlit() const override
+  {
+    return true;
+  }
 
   D3D::VertexShaderPtr m_vertex_shader;
   D3D::GeometryShaderPtr m_geometry_shader;
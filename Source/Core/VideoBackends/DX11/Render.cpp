@@ -19,6 +19,7 @@
 #include "Core/Host.h"
 #include "Core/Movie.h"
 
+#include "VideoBackends/DX11/AsyncReadback.h"
 #include "VideoBackends/DX11/BoundingBox.h"
 #include "VideoBackends/DX11/D3DBase.h"
 #include "VideoBackends/DX11/D3DPtr.h"
@@ -234,21 +235,14 @@ void Renderer::PrepareFrameDumpRenderTexture(u32 width, u32 height)
     (D3D11_BIND_FLAG)(D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE),
     D3D11_USAGE_DEFAULT, DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1);
 }
-void Renderer::PrepareFrameDumpBuffer(u32 width, u32 height)
+void Renderer::EndFrameDumping()
 {
-  if (width == m_frame_dump_staging_texture_width
-    && height == m_frame_dump_staging_texture_height)
-  {
-    return;
-  }
-  m_frame_dump_staging_texture.reset();
-  // We can't render anything outside of the backbuffer anyway, so use the backbuffer size as the screenshot buffer size.
-  // This texture is released to be recreated when the window is resized in Renderer::SwapImpl.
-  D3D11_TEXTURE2D_DESC scrtex_desc = CD3D11_TEXTURE2D_DESC(DXGI_FORMAT_R8G8B8A8_UNORM, width, height, 1, 1, 0, D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ | D3D11_CPU_ACCESS_WRITE);
-  HRESULT hr = D3D::device->CreateTexture2D(&scrtex_desc, nullptr, D3D::ToAddr(m_frame_dump_staging_texture));
-  CHECK(hr == S_OK, "Create screenshot staging texture");
-  D3D::SetDebugObjectName(m_frame_dump_staging_texture.get(), "staging screenshot texture");
+  // The dump thread has to be done with the last frame before its buffer goes away.
+  m_frame_dump_readback->Flush();
+  FinishFrameData();
+  m_frame_dump_readback.reset();
 }
+
 Renderer::Renderer(void *&window_handle)
 {
   D3D::Create((HWND)window_handle);
@@ -274,7 +268,6 @@ Renderer::Renderer(void *&window_handle)
 
   m_3d_vision_texture = nullptr;
   m_frame_dump_render_texture = nullptr;
-  m_frame_dump_staging_texture.reset();
   CheckForHostConfigChanges();
 }
 
@@ -304,6 +297,8 @@ void Renderer::Init()
 
 Renderer::~Renderer()
 {
+  if (m_frame_dump_readback)
+    EndFrameDumping();
   m_post_processor.reset();
   TeardownDeviceObjects();
   if (m_3d_vision_texture)
@@ -316,7 +311,6 @@ Renderer::~Renderer()
   }
   m_3d_vision_texture = nullptr;
   m_frame_dump_render_texture = nullptr;
-  m_frame_dump_staging_texture.reset();
   D3D::EndFrame();
   D3D::Present();
   D3D::Close();
@@ -372,7 +366,8 @@ bool Renderer::CheckForResize()
 
 void Renderer::SetScissorRect(const EFBRectangle& rc)
 {
-  D3D::context->RSSetScissorRects(1, ConvertEFBRectangle(rc).AsRECT());
+  // Recorded draws set their own scissor rectangle.
+  D3D::context.GetWithoutRecordedDraws()->RSSetScissorRects(1, ConvertEFBRectangle(rc).AsRECT());
 }
 
 // This function allows the CPU to directly access the EFB.
@@ -524,7 +519,8 @@ void Renderer::SetViewport()
   // This trick makes sure we match the precision provided by the 1:0
   // clipping depth range on the hardware.
   D3D11_VIEWPORT vp = CD3D11_VIEWPORT(X, Y, Wd, Ht, 1.0f - max_depth, 1.0f - min_depth);
-  D3D::context->RSSetViewports(1, &vp);
+  // Recorded draws set their own viewport.
+  D3D::context.GetWithoutRecordedDraws()->RSSetViewports(1, &vp);
 }
 
 void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaEnable, bool zEnable, u32 color, u32 z)
@@ -637,6 +633,10 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, co
   {
     DumpFrame(rc, xfbAddr, xfbSourceList, xfbCount, fbWidth, fbStride, fbHeight, ticks);
   }
+  else if (m_frame_dump_readback)
+  {
+    EndFrameDumping();
+  }
 
   Renderer::DrawDebugText();
   OSD::DrawMessages();
@@ -665,6 +665,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, co
   }
 
   // Flip/present backbuffer to frontbuffer here
+  PacePresent();
   D3D::Present();
   bool hpchanged = m_last_hp_frame_buffer != g_ActiveConfig.UseHPFrameBuffer();
   // Resize the back buffers NOW to avoid flickering
@@ -1048,19 +1049,19 @@ void  Renderer::DumpFrame(const EFBRectangle& source_rc, u32 xfb_addr,
     src_height = GetTargetRectangle().GetHeight();
     source_box = GetScreenshotSourceBox(m_target_rectangle, src_width, src_height);
   }
-  PrepareFrameDumpBuffer(src_width, src_height);
-
-  unsigned int box_width = source_box.right - source_box.left;
-  unsigned int box_height = source_box.bottom - source_box.top;
-
-  D3D::context->CopySubresourceRegion(m_frame_dump_staging_texture.get(), 0, 0, 0, 0, (ID3D11Resource*)src->GetTex(), 0, &source_box);
-  D3D11_MAPPED_SUBRESOURCE map;
-  D3D::context->Map(m_frame_dump_staging_texture.get(), 0, D3D11_MAP_READ, 0, &map);
-  AVIDump::Frame state = AVIDump::FetchState(ticks);
-  DumpFrameData(reinterpret_cast<const u8*>(map.pData), box_width, box_height,
-    map.RowPitch, state);
-  FinishFrameData();
-  D3D::context->Unmap(m_frame_dump_staging_texture.get(), 0);
+  // Write the frames the GPU finished since, then queue a readback of this one. The frame dump
+  // thread encodes them while the next frames are emulated.
+  if (!m_frame_dump_readback)
+    m_frame_dump_readback = std::make_unique<AsyncReadback>(FRAME_DUMP_BUFFERED_FRAMES);
+  m_frame_dump_readback->Poll();
+  const AVIDump::Frame state = AVIDump::FetchState(ticks);
+  const MathUtil::Rectangle<int> rect(source_box.left, source_box.top, source_box.right,
+    source_box.bottom);
+  m_frame_dump_readback->Queue(reinterpret_cast<uintptr_t>(src), rect,
+    [this, state](const u8* data, u32 width, u32 height, u32 stride) {
+      DumpFrameData(data, static_cast<int>(width), static_cast<int>(height),
+        static_cast<int>(stride), state);
+    });
 }
 
 void Renderer::SetFullscreen(bool enable_fullscreen)
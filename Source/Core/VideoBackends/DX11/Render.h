@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
 #include <string>
 #include "VideoCommon/RenderBase.h"
 #include "VideoBackends/DX11/D3DTexture.h"
@@ -12,6 +14,7 @@ struct XFBSourceBase;
 
 namespace DX11
 {
+class AsyncReadback;
 
 class Renderer : public ::Renderer
 {
@@ -69,17 +72,19 @@ private:
     u32 fb_stride, u32 fb_height, u64 ticks);
 
   void PrepareFrameDumpRenderTexture(u32 width, u32 height);
-  void PrepareFrameDumpBuffer(u32 width, u32 height);
+  // Writes the frames still being read back to the frame dump and stops reading back.
+  void EndFrameDumping();
   void Create3DVisionTexture(u32 width, u32 height);
   void SetupDeviceObjects();
 
   D3DTexture2D* m_frame_dump_render_texture = nullptr;
-  D3D::Texture2dPtr m_frame_dump_staging_texture;
+  // Frames are read back a few frames later, once the GPU is done with them, so that frame
+  // dumping doesn't wait for the GPU. Only exists while frame dumping.
+  static const size_t FRAME_DUMP_BUFFERED_FRAMES = 3;
+  std::unique_ptr<AsyncReadback> m_frame_dump_readback;
   D3DTexture2D* m_3d_vision_texture = nullptr;
   u32 m_frame_dump_render_texture_width = 0;
   u32 m_frame_dump_render_texture_height = 0;
-  u32 m_frame_dump_staging_texture_width = 0;
-  u32 m_frame_dump_staging_texture_height = 0;
   u32 m_3d_vision_texture_width = 0;
   u32 m_3d_vision_texture_height = 0;
   u32 m_last_multisamples = 0;
@@ -58,13 +58,14 @@ bool TextureCache::DecodeTextureOnGPU(HostTexture* dst, u32 dst_level, const u8*
 
 HostTextureFormat TextureCache::GetHostTextureFormat(const s32 texformat, const TlutFormat tlutfmt, u32 width, u32 height)
 {
-  if (s_decoder->FormatSupported(texformat))
-  {
-    return PC_TEX_FMT_RGBA32;
-  }
   const bool compressed_supported = ((width & 3) == 0) && ((height & 3) == 0);
   HostTextureFormat pcfmt = TexDecoder::GetHostTextureFormat(texformat, tlutfmt, compressed_supported);
   pcfmt = !g_ActiveConfig.backend_info.bSupportedFormats[pcfmt] ? PC_TEX_FMT_RGBA32 : pcfmt;
+  // CMPR uploaded as BC1 isn't decoded at all, everything else goes through the decoder.
+  if (!TexDecoder::IsCompressed(pcfmt) && s_decoder->FormatSupported(texformat))
+  {
+    return PC_TEX_FMT_RGBA32;
+  }
   return pcfmt;
 }
 
@@ -6,6 +6,7 @@
 
 #include "VideoBackends/DX11/BoundingBox.h"
 #include "VideoBackends/DX11/D3DBase.h"
+#include "VideoBackends/DX11/D3DDrawRecorder.h"
 #include "VideoBackends/DX11/D3DState.h"
 #include "VideoBackends/DX11/GeometryShaderCache.h"
 #include "VideoBackends/DX11/HullDomainShaderCache.h"
@@ -97,11 +98,14 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
   m_vertexDrawOffset = cursor;
   m_indexDrawOffset = cursor + vertexBufferSize;
 
-  D3D::context->Map(m_buffers[m_currentBuffer].get(), 0, MapType, 0, &map);
+  // Draws recorded on another thread only have to be executed before discarding the buffer.
+  ID3D11DeviceContext* context = MapType == D3D11_MAP_WRITE_DISCARD ?
+    D3D::context.Get() : D3D::context.GetWithoutRecordedDraws();
+  context->Map(m_buffers[m_currentBuffer].get(), 0, MapType, 0, &map);
   u8* mappedData = reinterpret_cast<u8*>(map.pData);
   memcpy(mappedData + m_vertexDrawOffset, m_pBaseBufferPointer, vertexBufferSize);
   memcpy(mappedData + m_indexDrawOffset, m_index_buffer_start, indexBufferSize);
-  D3D::context->Unmap(m_buffers[m_currentBuffer].get(), 0);
+  context->Unmap(m_buffers[m_currentBuffer].get(), 0);
 
   m_bufferCursor = cursor + totalBufferSize;
 
@@ -132,8 +136,17 @@ void VertexManager::Draw(UINT stride)
     D3D::stateman->SetPrimitiveTopology(m_current_primitive_type == PrimitiveType::Lines ? D3D11_PRIMITIVE_TOPOLOGY_LINELIST : D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
   }
 
-  D3D::stateman->Apply();
-  D3D::context->DrawIndexed(indices, startIndex, baseVertex);
+  // The bounding box is written through a UAV of the immediate context.
+  if (D3D::draw_recorder && !BBox::IsActive())
+  {
+    D3D::draw_recorder->RecordDraw(D3D::stateman->GetDrawState(), indices, startIndex,
+      baseVertex);
+  }
+  else
+  {
+    D3D::stateman->Apply();
+    D3D::context->DrawIndexed(indices, startIndex, baseVertex);
+  }
   INCSTAT(stats.thisFrame.numDrawCalls);
 }
 
@@ -4,13 +4,13 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
-#include "Common/LinearDiskCache.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
 
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/HLSLCompiler.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoBackends/DX11/D3DState.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -29,16 +29,18 @@ const VertexShaderCache::VSCacheEntry *VertexShaderCache::s_last_entry;
 const VertexShaderCache::VSCacheEntry *VertexShaderCache::s_last_uber_entry;
 VertexShaderUid VertexShaderCache::s_last_uid;
 UberShader::VertexUberShaderUid VertexShaderCache::s_last_uber_uid;
+std::deque<UberShader::VertexUberShaderUid> VertexShaderCache::s_background_uber_uids;
 
 static HLSLAsyncCompiler *s_compiler;
+static ShaderUidTracker s_uid_tracker(SHADER_UID_VERTEX);
 
 static D3D::VertexShaderPtr s_simple_vertex_shader;
 static D3D::VertexShaderPtr s_clear_vertex_shader;
 static D3D::InputLayoutPtr s_simple_layout;
 static D3D::InputLayoutPtr s_clear_layout;
 
-LinearDiskCache<VertexShaderUid, u8> g_vs_disk_cache;
-LinearDiskCache<UberShader::VertexUberShaderUid, u8> g_vus_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<VertexShaderUid, u8> g_vs_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<UberShader::VertexUberShaderUid, u8> g_vus_disk_cache;
 
 ID3D11VertexShader* VertexShaderCache::GetSimpleVertexShader()
 {
@@ -179,6 +181,11 @@ void VertexShaderCache::Init()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(s_vshaders) &&
+           !g_ActiveConfig.bDisableSpecializedShaders)
+  {
+    CompileShaders(true);
+  }
   s_last_entry = nullptr;
   s_last_uber_entry = nullptr;
   SETSTAT(stats.numVertexShadersCreated, 0);
@@ -189,10 +196,7 @@ void VertexShaderCache::LoadFromDisk()
 {
   if (s_vshaders)
   {
-    s_vshaders->Persist([](VertexShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_vshaders);
     s_vshaders->Clear([](VSCacheEntry& item)
     {
       item.Destroy();
@@ -203,13 +207,7 @@ void VertexShaderCache::LoadFromDisk()
   for (auto& item : s_vuber_shaders)
     item.second.Destroy();
   s_vuber_shaders.clear();
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  s_vshaders = VSCache::Create(
-    gameid,
-    VERTEXSHADERGEN_UID_VERSION,
-    "Ishiiruka.vs",
-    StringFromFormat("%s.vs", SConfig::GetInstance().GetGameID().c_str())
-  );
+  s_vshaders = ShaderCacheUtils::CreateUsageProfile<VSCache>("vs", VERTEXSHADERGEN_UID_VERSION);
   std::string cache_filename = GetDiskShaderCacheFileName(API_D3D11, "uvs", false, true);
   VertexUberShaderCacheInserter uinserter;
   g_vus_disk_cache.OpenAndRead(cache_filename, uinserter);
@@ -220,50 +218,86 @@ void VertexShaderCache::LoadFromDisk()
 
 static size_t shader_count = 0;
 
-void VertexShaderCache::CompileShaders()
+// In the background only the most used shaders are queued, they are picked up by the draws once
+// the thread pool has compiled them.
+void VertexShaderCache::CompileShaders(bool background)
 {
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler,
+    background ? CompilePriority::Predicted : CompilePriority::Precompile);
   shader_count = 0;
   const ShaderHostConfig& hostconfig = ShaderHostConfig::GetCurrent();
-  s_vshaders->ForEachMostUsedByCategory(gameid,
-    [&](const VertexShaderUid& it, size_t total)
+  ShaderCacheUtils::ForEachShaderToPrecompile(s_vshaders,
+    [](VSCacheEntry& entry)
+  {
+    return !entry.shader;
+  },
+    [&](const VertexShaderUid& item, size_t total)
   {
-    VertexShaderUid item = it;
-    item.ClearHASH();
-    item.CalculateUIDHash();
+    if (background)
+    {
+      CompileVShader(item, hostconfig, false, {});
+      return;
+    }
     CompileVShader(item, hostconfig, true, [total]() {
       shader_count++;
       Host_UpdateProgressDialog(GetStringT("Compiling Vertex shaders...").c_str(),
         static_cast<int>(shader_count), static_cast<int>(total));
     });
-    
-  },
-    [](VSCacheEntry& entry)
-  {
-    return !entry.shader;
-  }
-  , true);
+  }, background ? ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT : SIZE_MAX);
+  if (background)
+    return;
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
 }
 
+// Only the uber shaders the draws in the usage profile map to are waited for, so those never
+// stutter. The others are left for QueueBackgroundUberShader, or compiled when a draw needs one.
 void VertexShaderCache::CompileUberShaders()
 {
+  std::vector<UberShader::VertexUberShaderUid> used;
+  std::vector<UberShader::VertexUberShaderUid> unused;
+  ShaderCacheUtils::GetUberShadersToPrecompile(
+    s_vshaders,
+    [](const VertexShaderUid& uid) { return UberShader::GetVertexUberShaderUid(uid); },
+    UberShader::EnumerateVertexUberShaderUids, &used, &unused);
+
   const ShaderHostConfig& hostconfig = ShaderHostConfig::GetCurrent();
+  const size_t total = used.size();
   shader_count = 0;
-  UberShader::EnumerateVertexUberShaderUids([&](const UberShader::VertexUberShaderUid& uid, size_t total) {
-    CompileUberShader(uid, hostconfig, [total]() {
+  for (const UberShader::VertexUberShaderUid& uid : used)
+  {
+    CompileUberShader(uid, hostconfig, false, [total]() {
       shader_count++;
       Host_UpdateProgressDialog(GetStringT("Compiling Vertex Uber shaders...").c_str(),
         static_cast<int>(shader_count), static_cast<int>(total));
     });
-  });
+  }
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
+
+  s_background_uber_uids.clear();
+  for (const UberShader::VertexUberShaderUid& uid : unused)
+  {
+    auto it = s_vuber_shaders.find(uid);
+    if (it == s_vuber_shaders.end() || !it->second.compiled)
+      s_background_uber_uids.push_back(uid);
+  }
+}
+
+// Queues the next background uber shader whenever the compiler has nothing else waiting, so they
+// never hold up a shader a draw needs.
+void VertexShaderCache::QueueBackgroundUberShader()
+{
+  if (s_background_uber_uids.empty() || s_compiler->HasQueuedUnits())
+    return;
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler, CompilePriority::Predicted);
+  CompileUberShader(s_background_uber_uids.front(), ShaderHostConfig::GetCurrent(), true, {});
+  s_background_uber_uids.pop_front();
 }
 
 void VertexShaderCache::Reload()
 {
+  s_compiler->CancelPendingUnits(CompilePriority::Predicted);
   s_compiler->WaitForFinish();
   g_vs_disk_cache.Sync();
   g_vs_disk_cache.Close();
@@ -278,6 +312,11 @@ void VertexShaderCache::Reload()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(s_vshaders) &&
+           !g_ActiveConfig.bDisableSpecializedShaders)
+  {
+    CompileShaders(true);
+  }
   s_last_entry = nullptr;
   s_last_uid.ClearUID();
   s_last_uber_entry = nullptr;
@@ -288,10 +327,7 @@ void VertexShaderCache::Clear()
 {
   if (s_vshaders)
   {
-    s_vshaders->Persist([](VertexShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_vshaders);
     s_vshaders->Clear([](VSCacheEntry& item)
     {
       item.Destroy();
@@ -308,8 +344,10 @@ void VertexShaderCache::Clear()
 
 void VertexShaderCache::Shutdown()
 {
+  s_background_uber_uids.clear();
   if (s_compiler)
   {
+    s_compiler->CancelPendingUnits(CompilePriority::Predicted);
     s_compiler->WaitForFinish();
   }
   if (vscbuf != nullptr)
@@ -333,19 +371,28 @@ void VertexShaderCache::Shutdown()
   g_vus_disk_cache.Close();
 }
 
-void VertexShaderCache::CompileUberShader(const UberShader::VertexUberShaderUid& uid, const ShaderHostConfig& hostconfig, std::function<void()> oncompilationfinished = {})
+VertexShaderCache::VSCacheEntry* VertexShaderCache::CompileUberShader(const UberShader::VertexUberShaderUid& uid, const ShaderHostConfig& hostconfig, bool background, std::function<void()> oncompilationfinished)
 {
   VSCacheEntry* entry = &s_vuber_shaders[uid];
-  s_last_uber_entry = entry;
   // Compile only when we have a new instance
   if (entry->initialized.test_and_set())
   {
     if (oncompilationfinished) oncompilationfinished();
-    return;
+    return entry;
   }
   // Need to compile a new shader
 
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  if (background)
+  {
+    wunit->priority = &entry->hits;
+    // Compiled again the next time a draw needs it.
+    wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->initialized.clear(); };
+  }
+  else
+  {
+    wunit->priority = &HLSLAsyncCompiler::HIGHEST_PRIORITY;
+  }
   wunit->GenerateCodeHandler = [uid, hostconfig](ShaderCompilerWorkUnit* wunit)
   {
     UberShader::GenVertexShader(wunit->code, API_D3D11, hostconfig, uid.GetUidData());
@@ -394,6 +441,7 @@ void VertexShaderCache::CompileUberShader(const UberShader::VertexUberShaderUid&
     }
   };
   s_compiler->CompileShaderAsync(wunit);
+  return entry;
 }
 
 void VertexShaderCache::CompileVShader(const VertexShaderUid& uid, const ShaderHostConfig& hostconfig, bool forcecompile = false, std::function<void()> oncompilationfinished = {})
@@ -412,6 +460,9 @@ void VertexShaderCache::CompileVShader(const VertexShaderUid& uid, const ShaderH
   }
 
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  wunit->priority = &entry->hits;
+  // Compiled again the next time a draw needs it.
+  wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->initialized.clear(); };
   wunit->GenerateCodeHandler = [uid, hostconfig](ShaderCompilerWorkUnit* wunit)
   {
     GenerateVertexShaderCode(wunit->code, uid.GetUidData(), hostconfig);
@@ -464,14 +515,24 @@ void VertexShaderCache::PrepareShader(
   &xfr,
   const BPMemory &bpm)
 {
-  if (g_ActiveConfig.bBackgroundShaderCompiling || g_ActiveConfig.bDisableSpecializedShaders)
+  const bool use_uber_shaders =
+    g_ActiveConfig.bBackgroundShaderCompiling || g_ActiveConfig.bDisableSpecializedShaders;
+  // Nothing the uids depend on changed since the last draw.
+  if (s_uid_tracker.IsUnchanged(components) && s_last_entry &&
+    (!use_uber_shaders || s_last_uber_entry))
+  {
+    s_compiler->ProcCompilationResults();
+    return;
+  }
+  if (use_uber_shaders)
   {
     auto uuid = UberShader::GetVertexUberShaderUid(components, xfr);
     if (!s_last_uber_entry || s_last_uber_uid != uuid)
     {
       s_last_uber_uid = uuid;
-      CompileUberShader(uuid, ShaderHostConfig::GetCurrent());
+      s_last_uber_entry = CompileUberShader(uuid, ShaderHostConfig::GetCurrent(), false, {});
     }
+    QueueBackgroundUberShader();
   }
   VertexShaderUid uid;
   GetVertexShaderUID(uid, components, xfr, bpm);
@@ -495,6 +556,8 @@ void VertexShaderCache::SetActiveShader(D3DVertexFormat* current_vertex_format)
   }
   else if (s_last_uber_entry)
   {
+    if (s_last_entry)
+      s_last_entry->hits.fetch_add(1, std::memory_order_relaxed);
     D3DVertexFormat* uber_vertex_format = static_cast<D3DVertexFormat*>(
       VertexLoaderManager::GetUberVertexFormat(current_vertex_format->GetVertexDeclaration()));
     uber_vertex_format->SetInputLayout(s_last_uber_entry->bytecode);
@@ -509,6 +572,8 @@ bool VertexShaderCache::TestShader()
   {
     return s_last_uber_entry && s_last_uber_entry->compiled;
   }
+  ShaderCompileStats::StallTimer stall(!s_last_entry->compiled &&
+                                       !g_ActiveConfig.bFullAsyncShaderCompilation);
   int count = 0;
   while (!s_last_entry->compiled)
   {
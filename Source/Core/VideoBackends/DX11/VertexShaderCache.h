@@ -4,6 +4,7 @@
 
 #pragma once
 #include <atomic>
+#include <deque>
 #include <unordered_map>
 #include "VideoBackends/DX11/D3DBase.h"
 #include "VideoBackends/DX11/D3DBlob.h"
@@ -37,9 +38,11 @@ public:
 private:
   static void Clear();
   static void LoadFromDisk();
-  static void CompileShaders();
+  static void CompileShaders(bool background = false);
   static void CompileUberShaders();
-  static void CompileUberShader(const UberShader::VertexUberShaderUid& uid, const ShaderHostConfig& hostconfig, std::function<void()> oncompilationfinished);
+  static void QueueBackgroundUberShader();
+  struct VSCacheEntry;
+  static VSCacheEntry* CompileUberShader(const UberShader::VertexUberShaderUid& uid, const ShaderHostConfig& hostconfig, bool background, std::function<void()> oncompilationfinished);
   static void CompileVShader(const VertexShaderUid& uid, const ShaderHostConfig& hostconfig, bool forcecompile, std::function<void()> oncompilationfinished);
   struct VSCacheEntry
   {
@@ -49,7 +52,9 @@ private:
     std::string code;
     bool compiled;
     std::atomic_flag initialized;
-    VSCacheEntry() : compiled(false)
+    // Draws that fell back to the ubershader while this one was compiling.
+    std::atomic<u32> hits;
+    VSCacheEntry() : compiled(false), hits(0)
     {
       initialized.clear();
     }
@@ -73,6 +78,8 @@ private:
   static const VSCacheEntry* s_last_uber_entry;
   static VertexShaderUid s_last_uid;
   static UberShader::VertexUberShaderUid s_last_uber_uid;
+  // The uber shaders no game draw of the usage profile needs, compiled one at a time.
+  static std::deque<UberShader::VertexUberShaderUid> s_background_uber_uids;
 };
 
 }  // namespace DX11
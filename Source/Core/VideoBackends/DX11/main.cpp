@@ -31,6 +31,7 @@
 #include "VideoBackends/DX11/BoundingBox.h"
 #include "VideoBackends/DX11/D3DBase.h"
 #include "VideoBackends/DX11/D3DUtil.h"
+#include "VideoBackends/DX11/FrameProfiler.h"
 #include "VideoBackends/DX11/GeometryShaderCache.h"
 #include "VideoBackends/DX11/HullDomainShaderCache.h"
 #include "VideoBackends/DX11/PerfQuery.h"
@@ -85,13 +86,15 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsPixelLighting = true;
   g_Config.backend_info.bNeedBlendIndices = false;
   g_Config.backend_info.bSupportsOversizedViewports = false;
+  g_Config.backend_info.bSupportsPrimitiveRestart = false;
   g_Config.backend_info.bSupportsGeometryShaders = true;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
   g_Config.backend_info.bSupports3DVision = true;
   g_Config.backend_info.bSupportsPostProcessing = true;
   g_Config.backend_info.bSupportsClipControl = true;
   g_Config.backend_info.bSupportsNormalMaps = true;
   g_Config.backend_info.bSupportsDepthClamp = true;
-  g_Config.backend_info.bSupportsMultithreading = false;
+  g_Config.backend_info.bSupportsMultithreading = true;
   g_Config.backend_info.bSupportsValidationLayer = true;
   g_Config.backend_info.bSupportsReversedDepthRange = true;
   g_Config.backend_info.bSupportsInternalResolutionFrameDumps = true;
@@ -100,6 +103,9 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsDynamicSamplerIndexing = false;
   g_Config.backend_info.bSupportsUberShaders = true;
   g_Config.backend_info.bSupportsHighPrecisionFrameBuffer = true;
+  g_Config.backend_info.bSupportsGPUVertexDecoding = false;
+  g_Config.backend_info.bSupportsGPUTextureScaling = false;
+  g_Config.backend_info.bSupportsGPUMipmapGeneration = true;
   g_Config.ClearFormats();
   IDXGIFactory* factory;
   IDXGIAdapter* ad;
@@ -172,6 +178,7 @@ void VideoBackend::Video_Prepare()
   g_texture_cache = std::make_unique<TextureCache>();
   g_vertex_manager = std::make_unique<VertexManager>();
   g_perf_query = std::make_unique<PerfQuery>();
+  g_frame_profiler = std::make_unique<FrameProfiler>();
   g_renderer->Init();
   VertexShaderCache::Init();
   PixelShaderCache::Init();
@@ -191,6 +198,7 @@ void VideoBackend::Shutdown()
   VertexShaderCache::Shutdown();
   BBox::Shutdown();
 
+  g_frame_profiler.reset();
   g_perf_query.reset();
   g_vertex_manager.reset();
   g_texture_cache.reset();
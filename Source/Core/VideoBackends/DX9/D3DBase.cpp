@@ -66,17 +66,30 @@ const int MaxRenderStates = 210 + 46;
 const int MaxTextureTypes = 33;
 const int MaxSamplerSize = 13;
 const int MaxSamplerTypes = 15;
+// The values set with the Set functions are restored by the Refresh functions, the Device values
+// shadow what the device currently has, which is known once a state was set, so no call is made
+// for a value the device already has.
 static std::vector<bool> m_RenderStatesSet(MaxRenderStates);
 static std::vector<DWORD> m_RenderStates(MaxRenderStates);
-static std::vector<bool> m_RenderStatesChanged(MaxRenderStates);
+static std::vector<DWORD> m_RenderStatesDevice(MaxRenderStates);
 
 static std::vector<DWORD> m_TextureStageStates(MaxTextureStages * MaxTextureTypes);
 static std::vector<bool> m_TextureStageStatesSet(MaxTextureStages * MaxTextureTypes);
-static std::vector<bool> m_TextureStageStatesChanged(MaxTextureStages * MaxTextureTypes);
+static std::vector<DWORD> m_TextureStageStatesDevice(MaxTextureStages * MaxTextureTypes);
 
 static std::vector<DWORD> m_SamplerStates(MaxSamplerSize * MaxSamplerTypes);
 static std::vector<bool> m_SamplerStatesSet(MaxSamplerSize * MaxSamplerTypes);
-static std::vector<bool> m_SamplerStatesChanged(MaxSamplerSize * MaxSamplerTypes);
+static std::vector<DWORD> m_SamplerStatesDevice(MaxSamplerSize * MaxSamplerTypes);
+
+static inline u32 TextureStageStateIndex(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type)
+{
+  return Stage * MaxTextureTypes + Type;
+}
+
+static inline u32 SamplerStateIndex(DWORD Sampler, D3DSAMPLERSTATETYPE Type)
+{
+  return Sampler * MaxSamplerTypes + Type;
+}
 
 static LPDIRECT3DBASETEXTURE9 m_Textures[16];
 static LPDIRECT3DVERTEXDECLARATION9 m_VtxDecl;
@@ -495,12 +508,9 @@ HRESULT Create(int adapter, HWND wnd, int _resolution, int aa_mode, bool auto_de
   SetRenderState(D3DRS_FILLMODE, g_Config.bWireFrame ? D3DFILL_WIREFRAME : D3DFILL_SOLID);
   memset(m_Textures, 0, sizeof(m_Textures));
   m_TextureStageStatesSet.assign(MaxTextureStages * MaxTextureTypes, false);
-  m_TextureStageStatesChanged.assign(MaxTextureStages * MaxTextureTypes, false);
   m_RenderStates.assign(MaxRenderStates, 0);
   m_RenderStatesSet.assign(MaxRenderStates, false);
-  m_RenderStatesChanged.assign(MaxRenderStates, false);
   m_SamplerStatesSet.assign(MaxSamplerSize * MaxSamplerTypes, false);
-  m_SamplerStatesChanged.assign(MaxSamplerSize * MaxSamplerTypes, false);
   m_VtxDecl = nullptr;
   m_PixelShader = nullptr;
   m_VertexShader = nullptr;
@@ -732,23 +742,28 @@ void ApplyCachedState()
   {
     for (int type = 0; type < MaxSamplerTypes; type++)
     {
-      u32 index = sampler * MaxSamplerSize + type;
+      u32 index = SamplerStateIndex(sampler, (D3DSAMPLERSTATETYPE)type);
       if (m_SamplerStatesSet[index])
+      {
         dev->SetSamplerState(sampler, (D3DSAMPLERSTATETYPE)type, m_SamplerStates[index]);
+        m_SamplerStatesDevice[index] = m_SamplerStates[index];
+      }
     }
   }
 
   for (int rs = 0; rs < MaxRenderStates; rs++)
   {
     if (m_RenderStatesSet[rs])
+    {
       dev->SetRenderState((D3DRENDERSTATETYPE)rs, m_RenderStates[rs]);
+      m_RenderStatesDevice[rs] = m_RenderStates[rs];
+    }
   }
 
   // We don't bother restoring these so let's just wipe the state copy
   // so no stale state is around.
   memset(m_Textures, 0, sizeof(m_Textures));
   m_TextureStageStatesSet.assign(MaxTextureStages * MaxTextureTypes, false);
-  m_TextureStageStatesChanged.assign(MaxTextureStages * MaxTextureTypes, false);
   m_VtxDecl = nullptr;
   m_PixelShader = nullptr;
   m_VertexShader = nullptr;
@@ -772,110 +787,114 @@ void SetTexture(DWORD Stage, LPDIRECT3DBASETEXTURE9 pTexture)
 
 void RefreshRenderState(D3DRENDERSTATETYPE State)
 {
-  if (m_RenderStatesSet[State] && m_RenderStatesChanged[State])
+  if (m_RenderStatesSet[State] && m_RenderStatesDevice[State] != m_RenderStates[State])
   {
     dev->SetRenderState(State, m_RenderStates[State]);
-    m_RenderStatesChanged[State] = false;
+    m_RenderStatesDevice[State] = m_RenderStates[State];
   }
 }
 
 void SetRenderState(D3DRENDERSTATETYPE State, DWORD Value)
 {
-  if (m_RenderStates[State] != Value || !m_RenderStatesSet[State] || m_RenderStatesChanged[State])
+  m_RenderStates[State] = Value;
+  if (!m_RenderStatesSet[State] || m_RenderStatesDevice[State] != Value)
   {
-    m_RenderStates[State] = Value;
     m_RenderStatesSet[State] = true;
-    m_RenderStatesChanged[State] = false;
+    m_RenderStatesDevice[State] = Value;
     dev->SetRenderState(State, Value);
   }
 }
 
 void ChangeRenderState(D3DRENDERSTATETYPE State, DWORD Value)
 {
-  if (!m_RenderStatesSet[State] || m_RenderStates[State] != Value || m_RenderStatesChanged[State])
+  if (!m_RenderStatesSet[State])
   {
-    if (!m_RenderStatesSet[State])
-    {
-      m_RenderStates[State] = Value;
-      m_RenderStatesSet[State] = true;
-    }
-    m_RenderStatesChanged[State] = m_RenderStatesSet[State] && m_RenderStates[State] != Value;
-    dev->SetRenderState(State, Value);
+    m_RenderStates[State] = Value;
+    m_RenderStatesSet[State] = true;
+  }
+  else if (m_RenderStatesDevice[State] == Value)
+  {
+    return;
   }
+  m_RenderStatesDevice[State] = Value;
+  dev->SetRenderState(State, Value);
 }
 
 void SetTextureStageState(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type, DWORD Value)
 {
-  u32 index = Stage * MaxTextureStages + Type;
-  if (m_TextureStageStates[index] != Value || !m_TextureStageStatesSet[index] || m_TextureStageStatesChanged[index])
+  u32 index = TextureStageStateIndex(Stage, Type);
+  m_TextureStageStates[index] = Value;
+  if (!m_TextureStageStatesSet[index] || m_TextureStageStatesDevice[index] != Value)
   {
-    m_TextureStageStates[index] = Value;
     m_TextureStageStatesSet[index] = true;
-    m_TextureStageStatesChanged[index] = false;
+    m_TextureStageStatesDevice[index] = Value;
     dev->SetTextureStageState(Stage, Type, Value);
   }
 }
 
 void RefreshTextureStageState(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type)
 {
-  u32 index = Stage * MaxTextureStages + Type;
-  if (m_TextureStageStatesSet[index] && m_TextureStageStatesChanged[index])
+  u32 index = TextureStageStateIndex(Stage, Type);
+  if (m_TextureStageStatesSet[index] &&
+      m_TextureStageStatesDevice[index] != m_TextureStageStates[index])
   {
     dev->SetTextureStageState(Stage, Type, m_TextureStageStates[index]);
-    m_TextureStageStatesChanged[index] = false;
+    m_TextureStageStatesDevice[index] = m_TextureStageStates[index];
   }
 }
 
 void ChangeTextureStageState(DWORD Stage, D3DTEXTURESTAGESTATETYPE Type, DWORD Value)
 {
-  u32 index = Stage * MaxTextureStages + Type;
-  if (m_TextureStageStates[index] != Value || !m_TextureStageStatesSet[index] || m_TextureStageStatesChanged[index])
+  u32 index = TextureStageStateIndex(Stage, Type);
+  if (!m_TextureStageStatesSet[index])
   {
-    if (!m_TextureStageStatesSet[index])
-    {
-      m_TextureStageStates[index] = Value;
-      m_TextureStageStatesSet[index] = true;
-    }
-    m_TextureStageStatesChanged[index] = m_TextureStageStatesSet[index] && m_TextureStageStates[index] != Value;
-    dev->SetTextureStageState(Stage, Type, Value);
+    m_TextureStageStates[index] = Value;
+    m_TextureStageStatesSet[index] = true;
+  }
+  else if (m_TextureStageStatesDevice[index] == Value)
+  {
+    return;
   }
+  m_TextureStageStatesDevice[index] = Value;
+  dev->SetTextureStageState(Stage, Type, Value);
 }
 
 void SetSamplerState(DWORD Sampler, D3DSAMPLERSTATETYPE Type, DWORD Value)
 {
-  u32 index = Sampler * MaxSamplerSize + Type;
-  if (m_SamplerStates[index] != Value || !m_SamplerStatesSet[index] || m_SamplerStatesChanged[index])
+  u32 index = SamplerStateIndex(Sampler, Type);
+  m_SamplerStates[index] = Value;
+  if (!m_SamplerStatesSet[index] || m_SamplerStatesDevice[index] != Value)
   {
-    m_SamplerStates[index] = Value;
     m_SamplerStatesSet[index] = true;
-    m_SamplerStatesChanged[index] = false;
+    m_SamplerStatesDevice[index] = Value;
     dev->SetSamplerState(Sampler, Type, Value);
   }
 }
 
 void RefreshSamplerState(DWORD Sampler, D3DSAMPLERSTATETYPE Type)
 {
-  u32 index = Sampler * MaxSamplerSize + Type;
-  if (m_SamplerStatesSet[index] && m_SamplerStatesChanged[index])
+  u32 index = SamplerStateIndex(Sampler, Type);
+  if (m_SamplerStatesSet[index] && m_SamplerStatesDevice[index] != m_SamplerStates[index])
   {
     dev->SetSamplerState(Sampler, Type, m_SamplerStates[index]);
-    m_SamplerStatesChanged[index] = false;
+    m_SamplerStatesDevice[index] = m_SamplerStates[index];
   }
 }
 
 void ChangeSamplerState(DWORD Sampler, D3DSAMPLERSTATETYPE Type, DWORD Value)
 {
-  u32 index = Sampler * MaxSamplerSize + Type;
-  if (m_SamplerStates[index] != Value || !m_SamplerStatesSet[index] || m_SamplerStatesChanged[index])
+  u32 index = SamplerStateIndex(Sampler, Type);
+  if (!m_SamplerStatesSet[index])
   {
-    if (!m_SamplerStatesSet[index])
-    {
-      m_SamplerStates[index] = Value;
-      m_SamplerStatesSet[index] = true;
-    }
-    m_SamplerStatesChanged[index] = m_SamplerStatesSet[index] && m_SamplerStates[index] != Value;
-    dev->SetSamplerState(Sampler, Type, Value);
+    m_SamplerStates[index] = Value;
+    m_SamplerStatesSet[index] = true;
+  }
+  else if (m_SamplerStatesDevice[index] == Value)
+  {
+    return;
   }
+  m_SamplerStatesDevice[index] = Value;
+  dev->SetSamplerState(Sampler, Type, Value);
 }
 
 void RefreshVertexDeclaration()
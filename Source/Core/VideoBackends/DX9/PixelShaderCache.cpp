@@ -5,7 +5,6 @@
 #include "Common/Common.h"
 #include "Common/Hash.h"
 #include "Common/FileUtil.h"
-#include "Common/LinearDiskCache.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
@@ -24,6 +23,7 @@
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/HLSLCompiler.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 
 namespace DX9
 {
@@ -33,7 +33,10 @@ const PixelShaderCache::PSCacheEntry *PixelShaderCache::s_last_entry[PSRM_DEPTH_
 PixelShaderUid PixelShaderCache::s_last_uid[PSRM_DEPTH_ONLY + 1];
 
 static HLSLAsyncCompiler *s_compiler;
-static LinearDiskCache<PixelShaderUid, u8> g_ps_disk_cache;
+static ShaderUidTracker s_uid_trackers[PSRM_DEPTH_ONLY + 1] = {
+  ShaderUidTracker(SHADER_UID_PIXEL), ShaderUidTracker(SHADER_UID_PIXEL),
+  ShaderUidTracker(SHADER_UID_PIXEL), ShaderUidTracker(SHADER_UID_PIXEL)};
+static ShaderCacheUtils::ShaderDiskCache<PixelShaderUid, u8> g_ps_disk_cache;
 static std::set<u32> s_unique_shaders;
 ObjectUsageProfiler<PixelShaderUid, pKey_t, PixelShaderCache::PSCacheEntry, PixelShaderUid::ShaderUidHasher>* PixelShaderCache::s_pshaders = nullptr;
 
@@ -286,6 +289,10 @@ void PixelShaderCache::Init()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(s_pshaders))
+  {
+    CompileShaders(true);
+  }
   SETSTAT(stats.numPixelShadersCreated, 0);
   SETSTAT(stats.numPixelShadersAlive, s_pshaders->size());
 }
@@ -296,10 +303,7 @@ void PixelShaderCache::LoadFromDisk()
   {
     if (s_compiler)
       s_compiler->WaitForFinish();
-    s_pshaders->Persist([](PixelShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_pshaders);
     s_pshaders->Clear([](auto& item)
     {
       item.Destroy();
@@ -307,13 +311,8 @@ void PixelShaderCache::LoadFromDisk()
     delete s_pshaders;
     s_pshaders = nullptr;
   }
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  s_pshaders = ObjectUsageProfiler<PixelShaderUid, pKey_t, PSCacheEntry, PixelShaderUid::ShaderUidHasher>::Create(
-    gameid,
-    PIXELSHADERGEN_UID_VERSION,
-    "Ishiiruka.ps.dx9",
-    StringFromFormat("%s.ps.dx9", SConfig::GetInstance().GetGameID().c_str())
-  );
+  s_pshaders = ShaderCacheUtils::CreateUsageProfile<ObjectUsageProfiler<PixelShaderUid, pKey_t,
+    PSCacheEntry, PixelShaderUid::ShaderUidHasher>>("ps.dx9", PIXELSHADERGEN_UID_VERSION);
   std::string cache_filename = GetDiskShaderCacheFileName(API_D3D9, "ps", true, true);
   PixelShaderCacheInserter inserter;
   g_ps_disk_cache.OpenAndRead(cache_filename, inserter);
@@ -321,25 +320,36 @@ void PixelShaderCache::LoadFromDisk()
 
 static size_t shader_count = 0;
 
-void PixelShaderCache::CompileShaders()
+// In the background only the most used shaders are queued, they are picked up by the draws once
+// the thread pool has compiled them.
+void PixelShaderCache::CompileShaders(bool background)
 {
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler,
+    background ? CompilePriority::Predicted : CompilePriority::Precompile);
   std::vector<PixelShaderUid> shaders;
   shader_count = 0;
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  s_pshaders->ForEachMostUsedByCategory(gameid,
+  ShaderCacheUtils::ForEachShaderToPrecompile(s_pshaders,
+    [](PSCacheEntry& entry)
+  {
+    return !entry.shader;
+  },
     [&](const PixelShaderUid& item, size_t total)
   {
     PixelShaderUid newitem = item;
     pixel_shader_uid_data& uid_data = newitem.GetUidData<pixel_shader_uid_data>();
     bool need_alphaPass = uid_data.render_mode == PSRM_DUAL_SOURCE_BLEND && !g_ActiveConfig.backend_info.bSupportsDualSourceBlend;
-    std::function<void()> oncompilationfinished = [total]() {
-      shader_count++;
-      if ((shader_count & 15) == 0)
-      {
-        Host_UpdateProgressDialog(GetStringT("Compiling Pixel shaders...").c_str(),
-          static_cast<int>(shader_count), static_cast<int>(total * 2));
-      }
-    };
+    std::function<void()> oncompilationfinished;
+    if (!background)
+    {
+      oncompilationfinished = [total]() {
+        shader_count++;
+        if ((shader_count & 15) == 0)
+        {
+          Host_UpdateProgressDialog(GetStringT("Compiling Pixel shaders...").c_str(),
+            static_cast<int>(shader_count), static_cast<int>(total * 2));
+        }
+      };
+    }
     if (need_alphaPass)
     {
       uid_data.render_mode = PSRM_DEFAULT;
@@ -355,21 +365,18 @@ void PixelShaderCache::CompileShaders()
     }
     else
     {
-      newitem.ClearHASH();
-      newitem.CalculateUIDHash();
       CompilePShader(newitem, PIXEL_SHADER_RENDER_MODE::PSRM_DEFAULT, oncompilationfinished);
     }
-  },
-    [](PSCacheEntry& entry)
-  {
-    return !entry.shader;
-  }, true);
+  }, background ? ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT : SIZE_MAX);
+  if (background)
+    return;
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
 }
 
 void PixelShaderCache::Reload()
 {
+  s_compiler->CancelPendingUnits(CompilePriority::Predicted);
   s_compiler->WaitForFinish();
   g_ps_disk_cache.Sync();
   g_ps_disk_cache.Close();
@@ -389,10 +396,7 @@ void PixelShaderCache::Clear()
   {
     if (s_compiler)
       s_compiler->WaitForFinish();
-    s_pshaders->Persist([](PixelShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_pshaders);
     s_pshaders->Clear([](auto& item)
     {
       item.Destroy();
@@ -409,6 +413,7 @@ void PixelShaderCache::Shutdown()
 {
   if (s_compiler)
   {
+    s_compiler->CancelPendingUnits(CompilePriority::Predicted);
     s_compiler->WaitForFinish();
   }
   for (int copyMatrixType = 0; copyMatrixType < NUM_COPY_TYPES; copyMatrixType++)
@@ -453,6 +458,8 @@ void PixelShaderCache::CompilePShader(const PixelShaderUid& uid, PIXEL_SHADER_RE
   // Need to compile a new shader
   const ShaderHostConfig& hostconfig = ShaderHostConfig::GetCurrent();
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  // Compiled again the next time a draw needs it.
+  wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->initialized.clear(); };
   wunit->GenerateCodeHandler = [uid, hostconfig](ShaderCompilerWorkUnit* wunit)
   {
     GeneratePixelShaderCode(wunit->code, uid.GetUidData(), hostconfig);
@@ -499,6 +506,12 @@ void PixelShaderCache::PrepareShader(
   const XFMemory &xfr,
   const BPMemory &bpm)
 {
+  // Nothing the uid depends on changed since the last draw in this render mode.
+  if (s_uid_trackers[render_mode].IsUnchanged(components) && s_last_entry[render_mode])
+  {
+    s_compiler->ProcCompilationResults();
+    return;
+  }
   PixelShaderUid uid;
   GetPixelShaderUID(uid, render_mode, components, xfr, bpm);
   s_compiler->ProcCompilationResults();
@@ -515,6 +528,8 @@ void PixelShaderCache::PrepareShader(
 bool PixelShaderCache::SetShader(PIXEL_SHADER_RENDER_MODE render_mode)
 {
   const PSCacheEntry* entry = s_last_entry[render_mode];
+  ShaderCompileStats::StallTimer stall(!entry->compiled &&
+                                       !g_ActiveConfig.bFullAsyncShaderCompilation);
   u32 count = 0;
   while (!entry->compiled)
   {
@@ -63,7 +63,7 @@ private:
 
   static void Clear();
   static void LoadFromDisk();
-  static void CompileShaders();
+  static void CompileShaders(bool background = false);
   static void CompilePShader(const PixelShaderUid& uid, PIXEL_SHADER_RENDER_MODE render_mode, std::function<void()> oncompilationfinished);
 
 };
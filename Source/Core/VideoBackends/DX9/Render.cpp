@@ -693,6 +693,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 
   g_texture_cache->Cleanup(frameCount);
   // Flip/present backbuffer to frontbuffer here
+  PacePresent();
   D3D::Present();
   // Enable configuration changes
   UpdateActiveConfig();
@@ -3,7 +3,6 @@
 // Refer to the license.txt file included.
 #include "Common/Common.h"
 #include "Common/FileUtil.h"
-#include "Common/LinearDiskCache.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
@@ -13,6 +12,7 @@
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/HLSLCompiler.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 
 #include "VideoBackends/DX9/D3DBase.h"
 #include "VideoBackends/DX9/D3DShader.h"
@@ -28,12 +28,13 @@ VertexShaderUid VertexShaderCache::s_last_uid;
 
 
 static HLSLAsyncCompiler *s_compiler;
+static ShaderUidTracker s_uid_tracker(SHADER_UID_VERTEX);
 #define MAX_SSAA_SHADERS 2
 
 static LPDIRECT3DVERTEXSHADER9 s_simple_vertex_shaders[MAX_SSAA_SHADERS];
 static LPDIRECT3DVERTEXSHADER9 s_clear_vertex_shader;
 
-LinearDiskCache<VertexShaderUid, u8> g_vs_disk_cache;
+ShaderCacheUtils::ShaderDiskCache<VertexShaderUid, u8> g_vs_disk_cache;
 
 LPDIRECT3DVERTEXSHADER9 VertexShaderCache::GetSimpleVertexShader(int level)
 {
@@ -122,6 +123,10 @@ void VertexShaderCache::Init()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(s_vshaders))
+  {
+    CompileShaders(true);
+  }
   s_last_entry = nullptr;
   SETSTAT(stats.numVertexShadersAlive, s_vshaders->size());
   SETSTAT(stats.numVertexShadersCreated, 0);
@@ -131,10 +136,7 @@ void VertexShaderCache::LoadFromDisk()
 {
   if (s_vshaders)
   {
-    s_vshaders->Persist([](VertexShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_vshaders);
     s_vshaders->Clear([](auto& item)
     {
       item.Destroy();
@@ -142,43 +144,44 @@ void VertexShaderCache::LoadFromDisk()
     delete s_vshaders;
     s_vshaders = nullptr;
   }
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  s_vshaders = ObjectUsageProfiler<VertexShaderUid, pKey_t, VertexShaderCache::VSCacheEntry, VertexShaderUid::ShaderUidHasher>::Create(
-    gameid,
-    VERTEXSHADERGEN_UID_VERSION,
-    "Ishiiruka.vs",
-    StringFromFormat("%s.vs", SConfig::GetInstance().GetGameID().c_str())
-  );
+  s_vshaders = ShaderCacheUtils::CreateUsageProfile<ObjectUsageProfiler<VertexShaderUid, pKey_t,
+    VertexShaderCache::VSCacheEntry, VertexShaderUid::ShaderUidHasher>>(
+    "vs", VERTEXSHADERGEN_UID_VERSION);
   std::string cache_filename = GetDiskShaderCacheFileName(API_D3D9, "vs", true, true);
   VertexShaderCacheInserter inserter;
   g_vs_disk_cache.OpenAndRead(cache_filename, inserter);
 }
 
-void VertexShaderCache::CompileShaders()
+// In the background only the most used shaders are queued, they are picked up by the draws once
+// the thread pool has compiled them.
+void VertexShaderCache::CompileShaders(bool background)
 {
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
+  HLSLAsyncCompiler::ScopedPriority priority(*s_compiler,
+    background ? CompilePriority::Predicted : CompilePriority::Precompile);
   size_t shader_count = 0;
-  s_vshaders->ForEachMostUsedByCategory(gameid,
+  ShaderCacheUtils::ForEachShaderToPrecompile(s_vshaders,
+    [](VSCacheEntry& entry)
+  {
+    return !entry.shader;
+  },
     [&](const VertexShaderUid& item, size_t total)
   {
-    VertexShaderUid newitem = item;
-    newitem.ClearHASH();
-    newitem.CalculateUIDHash();
-    CompileVShader(newitem);
+    CompileVShader(item);
+    if (background)
+      return;
     shader_count++;
     Host_UpdateProgressDialog(GetStringT("Compiling Vertex shaders...").c_str(),
       static_cast<int>(shader_count), static_cast<int>(total));
-  },
-    [](VSCacheEntry& entry)
-  {
-    return !entry.shader;
-  }, true);
+  }, background ? ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT : SIZE_MAX);
+  if (background)
+    return;
   s_compiler->WaitForFinish();
   Host_UpdateProgressDialog("", -1, -1);
 }
 
 void VertexShaderCache::Reload()
 {
+  s_compiler->CancelPendingUnits(CompilePriority::Predicted);
   s_compiler->WaitForFinish();
   g_vs_disk_cache.Sync();
   g_vs_disk_cache.Close();
@@ -196,10 +199,7 @@ void VertexShaderCache::Clear()
     {
       s_compiler->WaitForFinish();
     }
-    s_vshaders->Persist([](VertexShaderUid &uid) {
-      uid.ClearHASH();
-      uid.CalculateUIDHash();
-    });
+    ShaderCacheUtils::PersistUsageProfile(s_vshaders);
     s_vshaders->Clear([](auto& item)
     {
       item.Destroy();
@@ -213,6 +213,7 @@ void VertexShaderCache::Shutdown()
 {
   if (s_compiler)
   {
+    s_compiler->CancelPendingUnits(CompilePriority::Predicted);
     s_compiler->WaitForFinish();
   }
   for (int i = 0; i < MAX_SSAA_SHADERS; i++)
@@ -243,6 +244,8 @@ void VertexShaderCache::CompileVShader(const VertexShaderUid& uid)
     return;
   }
   ShaderCompilerWorkUnit *wunit = s_compiler->NewUnit();
+  // Compiled again the next time a draw needs it.
+  wunit->CancelHandler = [entry](ShaderCompilerWorkUnit*) { entry->initialized.clear(); };
   const ShaderHostConfig& hostconfig = ShaderHostConfig::GetCurrent();
   wunit->GenerateCodeHandler = [uid, hostconfig](ShaderCompilerWorkUnit* wunit)
   {
@@ -282,6 +285,12 @@ void VertexShaderCache::CompileVShader(const VertexShaderUid& uid)
 
 void VertexShaderCache::PrepareShader(u32 components, const XFMemory &xfr, const BPMemory &bpm)
 {
+  // Nothing the uid depends on changed since the last draw.
+  if (s_uid_tracker.IsUnchanged(components) && s_last_entry)
+  {
+    s_compiler->ProcCompilationResults();
+    return;
+  }
   VertexShaderUid uid;
   GetVertexShaderUID(uid, components, xfr, bpm);
   s_compiler->ProcCompilationResults();
@@ -296,6 +305,8 @@ void VertexShaderCache::PrepareShader(u32 components, const XFMemory &xfr, const
 
 bool VertexShaderCache::TestShader()
 {
+  ShaderCompileStats::StallTimer stall(!s_last_entry->compiled &&
+                                       !g_ActiveConfig.bFullAsyncShaderCompilation);
   int count = 0;
   while (!s_last_entry->compiled)
   {
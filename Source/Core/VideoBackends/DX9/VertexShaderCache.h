@@ -53,7 +53,7 @@ private:
 
   static void Clear();
   static void LoadFromDisk();
-  static void CompileShaders();
+  static void CompileShaders(bool background = false);
   static void CompileVShader(const VertexShaderUid& uid);
 };
 
@@ -86,15 +86,20 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsEarlyZ = true;
   g_Config.backend_info.bNeedBlendIndices = true;
   g_Config.backend_info.bSupportsOversizedViewports = false;
+  g_Config.backend_info.bSupportsPrimitiveRestart = false;
   g_Config.backend_info.bSupportsBBox = false;
   g_Config.backend_info.bSupportsGeometryShaders = false;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;
   g_Config.backend_info.bSupports3DVision = false;
   g_Config.backend_info.bSupportsPostProcessing = false;
   g_Config.backend_info.bSupportsClipControl = true;
   g_Config.backend_info.bSupportsSSAA = false;
   g_Config.backend_info.bSupportsTessellation = false;
   g_Config.backend_info.bSupportsGPUTextureDecoding = false;
+  g_Config.backend_info.bSupportsGPUTextureScaling = false;
+  g_Config.backend_info.bSupportsGPUMipmapGeneration = false;
   g_Config.backend_info.bSupportsComputeTextureEncoding = false;
+  g_Config.backend_info.bSupportsGPUVertexDecoding = false;
   g_Config.backend_info.bSupportsDepthClamp = false;
   g_Config.backend_info.bSupportsMultithreading = false;
   g_Config.backend_info.bSupportsValidationLayer = false;
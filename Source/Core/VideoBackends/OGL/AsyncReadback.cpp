@@ -0,0 +1,94 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/OGL/AsyncReadback.h"
+
+#include <algorithm>
+
+#include "VideoBackends/OGL/Render.h"
+
+namespace OGL
+{
+AsyncReadback::AsyncReadback(size_t ring_size)
+    : AsyncReadbackBase(ring_size), m_buffers(GetSlotCount())
+{
+}
+
+AsyncReadback::~AsyncReadback()
+{
+  Discard();
+  for (PackBuffer& buffer : m_buffers)
+  {
+    if (buffer.fence)
+      glDeleteSync(buffer.fence);
+    if (buffer.buffer)
+      glDeleteBuffers(1, &buffer.buffer);
+  }
+}
+
+bool AsyncReadback::CopyToSlot(size_t slot, uintptr_t texture,
+                               const MathUtil::Rectangle<int>& rect)
+{
+  PackBuffer& buffer = m_buffers[slot];
+  const u32 width = static_cast<u32>(rect.GetWidth());
+  const u32 height = static_cast<u32>(rect.GetHeight());
+  const u32 size = width * height * 4;
+  if (!buffer.buffer)
+    glGenBuffers(1, &buffer.buffer);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.buffer);
+  if (buffer.size != size)
+  {
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    buffer.size = size;
+  }
+  buffer.stride = width * 4;
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(texture));
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(rect.left, std::min(rect.top, rect.bottom), width, height, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  if (buffer.fence)
+    glDeleteSync(buffer.fence);
+  buffer.fence =
+      g_ogl_config.bSupportsGLSync ? glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : 0;
+  return true;
+}
+
+bool AsyncReadback::IsSlotReady(size_t slot)
+{
+  // Without fences there is no telling, mapping waits for the copy.
+  const PackBuffer& buffer = m_buffers[slot];
+  if (!buffer.fence)
+    return true;
+
+  GLint status = GL_UNSIGNALED;
+  glGetSynciv(buffer.fence, GL_SYNC_STATUS, 1, nullptr, &status);
+  return status == GL_SIGNALED;
+}
+
+const u8* AsyncReadback::MapSlot(size_t slot, u32* stride)
+{
+  PackBuffer& buffer = m_buffers[slot];
+  if (buffer.fence)
+  {
+    glDeleteSync(buffer.fence);
+    buffer.fence = 0;
+  }
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.buffer);
+  void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, buffer.size, GL_MAP_READ_BIT);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  *stride = buffer.stride;
+  return reinterpret_cast<const u8*>(data);
+}
+
+void AsyncReadback::UnmapSlot(size_t slot)
+{
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffers[slot].buffer);
+  glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+}  // namespace OGL
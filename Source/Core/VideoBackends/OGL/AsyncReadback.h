@@ -0,0 +1,41 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/GL/GLUtil.h"
+
+#include "VideoCommon/AsyncReadbackBase.h"
+
+namespace OGL
+{
+// Reads framebuffers back through pixel pack buffers. The texture passed to Queue is the
+// framebuffer object to read from, 0 for the window, and the rectangle is bottom-up like the
+// rows it returns.
+class AsyncReadback final : public AsyncReadbackBase
+{
+public:
+  explicit AsyncReadback(size_t ring_size);
+  ~AsyncReadback();
+
+protected:
+  bool CopyToSlot(size_t slot, uintptr_t texture, const MathUtil::Rectangle<int>& rect) override;
+  bool IsSlotReady(size_t slot) override;
+  const u8* MapSlot(size_t slot, u32* stride) override;
+  void UnmapSlot(size_t slot) override;
+
+private:
+  struct PackBuffer
+  {
+    GLuint buffer = 0;
+    u32 size = 0;
+    u32 stride = 0;
+    GLsync fence = 0;
+  };
+
+  std::vector<PackBuffer> m_buffers;
+};
+}  // namespace OGL
@@ -0,0 +1,47 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/OGL/FrameProfiler.h"
+
+namespace OGL
+{
+FrameProfiler::FrameProfiler()
+{
+  if (!GLExtensions::Supports("GL_ARB_timer_query"))
+    return;
+
+  m_queries.resize(FRAME_COUNT * MAX_TIMESTAMPS);
+  glGenQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+}
+
+FrameProfiler::~FrameProfiler()
+{
+  if (!m_queries.empty())
+    glDeleteQueries(static_cast<GLsizei>(m_queries.size()), m_queries.data());
+}
+
+void FrameProfiler::WriteTimestamp(size_t frame, u32 index)
+{
+  glQueryCounter(m_queries[frame * MAX_TIMESTAMPS + index], GL_TIMESTAMP);
+}
+
+bool FrameProfiler::ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns)
+{
+  const GLuint* queries = &m_queries[frame * MAX_TIMESTAMPS];
+
+  // The last timestamp of a frame is the last one to be available.
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(queries[count - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return false;
+
+  for (u32 i = 0; i < count; i++)
+  {
+    GLuint64 timestamp = 0;
+    glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &timestamp);
+    timestamps_ns[i] = timestamp;
+  }
+  return true;
+}
+}  // namespace OGL
@@ -0,0 +1,30 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/GL/GLUtil.h"
+
+#include "VideoCommon/FrameProfilerBase.h"
+
+namespace OGL
+{
+// Takes the timestamps of the frames with GL_ARB_timer_query, without them if it is missing.
+class FrameProfiler final : public FrameProfilerBase
+{
+public:
+  FrameProfiler();
+  ~FrameProfiler();
+
+protected:
+  bool SupportsTimestamps() const override { return !m_queries.empty(); }
+  void WriteTimestamp(size_t frame, u32 index) override;
+  bool ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns) override;
+
+private:
+  std::vector<GLuint> m_queries;
+};
+}  // namespace OGL
@@ -36,6 +36,9 @@ GLuint FramebufferManager::m_efbColorSwap; // for hot swap when reinterpreting E
 std::vector<GLuint> FramebufferManager::m_resolvedFramebuffer;
 GLuint FramebufferManager::m_resolvedColorTexture;
 GLuint FramebufferManager::m_resolvedDepthTexture;
+TargetRectangle FramebufferManager::m_resolvedDepthRect;
+u64 FramebufferManager::m_resolvedDepthGeneration;
+bool FramebufferManager::m_resolvedDepthValid;
 
 // reinterpret pixel format
 SHADER FramebufferManager::m_pixel_format_shaders[2];
@@ -53,6 +56,7 @@ FramebufferManager::FramebufferManager(int targetWidth, int targetHeight, int ms
   m_efbColorSwap = 0;
   m_resolvedColorTexture = 0;
   m_resolvedDepthTexture = 0;
+  m_resolvedDepthValid = false;
 
   m_targetWidth = targetWidth;
   m_targetHeight = targetHeight;
@@ -495,6 +499,16 @@ GLuint FramebufferManager::GetEFBDepthTexture(const EFBRectangle& sourceRc)
     TargetRectangle targetRc = g_renderer->ConvertEFBRectangle(sourceRc);
     targetRc.ClampUL(0, 0, m_targetWidth, m_targetHeight);
 
+    // Nothing was drawn since the same region was resolved.
+    if (m_resolvedDepthValid && m_resolvedDepthRect == targetRc &&
+        m_resolvedDepthGeneration == g_renderer->GetEFBGeneration())
+    {
+      return m_resolvedDepthTexture;
+    }
+    m_resolvedDepthValid = true;
+    m_resolvedDepthRect = targetRc;
+    m_resolvedDepthGeneration = g_renderer->GetEFBGeneration();
+
     // Resolve.
     for (unsigned int i = 0; i < m_EFBLayers; i++)
     {
@@ -132,6 +132,10 @@ private:
   static std::vector<GLuint> m_resolvedFramebuffer;
   static GLuint m_resolvedColorTexture;
   static GLuint m_resolvedDepthTexture;
+  // The region and EFB generation m_resolvedDepthTexture was last resolved at.
+  static TargetRectangle m_resolvedDepthRect;
+  static u64 m_resolvedDepthGeneration;
+  static bool m_resolvedDepthValid;
 
   // For pixel format draw
   static SHADER m_pixel_format_shaders[2];
@@ -15,6 +15,7 @@
 
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/TextureConfig.h"
+#include "VideoCommon/TextureUtil.h"
 
 namespace OGL
 {
@@ -221,8 +222,16 @@ void OGLTexture::Bind(u32 stage)
 {
   if (s_Textures[stage] != m_texId || !g_ActiveConfig.backend_info.bSupportsBindingLayout)
   {
-    glActiveTexture(GL_TEXTURE0 + stage);
-    glBindTexture(m_config.enviroment ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D_ARRAY, m_texId);
+    if (g_ogl_config.bSupportsMultiBind)
+    {
+      // Binds to the target of the texture without switching the active texture unit.
+      glBindTextures(stage, 1, &m_texId);
+    }
+    else
+    {
+      glActiveTexture(GL_TEXTURE0 + stage);
+      glBindTexture(m_config.enviroment ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D_ARRAY, m_texId);
+    }
     s_Textures[stage] = m_texId;
   }
 }
@@ -387,6 +396,36 @@ void OGLTexture::Load(const u8* src, u32 width, u32 height, u32 expanded_width,
   SetStage();
 }
 
+bool OGLTexture::GenerateMipmaps()
+{
+  if (compressed || m_config.enviroment || gl_siformat != GL_RGBA8 ||
+      !g_ogl_config.bSupportsTextureStorage || !g_ogl_config.bSupportsCopySubImage)
+  {
+    return false;
+  }
+
+  // The levels are generated in an sRGB copy, which filters them in linear space.
+  GLuint srgb_texture;
+  glGenTextures(1, &srgb_texture);
+  glActiveTexture(GL_TEXTURE9);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, srgb_texture);
+  glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_config.levels, GL_SRGB8_ALPHA8, m_config.width,
+                 m_config.height, m_config.layers);
+  glCopyImageSubData(m_texId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, srgb_texture, GL_TEXTURE_2D_ARRAY,
+                     0, 0, 0, 0, m_config.width, m_config.height, m_config.layers);
+  glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+  for (u32 level = 1; level < m_config.levels; level++)
+  {
+    glCopyImageSubData(srgb_texture, GL_TEXTURE_2D_ARRAY, level, 0, 0, 0, m_texId,
+                       GL_TEXTURE_2D_ARRAY, level, 0, 0, 0,
+                       TextureUtil::CalculateLevelSize(m_config.width, level),
+                       TextureUtil::CalculateLevelSize(m_config.height, level), m_config.layers);
+  }
+  glDeleteTextures(1, &srgb_texture);
+  SetStage();
+  return true;
+}
+
 void OGLTexture::DisableStage(u32 stage) {}
 
 void OGLTexture::SetStage()
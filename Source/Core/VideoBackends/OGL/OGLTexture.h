@@ -24,6 +24,7 @@ public:
     const MathUtil::Rectangle<int>& srcrect,
     const MathUtil::Rectangle<int>& dstrect) override;
   void Load(const u8* src, u32 width, u32 height, u32 expanded_width, u32 level, u32 layer) override;
+  bool GenerateMipmaps() override;
 
   GLuint GetRawTexIdentifier() const;
   GLuint GetFramebuffer() const;
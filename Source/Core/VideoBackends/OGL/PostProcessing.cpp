@@ -322,7 +322,6 @@ void OGLPostProcessingShader::Draw(PostProcessor* p,
       shader->gs_program->Bind();
     else
       shader->program->Bind();
-    std::vector<s32> InputsToRelease;
     for (size_t i = 0; i < pass.inputs.size(); i++)
     {
       const InputBinding& input = pass.inputs[i];
@@ -363,7 +362,6 @@ void OGLPostProcessingShader::Draw(PostProcessor* p,
         }
         else if (input.prev_texture >= 0)
         {
-          InputsToRelease.push_back(input.prev_texture);
           glBindTexture(GL_TEXTURE_2D_ARRAY, static_cast<GLuint>(m_passes[input.prev_texture].GetOutput()->GetInternalObject()));
           input_sizes[i] = m_passes[input.prev_texture].output_size;
         }
@@ -380,10 +378,6 @@ void OGLPostProcessingShader::Draw(PostProcessor* p,
     parent->MapAndUpdateUniformBuffer(input_sizes, output_rect, output_size, src_rect, src_size, src_layer, gamma);
     glViewport(output_rect.left, output_rect.bottom, output_rect.GetWidth(), output_rect.GetHeight());
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    for (auto passidx : InputsToRelease)
-    {
-      m_passes[passidx].ClenaupOutput();
-    }
   }
 
   // Unbind input textures after rendering, so that they can safely be used as outputs again.
@@ -409,10 +403,6 @@ void OGLPostProcessingShader::Draw(PostProcessor* p,
       parent->CopyTexture(dst, GetPrevColorFrame(0)->GetInternalObject(), output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer, false, true);
     }
     parent->CopyTexture(dst_rect, dst_texture, output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer);
-    if (!IsLastPassScaled())
-    {
-      final_pass.ClenaupOutput();
-    }
   }
 }
 
@@ -88,6 +88,11 @@ public:
 
 protected:
   std::unique_ptr<PostProcessingShader> CreateShader(PostProcessingShaderConfiguration* config) override;
+  // glBlitFramebuffer handles the window framebuffer, scaling and format conversion.
+  bool SupportsDirectScreenBlit() const override
+  {
+    return true;
+  }
   GLuint m_draw_framebuffer = 0;
   GLuint m_read_framebuffer = 0;
 
@@ -2,12 +2,15 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
+#include <cstring>
 #include <string>
 
 #include "Common/Align.h"
 #include "Common/Common.h"
 #include "Common/MathUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/Timer.h"
 
 #include "Core/Host.h"
 #include "Core/ConfigManager.h"
@@ -38,11 +41,17 @@ s32 ProgramShaderCache::s_ubo_align;
 u32 ProgramShaderCache::s_last_VAO = INVALID_VAO;
 
 static std::unique_ptr<StreamBuffer> s_buffer;
+// Offsets of the pixel, vertex and geometry shader constants, bound to the binding points 1 to 3.
+static std::array<GLintptr, 3> s_ubo_offsets;
 static int num_failures = 0;
 
-static LinearDiskCache<SHADERUID, u8> g_program_disk_cache;
-static LinearDiskCache<UBERSHADERUID, u8> g_uber_program_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<SHADERUID, u8> g_program_disk_cache;
+static ShaderCacheUtils::ShaderDiskCache<UBERSHADERUID, u8> g_uber_program_disk_cache;
 static GLuint CurrentProgram = 0;
+static constexpr u32 PROGRAM_UID_STAGES = SHADER_UID_PIXEL | SHADER_UID_VERTEX | SHADER_UID_GEOMETRY;
+static std::array<ShaderUidTracker, PIXEL_SHADER_RENDER_MODE::PSRM_DEPTH_ONLY + 1> s_uid_trackers = {
+    {ShaderUidTracker(PROGRAM_UID_STAGES), ShaderUidTracker(PROGRAM_UID_STAGES),
+     ShaderUidTracker(PROGRAM_UID_STAGES), ShaderUidTracker(PROGRAM_UID_STAGES)}};
 
 ProgramShaderCache::PCache* ProgramShaderCache::pshaders;
 ProgramShaderCache::UberPCache ProgramShaderCache::pushaders;
@@ -55,7 +64,7 @@ UBERSHADERUID ProgramShaderCache::last_uber_uid;
 
 std::condition_variable ProgramShaderCache::s_condition_var;
 std::mutex ProgramShaderCache::s_mutex;
-std::queue<std::unique_ptr<ProgramShaderCache::QueueEntry>> ProgramShaderCache::s_compilation_queue;
+std::deque<std::unique_ptr<ProgramShaderCache::QueueEntry>> ProgramShaderCache::s_compilation_queue;
 std::thread ProgramShaderCache::s_thread;
 
 static char s_glsl_header[4096] = "";
@@ -198,30 +207,49 @@ void ProgramShaderCache::UploadConstants()
   }
   if (mask)
   {
+    const std::array<GLsizeiptr, 3> sizes = {
+        {PixelShaderManager::ConstantBufferSize * sizeof(float),
+         VertexShaderManager::ConstantBufferSize * sizeof(float),
+         sizeof(GeometryShaderConstants)}};
     glBindBuffer(GL_UNIFORM_BUFFER, s_buffer->m_buffer);
     if (mask & 1)
     {
-      const u32 pixel_buffer_size = PixelShaderManager::ConstantBufferSize * sizeof(float);
-      glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer,
-        s_buffer->Stream(pixel_buffer_size, s_ubo_align, PixelShaderManager::GetBuffer()),
-        pixel_buffer_size);
+      s_ubo_offsets[0] = s_buffer->Stream(static_cast<u32>(sizes[0]), s_ubo_align,
+        PixelShaderManager::GetBuffer());
       PixelShaderManager::Clear();
     }
     if (mask & 2)
     {
-      const u32 vertex_buffer_size = VertexShaderManager::ConstantBufferSize * sizeof(float);
-      glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer,
-        s_buffer->Stream(vertex_buffer_size, s_ubo_align, VertexShaderManager::GetBuffer()),
-        vertex_buffer_size);
+      s_ubo_offsets[1] = s_buffer->Stream(static_cast<u32>(sizes[1]), s_ubo_align,
+        VertexShaderManager::GetBuffer());
       VertexShaderManager::Clear();
     }
     if (mask & 4)
     {
-      glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer,
-        s_buffer->Stream(sizeof(GeometryShaderConstants), s_ubo_align, &GeometryShaderManager::constants),
-        sizeof(GeometryShaderConstants));
+      s_ubo_offsets[2] = s_buffer->Stream(static_cast<u32>(sizes[2]), s_ubo_align,
+        &GeometryShaderManager::constants);
       GeometryShaderManager::Clear();
     }
+
+    if (g_ogl_config.bSupportsMultiBind)
+    {
+      // One call rebinds all three blocks, the unchanged ones to the ranges they already had.
+      const std::array<GLuint, 3> buffers = {{s_buffer->m_buffer, s_buffer->m_buffer,
+                                              s_buffer->m_buffer}};
+      glBindBuffersRange(GL_UNIFORM_BUFFER, 1, 3, buffers.data(), s_ubo_offsets.data(),
+        sizes.data());
+    }
+    else
+    {
+      for (u32 i = 0; i < 3; i++)
+      {
+        if (mask & (1 << i))
+        {
+          glBindBufferRange(GL_UNIFORM_BUFFER, i + 1, s_buffer->m_buffer, s_ubo_offsets[i],
+            sizes[i]);
+        }
+      }
+    }
     ADDSTAT(stats.thisFrame.bytesUniformStreamed, required_size);
   }
 }
@@ -231,7 +259,8 @@ GLuint ProgramShaderCache::GetCurrentProgram()
   return CurrentProgram;
 }
 
-std::future<bool> ProgramShaderCache::CompileShader(const SHADERUID& uid, SHADER& shader)
+std::future<bool> ProgramShaderCache::CompileShader(const SHADERUID& uid, SHADER& shader,
+                                                    const std::atomic<u32>* priority)
 {
   ShaderCode vcode;
   ShaderCode pcode;
@@ -246,7 +275,8 @@ std::future<bool> ProgramShaderCache::CompileShader(const SHADERUID& uid, SHADER
   INCSTAT(stats.numPixelShadersCreated);
   SETSTAT(stats.numPixelShadersAlive, static_cast<int>(pshaders->size()));
 
-  return CompileShader(shader, vcode.data(), pcode.data(), use_geometry ? gcode.data() : nullptr);
+  return CompileShader(shader, vcode.data(), pcode.data(), use_geometry ? gcode.data() : nullptr,
+                       priority);
 }
 
 SHADER* ProgramShaderCache::CompileUberShader(const UBERSHADERUID& uid)
@@ -285,20 +315,30 @@ SHADER* ProgramShaderCache::CompileUberShader(const UBERSHADERUID& uid)
 SHADER* ProgramShaderCache::SetShader(PIXEL_SHADER_RENDER_MODE render_mode, u32 components, PrimitiveType primitive_type, const GLVertexFormat* vertex_format)
 {
   SHADERUID uid;
-  GetShaderId(&uid, render_mode, components, primitive_type);
   if (UsingExclusiveUberShaders())
   {
+    GetShaderId(&uid, render_mode, components, primitive_type);
     pshaders->GetOrAdd(uid);
     return SetUberShader(primitive_type, components, vertex_format);
   }
 
   BindVertexFormat(vertex_format);
 
-  if (!(last_entry[render_mode] && uid == last_uid[render_mode]))
+  // Nothing the uid depends on changed since the last draw in this render mode.
+  if (s_uid_trackers[render_mode].IsUnchanged(components, static_cast<u32>(primitive_type)) &&
+      last_entry[render_mode])
+  {
+    uid = last_uid[render_mode];
+  }
+  else
   {
-    // Shader wasn't already set
-    last_entry[render_mode] = &pshaders->GetOrAdd(uid);
-    last_uid[render_mode] = uid;
+    GetShaderId(&uid, render_mode, components, primitive_type);
+    if (!(last_entry[render_mode] && uid == last_uid[render_mode]))
+    {
+      // Shader wasn't already set
+      last_entry[render_mode] = &pshaders->GetOrAdd(uid);
+      last_uid[render_mode] = uid;
+    }
   }
   PCacheEntry* entry = last_entry[render_mode];
 
@@ -310,8 +350,10 @@ SHADER* ProgramShaderCache::SetShader(PIXEL_SHADER_RENDER_MODE render_mode, u32
   if (entry->compile_started)
   {
     // Compilation is started but not finished
+    entry->hits.fetch_add(1, std::memory_order_relaxed);
     if (UsingHybridUberShaders())
     {
+      ShaderCompileStats::AddUberShaderDraw();
       return SetUberShader(primitive_type, components, vertex_format);
     }
     return nullptr;
@@ -320,9 +362,15 @@ SHADER* ProgramShaderCache::SetShader(PIXEL_SHADER_RENDER_MODE render_mode, u32
   // Shader was not previously in cache, start compilation
   entry->in_cache = false;
   entry->compile_started = true;
-  std::future<bool> future = CompileShader(uid, entry->shader);
+  std::future<bool> future;
+  {
+    // Without a compile thread the draw waits for the shader.
+    ShaderCompileStats::StallTimer stall;
+    future = CompileShader(uid, entry->shader, &entry->hits);
+  }
   if (UsingHybridUberShaders())
   {
+    ShaderCompileStats::AddUberShaderDraw();
     return SetUberShader(primitive_type, components, vertex_format);
   }
   if (g_ActiveConfig.bFullAsyncShaderCompilation)
@@ -356,21 +404,24 @@ SHADER* ProgramShaderCache::SetUberShader(PrimitiveType primitive_type, u32 comp
     return &last_uber_entry->shader;
   }
   last_uber_uid = uid;
+  ShaderCompileStats::StallTimer stall;
   return CompileUberShader(uid);
 }
 
 std::future<bool> ProgramShaderCache::CompileShader(
-    SHADER& shader, const char* vcode, const char* pcode, const char* gcode)
+    SHADER& shader, const char* vcode, const char* pcode, const char* gcode,
+    const std::atomic<u32>* priority)
 {
   if (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders())
   {
     auto queue_entry = std::make_unique<QueueEntry>(&shader, vcode, pcode, gcode);
+    queue_entry->priority = priority;
     std::future<bool> future = queue_entry->promise.get_future();
-    std::queue <int>::size_type size_before;
+    size_t size_before;
     {
       std::lock_guard<std::mutex> lock(s_mutex);
       size_before = s_compilation_queue.size();
-      s_compilation_queue.push(std::move(queue_entry));
+      s_compilation_queue.push_back(std::move(queue_entry));
     }
     if (size_before == 0) {
       s_condition_var.notify_all();
@@ -379,7 +430,10 @@ std::future<bool> ProgramShaderCache::CompileShader(
   }
 
   std::promise<bool> promise;
+  const u64 start = Common::Timer::GetTimeUs();
   promise.set_value(CompileShaderWorker(shader, vcode, pcode, gcode));
+  ShaderCompileStats::AddCompile(ShaderCompileStats::Stage::Program, pcode, std::strlen(pcode),
+                                 Common::Timer::GetTimeUs() - start);
   return promise.get_future();
 }
 
@@ -470,11 +524,11 @@ bool ProgramShaderCache::CompileComputeShader(SHADER& shader, const std::string&
   {
     auto queue_entry = std::make_unique<QueueEntry>(&shader, code);
     std::future<bool> future = queue_entry->promise.get_future();
-    std::queue <int>::size_type size_before;
+    size_t size_before;
     {
       std::lock_guard<std::mutex> lock(s_mutex);
       size_before = s_compilation_queue.size();
-      s_compilation_queue.push(std::move(queue_entry));
+      s_compilation_queue.push_back(std::move(queue_entry));
     }
     if (size_before == 0) {
       s_condition_var.notify_all();
@@ -620,6 +674,31 @@ GLuint ProgramShaderCache::CompileSingleShader(GLuint type, const char* code)
   return result;
 }
 
+// Called with s_mutex held. Entries without a priority are waited on or are ubershaders, so they
+// go first; the thread is only stopped once everything queued before the request is done.
+std::unique_ptr<ProgramShaderCache::QueueEntry> ProgramShaderCache::PopHighestPriorityEntry()
+{
+  auto best = s_compilation_queue.begin();
+  u32 best_priority = 0;
+  for (auto it = s_compilation_queue.begin(); it != s_compilation_queue.end(); ++it)
+  {
+    const QueueEntry& entry = **it;
+    u32 priority = UINT32_MAX;
+    if (entry.kill_thread)
+      priority = 0;
+    else if (entry.priority)
+      priority = entry.priority->load(std::memory_order_relaxed);
+    if (priority > best_priority)
+    {
+      best = it;
+      best_priority = priority;
+    }
+  }
+  std::unique_ptr<QueueEntry> entry = std::move(*best);
+  s_compilation_queue.erase(best);
+  return entry;
+}
+
 void ProgramShaderCache::CompileThreadWorker(std::unique_ptr<cInterfaceBase> shared_context)
 {
   if (!shared_context->MakeCurrent())
@@ -638,8 +717,7 @@ void ProgramShaderCache::CompileThreadWorker(std::unique_ptr<cInterfaceBase> sha
       {
         s_condition_var.wait(lock, []{return !s_compilation_queue.empty();});
       }
-      entry = std::move(s_compilation_queue.front());
-      s_compilation_queue.pop();
+      entry = PopHighestPriorityEntry();
     }
     if (entry->kill_thread)
     {
@@ -653,8 +731,11 @@ void ProgramShaderCache::CompileThreadWorker(std::unique_ptr<cInterfaceBase> sha
     else
     {
       const char* gcode = entry->gcode.empty() ? nullptr : entry->gcode.c_str();
+      const u64 start = Common::Timer::GetTimeUs();
       success =
           CompileShaderWorker(*entry->shader, entry->vcode.c_str(), entry->pcode.c_str(), gcode);
+      ShaderCompileStats::AddCompile(ShaderCompileStats::Stage::Program, entry->pcode.data(),
+                                     entry->pcode.size(), Common::Timer::GetTimeUs() - start);
     }
     entry->promise.set_value(success);
   }
@@ -712,6 +793,7 @@ void ProgramShaderCache::Init()
   s_buffer.reset();
 
   s_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, s_ubo_buffer_size * 2048);
+  s_ubo_offsets = {};
 
   LoadFromDisk();
 
@@ -737,6 +819,12 @@ void ProgramShaderCache::Init()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(pshaders) &&
+           !UsingExclusiveUberShaders() &&
+           (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders()))
+  {
+    CompileShaders(true);
+  }
   CurrentProgram = 0;
   last_entry.fill(nullptr);
   last_uber_entry = nullptr;
@@ -751,13 +839,8 @@ void ProgramShaderCache::LoadFromDisk()
   {
     Shutdown(true);
   }
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  pshaders = PCache::Create(
-    gameid,
-    PIXELSHADERGEN_UID_VERSION * VERTEXSHADERGEN_UID_VERSION * GEOMETRYSHADERGEN_UID_VERSION,
-    "Ishiiruka.ps.OGL",
-    StringFromFormat("%s.ps.OGL", SConfig::GetInstance().GetGameID().c_str())
-  );
+  pshaders = ShaderCacheUtils::CreateUsageProfile<PCache>("ps.OGL",
+    PIXELSHADERGEN_UID_VERSION * VERTEXSHADERGEN_UID_VERSION * GEOMETRYSHADERGEN_UID_VERSION);
 
   // Read our shader cache, only if supported
   if (g_ogl_config.bSupportsGLSLCache)
@@ -825,13 +908,7 @@ void ProgramShaderCache::CompileUberShaders()
             uid.guid = guid;
             uid.vuid = vuid;
             uid.puid = puid;
-            uid.guid.ClearHASH();
-            uid.vuid.ClearHASH();
-            uid.puid.ClearHASH();
-            uid.guid.CalculateUIDHash();
-            uid.vuid.CalculateUIDHash();
-            uid.puid.CalculateUIDHash();
-            uid.CalculateHash();
+            ShaderCacheUtils::NormalizeUid(uid);
             CompileUberShader(uid);
             shader_count++;
             Host_UpdateProgressDialog(GetStringT("Compiling Uber Shaders...").c_str(),
@@ -844,42 +921,40 @@ void ProgramShaderCache::CompileUberShaders()
   Host_UpdateProgressDialog("", -1, -1);
 }
 
-void ProgramShaderCache::CompileShaders()
+// In the background only the most used programs are queued on the compilation thread, the draws
+// pick them up once they are linked.
+void ProgramShaderCache::CompileShaders(bool background)
 {
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
   size_t shader_count = 0;
-  pshaders->ForEachMostUsedByCategory(gameid,
-    [&](const SHADERUID& it, size_t total)
+  ShaderCacheUtils::ForEachShaderToPrecompile(pshaders,
+    [](PCacheEntry& entry)
+  {
+    return !entry.shader.glprogid;
+  },
+    [&](const SHADERUID& item, size_t total)
   {
-    SHADERUID item = it;
-    item.puid.ClearHASH();
-    item.puid.CalculateUIDHash();
-    item.vuid.ClearHASH();
-    item.vuid.CalculateUIDHash();
-    item.guid.ClearHASH();
-    item.guid.CalculateUIDHash();
-    item.CalculateHash();
     const pixel_shader_uid_data& uid_data = item.puid.GetUidData();
     shader_count++;
     if (!uid_data.bounding_box || g_ActiveConfig.backend_info.bSupportsBBox)
     {
-      Host_UpdateProgressDialog(GetStringT("Compiling Shaders...").c_str(),
-        static_cast<int>(shader_count), static_cast<int>(total));
+      if (!background)
+      {
+        Host_UpdateProgressDialog(GetStringT("Compiling Shaders...").c_str(),
+          static_cast<int>(shader_count), static_cast<int>(total));
+      }
 
       PCacheEntry& newentry = pshaders->GetOrAdd(item);
       if (newentry.compile_started)
         return;
       newentry.in_cache = false;
       newentry.compile_started = true;
-      CompileShader(item, newentry.shader).wait();
+      std::future<bool> future = CompileShader(item, newentry.shader);
+      if (!background)
+        future.wait();
     }
-  },
-    [](PCacheEntry& entry)
-  {
-    return !entry.shader.glprogid;
-  }
-  , true);
-  Host_UpdateProgressDialog("", -1, -1);
+  }, background ? ShaderCacheUtils::PREDICTIVE_PRECOMPILE_COUNT : SIZE_MAX);
+  if (!background)
+    Host_UpdateProgressDialog("", -1, -1);
 }
 
 void ProgramShaderCache::Shutdown(bool shadersonly)
@@ -887,11 +962,11 @@ void ProgramShaderCache::Shutdown(bool shadersonly)
   if (!shadersonly && (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders()))
   {
     auto queue_entry = std::make_unique<QueueEntry>();
-    std::queue <int>::size_type size_before;
+    size_t size_before;
     {
       std::lock_guard<std::mutex> lock(s_mutex);
       size_before = s_compilation_queue.size();
-      s_compilation_queue.push(std::move(queue_entry));
+      s_compilation_queue.push_back(std::move(queue_entry));
     }
     if (size_before == 0) {
       s_condition_var.notify_all();
@@ -899,15 +974,7 @@ void ProgramShaderCache::Shutdown(bool shadersonly)
   }
 
   InvalidateVertexFormat();
-  pshaders->Persist([](SHADERUID &uid) {
-    uid.guid.ClearHASH();
-    uid.vuid.ClearHASH();
-    uid.puid.ClearHASH();
-    uid.guid.CalculateUIDHash();
-    uid.vuid.CalculateUIDHash();
-    uid.puid.CalculateUIDHash();
-    uid.CalculateHash();
-  });
+  ShaderCacheUtils::PersistUsageProfile(pshaders);
   // store all shaders in cache on disk
   if (g_ogl_config.bSupportsGLSLCache)
   {
@@ -1003,6 +1070,12 @@ void ProgramShaderCache::Reload()
   {
     CompileShaders();
   }
+  else if (ShaderCacheUtils::ShouldPrecompileInBackground(pshaders) &&
+           !UsingExclusiveUberShaders() &&
+           (g_ActiveConfig.bFullAsyncShaderCompilation || UsingHybridUberShaders()))
+  {
+    CompileShaders(true);
+  }
 }
 
 void ProgramShaderCache::CreateHeader()
@@ -1018,6 +1091,14 @@ void ProgramShaderCache::CreateHeader()
   default: SupportedESPointSize = ""; break;
   }
 
+  std::string SupportedVSLayerOutput;
+  switch (g_ogl_config.SupportedVSLayerOutput)
+  {
+  case 1: SupportedVSLayerOutput = "#extension GL_ARB_shader_viewport_layer_array : enable"; break;
+  case 2: SupportedVSLayerOutput = "#extension GL_AMD_vertex_shader_layer : enable"; break;
+  default: SupportedVSLayerOutput = ""; break;
+  }
+
   switch (g_ogl_config.SupportedESTextureBuffer)
   {
   case ES_TEXBUF_TYPE::TEXBUF_EXT:
@@ -1059,6 +1140,7 @@ void ProgramShaderCache::CreateHeader()
     "%s\n" // Varying location
     "%s\n" // storage buffer
     "%s\n" // shader5
+    "%s\n" // vertex shader layer
     "%s\n" // SSAA
     "%s\n" // Geometry point size
     "%s\n" // AEP
@@ -1127,6 +1209,7 @@ void ProgramShaderCache::CreateHeader()
     , "#define VARYING_LOCATION(x)\n"
     , !is_glsles && g_ActiveConfig.backend_info.bSupportsFragmentStoresAndAtomics ? "#extension GL_ARB_shader_storage_buffer_object : enable" : ""
     , !is_glsles && g_ActiveConfig.backend_info.bSupportsGSInstancing ? "#extension GL_ARB_gpu_shader5 : enable" : ""
+    , SupportedVSLayerOutput.c_str()
     , SupportedESPointSize.c_str()
     , g_ogl_config.bSupportsAEP ? "#extension GL_ANDROID_extension_pack_es31a : enable" : ""
     , v < GLSL_140 && g_ActiveConfig.backend_info.bSupportsPaletteConversion ? "#extension GL_ARB_texture_buffer_object : enable" : ""
@@ -4,22 +4,23 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <tuple>
 #include <unordered_map>
 
 #include "Common/GL/GLInterfaceBase.h"
 #include "Common/GL/GLUtil.h"
-#include "Common/LinearDiskCache.h"
 
 #include "VideoCommon/GeometryShaderGen.h"
 #include "VideoCommon/ObjectUsageProfiler.h"
 #include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoCommon/UberShaderCommon.h"
 #include "VideoCommon/UberShaderPixel.h"
 #include "VideoCommon/UberShaderVertex.h"
@@ -44,6 +45,20 @@ public:
     GeometryShaderUid::ShaderUidHasher gshasher;
     hash = vshasher(vuid) ^ pshasher(puid) ^ gshasher(guid);
   }
+  // Same interface as the stage uids, so the VideoCommon shader cache helpers accept it.
+  void ClearHASH()
+  {
+    vuid.ClearHASH();
+    puid.ClearHASH();
+    guid.ClearHASH();
+  }
+  void CalculateUIDHash()
+  {
+    vuid.CalculateUIDHash();
+    puid.CalculateUIDHash();
+    guid.CalculateUIDHash();
+    CalculateHash();
+  }
   bool operator <(const SHADERUID& r) const
   {
     return std::tie(vuid, puid, guid) < std::tie(r.vuid, r.puid, r.guid);
@@ -77,6 +92,20 @@ public:
     GeometryShaderUid::ShaderUidHasher gshasher;
     hash = vshasher(vuid) ^ pshasher(puid) ^ gshasher(guid);
   }
+  // Same interface as the stage uids, so the VideoCommon shader cache helpers accept it.
+  void ClearHASH()
+  {
+    vuid.ClearHASH();
+    puid.ClearHASH();
+    guid.ClearHASH();
+  }
+  void CalculateUIDHash()
+  {
+    vuid.CalculateUIDHash();
+    puid.CalculateUIDHash();
+    guid.CalculateUIDHash();
+    CalculateHash();
+  }
   bool operator <(const UBERSHADERUID& r) const
   {
     return std::tie(vuid, puid, guid) < std::tie(r.vuid, r.puid, r.guid);
@@ -127,11 +156,13 @@ public:
   static void BindVertexFormat(const GLVertexFormat* vertex_format);
   static void InvalidateVertexFormat();
   static void BindLastVertexFormat();
-  static std::future<bool> CompileShader(const SHADERUID& uid, SHADER& shader);
+  // Programs with a priority are compiled busiest first, the ones without go ahead of all of them.
+  static std::future<bool> CompileShader(const SHADERUID& uid, SHADER& shader,
+                                         const std::atomic<u32>* priority = nullptr);
   static SHADER* CompileUberShader(const UBERSHADERUID& uid);
   static void GetShaderId(SHADERUID *uid, PIXEL_SHADER_RENDER_MODE render_mode, u32 components, PrimitiveType primitive_type);
 
-  static std::future<bool> CompileShader(SHADER &shader, const char* vcode, const char* pcode, const char* gcode = nullptr);
+  static std::future<bool> CompileShader(SHADER &shader, const char* vcode, const char* pcode, const char* gcode = nullptr, const std::atomic<u32>* priority = nullptr);
   static bool CompileComputeShader(SHADER& shader, const std::string& code);
   static GLuint CompileSingleShader(GLuint type, const char *code);
   static void UploadConstants();
@@ -151,6 +182,8 @@ private:
     SHADER shader;
     bool in_cache;
     bool compile_started = false;
+    // Draws that fell back to the ubershader while this one was compiling.
+    std::atomic<u32> hits{};
 
     void Destroy()
     {
@@ -175,6 +208,7 @@ private:
     std::string pcode;
     std::string gcode;
     std::string ccode;
+    const std::atomic<u32>* priority = nullptr;
     bool compute_shader = false;
     bool kill_thread = false;
   };
@@ -183,11 +217,12 @@ private:
   typedef std::unordered_map<UBERSHADERUID, PCacheEntry, UBERSHADERUID::ShaderUidHasher> UberPCache;
 
   static void LoadFromDisk();
-  static void CompileShaders();
+  static void CompileShaders(bool background = false);
   static bool CompileShaderWorker(
       SHADER& shader, const char* vcode, const char* pcode, const char* gcode);
   static bool CompileComputeShaderWorker(SHADER& shader, const std::string& code);
   static void CompileThreadWorker(std::unique_ptr<cInterfaceBase> shared_context);
+  static std::unique_ptr<QueueEntry> PopHighestPriorityEntry();
   static void CompileUberShaders();
 
   class ProgramShaderCacheInserter : public LinearDiskCacheReader<SHADERUID, u8>
@@ -219,7 +254,7 @@ private:
 
   static std::condition_variable s_condition_var;
   static std::mutex s_mutex;
-  static std::queue<std::unique_ptr<QueueEntry>> s_compilation_queue;
+  static std::deque<std::unique_ptr<QueueEntry>> s_compilation_queue;
   static std::thread s_thread;
 };
 
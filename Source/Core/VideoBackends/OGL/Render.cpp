@@ -23,6 +23,7 @@
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/Core.h"
 
+#include "VideoBackends/OGL/AsyncReadback.h"
 #include "VideoBackends/OGL/BoundingBox.h"
 #include "VideoBackends/OGL/FramebufferManager.h"
 #include "VideoBackends/OGL/OGLTexture.h"
@@ -481,6 +482,10 @@ Renderer::Renderer()
   g_Config.backend_info.bSupportsFragmentStoresAndAtomics =
       GLExtensions::Supports("GL_ARB_shader_storage_buffer_object");
   g_Config.backend_info.bSupportsGSInstancing = GLExtensions::Supports("GL_ARB_gpu_shader5");
+  g_ogl_config.SupportedVSLayerOutput =
+      GLExtensions::Supports("GL_ARB_shader_viewport_layer_array") ?
+          1 :
+          GLExtensions::Supports("GL_AMD_vertex_shader_layer") ? 2 : 0;
   g_Config.backend_info.bSupportsSSAA = GLExtensions::Supports("GL_ARB_gpu_shader5") &&
                                         GLExtensions::Supports("GL_ARB_sample_shading");
   g_Config.backend_info.bSupportsGeometryShaders =
@@ -532,10 +537,12 @@ Renderer::Renderer()
   g_ogl_config.bSupportsImageLoadStore = GLExtensions::Supports("GL_ARB_shader_image_load_store");
   g_ogl_config.bSupportsConservativeDepth = GLExtensions::Supports("GL_ARB_conservative_depth");
   g_ogl_config.bSupportsAniso = GLExtensions::Supports("GL_EXT_texture_filter_anisotropic");
+  g_ogl_config.bSupportsMultiBind = GLExtensions::Supports("GL_ARB_multi_bind");
   g_Config.backend_info.bSupportsComputeShaders = GLExtensions::Supports("GL_ARB_compute_shader");
 
   if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
   {
+    g_ogl_config.SupportedVSLayerOutput = 0;
     g_ogl_config.SupportedESPointSize =
         GLExtensions::Supports("GL_OES_geometry_point_size") ?
             1 :
@@ -683,6 +690,10 @@ Renderer::Renderer()
     g_ogl_config.bSupportsAEP = false;
   }
 
+  // Stereo is drawn as two instances which select their layer in the vertex shader.
+  g_Config.backend_info.bSupportsVSLayerOutput = g_ogl_config.SupportedVSLayerOutput > 0 &&
+                                                 g_Config.backend_info.bSupportsGeometryShaders;
+
   // Either method can do early-z tests. See PixelShaderGen for details.
   g_Config.backend_info.bSupportsEarlyZ =
       g_ogl_config.bSupportsImageLoadStore || g_ogl_config.bSupportsConservativeDepth;
@@ -697,6 +708,12 @@ Renderer::Renderer()
   g_Config.backend_info.bSupportsGPUTextureDecoding =
       g_Config.backend_info.bSupportsPaletteConversion &&
       g_Config.backend_info.bSupportsComputeShaders && g_ogl_config.bSupportsImageLoadStore;
+  // The texture scaling shaders read the decoded textures from the same buffer.
+  g_Config.backend_info.bSupportsGPUTextureScaling =
+      g_Config.backend_info.bSupportsGPUTextureDecoding;
+  // Mipmaps are generated in an sRGB copy of the texture.
+  g_Config.backend_info.bSupportsGPUMipmapGeneration =
+      g_ogl_config.bSupportsTextureStorage && g_ogl_config.bSupportsCopySubImage;
 
   if (g_ogl_config.bSupportsDebug)
   {
@@ -785,8 +802,8 @@ Renderer::Renderer()
 
 Renderer::~Renderer()
 {
-  FlushFrameDump();
-  FinishFrameData();
+  if (m_frame_dump_readback)
+    EndFrameDumping();
   DestroyFrameDumpResources();
 }
 
@@ -1342,11 +1359,11 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
   DrawFrame(flipped_trc, rc, xfbAddr, xfbSourceList, xfbCount, 0, dst_size, fbWidth, fbStride,
             fbHeight, Gamma);
 
-  // The FlushFrameDump call here is necessary even after frame dumping is stopped.
-  // If left out, screenshots are "one frame" behind, as an extra frame is dumped and buffered.
-  FlushFrameDump();
   if (IsFrameDumping())
   {
+    if (!m_frame_dump_readback)
+      m_frame_dump_readback = std::make_unique<AsyncReadback>(FRAME_DUMP_BUFFERED_FRAMES);
+
     // Currently, we only use the off-screen buffer as a frame dump source if full-resolution
     // frame dumping is enabled, saving the need for an extra copy. In the future, this could
     // be extended to be used for surfaceless contexts as well.
@@ -1358,10 +1375,15 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
     }
     else
     {
-      glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
-      DumpFrame(flipped_trc, ticks);
+      DumpFrame(flipped_trc, 0, ticks);
     }
   }
+  else if (m_frame_dump_readback)
+  {
+    // The frames still being read back have to be written even after frame dumping stopped,
+    // otherwise screenshots would be a frame behind.
+    EndFrameDumping();
+  }
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
   // Finish up the current frame, print some stats
 
@@ -1458,6 +1480,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 #endif
 
   // Copy the rendered frame to the real window
+  PacePresent();
   GLInterface->Swap();
 
   // Clear framebuffer
@@ -1647,58 +1670,24 @@ void Renderer::DrawRealXFB(const TargetRectangle& target_rc,
   }
 }
 
-void Renderer::FlushFrameDump()
+void Renderer::EndFrameDumping()
 {
-  if (!m_last_frame_exported)
-    return;
-
+  // The dump thread has to be done with the last frame before its buffer goes away.
+  m_frame_dump_readback->Flush();
   FinishFrameData();
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_frame_dumping_pbo[0]);
-  m_frame_pbo_is_mapped[0] = true;
-  void* data = glMapBufferRange(
-      GL_PIXEL_PACK_BUFFER, 0, m_last_frame_width[0] * m_last_frame_height[0] * 4, GL_MAP_READ_BIT);
-  DumpFrameData(reinterpret_cast<u8*>(data), m_last_frame_width[0], m_last_frame_height[0],
-                m_last_frame_width[0] * 4, m_last_frame_state, true);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-  m_last_frame_exported = false;
+  m_frame_dump_readback.reset();
 }
 
-void Renderer::DumpFrame(const TargetRectangle& flipped_trc, u64 ticks)
+void Renderer::DumpFrame(const TargetRectangle& flipped_trc, GLuint framebuffer, u64 ticks)
 {
-  if (!m_frame_dumping_pbo[0])
-  {
-    glGenBuffers(2, m_frame_dumping_pbo.data());
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_frame_dumping_pbo[0]);
-  }
-  else
-  {
-    FlushFrameDump();
-    std::swap(m_frame_dumping_pbo[0], m_frame_dumping_pbo[1]);
-    std::swap(m_frame_pbo_is_mapped[0], m_frame_pbo_is_mapped[1]);
-    std::swap(m_last_frame_width[0], m_last_frame_width[1]);
-    std::swap(m_last_frame_height[0], m_last_frame_height[1]);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_frame_dumping_pbo[0]);
-    if (m_frame_pbo_is_mapped[0])
-      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-    m_frame_pbo_is_mapped[0] = false;
-  }
-
-  if (flipped_trc.GetWidth() != m_last_frame_width[0] ||
-      flipped_trc.GetHeight() != m_last_frame_height[0])
-  {
-    m_last_frame_width[0] = flipped_trc.GetWidth();
-    m_last_frame_height[0] = flipped_trc.GetHeight();
-    glBufferData(GL_PIXEL_PACK_BUFFER, m_last_frame_width[0] * m_last_frame_height[0] * 4, nullptr,
-                 GL_STREAM_READ);
-  }
-
-  m_last_frame_state = AVIDump::FetchState(ticks);
-  m_last_frame_exported = true;
-
-  glPixelStorei(GL_PACK_ALIGNMENT, 1);
-  glReadPixels(flipped_trc.left, flipped_trc.bottom, m_last_frame_width[0], m_last_frame_height[0],
-               GL_RGBA, GL_UNSIGNED_BYTE, 0);
-  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  // Write the frames the GPU finished since, then queue a readback of this one.
+  m_frame_dump_readback->Poll();
+  const AVIDump::Frame state = AVIDump::FetchState(ticks);
+  m_frame_dump_readback->Queue(
+      framebuffer, flipped_trc, [this, state](const u8* data, u32 width, u32 height, u32 stride) {
+        DumpFrameData(data, static_cast<int>(width), static_cast<int>(height),
+                      static_cast<int>(stride), state, true);
+      });
 }
 
 void Renderer::DumpFrameUsingFBO(const EFBRectangle& source_rc, u32 xfb_addr,
@@ -1724,9 +1713,8 @@ void Renderer::DumpFrameUsingFBO(const EFBRectangle& source_rc, u32 xfb_addr,
   TargetSize dst_size = {(int)render_width, (int)render_height};
   DrawFrame(render_rc, source_rc, xfb_addr, xfb_sources, xfb_count, m_frame_dump_render_texture,
             dst_size, fb_width, fb_stride, fb_height, 1.0);
-  glBindFramebuffer(GL_READ_FRAMEBUFFER, m_frame_dump_render_framebuffer);
-  // Copy frame to output buffer. This assumes that GL_FRAMEBUFFER has been set.
-  DumpFrame(render_rc, ticks);
+  // Copy frame to output buffer.
+  DumpFrame(render_rc, m_frame_dump_render_framebuffer, ticks);
 
   // Restore state after drawing. This isn't the game state, it's the state set by ResetAPIState.
   FramebufferManager::SetFramebuffer(0);
@@ -1774,8 +1762,6 @@ void Renderer::DestroyFrameDumpResources()
     glDeleteFramebuffers(1, &m_frame_dump_render_framebuffer);
   if (m_frame_dump_render_texture)
     glDeleteTextures(1, &m_frame_dump_render_texture);
-  if (m_frame_dumping_pbo[0])
-    glDeleteBuffers(2, m_frame_dumping_pbo.data());
 }
 
 // ALWAYS call RestoreAPIState for each ResetAPIState call you're doing
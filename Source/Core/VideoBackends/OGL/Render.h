@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <string>
 #include "VideoCommon/RenderBase.h"
 
@@ -12,6 +13,8 @@ struct XFBSourceBase;
 
 namespace OGL
 {
+class AsyncReadback;
+
 void ClearEFBCache();
 
 enum GLSL_VERSION
@@ -49,6 +52,7 @@ struct VideoConfig
   bool bSupportsDebug;
   bool bSupportsCopySubImage;
   u8 SupportedESPointSize;
+  u8 SupportedVSLayerOutput;
   ES_TEXBUF_TYPE SupportedESTextureBuffer;
   bool bSupportsTextureStorage;
   bool bSupports2DTextureStorageMultisample;
@@ -56,6 +60,7 @@ struct VideoConfig
   bool bSupportsConservativeDepth;
   bool bSupportsImageLoadStore;
   bool bSupportsAniso;
+  bool bSupportsMultiBind;
 
   const char* gl_vendor;
   const char* gl_renderer;
@@ -149,8 +154,9 @@ private:
   void BlitScreen(const TargetRectangle& dst_rect, const TargetRectangle& src_rect, const  TargetSize& src_size, GLuint src_texture,
     GLuint src_depth_texture, const TargetSize& dst_size, GLuint dst_texture, float gamma);
 
-  void FlushFrameDump();
-  void DumpFrame(const TargetRectangle& flipped_trc, u64 ticks);
+  // Writes the frames still being read back to the frame dump and stops reading back.
+  void EndFrameDumping();
+  void DumpFrame(const TargetRectangle& flipped_trc, GLuint framebuffer, u64 ticks);
   void DumpFrameUsingFBO(const EFBRectangle& source_rc, u32 xfb_addr,
     const XFBSourceBase* const* xfb_sources, u32 xfb_count, u32 fb_width,
     u32 fb_stride, u32 fb_height, u64 ticks);
@@ -163,12 +169,9 @@ private:
   u32 m_frame_dump_render_texture_width = 0;
   u32 m_frame_dump_render_texture_height = 0;
 
-  // avi dumping state to delay one frame
-  std::array<u32, 2> m_frame_dumping_pbo = {};
-  std::array<bool, 2> m_frame_pbo_is_mapped = {};
-  std::array<int, 2> m_last_frame_width = {};
-  std::array<int, 2> m_last_frame_height = {};
-  bool m_last_frame_exported = false;
-  AVIDump::Frame m_last_frame_state;
+  // Frames are read back a few frames later, once the GPU is done with them. Only exists while
+  // frame dumping.
+  static const size_t FRAME_DUMP_BUFFERED_FRAMES = 2;
+  std::unique_ptr<AsyncReadback> m_frame_dump_readback;
 };
 }
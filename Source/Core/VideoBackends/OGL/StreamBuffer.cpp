@@ -221,6 +221,7 @@ public:
   BufferStorage(u32 type, u32 size, bool _coherent = false) : StreamBuffer(type, size), coherent(_coherent)
   {
     CreateFences();
+    m_persistent = true;
     glBindBuffer(m_buffertype, m_buffer);
 
     // PERSISTANT_BIT to make sure that the buffer can be used while mapped
@@ -251,6 +252,19 @@ public:
     return iter;
   }
 
+  std::pair<u8*, u32> Map(u32 size) override
+  {
+    AllocMemory(size);
+    return std::make_pair(m_pointer + m_iterator, m_iterator);
+  }
+
+  void Unmap(u32 used_size) override
+  {
+    if (!coherent && used_size)
+      glFlushMappedBufferRange(m_buffertype, m_iterator, used_size);
+    m_iterator += used_size;
+  }
+
   u8* m_pointer;
   const bool coherent;
 };
@@ -268,6 +282,7 @@ public:
   PinnedMemory(u32 type, u32 size) : StreamBuffer(type, size, ALIGN_PINNED_MEMORY)
   {
     CreateFences();
+    m_persistent = true;
     m_pointer = static_cast<u8*>(Common::AllocateAlignedMemory(m_size, ALIGN_PINNED_MEMORY));
     glBindBuffer(GL_EXTERNAL_VIRTUAL_MEMORY_BUFFER_AMD, m_buffer);
     glBufferData(GL_EXTERNAL_VIRTUAL_MEMORY_BUFFER_AMD, m_size, m_pointer, GL_STREAM_COPY);
@@ -293,6 +308,17 @@ public:
     return iter;
   }
 
+  std::pair<u8*, u32> Map(u32 size) override
+  {
+    AllocMemory(size);
+    return std::make_pair(m_pointer + m_iterator, m_iterator);
+  }
+
+  void Unmap(u32 used_size) override
+  {
+    m_iterator += used_size;
+  }
+
   u8* m_pointer;
   static constexpr u32 ALIGN_PINNED_MEMORY = 4096;
 };
@@ -43,6 +43,28 @@ public:
     }
     return Stream(size, src);
   }
+  /* Buffers that stay mapped while the GPU reads from them can also be written in place.
+  * Map returns a pointer to size bytes at the returned offset (a multiple of stride), which stays
+  * valid until Unmap. Only used_size bytes have to be written then.
+  * The other kinds return nullptr, they only take copies through Stream.
+  */
+  std::pair<u8*, u32> Map(u32 size, u32 stride)
+  {
+    if (!m_persistent)
+      return std::make_pair(nullptr, 0u);
+    u32 padding = m_iterator % stride;
+    if (padding)
+    {
+      m_iterator += stride - padding;
+    }
+    return Map(size);
+  }
+  virtual void Unmap(u32 used_size) {}
+  bool IsPersistent() const
+  {
+    return m_persistent;
+  }
+
   bool CanStreamWithoutRestart(u32 size, u32 stride = 0)
   {
     return (m_iterator + size + stride) <= m_size;
@@ -51,6 +73,10 @@ public:
 
 protected:
   StreamBuffer(u32 type, u32 size, u32 align_size = 16, bool need_cpu_buffer = false);
+  virtual std::pair<u8*, u32> Map(u32 size)
+  {
+    return std::make_pair(nullptr, 0u);
+  }
   void CreateFences();
   void DeleteFences();
   void AllocMemory(u32 size);
@@ -61,6 +87,7 @@ protected:
   u32 m_iterator;
   u32 m_used_iterator;
   u32 m_free_iterator;
+  bool m_persistent = false;
 
 private:
   static constexpr int SYNC_POINTS = 8;
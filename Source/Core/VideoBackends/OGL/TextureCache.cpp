@@ -38,6 +38,8 @@
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureScalerCommon.h"
+#include "VideoCommon/TextureScalerShader.h"
+#include "VideoCommon/TmemMirror.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace OGL
@@ -79,6 +81,20 @@ struct TextureDecodingProgramInfo
 static std::map<std::pair<u32, u32>, TextureDecodingProgramInfo> s_texture_decoding_program_info;
 static std::array<GLuint, TextureConversionShader::BUFFER_FORMAT_COUNT>
 s_texture_decoding_buffer_views;
+// A copy of TMEM, textures preloaded into it are decoded from there without uploading them.
+static GLuint s_tmem_buffer;
+static std::array<GLuint, TextureConversionShader::BUFFER_FORMAT_COUNT> s_tmem_buffer_views;
+
+struct TextureScalingProgramInfo
+{
+  SHADER program;
+  GLint uniform_dst_size = -1;
+  GLint uniform_src_size = -1;
+  GLint uniform_src_offset = -1;
+  bool valid = false;
+};
+
+static std::map<std::pair<int, int>, TextureScalingProgramInfo> s_texture_scaling_program_info;
 static void CreateTextureDecodingResources();
 static void DestroyTextureDecodingResources();
 
@@ -499,6 +515,18 @@ void CreateTextureDecodingResources()
     glBindTexture(GL_TEXTURE_BUFFER, s_texture_decoding_buffer_views[i]);
     glTexBuffer(GL_TEXTURE_BUFFER, gl_view_types[i], s_palette_stream_buffer->m_buffer);
   }
+
+  glGenBuffers(1, &s_tmem_buffer);
+  glBindBuffer(GL_TEXTURE_BUFFER, s_tmem_buffer);
+  glBufferData(GL_TEXTURE_BUFFER, TMEM_SIZE, nullptr, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_TEXTURE_BUFFER, s_palette_stream_buffer->m_buffer);
+  glGenTextures(TextureConversionShader::BUFFER_FORMAT_COUNT, s_tmem_buffer_views.data());
+  for (size_t i = 0; i < TextureConversionShader::BUFFER_FORMAT_COUNT; i++)
+  {
+    glBindTexture(GL_TEXTURE_BUFFER, s_tmem_buffer_views[i]);
+    glTexBuffer(GL_TEXTURE_BUFFER, gl_view_types[i], s_tmem_buffer);
+  }
+  TmemMirror::InvalidateAll();
 }
 
 void DestroyTextureDecodingResources()
@@ -506,7 +534,14 @@ void DestroyTextureDecodingResources()
   glDeleteTextures(TextureConversionShader::BUFFER_FORMAT_COUNT,
     s_texture_decoding_buffer_views.data());
   s_texture_decoding_buffer_views.fill(0);
+  glDeleteTextures(TextureConversionShader::BUFFER_FORMAT_COUNT, s_tmem_buffer_views.data());
+  s_tmem_buffer_views.fill(0);
+  glDeleteBuffers(1, &s_tmem_buffer);
+  s_tmem_buffer = 0;
   s_texture_decoding_program_info.clear();
+  for (auto& info : s_texture_scaling_program_info)
+    info.second.program.Destroy();
+  s_texture_scaling_program_info.clear();
 }
 
 bool TextureCache::SupportsGPUTextureDecode(TextureFormat format, TlutFormat palette_format)
@@ -548,6 +583,20 @@ bool TextureCache::SupportsGPUTextureDecode(TextureFormat format, TlutFormat pal
   return true;
 }
 
+static void UpdateTmemBuffer()
+{
+  u32 address, size;
+  if (!TmemMirror::PopInvalidRange(&address, &size))
+    return;
+
+  glBindBuffer(GL_TEXTURE_BUFFER, s_tmem_buffer);
+  do
+  {
+    glBufferSubData(GL_TEXTURE_BUFFER, address, size, texMem + address);
+  } while (TmemMirror::PopInvalidRange(&address, &size));
+  glBindBuffer(GL_TEXTURE_BUFFER, s_palette_stream_buffer->m_buffer);
+}
+
 bool TextureCache::DecodeTextureOnGPU(HostTexture* dst, u32 dst_level, const u8* data,
   u32 data_size, TextureFormat tformat, u32 width, u32 height,
   u32 aligned_width, u32 aligned_height, u32 row_stride,
@@ -562,37 +611,48 @@ bool TextureCache::DecodeTextureOnGPU(HostTexture* dst, u32 dst_level, const u8*
   GPUTimer timer;
 #endif
 
-  // Copy to GPU-visible buffer, aligned to the data type.
   auto info = iter->second;
   u32 bytes_per_buffer_elem =
     TextureConversionShader::GetBytesPerBufferElement(info.base_info->buffer_format);
-
-  // Only copy palette if it is required.
   bool has_palette = info.base_info->palette_size > 0;
-  u32 total_upload_size = static_cast<u32>(data_size);
-  u32 palette_offset = total_upload_size;
-  if (has_palette)
+
+  // Textures preloaded into TMEM, and their palettes, are read from the copy of TMEM.
+  u32 tmem_offset = 0;
+  u32 palette_tmem_offset = 0;
+  const bool from_tmem = TmemMirror::GetOffset(data, &tmem_offset) &&
+    TmemMirror::GetOffset(palette, &palette_tmem_offset) &&
+    tmem_offset % bytes_per_buffer_elem == 0 && tmem_offset + data_size <= TMEM_SIZE;
+  u32 offset_in_elements;
+  u32 palette_offset_in_elements;
+  if (from_tmem)
   {
-    // Align to u16.
-    if ((total_upload_size % sizeof(u16)) != 0)
+    UpdateTmemBuffer();
+    offset_in_elements = tmem_offset / bytes_per_buffer_elem;
+    palette_offset_in_elements = palette_tmem_offset / sizeof(u16);
+  }
+  else
+  {
+    // Copy to GPU-visible buffer, aligned to the data type.
+    // Only copy palette if it is required.
+    u32 palette_offset = static_cast<u32>(data_size);
+    if (has_palette)
     {
-      total_upload_size++;
-      palette_offset++;
+      // Align to u16.
+      if ((palette_offset % sizeof(u16)) != 0)
+        palette_offset++;
     }
 
-    total_upload_size += info.base_info->palette_size;
+    // Allocate space in stream buffer, and copy texture + palette across.
+    u32 offset = s_palette_stream_buffer->Stream(data_size, bytes_per_buffer_elem, data);
+    if (has_palette)
+      s_palette_stream_buffer->Stream(info.base_info->palette_size, sizeof(u16), palette);
+    offset_in_elements = offset / bytes_per_buffer_elem;
+    palette_offset_in_elements = (offset + palette_offset) / sizeof(u16);
   }
-
-  // Allocate space in stream buffer, and copy texture + palette across.
-  u32 offset = s_palette_stream_buffer->Stream(data_size, data);
-  if (has_palette)
-    s_palette_stream_buffer->Stream(info.base_info->palette_size, sizeof(u16), palette);
   info.program.Bind();
 
   // Calculate stride in buffer elements
   u32 row_stride_in_elements = row_stride / bytes_per_buffer_elem;
-  u32 offset_in_elements = offset / bytes_per_buffer_elem;
-  u32 palette_offset_in_elements = (offset + palette_offset) / sizeof(u16);
   if (info.uniform_dst_size >= 0)
     glUniform2ui(info.uniform_dst_size, width, height);
   if (info.uniform_src_size >= 0)
@@ -604,14 +664,17 @@ bool TextureCache::DecodeTextureOnGPU(HostTexture* dst, u32 dst_level, const u8*
   if (info.uniform_palette_offset >= 0)
     glUniform1ui(info.uniform_palette_offset, palette_offset_in_elements);
 
+  const auto& buffer_views = from_tmem ? s_tmem_buffer_views : s_texture_decoding_buffer_views;
   glActiveTexture(GL_TEXTURE9);
-  glBindTexture(GL_TEXTURE_BUFFER, s_texture_decoding_buffer_views[info.base_info->buffer_format]);
+  glBindTexture(GL_TEXTURE_BUFFER, buffer_views[info.base_info->buffer_format]);
 
   if (has_palette)
   {
     // Use an R16UI view for the palette.
     glActiveTexture(GL_TEXTURE10);
-    glBindTexture(GL_TEXTURE_BUFFER, s_palette_resolv_texture);
+    glBindTexture(GL_TEXTURE_BUFFER,
+      from_tmem ? buffer_views[TextureConversionShader::BUFFER_FORMAT_R16_UINT] :
+      s_palette_resolv_texture);
   }
 
   auto dispatch_groups =
@@ -630,4 +693,64 @@ bool TextureCache::DecodeTextureOnGPU(HostTexture* dst, u32 dst_level, const u8*
   return true;
 }
 
+bool TextureCache::SupportsGPUTextureScaling(int type, int factor)
+{
+  auto key = std::make_pair(type, factor);
+  auto iter = s_texture_scaling_program_info.find(key);
+  if (iter != s_texture_scaling_program_info.end())
+    return iter->second.valid;
+
+  TextureScalingProgramInfo info;
+  std::string shader_source =
+    TextureScalerShader::GenerateScalingShader(type, factor, API_OPENGL);
+  if (!s_palette_stream_buffer || shader_source.empty() ||
+    !ProgramShaderCache::CompileComputeShader(info.program, shader_source))
+  {
+    s_texture_scaling_program_info.emplace(key, info);
+    return false;
+  }
+
+  info.uniform_dst_size = glGetUniformLocation(info.program.glprogid, "u_dst_size");
+  info.uniform_src_size = glGetUniformLocation(info.program.glprogid, "u_src_size");
+  info.uniform_src_offset = glGetUniformLocation(info.program.glprogid, "u_src_offset");
+  info.valid = true;
+  s_texture_scaling_program_info.emplace(key, info);
+  return true;
+}
+
+bool TextureCache::ScaleTextureOnGPU(HostTexture* dst, u32 dst_level, const u8* data, u32 width,
+  u32 height, u32 row_length, int type, int factor)
+{
+  auto iter = s_texture_scaling_program_info.find(std::make_pair(type, factor));
+  if (iter == s_texture_scaling_program_info.end() || !iter->second.valid)
+    return false;
+
+  // The shader reads the pixels in pairs, so the data has to be aligned to one.
+  const u32 bytes_per_buffer_elem = TextureConversionShader::GetBytesPerBufferElement(
+    TextureConversionShader::BUFFER_FORMAT_R32G32_UINT);
+  u32 offset = s_palette_stream_buffer->Stream(row_length * height * sizeof(u32),
+    bytes_per_buffer_elem, data);
+
+  TextureScalingProgramInfo& info = iter->second;
+  info.program.Bind();
+  const u32 dst_width = width * factor;
+  const u32 dst_height = height * factor;
+  glUniform2ui(info.uniform_dst_size, dst_width, dst_height);
+  glUniform2ui(info.uniform_src_size, row_length, height);
+  glUniform1ui(info.uniform_src_offset, offset / sizeof(u32));
+
+  glActiveTexture(GL_TEXTURE9);
+  glBindTexture(GL_TEXTURE_BUFFER,
+    s_texture_decoding_buffer_views[TextureConversionShader::BUFFER_FORMAT_R32G32_UINT]);
+
+  auto dispatch_groups = TextureScalerShader::GetDispatchCount(dst_width, dst_height);
+  glBindImageTexture(0, static_cast<OGLTexture*>(dst)->GetRawTexIdentifier(), dst_level, GL_TRUE, 0,
+    GL_WRITE_ONLY, GL_RGBA8);
+  glDispatchCompute(dispatch_groups.first, dispatch_groups.second, 1);
+  glMemoryBarrier(GL_TEXTURE_UPDATE_BARRIER_BIT);
+
+  OGLTexture::SetStage();
+  return true;
+}
+
 }
@@ -32,6 +32,10 @@ private:
     u32 aligned_width, u32 aligned_height, u32 row_stride,
     const u8* palette, TlutFormat palette_format) override;
 
+  bool SupportsGPUTextureScaling(int type, int factor) override;
+  bool ScaleTextureOnGPU(HostTexture* dst, u32 dst_level, const u8* data, u32 width, u32 height,
+    u32 row_length, int type, int factor) override;
+
   void CopyEFBToCacheEntry(TextureCacheBase::TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
     bool scale_by_half, u32 cbuf_id, const float* colmat, u32 width, u32 height) override;
 
@@ -27,8 +27,10 @@
 namespace OGL
 {
 // This are the initially requested size for the buffers expressed in bytes
-const u32 MAX_IBUFFER_SIZE = 2 * 1024 * 1024;
-const u32 MAX_VBUFFER_SIZE = 32 * 1024 * 1024;
+// Mapped batches reserve MAXVBUFFERSIZE and MAXIBUFFERSIZE up front, so the rings have to be a few
+// times larger than that to not wait for the GPU on every batch.
+const u32 MAX_IBUFFER_SIZE = 4 * 1024 * 1024;
+const u32 MAX_VBUFFER_SIZE = 64 * 1024 * 1024;
 
 
 VertexManager::VertexManager() : m_cpu_v_buffer(MAXVBUFFERSIZE), m_cpu_i_buffer(MAXIBUFFERSIZE)
@@ -70,18 +72,44 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
 {
   u32 vertex_data_size = IndexGenerator::GetNumVerts() * stride;
   u32 index_data_size = IndexGenerator::GetIndexLen() * sizeof(u16);
-  m_baseVertex = m_vertexBuffer->Stream(vertex_data_size, stride, m_cpu_v_buffer.data()) / stride;
-  m_index_offset = m_indexBuffer->Stream(index_data_size, m_cpu_i_buffer.data());
+  if (m_writing_stream_buffers)
+  {
+    m_vertexBuffer->Unmap(vertex_data_size);
+    m_indexBuffer->Unmap(index_data_size);
+  }
+  else
+  {
+    m_baseVertex = m_vertexBuffer->Stream(vertex_data_size, stride, m_cpu_v_buffer.data()) / stride;
+    m_index_offset = m_indexBuffer->Stream(index_data_size, m_cpu_i_buffer.data());
+  }
   ADDSTAT(stats.thisFrame.bytesVertexStreamed, vertex_data_size);
   ADDSTAT(stats.thisFrame.bytesIndexStreamed, index_data_size);
 }
 
 void VertexManager::ResetBuffer(u32 stride)
 {
-  m_pCurBufferPointer = m_pBaseBufferPointer = m_cpu_v_buffer.data();
-  m_pEndBufferPointer = m_pBaseBufferPointer + m_cpu_v_buffer.size();
-  m_index_buffer_base = m_cpu_i_buffer.data();
-  IndexGenerator::Start(m_cpu_i_buffer.data());
+  // Persistently mapped buffers are written in place by the vertex loaders and the index
+  // generator. Batches that are culled entirely never reach the GPU, they go to the CPU buffers.
+  m_writing_stream_buffers =
+    !m_cull_all && m_vertexBuffer->IsPersistent() && m_indexBuffer->IsPersistent();
+  if (m_writing_stream_buffers)
+  {
+    auto buffer = m_vertexBuffer->Map(MAXVBUFFERSIZE, stride);
+    m_pCurBufferPointer = m_pBaseBufferPointer = buffer.first;
+    m_pEndBufferPointer = buffer.first + MAXVBUFFERSIZE;
+    m_baseVertex = buffer.second / stride;
+
+    buffer = m_indexBuffer->Map(MAXIBUFFERSIZE * sizeof(u16), sizeof(u16));
+    m_index_buffer_base = reinterpret_cast<u16*>(buffer.first);
+    m_index_offset = buffer.second;
+  }
+  else
+  {
+    m_pCurBufferPointer = m_pBaseBufferPointer = m_cpu_v_buffer.data();
+    m_pEndBufferPointer = m_pBaseBufferPointer + m_cpu_v_buffer.size();
+    m_index_buffer_base = m_cpu_i_buffer.data();
+  }
+  IndexGenerator::Start(m_index_buffer_base);
 }
 
 void VertexManager::Draw(u32 stride)
@@ -95,7 +123,17 @@ void VertexManager::Draw(u32 stride)
       GL_TRIANGLES
   };
   primitive_mode = modes[static_cast<u32>(m_current_primitive_type)];
-  if (g_ogl_config.bSupportsGLBaseVertex)
+  if (g_ActiveConfig.UseVertexShaderStereo())
+  {
+    // One instance per eye, the vertex shader selects the layer from gl_InstanceID.
+    if (g_ogl_config.bSupportsGLBaseVertex)
+      glDrawElementsInstancedBaseVertex(primitive_mode, index_size, GL_UNSIGNED_SHORT,
+                                        (u8*)nullptr + m_index_offset, 2, (GLint)m_baseVertex);
+    else
+      glDrawElementsInstanced(primitive_mode, index_size, GL_UNSIGNED_SHORT,
+                              (u8*)nullptr + m_index_offset, 2);
+  }
+  else if (g_ogl_config.bSupportsGLBaseVertex)
   {
     glDrawRangeElementsBaseVertex(primitive_mode, 0, max_index, index_size, GL_UNSIGNED_SHORT, (u8*)nullptr + m_index_offset, (GLint)m_baseVertex);
   }
@@ -47,11 +47,14 @@ private:
   GLuint m_vertex_buffers;
   GLuint m_index_buffers;
 
-  // Alternative buffers in CPU memory for primatives we are going to discard.
+  // Alternative buffers in CPU memory for primatives we are going to discard, and for stream
+  // buffers that can't stay mapped.
   std::vector<u8, Common::aligned_allocator<u8, 16>> m_cpu_v_buffer;
   std::vector<u16, Common::aligned_allocator<u16, 16>> m_cpu_i_buffer;
   std::unique_ptr<StreamBuffer> m_vertexBuffer;
   std::unique_ptr<StreamBuffer> m_indexBuffer;
+  // False while the current batch is written to the CPU buffers instead of the stream buffers.
+  bool m_writing_stream_buffers = false;
   size_t m_baseVertex;
   size_t m_index_offset;
   u16* m_index_buffer_base;
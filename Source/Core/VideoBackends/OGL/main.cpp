@@ -48,6 +48,7 @@ Make AA apply instantly during gameplay if possible
 #include "Core/Host.h"
 
 #include "VideoBackends/OGL/BoundingBox.h"
+#include "VideoBackends/OGL/FrameProfiler.h"
 #include "VideoBackends/OGL/PerfQuery.h"
 #include "VideoBackends/OGL/ProgramShaderCache.h"
 #include "VideoBackends/OGL/Render.h"
@@ -104,7 +105,9 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsScaling = false;
   g_Config.backend_info.bSupportsExclusiveFullscreen = false;
   g_Config.backend_info.bSupportsOversizedViewports = true;
+  g_Config.backend_info.bSupportsPrimitiveRestart = false;
   g_Config.backend_info.bSupportsGeometryShaders = true;
+  g_Config.backend_info.bSupportsVSLayerOutput = false;  // Dependent on extensions.
   g_Config.backend_info.bSupports3DVision = false;
   g_Config.backend_info.bSupportsPostProcessing = true;
   g_Config.backend_info.bSupportsSSAA = true;
@@ -113,7 +116,10 @@ void VideoBackend::InitBackendInfo()
   g_Config.backend_info.bSupportsTessellation = false;
   g_Config.backend_info.bSupportsComputeShaders = false;
   g_Config.backend_info.bSupportsGPUTextureDecoding = true;
+  g_Config.backend_info.bSupportsGPUTextureScaling = true;
+  g_Config.backend_info.bSupportsGPUMipmapGeneration = true;
   g_Config.backend_info.bSupportsComputeTextureEncoding = false;
+  g_Config.backend_info.bSupportsGPUVertexDecoding = false;
   g_Config.backend_info.bSupportsDepthClamp = true;
   g_Config.backend_info.bSupportsMultithreading = false;
   g_Config.backend_info.bSupportsValidationLayer = false;
@@ -155,6 +161,7 @@ void VideoBackend::Video_Prepare()
 
   g_vertex_manager = std::make_unique<VertexManager>();
   g_perf_query = GetPerfQuery();
+  g_frame_profiler = std::make_unique<FrameProfiler>();
   ProgramShaderCache::Init();
   g_texture_cache = std::make_unique<TextureCache>();
   g_sampler_cache = std::make_unique<SamplerCache>();
@@ -181,6 +188,7 @@ void VideoBackend::Video_Cleanup()
   g_sampler_cache.reset();
   g_texture_cache.reset();
   ProgramShaderCache::Shutdown();
+  g_frame_profiler.reset();
   g_perf_query.reset();
   g_vertex_manager.reset();
   g_renderer.reset();
@@ -3,9 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Rasterizer.h"
@@ -20,27 +24,216 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// The triangles of a draw are binned into tiles, which the thread pool draws in parallel. Each tile
+// draws its triangles in order, so unless a pixel depends on the one drawn before it, this gives
+// the same result as drawing them one by one. Tiles are made of whole blocks.
+static constexpr s32 TILE_SIZE = 32;
+static constexpr s32 TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+// Below this many pixels in the bounding rectangles of a draw, handing out tiles costs more than
+// it saves.
+static constexpr s64 PARALLEL_MIN_PIXELS = 16384;
+static constexpr size_t MAX_QUEUED_TRIANGLES = 4096;
+
+// What the pixels of a triangle are interpolated from, and its edges in 28.4 fixed point.
+struct Triangle
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  s32 vertex0X;
+  s32 vertex0Y;
+  float vertexOffsetX;
+  float vertexOffsetY;
+
+  // Half-edge constants and deltas
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Scissored bounding rectangle in pixels
+  s32 minx, maxx, miny, maxy;
+};
+
+// Draws pixels with a TEV unit of its own. The GPU thread has the first unit, each thread of the
+// pool one of the others.
+struct DrawUnit
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+
+  // The order of the last pixel that reached the TEV and of the last block built in the current
+  // tile, 0 for none. Counted from the triangle index plus one, then the block, then the pixel.
+  u32 triangle;
+  u64 lastPixel;
+  u64 lastBlock;
+
+  // What the last pixel and block in that order left, of all the tiles this unit drew.
+  u64 statePixel;
+  u64 stateBlock;
+  Tev pixelState;
+  RasterBlock blockState;
+};
+
+// The last one is kept for zfreeze.
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
-
-static s32 vertex0X;
-static s32 vertex0Y;
-static float vertexOffsetX;
-static float vertexOffsetY;
 
 static s32 scissorLeft = 0;
 static s32 scissorTop = 0;
 static s32 scissorRight = 0;
 static s32 scissorBottom = 0;
 
-static Tev tev;
-static RasterBlock rasterBlock;
+static std::vector<std::unique_ptr<DrawUnit>> drawUnits;
+static std::vector<Triangle> triangles;
+static s64 queuedPixels = 0;
+
+static void DrawTriangle(const Triangle& tri, DrawUnit& unit, s32 left, s32 top, s32 right,
+                         s32 bottom);
+
+namespace
+{
+// Hands out the tiles of the queued triangles to the thread pool. The GPU thread draws tiles too
+// and waits for the rest, so nothing changes the state the triangles are drawn with meanwhile.
+class TileDrawer final : public Common::IWorker
+{
+public:
+  TileDrawer()
+  {
+    Common::ThreadPool::RegisterWorker(this);
+  }
+  ~TileDrawer()
+  {
+    Common::ThreadPool::UnregisterWorker(this);
+  }
+
+  bool NextTask(size_t ID) override
+  {
+    return DrawNextTile(*drawUnits[ID + 1]);
+  }
+
+  void Run()
+  {
+    for (std::vector<u32>& tile : m_tiles)
+      tile.clear();
+    m_active_tiles.clear();
+    for (u32 i = 0; i < triangles.size(); i++)
+    {
+      const Triangle& tri = triangles[i];
+      for (s32 y = tri.miny / TILE_SIZE; y <= (tri.maxy - 1) / TILE_SIZE; y++)
+      {
+        for (s32 x = tri.minx / TILE_SIZE; x <= (tri.maxx - 1) / TILE_SIZE; x++)
+        {
+          std::vector<u32>& tile = m_tiles[y * TILES_X + x];
+          if (tile.empty())
+            m_active_tiles.push_back(y * TILES_X + x);
+          tile.push_back(i);
+        }
+      }
+    }
+
+    // Every unit starts from what the previous draw left, as if it drew all the pixels.
+    for (std::unique_ptr<DrawUnit>& unit : drawUnits)
+    {
+      if (unit != drawUnits[0])
+      {
+        unit->tev.CopyPixelState(drawUnits[0]->tev);
+        unit->rasterBlock = drawUnits[0]->rasterBlock;
+      }
+      unit->statePixel = 0;
+      unit->stateBlock = 0;
+    }
+
+    const u32 num_tiles = static_cast<u32>(m_active_tiles.size());
+    m_pending.store(num_tiles, std::memory_order_relaxed);
+    // The number of tiles is part of the claim counter, so that a worker that is late for the
+    // previous draw can't claim a tile of this one against a stale count.
+    m_claim.store(u64(num_tiles) << 32, std::memory_order_release);
+    const u32 num_workers = std::min<u32>(num_tiles - 1, static_cast<u32>(drawUnits.size() - 1));
+    for (u32 i = 0; i < num_workers; i++)
+      Common::ThreadPool::NotifyWorkPending();
+
+    while (DrawNextTile(*drawUnits[0]))
+    {
+    }
+    size_t loop_count = 0;
+    while (m_pending.load(std::memory_order_acquire) > 0)
+      Common::cYield(loop_count++);
+
+    // Carry on from the last pixel and block in drawing order, like the next draw would after
+    // drawing them one by one.
+    const DrawUnit* pixelUnit = drawUnits[0].get();
+    const DrawUnit* blockUnit = drawUnits[0].get();
+    for (const std::unique_ptr<DrawUnit>& unit : drawUnits)
+    {
+      if (unit->statePixel > pixelUnit->statePixel)
+        pixelUnit = unit.get();
+      if (unit->stateBlock > blockUnit->stateBlock)
+        blockUnit = unit.get();
+    }
+    if (pixelUnit->statePixel)
+      drawUnits[0]->tev.CopyPixelState(pixelUnit->pixelState);
+    if (blockUnit->stateBlock)
+      drawUnits[0]->rasterBlock = blockUnit->blockState;
+  }
+
+private:
+  bool DrawNextTile(DrawUnit& unit)
+  {
+    const u64 claim = m_claim.fetch_add(1, std::memory_order_acquire);
+    const u32 index = static_cast<u32>(claim);
+    if (index >= static_cast<u32>(claim >> 32))
+      return false;
+
+    const u32 tile = m_active_tiles[index];
+    const s32 left = (tile % TILES_X) * TILE_SIZE;
+    const s32 top = (tile / TILES_X) * TILE_SIZE;
+    const s32 right = std::min<s32>(left + TILE_SIZE, EFB_WIDTH);
+    const s32 bottom = std::min<s32>(top + TILE_SIZE, EFB_HEIGHT);
+
+    unit.lastPixel = 0;
+    unit.lastBlock = 0;
+    for (u32 i : m_tiles[tile])
+    {
+      unit.triangle = i;
+      DrawTriangle(triangles[i], unit, left, top, right, bottom);
+    }
+
+    // A tile draws its pixels in order, so its last one is the one the tile leaves behind.
+    if (unit.lastPixel > unit.statePixel)
+    {
+      unit.statePixel = unit.lastPixel;
+      unit.pixelState.CopyPixelState(unit.tev);
+    }
+    if (unit.lastBlock > unit.stateBlock)
+    {
+      unit.stateBlock = unit.lastBlock;
+      unit.blockState = unit.rasterBlock;
+    }
+
+    m_pending.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  std::vector<u32> m_tiles[TILES_X * TILES_Y];
+  std::vector<u32> m_active_tiles;
+  std::atomic<u64> m_claim{0};
+  std::atomic<u32> m_pending{0};
+};
+}  // Anonymous namespace
+
+static std::unique_ptr<TileDrawer> tileDrawer;
 
 void Init()
 {
-  tev.Init();
+  drawUnits.clear();
+  for (size_t i = 0; i <= Common::ThreadPool::GetThreadCount(); i++)
+  {
+    drawUnits.push_back(std::make_unique<DrawUnit>());
+    drawUnits.back()->tev.Init();
+  }
+  tileDrawer = std::make_unique<TileDrawer>();
 
   // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the first primitive.
   // TODO: This is just a guess!
@@ -48,6 +241,14 @@ void Init()
   ZSlope.f0 = 1.f;
 }
 
+void Shutdown()
+{
+  tileDrawer.reset();
+  drawUnits.clear();
+  triangles.clear();
+  queuedPixels = 0;
+}
+
 // Returns approximation of log2(f) in s28.4
 // results are close enough to use for LOD
 static s32 FixedLog2(float f)
@@ -94,32 +295,38 @@ void SetScissor()
 
 void SetTevReg(int reg, int comp, bool konst, s16 color)
 {
-  tev.SetRegColor(reg, comp, konst, color);
+  for (std::unique_ptr<DrawUnit>& unit : drawUnits)
+    unit->tev.SetRegColor(reg, comp, konst, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(const Triangle& tri, DrawUnit& unit, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(stats.thisFrame.rasterizedPixels);
+  Tev& tev = unit.tev;
+  tev.Counters.RasterizedPixels++;
 
-  float dx = vertexOffsetX + (float)(x - vertex0X);
-  float dy = vertexOffsetY + (float)(y - vertex0Y);
+  float dx = tri.vertexOffsetX + (float)(x - tri.vertex0X);
+  float dy = tri.vertexOffsetY + (float)(y - tri.vertex0Y);
 
-  s32 z = (s32)MathUtil::Clamp<float>(ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
+  s32 z = (s32)MathUtil::Clamp<float>(tri.ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
 
   if (!BoundingBox::active && bpmem.UseEarlyDepthTest() && g_ActiveConfig.bZComploc)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.Counters.PerfPixels[PQ_ZCOMP_INPUT_ZCOMPLOC]++;
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.Counters.PerfPixels[PQ_ZCOMP_OUTPUT_ZCOMPLOC]++;
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  unit.lastPixel = (u64(unit.triangle + 1) << 32) | (u32(y - yi) << 16) | (u32(x - xi) << 2) |
+                   (yi << 1) | xi;
+
+  const RasterBlock& rasterBlock = unit.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -130,7 +337,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(dx, dy);
+      u16 color = (u16)tri.ColorSlopes[i][comp].GetValue(dx, dy);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -162,16 +369,16 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static void InitTriangle(float X1, float Y1, s32 xi, s32 yi)
+static void InitTriangle(Triangle* tri, float X1, float Y1, s32 xi, s32 yi)
 {
-  vertex0X = xi;
-  vertex0Y = yi;
+  tri->vertex0X = xi;
+  tri->vertex0Y = yi;
 
   // adjust a little less than 0.5
   const float adjust = 0.495f;
 
-  vertexOffsetX = ((float)xi - X1) + adjust;
-  vertexOffsetY = ((float)yi - Y1) + adjust;
+  tri->vertexOffsetX = ((float)xi - X1) + adjust;
+  tri->vertexOffsetY = ((float)yi - Y1) + adjust;
 }
 
 static void InitSlope(Slope *slope, float f1, float f2, float f3, float DX31, float DX12, float DY12, float DY31)
@@ -186,7 +393,8 @@ static void InitSlope(Slope *slope, float f1, float f2, float f3, float DX31, fl
   slope->f0 = f1;
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear, u32 texmap,
+                                u32 texcoord)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
@@ -199,17 +407,17 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   float sDelta, tDelta;
   if (tm0.diag_lod)
   {
-    float *uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float *uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
+    const float *uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float *uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
 
     sDelta = fabsf(uv0[0] - uv1[0]);
     tDelta = fabsf(uv0[1] - uv1[1]);
   }
   else
   {
-    float *uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float *uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
-    float *uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
+    const float *uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float *uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
+    const float *uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
     sDelta = std::max(fabsf(uv0[0] - uv1[0]), fabsf(uv0[0] - uv2[0]));
     tDelta = std::max(fabsf(uv0[1] - uv1[1]), fabsf(uv0[1] - uv2[1]));
@@ -234,7 +442,7 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(const Triangle& tri, RasterBlock& rasterBlock, s32 blockX, s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -242,10 +450,10 @@ static void BuildBlock(s32 blockX, s32 blockY)
     {
       RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
-      float dx = vertexOffsetX + (float)(xi + blockX - vertex0X);
-      float dy = vertexOffsetY + (float)(yi + blockY - vertex0Y);
+      float dx = tri.vertexOffsetX + (float)(xi + blockX - tri.vertex0X);
+      float dy = tri.vertexOffsetY + (float)(yi + blockY - tri.vertex0Y);
 
-      float invW = 1.0f / WSlope.GetValue(dx, dy);
+      float invW = 1.0f / tri.WSlope.GetValue(dx, dy);
       pixel.InvW = invW;
 
       // tex coords
@@ -254,13 +462,13 @@ static void BuildBlock(s32 blockX, s32 blockY)
         float projection = invW;
         if (xfmem.texMtxInfo[i].projection)
         {
-          float q = TexSlopes[i][2].GetValue(dx, dy) * invW;
+          float q = tri.TexSlopes[i][2].GetValue(dx, dy) * invW;
           if (q != 0.0f)
             projection = invW / q;
         }
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(dx, dy) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(dx, dy) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(dx, dy) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(dx, dy) * projection;
       }
     }
   }
@@ -273,7 +481,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -285,12 +494,13 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
 
-static inline void PrepareBlock(s32 blockX, s32 blockY)
+static inline void PrepareBlock(const Triangle& tri, DrawUnit& unit, s32 blockX, s32 blockY)
 {
   static s32 x = -1;
   static s32 y = -1;
@@ -302,7 +512,335 @@ static inline void PrepareBlock(s32 blockX, s32 blockY)
   {
     x = blockX;
     y = blockY;
-    BuildBlock(x, y);
+    BuildBlock(tri, unit.rasterBlock, x, y);
+  }
+}
+
+// Draws the pixels of the blocks that start within the rectangle.
+static void DrawTriangle(const Triangle& tri, DrawUnit& unit, s32 left, s32 top, s32 right,
+                         s32 bottom)
+{
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
+
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
+
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  // Start in corner of 8x8 block
+  const s32 minx = std::max(tri.minx & ~(BLOCK_SIZE - 1), left);
+  const s32 miny = std::max(tri.miny & ~(BLOCK_SIZE - 1), top);
+  const s32 maxx = std::min(tri.maxx, right);
+  const s32 maxy = std::min(tri.maxy, bottom);
+
+  // Loop through blocks
+  for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
+  {
+    for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
+    {
+      // Corners of block
+      s32 x0 = x << 4;
+      s32 x1 = (x + BLOCK_SIZE - 1) << 4;
+      s32 y0 = y << 4;
+      s32 y1 = (y + BLOCK_SIZE - 1) << 4;
+
+      // Evaluate half-space functions
+      bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
+      bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
+      bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
+      bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
+      int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
+
+      bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
+      bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
+      bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
+      bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
+      int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
+
+      bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
+      bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
+      bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
+      bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
+      int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
+
+      // Skip block when outside an edge
+      if (a == 0x0 || b == 0x0 || c == 0x0)
+        continue;
+
+      BuildBlock(tri, unit.rasterBlock, x, y);
+      unit.lastBlock = (u64(unit.triangle + 1) << 32) | (u32(y) << 16) | (u32(x) << 2);
+
+      // Accept whole block when totally covered
+      if (a == 0xF && b == 0xF && c == 0xF)
+      {
+        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+        {
+          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+          {
+            Draw(tri, unit, x + ix, y + iy, ix, iy);
+          }
+        }
+      }
+      else // Partially covered block
+      {
+        s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
+        s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
+        s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
+
+        for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
+        {
+          s32 CX1 = CY1;
+          s32 CX2 = CY2;
+          s32 CX3 = CY3;
+
+          for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
+          {
+            if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+            {
+              Draw(tri, unit, x + ix, y + iy, ix, iy);
+            }
+
+            CX1 -= FDY12;
+            CX2 -= FDY23;
+            CX3 -= FDY31;
+          }
+
+          CY1 += FDX12;
+          CY2 += FDX23;
+          CY3 += FDX31;
+        }
+      }
+    }
+  }
+}
+
+static void DrawBoundingBox(const Triangle& tri, DrawUnit& unit)
+{
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
+
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
+
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  s32 minx = tri.minx;
+  s32 maxx = tri.maxx;
+  s32 miny = tri.miny;
+  s32 maxy = tri.maxy;
+
+  // Calculating bbox
+  // First check for alpha channel - don't do anything it if always fails,
+  // Change bbox to primitive size if it always passes
+  AlphaTest::TEST_RESULT alphaRes = bpmem.alpha_test.TestResult();
+
+  if (alphaRes != AlphaTest::UNDETERMINED)
+  {
+    if (alphaRes == AlphaTest::PASS)
+    {
+      BoundingBox::coords[BoundingBox::TOP] = std::min(BoundingBox::coords[BoundingBox::TOP], (u16)miny);
+      BoundingBox::coords[BoundingBox::LEFT] = std::min(BoundingBox::coords[BoundingBox::LEFT], (u16)minx);
+      BoundingBox::coords[BoundingBox::BOTTOM] = std::max(BoundingBox::coords[BoundingBox::BOTTOM], (u16)maxy);
+      BoundingBox::coords[BoundingBox::RIGHT] = std::max(BoundingBox::coords[BoundingBox::RIGHT], (u16)maxx);
+    }
+    return;
+  }
+
+  // If we are calculating bbox with alpha, we only need to find the
+  // topmost, leftmost, bottom most and rightmost pixels to be drawn.
+  // So instead of drawing every single one of the triangle's pixels,
+  // four loops are run: one for the top pixel, one for the left, one for
+  // the bottom and one for the right. As soon as a pixel that is to be
+  // drawn is found, the loop breaks. This enables a ~150% speedbost in
+  // bbox calculation, albeit at the cost of some ugly repetitive code.
+  const s32 FLEFT = minx << 4;
+  const s32 FRIGHT = maxx << 4;
+  s32 FTOP = miny << 4;
+  s32 FBOTTOM = maxy << 4;
+
+  // Start checking for bbox top
+  s32 CY1 = C1 + DX12 * FTOP - DY12 * FLEFT;
+  s32 CY2 = C2 + DX23 * FTOP - DY23 * FLEFT;
+  s32 CY3 = C3 + DX31 * FTOP - DY31 * FLEFT;
+
+  // Loop
+  for (s32 y = miny; y <= maxy; ++y)
+  {
+    if (y >= BoundingBox::coords[BoundingBox::TOP])
+      break;
+
+    s32 CX1 = CY1;
+    s32 CX2 = CY2;
+    s32 CX3 = CY3;
+
+    for (s32 x = minx; x <= maxx; ++x)
+    {
+      if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+      {
+        // Build the new raster block every other pixel
+        PrepareBlock(tri, unit, x, y);
+        Draw(tri, unit, x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
+
+        if (y >= BoundingBox::coords[BoundingBox::TOP])
+          break;
+      }
+
+      CX1 -= FDY12;
+      CX2 -= FDY23;
+      CX3 -= FDY31;
+    }
+
+    CY1 += FDX12;
+    CY2 += FDX23;
+    CY3 += FDX31;
+  }
+
+  // Update top limit
+  miny = std::max((s32)BoundingBox::coords[BoundingBox::TOP], miny);
+  FTOP = miny << 4;
+
+  // Checking for bbox left
+  s32 CX1 = C1 + DX12 * FTOP - DY12 * FLEFT;
+  s32 CX2 = C2 + DX23 * FTOP - DY23 * FLEFT;
+  s32 CX3 = C3 + DX31 * FTOP - DY31 * FLEFT;
+
+  // Loop
+  for (s32 x = minx; x <= maxx; ++x)
+  {
+    if (x >= BoundingBox::coords[BoundingBox::LEFT])
+      break;
+
+    CY1 = CX1;
+    CY2 = CX2;
+    CY3 = CX3;
+
+    for (s32 y = miny; y <= maxy; ++y)
+    {
+      if (CY1 > 0 && CY2 > 0 && CY3 > 0)
+      {
+        PrepareBlock(tri, unit, x, y);
+        Draw(tri, unit, x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
+
+        if (x >= BoundingBox::coords[BoundingBox::LEFT])
+          break;
+      }
+
+      CY1 += FDX12;
+      CY2 += FDX23;
+      CY3 += FDX31;
+    }
+
+    CX1 -= FDY12;
+    CX2 -= FDY23;
+    CX3 -= FDY31;
+  }
+
+  // Update left limit
+  minx = std::max((s32)BoundingBox::coords[BoundingBox::LEFT], minx);
+
+  // Checking for bbox bottom
+  CY1 = C1 + DX12 * FBOTTOM - DY12 * FRIGHT;
+  CY2 = C2 + DX23 * FBOTTOM - DY23 * FRIGHT;
+  CY3 = C3 + DX31 * FBOTTOM - DY31 * FRIGHT;
+
+  // Loop
+  for (s32 y = maxy; y >= miny; --y)
+  {
+    CX1 = CY1;
+    CX2 = CY2;
+    CX3 = CY3;
+
+    if (y <= BoundingBox::coords[BoundingBox::BOTTOM])
+      break;
+
+    for (s32 x = maxx; x >= minx; --x)
+    {
+      if (CX1 > 0 && CX2 > 0 && CX3 > 0)
+      {
+        // Build the new raster block every other pixel
+        PrepareBlock(tri, unit, x, y);
+        Draw(tri, unit, x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
+
+        if (y <= BoundingBox::coords[BoundingBox::BOTTOM])
+          break;
+      }
+
+      CX1 += FDY12;
+      CX2 += FDY23;
+      CX3 += FDY31;
+    }
+
+    CY1 -= FDX12;
+    CY2 -= FDX23;
+    CY3 -= FDX31;
+  }
+
+  // Update bottom limit
+  maxy = std::min((s32)BoundingBox::coords[BoundingBox::BOTTOM], maxy);
+  FBOTTOM = maxy << 4;
+
+  // Checking for bbox right
+  CX1 = C1 + DX12 * FBOTTOM - DY12 * FRIGHT;
+  CX2 = C2 + DX23 * FBOTTOM - DY23 * FRIGHT;
+  CX3 = C3 + DX31 * FBOTTOM - DY31 * FRIGHT;
+
+  // Loop
+  for (s32 x = maxx; x >= minx; --x)
+  {
+    if (x <= BoundingBox::coords[BoundingBox::RIGHT])
+      break;
+
+    CY1 = CX1;
+    CY2 = CX2;
+    CY3 = CX3;
+
+    for (s32 y = maxy; y >= miny; --y)
+    {
+      if (CY1 > 0 && CY2 > 0 && CY3 > 0)
+      {
+        // Build the new raster block every other pixel
+        PrepareBlock(tri, unit, x, y);
+        Draw(tri, unit, x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
+
+        if (x <= BoundingBox::coords[BoundingBox::RIGHT])
+          break;
+      }
+
+      CY1 -= FDX12;
+      CY2 -= FDX23;
+      CY3 -= FDX31;
+    }
+
+    CX1 += FDY12;
+    CX2 += FDY23;
+    CX3 += FDY31;
   }
 }
 
@@ -331,15 +869,6 @@ void DrawTriangleFrontFace(OutputVertexData *v0, OutputVertexData *v1, OutputVer
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -355,6 +884,12 @@ void DrawTriangleFrontFace(OutputVertexData *v0, OutputVertexData *v1, OutputVer
   if (minx >= maxx || miny >= maxy)
     return;
 
+  Triangle tri;
+  tri.minx = minx;
+  tri.maxx = maxx;
+  tri.miny = miny;
+  tri.maxy = maxy;
+
   // Setup slopes
   float fltx1 = v0->screenPosition.x;
   float flty1 = v0->screenPosition.y;
@@ -363,10 +898,10 @@ void DrawTriangleFrontFace(OutputVertexData *v0, OutputVertexData *v1, OutputVer
   float fltdy12 = flty1 - v1->screenPosition.y;
   float fltdy31 = v2->screenPosition.y - flty1;
 
-  InitTriangle(fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
+  InitTriangle(&tri, fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
 
   float w[3] = { 1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w, 1.0f / v2->projectedPosition.w };
-  InitSlope(&WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+  InitSlope(&tri.WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
 
   // TODO: The zfreeze emulation is not quite correct, yet!
   // Many things might prevent us from reaching this line (culling, clipping, scissoring).
@@ -374,17 +909,18 @@ void DrawTriangleFrontFace(OutputVertexData *v0, OutputVertexData *v1, OutputVer
   // We're currently sloppy at this since we abort early if any of the culling/clipping/scissoring tests fail.
   if (!bpmem.genMode.zfreeze || !g_ActiveConfig.bZFreeze)
     InitSlope(&ZSlope, v0->screenPosition[2], v1->screenPosition[2], v2->screenPosition[2], fltdx31, fltdx12, fltdy12, fltdy31);
+  tri.ZSlope = ZSlope;
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      InitSlope(&ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], fltdx31, fltdx12, fltdy12, fltdy31);
+      InitSlope(&tri.ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], fltdx31, fltdx12, fltdy12, fltdy31);
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
-      InitSlope(&TexSlopes[i][comp], v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1], v2->texCoords[i][comp] * w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+      InitSlope(&tri.TexSlopes[i][comp], v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1], v2->texCoords[i][comp] * w[2], fltdx31, fltdx12, fltdy12, fltdy31);
   }
 
   // Half-edge constants
@@ -397,279 +933,58 @@ void DrawTriangleFrontFace(OutputVertexData *v0, OutputVertexData *v1, OutputVer
   if (DY23 < 0 || (DY23 == 0 && DX23 > 0)) C2++;
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0)) C3++;
 
-  if (!BoundingBox::active)
+  tri.C1 = C1;
+  tri.C2 = C2;
+  tri.C3 = C3;
+  tri.DX12 = DX12;
+  tri.DX23 = DX23;
+  tri.DX31 = DX31;
+  tri.DY12 = DY12;
+  tri.DY23 = DY23;
+  tri.DY31 = DY31;
+
+  if (BoundingBox::active)
   {
-    // Start in corner of 8x8 block
-    minx &= ~(BLOCK_SIZE - 1);
-    miny &= ~(BLOCK_SIZE - 1);
-    // Loop through blocks
-    for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
-    {
-      for (s32 x = minx; x < maxx; x += BLOCK_SIZE)
-      {
-        // Corners of block
-        s32 x0 = x << 4;
-        s32 x1 = (x + BLOCK_SIZE - 1) << 4;
-        s32 y0 = y << 4;
-        s32 y1 = (y + BLOCK_SIZE - 1) << 4;
-
-        // Evaluate half-space functions
-        bool a00 = C1 + DX12 * y0 - DY12 * x0 > 0;
-        bool a10 = C1 + DX12 * y0 - DY12 * x1 > 0;
-        bool a01 = C1 + DX12 * y1 - DY12 * x0 > 0;
-        bool a11 = C1 + DX12 * y1 - DY12 * x1 > 0;
-        int a = (a00 << 0) | (a10 << 1) | (a01 << 2) | (a11 << 3);
-
-        bool b00 = C2 + DX23 * y0 - DY23 * x0 > 0;
-        bool b10 = C2 + DX23 * y0 - DY23 * x1 > 0;
-        bool b01 = C2 + DX23 * y1 - DY23 * x0 > 0;
-        bool b11 = C2 + DX23 * y1 - DY23 * x1 > 0;
-        int b = (b00 << 0) | (b10 << 1) | (b01 << 2) | (b11 << 3);
-
-        bool c00 = C3 + DX31 * y0 - DY31 * x0 > 0;
-        bool c10 = C3 + DX31 * y0 - DY31 * x1 > 0;
-        bool c01 = C3 + DX31 * y1 - DY31 * x0 > 0;
-        bool c11 = C3 + DX31 * y1 - DY31 * x1 > 0;
-        int c = (c00 << 0) | (c10 << 1) | (c01 << 2) | (c11 << 3);
-
-        // Skip block when outside an edge
-        if (a == 0x0 || b == 0x0 || c == 0x0)
-          continue;
-
-        BuildBlock(x, y);
-
-        // Accept whole block when totally covered
-        if (a == 0xF && b == 0xF && c == 0xF)
-        {
-          for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-          {
-            for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-            {
-              Draw(x + ix, y + iy, ix, iy);
-            }
-          }
-        }
-        else // Partially covered block
-        {
-          s32 CY1 = C1 + DX12 * y0 - DY12 * x0;
-          s32 CY2 = C2 + DX23 * y0 - DY23 * x0;
-          s32 CY3 = C3 + DX31 * y0 - DY31 * x0;
-
-          for (s32 iy = 0; iy < BLOCK_SIZE; iy++)
-          {
-            s32 CX1 = CY1;
-            s32 CX2 = CY2;
-            s32 CX3 = CY3;
-
-            for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
-            {
-              if (CX1 > 0 && CX2 > 0 && CX3 > 0)
-              {
-                Draw(x + ix, y + iy, ix, iy);
-              }
-
-              CX1 -= FDY12;
-              CX2 -= FDY23;
-              CX3 -= FDY31;
-            }
-
-            CY1 += FDX12;
-            CY2 += FDX23;
-            CY3 += FDX31;
-          }
-        }
-      }
-    }
+    // The search for the edges of the box needs the box of the triangles before.
+    if (!triangles.empty())
+      Flush();
+    DrawBoundingBox(tri, *drawUnits[0]);
+    return;
   }
-  else
-  {
-    // Calculating bbox
-    // First check for alpha channel - don't do anything it if always fails,
-    // Change bbox to primitive size if it always passes
-    AlphaTest::TEST_RESULT alphaRes = bpmem.alpha_test.TestResult();
 
-    if (alphaRes != AlphaTest::UNDETERMINED)
-    {
-      if (alphaRes == AlphaTest::PASS)
-      {
-        BoundingBox::coords[BoundingBox::TOP] = std::min(BoundingBox::coords[BoundingBox::TOP], (u16)miny);
-        BoundingBox::coords[BoundingBox::LEFT] = std::min(BoundingBox::coords[BoundingBox::LEFT], (u16)minx);
-        BoundingBox::coords[BoundingBox::BOTTOM] = std::max(BoundingBox::coords[BoundingBox::BOTTOM], (u16)maxy);
-        BoundingBox::coords[BoundingBox::RIGHT] = std::max(BoundingBox::coords[BoundingBox::RIGHT], (u16)maxx);
-      }
-      return;
-    }
-
-    // If we are calculating bbox with alpha, we only need to find the
-    // topmost, leftmost, bottom most and rightmost pixels to be drawn.
-    // So instead of drawing every single one of the triangle's pixels,
-    // four loops are run: one for the top pixel, one for the left, one for
-    // the bottom and one for the right. As soon as a pixel that is to be
-    // drawn is found, the loop breaks. This enables a ~150% speedbost in
-    // bbox calculation, albeit at the cost of some ugly repetitive code.
-    const s32 FLEFT = minx << 4;
-    const s32 FRIGHT = maxx << 4;
-    s32 FTOP = miny << 4;
-    s32 FBOTTOM = maxy << 4;
-
-    // Start checking for bbox top
-    s32 CY1 = C1 + DX12 * FTOP - DY12 * FLEFT;
-    s32 CY2 = C2 + DX23 * FTOP - DY23 * FLEFT;
-    s32 CY3 = C3 + DX31 * FTOP - DY31 * FLEFT;
-
-    // Loop
-    for (s32 y = miny; y <= maxy; ++y)
-    {
-      if (y >= BoundingBox::coords[BoundingBox::TOP])
-        break;
-
-      s32 CX1 = CY1;
-      s32 CX2 = CY2;
-      s32 CX3 = CY3;
-
-      for (s32 x = minx; x <= maxx; ++x)
-      {
-        if (CX1 > 0 && CX2 > 0 && CX3 > 0)
-        {
-          // Build the new raster block every other pixel
-          PrepareBlock(x, y);
-          Draw(x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
-
-          if (y >= BoundingBox::coords[BoundingBox::TOP])
-            break;
-        }
-
-        CX1 -= FDY12;
-        CX2 -= FDY23;
-        CX3 -= FDY31;
-      }
-
-      CY1 += FDX12;
-      CY2 += FDX23;
-      CY3 += FDX31;
-    }
-
-    // Update top limit
-    miny = std::max((s32)BoundingBox::coords[BoundingBox::TOP], miny);
-    FTOP = miny << 4;
-
-    // Checking for bbox left
-    s32 CX1 = C1 + DX12 * FTOP - DY12 * FLEFT;
-    s32 CX2 = C2 + DX23 * FTOP - DY23 * FLEFT;
-    s32 CX3 = C3 + DX31 * FTOP - DY31 * FLEFT;
-
-    // Loop
-    for (s32 x = minx; x <= maxx; ++x)
-    {
-      if (x >= BoundingBox::coords[BoundingBox::LEFT])
-        break;
-
-      CY1 = CX1;
-      CY2 = CX2;
-      CY3 = CX3;
-
-      for (s32 y = miny; y <= maxy; ++y)
-      {
-        if (CY1 > 0 && CY2 > 0 && CY3 > 0)
-        {
-          PrepareBlock(x, y);
-          Draw(x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
-
-          if (x >= BoundingBox::coords[BoundingBox::LEFT])
-            break;
-        }
-
-        CY1 += FDX12;
-        CY2 += FDX23;
-        CY3 += FDX31;
-      }
-
-      CX1 -= FDY12;
-      CX2 -= FDY23;
-      CX3 -= FDY31;
-    }
-
-    // Update left limit
-    minx = std::max((s32)BoundingBox::coords[BoundingBox::LEFT], minx);
-
-    // Checking for bbox bottom
-    CY1 = C1 + DX12 * FBOTTOM - DY12 * FRIGHT;
-    CY2 = C2 + DX23 * FBOTTOM - DY23 * FRIGHT;
-    CY3 = C3 + DX31 * FBOTTOM - DY31 * FRIGHT;
+  triangles.push_back(tri);
+  queuedPixels += s64(maxx - minx) * (maxy - miny);
+  if (triangles.size() >= MAX_QUEUED_TRIANGLES)
+    Flush();
+}
 
-    // Loop
-    for (s32 y = maxy; y >= miny; --y)
+void Flush()
+{
+  if (!triangles.empty())
+  {
+    // TEV dumps draw into shared buffers.
+    const bool parallel = drawUnits.size() > 1 && queuedPixels >= PARALLEL_MIN_PIXELS &&
+                          !g_ActiveConfig.bDumpTevStages &&
+                          !g_ActiveConfig.bDumpTevTextureFetches && !Tev::DependsOnPreviousPixel();
+    if (parallel)
     {
-      CX1 = CY1;
-      CX2 = CY2;
-      CX3 = CY3;
-
-      if (y <= BoundingBox::coords[BoundingBox::BOTTOM])
-        break;
-
-      for (s32 x = maxx; x >= minx; --x)
-      {
-        if (CX1 > 0 && CX2 > 0 && CX3 > 0)
-        {
-          // Build the new raster block every other pixel
-          PrepareBlock(x, y);
-          Draw(x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
-
-          if (y <= BoundingBox::coords[BoundingBox::BOTTOM])
-            break;
-        }
-
-        CX1 += FDY12;
-        CX2 += FDY23;
-        CX3 += FDY31;
-      }
-
-      CY1 -= FDX12;
-      CY2 -= FDX23;
-      CY3 -= FDX31;
+      tileDrawer->Run();
     }
-
-    // Update bottom limit
-    maxy = std::min((s32)BoundingBox::coords[BoundingBox::BOTTOM], maxy);
-    FBOTTOM = maxy << 4;
-
-    // Checking for bbox right
-    CX1 = C1 + DX12 * FBOTTOM - DY12 * FRIGHT;
-    CX2 = C2 + DX23 * FBOTTOM - DY23 * FRIGHT;
-    CX3 = C3 + DX31 * FBOTTOM - DY31 * FRIGHT;
-
-    // Loop
-    for (s32 x = maxx; x >= minx; --x)
+    else
     {
-      if (x <= BoundingBox::coords[BoundingBox::RIGHT])
-        break;
-
-      CY1 = CX1;
-      CY2 = CX2;
-      CY3 = CX3;
-
-      for (s32 y = maxy; y >= miny; --y)
+      DrawUnit& unit = *drawUnits[0];
+      for (u32 i = 0; i < triangles.size(); i++)
       {
-        if (CY1 > 0 && CY2 > 0 && CY3 > 0)
-        {
-          // Build the new raster block every other pixel
-          PrepareBlock(x, y);
-          Draw(x, y, x & (BLOCK_SIZE - 1), y & (BLOCK_SIZE - 1));
-
-          if (x <= BoundingBox::coords[BoundingBox::RIGHT])
-            break;
-        }
-
-        CY1 -= FDX12;
-        CY2 -= FDX23;
-        CY3 -= FDX31;
+        unit.triangle = i;
+        DrawTriangle(triangles[i], unit, 0, 0, EFB_WIDTH, EFB_HEIGHT);
       }
-
-      CX1 += FDY12;
-      CX2 += FDY23;
-      CX3 += FDY31;
     }
+    triangles.clear();
+    queuedPixels = 0;
   }
+
+  for (std::unique_ptr<DrawUnit>& unit : drawUnits)
+    unit->tev.FlushCounters();
 }
 
 }
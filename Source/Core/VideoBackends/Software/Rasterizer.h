@@ -11,9 +11,14 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
 void DrawTriangleFrontFace(OutputVertexData *v0, OutputVertexData *v1, OutputVertexData *v2);
 
+// Draws the triangles queued since the last call. Called at the end of each draw, before anything
+// changes the state they are drawn with or reads the EFB.
+void Flush();
+
 void SetScissor();
 
 void SetTevReg(int reg, int comp, bool konst, s16 color);
@@ -24,7 +29,7 @@ struct Slope
   float dfdy;
   float f0;
 
-  float GetValue(float dx, float dy)
+  float GetValue(float dx, float dy) const
   {
     return f0 + (dfdx * dx) + (dfdy * dy);
   }
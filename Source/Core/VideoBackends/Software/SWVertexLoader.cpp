@@ -2,10 +2,14 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <limits>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoBackends/Software/Clipper.h"
 #include "VideoBackends/Software/DebugUtil.h"
@@ -41,11 +45,91 @@ std::unique_ptr<NativeVertexFormat> SWVertexLoader::CreateNativeVertexFormat(con
   return std::make_unique<NullNativeVertexFormat>(vtx_decl);
 }
 
+namespace
+{
+// Transforming and lighting a vertex here costs several times what loading one does for the
+// hardware backends, so ranges can be a quarter of the size VertexLoaderManager uses. Draws are
+// split from four ranges on.
+constexpr u32 PARALLEL_MIN_VERTICES = 1024;
+constexpr u32 PARALLEL_RANGE_MIN_VERTICES = 256;
+}
+
+// Transforms ranges of the vertices of a draw on the thread pool. The GPU thread transforms ranges
+// too and waits for the rest, so nothing changes the state the vertices are transformed with
+// meanwhile.
+class SWVertexLoader::ParallelTransform final : public Common::IWorker
+{
+public:
+  explicit ParallelTransform(SWVertexLoader* loader) : m_loader(loader)
+  {
+    Common::ThreadPool::RegisterWorker(this);
+  }
+  ~ParallelTransform()
+  {
+    Common::ThreadPool::UnregisterWorker(this);
+  }
+
+  bool NextTask(size_t ID) override
+  {
+    return TransformNextRange();
+  }
+
+  void Run(u32 count)
+  {
+    const u32 num_ranges = std::min<u32>(count / PARALLEL_RANGE_MIN_VERTICES,
+                                         static_cast<u32>(Common::ThreadPool::GetThreadCount()) + 1);
+    if (count < PARALLEL_MIN_VERTICES || num_ranges < 2)
+    {
+      m_loader->TransformVertices(0, count);
+      return;
+    }
+
+    m_count = count;
+    m_range_size = (count + num_ranges - 1) / num_ranges;
+    m_pending.store(num_ranges, std::memory_order_relaxed);
+    // The number of ranges is part of the claim counter, so that a worker that is late for the
+    // previous draw can't claim a range of this one against a stale count.
+    m_claim.store(u64(num_ranges) << 32, std::memory_order_release);
+    for (u32 i = 1; i < num_ranges; i++)
+      Common::ThreadPool::NotifyWorkPending();
+
+    while (TransformNextRange())
+    {
+    }
+    size_t loop_count = 0;
+    while (m_pending.load(std::memory_order_acquire) > 0)
+      Common::cYield(loop_count++);
+  }
+
+private:
+  bool TransformNextRange()
+  {
+    const u64 claim = m_claim.fetch_add(1, std::memory_order_acquire);
+    const u32 index = static_cast<u32>(claim);
+    if (index >= static_cast<u32>(claim >> 32))
+      return false;
+
+    const u32 begin = index * m_range_size;
+    const u32 end = std::min(begin + m_range_size, m_count);
+    if (begin < end)
+      m_loader->TransformVertices(begin, end);
+    m_pending.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  SWVertexLoader* m_loader;
+  u32 m_count = 0;
+  u32 m_range_size = 0;
+  std::atomic<u64> m_claim{0};
+  std::atomic<u32> m_pending{0};
+};
+
 SWVertexLoader::SWVertexLoader()
 {
   LocalVBuffer.resize(MAXVBUFFERSIZE);
   LocalIBuffer.resize(MAXIBUFFERSIZE);
   m_SetupUnit = new SetupUnit;
+  m_ParallelTransform = std::make_unique<ParallelTransform>(this);
 }
 
 SWVertexLoader::~SWVertexLoader()
@@ -98,6 +182,20 @@ void SWVertexLoader::vFlush(bool useDstAlpha)
     Rasterizer::SetTevReg(i, Tev::ALP_C, true, kcolors[i * 4 + 3]);
   }
 
+  // Super Mario Sunshine requires the colors to be zero for those debug boxes.
+  memset(&m_Vertex, 0, sizeof(m_Vertex));
+  SetFormat(g_main_cp_state.last_id, primitiveType);
+
+  u32 numVertices = 0;
+  for (u32 i = 0; i < IndexGenerator::GetIndexLen(); i++)
+  {
+    if (LocalIBuffer[i] != 0xffff)
+      numVertices = std::max<u32>(numVertices, LocalIBuffer[i] + 1);
+  }
+  if (m_TransformedVertices.size() < numVertices)
+    m_TransformedVertices.resize(numVertices);
+  m_ParallelTransform->Run(numVertices);
+
   for (u32 i = 0; i < IndexGenerator::GetIndexLen(); i++)
   {
     u16 index = LocalIBuffer[i];
@@ -108,35 +206,42 @@ void SWVertexLoader::vFlush(bool useDstAlpha)
       m_SetupUnit->Init(primitiveType);
       continue;
     }
-    memset(&m_Vertex, 0, sizeof(m_Vertex));
-
-    // Super Mario Sunshine requires those to be zero for those debug boxes.
-    memset(&m_Vertex.color, 0, sizeof(m_Vertex.color));
-
-    // parse the videocommon format to our own struct format (m_Vertex)
-    SetFormat(g_main_cp_state.last_id, primitiveType);
-    ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
-
-    // transform this vertex so that it can be used for rasterization (outVertex)
-    OutputVertexData* outVertex = m_SetupUnit->GetVertex();
-    TransformUnit::TransformPosition(&m_Vertex, outVertex);
-    memset(&outVertex->normal, 0, sizeof(outVertex->normal));
-    if (VertexLoaderManager::g_current_components & VB_HAS_NRM0)
-    {
-      TransformUnit::TransformNormal(&m_Vertex, (VertexLoaderManager::g_current_components & VB_HAS_NRM2) != 0, outVertex);
-    }
-    TransformUnit::TransformColor(&m_Vertex, outVertex);
-    TransformUnit::TransformTexCoord(&m_Vertex, outVertex, m_TexGenSpecialCase);
 
     // assemble and rasterize the primitive
+    *m_SetupUnit->GetVertex() = m_TransformedVertices[index];
     m_SetupUnit->SetupVertex();
 
     INCSTAT(stats.thisFrame.numVerticesLoaded)
   }
 
+  Rasterizer::Flush();
+
   DebugUtil::OnObjectEnd();
 }
 
+void SWVertexLoader::TransformVertices(u32 begin, u32 end)
+{
+  const PortableVertexDeclaration& vdec =
+      VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration();
+  const u32 components = VertexLoaderManager::g_current_components;
+
+  for (u32 i = begin; i < end; i++)
+  {
+    // parse the videocommon format to our own struct format (vertex)
+    InputVertexData vertex = m_Vertex;
+    ParseVertex(vdec, i, &vertex);
+
+    // transform this vertex so that it can be used for rasterization (outVertex)
+    OutputVertexData* outVertex = &m_TransformedVertices[i];
+    memset(outVertex, 0, sizeof(*outVertex));
+    TransformUnit::TransformPosition(&vertex, outVertex);
+    if (components & VB_HAS_NRM0)
+      TransformUnit::TransformNormal(&vertex, (components & VB_HAS_NRM2) != 0, outVertex);
+    TransformUnit::TransformColor(&vertex, outVertex);
+    TransformUnit::TransformTexCoord(&vertex, outVertex, m_TexGenSpecialCase);
+  }
+}
+
 void SWVertexLoader::SetFormat(u8 attributeIndex, u8 primitiveType)
 {
   // matrix index from xf regs or cp memory?
@@ -224,33 +329,34 @@ static void ReadVertexAttribute(T* dst, DataReader src, const AttributeFormat& f
   }
 }
 
-void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index)
+void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index,
+                                 InputVertexData* vertex)
 {
   DataReader src(LocalVBuffer.data(), LocalVBuffer.data() + LocalVBuffer.size());
   src.ReadSkip(index * vdec.stride);
 
-  ReadVertexAttribute<float>(&m_Vertex.position[0], src, vdec.position, 0, 3, false);
+  ReadVertexAttribute<float>(&vertex->position[0], src, vdec.position, 0, 3, false);
 
   for (int i = 0; i < 3; i++)
   {
-    ReadVertexAttribute<float>(&m_Vertex.normal[i][0], src, vdec.normals[i], 0, 3, false);
+    ReadVertexAttribute<float>(&vertex->normal[i][0], src, vdec.normals[i], 0, 3, false);
   }
 
   for (int i = 0; i < 2; i++)
   {
-    ReadVertexAttribute<u8>(m_Vertex.color[i], src, vdec.colors[i], 0, 4, true);
+    ReadVertexAttribute<u8>(vertex->color[i], src, vdec.colors[i], 0, 4, true);
   }
 
   for (int i = 0; i < 8; i++)
   {
-    ReadVertexAttribute<float>(m_Vertex.texCoords[i], src, vdec.texcoords[i], 0, 2, false);
+    ReadVertexAttribute<float>(vertex->texCoords[i], src, vdec.texcoords[i], 0, 2, false);
 
     // the texmtr is stored as third component of the texCoord
     if (vdec.texcoords[i].components >= 3)
     {
-      ReadVertexAttribute<u8>(&m_Vertex.texMtx[i], src, vdec.texcoords[i], 2, 1, false);
+      ReadVertexAttribute<u8>(&vertex->texMtx[i], src, vdec.texcoords[i], 2, 1, false);
     }
   }
 
-  ReadVertexAttribute<u8>(&m_Vertex.posMtx, src, vdec.posmtx, 0, 1, false);
+  ReadVertexAttribute<u8>(&vertex->posMtx, src, vdec.posmtx, 0, 1, false);
 }
@@ -33,13 +33,20 @@ protected:
     return &LocalIBuffer[0];
   }
 private:
+  class ParallelTransform;
+
   void vFlush(bool useDstAlpha) override;
   std::vector<u8> LocalVBuffer;
   std::vector<u16> LocalIBuffer;
 
+  // What SetFormat sets for every vertex of the draw, before its own attributes are parsed.
   InputVertexData m_Vertex;
+  // The vertices of the draw, each transformed once however many primitives use it.
+  std::vector<OutputVertexData> m_TransformedVertices;
+  std::unique_ptr<ParallelTransform> m_ParallelTransform;
 
-  void ParseVertex(const PortableVertexDeclaration& vdec, int index);
+  void ParseVertex(const PortableVertexDeclaration& vdec, int index, InputVertexData* vertex);
+  void TransformVertices(u32 begin, u32 end);
 
   SetupUnit *m_SetupUnit;
 
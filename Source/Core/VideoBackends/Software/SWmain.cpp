@@ -148,6 +148,7 @@ void VideoSoftware::InitBackendInfo()
   g_Config.backend_info.bSupportsDualSourceBlend = true;
   g_Config.backend_info.bSupportsEarlyZ = true;
   g_Config.backend_info.bSupportsOversizedViewports = true;
+  g_Config.backend_info.bSupportsPrimitiveRestart = false;
 
   // aamodes
   g_Config.backend_info.AAModes = { 1 };
@@ -185,6 +186,7 @@ void VideoSoftware::Shutdown()
   // Do our OSD callbacks
   OSD::DoCallbacks(OSD::CallbackType::Shutdown);
 
+  Rasterizer::Shutdown();
   SWOGLWindow::Shutdown();
 }
 
@@ -2,7 +2,9 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -124,6 +126,8 @@ void Tev::Init()
   m_ScaleRShiftLUT[1] = 0;
   m_ScaleRShiftLUT[2] = 0;
   m_ScaleRShiftLUT[3] = 1;
+
+  ResetCounters();
 }
 
 static inline s16 Clamp255(s16 in)
@@ -511,7 +515,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < EFB_WIDTH);
   ASSERT(Position[1] >= 0 && Position[1] < EFB_HEIGHT);
 
-  INCSTAT(stats.thisFrame.tevPixelsIn);
+  Counters.PixelsIn++;
 
   for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages.Value(); stageNum++)
   {
@@ -763,19 +767,22 @@ void Tev::Draw()
     if (late_ztest && bpmem.zmode.testenable)
     {
       // TODO: Check against hw if these values get incremented even if depth testing is disabled
-      EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+      Counters.PerfPixels[PQ_ZCOMP_INPUT]++;
 
       if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
         return;
 
-      EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+      Counters.PerfPixels[PQ_ZCOMP_OUTPUT]++;
     }
   }
   // branchless bounding box update
-  BoundingBox::coords[BoundingBox::LEFT] = std::min((u16)Position[0], BoundingBox::coords[BoundingBox::LEFT]);
-  BoundingBox::coords[BoundingBox::RIGHT] = std::max((u16)Position[0], BoundingBox::coords[BoundingBox::RIGHT]);
-  BoundingBox::coords[BoundingBox::TOP] = std::min((u16)Position[1], BoundingBox::coords[BoundingBox::TOP]);
-  BoundingBox::coords[BoundingBox::BOTTOM] = std::max((u16)Position[1], BoundingBox::coords[BoundingBox::BOTTOM]);
+  // The rasterizer reads the box back while it looks for the edges of a primitive, otherwise it
+  // is merged in FlushCounters.
+  u16* bbox = BoundingBox::active ? BoundingBox::coords : Counters.BBox;
+  bbox[BoundingBox::LEFT] = std::min((u16)Position[0], bbox[BoundingBox::LEFT]);
+  bbox[BoundingBox::RIGHT] = std::max((u16)Position[0], bbox[BoundingBox::RIGHT]);
+  bbox[BoundingBox::TOP] = std::min((u16)Position[1], bbox[BoundingBox::TOP]);
+  bbox[BoundingBox::BOTTOM] = std::max((u16)Position[1], bbox[BoundingBox::BOTTOM]);
 
   // if we are only calculating the bounding box,
   // there's no need to actually draw anything
@@ -802,8 +809,8 @@ void Tev::Draw()
   }
 #endif
 
-  INCSTAT(stats.thisFrame.tevPixelsOut);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  Counters.PixelsOut++;
+  Counters.PerfPixels[PQ_BLEND_INPUT]++;
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
@@ -820,3 +827,126 @@ void Tev::SetRegColor(int reg, int comp, bool konst, s16 color)
   }
 }
 
+void Tev::CopyPixelState(const Tev& other)
+{
+  std::memcpy(Reg, other.Reg, sizeof(Reg));
+  std::memcpy(TexColor, other.TexColor, sizeof(TexColor));
+  std::memcpy(RasColor, other.RasColor, sizeof(RasColor));
+  std::memcpy(StageKonst, other.StageKonst, sizeof(StageKonst));
+  AlphaBump = other.AlphaBump;
+  std::memcpy(IndirectTex, other.IndirectTex, sizeof(IndirectTex));
+  TexCoord = other.TexCoord;
+
+  std::memcpy(Position, other.Position, sizeof(Position));
+  std::memcpy(Color, other.Color, sizeof(Color));
+  std::memcpy(Uv, other.Uv, sizeof(Uv));
+  std::memcpy(IndirectLod, other.IndirectLod, sizeof(IndirectLod));
+  std::memcpy(IndirectLinear, other.IndirectLinear, sizeof(IndirectLinear));
+  std::memcpy(TextureLod, other.TextureLod, sizeof(TextureLod));
+  std::memcpy(TextureLinear, other.TextureLinear, sizeof(TextureLinear));
+}
+
+void Tev::ResetCounters()
+{
+  Counters.RasterizedPixels = 0;
+  Counters.PixelsIn = 0;
+  Counters.PixelsOut = 0;
+  for (u32& pixels : Counters.PerfPixels)
+    pixels = 0;
+
+  Counters.BBox[BoundingBox::LEFT] = 0xFFFF;
+  Counters.BBox[BoundingBox::RIGHT] = 0;
+  Counters.BBox[BoundingBox::TOP] = 0xFFFF;
+  Counters.BBox[BoundingBox::BOTTOM] = 0;
+}
+
+void Tev::FlushCounters()
+{
+  ADDSTAT(stats.thisFrame.rasterizedPixels, Counters.RasterizedPixels);
+  ADDSTAT(stats.thisFrame.tevPixelsIn, Counters.PixelsIn);
+  ADDSTAT(stats.thisFrame.tevPixelsOut, Counters.PixelsOut);
+
+  for (int i = 0; i < PQ_NUM_MEMBERS; i++)
+  {
+    if (Counters.PerfPixels[i])
+      EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i), Counters.PerfPixels[i]);
+  }
+
+  u16* coords = BoundingBox::coords;
+  coords[BoundingBox::LEFT] = std::min(Counters.BBox[BoundingBox::LEFT], coords[BoundingBox::LEFT]);
+  coords[BoundingBox::RIGHT] =
+      std::max(Counters.BBox[BoundingBox::RIGHT], coords[BoundingBox::RIGHT]);
+  coords[BoundingBox::TOP] = std::min(Counters.BBox[BoundingBox::TOP], coords[BoundingBox::TOP]);
+  coords[BoundingBox::BOTTOM] =
+      std::max(Counters.BBox[BoundingBox::BOTTOM], coords[BoundingBox::BOTTOM]);
+
+  ResetCounters();
+}
+
+bool Tev::DependsOnPreviousPixel()
+{
+  const u32 numStages = bpmem.genMode.numtevstages + 1;
+
+  // Registers hold what the previous pixel left until the stages write them. Those no stage
+  // writes keep the values the draw started with.
+  bool colorWritten[4] = {};
+  bool alphaWritten[4] = {};
+  bool samples = false;
+  for (u32 i = 0; i < numStages; i++)
+  {
+    colorWritten[bpmem.combiners[i].colorC.dest] = true;
+    alphaWritten[bpmem.combiners[i].alphaC.dest] = true;
+    samples |= bpmem.tevorders[i >> 1].getEnable(i & 1) != 0;
+  }
+
+  bool colorSet[4] = {};
+  bool alphaSet[4] = {};
+  bool texSet = false;
+  bool coordSet = false;
+  for (u32 i = 0; i < numStages; i++)
+  {
+    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[i].colorC;
+    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[i].alphaC;
+    const TevStageIndirect& indirect = bpmem.tevind[i];
+
+    // The texture coordinate of the previous stage is kept when it's added to, or when the
+    // indirect matrix is invalid.
+    const bool keepsCoord =
+        indirect.fb_addprev || ((indirect.mid & 3) && (indirect.mid & 12) == 12);
+    if (keepsCoord && !coordSet && samples)
+      return true;
+    coordSet = coordSet || !keepsCoord;
+
+    if (bpmem.tevorders[i >> 1].getEnable(i & 1))
+      texSet = true;
+
+    const u32 colorInputs[4] = {cc.a, cc.b, cc.c, cc.d};
+    for (u32 input : colorInputs)
+    {
+      // prev, c0, c1 and c2, their colors on even inputs and their alphas on odd ones
+      if (input < 8)
+      {
+        const u32 reg = input >> 1;
+        if ((input & 1) ? alphaWritten[reg] && !alphaSet[reg] : colorWritten[reg] && !colorSet[reg])
+          return true;
+      }
+      else if (input < 10 && samples && !texSet)
+      {
+        return true;
+      }
+    }
+
+    const u32 alphaInputs[4] = {ac.a, ac.b, ac.c, ac.d};
+    for (u32 input : alphaInputs)
+    {
+      if (input < 4 && alphaWritten[input] && !alphaSet[input])
+        return true;
+      if (input == 4 && samples && !texSet)
+        return true;
+    }
+
+    colorSet[cc.dest] = true;
+    alphaSet[ac.dest] = true;
+  }
+  return false;
+}
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -83,9 +84,34 @@ public:
     RED_C
   };
 
+  // What the pixels drawn by this unit added to the statistics, the perf counters and the
+  // bounding box, kept apart so that several units can draw at once.
+  struct DrawCounters
+  {
+    u32 RasterizedPixels;
+    u32 PixelsIn;
+    u32 PixelsOut;
+    u32 PerfPixels[PQ_NUM_MEMBERS];
+    u16 BBox[4];
+  };
+  DrawCounters Counters;
+
   void Init();
 
   void Draw();
 
   void SetRegColor(int reg, int comp, bool konst, s16 color);
+
+  // Copies what the last pixel left in the unit, which the next one may read.
+  void CopyPixelState(const Tev& other);
+
+  // Adds the counters to the statistics, the perf counters and the bounding box, and resets them.
+  void FlushCounters();
+
+  // Whether a pixel may read what the previous pixel left in the unit with the current state, so
+  // that the pixels of a draw have to go through one unit in order.
+  static bool DependsOnPreviousPixel();
+
+private:
+  void ResetCounters();
 };
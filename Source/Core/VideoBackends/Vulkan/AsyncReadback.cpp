@@ -0,0 +1,100 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/Vulkan/AsyncReadback.h"
+
+#include <functional>
+
+#include "Common/MsgHandler.h"
+
+#include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/StagingTexture2D.h"
+#include "VideoBackends/Vulkan/StateTracker.h"
+#include "VideoBackends/Vulkan/Texture2D.h"
+#include "VideoBackends/Vulkan/Util.h"
+
+namespace Vulkan
+{
+AsyncReadback::AsyncReadback(size_t ring_size)
+  : AsyncReadbackBase(ring_size), m_staging_slots(GetSlotCount())
+{
+  g_command_buffer_mgr->AddFencePointCallback(
+    this, [](VkCommandBuffer, VkFence) {},
+    std::bind(&AsyncReadback::OnCommandBufferExecuted, this, std::placeholders::_1));
+}
+
+AsyncReadback::~AsyncReadback()
+{
+  g_command_buffer_mgr->RemoveFencePointCallback(this);
+  Discard();
+}
+
+bool AsyncReadback::CopyToSlot(size_t slot, uintptr_t texture,
+  const MathUtil::Rectangle<int>& rect)
+{
+  Texture2D* src_texture = reinterpret_cast<Texture2D*>(texture);
+  StagingSlot& staging = m_staging_slots[slot];
+  const u32 width = static_cast<u32>(rect.GetWidth());
+  const u32 height = static_cast<u32>(rect.GetHeight());
+  if (!staging.texture || staging.texture->GetWidth() != width ||
+    staging.texture->GetHeight() != height ||
+    staging.texture->GetFormat() != src_texture->GetFormat())
+  {
+    // Release the memory before allocating the new texture.
+    staging.texture.reset();
+    staging.texture = StagingTexture2D::Create(STAGING_BUFFER_TYPE_READBACK, width, height,
+      src_texture->GetFormat());
+    if (!staging.texture || !staging.texture->Map())
+    {
+      PanicAlert("Failed to allocate readback texture.");
+      staging.texture.reset();
+      return false;
+    }
+  }
+
+  VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
+  StateTracker::GetInstance()->EndRenderPass();
+  src_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  staging.texture->CopyFromImage(command_buffer, src_texture->GetImage(),
+    VK_IMAGE_ASPECT_COLOR_BIT, rect.left, rect.top, width, height, 0, 0);
+  staging.pending_fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+  return true;
+}
+
+bool AsyncReadback::IsSlotReady(size_t slot)
+{
+  return m_staging_slots[slot].pending_fence == VK_NULL_HANDLE;
+}
+
+const u8* AsyncReadback::MapSlot(size_t slot, u32* stride)
+{
+  StagingSlot& staging = m_staging_slots[slot];
+  if (staging.pending_fence != VK_NULL_HANDLE)
+  {
+    // The fence callback clears the fence.
+    if (staging.pending_fence == g_command_buffer_mgr->GetCurrentCommandBufferFence())
+    {
+      StateTracker::GetInstance()->OnReadback();
+      Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+    }
+    else
+    {
+      g_command_buffer_mgr->WaitForFence(staging.pending_fence);
+    }
+  }
+
+  staging.texture->InvalidateCPUCache();
+  *stride = staging.texture->GetRowStride();
+  return reinterpret_cast<const u8*>(staging.texture->GetMapPointer());
+}
+
+void AsyncReadback::OnCommandBufferExecuted(VkFence fence)
+{
+  for (StagingSlot& staging : m_staging_slots)
+  {
+    if (staging.pending_fence == fence)
+      staging.pending_fence = VK_NULL_HANDLE;
+  }
+}
+}  // namespace Vulkan
@@ -0,0 +1,42 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "VideoBackends/Vulkan/Constants.h"
+#include "VideoCommon/AsyncReadbackBase.h"
+
+namespace Vulkan
+{
+class StagingTexture2D;
+
+// Reads Texture2Ds back through staging textures, a slot is ready once the command buffer that
+// copied into it executed.
+class AsyncReadback final : public AsyncReadbackBase
+{
+public:
+  explicit AsyncReadback(size_t ring_size);
+  ~AsyncReadback();
+
+protected:
+  bool CopyToSlot(size_t slot, uintptr_t texture, const MathUtil::Rectangle<int>& rect) override;
+  bool IsSlotReady(size_t slot) override;
+  const u8* MapSlot(size_t slot, u32* stride) override;
+  void UnmapSlot(size_t slot) override {}
+
+private:
+  struct StagingSlot
+  {
+    std::unique_ptr<StagingTexture2D> texture;
+    VkFence pending_fence = VK_NULL_HANDLE;
+  };
+
+  void OnCommandBufferExecuted(VkFence fence);
+
+  std::vector<StagingSlot> m_staging_slots;
+};
+}  // namespace Vulkan
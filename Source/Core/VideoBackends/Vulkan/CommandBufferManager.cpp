@@ -14,8 +14,9 @@
 
 namespace Vulkan
 {
-CommandBufferManager::CommandBufferManager(bool use_threaded_submission)
-  : m_submit_semaphore(1, 1), m_use_threaded_submission(use_threaded_submission)
+CommandBufferManager::CommandBufferManager(bool use_threaded_submission, bool use_async_compute)
+  : m_submit_semaphore(1, 1), m_use_threaded_submission(use_threaded_submission),
+  m_use_async_compute(use_async_compute)
 {
 }
 
@@ -55,6 +56,7 @@ bool CommandBufferManager::CreateCommandBuffers()
   {
     resources.init_command_buffer_used = false;
     resources.needs_fence_wait = false;
+    resources.compute_command_buffer_used = false;
 
     VkCommandPoolCreateInfo pool_info = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
       g_vulkan_context->GetGraphicsQueueFamilyIndex() };
@@ -77,6 +79,9 @@ bool CommandBufferManager::CreateCommandBuffers()
       return false;
     }
 
+    if (m_use_async_compute && !CreateComputeCommandBuffer(resources))
+      return false;
+
     VkFenceCreateInfo fence_info = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr,
       VK_FENCE_CREATE_SIGNALED_BIT };
 
@@ -92,7 +97,8 @@ bool CommandBufferManager::CreateCommandBuffers()
     { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 500000 },
     { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 16 },
     { VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 16384 },
-    { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16384 } };
+    { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 16384 },
+    { VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 16384 } };
 
     VkDescriptorPoolCreateInfo pool_create_info = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
       nullptr,
@@ -115,6 +121,39 @@ bool CommandBufferManager::CreateCommandBuffers()
   return true;
 }
 
+bool CommandBufferManager::CreateComputeCommandBuffer(FrameResources& resources)
+{
+  VkDevice device = g_vulkan_context->GetDevice();
+  VkCommandPoolCreateInfo pool_info = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, nullptr, 0,
+    g_vulkan_context->GetComputeQueueFamilyIndex() };
+  VkResult res = vkCreateCommandPool(device, &pool_info, nullptr, &resources.compute_command_pool);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateCommandPool failed: ");
+    return false;
+  }
+
+  VkCommandBufferAllocateInfo buffer_info = {
+    VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, resources.compute_command_pool,
+    VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1 };
+  res = vkAllocateCommandBuffers(device, &buffer_info, &resources.compute_command_buffer);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkAllocateCommandBuffers failed: ");
+    return false;
+  }
+
+  VkSemaphoreCreateInfo semaphore_info = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, nullptr, 0 };
+  res = vkCreateSemaphore(device, &semaphore_info, nullptr, &resources.compute_semaphore);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateSemaphore failed: ");
+    return false;
+  }
+
+  return true;
+}
+
 void CommandBufferManager::DestroyCommandBuffers()
 {
   VkDevice device = g_vulkan_context->GetDevice();
@@ -148,6 +187,18 @@ void CommandBufferManager::DestroyCommandBuffers()
       vkDestroyCommandPool(device, resources.command_pool, nullptr);
       resources.command_pool = VK_NULL_HANDLE;
     }
+    if (resources.compute_semaphore != VK_NULL_HANDLE)
+    {
+      vkDestroySemaphore(device, resources.compute_semaphore, nullptr);
+      resources.compute_semaphore = VK_NULL_HANDLE;
+    }
+    if (resources.compute_command_pool != VK_NULL_HANDLE)
+    {
+      // Destroying the pool frees the command buffer.
+      vkDestroyCommandPool(device, resources.compute_command_pool, nullptr);
+      resources.compute_command_pool = VK_NULL_HANDLE;
+      resources.compute_command_buffer = VK_NULL_HANDLE;
+    }
   }
 }
 
@@ -267,6 +318,15 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
       PanicAlert("Failed to end command buffer");
     }
   }
+  if (m_use_async_compute)
+  {
+    VkResult res = vkEndCommandBuffer(resources.compute_command_buffer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkEndCommandBuffer failed: ");
+      PanicAlert("Failed to end command buffer");
+    }
+  }
 
   // This command buffer now has commands, so can't be re-used without waiting.
   resources.needs_fence_wait = true;
@@ -300,12 +360,46 @@ void CommandBufferManager::SubmitCommandBuffer(size_t index, VkSemaphore wait_se
   FrameResources& resources = m_frame_resources[index];
 
   // This may be executed on the worker thread, so don't modify any state of the manager class.
-  uint32_t wait_bits = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  std::array<VkSemaphore, 2> wait_semaphores;
+  std::array<VkPipelineStageFlags, 2> wait_stages;
+  u32 wait_semaphore_count = 0;
+  if (wait_semaphore != VK_NULL_HANDLE)
+  {
+    wait_semaphores[wait_semaphore_count] = wait_semaphore;
+    wait_stages[wait_semaphore_count++] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  }
+
+  // The async compute work goes first. The results are only read by transfers, so the graphics
+  // queue can start on everything before those while the compute queue is busy.
+  VkResult res;
+  if (resources.compute_command_buffer_used)
+  {
+    VkSubmitInfo compute_submit_info = { VK_STRUCTURE_TYPE_SUBMIT_INFO,
+      nullptr,
+      0,
+      nullptr,
+      nullptr,
+      1,
+      &resources.compute_command_buffer,
+      1,
+      &resources.compute_semaphore };
+    res = vkQueueSubmit(g_vulkan_context->GetComputeQueue(), 1, &compute_submit_info,
+      VK_NULL_HANDLE);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkQueueSubmit failed: ");
+      PanicAlert("Failed to submit command buffer.");
+    }
+
+    wait_semaphores[wait_semaphore_count] = resources.compute_semaphore;
+    wait_stages[wait_semaphore_count++] = VK_PIPELINE_STAGE_TRANSFER_BIT;
+  }
+
   VkSubmitInfo submit_info = { VK_STRUCTURE_TYPE_SUBMIT_INFO,
     nullptr,
-    0,
-    nullptr,
-    &wait_bits,
+    wait_semaphore_count,
+    wait_semaphores.data(),
+    wait_stages.data(),
     static_cast<u32>(resources.command_buffers.size()),
     resources.command_buffers.data(),
     0,
@@ -318,20 +412,13 @@ void CommandBufferManager::SubmitCommandBuffer(size_t index, VkSemaphore wait_se
     submit_info.pCommandBuffers = &m_frame_resources[index].command_buffers[1];
   }
 
-  if (wait_semaphore != VK_NULL_HANDLE)
-  {
-    submit_info.pWaitSemaphores = &wait_semaphore;
-    submit_info.waitSemaphoreCount = 1;
-  }
-
   if (signal_semaphore != VK_NULL_HANDLE)
   {
     submit_info.signalSemaphoreCount = 1;
     submit_info.pSignalSemaphores = &signal_semaphore;
   }
 
-  VkResult res =
-    vkQueueSubmit(g_vulkan_context->GetGraphicsQueue(), 1, &submit_info, resources.fence);
+  res = vkQueueSubmit(g_vulkan_context->GetGraphicsQueue(), 1, &submit_info, resources.fence);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkQueueSubmit failed: ");
@@ -417,6 +504,17 @@ void CommandBufferManager::ActivateCommandBuffer()
       LOG_VULKAN_ERROR(res, "vkBeginCommandBuffer failed: ");
   }
 
+  // The fence also covers the compute work, the draw command buffers waited for it.
+  if (m_use_async_compute)
+  {
+    res = vkResetCommandPool(g_vulkan_context->GetDevice(), resources.compute_command_pool, 0);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetCommandPool failed: ");
+    res = vkBeginCommandBuffer(resources.compute_command_buffer, &begin_info);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkBeginCommandBuffer failed: ");
+  }
+
   // Also can do the same for the descriptor pools
   res = vkResetDescriptorPool(g_vulkan_context->GetDevice(), resources.descriptor_pool, 0);
   if (res != VK_SUCCESS)
@@ -424,6 +522,7 @@ void CommandBufferManager::ActivateCommandBuffer()
 
   // Reset upload command buffer state
   resources.init_command_buffer_used = false;
+  resources.compute_command_buffer_used = false;
 }
 
 void CommandBufferManager::ExecuteCommandBuffer(bool submit_off_thread, bool wait_for_completion)
@@ -460,6 +559,14 @@ void CommandBufferManager::DeferDeviceMemoryDestruction(VkDeviceMemory object)
     [object]() { vkFreeMemory(g_vulkan_context->GetDevice(), object, nullptr); });
 }
 
+void CommandBufferManager::DeferDeviceMemoryDestruction(
+  const VulkanContext::MemoryAllocation& allocation)
+{
+  FrameResources& resources = m_frame_resources[m_current_frame];
+  resources.cleanup_resources.push_back(
+    [allocation]() { g_vulkan_context->FreeMemory(allocation); });
+}
+
 void CommandBufferManager::DeferFramebufferDestruction(VkFramebuffer object)
 {
   FrameResources& resources = m_frame_resources[m_current_frame];
@@ -23,13 +23,14 @@
 
 #include "VideoBackends/Vulkan/Constants.h"
 #include "VideoBackends/Vulkan/Util.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
 
 namespace Vulkan
 {
 class CommandBufferManager
 {
 public:
-  explicit CommandBufferManager(bool use_threaded_submission);
+  CommandBufferManager(bool use_threaded_submission, bool use_async_compute);
   ~CommandBufferManager();
 
   bool Initialize();
@@ -45,6 +46,15 @@ public:
   {
     return m_frame_resources[m_current_frame].command_buffers[1];
   }
+  // Compute work recorded here runs on the async compute queue. It is submitted before the init and
+  // draw command buffers, which wait for it before their transfers. Only valid with
+  // UsesAsyncCompute().
+  bool UsesAsyncCompute() const { return m_use_async_compute; }
+  VkCommandBuffer GetCurrentComputeCommandBuffer()
+  {
+    m_frame_resources[m_current_frame].compute_command_buffer_used = true;
+    return m_frame_resources[m_current_frame].compute_command_buffer;
+  }
   VkDescriptorPool GetCurrentDescriptorPool() const
   {
     return m_frame_resources[m_current_frame].descriptor_pool;
@@ -86,6 +96,7 @@ public:
   void DeferBufferDestruction(VkBuffer object);
   void DeferBufferViewDestruction(VkBufferView object);
   void DeferDeviceMemoryDestruction(VkDeviceMemory object);
+  void DeferDeviceMemoryDestruction(const VulkanContext::MemoryAllocation& allocation);
   void DeferFramebufferDestruction(VkFramebuffer object);
   void DeferImageDestruction(VkImage object);
   void DeferImageViewDestruction(VkImageView object);
@@ -122,9 +133,17 @@ private:
     bool init_command_buffer_used;
     bool needs_fence_wait;
 
+    // Async compute work, signals compute_semaphore for the other command buffers to wait on.
+    VkCommandPool compute_command_pool;
+    VkCommandBuffer compute_command_buffer;
+    VkSemaphore compute_semaphore;
+    bool compute_command_buffer_used;
+
     std::vector<std::function<void()>> cleanup_resources;
   };
 
+  bool CreateComputeCommandBuffer(FrameResources& resources);
+
   std::array<FrameResources, NUM_COMMAND_BUFFERS> m_frame_resources = {};
   size_t m_current_frame;
 
@@ -149,6 +168,7 @@ private:
   std::mutex m_pending_submit_lock;
   Common::Flag m_present_failed_flag;
   bool m_use_threaded_submission = false;
+  bool m_use_async_compute = false;
 };
 
 extern std::unique_ptr<CommandBufferManager> g_command_buffer_mgr;
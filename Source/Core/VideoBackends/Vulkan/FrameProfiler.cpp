@@ -0,0 +1,75 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/Vulkan/FrameProfiler.h"
+
+#include <algorithm>
+
+#include "VideoBackends/Vulkan/CommandBufferManager.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
+
+namespace Vulkan
+{
+FrameProfiler::FrameProfiler()
+{
+  if (!g_vulkan_context->GetDeviceLimits().timestampComputeAndGraphics)
+    return;
+
+  VkQueryPoolCreateInfo info = {
+      VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,  // VkStructureType                  sType
+      nullptr,                                   // const void*                      pNext
+      0,                                         // VkQueryPoolCreateFlags           flags
+      VK_QUERY_TYPE_TIMESTAMP,                   // VkQueryType                      queryType
+      FRAME_COUNT * MAX_TIMESTAMPS,              // uint32_t                         queryCount
+      0  // VkQueryPipelineStatisticFlags    pipelineStatistics;
+  };
+
+  VkResult res = vkCreateQueryPool(g_vulkan_context->GetDevice(), &info, nullptr, &m_query_pool);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateQueryPool failed: ");
+    m_query_pool = VK_NULL_HANDLE;
+  }
+}
+
+FrameProfiler::~FrameProfiler()
+{
+  if (m_query_pool != VK_NULL_HANDLE)
+    vkDestroyQueryPool(g_vulkan_context->GetDevice(), m_query_pool, nullptr);
+}
+
+void FrameProfiler::BeginTimestamps(size_t frame)
+{
+  // The init command buffer runs before the draws, and outside of any render pass.
+  vkCmdResetQueryPool(g_command_buffer_mgr->GetCurrentInitCommandBuffer(), m_query_pool,
+                      static_cast<u32>(frame) * MAX_TIMESTAMPS, MAX_TIMESTAMPS);
+}
+
+void FrameProfiler::WriteTimestamp(size_t frame, u32 index)
+{
+  vkCmdWriteTimestamp(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_query_pool,
+                      static_cast<u32>(frame) * MAX_TIMESTAMPS + index);
+}
+
+bool FrameProfiler::ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns)
+{
+  VkResult res = vkGetQueryPoolResults(
+      g_vulkan_context->GetDevice(), m_query_pool, static_cast<u32>(frame) * MAX_TIMESTAMPS,
+      count, count * sizeof(u64), timestamps_ns, sizeof(u64), VK_QUERY_RESULT_64_BIT);
+  if (res == VK_NOT_READY)
+    return false;
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkGetQueryPoolResults failed: ");
+    std::fill_n(timestamps_ns, count, 0);
+    return true;
+  }
+
+  const double period = g_vulkan_context->GetDeviceLimits().timestampPeriod;
+  for (u32 i = 0; i < count; i++)
+    timestamps_ns[i] = static_cast<u64>(timestamps_ns[i] * period);
+  return true;
+}
+}  // namespace Vulkan
@@ -0,0 +1,28 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "VideoBackends/Vulkan/VulkanLoader.h"
+#include "VideoCommon/FrameProfilerBase.h"
+
+namespace Vulkan
+{
+// Writes the timestamps of the frames to a query pool, without one if the device can't.
+class FrameProfiler final : public FrameProfilerBase
+{
+public:
+  FrameProfiler();
+  ~FrameProfiler();
+
+protected:
+  bool SupportsTimestamps() const override { return m_query_pool != VK_NULL_HANDLE; }
+  void BeginTimestamps(size_t frame) override;
+  void WriteTimestamp(size_t frame, u32 index) override;
+  bool ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns) override;
+
+private:
+  VkQueryPool m_query_pool = VK_NULL_HANDLE;
+};
+}  // namespace Vulkan
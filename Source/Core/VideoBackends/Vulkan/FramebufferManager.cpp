@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <functional>
 
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
@@ -41,10 +42,14 @@ constexpr size_t POKE_VERTEX_BUFFER_SIZE = 8 * 1024 * 1024;
 
 FramebufferManager::FramebufferManager()
 {
+  g_command_buffer_mgr->AddFencePointCallback(
+    this, [](VkCommandBuffer, VkFence) {},
+    std::bind(&FramebufferManager::OnCommandBufferExecuted, this, std::placeholders::_1));
 }
 
 FramebufferManager::~FramebufferManager()
 {
+  g_command_buffer_mgr->RemoveFencePointCallback(this);
   DestroyEFBFramebuffer();
   DestroyEFBRenderPass();
 
@@ -424,6 +429,7 @@ void FramebufferManager::DestroyEFBFramebuffer()
 
 void FramebufferManager::ResizeEFBTextures()
 {
+  InvalidateEFBCaches();
   DestroyEFBFramebuffer();
   if (!CreateEFBFramebuffer())
     PanicAlert("Failed to create EFB textures");
@@ -496,15 +502,28 @@ Texture2D* FramebufferManager::ResolveEFBColorTexture(const VkRect2D& region)
   if (GetEFBSamples() == VK_SAMPLE_COUNT_1_BIT)
     return m_efb_color_texture.get();
 
-  // Can't resolve within a render pass.
-  StateTracker::GetInstance()->EndRenderPass();
-
   // It's not valid to resolve out-of-bounds coordinates.
   // Ensuring the region is within the image is the caller's responsibility.
   ASSERT(region.offset.x >= 0 && region.offset.y >= 0 &&
     (static_cast<u32>(region.offset.x) + region.extent.width) <= GetEFBWidth() &&
     (static_cast<u32>(region.offset.y) + region.extent.height) <= GetEFBHeight());
 
+  // Nothing was drawn there since the last resolve.
+  u32 left, top, right, bottom;
+  TargetToNativeRect(region, &left, &top, &right, &bottom);
+  if (m_color_resolve_cache.IsClean(left, top, right, bottom))
+    return m_efb_resolve_color_texture.get();
+
+  // Can't resolve within a render pass. Ending it can run EFB copies that resolve as well, so it
+  // has to be done before the tiles are marked clean.
+  StateTracker::GetInstance()->EndRenderPass();
+
+  // Resolve whole tiles, so that later copies from around the same area can skip it. Pokes that
+  // weren't drawn yet keep their tiles dirty.
+  const VkRect2D resolve_region = ExpandToResolveTiles(left, top, right, bottom);
+  if (m_color_poke_vertices.empty())
+    m_color_resolve_cache.SetClean(left, top, right, bottom, true);
+
   // Resolving is considered to be a transfer operation.
   m_efb_color_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
@@ -514,10 +533,10 @@ Texture2D* FramebufferManager::ResolveEFBColorTexture(const VkRect2D& region)
   // Resolve to our already-created texture.
   VkImageResolve resolve = {
     { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, GetEFBLayers() },  // VkImageSubresourceLayers srcSubresource
-    { region.offset.x, region.offset.y, 0 },              // VkOffset3D                  srcOffset
+    { resolve_region.offset.x, resolve_region.offset.y, 0 },  // VkOffset3D srcOffset
     { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, GetEFBLayers() },  // VkImageSubresourceLayers dstSubresource
-    { region.offset.x, region.offset.y, 0 },              // VkOffset3D                  dstOffset
-    { region.extent.width, region.extent.height, GetEFBLayers() }  // VkExtent3D extent
+    { resolve_region.offset.x, resolve_region.offset.y, 0 },  // VkOffset3D dstOffset
+    { resolve_region.extent.width, resolve_region.extent.height, GetEFBLayers() }  // VkExtent3D extent
   };
   vkCmdResolveImage(g_command_buffer_mgr->GetCurrentCommandBuffer(),
     m_efb_color_texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
@@ -536,9 +555,18 @@ Texture2D* FramebufferManager::ResolveEFBDepthTexture(const VkRect2D& region)
   if (GetEFBSamples() == VK_SAMPLE_COUNT_1_BIT)
     return m_efb_depth_texture.get();
 
-  // Can't resolve within a render pass.
+  u32 left, top, right, bottom;
+  TargetToNativeRect(region, &left, &top, &right, &bottom);
+  if (m_depth_resolve_cache.IsClean(left, top, right, bottom))
+    return m_efb_resolve_depth_texture.get();
+
+  // Can't resolve within a render pass, see ResolveEFBColorTexture.
   StateTracker::GetInstance()->EndRenderPass();
 
+  const VkRect2D resolve_region = ExpandToResolveTiles(left, top, right, bottom);
+  if (m_depth_poke_vertices.empty())
+    m_depth_resolve_cache.SetClean(left, top, right, bottom, true);
+
   m_efb_depth_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
@@ -547,10 +575,10 @@ Texture2D* FramebufferManager::ResolveEFBDepthTexture(const VkRect2D& region)
     g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_STANDARD),
     m_depth_resolve_render_pass, g_shader_cache->GetScreenQuadVertexShader(),
     g_shader_cache->GetScreenQuadGeometryShader(), m_ps_depth_resolve);
-  draw.BeginRenderPass(m_depth_resolve_framebuffer, region);
+  draw.BeginRenderPass(m_depth_resolve_framebuffer, resolve_region);
   draw.SetPSSampler(0, m_efb_depth_texture->GetView(), g_object_cache->GetPointSampler());
-  draw.SetViewportAndScissor(region.offset.x, region.offset.y, region.extent.width,
-    region.extent.height);
+  draw.SetViewportAndScissor(resolve_region.offset.x, resolve_region.offset.y,
+    resolve_region.extent.width, resolve_region.extent.height);
   draw.DrawWithoutVertexBuffer(4);
   draw.EndRenderPass();
 
@@ -705,19 +733,26 @@ void FramebufferManager::DestroyConversionShaders()
 
 u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
 {
-  if (!m_color_readback_texture_valid && !PopulateColorReadbackTexture())
-    return 0;
+  m_color_peek_cache.peeked = true;
+  if (!m_color_peek_cache.IsTileValid(x, y))
+  {
+    if (!PopulateColorReadbackTexture())
+      return 0;
+  }
+  else
+  {
+    WaitForPeekCache(&m_color_peek_cache, m_color_readback_texture.get());
+  }
 
   u32 value;
   m_color_readback_texture->ReadTexel(x, y, &value, sizeof(value));
   return value;
 }
 
-bool FramebufferManager::PopulateColorReadbackTexture()
+void FramebufferManager::CopyColorToReadbackTexture()
 {
   // Can't be in our normal render pass.
   StateTracker::GetInstance()->EndRenderPass();
-  StateTracker::GetInstance()->OnReadback();
 
   // Issue a copy from framebuffer -> copy texture if we have >1xIR or MSAA on.
   VkRect2D src_region = { { 0, 0 },{ GetEFBWidth(), GetEFBHeight() } };
@@ -771,6 +806,12 @@ bool FramebufferManager::PopulateColorReadbackTexture()
     src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
       VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
   }
+}
+
+bool FramebufferManager::PopulateColorReadbackTexture()
+{
+  StateTracker::GetInstance()->OnReadback();
+  CopyColorToReadbackTexture();
 
   // Wait until the copy is complete.
   Util::ExecuteCurrentCommandsAndRestoreState(false, true);
@@ -779,25 +820,33 @@ bool FramebufferManager::PopulateColorReadbackTexture()
   if (!m_color_readback_texture->IsMapped() && !m_color_readback_texture->Map())
     return false;
 
-  m_color_readback_texture_valid = true;
+  m_color_peek_cache.valid_tiles.fill(true);
+  m_color_peek_cache.pending_fence = VK_NULL_HANDLE;
   return true;
 }
 
 float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
 {
-  if (!m_depth_readback_texture_valid && !PopulateDepthReadbackTexture())
-    return 0.0f;
+  m_depth_peek_cache.peeked = true;
+  if (!m_depth_peek_cache.IsTileValid(x, y))
+  {
+    if (!PopulateDepthReadbackTexture())
+      return 0.0f;
+  }
+  else
+  {
+    WaitForPeekCache(&m_depth_peek_cache, m_depth_readback_texture.get());
+  }
 
   float value;
   m_depth_readback_texture->ReadTexel(x, y, &value, sizeof(value));
   return value;
 }
 
-bool FramebufferManager::PopulateDepthReadbackTexture()
+void FramebufferManager::CopyDepthToReadbackTexture()
 {
   // Can't be in our normal render pass.
   StateTracker::GetInstance()->EndRenderPass();
-  StateTracker::GetInstance()->OnReadback();
 
   // Issue a copy from framebuffer -> copy texture if we have >1xIR or MSAA on.
   VkRect2D src_region = { { 0, 0 },{ GetEFBWidth(), GetEFBHeight() } };
@@ -855,6 +904,12 @@ bool FramebufferManager::PopulateDepthReadbackTexture()
     src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
       VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
   }
+}
+
+bool FramebufferManager::PopulateDepthReadbackTexture()
+{
+  StateTracker::GetInstance()->OnReadback();
+  CopyDepthToReadbackTexture();
 
   // Wait until the copy is complete.
   Util::ExecuteCurrentCommandsAndRestoreState(false, true);
@@ -863,14 +918,174 @@ bool FramebufferManager::PopulateDepthReadbackTexture()
   if (!m_depth_readback_texture->IsMapped() && !m_depth_readback_texture->Map())
     return false;
 
-  m_depth_readback_texture_valid = true;
+  m_depth_peek_cache.valid_tiles.fill(true);
+  m_depth_peek_cache.pending_fence = VK_NULL_HANDLE;
   return true;
 }
 
-void FramebufferManager::InvalidatePeekCache()
+void FramebufferManager::WaitForPeekCache(PeekCache* cache, StagingTexture2D* readback_texture)
 {
-  m_color_readback_texture_valid = false;
-  m_depth_readback_texture_valid = false;
+  if (cache->pending_fence == VK_NULL_HANDLE)
+    return;
+
+  // Still a CPU access, the background kicks are scheduled from these.
+  StateTracker::GetInstance()->OnReadback();
+
+  // The copy may not have left the command buffer being recorded yet.
+  if (cache->pending_fence == g_command_buffer_mgr->GetCurrentCommandBufferFence())
+    Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+  else
+    g_command_buffer_mgr->WaitForFence(cache->pending_fence);
+
+  // Waiting fires OnCommandBufferExecuted, which clears the fence.
+  cache->pending_fence = VK_NULL_HANDLE;
+  readback_texture->InvalidateCPUCache();
+}
+
+void FramebufferManager::OnCommandBufferExecuted(VkFence fence)
+{
+  for (PeekCache* cache : {&m_color_peek_cache, &m_depth_peek_cache})
+  {
+    if (cache->pending_fence != fence)
+      continue;
+
+    cache->pending_fence = VK_NULL_HANDLE;
+    StagingTexture2D* readback_texture = cache == &m_color_peek_cache ?
+      m_color_readback_texture.get() :
+      m_depth_readback_texture.get();
+    readback_texture->InvalidateCPUCache();
+  }
+}
+
+bool FramebufferManager::PeekCache::HasInvalidTiles() const
+{
+  return std::find(valid_tiles.begin(), valid_tiles.end(), false) != valid_tiles.end();
+}
+
+void FramebufferManager::PeekCache::Invalidate(u32 left, u32 top, u32 right, u32 bottom)
+{
+  // right and bottom are exclusive.
+  if (left >= right || top >= bottom)
+    return;
+
+  const u32 last_x = std::min(right - 1, EFB_WIDTH - 1u) / PEEK_TILE_SIZE;
+  const u32 last_y = std::min(bottom - 1, EFB_HEIGHT - 1u) / PEEK_TILE_SIZE;
+  for (u32 y = top / PEEK_TILE_SIZE; y <= last_y; y++)
+  {
+    for (u32 x = left / PEEK_TILE_SIZE; x <= last_x; x++)
+      valid_tiles[y * PEEK_TILES_WIDE + x] = false;
+  }
+}
+
+bool FramebufferManager::ResolveCache::IsClean(u32 left, u32 top, u32 right, u32 bottom) const
+{
+  if (left >= right || top >= bottom)
+    return true;
+
+  const u32 last_x = std::min(right - 1, EFB_WIDTH - 1u) / PEEK_TILE_SIZE;
+  const u32 last_y = std::min(bottom - 1, EFB_HEIGHT - 1u) / PEEK_TILE_SIZE;
+  for (u32 y = top / PEEK_TILE_SIZE; y <= last_y; y++)
+  {
+    for (u32 x = left / PEEK_TILE_SIZE; x <= last_x; x++)
+    {
+      if (!clean_tiles[y * PEEK_TILES_WIDE + x])
+        return false;
+    }
+  }
+  return true;
+}
+
+void FramebufferManager::ResolveCache::SetClean(u32 left, u32 top, u32 right, u32 bottom,
+  bool clean)
+{
+  if (left >= right || top >= bottom)
+    return;
+
+  const u32 last_x = std::min(right - 1, EFB_WIDTH - 1u) / PEEK_TILE_SIZE;
+  const u32 last_y = std::min(bottom - 1, EFB_HEIGHT - 1u) / PEEK_TILE_SIZE;
+  for (u32 y = top / PEEK_TILE_SIZE; y <= last_y; y++)
+  {
+    for (u32 x = left / PEEK_TILE_SIZE; x <= last_x; x++)
+      clean_tiles[y * PEEK_TILES_WIDE + x] = clean;
+  }
+}
+
+void FramebufferManager::TargetToNativeRect(const VkRect2D& region, u32* left, u32* top,
+  u32* right, u32* bottom) const
+{
+  const u32 target_width = GetEFBWidth();
+  const u32 target_height = GetEFBHeight();
+  *left = static_cast<u32>(std::max(region.offset.x, 0)) * EFB_WIDTH / target_width;
+  *top = static_cast<u32>(std::max(region.offset.y, 0)) * EFB_HEIGHT / target_height;
+  *right = static_cast<u32>(
+    (static_cast<u64>(std::max(region.offset.x, 0)) + region.extent.width) * EFB_WIDTH +
+    target_width - 1) / target_width;
+  *bottom = static_cast<u32>(
+    (static_cast<u64>(std::max(region.offset.y, 0)) + region.extent.height) * EFB_HEIGHT +
+    target_height - 1) / target_height;
+}
+
+VkRect2D FramebufferManager::ExpandToResolveTiles(u32 left, u32 top, u32 right,
+  u32 bottom) const
+{
+  // Round out to tile boundaries in native coordinates, then scale to the target, rounding
+  // outwards again so every target pixel touching a tile is included.
+  const u32 target_width = GetEFBWidth();
+  const u32 target_height = GetEFBHeight();
+  left = left / PEEK_TILE_SIZE * PEEK_TILE_SIZE;
+  top = top / PEEK_TILE_SIZE * PEEK_TILE_SIZE;
+  right = std::min((right + PEEK_TILE_SIZE - 1) / PEEK_TILE_SIZE * PEEK_TILE_SIZE,
+    static_cast<u32>(EFB_WIDTH));
+  bottom = std::min((bottom + PEEK_TILE_SIZE - 1) / PEEK_TILE_SIZE * PEEK_TILE_SIZE,
+    static_cast<u32>(EFB_HEIGHT));
+
+  const u32 target_left = left * target_width / EFB_WIDTH;
+  const u32 target_top = top * target_height / EFB_HEIGHT;
+  const u32 target_right =
+    std::min((right * target_width + EFB_WIDTH - 1) / EFB_WIDTH, target_width);
+  const u32 target_bottom =
+    std::min((bottom * target_height + EFB_HEIGHT - 1) / EFB_HEIGHT, target_height);
+  return { { static_cast<s32>(target_left), static_cast<s32>(target_top) },
+    { target_right - target_left, target_bottom - target_top } };
+}
+
+void FramebufferManager::InvalidateEFBCaches(const VkRect2D& region)
+{
+  u32 left, top, right, bottom;
+  TargetToNativeRect(region, &left, &top, &right, &bottom);
+  m_color_peek_cache.Invalidate(left, top, right, bottom);
+  m_depth_peek_cache.Invalidate(left, top, right, bottom);
+  m_color_resolve_cache.SetClean(left, top, right, bottom, false);
+  m_depth_resolve_cache.SetClean(left, top, right, bottom, false);
+}
+
+void FramebufferManager::InvalidateEFBCaches()
+{
+  m_color_peek_cache.valid_tiles.fill(false);
+  m_depth_peek_cache.valid_tiles.fill(false);
+  m_color_resolve_cache.clean_tiles.fill(false);
+  m_depth_resolve_cache.clean_tiles.fill(false);
+}
+
+void FramebufferManager::PrefetchPeekCache()
+{
+  // Only worth it for the caches the game peeks. The tiles become valid right away, the values
+  // are there once the command buffer executed.
+  VkFence fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+  if (m_color_peek_cache.peeked && m_color_peek_cache.HasInvalidTiles())
+  {
+    CopyColorToReadbackTexture();
+    m_color_peek_cache.valid_tiles.fill(true);
+    m_color_peek_cache.pending_fence = fence;
+    m_color_peek_cache.peeked = false;
+  }
+  if (m_depth_peek_cache.peeked && m_depth_peek_cache.HasInvalidTiles())
+  {
+    CopyDepthToReadbackTexture();
+    m_depth_peek_cache.valid_tiles.fill(true);
+    m_depth_peek_cache.pending_fence = fence;
+    m_depth_peek_cache.peeked = false;
+  }
 }
 
 bool FramebufferManager::CreateReadbackRenderPasses()
@@ -1058,10 +1273,10 @@ void FramebufferManager::DestroyReadbackTextures()
 {
   m_color_copy_texture.reset();
   m_color_readback_texture.reset();
-  m_color_readback_texture_valid = false;
+  m_color_peek_cache = {};
   m_depth_copy_texture.reset();
   m_depth_readback_texture.reset();
-  m_depth_readback_texture_valid = false;
+  m_depth_peek_cache = {};
 }
 
 bool FramebufferManager::CreateReadbackFramebuffer()
@@ -1121,10 +1336,17 @@ void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
     FlushEFBPokes();
 
   CreatePokeVertices(&m_color_poke_vertices, x, y, 0.0f, color);
+  m_color_resolve_cache.SetClean(x, y, x + 1, y + 1, false);
 
-  // Update the peek cache if it's valid, since we know the color of the pixel now.
-  if (m_color_readback_texture_valid)
-    m_color_readback_texture->WriteTexel(x, y, &color, sizeof(color));
+  // Update the peek cache if it's valid, since we know the color of the pixel now. A pending copy
+  // would overwrite the value, so drop the tile instead.
+  if (m_color_peek_cache.IsTileValid(x, y))
+  {
+    if (m_color_peek_cache.pending_fence == VK_NULL_HANDLE)
+      m_color_readback_texture->WriteTexel(x, y, &color, sizeof(color));
+    else
+      m_color_peek_cache.Invalidate(x, y, x + 1, y + 1);
+  }
 }
 
 void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
@@ -1134,10 +1356,16 @@ void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
     FlushEFBPokes();
 
   CreatePokeVertices(&m_depth_poke_vertices, x, y, depth, 0);
+  m_depth_resolve_cache.SetClean(x, y, x + 1, y + 1, false);
 
   // Update the peek cache if it's valid, since we know the color of the pixel now.
-  if (m_depth_readback_texture_valid)
-    m_depth_readback_texture->WriteTexel(x, y, &depth, sizeof(depth));
+  if (m_depth_peek_cache.IsTileValid(x, y))
+  {
+    if (m_depth_peek_cache.pending_fence == VK_NULL_HANDLE)
+      m_depth_readback_texture->WriteTexel(x, y, &depth, sizeof(depth));
+    else
+      m_depth_peek_cache.Invalidate(x, y, x + 1, y + 1);
+  }
 }
 
 void FramebufferManager::CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x,
@@ -1239,8 +1467,11 @@ void FramebufferManager::DrawPokeVertices(const EFBPokeVertex* vertices, size_t
   std::memcpy(m_poke_vertex_stream_buffer->GetCurrentHostPointer(), vertices, vertices_size);
   m_poke_vertex_stream_buffer->CommitMemory(vertices_size);
 
-  // Set up state.
+  // Set up state. Pokes can land anywhere, so the EFB copies waiting for the end of the render
+  // pass have to read the EFB first.
   StateTracker::GetInstance()->EndClearRenderPass();
+  if (TextureCache::GetInstance()->HasPendingTextureCopies())
+    StateTracker::GetInstance()->EndRenderPass();
   StateTracker::GetInstance()->BeginRenderPass();
   StateTracker::GetInstance()->SetPendingRebind();
   Util::SetViewportAndScissor(command_buffer, 0, 0, GetEFBWidth(), GetEFBHeight());
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 
@@ -78,7 +79,12 @@ public:
   // Reads a framebuffer value back from the GPU. This may block if the cache is not current.
   u32 PeekEFBColor(u32 x, u32 y);
   float PeekEFBDepth(u32 x, u32 y);
-  void InvalidatePeekCache();
+  // Drops the peeked values and resolved tiles under a region of the EFB, in target coordinates.
+  void InvalidateEFBCaches(const VkRect2D& region);
+  void InvalidateEFBCaches();
+  // Copies the EFB to the peek caches that were used since the last prefetch, without waiting
+  // for the copy. Call right before the command buffer is executed in the background.
+  void PrefetchPeekCache();
 
   // Writes a value to the framebuffer. This will never block, and writes will be batched.
   void PokeEFBColor(u32 x, u32 y, u32 color);
@@ -115,8 +121,52 @@ private:
   bool CompilePokeShaders();
   void DestroyPokeShaders();
 
+  // The peek caches are split in tiles, so a draw only invalidates the values under it.
+  static constexpr u32 PEEK_TILE_SIZE = 64;
+  static constexpr u32 PEEK_TILES_WIDE = (EFB_WIDTH + PEEK_TILE_SIZE - 1) / PEEK_TILE_SIZE;
+  static constexpr u32 PEEK_TILES_HIGH = (EFB_HEIGHT + PEEK_TILE_SIZE - 1) / PEEK_TILE_SIZE;
+
+  struct PeekCache
+  {
+    std::array<bool, PEEK_TILES_WIDE * PEEK_TILES_HIGH> valid_tiles = {};
+    // The command buffer holding the last copy, until it executed.
+    VkFence pending_fence = VK_NULL_HANDLE;
+    // Peeked since the last prefetch.
+    bool peeked = false;
+
+    bool IsTileValid(u32 x, u32 y) const
+    {
+      return valid_tiles[(y / PEEK_TILE_SIZE) * PEEK_TILES_WIDE + x / PEEK_TILE_SIZE];
+    }
+    bool HasInvalidTiles() const;
+    void Invalidate(u32 left, u32 top, u32 right, u32 bottom);
+  };
+
+  // Tiles of a resolve texture that still match the multisampled EFB, so resolving them again can
+  // be skipped.
+  struct ResolveCache
+  {
+    std::array<bool, PEEK_TILES_WIDE * PEEK_TILES_HIGH> clean_tiles = {};
+
+    // Coordinates are native, right and bottom exclusive.
+    bool IsClean(u32 left, u32 top, u32 right, u32 bottom) const;
+    void SetClean(u32 left, u32 top, u32 right, u32 bottom, bool clean);
+  };
+
+  // Scales a region in target coordinates to native EFB coordinates, rounding outwards.
+  void TargetToNativeRect(const VkRect2D& region, u32* left, u32* top, u32* right,
+    u32* bottom) const;
+  // Returns the region covering whole tiles under a region, both in target coordinates.
+  VkRect2D ExpandToResolveTiles(u32 left, u32 top, u32 right, u32 bottom) const;
+
+  // Records a copy of the EFB to the readback texture in the current command buffer.
+  void CopyColorToReadbackTexture();
+  void CopyDepthToReadbackTexture();
   bool PopulateColorReadbackTexture();
   bool PopulateDepthReadbackTexture();
+  // Waits for the copy the tiles of a peek cache came from, when it has not executed yet.
+  void WaitForPeekCache(PeekCache* cache, StagingTexture2D* readback_texture);
+  void OnCommandBufferExecuted(VkFence fence);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
     u32 color);
@@ -151,8 +201,10 @@ private:
   // CPU-side EFB readback texture
   std::unique_ptr<StagingTexture2D> m_color_readback_texture;
   std::unique_ptr<StagingTexture2D> m_depth_readback_texture;
-  bool m_color_readback_texture_valid = false;
-  bool m_depth_readback_texture_valid = false;
+  PeekCache m_color_peek_cache;
+  PeekCache m_depth_peek_cache;
+  ResolveCache m_color_resolve_cache;
+  ResolveCache m_depth_resolve_cache;
 
   // EFB poke drawing setup
   std::unique_ptr<VertexFormat> m_poke_vertex_format;
@@ -120,6 +120,32 @@ void PerfQuery::EndQuery()
 
 void PerfQuery::ResetQuery()
 {
+  // With approximate counters, the queries of the measurement that ends stay in flight and its
+  // counters are published once the last of them is processed.
+  if (ShouldApproximate() && m_query_count > 0)
+  {
+    PendingMeasurement measurement;
+    measurement.pending_queries = m_query_count - m_pending_measurement_queries;
+    std::copy_n(m_results, ArraySize(m_results), measurement.results.begin());
+    std::fill_n(m_results, ArraySize(m_results), 0);
+    m_pending_measurements.push_back(measurement);
+    m_pending_measurement_queries += measurement.pending_queries;
+    PublishFinishedMeasurements();
+
+    // Only wait when the GPU is several measurements behind.
+    while (m_pending_measurements.size() > MAX_PENDING_MEASUREMENTS)
+      BlockingPartialFlush();
+    return;
+  }
+
+  if (ShouldApproximate())
+  {
+    for (u32 i = 0; i < PQG_NUM_MEMBERS; i++)
+      m_approximate_results[i] = m_results[i];
+  }
+  m_pending_measurements.clear();
+  m_pending_measurement_queries = 0;
+
   m_query_count = 0;
   m_query_read_pos = 0;
   std::fill_n(m_results, ArraySize(m_results), 0);
@@ -140,22 +166,23 @@ void PerfQuery::ResetQuery()
 u32 PerfQuery::GetQueryResult(PerfQueryType type)
 {
   u32 result = 0;
+  const volatile u32* results = ShouldApproximate() ? m_approximate_results : m_results;
 
   if (type == PQ_ZCOMP_INPUT_ZCOMPLOC || type == PQ_ZCOMP_OUTPUT_ZCOMPLOC)
   {
-    result = m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = results[PQG_ZCOMP_ZCOMPLOC];
   }
   else if (type == PQ_ZCOMP_INPUT || type == PQ_ZCOMP_OUTPUT)
   {
-    result = m_results[PQG_ZCOMP];
+    result = results[PQG_ZCOMP];
   }
   else if (type == PQ_BLEND_INPUT)
   {
-    result = m_results[PQG_ZCOMP] + m_results[PQG_ZCOMP_ZCOMPLOC];
+    result = results[PQG_ZCOMP] + results[PQG_ZCOMP_ZCOMPLOC];
   }
   else if (type == PQ_EFB_COPY_CLOCKS)
   {
-    result = m_results[PQG_EFB_COPY_CLOCKS];
+    result = results[PQG_EFB_COPY_CLOCKS];
   }
 
   return result / 4;
@@ -341,15 +368,42 @@ void PerfQuery::ProcessResults(u32 start_index, u32 query_count)
     DEBUG_LOG(VIDEO, "  query result %u", result);
 
     // NOTE: Reported pixel metrics should be referenced to native resolution
-    m_results[entry.query_type] +=
+    AddResult(entry.query_type,
       static_cast<u32>(static_cast<u64>(result) * EFB_WIDTH / g_renderer->GetTargetWidth() *
-        EFB_HEIGHT / g_renderer->GetTargetHeight());
+        EFB_HEIGHT / g_renderer->GetTargetHeight()));
   }
 
   m_query_read_pos = (m_query_read_pos + query_count) % PERF_QUERY_BUFFER_SIZE;
   m_query_count -= query_count;
 }
 
+void PerfQuery::AddResult(u32 index, u32 value)
+{
+  // Queries are processed in the order they were made, so the oldest pending measurement gets
+  // the result.
+  if (m_pending_measurements.empty())
+  {
+    m_results[index] += value;
+    return;
+  }
+
+  PendingMeasurement& measurement = m_pending_measurements.front();
+  measurement.results[index] += value;
+  measurement.pending_queries--;
+  m_pending_measurement_queries--;
+  PublishFinishedMeasurements();
+}
+
+void PerfQuery::PublishFinishedMeasurements()
+{
+  while (!m_pending_measurements.empty() && m_pending_measurements.front().pending_queries == 0)
+  {
+    for (u32 i = 0; i < PQG_NUM_MEMBERS; i++)
+      m_approximate_results[i] = m_pending_measurements.front().results[i];
+    m_pending_measurements.pop_front();
+  }
+}
+
 void PerfQuery::NonBlockingPartialFlush()
 {
   if (IsFlushed())
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <memory>
 
 #include "Common/CommonTypes.h"
@@ -33,6 +34,7 @@ public:
   u32 GetQueryResult(PerfQueryType type) override;
   void FlushResults() override;
   bool IsFlushed() const override;
+  bool SupportsApproximateResults() const override { return true; }
 
 private:
   struct ActiveQuery
@@ -48,6 +50,9 @@ private:
   void QueueCopyQueryResults(VkCommandBuffer command_buffer, VkFence fence, u32 start_index,
     u32 query_count);
   void ProcessResults(u32 start_index, u32 query_count);
+  void AddResult(u32 index, u32 value);
+  // Publishes the measurements whose queries were all processed, oldest first.
+  void PublishFinishedMeasurements();
 
   void OnCommandBufferQueued(VkCommandBuffer command_buffer, VkFence fence);
   void OnCommandBufferExecuted(VkFence fence);
@@ -67,6 +72,20 @@ private:
 
   // Buffer containing query results. Each query is a u32.
   std::unique_ptr<StagingBuffer> m_readback_buffer;
+
+  // A measurement that ResetQuery ended while some of its queries were in flight, for the
+  // approximate counters.
+  struct PendingMeasurement
+  {
+    u32 pending_queries;
+    std::array<u32, PQG_NUM_MEMBERS> results;
+  };
+  static const size_t MAX_PENDING_MEASUREMENTS = 4;
+  std::deque<PendingMeasurement> m_pending_measurements;
+  // The in-flight queries of all pending measurements.
+  u32 m_pending_measurement_queries = 0;
+  // The counters of the last finished measurement, read by the CPU thread.
+  volatile u32 m_approximate_results[PQG_NUM_MEMBERS] = {};
   bool m_query_enabled{};
   PerfQueryGroup  m_type{};
 };
@@ -24,6 +24,7 @@
 
 
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/Statistics.h"
 
 namespace Vulkan
@@ -134,6 +135,27 @@ uintptr_t VulkanPostProcessingShader::CreateBindingSampler(const PostProcessingS
 }
 
 bool VulkanPostProcessingShader::RecompileShaders()
+{
+  return RecompileShaderBinaries();
+}
+
+static bool CompilePassShaderBinary(const std::string& source, std::vector<u8>* binary)
+{
+  ShaderCompiler::SPIRVCodeVector code;
+  if (!ShaderCompiler::CompileFragmentShader(&code, source.c_str(), source.length()))
+    return false;
+
+  const u8* code_bytes = reinterpret_cast<const u8*>(code.data());
+  binary->assign(code_bytes, code_bytes + code.size() * sizeof(ShaderCompiler::SPIRVCodeType));
+  return true;
+}
+
+PostProcessingShader::ShaderBinaryCompiler VulkanPostProcessingShader::GetShaderBinaryCompiler() const
+{
+  return CompilePassShaderBinary;
+}
+
+std::string VulkanPostProcessingShader::GetPassShaderSource(size_t pass_index) const
 {
   static const char* definitions =
     "#define API_VULKAN 1\n"
@@ -142,33 +164,25 @@ bool VulkanPostProcessingShader::RecompileShaders()
     "#define DEPTH_BUFFER_INPUT_INDEX %i\n"
     "#define PREV_OUTPUT_INPUT_INDEX %i\n";
 
-  std::string common_source = PostProcessor::GetCommonFragmentShaderSource(API_VULKAN, m_config, 0);
-  for (size_t i = 0; i < m_passes.size(); i++)
-  {
-    RenderPassData& pass = m_passes[i];
-    const PostProcessingShaderConfiguration::RenderPass& pass_config = m_config->GetPass(i);
-
-    int color_buffer_index = 0;
-    int depth_buffer_index = 0;
-    int prev_output_index = 0;
+  const PostProcessingShaderConfiguration::RenderPass& pass_config = m_config->GetPass(pass_index);
+  int color_buffer_index = 0;
+  int depth_buffer_index = 0;
+  int prev_output_index = 0;
+  pass_config.GetInputLocations(color_buffer_index, depth_buffer_index, prev_output_index);
 
-    pass_config.GetInputLocations(color_buffer_index, depth_buffer_index, prev_output_index);
+  return StringFromFormat(definitions, color_buffer_index, depth_buffer_index, prev_output_index) +
+    PostProcessor::GetCommonFragmentShaderSource(API_VULKAN, m_config, 0) +
+    PostProcessor::GetPassFragmentShaderSource(API_VULKAN, m_config, &pass_config);
+}
 
-    std::string hlsl_source = PostProcessor::GetPassFragmentShaderSource(API_VULKAN, m_config, &pass_config);
-    ReleasePassNativeResources(pass);
-    RenderPassVulkanData* pixel_shader = new RenderPassVulkanData();
-    pass.shader = reinterpret_cast<uintptr_t>(pixel_shader);
-    std::string fullcode = StringFromFormat(definitions, color_buffer_index, depth_buffer_index, prev_output_index) + common_source + hlsl_source;
-    pixel_shader->m_fragment_shader = Util::CompileAndCreateFragmentShader(fullcode);
-    if (pixel_shader->m_fragment_shader == VK_NULL_HANDLE)
-    {
-      ReleasePassNativeResources(pass);
-      ERROR_LOG(VIDEO, "Failed to compile post-processing shader %s (pass %s)", m_config->GetShaderName().c_str(), pass_config.entry_point.c_str());
-      m_ready = false;
-      return false;
-    }
-  }
-  return true;
+bool VulkanPostProcessingShader::CreatePassShader(RenderPassData& pass, const std::vector<u8>& binary)
+{
+  ReleasePassNativeResources(pass);
+  RenderPassVulkanData* pixel_shader = new RenderPassVulkanData();
+  pass.shader = reinterpret_cast<uintptr_t>(pixel_shader);
+  pixel_shader->m_fragment_shader = Util::CreateShaderModule(
+    reinterpret_cast<const u32*>(binary.data()), binary.size() / sizeof(u32));
+  return pixel_shader->m_fragment_shader != VK_NULL_HANDLE;
 }
 
 void VulkanPostProcessingShader::MapAndUpdateConfigurationBuffer()
@@ -259,7 +273,6 @@ void VulkanPostProcessingShader::Draw(PostProcessor* p,
         shader_buffer_size);
       draw.CommitPSUniforms(shader_buffer_size);
     }
-    std::vector<s32> InputsToRelease;
     // Bind inputs to pipeline
     for (size_t i = 0; i < pass.inputs.size(); i++)
     {
@@ -316,10 +329,6 @@ void VulkanPostProcessingShader::Draw(PostProcessor* p,
           VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
       }
       draw.SetPSSampler(i, input_texture->GetView(), parent->GetSamplerHandle(input.texture_sampler - 1));
-      for (auto passidx : InputsToRelease)
-      {
-        m_passes[passidx].ClenaupOutput();
-      }
     }
     parent->MapAndUpdateUniformBuffer(input_sizes, output_rect, output_size, src_rect, src_size, src_layer, gamma);
     void* vsuniforms = draw.AllocateVSUniforms(POST_PROCESSING_CONTANTS_BUFFER_SIZE);
@@ -360,10 +369,6 @@ void VulkanPostProcessingShader::Draw(PostProcessor* p,
       parent->CopyTexture(dst, GetPrevColorFrame(0)->GetInternalObject(), output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer, false, true);
     }
     parent->CopyTexture(dst_rect, dst_tex, output_rect, final_pass.GetOutput()->GetInternalObject(), final_pass.output_size, src_layer);
-    if (!IsLastPassScaled())
-    {
-      final_pass.ClenaupOutput();
-    }
   }
 }
 
@@ -470,6 +475,11 @@ bool VulkanPostProcessor::CreateCommonShaders()
   return result;
 }
 
+std::string VulkanPostProcessor::GetShaderBinaryCacheFileName() const
+{
+  return GetDiskShaderCacheFileName(API_VULKAN, "PP", false, false);
+}
+
 std::unique_ptr<PostProcessingShader> VulkanPostProcessor::CreateShader(PostProcessingShaderConfiguration* config)
 {
   std::unique_ptr<PostProcessingShader> shader;
@@ -541,6 +551,9 @@ void VulkanPostProcessor::PostProcessEFB(const TargetRectangle& src_rect, const
   if (g_ActiveConfig.iMultisamples > 1)
     CopyTexture(target_rect, reinterpret_cast<uintptr_t>(FramebufferManager::GetInstance()->GetEFBColorTexture()), target_rect, reinterpret_cast<uintptr_t>(color_texture), target_size, -1, false, true);
 
+  // The EFB changed under the region.
+  FramebufferManager::GetInstance()->InvalidateEFBCaches(region);
+
   g_renderer->RestoreAPIState();
 }
 
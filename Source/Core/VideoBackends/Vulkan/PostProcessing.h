@@ -38,6 +38,9 @@ private:
   uintptr_t CreateBindingSampler(const PostProcessingShaderConfiguration::RenderPass::Input& input_config) override;
   void ReleasePassNativeResources(RenderPassData& pass) override;
   bool RecompileShaders() override;
+  ShaderBinaryCompiler GetShaderBinaryCompiler() const override;
+  std::string GetPassShaderSource(size_t pass_index) const override;
+  bool CreatePassShader(RenderPassData& pass, const std::vector<u8>& binary) override;
   std::vector<u8> m_constants;
 };
 
@@ -82,6 +85,7 @@ protected:
   bool CreateCommonShaders();
 
   std::unique_ptr<PostProcessingShader> CreateShader(PostProcessingShaderConfiguration* config) override;
+  std::string GetShaderBinaryCacheFileName() const override;
 
   VkShaderModule m_vertex_shader;
   VkShaderModule m_layered_vertex_shader;
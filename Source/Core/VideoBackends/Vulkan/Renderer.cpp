@@ -15,6 +15,7 @@
 
 #include "Core/Core.h"
 
+#include "VideoBackends/Vulkan/AsyncReadback.h"
 #include "VideoBackends/Vulkan/BoundingBox.h"
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
 #include "VideoBackends/Vulkan/FramebufferManager.h"
@@ -22,7 +23,6 @@
 #include "VideoBackends/Vulkan/PostProcessing.h"
 #include "VideoBackends/Vulkan/RasterFont.h"
 #include "VideoBackends/Vulkan/ShaderCache.h"
-#include "VideoBackends/Vulkan/StagingTexture2D.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
 #include "VideoBackends/Vulkan/SwapChain.h"
 #include "VideoBackends/Vulkan/TextureCache.h"
@@ -67,7 +67,7 @@ Renderer::~Renderer()
   UpdateActiveConfig();
 
   // Ensure all frames are written to frame dump at shutdown.
-  if (m_frame_dumping_active)
+  if (m_frame_dump_readback)
     EndFrameDumping();
 
   DestroyFrameDumpResources();
@@ -359,6 +359,7 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool color_enable, bool alpha
   VkRect2D target_vk_rc = {
     { target_rc.left, target_rc.top },
     { static_cast<uint32_t>(target_rc.GetWidth()), static_cast<uint32_t>(target_rc.GetHeight()) } };
+  FramebufferManager::GetInstance()->InvalidateEFBCaches(target_vk_rc);
 
   // Determine whether the EFB has an alpha channel. If it doesn't, we can clear the alpha
   // channel to 0xFF. This hopefully allows us to use the fast path in most cases.
@@ -409,6 +410,10 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool color_enable, bool alpha
     return;
   }
 
+  // EFB copies waiting for the end of the render pass have to read the EFB before it's cleared.
+  if (TextureCache::GetInstance()->IsPendingTextureCopySource(target_vk_rc))
+    StateTracker::GetInstance()->EndRenderPass();
+
   // Fast path: Use vkCmdClearAttachments to clear the buffers within a render path
   // We can't use this when preserving alpha but clearing color.
   if (use_clear_attachments)
@@ -494,6 +499,7 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
   StateTracker::GetInstance()->EndRenderPass();
   StateTracker::GetInstance()->SetPendingRebind();
   FramebufferManager::GetInstance()->ReinterpretPixelData(convtype);
+  FramebufferManager::GetInstance()->InvalidateEFBCaches();
 
   // EFB framebuffer has now changed, so update accordingly.
   BindEFBToStateTracker();
@@ -542,7 +548,7 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   if (IsFrameDumping())
   {
     // If we haven't dumped a single frame yet, set up frame dumping.
-    if (!m_frame_dumping_active)
+    if (!m_frame_dump_readback)
       StartFrameDumping();
 
     DrawFrameDump(scaled_efb_rect, xfb_addr, xfb_sources, xfb_count, fb_width, fb_stride, fb_height,
@@ -550,8 +556,8 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
   }
   else
   {
-    // If frame dumping was previously enabled, flush all frames and remove the fence callback.
-    if (m_frame_dumping_active)
+    // If frame dumping was previously enabled, flush all frames.
+    if (m_frame_dump_readback)
       EndFrameDumping();
   }
 
@@ -569,6 +575,7 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
     // Because this final command buffer is rendering to the swap chain, we need to wait for
     // the available semaphore to be signaled before executing the buffer. This final submission
     // can happen off-thread in the background while we're preparing the next frame.
+    PacePresent();
     g_command_buffer_mgr->SubmitCommandBuffer(
       true, m_image_available_semaphore, m_rendering_finished_semaphore,
       m_swap_chain->GetSwapChain(), m_swap_chain->GetCurrentImageIndex());
@@ -949,138 +956,34 @@ bool Renderer::DrawFrameDump(const TargetRectangle& scaled_efb_rect, u32 xfb_add
   DrawFrame(target_rect,
     scaled_efb_rect, xfb_addr, xfb_sources, xfb_count, m_frame_dump_render_texture.get(), dst_size, fb_width, fb_stride, fb_height, 1.0f);
 
-  // Prepare the readback texture for copying.
-  StagingTexture2D* readback_texture = PrepareFrameDumpImage(width, height, ticks);
-  if (!readback_texture)
-    return false;
-
-  // Queue a copy to the current frame dump buffer. It will be written to the frame dump later.
-  m_frame_dump_render_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-  readback_texture->CopyFromImage(g_command_buffer_mgr->GetCurrentCommandBuffer(),
-    m_frame_dump_render_texture->GetImage(),
-    VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, width, height, 0, 0);
-  return true;
+  // Write the frames the GPU finished since, then queue a readback of this one. It will be
+  // written to the frame dump later.
+  m_frame_dump_readback->Poll();
+  const AVIDump::Frame state = AVIDump::FetchState(ticks);
+  return m_frame_dump_readback->Queue(
+    reinterpret_cast<uintptr_t>(m_frame_dump_render_texture.get()),
+    MathUtil::Rectangle<int>(0, 0, static_cast<int>(width), static_cast<int>(height)),
+    [this, state](const u8* data, u32 data_width, u32 data_height, u32 stride) {
+      DumpFrameData(data, static_cast<int>(data_width), static_cast<int>(data_height),
+        static_cast<int>(stride), state);
+    });
 }
 
 void Renderer::StartFrameDumping()
 {
-  ASSERT(!m_frame_dumping_active);
-
-  // Register fence callback so that we know when frames are ready to be written to the dump.
-  // This is done by clearing the fence pointer, so WriteFrameDumpFrame doesn't have to wait.
-  auto queued_callback = [](VkCommandBuffer, VkFence) {};
-  auto signaled_callback = std::bind(&Renderer::OnFrameDumpImageReady, this, std::placeholders::_1);
-
-  // We use the array pointer as a key here, that way if Renderer needed fence callbacks in
-  // the future it could be used without conflicting.
-  // We're not interested in when fences are submitted, so the first callback is a no-op.
-  g_command_buffer_mgr->AddFencePointCallback(
-    m_frame_dump_images.data(), std::move(queued_callback), std::move(signaled_callback));
-  m_frame_dumping_active = true;
+  ASSERT(!m_frame_dump_readback);
+  m_frame_dump_readback = std::make_unique<AsyncReadback>(FRAME_DUMP_BUFFERED_FRAMES);
 }
 
 void Renderer::EndFrameDumping()
 {
-  ASSERT(m_frame_dumping_active);
+  ASSERT(m_frame_dump_readback);
 
-  // Write any pending frames to the frame dump.
-  FlushFrameDump();
-
-  // Remove the fence callback that we registered earlier, one less function that needs to be
-  // called when preparing a command buffer.
-  g_command_buffer_mgr->RemoveFencePointCallback(m_frame_dump_images.data());
-  m_frame_dumping_active = false;
-}
-
-void Renderer::OnFrameDumpImageReady(VkFence fence)
-{
-  for (FrameDumpImage& frame : m_frame_dump_images)
-  {
-    // fence being a null handle means that we don't have to wait to re-use this image.
-    if (frame.fence == fence)
-      frame.fence = VK_NULL_HANDLE;
-  }
-}
-
-void Renderer::WriteFrameDumpImage(size_t index)
-{
-  FrameDumpImage& frame = m_frame_dump_images[index];
-  ASSERT(frame.pending);
-
-  // Check fence has been signaled.
-  // The callback here should set fence to null.
-  if (frame.fence != VK_NULL_HANDLE)
-  {
-    g_command_buffer_mgr->WaitForFence(frame.fence);
-    ASSERT(frame.fence == VK_NULL_HANDLE);
-  }
-
-  // Copy the now-populated image data to the output file.
-  DumpFrameData(reinterpret_cast<const u8*>(frame.readback_texture->GetMapPointer()),
-    static_cast<int>(frame.readback_texture->GetWidth()),
-    static_cast<int>(frame.readback_texture->GetHeight()),
-    static_cast<int>(frame.readback_texture->GetRowStride()), frame.dump_state);
-
-  frame.pending = false;
-}
-
-StagingTexture2D* Renderer::PrepareFrameDumpImage(u32 width, u32 height, u64 ticks)
-{
-  // Ensure the last frame that was sent to the frame dump has completed encoding before we send
-  // the next image to it.
+  // Write any pending frames to the frame dump, the dump thread has to be done with the last
+  // one before its buffer goes away.
+  m_frame_dump_readback->Flush();
   FinishFrameData();
-
-  // If the last image hasn't been written to the frame dump yet, write it now.
-  // This is necessary so that the worker thread is no more than one frame behind, and the pointer
-  // (which is actually the buffer) is safe for us to re-use next time.
-  if (m_frame_dump_images[m_current_frame_dump_image].pending)
-    WriteFrameDumpImage(m_current_frame_dump_image);
-
-  // Move to the next image buffer
-  m_current_frame_dump_image = (m_current_frame_dump_image + 1) % FRAME_DUMP_BUFFERED_FRAMES;
-  FrameDumpImage& image = m_frame_dump_images[m_current_frame_dump_image];
-
-  // Ensure the dimensions of the readback texture are sufficient.
-  if (!image.readback_texture || width != image.readback_texture->GetWidth() ||
-    height != image.readback_texture->GetHeight())
-  {
-    // Allocate a new readback texture.
-    // The reset() call is here so that the memory is released before allocating the new texture.
-    image.readback_texture.reset();
-    image.readback_texture = StagingTexture2D::Create(STAGING_BUFFER_TYPE_READBACK, width, height,
-      EFB_COLOR_TEXTURE_FORMAT);
-
-    if (!image.readback_texture || !image.readback_texture->Map())
-    {
-      // Not actually fatal, just means we can't dump this frame.
-      PanicAlert("Failed to allocate frame dump readback texture.");
-      image.readback_texture.reset();
-      return nullptr;
-    }
-  }
-
-  // The copy happens immediately after this function returns, so flag this frame as pending.
-  image.fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
-  image.dump_state = AVIDump::FetchState(ticks);
-  image.pending = true;
-  return image.readback_texture.get();
-}
-
-void Renderer::FlushFrameDump()
-{
-  // We must write frames in order, so this is why we use a counter rather than a range.
-  for (size_t i = 0; i < FRAME_DUMP_BUFFERED_FRAMES; i++)
-  {
-    if (m_frame_dump_images[m_current_frame_dump_image].pending)
-      WriteFrameDumpImage(m_current_frame_dump_image);
-
-    m_current_frame_dump_image = (m_current_frame_dump_image + 1) % FRAME_DUMP_BUFFERED_FRAMES;
-  }
-
-  // Since everything has been written now, may as well start at index zero.
-  // count-1 here because the index is incremented before usage.
-  m_current_frame_dump_image = FRAME_DUMP_BUFFERED_FRAMES - 1;
+  m_frame_dump_readback.reset();
 }
 
 void Renderer::BlitScreen(const TargetRectangle& dst_rect,
@@ -1115,7 +1018,8 @@ bool Renderer::ResizeFrameDumpBuffer(u32 new_width, u32 new_height)
 
   // Ensure all previous frames have been dumped, since we are destroying a framebuffer
   // that may still be in use.
-  FlushFrameDump();
+  if (m_frame_dump_readback)
+    m_frame_dump_readback->Flush();
 
   m_frame_dump_render_texture =
     Texture2D::Create(new_width, new_height, 1, 1, EFB_COLOR_TEXTURE_FORMAT,
@@ -1140,15 +1044,6 @@ bool Renderer::ResizeFrameDumpBuffer(u32 new_width, u32 new_height)
 void Renderer::DestroyFrameDumpResources()
 {
   m_frame_dump_render_texture.reset();
-
-  for (FrameDumpImage& image : m_frame_dump_images)
-  {
-    image.readback_texture.reset();
-    image.fence = VK_NULL_HANDLE;
-    image.dump_state = {};
-    image.pending = false;
-  }
-  m_current_frame_dump_image = FRAME_DUMP_BUFFERED_FRAMES - 1;
 }
 
 void Renderer::CheckForTargetResize(u32 fb_width, u32 fb_stride, u32 fb_height)
@@ -1215,7 +1110,8 @@ void Renderer::CheckForSurfaceChange()
         m_new_surface_handle);
       if (surface != VK_NULL_HANDLE)
       {
-        m_swap_chain = SwapChain::Create(m_new_surface_handle, surface, g_ActiveConfig.IsVSync());
+        m_swap_chain = SwapChain::Create(m_new_surface_handle, surface, g_ActiveConfig.IsVSync(),
+                                         g_ActiveConfig.bLowLatency);
         if (!m_swap_chain)
           PanicAlert("Failed to create swap chain.");
       }
@@ -1298,6 +1194,11 @@ void Renderer::CheckForConfigChanges()
     g_command_buffer_mgr->WaitForGPUIdle();
     m_swap_chain->SetVSync(g_ActiveConfig.IsVSync());
   }
+  if (m_swap_chain && g_ActiveConfig.bLowLatency != m_swap_chain->IsLowLatencyEnabled())
+  {
+    g_command_buffer_mgr->WaitForGPUIdle();
+    m_swap_chain->SetLowLatency(g_ActiveConfig.bLowLatency);
+  }
 
   // Wipe sampler cache if force texture filtering or anisotropy changes.
   if (anisotropy_changed || filtering_changed)
@@ -1374,7 +1275,11 @@ void Renderer::RestoreAPIState()
 
 void Renderer::SetRasterizationState(const RasterizationState& state)
 {
-  StateTracker::GetInstance()->SetRasterizationState(state);
+  // The index generator writes triangles as strips separated by restart indices.
+  RasterizationState new_state = state;
+  if (new_state.primitive == PrimitiveType::Triangles)
+    new_state.primitive = PrimitiveType::TriangleStrip;
+  StateTracker::GetInstance()->SetRasterizationState(new_state);
 }
 
 void Renderer::SetDepthState(const DepthState& state)
@@ -1420,6 +1325,7 @@ void Renderer::ResetSamplerStates()
 
   // Invalidate all sampler objects (some will be unused now).
   g_object_cache->ClearSamplerCache();
+  StateTracker::GetInstance()->InvalidateDescriptorSets();
 }
 
 void Renderer::SetInterlacingMode()
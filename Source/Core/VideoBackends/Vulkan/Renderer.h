@@ -17,10 +17,10 @@ struct XFBSourceBase;
 
 namespace Vulkan
 {
+class AsyncReadback;
 class BoundingBox;
 class FramebufferManager;
 class SwapChain;
-class StagingTexture2D;
 class Texture2D;
 class RasterFont;
 
@@ -123,21 +123,6 @@ private:
   void StartFrameDumping();
   void EndFrameDumping();
 
-  // Fence callback so that we know when frames are ready to be written to the dump.
-  // This is done by clearing the fence pointer, so WriteFrameDumpFrame doesn't have to wait.
-  void OnFrameDumpImageReady(VkFence fence);
-
-  // Writes the specified buffered frame to the frame dump.
-  // NOTE: Assumes that frame.ticks and frame.pending are valid.
-  void WriteFrameDumpImage(size_t index);
-
-  // If there is a pending frame in this buffer, writes it to the frame dump.
-  // Ensures that the specified readback buffer meets the size requirements of the current frame.
-  StagingTexture2D* PrepareFrameDumpImage(u32 width, u32 height, u64 ticks);
-
-  // Ensures all buffered frames are written to frame dump.
-  void FlushFrameDump();
-
   // Copies/scales an image to the currently-bound framebuffer.
   void BlitScreen(const TargetRectangle& dst_rect, const TargetRectangle& src_rect,
                   TargetSize src_size, const Texture2D* src_tex, const Texture2D* src_depth_tex,
@@ -167,17 +152,9 @@ private:
   // Texture used for screenshot/frame dumping
   std::unique_ptr<Texture2D> m_frame_dump_render_texture;
 
-  // Readback resources for frame dumping
+  // Frames are read back a few frames later, once the GPU is done with them. Only exists while
+  // frame dumping.
   static const size_t FRAME_DUMP_BUFFERED_FRAMES = 2;
-  struct FrameDumpImage
-  {
-    std::unique_ptr<StagingTexture2D> readback_texture;
-    VkFence fence = VK_NULL_HANDLE;
-    AVIDump::Frame dump_state = {};
-    bool pending = false;
-  };
-  std::array<FrameDumpImage, FRAME_DUMP_BUFFERED_FRAMES> m_frame_dump_images;
-  size_t m_current_frame_dump_image = FRAME_DUMP_BUFFERED_FRAMES - 1;
-  bool m_frame_dumping_active = false;
+  std::unique_ptr<AsyncReadback> m_frame_dump_readback;
 };
 }  // namespace Vulkan
@@ -14,6 +14,8 @@
 #include "Common/CommonFuncs.h"
 #include "Common/LinearDiskCache.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
@@ -45,6 +47,64 @@ ShaderCache::~ShaderCache()
   DestroySharedShaders();
 }
 
+ShaderCache::AsyncShaderCompiler::AsyncShaderCompiler()
+{
+  m_input.reserve(256);
+  Common::ThreadPool::RegisterWorker(this);
+}
+
+ShaderCache::AsyncShaderCompiler::~AsyncShaderCompiler()
+{
+  WaitForFinish();
+  Common::ThreadPool::UnregisterWorker(this);
+}
+
+bool ShaderCache::AsyncShaderCompiler::NextTask(size_t ID)
+{
+  std::function<void()> func;
+  {
+    std::lock_guard<std::mutex> guard(m_input_lock);
+    if (m_input.empty())
+      return false;
+    // Ties keep the order the shaders were queued in.
+    size_t best = 0;
+    u32 best_priority = 0;
+    for (size_t i = 0; i < m_input.size(); i++)
+    {
+      const u32 priority =
+          m_input[i].priority ? m_input[i].priority->load(std::memory_order_relaxed) : 0;
+      if (i == 0 || priority > best_priority)
+      {
+        best = i;
+        best_priority = priority;
+      }
+    }
+    func = std::move(m_input[best].func);
+    m_input.erase(m_input.begin() + best);
+  }
+  func();
+  m_in_progress_counter.fetch_sub(1);
+  return true;
+}
+
+void ShaderCache::AsyncShaderCompiler::CompileAsync(std::function<void()>&& func,
+                                                    const std::atomic<u32>* priority)
+{
+  m_in_progress_counter.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> guard(m_input_lock);
+    m_input.push_back({std::move(func), priority});
+  }
+  Common::ThreadPool::NotifyWorkPending();
+}
+
+void ShaderCache::AsyncShaderCompiler::WaitForFinish()
+{
+  u32 loopcount = 0;
+  while (m_in_progress_counter.load() > 0)
+    Common::cYield(loopcount++);
+}
+
 bool ShaderCache::Initialize()
 {
   LoadShaderCaches();
@@ -247,12 +307,17 @@ VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info)
   static constexpr std::array<VkPrimitiveTopology, 4> vk_primitive_topologies = {
     { VK_PRIMITIVE_TOPOLOGY_POINT_LIST, VK_PRIMITIVE_TOPOLOGY_LINE_LIST,
     VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP } };
+  // Restart only affects indexed draws, which are all generated by IndexGenerator.
+  const VkPrimitiveTopology topology =
+      vk_primitive_topologies[static_cast<u32>(info.rasterization_state.primitive.Value())];
+  const VkBool32 primitive_restart =
+      topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP ? VK_TRUE : VK_FALSE;
   VkPipelineInputAssemblyStateCreateInfo input_assembly_state = {
       VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
       nullptr,                  // const void*                                pNext
       0,                        // VkPipelineInputAssemblyStateCreateFlags    flags
-      vk_primitive_topologies[static_cast<u32>(info.rasterization_state.primitive.Value())],  // VkPrimitiveTopology
-      VK_FALSE                  // VkBool32                                   primitiveRestartEnable
+      topology,                 // VkPrimitiveTopology                        topology
+      primitive_restart         // VkBool32                                   primitiveRestartEnable
   };
 
   // Shaders to stages
@@ -345,8 +410,13 @@ VkPipeline ShaderCache::CreatePipeline(const PipelineInfo& info)
   };
 
   VkPipeline pipeline;
+  const u64 start = Common::Timer::GetTimeUs();
   VkResult res = vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), m_pipeline_cache, 1,
                                            &pipeline_info, nullptr, &pipeline);
+  // Drivers compile the shaders to the GPU here.
+  ShaderCompileStats::AddCompile(ShaderCompileStats::Stage::Program,
+                                 reinterpret_cast<const char*>(&info), sizeof(info),
+                                 Common::Timer::GetTimeUs() - start);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed: ");
@@ -363,15 +433,46 @@ VkPipeline ShaderCache::GetPipeline(const PipelineInfo& info)
 
 std::pair<VkPipeline, bool> ShaderCache::GetPipelineWithCacheResult(const PipelineInfo& info)
 {
-  auto iter = m_pipeline_objects.find(info);
-  if (iter != m_pipeline_objects.end())
-    return iter->second;
+  {
+    std::lock_guard<std::mutex> guard(m_pipeline_lock);
+    auto iter = m_pipeline_objects.find(info);
+    if (iter != m_pipeline_objects.end())
+      return iter->second;
+  }
 
   VkPipeline pipeline = CreatePipeline(info);
-  m_pipeline_objects.emplace(info, std::make_pair(pipeline, true));
+  std::lock_guard<std::mutex> guard(m_pipeline_lock);
+  auto result = m_pipeline_objects.emplace(info, std::make_pair(pipeline, true));
+  if (!result.second)
+  {
+    // The background compiler finished it first.
+    if (pipeline != VK_NULL_HANDLE)
+      vkDestroyPipeline(g_vulkan_context->GetDevice(), pipeline, nullptr);
+    return result.first->second;
+  }
   return{ pipeline, false };
 }
 
+void ShaderCache::PrecreatePipelineAsync(const PipelineInfo& info)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_pipeline_lock);
+    if (m_pipeline_objects.count(info))
+      return;
+  }
+  m_async_compiler.CompileAsync(
+      [this, info] {
+        VkPipeline pipeline = CreatePipeline(info);
+        std::lock_guard<std::mutex> guard(m_pipeline_lock);
+        if (!m_pipeline_objects.emplace(info, std::make_pair(pipeline, true)).second &&
+            pipeline != VK_NULL_HANDLE)
+        {
+          vkDestroyPipeline(g_vulkan_context->GetDevice(), pipeline, nullptr);
+        }
+      },
+      nullptr);
+}
+
 VkPipeline ShaderCache::CreateComputePipeline(const ComputePipelineInfo& info)
 {
   VkComputePipelineCreateInfo pipeline_info =
@@ -411,7 +512,8 @@ VkPipeline ShaderCache::GetComputePipeline(const ComputePipelineInfo& info)
 
 void ShaderCache::ClearPipelineCache()
 {
-  // TODO: Stop any async compiling happening.
+  // The background compiler may still be creating pipelines from the shaders about to go away.
+  m_async_compiler.WaitForFinish();
   for (const auto& it : m_pipeline_objects)
   {
     if (it.second.first != VK_NULL_HANDLE)
@@ -452,7 +554,16 @@ bool ShaderCache::CreatePipelineCache(bool load_from_disk)
 {
   // We have to keep the pipeline cache file name around since when we save it
   // we delete the old one, by which time the game's unique ID is already cleared.
-  m_pipeline_cache_filename = GetDiskShaderCacheFileName(API_VULKAN, "pipeline", true, true);
+  // One file per GPU and driver, so switching between them doesn't throw the other blob away.
+  const VkPhysicalDeviceProperties& properties = g_vulkan_context->GetDeviceProperties();
+  const std::string type = StringFromFormat("pipeline-%08X-%08X-%08X", properties.vendorID,
+                                            properties.deviceID, properties.driverVersion);
+  m_pipeline_cache_filename = GetDiskShaderCacheFileName(API_VULKAN, type.c_str(), true, true);
+
+  // Older versions kept a single file for every GPU, which nothing reads anymore.
+  const std::string old_filename = GetDiskShaderCacheFileName(API_VULKAN, "pipeline", true, true);
+  if (File::Exists(old_filename))
+    File::Delete(old_filename);
 
   std::vector<u8> disk_data;
   if (load_from_disk)
@@ -657,19 +768,10 @@ struct ShaderCacheReader : public LinearDiskCacheReader<Uid, u32>
 
 void ShaderCache::LoadShaderCaches(bool forcecompile)
 {
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
-  m_vs_cache.shader_map.reset(VShaderCache::cache_type::Create(
-    gameid,
-    VERTEXSHADERGEN_UID_VERSION,
-    "Ishiiruka.vs",
-    StringFromFormat("%s.vs", SConfig::GetInstance().GetGameID().c_str())
-  ));
-  m_ps_cache.shader_map.reset(PShaderCache::cache_type::Create(
-    gameid,
-    PIXELSHADERGEN_UID_VERSION,
-    "Ishiiruka.ps",
-    StringFromFormat("%s.ps", SConfig::GetInstance().GetGameID().c_str())
-  ));
+  m_vs_cache.shader_map.reset(ShaderCacheUtils::CreateUsageProfile<VShaderCache::cache_type>(
+      "vs", VERTEXSHADERGEN_UID_VERSION));
+  m_ps_cache.shader_map.reset(ShaderCacheUtils::CreateUsageProfile<PShaderCache::cache_type>(
+      "ps", PIXELSHADERGEN_UID_VERSION));
 
   ShaderUsageCacheReader<VertexShaderUid, VertexShaderUid::ShaderUidHasher> vs_reader(m_vs_cache.shader_map.get());
   m_vs_cache.disk_cache.OpenAndRead(GetDiskShaderCacheFileName(API_VULKAN, "vs", true, true), vs_reader);
@@ -734,47 +836,32 @@ void ShaderCache::CompileUberShaders()
 
 void ShaderCache::CompileShaders()
 {
-  pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().GetGameID().data()), (u32)SConfig::GetInstance().GetGameID().size(), 0);
   int shader_count = 0;
-  m_vs_cache.shader_map->ForEachMostUsedByCategory(gameid,
-    [&](const VertexShaderUid& uid, size_t total)
-  {
-    VertexShaderUid item = uid;
-    item.ClearHASH();
-    item.CalculateUIDHash();
-    vkShaderItem& it = m_vs_cache.shader_map->GetOrAdd(item);
-    if (!it.initialized.test_and_set())
-    {
-      CompileVertexShaderForUid(item, it);
-      Host_UpdateProgressDialog(GetStringT("Compiling Vertex shaders...").c_str(),
-        static_cast<int>(shader_count), static_cast<int>(total));
-    }
-  },
-    [](vkShaderItem& entry)
-  {
-    return !entry.compiled;
-  }
-  , true);
+  ShaderCacheUtils::ForEachShaderToPrecompile(
+      m_vs_cache.shader_map.get(), [](vkShaderItem& entry) { return !entry.compiled; },
+      [&](const VertexShaderUid& uid, size_t total) {
+        vkShaderItem& it = m_vs_cache.shader_map->GetOrAdd(uid);
+        if (!it.initialized.test_and_set())
+        {
+          CompileVertexShaderForUid(uid, ShaderHostConfig::GetCurrent(), it);
+          shader_count++;
+          Host_UpdateProgressDialog(GetStringT("Compiling Vertex shaders...").c_str(),
+                                    static_cast<int>(shader_count), static_cast<int>(total));
+        }
+      });
   shader_count = 0;
-  m_ps_cache.shader_map->ForEachMostUsedByCategory(gameid,
-    [&](const PixelShaderUid& uid, size_t total)
-  {
-    PixelShaderUid item = uid;
-    item.ClearHASH();
-    item.CalculateUIDHash();
-    vkShaderItem& it = m_ps_cache.shader_map->GetOrAdd(item);
-    if (!it.initialized.test_and_set())
-    {
-      CompilePixelShaderForUid(item, it);
-      Host_UpdateProgressDialog(GetStringT("Compiling Pixel shaders...").c_str(),
-        static_cast<int>(shader_count), static_cast<int>(total));
-    }
-  },
-    [](vkShaderItem& entry)
-  {
-    return !entry.compiled;
-  }
-  , true);
+  ShaderCacheUtils::ForEachShaderToPrecompile(
+      m_ps_cache.shader_map.get(), [](vkShaderItem& entry) { return !entry.compiled; },
+      [&](const PixelShaderUid& uid, size_t total) {
+        vkShaderItem& it = m_ps_cache.shader_map->GetOrAdd(uid);
+        if (!it.initialized.test_and_set())
+        {
+          CompilePixelShaderForUid(uid, ShaderHostConfig::GetCurrent(), it);
+          shader_count++;
+          Host_UpdateProgressDialog(GetStringT("Compiling Pixel shaders...").c_str(),
+                                    static_cast<int>(shader_count), static_cast<int>(total));
+        }
+      });
 
   if (g_vulkan_context->SupportsGeometryShaders())
   {
@@ -836,15 +923,11 @@ static void DestroyShaderCache(T& cache)
 
 void ShaderCache::DestroyShaderCaches()
 {
-  m_vs_cache.shader_map->Persist([](VertexShaderUid &uid) {
-    uid.ClearHASH();
-    uid.CalculateUIDHash();
-  });
+  m_async_compiler.WaitForFinish();
+
+  ShaderCacheUtils::PersistUsageProfile(m_vs_cache.shader_map.get());
   DestroyShaderUsageCache(m_vs_cache);
-  m_ps_cache.shader_map->Persist([](PixelShaderUid &uid) {
-    uid.ClearHASH();
-    uid.CalculateUIDHash();
-  });
+  ShaderCacheUtils::PersistUsageProfile(m_ps_cache.shader_map.get());
   DestroyShaderUsageCache(m_ps_cache);
 
   if (g_vulkan_context->SupportsGeometryShaders())
@@ -859,13 +942,15 @@ void ShaderCache::DestroyShaderCaches()
   SETSTAT(stats.numVertexShadersAlive, 0);
 }
 
-void ShaderCache::CompileVertexShaderForUid(const VertexShaderUid& uid, ShaderCache::vkShaderItem& it)
+void ShaderCache::CompileVertexShaderForUid(const VertexShaderUid& uid,
+                                            const ShaderHostConfig& host_config,
+                                            ShaderCache::vkShaderItem& it)
 {
   // Not in the cache, so compile the shader.
   ShaderCompiler::SPIRVCodeVector spv;
   VkShaderModule module = VK_NULL_HANDLE;
   ShaderCode source_code;
-  GenerateVertexShaderCode(source_code, uid.GetUidData(), ShaderHostConfig::GetCurrent());
+  GenerateVertexShaderCode(source_code, uid.GetUidData(), host_config);
   if (ShaderCompiler::CompileVertexShader(&spv, source_code.data(),
     source_code.size()))
   {
@@ -874,14 +959,16 @@ void ShaderCache::CompileVertexShaderForUid(const VertexShaderUid& uid, ShaderCa
     // Append to shader cache if it created successfully.
     if (module != VK_NULL_HANDLE)
     {
+      std::lock_guard<std::mutex> guard(m_disk_cache_lock);
       m_vs_cache.disk_cache.Append(uid, spv.data(), static_cast<u32>(spv.size()));
       INCSTAT(stats.numVertexShadersCreated);
       INCSTAT(stats.numVertexShadersAlive);
     }
   }
-  it.compiled = true;
   // We still insert null entries to prevent further compilation attempts.
   it.module = module;
+  // The GPU thread reads the module once it sees this, set it last.
+  it.compiled.store(true, std::memory_order_release);
 }
 
 void ShaderCache::CompileVertexUberShaderForUid(const UberShader::VertexUberShaderUid& uid, ShaderCache::vkShaderItem& it)
@@ -928,13 +1015,15 @@ void ShaderCache::CompileGeometryShaderForUid(const GeometryShaderUid& uid, Shad
   it.module = module;
 }
 
-void ShaderCache::CompilePixelShaderForUid(const PixelShaderUid& uid, ShaderCache::vkShaderItem& it)
+void ShaderCache::CompilePixelShaderForUid(const PixelShaderUid& uid,
+                                           const ShaderHostConfig& host_config,
+                                           ShaderCache::vkShaderItem& it)
 {
   // Not in the cache, so compile the shader.
   ShaderCompiler::SPIRVCodeVector spv;
   VkShaderModule module = VK_NULL_HANDLE;
   ShaderCode source_code;
-  GeneratePixelShaderCode(source_code, uid.GetUidData(), ShaderHostConfig::GetCurrent());
+  GeneratePixelShaderCode(source_code, uid.GetUidData(), host_config);
   if (ShaderCompiler::CompileFragmentShader(&spv, source_code.data(),
     source_code.size()))
   {
@@ -943,14 +1032,16 @@ void ShaderCache::CompilePixelShaderForUid(const PixelShaderUid& uid, ShaderCach
     // Append to shader cache if it created successfully.
     if (module != VK_NULL_HANDLE)
     {
+      std::lock_guard<std::mutex> guard(m_disk_cache_lock);
       m_ps_cache.disk_cache.Append(uid, spv.data(), static_cast<u32>(spv.size()));
       INCSTAT(stats.numPixelShadersCreated);
       INCSTAT(stats.numPixelShadersAlive);
     }
   }
-  it.compiled = true;
   // We still insert null entries to prevent further compilation attempts.
   it.module = module;
+  // The GPU thread reads the module once it sees this, set it last.
+  it.compiled.store(true, std::memory_order_release);
 }
 
 void ShaderCache::CompilePixelUberShaderForUid(const UberShader::PixelUberShaderUid& uid, ShaderCache::vkShaderItem& it)
@@ -982,9 +1073,17 @@ VkShaderModule ShaderCache::GetVertexShaderForUid(const VertexShaderUid& uid)
 {
   vkShaderItem& it = m_vs_cache.shader_map->GetOrAdd(uid);
   if (it.initialized.test_and_set())
+  {
+    // Hybrid mode was turned off while the background compiler had it.
+    if (!it.compiled.load(std::memory_order_acquire))
+    {
+      ShaderCompileStats::StallTimer stall(true);
+      m_async_compiler.WaitForFinish();
+    }
     return it.module;
+  }
 
-  CompileVertexShaderForUid(uid, it);
+  CompileVertexShaderForUid(uid, ShaderHostConfig::GetCurrent(), it);
   return it.module;
 }
 
@@ -1003,12 +1102,58 @@ VkShaderModule ShaderCache::GetPixelShaderForUid(const PixelShaderUid& uid)
 {
   vkShaderItem& it = m_ps_cache.shader_map->GetOrAdd(uid);
   if (it.initialized.test_and_set())
+  {
+    // Hybrid mode was turned off while the background compiler had it.
+    if (!it.compiled.load(std::memory_order_acquire))
+    {
+      ShaderCompileStats::StallTimer stall(true);
+      m_async_compiler.WaitForFinish();
+    }
     return it.module;
+  }
 
-  CompilePixelShaderForUid(uid, it);
+  CompilePixelShaderForUid(uid, ShaderHostConfig::GetCurrent(), it);
   return it.module;
 }
 
+bool ShaderCache::GetVertexShaderForUidAsync(const VertexShaderUid& uid, VkShaderModule* module)
+{
+  vkShaderItem& it = m_vs_cache.shader_map->GetOrAdd(uid);
+  if (!it.initialized.test_and_set())
+  {
+    const ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
+    m_async_compiler.CompileAsync(
+        [this, uid, host_config, &it] { CompileVertexShaderForUid(uid, host_config, it); },
+        &it.hits);
+  }
+  if (!it.compiled.load(std::memory_order_acquire))
+  {
+    it.hits.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  *module = it.module;
+  return true;
+}
+
+bool ShaderCache::GetPixelShaderForUidAsync(const PixelShaderUid& uid, VkShaderModule* module)
+{
+  vkShaderItem& it = m_ps_cache.shader_map->GetOrAdd(uid);
+  if (!it.initialized.test_and_set())
+  {
+    const ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
+    m_async_compiler.CompileAsync(
+        [this, uid, host_config, &it] { CompilePixelShaderForUid(uid, host_config, it); },
+        &it.hits);
+  }
+  if (!it.compiled.load(std::memory_order_acquire))
+  {
+    it.hits.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  *module = it.module;
+  return true;
+}
+
 VkShaderModule ShaderCache::GetVertexUberShaderForUid(const UberShader::VertexUberShaderUid& uid)
 {
   vkShaderItem& it = m_vus_cache.shader_map[uid];
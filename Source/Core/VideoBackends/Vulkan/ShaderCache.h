@@ -5,15 +5,20 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/LinearDiskCache.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoBackends/Vulkan/Constants.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
@@ -23,6 +28,7 @@
 #include "VideoCommon/ObjectUsageProfiler.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/RenderState.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoCommon/UberShaderPixel.h"
 #include "VideoCommon/UberShaderVertex.h"
 #include "VideoCommon/VertexShaderGen.h"
@@ -137,6 +143,11 @@ public:
   VkShaderModule GetGeometryShaderForUid(const GeometryShaderUid& uid);
   VkShaderModule GetPixelShaderForUid(const PixelShaderUid& uid);
 
+  // Hybrid ubershader mode: queue the shader for the background compiler instead of blocking.
+  // Returns false while it is compiling, every call made until then raises its priority.
+  bool GetVertexShaderForUidAsync(const VertexShaderUid& uid, VkShaderModule* module);
+  bool GetPixelShaderForUidAsync(const PixelShaderUid& uid, VkShaderModule* module);
+
   // Ubershader caches
   VkShaderModule GetVertexUberShaderForUid(const UberShader::VertexUberShaderUid& uid);
   VkShaderModule GetPixelUberShaderForUid(const UberShader::PixelUberShaderUid& uid);
@@ -156,6 +167,10 @@ public:
   // resulted in a pipeline being created, the second field of the return value will be false,
   // otherwise for a cache hit it will be true.
   std::pair<VkPipeline, bool> GetPipelineWithCacheResult(const PipelineInfo& info);
+
+  // Creates the pipeline on the thread pool, so the boot doesn't wait on the driver. A draw that
+  // needs it before it is ready creates it itself.
+  void PrecreatePipelineAsync(const PipelineInfo& info);
   
   // Creates a compute pipeline, and does not track the handle.
   VkPipeline CreateComputePipeline(const ComputePipelineInfo& info);
@@ -188,9 +203,11 @@ public:
   class vkShaderItem
   {
   public:
-    bool compiled{};
+    std::atomic<bool> compiled{};
     std::atomic_flag initialized{};
     VkShaderModule module = VK_NULL_HANDLE;
+    // Draws that fell back to the ubershaders while this one was compiling.
+    std::atomic<u32> hits{};
     vkShaderItem() {}
   };
 
@@ -205,7 +222,27 @@ private:
   bool CompileSharedShaders();
   void DestroySharedShaders();
 
-  
+  // Runs the hybrid mode compiles and the pipeline precreation on the thread pool, the shader
+  // with the most draws waiting on it first.
+  class AsyncShaderCompiler final : Common::IWorker
+  {
+  public:
+    AsyncShaderCompiler();
+    ~AsyncShaderCompiler();
+    bool NextTask(size_t ID) override;
+    void CompileAsync(std::function<void()>&& func, const std::atomic<u32>* priority);
+    void WaitForFinish();
+
+  private:
+    struct Task
+    {
+      std::function<void()> func;
+      const std::atomic<u32>* priority;
+    };
+    std::mutex m_input_lock;
+    std::vector<Task> m_input;
+    std::atomic<u32> m_in_progress_counter{};
+  };
 
   template <typename Uid, typename UidHasher>
   class ShaderUsageModuleCache
@@ -213,7 +250,7 @@ private:
   public:
     typedef ObjectUsageProfiler<Uid, pKey_t, vkShaderItem, UidHasher> cache_type;
     std::unique_ptr<cache_type> shader_map{};
-    LinearDiskCache<Uid, u32> disk_cache{};
+    ShaderCacheUtils::ShaderDiskCache<Uid, u32> disk_cache{};
     ShaderUsageModuleCache() {}
   };
 
@@ -223,7 +260,7 @@ private:
   public:
     typedef std::unordered_map<Uid, vkShaderItem, UidHasher> cache_type;
     cache_type shader_map{};
-    LinearDiskCache<Uid, u32> disk_cache{};
+    ShaderCacheUtils::ShaderDiskCache<Uid, u32> disk_cache{};
     ShaderModuleCache() {}
   };
 
@@ -239,16 +276,23 @@ private:
   PShaderCache m_ps_cache;
   VUShaderCache m_vus_cache;
   PUShaderCache m_pus_cache;
+  AsyncShaderCompiler m_async_compiler;
+  // The background compiles append to the vertex and pixel disk caches too.
+  std::mutex m_disk_cache_lock;
 
-  void CompileVertexShaderForUid(const VertexShaderUid& uid, vkShaderItem& it);
+  void CompileVertexShaderForUid(const VertexShaderUid& uid, const ShaderHostConfig& host_config,
+                                 vkShaderItem& it);
   void CompileGeometryShaderForUid(const GeometryShaderUid& uid, vkShaderItem& it);
-  void CompilePixelShaderForUid(const PixelShaderUid& uid, vkShaderItem& it);
+  void CompilePixelShaderForUid(const PixelShaderUid& uid, const ShaderHostConfig& host_config,
+                                vkShaderItem& it);
   void CompileVertexUberShaderForUid(const UberShader::VertexUberShaderUid& uid, vkShaderItem& it);
   void CompilePixelUberShaderForUid(const UberShader::PixelUberShaderUid& uid, vkShaderItem& it);
   
 
   std::unordered_map<PipelineInfo, std::pair<VkPipeline, bool>, PipelineInfoHash>
       m_pipeline_objects;
+  // The background compiler adds the pipelines it precreates.
+  std::mutex m_pipeline_lock;
   std::unordered_map<ComputePipelineInfo, VkPipeline, ComputePipelineInfoHash>
       m_compute_pipeline_objects;
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
@@ -20,7 +20,9 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Timer.h"
 
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace Vulkan
@@ -411,46 +413,47 @@ const TBuiltInResource* GetCompilerResourceLimits()
   return &limits;
 }
 
-bool CompileVertexShader(SPIRVCodeVector* out_code, const char* source_code,
-  size_t source_code_length)
+// The vertex, geometry and fragment shaders of the pipelines, timed for the statistics.
+static bool CompilePipelineShader(SPIRVCodeVector* out_code, EShLanguage stage,
+                                  const char* stage_filename, ShaderCompileStats::Stage stats_stage,
+                                  const char* source_code, size_t source_code_length)
 {
+  const u64 start = Common::Timer::GetTimeUs();
+  bool result = true;
   if (g_vulkan_context->SupportsNVGLSLExtension())
   {
-    CopyGLSLToSPVVector(out_code, "vs", source_code, source_code_length, SHADER_HEADER,
+    CopyGLSLToSPVVector(out_code, stage_filename, source_code, source_code_length, SHADER_HEADER,
       sizeof(SHADER_HEADER) - 1);
-    return true;
   }
+  else
+  {
+    result = CompileShaderToSPV(out_code, stage, stage_filename, source_code, source_code_length,
+      SHADER_HEADER, sizeof(SHADER_HEADER) - 1);
+  }
+  ShaderCompileStats::AddCompile(stats_stage, source_code, source_code_length,
+                                 Common::Timer::GetTimeUs() - start);
+  return result;
+}
 
-  return CompileShaderToSPV(out_code, EShLangVertex, "vs", source_code, source_code_length,
-    SHADER_HEADER, sizeof(SHADER_HEADER) - 1);
+bool CompileVertexShader(SPIRVCodeVector* out_code, const char* source_code,
+  size_t source_code_length)
+{
+  return CompilePipelineShader(out_code, EShLangVertex, "vs", ShaderCompileStats::Stage::Vertex,
+    source_code, source_code_length);
 }
 
 bool CompileGeometryShader(SPIRVCodeVector* out_code, const char* source_code,
   size_t source_code_length)
 {
-  if (g_vulkan_context->SupportsNVGLSLExtension())
-  {
-    CopyGLSLToSPVVector(out_code, "gs", source_code, source_code_length, SHADER_HEADER,
-      sizeof(SHADER_HEADER) - 1);
-    return true;
-  }
-
-  return CompileShaderToSPV(out_code, EShLangGeometry, "gs", source_code, source_code_length,
-    SHADER_HEADER, sizeof(SHADER_HEADER) - 1);
+  return CompilePipelineShader(out_code, EShLangGeometry, "gs",
+    ShaderCompileStats::Stage::Geometry, source_code, source_code_length);
 }
 
 bool CompileFragmentShader(SPIRVCodeVector* out_code, const char* source_code,
   size_t source_code_length)
 {
-  if (g_vulkan_context->SupportsNVGLSLExtension())
-  {
-    CopyGLSLToSPVVector(out_code, "ps", source_code, source_code_length, SHADER_HEADER,
-      sizeof(SHADER_HEADER) - 1);
-    return true;
-  }
-
-  return CompileShaderToSPV(out_code, EShLangFragment, "ps", source_code, source_code_length,
-    SHADER_HEADER, sizeof(SHADER_HEADER) - 1);
+  return CompilePipelineShader(out_code, EShLangFragment, "ps", ShaderCompileStats::Stage::Pixel,
+    source_code, source_code_length);
 }
 
 bool CompileComputeShader(SPIRVCodeVector* out_code, const char* source_code,
@@ -14,6 +14,7 @@
 #include "VideoBackends/Vulkan/FramebufferManager.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
+#include "VideoBackends/Vulkan/TextureCache.h"
 #include "VideoBackends/Vulkan/Util.h"
 #include "VideoBackends/Vulkan/VertexFormat.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
@@ -105,6 +106,7 @@ void StateTracker::InvalidateShaderPointers()
   m_ps_uid = {};
   m_uber_ps_uid = {};
   m_uber_vs_uid = {};
+  m_shader_uid_tracker.Reset();
   // Invalidate shader pointers.
   m_pipeline_state.vs = VK_NULL_HANDLE;
   m_pipeline_state.gs = VK_NULL_HANDLE;
@@ -247,14 +249,8 @@ bool StateTracker::PrecachePipelineUID(const SerializedPipelineUID& uid)
   pinfo.rasterization_state.hex = uid.rasterizer_state_bits;
   pinfo.depth_state.hex = uid.depth_state_bits;
 
-  VkPipeline pipeline = g_shader_cache->GetPipeline(pinfo);
-  if (pipeline == VK_NULL_HANDLE)
-  {
-    WARN_LOG(VIDEO, "Failed to get pipeline from cached UID.");
-    return false;
-  }
-
-  // We don't need to do anything with this pipeline, just make sure it exists.
+  // The driver compile is the slow part, the background compiler takes it.
+  g_shader_cache->PrecreatePipelineAsync(pinfo);
   return true;
 }
 
@@ -303,14 +299,8 @@ bool StateTracker::PrecacheUberPipelineUID(const SerializedUberPipelineUID& uid)
   pinfo.rasterization_state.hex = uid.rasterizer_state_bits;
   pinfo.depth_state.hex = uid.depth_state_bits;
 
-  VkPipeline pipeline = g_shader_cache->GetPipeline(pinfo);
-  if (pipeline == VK_NULL_HANDLE)
-  {
-    WARN_LOG(VIDEO, "Failed to get pipeline from cached UID.");
-    return false;
-  }
-
-  // We don't need to do anything with this pipeline, just make sure it exists.
+  // The driver compile is the slow part, the background compiler takes it.
+  g_shader_cache->PrecreatePipelineAsync(pinfo);
   return true;
 }
 
@@ -406,6 +396,13 @@ void StateTracker::SetBlendState(const BlendingState& state)
 
 bool StateTracker::CheckForShaderChanges(PrimitiveType gx_primitive_type, u32 components, PIXEL_SHADER_RENDER_MODE dstalpha_mode)
 {
+  // Nothing the uids depend on changed since the last draw, and no specialized shader is still
+  // compiling, so the shaders stay the same.
+  if (m_shader_uid_tracker.IsUnchanged(components, (dstalpha_mode << 8) | static_cast<u32>(gx_primitive_type)) &&
+      !m_vs_pending && !m_ps_pending)
+  {
+    return false;
+  }
   VertexShaderUid vs_uid;
   GetVertexShaderUID(vs_uid, components, xfmem, bpmem);
   PixelShaderUid ps_uid;
@@ -413,19 +410,42 @@ bool StateTracker::CheckForShaderChanges(PrimitiveType gx_primitive_type, u32 co
 
   bool changed = false;
   bool use_ubershaders = g_ActiveConfig.bDisableSpecializedShaders;
+  // Counts the draws that compile their shaders on this thread.
+  ShaderCompileStats::StallTimer stall;
   if (!use_ubershaders)
   {
-    if (vs_uid != m_vs_uid)
+    // In hybrid mode the specialized shaders compile in the background and the ubershaders
+    // draw until both of them are ready.
+    const bool hybrid = g_ActiveConfig.bBackgroundShaderCompiling;
+    if (vs_uid != m_vs_uid || m_vs_pending)
     {
-      m_pipeline_state.vs = g_shader_cache->GetVertexShaderForUid(vs_uid);
+      if (hybrid)
+        m_vs_pending = !g_shader_cache->GetVertexShaderForUidAsync(vs_uid, &m_specialized_vs);
+      else
+        m_specialized_vs = g_shader_cache->GetVertexShaderForUid(vs_uid);
+      m_vs_pending &= hybrid;
       m_vs_uid = vs_uid;
-      changed = true;
     }
 
-    if (ps_uid != m_ps_uid)
+    if (ps_uid != m_ps_uid || m_ps_pending)
     {
-      m_pipeline_state.ps = g_shader_cache->GetPixelShaderForUid(ps_uid);
+      if (hybrid)
+        m_ps_pending = !g_shader_cache->GetPixelShaderForUidAsync(ps_uid, &m_specialized_ps);
+      else
+        m_specialized_ps = g_shader_cache->GetPixelShaderForUid(ps_uid);
+      m_ps_pending &= hybrid;
       m_ps_uid = ps_uid;
+    }
+
+    use_ubershaders = m_vs_pending || m_ps_pending;
+    if (use_ubershaders)
+      ShaderCompileStats::AddUberShaderDraw();
+    // Swap the specialized shaders in on the first draw after they are ready.
+    if (!use_ubershaders &&
+        (m_pipeline_state.vs != m_specialized_vs || m_pipeline_state.ps != m_specialized_ps))
+    {
+      m_pipeline_state.vs = m_specialized_vs;
+      m_pipeline_state.ps = m_specialized_ps;
       changed = true;
     }
   }
@@ -500,6 +520,11 @@ void StateTracker::ClearShaders()
   std::memset(&m_ps_uid, 0xFF, sizeof(m_ps_uid));
   std::memset(&m_uber_vs_uid, 0xFF, sizeof(m_uber_vs_uid));
   std::memset(&m_uber_ps_uid, 0xFF, sizeof(m_uber_ps_uid));
+  m_vs_pending = false;
+  m_ps_pending = false;
+  m_specialized_vs = VK_NULL_HANDLE;
+  m_specialized_ps = VK_NULL_HANDLE;
+  m_shader_uid_tracker.Reset();
 
   m_pipeline_state.vs = VK_NULL_HANDLE;
   m_pipeline_state.gs = VK_NULL_HANDLE;
@@ -756,6 +781,7 @@ void StateTracker::UnbindTexture(VkImageView view)
 void StateTracker::InvalidateDescriptorSets()
 {
   m_descriptor_sets.fill(VK_NULL_HANDLE);
+  m_sampler_descriptor_sets.clear();
   m_dirty_flags |= DIRTY_FLAG_ALL_DESCRIPTOR_SETS;
 
   // Defer SSBO descriptor update until bbox is actually enabled.
@@ -808,6 +834,11 @@ void StateTracker::EndRenderPass()
 
   vkCmdEndRenderPass(g_command_buffer_mgr->GetCurrentCommandBuffer());
   m_current_render_pass = VK_NULL_HANDLE;
+
+  // EFB copies to textures made during the pass can read the EFB now.
+  TextureCache* texture_cache = TextureCache::GetInstance();
+  if (texture_cache && texture_cache->HasPendingTextureCopies())
+    texture_cache->RunPendingTextureCopies();
 }
 
 void StateTracker::BeginClearRenderPass(const VkRect2D& area, const VkClearValue clear_values[2])
@@ -856,6 +887,22 @@ bool StateTracker::Bind(bool rebind_all /*= false*/)
   if (m_current_render_pass == m_clear_render_pass && !IsViewportWithinRenderArea())
     EndRenderPass();
 
+  // Run the EFB copies waiting for the end of the pass if this draw can change their source, or
+  // samples one of their destinations.
+  TextureCache* texture_cache = TextureCache::GetInstance();
+  if (texture_cache->HasPendingTextureCopies())
+  {
+    bool depends_on_copy = texture_cache->IsPendingTextureCopySource(m_scissor);
+    for (size_t i = 0; i < m_bindings.ps_samplers.size() && !depends_on_copy; i++)
+    {
+      VkImageView view = m_bindings.ps_samplers[i].imageView;
+      depends_on_copy =
+        view != VK_NULL_HANDLE && texture_cache->IsPendingTextureCopyDestination(view);
+    }
+    if (depends_on_copy)
+      EndRenderPass();
+  }
+
   // Get new pipeline object if any parts have changed
   if (m_dirty_flags & DIRTY_FLAG_PIPELINE && !UpdatePipeline())
   {
@@ -932,7 +979,8 @@ void StateTracker::OnDraw()
   if (std::binary_search(m_scheduled_command_buffer_kicks.begin(),
     m_scheduled_command_buffer_kicks.end(), m_draw_counter))
   {
-    // Kick a command buffer on the background thread.
+    // Kick a command buffer on the background thread, with the EFB copied for the coming peeks.
+    FramebufferManager::GetInstance()->PrefetchPeekCache();
     Util::ExecuteCurrentCommandsAndRestoreState(true);
   }
 }
@@ -1062,6 +1110,7 @@ PipelineInfo StateTracker::GetAlphaPassPipelineConfig(const PipelineInfo& info)
 
 VkPipeline StateTracker::GetPipelineAndCacheUID(const PipelineInfo& info)
 {
+  ShaderCompileStats::StallTimer stall;
   auto result = g_shader_cache->GetPipelineWithCacheResult(info);
 
   // Add to the UID cache if it is a new pipeline.
@@ -1187,25 +1236,39 @@ bool StateTracker::UpdateDescriptorSet()
   if (m_dirty_flags & DIRTY_FLAG_PS_SAMPLERS ||
     m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] == VK_NULL_HANDLE)
   {
-    VkDescriptorSetLayout layout =
-      g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_PIXEL_SHADER_SAMPLERS);
-    VkDescriptorSet set = g_command_buffer_mgr->AllocateDescriptorSet(layout);
-    if (set == VK_NULL_HANDLE)
-      return false;
+    VkDescriptorSet set;
+    auto iter = m_sampler_descriptor_sets.find(m_bindings.ps_samplers);
+    if (iter != m_sampler_descriptor_sets.end())
+    {
+      set = iter->second;
+    }
+    else
+    {
+      VkDescriptorSetLayout layout =
+        g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_PIXEL_SHADER_SAMPLERS);
+      set = g_command_buffer_mgr->AllocateDescriptorSet(layout);
+      if (set == VK_NULL_HANDLE)
+        return false;
 
-    writes[num_writes++] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-      nullptr,
-      set,
-      0,
-      0,
-      static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
-      VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-      m_bindings.ps_samplers.data(),
-      nullptr,
-      nullptr };
+      writes[num_writes++] = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        nullptr,
+        set,
+        0,
+        0,
+        static_cast<u32>(NUM_PIXEL_SHADER_SAMPLERS),
+        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+        m_bindings.ps_samplers.data(),
+        nullptr,
+        nullptr };
 
-    m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] = set;
-    m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SET_BINDING;
+      m_sampler_descriptor_sets.emplace(m_bindings.ps_samplers, set);
+    }
+
+    if (m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] != set)
+    {
+      m_descriptor_sets[DESCRIPTOR_SET_BIND_POINT_PIXEL_SHADER_SAMPLERS] = set;
+      m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SET_BINDING;
+    }
   }
 
   if (m_bbox_enabled &&
@@ -1242,4 +1305,29 @@ bool StateTracker::UpdateDescriptorSet()
   return true;
 }
 
+size_t StateTracker::SamplerBindingsHash::operator()(const SamplerBindings& bindings) const
+{
+  size_t hash = 0;
+  for (const VkDescriptorImageInfo& info : bindings)
+  {
+    hash = hash * 31 + std::hash<VkSampler>()(info.sampler);
+    hash = hash * 31 + std::hash<VkImageView>()(info.imageView);
+  }
+  return hash;
+}
+
+bool StateTracker::SamplerBindingsEqual::operator()(const SamplerBindings& lhs,
+  const SamplerBindings& rhs) const
+{
+  for (size_t i = 0; i < lhs.size(); i++)
+  {
+    if (lhs[i].sampler != rhs[i].sampler || lhs[i].imageView != rhs[i].imageView ||
+      lhs[i].imageLayout != rhs[i].imageLayout)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace Vulkan
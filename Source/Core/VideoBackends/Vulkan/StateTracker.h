@@ -7,6 +7,7 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
@@ -72,6 +73,8 @@ public:
 
   // When executing a command buffer, we want to recreate the descriptor set, as it will
   // now be in a different pool for the new command buffer.
+  // Also call this when objects the sets may point to are destroyed before the command buffer is
+  // executed, as their handles could be reused.
   void InvalidateDescriptorSets();
 
   // Same with the uniforms, as the current storage will belong to the previous command buffer.
@@ -93,6 +96,7 @@ public:
 
   void SetViewport(const VkViewport& viewport);
   void SetScissor(const VkRect2D& scissor);
+  const VkRect2D& GetScissor() const { return m_scissor; }
 
   bool Bind(bool rebind_all = false);
 
@@ -202,6 +206,16 @@ private:
   void UpdatePipelineVertexFormat();
   bool UpdateDescriptorSet();
 
+  using SamplerBindings = std::array<VkDescriptorImageInfo, NUM_PIXEL_SHADER_SAMPLERS>;
+  struct SamplerBindingsHash
+  {
+    size_t operator()(const SamplerBindings& bindings) const;
+  };
+  struct SamplerBindingsEqual
+  {
+    bool operator()(const SamplerBindings& lhs, const SamplerBindings& rhs) const;
+  };
+
   // Allocates storage in the uniform buffer of the specified size. If this storage cannot be
   // allocated immediately, the current command buffer will be submitted and all stage's
   // constants will be re-uploaded. false will be returned in this case, otherwise true.
@@ -225,6 +239,13 @@ private:
   UberShader::VertexUberShaderUid m_uber_vs_uid = {};
   UberShader::PixelUberShaderUid m_uber_ps_uid = {};
   bool m_using_ubershaders = false;
+  // Hybrid mode: the specialized shaders of the current uids, and whether they are still
+  // compiling.
+  VkShaderModule m_specialized_vs = VK_NULL_HANDLE;
+  VkShaderModule m_specialized_ps = VK_NULL_HANDLE;
+  bool m_vs_pending = false;
+  bool m_ps_pending = false;
+  ShaderUidTracker m_shader_uid_tracker{SHADER_UID_PIXEL | SHADER_UID_VERTEX | SHADER_UID_GEOMETRY};
 
   // pipeline state
   PipelineInfo m_pipeline_state = {};
@@ -245,6 +266,10 @@ private:
     VkDescriptorBufferInfo ps_ssbo = {};
   } m_bindings;
   u32 m_num_active_descriptor_sets = 0;
+  // The sampler sets written to the current command buffer's pool. Draws often go back to textures
+  // that were bound before, those reuse the set instead of writing a new one.
+  std::unordered_map<SamplerBindings, VkDescriptorSet, SamplerBindingsHash, SamplerBindingsEqual>
+      m_sampler_descriptor_sets;
   size_t m_uniform_buffer_reserve_size = 0;
 
   // rasterization
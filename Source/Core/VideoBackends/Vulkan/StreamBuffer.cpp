@@ -31,12 +31,9 @@ StreamBuffer::~StreamBuffer()
 {
   g_command_buffer_mgr->RemoveFencePointCallback(this);
 
-  if (m_host_pointer)
-    vkUnmapMemory(g_vulkan_context->GetDevice(), m_memory);
-
   if (m_buffer != VK_NULL_HANDLE)
     g_command_buffer_mgr->DeferBufferDestruction(m_buffer);
-  if (m_memory != VK_NULL_HANDLE)
+  if (m_memory.memory != VK_NULL_HANDLE)
     g_command_buffer_mgr->DeferDeviceMemoryDestruction(m_memory);
 }
 
@@ -81,57 +78,34 @@ bool StreamBuffer::ResizeBuffer(size_t size)
   u32 memory_type_index = g_vulkan_context->GetUploadMemoryType(memory_requirements.memoryTypeBits,
     &m_coherent_mapping);
 
-  // Allocate memory for backing this buffer
-  VkMemoryAllocateInfo memory_allocate_info = {
-      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,  // VkStructureType    sType
-      nullptr,                                 // const void*        pNext
-      memory_requirements.size,                // VkDeviceSize       allocationSize
-      memory_type_index                        // uint32_t           memoryTypeIndex
-  };
-  VkDeviceMemory memory = VK_NULL_HANDLE;
-  res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_allocate_info, nullptr, &memory);
-  if (res != VK_SUCCESS)
+  // Allocate memory for backing this buffer, upload memory is mapped by the allocator.
+  VulkanContext::MemoryAllocation memory;
+  if (!g_vulkan_context->AllocateMemory(memory_requirements, memory_type_index, &memory))
   {
-    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
     vkDestroyBuffer(g_vulkan_context->GetDevice(), buffer, nullptr);
     return false;
   }
 
   // Bind memory to buffer
-  res = vkBindBufferMemory(g_vulkan_context->GetDevice(), buffer, memory, 0);
+  res = vkBindBufferMemory(g_vulkan_context->GetDevice(), buffer, memory.memory, memory.offset);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkBindBufferMemory failed: ");
     vkDestroyBuffer(g_vulkan_context->GetDevice(), buffer, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), memory, nullptr);
-    return false;
-  }
-
-  // Map this buffer into user-space
-  void* mapped_ptr = nullptr;
-  res = vkMapMemory(g_vulkan_context->GetDevice(), memory, 0, size, 0, &mapped_ptr);
-  if (res != VK_SUCCESS)
-  {
-    LOG_VULKAN_ERROR(res, "vkMapMemory failed: ");
-    vkDestroyBuffer(g_vulkan_context->GetDevice(), buffer, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), memory, nullptr);
+    g_vulkan_context->FreeMemory(memory);
     return false;
   }
 
-  // Unmap current host pointer (if there was a previous buffer)
-  if (m_host_pointer)
-    vkUnmapMemory(g_vulkan_context->GetDevice(), m_memory);
-
   // Destroy the backings for the buffer after the command buffer executes
   if (m_buffer != VK_NULL_HANDLE)
     g_command_buffer_mgr->DeferBufferDestruction(m_buffer);
-  if (m_memory != VK_NULL_HANDLE)
+  if (m_memory.memory != VK_NULL_HANDLE)
     g_command_buffer_mgr->DeferDeviceMemoryDestruction(m_memory);
 
   // Replace with the new buffer
   m_buffer = buffer;
   m_memory = memory;
-  m_host_pointer = reinterpret_cast<u8*>(mapped_ptr);
+  m_host_pointer = memory.host_pointer;
   m_current_size = size;
   m_current_offset = 0;
   m_current_gpu_position = 0;
@@ -238,8 +212,8 @@ void StreamBuffer::CommitMemory(size_t final_num_bytes)
   // For non-coherent mappings, flush the memory range
   if (!m_coherent_mapping)
   {
-    VkMappedMemoryRange range = { VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_memory,
-                                 m_current_offset, final_num_bytes };
+    VkMappedMemoryRange range = { VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, m_memory.memory,
+                                 m_memory.offset + m_current_offset, final_num_bytes };
     vkFlushMappedMemoryRanges(g_vulkan_context->GetDevice(), 1, &range);
   }
 
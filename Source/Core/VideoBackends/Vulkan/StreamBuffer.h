@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "VideoBackends/Vulkan/Constants.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
 
 namespace Vulkan
 {
@@ -20,7 +21,7 @@ public:
   ~StreamBuffer();
 
   VkBuffer GetBuffer() const { return m_buffer; }
-  VkDeviceMemory GetDeviceMemory() const { return m_memory; }
+  VkDeviceMemory GetDeviceMemory() const { return m_memory.memory; }
   u8* GetHostPointer() const { return m_host_pointer; }
   u8* GetCurrentHostPointer() const { return m_host_pointer + m_current_offset; }
   size_t GetCurrentSize() const { return m_current_size; }
@@ -48,7 +49,7 @@ private:
   size_t m_last_allocation_size = 0;
 
   VkBuffer m_buffer = VK_NULL_HANDLE;
-  VkDeviceMemory m_memory = VK_NULL_HANDLE;
+  VulkanContext::MemoryAllocation m_memory;
   u8* m_host_pointer = nullptr;
 
   // List of fences and the corresponding positions in the buffer
@@ -24,8 +24,9 @@
 
 namespace Vulkan
 {
-SwapChain::SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync)
-  : m_native_handle(native_handle), m_surface(surface), m_vsync_enabled(vsync)
+SwapChain::SwapChain(void* native_handle, VkSurfaceKHR surface, bool vsync, bool low_latency)
+  : m_native_handle(native_handle), m_surface(surface), m_vsync_enabled(vsync),
+    m_low_latency(low_latency)
 {
 }
 
@@ -127,10 +128,11 @@ VkSurfaceKHR SwapChain::CreateVulkanSurface(VkInstance instance, void* hwnd)
 #endif
 }
 
-std::unique_ptr<SwapChain> SwapChain::Create(void* native_handle, VkSurfaceKHR surface, bool vsync)
+std::unique_ptr<SwapChain> SwapChain::Create(void* native_handle, VkSurfaceKHR surface, bool vsync,
+                                             bool low_latency)
 {
   std::unique_ptr<SwapChain> swap_chain =
-    std::make_unique<SwapChain>(native_handle, surface, vsync);
+    std::make_unique<SwapChain>(native_handle, surface, vsync, low_latency);
 
   if (!swap_chain->CreateSwapChain() || !swap_chain->CreateRenderPass() ||
     !swap_chain->SetupSwapChainImages())
@@ -198,6 +200,13 @@ bool SwapChain::SelectPresentMode()
     return it != present_modes.end();
   };
 
+  // Mailbox doesn't tear either, but replaces a queued frame instead of waiting behind it.
+  if (m_vsync_enabled && m_low_latency && CheckForMode(VK_PRESENT_MODE_MAILBOX_KHR))
+  {
+    m_present_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+    return true;
+  }
+
   // If vsync is enabled, use VK_PRESENT_MODE_FIFO_KHR.
   // This check should not fail with conforming drivers, as the FIFO present mode is mandated by
   // the specification (VK_KHR_swapchain). In case it isn't though, fall through to any other mode.
@@ -479,6 +488,15 @@ bool SwapChain::SetVSync(bool enabled)
   return RecreateSwapChain();
 }
 
+bool SwapChain::SetLowLatency(bool enabled)
+{
+  if (m_low_latency == enabled)
+    return true;
+
+  m_low_latency = enabled;
+  return RecreateSwapChain();
+}
+
 bool SwapChain::RecreateSurface(void* native_handle)
 {
   // Destroy the old swap chain, images, and surface.
@@ -13,7 +13,8 @@ namespace Vulkan
 {
 Texture2D::Texture2D(u32 width, u32 height, u32 levels, u32 layers, VkFormat format,
                      VkSampleCountFlagBits samples, VkImageViewType view_type, VkImage image,
-                     VkDeviceMemory device_memory, VkImageView view, VkImageUsageFlags usage)
+                     const VulkanContext::MemoryAllocation& device_memory, VkImageView view,
+                     VkImageUsageFlags usage)
     : m_width(width), m_height(height), m_levels(levels), m_layers(layers), m_format(format),
       m_samples(samples), m_view_type(view_type), m_image(image), m_device_memory(device_memory),
       m_view(view), m_usage(usage), m_framebuffer(nullptr)
@@ -66,7 +67,7 @@ Texture2D::~Texture2D()
     g_command_buffer_mgr->DeferFramebufferDestruction(m_framebuffer);
 
   // If we don't have device memory allocated, the image is not owned by us (e.g. swapchain)
-  if (m_device_memory != VK_NULL_HANDLE)
+  if (m_device_memory.memory != VK_NULL_HANDLE)
   {
     g_command_buffer_mgr->DeferImageDestruction(m_image);
     g_command_buffer_mgr->DeferDeviceMemoryDestruction(m_device_memory);
@@ -106,26 +107,23 @@ std::unique_ptr<Texture2D> Texture2D::Create(u32 width, u32 height, u32 levels,
   VkMemoryRequirements memory_requirements;
   vkGetImageMemoryRequirements(g_vulkan_context->GetDevice(), image, &memory_requirements);
 
-  VkMemoryAllocateInfo memory_info = {
-      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, memory_requirements.size,
-      g_vulkan_context->GetMemoryType(memory_requirements.memoryTypeBits,
-                                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)};
-
-  VkDeviceMemory device_memory;
-  res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_info, nullptr, &device_memory);
-  if (res != VK_SUCCESS)
+  VulkanContext::MemoryAllocation device_memory;
+  if (!g_vulkan_context->AllocateMemory(
+          memory_requirements, g_vulkan_context->GetMemoryType(memory_requirements.memoryTypeBits,
+                                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+          &device_memory))
   {
-    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
     return nullptr;
   }
 
-  res = vkBindImageMemory(g_vulkan_context->GetDevice(), image, device_memory, 0);
+  res = vkBindImageMemory(g_vulkan_context->GetDevice(), image, device_memory.memory,
+                          device_memory.offset);
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vkBindImageMemory failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), device_memory, nullptr);
+    g_vulkan_context->FreeMemory(device_memory);
     return nullptr;
   }
 
@@ -148,7 +146,7 @@ std::unique_ptr<Texture2D> Texture2D::Create(u32 width, u32 height, u32 levels,
   {
     LOG_VULKAN_ERROR(res, "vkCreateImageView failed: ");
     vkDestroyImage(g_vulkan_context->GetDevice(), image, nullptr);
-    vkFreeMemory(g_vulkan_context->GetDevice(), device_memory, nullptr);
+    g_vulkan_context->FreeMemory(device_memory);
     return nullptr;
   }
   return std::make_unique<Texture2D>(width, height, levels, layers, format, samples, view_type,
@@ -175,7 +173,7 @@ Texture2D::CreateFromExistingImage(u32 width, u32 height, u32 levels, u32 layers
        0, levels, 0, layers}};
 
   // Memory is managed by the owner of the image.
-  VkDeviceMemory memory = VK_NULL_HANDLE;
+  VulkanContext::MemoryAllocation memory;
   VkImageView view = VK_NULL_HANDLE;
   VkResult res = vkCreateImageView(g_vulkan_context->GetDevice(), &view_info, nullptr, &view);
   if (res != VK_SUCCESS)
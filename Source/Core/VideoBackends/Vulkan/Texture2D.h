@@ -8,6 +8,7 @@
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
+#include "VideoBackends/Vulkan/VulkanContext.h"
 
 namespace Vulkan
 {
@@ -27,7 +28,8 @@ public:
   };
   Texture2D(u32 width, u32 height, u32 levels, u32 layers, VkFormat format,
     VkSampleCountFlagBits samples, VkImageViewType view_type, VkImage image,
-    VkDeviceMemory device_memory, VkImageView view, VkImageUsageFlags usage);
+    const VulkanContext::MemoryAllocation& device_memory, VkImageView view,
+    VkImageUsageFlags usage);
   ~Texture2D();
 
   void AddFramebuffer(VkRenderPass renderpass, bool clear = true);
@@ -54,7 +56,7 @@ public:
   VkImage GetImage() const { return m_image; }
   VkFramebuffer GetFrameBuffer() const { return m_framebuffer; }
   VkRenderPass GetDefaultRenderPass() const { return m_renderpass; }
-  VkDeviceMemory GetDeviceMemory() const { return m_device_memory; }
+  VkDeviceMemory GetDeviceMemory() const { return m_device_memory.memory; }
   VkImageView GetView() const { return m_view; }
   // Used when the render pass is changing the image layout, or to force it to
   // VK_IMAGE_LAYOUT_UNDEFINED, if the existing contents of the image is
@@ -75,7 +77,7 @@ private:
   ComputeImageLayout m_compute_layout = ComputeImageLayout::Undefined;
 
   VkImage m_image;
-  VkDeviceMemory m_device_memory;
+  VulkanContext::MemoryAllocation m_device_memory;
   VkImageView m_view;
   //framebuffer for drawing into.
   VkFramebuffer m_framebuffer;
@@ -42,6 +42,9 @@ TextureCache::TextureCache()
 
 TextureCache::~TextureCache()
 {
+  FlushDeferredEFBCopies();
+  // The textures are destroyed along with the cache.
+  m_pending_texture_copies.clear();
   for (size_t i = 0; i < m_render_pass.size(); i++)
   {
     if (m_render_pass[i] != VK_NULL_HANDLE)
@@ -118,6 +121,27 @@ void TextureCache::LoadLut(u32 lutFmt, void* addr, u32 size)
 void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
   u32 num_blocks_y, u32 memory_stride,
   bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half)
+{
+  EncodeEFB(dst, format, native_width, bytes_per_row, num_blocks_y, memory_stride, is_depth_copy,
+    src_rect, scale_by_half, false);
+}
+
+u64 TextureCache::DeferEFBCopy(u8* dst, const EFBCopyFormat& format, u32 native_width,
+  u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+  bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half)
+{
+  return EncodeEFB(dst, format, native_width, bytes_per_row, num_blocks_y, memory_stride,
+    is_depth_copy, src_rect, scale_by_half, true);
+}
+
+void TextureCache::ReadbackDeferredEFBCopies(u64 id)
+{
+  m_texture_converter->ReadbackDeferredCopies(id);
+}
+
+u64 TextureCache::EncodeEFB(u8* dst, const EFBCopyFormat& format, u32 native_width,
+  u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride, bool is_depth_copy,
+  const EFBRectangle& src_rect, bool scale_by_half, bool deferred)
 {
   // Flush EFB pokes first, as they're expected to be included.
   FramebufferManager::GetInstance()->FlushEFBPokes();
@@ -141,20 +165,33 @@ void TextureCache::CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_widt
   // End render pass before barrier (since we have no self-dependencies).
   // The barrier has to happen after the render pass, not inside it, as we are going to be
   // reading from the texture immediately afterwards.
+  // A deferred copy is only a CPU access once it is read back.
   StateTracker::GetInstance()->EndRenderPass();
-  StateTracker::GetInstance()->OnReadback();
+  if (!deferred)
+    StateTracker::GetInstance()->OnReadback();
 
   // Transition to shader resource before reading.
   VkImageLayout original_layout = src_texture->GetLayout();
   src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-  m_texture_converter->EncodeTextureToMemory(src_texture->GetView(), dst, format, native_width,
-    bytes_per_row, num_blocks_y, memory_stride,
-    is_depth_copy, src_rect, scale_by_half);
+  u64 id = 0;
+  if (deferred)
+  {
+    id = m_texture_converter->EncodeTextureToMemoryDeferred(src_texture->GetView(), dst, format,
+      native_width, bytes_per_row, num_blocks_y, memory_stride, is_depth_copy, src_rect,
+      scale_by_half);
+  }
+  else
+  {
+    m_texture_converter->EncodeTextureToMemory(src_texture->GetView(), dst, format, native_width,
+      bytes_per_row, num_blocks_y, memory_stride,
+      is_depth_copy, src_rect, scale_by_half);
+  }
 
   // Transition back to original state
   src_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(), original_layout);
+  return id;
 }
 
 HostTextureFormat TextureCache::GetHostTextureFormat(const s32 texformat, const TlutFormat tlutfmt, u32 width, u32 height)
@@ -267,45 +304,108 @@ bool TextureCache::DecodeTextureOnGPU(HostTexture* dst, u32 dst_level, const u8*
     row_stride, palette, palette_format);
 }
 
+bool TextureCache::SupportsGPUTextureScaling(int type, int factor)
+{
+  return m_texture_converter->SupportsTextureScaling(type, factor);
+}
+
+bool TextureCache::ScaleTextureOnGPU(HostTexture* dst, u32 dst_level, const u8* data, u32 width,
+  u32 height, u32 row_length, int type, int factor)
+{
+  return m_texture_converter->ScaleTexture(dst, dst_level, data, width, height, row_length, type,
+    factor);
+}
+
 void TextureCache::CopyEFBToCacheEntry(
   TextureCacheBase::TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
   bool scale_by_half, u32 cbuf_id, const float* colmat, u32 width, u32 height)
 {
-  VKTexture* texture = static_cast<VKTexture*>(entry->texture.get());
-  // A better way of doing this would be nice.
-  FramebufferManager* framebuffer_mgr =
-    static_cast<FramebufferManager*>(g_framebuffer_manager.get());
-  TargetRectangle scaled_src_rect = g_renderer->ConvertEFBRectangle(src_rect);
+  PendingTextureCopy copy;
+  copy.texture = static_cast<VKTexture*>(entry->texture.get());
+  copy.is_depth_copy = is_depth_copy;
+  copy.scale_by_half = scale_by_half;
+  copy.scaled_src_rect = g_renderer->ConvertEFBRectangle(src_rect);
+  copy.width = width;
+  copy.height = height;
+  std::copy_n(colmat, is_depth_copy ? 20 : 28, copy.colmat.begin());
+
+  // Has to be flagged as a render target.
+  ASSERT(copy.texture->GetFramebuffer() != VK_NULL_HANDLE);
+
+  // An out-of-bounds source region is valid here, and fine for the draw (since it is converted
+  // to texture coordinates), but it's not valid to resolve an out-of-range rectangle.
+  FramebufferManager* framebuffer_mgr = FramebufferManager::GetInstance();
+  copy.region =
+  {
+      { copy.scaled_src_rect.left, copy.scaled_src_rect.top },
+      { static_cast<u32>(copy.scaled_src_rect.GetWidth()),
+        static_cast<u32>(copy.scaled_src_rect.GetHeight()) }
+  };
+  copy.region = Util::ClampRect2D(copy.region, framebuffer_mgr->GetEFBWidth(),
+    framebuffer_mgr->GetEFBHeight());
 
   // Flush EFB pokes first, as they're expected to be included.
   framebuffer_mgr->FlushEFBPokes();
 
-  // Has to be flagged as a render target.
-  ASSERT(texture->GetFramebuffer() != VK_NULL_HANDLE);
+  // The copy needs its own render pass. Rather than splitting the EFB render pass for every copy
+  // made between draws, wait for the pass to end. The state tracker ends it early for draws that
+  // depend on the copy.
+  if (StateTracker::GetInstance()->InRenderPass())
+  {
+    m_pending_texture_copies.push_back(copy);
+    return;
+  }
+
+  RunTextureCopy(copy);
+}
+
+bool TextureCache::IsPendingTextureCopySource(const VkRect2D& rect) const
+{
+  return std::any_of(m_pending_texture_copies.begin(), m_pending_texture_copies.end(),
+    [&rect](const PendingTextureCopy& copy) {
+    const VkRect2D& region = copy.region;
+    return rect.offset.x < region.offset.x + static_cast<s32>(region.extent.width) &&
+      region.offset.x < rect.offset.x + static_cast<s32>(rect.extent.width) &&
+      rect.offset.y < region.offset.y + static_cast<s32>(region.extent.height) &&
+      region.offset.y < rect.offset.y + static_cast<s32>(rect.extent.height);
+  });
+}
+
+bool TextureCache::IsPendingTextureCopyDestination(VkImageView view) const
+{
+  return std::any_of(m_pending_texture_copies.begin(), m_pending_texture_copies.end(),
+    [view](const PendingTextureCopy& copy) {
+    return copy.texture->GetRawTexIdentifier()->GetView() == view;
+  });
+}
+
+void TextureCache::RunPendingTextureCopies()
+{
+  // Copies run outside of any render pass, so none are queued while running these.
+  for (const PendingTextureCopy& copy : m_pending_texture_copies)
+    RunTextureCopy(copy);
+  m_pending_texture_copies.clear();
+}
+
+void TextureCache::RunTextureCopy(const PendingTextureCopy& copy)
+{
+  VKTexture* texture = copy.texture;
+  const TargetRectangle& scaled_src_rect = copy.scaled_src_rect;
+  FramebufferManager* framebuffer_mgr = FramebufferManager::GetInstance();
 
   // Can't be done in a render pass, since we're doing our own render pass!
   VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentCommandBuffer();
   StateTracker::GetInstance()->EndRenderPass();
 
   // Transition EFB to shader resource before binding.
-  // An out-of-bounds source region is valid here, and fine for the draw (since it is converted
-  // to texture coordinates), but it's not valid to resolve an out-of-range rectangle.
-  VkRect2D region =
-  {
-      { scaled_src_rect.left, scaled_src_rect.top },
-      { static_cast<u32>(scaled_src_rect.GetWidth()), static_cast<u32>(scaled_src_rect.GetHeight()) }
-  };
-  region = Util::ClampRect2D(region, FramebufferManager::GetInstance()->GetEFBWidth(),
-    FramebufferManager::GetInstance()->GetEFBHeight());
-
   Texture2D* src_texture;
-  if (is_depth_copy)
-    src_texture = FramebufferManager::GetInstance()->ResolveEFBDepthTexture(region);
+  if (copy.is_depth_copy)
+    src_texture = framebuffer_mgr->ResolveEFBDepthTexture(copy.region);
   else
-    src_texture = FramebufferManager::GetInstance()->ResolveEFBColorTexture(region);
+    src_texture = framebuffer_mgr->ResolveEFBColorTexture(copy.region);
 
   VkSampler src_sampler =
-    scale_by_half ? g_object_cache->GetLinearSampler() : g_object_cache->GetPointSampler();
+    copy.scale_by_half ? g_object_cache->GetLinearSampler() : g_object_cache->GetPointSampler();
   VkImageLayout original_layout = src_texture->GetLayout();
   src_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
   texture->GetRawTexIdentifier()->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
@@ -314,12 +414,13 @@ void TextureCache::CopyEFBToCacheEntry(
     command_buffer, g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_PUSH_CONSTANT),
     GetRenderPass(texture->GetRawTexIdentifier()->GetFormat()), g_shader_cache->GetPassthroughVertexShader(),
     g_shader_cache->GetPassthroughGeometryShader(),
-    is_depth_copy ? m_efb_depth_to_tex_shader : m_efb_color_to_tex_shader);
+    copy.is_depth_copy ? m_efb_depth_to_tex_shader : m_efb_color_to_tex_shader);
 
-  draw.SetPushConstants(colmat, (is_depth_copy ? sizeof(float) * 20 : sizeof(float) * 28));
+  draw.SetPushConstants(copy.colmat.data(),
+    (copy.is_depth_copy ? sizeof(float) * 20 : sizeof(float) * 28));
   draw.SetPSSampler(0, src_texture->GetView(), src_sampler);
 
-  VkRect2D dest_region = { { 0, 0 },{ width, height } };
+  VkRect2D dest_region = { { 0, 0 },{ copy.width, copy.height } };
 
   draw.BeginRenderPass(texture->GetRawTexIdentifier()->GetFrameBuffer(), dest_region);
 
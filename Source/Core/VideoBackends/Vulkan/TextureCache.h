@@ -6,6 +6,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
@@ -17,6 +18,7 @@ namespace Vulkan
 class TextureConverter;
 class StateTracker;
 class Texture2D;
+class VKTexture;
 
 class TextureCache : public TextureCacheBase
 {
@@ -39,6 +41,14 @@ public:
   void CopyEFBToCacheEntry(TextureCacheBase::TCacheEntry* entry, bool is_depth_copy, const EFBRectangle& src_rect,
     bool scale_by_half, u32 cbuf_id, const float* colmat, u32 width, u32 height) override;
 
+  // EFB copies to textures made in the EFB render pass wait for it to end, so anything changing
+  // their source region or using their destination has to end it first.
+  bool HasPendingTextureCopies() const { return !m_pending_texture_copies.empty(); }
+  bool IsPendingTextureCopySource(const VkRect2D& rect) const;
+  bool IsPendingTextureCopyDestination(VkImageView view) const;
+  // Called by the state tracker once the EFB render pass ended.
+  void RunPendingTextureCopies();
+
   bool DecodeTextureOnGPU(HostTexture* dst, u32 dst_level, const u8* data,
     u32 data_size, TextureFormat format, u32 width, u32 height,
     u32 aligned_width, u32 aligned_height, u32 row_stride,
@@ -47,8 +57,15 @@ public:
   void CopyEFB(u8* dst, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
     u32 num_blocks_y, u32 memory_stride,
     bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half) override;
+  u64 DeferEFBCopy(u8* dst, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+    u32 num_blocks_y, u32 memory_stride,
+    bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half) override;
+  void ReadbackDeferredEFBCopies(u64 id) override;
 
   bool SupportsGPUTextureDecode(TextureFormat format, TlutFormat palette_format) override;
+  bool SupportsGPUTextureScaling(int type, int factor) override;
+  bool ScaleTextureOnGPU(HostTexture* dst, u32 dst_level, const u8* data, u32 width, u32 height,
+    u32 row_length, int type, int factor) override;
   TextureConverter* GetTextureConverter()
   {
     return m_texture_converter.get();
@@ -82,10 +99,30 @@ public:
     return m_texture_upload_buffer.get();
   }
 private:
+  struct PendingTextureCopy
+  {
+    VKTexture* texture;
+    bool is_depth_copy;
+    bool scale_by_half;
+    TargetRectangle scaled_src_rect;
+    // The source rectangle clamped to the EFB.
+    VkRect2D region;
+    u32 width;
+    u32 height;
+    std::array<float, 28> colmat;
+  };
+
   bool CreateRenderPasses();
+  void RunTextureCopy(const PendingTextureCopy& copy);
+  // Encodes an EFB copy for CopyEFB or DeferEFBCopy, returns the id of a deferred one.
+  u64 EncodeEFB(u8* dst, const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row,
+    u32 num_blocks_y, u32 memory_stride, bool is_depth_copy, const EFBRectangle& src_rect,
+    bool scale_by_half, bool deferred);
 
   std::array<VkRenderPass, 5> m_render_pass;
 
+  std::vector<PendingTextureCopy> m_pending_texture_copies;
+
   std::unique_ptr<StreamBuffer> m_texture_upload_buffer;
 
   std::unique_ptr<TextureConverter> m_texture_converter;
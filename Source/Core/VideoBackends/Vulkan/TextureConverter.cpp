@@ -7,8 +7,10 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <functional>
 #include <string>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
@@ -29,16 +31,58 @@
 
 #include "VideoCommon/TextureConversionShader.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureScalerShader.h"
+#include "VideoCommon/TmemMirror.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace Vulkan
 {
+// The textures written on the async compute queue start out undefined, so they never have to be
+// handed back to it from the graphics queue.
+static void BeginAsyncComputeWrite(VkCommandBuffer compute_command_buffer, Texture2D* texture)
+{
+  VkImageMemoryBarrier barrier = {
+      VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr, 0, VK_ACCESS_SHADER_WRITE_BIT,
+      VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, VK_QUEUE_FAMILY_IGNORED,
+      VK_QUEUE_FAMILY_IGNORED, texture->GetImage(), {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
+  vkCmdPipelineBarrier(compute_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+  texture->OverrideImageLayout(VK_IMAGE_LAYOUT_GENERAL);
+}
+
+// Moves a texture written on the async compute queue to the graphics queue as a copy source. The
+// release on the compute queue and the acquire on the graphics queue use the same barrier, the
+// graphics queue waits for the compute work before its transfers.
+static void EndAsyncComputeWrite(VkCommandBuffer compute_command_buffer,
+  VkCommandBuffer graphics_command_buffer, Texture2D* texture)
+{
+  VkImageMemoryBarrier barrier = {
+      VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, 0,
+      VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      g_vulkan_context->GetComputeQueueFamilyIndex(),
+      g_vulkan_context->GetGraphicsQueueFamilyIndex(), texture->GetImage(),
+      {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
+  vkCmdPipelineBarrier(compute_command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+    VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+  barrier.srcAccessMask = 0;
+  barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  vkCmdPipelineBarrier(graphics_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+  texture->OverrideImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+}
+
 TextureConverter::TextureConverter()
 {
+  g_command_buffer_mgr->AddFencePointCallback(
+    this, [](VkCommandBuffer, VkFence) {},
+    std::bind(&TextureConverter::OnCommandBufferExecuted, this, std::placeholders::_1));
 }
 
 TextureConverter::~TextureConverter()
 {
+  g_command_buffer_mgr->RemoveFencePointCallback(this);
+
   for (const auto& it : m_palette_conversion_shaders)
   {
     if (it != VK_NULL_HANDLE)
@@ -54,6 +98,14 @@ TextureConverter::~TextureConverter()
   if (m_texel_buffer_view_rgba8_unorm != VK_NULL_HANDLE)
     vkDestroyBufferView(g_vulkan_context->GetDevice(), m_texel_buffer_view_rgba8_unorm, nullptr);
 
+  DestroyTmemBuffer();
+
+  for (VkBufferView view : m_async_texel_buffer_views)
+  {
+    if (view != VK_NULL_HANDLE)
+      vkDestroyBufferView(g_vulkan_context->GetDevice(), view, nullptr);
+  }
+
   if (m_encoding_render_pass != VK_NULL_HANDLE)
     vkDestroyRenderPass(g_vulkan_context->GetDevice(), m_encoding_render_pass, nullptr);
 
@@ -66,6 +118,12 @@ TextureConverter::~TextureConverter()
       vkDestroyShaderModule(g_vulkan_context->GetDevice(), it.second.compute_shader, nullptr);
   }
 
+  for (const auto& it : m_scaling_shaders)
+  {
+    if (it.second != VK_NULL_HANDLE)
+      vkDestroyShaderModule(g_vulkan_context->GetDevice(), it.second, nullptr);
+  }
+
   if (m_rgb_to_yuyv_shader != VK_NULL_HANDLE)
     vkDestroyShaderModule(g_vulkan_context->GetDevice(), m_rgb_to_yuyv_shader, nullptr);
   if (m_yuyv_to_rgb_shader != VK_NULL_HANDLE)
@@ -110,6 +168,13 @@ bool TextureConverter::Initialize()
     return false;
   }
 
+  // Without the copy of TMEM, preloaded textures are uploaded like any other.
+  if (!CreateTmemBuffer())
+    WARN_LOG(VIDEO, "Failed to create TMEM buffer");
+
+  if (g_command_buffer_mgr->UsesAsyncCompute() && !CreateAsyncComputeTexelBuffer())
+    WARN_LOG(VIDEO, "Failed to create texel buffer for async compute");
+
   if (!CompileYUYVConversionShaders())
   {
     PanicAlert("Failed to compile YUYV conversion shaders");
@@ -218,13 +283,124 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
   u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
   bool is_depth_copy, const EFBRectangle& src_rect,
   bool scale_by_half)
+{
+  u32 render_width = bytes_per_row / sizeof(u32);
+  u32 render_height = num_blocks_y;
+  if (!EncodeTexture(src_texture, format, native_width, render_width, render_height,
+    is_depth_copy, src_rect, scale_by_half))
+  {
+    return;
+  }
+
+  m_encoding_download_texture->CopyFromImage(
+    g_command_buffer_mgr->GetCurrentCommandBuffer(), m_encoding_render_texture->GetImage(),
+    VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, render_width, render_height, 0, 0);
+
+  // Block until the GPU has finished copying to the staging texture.
+  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+
+  // Copy from staging texture to the final destination, adjusting pitch if necessary.
+  m_encoding_download_texture->ReadTexels(0, 0, render_width, render_height, dest_ptr,
+    memory_stride);
+}
+
+u64 TextureConverter::EncodeTextureToMemoryDeferred(VkImageView src_texture, u8* dest_ptr,
+  const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
+  u32 memory_stride, bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half)
+{
+  u32 render_width = bytes_per_row / sizeof(u32);
+  u32 render_height = num_blocks_y;
+
+  // Reuse a staging texture that is large enough, most games copy the same sizes every frame.
+  std::unique_ptr<StagingTexture2D> texture;
+  auto iter = std::find_if(m_free_deferred_copy_textures.begin(),
+    m_free_deferred_copy_textures.end(),
+    [render_width, render_height](const std::unique_ptr<StagingTexture2D>& free_texture) {
+      return free_texture->GetWidth() >= render_width &&
+        free_texture->GetHeight() >= render_height;
+    });
+  if (iter != m_free_deferred_copy_textures.end())
+  {
+    texture = std::move(*iter);
+    m_free_deferred_copy_textures.erase(iter);
+  }
+  else
+  {
+    texture = StagingTexture2D::Create(STAGING_BUFFER_TYPE_READBACK, render_width, render_height,
+      ENCODING_TEXTURE_FORMAT);
+    if (!texture || !texture->Map())
+      return 0;
+  }
+
+  if (!EncodeTexture(src_texture, format, native_width, render_width, render_height,
+    is_depth_copy, src_rect, scale_by_half))
+  {
+    m_free_deferred_copy_textures.push_back(std::move(texture));
+    return 0;
+  }
+
+  texture->CopyFromImage(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+    m_encoding_render_texture->GetImage(), VK_IMAGE_ASPECT_COLOR_BIT, 0, 0,
+    render_width, render_height, 0, 0);
+
+  const u64 id = m_next_deferred_copy_id++;
+  m_deferred_copies.push_back({id, std::move(texture), dest_ptr, render_width, render_height,
+    memory_stride, g_command_buffer_mgr->GetCurrentCommandBufferFence()});
+  return id;
+}
+
+void TextureConverter::ReadbackDeferredCopies(u64 id)
+{
+  const auto end = std::find_if(m_deferred_copies.begin(), m_deferred_copies.end(),
+    [id](const DeferredCopy& copy) { return copy.id > id; });
+  if (end == m_deferred_copies.begin())
+    return;
+
+  // Command buffers execute in order, the older copies are done once the newest one is.
+  const VkFence fence = (end - 1)->pending_fence;
+  if (fence != VK_NULL_HANDLE)
+  {
+    StateTracker::GetInstance()->OnReadback();
+    if (fence == g_command_buffer_mgr->GetCurrentCommandBufferFence())
+      Util::ExecuteCurrentCommandsAndRestoreState(false, true);
+    else
+      g_command_buffer_mgr->WaitForFence(fence);
+  }
+
+  for (auto copy = m_deferred_copies.begin(); copy != end; ++copy)
+  {
+    copy->texture->InvalidateCPUCache();
+    copy->texture->ReadTexels(0, 0, copy->width, copy->height, copy->dest_ptr,
+      copy->memory_stride);
+    m_free_deferred_copy_textures.push_back(std::move(copy->texture));
+  }
+  m_deferred_copies.erase(m_deferred_copies.begin(), end);
+}
+
+void TextureConverter::OnCommandBufferExecuted(VkFence fence)
+{
+  for (DeferredCopy& copy : m_deferred_copies)
+  {
+    if (copy.pending_fence == fence)
+      copy.pending_fence = VK_NULL_HANDLE;
+  }
+  for (AsyncComputeTexture& texture : m_async_compute_textures)
+  {
+    if (texture.pending_fence == fence)
+      texture.pending_fence = VK_NULL_HANDLE;
+  }
+}
+
+bool TextureConverter::EncodeTexture(VkImageView src_texture, const EFBCopyFormat& format,
+  u32 native_width, u32 render_width, u32 render_height, bool is_depth_copy,
+  const EFBRectangle& src_rect, bool scale_by_half)
 {
   VkShaderModule shader = GetEncodingShader(format);
   if (shader == VK_NULL_HANDLE)
   {
     ERROR_LOG(VIDEO, "Missing encoding fragment shader for format %u->%u", format.efb_format,
       static_cast<u32>(format.copy_format));
-    return;
+    return false;
   }
 
   // Can't do our own draw within a render pass.
@@ -250,8 +426,6 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
   draw.SetPSSampler(0, src_texture, linear_filter ? g_object_cache->GetLinearSampler() :
     g_object_cache->GetPointSampler());
 
-  u32 render_width = bytes_per_row / sizeof(u32);
-  u32 render_height = num_blocks_y;
   Util::SetViewportAndScissor(g_command_buffer_mgr->GetCurrentCommandBuffer(), 0, 0, render_width,
     render_height);
 
@@ -263,16 +437,7 @@ void TextureConverter::EncodeTextureToMemory(VkImageView src_texture, u8* dest_p
   // Transition the image before copying
   m_encoding_render_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-  m_encoding_download_texture->CopyFromImage(
-    g_command_buffer_mgr->GetCurrentCommandBuffer(), m_encoding_render_texture->GetImage(),
-    VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, render_width, render_height, 0, 0);
-
-  // Block until the GPU has finished copying to the staging texture.
-  Util::ExecuteCurrentCommandsAndRestoreState(false, true);
-
-  // Copy from staging texture to the final destination, adjusting pitch if necessary.
-  m_encoding_download_texture->ReadTexels(0, 0, render_width, render_height, dest_ptr,
-    memory_stride);
+  return true;
 }
 
 void TextureConverter::EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride,
@@ -436,54 +601,79 @@ bool TextureConverter::DecodeTexture(HostTexture* dst, u32 dst_level,
     u32 palette_offset;
   };
 
-  // Copy to GPU-visible buffer, aligned to the data type
   auto info = iter->second;
   u32 bytes_per_buffer_elem =
     TextureConversionShader::GetBytesPerBufferElement(info.base_info->buffer_format);
-
-  // Calculate total data size, including palette.
-  // Only copy palette if it is required.
-  u32 total_upload_size = static_cast<u32>(data_size);
   u32 palette_size = iter->second.base_info->palette_size;
-  u32 palette_offset = total_upload_size;
   bool has_palette = palette_size > 0;
-  if (has_palette)
-  {
-    // Align to u16.
-    if ((total_upload_size % sizeof(u16)) != 0)
-    {
-      total_upload_size++;
-      palette_offset++;
-    }
 
-    total_upload_size += palette_size;
-  }
-
-  // Allocate space for upload, if it fails, execute the buffer.
-  if (!m_texel_buffer->ReserveMemory(total_upload_size, bytes_per_buffer_elem))
-  {
-    Util::ExecuteCurrentCommandsAndRestoreState(true, false);
-    if (!m_texel_buffer->ReserveMemory(total_upload_size, bytes_per_buffer_elem))
-      PanicAlert("Failed to reserve memory for encoded texture upload");
-  }
-
-  // Copy/commit upload buffer.
-  u32 texel_buffer_offset = static_cast<u32>(m_texel_buffer->GetCurrentOffset());
-  std::memcpy(m_texel_buffer->GetCurrentHostPointer(), data, data_size);
-  if (has_palette)
-    std::memcpy(m_texel_buffer->GetCurrentHostPointer() + palette_offset, palette, palette_size);
-  m_texel_buffer->CommitMemory(total_upload_size);
+  // Textures preloaded into TMEM, and their palettes, are read from the copy of TMEM.
+  u32 tmem_offset = 0;
+  u32 palette_tmem_offset = 0;
+  const bool from_tmem = m_tmem_buffer != VK_NULL_HANDLE &&
+    TmemMirror::GetOffset(data, &tmem_offset) &&
+    TmemMirror::GetOffset(palette, &palette_tmem_offset) &&
+    tmem_offset % bytes_per_buffer_elem == 0 && tmem_offset + data_size <= TMEM_SIZE;
 
   // Determine uniforms.
   PushConstants constants = {
       { width, height },
       { aligned_width, aligned_height },
-      texel_buffer_offset / bytes_per_buffer_elem,
+      tmem_offset / bytes_per_buffer_elem,
       row_stride / bytes_per_buffer_elem,
-      static_cast<u32>((texel_buffer_offset + palette_offset) / sizeof(u16)) };
+      palette_tmem_offset / static_cast<u32>(sizeof(u16)) };
+
+  // The copy of TMEM is updated on the graphics queue, so only uploaded textures are decoded on the
+  // async compute queue.
+  AsyncComputeTexture* async_texture = nullptr;
+  if (!from_tmem && m_async_texel_buffer)
+    async_texture = GetAsyncComputeTexture(aligned_width, aligned_height);
+  StreamBuffer* texel_buffer = async_texture ? m_async_texel_buffer.get() : m_texel_buffer.get();
+
+  if (!from_tmem)
+  {
+    // Copy to GPU-visible buffer, aligned to the data type
+    // Calculate total data size, including palette.
+    // Only copy palette if it is required.
+    u32 total_upload_size = static_cast<u32>(data_size);
+    u32 palette_offset = total_upload_size;
+    if (has_palette)
+    {
+      // Align to u16.
+      if ((total_upload_size % sizeof(u16)) != 0)
+      {
+        total_upload_size++;
+        palette_offset++;
+      }
+
+      total_upload_size += palette_size;
+    }
+
+    // Allocate space for upload, if it fails, execute the buffer.
+    if (!texel_buffer->ReserveMemory(total_upload_size, bytes_per_buffer_elem))
+    {
+      Util::ExecuteCurrentCommandsAndRestoreState(true, false);
+      if (!texel_buffer->ReserveMemory(total_upload_size, bytes_per_buffer_elem))
+        PanicAlert("Failed to reserve memory for encoded texture upload");
+    }
+
+    // Copy/commit upload buffer.
+    u32 texel_buffer_offset = static_cast<u32>(texel_buffer->GetCurrentOffset());
+    std::memcpy(texel_buffer->GetCurrentHostPointer(), data, data_size);
+    if (has_palette)
+      std::memcpy(texel_buffer->GetCurrentHostPointer() + palette_offset, palette, palette_size);
+    texel_buffer->CommitMemory(total_upload_size);
+
+    constants.src_offset = texel_buffer_offset / bytes_per_buffer_elem;
+    constants.palette_offset =
+      static_cast<u32>((texel_buffer_offset + palette_offset) / sizeof(u16));
+  }
 
   // Determine view to use for texel buffers.
   VkBufferView data_view = VK_NULL_HANDLE;
+  VkBufferView palette_view =
+    from_tmem ? m_tmem_buffer_views[TextureConversionShader::BUFFER_FORMAT_R16_UINT] :
+    m_texel_buffer_view_r16_uint;
   switch (iter->second.base_info->buffer_format)
   {
   case TextureConversionShader::BUFFER_FORMAT_R8_UINT:
@@ -498,34 +688,58 @@ bool TextureConverter::DecodeTexture(HostTexture* dst, u32 dst_level,
   default:
     break;
   }
+  if (from_tmem)
+    data_view = m_tmem_buffer_views[iter->second.base_info->buffer_format];
+  if (async_texture)
+  {
+    data_view = m_async_texel_buffer_views[iter->second.base_info->buffer_format];
+    palette_view = m_async_texel_buffer_views[TextureConversionShader::BUFFER_FORMAT_R16_UINT];
+  }
 
   // Place compute shader dispatches together in the init command buffer.
   // That way we don't have to pay a penalty for switching from graphics->compute,
   // or end/restart our render pass.
   VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentInitCommandBuffer();
+  VkCommandBuffer compute_command_buffer = command_buffer;
+  Texture2D* decoding_texture = m_decoding_texture.get();
+  if (async_texture)
+  {
+    compute_command_buffer = g_command_buffer_mgr->GetCurrentComputeCommandBuffer();
+    async_texture->pending_fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+    decoding_texture = async_texture->texture.get();
+    BeginAsyncComputeWrite(compute_command_buffer, decoding_texture);
+  }
+  else
+  {
+    if (from_tmem)
+      UpdateTmemBuffer(command_buffer);
+    decoding_texture->TransitionToLayout(command_buffer, Texture2D::ComputeImageLayout::WriteOnly);
+  }
 
   // Dispatch compute to temporary texture.
-  ComputeShaderDispatcher dispatcher(command_buffer,
+  ComputeShaderDispatcher dispatcher(compute_command_buffer,
     g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_COMPUTE),
     iter->second.compute_shader);
-  m_decoding_texture->TransitionToLayout(command_buffer, Texture2D::ComputeImageLayout::WriteOnly);
   dispatcher.SetPushConstants(&constants, sizeof(constants));
-  dispatcher.SetStorageImage(m_decoding_texture->GetView(), m_decoding_texture->GetLayout());
+  dispatcher.SetStorageImage(decoding_texture->GetView(), decoding_texture->GetLayout());
   dispatcher.SetTexelBuffer(0, data_view);
   if (has_palette)
-    dispatcher.SetTexelBuffer(1, m_texel_buffer_view_r16_uint);
+    dispatcher.SetTexelBuffer(1, palette_view);
   auto groups = TextureConversionShader::GetDispatchCount(iter->second.base_info, aligned_width, aligned_height);
   dispatcher.Dispatch(groups.first, groups.second, 1);
 
   // Copy from temporary texture to final destination.
-  m_decoding_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  if (async_texture)
+    EndAsyncComputeWrite(compute_command_buffer, command_buffer, decoding_texture);
+  else
+    decoding_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
   static_cast<VKTexture*>(dst)->GetRawTexIdentifier()->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
   VkImageCopy image_copy = { { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
   { 0, 0, 0 },
   { VK_IMAGE_ASPECT_COLOR_BIT, dst_level, 0, 1 },
   { 0, 0, 0 },
   { width, height, 1 } };
-  vkCmdCopyImage(command_buffer, m_decoding_texture->GetImage(),
+  vkCmdCopyImage(command_buffer, decoding_texture->GetImage(),
     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, static_cast<VKTexture*>(dst)->GetRawTexIdentifier()->GetImage(),
     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
   // Texture should always be in SHADER_READ_ONLY layout prior to use.
@@ -533,6 +747,115 @@ bool TextureConverter::DecodeTexture(HostTexture* dst, u32 dst_level,
   return true;
 }
 
+bool TextureConverter::SupportsTextureScaling(int type, int factor)
+{
+  auto key = std::make_pair(type, factor);
+  auto iter = m_scaling_shaders.find(key);
+  if (iter != m_scaling_shaders.end())
+    return iter->second != VK_NULL_HANDLE;
+
+  VkShaderModule compute_shader = VK_NULL_HANDLE;
+  std::string shader_source =
+    TextureScalerShader::GenerateScalingShader(type, factor, API_TYPE::API_VULKAN);
+  if (!shader_source.empty())
+    compute_shader = Util::CompileAndCreateComputeShader(shader_source);
+
+  m_scaling_shaders.emplace(key, compute_shader);
+  return compute_shader != VK_NULL_HANDLE;
+}
+
+bool TextureConverter::ScaleTexture(HostTexture* dst, u32 dst_level, const u8* data, u32 width,
+  u32 height, u32 row_length, int type, int factor)
+{
+  auto iter = m_scaling_shaders.find(std::make_pair(type, factor));
+  if (iter == m_scaling_shaders.end() || iter->second == VK_NULL_HANDLE)
+    return false;
+
+  const u32 dst_width = width * factor;
+  const u32 dst_height = height * factor;
+  if (dst_width > SCALING_TEXTURE_SIZE || dst_height > SCALING_TEXTURE_SIZE)
+    return false;
+  if (!m_scaling_texture && !CreateScalingTexture())
+    return false;
+
+  struct PushConstants
+  {
+    u32 dst_size[2];
+    u32 src_size[2];
+    u32 src_offset;
+  };
+
+  // The shader reads the pixels in pairs, so the data has to be aligned to one.
+  const u32 bytes_per_buffer_elem = TextureConversionShader::GetBytesPerBufferElement(
+    TextureConversionShader::BUFFER_FORMAT_R32G32_UINT);
+  const u32 data_size = row_length * height * sizeof(u32);
+  AsyncComputeTexture* async_texture =
+    m_async_texel_buffer ? GetAsyncComputeTexture(dst_width, dst_height) : nullptr;
+  StreamBuffer* texel_buffer = async_texture ? m_async_texel_buffer.get() : m_texel_buffer.get();
+  if (!texel_buffer->ReserveMemory(data_size, bytes_per_buffer_elem))
+  {
+    Util::ExecuteCurrentCommandsAndRestoreState(true, false);
+    if (!texel_buffer->ReserveMemory(data_size, bytes_per_buffer_elem))
+    {
+      WARN_LOG(VIDEO, "Failed to reserve memory for texture scaling upload");
+      return false;
+    }
+  }
+
+  u32 texel_buffer_offset = static_cast<u32>(texel_buffer->GetCurrentOffset());
+  std::memcpy(texel_buffer->GetCurrentHostPointer(), data, data_size);
+  texel_buffer->CommitMemory(data_size);
+
+  PushConstants constants = {
+      { dst_width, dst_height },
+      { row_length, height },
+      texel_buffer_offset / static_cast<u32>(sizeof(u32)) };
+
+  // Same as decoding, dispatch in the init command buffer and copy to the destination from there.
+  VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentInitCommandBuffer();
+  VkCommandBuffer compute_command_buffer = command_buffer;
+  Texture2D* scaling_texture = m_scaling_texture.get();
+  VkBufferView data_view = m_texel_buffer_view_r32g32_uint;
+  if (async_texture)
+  {
+    compute_command_buffer = g_command_buffer_mgr->GetCurrentComputeCommandBuffer();
+    async_texture->pending_fence = g_command_buffer_mgr->GetCurrentCommandBufferFence();
+    scaling_texture = async_texture->texture.get();
+    data_view = m_async_texel_buffer_views[TextureConversionShader::BUFFER_FORMAT_R32G32_UINT];
+    BeginAsyncComputeWrite(compute_command_buffer, scaling_texture);
+  }
+  else
+  {
+    scaling_texture->TransitionToLayout(command_buffer, Texture2D::ComputeImageLayout::WriteOnly);
+  }
+
+  ComputeShaderDispatcher dispatcher(compute_command_buffer,
+    g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_COMPUTE),
+    iter->second);
+  dispatcher.SetPushConstants(&constants, sizeof(constants));
+  dispatcher.SetStorageImage(scaling_texture->GetView(), scaling_texture->GetLayout());
+  dispatcher.SetTexelBuffer(0, data_view);
+  auto groups = TextureScalerShader::GetDispatchCount(dst_width, dst_height);
+  dispatcher.Dispatch(groups.first, groups.second, 1);
+
+  Texture2D* dst_texture = static_cast<VKTexture*>(dst)->GetRawTexIdentifier();
+  if (async_texture)
+    EndAsyncComputeWrite(compute_command_buffer, command_buffer, scaling_texture);
+  else
+    scaling_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  dst_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  VkImageCopy image_copy = { { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 },
+  { 0, 0, 0 },
+  { VK_IMAGE_ASPECT_COLOR_BIT, dst_level, 0, 1 },
+  { 0, 0, 0 },
+  { dst_width, dst_height, 1 } };
+  vkCmdCopyImage(command_buffer, scaling_texture->GetImage(),
+    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst_texture->GetImage(),
+    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &image_copy);
+  dst_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  return true;
+}
+
 bool TextureConverter::CreateTexelBuffer()
 {
   // Prefer an 8MB buffer if possible, but use less if the device doesn't support this.
@@ -548,27 +871,33 @@ bool TextureConverter::CreateTexelBuffer()
     return false;
 
   // Create views of the formats that we will be using.
-  m_texel_buffer_view_r8_uint = CreateTexelBufferView(VK_FORMAT_R8_UINT);
-  m_texel_buffer_view_r16_uint = CreateTexelBufferView(VK_FORMAT_R16_UINT);
-  m_texel_buffer_view_r32g32_uint = CreateTexelBufferView(VK_FORMAT_R32G32_UINT);
-  m_texel_buffer_view_rgba8_unorm = CreateTexelBufferView(VK_FORMAT_R8G8B8A8_UNORM);
+  VkBuffer buffer = m_texel_buffer->GetBuffer();
+  m_texel_buffer_view_r8_uint =
+    CreateTexelBufferView(buffer, m_texel_buffer_size, VK_FORMAT_R8_UINT);
+  m_texel_buffer_view_r16_uint =
+    CreateTexelBufferView(buffer, m_texel_buffer_size, VK_FORMAT_R16_UINT);
+  m_texel_buffer_view_r32g32_uint =
+    CreateTexelBufferView(buffer, m_texel_buffer_size, VK_FORMAT_R32G32_UINT);
+  m_texel_buffer_view_rgba8_unorm =
+    CreateTexelBufferView(buffer, m_texel_buffer_size, VK_FORMAT_R8G8B8A8_UNORM);
   return m_texel_buffer_view_r8_uint != VK_NULL_HANDLE &&
     m_texel_buffer_view_r16_uint != VK_NULL_HANDLE &&
     m_texel_buffer_view_r32g32_uint != VK_NULL_HANDLE &&
     m_texel_buffer_view_rgba8_unorm != VK_NULL_HANDLE;
 }
 
-VkBufferView TextureConverter::CreateTexelBufferView(VkFormat format) const
+VkBufferView TextureConverter::CreateTexelBufferView(VkBuffer buffer, VkDeviceSize range,
+  VkFormat format) const
 {
   // Create a view of the whole buffer, we'll offset our texel load into it
   VkBufferViewCreateInfo view_info = {
       VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO,  // VkStructureType            sType
       nullptr,                                    // const void*                pNext
       0,                                          // VkBufferViewCreateFlags    flags
-      m_texel_buffer->GetBuffer(),                // VkBuffer                   buffer
+      buffer,                                     // VkBuffer                   buffer
       format,                                     // VkFormat                   format
       0,                                          // VkDeviceSize               offset
-      m_texel_buffer_size                         // VkDeviceSize               range
+      range                                       // VkDeviceSize               range
   };
 
   VkBufferView view;
@@ -582,6 +911,119 @@ VkBufferView TextureConverter::CreateTexelBufferView(VkFormat format) const
   return view;
 }
 
+bool TextureConverter::CreateTmemBuffer()
+{
+  if (g_vulkan_context->GetDeviceLimits().maxTexelBufferElements < TMEM_SIZE)
+    return false;
+
+  VkBufferCreateInfo info = {
+      VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,  // VkStructureType        sType
+      nullptr,                               // const void*            pNext
+      0,                                     // VkBufferCreateFlags    flags
+      TMEM_SIZE,                             // VkDeviceSize           size
+      VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT |
+          VK_BUFFER_USAGE_TRANSFER_DST_BIT,  // VkBufferUsageFlags     usage
+      VK_SHARING_MODE_EXCLUSIVE,             // VkSharingMode          sharingMode
+      0,                                     // uint32_t               queueFamilyIndexCount
+      nullptr                                // const uint32_t*        pQueueFamilyIndices
+  };
+  VkResult res = vkCreateBuffer(g_vulkan_context->GetDevice(), &info, nullptr, &m_tmem_buffer);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateBuffer failed: ");
+    m_tmem_buffer = VK_NULL_HANDLE;
+    return false;
+  }
+
+  VkMemoryRequirements memory_requirements;
+  vkGetBufferMemoryRequirements(g_vulkan_context->GetDevice(), m_tmem_buffer,
+    &memory_requirements);
+  VkMemoryAllocateInfo memory_allocate_info = {
+      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,  // VkStructureType    sType
+      nullptr,                                 // const void*        pNext
+      memory_requirements.size,                // VkDeviceSize       allocationSize
+      g_vulkan_context->GetMemoryType(memory_requirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)   // uint32_t           memoryTypeIndex
+  };
+  res = vkAllocateMemory(g_vulkan_context->GetDevice(), &memory_allocate_info, nullptr,
+    &m_tmem_buffer_memory);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+    m_tmem_buffer_memory = VK_NULL_HANDLE;
+    DestroyTmemBuffer();
+    return false;
+  }
+
+  res = vkBindBufferMemory(g_vulkan_context->GetDevice(), m_tmem_buffer, m_tmem_buffer_memory, 0);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkBindBufferMemory failed: ");
+    DestroyTmemBuffer();
+    return false;
+  }
+
+  static const VkFormat view_formats[TextureConversionShader::BUFFER_FORMAT_COUNT] = {
+      VK_FORMAT_R8_UINT,      // BUFFER_FORMAT_R8_UINT
+      VK_FORMAT_R16_UINT,     // BUFFER_FORMAT_R16_UINT
+      VK_FORMAT_R32G32_UINT,  // BUFFER_FORMAT_R32G32_UINT
+  };
+  for (size_t i = 0; i < TextureConversionShader::BUFFER_FORMAT_COUNT; i++)
+  {
+    m_tmem_buffer_views[i] = CreateTexelBufferView(m_tmem_buffer, TMEM_SIZE, view_formats[i]);
+    if (m_tmem_buffer_views[i] == VK_NULL_HANDLE)
+    {
+      DestroyTmemBuffer();
+      return false;
+    }
+  }
+
+  // The buffer starts out undefined, the first decode from it copies all of TMEM.
+  TmemMirror::InvalidateAll();
+  return true;
+}
+
+void TextureConverter::DestroyTmemBuffer()
+{
+  for (VkBufferView& view : m_tmem_buffer_views)
+  {
+    if (view != VK_NULL_HANDLE)
+      vkDestroyBufferView(g_vulkan_context->GetDevice(), view, nullptr);
+    view = VK_NULL_HANDLE;
+  }
+  if (m_tmem_buffer != VK_NULL_HANDLE)
+    vkDestroyBuffer(g_vulkan_context->GetDevice(), m_tmem_buffer, nullptr);
+  m_tmem_buffer = VK_NULL_HANDLE;
+  if (m_tmem_buffer_memory != VK_NULL_HANDLE)
+    vkFreeMemory(g_vulkan_context->GetDevice(), m_tmem_buffer_memory, nullptr);
+  m_tmem_buffer_memory = VK_NULL_HANDLE;
+}
+
+void TextureConverter::UpdateTmemBuffer(VkCommandBuffer command_buffer)
+{
+  u32 address, size;
+  if (!TmemMirror::PopInvalidRange(&address, &size))
+    return;
+
+  // Earlier decodes may still be reading the parts that change.
+  Util::BufferMemoryBarrier(command_buffer, m_tmem_buffer, VK_ACCESS_SHADER_READ_BIT,
+    VK_ACCESS_TRANSFER_WRITE_BIT, 0, VK_WHOLE_SIZE,
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+  do
+  {
+    // vkCmdUpdateBuffer takes at most 64KB at a time.
+    for (u32 done = 0; done < size; done += 65536)
+    {
+      const u32 chunk = std::min(size - done, 65536u);
+      vkCmdUpdateBuffer(command_buffer, m_tmem_buffer, address + done, chunk,
+        texMem + address + done);
+    }
+  } while (TmemMirror::PopInvalidRange(&address, &size));
+  Util::BufferMemoryBarrier(command_buffer, m_tmem_buffer, VK_ACCESS_TRANSFER_WRITE_BIT,
+    VK_ACCESS_SHADER_READ_BIT, 0, VK_WHOLE_SIZE, VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+}
+
 bool TextureConverter::CompilePaletteConversionShaders()
 {
   static const char PALETTE_CONVERSION_FRAGMENT_SHADER_SOURCE[] = R"(
@@ -768,6 +1210,77 @@ bool TextureConverter::CreateDecodingTexture()
   return static_cast<bool>(m_decoding_texture);
 }
 
+bool TextureConverter::CreateScalingTexture()
+{
+  m_scaling_texture = Texture2D::Create(
+    SCALING_TEXTURE_SIZE, SCALING_TEXTURE_SIZE, 1, 1, VK_FORMAT_R8G8B8A8_UNORM,
+    VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_TILING_OPTIMAL,
+    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+  return static_cast<bool>(m_scaling_texture);
+}
+
+bool TextureConverter::CreateAsyncComputeTexelBuffer()
+{
+  m_async_texel_buffer = StreamBuffer::Create(VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT,
+    m_texel_buffer_size, m_texel_buffer_size);
+  if (!m_async_texel_buffer)
+    return false;
+
+  static const VkFormat view_formats[TextureConversionShader::BUFFER_FORMAT_COUNT] = {
+      VK_FORMAT_R8_UINT,      // BUFFER_FORMAT_R8_UINT
+      VK_FORMAT_R16_UINT,     // BUFFER_FORMAT_R16_UINT
+      VK_FORMAT_R32G32_UINT,  // BUFFER_FORMAT_R32G32_UINT
+  };
+  for (size_t i = 0; i < TextureConversionShader::BUFFER_FORMAT_COUNT; i++)
+  {
+    m_async_texel_buffer_views[i] = CreateTexelBufferView(m_async_texel_buffer->GetBuffer(),
+      m_texel_buffer_size, view_formats[i]);
+    if (m_async_texel_buffer_views[i] == VK_NULL_HANDLE)
+    {
+      // Decode everything on the graphics queue instead.
+      m_async_texel_buffer.reset();
+      return false;
+    }
+  }
+  return true;
+}
+
+TextureConverter::AsyncComputeTexture* TextureConverter::GetAsyncComputeTexture(u32 width,
+  u32 height)
+{
+  AsyncComputeTexture* replaceable = nullptr;
+  for (AsyncComputeTexture& entry : m_async_compute_textures)
+  {
+    if (entry.pending_fence != VK_NULL_HANDLE)
+      continue;
+    if (entry.texture->GetWidth() >= width && entry.texture->GetHeight() >= height)
+      return &entry;
+    replaceable = &entry;
+  }
+
+  if (!replaceable)
+  {
+    if (m_async_compute_textures.size() >= MAX_ASYNC_COMPUTE_TEXTURES)
+      return nullptr;
+    m_async_compute_textures.push_back({});
+    replaceable = &m_async_compute_textures.back();
+  }
+
+  // Sizes are rounded up so the textures can be reused for textures of similar sizes.
+  replaceable->texture = Texture2D::Create(
+    Common::AlignUp(width, 256), Common::AlignUp(height, 256), 1, 1, VK_FORMAT_R8G8B8A8_UNORM,
+    VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_TILING_OPTIMAL,
+    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+  replaceable->pending_fence = VK_NULL_HANDLE;
+  if (!replaceable->texture)
+  {
+    m_async_compute_textures.erase(m_async_compute_textures.begin() +
+      (replaceable - m_async_compute_textures.data()));
+    return nullptr;
+  }
+  return replaceable;
+}
+
 bool TextureConverter::CompileYUYVConversionShaders()
 {
   static const char RGB_TO_YUYV_SHADER_SOURCE[] = R"(
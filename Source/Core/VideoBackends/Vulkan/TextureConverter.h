@@ -5,9 +5,11 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StreamBuffer.h"
@@ -41,6 +43,15 @@ public:
     u32 memory_stride, bool is_depth_copy, const EFBRectangle& src_rect,
     bool scale_by_half);
 
+  // Like EncodeTextureToMemory, but leaves the encoded copy in a staging texture without
+  // executing the command buffer. Returns the id to read it back with, 0 on failure.
+  u64 EncodeTextureToMemoryDeferred(VkImageView src_texture, u8* dest_ptr,
+    const EFBCopyFormat& format, u32 native_width, u32 bytes_per_row, u32 num_blocks_y,
+    u32 memory_stride, bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half);
+  // Writes the deferred copies up to and including id to guest memory, in the order they were
+  // encoded. Waits for the command buffers they are in.
+  void ReadbackDeferredCopies(u64 id);
+
   // Encodes texture to guest memory in XFB (YUYV) format.
   void EncodeTextureToMemoryYUYV(void* dst_ptr, u32 dst_width, u32 dst_stride, u32 dst_height,
     Texture2D* src_texture, const MathUtil::Rectangle<int>& src_rect);
@@ -55,6 +66,10 @@ public:
     u32 aligned_width, u32 aligned_height, u32 row_stride, const u8* palette,
     TlutFormat palette_format);
 
+  bool SupportsTextureScaling(int type, int factor);
+  bool ScaleTexture(HostTexture* dst, u32 dst_level, const u8* data, u32 width, u32 height,
+    u32 row_length, int type, int factor);
+
 private:
   static const u32 ENCODING_TEXTURE_WIDTH = EFB_WIDTH * 4;
   static const u32 ENCODING_TEXTURE_HEIGHT = 1024;
@@ -65,8 +80,16 @@ private:
   static const u32 DECODING_TEXTURE_WIDTH = 1024;
   static const u32 DECODING_TEXTURE_HEIGHT = 1024;
 
+  // The texture cache only scales textures smaller than 384x384, by up to 5x.
+  static const u32 SCALING_TEXTURE_SIZE = 2048;
+
   bool CreateTexelBuffer();
-  VkBufferView CreateTexelBufferView(VkFormat format) const;
+  VkBufferView CreateTexelBufferView(VkBuffer buffer, VkDeviceSize range, VkFormat format) const;
+
+  bool CreateTmemBuffer();
+  void DestroyTmemBuffer();
+  // Copies the parts of TMEM written since the last decode from it.
+  void UpdateTmemBuffer(VkCommandBuffer command_buffer);
 
   bool CompilePaletteConversionShaders();
 
@@ -75,8 +98,20 @@ private:
   bool CreateEncodingRenderPass();
   bool CreateEncodingTexture();
   bool CreateEncodingDownloadTexture();
+  // Draws the encoded copy to m_encoding_render_texture and leaves it as a transfer source.
+  bool EncodeTexture(VkImageView src_texture, const EFBCopyFormat& format, u32 native_width,
+    u32 render_width, u32 render_height, bool is_depth_copy, const EFBRectangle& src_rect,
+    bool scale_by_half);
+  void OnCommandBufferExecuted(VkFence fence);
 
   bool CreateDecodingTexture();
+  bool CreateScalingTexture();
+
+  bool CreateAsyncComputeTexelBuffer();
+  // Returns a texture of at least the given size for the async compute queue, null if too many
+  // are in use. Set pending_fence once the work is recorded.
+  struct AsyncComputeTexture;
+  AsyncComputeTexture* GetAsyncComputeTexture(u32 width, u32 height);
 
   bool CompileYUYVConversionShaders();
 
@@ -108,6 +143,23 @@ private:
   std::unique_ptr<Texture2D> m_encoding_render_texture;
   std::unique_ptr<StagingTexture2D> m_encoding_download_texture;
 
+  // EFB copies waiting in a staging texture for their readback.
+  struct DeferredCopy
+  {
+    u64 id;
+    std::unique_ptr<StagingTexture2D> texture;
+    u8* dest_ptr;
+    u32 width;
+    u32 height;
+    u32 memory_stride;
+    // The fence of the command buffer the copy was recorded to, until it executed.
+    VkFence pending_fence;
+  };
+  std::deque<DeferredCopy> m_deferred_copies;
+  // Staging textures of read back copies, for the next ones.
+  std::vector<std::unique_ptr<StagingTexture2D>> m_free_deferred_copy_textures;
+  u64 m_next_deferred_copy_id = 1;
+
   // Texture decoding - GX format in memory->RGBA8
   struct TextureDecodingPipeline
   {
@@ -118,6 +170,30 @@ private:
   std::map<std::pair<TextureFormat, TlutFormat>, TextureDecodingPipeline> m_decoding_pipelines;
   std::unique_ptr<Texture2D> m_decoding_texture;
 
+  // A copy of TMEM, textures preloaded into it are decoded from there without uploading them.
+  VkBuffer m_tmem_buffer = VK_NULL_HANDLE;
+  VkDeviceMemory m_tmem_buffer_memory = VK_NULL_HANDLE;
+  std::array<VkBufferView, TextureConversionShader::BUFFER_FORMAT_COUNT> m_tmem_buffer_views = {};
+
+  // Texture scaling - decoded RGBA8 texture->scaled RGBA8 texture, created on first use
+  std::map<std::pair<int, int>, VkShaderModule> m_scaling_shaders;
+  std::unique_ptr<Texture2D> m_scaling_texture;
+
+  // Decoding and scaling on the async compute queue. The compute queue has a texel buffer of its
+  // own and writes to textures that are only copied to the destination on the graphics queue, so
+  // nothing else changes queues.
+  static const size_t MAX_ASYNC_COMPUTE_TEXTURES = 32;
+  struct AsyncComputeTexture
+  {
+    std::unique_ptr<Texture2D> texture;
+    // The fence of the command buffer the texture is used in, until it executed.
+    VkFence pending_fence;
+  };
+  std::unique_ptr<StreamBuffer> m_async_texel_buffer;
+  std::array<VkBufferView, TextureConversionShader::BUFFER_FORMAT_COUNT>
+    m_async_texel_buffer_views = {};
+  std::vector<AsyncComputeTexture> m_async_compute_textures;
+
   // XFB encoding/decoding shaders
   VkShaderModule m_rgb_to_yuyv_shader = VK_NULL_HANDLE;
   VkShaderModule m_yuyv_to_rgb_shader = VK_NULL_HANDLE;
@@ -824,6 +824,11 @@ void ComputeShaderDispatcher::SetTexelBuffer(size_t index, VkBufferView view)
   m_texel_buffers[index] = view;
 }
 
+void ComputeShaderDispatcher::SetStorageTexelBuffer(VkBufferView view)
+{
+  m_storage_texel_buffer = view;
+}
+
 void ComputeShaderDispatcher::Dispatch(u32 groups_x, u32 groups_y, u32 groups_z)
 {
   BindDescriptors();
@@ -844,7 +849,7 @@ void ComputeShaderDispatcher::BindDescriptors()
   }
 
   // Reserve enough descriptors to write every binding.
-  std::array<VkWriteDescriptorSet, 7> set_writes = {};
+  std::array<VkWriteDescriptorSet, 9> set_writes = {};
   u32 num_set_writes = 0;
 
   if (m_uniform_buffer.buffer != VK_NULL_HANDLE)
@@ -897,6 +902,13 @@ void ComputeShaderDispatcher::BindDescriptors()
       VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,       &m_storage_image, nullptr, nullptr };
   }
 
+  if (m_storage_texel_buffer != VK_NULL_HANDLE)
+  {
+    set_writes[num_set_writes++] = {
+      VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set,     8, 0, 1,
+      VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, nullptr, nullptr, &m_storage_texel_buffer };
+  }
+
   if (num_set_writes > 0)
   {
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), num_set_writes, set_writes.data(), 0,
@@ -212,6 +212,8 @@ public:
 
   void SetStorageImage(VkImageView view, VkImageLayout image_layout);
 
+  void SetStorageTexelBuffer(VkBufferView view);
+
   void Dispatch(u32 groups_x, u32 groups_y, u32 groups_z);
 
 private:
@@ -229,6 +231,8 @@ private:
 
   VkDescriptorImageInfo m_storage_image = {};
 
+  VkBufferView m_storage_texel_buffer = VK_NULL_HANDLE;
+
   ComputePipelineInfo m_pipeline_info = {};
 };
 
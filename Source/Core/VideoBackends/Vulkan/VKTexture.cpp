@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <vector>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
@@ -17,12 +18,14 @@
 #include "VideoBackends/Vulkan/StagingTexture2D.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
 #include "VideoBackends/Vulkan/Texture2D.h"
+#include "VideoBackends/Vulkan/TextureCache.h"
 #include "VideoBackends/Vulkan/Util.h"
 #include "VideoBackends/Vulkan/VKTexture.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/TextureConfig.h"
+#include "VideoCommon/TextureUtil.h"
 
 namespace Vulkan
 {
@@ -70,6 +73,11 @@ VKTexture::~VKTexture()
 {
   // Texture is automatically cleaned up, however, we don't want to leave it bound.
   StateTracker::GetInstance()->UnbindTexture(m_texture->GetView());
+
+  // Nor leave an EFB copy to it waiting. The texture cache is already gone at shutdown.
+  TextureCache* texture_cache = TextureCache::GetInstance();
+  if (texture_cache && texture_cache->IsPendingTextureCopyDestination(m_texture->GetView()))
+    StateTracker::GetInstance()->EndRenderPass();
 }
 
 Texture2D* VKTexture::GetRawTexIdentifier() const
@@ -108,10 +116,11 @@ bool VKTexture::Save(const std::string& filename, u32 level)
     STAGING_BUFFER_TYPE_READBACK, level_width, level_height, TEXTURECACHE_TEXTURE_FORMAT);
 
   // Transition image to transfer source, and invalidate the current state,
-  // since we'll be executing the command buffer.
+  // since we'll be executing the command buffer. Ending the render pass first runs any EFB copy
+  // to this texture that is still waiting for it.
+  StateTracker::GetInstance()->EndRenderPass();
   m_texture->TransitionToLayout(g_command_buffer_mgr->GetCurrentCommandBuffer(),
     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-  StateTracker::GetInstance()->EndRenderPass();
 
   // Copy to download buffer.
   staging_texture->CopyFromImage(g_command_buffer_mgr->GetCurrentCommandBuffer(),
@@ -373,4 +382,79 @@ void VKTexture::Load(const u8* src, u32 width, u32 height, u32 expanded_width, u
   }
 }
 
+bool VKTexture::GenerateMipmaps()
+{
+  if (m_texture->GetFormat() != VK_FORMAT_R8G8B8A8_UNORM || m_config.enviroment)
+    return false;
+
+  // The levels are generated in an sRGB copy, which blits them in linear space.
+  std::unique_ptr<Texture2D> srgb_texture = Texture2D::Create(
+      m_config.width, m_config.height, m_config.levels, m_config.layers, VK_FORMAT_R8G8B8A8_SRGB,
+      VK_SAMPLE_COUNT_1_BIT, VK_IMAGE_VIEW_TYPE_2D_ARRAY, VK_IMAGE_TILING_OPTIMAL,
+      VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+          VK_IMAGE_USAGE_SAMPLED_BIT);
+  if (!srgb_texture)
+    return false;
+
+  // Recorded after the upload of level 0, in the same command buffer.
+  VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentInitCommandBuffer();
+  m_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  srgb_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  const VkImageCopy base_copy = {
+      {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, m_config.layers},
+      {0, 0, 0},
+      {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, m_config.layers},
+      {0, 0, 0},
+      {m_config.width, m_config.height, 1}};
+  vkCmdCopyImage(command_buffer, m_texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 srgb_texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &base_copy);
+
+  // Each level is read once the one before it is written, so they change layout one at a time.
+  VkImageMemoryBarrier barrier = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+                                  nullptr,
+                                  VK_ACCESS_TRANSFER_WRITE_BIT,
+                                  VK_ACCESS_TRANSFER_READ_BIT,
+                                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                  VK_QUEUE_FAMILY_IGNORED,
+                                  VK_QUEUE_FAMILY_IGNORED,
+                                  srgb_texture->GetImage(),
+                                  {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, m_config.layers}};
+  std::vector<VkImageCopy> level_copies;
+  for (u32 level = 1; level <= m_config.levels; level++)
+  {
+    barrier.subresourceRange.baseMipLevel = level - 1;
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    if (level == m_config.levels)
+      break;
+
+    const u32 src_width = TextureUtil::CalculateLevelSize(m_config.width, level - 1);
+    const u32 src_height = TextureUtil::CalculateLevelSize(m_config.height, level - 1);
+    const u32 width = TextureUtil::CalculateLevelSize(m_config.width, level);
+    const u32 height = TextureUtil::CalculateLevelSize(m_config.height, level);
+    const VkImageBlit blit = {
+        {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, m_config.layers},
+        {{0, 0, 0}, {static_cast<s32>(src_width), static_cast<s32>(src_height), 1}},
+        {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, m_config.layers},
+        {{0, 0, 0}, {static_cast<s32>(width), static_cast<s32>(height), 1}}};
+    vkCmdBlitImage(command_buffer, srgb_texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   srgb_texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit,
+                   VK_FILTER_LINEAR);
+    level_copies.push_back({{VK_IMAGE_ASPECT_COLOR_BIT, level, 0, m_config.layers},
+                            {0, 0, 0},
+                            {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, m_config.layers},
+                            {0, 0, 0},
+                            {width, height, 1}});
+  }
+  srgb_texture->OverrideImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+  // Like after Load, the texture is left ready for further uploads.
+  m_texture->TransitionToLayout(command_buffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  vkCmdCopyImage(command_buffer, srgb_texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 m_texture->GetImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                 static_cast<u32>(level_copies.size()), level_copies.data());
+  return true;
+}
+
 }  // namespace Vulkan
@@ -28,6 +28,7 @@ public:
   void CopyRectangleFromTexture(Texture2D* source, const MathUtil::Rectangle<int>& srcrect,
     const MathUtil::Rectangle<int>& dstrect);
   void Load(const u8* src, u32 width, u32 height, u32 expanded_width, u32 level, u32 layer) override;
+  bool GenerateMipmaps() override;
 
   Texture2D* GetRawTexIdentifier() const;
   VkFramebuffer GetFramebuffer() const;
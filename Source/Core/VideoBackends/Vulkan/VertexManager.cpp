@@ -2,12 +2,14 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
 
 #include "VideoBackends/Vulkan/VertexManager.h"
 #include "VideoBackends/Vulkan/BoundingBox.h"
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
 #include "VideoBackends/Vulkan/FramebufferManager.h"
+#include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/PerfQuery.h"
 #include "VideoBackends/Vulkan/Renderer.h"
 #include "VideoBackends/Vulkan/StateTracker.h"
@@ -17,6 +19,7 @@
 #include "VideoBackends/Vulkan/VulkanContext.h"
 
 #include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/GPUVertexDecoder.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -25,10 +28,13 @@
 namespace Vulkan
 {
 // TODO: Clean up this mess
-constexpr size_t INITIAL_VERTEX_BUFFER_SIZE = VertexManager::MAXVBUFFERSIZE * 2;
+// Every batch reserves MAXVBUFFERSIZE and MAXIBUFFERSIZE up front, so the buffers start out
+// holding a few of those, the same as the OGL rings, instead of growing in the first frames.
+constexpr size_t INITIAL_VERTEX_BUFFER_SIZE = VertexManager::MAXVBUFFERSIZE * 4;
 constexpr size_t MAX_VERTEX_BUFFER_SIZE = VertexManager::MAXVBUFFERSIZE * 16;
-constexpr size_t INITIAL_INDEX_BUFFER_SIZE = VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 2;
+constexpr size_t INITIAL_INDEX_BUFFER_SIZE = VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 8;
 constexpr size_t MAX_INDEX_BUFFER_SIZE = VertexManager::MAXIBUFFERSIZE * sizeof(u16) * 16;
+constexpr size_t GPU_DECODER_BUFFER_SIZE = 32 * 1024 * 1024;
 
 VertexManager::VertexManager()
   : m_cpu_vertex_buffer(MAXVBUFFERSIZE), m_cpu_index_buffer(MAXIBUFFERSIZE)
@@ -37,6 +43,15 @@ VertexManager::VertexManager()
 
 VertexManager::~VertexManager()
 {
+  for (const auto& it : m_gpu_decoder_shaders)
+  {
+    if (it.second.compute_shader != VK_NULL_HANDLE)
+      vkDestroyShaderModule(g_vulkan_context->GetDevice(), it.second.compute_shader, nullptr);
+  }
+  if (m_gpu_decoder_input_view != VK_NULL_HANDLE)
+    vkDestroyBufferView(g_vulkan_context->GetDevice(), m_gpu_decoder_input_view, nullptr);
+  if (m_gpu_decoder_output_view != VK_NULL_HANDLE)
+    vkDestroyBufferView(g_vulkan_context->GetDevice(), m_gpu_decoder_output_view, nullptr);
 }
 
 VertexManager* VertexManager::GetInstance()
@@ -46,7 +61,8 @@ VertexManager* VertexManager::GetInstance()
 
 bool VertexManager::Initialize()
 {
-  m_vertex_stream_buffer = StreamBuffer::Create(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+  m_vertex_stream_buffer = StreamBuffer::Create(
+    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT,
     INITIAL_VERTEX_BUFFER_SIZE, MAX_VERTEX_BUFFER_SIZE);
 
   m_index_stream_buffer = StreamBuffer::Create(VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
@@ -58,6 +74,126 @@ bool VertexManager::Initialize()
     return false;
   }
 
+  // Not fatal, all vertices are converted on the CPU without it.
+  if (!CreateGPUDecoderBuffer())
+  {
+    WARN_LOG(VIDEO, "GPU vertex decoding is not available");
+    m_gpu_decoder_buffer.reset();
+  }
+
+  return true;
+}
+
+bool VertexManager::CreateGPUDecoderBuffer()
+{
+  // The output view has to be able to cover the vertex buffer at its largest.
+  const size_t max_texel_buffer_elements =
+    static_cast<size_t>(g_vulkan_context->GetDeviceLimits().maxTexelBufferElements);
+  if (MAX_VERTEX_BUFFER_SIZE / sizeof(u32) > max_texel_buffer_elements)
+    return false;
+
+  m_gpu_decoder_buffer_size = std::min(GPU_DECODER_BUFFER_SIZE, max_texel_buffer_elements);
+  m_gpu_decoder_buffer = StreamBuffer::Create(VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT,
+    m_gpu_decoder_buffer_size, m_gpu_decoder_buffer_size);
+  if (!m_gpu_decoder_buffer)
+    return false;
+
+  // The input is read byte by byte, the shader takes care of unaligned and big endian data.
+  VkBufferViewCreateInfo view_info = {
+      VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO,  // VkStructureType            sType
+      nullptr,                                    // const void*                pNext
+      0,                                          // VkBufferViewCreateFlags    flags
+      m_gpu_decoder_buffer->GetBuffer(),          // VkBuffer                   buffer
+      VK_FORMAT_R8_UINT,                          // VkFormat                   format
+      0,                                          // VkDeviceSize               offset
+      m_gpu_decoder_buffer_size                   // VkDeviceSize               range
+  };
+
+  VkResult res = vkCreateBufferView(g_vulkan_context->GetDevice(), &view_info, nullptr,
+    &m_gpu_decoder_input_view);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateBufferView failed: ");
+    m_gpu_decoder_input_view = VK_NULL_HANDLE;
+    return false;
+  }
+
+  return true;
+}
+
+bool VertexManager::UpdateGPUDecoderOutputView()
+{
+  VkBuffer buffer = m_vertex_stream_buffer->GetBuffer();
+  size_t size = m_vertex_stream_buffer->GetCurrentSize();
+  if (m_gpu_decoder_output_view != VK_NULL_HANDLE && m_gpu_decoder_output_buffer == buffer &&
+    m_gpu_decoder_output_size == size)
+  {
+    return true;
+  }
+
+  // The old buffer can still be in use by commands in flight.
+  if (m_gpu_decoder_output_view != VK_NULL_HANDLE)
+  {
+    g_command_buffer_mgr->DeferBufferViewDestruction(m_gpu_decoder_output_view);
+    m_gpu_decoder_output_view = VK_NULL_HANDLE;
+  }
+
+  VkBufferViewCreateInfo view_info = {
+      VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO,  // VkStructureType            sType
+      nullptr,                                    // const void*                pNext
+      0,                                          // VkBufferViewCreateFlags    flags
+      buffer,                                     // VkBuffer                   buffer
+      VK_FORMAT_R32_UINT,                         // VkFormat                   format
+      0,                                          // VkDeviceSize               offset
+      size                                        // VkDeviceSize               range
+  };
+
+  VkResult res = vkCreateBufferView(g_vulkan_context->GetDevice(), &view_info, nullptr,
+    &m_gpu_decoder_output_view);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateBufferView failed: ");
+    m_gpu_decoder_output_view = VK_NULL_HANDLE;
+    return false;
+  }
+
+  m_gpu_decoder_output_buffer = buffer;
+  m_gpu_decoder_output_size = size;
+  return true;
+}
+
+bool VertexManager::DecodeVerticesOnGPU(VertexLoaderBase* loader,
+                                        const VertexLoaderParameters& parameters)
+{
+  if (!m_gpu_decoder_buffer)
+    return false;
+
+  VertexLoaderUID uid(*parameters.VtxDesc, *parameters.VtxAttr);
+  auto iter = m_gpu_decoder_shaders.find(uid);
+  if (iter == m_gpu_decoder_shaders.end())
+  {
+    // Formats without a shader are remembered too, so that generation isn't retried every draw.
+    GPUDecoderShader shader;
+    shader.format = GPUVertexDecoder::GetFormat(*loader, API_VULKAN);
+    if (!shader.format.shader_source.empty())
+      shader.compute_shader = Util::CompileAndCreateComputeShader(shader.format.shader_source);
+    iter = m_gpu_decoder_shaders.emplace(uid, std::move(shader)).first;
+  }
+  if (iter->second.compute_shader == VK_NULL_HANDLE)
+    return false;
+
+  // Half of the buffer, so that the next batch doesn't have to wait for this one to be consumed.
+  GPUDecodedDraw draw;
+  draw.compute_shader = iter->second.compute_shader;
+  u32 dst_offset =
+    static_cast<u32>((parameters.destination - m_pBaseBufferPointer) / sizeof(u32));
+  if (!GPUVertexDecoder::PrepareDraw(iter->second.format, parameters, dst_offset,
+    m_gpu_decoder_buffer_size / 2, &m_gpu_decoder_data, &draw.constants))
+  {
+    return false;
+  }
+
+  m_gpu_decoded_draws.push_back(draw);
   return true;
 }
 
@@ -71,39 +207,38 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
 {
   size_t vertex_data_size = IndexGenerator::GetNumVerts() * stride;
   size_t index_data_size = IndexGenerator::GetIndexLen() * sizeof(u16);
+  size_t decoder_data_size = m_gpu_decoder_data.size();
 
-  // Attempt to allocate from buffers
-  bool has_vbuffer_allocation = m_vertex_stream_buffer->ReserveMemory(vertex_data_size, stride);
-  bool has_ibuffer_allocation = m_index_stream_buffer->ReserveMemory(index_data_size, sizeof(u16));
-  if (!has_vbuffer_allocation || !has_ibuffer_allocation)
+  if (!m_writing_stream_buffers)
   {
-    // Flush any pending commands first, so that we can wait on the fences
-    WARN_LOG(VIDEO, "Executing command list while waiting for space in vertex/index buffer");
-    Util::ExecuteCurrentCommandsAndRestoreState(false);
-
-    // Attempt to allocate again, this may cause a fence wait
-    if (!has_vbuffer_allocation)
-      has_vbuffer_allocation = m_vertex_stream_buffer->ReserveMemory(vertex_data_size, stride);
-    if (!has_ibuffer_allocation)
-      has_ibuffer_allocation = m_index_stream_buffer->ReserveMemory(index_data_size, sizeof(u16));
-
-    // If we still failed, that means the allocation was too large and will never succeed, so panic
-    if (!has_vbuffer_allocation || !has_ibuffer_allocation)
+    // The batch was written to the CPU buffers.
+    if (!ReserveStreamMemory(vertex_data_size, index_data_size, stride))
       PanicAlert("Failed to allocate space in streaming buffers for pending draw");
+    std::memcpy(m_vertex_stream_buffer->GetCurrentHostPointer(), m_cpu_vertex_buffer.data(), vertex_data_size);
+    std::memcpy(m_index_stream_buffer->GetCurrentHostPointer(), m_cpu_index_buffer.data(), index_data_size);
+    UpdateBaseIndices(stride);
   }
 
-  std::memcpy(m_vertex_stream_buffer->GetCurrentHostPointer(), m_cpu_vertex_buffer.data(), vertex_data_size);
-  std::memcpy(m_index_stream_buffer->GetCurrentHostPointer(), m_cpu_index_buffer.data(), index_data_size);
-
-  // Update base indices
-  m_current_draw_base_vertex =
-    static_cast<u32>(m_vertex_stream_buffer->GetCurrentOffset() / stride);
-  m_current_draw_base_index =
-    static_cast<u32>(m_index_stream_buffer->GetCurrentOffset() / sizeof(u16));
+  if (decoder_data_size > 0 && !m_gpu_decoder_buffer->ReserveMemory(decoder_data_size, sizeof(u32)))
+  {
+    // The batch's vertices are committed after this, with the command buffer that draws them.
+    WARN_LOG(VIDEO, "Executing command list while waiting for space in GPU decoder buffer");
+    Util::ExecuteCurrentCommandsAndRestoreState(false);
+    if (!m_gpu_decoder_buffer->ReserveMemory(decoder_data_size, sizeof(u32)))
+      PanicAlert("Failed to allocate space in streaming buffers for pending draw");
+  }
 
   m_vertex_stream_buffer->CommitMemory(vertex_data_size);
   m_index_stream_buffer->CommitMemory(index_data_size);
 
+  if (decoder_data_size > 0)
+  {
+    std::memcpy(m_gpu_decoder_buffer->GetCurrentHostPointer(), m_gpu_decoder_data.data(),
+      decoder_data_size);
+    m_gpu_decoder_input_offset = static_cast<u32>(m_gpu_decoder_buffer->GetCurrentOffset());
+    m_gpu_decoder_buffer->CommitMemory(decoder_data_size);
+  }
+
   ADDSTAT(stats.thisFrame.bytesVertexStreamed, static_cast<int>(vertex_data_size));
   ADDSTAT(stats.thisFrame.bytesIndexStreamed, static_cast<int>(index_data_size));
 
@@ -111,11 +246,99 @@ void VertexManager::PrepareDrawBuffers(u32 stride)
   StateTracker::GetInstance()->SetIndexBuffer(m_index_stream_buffer->GetBuffer(), 0, VK_INDEX_TYPE_UINT16);
 }
 
+bool VertexManager::ReserveStreamMemory(size_t vertex_size, size_t index_size, u32 stride)
+{
+  // Attempt to allocate from buffers
+  bool has_vbuffer_allocation = m_vertex_stream_buffer->ReserveMemory(vertex_size, stride);
+  bool has_ibuffer_allocation = m_index_stream_buffer->ReserveMemory(index_size, sizeof(u16));
+  if (has_vbuffer_allocation && has_ibuffer_allocation)
+    return true;
+
+  // Flush any pending commands first, so that we can wait on the fences
+  WARN_LOG(VIDEO, "Executing command list while waiting for space in vertex/index buffer");
+  Util::ExecuteCurrentCommandsAndRestoreState(false);
+
+  // Attempt to allocate again, this may cause a fence wait
+  if (!has_vbuffer_allocation)
+    has_vbuffer_allocation = m_vertex_stream_buffer->ReserveMemory(vertex_size, stride);
+  if (!has_ibuffer_allocation)
+    has_ibuffer_allocation = m_index_stream_buffer->ReserveMemory(index_size, sizeof(u16));
+
+  // If we still failed, that means the allocation was too large and will never succeed
+  return has_vbuffer_allocation && has_ibuffer_allocation;
+}
+
+void VertexManager::UpdateBaseIndices(u32 stride)
+{
+  m_current_draw_base_vertex =
+    static_cast<u32>(m_vertex_stream_buffer->GetCurrentOffset() / stride);
+  m_current_draw_base_index =
+    static_cast<u32>(m_index_stream_buffer->GetCurrentOffset() / sizeof(u16));
+}
+
 void VertexManager::ResetBuffer(u32 stride)
 {
-  m_pCurBufferPointer = m_pBaseBufferPointer = m_cpu_vertex_buffer.data();
-  m_pEndBufferPointer = m_pBaseBufferPointer + m_cpu_vertex_buffer.size();
-  IndexGenerator::Start(m_cpu_index_buffer.data());
+  m_gpu_decoded_draws.clear();
+  m_gpu_decoder_data.clear();
+
+  // The vertex loaders and the index generator write straight into the stream buffers, which stay
+  // mapped. Batches that are culled entirely never reach the GPU, they go to the CPU buffers.
+  m_writing_stream_buffers =
+    !m_cull_all && ReserveStreamMemory(MAXVBUFFERSIZE, MAXIBUFFERSIZE * sizeof(u16), stride);
+  if (!m_writing_stream_buffers)
+  {
+    m_pCurBufferPointer = m_pBaseBufferPointer = m_cpu_vertex_buffer.data();
+    m_pEndBufferPointer = m_pBaseBufferPointer + m_cpu_vertex_buffer.size();
+    IndexGenerator::Start(m_cpu_index_buffer.data());
+    return;
+  }
+
+  m_pCurBufferPointer = m_pBaseBufferPointer = m_vertex_stream_buffer->GetCurrentHostPointer();
+  m_pEndBufferPointer = m_pBaseBufferPointer + MAXVBUFFERSIZE;
+  IndexGenerator::Start(reinterpret_cast<u16*>(m_index_stream_buffer->GetCurrentHostPointer()));
+  UpdateBaseIndices(stride);
+}
+
+void VertexManager::DispatchGPUDecodedDraws(u32 stride)
+{
+  if (!UpdateGPUDecoderOutputView())
+  {
+    ERROR_LOG(VIDEO, "Skipped GPU vertex decoding of %zu draws", m_gpu_decoded_draws.size());
+    m_gpu_decoded_draws.clear();
+    m_gpu_decoder_data.clear();
+    return;
+  }
+
+  // Like texture decoding, this goes to the init command buffer, which runs before the draws.
+  VkCommandBuffer command_buffer = g_command_buffer_mgr->GetCurrentInitCommandBuffer();
+  u32 output_base = m_current_draw_base_vertex * stride / sizeof(u32);
+  for (GPUDecodedDraw& draw : m_gpu_decoded_draws)
+  {
+    // The offsets were relative to the batch, now the buffer locations are known.
+    GPUVertexDecoder::Constants& constants = draw.constants;
+    constants.src_offset += m_gpu_decoder_input_offset;
+    constants.dst_offset += output_base;
+    for (u32& array_base : constants.array_base)
+      array_base += m_gpu_decoder_input_offset;
+
+    ComputeShaderDispatcher dispatcher(command_buffer,
+      g_object_cache->GetPipelineLayout(PIPELINE_LAYOUT_COMPUTE), draw.compute_shader);
+    std::memcpy(dispatcher.AllocateUniformBuffer(sizeof(constants)), &constants,
+      sizeof(constants));
+    dispatcher.CommitUniformBuffer(sizeof(constants));
+    dispatcher.SetTexelBuffer(0, m_gpu_decoder_input_view);
+    dispatcher.SetStorageTexelBuffer(m_gpu_decoder_output_view);
+    dispatcher.Dispatch(GPUVertexDecoder::GetDispatchCount(constants.count), 1, 1);
+  }
+
+  Util::BufferMemoryBarrier(command_buffer, m_vertex_stream_buffer->GetBuffer(),
+    VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+    m_current_draw_base_vertex * stride, IndexGenerator::GetNumVerts() * stride,
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+  ADDSTAT(stats.thisFrame.bytesVertexStreamed, static_cast<int>(m_gpu_decoder_data.size()));
+  m_gpu_decoded_draws.clear();
+  m_gpu_decoder_data.clear();
 }
 
 u16* VertexManager::GetIndexBuffer()
@@ -153,9 +376,11 @@ void VertexManager::vFlush(bool use_dst_alpha)
   // the current command buffer to be executed, and we want the buffer space to be associated
   // with the command buffer that has the corresponding draw.
   PrepareDrawBuffers(vertex_stride);
+  if (!m_gpu_decoded_draws.empty())
+    DispatchGPUDecodedDraws(vertex_stride);
 
-  // Flush all EFB pokes and invalidate the peek cache.
-  FramebufferManager::GetInstance()->InvalidatePeekCache();
+  // Flush all EFB pokes and invalidate the peek cache and resolved tiles under the draw.
+  FramebufferManager::GetInstance()->InvalidateEFBCaches(StateTracker::GetInstance()->GetScissor());
   FramebufferManager::GetInstance()->FlushEFBPokes();
 
   // If bounding box is enabled, we need to flush any changes first, then invalidate what we have.
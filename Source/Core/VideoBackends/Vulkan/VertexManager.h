@@ -4,11 +4,15 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
+#include "VideoBackends/Vulkan/Constants.h"
+#include "VideoCommon/GPUVertexDecoder.h"
+#include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 
 namespace Vulkan
@@ -28,6 +32,8 @@ public:
   std::unique_ptr<NativeVertexFormat>
     CreateNativeVertexFormat(const PortableVertexDeclaration& vtx_decl) override;
   void PrepareShaders(PrimitiveType primitive, u32 components, const XFMemory &xfr, const BPMemory &bpm) {}
+  bool DecodeVerticesOnGPU(VertexLoaderBase* loader,
+                           const VertexLoaderParameters& parameters) override;
 protected:
   void PrepareDrawBuffers(u32 stride);
   void ResetBuffer(u32 stride) override;
@@ -35,13 +41,45 @@ protected:
 private:
   void vFlush(bool use_dst_alpha) override;
 
+  struct GPUDecoderShader
+  {
+    GPUVertexDecoder::Format format;
+    VkShaderModule compute_shader = VK_NULL_HANDLE;
+  };
+  struct GPUDecodedDraw
+  {
+    VkShaderModule compute_shader;
+    GPUVertexDecoder::Constants constants;
+  };
+
+  bool ReserveStreamMemory(size_t vertex_size, size_t index_size, u32 stride);
+  void UpdateBaseIndices(u32 stride);
+  bool CreateGPUDecoderBuffer();
+  bool UpdateGPUDecoderOutputView();
+  void DispatchGPUDecodedDraws(u32 stride);
+
   std::vector<u8, Common::aligned_allocator<u8, 256>> m_cpu_vertex_buffer;
   std::vector<u16, Common::aligned_allocator<u16, 256>> m_cpu_index_buffer;
 
   std::unique_ptr<StreamBuffer> m_vertex_stream_buffer;
   std::unique_ptr<StreamBuffer> m_index_stream_buffer;
 
+  // False while the current batch is written to the CPU buffers instead of the stream buffers.
+  bool m_writing_stream_buffers = false;
   u32 m_current_draw_base_vertex = 0;
   u32 m_current_draw_base_index = 0;
+
+  std::map<VertexLoaderUID, GPUDecoderShader> m_gpu_decoder_shaders;
+  // Raw vertices and vertex array data of the draws in this batch that are converted on the GPU.
+  std::vector<GPUDecodedDraw> m_gpu_decoded_draws;
+  std::vector<u8> m_gpu_decoder_data;
+  std::unique_ptr<StreamBuffer> m_gpu_decoder_buffer;
+  size_t m_gpu_decoder_buffer_size = 0;
+  VkBufferView m_gpu_decoder_input_view = VK_NULL_HANDLE;
+  u32 m_gpu_decoder_input_offset = 0;
+  // R32_UINT view of the vertex stream buffer, recreated whenever the buffer is reallocated.
+  VkBufferView m_gpu_decoder_output_view = VK_NULL_HANDLE;
+  VkBuffer m_gpu_decoder_output_buffer = VK_NULL_HANDLE;
+  size_t m_gpu_decoder_output_size = 0;
 };
 }
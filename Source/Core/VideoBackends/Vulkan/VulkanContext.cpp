@@ -39,7 +39,10 @@ VulkanContext::VulkanContext(VkInstance instance, VkPhysicalDevice physical_devi
 VulkanContext::~VulkanContext()
 {
   if (m_device != VK_NULL_HANDLE)
+  {
+    FreeMemoryBlocks();
     vkDestroyDevice(m_device, nullptr);
+  }
 
   if (m_debug_report_callback != VK_NULL_HANDLE)
     DisableDebugReports();
@@ -225,6 +228,7 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsExclusiveFullscreen = false;  // Currently WSI does not allow this.
   config->backend_info.bSupports3DVision = false;             // D3D-exclusive.
   config->backend_info.bSupportsOversizedViewports = true;    // Assumed support.
+  config->backend_info.bSupportsPrimitiveRestart = true;      // Assumed support.
   config->backend_info.bSupportsEarlyZ = true;                // Assumed support.  
   config->backend_info.bSupportsBindingLayout = false;        // Assumed support.
   config->backend_info.bSupportsPaletteConversion = true;     // Assumed support.
@@ -235,6 +239,7 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsDualSourceBlend = false;      // Dependent on features.
   config->backend_info.bSupportsGeometryShaders = false;      // Dependent on features.
   config->backend_info.bSupportsGSInstancing = false;         // Dependent on features.
+  config->backend_info.bSupportsVSLayerOutput = false;        // Needs VK_KHR_multiview.
   config->backend_info.bSupportsBBox = false;                 // Dependent on features.
   config->backend_info.bSupportsSSAA = false;                 // Dependent on features.
   config->backend_info.bSupportsFragmentStoresAndAtomics = false;     // Dependent on features.
@@ -242,6 +247,9 @@ void VulkanContext::PopulateBackendInfo(VideoConfig* config)
   config->backend_info.bSupportsReversedDepthRange = false;   // No support yet due to driver bugs.
   config->backend_info.bSupportsComputeShaders = true;        // Assumed support.
   config->backend_info.bSupportsGPUTextureDecoding = true;    // Assumed support.
+  config->backend_info.bSupportsGPUTextureScaling = true;     // Assumed support.
+  config->backend_info.bSupportsGPUMipmapGeneration = false;  // Dependent on features.
+  config->backend_info.bSupportsGPUVertexDecoding = true;     // Assumed support.
   config->backend_info.bSupportsBitfield = true;              // Assumed support.
   config->backend_info.bSupportsDynamicSamplerIndexing = true;        // Assumed support.
   config->ClearFormats();
@@ -295,6 +303,15 @@ void VulkanContext::PopulateBackendInfoFeatures(VideoConfig* config, VkPhysicalD
   config->backend_info.bSupportedFormats[PC_TEX_FMT_DXT1] = supports_bc;
   config->backend_info.bSupportedFormats[PC_TEX_FMT_DXT3] = supports_bc;
   config->backend_info.bSupportedFormats[PC_TEX_FMT_DXT5] = supports_bc;
+
+  // Mipmaps are blitted in an sRGB copy of the texture.
+  VkFormatProperties srgb_properties;
+  vkGetPhysicalDeviceFormatProperties(gpu, VK_FORMAT_R8G8B8A8_SRGB, &srgb_properties);
+  const VkFormatFeatureFlags blit_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT |
+                                             VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                             VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+  config->backend_info.bSupportsGPUMipmapGeneration =
+      (srgb_properties.optimalTilingFeatures & blit_features) == blit_features;
   config->backend_info.bSupportedFormats[PC_TEX_FMT_BPTC] = supports_bc;
   config->backend_info.bSupportedFormats[PC_TEX_FMT_DEPTH_FLOAT] = true;
   config->backend_info.bSupportedFormats[PC_TEX_FMT_R_FLOAT] = true;
@@ -540,6 +557,19 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
     return false;
   }
 
+  // A family without graphics support runs compute work next to the graphics queue.
+  m_compute_queue_family_index = queue_family_count;
+  for (uint32_t i = 0; i < queue_family_count; i++)
+  {
+    const VkQueueFlags flags = queue_family_properties[i].queueFlags;
+    if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) &&
+      i != m_present_queue_family_index)
+    {
+      m_compute_queue_family_index = i;
+      break;
+    }
+  }
+
   VkDeviceCreateInfo device_info = {};
   device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
   device_info.pNext = nullptr;
@@ -562,7 +592,15 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
   present_queue_info.queueCount = 1;
   present_queue_info.pQueuePriorities = queue_priorities;
 
-  std::array<VkDeviceQueueCreateInfo, 2> queue_infos = { {
+  VkDeviceQueueCreateInfo compute_queue_info = {};
+  compute_queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+  compute_queue_info.pNext = nullptr;
+  compute_queue_info.flags = 0;
+  compute_queue_info.queueFamilyIndex = m_compute_queue_family_index;
+  compute_queue_info.queueCount = 1;
+  compute_queue_info.pQueuePriorities = queue_priorities;
+
+  std::array<VkDeviceQueueCreateInfo, 3> queue_infos = { {
       graphics_queue_info, present_queue_info,
     } };
 
@@ -571,6 +609,10 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
   {
     device_info.queueCreateInfoCount = 2;
   }
+  if (m_compute_queue_family_index != queue_family_count)
+  {
+    queue_infos[device_info.queueCreateInfoCount++] = compute_queue_info;
+  }
   device_info.pQueueCreateInfos = queue_infos.data();
 
   ExtensionList enabled_extensions;
@@ -613,6 +655,12 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
   {
     vkGetDeviceQueue(m_device, m_present_queue_family_index, 0, &m_present_queue);
   }
+  if (m_compute_queue_family_index != queue_family_count)
+  {
+    vkGetDeviceQueue(m_device, m_compute_queue_family_index, 0, &m_compute_queue);
+    INFO_LOG(VIDEO, "Using vulkan queue family %u for async compute",
+      m_compute_queue_family_index);
+  }
   return true;
 }
 
@@ -768,4 +816,138 @@ u32 VulkanContext::GetReadbackMemoryType(u32 bits, bool* is_coherent, bool* is_c
 
   return type_index;
 }
+
+bool VulkanContext::AllocateDeviceMemory(VkDeviceSize size, u32 memory_type,
+  VkDeviceMemory* out_memory, u8** out_host_pointer)
+{
+  VkMemoryAllocateInfo memory_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, nullptr, size,
+                                      memory_type};
+  VkResult res = vkAllocateMemory(m_device, &memory_info, nullptr, out_memory);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkAllocateMemory failed: ");
+    return false;
+  }
+
+  *out_host_pointer = nullptr;
+  if (m_device_memory_properties.memoryTypes[memory_type].propertyFlags &
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+  {
+    void* host_pointer;
+    res = vkMapMemory(m_device, *out_memory, 0, VK_WHOLE_SIZE, 0, &host_pointer);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkMapMemory failed: ");
+      vkFreeMemory(m_device, *out_memory, nullptr);
+      return false;
+    }
+    *out_host_pointer = static_cast<u8*>(host_pointer);
+  }
+
+  return true;
+}
+
+bool VulkanContext::AllocateMemory(const VkMemoryRequirements& requirements, u32 memory_type,
+  MemoryAllocation* out_allocation)
+{
+  *out_allocation = {};
+  out_allocation->memory_type = memory_type;
+  out_allocation->size = requirements.size;
+
+  // The slots of a size class are aligned to its size, which also keeps linear and optimal
+  // resources in different pages of the buffer-image granularity.
+  const VkDeviceSize min_size = std::max(std::max(requirements.size, requirements.alignment),
+    GetBufferImageGranularity());
+  u32 size_class = 0;
+  while (size_class < SIZE_CLASS_COUNT &&
+    (VkDeviceSize(1) << (MIN_SIZE_CLASS_SHIFT + size_class)) < min_size)
+  {
+    size_class++;
+  }
+  if (size_class == SIZE_CLASS_COUNT)
+  {
+    return AllocateDeviceMemory(requirements.size, memory_type, &out_allocation->memory,
+      &out_allocation->host_pointer);
+  }
+
+  std::lock_guard<std::mutex> guard(m_memory_mutex);
+  std::vector<std::unique_ptr<MemoryBlock>>& pool = m_memory_pools[memory_type][size_class];
+  auto iter = std::find_if(pool.begin(), pool.end(), [](const std::unique_ptr<MemoryBlock>& block) {
+    return !block->free_slots.empty();
+  });
+  MemoryBlock* block;
+  if (iter != pool.end())
+  {
+    block = iter->get();
+  }
+  else
+  {
+    VkDeviceMemory memory;
+    u8* host_pointer;
+    if (!AllocateDeviceMemory(MEMORY_BLOCK_SIZE, memory_type, &memory, &host_pointer))
+      return false;
+
+    const u32 slot_count =
+      static_cast<u32>(MEMORY_BLOCK_SIZE >> (MIN_SIZE_CLASS_SHIFT + size_class));
+    pool.push_back(std::unique_ptr<MemoryBlock>(
+      new MemoryBlock{memory, host_pointer, size_class, slot_count, {}}));
+    block = pool.back().get();
+    // Hand out the slots from the start of the block first.
+    for (u32 slot = slot_count; slot > 0; slot--)
+      block->free_slots.push_back(slot - 1);
+  }
+
+  const u32 slot = block->free_slots.back();
+  block->free_slots.pop_back();
+  out_allocation->memory = block->memory;
+  out_allocation->offset = VkDeviceSize(slot) << (MIN_SIZE_CLASS_SHIFT + size_class);
+  out_allocation->host_pointer =
+    block->host_pointer ? block->host_pointer + out_allocation->offset : nullptr;
+  out_allocation->block = block;
+  out_allocation->slot = slot;
+  return true;
+}
+
+void VulkanContext::FreeMemory(const MemoryAllocation& allocation)
+{
+  if (!allocation.block)
+  {
+    if (allocation.memory != VK_NULL_HANDLE)
+      vkFreeMemory(m_device, allocation.memory, nullptr);
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(m_memory_mutex);
+  MemoryBlock* block = allocation.block;
+  block->free_slots.push_back(allocation.slot);
+  if (block->free_slots.size() < block->slot_count)
+    return;
+
+  // Keep one empty block per pool around for the next allocations, free any others.
+  std::vector<std::unique_ptr<MemoryBlock>>& pool =
+    m_memory_pools[allocation.memory_type][block->size_class];
+  const bool other_empty_block =
+    std::any_of(pool.begin(), pool.end(), [block](const std::unique_ptr<MemoryBlock>& other) {
+      return other.get() != block && other->free_slots.size() == other->slot_count;
+    });
+  if (!other_empty_block)
+    return;
+
+  vkFreeMemory(m_device, block->memory, nullptr);
+  pool.erase(std::find_if(pool.begin(), pool.end(),
+    [block](const std::unique_ptr<MemoryBlock>& other) { return other.get() == block; }));
+}
+
+void VulkanContext::FreeMemoryBlocks()
+{
+  for (auto& pools : m_memory_pools)
+  {
+    for (auto& pool : pools)
+    {
+      for (const std::unique_ptr<MemoryBlock>& block : pool)
+        vkFreeMemory(m_device, block->memory, nullptr);
+      pool.clear();
+    }
+  }
+}
 }
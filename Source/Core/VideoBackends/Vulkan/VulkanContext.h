@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -59,6 +61,9 @@ public:
   u32 GetGraphicsQueueFamilyIndex() const { return m_graphics_queue_family_index; }
   VkQueue GetPresentQueue() const { return m_present_queue; }
   u32 GetPresentQueueFamilyIndex() const { return m_present_queue_family_index; }
+  // Queue of a family that only does compute, null if the device doesn't have one.
+  VkQueue GetComputeQueue() const { return m_compute_queue; }
+  u32 GetComputeQueueFamilyIndex() const { return m_compute_queue_family_index; }
   const VkQueueFamilyProperties& GetGraphicsQueueProperties() const
   {
     return m_graphics_queue_properties;
@@ -84,6 +89,7 @@ public:
     return m_device_features.occlusionQueryPrecise == VK_TRUE;
   }
   bool SupportsNVGLSLExtension() const { return m_supports_nv_glsl_extension; }
+  bool SupportsAsyncCompute() const { return m_compute_queue != VK_NULL_HANDLE; }
   // Helpers for getting constants
   VkDeviceSize GetUniformBufferAlignment() const
   {
@@ -107,7 +113,46 @@ public:
   u32 GetUploadMemoryType(u32 bits, bool* is_coherent = nullptr);
   u32 GetReadbackMemoryType(u32 bits, bool* is_coherent = nullptr, bool* is_cached = nullptr);
 
+  // Device memory is sub-allocated from blocks shared by allocations of the same memory type and
+  // size class, so creating and destroying textures doesn't allocate memory from the driver every
+  // time. Allocations larger than the biggest size class get memory of their own.
+  struct MemoryBlock;
+  struct MemoryAllocation
+  {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    // Host-visible memory stays mapped for as long as it is allocated.
+    u8* host_pointer = nullptr;
+    MemoryBlock* block = nullptr;
+    u32 memory_type = 0;
+    u32 slot = 0;
+  };
+  bool AllocateMemory(const VkMemoryRequirements& requirements, u32 memory_type,
+    MemoryAllocation* out_allocation);
+  // The memory must not be in use by the GPU anymore, see
+  // CommandBufferManager::DeferDeviceMemoryDestruction.
+  void FreeMemory(const MemoryAllocation& allocation);
+
+  struct MemoryBlock
+  {
+    VkDeviceMemory memory;
+    u8* host_pointer;
+    u32 size_class;
+    u32 slot_count;
+    std::vector<u32> free_slots;
+  };
+
 private:
+  // Size classes of 64KB to 4MB, sub-allocated from blocks of 16MB.
+  static constexpr u32 MIN_SIZE_CLASS_SHIFT = 16;
+  static constexpr u32 SIZE_CLASS_COUNT = 7;
+  static constexpr VkDeviceSize MEMORY_BLOCK_SIZE = 16 * 1024 * 1024;
+
+  bool AllocateDeviceMemory(VkDeviceSize size, u32 memory_type, VkDeviceMemory* out_memory,
+    u8** out_host_pointer);
+  void FreeMemoryBlocks();
+
   using ExtensionList = std::vector<const char*>;
   static bool SelectInstanceExtensions(ExtensionList* extension_list, bool enable_surface,
     bool enable_debug_report);
@@ -123,6 +168,8 @@ private:
   u32 m_graphics_queue_family_index = 0;
   VkQueue m_present_queue = VK_NULL_HANDLE;
   u32 m_present_queue_family_index = 0;
+  VkQueue m_compute_queue = VK_NULL_HANDLE;
+  u32 m_compute_queue_family_index = 0;
   VkQueueFamilyProperties m_graphics_queue_properties = {};
 
   VkDebugReportCallbackEXT m_debug_report_callback = VK_NULL_HANDLE;
@@ -132,6 +179,12 @@ private:
   VkPhysicalDeviceMemoryProperties m_device_memory_properties = {};
 
   bool m_supports_nv_glsl_extension = false;
+
+  // Textures can be created and destroyed on other threads than the GPU thread.
+  std::mutex m_memory_mutex;
+  std::array<std::array<std::vector<std::unique_ptr<MemoryBlock>>, SIZE_CLASS_COUNT>,
+    VK_MAX_MEMORY_TYPES>
+    m_memory_pools;
 };
 
 extern std::unique_ptr<VulkanContext> g_vulkan_context;
@@ -10,6 +10,7 @@
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
 #include "VideoBackends/Vulkan/Constants.h"
 #include "VideoBackends/Vulkan/FramebufferManager.h"
+#include "VideoBackends/Vulkan/FrameProfiler.h"
 #include "VideoBackends/Vulkan/ObjectCache.h"
 #include "VideoBackends/Vulkan/PerfQuery.h"
 #include "VideoBackends/Vulkan/Renderer.h"
@@ -188,7 +189,8 @@ bool VideoBackend::Initialize(void* window_handle)
   std::unique_ptr<SwapChain> swap_chain;
   if (surface != VK_NULL_HANDLE)
   {
-    swap_chain = SwapChain::Create(window_handle, surface, g_Config.IsVSync());
+    swap_chain =
+        SwapChain::Create(window_handle, surface, g_Config.IsVSync(), g_Config.bLowLatency);
     if (!swap_chain)
     {
       PanicAlert("Failed to create Vulkan swap chain.");
@@ -197,7 +199,9 @@ bool VideoBackend::Initialize(void* window_handle)
   }
 
   // Create command buffers. We do this separately because the other classes depend on it.
-  g_command_buffer_mgr = std::make_unique<CommandBufferManager>(g_Config.bBackendMultithreading);
+  g_command_buffer_mgr = std::make_unique<CommandBufferManager>(
+      g_Config.bBackendMultithreading,
+      g_Config.bBackendMultithreading && g_vulkan_context->SupportsAsyncCompute());
   if (!g_command_buffer_mgr->Initialize())
   {
     PanicAlert("Failed to create Vulkan command buffers");
@@ -257,6 +261,7 @@ bool VideoBackend::Initialize(void* window_handle)
     return false;
   }
 
+  g_frame_profiler = std::make_unique<FrameProfiler>();
   return true;
 }
 
@@ -276,6 +281,7 @@ void VideoBackend::Shutdown()
   if (g_command_buffer_mgr)
     g_command_buffer_mgr->WaitForGPUIdle();
 
+  g_frame_profiler.reset();
   g_perf_query.reset();
   g_texture_cache.reset();
   g_vertex_manager.reset();
@@ -122,6 +122,61 @@ static std::string GetDumpPath(const std::string& format)
   return s_dump_path;
 }
 
+static AVPixelFormat GetEncoderPixelFormat(const AVCodec* codec)
+{
+  if (g_Config.bUseFFV1)
+    return AV_PIX_FMT_BGRA;
+  if (!codec->pix_fmts)
+    return AV_PIX_FMT_YUV420P;
+  for (const AVPixelFormat* format = codec->pix_fmts; *format != AV_PIX_FMT_NONE; ++format)
+  {
+    if (*format == AV_PIX_FMT_YUV420P)
+      return *format;
+  }
+  // Hardware encoders mostly take NV12. Formats of frames in GPU memory, like the ones of VAAPI,
+  // can't come out of swscale.
+  for (const AVPixelFormat* format = codec->pix_fmts; *format != AV_PIX_FMT_NONE; ++format)
+  {
+    if (sws_isSupportedOutput(*format))
+      return *format;
+  }
+  return AV_PIX_FMT_NONE;
+}
+
+static bool OpenCodec(const AVCodec* codec, AVOutputFormat* output_format)
+{
+  const AVPixelFormat pix_fmt = GetEncoderPixelFormat(codec);
+  if (pix_fmt == AV_PIX_FMT_NONE)
+    return false;
+
+  s_codec_context = avcodec_alloc_context3(codec);
+  if (!s_codec_context)
+    return false;
+
+  // Force XVID FourCC for better compatibility
+  if (codec->id == AV_CODEC_ID_MPEG4)
+    s_codec_context->codec_tag = MKTAG('X', 'V', 'I', 'D');
+
+  s_codec_context->codec_type = AVMEDIA_TYPE_VIDEO;
+  s_codec_context->bit_rate = g_Config.iBitrateKbps * 1000;
+  s_codec_context->width = s_width;
+  s_codec_context->height = s_height;
+  s_codec_context->time_base.num = 1;
+  s_codec_context->time_base.den = VideoInterface::GetTargetRefreshRate();
+  s_codec_context->gop_size = 12;
+  s_codec_context->pix_fmt = pix_fmt;
+
+  if (output_format->flags & AVFMT_GLOBALHEADER)
+    s_codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+  if (avcodec_open2(s_codec_context, codec, nullptr) < 0)
+  {
+    avcodec_free_context(&s_codec_context);
+    return false;
+  }
+  return true;
+}
+
 bool AVIDump::CreateVideoFile()
 {
   const std::string& s_format = g_Config.sDumpFormat;
@@ -160,34 +215,35 @@ bool AVIDump::CreateVideoFile()
 
   const AVCodec* codec = nullptr;
 
-  codec = avcodec_find_encoder(codec_id);
-  s_codec_context = avcodec_alloc_context3(codec);
-  if (!codec || !s_codec_context)
+  // A hardware encoder may be missing from the FFmpeg build or fail to open without the hardware,
+  // the software encoder of the codec takes over then.
+  if (!g_Config.bUseFFV1 && !g_Config.sDumpEncoder.empty())
   {
-    ERROR_LOG(VIDEO, "Could not find encoder or allocate codec context");
-    return false;
+    codec = avcodec_find_encoder_by_name(g_Config.sDumpEncoder.c_str());
+    if (!codec)
+    {
+      WARN_LOG(VIDEO, "Invalid encoder %s", g_Config.sDumpEncoder.c_str());
+    }
+    else if (!OpenCodec(codec, output_format))
+    {
+      WARN_LOG(VIDEO, "Could not open encoder %s", g_Config.sDumpEncoder.c_str());
+      codec = nullptr;
+    }
   }
 
-  // Force XVID FourCC for better compatibility
-  if (codec->id == AV_CODEC_ID_MPEG4)
-    s_codec_context->codec_tag = MKTAG('X', 'V', 'I', 'D');
-
-  s_codec_context->codec_type = AVMEDIA_TYPE_VIDEO;
-  s_codec_context->bit_rate = g_Config.iBitrateKbps * 1000;
-  s_codec_context->width = s_width;
-  s_codec_context->height = s_height;
-  s_codec_context->time_base.num = 1;
-  s_codec_context->time_base.den = VideoInterface::GetTargetRefreshRate();
-  s_codec_context->gop_size = 12;
-  s_codec_context->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGRA : AV_PIX_FMT_YUV420P;
-
-  if (output_format->flags & AVFMT_GLOBALHEADER)
-    s_codec_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
-
-  if (avcodec_open2(s_codec_context, codec, nullptr) < 0)
+  if (!codec)
   {
-    ERROR_LOG(VIDEO, "Could not open codec");
-    return false;
+    codec = avcodec_find_encoder(codec_id);
+    if (!codec)
+    {
+      ERROR_LOG(VIDEO, "Could not find encoder");
+      return false;
+    }
+    if (!OpenCodec(codec, output_format))
+    {
+      ERROR_LOG(VIDEO, "Could not open codec");
+      return false;
+    }
   }
 
   s_src_frame = av_frame_alloc();
@@ -357,6 +413,11 @@ static void HandleDelayedPackets()
 {
   AVPacket pkt;
 
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 37, 100)
+  // Encoders keep frames back until they are told the stream ended, hardware ones more than most.
+  avcodec_send_frame(s_codec_context, nullptr);
+#endif
+
   while (true)
   {
     PreparePacket(&pkt);
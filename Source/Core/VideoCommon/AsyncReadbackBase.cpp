@@ -0,0 +1,84 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/AsyncReadbackBase.h"
+
+#include "Common/Assert.h"
+
+AsyncReadbackBase::AsyncReadbackBase(size_t ring_size)
+    : m_slots(ring_size + 1), m_mapped_slot(ring_size + 1)
+{
+}
+
+AsyncReadbackBase::~AsyncReadbackBase()
+{
+  // Backends have to call Discard, the slots can't be unmapped from here.
+  ASSERT(!HasPending() && m_mapped_slot == m_slots.size());
+}
+
+bool AsyncReadbackBase::Queue(uintptr_t texture, const MathUtil::Rectangle<int>& rect,
+                              Callback callback)
+{
+  if (rect.GetWidth() <= 0 || rect.GetHeight() <= 0)
+    return false;
+
+  // The slot after the pending ones is only taken by the data of the last callback when the ring
+  // is full.
+  if (m_pending_count == m_slots.size() - 1)
+    ReadbackOldest();
+
+  const size_t slot = (m_oldest + m_pending_count) % m_slots.size();
+  if (!CopyToSlot(slot, texture, rect))
+    return false;
+
+  m_slots[slot].callback = std::move(callback);
+  m_slots[slot].width = static_cast<u32>(rect.GetWidth());
+  m_slots[slot].height = static_cast<u32>(rect.GetHeight());
+  m_pending_count++;
+  return true;
+}
+
+void AsyncReadbackBase::Poll()
+{
+  while (m_pending_count != 0 && IsSlotReady(m_oldest))
+    ReadbackOldest();
+}
+
+void AsyncReadbackBase::Flush()
+{
+  while (m_pending_count != 0)
+    ReadbackOldest();
+}
+
+void AsyncReadbackBase::Discard()
+{
+  for (; m_pending_count != 0; m_pending_count--)
+  {
+    m_slots[m_oldest].callback = nullptr;
+    m_oldest = (m_oldest + 1) % m_slots.size();
+  }
+  if (m_mapped_slot != m_slots.size())
+  {
+    UnmapSlot(m_mapped_slot);
+    m_mapped_slot = m_slots.size();
+  }
+}
+
+void AsyncReadbackBase::ReadbackOldest()
+{
+  Slot& slot = m_slots[m_oldest];
+  u32 stride = 0;
+  const u8* data = MapSlot(m_oldest, &stride);
+  if (data)
+    slot.callback(data, slot.width, slot.height, stride);
+  slot.callback = nullptr;
+
+  // The previous callback is done with its data now.
+  if (m_mapped_slot != m_slots.size())
+    UnmapSlot(m_mapped_slot);
+  m_mapped_slot = data ? m_oldest : m_slots.size();
+
+  m_oldest = (m_oldest + 1) % m_slots.size();
+  m_pending_count--;
+}
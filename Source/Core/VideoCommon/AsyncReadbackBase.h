@@ -0,0 +1,69 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MathUtil.h"
+
+// A ring of staging resources the GPU copies textures into, so that the CPU reads a copy back
+// once the GPU is done with it instead of waiting for it. Backends implement the primitives, the
+// ring keeps the readbacks in order and runs their callbacks.
+class AsyncReadbackBase
+{
+public:
+  // Receives the texels of a finished readback, rows are stride bytes apart. The data stays valid
+  // until the callback of the next readback returned, so a callback handing it to another thread
+  // has to wait for that thread when it is called again.
+  using Callback = std::function<void(const u8* data, u32 width, u32 height, u32 stride)>;
+
+  // Up to ring_size readbacks can be in flight, queueing more reads back the oldest one first.
+  explicit AsyncReadbackBase(size_t ring_size);
+  virtual ~AsyncReadbackBase();
+
+  // Queues a copy of a rectangle of a backend texture. Returns false if it couldn't be queued.
+  bool Queue(uintptr_t texture, const MathUtil::Rectangle<int>& rect, Callback callback);
+  // Runs the callbacks of the readbacks the GPU finished, oldest first, without waiting.
+  void Poll();
+  // Waits for every queued readback and runs their callbacks.
+  void Flush();
+  // Drops the queued readbacks without running their callbacks, and releases the data of the
+  // last callback. Backends call this in their destructor.
+  void Discard();
+
+  bool HasPending() const { return m_pending_count != 0; }
+
+protected:
+  // Ensures the staging resource of a slot holds the rectangle and records the copy into it.
+  virtual bool CopyToSlot(size_t slot, uintptr_t texture, const MathUtil::Rectangle<int>& rect) = 0;
+  // Whether the copy into a slot finished, without waiting for it.
+  virtual bool IsSlotReady(size_t slot) = 0;
+  // Waits for the copy into a slot and maps it. Returns nullptr if it couldn't be mapped.
+  virtual const u8* MapSlot(size_t slot, u32* stride) = 0;
+  virtual void UnmapSlot(size_t slot) = 0;
+
+  // One more than the ring size, the data of the last callback keeps its slot.
+  size_t GetSlotCount() const { return m_slots.size(); }
+
+private:
+  struct Slot
+  {
+    Callback callback;
+    u32 width = 0;
+    u32 height = 0;
+  };
+
+  void ReadbackOldest();
+
+  std::vector<Slot> m_slots;
+  size_t m_oldest = 0;
+  size_t m_pending_count = 0;
+  // The slot the data of the last callback is in, the slot count if there is none.
+  size_t m_mapped_slot;
+};
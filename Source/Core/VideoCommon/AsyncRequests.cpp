@@ -4,6 +4,8 @@
 
 #include <mutex>
 
+#include "Common/Tracing.h"
+
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/Fifo.h"
@@ -14,6 +16,9 @@
 
 AsyncRequests AsyncRequests::s_singleton;
 
+// Past this many held back pokes, they are drawn without waiting for a use of the EFB.
+constexpr size_t MAX_MERGED_EFB_POKES = 65536;
+
 AsyncRequests::AsyncRequests()
   : m_enable(false), m_passthrough(true)
 {}
@@ -27,33 +32,16 @@ void AsyncRequests::PullEventsInternal()
   {
     Event e = m_queue.front();
 
-    // try to merge as many efb pokes as possible
-    // it's a bit hacky, but some games render a complete frame in this way
-    if ((e.type == Event::EFB_POKE_COLOR || e.type == Event::EFB_POKE_Z))
+    // Merge as many efb pokes as possible, some games render a complete frame this way. They
+    // usually come in one at a time, so they are kept until something else uses the EFB.
+    if (e.type == Event::EFB_POKE_COLOR || e.type == Event::EFB_POKE_Z)
     {
-      m_merged_efb_pokes.clear();
-      Event first_event = m_queue.front();
-      EFBAccessType t = first_event.type == Event::EFB_POKE_COLOR ? EFBAccessType::PokeColor : EFBAccessType::PokeZ;
-
-      do
-      {
-        e = m_queue.front();
-
-        EfbPokeData d;
-        d.data = e.efb_poke.data;
-        d.x = e.efb_poke.x;
-        d.y = e.efb_poke.y;
-        m_merged_efb_pokes.push_back(d);
-
-        m_queue.pop();
-      } while (!m_queue.empty() && m_queue.front().type == first_event.type);
-
-      lock.unlock();
-      g_renderer->PokeEFB(t, m_merged_efb_pokes.data(), m_merged_efb_pokes.size());
-      lock.lock();
+      MergeEFBPoke(e, lock);
+      m_queue.pop();
       continue;
     }
 
+    DrawMergedEFBPokes(lock);
     lock.unlock();
     HandleEvent(e);
     lock.lock();
@@ -74,6 +62,14 @@ void AsyncRequests::PushEvent(const AsyncRequests::Event& event, bool blocking)
 
   if (m_passthrough)
   {
+    if (event.type == Event::EFB_POKE_COLOR || event.type == Event::EFB_POKE_Z)
+    {
+      MergeEFBPoke(event, lock);
+      return;
+    }
+
+    // Drawn first, so nothing HandleEvent does can find pokes to flush while the lock is held.
+    DrawMergedEFBPokes(lock);
     HandleEvent(event);
     return;
   }
@@ -89,6 +85,7 @@ void AsyncRequests::PushEvent(const AsyncRequests::Event& event, bool blocking)
   Fifo::RunGpu();
   if (blocking)
   {
+    TRACE_SCOPE("Sync", "Wait for GPU request");
     m_cond.wait(lock, [this]
     {
       return m_queue.empty();
@@ -106,6 +103,8 @@ void AsyncRequests::SetEnable(bool enable)
     // flush the queue on disabling
     while (!m_queue.empty())
       m_queue.pop();
+    m_merged_efb_pokes.clear();
+    m_efb_pokes_pending.Clear();
     if (m_wake_me_up_again)
       m_cond.notify_all();
   }
@@ -120,6 +119,7 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   {
     EfbPokeData poke = { e.efb_poke.x, e.efb_poke.y, e.efb_poke.data };
     g_renderer->PokeEFB(EFBAccessType::PokeColor, &poke, 1);
+    g_renderer->OnEFBModified();
   }
   break;
 
@@ -127,6 +127,7 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   {
     EfbPokeData poke = { e.efb_poke.x, e.efb_poke.y, e.efb_poke.data };
     g_renderer->PokeEFB(EFBAccessType::PokeZ, &poke, 1);
+    g_renderer->OnEFBModified();
   }
   break;
 
@@ -152,6 +153,16 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
       *e.bbox.data = BoundingBox::coords[e.bbox.index];
     }
     break;
+  case Event::BBOX_PREFETCH:
+    for (int i = 0; i < 4; i++)
+    {
+      if (g_ActiveConfig.backend_info.bSupportsBBox && g_ActiveConfig.iBBoxMode == BBoxGPU)
+        e.bbox_prefetch.data[i] = g_renderer->BBoxRead(i);
+      else
+        e.bbox_prefetch.data[i] = BoundingBox::coords[i];
+    }
+    e.bbox_prefetch.done->Set();
+    break;
   case Event::PERF_QUERY:
     g_perf_query->FlushResults();
     break;
@@ -159,6 +170,44 @@ void AsyncRequests::HandleEvent(const AsyncRequests::Event& e)
   }
 }
 
+void AsyncRequests::FlushEFBPokesInternal()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  DrawMergedEFBPokes(lock);
+}
+
+void AsyncRequests::MergeEFBPoke(const Event& e, std::unique_lock<std::mutex>& lock)
+{
+  if (!m_merged_efb_pokes.empty() &&
+      (e.type != m_merged_efb_poke_type || m_merged_efb_pokes.size() >= MAX_MERGED_EFB_POKES))
+  {
+    DrawMergedEFBPokes(lock);
+  }
+
+  m_merged_efb_poke_type = e.type;
+  m_merged_efb_pokes.push_back({e.efb_poke.x, e.efb_poke.y, e.efb_poke.data});
+  m_efb_pokes_pending.Set();
+}
+
+void AsyncRequests::DrawMergedEFBPokes(std::unique_lock<std::mutex>& lock)
+{
+  if (m_merged_efb_pokes.empty())
+    return;
+
+  // Pokes merged while drawing go to the other vector.
+  m_drawn_efb_pokes.swap(m_merged_efb_pokes);
+  m_merged_efb_pokes.clear();
+  m_efb_pokes_pending.Clear();
+  const EFBAccessType type = m_merged_efb_poke_type == Event::EFB_POKE_COLOR ?
+                                 EFBAccessType::PokeColor :
+                                 EFBAccessType::PokeZ;
+
+  lock.unlock();
+  g_renderer->PokeEFB(type, m_drawn_efb_pokes.data(), m_drawn_efb_pokes.size());
+  g_renderer->OnEFBModified();
+  lock.lock();
+}
+
 void AsyncRequests::SetPassthrough(bool enable)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
@@ -27,6 +27,7 @@ public:
       EFB_PEEK_Z,
       SWAP_EVENT,
       BBOX_READ,
+      BBOX_PREFETCH,
       PERF_QUERY,
     } type;
     u64 time;
@@ -61,6 +62,13 @@ public:
         u16* data;
       } bbox;
 
+      struct
+      {
+        // All four values are written, then done is set.
+        u16* data;
+        Common::Flag* done;
+      } bbox_prefetch;
+
       struct
       {} perf_query;
     };
@@ -74,6 +82,13 @@ public:
       PullEventsInternal();
   }
   void PushEvent(const Event& event, bool blocking = false);
+  // Pokes are held back to be drawn in large batches. Call on the video thread before anything
+  // that draws to or reads the EFB.
+  void FlushEFBPokes()
+  {
+    if (m_efb_pokes_pending.IsSet())
+      FlushEFBPokesInternal();
+  }
   void SetEnable(bool enable);
   void SetPassthrough(bool enable);
 
@@ -85,6 +100,10 @@ public:
 private:
   void PullEventsInternal();
   void HandleEvent(const Event& e);
+  void FlushEFBPokesInternal();
+  // Both expect m_mutex to be held through lock, which is released while drawing.
+  void MergeEFBPoke(const Event& e, std::unique_lock<std::mutex>& lock);
+  void DrawMergedEFBPokes(std::unique_lock<std::mutex>& lock);
 
   static AsyncRequests s_singleton;
 
@@ -97,5 +116,8 @@ private:
   bool m_enable;
   bool m_passthrough;
 
+  Common::Flag m_efb_pokes_pending;
+  Event::Type m_merged_efb_poke_type = Event::EFB_POKE_COLOR;
   std::vector<EfbPokeData> m_merged_efb_pokes;
+  std::vector<EfbPokeData> m_drawn_efb_pokes;
 };
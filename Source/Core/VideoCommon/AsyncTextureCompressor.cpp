@@ -0,0 +1,97 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/AsyncTextureCompressor.h"
+
+#include "Common/Thread.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureUtil.h"
+
+AsyncTextureCompressor::AsyncTextureCompressor()
+{
+  Common::ThreadPool::RegisterWorker(this);
+}
+
+AsyncTextureCompressor::~AsyncTextureCompressor()
+{
+  Common::ThreadPool::UnregisterWorker(this);
+  Clear();
+  size_t loop_count = 0;
+  while (m_running.load())
+    Common::cYield(loop_count++);
+}
+
+bool AsyncTextureCompressor::NextTask(size_t ID)
+{
+  // Jobs share nothing, every thread of the pool may run one.
+  m_running++;
+  std::unique_ptr<Job> job;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_queued.empty())
+    {
+      job = std::move(m_queued.front());
+      m_queued.pop_front();
+    }
+  }
+  if (!job)
+  {
+    m_running--;
+    return false;
+  }
+
+  Compress(job.get());
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_finished.push_back(std::move(job));
+  }
+  m_running--;
+  return true;
+}
+
+void AsyncTextureCompressor::Queue(std::unique_ptr<Job> job)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_queued.push_back(std::move(job));
+  }
+  Common::ThreadPool::NotifyWorkPending();
+}
+
+void AsyncTextureCompressor::Clear()
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  m_queued.clear();
+}
+
+void AsyncTextureCompressor::TakeFinished(std::vector<std::unique_ptr<Job>>* out)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  for (auto& job : m_finished)
+    out->push_back(std::move(job));
+  m_finished.clear();
+}
+
+void AsyncTextureCompressor::Compress(Job* job)
+{
+  size_t compressed_size = 0;
+  for (u32 level = 0; level < job->levels; level++)
+  {
+    compressed_size += TextureUtil::GetTextureSizeInBytes(
+        TextureUtil::CalculateLevelSize(job->width, level),
+        TextureUtil::CalculateLevelSize(job->height, level), PC_TEX_FMT_DXT5);
+  }
+  std::vector<u8> compressed(compressed_size);
+  u8* dst = compressed.data();
+  const u8* src = job->data.data();
+  for (u32 level = 0; level < job->levels; level++)
+  {
+    const u32 width = TextureUtil::CalculateLevelSize(job->width, level);
+    const u32 height = TextureUtil::CalculateLevelSize(job->height, level);
+    TextureUtil::CompressRGBA32ToDXT5(dst, reinterpret_cast<const u32*>(src), width, height, width);
+    dst += TextureUtil::GetTextureSizeInBytes(width, height, PC_TEX_FMT_DXT5);
+    src += TextureUtil::GetTextureSizeInBytes(width, height, PC_TEX_FMT_RGBA32);
+  }
+  job->data = std::move(compressed);
+}
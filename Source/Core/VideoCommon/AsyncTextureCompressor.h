@@ -0,0 +1,53 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
+
+// Compresses RGBA32 custom textures to DXT5 on the thread pool, so that the ones loaded from
+// images take a quarter of the memory once the texture cache swaps the result in.
+class AsyncTextureCompressor final : public Common::IWorker
+{
+public:
+  struct Job
+  {
+    u64 id;
+    // The name the custom texture is cached under.
+    std::string name;
+    u32 width;
+    u32 height;
+    u32 levels;
+    // The RGBA32 levels, replaced by the DXT5 ones. Both dimensions are multiples of 4.
+    std::vector<u8> data;
+  };
+
+  AsyncTextureCompressor();
+  ~AsyncTextureCompressor();
+
+  bool NextTask(size_t ID) override;
+
+  void Queue(std::unique_ptr<Job> job);
+  // Drops the jobs that didn't start yet, the running ones still finish.
+  void Clear();
+  // Moves the finished jobs to out.
+  void TakeFinished(std::vector<std::unique_ptr<Job>>* out);
+
+  // Compresses the levels of a job in place.
+  static void Compress(Job* job);
+
+private:
+  std::mutex m_lock;
+  std::deque<std::unique_ptr<Job>> m_queued;
+  std::vector<std::unique_ptr<Job>> m_finished;
+  std::atomic<int> m_running{0};
+};
@@ -0,0 +1,80 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/AsyncTextureDumper.h"
+
+#include "VideoCommon/ImageWrite.h"
+
+// Memory the queued textures may take before the GPU thread writes them itself.
+static const size_t MAX_QUEUED_SIZE = 64 * 1024 * 1024;
+
+AsyncTextureDumper::AsyncTextureDumper()
+{
+  Common::ThreadPool::RegisterWorker(this);
+}
+
+AsyncTextureDumper::~AsyncTextureDumper()
+{
+  Common::ThreadPool::UnregisterWorker(this);
+  while (NextTask(0))
+  {
+  }
+  size_t loop_count = 0;
+  while (m_running.load())
+    Common::cYield(loop_count++);
+}
+
+bool AsyncTextureDumper::NextTask(size_t ID)
+{
+  // Jobs share nothing, every thread of the pool may run one.
+  m_running++;
+  std::unique_ptr<Job> job;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_queued.empty())
+    {
+      job = std::move(m_queued.front());
+      m_queued.pop_front();
+      m_queued_size -= job->data.size();
+    }
+  }
+  if (!job)
+  {
+    m_running--;
+    return false;
+  }
+
+  Write(*job);
+  m_running--;
+  return true;
+}
+
+bool AsyncTextureDumper::Claim(const std::string& filename)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  return m_claimed.insert(filename).second;
+}
+
+void AsyncTextureDumper::Queue(std::unique_ptr<Job> job)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_queued_size + job->data.size() <= MAX_QUEUED_SIZE)
+    {
+      m_queued_size += job->data.size();
+      m_queued.push_back(std::move(job));
+    }
+  }
+  if (job)
+  {
+    Write(*job);
+    return;
+  }
+  Common::ThreadPool::NotifyWorkPending();
+}
+
+void AsyncTextureDumper::Write(const Job& job)
+{
+  TextureToPng(job.data.data(), job.row_stride, job.filename, job.width, job.height, true);
+}
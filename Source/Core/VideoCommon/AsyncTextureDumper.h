@@ -0,0 +1,53 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
+
+// Encodes and writes the dumped textures as PNG on the thread pool, so that dumping doesn't stall
+// the GPU thread.
+class AsyncTextureDumper final : public Common::IWorker
+{
+public:
+  struct Job
+  {
+    std::string filename;
+    u32 width;
+    u32 height;
+    u32 row_stride;
+    // RGBA32.
+    std::vector<u8> data;
+  };
+
+  AsyncTextureDumper();
+  // Writes the textures still queued before returning.
+  ~AsyncTextureDumper();
+
+  bool NextTask(size_t ID) override;
+
+  // Returns false if filename was already dumped or queued, that texture is skipped.
+  bool Claim(const std::string& filename);
+  // Writes the texture on the calling thread when the queue is full, so its memory stays bounded.
+  void Queue(std::unique_ptr<Job> job);
+
+private:
+  static void Write(const Job& job);
+
+  std::mutex m_lock;
+  std::deque<std::unique_ptr<Job>> m_queued;
+  size_t m_queued_size = 0;
+  std::unordered_set<std::string> m_claimed;
+  std::atomic<int> m_running{0};
+};
@@ -0,0 +1,66 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/AutoTuner.h"
+
+#include <algorithm>
+
+namespace AutoTuner
+{
+bool FramesMatch(const std::vector<u64>& reference, const std::vector<u64>& frames)
+{
+  const size_t count = std::min(reference.size(), frames.size());
+  if (count == 0 || count + MAX_MISSING_FRAMES < reference.size())
+    return false;
+  return std::equal(frames.begin(), frames.begin() + count, reference.begin());
+}
+
+Configuration GetCurrentConfiguration(const std::vector<Setting>& settings)
+{
+  Configuration configuration;
+  for (const Setting& setting : settings)
+    configuration[setting.location] = setting.current;
+  return configuration;
+}
+
+std::optional<Result> Tune(const std::vector<Setting>& settings, const MeasureFunction& measure,
+                           double min_gain_percent)
+{
+  const Configuration start = GetCurrentConfiguration(settings);
+  const std::optional<Measurement> reference = measure(start);
+  if (!reference || reference->frame_hashes.empty())
+    return std::nullopt;
+
+  Result result;
+  result.best = start;
+  result.reference_fps = reference->fps;
+  result.best_fps = reference->fps;
+  for (const Setting& setting : settings)
+  {
+    // The value kept from the settings before stays the one to beat.
+    const std::string best_value = result.best[setting.location];
+    for (const std::string& value : setting.values)
+    {
+      if (value == best_value)
+        continue;
+
+      Configuration candidate = result.best;
+      candidate[setting.location] = value;
+      result.tried++;
+      const std::optional<Measurement> measurement = measure(candidate);
+      if (!measurement || !FramesMatch(reference->frame_hashes, measurement->frame_hashes))
+      {
+        result.mismatched++;
+        continue;
+      }
+      if (measurement->fps > result.best_fps * (1.0 + min_gain_percent / 100.0))
+      {
+        result.best = std::move(candidate);
+        result.best_fps = measurement->fps;
+      }
+    }
+  }
+  return result;
+}
+}  // namespace AutoTuner
@@ -0,0 +1,79 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+
+// Looks for the fastest values of a few settings that still draw the same frames as the ones the
+// user has, by timing a benchmark with each of them. Used by DolphinNoGUI --autotune.
+namespace AutoTuner
+{
+// The values are strings as they are stored in a config layer.
+using Configuration = std::map<Config::ConfigLocation, std::string>;
+
+struct Setting
+{
+  std::string name;
+  Config::ConfigLocation location;
+  // The value in effect when the setting was made, which the search starts with.
+  std::string current;
+  // The values to try instead.
+  std::vector<std::string> values;
+};
+
+template <typename T>
+Setting MakeSetting(const std::string& name, const Config::ConfigInfo<T>& info,
+                    const std::vector<T>& values)
+{
+  Setting setting{name, info.location, Config::detail::ValueToString(Config::Get(info)), {}};
+  for (const T& value : values)
+    setting.values.push_back(Config::detail::ValueToString(value));
+  return setting;
+}
+
+struct Measurement
+{
+  double fps = 0.0;
+  std::vector<u64> frame_hashes;
+};
+
+// Runs the benchmark with the configuration. Empty if it failed.
+using MeasureFunction = std::function<std::optional<Measurement>(const Configuration&)>;
+
+// The last frames of a run may not be read back before the emulation stops, so this many of them
+// may be missing.
+constexpr size_t MAX_MISSING_FRAMES = 8;
+
+// Whether a run drew the same frames as the reference.
+bool FramesMatch(const std::vector<u64>& reference, const std::vector<u64>& frames);
+
+struct Result
+{
+  Configuration best;
+  double reference_fps = 0.0;
+  double best_fps = 0.0;
+  // Configurations measured besides the reference, and how many of them drew other frames or
+  // failed to run.
+  u32 tried = 0;
+  u32 mismatched = 0;
+};
+
+// The current values of the settings.
+Configuration GetCurrentConfiguration(const std::vector<Setting>& settings);
+
+// Measures the current configuration as the reference, then goes through the settings in order
+// and tries each of their values on top of the best configuration found so far. A value is kept
+// if the frames match the reference and it's faster by more than min_gain_percent. Empty if the
+// reference failed to run or drew no frames.
+std::optional<Result> Tune(const std::vector<Setting>& settings, const MeasureFunction& measure,
+                           double min_gain_percent);
+}  // namespace AutoTuner
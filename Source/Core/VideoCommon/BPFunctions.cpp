@@ -5,6 +5,7 @@
 #include "Common/Common.h"
 #include "Common/Logging/Log.h"
 
+#include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/GeometryShaderManager.h"
@@ -26,6 +27,8 @@ namespace BPFunctions
 
 void FlushPipeline()
 {
+  // EFB copies, clears and format changes come through here too.
+  AsyncRequests::GetInstance()->FlushEFBPokes();
   g_vertex_manager->Flush();
 }
 
@@ -135,6 +138,7 @@ void ClearScreen(const EFBRectangle &rc)
       z = Z24ToZ16ToZ24(z);
     }
     g_renderer->ClearScreen(rc, colorEnable, alphaEnable, zEnable, color, z);
+    g_renderer->OnEFBModified();
   }
 }
 
@@ -203,6 +207,7 @@ void OnPixelFormatChange()
   }
 
   g_renderer->ReinterpretPixelData(convtype);
+  g_renderer->OnEFBModified();
 
 skip:
   DEBUG_LOG(VIDEO, "pixelfmt: pixel=%d, zc=%d", static_cast<int>(new_format), static_cast<int>(bpmem.zcontrol.zformat));
@@ -41,6 +41,10 @@ void LoadBPReg(u32 value0)
   if (opcode != BPMEM_BP_MASK)
     bpmem.bpMask = 0xFFFFFF;
 
+  // Games write most registers with the value they already have, don't bother BPWritten.
+  if (!changes && !BPWriteHasSideEffects(opcode))
+    return;
+
   BPWritten(bp);
 }
 
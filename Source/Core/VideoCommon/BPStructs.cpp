@@ -24,10 +24,13 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TmemMirror.h"
 #include "VideoCommon/VertexLoader.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -58,6 +61,27 @@ void BPInit()
   mapTexFound = false;
 }
 
+bool BPWriteHasSideEffects(int address)
+{
+  switch (address)
+  {
+  case BPMEM_TRIGGER_EFB_COPY:
+  case BPMEM_CLEARBBOX1:
+  case BPMEM_CLEARBBOX2:
+  case BPMEM_SETDRAWDONE:
+  case BPMEM_PE_TOKEN_ID:
+  case BPMEM_PE_TOKEN_INT_ID:
+  case BPMEM_LOADTLUT0:
+  case BPMEM_LOADTLUT1:
+  case BPMEM_TEXINVALIDATE:
+  case BPMEM_PRELOAD_MODE:
+  case BPMEM_CLEAR_PIXEL_PERF:
+    return true;
+  default:
+    return false;
+  }
+}
+
 void BPWritten(const BPCmd& bp)
 {
   /*
@@ -99,27 +123,22 @@ void BPWritten(const BPCmd& bp)
   // FIXME: Hangs load-state, but should fix graphic-heavy games state loading
   //std::lock_guard<std::mutex> lk(s_bpCritical);
 
-  if (((s32*)&bpmem)[bp.address] == bp.newvalue)
+  if (((s32*)&bpmem)[bp.address] == bp.newvalue && !BPWriteHasSideEffects(bp.address))
+    return;
+
+  // The batch flushed here holds the reference triangle of the first zfreeze draw.
+  if (bp.address == BPMEM_GENMODE && !g_vertex_manager->IsZSlopeEnabled())
   {
-    if (!(bp.address == BPMEM_TRIGGER_EFB_COPY
-      || bp.address == BPMEM_CLEARBBOX1
-      || bp.address == BPMEM_CLEARBBOX2
-      || bp.address == BPMEM_SETDRAWDONE
-      || bp.address == BPMEM_PE_TOKEN_ID
-      || bp.address == BPMEM_PE_TOKEN_INT_ID
-      || bp.address == BPMEM_LOADTLUT0
-      || bp.address == BPMEM_LOADTLUT1
-      || bp.address == BPMEM_TEXINVALIDATE
-      || bp.address == BPMEM_PRELOAD_MODE
-      || bp.address == BPMEM_CLEAR_PIXEL_PERF))
-    {
-      return;
-    }
+    GenMode gen_mode;
+    gen_mode.hex = bp.newvalue;
+    if (gen_mode.zfreeze)
+      g_vertex_manager->EnableZSlope();
   }
 
   FlushPipeline();
 
   ((u32*)&bpmem)[bp.address] = bp.newvalue;
+  InvalidateShaderUidsForBPWrite(bp.address);
 
   switch (bp.address)
   {
@@ -211,6 +230,8 @@ void BPWritten(const BPCmd& bp)
     switch (bp.newvalue & 0xFF)
     {
     case 0x02:
+      // The game reads its EFB copies once the GPU is done.
+      g_texture_cache->FlushDeferredEFBCopies();
       if (!Fifo::UseDeterministicGPUThread())
         PixelEngine::SetFinish(); // may generate interrupt
       DEBUG_LOG(VIDEO, "GXSetDrawDone SetPEFinish (value: 0x%02X)", (bp.newvalue & 0xFFFF));
@@ -222,11 +243,13 @@ void BPWritten(const BPCmd& bp)
     }
     return;
   case BPMEM_PE_TOKEN_ID: // Pixel Engine Token ID
+    g_texture_cache->FlushDeferredEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), false);
     DEBUG_LOG(VIDEO, "SetPEToken 0x%04x", (bp.newvalue & 0xFFFF));
     return;
   case BPMEM_PE_TOKEN_INT_ID: // Pixel Engine Interrupt Token ID
+    g_texture_cache->FlushDeferredEFBCopies();
     if (!Fifo::UseDeterministicGPUThread())
       PixelEngine::SetToken(static_cast<u16>(bp.newvalue & 0xFFFF), true);
     DEBUG_LOG(VIDEO, "SetPEToken + INT 0x%04x", (bp.newvalue & 0xFFFF));
@@ -312,7 +335,9 @@ void BPWritten(const BPCmd& bp)
     if (!SConfig::GetInstance().bWii)
       addr = addr & 0x01FFFFFF;
 
+    g_texture_cache->FlushDeferredEFBCopies(addr, tlutXferCount);
     Memory::CopyFromEmu(texMem + tlutTMemAddr, addr, tlutXferCount);
+    TmemMirror::Invalidate(tlutTMemAddr, tlutXferCount);
 
     if (g_bRecordFifoData)
       FifoRecorder::GetInstance().UseMemory(addr, tlutXferCount, MemoryUpdate::TMEM);
@@ -504,6 +529,9 @@ void BPWritten(const BPCmd& bp)
       u32 src_addr = tmem_cfg.preload_addr << 5; // TODO: Should we add mask here on GC?
       u32 bytes_read = 0;
       u32 tmem_addr_even = tmem_cfg.preload_tmem_even * TMEM_LINE_SIZE;
+      g_texture_cache->FlushDeferredEFBCopies(
+          src_addr, tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE *
+                        (tmem_cfg.preload_tile_info.type != 3 ? 1 : 2));
 
       if (tmem_cfg.preload_tile_info.type != 3)
       {
@@ -512,6 +540,7 @@ void BPWritten(const BPCmd& bp)
           bytes_read = TMEM_SIZE - tmem_addr_even;
 
         Memory::CopyFromEmu(texMem + tmem_addr_even, src_addr, bytes_read);
+        TmemMirror::Invalidate(tmem_addr_even, bytes_read);
       }
       else // RGBA8 tiles (and CI14, but that might just be stupid libogc!)
       {
@@ -527,6 +556,8 @@ void BPWritten(const BPCmd& bp)
 
           memcpy(texMem + tmem_addr_even, src_ptr + bytes_read, TMEM_LINE_SIZE);
           memcpy(texMem + tmem_addr_odd, src_ptr + bytes_read + TMEM_LINE_SIZE, TMEM_LINE_SIZE);
+          TmemMirror::Invalidate(tmem_addr_even, TMEM_LINE_SIZE);
+          TmemMirror::Invalidate(tmem_addr_odd, TMEM_LINE_SIZE);
           tmem_addr_even += TMEM_LINE_SIZE;
           tmem_addr_odd += TMEM_LINE_SIZE;
           bytes_read += TMEM_LINE_SIZE * 2;
@@ -684,6 +715,7 @@ void BPWritten(const BPCmd& bp)
 // Called when loading a saved state.
 void BPReload()
 {
+  InvalidateShaderUids();
   // restore anything that goes straight to the renderer.
   // let's not risk actually replaying any writes.
   // note that PixelShaderManager is already covered since it has its own DoState.
@@ -9,3 +9,5 @@ struct BPCmd;
 void BPInit();
 void BPReload();
 void BPWritten(const BPCmd& bp);
+// Whether writing the register does something even when its value doesn't change.
+bool BPWriteHasSideEffects(int address);
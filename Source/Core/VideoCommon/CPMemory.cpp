@@ -50,7 +50,11 @@ void LoadCPReg(u32 sub_cmd, u32 value)
       VertexShaderManager::SetTexMatrixChangedB(value);
     break;
 
+  // Games set the same vertex format before most draws, which doesn't need the vertex loader
+  // to be looked up again.
   case 0x50:
+    if ((state->vtx_desc.Hex & 0x1FFFF) == value)
+      break;
     state->vtx_desc.Hex &= ~0x1FFFF;  // keep the Upper bits
     state->vtx_desc.Hex |= value;
     state->attr_dirty = 0xFF;
@@ -58,6 +62,8 @@ void LoadCPReg(u32 sub_cmd, u32 value)
     break;
 
   case 0x60:
+    if ((state->vtx_desc.Hex >> 17) == value)
+      break;
     state->vtx_desc.Hex &= 0x1FFFF;  // keep the lower 17Bits
     state->vtx_desc.Hex |= (u64)value << 17;
     state->attr_dirty = 0xFF;
@@ -66,27 +72,38 @@ void LoadCPReg(u32 sub_cmd, u32 value)
 
   case 0x70:
     ASSERT((sub_cmd & 0x0F) < 8);
+    if (state->vtx_attr[sub_cmd & 7].g0.Hex == value)
+      break;
     state->vtx_attr[sub_cmd & 7].g0.Hex = value;
     state->attr_dirty |= 1 << (sub_cmd & 7);
     break;
 
   case 0x80:
     ASSERT((sub_cmd & 0x0F) < 8);
+    if (state->vtx_attr[sub_cmd & 7].g1.Hex == value)
+      break;
     state->vtx_attr[sub_cmd & 7].g1.Hex = value;
     state->attr_dirty |= 1 << (sub_cmd & 7);
     break;
 
   case 0x90:
     ASSERT((sub_cmd & 0x0F) < 8);
+    if (state->vtx_attr[sub_cmd & 7].g2.Hex == value)
+      break;
     state->vtx_attr[sub_cmd & 7].g2.Hex = value;
     state->attr_dirty |= 1 << (sub_cmd & 7);
     break;
 
     // Pointers to vertex arrays in GC RAM
   case 0xA0:
-    state->array_bases[sub_cmd & 0xF] = value & CommandProcessor::GetPhysicalAddressMask();
+  {
+    const u32 base = value & CommandProcessor::GetPhysicalAddressMask();
+    if (state->array_bases[sub_cmd & 0xF] == base)
+      break;
+    state->array_bases[sub_cmd & 0xF] = base;
     state->bases_dirty = true;
     break;
+  }
 
   case 0xB0:
     state->array_strides[sub_cmd & 0xF] = value & 0xFF;
@@ -290,7 +290,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
     MMIO::DirectWrite<u16>(MMIO::Utils::HighPart(&fifo.CPReadPointer)));
 }
 
-void GatherPipeBursted()
+void GatherPipeBursted(u32 bursts)
 {
   SetCPStatusFromCPU();
 
@@ -313,10 +313,13 @@ void GatherPipeBursted()
   }
 
   // update the fifo pointer
-  if (fifo.CPWritePointer == fifo.CPEnd)
-    fifo.CPWritePointer = fifo.CPBase;
-  else
-    fifo.CPWritePointer += GATHER_PIPE_SIZE;
+  for (u32 i = 0; i < bursts; ++i)
+  {
+    if (fifo.CPWritePointer == fifo.CPEnd)
+      fifo.CPWritePointer = fifo.CPBase;
+    else
+      fifo.CPWritePointer += GATHER_PIPE_SIZE;
+  }
 
   if (m_CPCtrlReg.GPReadEnable && m_CPCtrlReg.GPLinkEnable)
   {
@@ -329,7 +332,7 @@ void GatherPipeBursted()
   if (fifo.bFF_HiWatermark)
     CoreTiming::ForceExceptionCheck(0);
 
-  Common::AtomicAdd(fifo.CPReadWriteDistance, GATHER_PIPE_SIZE);
+  Common::AtomicAdd(fifo.CPReadWriteDistance, bursts * GATHER_PIPE_SIZE);
 
   Fifo::RunGpu();
 
@@ -146,7 +146,8 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base);
 
 void SetCPStatusFromGPU();
 void SetCPStatusFromCPU();
-void GatherPipeBursted();
+// Called after the gather pipe wrote the given number of bursts to the FIFO.
+void GatherPipeBursted(u32 bursts);
 void UpdateInterrupts(u64 userdata);
 void UpdateInterruptsFromVideoBackend(u64 userdata);
 
@@ -85,4 +85,5 @@ struct TessellationShaderConstants
 {
   float4 tessparams;
   int4 cullparams;
+  float4 lodparams;
 };
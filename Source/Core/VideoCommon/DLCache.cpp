@@ -0,0 +1,131 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/Swap.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/DLCache.h"
+#include "VideoCommon/Fifo.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DLCache
+{
+// Entries that weren't called for this many frames are dropped.
+static const u32 MAX_UNUSED_FRAMES = 600;
+// If the cached vertices still take more memory than this after that, everything is dropped.
+static const size_t MAX_VERTEX_BYTES = 64 * 1024 * 1024;
+
+struct Entry
+{
+  u64 hash = 0;
+  u32 cycles = 0;
+  // Bytes taken by the recorded commands, a list can end in an incomplete one.
+  u32 length = 0;
+  u32 last_frame = 0;
+  std::vector<OpcodeDecoder::PreparsedCommand> commands;
+  // One per command, only used by draws.
+  std::vector<VertexLoaderManager::CachedVertices> draws;
+};
+
+static std::unordered_map<u64, Entry> s_entries;
+static u32 s_frame = 0;
+// A list can end the frame itself (e.g. with an XFB copy), its entry must survive that.
+static u32 s_running_lists = 0;
+static bool s_cleanup_pending = false;
+
+void Clear()
+{
+  s_entries.clear();
+}
+
+static void Cleanup()
+{
+  size_t vertex_bytes = 0;
+  for (auto it = s_entries.begin(); it != s_entries.end();)
+  {
+    if (s_frame - it->second.last_frame > MAX_UNUSED_FRAMES)
+    {
+      it = s_entries.erase(it);
+      continue;
+    }
+
+    for (const VertexLoaderManager::CachedVertices& draw : it->second.draws)
+      vertex_bytes += draw.data.capacity();
+    ++it;
+  }
+
+  if (vertex_bytes > MAX_VERTEX_BYTES)
+    Clear();
+}
+
+void ProgressiveCleanup()
+{
+  s_frame++;
+  if (s_running_lists)
+    s_cleanup_pending = true;
+  else
+    Cleanup();
+}
+
+static void RunEntry(Entry& entry, u64 hash, u32* cycles)
+{
+  u8* start = g_VideoData.GetReadPosition();
+  u8* end = g_VideoData.GetEnd();
+  if (entry.commands.empty() || entry.hash != hash)
+  {
+    entry.hash = hash;
+    entry.commands.clear();
+    entry.draws.clear();
+    u8* stop = OpcodeDecoder::Run<false, false>(g_VideoData, &entry.cycles, &entry.commands);
+    entry.length = u32(stop - start);
+    entry.draws.resize(entry.commands.size());
+    *cycles = entry.cycles;
+    return;
+  }
+
+  u8* stop = OpcodeDecoder::RunPreparsed(entry.commands.data(), entry.commands.size(), start,
+                                         entry.draws.data());
+  if (stop != start + entry.length)
+  {
+    // A draw's vertex format changed since the list was recorded, so the rest of the recorded
+    // command boundaries are meaningless. Interpret the rest and record it again next time.
+    g_VideoData.SetReadPosition(stop, end);
+    OpcodeDecoder::Run<false, false>(g_VideoData, nullptr);
+    entry.commands.clear();
+    entry.draws.clear();
+  }
+
+  // Nested display lists are only timed when their caller is recorded.
+  *cycles = entry.cycles;
+}
+
+bool HandleDisplayList(u32 address, u32 size, u32* cycles)
+{
+  // The deterministic GPU thread reads display lists from the aux buffer instead of RAM, and the
+  // FIFO recorder needs every command to go through the interpreter.
+  if (!g_ActiveConfig.bDisplayListCache || Fifo::UseDeterministicGPUThread() || g_bRecordFifoData)
+    return false;
+
+  const u64 hash = GetHash64(g_VideoData.GetReadPosition(), size, 0);
+  Entry& entry = s_entries[(u64(address) << 32) | size];
+  entry.last_frame = s_frame;
+
+  s_running_lists++;
+  RunEntry(entry, hash, cycles);
+  s_running_lists--;
+  if (!s_running_lists && s_cleanup_pending)
+  {
+    s_cleanup_pending = false;
+    Cleanup();
+  }
+  return true;
+}
+}  // namespace DLCache
@@ -0,0 +1,28 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Games call the same display lists over and over, usually with nothing but a few matrices
+// changed in between. The cache records the commands of a display list the first time it runs,
+// so that later calls neither decode the byte stream again nor run the vertex loader on draws
+// whose output can't have changed.
+//
+// A list is identified by its address and size, and an entry only stays in use while the hash
+// of the list's bytes matches: the emulated CPU and DMA write to RAM without telling the GPU
+// thread. Converted vertices are copied into the vertex buffer, indices are still generated
+// since they depend on where the draw ends up in the batch.
+namespace DLCache
+{
+void Clear();
+
+// Drops entries that haven't been called for a while. Called once per frame.
+void ProgressiveCleanup();
+
+// Runs the display list at address from g_VideoData, which is set to the list's bytes. Returns
+// false without doing anything if the list has to be interpreted as usual.
+bool HandleDisplayList(u32 address, u32 size, u32* cycles);
+}  // namespace DLCache
@@ -2,8 +2,10 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
 #include <atomic>
 #include <cstring>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/Atomic.h"
@@ -11,8 +13,12 @@
 #include "Common/ChunkFile.h"
 #include "Common/Event.h"
 #include "Common/FPURoundMode.h"
+#include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
+#include "Common/Timer.h"
+#include "Common/Tracing.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -26,6 +32,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoConfig.h"
@@ -70,10 +77,29 @@ static u8* s_video_buffer_pp_read_ptr;
 // polls, it's just atomic.
 // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
 
+// Commands that the CPU thread already decoded while preprocessing, in the order they appear
+// from s_video_buffer_read_ptr on. Only used with the deterministic GPU thread; the CPU thread
+// is the only producer and the GPU thread the only consumer. Both positions only ever grow.
+static constexpr size_t PREPARSED_RING_SIZE = 0x10000;
+static std::array<OpcodeDecoder::PreparsedCommand, PREPARSED_RING_SIZE> s_preparsed_commands;
+static std::atomic<size_t> s_preparsed_write_pos;
+static std::atomic<size_t> s_preparsed_read_pos;
+static std::vector<OpcodeDecoder::PreparsedCommand> s_preparsed_batch;
+
 static std::atomic<int> s_sync_ticks;
 static bool s_syncing_suspended;
 static Common::Event s_sync_wakeup_event;
 
+// How far the GPU thread may run behind (max) or ahead (min) of the CPU thread in SyncGPU mode.
+// These start out as the configured values; with bSyncGPUAdaptive the CPU thread retunes them
+// once per emulated frame from how long it had to wait for the GPU thread.
+static std::atomic<int> s_sync_max_distance;
+static std::atomic<int> s_sync_min_distance;
+static int s_sync_window_ticks;
+static int s_sync_window_peak;
+static u64 s_sync_window_start_us;
+static u64 s_sync_window_stall_us;
+
 void DoState(PointerWrap& p)
 {
   p.DoArray(s_video_buffer, FIFO_SIZE);
@@ -85,6 +111,8 @@ void DoState(PointerWrap& p)
   {
     // We're good and paused, right?
     s_video_buffer_seen_ptr = s_video_buffer_pp_read_ptr = s_video_buffer_read_ptr;
+    s_preparsed_write_pos.store(0);
+    s_preparsed_read_pos.store(0);
   }
 
   p.Do(s_sync_ticks);
@@ -119,6 +147,14 @@ void Init()
   if (SConfig::GetInstance().bCPUThread)
     s_gpu_mainloop.Prepare();
   s_sync_ticks.store(0);
+
+  s_sync_max_distance.store(SConfig::GetInstance().iSyncGpuMaxDistance);
+  s_sync_min_distance.store(SConfig::GetInstance().iSyncGpuMinDistance);
+  s_sync_window_ticks = 0;
+  s_sync_window_peak = 0;
+  s_sync_window_start_us = Common::Timer::GetTimeUs();
+  s_sync_window_stall_us = 0;
+  stats.syncGpuMaxDistance = 0;
 }
 
 void Shutdown()
@@ -162,6 +198,7 @@ void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (s_use_deterministic_gpu_thread)
   {
+    TRACE_SCOPE("Sync", "Wait for GPU thread");
     s_gpu_mainloop.Wait();
     if (!s_gpu_mainloop.IsRunning())
       return;
@@ -243,6 +280,43 @@ static void ReadDataFromFifo(u32 readPtr)
   s_video_buffer_write_ptr += len;
 }
 
+// Hands the commands of the last preprocessed chunk over to the GPU thread.
+static void PushPreparsedCommands()
+{
+  size_t write_pos = s_preparsed_write_pos.load(std::memory_order_relaxed);
+  for (const OpcodeDecoder::PreparsedCommand& command : s_preparsed_batch)
+  {
+    // The GPU thread empties the ring whenever it runs, so this only waits if it's far behind.
+    while (write_pos - s_preparsed_read_pos.load(std::memory_order_acquire) == PREPARSED_RING_SIZE)
+    {
+      if (!s_gpu_mainloop.IsRunning())
+        return;
+      s_preparsed_write_pos.store(write_pos, std::memory_order_release);
+      s_gpu_mainloop.Wakeup();
+      Common::YieldCPU();
+    }
+    s_preparsed_commands[write_pos % PREPARSED_RING_SIZE] = command;
+    write_pos++;
+  }
+  s_preparsed_write_pos.store(write_pos, std::memory_order_release);
+}
+
+// Runs every command the CPU thread has handed over so far, starting at data.
+static u8* RunPreparsedCommands(u8* data)
+{
+  size_t read_pos = s_preparsed_read_pos.load(std::memory_order_relaxed);
+  const size_t write_pos = s_preparsed_write_pos.load(std::memory_order_acquire);
+  while (read_pos != write_pos)
+  {
+    const size_t index = read_pos % PREPARSED_RING_SIZE;
+    const size_t count = std::min(write_pos - read_pos, PREPARSED_RING_SIZE - index);
+    data = OpcodeDecoder::RunPreparsed(&s_preparsed_commands[index], count, data);
+    read_pos += count;
+    s_preparsed_read_pos.store(read_pos, std::memory_order_release);
+  }
+  return data;
+}
+
 // The deterministic_gpu_thread version.
 static void ReadDataFromFifoOnCPU(u32 readPtr)
 {
@@ -274,7 +348,9 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
   }
   Memory::CopyFromEmu(s_video_buffer_write_ptr, readPtr, len);
   DataReader fifo_reader(s_video_buffer_pp_read_ptr, write_ptr + len);
-  s_video_buffer_pp_read_ptr = OpcodeDecoder::Run<true>(fifo_reader, nullptr);
+  s_preparsed_batch.clear();
+  s_video_buffer_pp_read_ptr = OpcodeDecoder::Run<true>(fifo_reader, nullptr, &s_preparsed_batch);
+  PushPreparsedCommands();
   // This would have to be locked if the GPU thread didn't spin.
   s_video_buffer_write_ptr = write_ptr + len;
 }
@@ -310,14 +386,14 @@ void RunGpuLoop()
     {
       AsyncRequests::GetInstance()->PullEvents();
 
-      // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
+      // All the fifo/CP stuff is on the CPU, which also decoded the commands while
+      // preprocessing them. We just need to run them.
       u8* seen_ptr = s_video_buffer_seen_ptr;
       u8* write_ptr = s_video_buffer_write_ptr;
       // See comment in SyncGPU
       if (write_ptr > seen_ptr)
       {
-        g_VideoData.SetReadPosition(s_video_buffer_read_ptr, write_ptr);
-        s_video_buffer_read_ptr = OpcodeDecoder::Run<false>(g_VideoData, nullptr);
+        s_video_buffer_read_ptr = RunPreparsedCommands(s_video_buffer_read_ptr);
         s_video_buffer_seen_ptr = write_ptr;
       }
     }
@@ -333,7 +409,7 @@ void RunGpuLoop()
       while (!CommandProcessor::IsInterruptWaiting() && fifo.bFF_GPReadEnable &&
         fifo.CPReadWriteDistance && !AtBreakpoint())
       {
-        if (param.bSyncGPU && s_sync_ticks.load() < param.iSyncGpuMinDistance)
+        if (param.bSyncGPU && s_sync_ticks.load() < s_sync_min_distance.load())
           break;
 
         u32 cyclesExecuted = 0;
@@ -365,8 +441,8 @@ void RunGpuLoop()
         {
           cyclesExecuted = (int)(cyclesExecuted / param.fSyncGpuOverclock);
           int old = s_sync_ticks.fetch_sub(cyclesExecuted);
-          if (old >= param.iSyncGpuMaxDistance &&
-            old - (int)cyclesExecuted < param.iSyncGpuMaxDistance)
+          const int max_distance = s_sync_max_distance.load();
+          if (old >= max_distance && old - (int)cyclesExecuted < max_distance)
             s_sync_wakeup_event.Set();
         }
 
@@ -381,7 +457,7 @@ void RunGpuLoop()
       if (s_sync_ticks.load() > 0)
       {
         int old = s_sync_ticks.exchange(0);
-        if (old >= param.iSyncGpuMaxDistance)
+        if (old >= s_sync_max_distance.load())
           s_sync_wakeup_event.Set();
       }
 
@@ -403,6 +479,7 @@ void FlushGpu()
   if (!param.bCPUThread || s_use_deterministic_gpu_thread)
     return;
 
+  TRACE_SCOPE("Sync", "Flush GPU thread");
   s_gpu_mainloop.Wait();
 }
 
@@ -521,6 +598,8 @@ void UpdateWantDeterminism(bool want)
     {
       // These haven't been updated in non-deterministic mode.
       s_video_buffer_seen_ptr = s_video_buffer_pp_read_ptr = s_video_buffer_read_ptr;
+      s_preparsed_write_pos.store(0);
+      s_preparsed_read_pos.store(0);
       CopyPreprocessCPStateFromMain();
       VertexLoaderManager::MarkAllDirty();
     }
@@ -532,6 +611,55 @@ bool UseDeterministicGPUThread()
   return s_use_deterministic_gpu_thread;
 }
 
+/* Retunes the SyncGPU distances once per emulated frame. If the CPU thread spent a noticeable
+* part of the frame waiting for the GPU thread, the GPU thread is allowed to fall further behind;
+* if it kept up with plenty of room to spare, the distance shrinks again to bring latency down.
+* The result stays within a quarter and twice the configured distance.
+* Must only be called by the CPU thread, and not while it waits for the GPU thread.
+*/
+static void UpdateSyncDistances(int ticks)
+{
+  const SConfig& param = SConfig::GetInstance();
+  if (!param.bSyncGPUAdaptive)
+    return;
+
+  s_sync_window_ticks += ticks;
+  if (s_sync_window_ticks < static_cast<int>(SystemTimers::GetTicksPerSecond() / 60))
+    return;
+
+  const u64 now_us = Common::Timer::GetTimeUs();
+  const u64 elapsed_us = std::max<u64>(now_us - s_sync_window_start_us, 1);
+  const float stall_percent = 100.0f * s_sync_window_stall_us / elapsed_us;
+
+  const int config_max = std::max(param.iSyncGpuMaxDistance, GPU_TIME_SLOT_SIZE);
+  int max_distance = s_sync_max_distance.load();
+  if (stall_percent > 5.0f)
+    max_distance += max_distance / 4;
+  else if (stall_percent < 1.0f && s_sync_window_peak * 2 < max_distance)
+    max_distance -= max_distance / 8;
+  max_distance = MathUtil::Clamp(max_distance, config_max / 4, config_max * 2);
+
+  // Keep the configured ratio between how far ahead and how far behind the GPU may be.
+  const int min_distance =
+      static_cast<int>(static_cast<s64>(param.iSyncGpuMinDistance) * max_distance / config_max);
+
+  s_sync_max_distance.store(max_distance);
+  s_sync_min_distance.store(min_distance);
+  stats.syncGpuMaxDistance = max_distance;
+  stats.syncGpuMinDistance = min_distance;
+  stats.syncGpuStallPercent = stall_percent;
+
+  s_sync_window_ticks = 0;
+  s_sync_window_peak = 0;
+  s_sync_window_start_us = now_us;
+  s_sync_window_stall_us = 0;
+
+  // A lower minimum may have let the GPU thread's budget pass it without the wakeup below
+  // ever seeing the crossing.
+  if (s_sync_ticks.load() >= min_distance)
+    RunGpu();
+}
+
 /* This function checks the emulated CPU - GPU distance and may wake up the GPU,
 * or block the CPU if required. It should be called by the CPU thread regularly.
 * @ticks The gone emulated CPU time.
@@ -539,26 +667,34 @@ bool UseDeterministicGPUThread()
 */
 static int WaitForGpuThread(int ticks)
 {
-  const SConfig& param = SConfig::GetInstance();
+  UpdateSyncDistances(ticks);
+  const int min_distance = s_sync_min_distance.load();
+  const int max_distance = s_sync_max_distance.load();
 
   int old = s_sync_ticks.fetch_add(ticks);
   int now = old + ticks;
+  s_sync_window_peak = std::max(s_sync_window_peak, now);
 
   // GPU is idle, so stop polling.
   if (old >= 0 && s_gpu_mainloop.IsDone())
     return -1;
 
   // Wakeup GPU
-  if (old < param.iSyncGpuMinDistance && now >= param.iSyncGpuMinDistance)
+  if (old < min_distance && now >= min_distance)
     RunGpu();
 
   // If the GPU is still sleeping, wait for a longer time
-  if (now < param.iSyncGpuMinDistance)
-    return GPU_TIME_SLOT_SIZE + param.iSyncGpuMinDistance - now;
+  if (now < min_distance)
+    return GPU_TIME_SLOT_SIZE + min_distance - now;
 
   // Wait for GPU
-  if (now >= param.iSyncGpuMaxDistance)
+  if (now >= max_distance)
+  {
+    TRACE_SCOPE("Sync", "SyncGPU wait");
+    const u64 start_us = Common::Timer::GetTimeUs();
     s_sync_wakeup_event.Wait();
+    s_sync_window_stall_us += Common::Timer::GetTimeUs() - start_us;
+  }
 
   return GPU_TIME_SLOT_SIZE;
 }
@@ -0,0 +1,383 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FrameBenchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include <picojson/picojson.h>
+
+#include "Common/Hash.h"
+#include "Common/Timer.h"
+
+namespace FrameBenchmark
+{
+namespace
+{
+std::mutex s_lock;
+std::atomic<bool> s_recording{false};
+std::atomic<bool> s_hashing_frames{false};
+Recording s_data;
+bool s_clocks_started = false;
+u64 s_last_end_us = 0;
+u64 s_last_thread_cpu_us = 0;
+
+struct Counter
+{
+  const char* name;
+  int Statistics::ThisFrame::*member;
+};
+
+const Counter COUNTERS[] = {
+    {"bp_loads", &Statistics::ThisFrame::numBPLoads},
+    {"cp_loads", &Statistics::ThisFrame::numCPLoads},
+    {"xf_loads", &Statistics::ThisFrame::numXFLoads},
+    {"display_lists", &Statistics::ThisFrame::numDListsCalled},
+    {"primitives", &Statistics::ThisFrame::numPrims},
+    {"primitive_joins", &Statistics::ThisFrame::numPrimitiveJoins},
+    {"draw_calls", &Statistics::ThisFrame::numDrawCalls},
+    {"shader_changes", &Statistics::ThisFrame::numShaderChanges},
+    {"vertices_loaded", &Statistics::ThisFrame::numVerticesLoaded},
+    {"triangles_in", &Statistics::ThisFrame::numTrianglesIn},
+    {"triangles_culled", &Statistics::ThisFrame::numTrianglesCulled},
+    {"triangles_clipped", &Statistics::ThisFrame::numTrianglesClipped},
+    {"triangles_rejected", &Statistics::ThisFrame::numTrianglesRejected},
+    {"triangles_drawn", &Statistics::ThisFrame::numTrianglesDrawn},
+    {"vertex_bytes_streamed", &Statistics::ThisFrame::bytesVertexStreamed},
+    {"index_bytes_streamed", &Statistics::ThisFrame::bytesIndexStreamed},
+    {"uniform_bytes_streamed", &Statistics::ThisFrame::bytesUniformStreamed},
+};
+
+// Times below this in both reports are too noisy to compare.
+constexpr double MIN_COMPARED_MS = 0.1;
+
+double GetMedian(std::vector<double> values)
+{
+  if (values.empty())
+    return 0.0;
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+Distribution GetDistribution(std::vector<double> values)
+{
+  Distribution distribution;
+  if (values.empty())
+    return distribution;
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (double value : values)
+    sum += value;
+  distribution.mean = sum / values.size();
+  distribution.median = GetMedian(values);
+  distribution.p95 = values[(values.size() * 95 + 99) / 100 - 1];
+  distribution.max = values.back();
+  return distribution;
+}
+
+double GetNumber(const picojson::object& object, const char* name)
+{
+  auto it = object.find(name);
+  return it != object.end() && it->second.is<double>() ? it->second.get<double>() : 0.0;
+}
+
+std::string GetString(const picojson::object& object, const char* name)
+{
+  auto it = object.find(name);
+  return it != object.end() && it->second.is<std::string>() ? it->second.get<std::string>() :
+                                                               std::string();
+}
+
+const picojson::object* GetObject(const picojson::object& object, const char* name)
+{
+  auto it = object.find(name);
+  return it != object.end() && it->second.is<picojson::object>() ?
+             &it->second.get<picojson::object>() :
+             nullptr;
+}
+
+const picojson::array* GetArray(const picojson::object& object, const char* name)
+{
+  auto it = object.find(name);
+  return it != object.end() && it->second.is<picojson::array>() ?
+             &it->second.get<picojson::array>() :
+             nullptr;
+}
+}  // namespace
+
+void StartRecording(bool hash_frames)
+{
+  std::lock_guard<std::mutex> guard(s_lock);
+  s_data = {};
+  s_clocks_started = false;
+  s_hashing_frames.store(hash_frames);
+  s_recording.store(true);
+}
+
+Recording StopRecording()
+{
+  std::lock_guard<std::mutex> guard(s_lock);
+  s_recording.store(false);
+  s_hashing_frames.store(false);
+  return std::move(s_data);
+}
+
+bool IsRecording()
+{
+  return s_recording.load(std::memory_order_relaxed);
+}
+
+bool IsHashingFrames()
+{
+  return s_hashing_frames.load(std::memory_order_relaxed);
+}
+
+void EndFrame()
+{
+  const u64 end_us = Common::Timer::GetTimeUs();
+  const u64 thread_cpu_us = Common::Timer::GetThreadCPUTimeUs();
+  std::lock_guard<std::mutex> guard(s_lock);
+  if (s_clocks_started)
+  {
+    FrameSample sample;
+    sample.interval_ms = (end_us - s_last_end_us) / 1000.0f;
+    sample.thread_cpu_ms = (thread_cpu_us - s_last_thread_cpu_us) / 1000.0f;
+    sample.counters = stats.thisFrame;
+    s_data.frames.push_back(sample);
+  }
+  s_clocks_started = true;
+  s_last_end_us = end_us;
+  s_last_thread_cpu_us = thread_cpu_us;
+}
+
+void AddFrameTimes(const FrameProfilerBase::FrameTimes& times)
+{
+  std::lock_guard<std::mutex> guard(s_lock);
+  s_data.times.push_back(times);
+}
+
+void AddFrame(const u8* data, int width, int height, int stride)
+{
+  u64 hash = 0;
+  for (int y = 0; y < height; y++)
+    hash = GetXXH3_64(data + static_cast<size_t>(y) * stride, static_cast<size_t>(width) * 4, hash);
+  std::lock_guard<std::mutex> guard(s_lock);
+  if (s_hashing_frames.load(std::memory_order_relaxed))
+    s_data.frame_hashes.push_back(hash);
+}
+
+RunResult Summarize(const Recording& recording)
+{
+  RunResult result;
+  result.frames = static_cast<u32>(recording.frames.size());
+  if (recording.frames.empty())
+    return result;
+
+  std::vector<double> intervals, thread_times;
+  double total_ms = 0.0;
+  for (const FrameSample& frame : recording.frames)
+  {
+    intervals.push_back(frame.interval_ms);
+    thread_times.push_back(frame.thread_cpu_ms);
+    total_ms += frame.interval_ms;
+  }
+  result.fps = total_ms > 0.0 ? result.frames * 1000.0 / total_ms : 0.0;
+  result.times["frame_interval_ms"] = GetDistribution(std::move(intervals));
+  result.times["gpu_thread_cpu_ms"] = GetDistribution(std::move(thread_times));
+
+  if (!recording.times.empty())
+  {
+    const bool has_gpu =
+        std::all_of(recording.times.begin(), recording.times.end(),
+                    [](const FrameProfilerBase::FrameTimes& times) { return times.has_gpu; });
+    for (size_t i = 0; i < FrameProfilerBase::TIME_COUNT; i++)
+    {
+      std::vector<double> cpu_ms, gpu_ms;
+      for (const FrameProfilerBase::FrameTimes& times : recording.times)
+      {
+        cpu_ms.push_back(times.cpu_ms[i]);
+        gpu_ms.push_back(times.gpu_ms[i]);
+      }
+      const std::string name = FrameProfilerBase::GetTimeLogName(i);
+      result.times["cpu_" + name + "_ms"] = GetDistribution(std::move(cpu_ms));
+      if (has_gpu)
+        result.times["gpu_" + name + "_ms"] = GetDistribution(std::move(gpu_ms));
+    }
+  }
+
+  for (const Counter& counter : COUNTERS)
+  {
+    double sum = 0.0;
+    for (const FrameSample& frame : recording.frames)
+      sum += frame.counters.*counter.member;
+    result.counters[counter.name] = sum / recording.frames.size();
+  }
+  return result;
+}
+
+std::string ToJSON(const Report& report)
+{
+  picojson::array files;
+  for (const FileResult& file : report.files)
+  {
+    picojson::array runs;
+    for (const RunResult& run : file.runs)
+    {
+      picojson::object times;
+      for (const auto& time : run.times)
+      {
+        picojson::object distribution;
+        distribution["mean"] = picojson::value(time.second.mean);
+        distribution["median"] = picojson::value(time.second.median);
+        distribution["p95"] = picojson::value(time.second.p95);
+        distribution["max"] = picojson::value(time.second.max);
+        times[time.first] = picojson::value(distribution);
+      }
+      picojson::object counters;
+      for (const auto& counter : run.counters)
+        counters[counter.first] = picojson::value(counter.second);
+
+      picojson::object run_object;
+      run_object["frames"] = picojson::value(static_cast<double>(run.frames));
+      run_object["fps"] = picojson::value(run.fps);
+      run_object["times"] = picojson::value(times);
+      run_object["counters"] = picojson::value(counters);
+      runs.emplace_back(run_object);
+    }
+
+    picojson::object file_object;
+    file_object["name"] = picojson::value(file.name);
+    file_object["frame_start"] = picojson::value(static_cast<double>(file.frame_start));
+    file_object["frame_end"] = picojson::value(static_cast<double>(file.frame_end));
+    file_object["runs"] = picojson::value(runs);
+    files.emplace_back(file_object);
+  }
+
+  picojson::object root;
+  root["revision"] = picojson::value(report.revision);
+  root["backend"] = picojson::value(report.backend);
+  root["files"] = picojson::value(files);
+  return picojson::value(root).serialize(true);
+}
+
+bool FromJSON(const std::string& json, Report* report)
+{
+  picojson::value root_value;
+  if (!picojson::parse(root_value, json).empty() || !root_value.is<picojson::object>())
+    return false;
+  const picojson::object& root = root_value.get<picojson::object>();
+  const picojson::array* files = GetArray(root, "files");
+  if (!files)
+    return false;
+
+  *report = {};
+  report->revision = GetString(root, "revision");
+  report->backend = GetString(root, "backend");
+  for (const picojson::value& file_value : *files)
+  {
+    if (!file_value.is<picojson::object>())
+      return false;
+    const picojson::object& file_object = file_value.get<picojson::object>();
+    FileResult file;
+    file.name = GetString(file_object, "name");
+    file.frame_start = static_cast<u32>(GetNumber(file_object, "frame_start"));
+    file.frame_end = static_cast<u32>(GetNumber(file_object, "frame_end"));
+    if (const picojson::array* runs = GetArray(file_object, "runs"))
+    {
+      for (const picojson::value& run_value : *runs)
+      {
+        if (!run_value.is<picojson::object>())
+          return false;
+        const picojson::object& run_object = run_value.get<picojson::object>();
+        RunResult run;
+        run.frames = static_cast<u32>(GetNumber(run_object, "frames"));
+        run.fps = GetNumber(run_object, "fps");
+        if (const picojson::object* times = GetObject(run_object, "times"))
+        {
+          for (const auto& time : *times)
+          {
+            if (!time.second.is<picojson::object>())
+              continue;
+            const picojson::object& distribution_object = time.second.get<picojson::object>();
+            Distribution& distribution = run.times[time.first];
+            distribution.mean = GetNumber(distribution_object, "mean");
+            distribution.median = GetNumber(distribution_object, "median");
+            distribution.p95 = GetNumber(distribution_object, "p95");
+            distribution.max = GetNumber(distribution_object, "max");
+          }
+        }
+        if (const picojson::object* counters = GetObject(run_object, "counters"))
+        {
+          for (const auto& counter : *counters)
+          {
+            if (counter.second.is<double>())
+              run.counters[counter.first] = counter.second.get<double>();
+          }
+        }
+        file.runs.push_back(std::move(run));
+      }
+    }
+    report->files.push_back(std::move(file));
+  }
+  return true;
+}
+
+std::vector<Regression> Compare(const Report& baseline, const Report& current,
+                                double threshold_percent)
+{
+  std::vector<Regression> regressions;
+  for (const FileResult& file : current.files)
+  {
+    auto baseline_file =
+        std::find_if(baseline.files.begin(), baseline.files.end(), [&file](const FileResult& f) {
+          return f.name == file.name && f.frame_start == file.frame_start &&
+                 f.frame_end == file.frame_end;
+        });
+    if (baseline_file == baseline.files.end() || baseline_file->runs.empty() || file.runs.empty())
+      continue;
+
+    std::vector<double> baseline_fps, current_fps;
+    for (const RunResult& run : baseline_file->runs)
+      baseline_fps.push_back(run.fps);
+    for (const RunResult& run : file.runs)
+      current_fps.push_back(run.fps);
+    const double old_fps = GetMedian(std::move(baseline_fps));
+    const double new_fps = GetMedian(std::move(current_fps));
+    const double fps_percent = old_fps > 0.0 ? (new_fps - old_fps) * 100.0 / old_fps : 0.0;
+    if (-fps_percent > threshold_percent)
+      regressions.push_back({file.name, "fps", old_fps, new_fps, fps_percent});
+
+    for (const auto& time : file.runs.front().times)
+    {
+      std::vector<double> baseline_ms, current_ms;
+      for (const RunResult& run : baseline_file->runs)
+      {
+        auto it = run.times.find(time.first);
+        if (it != run.times.end())
+          baseline_ms.push_back(it->second.mean);
+      }
+      for (const RunResult& run : file.runs)
+      {
+        auto it = run.times.find(time.first);
+        if (it != run.times.end())
+          current_ms.push_back(it->second.mean);
+      }
+      if (baseline_ms.empty())
+        continue;
+      const double old_ms = GetMedian(std::move(baseline_ms));
+      const double new_ms = GetMedian(std::move(current_ms));
+      if (std::max(old_ms, new_ms) < MIN_COMPARED_MS || old_ms <= 0.0)
+        continue;
+      const double percent = (new_ms - old_ms) * 100.0 / old_ms;
+      if (percent > threshold_percent)
+        regressions.push_back({file.name, time.first, old_ms, new_ms, percent});
+    }
+  }
+  return regressions;
+}
+}  // namespace FrameBenchmark
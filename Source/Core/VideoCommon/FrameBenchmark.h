@@ -0,0 +1,105 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/FrameProfilerBase.h"
+#include "VideoCommon/Statistics.h"
+
+// Per frame measurements of benchmark runs, like the FIFO log playback of DolphinNoGUI
+// --fifo_benchmark, and the reports made of them.
+namespace FrameBenchmark
+{
+// The first frame of a recording only starts the clocks, it gets no sample.
+struct FrameSample
+{
+  // The time since the previous frame ended on the GPU thread.
+  float interval_ms;
+  // How long the GPU thread ran in that time, as opposed to waiting.
+  float thread_cpu_ms;
+  Statistics::ThisFrame counters;
+};
+
+struct Recording
+{
+  std::vector<FrameSample> frames;
+  // The times of the frame profiler. They are read a few frames late, the last frames of a run
+  // never get them. Empty if the backend has no profiler.
+  std::vector<FrameProfilerBase::FrameTimes> times;
+  // A hash of each presented frame, if asked for. The frames are read back like frame dumps,
+  // which the backends finish a few frames late.
+  std::vector<u64> frame_hashes;
+};
+
+// Neither may be called while the emulation runs.
+void StartRecording(bool hash_frames = false);
+Recording StopRecording();
+bool IsRecording();
+bool IsHashingFrames();
+
+// The renderer calls this at the end of each frame, on the GPU thread.
+void EndFrame();
+// The frame profiler calls this when the times of a frame are known.
+void AddFrameTimes(const FrameProfilerBase::FrameTimes& times);
+// The renderer calls this with each frame it reads back while hashing frames, in RGBA8.
+void AddFrame(const u8* data, int width, int height, int stride);
+
+// The spread of a time over the frames of a run.
+struct Distribution
+{
+  double mean = 0.0;
+  double median = 0.0;
+  double p95 = 0.0;
+  double max = 0.0;
+};
+
+struct RunResult
+{
+  u32 frames = 0;
+  double fps = 0.0;
+  // In ms by name, like gpu_thread_cpu_ms or gpu_efb_copies_ms.
+  std::map<std::string, Distribution> times;
+  // The statistics counters averaged over the frames by name, like draw_calls.
+  std::map<std::string, double> counters;
+};
+
+struct FileResult
+{
+  std::string name;
+  u32 frame_start = 0;
+  u32 frame_end = 0;
+  std::vector<RunResult> runs;
+};
+
+struct Report
+{
+  std::string revision;
+  std::string backend;
+  std::vector<FileResult> files;
+};
+
+RunResult Summarize(const Recording& recording);
+
+std::string ToJSON(const Report& report);
+bool FromJSON(const std::string& json, Report* report);
+
+// A measurement of a file that got worse than in the baseline by more than the threshold. The
+// mean time of each run and the FPS are compared, taking the median over the runs.
+struct Regression
+{
+  std::string file;
+  std::string metric;
+  double baseline;
+  double current;
+  double percent;
+};
+
+std::vector<Regression> Compare(const Report& baseline, const Report& current,
+                                double threshold_percent);
+}  // namespace FrameBenchmark
@@ -0,0 +1,122 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Common/StringUtil.h"
+#include "Common/Thread.h"
+#include "Common/Timer.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/SystemTimers.h"
+#include "VideoCommon/FrameProfilerBase.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+// The last part of the wait is spun, sleeping is only accurate to about a millisecond.
+constexpr u64 SPIN_US = 1500;
+// Longer gaps are pauses, loads or frame skips, the next frame is presented right away.
+constexpr u64 MAX_PACED_FRAME_US = 100000;
+}
+
+void FramePacer::BeginFrame(u64 ticks)
+{
+  m_frame_ticks = ticks;
+  m_target_present_us = 0;
+  m_vi_ms = 0.0f;
+  m_wait_ms = 0.0f;
+
+  // Unlimited speed has no VI time to follow.
+  const float speed = SConfig::GetInstance().m_EmulationSpeed;
+  if (m_last_ticks == 0 || ticks <= m_last_ticks || speed <= 0.0f)
+    return;
+
+  const u64 vi_us = static_cast<u64>(static_cast<double>(ticks - m_last_ticks) * 1000000.0 /
+                                     SystemTimers::GetTicksPerSecond() / speed);
+  m_vi_ms = vi_us / 1000.0f;
+  if (g_ActiveConfig.bPacePresents && m_last_present_us != 0 && vi_us < MAX_PACED_FRAME_US)
+    m_target_present_us = m_last_present_us + vi_us;
+}
+
+void FramePacer::WaitForPresent()
+{
+  if (m_target_present_us == 0)
+    return;
+
+  // A late frame is presented right away and the next one is paced from it.
+  const u64 start = Common::Timer::GetTimeUs();
+  if (start >= m_target_present_us)
+    return;
+
+  if (m_target_present_us - start > SPIN_US)
+    Common::SleepCurrentThread(static_cast<int>((m_target_present_us - start - SPIN_US) / 1000));
+  while (Common::Timer::GetTimeUs() < m_target_present_us)
+    Common::YieldCPU();
+
+  m_wait_ms = (Common::Timer::GetTimeUs() - start) / 1000.0f;
+}
+
+void FramePacer::EndFrame()
+{
+  const u64 now = Common::Timer::GetTimeUs();
+  if (m_last_present_us != 0)
+  {
+    FrameTiming timing;
+    timing.present_ms = (now - m_last_present_us) / 1000.0f;
+    timing.vi_ms = m_vi_ms;
+    timing.wait_ms = m_wait_ms;
+    m_history.push_back(timing);
+    if (m_history.size() > HISTORY_SIZE)
+      m_history.pop_front();
+  }
+  m_last_present_us = now;
+  m_last_ticks = m_frame_ticks;
+}
+
+std::string FramePacer::ToString() const
+{
+  if (m_history.empty())
+    return "";
+
+  std::vector<float> present_ms;
+  present_ms.reserve(m_history.size());
+  double sum = 0.0, vi_error = 0.0, wait = 0.0;
+  for (const FrameTiming& timing : m_history)
+  {
+    present_ms.push_back(timing.present_ms);
+    sum += timing.present_ms;
+    if (timing.vi_ms > 0.0f)
+      vi_error += std::abs(timing.present_ms - timing.vi_ms);
+    wait += timing.wait_ms;
+  }
+  const double count = static_cast<double>(m_history.size());
+  const double mean = sum / count;
+  double variance = 0.0;
+  for (float ms : present_ms)
+    variance += (ms - mean) * (ms - mean);
+
+  // The 99th percentile is the slowest frame until there are a hundred of them.
+  const size_t p99 = present_ms.size() - 1 - present_ms.size() / 100;
+  std::nth_element(present_ms.begin(), present_ms.begin() + p99, present_ms.end());
+
+  std::string result = StringFromFormat(
+      "Present %6.2f ms, std dev %5.2f ms, 99%% %6.2f ms\n"
+      "Off VI  %6.2f ms, waited  %5.2f ms%s\n",
+      mean, std::sqrt(variance / count), present_ms[p99], vi_error / count, wait / count,
+      g_ActiveConfig.bPacePresents ? " (paced)" : "");
+  if (g_frame_profiler)
+  {
+    const FrameProfilerBase::FrameTimes average = g_frame_profiler->GetAverageTimes();
+    if (average.has_gpu)
+    {
+      result += StringFromFormat("GPU     %6.2f ms\n",
+                                 average.gpu_ms[FrameProfilerBase::TIME_FRAME]);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,51 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Records when each frame was presented and the emulated VI time it belongs to, and optionally
+// paces the presents to the emulated VI time. Pacing is meant for variable refresh displays, where
+// the display follows the presents instead of V-Sync.
+class FramePacer
+{
+public:
+  static constexpr size_t HISTORY_SIZE = 120;
+
+  struct FrameTiming
+  {
+    // Time between this present and the previous one.
+    float present_ms = 0.0f;
+    // Emulated VI time between the two frames, at the current emulation speed.
+    float vi_ms = 0.0f;
+    // Time waited before the present.
+    float wait_ms = 0.0f;
+  };
+
+  // Called before the frame is drawn, ticks is the CoreTiming time of the XFB copy.
+  void BeginFrame(u64 ticks);
+  // Called by the backends right before presenting, waits until the frame is due if pacing.
+  void WaitForPresent();
+  // Called after a frame was presented.
+  void EndFrame();
+
+  // Present times, their deviation and the deviation from the VI times of the last frames, with
+  // the GPU frame time from the frame profiler if it has one.
+  std::string ToString() const;
+
+private:
+  u64 m_frame_ticks = 0;
+  u64 m_last_ticks = 0;
+  u64 m_last_present_us = 0;
+  // When the current frame is due, 0 if it isn't paced.
+  u64 m_target_present_us = 0;
+  float m_vi_ms = 0.0f;
+  float m_wait_ms = 0.0f;
+  std::deque<FrameTiming> m_history;
+};
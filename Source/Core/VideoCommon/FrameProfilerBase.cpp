@@ -0,0 +1,314 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/FrameProfilerBase.h"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "Common/Assert.h"
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+
+#include "VideoCommon/FrameBenchmark.h"
+
+std::unique_ptr<FrameProfilerBase> g_frame_profiler;
+
+namespace
+{
+constexpr std::array<const char*, FrameProfilerBase::TIME_COUNT> TIME_NAMES = {
+    {"Frame", "EFB drawing", "EFB copies", "Post-processing", "Scaling", "Present"}};
+constexpr std::array<const char*, FrameProfilerBase::TIME_COUNT> TIME_LOG_NAMES = {
+    {"frame", "efb", "efb_copies", "post_processing", "scaling", "present"}};
+
+// The bars of the overlay are full at one frame at 60 FPS, the graph at two.
+constexpr float BAR_MS = 1000.0f / 60.0f;
+constexpr int BAR_WIDTH = 16;
+constexpr float GRAPH_MS = 2.0f * BAR_MS;
+constexpr char GRAPH_LEVELS[] = " .:-=+*#%@";
+
+std::string Bar(float ms)
+{
+  const int length = std::min(static_cast<int>(ms / BAR_MS * BAR_WIDTH + 0.5f), BAR_WIDTH + 1);
+  std::string bar(length, '#');
+  if (length > BAR_WIDTH)
+    bar.back() = '>';
+  bar.resize(BAR_WIDTH + 1, ' ');
+  return "[" + bar + "]";
+}
+
+char GraphLevel(float ms)
+{
+  const int max_level = static_cast<int>(sizeof(GRAPH_LEVELS)) - 2;
+  return GRAPH_LEVELS[std::min(static_cast<int>(ms / GRAPH_MS * max_level + 0.5f), max_level)];
+}
+}  // Anonymous namespace
+
+FrameProfilerBase::FrameProfilerBase() = default;
+
+FrameProfilerBase::~FrameProfilerBase() = default;
+
+const char* FrameProfilerBase::GetTimeLogName(size_t index)
+{
+  return TIME_LOG_NAMES[index];
+}
+
+void FrameProfilerBase::BeginPass(FramePass pass)
+{
+  if (!m_frame_started)
+    return;
+
+  Frame& frame = m_frames[m_current];
+  PassRecord record;
+  record.pass = pass;
+  record.parent = m_open_passes.empty() ? -1 : m_open_passes.back();
+  record.begin_timestamp = NO_TIMESTAMP;
+  record.end_timestamp = NO_TIMESTAMP;
+  record.begin_us = Common::Timer::GetTimeUs();
+  record.end_us = record.begin_us;
+
+  // Keep one timestamp for the end of the frame.
+  if (SupportsTimestamps() &&
+      frame.timestamp_count + frame.reserved_timestamps + 3 <= MAX_TIMESTAMPS)
+  {
+    record.begin_timestamp = frame.timestamp_count++;
+    frame.reserved_timestamps++;
+    WriteTimestamp(m_current, record.begin_timestamp);
+  }
+
+  m_open_passes.push_back(static_cast<int>(frame.passes.size()));
+  frame.passes.push_back(record);
+}
+
+void FrameProfilerBase::EndPass(FramePass pass)
+{
+  // The pass may have been open when the frame ended.
+  if (!m_frame_started || m_open_passes.empty())
+    return;
+
+  Frame& frame = m_frames[m_current];
+  PassRecord& record = frame.passes[m_open_passes.back()];
+  m_open_passes.pop_back();
+  DEBUG_ASSERT(record.pass == pass);
+
+  if (record.begin_timestamp != NO_TIMESTAMP)
+  {
+    record.end_timestamp = frame.timestamp_count++;
+    frame.reserved_timestamps--;
+    WriteTimestamp(m_current, record.end_timestamp);
+  }
+  record.end_us = Common::Timer::GetTimeUs();
+}
+
+void FrameProfilerBase::EndFrame(bool profile, bool log)
+{
+  if (m_frame_started)
+  {
+    while (!m_open_passes.empty())
+      EndPass(m_frames[m_current].passes[m_open_passes.back()].pass);
+
+    Frame& frame = m_frames[m_current];
+    frame.end_us = Common::Timer::GetTimeUs();
+    if (SupportsTimestamps())
+    {
+      WriteTimestamp(m_current, frame.timestamp_count++);
+      EndTimestamps(m_current);
+    }
+    frame.pending = true;
+    m_frame_started = false;
+  }
+
+  CollectFrames(log);
+  if (!log && m_log_file.is_open())
+    m_log_file.close();
+
+  if (!profile)
+  {
+    for (Frame& frame : m_frames)
+      frame.pending = false;
+    m_history.clear();
+    return;
+  }
+
+  BeginFrame();
+}
+
+void FrameProfilerBase::BeginFrame()
+{
+  m_current = (m_current + 1) % FRAME_COUNT;
+  Frame& frame = m_frames[m_current];
+  frame.number = m_frame_number++;
+  frame.pending = false;
+  frame.timestamp_count = 0;
+  frame.reserved_timestamps = 0;
+  frame.passes.clear();
+  frame.begin_us = Common::Timer::GetTimeUs();
+  if (SupportsTimestamps())
+  {
+    BeginTimestamps(m_current);
+    WriteTimestamp(m_current, frame.timestamp_count++);
+  }
+  m_frame_started = true;
+}
+
+void FrameProfilerBase::CollectFrames(bool log)
+{
+  // The oldest frame is the one after the current one in the ring.
+  for (size_t i = 1; i <= FRAME_COUNT; i++)
+  {
+    const size_t index = (m_current + i) % FRAME_COUNT;
+    Frame& frame = m_frames[index];
+    if (!frame.pending)
+      continue;
+
+    if (SupportsTimestamps())
+    {
+      m_timestamps.resize(frame.timestamp_count);
+      if (!ReadTimestamps(index, frame.timestamp_count, m_timestamps.data()))
+        break;
+      FinishFrame(frame, m_timestamps.data(), log);
+    }
+    else
+    {
+      FinishFrame(frame, nullptr, log);
+    }
+    frame.pending = false;
+  }
+}
+
+void FrameProfilerBase::FinishFrame(const Frame& frame, const u64* timestamps, bool log)
+{
+  FrameTimes times;
+  times.has_gpu = timestamps && timestamps[frame.timestamp_count - 1] > timestamps[0];
+
+  // A pass started inside another one is taken out of the time of its parent, and the passes
+  // started outside of any other one out of the time left for drawing the EFB.
+  float cpu_covered_ms = 0.0f;
+  float gpu_covered_ms = 0.0f;
+  for (const PassRecord& record : frame.passes)
+  {
+    const size_t index = TIME_FIRST_PASS + static_cast<size_t>(record.pass);
+    const size_t parent_index =
+        record.parent < 0 ?
+            TIME_COUNT :
+            TIME_FIRST_PASS + static_cast<size_t>(frame.passes[record.parent].pass);
+
+    const float cpu_ms = (record.end_us - record.begin_us) / 1000.0f;
+    times.cpu_ms[index] += cpu_ms;
+    if (parent_index == TIME_COUNT)
+      cpu_covered_ms += cpu_ms;
+    else
+      times.cpu_ms[parent_index] -= cpu_ms;
+
+    if (!times.has_gpu || record.begin_timestamp == NO_TIMESTAMP)
+      continue;
+    const float gpu_ms =
+        (timestamps[record.end_timestamp] - timestamps[record.begin_timestamp]) / 1000000.0f;
+    times.gpu_ms[index] += gpu_ms;
+    if (parent_index == TIME_COUNT)
+      gpu_covered_ms += gpu_ms;
+    else
+      times.gpu_ms[parent_index] -= gpu_ms;
+  }
+
+  times.cpu_ms[TIME_FRAME] = (frame.end_us - frame.begin_us) / 1000.0f;
+  times.cpu_ms[TIME_EFB] = std::max(times.cpu_ms[TIME_FRAME] - cpu_covered_ms, 0.0f);
+  if (times.has_gpu)
+  {
+    times.gpu_ms[TIME_FRAME] =
+        (timestamps[frame.timestamp_count - 1] - timestamps[0]) / 1000000.0f;
+    times.gpu_ms[TIME_EFB] = std::max(times.gpu_ms[TIME_FRAME] - gpu_covered_ms, 0.0f);
+  }
+
+  m_history.push_back(times);
+  if (m_history.size() > HISTORY_SIZE)
+    m_history.pop_front();
+
+  if (log)
+    LogTimes(frame.number, times);
+  if (FrameBenchmark::IsRecording())
+    FrameBenchmark::AddFrameTimes(times);
+}
+
+void FrameProfilerBase::LogTimes(u64 number, const FrameTimes& times)
+{
+  if (!m_log_file.is_open())
+  {
+    File::OpenFStream(m_log_file, File::GetUserPath(D_LOGS_IDX) + "frame_profile.csv",
+                      std::ios_base::out | std::ios_base::trunc);
+    m_log_file << "frame";
+    for (const char* name : TIME_LOG_NAMES)
+      m_log_file << ",cpu_" << name << "_ms";
+    for (const char* name : TIME_LOG_NAMES)
+      m_log_file << ",gpu_" << name << "_ms";
+    m_log_file << '\n';
+  }
+
+  m_log_file << number << std::fixed << std::setprecision(3);
+  for (float ms : times.cpu_ms)
+    m_log_file << ',' << ms;
+  for (float ms : times.gpu_ms)
+  {
+    // Leave the GPU times empty rather than claiming they took no time.
+    m_log_file << ',';
+    if (times.has_gpu)
+      m_log_file << ms;
+  }
+  m_log_file << '\n';
+}
+
+FrameProfilerBase::FrameTimes FrameProfilerBase::GetAverageTimes() const
+{
+  FrameTimes average;
+  if (m_history.empty())
+    return average;
+
+  average.has_gpu = std::all_of(m_history.begin(), m_history.end(),
+                                [](const FrameTimes& times) { return times.has_gpu; });
+  for (const FrameTimes& times : m_history)
+  {
+    for (size_t i = 0; i < TIME_COUNT; i++)
+    {
+      average.cpu_ms[i] += times.cpu_ms[i] / m_history.size();
+      if (average.has_gpu)
+        average.gpu_ms[i] += times.gpu_ms[i] / m_history.size();
+    }
+  }
+  return average;
+}
+
+std::string FrameProfilerBase::ToString() const
+{
+  if (m_history.empty())
+    return "";
+
+  const FrameTimes average = GetAverageTimes();
+  std::string result = StringFromFormat("%-16s %8s %19s %8s\n", "Frame profile", "CPU ms", "",
+                                        average.has_gpu ? "GPU ms" : "");
+  for (size_t i = 0; i < TIME_COUNT; i++)
+  {
+    result += StringFromFormat("%-16s %8.2f %s", TIME_NAMES[i], average.cpu_ms[i],
+                               Bar(average.cpu_ms[i]).c_str());
+    if (average.has_gpu)
+    {
+      result +=
+          StringFromFormat(" %8.2f %s", average.gpu_ms[i], Bar(average.gpu_ms[i]).c_str());
+    }
+    result += '\n';
+  }
+
+  // The frame times of the last frames, oldest first.
+  std::string cpu_graph, gpu_graph;
+  for (const FrameTimes& times : m_history)
+  {
+    cpu_graph += GraphLevel(times.cpu_ms[TIME_FRAME]);
+    gpu_graph += times.has_gpu ? GraphLevel(times.gpu_ms[TIME_FRAME]) : ' ';
+  }
+  result += "CPU |" + cpu_graph + "|\n";
+  if (average.has_gpu)
+    result += "GPU |" + gpu_graph + "|\n";
+  return result;
+}
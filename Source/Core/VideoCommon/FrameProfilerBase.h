@@ -0,0 +1,153 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// The passes of a frame. The time of a pass doesn't include the passes started inside of it, the
+// EFB is drawn in the time no pass covers.
+enum class FramePass : u32
+{
+  EFBCopy,
+  PostProcessing,
+  Scaling,
+  Present,
+  Count
+};
+
+// Times the passes of each frame on the GPU thread, and on the GPU with timestamp queries for
+// backends that have them. Timestamps are read a few frames later without waiting for the GPU, a
+// frame whose timestamps still aren't ready once its queries are needed again is dropped.
+class FrameProfilerBase
+{
+public:
+  static constexpr size_t FRAME_COUNT = 4;
+  // Passes past this many timestamps in a frame only get CPU times.
+  static constexpr u32 MAX_TIMESTAMPS = 128;
+  static constexpr size_t HISTORY_SIZE = 60;
+
+  enum TimeIndex : size_t
+  {
+    TIME_FRAME,
+    TIME_EFB,
+    TIME_FIRST_PASS,
+    TIME_COUNT = TIME_FIRST_PASS + static_cast<size_t>(FramePass::Count)
+  };
+
+  struct FrameTimes
+  {
+    std::array<float, TIME_COUNT> cpu_ms{};
+    std::array<float, TIME_COUNT> gpu_ms{};
+    bool has_gpu = false;
+  };
+
+  FrameProfilerBase();
+  virtual ~FrameProfilerBase();
+
+  // The name of a time in the log and in benchmark reports, like efb_copies.
+  static const char* GetTimeLogName(size_t index);
+
+  // Whether the passes of the current frame are timed.
+  bool IsActive() const { return m_frame_started; }
+
+  void BeginPass(FramePass pass);
+  void EndPass(FramePass pass);
+  // Ends the frame after it was presented and collects the times of the frames the GPU finished.
+  // Times the next frame if profile is set, log appends the finished frames to
+  // User/Logs/frame_profile.csv.
+  void EndFrame(bool profile, bool log);
+
+  // The averages of the last frames, GPU times only if all of them have some.
+  FrameTimes GetAverageTimes() const;
+  // The overlay, the averages and a graph of the last frames.
+  std::string ToString() const;
+
+protected:
+  // Backends with timestamp queries override these, frame is the slot in the ring.
+  virtual bool SupportsTimestamps() const { return false; }
+  // Called before the first timestamp of a frame, its earlier timestamps were read or dropped.
+  virtual void BeginTimestamps(size_t frame) {}
+  virtual void WriteTimestamp(size_t frame, u32 index) {}
+  // Called after the last timestamp of a frame.
+  virtual void EndTimestamps(size_t frame) {}
+  // Reads the first count timestamps of a frame in nanoseconds without waiting. Returns false if
+  // they aren't ready, and fills in zeros if they can't be compared.
+  virtual bool ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns) { return false; }
+
+private:
+  static constexpr u32 NO_TIMESTAMP = 0xFFFFFFFF;
+
+  struct PassRecord
+  {
+    FramePass pass;
+    // The pass this one was started in, -1 for none.
+    int parent;
+    u32 begin_timestamp;
+    u32 end_timestamp;
+    u64 begin_us;
+    u64 end_us;
+  };
+
+  struct Frame
+  {
+    u64 number = 0;
+    bool pending = false;
+    u32 timestamp_count = 0;
+    // The end timestamps of the open passes.
+    u32 reserved_timestamps = 0;
+    u64 begin_us = 0;
+    u64 end_us = 0;
+    std::vector<PassRecord> passes;
+  };
+
+  void BeginFrame();
+  void CollectFrames(bool log);
+  void FinishFrame(const Frame& frame, const u64* timestamps, bool log);
+  void LogTimes(u64 number, const FrameTimes& times);
+
+  std::array<Frame, FRAME_COUNT> m_frames;
+  size_t m_current = 0;
+  bool m_frame_started = false;
+  u64 m_frame_number = 0;
+  std::vector<int> m_open_passes;
+  std::vector<u64> m_timestamps;
+
+  std::deque<FrameTimes> m_history;
+  std::ofstream m_log_file;
+};
+
+extern std::unique_ptr<FrameProfilerBase> g_frame_profiler;
+
+// Times a pass until it goes out of scope, if the current frame is profiled.
+class FramePassScope
+{
+public:
+  explicit FramePassScope(FramePass pass)
+      : m_pass(pass), m_active(g_frame_profiler && g_frame_profiler->IsActive())
+  {
+    if (m_active)
+      g_frame_profiler->BeginPass(m_pass);
+  }
+  ~FramePassScope()
+  {
+    if (m_active)
+      g_frame_profiler->EndPass(m_pass);
+  }
+
+  FramePassScope(const FramePassScope&) = delete;
+  FramePassScope& operator=(const FramePassScope&) = delete;
+
+private:
+  FramePass m_pass;
+  bool m_active;
+};
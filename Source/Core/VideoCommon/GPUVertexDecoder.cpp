@@ -0,0 +1,568 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Core/HW/Memmap.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/GPUVertexDecoder.h"
+#include "VideoCommon/VertexLoaderBase.h"
+
+namespace GPUVertexDecoder
+{
+static const char vulkan_header[] = R"(
+layout(local_size_x = 64) in;
+
+UBO_BINDING(std140, 0) uniform DecoderConstants
+{
+  uvec4 params;
+  uvec4 array_base[3];
+  uvec4 array_stride[3];
+  vec4 array_scale[3];
+} constants;
+#define u_src_offset (constants.params.x)
+#define u_dst_offset (constants.params.y)
+#define u_count (constants.params.z)
+#define u_matrix_index (constants.params.w)
+#define ARRAY_BASE(i) (constants.array_base[(i) / 4][(i) % 4])
+#define ARRAY_STRIDE(i) (constants.array_stride[(i) / 4][(i) % 4])
+#define ARRAY_SCALE(i) (constants.array_scale[(i) / 4][(i) % 4])
+
+TEXEL_BUFFER_BINDING(0) uniform usamplerBuffer s_input_buffer;
+IMAGE_BINDING(r32ui, 1) uniform writeonly uimageBuffer output_buffer;
+
+uint ReadU8(uint pos)
+{
+  return texelFetch(s_input_buffer, int(pos)).x;
+}
+
+void WriteU32(uint pos, uint value)
+{
+  imageStore(output_buffer, int(pos), uvec4(value, 0u, 0u, 0u));
+}
+)";
+
+static const char vulkan_footer[] = R"(
+void main()
+{
+  if (gl_GlobalInvocationID.x < u_count)
+    DecodeVertex(gl_GlobalInvocationID.x);
+}
+)";
+
+// Everything below only needs ReadU8 and WriteU32 from the API's header. The input is big endian,
+// like in memory.
+static const char common_functions[] = R"(
+uint ReadU16(uint pos)
+{
+  return (ReadU8(pos) << 8) | ReadU8(pos + 1u);
+}
+
+uint ReadU32(uint pos)
+{
+  return (ReadU16(pos) << 16) | ReadU16(pos + 2u);
+}
+
+float ReadUByte(uint pos)
+{
+  return float(ReadU8(pos));
+}
+
+float ReadByte(uint pos)
+{
+  return float(int(ReadU8(pos) << 24) >> 24);
+}
+
+float ReadUShort(uint pos)
+{
+  return float(ReadU16(pos));
+}
+
+float ReadShort(uint pos)
+{
+  return float(int(ReadU16(pos) << 16) >> 16);
+}
+
+float ReadFloat(uint pos)
+{
+  return uintBitsToFloat(ReadU32(pos));
+}
+
+void WriteFloat(uint pos, float value)
+{
+  WriteU32(pos, floatBitsToUint(value));
+}
+
+// Colors are written as RGBA8, the first component in the lowest byte.
+uint Convert4To8(uint v)
+{
+  return (v << 4) | v;
+}
+
+uint Convert5To8(uint v)
+{
+  return (v << 3) | (v >> 2);
+}
+
+uint Convert6To8(uint v)
+{
+  return (v << 2) | (v >> 4);
+}
+
+uint ReadColor565(uint pos)
+{
+  uint v = ReadU16(pos);
+  return Convert5To8(v >> 11) | (Convert6To8((v >> 5) & 0x3Fu) << 8) |
+         (Convert5To8(v & 0x1Fu) << 16) | 0xFF000000u;
+}
+
+uint ReadColor888(uint pos)
+{
+  return ReadU8(pos) | (ReadU8(pos + 1u) << 8) | (ReadU8(pos + 2u) << 16) | 0xFF000000u;
+}
+
+uint ReadColor8888(uint pos)
+{
+  return ReadU8(pos) | (ReadU8(pos + 1u) << 8) | (ReadU8(pos + 2u) << 16) |
+         (ReadU8(pos + 3u) << 24);
+}
+
+uint ReadColor4444(uint pos)
+{
+  uint v = ReadU16(pos);
+  return Convert4To8(v >> 12) | (Convert4To8((v >> 8) & 0xFu) << 8) |
+         (Convert4To8((v >> 4) & 0xFu) << 16) | (Convert4To8(v & 0xFu) << 24);
+}
+
+uint ReadColor6666(uint pos)
+{
+  uint v = (ReadU8(pos) << 16) | (ReadU8(pos + 1u) << 8) | ReadU8(pos + 2u);
+  return Convert6To8(v >> 18) | (Convert6To8((v >> 12) & 0x3Fu) << 8) |
+         (Convert6To8((v >> 6) & 0x3Fu) << 16) | (Convert6To8(v & 0x3Fu) << 24);
+}
+)";
+
+static std::string FloatConstant(float value)
+{
+  u32 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return StringFromFormat(" * uintBitsToFloat(0x%08Xu)", bits);
+}
+
+namespace
+{
+// Emits the conversion of one vertex in the order and layout of VertexLoaderX64.
+class ShaderGenerator
+{
+public:
+  ShaderGenerator(const TVtxDesc& vtx_desc, const TVtxAttr& vtx_attr, Format* format)
+      : m_VtxDesc(vtx_desc), m_VtxAttr(vtx_attr), m_format(format)
+  {
+    std::memset(&m_native_vtx_decl, 0, sizeof(m_native_vtx_decl));
+  }
+
+  // Returns false for formats the CPU loaders treat in ways that aren't worth reproducing.
+  bool Generate();
+
+  const std::string& GetCode() const { return m_code; }
+  const PortableVertexDeclaration& GetDeclaration() const { return m_native_vtx_decl; }
+
+private:
+  void LoadAddress(int array, u64 attribute, u32 read_offset);
+  void ReadVertex(u64 attribute, int format, int count_in, int count_out, const std::string& scale,
+                  AttributeFormat* native_format);
+  void ReadColor(u64 attribute, int format, AttributeFormat* native_format);
+
+  const TVtxDesc& m_VtxDesc;
+  const TVtxAttr& m_VtxAttr;
+  Format* m_format;
+  std::string m_code;
+  PortableVertexDeclaration m_native_vtx_decl;
+
+  u32 m_src_ofs = 0;
+  u32 m_dst_ofs = 0;
+  // The current attribute's entry in m_format->arrays, or -1 if it is direct.
+  int m_indexed_array = -1;
+  // Where the current attribute's next vector starts, relative to addr.
+  u32 m_addr_ofs = 0;
+};
+}  // namespace
+
+// Makes addr point to the attribute. read_offset is added for the later vectors of NBT normals.
+void ShaderGenerator::LoadAddress(int array, u64 attribute, u32 read_offset)
+{
+  if (!(attribute & INDEX8))
+  {
+    m_code += StringFromFormat("  addr = src + %uu;\n", m_src_ofs);
+    m_indexed_array = -1;
+    m_addr_ofs = 0;
+    return;
+  }
+
+  const u32 index_size = attribute == INDEX8 ? 1 : 2;
+  m_code += StringFromFormat("  addr = ARRAY_BASE(%d) + %s(src + %uu) * ARRAY_STRIDE(%d);\n", array,
+                             index_size == 1 ? "ReadU8" : "ReadU16", m_src_ofs, array);
+
+  auto iter = std::find_if(m_format->arrays.begin(), m_format->arrays.end(),
+                           [array](const IndexedArray& a) { return a.array == array; });
+  if (iter == m_format->arrays.end())
+  {
+    m_format->arrays.push_back({array, index_size, {}, 0, 0});
+    iter = m_format->arrays.end() - 1;
+  }
+  iter->index_offsets[iter->num_indices++] = m_src_ofs;
+  m_src_ofs += index_size;
+  m_indexed_array = static_cast<int>(iter - m_format->arrays.begin());
+  m_addr_ofs = read_offset;
+}
+
+void ShaderGenerator::ReadVertex(u64 attribute, int format, int count_in, int count_out,
+                                 const std::string& scale, AttributeFormat* native_format)
+{
+  static const char* const readers[] = {"ReadUByte", "ReadByte", "ReadUShort", "ReadShort",
+                                        "ReadFloat"};
+  const u32 elem_size = 1 << (format / 2);
+  const u32 load_bytes = elem_size * count_in;
+
+  native_format->components = count_out;
+  native_format->enable = true;
+  native_format->offset = m_dst_ofs;
+  native_format->type = FORMAT_FLOAT;
+
+  for (int i = 0; i < count_out; i++)
+  {
+    const u32 dst = m_dst_ofs / sizeof(u32) + i;
+    if (i < count_in)
+    {
+      m_code += StringFromFormat("  WriteFloat(dst + %uu, %s(addr + %uu)%s);\n", dst,
+                                 readers[format], m_addr_ofs + i * elem_size, scale.c_str());
+    }
+    else
+    {
+      m_code += StringFromFormat("  WriteFloat(dst + %uu, 0.0);\n", dst);
+    }
+  }
+  m_dst_ofs += sizeof(float) * count_out;
+
+  if (m_indexed_array >= 0)
+  {
+    IndexedArray& indexed = m_format->arrays[m_indexed_array];
+    indexed.read_size = std::max(indexed.read_size, m_addr_ofs + load_bytes);
+  }
+  else
+  {
+    m_src_ofs += load_bytes;
+  }
+  m_addr_ofs += load_bytes;
+}
+
+void ShaderGenerator::ReadColor(u64 attribute, int format, AttributeFormat* native_format)
+{
+  static const char* const readers[] = {"ReadColor565",  "ReadColor888",  "ReadColor888",
+                                        "ReadColor4444", "ReadColor6666", "ReadColor8888"};
+  static const u32 load_bytes[] = {2, 3, 4, 2, 3, 4};
+
+  native_format->components = 4;
+  native_format->enable = true;
+  native_format->offset = m_dst_ofs;
+  native_format->type = FORMAT_UBYTE;
+
+  m_code += StringFromFormat("  WriteU32(dst + %uu, %s(addr));\n", m_dst_ofs / u32(sizeof(u32)),
+                             readers[format]);
+  m_dst_ofs += sizeof(u32);
+
+  if (m_indexed_array >= 0)
+    m_format->arrays[m_indexed_array].read_size = load_bytes[format];
+  else
+    m_src_ofs += load_bytes[format];
+}
+
+bool ShaderGenerator::Generate()
+{
+  if (m_VtxAttr.PosFormat > FORMAT_FLOAT || m_VtxAttr.NormalFormat > FORMAT_FLOAT)
+    return false;
+
+  m_code += "  uint addr;\n";
+
+  if (m_VtxDesc.PosMatIdx)
+    m_src_ofs++;
+
+  u32 texmatidx_ofs[8];
+  const u64 tm[8] = {
+      m_VtxDesc.Tex0MatIdx, m_VtxDesc.Tex1MatIdx, m_VtxDesc.Tex2MatIdx, m_VtxDesc.Tex3MatIdx,
+      m_VtxDesc.Tex4MatIdx, m_VtxDesc.Tex5MatIdx, m_VtxDesc.Tex6MatIdx, m_VtxDesc.Tex7MatIdx,
+  };
+  for (int i = 0; i < 8; i++)
+  {
+    if (tm[i])
+      texmatidx_ofs[i] = m_src_ofs++;
+  }
+
+  const bool dequantize_position = m_VtxAttr.ByteDequant && m_VtxAttr.PosFormat != FORMAT_FLOAT;
+  LoadAddress(ARRAY_POSITION, m_VtxDesc.Position, 0);
+  ReadVertex(m_VtxDesc.Position, m_VtxAttr.PosFormat, m_VtxAttr.PosElements + 2, 3,
+             dequantize_position ? " * ARRAY_SCALE(0)" : "", &m_native_vtx_decl.position);
+
+  if (m_VtxDesc.Normal)
+  {
+    // The CPU loaders advance past direct normals twice with NormalIndex3. No game should do
+    // that, the hardware ignores NormalIndex3 for direct normals.
+    if (m_VtxDesc.Normal == DIRECT && m_VtxAttr.NormalIndex3 && m_VtxAttr.NormalElements)
+      return false;
+
+    static const float normal_scales[] = {1.0f / (1 << 7), 1.0f / (1 << 6), 1.0f / (1 << 15),
+                                          1.0f / (1 << 14)};
+    const std::string scale = m_VtxAttr.NormalFormat == FORMAT_FLOAT ?
+                                  "" :
+                                  FloatConstant(normal_scales[m_VtxAttr.NormalFormat]);
+    const u32 elem_size = 1 << (m_VtxAttr.NormalFormat / 2);
+    for (int i = 0; i < (m_VtxAttr.NormalElements ? 3 : 1); i++)
+    {
+      if (!i || m_VtxAttr.NormalIndex3)
+        LoadAddress(ARRAY_NORMAL, m_VtxDesc.Normal, i * elem_size * 3);
+      ReadVertex(m_VtxDesc.Normal, m_VtxAttr.NormalFormat, 3, 3, scale,
+                 &m_native_vtx_decl.normals[i]);
+    }
+  }
+
+  const u64 col[2] = {m_VtxDesc.Color0, m_VtxDesc.Color1};
+  for (int i = 0; i < 2; i++)
+  {
+    if (!col[i])
+      continue;
+    if (m_VtxAttr.color[i].Comp > FORMAT_32B_8888)
+      return false;
+    LoadAddress(ARRAY_COLOR + i, col[i], 0);
+    ReadColor(col[i], m_VtxAttr.color[i].Comp, &m_native_vtx_decl.colors[i]);
+  }
+
+  const u64 tc[8] = {
+      m_VtxDesc.Tex0Coord, m_VtxDesc.Tex1Coord, m_VtxDesc.Tex2Coord, m_VtxDesc.Tex3Coord,
+      m_VtxDesc.Tex4Coord, m_VtxDesc.Tex5Coord, m_VtxDesc.Tex6Coord, m_VtxDesc.Tex7Coord,
+  };
+  for (int i = 0; i < 8; i++)
+  {
+    const int format = m_VtxAttr.texCoord[i].Format;
+    const int elements = m_VtxAttr.texCoord[i].Elements + 1;
+    if (tc[i])
+    {
+      if (format > FORMAT_FLOAT)
+        return false;
+      const bool dequantize = m_VtxAttr.ByteDequant && format != FORMAT_FLOAT;
+      LoadAddress(ARRAY_TEXCOORD0 + i, tc[i], 0);
+      ReadVertex(tc[i], format, elements, tm[i] ? 2 : elements,
+                 dequantize ? StringFromFormat(" * ARRAY_SCALE(%d)", ARRAY_TEXCOORD0 + i) : "",
+                 &m_native_vtx_decl.texcoords[i]);
+    }
+    if (tm[i])
+    {
+      // The texture matrix index goes into z, after two coordinates or none at all.
+      AttributeFormat& native_format = m_native_vtx_decl.texcoords[i];
+      native_format.components = 3;
+      native_format.enable = true;
+      native_format.type = FORMAT_FLOAT;
+      u32 dst = m_dst_ofs / sizeof(u32);
+      if (!tc[i])
+      {
+        native_format.offset = m_dst_ofs;
+        m_code += StringFromFormat("  WriteFloat(dst + %uu, 0.0);\n", dst++);
+        m_code += StringFromFormat("  WriteFloat(dst + %uu, 0.0);\n", dst++);
+        m_dst_ofs += sizeof(float) * 2;
+      }
+      m_code += StringFromFormat("  WriteFloat(dst + %uu, float(ReadU8(src + %uu)));\n", dst,
+                                 texmatidx_ofs[i]);
+      m_dst_ofs += sizeof(float);
+    }
+  }
+
+  if (m_VtxDesc.PosMatIdx)
+  {
+    m_code += StringFromFormat("  WriteU32(dst + %uu, ReadU8(src) & 0x3Fu);\n",
+                               m_dst_ofs / u32(sizeof(u32)));
+  }
+  else
+  {
+    m_code += StringFromFormat("  WriteU32(dst + %uu, u_matrix_index & 0x3Fu);\n",
+                               m_dst_ofs / u32(sizeof(u32)));
+  }
+  m_native_vtx_decl.posmtx.components = 4;
+  m_native_vtx_decl.posmtx.enable = true;
+  m_native_vtx_decl.posmtx.offset = m_dst_ofs;
+  m_native_vtx_decl.posmtx.type = FORMAT_UBYTE;
+  m_dst_ofs += sizeof(u32);
+
+  m_native_vtx_decl.stride = m_dst_ofs;
+  m_format->vertex_size = m_src_ofs;
+  m_format->native_stride = m_dst_ofs;
+  return true;
+}
+
+static bool SameAttribute(const AttributeFormat& a, const AttributeFormat& b)
+{
+  if (a.enable != b.enable)
+    return false;
+  return !a.enable || (a.type == b.type && a.components == b.components && a.offset == b.offset);
+}
+
+static bool SameLayout(const PortableVertexDeclaration& a, const PortableVertexDeclaration& b)
+{
+  bool same = a.stride == b.stride && SameAttribute(a.position, b.position) &&
+              SameAttribute(a.posmtx, b.posmtx);
+  for (int i = 0; i < 3; i++)
+    same = same && SameAttribute(a.normals[i], b.normals[i]);
+  for (int i = 0; i < 2; i++)
+    same = same && SameAttribute(a.colors[i], b.colors[i]);
+  for (int i = 0; i < 8; i++)
+    same = same && SameAttribute(a.texcoords[i], b.texcoords[i]);
+  return same;
+}
+
+Format GetFormat(const VertexLoaderBase& loader, API_TYPE api_type)
+{
+  Format format;
+  if (api_type != API_VULKAN)
+    return format;
+
+  ShaderGenerator generator(loader.GetVtxDesc(), loader.GetVtxAttr(), &format);
+  if (!generator.Generate() || format.vertex_size != static_cast<u32>(loader.m_VertexSize) ||
+      !SameLayout(generator.GetDeclaration(), loader.m_native_vtx_decl))
+  {
+    return Format();
+  }
+
+  format.shader_source = vulkan_header;
+  format.shader_source += common_functions;
+  format.shader_source += StringFromFormat("\nvoid DecodeVertex(uint vertex)\n"
+                                           "{\n"
+                                           "  uint src = u_src_offset + vertex * %uu;\n"
+                                           "  uint dst = u_dst_offset + vertex * %uu;\n",
+                                           format.vertex_size, format.native_stride / 4);
+  format.shader_source += generator.GetCode();
+  format.shader_source += "}\n";
+  format.shader_source += vulkan_footer;
+  return format;
+}
+
+// Memory::GetPointer complains about bad addresses, while the CPU loaders read whatever is mapped
+// there. Only copy from actual RAM and leave everything else to the CPU.
+static bool IsInRAM(const u8* begin, size_t size)
+{
+  const auto inside = [begin, size](const u8* memory, size_t memory_size) {
+    return memory && begin >= memory && size <= memory_size &&
+           static_cast<size_t>(begin - memory) <= memory_size - size;
+  };
+  return inside(Memory::m_pRAM, Memory::REALRAM_SIZE) ||
+         inside(Memory::m_pEXRAM, Memory::EXRAM_SIZE);
+}
+
+bool PrepareDraw(const Format& format, const VertexLoaderParameters& parameters, u32 dst_offset,
+                 size_t max_data_size, std::vector<u8>* data, Constants* constants)
+{
+  const u32 count = static_cast<u32>(parameters.count);
+  const u8* source = parameters.source;
+  const size_t old_size = data->size();
+  size_t size = old_size + count * format.vertex_size;
+  if (size > max_data_size)
+    return false;
+
+  struct Range
+  {
+    u32 min;
+    u32 max;
+  };
+  std::array<Range, NUM_ARRAYS> ranges;
+  for (const IndexedArray& array : format.arrays)
+  {
+    Range range = {UINT32_MAX, 0};
+    for (u32 i = 0; i < count; i++)
+    {
+      const u8* vertex = source + i * format.vertex_size;
+      for (u32 j = 0; j < array.num_indices; j++)
+      {
+        const u8* index_ptr = vertex + array.index_offsets[j];
+        const u32 index = array.index_size == 1 ? *index_ptr : Common::swap16(index_ptr);
+        range.min = std::min(range.min, index);
+        range.max = std::max(range.max, index);
+      }
+    }
+
+    // A position index of all ones skips the vertex, which the shader can't do.
+    const u32 skip_index = array.index_size == 1 ? 0xFF : 0xFFFF;
+    if (array.array == ARRAY_POSITION && range.max == skip_index)
+      return false;
+
+    const u32 stride = g_main_cp_state.array_strides[array.array];
+    const u8* begin = cached_arraybases[array.array] + range.min * stride;
+    const size_t read_size = (range.max - range.min) * stride + array.read_size;
+    if (!IsInRAM(begin, read_size))
+      return false;
+
+    ranges[array.array] = range;
+    size += read_size;
+    if (size > max_data_size)
+      return false;
+  }
+
+  data->resize(size);
+  u8* dst = data->data() + old_size;
+  std::memcpy(dst, source, count * format.vertex_size);
+  dst += count * format.vertex_size;
+
+  std::memset(constants, 0, sizeof(*constants));
+  constants->src_offset = static_cast<u32>(old_size);
+  constants->dst_offset = dst_offset;
+  constants->count = count;
+  constants->matrix_index = g_main_cp_state.matrix_index_a.Hex;
+  for (const IndexedArray& array : format.arrays)
+  {
+    const Range& range = ranges[array.array];
+    const u32 stride = g_main_cp_state.array_strides[array.array];
+    const size_t read_size = (range.max - range.min) * stride + array.read_size;
+    std::memcpy(dst, cached_arraybases[array.array] + range.min * stride, read_size);
+
+    // Unsigned wraparound makes base + index * stride land in the copy for every used index.
+    constants->array_base[array.array] =
+        static_cast<u32>(dst - data->data()) - range.min * stride;
+    constants->array_stride[array.array] = stride;
+    dst += read_size;
+  }
+
+  const VAT& vat = *parameters.VtxAttr;
+  constants->array_scale[ARRAY_POSITION] = fractionTable[vat.g0.PosFrac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 0] = fractionTable[vat.g0.Tex0Frac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 1] = fractionTable[vat.g1.Tex1Frac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 2] = fractionTable[vat.g1.Tex2Frac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 3] = fractionTable[vat.g1.Tex3Frac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 4] = fractionTable[vat.g2.Tex4Frac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 5] = fractionTable[vat.g2.Tex5Frac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 6] = fractionTable[vat.g2.Tex6Frac];
+  constants->array_scale[ARRAY_TEXCOORD0 + 7] = fractionTable[vat.g2.Tex7Frac];
+  return true;
+}
+
+void DecodeSlopeVertices(VertexLoaderBase* loader, const VertexLoaderParameters& parameters)
+{
+  // The first vertex is part of every triangle of a fan, the last four cover the last triangle
+  // of every other primitive.
+  VertexLoaderParameters vertex = parameters;
+  vertex.count = 1;
+  s32 decoded = 0;
+  for (int i = 0; i < parameters.count; i = (i == 0 ? std::max(1, parameters.count - 4) : i + 1))
+  {
+    vertex.source = parameters.source + i * loader->m_VertexSize;
+    vertex.destination = parameters.destination + i * loader->m_native_stride;
+    loader->RunVertices(vertex);
+    decoded++;
+  }
+
+  // Keep the loader's statistics as if it had converted the whole draw.
+  loader->m_numLoadedVertices += parameters.count - decoded;
+}
+}  // namespace GPUVertexDecoder
@@ -0,0 +1,81 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/VideoCommon.h"
+
+class VertexLoaderBase;
+struct VertexLoaderParameters;
+
+// Converts the vertices of large draws to the native vertex format with a compute shader that
+// writes straight into the backend's vertex buffer, instead of running the CPU vertex loader.
+//
+// A draw's raw vertices are uploaded together with the parts of the vertex arrays that its
+// indices point to. The shader produces exactly the layout of the CPU loader for the same format,
+// so a batch can mix draws converted either way. The CPU loader is still used for small draws,
+// for formats the shader generator doesn't handle, and whenever the converted vertices are needed
+// on the CPU: bounding box emulation on the CPU and position indices that skip vertices.
+namespace GPUVertexDecoder
+{
+// Below this, converting on the CPU is cheaper than uploading and dispatching.
+constexpr int MIN_VERTICES = 1024;
+constexpr u32 WORKGROUP_SIZE = 64;
+constexpr int NUM_ARRAYS = 12;
+
+// Matches the std140 uniform block in the shader header.
+struct Constants
+{
+  u32 src_offset;  // Bytes into the input buffer.
+  u32 dst_offset;  // 32-bit words into the vertex buffer.
+  u32 count;
+  u32 matrix_index;
+  u32 array_base[NUM_ARRAYS];  // Bytes into the input buffer, for index 0.
+  u32 array_stride[NUM_ARRAYS];
+  float array_scale[NUM_ARRAYS];  // Dequantization factors of the position and texcoords.
+};
+
+// An indexed attribute, whose used range of the vertex array has to be uploaded.
+struct IndexedArray
+{
+  int array;
+  u32 index_size;
+  // Offsets of the indices in a raw vertex, normals with NormalIndex3 have one per vector.
+  u32 index_offsets[3];
+  u32 num_indices;
+  // Bytes read after index * stride.
+  u32 read_size;
+};
+
+struct Format
+{
+  // Empty if the shader generator can't reproduce the loader's output for this format.
+  std::string shader_source;
+  u32 vertex_size = 0;
+  u32 native_stride = 0;
+  std::vector<IndexedArray> arrays;
+};
+
+Format GetFormat(const VertexLoaderBase& loader, API_TYPE api_type);
+
+// Appends the draw's input to data and fills in constants, with offsets relative to the start of
+// data and dst_offset. Leaves data alone and returns false if the draw has to be converted on the
+// CPU, or if data would grow beyond max_data_size.
+bool PrepareDraw(const Format& format, const VertexLoaderParameters& parameters, u32 dst_offset,
+                 size_t max_data_size, std::vector<u8>* data, Constants* constants);
+
+// The depth slope for zfreeze is calculated from the last triangle of a batch, which is read from
+// the CPU's copy of the vertices. Converts the vertices that can belong to the last triangle of a
+// draw on the CPU, so that the copy is valid for them.
+void DecodeSlopeVertices(VertexLoaderBase* loader, const VertexLoaderParameters& parameters);
+
+inline u32 GetDispatchCount(u32 count)
+{
+  return (count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+}
+}  // namespace GPUVertexDecoder
@@ -1,16 +1,13 @@
 // Copyright 2013 Dolphin Emulator Project
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
-
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
 #include "VideoCommon/G_GB4P51_pvt.h"
 #include "VideoCommon/VertexLoader_Template.h"
 
-
-
 void G_GB4P51_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
 {
-  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s8_T0_mtx0_1_I16_s16_
-// num_verts= 139264034
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s8_T0_mtx0_1_I16_s16_ num_verts= 139264034
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1,16 +1,13 @@
 // Copyright 2013 Dolphin Emulator Project
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
-
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
 #include "VideoCommon/G_GNUEDA_pvt.h"
 #include "VideoCommon/VertexLoader_Template.h"
 
-
-
 void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
 {
-  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_flt_
-// num_verts= 16423699
+  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_flt_ num_verts= 16423699
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -21,8 +18,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21316665904952] = TemplatedLoader<0, 0x00030f00u, 0x41201009u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_C0_1_I16_8888_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_
-// num_verts= 3148318
+  // P_mtx0_3_I16_flt_C0_1_I16_8888_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_ num_verts= 3148318
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -33,8 +29,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[23069966952457] = TemplatedLoader<0, 0x000f3300u, 0x41216009u, 0x00000009u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_
-// num_verts= 3032380
+  // P_mtx0_3_I16_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_ num_verts= 3032380
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -45,8 +40,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22194097903625] = TemplatedLoader<0, 0x000a0300u, 0x41200009u, 0x00000009u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_T0_mtx0_1_I8_flt_
-// num_verts= 1457768
+  // P_mtx0_3_I16_flt_T0_mtx0_1_I8_flt_ num_verts= 1457768
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -57,8 +51,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20845968380728] = TemplatedLoader<0, 0x00020300u, 0x41200009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_
-// num_verts= 1414283
+  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_ num_verts= 1414283
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -69,8 +62,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20456864321336] = TemplatedLoader<0, 0x00000f00u, 0x40001009u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_2_Dir_s16_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_
-// num_verts= 254612
+  // P_mtx0_2_Dir_s16_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_ num_verts= 254612
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -81,8 +73,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20688359175493] = TemplatedLoader<0, 0x00011100u, 0x41216006u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_Dir_s8_C0_1_Dir_8888_T0_mtx0_1_Dir_u8_
-// num_verts= 145692
+  // P_mtx0_2_Dir_s8_C0_1_Dir_8888_T0_mtx0_1_Dir_u8_ num_verts= 145692
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -93,8 +84,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20373467533313] = TemplatedLoader<0, 0x00011100u, 0x40216002u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_
-// num_verts= 59267
+  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_ num_verts= 59267
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -105,8 +95,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[23338860188681] = TemplatedLoader<0, 0x000f0f00u, 0x41201009u, 0x80000009u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_flt_C0_1_I8_8888_
-// num_verts= 23726
+  // P_mtx1_3_I8_flt_C0_1_I8_8888_ num_verts= 23726
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -117,8 +106,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20470985816632] = TemplatedLoader<0, 0x00002200u, 0x40016009u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_2_Dir_u8_
-// num_verts= 9896
+  // P_mtx0_2_Dir_u8_ num_verts= 9896
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -129,8 +117,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20153366285663] = TemplatedLoader<0, 0x00000100u, 0x40000000u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_
-// num_verts= 9737
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_ num_verts= 9737
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -141,8 +128,7 @@ void G_GNUEDA_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20160025996088] = TemplatedLoader<0, 0x00000b00u, 0x40001009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_I8_u8_
-// num_verts= 5576
+  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_I8_u8_ num_verts= 5576
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
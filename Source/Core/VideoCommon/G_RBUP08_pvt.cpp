@@ -1,16 +1,13 @@
 // Copyright 2013 Dolphin Emulator Project
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
-
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
 #include "VideoCommon/G_RBUP08_pvt.h"
 #include "VideoCommon/VertexLoader_Template.h"
 
-
-
 void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
 {
-  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_
-// num_verts= 94979596
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_ num_verts= 94979596
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -21,8 +18,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21159200864406] = TemplatedLoader<0, 0x00030f00u, 0x40a00c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_
-// num_verts= 64559916
+  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_ num_verts= 64559916
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -33,8 +29,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20987393342358] = TemplatedLoader<0, 0x00020a00u, 0x40a00c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 46127637
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 46127637
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -45,8 +40,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49004107214565] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_
-// num_verts= 35671630
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_ num_verts= 35671630
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -57,8 +51,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22716059889125] = TemplatedLoader<0, 0x000e0b00u, 0x40a01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_
-// num_verts= 20626536
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_ num_verts= 20626536
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -69,8 +62,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22965932036581] = TemplatedLoader<0, 0x000f0f00u, 0x40e01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_T1_mtx1_1_I16_u16_T2_mtx0_1_I16_u16_
-// num_verts= 20412465
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_T1_mtx1_1_I16_u16_T2_mtx0_1_I16_u16_ num_verts= 20412465
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -81,8 +73,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[31270177770997] = TemplatedLoader<0, 0x003f0f02u, 0x40a00c07u, 0x80000a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 17681599
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 17681599
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -93,8 +84,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49004179042021] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_
-// num_verts= 15102100
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_ num_verts= 15102100
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -105,8 +95,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49004178761445] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x001c0205u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_
-// num_verts= 14338543
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_ num_verts= 14338543
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -117,8 +106,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49003963279077] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00040205u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_T1_mtx1_1_I16_s16_T2_mtx0_1_I16_s16_
-// num_verts= 13454402
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_T1_mtx1_1_I16_s16_T2_mtx0_1_I16_s16_ num_verts= 13454402
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -129,8 +117,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[31348900803335] = TemplatedLoader<0, 0x003f0f02u, 0x40e00c07u, 0x80000e07u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_
-// num_verts= 12865978
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_ num_verts= 12865978
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -141,8 +128,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22963298971109] = TemplatedLoader<0, 0x000f0b00u, 0x40e01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_s16_
-// num_verts= 12543279
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_s16_ num_verts= 12543279
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -153,8 +139,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27433855439589] = TemplatedLoader<0, 0x002a0a00u, 0x40a01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_
-// num_verts= 12185127
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_ num_verts= 12185127
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -165,8 +150,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22794782780901] = TemplatedLoader<0, 0x000e0b00u, 0x40e01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_s16_
-// num_verts= 11482198
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_s16_ num_verts= 11482198
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -177,8 +161,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[63160197285861] = TemplatedLoader<0, 0x00fe0b00u, 0x40a01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_flt_
-// num_verts= 11019426
+  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_flt_ num_verts= 11019426
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -189,8 +172,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21148149714744] = TemplatedLoader<0, 0x00020f00u, 0x41201009u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 10867396
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 10867396
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -201,8 +183,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49082830106341] = TemplatedLoader<0, 0x00aa0a00u, 0x40e01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_
-// num_verts= 10561332
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_ num_verts= 10561332
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -213,8 +194,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49678028039909] = TemplatedLoader<0, 0x00ae0a00u, 0x40a01009u, 0x00040205u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u8_T1_mtx1_1_I16_u8_T2_mtx0_1_I16_u8_
-// num_verts= 9936810
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u8_T1_mtx1_1_I16_u8_T2_mtx0_1_I16_u8_ num_verts= 9936810
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -225,8 +205,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[31112731706321] = TemplatedLoader<0, 0x003f0f02u, 0x40200c07u, 0x80000201u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_
-// num_verts= 9280523
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_ num_verts= 9280523
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -237,8 +216,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20693865605944] = TemplatedLoader<0, 0x00020b00u, 0x40a01009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_
-// num_verts= 8675688
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_ num_verts= 8675688
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -249,8 +227,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30973353700325] = TemplatedLoader<0, 0x003f0b00u, 0x40a01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_
-// num_verts= 8656956
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_ num_verts= 8656956
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -261,8 +238,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20865014861624] = TemplatedLoader<0, 0x00030f00u, 0x40a01009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_
-// num_verts= 7381220
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_ num_verts= 7381220
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -273,8 +249,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22041336861925] = TemplatedLoader<0, 0x000a0a00u, 0x40a01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_s16_
-// num_verts= 7141316
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_s16_ num_verts= 7141316
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -285,8 +260,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[63331346541541] = TemplatedLoader<0, 0x00ff0f00u, 0x40a01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_
-// num_verts= 7014047
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_ num_verts= 7014047
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -297,8 +271,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22120059753701] = TemplatedLoader<0, 0x000a0a00u, 0x40e01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_
-// num_verts= 6901614
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_ num_verts= 6901614
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -309,8 +282,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[28107920200421] = TemplatedLoader<0, 0x002e0a00u, 0x40a01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_
-// num_verts= 6769270
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_ num_verts= 6769270
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -321,8 +293,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22887209144805] = TemplatedLoader<0, 0x000f0f00u, 0x40a01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_u16_
-// num_verts= 5899848
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_u16_ num_verts= 5899848
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -333,8 +304,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[63238848350181] = TemplatedLoader<0, 0x00fe0b00u, 0x40e01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_flt_
-// num_verts= 5809236
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_flt_ num_verts= 5809236
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -345,8 +315,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21019827579704] = TemplatedLoader<0, 0x00030b00u, 0x41201009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_
-// num_verts= 5579970
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_ num_verts= 5579970
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -357,8 +326,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30804837510117] = TemplatedLoader<0, 0x003e0b00u, 0x40a01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 5316220
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 5316220
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -369,8 +337,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49678243802853] = TemplatedLoader<0, 0x00ae0a00u, 0x40a01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_
-// num_verts= 5115936
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_ num_verts= 5115936
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -381,8 +348,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22794124514533] = TemplatedLoader<0, 0x000e0a00u, 0x40e01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_u16_
-// num_verts= 4792368
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_u16_ num_verts= 4792368
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -393,8 +359,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20696498671416] = TemplatedLoader<0, 0x00020f00u, 0x40a01009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I8_s16_
-// num_verts= 4604600
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I8_s16_ num_verts= 4604600
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -405,8 +370,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[52375161112549] = TemplatedLoader<0, 0x00be0b00u, 0x40a01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 4551810
+  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 4551810
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -417,8 +381,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49849321231077] = TemplatedLoader<0, 0x00af0e00u, 0x40a01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 4534368
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 4534368
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -429,8 +392,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49846688165605] = TemplatedLoader<0, 0x00af0a00u, 0x40a01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I16_s16_
-// num_verts= 4156698
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I16_s16_ num_verts= 4156698
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -441,8 +403,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[60711177324517] = TemplatedLoader<0, 0x00ef0b00u, 0x40e01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_T1_mtx1_1_Inv_flt_
-// num_verts= 3886668
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_T1_mtx1_1_Inv_flt_ num_verts= 3886668
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -453,8 +414,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21159206008345] = TemplatedLoader<0, 0x00030f02u, 0x40a00c07u, 0x80000009u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 3503755
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 3503755
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -465,8 +425,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49082901933797] = TemplatedLoader<0, 0x00aa0a00u, 0x40e01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_
-// num_verts= 3463680
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_ num_verts= 3463680
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -477,8 +436,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49004106933989] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00140205u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_
-// num_verts= 3308032
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_ num_verts= 3308032
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -489,8 +447,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49678243522277] = TemplatedLoader<0, 0x00ae0a00u, 0x40a01009u, 0x001c0205u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 3211692
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 3211692
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -501,8 +458,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49757553133541] = TemplatedLoader<0, 0x00ae0b00u, 0x40e01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u8_
-// num_verts= 3166777
+  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u8_ num_verts= 3166777
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -513,8 +469,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20829947558806] = TemplatedLoader<0, 0x00020a00u, 0x40200c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 2938572
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 2938572
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -525,8 +480,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49926141151205] = TemplatedLoader<0, 0x00af0b00u, 0x40e01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 2923636
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 2923636
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -537,8 +491,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49004107214017] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00140a01u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_
-// num_verts= 2891384
+  // P_mtx1_3_I8_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_ num_verts= 2891384
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -549,8 +502,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21158542598038] = TemplatedLoader<0, 0x00030e00u, 0x40a00c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_
-// num_verts= 2724130
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_ num_verts= 2724130
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -561,8 +513,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49082686170853] = TemplatedLoader<0, 0x00aa0a00u, 0x40e01009u, 0x00040205u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_s16_
-// num_verts= 2676210
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_s16_ num_verts= 2676210
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -573,8 +524,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20775221563192] = TemplatedLoader<0, 0x00020f00u, 0x40e01009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_
-// num_verts= 2607642
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_ num_verts= 2607642
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -585,8 +535,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27433855299301] = TemplatedLoader<0, 0x002a0a00u, 0x40a01009u, 0x00000a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_
-// num_verts= 2514414
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_ num_verts= 2514414
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -597,8 +546,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30975986765797] = TemplatedLoader<0, 0x003f0f00u, 0x40a01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_
-// num_verts= 2351972
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_ num_verts= 2351972
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -609,8 +557,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20864995642168] = TemplatedLoader<0, 0x00030f00u, 0x40a00c09u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_
-// num_verts= 2097771
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_ num_verts= 2097771
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -621,8 +568,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30975967368515] = TemplatedLoader<0, 0x003f0f00u, 0x40a00c07u, 0x00000a05u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_
-// num_verts= 1967616
+  // P_mtx1_3_I8_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_ num_verts= 1967616
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -633,8 +579,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21066135453590] = TemplatedLoader<0, 0x00020a00u, 0x40e01007u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_
-// num_verts= 1842624
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_s16_ num_verts= 1842624
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -645,8 +590,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30647391726565] = TemplatedLoader<0, 0x003e0b00u, 0x40201009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u8_
-// num_verts= 1820688
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u8_ num_verts= 1820688
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -657,8 +601,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30975986344933] = TemplatedLoader<0, 0x003f0f00u, 0x40a01009u, 0x00000205u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_
-// num_verts= 1809504
+  // P_mtx0_3_I16_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_ num_verts= 1809504
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -669,8 +612,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20693865568406] = TemplatedLoader<0, 0x00020b00u, 0x40a01007u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_
-// num_verts= 1669848
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_ num_verts= 1669848
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -681,8 +623,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20772588497720] = TemplatedLoader<0, 0x00020b00u, 0x40e01009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_
-// num_verts= 1553110
+  // P_mtx0_3_I8_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_ num_verts= 1553110
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -693,8 +634,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20693207302038] = TemplatedLoader<0, 0x00020a00u, 0x40a01007u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_u16_
-// num_verts= 1481793
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_u16_ num_verts= 1481793
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -705,8 +645,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20696479414422] = TemplatedLoader<0, 0x00020f00u, 0x40a00c07u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_u16_
-// num_verts= 1464684
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_T3_mtx0_1_I16_u16_ num_verts= 1464684
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -717,8 +656,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[63409997605861] = TemplatedLoader<0, 0x00ff0f00u, 0x40e01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_
-// num_verts= 1353696
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_ num_verts= 1353696
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -729,8 +667,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21883891078373] = TemplatedLoader<0, 0x000a0a00u, 0x40201009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_
-// num_verts= 1329712
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_ num_verts= 1329712
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -741,8 +678,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49082901653221] = TemplatedLoader<0, 0x00aa0a00u, 0x40e01009u, 0x001c0205u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 1322776
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 1322776
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -753,8 +689,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49925482884837] = TemplatedLoader<0, 0x00af0a00u, 0x40e01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_s16_
-// num_verts= 1267708
+  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_s16_ num_verts= 1267708
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -765,8 +700,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21066116234134] = TemplatedLoader<0, 0x00020a00u, 0x40e00c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_
-// num_verts= 1220190
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u16_ num_verts= 1220190
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -777,8 +711,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30973353560037] = TemplatedLoader<0, 0x003f0b00u, 0x40a01009u, 0x00000a05u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I16_u16_
-// num_verts= 1212106
+  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I16_u16_ num_verts= 1212106
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -789,8 +722,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21155909532566] = TemplatedLoader<0, 0x00030a00u, 0x40a00c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 1188024
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 1188024
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -801,8 +733,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49756894867173] = TemplatedLoader<0, 0x00ae0a00u, 0x40e01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 1161664
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 1161664
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -813,8 +744,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49678171975397] = TemplatedLoader<0, 0x00ae0a00u, 0x40a01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_
-// num_verts= 1126080
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_ num_verts= 1126080
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -825,8 +755,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22715401622757] = TemplatedLoader<0, 0x000e0a00u, 0x40a01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 1125099
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 1125099
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -837,8 +766,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49172623404773] = TemplatedLoader<0, 0x00ab0a00u, 0x40a01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u8_
-// num_verts= 1118736
+  // P_mtx0_3_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I16_u8_ num_verts= 1118736
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -849,8 +777,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[30804837089253] = TemplatedLoader<0, 0x003e0b00u, 0x40a01009u, 0x00000205u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I8_u16_
-// num_verts= 1074759
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I8_u16_ num_verts= 1074759
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -861,8 +788,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22209853052133] = TemplatedLoader<0, 0x000b0a00u, 0x40a01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 937664
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 937664
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -873,8 +799,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49756966694629] = TemplatedLoader<0, 0x00ae0a00u, 0x40e01009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u8_
-// num_verts= 898776
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u8_ num_verts= 898776
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -885,8 +810,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49003963559653] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00040a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_
-// num_verts= 855504
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_ num_verts= 855504
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -897,8 +821,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27433855018725] = TemplatedLoader<0, 0x002a0a00u, 0x40a01009u, 0x00000205u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u8_
-// num_verts= 844536
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u8_ num_verts= 844536
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -909,8 +832,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[28107919779557] = TemplatedLoader<0, 0x002e0a00u, 0x40a01009u, 0x00000205u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_u16_
-// num_verts= 810616
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_u16_ num_verts= 810616
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -921,8 +843,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20990684674198] = TemplatedLoader<0, 0x00020f00u, 0x40a00c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_
-// num_verts= 767760
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_ num_verts= 767760
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -933,8 +854,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27950474416869] = TemplatedLoader<0, 0x002e0a00u, 0x40201009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_
-// num_verts= 737598
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I16_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_ num_verts= 737598
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -945,8 +865,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[28276436390629] = TemplatedLoader<0, 0x002f0a00u, 0x40a01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_
-// num_verts= 715662
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_ num_verts= 715662
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -957,8 +876,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[28107920060133] = TemplatedLoader<0, 0x002e0a00u, 0x40a01009u, 0x00000a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 714480
+  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 714480
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -969,8 +887,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49928044122853] = TemplatedLoader<0, 0x00af0e00u, 0x40e01009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_u8_
-// num_verts= 702240
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_u8_ num_verts= 702240
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -981,8 +898,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20833238890646] = TemplatedLoader<0, 0x00020f00u, 0x40200c07u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_
-// num_verts= 690984
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I16_u16_T2_mtx0_1_I8_s16_ num_verts= 690984
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -993,8 +909,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[28186643092197] = TemplatedLoader<0, 0x002e0a00u, 0x40e01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_
-// num_verts= 661416
+  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_u16_ num_verts= 661416
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1005,8 +920,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22965273770213] = TemplatedLoader<0, 0x000f0e00u, 0x40e01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_s16_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u8_
-// num_verts= 633876
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u8_ num_verts= 633876
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1017,8 +931,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20707569040534] = TemplatedLoader<0, 0x00030f00u, 0x40201007u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_s16_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_
-// num_verts= 603273
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_flt_T0_mtx0_1_I16_u16_ num_verts= 603273
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1029,8 +942,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20865014824086] = TemplatedLoader<0, 0x00030f00u, 0x40a01007u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_s16_
-// num_verts= 578562
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_s16_ num_verts= 578562
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1041,8 +953,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27433855439041] = TemplatedLoader<0, 0x002a0a00u, 0x40a01009u, 0x00000e01u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_
-// num_verts= 573078
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_ num_verts= 573078
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1053,8 +964,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27276409515749] = TemplatedLoader<0, 0x002a0a00u, 0x40201009u, 0x00000a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_s16_
-// num_verts= 499044
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_s16_ num_verts= 499044
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1065,8 +975,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27512578331365] = TemplatedLoader<0, 0x002a0a00u, 0x40e01009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_
-// num_verts= 428352
+  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I16_u16_ num_verts= 428352
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1077,8 +986,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22718034688229] = TemplatedLoader<0, 0x000e0e00u, 0x40a01009u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_u16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_
-// num_verts= 426874
+  // P_mtx1_3_I8_u16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_ num_verts= 426874
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1089,8 +997,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20987393304820] = TemplatedLoader<0, 0x00020a00u, 0x40a00c05u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_
-// num_verts= 425010
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_ num_verts= 425010
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1101,8 +1008,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27433855298753] = TemplatedLoader<0, 0x002a0a00u, 0x40a01009u, 0x00000a01u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_
-// num_verts= 404032
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_ num_verts= 404032
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1113,8 +1019,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22041336861377] = TemplatedLoader<0, 0x000a0a00u, 0x40a01009u, 0x00000001u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_s16_
-// num_verts= 389364
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_s16_ num_verts= 389364
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1125,8 +1030,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27276409656037] = TemplatedLoader<0, 0x002a0a00u, 0x40201009u, 0x00000e05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u8_
-// num_verts= 371964
+  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u8_ num_verts= 371964
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1137,8 +1041,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20535742299030] = TemplatedLoader<0, 0x00020a00u, 0x40200c07u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_
-// num_verts= 351548
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_ num_verts= 351548
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1149,8 +1052,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49004178760897] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x001c0201u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_u16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_
-// num_verts= 351360
+  // P_mtx0_3_I8_u16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_ num_verts= 351360
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1161,8 +1063,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20693207264500] = TemplatedLoader<0, 0x00020a00u, 0x40a01005u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_s16_
-// num_verts= 339416
+  // P_mtx0_3_I8_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I8_s16_ num_verts= 339416
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1173,8 +1074,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20774544039830] = TemplatedLoader<0, 0x00020e00u, 0x40e00c07u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_
-// num_verts= 326634
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_ num_verts= 326634
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1185,8 +1085,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20535761556024] = TemplatedLoader<0, 0x00020a00u, 0x40201009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 322322
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 322322
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1197,8 +1096,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846733258469] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x001c0a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_u16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_
-// num_verts= 293860
+  // P_mtx0_3_I8_u16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_ num_verts= 293860
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1209,8 +1107,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20693188045044] = TemplatedLoader<0, 0x00020a00u, 0x40a00c05u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_T1_mtx1_1_I8_u16_T2_mtx0_1_I8_u16_
-// num_verts= 289810
+  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_T1_mtx1_1_I8_u16_T2_mtx0_1_I8_u16_ num_verts= 289810
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1221,8 +1118,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27728046444789] = TemplatedLoader<0, 0x002a0a02u, 0x40a00c07u, 0x80000a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_s16_
-// num_verts= 279684
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_s16_ num_verts= 279684
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1233,8 +1129,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27276409655489] = TemplatedLoader<0, 0x002a0a00u, 0x40201009u, 0x00000e01u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 275748
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 275748
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1245,8 +1140,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846661431013] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x00140a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 261983
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 261983
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1257,8 +1151,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49004179041473] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x001c0a01u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_
-// num_verts= 213616
+  // P_mtx0_3_I8_s16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_ num_verts= 213616
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1269,8 +1162,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20771930193814] = TemplatedLoader<0, 0x00020a00u, 0x40e01007u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_T1_mtx1_1_Inv_flt_
-// num_verts= 206724
+  // P_mtx1_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_T1_mtx1_1_Inv_flt_ num_verts= 206724
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1281,8 +1173,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20987398486297] = TemplatedLoader<0, 0x00020a02u, 0x40a00c07u, 0x80000009u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_
-// num_verts= 189736
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_ num_verts= 189736
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1293,8 +1184,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21883891077825] = TemplatedLoader<0, 0x000a0a00u, 0x40201009u, 0x00000001u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u8_
-// num_verts= 181224
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u8_ num_verts= 181224
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1305,8 +1195,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22120059753153] = TemplatedLoader<0, 0x000a0a00u, 0x40e01009u, 0x00000001u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_
-// num_verts= 170004
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_ num_verts= 170004
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1317,8 +1206,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27433855018177] = TemplatedLoader<0, 0x002a0a00u, 0x40a01009u, 0x00000201u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_
-// num_verts= 137836
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_ num_verts= 137836
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1329,8 +1217,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49003963278529] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00040201u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_
-// num_verts= 108836
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_ num_verts= 108836
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1341,8 +1228,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846732977893] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x001c0205u, 0x00000000u>;
   }
-  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_
-// num_verts= 90048
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_u16_ num_verts= 90048
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1353,8 +1239,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20864995604630] = TemplatedLoader<0, 0x00030f00u, 0x40a00c07u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_
-// num_verts= 87906
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_ num_verts= 87906
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1365,8 +1250,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846517495525] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x00040205u, 0x00000000u>;
   }
-  // P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_T2_mtx0_1_Dir_flt_
-// num_verts= 77936
+  // P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_T2_mtx0_1_Dir_flt_ num_verts= 77936
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1377,8 +1261,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[24058683649720] = TemplatedLoader<0, 0x00151100u, 0x41216008u, 0x00001209u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_
-// num_verts= 59072
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_ num_verts= 59072
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1389,8 +1272,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49082829825765] = TemplatedLoader<0, 0x00aa0a00u, 0x40e01009u, 0x00140205u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u8_
-// num_verts= 52212
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u8_ num_verts= 52212
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1401,8 +1283,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49082686451429] = TemplatedLoader<0, 0x00aa0a00u, 0x40e01009u, 0x00040a05u, 0x00000000u>;
   }
-  // P_mtx0_3_Dir_u16_C0_1_Dir_8888_
-// num_verts= 48344
+  // P_mtx0_3_Dir_u16_C0_1_Dir_8888_ num_verts= 48344
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1413,8 +1294,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20165589953524] = TemplatedLoader<0, 0x00001100u, 0x40016005u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_u16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_
-// num_verts= 43920
+  // P_mtx0_3_I8_u16_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_ num_verts= 43920
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1425,8 +1305,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20535761480948] = TemplatedLoader<0, 0x00020a00u, 0x40201005u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u8_
-// num_verts= 29302
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u8_ num_verts= 29302
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1437,8 +1316,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846517776101] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x00040a05u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_
-// num_verts= 19364
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_u16_ num_verts= 19364
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1449,8 +1327,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846661430465] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x00140a01u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_
-// num_verts= 16452
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_ num_verts= 16452
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1461,8 +1338,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27276409515201] = TemplatedLoader<0, 0x002a0a00u, 0x40201009u, 0x00000a01u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_
-// num_verts= 14768
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_s16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_ num_verts= 14768
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1473,8 +1349,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49082829825217] = TemplatedLoader<0, 0x00aa0a00u, 0x40e01009u, 0x00140201u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_
-// num_verts= 12162
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u16_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_ num_verts= 12162
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1485,8 +1360,7 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846661150437] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x00140205u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_
-// num_verts= 8372
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u16_T3_mtx0_1_I8_s16_ num_verts= 8372
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -1497,40 +1371,37 @@ void G_RBUP08_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[48846733257921] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x001c0a01u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_
-// num_verts= 8108
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_ num_verts= 8108
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
-    pvlmap[49004106933441] = TemplatedLoader<0x301, 0x00aa0a00u, 0x40a01009u, 0x00140201u, 0x00000000u>;
+    pvlmap[48846517494977] = TemplatedLoader<0x301, 0x00aa0a00u, 0x40201009u, 0x00040201u, 0x00000000u>;
   }
   else
 #endif
   {
-    pvlmap[49004106933441] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00140201u, 0x00000000u>;
+    pvlmap[48846517494977] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x00040201u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u8_
-// num_verts= 8108
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_ num_verts= 8108
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
-    pvlmap[48846517494977] = TemplatedLoader<0x301, 0x00aa0a00u, 0x40201009u, 0x00040201u, 0x00000000u>;
+    pvlmap[48846732977345] = TemplatedLoader<0x301, 0x00aa0a00u, 0x40201009u, 0x001c0201u, 0x00000000u>;
   }
   else
 #endif
   {
-    pvlmap[48846517494977] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x00040201u, 0x00000000u>;
+    pvlmap[48846732977345] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x001c0201u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_s16_
-// num_verts= 8108
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u8_T2_mtx0_1_I8_u8_T3_mtx0_1_I8_u16_ num_verts= 8108
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
-    pvlmap[48846732977345] = TemplatedLoader<0x301, 0x00aa0a00u, 0x40201009u, 0x001c0201u, 0x00000000u>;
+    pvlmap[49004106933441] = TemplatedLoader<0x301, 0x00aa0a00u, 0x40a01009u, 0x00140201u, 0x00000000u>;
   }
   else
 #endif
   {
-    pvlmap[48846732977345] = TemplatedLoader<0, 0x00aa0a00u, 0x40201009u, 0x001c0201u, 0x00000000u>;
+    pvlmap[49004106933441] = TemplatedLoader<0, 0x00aa0a00u, 0x40a01009u, 0x00140201u, 0x00000000u>;
   }
 }
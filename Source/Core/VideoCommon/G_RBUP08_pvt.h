@@ -1,7 +1,7 @@
 // Copyright 2013 Dolphin Emulator Project
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
-// Added for Ishiiruka by Tino
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
 #pragma once
 #include <map>
 #include "VideoCommon/NativeVertexFormat.h"
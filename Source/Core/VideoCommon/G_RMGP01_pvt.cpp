@@ -1,14 +1,13 @@
 // Copyright 2013 Dolphin Emulator Project
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
-// Added for Ishiiruka by Tino
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
 #include "VideoCommon/G_RMGP01_pvt.h"
 #include "VideoCommon/VertexLoader_Template.h"
 
-
 void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
 {
-  //P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 1634718708
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 1634718708
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -19,7 +18,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20977006594198] = TemplatedLoader<0, 0x00033f00u, 0x40e16c07u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_ num_verts= 282808496
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_ num_verts= 282808496
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -30,7 +29,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20162639804566] = TemplatedLoader<0, 0x00000f00u, 0x40000c07u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 148684510
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 148684510
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -41,7 +40,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21271211853974] = TemplatedLoader<0, 0x00033f00u, 0x40e16c07u, 0x80000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_ num_verts= 123985257
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_ num_verts= 123985257
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -52,7 +51,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20943718496406] = TemplatedLoader<0, 0x00030f00u, 0x40e00c07u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I8_s8_T0_mtx0_1_I8_s8_ num_verts= 42056768
+  // P_mtx0_3_I8_s8_T0_mtx0_1_I8_s8_ num_verts= 42056768
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -63,7 +62,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20609141326418] = TemplatedLoader<0, 0x00020200u, 0x40600003u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_ num_verts= 33390180
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_ num_verts= 33390180
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -74,7 +73,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20456845064342] = TemplatedLoader<0, 0x00000f00u, 0x40000c07u, 0x80000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 20656335
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 20656335
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -85,7 +84,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20977006631736] = TemplatedLoader<0, 0x00033f00u, 0x40e16c09u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 17966340
+  // P_mtx0_3_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 17966340
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -96,7 +95,18 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20969049739414] = TemplatedLoader<0, 0x00033300u, 0x40e16007u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_ num_verts= 16858875
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_s16_ num_verts= 17684060
+#if _M_SSE >= 0x301
+  if (cpu_info.bSSSE3)
+  {
+    pvlmap[22999200915191] = TemplatedLoader<0x301, 0x000f3f00u, 0x40e16c09u, 0x00000007u, 0x00000000u>;
+  }
+  else
+#endif
+  {
+    pvlmap[22999200915191] = TemplatedLoader<0, 0x000f3f00u, 0x40e16c09u, 0x00000007u, 0x00000000u>;
+  }
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_ num_verts= 16858875
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -107,7 +117,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20943718533944] = TemplatedLoader<0, 0x00030f00u, 0x40e00c09u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_flt_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 15811590
+  // P_mtx0_3_I16_flt_C0_1_I16_8888_T0_mtx0_1_I16_s16_ num_verts= 15811590
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -118,7 +128,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20969049776952] = TemplatedLoader<0, 0x00033300u, 0x40e16009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx1_1_Inv_flt_ num_verts= 14616395
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx1_1_Inv_flt_ num_verts= 14616395
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -129,7 +139,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21271216997913] = TemplatedLoader<0, 0x00033f02u, 0x40e16c07u, 0x80000009u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_T0_mtx0_1_Dir_flt_ num_verts= 12531821
+  // P_mtx0_3_Dir_flt_T0_mtx0_1_Dir_flt_ num_verts= 12531821
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -140,7 +150,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20676135657784] = TemplatedLoader<0, 0x00010100u, 0x41200009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx1_1_I16_s16_ num_verts= 10647072
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx1_1_I16_s16_ num_verts= 10647072
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -151,7 +161,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21271214425327] = TemplatedLoader<0, 0x00033f01u, 0x40e16c07u, 0x80000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_ num_verts= 10222171
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_ num_verts= 10222171
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -162,7 +172,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20195927902358] = TemplatedLoader<0, 0x00003f00u, 0x40016c07u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_Nrm_0_0_Dir_flt_ num_verts= 6757672
+  // P_mtx0_3_Dir_flt_Nrm_0_0_Dir_flt_ num_verts= 6757672
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -173,7 +183,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20156076397880] = TemplatedLoader<0, 0x00000500u, 0x40001009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_ num_verts= 6757672
+  // P_mtx0_3_Dir_flt_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_ num_verts= 6757672
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -184,7 +194,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21350200419849] = TemplatedLoader<0, 0x00050100u, 0x41200009u, 0x00000009u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_ num_verts= 5560606
+  // P_mtx0_3_Dir_flt_ num_verts= 5560606
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -195,7 +205,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20153366454584] = TemplatedLoader<0, 0x00000100u, 0x40000009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx1_1_Inv_flt_T2_mtx1_1_Inv_flt_ num_verts= 5353320
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx1_1_Inv_flt_T2_mtx1_1_Inv_flt_ num_verts= 5353320
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -206,7 +216,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21271227914621] = TemplatedLoader<0, 0x00033f06u, 0x40e16c07u, 0x80001209u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_T2_mtx0_1_I16_flt_T3_mtx0_1_I16_flt_ num_verts= 4578000
+  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_T2_mtx0_1_I16_flt_T3_mtx0_1_I16_flt_ num_verts= 4578000
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -217,7 +227,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[63491795400713] = TemplatedLoader<0, 0x00ff1100u, 0x41216009u, 0x00241209u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx1_1_I16_s16_T1_mtx1_1_Inv_flt_ num_verts= 3691776
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx1_1_I16_s16_T1_mtx1_1_Inv_flt_ num_verts= 3691776
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -228,7 +238,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21271219569266] = TemplatedLoader<0, 0x00033f03u, 0x40e16c07u, 0x80000009u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_u16_ num_verts= 3349472
+  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_u16_ num_verts= 3349472
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -239,7 +249,29 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20530913448248] = TemplatedLoader<0, 0x00011100u, 0x40a16009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_ num_verts= 2872184
+  // P_mtx0_3_I16_s16_C0_1_I16_8888_ num_verts= 2941856
+#if _M_SSE >= 0x301
+  if (cpu_info.bSSSE3)
+  {
+    pvlmap[20187971047574] = TemplatedLoader<0x301, 0x00003300u, 0x40016007u, 0x00000000u, 0x00000000u>;
+  }
+  else
+#endif
+  {
+    pvlmap[20187971047574] = TemplatedLoader<0, 0x00003300u, 0x40016007u, 0x00000000u, 0x00000000u>;
+  }
+  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_ num_verts= 2883600
+#if _M_SSE >= 0x301
+  if (cpu_info.bSSSE3)
+  {
+    pvlmap[23047585895945] = TemplatedLoader<0x301, 0x000f1100u, 0x41216009u, 0x00000009u, 0x00000000u>;
+  }
+  else
+#endif
+  {
+    pvlmap[23047585895945] = TemplatedLoader<0, 0x000f1100u, 0x41216009u, 0x00000009u, 0x00000000u>;
+  }
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_ num_verts= 2872184
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -250,7 +282,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21237923756182] = TemplatedLoader<0, 0x00030f00u, 0x40e00c07u, 0x80000000u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_flt_T0_mtx0_1_Dir_flt_ num_verts= 2805260
+  // P_mtx0_2_Dir_flt_T0_mtx0_1_Dir_flt_ num_verts= 2805260
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -261,7 +293,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20676135639015] = TemplatedLoader<0, 0x00010100u, 0x41200008u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_ num_verts= 2330456
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_ num_verts= 2330456
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -272,7 +304,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20490133162134] = TemplatedLoader<0, 0x00003f00u, 0x40016c07u, 0x80000000u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_C0_1_Dir_8888_ num_verts= 2286516
+  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_ num_verts= 2286516
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -283,52 +315,51 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20165590028600] = TemplatedLoader<0, 0x00001100u, 0x40016009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_I16_flt_T1_mtx0_1_I16_flt_
-  // num_verts= 2883600
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T2_mtx1_1_Inv_flt_ num_verts= 1255222
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
-    pvlmap[23047585895945] = TemplatedLoader<0x301, 0x000f1100u, 0x41216009u, 0x00000009u, 0x00000000u>;
+    pvlmap[21271222770682] = TemplatedLoader<0x301, 0x00033f04u, 0x40e16c07u, 0x80001200u, 0x00000000u>;
   }
   else
 #endif
   {
-    pvlmap[23047585895945] = TemplatedLoader<0, 0x000f1100u, 0x41216009u, 0x00000009u, 0x00000000u>;
+    pvlmap[21271222770682] = TemplatedLoader<0, 0x00033f04u, 0x40e16c07u, 0x80001200u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T2_mtx1_1_Inv_flt_ num_verts= 1255222
+  // P_mtx0_3_Dir_flt_T0_mtx0_1_I8_flt_ num_verts= 1003520
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
-    pvlmap[21271222770682] = TemplatedLoader<0x301, 0x00033f04u, 0x40e16c07u, 0x80001200u, 0x00000000u>;
+    pvlmap[20844651847992] = TemplatedLoader<0x301, 0x00020100u, 0x41200009u, 0x00000000u, 0x00000000u>;
   }
   else
 #endif
   {
-    pvlmap[21271222770682] = TemplatedLoader<0, 0x00033f04u, 0x40e16c07u, 0x80001200u, 0x00000000u>;
+    pvlmap[20844651847992] = TemplatedLoader<0, 0x00020100u, 0x41200009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_T0_mtx0_1_I8_flt_ num_verts= 1003520
+  // P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_ num_verts= 866912
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
-    pvlmap[20844651847992] = TemplatedLoader<0x301, 0x00020100u, 0x41200009u, 0x00000000u, 0x00000000u>;
+    pvlmap[20688359213031] = TemplatedLoader<0x301, 0x00011100u, 0x41216008u, 0x00000000u, 0x00000000u>;
   }
   else
 #endif
   {
-    pvlmap[20844651847992] = TemplatedLoader<0, 0x00020100u, 0x41200009u, 0x00000000u, 0x00000000u>;
+    pvlmap[20688359213031] = TemplatedLoader<0, 0x00011100u, 0x41216008u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_ num_verts= 866912
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_C0_1_I16_8888_ num_verts= 738660
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
-    pvlmap[20688359213031] = TemplatedLoader<0x301, 0x00011100u, 0x41216008u, 0x00000000u, 0x00000000u>;
+    pvlmap[20195927939896] = TemplatedLoader<0x301, 0x00003f00u, 0x40016c09u, 0x00000000u, 0x00000000u>;
   }
   else
 #endif
   {
-    pvlmap[20688359213031] = TemplatedLoader<0, 0x00011100u, 0x41216008u, 0x00000000u, 0x00000000u>;
+    pvlmap[20195927939896] = TemplatedLoader<0, 0x00003f00u, 0x40016c09u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_u16_T0_mtx0_1_Dir_u8_ num_verts= 203608
+  // P_mtx0_2_Dir_u16_T0_mtx0_1_Dir_u8_ num_verts= 203608
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -339,7 +370,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20361243996835] = TemplatedLoader<0, 0x00010100u, 0x40200004u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_u16_T0_mtx0_1_Dir_flt_ num_verts= 95756
+  // P_mtx0_2_Dir_u16_T0_mtx0_1_Dir_flt_ num_verts= 95756
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -350,7 +381,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20676135563939] = TemplatedLoader<0, 0x00010100u, 0x41200004u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_ num_verts= 87756
+  // P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_ num_verts= 87756
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -361,7 +392,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20162639842104] = TemplatedLoader<0, 0x00000f00u, 0x40000c09u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_ num_verts= 45540
+  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_ num_verts= 45540
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -372,7 +403,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20688359231800] = TemplatedLoader<0, 0x00011100u, 0x41216009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_T1_mtx1_1_Inv_flt_ num_verts= 43488
+  // P_mtx1_3_I16_s16_Nrm_0_0_I16_s16_T0_mtx0_1_I16_s16_T1_mtx1_1_Inv_flt_ num_verts= 43488
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -383,7 +414,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21237928900121] = TemplatedLoader<0, 0x00030f02u, 0x40e00c07u, 0x80000009u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_u16_ num_verts= 24152
+  // P_mtx0_2_Dir_u16_ num_verts= 24152
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -394,7 +425,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20153366360739] = TemplatedLoader<0, 0x00000100u, 0x40000004u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_flt_C0_1_Dir_8888_ num_verts= 6992
+  // P_mtx0_2_Dir_flt_C0_1_Dir_8888_ num_verts= 6992
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -405,7 +436,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20165590009831] = TemplatedLoader<0, 0x00001100u, 0x40016008u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_s16_ num_verts= 2520
+  // P_mtx0_3_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_s16_ num_verts= 2520
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -416,7 +447,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20609636340024] = TemplatedLoader<0, 0x00011100u, 0x40e16009u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_s16_ num_verts= 1852
+  // P_mtx0_3_I16_s16_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_s16_ num_verts= 1852
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -427,7 +458,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22999200877653] = TemplatedLoader<0, 0x000f3f00u, 0x40e16c07u, 0x00000007u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_u16_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_ num_verts= 1064
+  // P_mtx0_2_Dir_u16_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_ num_verts= 1064
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -438,7 +469,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21350200326004] = TemplatedLoader<0, 0x00050100u, 0x41200004u, 0x00000009u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_flt_ num_verts= 924
+  // P_mtx0_2_Dir_flt_ num_verts= 924
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -449,7 +480,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20153366435815] = TemplatedLoader<0, 0x00000100u, 0x40000008u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_s16_ num_verts= 768
+  // P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_s16_ num_verts= 768
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -460,7 +491,7 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20609636321255] = TemplatedLoader<0, 0x00011100u, 0x40e16008u, 0x00000000u, 0x00000000u>;
   }
-  //P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_ num_verts= 28
+  // P_mtx0_2_Dir_flt_C0_1_Dir_8888_T0_mtx0_1_Dir_flt_T1_mtx0_1_Dir_flt_ num_verts= 28
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -471,37 +502,4 @@ void G_RMGP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21362423975096] = TemplatedLoader<0, 0x00051100u, 0x41216008u, 0x00000009u, 0x00000000u>;
   }
-  //P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_C0_1_I16_8888_T0_mtx0_1_I16_s16_T1_mtx0_1_I16_s16_ num_verts= 17684060
-#if _M_SSE >= 0x301
-  if (cpu_info.bSSSE3)
-  {
-    pvlmap[22999200915191] = TemplatedLoader<0x301, 0x000f3f00u, 0x40e16c09u, 0x00000007u, 0x00000000u>;
-  }
-  else
-#endif
-  {
-    pvlmap[22999200915191] = TemplatedLoader<0, 0x000f3f00u, 0x40e16c09u, 0x00000007u, 0x00000000u>;
-  }
-  //P_mtx0_3_I16_s16_C0_1_I16_8888_ num_verts= 2941856
-#if _M_SSE >= 0x301
-  if (cpu_info.bSSSE3)
-  {
-    pvlmap[20187971047574] = TemplatedLoader<0x301, 0x00003300u, 0x40016007u, 0x00000000u, 0x00000000u>;
-  }
-  else
-#endif
-  {
-    pvlmap[20187971047574] = TemplatedLoader<0, 0x00003300u, 0x40016007u, 0x00000000u, 0x00000000u>;
-  }
-  //P_mtx0_3_I16_flt_Nrm_0_0_I16_s16_C0_1_I16_8888_ num_verts= 738660
-#if _M_SSE >= 0x301
-  if (cpu_info.bSSSE3)
-  {
-    pvlmap[20195927939896] = TemplatedLoader<0x301, 0x00003f00u, 0x40016c09u, 0x00000000u, 0x00000000u>;
-  }
-  else
-#endif
-  {
-    pvlmap[20195927939896] = TemplatedLoader<0, 0x00003f00u, 0x40016c09u, 0x00000000u, 0x00000000u>;
-  }
 }
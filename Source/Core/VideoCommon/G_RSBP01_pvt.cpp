@@ -1,16 +1,13 @@
 // Copyright 2013 Dolphin Emulator Project
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
-
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
 #include "VideoCommon/G_RSBP01_pvt.h"
 #include "VideoCommon/VertexLoader_Template.h"
 
-
-
 void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
 {
-  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_C0_1_I8_8888_T0_mtx0_1_I16_flt_T1_mtx1_1_Inv_flt_
-// num_verts= 30974039
+  // P_mtx1_3_I16_flt_Nrm_0_0_I16_flt_C0_1_I8_8888_T0_mtx0_1_I16_flt_T1_mtx1_1_Inv_flt_ num_verts= 30974039
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -21,8 +18,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21339426884795] = TemplatedLoader<0, 0x00032f02u, 0x41217009u, 0x80000009u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_
-// num_verts= 2575754
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_ num_verts= 2575754
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -33,8 +29,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20182123565624] = TemplatedLoader<0, 0x00002a00u, 0x40017009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_flt_Nrm_0_0_I16_s16_C0_0_I8_565_
-// num_verts= 1925770
+  // P_mtx1_3_I16_flt_Nrm_0_0_I16_s16_C0_0_I8_565_ num_verts= 1925770
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -45,8 +40,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20477909625656] = TemplatedLoader<0, 0x00002f00u, 0x40000c09u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_
-// num_verts= 1767558
+  // P_mtx0_3_I8_flt_Nrm_0_0_I16_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_ num_verts= 1767558
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -57,8 +51,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20876042024504] = TemplatedLoader<0, 0x00022e00u, 0x41217009u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_T1_mtx1_1_Inv_flt_
-// num_verts= 1625397
+  // P_mtx1_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_T1_mtx1_1_Inv_flt_ num_verts= 1625397
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -69,8 +62,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21167619362747] = TemplatedLoader<0, 0x00022a02u, 0x41217009u, 0x80000009u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_
-// num_verts= 1324076
+  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_ num_verts= 1324076
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -81,8 +73,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20850653104359] = TemplatedLoader<0, 0x00020a00u, 0x41201008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_T2_mtx0_1_I8_flt_
-// num_verts= 1070190
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_T2_mtx0_1_I8_flt_ num_verts= 1070190
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -93,8 +84,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[27614057199881] = TemplatedLoader<0, 0x002a2a00u, 0x41217009u, 0x00001209u, 0x00000000u>;
   }
-  // P_mtx1_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I16_flt_
-// num_verts= 895442
+  // P_mtx1_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I16_flt_ num_verts= 895442
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -105,8 +95,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21336130409016] = TemplatedLoader<0, 0x00032a00u, 0x41217009u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I16_flt_Nrm_0_0_I8_flt_
-// num_verts= 525600
+  // P_mtx0_2_I16_flt_Nrm_0_0_I8_flt_ num_verts= 525600
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -117,8 +106,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20160025977319] = TemplatedLoader<0, 0x00000b00u, 0x40001008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_
-// num_verts= 315040
+  // P_mtx0_2_I16_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_ num_verts= 315040
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -129,8 +117,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20851311370727] = TemplatedLoader<0, 0x00020b00u, 0x41201008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_T2_mtx0_1_I8_flt_T3_mtx0_1_I8_flt_
-// num_verts= 267388
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_T2_mtx0_1_I8_flt_T3_mtx0_1_I8_flt_ num_verts= 267388
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -141,8 +128,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[49184452770057] = TemplatedLoader<0, 0x00aa2a00u, 0x41217009u, 0x00241209u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s16_C0_0_I8_565_
-// num_verts= 205232
+  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s16_C0_0_I8_565_ num_verts= 205232
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -153,8 +139,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20180412996502] = TemplatedLoader<0, 0x00002a00u, 0x40000c07u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx1_3_I16_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_
-// num_verts= 199470
+  // P_mtx1_3_I16_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_ num_verts= 199470
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -165,8 +150,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21168272485176] = TemplatedLoader<0, 0x00022b00u, 0x41217009u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_T0_mtx0_1_I8_u16_
-// num_verts= 166356
+  // P_mtx0_2_I8_s16_T0_mtx0_1_I8_u16_ num_verts= 166356
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -177,8 +161,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20687864274501] = TemplatedLoader<0, 0x00020200u, 0x40a00006u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_
-// num_verts= 145656
+  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s16_T0_mtx0_1_I8_u16_T1_mtx0_1_I8_u16_ num_verts= 145656
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -189,8 +172,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22041317604931] = TemplatedLoader<0, 0x000a0a00u, 0x40a00c07u, 0x00000005u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_
-// num_verts= 95860
+  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_ num_verts= 95860
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -201,8 +183,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20182123546855] = TemplatedLoader<0, 0x00002a00u, 0x40017008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_
-// num_verts= 79491
+  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_ num_verts= 79491
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -213,8 +194,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20873408940263] = TemplatedLoader<0, 0x00022a00u, 0x41217008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s8_T0_mtx0_1_I8_u8_
-// num_verts= 30036
+  // P_mtx0_2_I8_s8_T0_mtx0_1_I8_u8_ num_verts= 30036
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -225,8 +205,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20530418415873] = TemplatedLoader<0, 0x00020200u, 0x40200002u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_C0_1_I8_8888_T0_mtx0_1_I8_u8_
-// num_verts= 27333
+  // P_mtx0_2_I8_s16_C0_1_I8_8888_T0_mtx0_1_I8_u8_ num_verts= 27333
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -237,8 +216,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20553174326853] = TemplatedLoader<0, 0x00022200u, 0x40216006u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_T0_mtx0_1_I8_flt_
-// num_verts= 23029
+  // P_mtx0_2_I8_flt_T0_mtx0_1_I8_flt_ num_verts= 23029
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -249,8 +227,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20845310095591] = TemplatedLoader<0, 0x00020200u, 0x41200008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_
-// num_verts= 18384
+  // P_mtx0_2_I8_s16_T0_mtx0_1_I8_u8_T1_mtx0_1_I8_u8_ num_verts= 18384
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -261,8 +238,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21878548012750] = TemplatedLoader<0, 0x000a0200u, 0x40200006u, 0x00000001u, 0x00000000u>;
   }
-  // P_mtx1_2_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_
-// num_verts= 17440
+  // P_mtx1_2_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_ num_verts= 17440
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -273,8 +249,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[21144858364135] = TemplatedLoader<0, 0x00020a00u, 0x41201008u, 0x80000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_u16_T0_mtx0_1_I8_u8_
-// num_verts= 15716
+  // P_mtx0_2_I8_u16_T0_mtx0_1_I8_u8_ num_verts= 15716
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -285,8 +260,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20530418453411] = TemplatedLoader<0, 0x00020200u, 0x40200004u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s8_T0_mtx0_1_I8_u16_
-// num_verts= 6594
+  // P_mtx0_2_I8_s8_T0_mtx0_1_I8_u16_ num_verts= 6594
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -297,8 +271,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20687864199425] = TemplatedLoader<0, 0x00020200u, 0x40a00002u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u8_
-// num_verts= 5762
+  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u8_ num_verts= 5762
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -309,8 +282,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20556768365125] = TemplatedLoader<0, 0x00022a00u, 0x40200406u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_
-// num_verts= 4360
+  // P_mtx0_3_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_ num_verts= 4360
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -321,8 +293,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22198782646025] = TemplatedLoader<0, 0x000a0a00u, 0x41201009u, 0x00000009u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_
-// num_verts= 3500
+  // P_mtx0_2_I8_flt_Nrm_0_0_I8_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_ num_verts= 3500
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -333,8 +304,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22198782627256] = TemplatedLoader<0, 0x000a0a00u, 0x41201008u, 0x00000009u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_
-// num_verts= 2736
+  // P_mtx0_2_I8_flt_C0_1_I8_8888_T0_mtx0_1_I8_flt_ num_verts= 2736
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -345,8 +315,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20868065931495] = TemplatedLoader<0, 0x00022200u, 0x41216008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_s8_
-// num_verts= 2160
+  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_s8_ num_verts= 2160
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -357,8 +326,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20614426733125] = TemplatedLoader<0, 0x00020a00u, 0x40600406u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_C0_1_I8_8888_
-// num_verts= 1812
+  // P_mtx0_2_I8_s16_C0_1_I8_8888_ num_verts= 1812
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -369,8 +337,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20176780500549] = TemplatedLoader<0, 0x00002200u, 0x40016006u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u16_
-// num_verts= 768
+  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u16_ num_verts= 768
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -381,8 +348,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20714214148677] = TemplatedLoader<0, 0x00022a00u, 0x40a00406u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_
-// num_verts= 704
+  // P_mtx0_2_I8_flt_ num_verts= 704
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -393,8 +359,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20154024702183] = TemplatedLoader<0, 0x00000200u, 0x40000008u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_s8_
-// num_verts= 704
+  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_s8_ num_verts= 704
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -405,8 +370,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20635491275670] = TemplatedLoader<0, 0x00022a00u, 0x40600407u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_s16_
-// num_verts= 660
+  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_s16_ num_verts= 660
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -417,8 +381,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20771872516677] = TemplatedLoader<0, 0x00020a00u, 0x40e00406u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u16_
-// num_verts= 336
+  // P_mtx0_2_I8_flt_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u16_ num_verts= 336
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -429,8 +392,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20714214186215] = TemplatedLoader<0, 0x00022a00u, 0x40a00408u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_Nrm_0_0_I8_s8_T0_mtx0_1_I8_s8_
-// num_verts= 224
+  // P_mtx0_2_I8_flt_Nrm_0_0_I8_s8_T0_mtx0_1_I8_s8_ num_verts= 224
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -441,8 +403,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20614426770663] = TemplatedLoader<0, 0x00020a00u, 0x40600408u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_u16_
-// num_verts= 216
+  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_u16_ num_verts= 216
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -453,8 +414,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20693149624901] = TemplatedLoader<0, 0x00020a00u, 0x40a00406u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_
-// num_verts= 200
+  // P_mtx0_2_I8_flt_T0_mtx0_1_I8_flt_T1_mtx0_1_I8_flt_ num_verts= 200
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -465,8 +425,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[22193439618488] = TemplatedLoader<0, 0x000a0200u, 0x41200008u, 0x00000009u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u8_
-// num_verts= 140
+  // P_mtx0_3_I8_s16_Nrm_0_0_I8_s8_C0_0_I8_565_T0_mtx0_1_I8_u8_ num_verts= 140
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -477,8 +436,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20556768383894] = TemplatedLoader<0, 0x00022a00u, 0x40200407u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_3_I8_s8_Nrm_0_0_I8_s8_T0_mtx0_1_I8_u8_
-// num_verts= 120
+  // P_mtx0_3_I8_s8_Nrm_0_0_I8_s8_T0_mtx0_1_I8_u8_ num_verts= 120
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
@@ -489,8 +447,7 @@ void G_RSBP01_pvt::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)
   {
     pvlmap[20535703785042] = TemplatedLoader<0, 0x00020a00u, 0x40200403u, 0x00000000u, 0x00000000u>;
   }
-  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_u8_
-// num_verts= 48
+  // P_mtx0_2_I8_s16_Nrm_0_0_I8_s8_T0_mtx0_1_I8_u8_ num_verts= 48
 #if _M_SSE >= 0x301
   if (cpu_info.bSSSE3)
   {
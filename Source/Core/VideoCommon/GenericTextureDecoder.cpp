@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <cmath>
+#include <cstring>
 
 #include "Common/CPUDetect.h"
 #include "Common/Common.h"
@@ -14,6 +15,10 @@
 
 #include "VideoCommon/LookUpTables.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 bool TexFmt_Overlay_Enable = false;
 bool TexFmt_Overlay_Center = false;
 
@@ -1272,10 +1277,11 @@ inline u32 makeRGBA(u32 r, u32 g, u32 b, u32 a)
   return (a << 24) | (b << 16) | (g << 8) | r;
 }
 
-inline void decodeDXTBlock(u32* dst, const DXT1Block* src, u32 pitch)
+// Builds the four colors of a block, laid out by makecol or makeRGBA.
+template <u32 (*make)(u32, u32, u32, u32)>
+inline void decodeDXTColors(u32* colors, const DXT1Block* src)
 {
   // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
-  // Needs more speed.
   u16 c1 = Common::swap16(src->color1);
   u16 c2 = Common::swap16(src->color2);
   u32 blue1 = Convert5To8(c1 & 0x1F);
@@ -1284,65 +1290,29 @@ inline void decodeDXTBlock(u32* dst, const DXT1Block* src, u32 pitch)
   u32 green2 = Convert6To8((c2 >> 5) & 0x3F);
   u32 red1 = Convert5To8((c1 >> 11) & 0x1F);
   u32 red2 = Convert5To8((c2 >> 11) & 0x1F);
-  u32 colors[4];
-  colors[0] = makecol(red1, green1, blue1, 255);
-  colors[1] = makecol(red2, green2, blue2, 255);
+  colors[0] = make(red1, green1, blue1, 255);
+  colors[1] = make(red2, green2, blue2, 255);
   if (c1 > c2)
   {
     u32 blue3 = ((blue2 - blue1) >> 1) - ((blue2 - blue1) >> 3);
     u32 green3 = ((green2 - green1) >> 1) - ((green2 - green1) >> 3);
     u32 red3 = ((red2 - red1) >> 1) - ((red2 - red1) >> 3);
-    colors[2] = makecol(red1 + red3, green1 + green3, blue1 + blue3, 255);
-    colors[3] = makecol(red2 - red3, green2 - green3, blue2 - blue3, 255);
+    colors[2] = make(red1 + red3, green1 + green3, blue1 + blue3, 255);
+    colors[3] = make(red2 - red3, green2 - green3, blue2 - blue3, 255);
   }
   else
   {
-    colors[2] = makecol((red1 + red2 + 1) / 2,  // Average
-                        (green1 + green2 + 1) / 2, (blue1 + blue2 + 1) / 2, 255);
-    colors[3] = makecol(red2, green2, blue2, 0);  // Color2 but transparent
-  }
-
-  for (u32 y = 0; y < 4; y++)
-  {
-    u32 val = src->lines[y];
-    for (u32 x = 0; x < 4; x++)
-    {
-      dst[x] = colors[(val >> 6) & 3];
-      val <<= 2;
-    }
-    dst += pitch;
+    colors[2] = make((red1 + red2 + 1) / 2,  // Average
+                     (green1 + green2 + 1) / 2, (blue1 + blue2 + 1) / 2, 255);
+    colors[3] = make(red2, green2, blue2, 0);  // Color2 but transparent
   }
 }
 
-inline void decodeDXTBlockRGBA(u32* dst, const DXT1Block* src, u32 pitch)
+template <u32 (*make)(u32, u32, u32, u32)>
+inline void decodeDXTBlockWith(u32* dst, const DXT1Block* src, u32 pitch)
 {
-  // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
-  // Needs more speed.
-  u16 c1 = Common::swap16(src->color1);
-  u16 c2 = Common::swap16(src->color2);
-  u32 blue1 = Convert5To8(c1 & 0x1F);
-  u32 blue2 = Convert5To8(c2 & 0x1F);
-  u32 green1 = Convert6To8((c1 >> 5) & 0x3F);
-  u32 green2 = Convert6To8((c2 >> 5) & 0x3F);
-  u32 red1 = Convert5To8((c1 >> 11) & 0x1F);
-  u32 red2 = Convert5To8((c2 >> 11) & 0x1F);
   u32 colors[4];
-  colors[0] = makeRGBA(red1, green1, blue1, 255);
-  colors[1] = makeRGBA(red2, green2, blue2, 255);
-  if (c1 > c2)
-  {
-    u32 blue3 = ((blue2 - blue1) >> 1) - ((blue2 - blue1) >> 3);
-    u32 green3 = ((green2 - green1) >> 1) - ((green2 - green1) >> 3);
-    u32 red3 = ((red2 - red1) >> 1) - ((red2 - red1) >> 3);
-    colors[2] = makeRGBA(red1 + red3, green1 + green3, blue1 + blue3, 255);
-    colors[3] = makeRGBA(red2 - red3, green2 - green3, blue2 - blue3, 255);
-  }
-  else
-  {
-    colors[2] = makeRGBA((red1 + red2 + 1) / 2,  // Average
-                         (green1 + green2 + 1) / 2, (blue1 + blue2 + 1) / 2, 255);
-    colors[3] = makeRGBA(red2, green2, blue2, 0);  // Color2 but transparent
-  }
+  decodeDXTColors<make>(colors, src);
 
   for (u32 y = 0; y < 4; y++)
   {
@@ -1356,6 +1326,16 @@ inline void decodeDXTBlockRGBA(u32* dst, const DXT1Block* src, u32 pitch)
   }
 }
 
+inline void decodeDXTBlock(u32* dst, const DXT1Block* src, u32 pitch)
+{
+  decodeDXTBlockWith<makecol>(dst, src, pitch);
+}
+
+inline void decodeDXTBlockRGBA(u32* dst, const DXT1Block* src, u32 pitch)
+{
+  decodeDXTBlockWith<makeRGBA>(dst, src, pitch);
+}
+
 inline void DXT1ToDXT3Block(DXT3Block* dst, const DXT1Block* src)
 {
   DXT3Block result;
@@ -1388,6 +1368,54 @@ inline void DXT1ToDXT3Block(DXT3Block* dst, const DXT1Block* src)
   *dst = result;
 }
 
+// BC1 is the same as CMPR, but with little endian colors and the first texel of a row in the
+// low bits.
+inline void DXT1ToBC1Block(DXT1Block* dst, const DXT1Block* src)
+{
+  DXT1Block result = *src;
+  result.color1 = Common::swap16(result.color1);
+  result.color2 = Common::swap16(result.color2);
+  result.indices = ((result.indices >> 4) & 0x0F0F0F0F) | ((result.indices << 4) & 0xF0F0F0F0);
+  result.indices = ((result.indices >> 2) & 0x33333333) | ((result.indices << 2) & 0xCCCCCCCC);
+  *dst = result;
+}
+
+// Puts the four 4x4 blocks of each 8x8 CMPR block in place for the GPU:
+// 11111111 22222222 55555555 66666666
+// 33333333 44444444 77777777 88888888
+template <typename Block, void (*convert)(Block*, const DXT1Block*)>
+static void ReorderDXTBlocks(Block* dst, const DXT1Block* src, u32 width, u32 height)
+{
+  const u32 bheight = height >> 2;
+  const u32 bwidth = width >> 2;
+  for (u32 y = 0; y < bheight; y += 2)
+  {
+    Block* line1 = dst + y * bwidth;
+    Block* line2 = line1 + bwidth;
+    for (u32 x = 0; x < bwidth; x += 2)
+    {
+      convert(line1++, src++);
+      convert(line1++, src++);
+      convert(line2++, src++);
+      convert(line2++, src++);
+    }
+  }
+}
+
+bool CMPRHasTransparentTexels(const u8* src, u32 size)
+{
+  const DXT1Block* block = (const DXT1Block*)src;
+  for (u32 i = 0; i < size / sizeof(DXT1Block); i++, block++)
+  {
+    if (Common::swap16(block->color1) > Common::swap16(block->color2))
+      continue;
+    // Index 3 is the transparent one in blocks with three colors.
+    if ((block->indices & (block->indices >> 1) & 0x55555555) != 0)
+      return true;
+  }
+  return false;
+}
+
 static HostTextureFormat GetPCFormatFromTLUTFormat(u32 tlutfmt)
 {
   switch (tlutfmt)
@@ -1442,7 +1470,7 @@ HostTextureFormat GetHostTextureFormat(u32 texformat, TlutFormat tlutfmt, bool c
                     // The metroid games use this format almost exclusively.
     if (compressed_supported)
     {
-      fmt = PC_TEX_FMT_DXT3;
+      fmt = PC_TEX_FMT_DXT1;
     }
     else
     {
@@ -1453,12 +1481,417 @@ HostTextureFormat GetHostTextureFormat(u32 texformat, TlutFormat tlutfmt, bool c
   return fmt;
 }
 
+#ifdef _M_ARM_64
+// NEON decoders. AArch64 always has NEON, so these run for every format they cover and the rest
+// returns PC_TEX_FMT_NONE for the scalar decoders below. Texels go four at a time as 32 bit lanes,
+// or eight at a time as bytes with interleaving stores. Palettes are decoded once per texture;
+// C4 looks them up with table lookups, C8 and C14X2 with plain loads.
+
+enum class NEONOutput
+{
+  RGBA,
+  BGRA,
+  Raw16,  // The TLUT entries byteswapped, for IA8 and RGB565 palettes.
+};
+
+static inline uint8x8_t Expand4To8_NEON(uint8x8_t v)
+{
+  return vsli_n_u8(v, v, 4);
+}
+
+static inline uint8x16_t Expand4To8_NEON(uint8x16_t v)
+{
+  return vsliq_n_u8(v, v, 4);
+}
+
+static inline uint32x4_t Field_NEON(uint32x4_t v, u32 mask)
+{
+  return vandq_u32(v, vdupq_n_u32(mask));
+}
+
+// vshrq_n_u32 takes shifts from 1 to 32 only, hence the overload above for the low bits.
+template <int shift>
+static inline uint32x4_t Field_NEON(uint32x4_t v, u32 mask)
+{
+  return Field_NEON(vshrq_n_u32(v, shift), mask);
+}
+
+static inline uint32x4_t Expand3To8_NEON(uint32x4_t v)
+{
+  return vorrq_u32(vorrq_u32(vshlq_n_u32(v, 5), vshlq_n_u32(v, 2)), vshrq_n_u32(v, 1));
+}
+
+static inline uint32x4_t Expand4To8_NEON(uint32x4_t v)
+{
+  return vorrq_u32(vshlq_n_u32(v, 4), v);
+}
+
+static inline uint32x4_t Expand5To8_NEON(uint32x4_t v)
+{
+  return vorrq_u32(vshlq_n_u32(v, 3), vshrq_n_u32(v, 2));
+}
+
+static inline uint32x4_t Expand6To8_NEON(uint32x4_t v)
+{
+  return vorrq_u32(vshlq_n_u32(v, 2), vshrq_n_u32(v, 4));
+}
+
+static inline uint32x4_t MakeColor_NEON(uint32x4_t r, uint32x4_t g, uint32x4_t b, uint32x4_t a,
+                                        bool bgra)
+{
+  return vorrq_u32(vorrq_u32(bgra ? b : r, vshlq_n_u32(g, 8)),
+                   vorrq_u32(vshlq_n_u32(bgra ? r : b, 16), vshlq_n_u32(a, 24)));
+}
+
+// The decoders below take four byteswapped 16 bit values, one in the low half of each lane.
+static inline uint32x4_t DecodeIA8_NEON(uint32x4_t v)
+{
+  const uint32x4_t i = vandq_u32(v, vdupq_n_u32(0xFF));
+  return vorrq_u32(vmulq_n_u32(i, 0x010101), vshlq_n_u32(vshrq_n_u32(v, 8), 24));
+}
+
+static inline uint32x4_t Decode565_NEON(uint32x4_t v, bool bgra)
+{
+  return MakeColor_NEON(Expand5To8_NEON(Field_NEON<11>(v, 0x1F)),
+                        Expand6To8_NEON(Field_NEON<5>(v, 0x3F)),
+                        Expand5To8_NEON(Field_NEON(v, 0x1F)), vdupq_n_u32(0xFF), bgra);
+}
+
+static inline uint32x4_t Decode5A3_NEON(uint32x4_t v, bool bgra)
+{
+  const uint32x4_t opaque = MakeColor_NEON(
+      Expand5To8_NEON(Field_NEON<10>(v, 0x1F)), Expand5To8_NEON(Field_NEON<5>(v, 0x1F)),
+      Expand5To8_NEON(Field_NEON(v, 0x1F)), vdupq_n_u32(0xFF), bgra);
+  const uint32x4_t translucent = MakeColor_NEON(
+      Expand4To8_NEON(Field_NEON<8>(v, 0xF)), Expand4To8_NEON(Field_NEON<4>(v, 0xF)),
+      Expand4To8_NEON(Field_NEON(v, 0xF)), Expand3To8_NEON(Field_NEON<12>(v, 0x7)), bgra);
+  return vbslq_u32(vtstq_u32(v, vdupq_n_u32(0x8000)), opaque, translucent);
+}
+
+static inline uint32x4_t DecodeTlut_NEON(uint32x4_t v, u32 tlutfmt, NEONOutput output)
+{
+  if (output == NEONOutput::Raw16)
+    return v;
+  switch (tlutfmt)
+  {
+  case GX_TL_IA8:
+    return DecodeIA8_NEON(v);
+  case GX_TL_RGB565:
+    return Decode565_NEON(v, output == NEONOutput::BGRA);
+  default:
+    return Decode5A3_NEON(v, output == NEONOutput::BGRA);
+  }
+}
+
+// Loads four big endian 16 bit values, byteswapped and zero extended.
+static inline uint32x4_t Load16_NEON(const void* src)
+{
+  return vmovl_u16(vreinterpret_u16_u8(vrev16_u8(vld1_u8((const u8*)src))));
+}
+
+// Splits four bytes into eight nibbles, the high one first.
+static inline uint8x8_t LoadNibbles_NEON(const u8* src)
+{
+  u32 bytes;
+  std::memcpy(&bytes, src, sizeof(bytes));
+  const uint8x8_t v = vreinterpret_u8_u32(vdup_n_u32(bytes));
+  return vzip1_u8(vshr_n_u8(v, 4), vand_u8(v, vdup_n_u8(0xF)));
+}
+
+// Looks up four texels in a table of sixteen 32 bit colors.
+static inline uint32x4_t Lookup16_NEON(const uint8x16x4_t& table, uint32x4_t index)
+{
+  const uint32x4_t bytes = vaddq_u32(vmulq_n_u32(index, 0x04040404), vdupq_n_u32(0x03020100));
+  return vreinterpretq_u32_u8(vqtbl4q_u8(table, vreinterpretq_u8_u32(bytes)));
+}
+
+// Stores a row of eight texels.
+static inline void StoreRow8_NEON(u8* dst, uint32x4_t left, uint32x4_t right, NEONOutput output)
+{
+  if (output == NEONOutput::Raw16)
+  {
+    vst1q_u16((u16*)dst, vcombine_u16(vmovn_u32(left), vmovn_u32(right)));
+  }
+  else
+  {
+    vst1q_u32((u32*)dst, left);
+    vst1q_u32((u32*)dst + 4, right);
+  }
+}
+
+// Stores a row of four texels.
+static inline void StoreRow4_NEON(u8* dst, uint32x4_t v, NEONOutput output)
+{
+  if (output == NEONOutput::Raw16)
+    vst1_u16((u16*)dst, vmovn_u32(v));
+  else
+    vst1q_u32((u32*)dst, v);
+}
+
+// Decodes a whole palette of 16 or 256 entries.
+static void DecodePalette_NEON(u32* palette, u32 tlutaddr, u32 count, u32 tlutfmt,
+                               NEONOutput output)
+{
+  const u16* tlut = (const u16*)(texMem + tlutaddr);
+  for (u32 i = 0; i < count; i += 4)
+    vst1q_u32(palette + i, DecodeTlut_NEON(Load16_NEON(tlut + i), tlutfmt, output));
+}
+
+static void DecodeDXTBlock_NEON(u32* dst, const DXT1Block* src, u32 width, bool bgra)
+{
+  u32 colors[4];
+  if (bgra)
+    decodeDXTColors<makecol>(colors, src);
+  else
+    decodeDXTColors<makeRGBA>(colors, src);
+  const uint8x16_t palette = vld1q_u8((const u8*)colors);
+  // Each row is a byte of indices with the first texel in the top bits.
+  const int32x4_t shifts = {-6, -4, -2, 0};
+  for (u32 y = 0; y < 4; y++)
+  {
+    const uint32x4_t index =
+        vandq_u32(vshlq_u32(vdupq_n_u32(src->lines[y]), shifts), vdupq_n_u32(3));
+    const uint32x4_t bytes = vaddq_u32(vmulq_n_u32(index, 0x04040404), vdupq_n_u32(0x03020100));
+    vst1q_u8((u8*)(dst + y * width), vqtbl1q_u8(palette, vreinterpretq_u8_u32(bytes)));
+  }
+}
+
+static HostTextureFormat Decode_NEON(u8* dst, const u8* src, u32 width, u32 height, u32 texformat,
+                                     u32 tlutaddr, u32 tlutfmt, bool rgba,
+                                     HostTextureFormat compressed_format)
+{
+  const NEONOutput color_output = rgba ? NEONOutput::RGBA : NEONOutput::BGRA;
+  const NEONOutput tlut_output =
+      (rgba || tlutfmt == GX_TL_RGB5A3) ? color_output : NEONOutput::Raw16;
+  const u32 tlut_texel_size = tlut_output == NEONOutput::Raw16 ? 2 : 4;
+  u32* dst32 = (u32*)dst;
+  u16* dst16 = (u16*)dst;
+
+  switch (texformat)
+  {
+  case GX_TF_I4:
+    for (u32 y = 0; y < height; y += 8)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        if (!rgba)
+        {
+          // Sixteen bytes are four rows, zipping gives two rows at a time.
+          for (u32 half = 0; half < 2; half++)
+          {
+            const uint8x16_t v = vld1q_u8(src + half * 16);
+            const uint8x16_t hi = Expand4To8_NEON(vshrq_n_u8(v, 4));
+            const uint8x16_t lo = Expand4To8_NEON(vandq_u8(v, vdupq_n_u8(0xF)));
+            const uint8x16_t rows[2] = {vzip1q_u8(hi, lo), vzip2q_u8(hi, lo)};
+            for (u32 i = 0; i < 2; i++)
+            {
+              u8* row = dst + (y + half * 4 + i * 2) * width + x;
+              vst1_u8(row, vget_low_u8(rows[i]));
+              vst1_u8(row + width, vget_high_u8(rows[i]));
+            }
+          }
+          continue;
+        }
+        for (u32 iy = 0; iy < 8; iy++)
+        {
+          const uint8x8_t i = Expand4To8_NEON(LoadNibbles_NEON(src + iy * 4));
+          vst4_u8((u8*)(dst32 + (y + iy) * width + x), (uint8x8x4_t{{i, i, i, i}}));
+        }
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_I4_AS_I8;
+
+  case GX_TF_I8:
+    // The native format is a plain copy.
+    if (!rgba)
+      return PC_TEX_FMT_NONE;
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const uint8x8_t i = vld1_u8(src + iy * 8);
+          vst4_u8((u8*)(dst32 + (y + iy) * width + x), (uint8x8x4_t{{i, i, i, i}}));
+        }
+      }
+    }
+    return PC_TEX_FMT_RGBA32;
+
+  case GX_TF_IA4:
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const uint8x8_t v = vld1_u8(src + iy * 8);
+          const uint8x8_t a = Expand4To8_NEON(vshr_n_u8(v, 4));
+          const uint8x8_t i = Expand4To8_NEON(vand_u8(v, vdup_n_u8(0xF)));
+          if (rgba)
+            vst4_u8((u8*)(dst32 + (y + iy) * width + x), (uint8x8x4_t{{i, i, i, a}}));
+          else
+            vst2_u8((u8*)(dst16 + (y + iy) * width + x), (uint8x8x2_t{{i, a}}));
+        }
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_IA4_AS_IA8;
+
+  case GX_TF_IA8:
+  case GX_TF_RGB565:
+  case GX_TF_RGB5A3:
+  {
+    const bool raw = !rgba && texformat != GX_TF_RGB5A3;
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 4, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          if (raw)
+          {
+            vst1_u8((u8*)(dst16 + (y + iy) * width + x), vrev16_u8(vld1_u8(src + iy * 8)));
+            continue;
+          }
+          const uint32x4_t v = Load16_NEON(src + iy * 8);
+          uint32x4_t texels;
+          if (texformat == GX_TF_IA8)
+            texels = DecodeIA8_NEON(v);
+          else if (texformat == GX_TF_RGB565)
+            texels = Decode565_NEON(v, false);
+          else
+            texels = Decode5A3_NEON(v, !rgba);
+          vst1q_u32(dst32 + (y + iy) * width + x, texels);
+        }
+      }
+    }
+    if (raw)
+      return texformat == GX_TF_IA8 ? PC_TEX_FMT_IA8 : PC_TEX_FMT_RGB565;
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_BGRA32;
+  }
+
+  case GX_TF_RGBA8:
+    // Each block is 16 AR pairs followed by 16 GB pairs.
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 4, src += 64)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const uint32x4_t ar = vmovl_u16(vld1_u16((const u16*)(src + iy * 8)));
+          const uint32x4_t gb = vmovl_u16(vld1_u16((const u16*)(src + 32 + iy * 8)));
+          // A R G B in memory order, one texel per lane.
+          const uint32x4_t argb = vorrq_u32(ar, vshlq_n_u32(gb, 16));
+          const uint32x4_t texels =
+              rgba ? vorrq_u32(vshrq_n_u32(argb, 8), vshlq_n_u32(argb, 24)) :
+                     vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(argb)));
+          vst1q_u32(dst32 + (y + iy) * width + x, texels);
+        }
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_BGRA32;
+
+  case GX_TF_C4:
+  {
+    u32 palette[16];
+    DecodePalette_NEON(palette, tlutaddr, 16, tlutfmt, tlut_output);
+    const u8* bytes = (const u8*)palette;
+    const uint8x16x4_t table = {
+        {vld1q_u8(bytes), vld1q_u8(bytes + 16), vld1q_u8(bytes + 32), vld1q_u8(bytes + 48)}};
+    for (u32 y = 0; y < height; y += 8)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        for (u32 iy = 0; iy < 8; iy++)
+        {
+          const uint16x8_t index = vmovl_u8(LoadNibbles_NEON(src + iy * 4));
+          StoreRow8_NEON(dst + ((y + iy) * width + x) * tlut_texel_size,
+                         Lookup16_NEON(table, vmovl_u16(vget_low_u16(index))),
+                         Lookup16_NEON(table, vmovl_u16(vget_high_u16(index))), tlut_output);
+        }
+      }
+    }
+    break;
+  }
+
+  case GX_TF_C8:
+  {
+    u32 palette[256];
+    DecodePalette_NEON(palette, tlutaddr, 256, tlutfmt, tlut_output);
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const u8* index = src + iy * 8;
+          const uint32x4_t left = {palette[index[0]], palette[index[1]], palette[index[2]],
+                                   palette[index[3]]};
+          const uint32x4_t right = {palette[index[4]], palette[index[5]], palette[index[6]],
+                                    palette[index[7]]};
+          StoreRow8_NEON(dst + ((y + iy) * width + x) * tlut_texel_size, left, right, tlut_output);
+        }
+      }
+    }
+    break;
+  }
+
+  case GX_TF_C14X2:
+  {
+    // Too many entries to decode them up front, so only the decoding is vectorized.
+    const u16* tlut = (const u16*)(texMem + tlutaddr);
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 4, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const u16* index = (const u16*)(src + iy * 8);
+          u16 entries[4];
+          for (u32 i = 0; i < 4; i++)
+            entries[i] = tlut[Common::swap16(index[i]) & 0x3FFF];
+          StoreRow4_NEON(dst + ((y + iy) * width + x) * tlut_texel_size,
+                         DecodeTlut_NEON(Load16_NEON(entries), tlutfmt, tlut_output), tlut_output);
+        }
+      }
+    }
+    break;
+  }
+
+  case GX_TF_CMPR:
+    // Converting to BC1 or DXT3 for the GPU stays on the scalar path.
+    if (!rgba &&
+        (compressed_format == PC_TEX_FMT_DXT1 || compressed_format == PC_TEX_FMT_DXT3))
+      return PC_TEX_FMT_NONE;
+    for (u32 y = 0; y < height; y += 8)
+    {
+      for (u32 x = 0; x < width; x += 8)
+      {
+        const DXT1Block* block = (const DXT1Block*)src;
+        DecodeDXTBlock_NEON(dst32 + y * width + x, block, width, !rgba);
+        DecodeDXTBlock_NEON(dst32 + y * width + x + 4, block + 1, width, !rgba);
+        DecodeDXTBlock_NEON(dst32 + (y + 4) * width + x, block + 2, width, !rgba);
+        DecodeDXTBlock_NEON(dst32 + (y + 4) * width + x + 4, block + 3, width, !rgba);
+        src += sizeof(DXT1Block) * 4;
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_BGRA32;
+
+  default:
+    return PC_TEX_FMT_NONE;
+  }
+
+  return rgba ? PC_TEX_FMT_RGBA32 : GetPCFormatFromTLUTFormat(tlutfmt);
+}
+#endif
+
 // switch endianness, unswizzle
 // TODO: to save memory, don't blindly convert everything to argb8888
 // also ARGB order needs to be swapped later, to accommodate modern hardware better
 // need to add DXT support too
 static HostTextureFormat Decode_real(u8* dst, const u8* src, u32 width, u32 height, u32 texformat,
-                                     u32 tlutaddr, TlutFormat tlutfmt, bool compressed_supported)
+                                     u32 tlutaddr, TlutFormat tlutfmt,
+                                     HostTextureFormat compressed_format)
 {
   const u32 Wsteps4 = (width + 3) / 4;
   const u32 Wsteps8 = (width + 7) / 8;
@@ -1603,29 +2036,17 @@ static HostTextureFormat Decode_real(u8* dst, const u8* src, u32 width, u32 heig
   case GX_TF_CMPR:  // speed critical
                     // The metroid games use this format almost exclusively.
   {
-    if (compressed_supported)
+    if (compressed_format == PC_TEX_FMT_DXT1)
     {
-      // Transfor dxt1 to dxt3 to allow compatibility and minimize space
-      // 11111111 22222222 55555555 66666666
-      // 33333333 44444444 77777777 88888888
-      DXT3Block* bdst = (DXT3Block*)dst;
-      const DXT1Block* bsrc = (DXT1Block*)src;
-      u32 bheight = height >> 2;
-      u32 bwidth = width >> 2;
-      for (u32 y = 0; y < bheight; y += 2)
-      {
-        u32 yStep = y * bwidth;
-        const DXT1Block* src2 = bsrc + yStep;
-        DXT3Block* line1 = bdst + yStep;
-        DXT3Block* line2 = line1 + bwidth;
-        for (u32 x = 0; x < bwidth; x += 2)
-        {
-          DXT1ToDXT3Block(line1++, src2++);
-          DXT1ToDXT3Block(line1++, src2++);
-          DXT1ToDXT3Block(line2++, src2++);
-          DXT1ToDXT3Block(line2++, src2++);
-        }
-      }
+      ReorderDXTBlocks<DXT1Block, DXT1ToBC1Block>((DXT1Block*)dst, (const DXT1Block*)src, width,
+                                                  height);
+      return PC_TEX_FMT_DXT1;
+    }
+    else if (compressed_format == PC_TEX_FMT_DXT3)
+    {
+      // DXT3 keeps the color of transparent texels, BC1 makes them black
+      ReorderDXTBlocks<DXT3Block, DXT1ToDXT3Block>((DXT3Block*)dst, (const DXT1Block*)src, width,
+                                                   height);
       return PC_TEX_FMT_DXT3;
     }
     else
@@ -1799,8 +2220,8 @@ HostTextureFormat Decode_RGBA(u32* dst, const u8* src, u32 width, u32 height, u3
       for (u32 y = 0; y < height; y += 4)
         for (u32 x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
           for (u32 iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
-            decodebytesC14X2_5A3_To_BGRA32(dst + (y + iy) * width + x, (u16*)(src + 8 * xStep),
-                                           tlutaddr);
+            decodebytesC14X2_5A3_To_RGBA(dst + (y + iy) * width + x, (u16*)(src + 8 * xStep),
+                                         tlutaddr);
     }
     else if (tlutfmt == 0)
     {
@@ -1887,18 +2308,26 @@ void SetTexFmtOverlayOptions(bool enable, bool center)
 }
 
 HostTextureFormat Decode(u8* dst, const u8* src, u32 width, u32 height, u32 texformat, u32 tlutaddr,
-                         TlutFormat tlutfmt, bool rgbaOnly, bool compressed_supported)
+                         TlutFormat tlutfmt, bool rgbaOnly, HostTextureFormat compressed_format)
 {
   HostTextureFormat retval = PC_TEX_FMT_NONE;
 
-  if (rgbaOnly)
+#ifdef _M_ARM_64
+  retval = Decode_NEON(dst, src, width, height, texformat, tlutaddr, tlutfmt, rgbaOnly,
+                       compressed_format);
+#endif
+  if (retval != PC_TEX_FMT_NONE)
+  {
+    // Done above.
+  }
+  else if (rgbaOnly)
   {
     retval = Decode_RGBA((u32*)dst, src, width, height, texformat, tlutaddr, tlutfmt);
   }
   else
   {
     retval =
-        Decode_real(dst, src, width, height, texformat, tlutaddr, tlutfmt, compressed_supported);
+        Decode_real(dst, src, width, height, texformat, tlutaddr, tlutfmt, compressed_format);
   }
   if ((!TexFmt_Overlay_Enable) || (retval == PC_TEX_FMT_NONE))
     return retval;
@@ -18,7 +18,7 @@ static const char* primitives_d3d[] = {"point", "line", "triangle"};
 
 bool geometry_shader_uid_data::IsPassthrough() const
 {
-  const bool stereo = g_ActiveConfig.iStereoMode > 0;
+  const bool stereo = g_ActiveConfig.iStereoMode > 0 && !g_ActiveConfig.UseVertexShaderStereo();
   const bool wireframe = g_ActiveConfig.bWireFrame;
   return primitive_type == static_cast<u32>(PrimitiveType::Triangles) && !stereo && !wireframe;
 }
@@ -86,10 +86,33 @@ inline void EndPrimitive(ShaderCode& out, API_TYPE ApiType,
     out.Write("\toutput.RestartStrip();\n");
 }
 
+void GenerateGeometryShaderConstants(ShaderCode& out, API_TYPE ApiType)
+{
+  if (ApiType == API_OPENGL || ApiType == API_VULKAN)
+    out.Write("UBO_BINDING(std140, 3) uniform GSBlock {\n");
+  else
+    out.Write("cbuffer GSBlock {\n");
+  out.Write("\tfloat4 " I_STEREOPARAMS ";\n"
+            "\tfloat4 " I_LINEPTPARAMS ";\n"
+            "\tint4 " I_TEXOFFSET ";\n"
+            "};\n");
+}
+
+void GenerateVertexShaderStereo(ShaderCode& out, const char* vertex)
+{
+  // The draw is instanced once per eye, the offset matches the geometry shader path.
+  out.Write("int eye = gl_InstanceID;\n");
+  out.Write("float hoffset = (eye == 0) ? " I_STEREOPARAMS ".x : " I_STEREOPARAMS ".y;\n");
+  out.Write("%s.pos.x += hoffset * (%s.pos.w - " I_STEREOPARAMS ".z);\n", vertex, vertex);
+}
+
 inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
                                    const geometry_shader_uid_data& uid_data,
                                    const ShaderHostConfig& hostconfig)
 {
+  // With vertex shader stereo every eye is a separate instance, the geometry shader only expands
+  // lines and points and forwards the layer.
+  const bool gs_stereo = hostconfig.stereo && !hostconfig.vs_stereo;
   const unsigned int vertex_in = uid_data.primitive_type + 1;
   unsigned int vertex_out =
       uid_data.primitive_type == static_cast<u32>(PrimitiveType::Triangles) ? 3 : 4;
@@ -103,7 +126,7 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
     if (hostconfig.backend_gs_instancing)
     {
       out.Write("layout(%s, invocations = %d) in;\n", primitives_ogl[uid_data.primitive_type],
-                hostconfig.stereo ? 2 : 1);
+                gs_stereo ? 2 : 1);
       out.Write("layout(%s_strip, max_vertices = %d) out;\n",
                 hostconfig.wireframe ? "line" : "triangle", vertex_out);
     }
@@ -112,19 +135,12 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
       out.Write("layout(%s) in;\n", primitives_ogl[uid_data.primitive_type]);
       out.Write("layout(%s_strip, max_vertices = %d) out;\n",
                 hostconfig.wireframe ? "line" : "triangle",
-                hostconfig.stereo ? vertex_out * 2 : vertex_out);
+                gs_stereo ? vertex_out * 2 : vertex_out);
     }
   }
 
   // uniforms
-  if (ApiType == API_OPENGL || ApiType == API_VULKAN)
-    out.Write("UBO_BINDING(std140, 3) uniform GSBlock {\n");
-  else
-    out.Write("cbuffer GSBlock {\n");
-  out.Write("\tfloat4 " I_STEREOPARAMS ";\n"
-            "\tfloat4 " I_LINEPTPARAMS ";\n"
-            "\tint4 " I_TEXOFFSET ";\n"
-            "};\n");
+  GenerateGeometryShaderConstants(out, ApiType);
 
   out.Write("struct VS_OUTPUT {\n");
   GenerateVSOutputMembers(out, ApiType, uid_data.pixel_lighting, uid_data.numTexGens);
@@ -139,6 +155,8 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
     GenerateVSOutputMembers(
         out, ApiType, uid_data.pixel_lighting, uid_data.numTexGens,
         GetInterpolationQualifier(ApiType, hostconfig.msaa, hostconfig.ssaa, true, true));
+    if (hostconfig.vs_stereo)
+      out.Write("\tflat int layer;\n");
     out.Write("} vs[%d];\n", vertex_in);
 
     out.Write("VARYING_LOCATION(0) out VertexData {\n");
@@ -165,7 +183,7 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
 
     if (g_ActiveConfig.backend_info.bSupportsGSInstancing)
     {
-      out.Write("[maxvertexcount(%d)]\n[instance(%d)]\n", vertex_out, hostconfig.stereo ? 2 : 1);
+      out.Write("[maxvertexcount(%d)]\n[instance(%d)]\n", vertex_out, gs_stereo ? 2 : 1);
       out.Write("void main(%s VS_OUTPUT o[%d], inout %sStream<VertexData> output, in uint "
                 "InstanceID : SV_GSInstanceID)\n{\n",
                 primitives_d3d[uid_data.primitive_type], vertex_in,
@@ -173,7 +191,7 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
     }
     else
     {
-      out.Write("[maxvertexcount(%d)]\n", hostconfig.stereo ? vertex_out * 2 : vertex_out);
+      out.Write("[maxvertexcount(%d)]\n", gs_stereo ? vertex_out * 2 : vertex_out);
       out.Write("void main(%s VS_OUTPUT o[%d], inout %sStream<VertexData> output)\n{\n",
                 primitives_d3d[uid_data.primitive_type], vertex_in,
                 hostconfig.wireframe ? "Line" : "Triangle");
@@ -234,7 +252,7 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
               ".x, -" I_LINEPTPARAMS ".w / " I_LINEPTPARAMS ".y) * center.pos.w;\n");
   }
 
-  if (hostconfig.stereo)
+  if (gs_stereo)
   {
     // If the GPU supports invocation we don't need a for loop and can simply use the
     // invocation identifier to determine which layer we're rendering.
@@ -267,7 +285,13 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
     out.Write("\tVS_OUTPUT f = o[i];\n");
   }
 
-  if (hostconfig.stereo)
+  if (hostconfig.vs_stereo)
+  {
+    // The vertex shader selected the eye of the instance
+    out.Write("\tps.layer = vs[i].layer;\n");
+    out.Write("\tgl_Layer = vs[i].layer;\n");
+  }
+  else if (hostconfig.stereo)
   {
     // Select the output layer
     out.Write("\tps.layer = eye;\n");
@@ -346,7 +370,7 @@ inline void GenerateGeometryShader(ShaderCode& out, API_TYPE ApiType,
 
   EndPrimitive(out, ApiType, uid_data, hostconfig);
 
-  if (hostconfig.stereo && !hostconfig.backend_gs_instancing)
+  if (gs_stereo && !hostconfig.backend_gs_instancing)
     out.Write("\t}\n");
 
   out.Write("}\n");
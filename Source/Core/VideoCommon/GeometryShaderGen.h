@@ -49,5 +49,9 @@ struct geometry_shader_uid_data
 typedef ShaderUid<geometry_shader_uid_data> GeometryShaderUid;
 
 void GenerateGeometryShaderCode(ShaderCode& object, const geometry_shader_uid_data& uid_data, const ShaderHostConfig& hostconfig);
+// The GSBlock uniforms, vertex shaders doing stereo read the stereo parameters from it.
+void GenerateGeometryShaderConstants(ShaderCode& out, API_TYPE ApiType);
+// Offsets the position of vertex for the eye of the instance, when ShaderHostConfig::vs_stereo.
+void GenerateVertexShaderStereo(ShaderCode& out, const char* vertex);
 void GetGeometryShaderUid(GeometryShaderUid& object, PrimitiveType primitive_type, const XFMemory &xfr, const u32 components);
 void EnumerateGeometryShaderUids(const std::function<void(const GeometryShaderUid&, size_t)>& callback);
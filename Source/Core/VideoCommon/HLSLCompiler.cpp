@@ -3,9 +3,15 @@
 // Refer to the license.txt file included.
 // Added for Ishiiruka By Tino
 
-#include "Common/CPUDetect.h"
 #include "VideoCommon/HLSLCompiler.h"
 
+#include <algorithm>
+
+#include "Common/CPUDetect.h"
+#include "Common/Timer.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoConfig.h"
+
 
 ShaderCompilerWorkUnit::ShaderCompilerWorkUnit() :
   flags(0),
@@ -16,7 +22,10 @@ ShaderCompilerWorkUnit::ShaderCompilerWorkUnit() :
   target(nullptr),
   shaderbytecode(nullptr),
   error(nullptr),
-  ResultHandler()
+  ResultHandler(),
+  CancelHandler(),
+  priority(nullptr),
+  priority_class(CompilePriority::OnDemand)
 {
 
 }
@@ -25,6 +34,9 @@ void ShaderCompilerWorkUnit::Clear()
 {
   GenerateCodeHandler = {};
   ResultHandler = {};
+  CancelHandler = {};
+  priority = nullptr;
+  priority_class = CompilePriority::OnDemand;
   cresult = 0;
   defines = nullptr;
   entrypoint = nullptr;
@@ -56,16 +68,17 @@ void ShaderCompilerWorkUnit::Release()
   }
 }
 
+const std::atomic<u32> HLSLAsyncCompiler::HIGHEST_PRIORITY{UINT32_MAX};
+
 HLSLAsyncCompiler::HLSLAsyncCompiler() :
-  m_input(repository_size),
   m_output(repository_size)
 {
+  m_input.reserve(repository_size);
   WorkUnitRepository = new ShaderCompilerWorkUnit[repository_size];
   for (size_t i = 0; i < repository_size; i++)
   {
     m_repository.push_back(std::move(&WorkUnitRepository[i]));
   }
-  Common::ThreadPool::RegisterWorker(this);
 }
 
 void HLSLAsyncCompiler::SetCompilerFunction(pD3DCompile compilerfunc)
@@ -75,33 +88,93 @@ void HLSLAsyncCompiler::SetCompilerFunction(pD3DCompile compilerfunc)
 
 HLSLAsyncCompiler::~HLSLAsyncCompiler()
 {
-  Common::ThreadPool::UnregisterWorker(this);
   delete[] WorkUnitRepository;
 }
 
-bool HLSLAsyncCompiler::NextTask(size_t ID)
+// Ties keep the submission order.
+ShaderCompilerWorkUnit* HLSLAsyncCompiler::PopHighestPriorityUnit()
 {
-  ShaderCompilerWorkUnit* unit = nullptr;
-  if (m_input.try_pop(unit))
+  std::lock_guard<std::mutex> guard(m_input_lock);
+  if (m_input.empty())
+    return nullptr;
+  const auto get_priority = [](const ShaderCompilerWorkUnit* unit) {
+    const u32 hits = unit->priority ? unit->priority->load(std::memory_order_relaxed) : 0;
+    return (static_cast<u64>(unit->priority_class) << 32) | hits;
+  };
+  auto best = m_input.begin();
+  u64 best_priority = get_priority(*best);
+  for (auto it = std::next(best); it != m_input.end(); ++it)
   {
-    if (unit->GenerateCodeHandler)
+    const u64 priority = get_priority(*it);
+    if (priority > best_priority)
     {
-      unit->GenerateCodeHandler(unit);
+      best = it;
+      best_priority = priority;
     }
-    unit->cresult = PD3DCompile(unit->code.data(),
-      unit->code.size(),
-      nullptr,
-      (const D3D_SHADER_MACRO*)unit->defines,
-      nullptr,
-      unit->entrypoint,
-      unit->target,
-      unit->flags, 0,
-      &unit->shaderbytecode,
-      &unit->error);
-    m_output.push(std::move(unit));
-    return true;
   }
-  return false;
+  ShaderCompilerWorkUnit* unit = *best;
+  m_input.erase(best);
+  return unit;
+}
+
+// The targets are "vs_5_0", "ps_3_0" and so on.
+static ShaderCompileStats::Stage GetTargetStage(const char* target)
+{
+  switch (target[0])
+  {
+  case 'p':
+    return ShaderCompileStats::Stage::Pixel;
+  case 'g':
+    return ShaderCompileStats::Stage::Geometry;
+  case 'h':
+    return ShaderCompileStats::Stage::Hull;
+  case 'd':
+    return ShaderCompileStats::Stage::Domain;
+  default:
+    return ShaderCompileStats::Stage::Vertex;
+  }
+}
+
+void HLSLAsyncCompiler::CompileNextUnit()
+{
+  if (m_active_jobs.fetch_add(1) >= m_max_active_jobs.load())
+  {
+    m_active_jobs.fetch_sub(1);
+    return;
+  }
+  ShaderCompilerWorkUnit* unit = PopHighestPriorityUnit();
+  if (!unit)
+  {
+    m_active_jobs.fetch_sub(1);
+    return;
+  }
+  if (unit->GenerateCodeHandler)
+  {
+    unit->GenerateCodeHandler(unit);
+  }
+  const u64 start = Common::Timer::GetTimeUs();
+  unit->cresult = PD3DCompile(unit->code.data(),
+    unit->code.size(),
+    nullptr,
+    (const D3D_SHADER_MACRO*)unit->defines,
+    nullptr,
+    unit->entrypoint,
+    unit->target,
+    unit->flags, 0,
+    &unit->shaderbytecode,
+    &unit->error);
+  ShaderCompileStats::AddCompile(GetTargetStage(unit->target), unit->code.data(),
+                                 unit->code.size(), Common::Timer::GetTimeUs() - start);
+  m_output.push(std::move(unit));
+  m_active_jobs.fetch_sub(1);
+  // The tasks turned away by the job limit are gone, one takes the place of this one.
+  bool pending;
+  {
+    std::lock_guard<std::mutex> guard(m_input_lock);
+    pending = !m_input.empty();
+  }
+  if (pending)
+    Common::ThreadPool::Submit([this] { CompileNextUnit(); });
 }
 ShaderCompilerWorkUnit* HLSLAsyncCompiler::NewUnit()
 {
@@ -125,8 +198,13 @@ ShaderCompilerWorkUnit* HLSLAsyncCompiler::NewUnit()
 void HLSLAsyncCompiler::CompileShaderAsync(ShaderCompilerWorkUnit* unit)
 {
   m_in_progres_counter++;
-  m_input.push(std::move(unit));
-  Common::ThreadPool::NotifyWorkPending();
+  unit->priority_class = m_submit_priority;
+  SetMaxActiveJobs(static_cast<u32>(std::max(g_ActiveConfig.iShaderCompilerThreads, 0)));
+  {
+    std::lock_guard<std::mutex> guard(m_input_lock);
+    m_input.push_back(unit);
+  }
+  Common::ThreadPool::Submit([this] { CompileNextUnit(); });
 }
 
 void HLSLAsyncCompiler::ProcCompilationResults()
@@ -143,11 +221,42 @@ void HLSLAsyncCompiler::ProcCompilationResults()
     m_in_progres_counter--;
   }
 }
+void HLSLAsyncCompiler::CancelPendingUnits(CompilePriority max_class)
+{
+  std::vector<ShaderCompilerWorkUnit*> cancelled;
+  {
+    std::lock_guard<std::mutex> guard(m_input_lock);
+    auto end = std::stable_partition(m_input.begin(), m_input.end(), [&](const auto* unit) {
+      return unit->priority_class > max_class || !unit->CancelHandler;
+    });
+    cancelled.assign(end, m_input.end());
+    m_input.erase(end, m_input.end());
+  }
+  for (ShaderCompilerWorkUnit* unit : cancelled)
+  {
+    unit->CancelHandler(unit);
+    unit->Clear();
+    m_repository.push_back(unit);
+    m_in_progres_counter--;
+  }
+}
+
+void HLSLAsyncCompiler::SetMaxActiveJobs(u32 max_jobs)
+{
+  m_max_active_jobs.store(max_jobs ? max_jobs : UINT32_MAX);
+}
+
 bool HLSLAsyncCompiler::CompilationFinished()
 {
   return m_in_progres_counter == 0;
 }
 
+bool HLSLAsyncCompiler::HasQueuedUnits()
+{
+  std::lock_guard<std::mutex> guard(m_input_lock);
+  return !m_input.empty();
+}
+
 void HLSLAsyncCompiler::WaitForFinish()
 {
   u32 loopcount = 0;
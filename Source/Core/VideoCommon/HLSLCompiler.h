@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <mutex>
 #include <vector>
 #include <D3Dcompiler.h>
 #include "VideoCommon/ShaderGenCommon.h"
@@ -12,6 +13,15 @@
 
 class HLSLAsyncCompiler;
 
+// Which compiles go first: the ones a draw waits on, then the shaders the usage profile predicts,
+// then the rest of the precompile from the shader cache.
+enum class CompilePriority : u32
+{
+  Precompile,
+  Predicted,
+  OnDemand,
+};
+
 class ShaderCompilerWorkUnit
 {
   friend class HLSLAsyncCompiler;
@@ -29,33 +39,73 @@ public:
   ShaderCode code;
   std::function<void(ShaderCompilerWorkUnit*)> GenerateCodeHandler;
   std::function<void(ShaderCompilerWorkUnit*)> ResultHandler;
+  // Called instead of ResultHandler when the unit is dropped before it compiled. Units without
+  // one are never cancelled.
+  std::function<void(ShaderCompilerWorkUnit*)> CancelHandler;
+  // How often the draws needed the shader while it was pending, the busiest units of a
+  // priority_class compile first.
+  const std::atomic<u32>* priority;
+  CompilePriority priority_class;
   void Clear();
   void Release();
 };
 
-class HLSLAsyncCompiler final : Common::IWorker
+class HLSLAsyncCompiler final
 {
   static constexpr size_t repository_size = 256;
   friend class HLSLCompiler;
   pD3DCompile PD3DCompile;
   HLSLAsyncCompiler();
   s32 m_in_progres_counter = 0;  
+  CompilePriority m_submit_priority = CompilePriority::OnDemand;
+  // Compiles running on the thread pool, and how many of them may run at once.
+  std::atomic<u32> m_active_jobs{};
+  std::atomic<u32> m_max_active_jobs{UINT32_MAX};
   ShaderCompilerWorkUnit* WorkUnitRepository;
   std::deque<ShaderCompilerWorkUnit*> m_repository;
-  Common::OneToManyQueue<ShaderCompilerWorkUnit*, Common::CircularQueue<ShaderCompilerWorkUnit*>> m_input;
+  std::mutex m_input_lock;
+  std::vector<ShaderCompilerWorkUnit*> m_input;
+  ShaderCompilerWorkUnit* PopHighestPriorityUnit();
+  // A background task of the thread pool, queued once per unit.
+  void CompileNextUnit();
   Common::ManyToOneQueue<ShaderCompilerWorkUnit*, Common::CircularQueue<ShaderCompilerWorkUnit*>> m_output;
   HLSLAsyncCompiler(HLSLAsyncCompiler const&);
   void operator=(HLSLAsyncCompiler const&);
 public:
+  // Ubershaders are what the draws fall back to, they go ahead of every specialized shader.
+  static const std::atomic<u32> HIGHEST_PRIORITY;
   static HLSLAsyncCompiler& getInstance();
   void SetCompilerFunction(pD3DCompile compilerfunc);
   virtual ~HLSLAsyncCompiler();
-  bool NextTask(size_t ID) override;
   ShaderCompilerWorkUnit* NewUnit();
+  // Queues the unit with the priority class of the innermost ScopedPriority.
   void CompileShaderAsync(ShaderCompilerWorkUnit* unit);
+  // Drops the queued units of max_class and below that have a CancelHandler, for when the shaders
+  // they compile are not needed anymore.
+  void CancelPendingUnits(CompilePriority max_class);
+  // 0 lets every thread of the pool compile.
+  void SetMaxActiveJobs(u32 max_jobs);
   void ProcCompilationResults();
   bool CompilationFinished();  
+  // Whether units are queued that no thread has started on yet.
+  bool HasQueuedUnits();
   void WaitForFinish();
+
+  // Units queued while this lives get its priority class.
+  class ScopedPriority
+  {
+  public:
+    ScopedPriority(HLSLAsyncCompiler& compiler, CompilePriority priority_class)
+      : m_compiler(compiler), m_previous(compiler.m_submit_priority)
+    {
+      compiler.m_submit_priority = priority_class;
+    }
+    ~ScopedPriority() { m_compiler.m_submit_priority = m_previous; }
+
+  private:
+    HLSLAsyncCompiler& m_compiler;
+    CompilePriority m_previous;
+  };
 };
 
 class HLSLCompiler
@@ -0,0 +1,145 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/HiresTexturePack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <xxhash.h>
+
+#include "Common/Logging/Log.h"
+
+static const u32 PACK_MAGIC = 0x4B505448;  // 'HTPK'
+static const u32 PACK_VERSION = 1;
+
+struct PackHeader
+{
+  u32 magic;
+  u32 version;
+  u32 entry_count;
+  u32 pad;
+  u64 index_offset;
+};
+
+HiresTexturePack::~HiresTexturePack()
+{
+  Close();
+}
+
+u64 HiresTexturePack::GetHash(const std::string& basename, EntryType type)
+{
+  return XXH64(basename.data(), basename.size(), type);
+}
+
+bool HiresTexturePack::Open(const std::string& filename)
+{
+  Close();
+  if (!m_file.Open(filename))
+  {
+    ERROR_LOG(VIDEO, "Failed to map the custom texture pack %s", filename.c_str());
+    return false;
+  }
+  m_base = m_file.GetData();
+  m_size = static_cast<size_t>(m_file.GetSize());
+  if (m_size < sizeof(PackHeader))
+  {
+    ERROR_LOG(VIDEO, "Invalid custom texture pack %s", filename.c_str());
+    Close();
+    return false;
+  }
+
+  const PackHeader* header = reinterpret_cast<const PackHeader*>(m_base);
+  const u64 index_size = static_cast<u64>(header->entry_count) * sizeof(Entry);
+  if (header->magic != PACK_MAGIC || header->version != PACK_VERSION ||
+      header->index_offset < sizeof(PackHeader) || header->index_offset > m_size ||
+      index_size > m_size - header->index_offset || header->index_offset % alignof(Entry) != 0)
+  {
+    ERROR_LOG(VIDEO, "Invalid custom texture pack %s", filename.c_str());
+    Close();
+    return false;
+  }
+  m_entries = reinterpret_cast<const Entry*>(m_base + header->index_offset);
+  m_entry_count = header->entry_count;
+
+  // Catch truncated or corrupted packs here rather than when the game reaches the texture.
+  const bool valid_entries = std::all_of(m_entries, m_entries + m_entry_count, [&](const Entry& e) {
+    return e.data_offset >= sizeof(PackHeader) && e.data_offset <= header->index_offset &&
+           e.data_size <= header->index_offset - e.data_offset;
+  });
+  const bool sorted = std::is_sorted(m_entries, m_entries + m_entry_count,
+                                     [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+  if (!valid_entries || !sorted)
+  {
+    ERROR_LOG(VIDEO, "Invalid custom texture pack index in %s", filename.c_str());
+    Close();
+    return false;
+  }
+
+  INFO_LOG(VIDEO, "Custom texture pack %s: %zu textures", filename.c_str(), m_entry_count);
+  return true;
+}
+
+void HiresTexturePack::Close()
+{
+  m_file.Close();
+  m_base = nullptr;
+  m_size = 0;
+  m_entries = nullptr;
+  m_entry_count = 0;
+}
+
+const HiresTexturePack::Entry* HiresTexturePack::Find(const std::string& basename,
+                                                      EntryType type) const
+{
+  const u64 hash = GetHash(basename, type);
+  const Entry* end = m_entries + m_entry_count;
+  const Entry* iter = std::lower_bound(m_entries, end, hash,
+                                       [](const Entry& e, u64 value) { return e.hash < value; });
+  for (; iter != end && iter->hash == hash; ++iter)
+  {
+    if (iter->type == type)
+      return iter;
+  }
+  return nullptr;
+}
+
+bool HiresTexturePack::Writer::Open(const std::string& filename)
+{
+  m_entries.clear();
+  // The header is written again with the index offset by Finish().
+  const PackHeader header = {};
+  return m_file.Open(filename, "wb") && m_file.WriteArray(&header, 1);
+}
+
+bool HiresTexturePack::Writer::Add(const std::string& basename, EntryType type, Entry entry,
+                                   const u8* data, size_t data_size)
+{
+  entry.hash = GetHash(basename, type);
+  entry.type = type;
+  entry.data_offset = m_file.Tell();
+  entry.data_size = data_size;
+  if (!m_file.WriteBytes(data, data_size))
+    return false;
+  m_entries.push_back(entry);
+  return true;
+}
+
+bool HiresTexturePack::Writer::Finish()
+{
+  std::sort(m_entries.begin(), m_entries.end(),
+            [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+
+  // Keep the index aligned so that it can be used straight from the mapping.
+  u64 index_offset = m_file.Tell();
+  const u64 padding = (alignof(Entry) - index_offset % alignof(Entry)) % alignof(Entry);
+  const u8 zeros[alignof(Entry)] = {};
+  index_offset += padding;
+
+  const PackHeader header = {PACK_MAGIC, PACK_VERSION, static_cast<u32>(m_entries.size()), 0,
+                             index_offset};
+  const bool success = m_file.WriteBytes(zeros, padding) &&
+                       m_file.WriteArray(m_entries.data(), m_entries.size()) &&
+                       m_file.Seek(0, SEEK_SET) && m_file.WriteArray(&header, 1);
+  return m_file.Close() && success;
+}
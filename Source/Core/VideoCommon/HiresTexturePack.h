@@ -0,0 +1,102 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/MappedFile.h"
+
+// The custom textures of a game packed in a single file, so that they are found without walking
+// a directory of thousands of images and loaded without decoding them.
+//
+// On disk format:
+// header{
+// u32 'HTPK';
+// u32 version;
+// u32 entry_count;
+// u32 pad;
+// u64 index_offset;
+//}
+// u8 data[];
+// Entry index[entry_count]; sorted by hash
+//
+// The data of an entry holds its levels one after the other, each
+// TextureUtil::GetTextureSizeInBytes long, in the order the texture cache uploads them: the color
+// levels, then the normal map and the emissive map ones, or the six faces of an enviroment map.
+// The packs are read through a read only mapping of the file, so only the textures the game uses
+// are read from the disk, and the system is free to drop them from memory again.
+class HiresTexturePack
+{
+public:
+  enum EntryType : u32
+  {
+    TEXTURE = 0,
+    ENVIROMENT = 1,
+  };
+
+  enum EntryFlags : u32
+  {
+    ARBITRARY_MIPS = 1,
+  };
+
+  struct Entry
+  {
+    // XXH64 of the base name, seeded with the type.
+    u64 hash;
+    u32 type;
+    u32 format;
+    u32 width;
+    u32 height;
+    u32 levels;
+    u32 nrm_levels;
+    u32 lum_levels;
+    u32 flags;
+    u64 data_offset;
+    u64 data_size;
+  };
+
+  HiresTexturePack() = default;
+  ~HiresTexturePack();
+  HiresTexturePack(const HiresTexturePack&) = delete;
+  HiresTexturePack& operator=(const HiresTexturePack&) = delete;
+
+  static u64 GetHash(const std::string& basename, EntryType type);
+
+  bool Open(const std::string& filename);
+  void Close();
+  bool IsOpen() const { return m_base != nullptr; }
+
+  const Entry* Find(const std::string& basename, EntryType type) const;
+  // Points into the mapping, valid until the pack is closed.
+  const u8* GetData(const Entry& entry) const { return m_base + entry.data_offset; }
+  size_t GetCount() const { return m_entry_count; }
+
+  // Writes a pack one texture at a time, the index goes at the end once they are all known.
+  class Writer
+  {
+  public:
+    bool Open(const std::string& filename);
+    // entry.hash, data_offset and data_size are filled in from the arguments.
+    bool Add(const std::string& basename, EntryType type, Entry entry, const u8* data,
+             size_t data_size);
+    bool Finish();
+    size_t GetCount() const { return m_entries.size(); }
+
+  private:
+    File::IOFile m_file;
+    std::vector<Entry> m_entries;
+  };
+
+private:
+  Common::MappedFile m_file;
+  const u8* m_base = nullptr;
+  size_t m_size = 0;
+  const Entry* m_entries = nullptr;
+  size_t m_entry_count = 0;
+};
@@ -3,34 +3,41 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <cinttypes>
 #include <cstring>
 #include <memory>
 #include <mutex>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
 
 #include <SOIL/SOIL.h>
 
+#include "Common/CommonFuncs.h"
 #include "Common/CommonPaths.h"
 #include "Common/File.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/Flag.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
 
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Host.h"
 
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/ImageLoader.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -107,6 +114,8 @@ static EnvTextureCache s_enviromentMap;
 typedef std::unordered_map<std::string, std::shared_ptr<HiresTexture>> TextureCache;
 static TextureCache s_textureCache;
 static TextureCache s_enviromentCache;
+// The packed textures of the game, used instead of the maps above when there is a pack.
+static std::unique_ptr<HiresTexturePack> s_pack;
 
 static std::mutex s_textureCacheMutex;
 static Common::Flag s_textureCacheAbortLoading;
@@ -115,8 +124,21 @@ static std::atomic<size_t> size_sum;
 static size_t max_mem = 0;
 static std::thread s_prefetcher;
 
-static const std::string s_format_prefix = "tex1_";
+// Names of the textures of the game in the order it first used them, over all the sessions, so
+// that the prefetcher loads the ones needed early in the game first. Enviroment maps are stored
+// with their prefix.
+static std::mutex s_usageMutex;
+static std::vector<std::string> s_usage;
+static std::unordered_set<std::string> s_usageSet;
+static std::string s_usageGameId;
+static bool s_usageChanged = false;
+
+// By name version.
+static const std::string s_format_prefixes[] = {"", "tex1_", "tex2_"};
+// A bit for each name version of the textures found in the directories.
+static u32 s_name_versions = 0;
 static const std::string s_enviroment_prefix = "env_";
+static const std::string s_pack_extension = ".htp";
 
 HiresTexture::HiresTexture()
     : m_format(PC_TEX_FMT_NONE), m_height(0), m_levels(0), m_nrm_levels(0), m_lum_levels(0),
@@ -141,9 +163,76 @@ void HiresTexture::Shutdown()
     s_textureCacheAbortLoading.Set();
     s_prefetcher.join();
   }
+  SaveUsage();
   s_textureMap.clear();
   s_enviromentMap.clear();
+  s_name_versions = 0;
   s_textureCache.clear();
+  s_pack.reset();
+}
+
+// The version of a texture name, 0 if it isn't one.
+static int GetNameVersion(const std::string& filename)
+{
+  for (int version = 1; version < static_cast<int>(ArraySize(s_format_prefixes)); version++)
+  {
+    if (filename.rfind(s_format_prefixes[version], 0) == 0)
+      return version;
+  }
+  return 0;
+}
+
+static std::string GetUsageFilename(const std::string& game_id)
+{
+  return File::GetUserPath(D_CACHE_IDX) + "HiresTextures" DIR_SEP + game_id + ".txt";
+}
+
+void HiresTexture::LoadUsage(const std::string& game_id)
+{
+  std::lock_guard<std::mutex> lk(s_usageMutex);
+  s_usage.clear();
+  s_usageSet.clear();
+  s_usageGameId = game_id;
+  s_usageChanged = false;
+  std::string contents;
+  if (game_id.empty() || !File::ReadFileToString(GetUsageFilename(game_id), contents))
+    return;
+  std::istringstream stream(contents);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    line = StripSpaces(line);
+    if (!line.empty() && s_usageSet.insert(line).second)
+      s_usage.push_back(line);
+  }
+}
+
+void HiresTexture::SaveUsage()
+{
+  std::lock_guard<std::mutex> lk(s_usageMutex);
+  if (!s_usageChanged || s_usageGameId.empty())
+    return;
+  std::string contents;
+  for (const std::string& name : s_usage)
+  {
+    contents += name;
+    contents += '\n';
+  }
+  const std::string filename = GetUsageFilename(s_usageGameId);
+  File::CreateFullPath(filename);
+  if (!File::WriteStringToFile(contents, filename))
+    ERROR_LOG(VIDEO, "Failed to write the custom texture usage %s", filename.c_str());
+  s_usageChanged = false;
+}
+
+void HiresTexture::RecordUsage(const std::string& name)
+{
+  std::lock_guard<std::mutex> lk(s_usageMutex);
+  if (s_usageSet.insert(name).second)
+  {
+    s_usage.push_back(name);
+    s_usageChanged = true;
+  }
 }
 
 std::set<std::string> HiresTexture::GetTextureDirectory(const std::string& game_id)
@@ -193,6 +282,17 @@ std::set<std::string> HiresTexture::GetTextureDirectory(const std::string& game_
   return result;
 }
 
+std::string HiresTexture::GetPackFilename(const std::string& game_id)
+{
+  const std::string texture_directory = File::GetUserPath(D_HIRESTEXTURES_IDX);
+  if (File::Exists(texture_directory + game_id + s_pack_extension))
+    return texture_directory + game_id + s_pack_extension;
+  // Like the directories, fall back to a region-free pack.
+  if (File::Exists(texture_directory + game_id.substr(0, 3) + s_pack_extension))
+    return texture_directory + game_id.substr(0, 3) + s_pack_extension;
+  return "";
+}
+
 static const std::string ddscode = ".dds";
 static const std::string cddscode = ".DDS";
 static const std::string miptag = "mip";
@@ -319,10 +419,13 @@ void HiresTexture::Update()
     s_prefetcher.join();
   }
 
+  SaveUsage();
+  s_pack.reset();
   if (!g_ActiveConfig.bHiresTextures)
   {
     s_textureMap.clear();
     s_enviromentMap.clear();
+    s_name_versions = 0;
     s_textureCache.clear();
     s_enviromentCache.clear();
     size_sum.store(0);
@@ -338,7 +441,28 @@ void HiresTexture::Update()
 
   s_textureMap.clear();
   s_enviromentMap.clear();
+  s_name_versions = 0;
   const std::string& game_id = SConfig::GetInstance().GetGameID();
+
+  // A packed game is ready without looking at its directories, the textures are streamed from the
+  // pack as the game uses them.
+  const std::string pack_filename = GetPackFilename(game_id);
+  if (!pack_filename.empty() && !BuildMaterialMaps)
+  {
+    std::unique_ptr<HiresTexturePack> pack = std::make_unique<HiresTexturePack>();
+    if (pack->Open(pack_filename))
+    {
+      s_pack = std::move(pack);
+      s_textureCache.clear();
+      s_enviromentCache.clear();
+      size_sum.store(0);
+      OSD::AddMessage(
+          StringFromFormat("Custom texture pack loaded, %zu textures", s_pack->GetCount()), 5000);
+      return;
+    }
+  }
+
+  LoadUsage(game_id);
   const std::set<std::string> texture_directories = GetTextureDirectory(game_id);
   const std::string resource_directory = File::GetSysDirectory() + RESOURCES_DIR DIR_SEP;
   std::vector<std::string> Extensions;
@@ -356,8 +480,9 @@ void HiresTexture::Update()
     std::string filename;
     std::string extension;
     SplitPath(fileitem, nullptr, &filename, &extension);
-    if (filename.rfind(s_format_prefix, 0) == 0)
+    if (const int version = GetNameVersion(filename))
     {
+      s_name_versions |= 1 << version;
       ProccessTexture(fileitem, filename, extension, BuildMaterialMaps);
     }
     else if (filename.rfind(s_enviroment_prefix, 0) == 0)
@@ -377,8 +502,9 @@ void HiresTexture::Update()
       std::string filename;
       std::string extension;
       SplitPath(fileitem, nullptr, &filename, &extension);
-      if (filename.rfind(s_format_prefix, 0) == 0)
+      if (const int version = GetNameVersion(filename))
       {
+        s_name_versions |= 1 << version;
         ProccessTexture(fileitem, filename, extension, BuildMaterialMaps);
       }
       else if (filename.rfind(s_enviroment_prefix, 0) == 0)
@@ -389,6 +515,14 @@ void HiresTexture::Update()
     }
   }
 
+  if (g_ActiveConfig.bPackHiresTextures && !BuildMaterialMaps && s_textureMap.size() > 0)
+  {
+    s_textureCacheAbortLoading.Clear();
+    s_prefetcher = std::thread(
+        BuildPack, File::GetUserPath(D_HIRESTEXTURES_IDX) + game_id + s_pack_extension);
+    return;
+  }
+
   if (g_ActiveConfig.bCacheHiresTextures && s_textureMap.size() > 0)
   {
     // remove cached but deleted textures
@@ -428,154 +562,377 @@ void HiresTexture::Update()
   }
 }
 
-void HiresTexture::Prefetch()
+namespace
 {
-  Common::SetCurrentThreadName("Prefetcher");
-  const size_t total = s_textureMap.size() + s_enviromentMap.size();
-  size_t count = 0;
-  size_t notification = 10;
-  u32 starttime = Common::Timer::GetTimeMs();
-  for (const auto& entry : s_textureMap)
+// Hands out the textures of the prefetch list one at a time to the thread pool. The prefetcher
+// thread loads them too, and is the only one that reports the progress.
+class PrefetchWorker final : public Common::IWorker
+{
+public:
+  PrefetchWorker(size_t count, const std::function<void(size_t)>& func)
+      : m_func(func), m_count(count)
   {
-    const std::string& base_filename = entry.first;
+    Common::ThreadPool::RegisterWorker(this);
+    const size_t threads = std::min(count, Common::ThreadPool::GetThreadCount());
+    for (size_t i = 0; i < threads; i++)
+      Common::ThreadPool::NotifyWorkPending();
+  }
+  ~PrefetchWorker()
+  {
+    Common::ThreadPool::UnregisterWorker(this);
+    Stop();
+    size_t loop_count = 0;
+    while (!IsIdle())
+      Common::cYield(loop_count++);
+  }
 
-    std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  bool NextTask(size_t ID) override
+  {
+    if (!RunNext())
+      return false;
+    // Threads only come back for as many textures as they were notified of.
+    if (m_next.load(std::memory_order_relaxed) < m_count)
+      Common::ThreadPool::NotifyWorkPending();
+    return true;
+  }
 
-    auto iter = s_textureCache.find(base_filename);
-    if (iter == s_textureCache.end())
+  bool RunNext()
+  {
+    m_active.fetch_add(1, std::memory_order_acquire);
+    const size_t index = m_stop.load() ? m_count : m_next.fetch_add(1);
+    const bool run = index < m_count;
+    if (run)
     {
-      lk.unlock();
-      HiresTexture* ptr = Load(
-          base_filename, [](size_t requested_size) { return new u8[requested_size]; }, true);
-      lk.lock();
-      if (ptr != nullptr)
-      {
-        size_sum.fetch_add(ptr->m_cached_data_size);
-        iter = s_textureCache.insert(
-            iter, std::make_pair(base_filename, std::shared_ptr<HiresTexture>(ptr)));
-      }
+      m_func(index);
+      m_done.fetch_add(1, std::memory_order_relaxed);
     }
+    m_active.fetch_sub(1, std::memory_order_release);
+    return run;
+  }
+
+  void Stop() { m_stop.store(true); }
+  // Nothing left to hand out and no texture still loading.
+  bool IsIdle() const
+  {
+    return (m_stop.load() || m_next.load() >= m_count) &&
+           m_active.load(std::memory_order_acquire) == 0;
+  }
+  size_t GetDone() const { return m_done.load(std::memory_order_relaxed); }
+
+private:
+  const std::function<void(size_t)>& m_func;
+  const size_t m_count;
+  std::atomic<size_t> m_next{0};
+  std::atomic<size_t> m_done{0};
+  std::atomic<u32> m_active{0};
+  std::atomic<bool> m_stop{false};
+};
+
+struct PrefetchItem
+{
+  std::string basename;
+  bool enviroment;
+};
+}
 
-    if (s_textureCacheAbortLoading.IsSet())
+void HiresTexture::Prefetch()
+{
+  Common::SetCurrentThreadName("Prefetcher");
+  u32 starttime = Common::Timer::GetTimeMs();
+
+  // What the game used before goes first, in the order it did, then everything else.
+  std::vector<PrefetchItem> items;
+  items.reserve(s_textureMap.size() + s_enviromentMap.size());
+  {
+    std::lock_guard<std::mutex> lk(s_usageMutex);
+    for (const std::string& name : s_usage)
     {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures)
+      if (name.rfind(s_enviroment_prefix, 0) == 0)
       {
-        Host_UpdateProgressDialog("", -1, -1);
+        std::string basename = name.substr(s_enviroment_prefix.length());
+        if (s_enviromentMap.count(basename))
+          items.push_back({std::move(basename), true});
       }
-      return;
+      else if (s_textureMap.count(name))
+      {
+        items.push_back({name, false});
+      }
+    }
+    for (const auto& entry : s_textureMap)
+    {
+      if (!s_usageSet.count(entry.first))
+        items.push_back({entry.first, false});
+    }
+    for (const auto& entry : s_enviromentMap)
+    {
+      if (!s_usageSet.count(s_enviroment_prefix + entry.first))
+        items.push_back({entry.first, true});
     }
+  }
+  const size_t total = items.size();
 
+  std::atomic<bool> out_of_memory{false};
+  const std::function<void(size_t)> load = [&](size_t index) {
+    const PrefetchItem& item = items[index];
+    TextureCache& cache = item.enviroment ? s_enviromentCache : s_textureCache;
+    {
+      std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+      if (cache.count(item.basename))
+        return;
+    }
     if (size_sum.load() > max_mem)
     {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
-      OSD::AddMessage(
-          StringFromFormat(
-              "Custom Textures prefetching after %.1f MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      if (g_ActiveConfig.bWaitForCacheHiresTextures)
-      {
-        Host_UpdateProgressDialog("", -1, -1);
-      }
+      out_of_memory.store(true);
       return;
     }
-    count++;
-    size_t percent = (count * 100) / total;
-    if (percent >= notification)
+    const auto allocate = [](size_t requested_size) { return new u8[requested_size]; };
+    std::shared_ptr<HiresTexture> ptr(item.enviroment ?
+                                          LoadEnviroment(item.basename, allocate, true) :
+                                          Load(item.basename, allocate, true));
+    if (!ptr)
+      return;
+    std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+    // The game may have loaded it meanwhile.
+    if (cache.emplace(item.basename, ptr).second)
+      size_sum.fetch_add(ptr->m_cached_data_size);
+  };
+
+  size_t notification = 10;
+  bool aborted = false;
+  {
+    PrefetchWorker worker(total, load);
+    size_t loop_count = 0;
+    while (!worker.IsIdle())
     {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures)
+      if (worker.RunNext())
+        loop_count = 0;
+      else
+        Common::cYield(loop_count++);
+
+      if (s_textureCacheAbortLoading.IsSet() || out_of_memory.load())
       {
-        Host_UpdateProgressDialog(GetStringT("Prefetching Custom Textures...").c_str(),
-                                  static_cast<int>(count), static_cast<int>(total));
+        worker.Stop();
+        aborted = true;
+        continue;
       }
-      else
+      const size_t count = worker.GetDone();
+      const size_t percent = (count * 100) / total;
+      if (percent >= notification)
       {
-        OSD::AddMessage(StringFromFormat("Custom Textures prefetching %.1f MB %zu %% finished",
-                                         size_sum / (1024.0 * 1024.0), percent),
-                        2000);
+        if (g_ActiveConfig.bWaitForCacheHiresTextures)
+        {
+          Host_UpdateProgressDialog(GetStringT("Prefetching Custom Textures...").c_str(),
+                                    static_cast<int>(count), static_cast<int>(total));
+        }
+        else
+        {
+          OSD::AddMessage(StringFromFormat("Custom Textures prefetching %.1f MB %zu %% finished",
+                                           size_sum / (1024.0 * 1024.0), percent),
+                          2000);
+        }
+        notification += 10;
       }
-      notification += 10;
     }
   }
 
-  for (const auto& entry : s_enviromentMap)
+  if (g_ActiveConfig.bWaitForCacheHiresTextures)
   {
-    const std::string& base_filename = entry.first;
+    Host_UpdateProgressDialog("", -1, -1);
+  }
+  if (out_of_memory.load())
+  {
+    Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
 
-    std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+    OSD::AddMessage(
+        StringFromFormat(
+            "Custom Textures prefetching after %.1f MB aborted, not enough RAM available",
+            size_sum / (1024.0 * 1024.0)),
+        10000);
+    return;
+  }
+  if (aborted)
+  {
+    return;
+  }
+  u32 stoptime = Common::Timer::GetTimeMs();
+  OSD::AddMessage(StringFromFormat("Custom Textures loaded, %.1f MB in %.1f s",
+                                   size_sum / (1024.0 * 1024.0), (stoptime - starttime) / 1000.0),
+                  10000);
+}
 
-    auto iter = s_enviromentCache.find(base_filename);
-    if (iter == s_enviromentCache.end())
-    {
-      lk.unlock();
-      HiresTexture* ptr = LoadEnviroment(
-          base_filename, [](size_t requested_size) { return new u8[requested_size]; }, true);
-      lk.lock();
-      if (ptr != nullptr)
-      {
-        size_sum.fetch_add(ptr->m_cached_data_size);
-        iter = s_enviromentCache.insert(
-            iter, std::make_pair(base_filename, std::shared_ptr<HiresTexture>(ptr)));
-      }
-    }
+// Size of layers of the same number of levels one after the other, like the texture cache uploads
+// them.
+static size_t GetLayersSize(u32 width, u32 height, u32 levels, u32 layers, HostTextureFormat fmt)
+{
+  size_t size = 0;
+  for (u32 level = 0; level < levels; level++)
+  {
+    size += TextureUtil::GetTextureSizeInBytes(TextureUtil::CalculateLevelSize(width, level),
+                                               TextureUtil::CalculateLevelSize(height, level), fmt);
+  }
+  return size * layers;
+}
 
-    if (s_textureCacheAbortLoading.IsSet())
-    {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures)
-      {
-        Host_UpdateProgressDialog("", -1, -1);
-      }
+void HiresTexture::BuildPack(const std::string& filename)
+{
+  Common::SetCurrentThreadName("Texture Packer");
+  // Written aside and renamed once complete, so that a half written pack is never picked up.
+  const std::string temp_filename = filename + ".tmp";
+  // Packs are for the backend that built them, don't compress for one that can't use it.
+  const bool compress = g_ActiveConfig.backend_info.bSupportedFormats[PC_TEX_FMT_DXT5];
+  const size_t total = s_textureMap.size() + s_enviromentMap.size();
+  size_t count = 0;
+  size_t notification = 10;
+  u32 starttime = Common::Timer::GetTimeMs();
+  HiresTexturePack::Writer writer;
+  if (!writer.Open(temp_filename))
+  {
+    ERROR_LOG(VIDEO, "Failed to create the custom texture pack %s", temp_filename.c_str());
+    return;
+  }
+
+  std::vector<u8> compressed;
+  const auto add = [&](const std::string& basename, HiresTexturePack::EntryType type,
+                       const HiresTexture& texture, u32 layers) {
+    const u8* data = texture.m_cached_data.get();
+    size_t data_size =
+        GetLayersSize(texture.m_width, texture.m_height, texture.m_levels, layers, texture.m_format);
+    if (data_size > texture.m_cached_data_size)
       return;
-    }
 
-    if (size_sum.load() > max_mem)
+    HiresTexturePack::Entry entry = {};
+    entry.format = texture.m_format;
+    entry.width = texture.m_width;
+    entry.height = texture.m_height;
+    entry.levels = texture.m_levels;
+    entry.nrm_levels = texture.m_nrm_levels;
+    entry.lum_levels = texture.m_lum_levels;
+    entry.flags = texture.has_arbitrary_mips ? HiresTexturePack::ARBITRARY_MIPS : 0;
+    // The DXT5 blocks of a level 0 that isn't a multiple of 4 wide and high don't line up with it.
+    if (compress && texture.m_format == PC_TEX_FMT_RGBA32 && texture.m_width % 4 == 0 &&
+        texture.m_height % 4 == 0)
     {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
-      OSD::AddMessage(
-          StringFromFormat(
-              "Custom Textures prefetching after %.1f MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      if (g_ActiveConfig.bWaitForCacheHiresTextures)
+      compressed.resize(GetLayersSize(texture.m_width, texture.m_height, texture.m_levels, layers,
+                                      PC_TEX_FMT_DXT5));
+      u8* dst = compressed.data();
+      const u8* src = data;
+      for (u32 layer = 0; layer < layers; layer++)
       {
-        Host_UpdateProgressDialog("", -1, -1);
+        for (u32 level = 0; level < texture.m_levels; level++)
+        {
+          const u32 width = TextureUtil::CalculateLevelSize(texture.m_width, level);
+          const u32 height = TextureUtil::CalculateLevelSize(texture.m_height, level);
+          TextureUtil::CompressRGBA32ToDXT5(dst, reinterpret_cast<const u32*>(src), width, height,
+                                            width);
+          dst += TextureUtil::GetTextureSizeInBytes(width, height, PC_TEX_FMT_DXT5);
+          src += TextureUtil::GetTextureSizeInBytes(width, height, PC_TEX_FMT_RGBA32);
+        }
       }
-      return;
+      entry.format = PC_TEX_FMT_DXT5;
+      data = compressed.data();
+      data_size = compressed.size();
     }
+    writer.Add(basename, type, entry, data, data_size);
+  };
+  const auto progress = [&]() {
     count++;
     size_t percent = (count * 100) / total;
     if (percent >= notification)
     {
-      if (g_ActiveConfig.bWaitForCacheHiresTextures)
-      {
-        Host_UpdateProgressDialog(GetStringT("Prefetching Custom Textures...").c_str(),
-                                  static_cast<int>(count), static_cast<int>(total));
-      }
-      else
-      {
-        OSD::AddMessage(StringFromFormat("Custom Textures prefetching %.1f MB %zu %% finished",
-                                         size_sum / (1024.0 * 1024.0), percent),
-                        2000);
-      }
+      OSD::AddMessage(StringFromFormat("Custom Textures packing %zu %% finished", percent), 2000);
       notification += 10;
     }
+    return !s_textureCacheAbortLoading.IsSet();
+  };
+
+  bool finished = true;
+  for (const auto& entry : s_textureMap)
+  {
+    std::unique_ptr<HiresTexture> texture(Load(
+        entry.first, [](size_t requested_size) { return new u8[requested_size]; }, true));
+    if (texture)
+    {
+      const u32 layers = 1 + (texture->m_nrm_levels ? 1 : 0) + (texture->m_lum_levels ? 1 : 0);
+      add(entry.first, HiresTexturePack::TEXTURE, *texture, layers);
+    }
+    finished = progress();
+    if (!finished)
+      break;
+  }
+  for (const auto& entry : s_enviromentMap)
+  {
+    if (!finished)
+      break;
+    std::unique_ptr<HiresTexture> texture(LoadEnviroment(
+        entry.first, [](size_t requested_size) { return new u8[requested_size]; }, true));
+    if (texture)
+      add(entry.first, HiresTexturePack::ENVIROMENT, *texture, 6);
+    finished = progress();
   }
 
-  if (g_ActiveConfig.bWaitForCacheHiresTextures)
+  const size_t packed = writer.GetCount();
+  if (!writer.Finish() || !finished || !File::Rename(temp_filename, filename))
   {
-    Host_UpdateProgressDialog("", -1, -1);
+    File::Delete(temp_filename);
+    if (finished)
+      ERROR_LOG(VIDEO, "Failed to write the custom texture pack %s", filename.c_str());
+    return;
   }
   u32 stoptime = Common::Timer::GetTimeMs();
-  OSD::AddMessage(StringFromFormat("Custom Textures loaded, %.1f MB in %.1f s",
-                                   size_sum / (1024.0 * 1024.0), (stoptime - starttime) / 1000.0),
+  OSD::AddMessage(StringFromFormat("Custom Textures packed, %zu textures in %.1f s, the pack is "
+                                   "used from the next start",
+                                   packed, (stoptime - starttime) / 1000.0),
                   10000);
 }
 
+HiresTexture* HiresTexture::LoadFromPack(const std::string& basename,
+                                         HiresTexturePack::EntryType type,
+                                         const std::function<u8*(size_t)>& request_buffer_delegate)
+{
+  const HiresTexturePack::Entry* entry = s_pack->Find(basename, type);
+  if (entry == nullptr)
+  {
+    return nullptr;
+  }
+  const HostTextureFormat format = static_cast<HostTextureFormat>(entry->format);
+  if (entry->format >= PC_TEX_NUM_FORMATS ||
+      !g_ActiveConfig.backend_info.bSupportedFormats[format] || entry->levels == 0)
+  {
+    return nullptr;
+  }
+  const u32 layers = type == HiresTexturePack::ENVIROMENT ?
+                         6 :
+                         1 + (entry->nrm_levels ? 1 : 0) + (entry->lum_levels ? 1 : 0);
+  if (GetLayersSize(entry->width, entry->height, entry->levels, layers, format) > entry->data_size)
+  {
+    ERROR_LOG(VIDEO, "Custom texture %s is truncated in the pack", basename.c_str());
+    return nullptr;
+  }
+  // The pages of the texture are only read from the disk here.
+  const size_t data_size = static_cast<size_t>(entry->data_size);
+  u8* dst = request_buffer_delegate(data_size);
+  memcpy(dst, s_pack->GetData(*entry), data_size);
+
+  HiresTexture* ret = new HiresTexture();
+  ret->has_arbitrary_mips = (entry->flags & HiresTexturePack::ARBITRARY_MIPS) != 0;
+  ret->m_format = format;
+  ret->m_width = entry->width;
+  ret->m_height = entry->height;
+  ret->m_levels = entry->levels;
+  ret->m_nrm_levels = entry->nrm_levels;
+  ret->m_lum_levels = entry->lum_levels;
+  return ret;
+}
+
+bool HiresTexture::HasNameVersion(NameVersion version)
+{
+  // The names in a pack are hashed, so it might have either.
+  return s_pack || (s_name_versions >> static_cast<int>(version)) & 1;
+}
+
 std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                       size_t tlut_size, u32 width, u32 height, int format,
-                                      bool has_mipmaps, bool dump)
+                                      bool has_mipmaps, NameVersion version, bool dump)
 {
   std::string name = "";
   HiresTextureCache::iterator convert_iter;
@@ -615,12 +972,14 @@ std::string HiresTexture::GenBaseName(const u8* texture, size_t texture_size, co
     tlut_size = 2 * (max + 1 - min);
     tlut += 2 * min;
   }
-  u64 tex_hash = XXH64(texture, texture_size, 0);
+  const bool xxh3 = version == NameVersion::XXH3;
+  u64 tex_hash = xxh3 ? GetXXH3_64(texture, texture_size) : XXH64(texture, texture_size, 0);
   u64 tlut_hash = 0;
   if (tlut_size)
-    tlut_hash = XXH64(tlut, tlut_size, 0);
-  std::string basename = s_format_prefix + StringFromFormat("%dx%d%s_%016" PRIx64, width, height,
-                                                            has_mipmaps ? "_m" : "", tex_hash);
+    tlut_hash = xxh3 ? GetXXH3_64(tlut, tlut_size) : XXH64(tlut, tlut_size, 0);
+  std::string basename =
+      s_format_prefixes[static_cast<int>(version)] +
+      StringFromFormat("%dx%d%s_%016" PRIx64, width, height, has_mipmaps ? "_m" : "", tex_hash);
   std::string tlutname = tlut_size ? StringFromFormat("_%016" PRIx64, tlut_hash) : "";
   std::string formatname = StringFromFormat("_%d", format);
   std::string fullname = basename + tlutname + formatname;
@@ -642,15 +1001,22 @@ inline u8* LoadImageFromFile(const char* path, int& width, int& height)
 
 inline void ReadImageFile(ImageLoaderParams& ImgInfo)
 {
-  // libpng path seems to fail with some png files using soil meanwhile
-  /*if (ImageLoader::ReadImageFile(ImgInfo))
-  {
-  ImgInfo.resultTex = PC_TEX_FMT_RGBA32;
-  }
-  */
+  // libpng decodes straight into the texture buffer, in the format the backend uploads without a
+  // conversion. SOIL takes the files it can't read.
+  ImgInfo.resultTex = PC_TEX_FMT_NONE;
+  ImgInfo.desiredTex = !g_ActiveConfig.backend_info.bSupportedFormats[PC_TEX_FMT_RGBA32] &&
+                               g_ActiveConfig.backend_info.bSupportedFormats[PC_TEX_FMT_BGRA32] ?
+                           PC_TEX_FMT_BGRA32 :
+                           PC_TEX_FMT_RGBA32;
+  u8* const previous_dst = ImgInfo.dst;
+  if (ImageLoader::ReadPNG(ImgInfo))
+    return;
+  // A file that failed while decoding has its buffer already, it's as broken for SOIL.
+  if (ImgInfo.dst != previous_dst)
+    return;
+
   int image_width;
   int image_height;
-  ImgInfo.resultTex = PC_TEX_FMT_NONE;
   u8* decoded = LoadImageFromFile(ImgInfo.Path, image_width, image_height);
   if (decoded == nullptr)
   {
@@ -743,6 +1109,11 @@ std::shared_ptr<HiresTexture>
 HiresTexture::Search(const std::string& basename,
                      std::function<u8*(size_t)> request_buffer_delegate)
 {
+  if (s_pack)
+  {
+    return std::shared_ptr<HiresTexture>(
+        LoadFromPack(basename, HiresTexturePack::TEXTURE, request_buffer_delegate));
+  }
   if (g_ActiveConfig.bCacheHiresTextures)
   {
     std::unique_lock<std::mutex> lk(s_textureCacheMutex);
@@ -753,6 +1124,7 @@ HiresTexture::Search(const std::string& basename,
       HiresTexture* current = iter->second.get();
       u8* dst = request_buffer_delegate(current->m_cached_data_size);
       memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
+      RecordUsage(basename);
       return iter->second;
     }
     lk.unlock();
@@ -768,15 +1140,54 @@ HiresTexture::Search(const std::string& basename,
         size_sum.fetch_add(current->m_cached_data_size);
         u8* dst = request_buffer_delegate(current->m_cached_data_size);
         memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
+        RecordUsage(basename);
       }
       return ptr;
     }
   }
-  return std::shared_ptr<HiresTexture>(Load(basename, request_buffer_delegate, false));
+  std::shared_ptr<HiresTexture> ptr(Load(basename, request_buffer_delegate, false));
+  if (ptr)
+    RecordUsage(basename);
+  return ptr;
+}
+
+void HiresTexture::StoreCompressed(const std::string& basename, u32 width, u32 height, u32 levels,
+                                   const u8* data, size_t size)
+{
+  if (s_pack || !g_ActiveConfig.bCacheHiresTextures)
+    return;
+  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  auto iter = s_textureCache.find(basename);
+  if (iter == s_textureCache.end())
+    return;
+  const HiresTexture* current = iter->second.get();
+  // Material maps are cached in the same data, they stay uncompressed.
+  if (current->m_format != PC_TEX_FMT_RGBA32 || current->m_nrm_levels || current->m_lum_levels ||
+      current->m_width != width || current->m_height != height || current->m_levels != levels)
+  {
+    return;
+  }
+  std::shared_ptr<HiresTexture> compressed(new HiresTexture());
+  compressed->m_format = PC_TEX_FMT_DXT5;
+  compressed->m_width = width;
+  compressed->m_height = height;
+  compressed->m_levels = levels;
+  compressed->has_arbitrary_mips = current->has_arbitrary_mips;
+  compressed->m_cached_data.reset(new u8[size]);
+  memcpy(compressed->m_cached_data.get(), data, size);
+  compressed->m_cached_data_size = size;
+  size_sum.fetch_sub(current->m_cached_data_size);
+  size_sum.fetch_add(size);
+  iter->second = std::move(compressed);
 }
 
 bool HiresTexture::EnviromentExists(const std::string& basename)
 {
+  if (s_pack)
+  {
+    return g_ActiveConfig.HiresMaterialMapsEnabled() &&
+           s_pack->Find(basename, HiresTexturePack::ENVIROMENT) != nullptr;
+  }
   if (s_enviromentMap.size() == 0 || !g_ActiveConfig.HiresMaterialMapsEnabled())
   {
     return false;
@@ -793,6 +1204,13 @@ std::shared_ptr<HiresTexture>
 HiresTexture::SearchEnviroment(const std::string& basename,
                                std::function<u8*(size_t)> request_buffer_delegate)
 {
+  if (s_pack)
+  {
+    if (!g_ActiveConfig.HiresMaterialMapsEnabled())
+      return nullptr;
+    return std::shared_ptr<HiresTexture>(
+        LoadFromPack(basename, HiresTexturePack::ENVIROMENT, request_buffer_delegate));
+  }
   if (g_ActiveConfig.bCacheHiresTextures)
   {
     std::unique_lock<std::mutex> lk(s_textureCacheMutex);
@@ -803,6 +1221,7 @@ HiresTexture::SearchEnviroment(const std::string& basename,
       HiresTexture* current = iter->second.get();
       u8* dst = request_buffer_delegate(current->m_cached_data_size);
       memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
+      RecordUsage(s_enviroment_prefix + basename);
       return iter->second;
     }
     lk.unlock();
@@ -818,11 +1237,15 @@ HiresTexture::SearchEnviroment(const std::string& basename,
         size_sum.fetch_add(current->m_cached_data_size);
         u8* dst = request_buffer_delegate(current->m_cached_data_size);
         memcpy(dst, current->m_cached_data.get(), current->m_cached_data_size);
+        RecordUsage(s_enviroment_prefix + basename);
       }
       return ptr;
     }
   }
-  return std::shared_ptr<HiresTexture>(LoadEnviroment(basename, request_buffer_delegate, false));
+  std::shared_ptr<HiresTexture> ptr(LoadEnviroment(basename, request_buffer_delegate, false));
+  if (ptr)
+    RecordUsage(s_enviroment_prefix + basename);
+  return ptr;
 }
 
 ImageLoaderParams LoadMipLevel(const hires_mip_level& item,
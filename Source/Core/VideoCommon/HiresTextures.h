@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "VideoCommon/HiresTexturePack.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -28,10 +29,24 @@ public:
   SearchEnviroment(const std::string& basename, std::function<u8*(size_t)> request_buffer_delegate);
 
   static bool EnviromentExists(const std::string& basename);
+  // Replaces the cached RGBA32 levels of a texture with the DXT5 levels compressed from them.
+  static void StoreCompressed(const std::string& basename, u32 width, u32 height, u32 levels,
+                              const u8* data, size_t size);
 
+  // The hash in the texture names. Packs made for older versions keep working, new ones can use
+  // the faster hash.
+  enum class NameVersion
+  {
+    // tex1_ names.
+    XXH64 = 1,
+    // tex2_ names.
+    XXH3 = 2,
+  };
+  // Whether textures named with the version were loaded, so lookups only hash for those.
+  static bool HasNameVersion(NameVersion version);
   static std::string GenBaseName(const u8* texture, size_t texture_size, const u8* tlut,
                                  size_t tlut_size, u32 width, u32 height, int format,
-                                 bool has_mipmaps, bool dump = false);
+                                 bool has_mipmaps, NameVersion version, bool dump = false);
 
   ~HiresTexture(){};
   HostTextureFormat m_format;
@@ -50,8 +65,19 @@ private:
   static HiresTexture* LoadEnviroment(const std::string& base_filename,
                                       std::function<u8*(size_t)> request_buffer_delegate,
                                       bool cacheresult);
+  static HiresTexture* LoadFromPack(const std::string& basename, HiresTexturePack::EntryType type,
+                                    const std::function<u8*(size_t)>& request_buffer_delegate);
 
   static void Prefetch();
+  // Keeps the order the game first uses its textures in, for the next prefetch.
+  static void LoadUsage(const std::string& game_id);
+  static void SaveUsage();
+  static void RecordUsage(const std::string& name);
+  // Packs the textures found in the directories, with the mips and material maps as they are
+  // loaded now.
+  static void BuildPack(const std::string& filename);
   HiresTexture();
   static std::set<std::string> GetTextureDirectory(const std::string& game_id);
+  // The pack of the game, or an empty string if it has none.
+  static std::string GetPackFilename(const std::string& game_id);
 };
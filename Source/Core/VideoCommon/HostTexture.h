@@ -23,6 +23,9 @@ public:
     const MathUtil::Rectangle<int>& srcrect,
     const MathUtil::Rectangle<int>& dstrect) = 0;
   virtual void Load(const u8* src, u32 width, u32 height, u32 expanded_width, u32 level, u32 layer) = 0;
+  // Fills the levels after the first from it, filtering in linear color space. Only used with
+  // backend_info.bSupportsGPUMipmapGeneration, false when the backend couldn't.
+  virtual bool GenerateMipmaps() { return false; }
   virtual uintptr_t GetInternalObject() const = 0;
 
   const TextureConfig& GetConfig() const
@@ -4,6 +4,10 @@
 
 #include <cstddef>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/IndexGenerator.h"
@@ -17,17 +21,113 @@ u32 IndexGenerator::base_index;
 
 static void(*primitive_table[8])(u32);
 
-void IndexGenerator::Init()
+namespace
 {
-  primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = IndexGenerator::AddQuads;
-#if defined(_DEBUG) || defined(DEBUGFAST)
-  primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = IndexGenerator::AddQuads_nonstandard;
+// Lanes of an index pattern that aren't offsets from the block's first vertex.
+const u16 R = IndexGenerator::RESTART_INDEX;
+const u16 C = 0xFFFE;  // The first vertex of the primitive, for fans.
+
+// The indices of a number of primitives, repeated with the vertices advanced by the step.
+// Multiples of 8 indices, so that a block is written with whole vectors.
+const u16 strip_pattern[] = {0, 1, 2, 1, 3, 2, 2, 3, 4, 3, 5, 4,
+                             4, 5, 6, 5, 7, 6, 6, 7, 8, 7, 9, 8};
+const u16 fan_pattern[] = {C, 1, 2, C, 2, 3, C, 3, 4, C, 4, 5, C, 5, 6, C, 6, 7, C, 7, 8, C, 8, 9};
+const u16 quad_pattern[] = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7,
+                            8, 9, 10, 8, 10, 11, 12, 13, 14, 12, 14, 15};
+const u16 line_strip_pattern[] = {0, 1, 1, 2, 2, 3, 3, 4};
+const u16 list_pr_pattern[] = {0, 1, 2, R, 3, 4, 5, R};
+const u16 fan_pr_pattern[] = {1, 2, C, 3, 4, R, 4, 5, C, 6, 7, R,
+                              7, 8, C, 9, 10, R, 10, 11, C, 12, 13, R};
+const u16 quad_pr_pattern[] = {1, 2, 0, 3, R, 5, 6, 4, 7, R, 9, 10, 8, 11, R, 13, 14, 12, 15, R,
+                               17, 18, 16, 19, R, 21, 22, 20, 23, R, 25, 26, 24, 27, R,
+                               29, 30, 28, 31, R};
+
+template <size_t N>
+u16* WriteBlocks(u16* ptr, const u16 (&pattern)[N], u32 first, u32 center, u32 step,
+                 u32 num_blocks)
+{
+  static_assert(N % 8 == 0, "Index patterns must fill whole vectors");
+#if defined(_M_X86_64)
+  __m128i offsets[N / 8];
+  __m128i keep[N / 8];
+  __m128i fixed[N / 8];
+  const __m128i restart = _mm_set1_epi16(static_cast<s16>(R));
+  const __m128i center_index = _mm_set1_epi16(static_cast<s16>(center));
+  for (size_t i = 0; i < N / 8; i++)
+  {
+    offsets[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern + i * 8));
+    const __m128i is_restart = _mm_cmpeq_epi16(offsets[i], restart);
+    const __m128i is_center = _mm_cmpeq_epi16(offsets[i], _mm_set1_epi16(static_cast<s16>(C)));
+    keep[i] = _mm_xor_si128(_mm_or_si128(is_restart, is_center), _mm_set1_epi16(-1));
+    fixed[i] = _mm_or_si128(is_restart, _mm_and_si128(is_center, center_index));
+  }
+
+  __m128i base = _mm_set1_epi16(static_cast<s16>(first));
+  const __m128i base_step = _mm_set1_epi16(static_cast<s16>(step));
+  for (u32 block = 0; block < num_blocks; block++)
+  {
+    for (size_t i = 0; i < N / 8; i++)
+    {
+      const __m128i indices = _mm_add_epi16(offsets[i], base);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr),
+                       _mm_or_si128(_mm_and_si128(indices, keep[i]), fixed[i]));
+      ptr += 8;
+    }
+    base = _mm_add_epi16(base, base_step);
+  }
 #else
-  primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = IndexGenerator::AddQuads;
+  for (u32 block = 0; block < num_blocks; block++)
+  {
+    for (u16 offset : pattern)
+      *ptr++ = offset == R ? R : offset == C ? center : first + offset;
+    first += step;
+  }
+#endif
+  return ptr;
+}
+
+u16* WriteSequence(u16* ptr, u32 first, u32 count)
+{
+#if defined(_M_X86_64)
+  __m128i indices = _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(first)),
+                                  _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+  const __m128i step = _mm_set1_epi16(8);
+  for (; count >= 8; count -= 8)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), indices);
+    indices = _mm_add_epi16(indices, step);
+    ptr += 8;
+    first += 8;
+  }
+#endif
+  for (; count > 0; count--)
+    *ptr++ = first++;
+  return ptr;
+}
+}
+
+void IndexGenerator::Init()
+{
+  if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart)
+  {
+    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = IndexGenerator::AddQuads<true>;
+    primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = IndexGenerator::AddQuads_nonstandard<true>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = IndexGenerator::AddList<true>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = IndexGenerator::AddStrip<true>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = IndexGenerator::AddFan<true>;
+  }
+  else
+  {
+    primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = IndexGenerator::AddQuads<false>;
+    primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = IndexGenerator::AddQuads_nonstandard<false>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = IndexGenerator::AddList<false>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = IndexGenerator::AddStrip<false>;
+    primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = IndexGenerator::AddFan<false>;
+  }
+#if !defined(_DEBUG) && !defined(DEBUGFAST)
+  primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] =
+    primitive_table[OpcodeDecoder::GX_DRAW_QUADS];
 #endif
-  primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLES] = IndexGenerator::AddList;
-  primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP] = IndexGenerator::AddStrip;
-  primitive_table[OpcodeDecoder::GX_DRAW_TRIANGLE_FAN] = IndexGenerator::AddFan;
   primitive_table[OpcodeDecoder::GX_DRAW_LINES] = &IndexGenerator::AddLineList;
   primitive_table[OpcodeDecoder::GX_DRAW_LINE_STRIP] = &IndexGenerator::AddLineStrip;
   primitive_table[OpcodeDecoder::GX_DRAW_POINTS] = &IndexGenerator::AddPoints;
@@ -47,46 +147,64 @@ void IndexGenerator::AddIndices(int primitive, u32 numVerts)
 }
 
 // Triangles
+template <bool pr>
 __forceinline u16* IndexGenerator::WriteTriangle(u16* ptr, u32 index1, u32 index2, u32 index3)
 {
   *ptr++ = index1;
   *ptr++ = index2;
   *ptr++ = index3;
+  if (pr)
+    *ptr++ = RESTART_INDEX;
   return ptr;
 }
 
+template <bool pr>
 void IndexGenerator::AddList(u32 const numVerts)
 {
-  u32 i = base_index + 2;
-  u32 top = (base_index + numVerts);
   u16* ptr = index_buffer_current;
-  while (i < top)
+  const u32 num_triangles = numVerts / 3;
+  if (pr)
   {
-    ptr = WriteTriangle(ptr, i - 2, i - 1, i);
-    i += 3;
+    ptr = WriteBlocks(ptr, list_pr_pattern, base_index, 0, 6, num_triangles / 2);
+    if (num_triangles & 1)
+    {
+      const u32 i = base_index + (num_triangles - 1) * 3;
+      ptr = WriteTriangle<pr>(ptr, i, i + 1, i + 2);
+    }
+  }
+  else
+  {
+    // The indices of a list are just the vertices in order.
+    ptr = WriteSequence(ptr, base_index, num_triangles * 3);
   }
   index_buffer_current = ptr;
 }
 
+template <bool pr>
 void IndexGenerator::AddStrip(u32 const numVerts)
 {
   u16* ptr = index_buffer_current;
-  u32 top = (base_index + numVerts);
-  u32 a = base_index;
-  u32 i = a + 2;
-  u32 wind = 1;
-  while (i < top)
+  if (numVerts < 3)
+    return;
+
+  if (pr)
   {
-    u32 b = i - wind;
-    wind ^= 1;
-    u32 c = i - wind;
-    ptr = WriteTriangle(
-      ptr,
-      a,
-      b,
-      c);
-    ++i;
-    ++a;
+    ptr = WriteSequence(ptr, base_index, numVerts);
+    *ptr++ = RESTART_INDEX;
+  }
+  else
+  {
+    // Every other triangle is wound the other way.
+    const u32 num_triangles = numVerts - 2;
+    ptr = WriteBlocks(ptr, strip_pattern, base_index, 0, 8, num_triangles / 8);
+    for (u32 t = num_triangles & ~7; t < num_triangles; t++)
+    {
+      const u32 a = base_index + t;
+      if (t & 1)
+        ptr = WriteTriangle<pr>(ptr, a, a + 2, a + 1);
+      else
+        ptr = WriteTriangle<pr>(ptr, a, a + 1, a + 2);
+    }
   }
   index_buffer_current = ptr;
 }
@@ -110,16 +228,45 @@ void IndexGenerator::AddStrip(u32 const numVerts)
  * so we use 6 indices for 3 triangles
  */
 
+template <bool pr>
 void IndexGenerator::AddFan(u32 numVerts)
 {
-  u32 i = base_index + 2;
-  u32 top = (base_index + numVerts);
   u16* ptr = index_buffer_current;
+  if (numVerts < 3)
+    return;
 
-  while (i < top)
+  const u32 num_triangles = numVerts - 2;
+  if (pr)
   {
-    ptr = WriteTriangle(ptr, base_index, i - 1, i);
-    ++i;
+    ptr = WriteBlocks(ptr, fan_pr_pattern, base_index, base_index, 12, num_triangles / 12);
+    u32 i = 2 + (num_triangles / 12) * 12;
+    for (; i + 3 <= numVerts; i += 3)
+    {
+      *ptr++ = base_index + i - 1;
+      *ptr++ = base_index + i + 0;
+      *ptr++ = base_index;
+      *ptr++ = base_index + i + 1;
+      *ptr++ = base_index + i + 2;
+      *ptr++ = RESTART_INDEX;
+    }
+    if (i + 2 == numVerts)
+    {
+      *ptr++ = base_index + i - 1;
+      *ptr++ = base_index + i + 0;
+      *ptr++ = base_index;
+      *ptr++ = base_index + i + 1;
+      *ptr++ = RESTART_INDEX;
+    }
+    else if (i + 1 == numVerts)
+    {
+      ptr = WriteTriangle<pr>(ptr, base_index, base_index + i - 1, base_index + i);
+    }
+  }
+  else
+  {
+    ptr = WriteBlocks(ptr, fan_pattern, base_index, base_index, 8, num_triangles / 8);
+    for (u32 i = base_index + 2 + (num_triangles & ~7); i < base_index + numVerts; i++)
+      ptr = WriteTriangle<pr>(ptr, base_index, i - 1, i);
   }
   index_buffer_current = ptr;
 }
@@ -141,54 +288,67 @@ void IndexGenerator::AddFan(u32 numVerts)
  * A simple triangle has to be rendered for three vertices.
  * ZWW do this for sun rays
  */
+template <bool pr>
 void IndexGenerator::AddQuads(u32 numVerts)
 {
-  u32 i = base_index + 3;
-  u32 top = (base_index + numVerts);
   u16* ptr = index_buffer_current;
+  const u32 num_quads = numVerts / 4;
+  u32 quads_per_block = pr ? 8 : 4;
+  if (pr)
+    ptr = WriteBlocks(ptr, quad_pr_pattern, base_index, 0, 32, num_quads / quads_per_block);
+  else
+    ptr = WriteBlocks(ptr, quad_pattern, base_index, 0, 16, num_quads / quads_per_block);
+
+  u32 i = base_index + (num_quads / quads_per_block) * quads_per_block * 4 + 3;
+  u32 top = (base_index + numVerts);
   while (i < top)
   {
-    ptr = WriteTriangle(ptr, i - 3, i - 2, i - 1);
-    ptr = WriteTriangle(ptr, i - 3, i - 1, i - 0);
+    if (pr)
+    {
+      *ptr++ = i - 2;
+      *ptr++ = i - 1;
+      *ptr++ = i - 3;
+      *ptr++ = i - 0;
+      *ptr++ = RESTART_INDEX;
+    }
+    else
+    {
+      ptr = WriteTriangle<pr>(ptr, i - 3, i - 2, i - 1);
+      ptr = WriteTriangle<pr>(ptr, i - 3, i - 1, i - 0);
+    }
     i += 4;
   }
 
   // three vertices remaining, so render a triangle
   if (i == top)
   {
-    ptr = WriteTriangle(ptr, top - 3, top - 2, top - 1);
+    ptr = WriteTriangle<pr>(ptr, top - 3, top - 2, top - 1);
   }
   index_buffer_current = ptr;
 }
 
+template <bool pr>
 void IndexGenerator::AddQuads_nonstandard(u32 numVerts)
 {
   WARN_LOG(VIDEO, "Non-standard primitive drawing command GL_DRAW_QUADS_2");
-  AddQuads(numVerts);
+  AddQuads<pr>(numVerts);
 }
 
 // Lines
 void IndexGenerator::AddLineList(u32 numVerts)
 {
-  u32 i = base_index + 1;
-  u32 top = (base_index + numVerts);
-  u16* ptr = index_buffer_current;
-  while (i < top)
-  {
-    *ptr++ = i - 1;
-    *ptr++ = i;
-    i += 2;
-  }
-  index_buffer_current = ptr;
+  index_buffer_current = WriteSequence(index_buffer_current, base_index, numVerts & ~1);
 }
 
 // shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
 void IndexGenerator::AddLineStrip(u32 numVerts)
 {
-  u32 i = base_index + 1;
-  u32 top = (base_index + numVerts);
   u16* ptr = index_buffer_current;
+  const u32 num_lines = numVerts > 0 ? numVerts - 1 : 0;
+  ptr = WriteBlocks(ptr, line_strip_pattern, base_index, 0, 4, num_lines / 4);
+  u32 i = base_index + 1 + (num_lines & ~3);
+  u32 top = (base_index + numVerts);
   while (i < top)
   {
     *ptr++ = i - 1;
@@ -201,13 +361,5 @@ void IndexGenerator::AddLineStrip(u32 numVerts)
 // Points
 void IndexGenerator::AddPoints(u32 numVerts)
 {
-  u32 i = base_index;
-  u32 top = (base_index + numVerts);
-  u16 *ptr = index_buffer_current;
-  while (i < top)
-  {
-    *ptr++ = i;
-    ++i;
-  }
-  index_buffer_current = ptr;
+  index_buffer_current = WriteSequence(index_buffer_current, base_index, numVerts);
 }
@@ -9,6 +9,8 @@ class IndexGenerator
 {
 public:
   // Init
+  // With primitive restart, triangles are written as strips that are separated by restart
+  // indices, and have to be drawn with a triangle strip topology.
   static void Init();
   static void Start(u16 *Indexptr);
 
@@ -25,6 +27,8 @@ public:
     return (u32)(index_buffer_current - BASEIptr);
   }
 
+  static const u16 RESTART_INDEX = 0xFFFF;
+
   static inline u32 GetRemainingIndices()
   {
     const u32 max_index = 65534; // -1 is reserved for primitive restart (ogl + dx11)
@@ -37,10 +41,15 @@ public:
   }
 private:
   // Triangles
+  template <bool pr>
   static void AddList(u32 numVerts);
+  template <bool pr>
   static void AddStrip(u32 numVerts);
+  template <bool pr>
   static void AddFan(u32 numVerts);
+  template <bool pr>
   static void AddQuads(u32 numVerts);
+  template <bool pr>
   static void AddQuads_nonstandard(u32 numVerts);
 
   // Lines
@@ -50,6 +59,7 @@ private:
   // Points
   static void AddPoints(u32 numVerts);
 
+  template <bool pr>
   static u16* WriteTriangle(u16 *ptr, u32 index1, u32 index2, u32 index3);
 
   static u16 *index_buffer_current;
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cstring>
 
 #include "Common/ChunkFile.h"
@@ -9,6 +10,7 @@
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
 #include "Core/Host.h"
 #include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPStructs.h"
@@ -24,7 +26,9 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
+#include "VideoCommon/TmemMirror.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -42,6 +46,23 @@ static volatile struct
   u32 fbStride;
 } s_beginFieldArgs;
 
+// Fields begun, counted on the CPU thread.
+static u32 s_field_count;
+
+// GPU bounding box values read back in the background, double buffered so one can be returned
+// while the other is filled. Only the CPU thread touches these outside of the prefetch events.
+struct BBoxPrefetch
+{
+  std::array<u16, 4> values;
+  Common::Flag done;
+  u32 field;
+};
+static std::array<BBoxPrefetch, 2> s_bbox_prefetches;
+static int s_bbox_prefetch_pending = -1;
+static int s_bbox_prefetch_ready = -1;
+// The values of the ready prefetch that were returned already.
+static std::array<bool, 4> s_bbox_prefetch_used;
+
 void VideoBackendBase::ShowConfig(void* parent_handle)
 {
   if (!m_initialized)
@@ -60,6 +81,7 @@ void VideoBackendBase::Video_ExitLoop()
 // Run from the CPU thread (from VideoInterface.cpp)
 void VideoBackendBase::Video_BeginField(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, u64 ticks)
 {
+  s_field_count++;
   if (m_initialized && g_ActiveConfig.bUseXFB && g_renderer)
   {
     Fifo::SyncGPU(Fifo::SyncGPUReason::Swap);
@@ -160,22 +182,76 @@ u32 VideoBackendBase::Video_GetQueryResult(PerfQueryType type)
     return 0;
   }
 
-  Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
+  // Approximate counters are those of a measurement that already finished on the GPU.
+  if (!PerfQueryBase::ShouldApproximate())
+  {
+    Fifo::SyncGPU(Fifo::SyncGPUReason::PerfQuery);
 
-  AsyncRequests::Event e;
-  e.time = 0;
-  e.type = AsyncRequests::Event::PERF_QUERY;
+    AsyncRequests::Event e;
+    e.time = 0;
+    e.type = AsyncRequests::Event::PERF_QUERY;
 
-  if (!g_perf_query->IsFlushed())
-    AsyncRequests::GetInstance()->PushEvent(e, true);
+    if (!g_perf_query->IsFlushed())
+      AsyncRequests::GetInstance()->PushEvent(e, true);
+  }
 
   return g_perf_query->GetQueryResult(type);
 }
+// Returns a bounding box value the GPU reported recently, without waiting for it. Each value
+// of a read back is returned once: reading it again means the game depends on it, so that read
+// waits for the exact value.
+static bool PredictBoundingBox(int index, u16* value)
+{
+  if (s_bbox_prefetch_pending >= 0 && s_bbox_prefetches[s_bbox_prefetch_pending].done.IsSet())
+  {
+    s_bbox_prefetch_ready = s_bbox_prefetch_pending;
+    s_bbox_prefetch_pending = -1;
+    s_bbox_prefetch_used.fill(false);
+  }
+
+  // Start the next read back, into the buffer that isn't returned from. One that got dropped
+  // with the request queue is started again.
+  const u32 window = static_cast<u32>(g_ActiveConfig.iBBoxPredictionWindow);
+  if (s_bbox_prefetch_pending < 0 ||
+      s_field_count - s_bbox_prefetches[s_bbox_prefetch_pending].field > window)
+  {
+    if (s_bbox_prefetch_pending < 0)
+      s_bbox_prefetch_pending = s_bbox_prefetch_ready == 0 ? 1 : 0;
+    BBoxPrefetch& prefetch = s_bbox_prefetches[s_bbox_prefetch_pending];
+    prefetch.done.Clear();
+    prefetch.field = s_field_count;
+
+    AsyncRequests::Event e;
+    e.time = 0;
+    e.type = AsyncRequests::Event::BBOX_PREFETCH;
+    e.bbox_prefetch.data = prefetch.values.data();
+    e.bbox_prefetch.done = &prefetch.done;
+    AsyncRequests::GetInstance()->PushEvent(e, false);
+  }
+
+  if (s_bbox_prefetch_ready < 0 || s_bbox_prefetch_used[index])
+    return false;
+  const BBoxPrefetch& ready = s_bbox_prefetches[s_bbox_prefetch_ready];
+  if (s_field_count - ready.field > window)
+    return false;
+
+  s_bbox_prefetch_used[index] = true;
+  *value = ready.values[index];
+  return true;
+}
+
 u16 VideoBackendBase::Video_GetBoundingBox(int index)
 {
   if (g_ActiveConfig.iBBoxMode == BBoxNone)
     return BoundingBox::coords[index];
 
+  u16 predicted;
+  if (g_ActiveConfig.iBBoxPredictionWindow > 0 && g_ActiveConfig.iBBoxMode == BBoxGPU &&
+      PredictBoundingBox(index, &predicted))
+  {
+    return predicted;
+  }
+
   Fifo::SyncGPU(Fifo::SyncGPUReason::BBox);
 
   AsyncRequests::Event e;
@@ -192,11 +268,15 @@ void VideoBackendBase::InitializeShared()
 {
   memset(&g_main_cp_state, 0, sizeof(g_main_cp_state));
   memset(texMem, 0, TMEM_SIZE);
+  TmemMirror::InvalidateAll();
   s_FifoShuttingDown.Clear();
   memset((void*)&s_beginFieldArgs, 0, sizeof(s_beginFieldArgs));
   m_invalid = false;
   memset(m_EFB_PCache, 0, m_EFB_PCache_Size * sizeof(EFBPeekCacheElement));
   s_EFB_PCache_Frame = 1;
+  s_field_count = 0;
+  s_bbox_prefetch_pending = -1;
+  s_bbox_prefetch_ready = -1;
   frameCount = 0;
   // Do our OSD callbacks
   OSD::DoCallbacks(OSD::CallbackType::Initialization);
@@ -223,6 +303,8 @@ void VideoBackendBase::InitializeShared()
     VertexShaderManager::DisableDirtyRegions();
   }
   TessellationShaderManager::Init();
+  ShaderCompileStats::Reset();
+  TextureCacheStats::Reset();
 
   // Notify the core that the video backend is ready
   Host_Message(WM_USER_CREATE);
@@ -235,6 +317,10 @@ void VideoBackendBase::ShutdownShared()
 
   m_initialized = false;
 
+  if (g_ActiveConfig.bDumpShaderCompileStats)
+    ShaderCompileStats::DumpCSV(SConfig::GetInstance().GetGameID(), GetName());
+  if (g_ActiveConfig.bDumpTextureCacheStats)
+    TextureCacheStats::DumpCSV(SConfig::GetInstance().GetGameID(), GetName());
   Fifo::Shutdown();
   GeometryShaderManager::Shutdown();
   TessellationShaderManager::Shutdown();
@@ -280,6 +366,6 @@ void VideoBackendBase::CheckInvalidState()
     m_invalid = false;
 
     BPReload();
-    g_texture_cache->Invalidate();
+    g_texture_cache->InvalidateForStateLoad();
   }
 }
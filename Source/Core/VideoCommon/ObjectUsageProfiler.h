@@ -31,14 +31,16 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 #include <algorithm>
+#include <climits>
 #include <fstream>
 #include <functional>
 #include <map>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
+#include "Common/FlatHashMap.h"
 #include "Common/StringUtil.h"
 
 typedef uint64_t pKey_t;
@@ -46,6 +48,8 @@ typedef uint64_t pKey_t;
 template <typename Tobj, typename TCaterogry, typename TInfo, typename TobjHasher> class ObjectUsageProfiler
 {
 public:
+  typedef Tobj key_type;
+  typedef TInfo info_type;
   ObjectUsageProfiler(pKey_t version) : m_version(version)
   {};
   void SetCategory(const TCaterogry& category)
@@ -145,10 +149,10 @@ public:
 
   const TInfo* GetInfoIfexists(const Tobj& obj) const
   {
-    auto it = m_objects.find(obj);
-    if (it != m_objects.end())
+    auto item = m_objects.find(obj);
+    if (item)
     {
-      return &it->second.info;
+      return &item->second.info;
     }
     return nullptr;
   }
@@ -400,20 +404,51 @@ public:
       filename.c_str());
     bool profile_exists = File::Exists(profile_filename);
     bool global_profile_exists = File::Exists(global_profile_filename);
+    std::string shared_profile_filename = GetSharedProfileFilename(filename);
     ObjectUsageProfiler<Tobj, TCaterogry, TInfo, TobjHasher>* output = new ObjectUsageProfiler<Tobj, TCaterogry, TInfo, TobjHasher>(version);
     if (profile_exists)
     {
       output->ReadFromFile(profile_filename);
     }
-    else if (global_profile_exists)
+    else if (shared_profile_filename.size() > 0)
+    {
+      output->ReadFromFile(shared_profile_filename);
+      output->m_seeded = output->size() > 0;
+    }
+    if (!profile_exists && !output->m_seeded && global_profile_exists)
     {
       output->ReadFromFile(global_profile_filename, true);
+      output->m_seeded = output->size() > 0;
     }
     output->SetCategory(catid);
     output->SetStorage(profile_filename);
     return output;
   }
 
+  // True when the game had no profile of its own and this one was read from a shared per game
+  // profile or the global profile, usually the first time the game runs.
+  bool IsSeeded() const
+  {
+    return m_seeded;
+  }
+
+  // Per game profiles are portable, the ones users drop in User/ShaderProfiles or that ship in
+  // Sys/ShaderProfiles seed the games that don't have one yet.
+  static std::string GetSharedProfileFilename(const std::string& filename)
+  {
+    std::string user_filename = File::GetUserPath(D_USER_IDX) + SHADERPROFILES_DIR DIR_SEP + filename + ".usage";
+    if (File::Exists(user_filename))
+    {
+      return user_filename;
+    }
+    std::string sys_filename = File::GetSysDirectory() + SHADERPROFILES_DIR DIR_SEP + filename + ".usage";
+    if (File::Exists(sys_filename))
+    {
+      return sys_filename;
+    }
+    return {};
+  }
+
 private:
   const pKey_t ValidationMask = 1980092619761005200ull;
   struct ObjectMetadata
@@ -445,7 +480,8 @@ private:
     pKey_t Id;
     pKey_t usage_count;
   };
-  std::unordered_map<Tobj, ObjectMetadata, TobjHasher> m_objects;
+  // Looked up on every shader change, the entries keep their address while it grows.
+  FlatHashMap<Tobj, ObjectMetadata, TobjHasher> m_objects;
   std::map<TCaterogry, CategoryMetadata> m_categories;
   pKey_t m_category_id = {};
   pKey_t m_category_index = {};
@@ -453,6 +489,7 @@ private:
   pKey_t m_category_mask = {};
   pKey_t m_version = {};
   std::string m_storage;
+  bool m_seeded = false;
   template<typename T>
   inline void bwrite(std::ofstream& out, const T& t)
   {
@@ -12,21 +12,27 @@
 // while interpreting them, and hope that the vertex format doesn't change, though, if you do it right
 // when they are called. The reason is that the vertex format affects the sizes of the vertices.
 
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Common/Tracing.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DLCache.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 bool g_bRecordFifoData = false;
@@ -62,7 +68,8 @@ __forceinline u32 InterpretDisplayList(u32 address, u32 size)
 
     // temporarily swap dl and non-dl (small "hack" for the stats)
     Statistics::SwapDL();
-    OpcodeDecoder::Run<false, false>(g_VideoData, &cycles);
+    if (!DLCache::HandleDisplayList(address, size, &cycles))
+      OpcodeDecoder::Run<false, false>(g_VideoData, &cycles);
     INCSTAT(stats.thisFrame.numDListsCalled);
     // un-swap
     Statistics::SwapDL();
@@ -158,9 +165,56 @@ void Init()
   s_bFifoErrorSeen = false;
 }
 
+XFMemRun FindXFMemRun(const u8* start, const u8* end)
+{
+  XFMemRun run;
+  const u8* command = start;
+  while (end - command >= 1 + GX_LOAD_XF_REG_SIZE && command[0] == GX_LOAD_XF_REG)
+  {
+    const u32 cmd2 = Common::swap32(command + 1);
+    const u32 address = cmd2 & 0xFFFF;
+    const u32 size = ((cmd2 >> 16) & 15) + 1;
+    const u8* next = command + 1 + GX_LOAD_XF_REG_SIZE + size * sizeof(u32);
+    if (address + size > 0x1000 || next > end || (run.count && address != run.address + run.size))
+      break;
+    if (!run.count)
+      run.address = address;
+    run.count++;
+    run.size += size;
+    command = next;
+  }
+  run.end = command;
+  return run;
+}
+
+template <bool is_preprocess>
+static VertexLoaderParameters GetVertexLoaderParameters(u8 cmd_byte, u32 count, u8* source,
+                                                        size_t buf_size)
+{
+  CPState& state = is_preprocess ? g_preprocess_cp_state : g_main_cp_state;
+  VertexLoaderParameters parameters;
+  parameters.count = count;
+  parameters.buf_size = buf_size;
+  parameters.primitive = (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT;
+  u32 vtx_attr_group = cmd_byte & GX_VAT_MASK;
+  parameters.vtx_attr_group = vtx_attr_group;
+  parameters.needloaderrefresh = (state.attr_dirty & (1u << vtx_attr_group)) != 0;
+  parameters.skip_draw = g_ActiveConfig.bSkipDrawing
+    || xfmem.viewport.wd == 0.0f
+    || xfmem.viewport.ht == 0.0f
+    || (bpmem.scissorBR.x + 1 - bpmem.scissorTL.x) == 0
+    || (bpmem.scissorBR.y + 1 - bpmem.scissorTL.y) == 0;
+  parameters.VtxDesc = &state.vtx_desc;
+  parameters.VtxAttr = &state.vtx_attr[vtx_attr_group];
+  parameters.source = source;
+  state.attr_dirty &= ~(1 << vtx_attr_group);
+  return parameters;
+}
+
 template <bool is_preprocess, bool sizeCheck>
-u8* Run(DataReader& reader, u32* cycles)
+u8* Run(DataReader& reader, u32* cycles, std::vector<PreparsedCommand>* commands)
 {
+  TRACE_SCOPE("GPU", is_preprocess ? "FIFO preprocess" : "FIFO decode");
   u32 totalCycles = 0;
   u8* opcodeStart;
   while (true)
@@ -171,6 +225,7 @@ u8* Run(DataReader& reader, u32* cycles)
 
     u8 cmd_byte = reader.Read<u8>();
     size_t distance = reader.size();
+    PreparsedCommand command = {cmd_byte};
 
     switch (cmd_byte)
     {
@@ -193,6 +248,8 @@ u8* Run(DataReader& reader, u32* cycles)
       u8 sub_cmd = reader.Read<u8>();
       u32 value = reader.Read<u32>();
       LoadCPReg<is_preprocess>(sub_cmd, value);
+      command.sub_cmd = sub_cmd;
+      command.value = value;
       if (!is_preprocess)
         INCSTAT(stats.thisFrame.numCPLoads);
     }
@@ -202,6 +259,7 @@ u8* Run(DataReader& reader, u32* cycles)
       if (sizeCheck && distance < GX_LOAD_XF_REG_SIZE)
         goto end;
       u32 Cmd2 = reader.Read<u32>();
+      command.value = Cmd2;
       distance -= GX_LOAD_XF_REG_SIZE;
       int transfer_size = ((Cmd2 >> 16) & 15) + 1;
       if (sizeCheck && distance < (transfer_size * sizeof(u32)))
@@ -213,9 +271,24 @@ u8* Run(DataReader& reader, u32* cycles)
       }
       else
       {
-        u32 xf_address = Cmd2 & 0xFFFF;
-        LoadXFReg(transfer_size, xf_address);
-        INCSTAT(stats.thisFrame.numXFLoads);
+        // The FIFO recorder and the display list cache need each command on its own.
+        const XFMemRun run = commands || g_bRecordFifoData ?
+                                 XFMemRun() :
+                                 FindXFMemRun(opcodeStart, reader.GetEnd());
+        if (run.count > 1)
+        {
+          LoadXFMemRun(opcodeStart, run.count, run.address, run.size);
+          totalCycles += GX_LOAD_XF_REG_BASE_CYCLES * (run.count - 1) +
+                         GX_LOAD_XF_REG_TRANSFER_CYCLES * (run.size - transfer_size);
+          reader.ReadSkip(u32(run.end - reader.GetReadPosition()));
+          ADDSTAT(stats.thisFrame.numXFLoads, run.count);
+        }
+        else
+        {
+          u32 xf_address = Cmd2 & 0xFFFF;
+          LoadXFReg(transfer_size, xf_address);
+          INCSTAT(stats.thisFrame.numXFLoads);
+        }
       }
     }
     break;
@@ -228,10 +301,11 @@ u8* Run(DataReader& reader, u32* cycles)
         goto end;
       totalCycles += GX_LOAD_INDX_CYCLES;
       const s32 ref_array = (cmd_byte >> 3) + 8;
+      command.value = reader.Read<u32>();
       if (is_preprocess)
-        PreprocessIndexedXF(reader.Read<u32>(), ref_array);
+        PreprocessIndexedXF(command.value, ref_array);
       else
-        LoadIndexedXF(reader.Read<u32>(), ref_array);
+        LoadIndexedXF(command.value, ref_array);
     }
     break;
     case GX_CMD_CALL_DL:
@@ -240,6 +314,8 @@ u8* Run(DataReader& reader, u32* cycles)
         goto end;
       u32 address = reader.Read<u32>();
       u32 count = reader.Read<u32>();
+      command.value = address;
+      command.extra = count;
       if (is_preprocess)
         InterpretDisplayListPreprocess(address, count);
       else
@@ -264,6 +340,7 @@ u8* Run(DataReader& reader, u32* cycles)
         goto end;
       totalCycles += GX_LOAD_BP_REG_CYCLES;
       u32 bp_cmd = reader.Read<u32>();
+      command.value = bp_cmd;
       if (is_preprocess)
       {
         LoadBPRegPreprocess(bp_cmd);
@@ -284,25 +361,12 @@ u8* Run(DataReader& reader, u32* cycles)
           goto end;
 
         u32 count = reader.Read<u16>();
+        command.count = count;
         distance -= GX_DRAW_PRIMITIVES_SIZE;
         if (count)
         {
-          CPState& state = is_preprocess ? g_preprocess_cp_state : g_main_cp_state;
-          VertexLoaderParameters parameters;
-          parameters.count = count;
-          parameters.buf_size = distance;
-          parameters.primitive = (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT;
-          u32 vtx_attr_group = cmd_byte & GX_VAT_MASK;
-          parameters.vtx_attr_group = vtx_attr_group;
-          parameters.needloaderrefresh = (state.attr_dirty & (1u << vtx_attr_group)) != 0;
-          parameters.skip_draw = xfmem.viewport.wd == 0.0f
-            || xfmem.viewport.ht == 0.0f
-            || (bpmem.scissorBR.x + 1 - bpmem.scissorTL.x) == 0
-            || (bpmem.scissorBR.y + 1 - bpmem.scissorTL.y) == 0;
-          parameters.VtxDesc = &state.vtx_desc;
-          parameters.VtxAttr = &state.vtx_attr[vtx_attr_group];
-          parameters.source = reader.GetReadPosition();
-          state.attr_dirty &= ~(1 << vtx_attr_group);
+          VertexLoaderParameters parameters = GetVertexLoaderParameters<is_preprocess>(
+              cmd_byte, count, reader.GetReadPosition(), distance);
           u32 readsize = 0;
           if (is_preprocess)
           {
@@ -357,6 +421,16 @@ u8* Run(DataReader& reader, u32* cycles)
       opcodeEnd = reader.GetReadPosition();
       FifoRecorder::GetInstance().WriteGPCommand(opcodeStart, u32(opcodeEnd - opcodeStart));
     }
+
+    if (commands)
+    {
+      command.size = u32(reader.GetReadPosition() - opcodeStart);
+      // Runs of NOPs pad every flushed FIFO chunk, don't spend a command on each of them.
+      if (cmd_byte == GX_NOP && !commands->empty() && commands->back().cmd_byte == GX_NOP)
+        commands->back().size += command.size;
+      else
+        commands->push_back(command);
+    }
   }
 end:
   if (cycles)
@@ -366,9 +440,100 @@ end:
   return opcodeStart;
 }
 
-template u8* Run<true, false>(DataReader& reader, u32* cycles);
-template u8* Run<false, false>(DataReader& reader, u32* cycles);
-template u8* Run<true, true>(DataReader& reader, u32* cycles);
-template u8* Run<false, true>(DataReader& reader, u32* cycles);
+u8* RunPreparsed(const PreparsedCommand* commands, size_t count, u8* data,
+                 VertexLoaderManager::CachedVertices* draws)
+{
+  TRACE_SCOPE("GPU", "FIFO decode preparsed");
+  for (size_t i = 0; i < count; ++i)
+  {
+    const PreparsedCommand& command = commands[i];
+    const u8 cmd_byte = command.cmd_byte;
+    switch (cmd_byte)
+    {
+    case GX_NOP:
+    case GX_UNKNOWN_RESET:
+    case GX_CMD_UNKNOWN_METRICS:
+    case GX_CMD_INVL_VC:
+      break;
+    case GX_LOAD_CP_REG:
+      LoadCPReg<false>(command.sub_cmd, command.value);
+      INCSTAT(stats.thisFrame.numCPLoads);
+      break;
+    case GX_LOAD_XF_REG:
+    {
+      XFMemRun run;
+      if (!g_bRecordFifoData)
+      {
+        u8* end = data;
+        for (size_t j = i; j < count && commands[j].cmd_byte == GX_LOAD_XF_REG; ++j)
+          end += commands[j].size;
+        run = FindXFMemRun(data, end);
+      }
+      if (run.count > 1)
+      {
+        LoadXFMemRun(data, run.count, run.address, run.size);
+        ADDSTAT(stats.thisFrame.numXFLoads, run.count);
+        i += run.count - 1;
+        data += run.end - data;
+        continue;
+      }
+      // LoadXFReg reads the register values from g_VideoData.
+      g_VideoData.SetReadPosition(data + 1 + GX_LOAD_XF_REG_SIZE, data + command.size);
+      LoadXFReg(((command.value >> 16) & 15) + 1, command.value & 0xFFFF);
+      INCSTAT(stats.thisFrame.numXFLoads);
+      break;
+    }
+    case GX_LOAD_INDX_A:
+    case GX_LOAD_INDX_B:
+    case GX_LOAD_INDX_C:
+    case GX_LOAD_INDX_D:
+      LoadIndexedXF(command.value, (cmd_byte >> 3) + 8);
+      break;
+    case GX_CMD_CALL_DL:
+      InterpretDisplayList(command.value, command.extra);
+      break;
+    case GX_LOAD_BP_REG:
+      LoadBPReg(command.value);
+      INCSTAT(stats.thisFrame.numBPLoads);
+      break;
+    default:
+      if ((cmd_byte & GX_DRAW_PRIMITIVES) == 0x80 && command.count)
+      {
+        // The recording pass already made sure that all of the vertices are there.
+        u8* source = data + 1 + GX_DRAW_PRIMITIVES_SIZE;
+        VertexLoaderParameters parameters = GetVertexLoaderParameters<false>(
+            cmd_byte, command.count, source, data + command.size - source);
+        u32 readsize = 0;
+        u32 writesize = 0;
+        if (draws)
+        {
+          if (!VertexLoaderManager::ConvertVerticesCached(parameters, writesize, draws[i]))
+            return data;
+          g_vertex_manager->IncCurrentBufferPointer(writesize);
+        }
+        else if (VertexLoaderManager::ConvertVertices(parameters, readsize, writesize))
+        {
+          g_vertex_manager->IncCurrentBufferPointer(writesize);
+        }
+      }
+      break;
+    }
+
+    if (g_bRecordFifoData && cmd_byte != GX_CMD_CALL_DL)
+      FifoRecorder::GetInstance().WriteGPCommand(data, command.size);
+
+    data += command.size;
+  }
+  return data;
+}
+
+template u8* Run<true, false>(DataReader& reader, u32* cycles,
+                              std::vector<PreparsedCommand>* commands);
+template u8* Run<false, false>(DataReader& reader, u32* cycles,
+                               std::vector<PreparsedCommand>* commands);
+template u8* Run<true, true>(DataReader& reader, u32* cycles,
+                             std::vector<PreparsedCommand>* commands);
+template u8* Run<false, true>(DataReader& reader, u32* cycles,
+                              std::vector<PreparsedCommand>* commands);
 
 } // namespace OpcodeDecoder
\ No newline at end of file
@@ -3,10 +3,18 @@
 // Refer to the license.txt file included.
 
 #pragma once
+#include <cstddef>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 
 class DataReader;
 
+namespace VertexLoaderManager
+{
+struct CachedVertices;
+}
+
 namespace OpcodeDecoder
 {
 enum GxOpCodes : u8
@@ -53,6 +61,20 @@ enum GxOpcodesCycles : u32
   GX_DRAW_PRIMITIVES_CYCLES = 12 // 4 GPU ticks per vertex, 3 CPU ticks per GPU tick
 };
 
+// GX_LOAD_XF_REG commands in a row that write XF memory right after each other. Games upload
+// matrices like that, a few rows per command.
+struct XFMemRun
+{
+  u32 count = 0;
+  u32 address = 0;
+  // In words.
+  u32 size = 0;
+  const u8* end = nullptr;
+};
+
+// Only takes commands that lie completely within [start, end) and don't reach the XF registers.
+XFMemRun FindXFMemRun(const u8* start, const u8* end);
+
 enum
 {
   GX_PRIMITIVE_MASK = 0x78,
@@ -75,10 +97,33 @@ enum GxDrawMode : u32
   GX_DRAW_POINTS = 0x7,			// 0xB8
 };
 
+// In deterministic GPU thread mode the CPU thread has to walk every FIFO command anyway to keep
+// the preprocess state up to date. It records what it found, so that the GPU thread can run the
+// commands without decoding the byte stream a second time.
+struct PreparsedCommand
+{
+  u8 cmd_byte;
+  u8 sub_cmd;  // CP register
+  u16 count;   // vertex count
+  u32 value;   // BP/CP/indexed XF value, XF command, display list address
+  u32 extra;   // display list size
+  u32 size;    // FIFO bytes taken by the command, including the opcode
+};
+
 void Init();
 
+// If commands is given, every complete command that was read is appended to it. The main FIFO is
+// recorded in preprocess mode, display lists are recorded by the display list cache.
 template <bool is_preprocess = false, bool sizeCheck = true>
-u8* Run(DataReader& reader, u32* cycles);
+u8* Run(DataReader& reader, u32* cycles, std::vector<PreparsedCommand>* commands = nullptr);
+
+// Runs commands recorded by Run, starting with the first one at data. Returns the address just
+// past the last command that was run.
+// If draws is given, it has an entry for every command, and draws go through
+// VertexLoaderManager::ConvertVerticesCached with it. The run then stops in front of a draw that
+// doesn't match its recorded size anymore.
+u8* RunPreparsed(const PreparsedCommand* commands, size_t count, u8* data,
+                 VertexLoaderManager::CachedVertices* draws = nullptr);
 
 typedef void(*DataReadU32xNfunc)(u32 *buf);
 extern DataReadU32xNfunc DataReadU32xFuncs[16];
@@ -4,8 +4,10 @@
 // Added for Ishiiruka By Tino
 
 #include <png.h>
+#include <vector>
 
-#include "ImageLoader.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/ImageLoader.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -24,6 +26,14 @@ static void PNGWarnFn(png_structp png_ptr, png_const_charp error_message)
 
 bool ImageLoader::ReadPNG(ImageLoaderParams &ImgInfo)
 {
+  // We read using a FILE*; this could be changed. It and the row pointers are created before the
+  // setjmp, so that the error path doesn't skip their destructors.
+  File::IOFile file;
+  std::vector<u8*> row_pointers;
+  if (!file.Open(ImgInfo.Path, "rb"))
+  {
+    return false;
+  }
   // Set up libpng reading.
   png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, PNGErrorFn, PNGWarnFn);
   if (!png_ptr)
@@ -45,12 +55,6 @@ bool ImageLoader::ReadPNG(ImageLoaderParams &ImgInfo)
     png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
     return false;
   }
-  // We read using a FILE*; this could be changed.
-  File::IOFile file;
-  if (!file.Open(ImgInfo.Path, "rb"))
-  {
-    return false;
-  }
   png_init_io(png_ptr, file.GetHandle());
   png_set_sig_bytes(png_ptr, 0);
   // Process PNG header, etc.
@@ -73,12 +77,24 @@ bool ImageLoader::ReadPNG(ImageLoaderParams &ImgInfo)
     png_set_tRNS_to_alpha(png_ptr);
   else if ((color_type & PNG_COLOR_MASK_ALPHA) == 0)
     png_set_add_alpha(png_ptr, 0xFF, PNG_FILLER_AFTER);
+  // Backends without RGBA textures take BGRA, libpng swaps while it decodes.
+  const bool bgra = ImgInfo.desiredTex == PC_TEX_FMT_BGRA32;
+  if (bgra)
+    png_set_bgr(png_ptr);
+  // Interlaced images need it before png_read_update_info, png_read_image fails otherwise.
+  png_set_interlace_handling(png_ptr);
   png_read_update_info(png_ptr, info_ptr);
   ImgInfo.Width = width;
   ImgInfo.Height = height;
   ImgInfo.data_size = width * height * 4;
+  // The rows are decoded straight into the buffer the texture is uploaded from.
   ImgInfo.dst = ImgInfo.request_buffer_delegate(ImgInfo.data_size, false);
-  std::vector<u8*> row_pointers(height);
+  if (!ImgInfo.dst)
+  {
+    png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+    return false;
+  }
+  row_pointers.resize(height);
   u8* row_pointer = ImgInfo.dst;
   for (unsigned i = 0; i < height; ++i)
   {
@@ -88,6 +104,7 @@ bool ImageLoader::ReadPNG(ImageLoaderParams &ImgInfo)
   png_read_image(png_ptr, row_pointers.data());
   png_read_end(png_ptr, end_info);
   png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+  ImgInfo.resultTex = bgra ? PC_TEX_FMT_BGRA32 : PC_TEX_FMT_RGBA32;
   return true;
 }
 
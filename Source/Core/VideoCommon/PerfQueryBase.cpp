@@ -12,3 +12,8 @@ bool PerfQueryBase::ShouldEmulate()
 {
   return g_ActiveConfig.bPerfQueriesEnable;
 }
+
+bool PerfQueryBase::ShouldApproximate()
+{
+  return g_ActiveConfig.bPerfQueriesApproximate && g_perf_query->SupportsApproximateResults();
+}
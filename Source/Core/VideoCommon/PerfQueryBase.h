@@ -40,6 +40,17 @@ public:
   // NOTE: Called from CPU+GPU thread
   static bool ShouldEmulate();
 
+  // Checks if the gameini asks for counters that are read without waiting for the GPU. Those are
+  // the ones of the previous measurement, between the last two ResetQuery calls.
+  // NOTE: Called from CPU+GPU thread
+  static bool ShouldApproximate();
+
+  // Whether the backend keeps the counters of the previous measurement for ShouldApproximate.
+  virtual bool SupportsApproximateResults() const
+  {
+    return false;
+  }
+
   // Begin querying the specified value for the following host GPU commands
   virtual void EnableQuery(PerfQueryGroup type)
   {}
@@ -22,6 +22,7 @@
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/ShaderGenCommon.h"
 
 namespace PixelEngine
 {
@@ -256,6 +257,7 @@ void RegisterMMIO(MMIO::Mapping* mmio, u32 base)
     {
       BoundingBox::active = false;
       PixelShaderManager::SetBoundingBoxActive(false);
+      InvalidateShaderUids(SHADER_UID_PIXEL);
       return g_video_backend->Video_GetBoundingBox(i);
     }),
       MMIO::InvalidWrite<u16>()
@@ -56,7 +56,7 @@ static bool s_use_integer_constants = false;
 void PixelShaderManager::Init(bool use_integer_constants)
 {
   s_use_integer_constants = use_integer_constants;
-  m_buffer.Clear();
+  m_buffer.MarkAllDirty();
   lastAlpha = 0;
   memset(lastTexDims, 0, sizeof(lastTexDims));
   lastZBias = 0;
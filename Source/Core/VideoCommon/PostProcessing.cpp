@@ -2,9 +2,12 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <mutex>
 #include <string>
+#include <tuple>
 
 #include <SOIL/SOIL.h>
 
@@ -12,17 +15,22 @@
 #include "Common/CommonPaths.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IniFile.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/StringUtil.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/VideoInterface.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FramebufferManagerBase.h"
+#include "VideoCommon/FrameProfilerBase.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/ShaderCacheUtils.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
@@ -112,6 +120,7 @@ bool PostProcessingShaderConfiguration::LoadShader(const std::string& sub_dir,
   m_any_options_dirty = false;
   m_compile_time_constants_dirty = false;
   m_requires_depth_buffer = false;
+  m_bake_options = g_ActiveConfig.bPostProcessingBakeOptions;
   m_frame_output.color_output_scale = 1.0;
   m_frame_output.depth_scale = 1.0;
   m_frame_output.depth_count = 0;
@@ -513,6 +522,7 @@ bool PostProcessingShaderConfiguration::ParsePassBlock(const std::string& dirnam
 {
   RenderPass pass;
   pass.output_scale = 1.0f;
+  pass.min_output_scale = 0.0f;
   pass.output_format = g_ActiveConfig.UseHPFrameBuffer() ?
                            HostTextureFormat::PC_TEX_FMT_RGBA16_FLOAT :
                            HostTextureFormat::PC_TEX_FMT_RGBA32;
@@ -559,6 +569,12 @@ bool PostProcessingShaderConfiguration::ParsePassBlock(const std::string& dirnam
       // negative means native scale
       pass.output_scale = -pass.output_scale;
     }
+    else if (key == "MinOutputScale")
+    {
+      TryParse(value, &pass.min_output_scale);
+      if (pass.min_output_scale <= 0.0f)
+        return false;
+    }
     else if (key == "DependantOption" || key == "DependentOption")
     {
       ConfigMap::const_iterator it = m_loaded_options.find(value);
@@ -732,6 +748,12 @@ bool PostProcessingShaderConfiguration::ParsePassBlock(const std::string& dirnam
     }
   }
 
+  // Native scales aren't dynamic, and a minimum above the scale only clamps it.
+  if (pass.min_output_scale <= 0.0f || pass.output_scale < 0.0f)
+    pass.min_output_scale = pass.output_scale;
+  else
+    pass.min_output_scale = std::min(pass.min_output_scale, pass.output_scale);
+
   if (!ValidatePassInputs(pass))
     return false;
 
@@ -796,6 +818,7 @@ void PostProcessingShaderConfiguration::CreateDefaultPass()
   pass.entry_point = "main";
   pass.inputs.push_back(std::move(input));
   pass.output_scale = 1;
+  pass.min_output_scale = 1;
   m_render_passes.push_back(std::move(pass));
 }
 
@@ -965,7 +988,7 @@ void PostProcessingShaderConfiguration::SyncConfiguration()
       bool dirty = it.second.m_dirty;
       m_any_options_dirty = m_any_options_dirty || dirty;
       m_compile_time_constants_dirty =
-          m_compile_time_constants_dirty || (dirty && it.second.m_compile_time_constant);
+          m_compile_time_constants_dirty || (dirty && IsConstantOption(it.second));
     }
   }
 }
@@ -1007,6 +1030,88 @@ void PostProcessingShaderConfiguration::SetOptionb(const std::string& option, bo
   m_pending_config_sync.store(true);
 }
 
+// The full source of a pass includes the values of the compile-time options, so the same source
+// always compiles to the same binary.
+struct PassShaderBinaryKey
+{
+  u64 hash;
+  u64 length;
+
+  bool operator<(const PassShaderBinaryKey& other) const
+  {
+    return std::tie(hash, length) < std::tie(other.hash, other.length);
+  }
+};
+
+// Pass shader binaries of the running backend, shared with the worker threads compiling them.
+// They are looked up in the file as needed instead of being loaded up front.
+class PassShaderBinaryCache final
+{
+public:
+  void Open(const std::string& filename)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_open)
+      return;
+    m_disk_cache.Open(filename);
+    m_open = true;
+  }
+
+  void Close()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_open)
+      return;
+    m_disk_cache.Sync();
+    m_disk_cache.Close();
+    m_open = false;
+  }
+
+  bool Lookup(const PassShaderBinaryKey& key, std::vector<u8>* binary)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_open && m_disk_cache.Get(key, binary);
+  }
+
+  void Insert(const PassShaderBinaryKey& key, const std::vector<u8>& binary)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_open)
+      return;
+    m_disk_cache.Append(key, binary.data(), static_cast<u32>(binary.size()));
+  }
+
+private:
+  std::mutex m_mutex;
+  ShaderCacheUtils::ShaderDiskCache<PassShaderBinaryKey, u8> m_disk_cache;
+  bool m_open = false;
+};
+
+static PassShaderBinaryCache s_pass_binary_cache;
+
+// Returns an empty list if a pass fails to compile.
+static PostProcessingShader::ShaderBinaryList
+CompilePassShaderBinaries(PostProcessingShader::ShaderBinaryCompiler compiler,
+                          const std::vector<std::string>& sources)
+{
+  PostProcessingShader::ShaderBinaryList binaries(sources.size());
+  for (size_t i = 0; i < sources.size(); i++)
+  {
+    const std::string& source = sources[i];
+    const PassShaderBinaryKey key = {
+        GetMurmurHash3(reinterpret_cast<const u8*>(source.data()), static_cast<u32>(source.size()),
+                       0),
+        source.size()};
+    if (s_pass_binary_cache.Lookup(key, &binaries[i]))
+      continue;
+    if (!compiler(source, &binaries[i]))
+      return {};
+    s_pass_binary_cache.Insert(key, binaries[i]);
+  }
+  return binaries;
+}
+
+// m_pending_binaries waits for a background compile, which only uses the sources it was given.
 PostProcessingShader::~PostProcessingShader() {}
 
 HostTexture* PostProcessingShader::GetLastPassOutputTexture() const
@@ -1034,13 +1139,20 @@ bool PostProcessingShader::Initialize(PostProcessingShaderConfiguration* config,
   return m_ready;
 }
 
-bool PostProcessingShader::Reconfigure(const TargetSize& new_size)
+bool PostProcessingShader::Reconfigure(const TargetSize& new_size, float dynamic_scale)
 {
   m_ready = true;
 
-  const bool size_changed = (m_internal_size != new_size);
+  if (!m_config->HasDynamicallyScaledPasses())
+    dynamic_scale = 1.0f;
+
+  // A new dynamic scale resizes the outputs of the dynamically scaled passes.
+  const bool size_changed = (m_internal_size != new_size || m_dynamic_scale != dynamic_scale);
   if (size_changed)
+  {
+    m_dynamic_scale = dynamic_scale;
     m_ready = ResizeOutputTextures(new_size);
+  }
 
   // Re-link on size change due to the input pointer changes
   if (m_ready && (m_config->IsDirty() || size_changed))
@@ -1048,18 +1160,110 @@ bool PostProcessingShader::Reconfigure(const TargetSize& new_size)
 
   // Recompile shaders if compile-time constants have changed
   if (m_ready && m_config->IsCompileTimeConstantsDirty())
-    m_ready = RecompileShaders();
+  {
+    if (GetShaderBinaryCompiler())
+      StartBackgroundRecompile();
+    else
+      m_ready = RecompileShaders();
+  }
+
+  if (m_ready)
+    m_ready = UpdateBackgroundRecompile();
 
   return m_ready;
 }
 
+std::vector<std::string> PostProcessingShader::GetPassShaderSources() const
+{
+  std::vector<std::string> sources;
+  sources.reserve(m_passes.size());
+  for (size_t i = 0; i < m_passes.size(); i++)
+    sources.push_back(GetPassShaderSource(i));
+  return sources;
+}
+
+bool PostProcessingShader::CreatePassShaders(const ShaderBinaryList& binaries)
+{
+  for (size_t i = 0; i < m_passes.size(); i++)
+  {
+    if (!CreatePassShader(m_passes[i], binaries[i]))
+    {
+      ReleasePassNativeResources(m_passes[i]);
+      ERROR_LOG(VIDEO, "Failed to create post-processing shader %s (pass %s)",
+                m_config->GetShaderName().c_str(), m_config->GetPass(i).entry_point.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PostProcessingShader::RecompileShaderBinaries()
+{
+  // A background compile still running was started for older options.
+  if (m_pending_binaries.valid())
+    m_pending_binaries.wait();
+  m_pending_binaries = {};
+  m_recompile_requested = false;
+
+  ShaderBinaryList binaries =
+      CompilePassShaderBinaries(GetShaderBinaryCompiler(), GetPassShaderSources());
+  if (binaries.empty())
+  {
+    ERROR_LOG(VIDEO, "Failed to compile post-processing shader %s",
+              m_config->GetShaderName().c_str());
+    return false;
+  }
+  return CreatePassShaders(binaries);
+}
+
+void PostProcessingShader::StartBackgroundRecompile()
+{
+  // Only one compile runs at a time, the latest options are compiled once it is done.
+  if (m_pending_binaries.valid())
+  {
+    m_recompile_requested = true;
+    return;
+  }
+
+  ShaderBinaryCompiler compiler = GetShaderBinaryCompiler();
+  std::vector<std::string> sources = GetPassShaderSources();
+  m_pending_binaries = std::async(std::launch::async, [compiler, sources] {
+    return CompilePassShaderBinaries(compiler, sources);
+  });
+}
+
+bool PostProcessingShader::UpdateBackgroundRecompile()
+{
+  if (!m_pending_binaries.valid() ||
+      m_pending_binaries.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+  {
+    return true;
+  }
+
+  ShaderBinaryList binaries = m_pending_binaries.get();
+  if (m_recompile_requested)
+  {
+    m_recompile_requested = false;
+    StartBackgroundRecompile();
+    return true;
+  }
+
+  // The previous shaders keep drawing when the new options don't compile.
+  if (binaries.empty())
+  {
+    ERROR_LOG(VIDEO, "Failed to compile post-processing shader %s",
+              m_config->GetShaderName().c_str());
+    return true;
+  }
+  return CreatePassShaders(binaries);
+}
+
 bool PostProcessingShader::CreatePasses()
 {
   m_passes.reserve(m_config->GetPasses().size());
   for (const auto& pass_config : m_config->GetPasses())
   {
     RenderPassData pass;
-    pass.ReleaseOutput();
     pass.output_scale = pass_config.output_scale;
     pass.enabled = true;
     pass.inputs.reserve(pass_config.inputs.size());
@@ -1111,11 +1315,6 @@ void PostProcessingShader::LinkPassOutputs()
 {
   m_last_pass_index = 0;
   m_last_pass_uses_color_buffer = false;
-  // Clear all reference count to regenerate wth the new configuration
-  for (size_t pass_index = 0; pass_index < m_passes.size(); pass_index++)
-  {
-    m_passes[pass_index].ClearReference();
-  }
   // Update dependant options (enable/disable passes)
   for (size_t pass_index = 0; pass_index < m_passes.size(); pass_index++)
   {
@@ -1156,10 +1355,6 @@ void PostProcessingShader::LinkPassOutputs()
         {
           m_last_pass_uses_color_buffer = true;
         }
-        else
-        {
-          m_passes[pass_output_index].AddReference();
-        }
       }
       break;
       case POST_PROCESSING_INPUT_TYPE_COLOR_BUFFER:
@@ -1171,13 +1366,73 @@ void PostProcessingShader::LinkPassOutputs()
       }
     }
   }
-  if (!IsLastPassScaled())
+  AssignOutputSlots();
+}
+
+void PostProcessingShader::AssignOutputSlots()
+{
+  ReleaseOutputSlots();
+
+  // Passes only read the outputs of earlier passes, so the output of a pass is live from the pass
+  // until the last pass reading it, and the output of the last pass until the final copy.
+  std::vector<size_t> last_use(m_passes.size());
+  for (size_t pass_index = 0; pass_index < m_passes.size(); pass_index++)
+  {
+    last_use[pass_index] = pass_index;
+    if (!m_passes[pass_index].enabled)
+      continue;
+    for (const InputBinding& input : m_passes[pass_index].inputs)
+    {
+      if ((input.type == POST_PROCESSING_INPUT_TYPE_PASS_OUTPUT ||
+           input.type == POST_PROCESSING_INPUT_TYPE_PREVIOUS_PASS_OUTPUT) &&
+          input.prev_texture >= 0)
+      {
+        last_use[input.prev_texture] = std::max(last_use[input.prev_texture], pass_index);
+      }
+    }
+  }
+  if (!m_passes.empty())
+    last_use[m_last_pass_index] = m_passes.size();
+
+  for (size_t pass_index = 0; pass_index < m_passes.size(); pass_index++)
   {
-    // If is not scaled we whant to keep this texture for output
-    m_passes[m_last_pass_index].AddOutput();
+    RenderPassData& pass = m_passes[pass_index];
+    if (!pass.enabled)
+    {
+      pass.SetOutputSlot(nullptr);
+      continue;
+    }
+
+    auto iter = std::find_if(m_output_slots.begin(), m_output_slots.end(),
+                             [&pass, pass_index](const std::unique_ptr<OutputSlot>& slot) {
+                               return slot->last_use < pass_index &&
+                                      slot->config == pass.GetConfig();
+                             });
+    OutputSlot* slot;
+    if (iter != m_output_slots.end())
+    {
+      slot = iter->get();
+    }
+    else
+    {
+      m_output_slots.push_back(std::make_unique<OutputSlot>());
+      slot = m_output_slots.back().get();
+      slot->config = pass.GetConfig();
+    }
+    slot->last_use = last_use[pass_index];
+    pass.SetOutputSlot(slot);
   }
 }
 
+void PostProcessingShader::ReleaseOutputSlots()
+{
+  for (RenderPassData& pass : m_passes)
+    pass.SetOutputSlot(nullptr);
+  for (std::unique_ptr<OutputSlot>& slot : m_output_slots)
+    g_texture_cache->DisposeTexture(slot->texture);
+  m_output_slots.clear();
+}
+
 bool PostProcessingShader::ResizeOutputTextures(const TargetSize& new_size)
 {
   const PostProcessingShaderConfiguration::FrameOutput& frameoutput = m_config->GetFrameOutput();
@@ -1213,8 +1468,8 @@ bool PostProcessingShader::ResizeOutputTextures(const TargetSize& new_size)
     RenderPassData& pass = m_passes[pass_index];
     const PostProcessingShaderConfiguration::RenderPass& pass_config =
         m_config->GetPass(pass_index);
-    pass.output_size = PostProcessor::ScaleTargetSize(new_size, pass_config.output_scale);
-    pass.ReleaseOutput();
+    pass.output_scale = pass_config.GetOutputScale(m_dynamic_scale);
+    pass.output_size = PostProcessor::ScaleTargetSize(new_size, pass.output_scale);
     config.width = pass.output_size.width;
     config.height = pass.output_size.height;
     // Last pass output is always RGBA32
@@ -1222,35 +1477,32 @@ bool PostProcessingShader::ResizeOutputTextures(const TargetSize& new_size)
                                                          HostTextureFormat::PC_TEX_FMT_RGBA32;
     pass.SetConfig(config);
   }
+  // The slots are assigned again for the new sizes.
+  ReleaseOutputSlots();
   m_internal_size = new_size;
   return true;
 }
 
 void PostProcessingShader::RenderPassData::AddOutput()
 {
-  if (enabled && !output_texture)
-  {
-    output_texture = g_texture_cache->AllocateTexture(config);
-    ref_count = use_count;
-  }
+  if (enabled && output_slot && !output_slot->texture)
+    output_slot->texture = g_texture_cache->AllocateTexture(output_slot->config);
 }
 
-void PostProcessingShader::RenderPassData::ClenaupOutput()
+// Shader run at the head of the chain when post-processing anti-aliasing is selected.
+static const char POST_AA_SHADER_NAME[] = "FXAA";
+
+// Anti-aliasing runs the chain even when the user shaders are disabled, it then always runs on
+// swap so it sees the final image at the internal resolution.
+static bool IsChainEnabled()
 {
-  ref_count--;
-  if (output_texture && ref_count <= 0)
-  {
-    ReleaseOutput();
-  }
+  return g_ActiveConfig.bPostProcessingEnable || g_ActiveConfig.bPostProcessingAA;
 }
 
-void PostProcessingShader::RenderPassData::ReleaseOutput()
+static int GetChainTrigger()
 {
-  if (output_texture)
-  {
-    g_texture_cache->DisposeTexture(output_texture);
-    output_texture = nullptr;
-  }
+  return g_ActiveConfig.bPostProcessingEnable ? g_ActiveConfig.iPostProcessingTrigger :
+                                                POST_PROCESSING_TRIGGER_ON_SWAP;
 }
 
 PostProcessor::PostProcessor(API_TYPE apitype) : m_APIType(apitype)
@@ -1261,6 +1513,12 @@ PostProcessor::PostProcessor(API_TYPE apitype) : m_APIType(apitype)
 PostProcessor::~PostProcessor()
 {
   m_timer.Stop();
+
+  // Waits for the background compiles before the binary cache is closed.
+  m_post_processing_shaders.clear();
+  m_scaling_shader.reset();
+  m_stereo_shader.reset();
+  s_pass_binary_cache.Close();
 }
 
 void PostProcessor::DisablePostProcessor()
@@ -1277,9 +1535,15 @@ void PostProcessor::ReloadShaders()
   m_stereo_shader.reset();
   m_active = false;
 
+  m_post_aa = g_ActiveConfig.bPostProcessingAA;
   ReloadShaderConfigs();
+  m_bake_options = g_ActiveConfig.bPostProcessingBakeOptions;
+
+  const std::string binary_cache_filename = GetShaderBinaryCacheFileName();
+  if (!binary_cache_filename.empty())
+    s_pass_binary_cache.Open(binary_cache_filename);
 
-  if (g_ActiveConfig.bPostProcessingEnable)
+  if (IsChainEnabled())
     CreatePostProcessingShaders();
 
   CreateScalingShader();
@@ -1296,27 +1560,26 @@ void PostProcessor::ReloadShaders()
 
 bool PostProcessor::ShouldTriggerOnSwap() const
 {
-  return g_ActiveConfig.bPostProcessingEnable &&
-         g_ActiveConfig.iPostProcessingTrigger == POST_PROCESSING_TRIGGER_ON_SWAP && m_active;
+  return IsChainEnabled() && GetChainTrigger() == POST_PROCESSING_TRIGGER_ON_SWAP && m_active;
 }
 
 bool PostProcessor::ShouldTriggerAfterBlit() const
 {
-  return g_ActiveConfig.bPostProcessingEnable &&
-         g_ActiveConfig.iPostProcessingTrigger == POST_PROCESSING_TRIGGER_AFTER_BLIT && m_active;
+  return IsChainEnabled() && GetChainTrigger() == POST_PROCESSING_TRIGGER_AFTER_BLIT && m_active;
 }
 
 bool PostProcessor::XFBDepthDataRequired() const
 {
   return (m_scaling_config && m_scaling_config->RequiresDepthBuffer()) ||
-         (g_ActiveConfig.bPostProcessingEnable && m_active &&
-          (g_ActiveConfig.iPostProcessingTrigger == POST_PROCESSING_TRIGGER_AFTER_BLIT ||
-           (g_ActiveConfig.iPostProcessingTrigger == POST_PROCESSING_TRIGGER_ON_SWAP &&
+         (IsChainEnabled() && m_active &&
+          (GetChainTrigger() == POST_PROCESSING_TRIGGER_AFTER_BLIT ||
+           (GetChainTrigger() == POST_PROCESSING_TRIGGER_ON_SWAP &&
             !g_ActiveConfig.bUseXFB)));
 }
 
 void PostProcessor::DoEFB(const TargetRectangle* src_rect)
 {
+  FramePassScope profile_pass(FramePass::PostProcessing);
   TargetSize target_size(g_renderer->GetTargetWidth(), g_renderer->GetTargetHeight());
   TargetRectangle target_rect;
   if (src_rect)
@@ -1372,9 +1635,9 @@ void PostProcessor::DoEFB(const TargetRectangle* src_rect)
 
 void PostProcessor::OnProjectionLoaded(u32 type)
 {
-  if (!m_active || !g_ActiveConfig.bPostProcessingEnable ||
-      (g_ActiveConfig.iPostProcessingTrigger != POST_PROCESSING_TRIGGER_ON_PROJECTION &&
-       (g_ActiveConfig.iPostProcessingTrigger != POST_PROCESSING_TRIGGER_ON_EFB_COPY)))
+  if (!m_active || !IsChainEnabled() ||
+      (GetChainTrigger() != POST_PROCESSING_TRIGGER_ON_PROJECTION &&
+       (GetChainTrigger() != POST_PROCESSING_TRIGGER_ON_EFB_COPY)))
   {
     return;
   }
@@ -1388,7 +1651,7 @@ void PostProcessor::OnProjectionLoaded(u32 type)
   else if (type == GX_ORTHOGRAPHIC)
   {
     // Fire off postprocessing on the current efb if a perspective scene has been drawn.
-    if (g_ActiveConfig.iPostProcessingTrigger == POST_PROCESSING_TRIGGER_ON_PROJECTION &&
+    if (GetChainTrigger() == POST_PROCESSING_TRIGGER_ON_PROJECTION &&
         m_projection_state == PROJECTION_STATE_PERSPECTIVE)
     {
       m_projection_state = PROJECTION_STATE_FINAL;
@@ -1399,8 +1662,8 @@ void PostProcessor::OnProjectionLoaded(u32 type)
 
 void PostProcessor::OnEFBCopy(const TargetRectangle* src_rect)
 {
-  if (!m_active || !g_ActiveConfig.bPostProcessingEnable ||
-      g_ActiveConfig.iPostProcessingTrigger != POST_PROCESSING_TRIGGER_ON_EFB_COPY)
+  if (!m_active || !IsChainEnabled() ||
+      GetChainTrigger() != POST_PROCESSING_TRIGGER_ON_EFB_COPY)
   {
     return;
   }
@@ -1416,9 +1679,9 @@ void PostProcessor::OnEFBCopy(const TargetRectangle* src_rect)
 
 void PostProcessor::OnEndFrame()
 {
-  if (!m_active || !g_ActiveConfig.bPostProcessingEnable ||
-      (g_ActiveConfig.iPostProcessingTrigger != POST_PROCESSING_TRIGGER_ON_PROJECTION &&
-       (g_ActiveConfig.iPostProcessingTrigger != POST_PROCESSING_TRIGGER_ON_EFB_COPY)))
+  if (!m_active || !IsChainEnabled() ||
+      (GetChainTrigger() != POST_PROCESSING_TRIGGER_ON_PROJECTION &&
+       (GetChainTrigger() != POST_PROCESSING_TRIGGER_ON_EFB_COPY)))
   {
     return;
   }
@@ -1433,6 +1696,12 @@ void PostProcessor::OnEndFrame()
 
 void PostProcessor::UpdateConfiguration()
 {
+  if (m_bake_options != g_ActiveConfig.bPostProcessingBakeOptions ||
+      m_post_aa != g_ActiveConfig.bPostProcessingAA)
+    SetReloadFlag();
+
+  UpdateDynamicScale();
+
   if (m_stereo_config)
   {
     m_stereo_config->SyncConfiguration();
@@ -1447,6 +1716,51 @@ void PostProcessor::UpdateConfiguration()
   }
 }
 
+void PostProcessor::UpdateDynamicScale()
+{
+  // Frames slower than this are stalls (loading, pausing) rather than GPU load.
+  static constexpr float MAX_FRAME_MS = 250.0f;
+  static constexpr u32 ADJUST_INTERVAL_FRAMES = 30;
+  static constexpr float SCALE_STEP = 0.125f;
+
+  const u64 now_us = Common::Timer::GetTimeUs();
+  const float frame_ms = static_cast<float>(now_us - m_last_frame_us) / 1000.0f;
+  const bool has_last_frame = m_last_frame_us != 0;
+  m_last_frame_us = now_us;
+
+  const bool enabled =
+      m_active && g_ActiveConfig.bPostProcessingDynamicScale &&
+      std::any_of(m_shader_configs.begin(), m_shader_configs.end(), [](const auto& it) {
+        return it.second->HasDynamicallyScaledPasses();
+      });
+  if (!enabled)
+  {
+    m_dynamic_scale = 1.0f;
+    m_average_frame_ms = 0.0f;
+    m_dynamic_scale_frames = 0;
+    return;
+  }
+  if (!has_last_frame || frame_ms > MAX_FRAME_MS)
+    return;
+
+  m_average_frame_ms =
+      (m_average_frame_ms > 0.0f) ? m_average_frame_ms * 0.9f + frame_ms * 0.1f : frame_ms;
+  if (++m_dynamic_scale_frames < ADJUST_INTERVAL_FRAMES)
+    return;
+  m_dynamic_scale_frames = 0;
+
+  const u32 refresh_rate = VideoInterface::GetTargetRefreshRate();
+  if (refresh_rate == 0)
+    return;
+
+  // The hysteresis keeps the scale from flipping between two steps, each one resizes textures.
+  const float target_ms = 1000.0f / static_cast<float>(refresh_rate);
+  if (m_average_frame_ms > target_ms * 1.05f)
+    m_dynamic_scale = std::max(m_dynamic_scale - SCALE_STEP, 0.0f);
+  else if (m_average_frame_ms < target_ms * 1.02f)
+    m_dynamic_scale = std::min(m_dynamic_scale + SCALE_STEP, 1.0f);
+}
+
 PostProcessingShaderConfiguration*
 PostProcessor::GetPostShaderConfig(const std::string& shader_name)
 {
@@ -1468,6 +1782,8 @@ void PostProcessor::ReloadPostProcessingShaderConfigs()
 {
   // Load post-processing shader list
   m_shader_names = SplitString(g_ActiveConfig.sPostProcessingShaders, ':');
+  if (m_post_aa && (m_shader_names.empty() || m_shader_names.front() != POST_AA_SHADER_NAME))
+    m_shader_names.insert(m_shader_names.begin(), POST_AA_SHADER_NAME);
 
   // Load shaders
   m_shader_configs.clear();
@@ -1589,8 +1905,14 @@ TargetRectangle PostProcessor::ScaleTargetRectangle(API_TYPE api, const TargetRe
 
 void PostProcessor::CreatePostProcessingShaders()
 {
-  for (const std::string& shader_name : m_shader_names)
+  for (size_t i = 0; i < m_shader_names.size(); i++)
   {
+    // With post-processing disabled only the anti-aliasing pass at the head of the chain runs.
+    const bool is_post_aa = m_post_aa && i == 0;
+    if (!g_ActiveConfig.bPostProcessingEnable && !is_post_aa)
+      continue;
+
+    const std::string& shader_name = m_shader_names[i];
     const auto& it = m_shader_configs.find(shader_name);
     if (it == m_shader_configs.end())
       continue;
@@ -1673,6 +1995,7 @@ bool PostProcessor::ResizeCopyBuffers(const TargetSize& size, int layers)
   }
   m_copy_size.Set(0, 0);
   m_copy_layers = 0;
+  m_depth_copy_source = {};
 
   TextureConfig config;
   config.width = size.width;
@@ -1720,7 +2043,7 @@ bool PostProcessor::ReconfigurePostProcessingShaders(const TargetSize& size)
 {
   for (const auto& shader : m_post_processing_shaders)
   {
-    if (!shader->IsReady() || !shader->Reconfigure(size))
+    if (!shader->IsReady() || !shader->Reconfigure(size, m_dynamic_scale))
       return false;
   }
 
@@ -1764,11 +2087,20 @@ bool PostProcessor::ReconfigureStereoShader(const TargetSize& size)
   return true;
 }
 
+bool PostProcessor::CanBlitDirectly(float gamma) const
+{
+  // The built-in scaling shader only applies the gamma and samples linearly, which is what
+  // CopyTexture does when scaling.
+  return SupportsDirectScreenBlit() && gamma == 1.0f && m_scaling_config &&
+         m_scaling_config->GetShaderName().empty();
+}
+
 void PostProcessor::BlitScreen(const TargetRectangle& dst_rect, const TargetSize& dst_size,
                                uintptr_t dst_texture, const TargetRectangle& src_rect,
                                const TargetSize& src_size, uintptr_t src_texture,
                                uintptr_t src_depth_texture, int src_layer, float gamma)
 {
+  FramePassScope profile_pass(FramePass::Scaling);
   const bool triguer_after_blit = ShouldTriggerAfterBlit();
   DEBUG_ASSERT_MSG(VIDEO, src_layer >= 0,
                    "BlitToFramebuffer should always be called with a single source layer");
@@ -1804,7 +2136,7 @@ void PostProcessor::BlitScreen(const TargetRectangle& dst_rect, const TargetSize
     {
       buffer_rect.bottom = buffer_size.height;
     }
-    if (m_scaling_shader)
+    if (m_scaling_shader && !CanBlitDirectly(gamma))
     {
       m_scaling_shader->Draw(this, buffer_rect, buffer_size,
                              m_color_copy_texture->GetInternalObject(), src_rect, src_size,
@@ -1819,7 +2151,7 @@ void PostProcessor::BlitScreen(const TargetRectangle& dst_rect, const TargetSize
                 m_color_copy_texture->GetInternalObject(), src_rect, src_size, src_depth_texture,
                 dst_texture, &dst_rect, &dst_size);
   }
-  else if (m_scaling_shader)
+  else if (m_scaling_shader && !CanBlitDirectly(gamma))
     m_scaling_shader->Draw(this, dst_rect, dst_size, dst_texture, src_rect, src_size, src_texture,
                            src_depth_texture, src_layer, gamma);
   else
@@ -1836,6 +2168,7 @@ void PostProcessor::PostProcess(TargetRectangle* output_rect, TargetSize* output
 {
   if (!m_active)
     return;
+  FramePassScope profile_pass(FramePass::PostProcessing);
   uintptr_t real_dst_texture = dst_texture == 0 && dst_rect == nullptr ? src_texture : dst_texture;
   // Setup copy buffers first, and update compile-time constants.
   TargetSize buffer_size(src_rect.GetWidth(), src_rect.GetHeight());
@@ -1880,8 +2213,16 @@ void PostProcessor::PostProcess(TargetRectangle* output_rect, TargetSize* output
   }
   if (src_depth_texture != 0 && src_depth_size != buffer_size)
   {
-    CopyTexture(buffer_rect, m_depth_copy_texture->GetInternalObject(), src_depth_rect,
-                src_depth_texture, src_depth_size, -1, true, true);
+    // Post-processing doesn't write depth, so the copy of the previous invocation holds until the
+    // EFB is drawn to again.
+    const DepthCopySource depth_source = {src_depth_texture, src_depth_rect, src_depth_size,
+                                          buffer_size, g_renderer->GetEFBGeneration()};
+    if (m_depth_copy_source != depth_source)
+    {
+      CopyTexture(buffer_rect, m_depth_copy_texture->GetInternalObject(), src_depth_rect,
+                  src_depth_texture, src_depth_size, -1, true, true);
+      m_depth_copy_source = depth_source;
+    }
   }
   else
   {
@@ -2380,6 +2721,37 @@ float SampleRawDepthLocation(float2 location) { return DEPTH_VALUE(SampleInputLo
 float SampleDepth() { return ToLinearDepth(SampleRawDepth()); }
 float SampleDepthLocation(float2 location) { return ToLinearDepth(SampleRawDepthLocation(location)); }
 
+// Joint bilateral upsampling of a previous pass with a lower resolution, the four nearest texels
+// are weighted by how close their depth is to the depth of the output pixel, so the pass doesn't
+// bleed over the edges of objects. Passes reading a dynamically scaled pass along with the depth
+// buffer sample the previous pass through these.
+float4 SamplePrevBilateralTap(float2 texel, float bilinear_weight, float center_depth, inout float total_weight)
+{
+	float2 location = (texel + 0.5) * GetInvPrevResolution();
+	float depth_delta = abs(SampleDepthLocation(location) - center_depth) / max(center_depth, 0.0001);
+	float weight = bilinear_weight / (0.01 + depth_delta);
+	total_weight += weight;
+	return SampleInputLocation(PREV_OUTPUT_INPUT_INDEX, location) * weight;
+}
+float4 SamplePrevBilateralLocation(float2 location)
+{
+	float2 prev_size = GetPrevResolution();
+	if (prev_size.x >= GetTargetResolution().x && prev_size.y >= GetTargetResolution().y)
+		return SampleInputLocation(PREV_OUTPUT_INPUT_INDEX, location);
+
+	float2 texel = location * prev_size - 0.5;
+	float2 base = floor(texel);
+	float2 f = texel - base;
+	float center_depth = SampleDepthLocation(location);
+	float total_weight = 0.0;
+	float4 value = SamplePrevBilateralTap(base, (1.0 - f.x) * (1.0 - f.y), center_depth, total_weight);
+	value += SamplePrevBilateralTap(base + float2(1.0, 0.0), f.x * (1.0 - f.y), center_depth, total_weight);
+	value += SamplePrevBilateralTap(base + float2(0.0, 1.0), (1.0 - f.x) * f.y, center_depth, total_weight);
+	value += SamplePrevBilateralTap(base + float2(1.0, 1.0), f.x * f.y, center_depth, total_weight);
+	return value / total_weight;
+}
+float4 SamplePrevBilateral() { return SamplePrevBilateralLocation(GetCoordinates()); }
+
 // Offset methods are macros, because the offset must be a constant expression.
 #define SampleOffset(offset) (SampleInputOffset(COLOR_BUFFER_INPUT_INDEX, offset))
 #define SampleLayerOffset(offset, layer) (SampleInputLayerOffset(COLOR_BUFFER_INPUT_INDEX, layer, offset))
@@ -2516,7 +2888,8 @@ void PostProcessor::GetUniformBufferShaderSource(API_TYPE api,
                    "\tuint u_scaling_filter;\n"
                    "};\n";
   if (config == nullptr || !includeconfig ||
-      (config != nullptr && config->GetOptions().size() == 0))
+      std::all_of(config->GetOptions().begin(), config->GetOptions().end(),
+                  [config](const auto& it) { return config->IsConstantOption(it.second); }))
   {
     return;
   }
@@ -2539,7 +2912,7 @@ void PostProcessor::GetUniformBufferShaderSource(API_TYPE api,
   const u32 mask = align - 1;
   for (const auto& it : config->GetOptions())
   {
-    if (it.second.m_compile_time_constant)
+    if (config->IsConstantOption(it.second))
     {
       continue;
     }
@@ -2604,6 +2977,46 @@ void PostProcessor::GetUniformBufferShaderSource(API_TYPE api,
   shader_source += StringFromFormat("}%s;\n", api == API_D3D11 ? "" : " conf_options");
 }
 
+// Type of an option in the shader, bools are ints like in the uniform buffer.
+static std::string
+GetOptionTypeSource(const PostProcessingShaderConfiguration::ConfigurationOption& option)
+{
+  size_t count = 1;
+  const char* type = "int";
+  if (option.m_type == POST_PROCESSING_OPTION_TYPE_INTEGER)
+  {
+    count = option.m_integer_values.size();
+  }
+  else if (option.m_type == POST_PROCESSING_OPTION_TYPE_FLOAT)
+  {
+    count = option.m_float_values.size();
+    type = "float";
+  }
+  return count == 1 ? type : StringFromFormat("%s%u", type, static_cast<u32>(count));
+}
+
+// Constructor expression with the current value of an option.
+static std::string
+GetOptionValueSource(const PostProcessingShaderConfiguration::ConfigurationOption& option)
+{
+  std::string values;
+  if (option.m_type == POST_PROCESSING_OPTION_TYPE_BOOL)
+  {
+    values = std::to_string(static_cast<int>(option.m_bool_value));
+  }
+  else if (option.m_type == POST_PROCESSING_OPTION_TYPE_INTEGER)
+  {
+    for (s32 value : option.m_integer_values)
+      values += (values.empty() ? "" : ", ") + std::to_string(value);
+  }
+  else if (option.m_type == POST_PROCESSING_OPTION_TYPE_FLOAT)
+  {
+    for (float value : option.m_float_values)
+      values += (values.empty() ? "" : ", ") + StringFromFormat("%.9g", value);
+  }
+  return GetOptionTypeSource(option) + "(" + values + ")";
+}
+
 std::string PostProcessor::GetCommonFragmentShaderSource(
     API_TYPE api, const PostProcessingShaderConfiguration* config, int texture_register_start)
 {
@@ -2637,23 +3050,40 @@ std::string PostProcessor::GetCommonFragmentShaderSource(
       shader_source +=
           StringFromFormat("#define %s (%d)\n", it.first.c_str(), (int)it.second.m_bool_value);
     }
-    else if (it.second.m_type == POST_PROCESSING_OPTION_TYPE_INTEGER)
+    else
     {
-      int count = static_cast<int>(it.second.m_integer_values.size());
-      std::string type_str = (count == 1) ? "int" : StringFromFormat("int%d", count);
-      shader_source += StringFromFormat("#define %s %s(", it.first.c_str(), type_str.c_str());
-      for (int i = 0; i < count; i++)
-        shader_source += std::to_string(it.second.m_integer_values[i]);
-      shader_source += ")\n";
+      shader_source += StringFromFormat("#define %s %s\n", it.first.c_str(),
+                                        GetOptionValueSource(it.second).c_str());
     }
-    else if (it.second.m_type == POST_PROCESSING_OPTION_TYPE_FLOAT)
+  }
+
+  // Baked options replace the uniform buffer, and are read through the same GetOption() macro.
+  if (config->AreOptionsBaked())
+  {
+    std::string members;
+    std::string values;
+    for (const auto& it : config->GetOptions())
+    {
+      if (it.second.m_compile_time_constant)
+        continue;
+
+      const std::string type = GetOptionTypeSource(it.second);
+      const std::string value = GetOptionValueSource(it.second);
+      if (api == API_D3D11)
+      {
+        shader_source += StringFromFormat("static const %s o_%s = %s;\n", type.c_str(),
+                                          it.first.c_str(), value.c_str());
+      }
+      else
+      {
+        members += StringFromFormat("\t%s %s;\n", type.c_str(), it.first.c_str());
+        values += (values.empty() ? "" : ", ") + value;
+      }
+    }
+    if (!members.empty())
     {
-      int count = static_cast<int>(it.second.m_float_values.size());
-      std::string type_str = (count == 1) ? "float" : StringFromFormat("float%d", count);
-      shader_source += StringFromFormat("#define %s %s(", it.first.c_str(), type_str.c_str());
-      for (int i = 0; i < count; i++)
-        shader_source += StringFromFormat("%f", it.second.m_float_values[i]);
-      shader_source += ")\n";
+      shader_source += "struct BakedOptions {\n" + members + "};\n";
+      shader_source += "const BakedOptions conf_options = BakedOptions(" + values + ");\n";
     }
   }
 
@@ -2668,6 +3098,31 @@ std::string PostProcessor::GetPassFragmentShaderSource(
 {
   std::string shader_source;
 
+  // Upsample the previous pass bilaterally when it can have a lower resolution than this pass.
+  const PostProcessingShaderConfiguration::RenderPassList& passes = config->GetPasses();
+  const size_t pass_index = static_cast<size_t>(pass - passes.data());
+  bool reads_depth = false;
+  bool reads_dynamic_pass = false;
+  for (const PostProcessingShaderConfiguration::RenderPass::Input& input : pass->inputs)
+  {
+    if (input.type == POST_PROCESSING_INPUT_TYPE_DEPTH_BUFFER)
+    {
+      reads_depth = true;
+    }
+    else if (input.type == POST_PROCESSING_INPUT_TYPE_PREVIOUS_PASS_OUTPUT && pass_index > 0 &&
+             pass_index < passes.size())
+    {
+      const PostProcessingShaderConfiguration::RenderPass& prev_pass = passes[pass_index - 1];
+      reads_dynamic_pass = prev_pass.IsDynamicallyScaled() && pass->output_scale > 0.0f &&
+                           prev_pass.min_output_scale < pass->GetOutputScale(0.0f);
+    }
+  }
+  if (reads_depth && reads_dynamic_pass)
+  {
+    shader_source += "#define SamplePrev() SamplePrevBilateral()\n";
+    shader_source += "#define SamplePrevLocation(location) SamplePrevBilateralLocation(location)\n";
+  }
+
   // Include the user's code here
   if (!pass->entry_point.empty())
   {
@@ -2822,7 +3277,7 @@ void* PostProcessingShaderConfiguration::UpdateConfigurationBuffer(u32* buffer_s
   for (const auto& it : m_running_options)
   {
     // Skip compile-time constants, since they're set in the program source.
-    if (it.second.m_compile_time_constant)
+    if (IsConstantOption(it.second))
       continue;
 
     u32 components = 1;
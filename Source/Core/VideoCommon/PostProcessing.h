@@ -6,6 +6,7 @@
 
 #include <array>
 #include <atomic>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -124,6 +125,8 @@ public:
     std::vector<Input> inputs;
     std::string entry_point;
     float output_scale;
+    // Lowest scale the dynamic resolution controller may lower a positive output scale to.
+    float min_output_scale;
     HostTextureFormat output_format;
     std::vector<const ConfigurationOption*> dependent_options;
 
@@ -157,6 +160,19 @@ public:
       }
     }
 
+    bool IsDynamicallyScaled() const
+    {
+      return output_scale > 0.0f && min_output_scale < output_scale;
+    }
+
+    // Output scale at a dynamic scale between 0 (the minimum) and 1 (the declared scale).
+    float GetOutputScale(float dynamic_scale) const
+    {
+      if (!IsDynamicallyScaled())
+        return output_scale;
+      return min_output_scale + (output_scale - min_output_scale) * dynamic_scale;
+    }
+
     bool CheckEnabled() const
     {
       if (dependent_options.size() > 0)
@@ -231,6 +247,17 @@ public:
     return m_requires_depth_buffer;
   }
 
+  // Baked options are all compile-time constants, so the compiler drops the code disabled options
+  // guard, at the cost of a recompile whenever one changes.
+  bool AreOptionsBaked() const
+  {
+    return m_bake_options;
+  }
+  bool IsConstantOption(const ConfigurationOption& option) const
+  {
+    return m_bake_options || option.m_compile_time_constant;
+  }
+
   bool HasOptions() const
   {
     return !m_running_options.empty();
@@ -259,6 +286,15 @@ public:
   {
     return m_render_passes.at(index);
   }
+  bool HasDynamicallyScaledPasses() const
+  {
+    for (const RenderPass& pass : m_render_passes)
+    {
+      if (pass.IsDynamicallyScaled())
+        return true;
+    }
+    return false;
+  }
 
   // For updating option's values
   void SetOptionf(const std::string& option, int index, float value);
@@ -284,6 +320,7 @@ public:
   bool m_any_options_dirty = false;
   bool m_compile_time_constants_dirty = false;
   bool m_requires_depth_buffer = false;
+  bool m_bake_options = false;
   std::string m_shader_name;
   std::string m_shader_source;
   ConfigMap m_running_options;
@@ -316,6 +353,11 @@ class PostProcessor;
 class PostProcessingShader
 {
 public:
+  // Compiles the full source of a pass to the binary the backend creates its shader from, called
+  // from worker threads.
+  using ShaderBinaryCompiler = bool (*)(const std::string& source, std::vector<u8>* binary);
+  using ShaderBinaryList = std::vector<std::vector<u8>>;
+
   PostProcessingShader()
   {};
   virtual ~PostProcessingShader();
@@ -329,7 +371,8 @@ public:
   }
 
   bool Initialize(PostProcessingShaderConfiguration* config, int target_layers);
-  bool Reconfigure(const TargetSize& new_size);
+  // dynamic_scale only applies to the passes declaring a minimum output scale.
+  bool Reconfigure(const TargetSize& new_size, float dynamic_scale = 1.0f);
   virtual void MapAndUpdateConfigurationBuffer() = 0;
   virtual void Draw(PostProcessor* parent,
     const TargetRectangle& dst_rect, const TargetSize& dst_size, uintptr_t dst_texture,
@@ -351,13 +394,21 @@ protected:
   virtual void ReleaseBindingSampler(uintptr_t sampler) = 0;
   virtual uintptr_t CreateBindingSampler(const PostProcessingShaderConfiguration::RenderPass::Input& input_config) = 0;
 
+  // Pass outputs with the same texture config share a texture when the output of one is no
+  // longer read by the time the other pass is drawn.
+  struct OutputSlot final
+  {
+    TextureConfig config{};
+    std::unique_ptr<HostTexture> texture{};
+    // Index of the last pass reading the texture, past the last pass for the final copy.
+    size_t last_use{};
+  };
+
   class RenderPassData final
   {
   private:
-    std::unique_ptr<HostTexture> output_texture{};
+    OutputSlot* output_slot{};
     TextureConfig config{};
-    size_t use_count{};
-    size_t ref_count{};
   public:
     uintptr_t shader{};
     std::vector<InputBinding> inputs;
@@ -369,12 +420,11 @@ protected:
     {
       config = conf;
     }
+    const TextureConfig& GetConfig() const { return config; }
+    void SetOutputSlot(OutputSlot* slot) { output_slot = slot; }
+    // Allocates the texture of the output slot on first use.
     void AddOutput();
-    HostTexture* GetOutput() const { return output_texture.get(); }
-    void ClenaupOutput();
-    void ReleaseOutput();
-    void AddReference() { use_count++; }
-    void ClearReference() { use_count = 0; }
+    HostTexture* GetOutput() const { return output_slot ? output_slot->texture.get() : nullptr; }
   };
 
   virtual void ReleasePassNativeResources(RenderPassData& pass) = 0;
@@ -382,16 +432,47 @@ protected:
 
   bool CreatePasses();
   virtual bool RecompileShaders() = 0;
+
+  // Backends compiling the passes to a binary (SPIR-V, DXBC) return their compiler, implement
+  // GetPassShaderSource and CreatePassShader and call RecompileShaderBinaries from
+  // RecompileShaders. The binaries are cached on disk, and when compile-time options change the
+  // previous shaders keep drawing until the new ones are compiled in the background.
+  virtual ShaderBinaryCompiler GetShaderBinaryCompiler() const
+  {
+    return nullptr;
+  }
+  virtual std::string GetPassShaderSource(size_t pass_index) const
+  {
+    return {};
+  }
+  // Replaces the native shader of the pass.
+  virtual bool CreatePassShader(RenderPassData& pass, const std::vector<u8>& binary)
+  {
+    return false;
+  }
+  bool RecompileShaderBinaries();
+  std::vector<std::string> GetPassShaderSources() const;
+  bool CreatePassShaders(const ShaderBinaryList& binaries);
+  void StartBackgroundRecompile();
+  bool UpdateBackgroundRecompile();
+
   bool ResizeOutputTextures(const TargetSize& new_size);
   void LinkPassOutputs();
+  void AssignOutputSlots();
+  void ReleaseOutputSlots();
 
   PostProcessingShaderConfiguration* m_config;
   uintptr_t m_uniform_buffer;
 
   TargetSize m_internal_size;
   int m_internal_layers = 0;
+  float m_dynamic_scale = 1.0f;
 
   std::vector<RenderPassData> m_passes;
+  std::vector<std::unique_ptr<OutputSlot>> m_output_slots;
+  std::future<ShaderBinaryList> m_pending_binaries;
+  // Set when the options changed again while the background compile was running.
+  bool m_recompile_requested = false;
   size_t m_last_pass_index = 0;
   bool m_last_pass_uses_color_buffer = false;
   bool m_ready = false;
@@ -535,6 +616,17 @@ public:
 
 protected:
   virtual std::unique_ptr<PostProcessingShader> CreateShader(PostProcessingShaderConfiguration* config) = 0;
+  // File of the pass shader binary cache, empty for backends without shader binaries.
+  virtual std::string GetShaderBinaryCacheFileName() const
+  {
+    return {};
+  }
+  // Whether CopyTexture can write the screen with a hardware copy or blit, so the scaling shader
+  // can be skipped when it would only copy the image.
+  virtual bool SupportsDirectScreenBlit() const
+  {
+    return false;
+  }
   // NOTE: Can change current render target and viewport.
   // If src_layer <0, copy all layers, otherwise, copy src_layer to layer 0.
   virtual void CopyTexture(const TargetRectangle& dst_rect, uintptr_t dst_texture,
@@ -553,6 +645,10 @@ protected:
   bool ReconfigureStereoShader(const TargetSize& size);
   bool ResizeCopyBuffers(const TargetSize& size, int layers);
   bool ResizeStereoBuffer(const TargetSize& size);
+  // True when the scaling shader is the built-in copy and can be replaced by CopyTexture.
+  bool CanBlitDirectly(float gamma) const;
+  // Moves the dynamic scale towards the one keeping the frame time on target.
+  void UpdateDynamicScale();
 
   enum PROJECTION_STATE : u32
   {
@@ -605,6 +701,23 @@ protected:
   std::unique_ptr<HostTexture> m_color_copy_texture = nullptr;
   std::unique_ptr<HostTexture> m_depth_copy_texture = nullptr;
 
+  // The depth buffer and EFB state the depth copy was made from.
+  struct DepthCopySource final
+  {
+    uintptr_t texture = 0;
+    TargetRectangle rect{};
+    TargetSize size{};
+    TargetSize buffer_size{};
+    u64 efb_generation = 0;
+
+    bool operator!=(const DepthCopySource& other) const
+    {
+      return texture != other.texture || !(rect == other.rect) || size != other.size ||
+             buffer_size != other.buffer_size || efb_generation != other.efb_generation;
+    }
+  };
+  DepthCopySource m_depth_copy_source;
+
   TargetSize m_stereo_buffer_size;
   std::unique_ptr<HostTexture> m_stereo_buffer_texture = nullptr;
 
@@ -614,6 +727,15 @@ protected:
   // Global post-processing enable state
   bool m_active = false;
   bool m_requires_depth_buffer = false;
+  // Whether the loaded configs bake their options.
+  bool m_bake_options = false;
+  // Whether the anti-aliasing shader was inserted at the head of the chain.
+  bool m_post_aa = false;
+  // Dynamic resolution state, the scale goes from 0 (minimum pass scales) to 1 (declared scales).
+  float m_dynamic_scale = 1.0f;
+  float m_average_frame_ms = 0.0f;
+  u64 m_last_frame_us = 0;
+  u32 m_dynamic_scale_frames = 0;
   const API_TYPE m_APIType;
   // Uniform buffer data, double-buffered so we don't update if unnecessary
   std::array<Constant, POST_PROCESSING_CONTANTS> m_current_constants;
@@ -0,0 +1,47 @@
+// Copyright 2013 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
+
+#include "VideoCommon/PrecompiledVertexLoaders.h"
+
+#include "VideoCommon/G_G4BP08_pvt.h"
+#include "VideoCommon/G_GB4P51_pvt.h"
+#include "VideoCommon/G_GFZE01_pvt.h"
+#include "VideoCommon/G_GLMP01_pvt.h"
+#include "VideoCommon/G_GM8E01_pvt.h"
+#include "VideoCommon/G_GNUEDA_pvt.h"
+#include "VideoCommon/G_GSAE01_pvt.h"
+#include "VideoCommon/G_GZ2P01_pvt.h"
+#include "VideoCommon/G_R5WEA4_pvt.h"
+#include "VideoCommon/G_RBUP08_pvt.h"
+#include "VideoCommon/G_RMCP01_pvt.h"
+#include "VideoCommon/G_RMGP01_pvt.h"
+#include "VideoCommon/G_RSBP01_pvt.h"
+#include "VideoCommon/G_SDWP18_pvt.h"
+#include "VideoCommon/G_SMNP01_pvt.h"
+#include "VideoCommon/G_SPDE52_pvt.h"
+#include "VideoCommon/G_SPXP41_pvt.h"
+#include "VideoCommon/G_SX4E01_pvt.h"
+
+void InitializePrecompiledVertexLoaders(std::map<u64, TCompiledLoaderFunction>& pvlmap)
+{
+  G_G4BP08_pvt::Initialize(pvlmap);
+  G_GB4P51_pvt::Initialize(pvlmap);
+  G_GFZE01_pvt::Initialize(pvlmap);
+  G_GLMP01_pvt::Initialize(pvlmap);
+  G_GM8E01_pvt::Initialize(pvlmap);
+  G_GNUEDA_pvt::Initialize(pvlmap);
+  G_GSAE01_pvt::Initialize(pvlmap);
+  G_GZ2P01_pvt::Initialize(pvlmap);
+  G_R5WEA4_pvt::Initialize(pvlmap);
+  G_RBUP08_pvt::Initialize(pvlmap);
+  G_RMCP01_pvt::Initialize(pvlmap);
+  G_RMGP01_pvt::Initialize(pvlmap);
+  G_RSBP01_pvt::Initialize(pvlmap);
+  G_SDWP18_pvt::Initialize(pvlmap);
+  G_SMNP01_pvt::Initialize(pvlmap);
+  G_SPDE52_pvt::Initialize(pvlmap);
+  G_SPXP41_pvt::Initialize(pvlmap);
+  G_SX4E01_pvt::Initialize(pvlmap);
+}
@@ -0,0 +1,14 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+
+#include "VideoCommon/NativeVertexFormat.h"
+
+// Registers the precompiled loaders of every game that has a profile in
+// VideoCommon/VertexLoaderProfiles. PrecompiledVertexLoaders.cpp and the G_*_pvt files are
+// generated from those profiles by Tools/gen-precompiled-vertex-loaders.py.
+void InitializePrecompiledVertexLoaders(std::map<u64, TCompiledLoaderFunction>& pvlmap);
@@ -38,15 +38,21 @@
 #include "Core/Host.h"
 #include "Core/Movie.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
+#include "Core/HW/GCPad.h"
+#include "Core/HW/SI/SI.h"
 #include "Core/HW/VideoInterface.h"
+#include "Core/HW/WriteWatch.h"
 
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/Debugger.h"
+#include "VideoCommon/DLCache.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/FrameBenchmark.h"
 #include "VideoCommon/FramebufferManagerBase.h"
+#include "VideoCommon/FrameProfilerBase.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -73,6 +79,9 @@ std::unique_ptr<Renderer> g_renderer;
 // to the depth buffer that exceeds 2^24 - 1.
 const float Renderer::GX_MAX_DEPTH = 16777215.0f / 16777216.0f;
 
+// Duplicate frames left on screen in a row at most.
+static const u32 MAX_SKIPPED_DUPLICATE_FRAMES = 3;
+
 static float AspectToWidescreen(float aspect)
 {
   return aspect * ((16.0f / 9.0f) / (4.0f / 3.0f));
@@ -80,7 +89,7 @@ static float AspectToWidescreen(float aspect)
 
 Renderer::Renderer()
 {
-  SetHash64Function();
+  SetHash64Function(static_cast<Hash64Function>(g_ActiveConfig.iTextureHashFunction));
   OSDChoice = 0;
   OSDTime = 0;
   m_last_efb_scale = g_ActiveConfig.iEFBScale;
@@ -353,6 +362,18 @@ void Renderer::DrawDebugText()
     final_yellow += "\n";
   }
 
+  if (g_ActiveConfig.bLowLatency)
+  {
+    final_cyan += StringFromFormat("Input latency: ~%.1f ms\n", m_input_latency_ms);
+    final_yellow += "\n";
+  }
+
+  if (Pad::IsSampling())
+  {
+    final_cyan += StringFromFormat("Pad sample age: ~%.2f ms\n", m_pad_sample_age_ms);
+    final_yellow += "\n";
+  }
+
   if (SConfig::GetInstance().m_ShowLag)
   {
     final_cyan += StringFromFormat("Lag: %" PRIu64 "\n", Movie::GetCurrentLagCount());
@@ -465,6 +486,13 @@ void Renderer::DrawDebugText()
   if (g_ActiveConfig.bOverlayProjStats)
     final_cyan += Statistics::ToStringProj();
 
+  if (g_ActiveConfig.bOverlayFrameProfile)
+  {
+    if (g_frame_profiler)
+      final_cyan += g_frame_profiler->ToString();
+    final_cyan += m_frame_pacer.ToString();
+  }
+
   // and then the text
   RenderText(final_cyan, 20, 20, 0xFF00FFFF);
   RenderText(final_yellow, 20, 20, 0xFFFFFF00);
@@ -777,12 +805,46 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
       m_aspect_wide = flush_count_anamorphic > 0.75 * flush_total;
   }
 
+  // Copies nothing asked for during the frame are written at its end.
+  if (g_texture_cache)
+    g_texture_cache->FlushDeferredEFBCopies();
+
   // TODO: merge more generic parts into VideoCommon
-  SwapImpl(xfbAddr, fbWidth, fbStride, fbHeight, rc, ticks, Gamma);
+  if (!Core::IsCatchingUp() && !IsDuplicateFrame(xfbAddr, fbWidth, fbStride, fbHeight, rc))
+  {
+    m_frame_pacer.BeginFrame(ticks);
+    {
+      FramePassScope profile_pass(FramePass::Present);
+      SwapImpl(xfbAddr, fbWidth, fbStride, fbHeight, rc, ticks, Gamma);
+    }
+    m_frame_pacer.EndFrame();
+  }
+
+  // This doesn't include the display's own latency, or the wait for scan out with V-Sync.
+  const u64 last_poll_us = SerialInterface::GetLastPollTimeUs();
+  if (g_ActiveConfig.bLowLatency && last_poll_us)
+  {
+    const float latency_ms = (Common::Timer::GetTimeUs() - last_poll_us) / 1000.0f;
+    m_input_latency_ms += (latency_ms - m_input_latency_ms) * 0.1f;
+  }
+  if (Pad::IsSampling())
+  {
+    const float sample_age_ms = Pad::GetLastSampleAgeUs() / 1000.0f;
+    m_pad_sample_age_ms += (sample_age_ms - m_pad_sample_age_ms) * 0.1f;
+  }
 
   if (m_xfb_written || (g_ActiveConfig.bUseXFB && g_ActiveConfig.bUseRealXFB))
     m_fps_counter.Update();
 
+  if (g_frame_profiler)
+  {
+    g_frame_profiler->EndFrame(
+        g_ActiveConfig.bOverlayFrameProfile || FrameBenchmark::IsRecording(),
+        g_ActiveConfig.bLogFrameProfileToFile);
+  }
+  if (FrameBenchmark::IsRecording())
+    FrameBenchmark::EndFrame();
+
   frameCount++;
   GFX_DEBUGGER_PAUSE_AT(NEXT_FRAME, true);
   if (g_ActiveConfig.bBlackFrameInsertion)
@@ -794,17 +856,57 @@ void Renderer::Swap(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight, const
   // Set default viewport and scissor, for the clear to work correctly
   // New frame
   stats.ResetFrame();
+  TextureCacheStats::EndFrame();
+  DLCache::ProgressiveCleanup();
 
   Core::Callback_VideoCopiedToXFB(m_xfb_written || (g_ActiveConfig.bUseXFB && g_ActiveConfig.bUseRealXFB));
   m_xfb_written = false;
 }
 
+// Games running at 30 FPS or less show each frame for several fields, the swaps in between only
+// present the same image again.
+bool Renderer::IsDuplicateFrame(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
+                                const EFBRectangle& rc)
+{
+  // Swaps that don't present anything leave the state of the last presenting one.
+  if (!m_xfb_written && !g_ActiveConfig.RealXFBEnabled())
+    return false;
+
+  const std::array<s32, 8> source = {
+      static_cast<s32>(xfb_addr), static_cast<s32>(fb_width), static_cast<s32>(fb_stride),
+      static_cast<s32>(fb_height), rc.left, rc.top, rc.right, rc.bottom};
+  bool duplicate = !m_efb_modified && source == m_last_swap_source;
+  m_efb_modified = false;
+  m_last_swap_source = source;
+
+  // Real XFB is read from RAM, which the CPU may write without drawing anything.
+  if (g_ActiveConfig.RealXFBEnabled())
+  {
+    const u32 size = fb_stride * fb_height * 2;
+    duplicate = duplicate && m_xfb_snapshot_valid &&
+                WriteWatch::IsUnchanged(xfb_addr, size, m_xfb_snapshot);
+    if (!duplicate)
+      m_xfb_snapshot_valid = WriteWatch::Snapshot(xfb_addr, size, &m_xfb_snapshot);
+  }
+
+  // A few frames are presented anyway, so that the on-screen display keeps up when a game stops
+  // drawing.
+  if (!duplicate || !g_ActiveConfig.bSkipDuplicateFrames ||
+      m_duplicate_frames >= MAX_SKIPPED_DUPLICATE_FRAMES || IsFrameDumping())
+  {
+    m_duplicate_frames = 0;
+    return false;
+  }
+  m_duplicate_frames++;
+  return true;
+}
+
 bool Renderer::IsFrameDumping()
 {
   if (m_screenshot_request.IsSet())
     return true;
 
-  if (SConfig::GetInstance().m_DumpFrames)
+  if (SConfig::GetInstance().m_DumpFrames || FrameBenchmark::IsHashingFrames())
     return true;
 
   ShutdownFrameDumping();
@@ -823,6 +925,13 @@ void Renderer::ShutdownFrameDumping()
 
 void Renderer::DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state, bool swap_upside_down, bool bgra)
 {
+  if (FrameBenchmark::IsHashingFrames())
+  {
+    FrameBenchmark::AddFrame(data, w, h, stride);
+    if (!m_screenshot_request.IsSet() && !SConfig::GetInstance().m_DumpFrames)
+      return;
+  }
+
   FinishFrameData();
 
   m_frame_dump_config = FrameDumpConfig{ data, w, h, stride, swap_upside_down, bgra, state };
@@ -13,6 +13,7 @@
 // ---------------------------------------------------------------------------------------------
 
 #pragma once
+#include <array>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -29,6 +30,7 @@
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FPSCounter.h"
+#include "VideoCommon/FramePacer.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -131,6 +133,15 @@ public:
   virtual void ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaEnable, bool zEnable, u32 color, u32 z) = 0;
   virtual void ReinterpretPixelData(unsigned int convtype) = 0;
   void RenderToXFB(u32 xfbAddr, const EFBRectangle& sourceRc, u32 fbStride, u32 fbHeight, float Gamma = 1.0f);
+  // Draws, clears and pokes call this, a swap without any since the last one repeats its image.
+  void OnEFBModified()
+  {
+    m_efb_modified = true;
+    m_efb_generation++;
+  }
+  // Changes with every modification of the EFB, copies and resolves of an unchanged EFB can be
+  // reused.
+  u64 GetEFBGeneration() const { return m_efb_generation; }
 
   virtual u32 AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data) = 0;
   virtual void PokeEFB(EFBAccessType type, const EfbPokeData* data, size_t num_points) = 0;
@@ -160,6 +171,8 @@ protected:
   bool IsFrameDumping();
   void DumpFrameData(const u8* data, int w, int h, int stride, const AVIDump::Frame& state, bool swap_upside_down = false, bool bgra = false);
   void FinishFrameData();
+  // Called by the backends right before presenting a frame.
+  void PacePresent() { m_frame_pacer.WaitForPresent(); }
 
   Common::Flag m_screenshot_request;
   Common::Event m_screenshot_completed;
@@ -182,6 +195,11 @@ protected:
   bool m_xfb_written{};
 
   FPSCounter m_fps_counter;
+  FramePacer m_frame_pacer;
+  // Smoothed time from the latest controller read to the end of presenting, low latency mode only.
+  float m_input_latency_ms = 0.0f;
+  // Smoothed age of the pad samples the SI reads, with the pad sampling thread only.
+  float m_pad_sample_age_ms = 0.0f;
   u32 m_last_host_config_bits = 0;
   bool m_last_uber_shader_enabled = false;
   std::unique_ptr<PostProcessor> m_post_processor;
@@ -194,6 +212,19 @@ protected:
 private:
   void RunFrameDumps();
   void ShutdownFrameDumping();
+  // Whether a swap that presents would show the same image as the last one, which is then left
+  // on screen instead.
+  bool IsDuplicateFrame(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
+                        const EFBRectangle& rc);
+
+  bool m_efb_modified = true;
+  u64 m_efb_generation = 0;
+  // The XFB address, size and source rectangle of the last presenting swap.
+  std::array<s32, 8> m_last_swap_source{};
+  // WriteWatch snapshot of the real XFB of the last presenting swap.
+  u64 m_xfb_snapshot = 0;
+  bool m_xfb_snapshot_valid = false;
+  u32 m_duplicate_frames = 0;
   PEControl::PixelFormat m_prev_efb_format = PEControl::INVALID_FMT;
   u32 m_efb_scale_numeratorX = 1;
   u32 m_efb_scale_numeratorY = 1;
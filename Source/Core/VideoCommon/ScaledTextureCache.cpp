@@ -0,0 +1,358 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/ScaledTextureCache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/ConfigManager.h"
+#include "VideoCommon/TextureUtil.h"
+
+static const u32 PACK_MAGIC = 0x4B505453;  // 'STPK'
+static const u32 PACK_VERSION = 1;
+
+// Scaled textures are at most 2048x2048 with their mips, anything bigger is a corrupted record.
+static const u32 MAX_TEXTURE_DATA_SIZE = 32 * 1024 * 1024;
+
+struct PackHeader
+{
+  u32 magic;
+  u32 version;
+};
+
+ScaledTexturePack::~ScaledTexturePack()
+{
+  Close();
+}
+
+bool ScaledTexturePack::Open(const std::string& filename, u64 size_limit)
+{
+  Close();
+  m_filename = filename;
+  m_file.Open(filename, File::Exists(filename) ? "r+b" : "w+b");
+  if (!m_file.IsOpen())
+  {
+    ERROR_LOG(VIDEO, "Failed to open the scaled texture cache %s", filename.c_str());
+    return false;
+  }
+
+  PackHeader header = {};
+  if (!m_file.ReadArray(&header, 1) || header.magic != PACK_MAGIC ||
+      header.version != PACK_VERSION)
+  {
+    // Empty, from an other version or corrupted, start over.
+    m_file.Open(filename, "w+b");
+    return WriteHeader();
+  }
+
+  ReadRecords();
+  INFO_LOG(VIDEO, "Scaled texture cache %s: %zu textures, %" PRIu64 " bytes", filename.c_str(),
+           m_records.size(), m_data_size);
+  return Compact(size_limit);
+}
+
+void ScaledTexturePack::Close()
+{
+  m_file.Close();
+  m_records.clear();
+  m_data_size = 0;
+  m_use_counter = 0;
+}
+
+bool ScaledTexturePack::WriteHeader()
+{
+  const PackHeader header = {PACK_MAGIC, PACK_VERSION};
+  m_file.Clear();
+  return m_file.Seek(0, SEEK_SET) && m_file.WriteArray(&header, 1) && m_file.Flush();
+}
+
+void ScaledTexturePack::ReadRecords()
+{
+  const u64 file_size = m_file.GetSize();
+  u64 offset = sizeof(PackHeader);
+  Key key;
+  TextureInfo info;
+  while (m_file.ReadArray(&key, 1) && m_file.ReadArray(&info, 1))
+  {
+    const u64 data_offset = offset + sizeof(Key) + sizeof(TextureInfo);
+    if (info.data_size > MAX_TEXTURE_DATA_SIZE || data_offset + info.data_size > file_size)
+      break;
+
+    // A texture stored again replaces the old copy.
+    auto iter = m_records.find(key);
+    if (iter != m_records.end())
+      m_data_size -= sizeof(Key) + sizeof(TextureInfo) + iter->second.info.data_size;
+    m_records[key] = {data_offset, info, ++m_use_counter};
+    m_data_size += sizeof(Key) + sizeof(TextureInfo) + info.data_size;
+
+    offset = data_offset + info.data_size;
+    if (!m_file.Seek(offset, SEEK_SET))
+      break;
+  }
+
+  // Drop a record cut off by a crash, the next one goes in its place.
+  m_file.Clear();
+  if (offset != file_size)
+    m_file.Resize(offset);
+  m_file.Seek(offset, SEEK_SET);
+}
+
+bool ScaledTexturePack::Contains(const Key& key) const
+{
+  return m_records.find(key) != m_records.end();
+}
+
+bool ScaledTexturePack::Read(const Key& key, Texture* out)
+{
+  auto iter = m_records.find(key);
+  if (iter == m_records.end())
+    return false;
+
+  Record& record = iter->second;
+  out->info = record.info;
+  out->data.resize(record.info.data_size);
+  m_file.Clear();
+  const bool success = m_file.Seek(record.offset, SEEK_SET) &&
+                       m_file.ReadBytes(out->data.data(), out->data.size());
+  m_file.Seek(0, SEEK_END);
+  if (!success)
+  {
+    m_data_size -= sizeof(Key) + sizeof(TextureInfo) + record.info.data_size;
+    m_records.erase(iter);
+    return false;
+  }
+
+  record.last_use = ++m_use_counter;
+  return true;
+}
+
+bool ScaledTexturePack::Append(const Key& key, const Texture& texture)
+{
+  if (!m_file.IsOpen() || texture.data.size() != texture.info.data_size)
+    return false;
+
+  m_file.Clear();
+  const u64 offset = m_file.GetSize();
+  if (!m_file.Seek(offset, SEEK_SET) || !m_file.WriteArray(&key, 1) ||
+      !m_file.WriteArray(&texture.info, 1) ||
+      !m_file.WriteBytes(texture.data.data(), texture.data.size()) || !m_file.Flush())
+  {
+    // Cut the partial record off so that the next one lines up.
+    m_file.Clear();
+    m_file.Resize(offset);
+    return false;
+  }
+
+  auto iter = m_records.find(key);
+  if (iter != m_records.end())
+    m_data_size -= sizeof(Key) + sizeof(TextureInfo) + iter->second.info.data_size;
+  m_records[key] = {offset + sizeof(Key) + sizeof(TextureInfo), texture.info, ++m_use_counter};
+  m_data_size += sizeof(Key) + sizeof(TextureInfo) + texture.info.data_size;
+  return true;
+}
+
+bool ScaledTexturePack::Compact(u64 size_limit)
+{
+  if (!m_file.IsOpen())
+    return false;
+  if (m_file.GetSize() <= size_limit)
+    return true;
+
+  // Most recently used first, until the limit is reached.
+  std::vector<std::pair<const Key*, Record*>> records;
+  records.reserve(m_records.size());
+  for (auto& it : m_records)
+    records.emplace_back(&it.first, &it.second);
+  std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+    return a.second->last_use > b.second->last_use;
+  });
+  u64 kept_size = sizeof(PackHeader);
+  size_t kept_count = 0;
+  while (kept_count < records.size())
+  {
+    const u64 record_size =
+        sizeof(Key) + sizeof(TextureInfo) + records[kept_count].second->info.data_size;
+    if (kept_size + record_size > size_limit)
+      break;
+    kept_size += record_size;
+    kept_count++;
+  }
+
+  // Write the kept ones least recently used first, so that the order survives the next Open.
+  const std::string temp_filename = m_filename + ".tmp";
+  File::IOFile temp(temp_filename, "wb");
+  const PackHeader header = {PACK_MAGIC, PACK_VERSION};
+  bool success = temp.WriteArray(&header, 1);
+  std::vector<u8> data;
+  for (size_t i = kept_count; i-- > 0 && success;)
+  {
+    const Record& record = *records[i].second;
+    data.resize(record.info.data_size);
+    m_file.Clear();
+    success = m_file.Seek(record.offset, SEEK_SET) && m_file.ReadBytes(data.data(), data.size()) &&
+              temp.WriteArray(records[i].first, 1) && temp.WriteArray(&record.info, 1) &&
+              temp.WriteBytes(data.data(), data.size());
+  }
+  success = temp.Close() && success;
+  if (!success)
+  {
+    ERROR_LOG(VIDEO, "Failed to compact the scaled texture cache %s", m_filename.c_str());
+    File::Delete(temp_filename);
+    m_file.Clear();
+    m_file.Seek(0, SEEK_END);
+    return false;
+  }
+
+  INFO_LOG(VIDEO, "Dropped %zu least recently used textures from the scaled texture cache",
+           m_records.size() - kept_count);
+  m_file.Close();
+  const std::string filename = m_filename;
+  if (!File::Rename(temp_filename, filename))
+  {
+    File::Delete(temp_filename);
+    return Open(filename, UINT64_MAX);
+  }
+  Close();
+  m_filename = filename;
+  m_file.Open(filename, "r+b");
+  m_file.Seek(sizeof(PackHeader), SEEK_SET);
+  ReadRecords();
+  return true;
+}
+
+ScaledTextureCache::ScaledTextureCache(const std::string& filename, u64 size_limit, bool compress)
+    : m_size_limit(size_limit), m_compress(compress)
+{
+  m_pack.Open(filename, size_limit);
+  Common::ThreadPool::RegisterWorker(this);
+}
+
+ScaledTextureCache::~ScaledTextureCache()
+{
+  Common::ThreadPool::UnregisterWorker(this);
+  size_t loop_count = 0;
+  while (m_running.load())
+    Common::cYield(loop_count++);
+
+  // Keep what was scaled but not written yet.
+  for (const auto& pending : m_queued)
+    Write(*pending);
+  m_queued.clear();
+  m_pack.Compact(m_size_limit);
+}
+
+std::string ScaledTextureCache::GetFilename()
+{
+  const std::string directory = File::GetUserPath(D_CACHE_IDX) + "ScaledTextures" DIR_SEP;
+  if (!File::Exists(directory))
+    File::CreateDir(directory);
+  return directory + SConfig::GetInstance().GetGameID() + ".pack";
+}
+
+bool ScaledTextureCache::NextTask(size_t ID)
+{
+  // Appends have to go one after the other anyway.
+  if (m_running.exchange(true))
+    return false;
+
+  std::unique_ptr<PendingTexture> pending;
+  {
+    std::lock_guard<std::mutex> guard(m_queue_lock);
+    if (!m_queued.empty())
+    {
+      pending = std::move(m_queued.front());
+      m_queued.pop_front();
+    }
+  }
+  if (!pending)
+  {
+    m_running.store(false);
+    return false;
+  }
+
+  Write(*pending);
+
+  bool more;
+  {
+    std::lock_guard<std::mutex> guard(m_queue_lock);
+    more = !m_queued.empty();
+  }
+  m_running.store(false);
+  // Threads turned away while this one wrote don't come back on their own.
+  if (more)
+    Common::ThreadPool::NotifyWorkPending();
+  return true;
+}
+
+bool ScaledTextureCache::Read(const ScaledTexturePack::Key& key, ScaledTexturePack::Texture* out)
+{
+  std::lock_guard<std::mutex> guard(m_pack_lock);
+  return m_pack.Read(key, out);
+}
+
+void ScaledTextureCache::Store(const ScaledTexturePack::Key& key, std::vector<Level> levels)
+{
+  auto pending = std::make_unique<PendingTexture>();
+  pending->key = key;
+  pending->levels = std::move(levels);
+  {
+    std::lock_guard<std::mutex> guard(m_queue_lock);
+    m_queued.push_back(std::move(pending));
+  }
+  Common::ThreadPool::NotifyWorkPending();
+}
+
+void ScaledTextureCache::Write(const PendingTexture& pending)
+{
+  if (pending.levels.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> guard(m_pack_lock);
+    if (m_pack.Contains(pending.key))
+      return;
+  }
+
+  // The DXT5 blocks of a level 0 that isn't a multiple of 4 wide and high don't line up with it.
+  const Level& first = pending.levels.front();
+  const HostTextureFormat format = m_compress && first.width % 4 == 0 && first.height % 4 == 0 ?
+                                       PC_TEX_FMT_DXT5 :
+                                       PC_TEX_FMT_RGBA32;
+  ScaledTexturePack::Texture texture;
+  texture.info.format = format;
+  texture.info.width = first.width;
+  texture.info.height = first.height;
+  texture.info.levels = static_cast<u32>(pending.levels.size());
+  for (const Level& level : pending.levels)
+  {
+    const size_t offset = texture.data.size();
+    texture.data.resize(offset + TextureUtil::GetTextureSizeInBytes(level.width, level.height,
+                                                                    format));
+    u8* dst = texture.data.data() + offset;
+    if (format == PC_TEX_FMT_DXT5)
+    {
+      TextureUtil::CompressRGBA32ToDXT5(dst, level.data.data(), level.width, level.height,
+                                        level.row_length);
+    }
+    else
+    {
+      TextureUtil::CopyTextureData(dst, reinterpret_cast<const u8*>(level.data.data()),
+                                   level.width, level.height, level.row_length * sizeof(u32),
+                                   level.width * sizeof(u32), sizeof(u32));
+    }
+  }
+  texture.info.data_size = static_cast<u32>(texture.data.size());
+
+  std::lock_guard<std::mutex> guard(m_pack_lock);
+  m_pack.Append(pending.key, texture);
+  // Rewriting the file is slow, so it may grow a bit past the limit first.
+  if (m_pack.GetDataSize() > m_size_limit + m_size_limit / 4)
+    m_pack.Compact(m_size_limit);
+}
@@ -0,0 +1,164 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/ThreadPool.h"
+#include "VideoCommon/TextureDecoder.h"
+
+// Upscaled textures of a game, kept on disk between sessions so that each texture only goes
+// through the scaler the first time the game uses it.
+//
+// On disk format:
+// header{
+// u32 'STPK';
+// u32 version;
+//}
+// record{
+// Key key;
+// TextureInfo info;
+// u8 data[info.data_size];
+//}
+//
+// Records are appended in the order they are (re)used, so the front of the file holds the least
+// recently used ones. Once the file grows past its limit, Compact() rewrites it without those.
+class ScaledTexturePack
+{
+public:
+  struct Key
+  {
+    // XXH64 of the texture data, including the mips, and of the palette.
+    u64 hash;
+    u32 width;
+    u32 height;
+    u32 levels;
+    // Texture format, with the palette format in the upper half for paletted ones.
+    u32 format;
+    u32 scaling_type;
+    u32 scaling_factor;
+    u32 deposterize;
+    u32 pad;
+
+    bool operator==(const Key& other) const
+    {
+      return hash == other.hash && width == other.width && height == other.height &&
+             levels == other.levels && format == other.format &&
+             scaling_type == other.scaling_type && scaling_factor == other.scaling_factor &&
+             deposterize == other.deposterize;
+    }
+  };
+
+  struct KeyHasher
+  {
+    size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+  };
+
+  struct TextureInfo
+  {
+    u32 format;
+    // Size of level 0, the others are halved like the native ones.
+    u32 width;
+    u32 height;
+    u32 levels;
+    u32 data_size;
+  };
+
+  struct Texture
+  {
+    TextureInfo info;
+    // The levels one after the other, each TextureUtil::GetTextureSizeInBytes long.
+    std::vector<u8> data;
+  };
+
+  ScaledTexturePack() = default;
+  ~ScaledTexturePack();
+
+  // Opens or creates the pack, dropping the least recently used textures past size_limit bytes.
+  bool Open(const std::string& filename, u64 size_limit);
+  void Close();
+
+  bool Contains(const Key& key) const;
+  // Reads the texture and marks it as the most recently used one.
+  bool Read(const Key& key, Texture* out);
+  bool Append(const Key& key, const Texture& texture);
+  // Rewrites the file with the most recently used textures that fit in size_limit bytes, if it is
+  // bigger than that.
+  bool Compact(u64 size_limit);
+
+  size_t GetCount() const { return m_records.size(); }
+  // Bytes the records take up, not counting the ones replaced by newer copies.
+  u64 GetDataSize() const { return m_data_size; }
+
+private:
+  struct Record
+  {
+    u64 offset;
+    TextureInfo info;
+    u64 last_use;
+  };
+
+  bool WriteHeader();
+  void ReadRecords();
+
+  std::string m_filename;
+  File::IOFile m_file;
+  std::unordered_map<Key, Record, KeyHasher> m_records;
+  u64 m_data_size = 0;
+  u64 m_use_counter = 0;
+};
+
+// A ScaledTexturePack shared with a thread pool worker, which compresses the textures stored
+// from the GPU thread and appends them in the background.
+class ScaledTextureCache final : public Common::IWorker
+{
+public:
+  struct Level
+  {
+    // RGBA32 pixels of the scaled level.
+    std::vector<u32> data;
+    u32 width;
+    u32 height;
+    u32 row_length;
+  };
+
+  // compress stores the textures that allow it as DXT5 instead of RGBA32.
+  ScaledTextureCache(const std::string& filename, u64 size_limit, bool compress);
+  ~ScaledTextureCache();
+
+  bool NextTask(size_t ID) override;
+
+  bool Read(const ScaledTexturePack::Key& key, ScaledTexturePack::Texture* out);
+  void Store(const ScaledTexturePack::Key& key, std::vector<Level> levels);
+
+  // Where the cache of the running game is kept.
+  static std::string GetFilename();
+
+private:
+  struct PendingTexture
+  {
+    ScaledTexturePack::Key key;
+    std::vector<Level> levels;
+  };
+
+  void Write(const PendingTexture& pending);
+
+  ScaledTexturePack m_pack;
+  u64 m_size_limit;
+  bool m_compress;
+  std::mutex m_pack_lock;
+  std::mutex m_queue_lock;
+  std::deque<std::unique_ptr<PendingTexture>> m_queued;
+  std::atomic<bool> m_running{false};
+};
@@ -0,0 +1,74 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/ShaderCacheUtils.h"
+
+#include <lzo/lzo1x.h>
+
+#include "Common/Hash.h"
+#include "Common/Version.h"
+#include "Core/ConfigManager.h"
+
+namespace ShaderCacheUtils
+{
+pKey_t GetGameCategory()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  return static_cast<pKey_t>(GetMurmurHash3(reinterpret_cast<const u8*>(game_id.data()),
+                                            static_cast<u32>(game_id.size()), 0));
+}
+
+std::string GetGameID()
+{
+  return SConfig::GetInstance().GetGameID();
+}
+
+// Bytecode and program binaries are far smaller, anything bigger is a corrupted entry.
+static const u32 MAX_SHADER_DATA_SIZE = 64 * 1024 * 1024;
+
+static bool InitializeLZO()
+{
+  static const bool initialized = lzo_init() == LZO_E_OK;
+  return initialized;
+}
+
+// Every value starts with its uncompressed size.
+bool CompressShaderData(const u8* data, u32 size, std::vector<u8>* out)
+{
+  if (!InitializeLZO())
+    return false;
+  std::vector<u8> work_memory(LZO1X_1_MEM_COMPRESS);
+  out->resize(sizeof(u32) + size + size / 16 + 64 + 3);
+  std::memcpy(out->data(), &size, sizeof(u32));
+  lzo_uint out_size = 0;
+  if (lzo1x_1_compress(data, size, out->data() + sizeof(u32), &out_size, work_memory.data()) !=
+      LZO_E_OK)
+  {
+    return false;
+  }
+  out->resize(sizeof(u32) + out_size);
+  return true;
+}
+
+bool DecompressShaderData(const u8* data, u32 size, std::vector<u8>* out)
+{
+  u32 raw_size = 0;
+  if (size < sizeof(u32) || !InitializeLZO())
+    return false;
+  std::memcpy(&raw_size, data, sizeof(u32));
+  if (raw_size > MAX_SHADER_DATA_SIZE)
+    return false;
+  out->resize(raw_size);
+  lzo_uint out_size = raw_size;
+  return lzo1x_decompress_safe(data + sizeof(u32), size - sizeof(u32), out->data(), &out_size,
+                               nullptr) == LZO_E_OK &&
+         out_size == raw_size;
+}
+
+// Files written before the store was compressed carry the plain version and are recreated.
+std::string GetDiskCacheVersion()
+{
+  return Common::scm_rev_cache_str + "lzo";
+}
+}
@@ -0,0 +1,238 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
+#include "VideoCommon/ObjectUsageProfiler.h"
+#include "VideoCommon/Statistics.h"
+
+// Pieces every backend shader cache shares: the per game usage profiles that decide which
+// shaders are precompiled first, and the on-disk bytecode store.
+namespace ShaderCacheUtils
+{
+// Usage profile category of the running game.
+pKey_t GetGameCategory();
+std::string GetGameID();
+
+template <typename Uid>
+void NormalizeUid(Uid& uid)
+{
+  uid.ClearHASH();
+  uid.CalculateUIDHash();
+}
+
+// Opens the usage profile "<game id>.<type>", seeded from the global "Ishiiruka.<type>" profile
+// the first time a game runs.
+template <typename Profile>
+Profile* CreateUsageProfile(const char* type, pKey_t version)
+{
+  return Profile::Create(GetGameCategory(), version, std::string("Ishiiruka.") + type,
+                         GetGameID() + "." + type);
+}
+
+template <typename Profile>
+void PersistUsageProfile(Profile* profile)
+{
+  if (profile)
+    profile->Persist(NormalizeUid<typename Profile::key_type>);
+}
+
+// Calls func(uid, total) for up to max_count shaders of the running game, most used first,
+// skipping the entries needs_compile rejects.
+template <typename Profile, typename Filter, typename Func>
+void ForEachShaderToPrecompile(Profile* profile, Filter needs_compile, Func func,
+                               size_t max_count = SIZE_MAX)
+{
+  profile->ForEachMostUsedByCategory(GetGameCategory(),
+                                     [&](const typename Profile::key_type& uid, size_t total) {
+                                       typename Profile::key_type item = uid;
+                                       NormalizeUid(item);
+                                       func(item, total);
+                                     },
+                                     needs_compile, true, 3, max_count);
+}
+
+// The first time a game runs with a seeded profile, this many of its most used shaders per stage
+// are queued for the background compiler instead of blocking the boot. Tessellation uses half as
+// many since each uid is a hull and a domain shader, so the vertex, pixel and tessellation stages
+// together fit in the work units HLSLAsyncCompiler holds.
+constexpr size_t PREDICTIVE_PRECOMPILE_COUNT = 64;
+
+template <typename Profile>
+bool ShouldPrecompileInBackground(const Profile* profile)
+{
+  return profile && profile->IsSeeded();
+}
+
+// Splits the uber shaders enumerate gives into the ones the specialized shaders in the usage
+// profile map to, most used first, and the others. The boot only waits for the first ones, the
+// others are compiled in the background.
+template <typename UberUid, typename Profile, typename ToUberUid, typename Enumerate>
+void GetUberShadersToPrecompile(Profile* profile, ToUberUid to_uber_uid, Enumerate enumerate,
+                                std::vector<UberUid>* used, std::vector<UberUid>* unused)
+{
+  const auto contains = [](const std::vector<UberUid>& uids, const UberUid& uid) {
+    return std::find(uids.begin(), uids.end(), uid) != uids.end();
+  };
+  if (profile)
+  {
+    ForEachShaderToPrecompile(profile, [](const auto&) { return true; },
+                              [&](const typename Profile::key_type& uid, size_t total) {
+                                const UberUid uber_uid = to_uber_uid(uid);
+                                if (!contains(*used, uber_uid))
+                                  used->push_back(uber_uid);
+                              });
+  }
+  enumerate([&](const UberUid& uid, size_t total) {
+    if (!contains(*used, uid))
+      unused->push_back(uid);
+  });
+}
+
+// Files hold at most this many shaders, the oldest are dropped once a cache grows past it.
+constexpr u32 MAX_DISK_CACHE_ENTRIES = 16384;
+
+bool CompressShaderData(const u8* data, u32 size, std::vector<u8>* out);
+bool DecompressShaderData(const u8* data, u32 size, std::vector<u8>* out);
+std::string GetDiskCacheVersion();
+
+// Drop-in replacement for LinearDiskCache that stores the values LZO compressed. Duplicated
+// keys, entries that fail to decompress and the entries above MAX_DISK_CACHE_ENTRIES are
+// removed from the file when it is opened.
+template <typename K, typename V>
+class ShaderDiskCache
+{
+public:
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    Decompressor decompressor(reader);
+    const u32 count = m_cache.OpenAndRead(filename, decompressor, GetDiskCacheVersion());
+    ShaderCompileStats::AddDiskCacheHits(static_cast<u32>(decompressor.last_index.size()));
+    if (decompressor.invalid_entries != 0 || decompressor.last_index.size() < count ||
+        count > MAX_DISK_CACHE_ENTRIES)
+    {
+      Compact(filename, decompressor.last_index, count);
+    }
+    return count;
+  }
+
+  // Opens the file for Get without reading it.
+  u32 Open(const std::string& filename) { return m_cache.Open(filename, GetDiskCacheVersion()); }
+
+  bool Get(const K& key, std::vector<V>* value)
+  {
+    if (!m_cache.Get(key, &m_buffer) ||
+        !DecompressShaderData(m_buffer.data(), static_cast<u32>(m_buffer.size()), &m_data) ||
+        m_data.size() % sizeof(V) != 0)
+    {
+      return false;
+    }
+    value->resize(m_data.size() / sizeof(V));
+    std::memcpy(value->data(), m_data.data(), m_data.size());
+    return true;
+  }
+
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    if (CompressShaderData(reinterpret_cast<const u8*>(value), value_size * sizeof(V), &m_buffer))
+      m_cache.Append(key, m_buffer.data(), static_cast<u32>(m_buffer.size()));
+  }
+
+  void Sync() { m_cache.Sync(); }
+  void Close() { m_cache.Close(); }
+
+private:
+  struct KeyLess
+  {
+    bool operator()(const K& a, const K& b) const { return std::memcmp(&a, &b, sizeof(K)) < 0; }
+  };
+  using IndexMap = std::map<K, u32, KeyLess>;
+
+  class Decompressor : public LinearDiskCacheReader<K, u8>
+  {
+  public:
+    explicit Decompressor(LinearDiskCacheReader<K, V>& reader) : m_reader(reader) {}
+    void Read(const K& key, const u8* value, u32 value_size) override
+    {
+      const u32 index = m_index++;
+      if (!DecompressShaderData(value, value_size, &m_data) || m_data.size() % sizeof(V) != 0)
+      {
+        invalid_entries++;
+        return;
+      }
+      last_index[key] = index;
+      m_reader.Read(key, reinterpret_cast<const V*>(m_data.data()),
+                    static_cast<u32>(m_data.size() / sizeof(V)));
+    }
+
+    IndexMap last_index;
+    u32 invalid_entries = 0;
+
+  private:
+    LinearDiskCacheReader<K, V>& m_reader;
+    std::vector<u8> m_data;
+    u32 m_index = 0;
+  };
+
+  class Collector : public LinearDiskCacheReader<K, u8>
+  {
+  public:
+    Collector(const IndexMap& last_index, u32 first_kept)
+      : m_last_index(last_index), m_first_kept(first_kept)
+    {
+    }
+    void Read(const K& key, const u8* value, u32 value_size) override
+    {
+      const u32 index = m_index++;
+      auto it = m_last_index.find(key);
+      if (index < m_first_kept || it == m_last_index.end() || it->second != index)
+        return;
+      entries.emplace_back(key, std::vector<u8>(value, value + value_size));
+    }
+
+    std::vector<std::pair<K, std::vector<u8>>> entries;
+
+  private:
+    const IndexMap& m_last_index;
+    u32 m_first_kept;
+    u32 m_index = 0;
+  };
+
+  class Ignore : public LinearDiskCacheReader<K, u8>
+  {
+  public:
+    void Read(const K& key, const u8* value, u32 value_size) override {}
+  };
+
+  // Rewrites the file with the newest copy of every key, keeping the newest entries when there
+  // are too many.
+  void Compact(const std::string& filename, const IndexMap& last_index, u32 count)
+  {
+    const u32 first_kept = count > MAX_DISK_CACHE_ENTRIES ? count - MAX_DISK_CACHE_ENTRIES : 0;
+    Collector collector(last_index, first_kept);
+    m_cache.OpenAndRead(filename, collector, GetDiskCacheVersion());
+    m_cache.Close();
+    File::Delete(filename);
+    Ignore ignore;
+    m_cache.OpenAndRead(filename, ignore, GetDiskCacheVersion());
+    for (const auto& entry : collector.entries)
+      m_cache.Append(entry.first, entry.second.data(), static_cast<u32>(entry.second.size()));
+    m_cache.Sync();
+  }
+
+  LinearDiskCache<K, u8> m_cache;
+  std::vector<u8> m_buffer;
+  std::vector<u8> m_data;
+};
+}
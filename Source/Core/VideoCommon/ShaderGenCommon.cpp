@@ -3,9 +3,115 @@
 // Refer to the license.txt file included.
 
 #include "VideoCommon/ShaderGenCommon.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <utility>
+
 #include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/BPMemory.h"
+
+// One counter per stage. The bounding box flag also changes on the CPU thread.
+static std::array<std::atomic<u32>, 4> s_shader_uid_revisions{};
+
+void InvalidateShaderUids(u32 stages)
+{
+  for (size_t i = 0; i < s_shader_uid_revisions.size(); i++)
+  {
+    if (stages & (1 << i))
+      s_shader_uid_revisions[i].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// The registers the Get*ShaderUid functions read, keep in sync with them.
+static std::array<u8, 0x100> BuildBPShaderUidStages()
+{
+  std::array<u8, 0x100> stages{};
+  const auto set = [&stages](u32 first, u32 last, u32 mask) {
+    for (u32 address = first; address <= last; address++)
+      stages[address] |= mask;
+  };
+  // genMode, tevind, tevindref and tevorders select the stages and texture coordinates.
+  set(BPMEM_GENMODE, BPMEM_GENMODE, SHADER_UID_PIXEL | SHADER_UID_TESSELLATION);
+  set(BPMEM_IND_CMD, BPMEM_IND_CMD + 15, SHADER_UID_PIXEL | SHADER_UID_TESSELLATION);
+  set(BPMEM_IREF, BPMEM_TREF + 7, SHADER_UID_PIXEL | SHADER_UID_TESSELLATION);
+  set(BPMEM_ZMODE, BPMEM_BLENDMODE, SHADER_UID_PIXEL);
+  set(BPMEM_ZCOMPARE, BPMEM_ZCOMPARE, SHADER_UID_PIXEL);
+  set(BPMEM_TEV_COLOR_ENV, BPMEM_TEV_ALPHA_ENV + 30, SHADER_UID_PIXEL);
+  set(BPMEM_FOGRANGE, BPMEM_FOGRANGE, SHADER_UID_PIXEL);
+  set(BPMEM_FOGPARAM3, BPMEM_FOGPARAM3, SHADER_UID_PIXEL);
+  set(BPMEM_ALPHACOMPARE, BPMEM_ALPHACOMPARE, SHADER_UID_PIXEL);
+  set(BPMEM_ZTEX2, BPMEM_TEV_KSEL + 7, SHADER_UID_PIXEL);
+  // These turn the bounding box on and off.
+  set(BPMEM_TRIGGER_EFB_COPY, BPMEM_TRIGGER_EFB_COPY, SHADER_UID_PIXEL);
+  set(BPMEM_CLEARBBOX1, BPMEM_CLEARBBOX2, SHADER_UID_PIXEL);
+  return stages;
+}
+
+static u32 GetXFShaderUidStages(u32 address)
+{
+  switch (address)
+  {
+  case XFMEM_SETNUMCHAN:
+  case XFMEM_SETPROJECTION + 6:  // The projection type
+  case XFMEM_SETNUMTEXGENS:
+    return SHADER_UID_ALL;
+  case XFMEM_SETCHAN0_COLOR:
+  case XFMEM_SETCHAN1_COLOR:
+  case XFMEM_SETCHAN0_ALPHA:
+  case XFMEM_SETCHAN1_ALPHA:
+    return SHADER_UID_PIXEL | SHADER_UID_VERTEX;
+  case XFMEM_DUALTEX:
+    return SHADER_UID_VERTEX;
+  default:
+    if ((address >= XFMEM_SETTEXMTXINFO && address < XFMEM_SETTEXMTXINFO + 8) ||
+        (address >= XFMEM_SETPOSMTXINFO && address < XFMEM_SETPOSMTXINFO + 8))
+    {
+      return SHADER_UID_VERTEX;
+    }
+    return 0;
+  }
+}
+
+void InvalidateShaderUidsForBPWrite(u32 address)
+{
+  static const std::array<u8, 0x100> bp_stages = BuildBPShaderUidStages();
+  if (bp_stages[address & 0xFF])
+    InvalidateShaderUids(bp_stages[address & 0xFF]);
+}
+
+void InvalidateShaderUidsForXFWrite(u32 address, u32 count)
+{
+  u32 stages = 0;
+  for (u32 i = 0; i < count; i++)
+    stages |= GetXFShaderUidStages(address + i);
+  if (stages)
+    InvalidateShaderUids(stages);
+}
+
+bool ShaderUidTracker::IsUnchanged(u32 components, u32 draw_mode)
+{
+  // The counters only grow, so the sum changes whenever one of them does.
+  u32 revision = 0;
+  for (size_t i = 0; i < s_shader_uid_revisions.size(); i++)
+  {
+    if (m_stages & (1 << i))
+      revision += s_shader_uid_revisions[i].load(std::memory_order_relaxed);
+  }
+  if (m_valid && m_revision == revision && m_components == components &&
+      m_draw_mode == draw_mode)
+  {
+    return true;
+  }
+  m_valid = true;
+  m_revision = revision;
+  m_components = components;
+  m_draw_mode = draw_mode;
+  return false;
+}
 
 ShaderHostConfig ShaderHostConfig::GetCurrent()
 {
@@ -30,9 +136,77 @@ ShaderHostConfig ShaderHostConfig::GetCurrent()
   bits.backend_bitfield = g_ActiveConfig.backend_info.bSupportsBitfield;
   bits.backend_dynamic_sampler_indexing =
     g_ActiveConfig.backend_info.bSupportsDynamicSamplerIndexing;
+  bits.vs_stereo = g_ActiveConfig.UseVertexShaderStereo();
   return bits;
 }
 
+namespace
+{
+// Buffers left by the ShaderCode objects a thread destroyed. A thread rarely has more than a
+// vertex, a pixel and a geometry shader in flight, a few spare buffers cover it.
+constexpr size_t SHADER_CODE_BUFFER_SIZE = 32768;
+constexpr size_t MAX_POOLED_SHADER_CODE_BUFFERS = 4;
+
+// The work units of the asynchronous compilers can be released after the thread locals of the
+// releasing thread are gone, alive tells the destructor not to touch the pool then.
+struct ShaderCodeBufferPool
+{
+  ~ShaderCodeBufferPool() { alive = false; }
+  std::vector<std::string> buffers;
+  bool alive = true;
+};
+
+thread_local ShaderCodeBufferPool s_shader_code_buffers;
+}
+
+ShaderCode::ShaderCode()
+{
+  ShaderCodeBufferPool& pool = s_shader_code_buffers;
+  if (pool.alive && !pool.buffers.empty())
+  {
+    m_buffer = std::move(pool.buffers.back());
+    pool.buffers.pop_back();
+    return;
+  }
+  m_buffer.reserve(SHADER_CODE_BUFFER_SIZE);
+}
+
+ShaderCode::~ShaderCode()
+{
+  ShaderCodeBufferPool& pool = s_shader_code_buffers;
+  if (!pool.alive || pool.buffers.size() >= MAX_POOLED_SHADER_CODE_BUFFERS ||
+      m_buffer.capacity() < SHADER_CODE_BUFFER_SIZE)
+  {
+    return;
+  }
+  m_buffer.clear();
+  pool.buffers.push_back(std::move(m_buffer));
+}
+
+void ShaderCode::WriteV(const char* fmt, va_list arglist)
+{
+  // Most lines are plain text.
+  if (!std::strchr(fmt, '%'))
+  {
+    m_buffer.append(fmt);
+    return;
+  }
+  va_list arglist_copy;
+  va_copy(arglist_copy, arglist);
+  char line[1024];
+  if (CharArrayFromFormatV(line, sizeof(line), fmt, arglist) ||
+      std::strlen(line) < sizeof(line) - 1)
+  {
+    m_buffer.append(line);
+  }
+  else
+  {
+    // Longer than the stack buffer.
+    m_buffer.append(StringFromFormatV(fmt, arglist_copy));
+  }
+  va_end(arglist_copy);
+}
+
 std::string GetDiskShaderCacheFileName(API_TYPE api_type, const char* type, bool include_gameid,
   bool include_host_config, bool uid)
 {
@@ -60,7 +60,7 @@ public:
       }
       else
       {
-        HASH = (std::size_t)GetMurmurHash3(reinterpret_cast<u8*>(&data) + data.StartValue(), data.NumValues(), 0);
+        HASH = (std::size_t)GetXXH3_64(reinterpret_cast<u8*>(&data) + data.StartValue(), data.NumValues());
       }
       HASH++;
     }
@@ -112,10 +112,19 @@ private:
   std::size_t HASH;
 };
 
+// Shader source buffer. Lines without arguments are appended as they are and the others are
+// formatted on the stack, so writing a line doesn't allocate. The buffers are recycled per thread
+// once a ShaderCode goes away, the next shader generated on that thread reuses their capacity.
 class ShaderCode
 {
 public:
-  ShaderCode() { m_buffer.reserve(32768); }
+  ShaderCode();
+  ShaderCode(const ShaderCode&) = default;
+  ShaderCode(ShaderCode&&) = default;
+  ShaderCode& operator=(const ShaderCode&) = default;
+  ShaderCode& operator=(ShaderCode&&) = default;
+  ~ShaderCode();
+
   void Write(const char* fmt, ...)
 #ifdef __GNUC__
     __attribute__((format(printf, 2, 3)))
@@ -123,9 +132,10 @@ public:
   {
     va_list arglist;
     va_start(arglist, fmt);
-    m_buffer += StringFromFormatV(fmt, arglist);
+    WriteV(fmt, arglist);
     va_end(arglist);
-}
+  }
+  void WriteV(const char* fmt, va_list arglist);
   void clear()
   {
     m_buffer.clear();
@@ -172,12 +182,49 @@ union ShaderHostConfig
     u32 backend_reversed_depth_range : 1;
     u32 backend_bitfield : 1;
     u32 backend_dynamic_sampler_indexing : 1;
-    u32 pad : 13;
+    u32 vs_stereo : 1;
+    u32 pad : 12;
   };
 
   static ShaderHostConfig GetCurrent();
 };
 
+// The uids the state changes are tracked for.
+enum ShaderUidStage : u32
+{
+  SHADER_UID_PIXEL = 1 << 0,
+  SHADER_UID_VERTEX = 1 << 1,
+  SHADER_UID_GEOMETRY = 1 << 2,
+  SHADER_UID_TESSELLATION = 1 << 3,
+  SHADER_UID_ALL = (1 << 4) - 1,
+};
+
+// Called when the state the uids of stages are generated from may have changed, like the active
+// config, the bounding box or loading a state.
+void InvalidateShaderUids(u32 stages = SHADER_UID_ALL);
+// Register writes only invalidate the uids that read the registers.
+void InvalidateShaderUidsForBPWrite(u32 address);
+void InvalidateShaderUidsForXFWrite(u32 address, u32 count);
+
+// Lets a shader cache skip generating the uids of a draw when nothing they depend on changed
+// since its last draw. components and draw_mode hold the inputs that come from the draw itself,
+// like the primitive type.
+class ShaderUidTracker
+{
+public:
+  explicit ShaderUidTracker(u32 stages) : m_stages(stages) {}
+  // True when the uids of the last call still hold.
+  bool IsUnchanged(u32 components, u32 draw_mode = 0);
+  void Reset() { m_valid = false; }
+
+private:
+  u32 m_stages;
+  u32 m_revision = 0;
+  u32 m_components = 0;
+  u32 m_draw_mode = 0;
+  bool m_valid = false;
+};
+
 // Gets the filename of the specified type of cache object (e.g. vertex shader, pipeline).
 std::string GetDiskShaderCacheFileName(API_TYPE api_type, const char* type, bool include_gameid,
   bool include_host_config, bool uid = false);
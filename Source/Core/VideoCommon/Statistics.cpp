@@ -2,11 +2,22 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
+#include <atomic>
+#include <cinttypes>
 #include <cstring>
+#include <fstream>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "Common/Tracing.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -16,6 +27,7 @@ Statistics stats;
 void Statistics::ResetFrame()
 {
   memset(&thisFrame, 0, sizeof(ThisFrame));
+  VertexLoaderManager::ResetFrameStatistics();
 }
 
 void Statistics::SwapDL()
@@ -44,6 +56,15 @@ std::string Statistics::ToString()
   }
   str += StringFromFormat("Textures created: %i\n", stats.numTexturesCreated);
   str += StringFromFormat("Textures alive: %i\n", stats.numTexturesAlive);
+  if (stats.textureMemoryBudget)
+  {
+    str += StringFromFormat("Texture memory: %i / %i MB\n", stats.textureMemoryUsed,
+                            stats.textureMemoryBudget);
+  }
+  else
+  {
+    str += StringFromFormat("Texture memory: %i MB\n", stats.textureMemoryUsed);
+  }
   str += StringFromFormat("pshaders created: %i\n", stats.numPixelShadersCreated);
   str += StringFromFormat("pshaders alive: %i\n", stats.numPixelShadersAlive);
   str += StringFromFormat("vshaders created: %i\n", stats.numVertexShadersCreated);
@@ -70,6 +91,14 @@ std::string Statistics::ToString()
   str += StringFromFormat("Index streamed: %i kB\n", stats.thisFrame.bytesIndexStreamed / 1024);
   str += StringFromFormat("Uniform streamed: %i kB\n", stats.thisFrame.bytesUniformStreamed / 1024);
   str += StringFromFormat("Vertex Loaders: %i\n", stats.numVertexLoaders);
+  str += ShaderCompileStats::ToString();
+  str += TextureCacheStats::ToString();
+  if (stats.syncGpuMaxDistance)
+  {
+    str += StringFromFormat("SyncGPU distance: %i / %i (CPU stalled %.1f%%)\n",
+                            stats.syncGpuMinDistance, stats.syncGpuMaxDistance,
+                            stats.syncGpuStallPercent);
+  }
 
   std::string vertex_list;
   VertexLoaderManager::AppendListToString(&vertex_list);
@@ -110,3 +139,308 @@ std::string Statistics::ToStringProj()
 
   return projections;
 }
+
+namespace ShaderCompileStats
+{
+namespace
+{
+// Enough for the shaders of a long session, the totals keep counting past it.
+constexpr size_t MAX_COMPILE_RECORDS = 65536;
+
+struct CompileRecord
+{
+  Stage stage;
+  u64 source_hash;
+  u64 microseconds;
+};
+
+constexpr std::array<const char*, static_cast<size_t>(Stage::Count)> STAGE_NAMES = {
+    {"vertex", "pixel", "geometry", "hull", "domain", "program"}};
+
+std::array<std::atomic<u64>, static_cast<size_t>(Stage::Count)> s_compiles;
+std::array<std::atomic<u64>, static_cast<size_t>(Stage::Count)> s_compile_us;
+std::atomic<u64> s_stalls;
+std::atomic<u64> s_stall_us;
+std::atomic<u64> s_uber_shader_draws;
+std::atomic<u64> s_disk_cache_hits;
+
+std::mutex s_records_lock;
+std::vector<CompileRecord> s_records;
+
+thread_local u64 s_thread_compiles = 0;
+
+double ToMilliseconds(u64 microseconds)
+{
+  return static_cast<double>(microseconds) / 1000.0;
+}
+}
+
+void Reset()
+{
+  for (size_t i = 0; i < s_compiles.size(); i++)
+  {
+    s_compiles[i] = 0;
+    s_compile_us[i] = 0;
+  }
+  s_stalls = 0;
+  s_stall_us = 0;
+  s_uber_shader_draws = 0;
+  s_disk_cache_hits = 0;
+  std::lock_guard<std::mutex> guard(s_records_lock);
+  s_records.clear();
+}
+
+void AddCompile(Stage stage, const char* source, size_t source_size, u64 microseconds)
+{
+  TRACE_COMPLETE("Shader", STAGE_NAMES[static_cast<size_t>(stage)], microseconds);
+  s_compiles[static_cast<size_t>(stage)].fetch_add(1, std::memory_order_relaxed);
+  s_compile_us[static_cast<size_t>(stage)].fetch_add(microseconds, std::memory_order_relaxed);
+  s_thread_compiles++;
+  const u64 source_hash =
+      GetMurmurHash3(reinterpret_cast<const u8*>(source), static_cast<u32>(source_size), 0);
+  std::lock_guard<std::mutex> guard(s_records_lock);
+  if (s_records.size() < MAX_COMPILE_RECORDS)
+    s_records.push_back({stage, source_hash, microseconds});
+}
+
+void AddStall(u64 microseconds)
+{
+  TRACE_COMPLETE("Shader", "Compile stall", microseconds);
+  s_stalls.fetch_add(1, std::memory_order_relaxed);
+  s_stall_us.fetch_add(microseconds, std::memory_order_relaxed);
+}
+
+void AddUberShaderDraw()
+{
+  s_uber_shader_draws.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AddDiskCacheHits(u32 count)
+{
+  s_disk_cache_hits.fetch_add(count, std::memory_order_relaxed);
+}
+
+std::string ToString()
+{
+  u64 compiles = 0;
+  u64 compile_us = 0;
+  for (size_t i = 0; i < s_compiles.size(); i++)
+  {
+    compiles += s_compiles[i];
+    compile_us += s_compile_us[i];
+  }
+  std::string str;
+  str += StringFromFormat("Shader compiles: %" PRIu64 " (%.1f ms)\n", compiles,
+                          ToMilliseconds(compile_us));
+  str += StringFromFormat("Shader stalls: %" PRIu64 " (%.1f ms)\n", s_stalls.load(),
+                          ToMilliseconds(s_stall_us));
+  str += StringFromFormat("Ubershader draws: %" PRIu64 "\n", s_uber_shader_draws.load());
+  str += StringFromFormat("Shader disk cache hits/misses: %" PRIu64 " / %" PRIu64 "\n",
+                          s_disk_cache_hits.load(), compiles);
+  return str;
+}
+
+void DumpCSV(const std::string& game_id, const std::string& backend)
+{
+  if (game_id.empty())
+    return;
+  const std::string directory = File::GetUserPath(D_DUMP_IDX) + "ShaderStats" DIR_SEP;
+  File::CreateFullPath(directory);
+  std::ofstream out;
+  File::OpenFStream(out, directory + game_id + "_" + backend + ".csv",
+                    std::ios_base::out | std::ios_base::trunc);
+  if (!out.is_open())
+    return;
+
+  // One row per total, then one per compile.
+  out << "kind,stage,source_hash,count,ms\n";
+  for (size_t i = 0; i < s_compiles.size(); i++)
+  {
+    if (s_compiles[i])
+    {
+      out << StringFromFormat("compiles,%s,,%" PRIu64 ",%.3f\n", STAGE_NAMES[i],
+                              s_compiles[i].load(), ToMilliseconds(s_compile_us[i]));
+    }
+  }
+  out << StringFromFormat("stalls,,,%" PRIu64 ",%.3f\n", s_stalls.load(),
+                          ToMilliseconds(s_stall_us));
+  out << StringFromFormat("ubershader_draws,,,%" PRIu64 ",\n", s_uber_shader_draws.load());
+  out << StringFromFormat("disk_cache_hits,,,%" PRIu64 ",\n", s_disk_cache_hits.load());
+  std::lock_guard<std::mutex> guard(s_records_lock);
+  for (const CompileRecord& record : s_records)
+  {
+    out << StringFromFormat("compile,%s,%016" PRIx64 ",1,%.3f\n",
+                            STAGE_NAMES[static_cast<size_t>(record.stage)], record.source_hash,
+                            ToMilliseconds(record.microseconds));
+  }
+}
+
+StallTimer::StallTimer(bool waiting)
+    : m_start(Common::Timer::GetTimeUs()), m_compiles(s_thread_compiles), m_waiting(waiting)
+{
+}
+
+StallTimer::~StallTimer()
+{
+  if (m_waiting || s_thread_compiles != m_compiles)
+    AddStall(Common::Timer::GetTimeUs() - m_start);
+}
+}
+
+namespace TextureCacheStats
+{
+namespace
+{
+// GX texture formats are 4 bits.
+constexpr size_t NUM_FORMATS = 16;
+
+constexpr std::array<const char*, static_cast<size_t>(Stage::Count)> STAGE_NAMES = {
+    {"hash", "hires_lookup", "decode", "scale", "upload"}};
+
+constexpr std::array<const char*, NUM_FORMATS> FORMAT_NAMES = {
+    {"I4", "I8", "IA4", "IA8", "RGB565", "RGB5A3", "RGBA8", "7", "C4", "C8", "C14X2", "B", "C", "D",
+     "CMPR", "F"}};
+
+struct Counters
+{
+  std::array<u64, static_cast<size_t>(Stage::Count)> stage_us;
+  std::array<u64, NUM_FORMATS> hits;
+  std::array<u64, NUM_FORMATS> misses;
+  u64 efb_copy_reuses;
+  u64 upload_bytes;
+};
+
+Counters s_frame;
+Counters s_last_frame;
+Counters s_session;
+u64 s_frames;
+
+double ToMilliseconds(u64 microseconds)
+{
+  return static_cast<double>(microseconds) / 1000.0;
+}
+
+bool IsEnabled()
+{
+  return g_ActiveConfig.bOverlayStats || g_ActiveConfig.bDumpTextureCacheStats;
+}
+}
+
+void Reset()
+{
+  s_frame = {};
+  s_last_frame = {};
+  s_session = {};
+  s_frames = 0;
+}
+
+void EndFrame()
+{
+  for (size_t i = 0; i < s_frame.stage_us.size(); i++)
+    s_session.stage_us[i] += s_frame.stage_us[i];
+  for (size_t i = 0; i < NUM_FORMATS; i++)
+  {
+    s_session.hits[i] += s_frame.hits[i];
+    s_session.misses[i] += s_frame.misses[i];
+  }
+  s_session.efb_copy_reuses += s_frame.efb_copy_reuses;
+  s_session.upload_bytes += s_frame.upload_bytes;
+  s_frames++;
+  s_last_frame = s_frame;
+  s_frame = {};
+}
+
+void AddLookup(u32 texformat, bool hit)
+{
+  (hit ? s_frame.hits : s_frame.misses)[texformat % NUM_FORMATS]++;
+}
+
+void AddEFBCopyReuse()
+{
+  s_frame.efb_copy_reuses++;
+}
+
+void AddUploadBytes(u64 bytes)
+{
+  s_frame.upload_bytes += bytes;
+}
+
+std::string ToString()
+{
+  const Counters& frame = s_last_frame;
+  std::string str;
+  str += StringFromFormat("Texture load: hash %.2f, hires %.2f, decode %.2f, scale %.2f, "
+                          "upload %.2f ms\n",
+                          ToMilliseconds(frame.stage_us[static_cast<size_t>(Stage::Hash)]),
+                          ToMilliseconds(frame.stage_us[static_cast<size_t>(Stage::HiresLookup)]),
+                          ToMilliseconds(frame.stage_us[static_cast<size_t>(Stage::Decode)]),
+                          ToMilliseconds(frame.stage_us[static_cast<size_t>(Stage::Scale)]),
+                          ToMilliseconds(frame.stage_us[static_cast<size_t>(Stage::Upload)]));
+  u64 hits = 0;
+  u64 misses = 0;
+  std::string formats;
+  for (size_t i = 0; i < NUM_FORMATS; i++)
+  {
+    hits += frame.hits[i];
+    misses += frame.misses[i];
+    if (frame.hits[i] || frame.misses[i])
+    {
+      formats += StringFromFormat(" %s %" PRIu64 "/%" PRIu64, FORMAT_NAMES[i], frame.hits[i],
+                                  frame.misses[i]);
+    }
+  }
+  str += StringFromFormat("Texture hits/misses: %" PRIu64 " / %" PRIu64
+                          ", EFB copies reused: %" PRIu64 "\n",
+                          hits, misses, frame.efb_copy_reuses);
+  if (!formats.empty())
+    str += "Texture hits/misses by format:" + formats + "\n";
+  str += StringFromFormat("Texture upload: %" PRIu64 " kB\n", frame.upload_bytes / 1024);
+  return str;
+}
+
+void DumpCSV(const std::string& game_id, const std::string& backend)
+{
+  if (game_id.empty() || !s_frames)
+    return;
+  const std::string directory = File::GetUserPath(D_DUMP_IDX) + "TextureCacheStats" DIR_SEP;
+  File::CreateFullPath(directory);
+  std::ofstream out;
+  File::OpenFStream(out, directory + game_id + "_" + backend + ".csv",
+                    std::ios_base::out | std::ios_base::trunc);
+  if (!out.is_open())
+    return;
+
+  // Totals of the session, with the average per frame.
+  out << "kind,name,total,per_frame\n";
+  for (size_t i = 0; i < s_session.stage_us.size(); i++)
+  {
+    const double ms = ToMilliseconds(s_session.stage_us[i]);
+    out << StringFromFormat("ms,%s,%.3f,%.3f\n", STAGE_NAMES[i], ms, ms / s_frames);
+  }
+  for (size_t i = 0; i < NUM_FORMATS; i++)
+  {
+    if (!s_session.hits[i] && !s_session.misses[i])
+      continue;
+    out << StringFromFormat("hits,%s,%" PRIu64 ",%.3f\n", FORMAT_NAMES[i], s_session.hits[i],
+                            static_cast<double>(s_session.hits[i]) / s_frames);
+    out << StringFromFormat("misses,%s,%" PRIu64 ",%.3f\n", FORMAT_NAMES[i], s_session.misses[i],
+                            static_cast<double>(s_session.misses[i]) / s_frames);
+  }
+  out << StringFromFormat("efb_copy_reuses,,%" PRIu64 ",%.3f\n", s_session.efb_copy_reuses,
+                          static_cast<double>(s_session.efb_copy_reuses) / s_frames);
+  out << StringFromFormat("upload_bytes,,%" PRIu64 ",%.1f\n", s_session.upload_bytes,
+                          static_cast<double>(s_session.upload_bytes) / s_frames);
+  out << StringFromFormat("frames,,%" PRIu64 ",\n", s_frames);
+}
+
+StageTimer::StageTimer(Stage stage)
+    : m_stage(stage), m_start(IsEnabled() ? Common::Timer::GetTimeUs() : 0)
+{
+}
+
+StageTimer::~StageTimer()
+{
+  if (m_start)
+    s_frame.stage_us[static_cast<size_t>(m_stage)] += Common::Timer::GetTimeUs() - m_start;
+}
+}
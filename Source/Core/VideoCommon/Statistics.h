@@ -6,6 +6,8 @@
 
 #include <string>
 
+#include "Common/CommonTypes.h"
+
 struct Statistics
 {
   int numDomainShadersCreated;
@@ -21,9 +23,17 @@ struct Statistics
 
   int numTexturesCreated;
   int numTexturesAlive;
+  // Texture memory in MB, and the budget for it, 0 when there is none.
+  int textureMemoryUsed;
+  int textureMemoryBudget;
 
   int numVertexLoaders;
 
+  // The distances the adaptive SyncGPU controller settled on, 0 when it's not running.
+  int syncGpuMaxDistance;
+  int syncGpuMinDistance;
+  float syncGpuStallPercent;
+
   float proj_0, proj_1, proj_2, proj_3, proj_4, proj_5;
   float gproj_0, gproj_1, gproj_2, gproj_3, gproj_4, gproj_5;
   float gproj_6, gproj_7, gproj_8, gproj_9, gproj_10, gproj_11, gproj_12, gproj_13, gproj_14, gproj_15;
@@ -75,6 +85,90 @@ struct Statistics
 
 extern Statistics stats;
 
+// Shader compile telemetry of the session. The compiler threads update it too, so unlike the
+// per frame statistics it is atomic and only resets when the emulation starts.
+namespace ShaderCompileStats
+{
+enum class Stage : u32
+{
+  Vertex,
+  Pixel,
+  Geometry,
+  Hull,
+  Domain,
+  // OpenGL programs and Vulkan pipelines, which compile all the stages together.
+  Program,
+  Count
+};
+
+void Reset();
+// source identifies the shader in the CSV, the same source always gets the same hash.
+void AddCompile(Stage stage, const char* source, size_t source_size, u64 microseconds);
+void AddStall(u64 microseconds);
+// Draws that used an ubershader because the specialized shader was still compiling.
+void AddUberShaderDraw();
+// Shaders read from the disk caches. Every shader that had to be compiled missed them.
+void AddDiskCacheHits(u32 count);
+
+std::string ToString();
+// Writes the totals and every compile to User/Dump/ShaderStats/<game id>_<backend>.csv.
+void DumpCSV(const std::string& game_id, const std::string& backend);
+
+// Times a draw waiting on its shaders. The wait counts as a stall when waiting is set, or when
+// the thread compiled a shader itself before the timer went away.
+class StallTimer
+{
+public:
+  explicit StallTimer(bool waiting = false);
+  ~StallTimer();
+
+private:
+  u64 m_start;
+  u64 m_compiles;
+  bool m_waiting;
+};
+}
+
+// Where TextureCacheBase::Load spends its time, with the lookups and uploads behind it. Only the
+// GPU thread updates it. The last frame is shown with the statistics, the session totals are
+// written out when emulation stops.
+namespace TextureCacheStats
+{
+enum class Stage : u32
+{
+  Hash,
+  HiresLookup,
+  Decode,
+  Scale,
+  Upload,
+  Count
+};
+
+void Reset();
+// Moves the frame to the session totals, the frame shown is the one that ended last.
+void EndFrame();
+// Texture lookups by GX texture format, a miss creates the texture.
+void AddLookup(u32 texformat, bool hit);
+void AddEFBCopyReuse();
+void AddUploadBytes(u64 bytes);
+
+std::string ToString();
+// Writes the session totals to User/Dump/TextureCacheStats/<game id>_<backend>.csv.
+void DumpCSV(const std::string& game_id, const std::string& backend);
+
+// Adds the time until it goes away to a stage, while the statistics are shown or dumped.
+class StageTimer
+{
+public:
+  explicit StageTimer(Stage stage);
+  ~StageTimer();
+
+private:
+  Stage m_stage;
+  u64 m_start;
+};
+}
+
 #define STATISTICS
 
 #ifdef STATISTICS
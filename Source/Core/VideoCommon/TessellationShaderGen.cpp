@@ -87,7 +87,12 @@ float CalcTessFactor(float3 Origin, float Diameter)
 {
   float distance = 1.0 - saturate(length(Origin) * )hlsl" I_TESSPARAMS R"hlsl(.x);
   distance = distance * distance;
-  return round(max(4.0,)hlsl" I_TESSPARAMS R"hlsl(.y * GetScreenSize(Origin,Diameter) * distance));
+  float size = GetScreenSize(Origin, Diameter);
+  float factor = )hlsl" I_TESSPARAMS R"hlsl(.y * size * distance;
+  // Don't split the edge into segments smaller than the error threshold in pixels,
+  // small and distant edges are left untessellated.
+  factor = min(factor, size * )hlsl" I_LODPARAMS R"hlsl(.x * )hlsl" I_LODPARAMS R"hlsl(.y);
+  return clamp(round(factor), 1.0, 64.0);
 }
 ConstantOutput TConstFunc(InputPatch<VS_OUTPUT, 3> patch)
 {
@@ -437,6 +442,7 @@ inline void GenerateTessellationShader(ShaderCode& out,
     out.Write("cbuffer TSBlock : register(b0) {\n");
   out.Write("\tfloat4 " I_TESSPARAMS ";\n"
             "\tint4 " I_CULLPARAMS ";\n"
+            "\tfloat4 " I_LODPARAMS ";\n"
             "};\n");
 
   if (ApiType == API_OPENGL)
@@ -506,16 +512,20 @@ inline void GenerateTessellationShader(ShaderCode& out,
       out.Write("result.clipDist = patch[id].clipDist;\n");
     out.Write("return result;\n}\n");
     out.Write("%s", s_hlsl_constant_header_str);
+    // The patch is culled when all its vertices are outside the same clip plane, the planes are
+    // widened to leave room for the displacement. Testing in clip space keeps vertices behind the
+    // camera from being mirrored into the frustum by the perspective divide.
     out.Write(" if (" I_CULLPARAMS ".y != 0) {\n"
-              "   float3 spos0 = patch[0].pos.xyz / patch[0].pos.w;\n"
-              "   float3 spos1 = patch[1].pos.xyz / patch[1].pos.w;\n"
-              "   float3 spos2 = patch[2].pos.xyz / patch[2].pos.w;\n"
-              "   float3 posmax = max(max(spos0, spos1), spos2);\n"
-              "   float3 posmin = min(min(spos0, spos1), spos2);\n"
-              "   if (\n"
-              "   (posmin.x > 1.5 || posmax.x < -1.5 || posmin.y > 1.5 || posmax.y < -1.5 || "
-              "posmin.z > 1.5 || posmax.z < -0.5)"
-              "   )\n"
+              "   float4 cpos0 = patch[0].pos;\n"
+              "   float4 cpos1 = patch[1].pos;\n"
+              "   float4 cpos2 = patch[2].pos;\n"
+              "   bool3 outmax = (cpos0.xyz > float3(1.5, 1.5, 1.5) * cpos0.www) &&\n"
+              "                  (cpos1.xyz > float3(1.5, 1.5, 1.5) * cpos1.www) &&\n"
+              "                  (cpos2.xyz > float3(1.5, 1.5, 1.5) * cpos2.www);\n"
+              "   bool3 outmin = (cpos0.xyz < float3(-1.5, -1.5, -0.5) * cpos0.www) &&\n"
+              "                  (cpos1.xyz < float3(-1.5, -1.5, -0.5) * cpos1.www) &&\n"
+              "                  (cpos2.xyz < float3(-1.5, -1.5, -0.5) * cpos2.www);\n"
+              "   if (any(outmax) || any(outmin))\n"
               "   {\n"
               "     result.EFactor[0] = 0;\n"
               "     result.EFactor[1] = 0;\n"
@@ -535,6 +545,26 @@ inline void GenerateTessellationShader(ShaderCode& out,
     {
       out.Write("     pos[i] = float4(patch[i].tex0.w, patch[i].tex1.w, patch[i].tex7.w, 1.0);\n");
     }
+    // Back facing patches are culled before the per vertex constants are built.
+    out.Write(
+        "   }\n"
+        "   float3 edge0 = pos[1].xyz - pos[0].xyz;\n"
+        "   float3 edge2 = pos[2].xyz - pos[0].xyz;\n"
+        "   float3 faceNormal = normalize(cross(edge2, edge0));\n"
+        "   if (" I_CULLPARAMS ".x != 0) {\n"
+        "     float3 view = normalize(-pos[0].xyz);\n"
+        "     float visibility = dot(view, faceNormal);\n"
+        "     bool notvisible = " I_CULLPARAMS
+        ".x < 0 ? (visibility < -0.25) : (visibility > 0.25);\n"
+        "     if (notvisible) {\n"
+        "       result.EFactor[0] = 0;\n"
+        "       result.EFactor[1] = 0;\n"
+        "       result.EFactor[2] = 0;\n"
+        "       result.InsideFactor = 0;\n"
+        "       return result; // culled, so no further processing\n"
+        "     }\n   }\n"
+        "   [unroll]\n"
+        "   for(int i = 0; i < 3; i++)\n{\n");
     for (u32 i = 0; i < texcount; ++i)
     {
       out.Write("     result.tex%d[i].xyz = patch[i].tex%d.xyz;\n", i, i);
@@ -566,24 +596,9 @@ inline void GenerateTessellationShader(ShaderCode& out,
     }
     out.Write(
         "   }\n"
-        "   float3 edge0 = pos[1].xyz - pos[0].xyz;\n"
-        "   float3 edge2 = pos[2].xyz - pos[0].xyz;\n"
-        "   float3 faceNormal = normalize(cross(edge2, edge0));\n"
         "   result.Normal[0] = float4(CorrectNormal(result.Normal[0].xyz, faceNormal), 0.0f);\n"
         "   result.Normal[1] = float4(CorrectNormal(result.Normal[1].xyz, faceNormal), 0.0f);\n"
         "   result.Normal[2] = float4(CorrectNormal(result.Normal[2].xyz, faceNormal), 0.0f);\n"
-        "   if (" I_CULLPARAMS ".x != 0) {\n"
-        "     float3 view = normalize(-pos[0].xyz);\n"
-        "     float visibility = dot(view, faceNormal);\n"
-        "     bool notvisible = " I_CULLPARAMS
-        ".x < 0 ? (visibility < -0.25) : (visibility > 0.25);\n"
-        "     if (notvisible) {\n"
-        "       result.EFactor[0] = 0;\n"
-        "       result.EFactor[1] = 0;\n"
-        "       result.EFactor[2] = 0;\n"
-        "       result.InsideFactor = 0;\n"
-        "       return result; // culled, so no further processing\n"
-        "     }\n   }\n"
         "   float l0 = distance(pos[1].xyz,pos[2].xyz);\n"
         "   float l1 = distance(pos[2].xyz,pos[0].xyz);\n"
         "   float l2 = distance(pos[0].xyz,pos[1].xyz);\n"
@@ -15,6 +15,9 @@
 #include "VideoCommon/VertexShaderManager.h"
 
 
+// Tessellated edges are not split into segments shorter than this, in target pixels.
+static constexpr float TESSELLATION_MIN_SEGMENT_PIXELS = 4.0f;
+
 alignas(256) TessellationShaderConstants TessellationShaderManager::constants;
 bool TessellationShaderManager::dirty;
 
@@ -63,6 +66,14 @@ void TessellationShaderManager::SetConstants()
       constants.cullparams[1] = earlycull;
       dirty = true;
     }
+    // GetScreenSize in the hull shader returns the size relative to half the viewport height.
+    float half_height = g_renderer->EFBToScaledYf(std::fabs(xfmem.viewport.ht));
+    if (constants.lodparams[0] != half_height)
+    {
+      constants.lodparams[0] = half_height;
+      constants.lodparams[1] = 1.0f / TESSELLATION_MIN_SEGMENT_PIXELS;
+      dirty = true;
+    }
   }
 }
 
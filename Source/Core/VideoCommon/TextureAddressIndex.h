@@ -0,0 +1,145 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Index of texture cache entries by the range of memory they cover. Entries starting at an
+// address are found with one hash lookup. For overlap queries, memory is split into buckets that
+// list every entry touching them, so a query only looks at the entries near its range instead of
+// every entry starting up to the largest texture size before it.
+template <typename Entry>
+class TextureAddressIndex
+{
+public:
+  // Entries that cover no memory are indexed as if they covered their first byte.
+  void Insert(Entry* entry, u32 address, u32 size)
+  {
+    const Range range{address, address + std::max<u32>(size, 1), m_next_sequence++};
+    m_ranges[entry] = range;
+    m_by_address[address].push_back(entry);
+    for (u32 bucket = FirstBucket(range); bucket <= LastBucket(range); bucket++)
+      m_buckets[bucket].push_back({entry, range});
+  }
+
+  bool Remove(Entry* entry)
+  {
+    auto iter = m_ranges.find(entry);
+    if (iter == m_ranges.end())
+      return false;
+    const Range range = iter->second;
+    m_ranges.erase(iter);
+
+    auto at_address = m_by_address.find(range.start);
+    EraseFirst(at_address->second, [entry](Entry* e) { return e == entry; });
+    if (at_address->second.empty())
+      m_by_address.erase(at_address);
+    for (u32 bucket = FirstBucket(range); bucket <= LastBucket(range); bucket++)
+    {
+      auto items = m_buckets.find(bucket);
+      EraseFirst(items->second, [entry](const Item& item) { return item.entry == entry; });
+      if (items->second.empty())
+        m_buckets.erase(items);
+    }
+    return true;
+  }
+
+  bool Contains(Entry* entry) const { return m_ranges.count(entry) != 0; }
+
+  // Appends the entries starting at the address, oldest first.
+  void FindAt(u32 address, std::vector<Entry*>* out) const
+  {
+    auto iter = m_by_address.find(address);
+    if (iter != m_by_address.end())
+      out->insert(out->end(), iter->second.begin(), iter->second.end());
+  }
+
+  // Appends the entries overlapping [address, address + size), by address and then oldest first.
+  void FindOverlapping(u32 address, u32 size, std::vector<Entry*>* out) const
+  {
+    const Range query{address, address + std::max<u32>(size, 1), 0};
+    const u32 first_bucket = FirstBucket(query);
+    m_found.clear();
+    for (u32 bucket = first_bucket; bucket <= LastBucket(query); bucket++)
+    {
+      auto items = m_buckets.find(bucket);
+      if (items == m_buckets.end())
+        continue;
+      for (const Item& item : items->second)
+      {
+        // An entry is in every bucket it touches, report it from the first one both share.
+        if (item.range.start < query.end && query.start < item.range.end &&
+            std::max(FirstBucket(item.range), first_bucket) == bucket)
+        {
+          m_found.push_back(item);
+        }
+      }
+    }
+    std::sort(m_found.begin(), m_found.end(), [](const Item& a, const Item& b) {
+      return a.range.start != b.range.start ? a.range.start < b.range.start :
+                                              a.range.sequence < b.range.sequence;
+    });
+    for (const Item& item : m_found)
+      out->push_back(item.entry);
+  }
+
+  // Appends every entry, in no particular order.
+  void FindAll(std::vector<Entry*>* out) const
+  {
+    out->reserve(out->size() + m_ranges.size());
+    for (const auto& range : m_ranges)
+      out->push_back(range.first);
+  }
+
+  size_t size() const { return m_ranges.size(); }
+  bool empty() const { return m_ranges.empty(); }
+
+  void clear()
+  {
+    m_ranges.clear();
+    m_by_address.clear();
+    m_buckets.clear();
+  }
+
+private:
+  // EFB copies span up to 1.3MB and textures up to 4MB, so an entry is in a handful of buckets.
+  static constexpr u32 BUCKET_SHIFT = 16;
+
+  struct Range
+  {
+    u32 start;
+    u32 end;
+    u64 sequence;
+  };
+
+  struct Item
+  {
+    Entry* entry;
+    Range range;
+  };
+
+  static u32 FirstBucket(const Range& range) { return range.start >> BUCKET_SHIFT; }
+  static u32 LastBucket(const Range& range) { return (range.end - 1) >> BUCKET_SHIFT; }
+
+  // Keeps the order of the remaining items.
+  template <typename T, typename Pred>
+  static void EraseFirst(std::vector<T>& items, Pred pred)
+  {
+    auto iter = std::find_if(items.begin(), items.end(), pred);
+    if (iter != items.end())
+      items.erase(iter);
+  }
+
+  std::unordered_map<Entry*, Range> m_ranges;
+  std::unordered_map<u32, std::vector<Entry*>> m_by_address;
+  std::unordered_map<u32, std::vector<Item>> m_buckets;
+  mutable std::vector<Item> m_found;
+  u64 m_next_sequence = 0;
+};
@@ -6,20 +6,26 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <xxhash.h>
 
 #include "Common/Align.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/FifoPlayer/FifoPlayer.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/WriteWatch.h"
 
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/FramebufferManagerBase.h"
+#include "VideoCommon/FrameProfilerBase.h"
 #include "VideoCommon/HiresTextures.h"
+#include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/SamplerCommon.h"
@@ -33,8 +39,34 @@
 
 static const u64 MAX_TEXTURE_BINARY_SIZE =
     1024 * 1024 * 4;  // 1024 x 1024 texel times 8 nibbles per texel
+// Bounds the memory of addresses that were textures once, like streamed movie frames.
+static const size_t MAX_WATCHED_HASHES = 4096;
+// Bounds the staging memory the backend holds for EFB copies that weren't read back.
+static const size_t MAX_DEFERRED_EFB_COPIES = 64;
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
+// The decode buffer is reused for the next level, so the job keeps a copy.
+static void AddScaleJobLevel(AsyncTextureScaler::Job* job, const u8* data, u32 width, u32 height,
+                             u32 expanded_width)
+{
+  const u32* pixels = reinterpret_cast<const u32*>(data);
+  AsyncTextureScaler::Level level;
+  level.data.assign(pixels, pixels + expanded_width * height);
+  level.width = width;
+  level.height = height;
+  level.expanded_width = expanded_width;
+  job->levels.push_back(std::move(level));
+}
+
+// Same for the scaler buffer, which the next level is scaled into.
+static void AddScaledLevel(std::vector<ScaledTextureCache::Level>* levels, const u8* data,
+                           u32 width, u32 height, u32 row_length)
+{
+  const u32* pixels = reinterpret_cast<const u32*>(data);
+  levels->push_back({std::vector<u32>(pixels, pixels + row_length * height), width, height,
+                     row_length});
+}
+
 TextureCacheBase::TCacheEntry::TCacheEntry(std::unique_ptr<HostTexture> tex, bool material,
                                            bool luma)
 {
@@ -54,7 +86,10 @@ void TextureCacheBase::CheckTempSize(size_t required_size)
   if (required_size <= temp_size)
     return;
 
-  temp_size = required_size;
+  // Grow to the next power of two, so that slowly growing sizes don't reallocate every time.
+  temp_size = 1;
+  while (temp_size < required_size)
+    temp_size <<= 1;
   Common::FreeAlignedMemory(temp);
   temp = static_cast<u8*>(Common::AllocateAlignedMemory(temp_size, 16));
 }
@@ -73,20 +108,53 @@ TextureCacheBase::TextureCacheBase()
   texture_pool_memory_usage = 0;
   InvalidateAllBindPoints();
   m_scaler = std::make_unique<TextureScaler>();
+  m_async_scaler = std::make_unique<AsyncTextureScaler>();
+  m_async_compressor = std::make_unique<AsyncTextureCompressor>();
+  m_texture_dumper = std::make_unique<AsyncTextureDumper>();
+  CreateScaledTextureCache(g_ActiveConfig);
+}
+
+void TextureCacheBase::CreateScaledTextureCache(const VideoConfig& config)
+{
+  m_scaled_texture_cache.reset();
+  scale_job_cache_keys.clear();
+  if (!config.bTexScalingCache)
+    return;
+
+  const bool compress =
+      config.bTexScalingCacheCompress && config.backend_info.bSupportedFormats[PC_TEX_FMT_DXT5];
+  m_scaled_texture_cache = std::make_unique<ScaledTextureCache>(
+      ScaledTextureCache::GetFilename(), static_cast<u64>(config.iTexScalingCacheSize) << 20,
+      compress);
 }
 
 void TextureCacheBase::Invalidate()
 {
   InvalidateAllBindPoints();
   bound_textures.fill(nullptr);
-  auto iter = textures_by_address.begin();
-  auto end = textures_by_address.end();
-  while (iter != end)
-  {
-    iter = InvalidateTexture(iter);
-  }
+  std::vector<TCacheEntry*> entries;
+  textures_by_address.FindAll(&entries);
+  for (TCacheEntry* entry : entries)
+    InvalidateTexture(entry);
   textures_by_address.clear();
   textures_by_hash.clear();
+  watched_hashes.clear();
+  m_async_scaler->Clear();
+  m_async_compressor->Clear();
+}
+
+void TextureCacheBase::InvalidateForStateLoad()
+{
+  InvalidateAllBindPoints();
+  bound_textures.fill(nullptr);
+  std::vector<TCacheEntry*> entries;
+  textures_by_address.FindAll(&entries);
+  // Picked before disposing of any, that drops the references of the textures left.
+  const auto kept = std::partition(entries.begin(), entries.end(), [](const TCacheEntry* entry) {
+    return entry->IsEfbCopy() || !entry->references.empty();
+  });
+  for (auto iter = entries.begin(); iter != kept; ++iter)
+    InvalidateTexture(*iter);
 }
 
 TextureCacheBase::~TextureCacheBase()
@@ -95,18 +163,24 @@ TextureCacheBase::~TextureCacheBase()
   Invalidate();
   texture_pool.clear();
   texture_pool_memory_usage = 0;
+  texture_pool_idle_memory = 0;
   if (TextureCacheBase::temp)
   {
     Common::FreeAlignedMemory(TextureCacheBase::temp);
     TextureCacheBase::temp = nullptr;
   }
   m_scaler.reset();
+  m_async_scaler.reset();
+  m_async_compressor.reset();
+  m_texture_dumper.reset();
+  m_scaled_texture_cache.reset();
 }
 
 void TextureCacheBase::OnConfigChanged(VideoConfig& config)
 {
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.bPackHiresTextures != backup_config.pack_hires_textures)
   {
     HiresTexture::Update();
   }
@@ -127,6 +201,16 @@ void TextureCacheBase::OnConfigChanged(VideoConfig& config)
                                         g_ActiveConfig.bTexFmtOverlayCenter);
   }
 
+  if (!config.bDeferEFBCopies)
+    FlushDeferredEFBCopies();
+
+  if (config.bTexScalingCache != backup_config.scaling_cache ||
+      config.bTexScalingCacheCompress != backup_config.scaling_cache_compress ||
+      config.iTexScalingCacheSize != backup_config.scaling_cache_size)
+  {
+    CreateScaledTextureCache(config);
+  }
+
   if ((config.iStereoMode > 0) != backup_config.stereo_3d ||
       config.bStereoEFBMonoDepth != backup_config.efb_mono_depth)
   {
@@ -145,64 +229,60 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.pack_hires_textures = config.bPackHiresTextures;
   backup_config.stereo_3d = config.iStereoMode > 0;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.scaling_factor = config.iTexScalingFactor;
   backup_config.scaling_mode = config.iTexScalingType;
   backup_config.scaling_deposterize = config.bTexDeposterize;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
+  backup_config.scaling_cache = config.bTexScalingCache;
+  backup_config.scaling_cache_compress = config.bTexScalingCacheCompress;
+  backup_config.scaling_cache_size = config.iTexScalingCacheSize;
 }
 
 void TextureCacheBase::Cleanup(s32 _frameCount)
 {
+  ApplyScaledTextures();
+  ApplyCompressedTextures();
+
   s32 texture_kill_threshold = TEXTURE_KILL_THRESHOLD;
   if (texture_pool_memory_usage < (TEXTURE_POOL_MEMORY_LIMIT / 2))
   {
     // if we are using less than the memory limit increase kill threshold
     texture_kill_threshold *= TEXTURE_KILL_MULTIPLIER;
   }
-  auto iter = textures_by_address.begin();
-  auto tcend = textures_by_address.end();
-  while (iter != tcend)
+  std::vector<TCacheEntry*> entries;
+  textures_by_address.FindAll(&entries);
+  for (TCacheEntry* entry : entries)
   {
-    if (iter->second->tmem_only)
-    {
-      iter = InvalidateTexture(iter);
-    }
-    else if (iter->second->frameCount == FRAMECOUNT_INVALID)
+    if (entry->tmem_only)
     {
-      iter->second->frameCount = _frameCount;
+      InvalidateTexture(entry);
+      continue;
     }
-    if (iter == tcend)
+    if (entry->frameCount == FRAMECOUNT_INVALID)
     {
-      break;
+      entry->frameCount = _frameCount;
     }
-    if (_frameCount > texture_kill_threshold + iter->second->frameCount)
+    if (_frameCount > texture_kill_threshold + entry->frameCount)
     {
-      if (iter->second->IsEfbCopy())
+      if (entry->IsEfbCopy())
       {
         // Only remove EFB copies when they wouldn't be used anymore(changed hash), because EFB
         // copies living on the host GPU are unrecoverable. Perform this check only every
         // TEXTURE_KILL_THRESHOLD for performance reasons
-        if ((_frameCount - iter->second->frameCount) % TEXTURE_KILL_THRESHOLD == 1 &&
-            iter->second->hash != iter->second->CalculateHash())
+        if ((_frameCount - entry->frameCount) % TEXTURE_KILL_THRESHOLD == 1 &&
+            entry->hash != entry->CalculateHash())
         {
-          iter = InvalidateTexture(iter);
-        }
-        else
-        {
-          ++iter;
+          InvalidateTexture(entry);
         }
       }
       else
       {
-        iter = InvalidateTexture(iter);
+        InvalidateTexture(entry);
       }
     }
-    else
-    {
-      ++iter;
-    }
   }
   auto env_iter = enviroment_cache.begin();
   auto env_end = enviroment_cache.end();
@@ -223,6 +303,10 @@ void TextureCacheBase::Cleanup(s32 _frameCount)
       ++env_iter;
     }
   }
+  // Pooled textures unused for a few frames are only released while the pool is over its budget,
+  // oldest first, so that games which create and drop the same EFB copy and render target sizes
+  // every few frames keep reusing them. Past TEXTURE_POOL_MAX_AGE they go regardless.
+  std::vector<TexPool::iterator> expired;
   TexPool::iterator iter2 = texture_pool.begin();
   TexPool::iterator tcend2 = texture_pool.end();
   while (iter2 != tcend2)
@@ -231,16 +315,80 @@ void TextureCacheBase::Cleanup(s32 _frameCount)
     {
       iter2->second.frameCount = _frameCount;
     }
+    if (_frameCount > TEXTURE_POOL_MAX_AGE + iter2->second.frameCount)
+    {
+      iter2 = ReleasePooledTexture(iter2);
+      continue;
+    }
     if (_frameCount > TEXTURE_POOL_KILL_THRESHOLD + iter2->second.frameCount)
+      expired.push_back(iter2);
+    ++iter2;
+  }
+  if (texture_pool_idle_memory > TEXTURE_POOL_IDLE_MEMORY_LIMIT)
+  {
+    std::sort(expired.begin(), expired.end(), [](const auto& a, const auto& b) {
+      return a->second.frameCount < b->second.frameCount;
+    });
+    for (size_t i = 0;
+         i < expired.size() && texture_pool_idle_memory > TEXTURE_POOL_IDLE_MEMORY_LIMIT; i++)
     {
-      texture_pool_memory_usage -= iter2->second.texture->GetConfig().GetSizeInBytes();
-      iter2 = texture_pool.erase(iter2);
+      ReleasePooledTexture(expired[i]);
     }
-    else
+  }
+
+  EnforceMemoryBudget(_frameCount);
+}
+
+void TextureCacheBase::EnforceMemoryBudget(s32 frame_count)
+{
+  const size_t budget = static_cast<size_t>(g_ActiveConfig.iTextureMemoryBudget) << 20;
+  // Scale textures again only once there's some room, so that it doesn't flip every frame.
+  if (memory_pressure && (!budget || texture_pool_memory_usage < budget / 4 * 3))
+    memory_pressure = false;
+
+  if (budget && texture_pool_memory_usage > budget)
+  {
+    if (!memory_pressure)
     {
-      ++iter2;
+      OSD::AddMessage(StringFromFormat("Texture memory over the %i MB budget, scaled textures drop "
+                                       "to native resolution",
+                                       g_ActiveConfig.iTextureMemoryBudget),
+                      5000);
     }
+    memory_pressure = true;
+
+    // Textures not used since the last frame go least recently used first, scaled ones before
+    // custom ones before native ones. Scaled textures come back at native resolution while there
+    // is pressure. EFB copies can't be recreated, so they stay.
+    std::vector<TCacheEntry*> entries;
+    textures_by_address.FindAll(&entries);
+    const auto rank = [](const TCacheEntry* entry) {
+      return entry->is_scaled ? 0 : entry->is_custom_tex ? 1 : 2;
+    };
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [frame_count](const TCacheEntry* entry) {
+                                   return entry->IsEfbCopy() || entry->tmem_only ||
+                                          entry->frameCount >= frame_count;
+                                 }),
+                  entries.end());
+    std::sort(entries.begin(), entries.end(),
+              [&rank](const TCacheEntry* a, const TCacheEntry* b) {
+                return std::make_pair(rank(a), a->frameCount) <
+                       std::make_pair(rank(b), b->frameCount);
+              });
+    // Evicted textures go to the pool, which is emptied after.
+    for (size_t i = 0;
+         i < entries.size() && texture_pool_memory_usage - texture_pool_idle_memory > budget; i++)
+    {
+      InvalidateTexture(entries[i]);
+    }
+    TexPool::iterator iter = texture_pool.begin();
+    while (iter != texture_pool.end() && texture_pool_memory_usage > budget)
+      iter = ReleasePooledTexture(iter);
   }
+
+  stats.textureMemoryUsed = static_cast<int>(texture_pool_memory_usage >> 20);
+  stats.textureMemoryBudget = g_ActiveConfig.iTextureMemoryBudget;
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -272,16 +420,135 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ApplyPaletteToEntry(TCacheEntry
     decoded_entry->frameCount = FRAMECOUNT_INVALID;
     decoded_entry->is_efb_copy = false;
     g_texture_cache->LoadLut(tlutfmt, &texMem[tlutaddr], palette_size);
-    auto iter = textures_by_address.emplace(entry->addr, decoded_entry);
+    textures_by_address.Insert(decoded_entry, decoded_entry->addr, decoded_entry->size_in_bytes);
     if (g_texture_cache->Palettize(decoded_entry, entry))
     {
       return decoded_entry;
     }
-    InvalidateTexture(iter);
+    InvalidateTexture(decoded_entry);
   }
   return nullptr;
 }
 
+void TextureCacheBase::ApplyScaledTextures()
+{
+  std::vector<std::unique_ptr<AsyncTextureScaler::Job>> finished;
+  m_async_scaler->TakeFinished(&finished);
+  for (const auto& job : finished)
+  {
+    // Entries disposed of or partially updated since don't want it anymore.
+    auto iter = scale_jobs.find(job->id);
+    if (iter == scale_jobs.end())
+      continue;
+    TCacheEntry* entry = iter->second;
+    scale_jobs.erase(iter);
+    entry->scale_job = 0;
+    ScaledTexturePack::Key cache_key;
+    auto key_iter = scale_job_cache_keys.find(job->id);
+    const bool store = key_iter != scale_job_cache_keys.end();
+    if (store)
+    {
+      cache_key = key_iter->second;
+      scale_job_cache_keys.erase(key_iter);
+    }
+
+    TextureConfig config = entry->GetConfig();
+    config.width *= job->factor;
+    config.height *= job->factor;
+    std::unique_ptr<HostTexture> texture = AllocateTexture(config);
+    if (!texture)
+      continue;
+    for (u32 level = 0; level < job->levels.size(); ++level)
+    {
+      const AsyncTextureScaler::Level& scaled = job->levels[level];
+      texture->Load(reinterpret_cast<const u8*>(scaled.data.data()), scaled.width * job->factor,
+                    scaled.height * job->factor, scaled.expanded_width * job->factor, level, 0);
+    }
+    entry->texture.swap(texture);
+    DisposeTexture(texture);
+    entry->is_scaled = true;
+    // The sampler states depend on the texture size.
+    InvalidateAllBindPoints();
+
+    if (store && m_scaled_texture_cache)
+    {
+      std::vector<ScaledTextureCache::Level> levels;
+      for (AsyncTextureScaler::Level& scaled : job->levels)
+      {
+        levels.push_back({std::move(scaled.data), static_cast<u32>(scaled.width * job->factor),
+                          static_cast<u32>(scaled.height * job->factor),
+                          static_cast<u32>(scaled.expanded_width * job->factor)});
+      }
+      m_scaled_texture_cache->Store(cache_key, std::move(levels));
+    }
+  }
+}
+
+void TextureCacheBase::CancelScaleJob(TCacheEntry* entry)
+{
+  if (entry->scale_job == 0)
+    return;
+  scale_jobs.erase(entry->scale_job);
+  scale_job_cache_keys.erase(entry->scale_job);
+  entry->scale_job = 0;
+}
+
+void TextureCacheBase::ApplyCompressedTextures()
+{
+  std::vector<std::unique_ptr<AsyncTextureCompressor::Job>> finished;
+  m_async_compressor->TakeFinished(&finished);
+  for (const auto& job : finished)
+  {
+    auto iter = compress_jobs.find(job->id);
+    if (iter == compress_jobs.end())
+    {
+      // The entry is gone, but the next one loading the texture still finds it compressed.
+      HiresTexture::StoreCompressed(job->name, job->width, job->height, job->levels,
+                                    job->data.data(), job->data.size());
+      continue;
+    }
+    TCacheEntry* entry = iter->second;
+    compress_jobs.erase(iter);
+    entry->compress_job = 0;
+
+    TextureConfig config = entry->GetConfig();
+    config.pcformat = PC_TEX_FMT_DXT5;
+    std::unique_ptr<HostTexture> texture = AllocateTexture(config);
+    if (!texture)
+      continue;
+    const u8* level_data = job->data.data();
+    for (u32 level = 0; level < job->levels; ++level)
+    {
+      const u32 width = TextureUtil::CalculateLevelSize(job->width, level);
+      const u32 height = TextureUtil::CalculateLevelSize(job->height, level);
+      texture->Load(level_data, width, height, width, level, 0);
+      level_data += TextureUtil::GetTextureSizeInBytes(width, height, PC_TEX_FMT_DXT5);
+    }
+    entry->texture.swap(texture);
+    DisposeTexture(texture);
+    InvalidateAllBindPoints();
+    HiresTexture::StoreCompressed(job->name, job->width, job->height, job->levels,
+                                  job->data.data(), job->data.size());
+  }
+}
+
+void TextureCacheBase::CancelCompressJob(TCacheEntry* entry)
+{
+  if (entry->compress_job == 0)
+    return;
+  compress_jobs.erase(entry->compress_job);
+  entry->compress_job = 0;
+}
+
+void TextureCacheBase::UploadLevel(HostTexture* texture, const u8* src, u32 width, u32 height,
+                                   u32 expanded_width, u32 level, u32 layer)
+{
+  TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Upload);
+  texture->Load(src, width, height, expanded_width, level, layer);
+  TextureCacheStats::AddUploadBytes(
+      TextureUtil::GetTextureSizeInBytes(expanded_width, height, texture->GetConfig().pcformat));
+}
+
 void TextureCacheBase::ScaleTextureCacheEntryTo(TextureCacheBase::TCacheEntry* entry, u32 new_width,
                                                 u32 new_height)
 {
@@ -311,10 +578,9 @@ void TextureCacheBase::ScaleTextureCacheEntryTo(TextureCacheBase::TCacheEntry* e
 
     entry->texture.swap(new_texture);
 
-    auto config = new_texture->GetConfig();
     // At this point new_texture has the old texture in it,
     // we can potentially reuse this, so let's move it back to the pool
-    texture_pool.emplace(config, TexPoolEntry(std::move(new_texture)));
+    DisposeTexture(new_texture);
   }
   else
   {
@@ -349,10 +615,13 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u32 tlut
 
   u32 numBlocksX = (entry_to_update->native_width + block_width - 1) / block_width;
 
-  auto iter = FindOverlappingTextures(entry_to_update->addr, entry_to_update->size_in_bytes);
-  while (iter.first != iter.second)
+  // ApplyPaletteToEntry adds entries while this runs, which are never EFB copies.
+  std::vector<TCacheEntry*>& overlapping = overlapping_entries;
+  overlapping.clear();
+  textures_by_address.FindOverlapping(entry_to_update->addr, entry_to_update->size_in_bytes,
+                                      &overlapping);
+  for (TCacheEntry* entry : overlapping)
   {
-    TCacheEntry* entry = iter.first->second;
     if (entry != entry_to_update && entry->IsEfbCopy() && !entry->tmem_only &&
         entry->references.count(entry_to_update) == 0 &&
         entry->OverlapsMemoryRange(entry_to_update->addr, entry_to_update->size_in_bytes) &&
@@ -374,7 +643,6 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u32 tlut
           }
           else
           {
-            ++iter.first;
             continue;
           }
         }
@@ -438,12 +706,15 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u32 tlut
         dstrect.right = (dst_x + copy_width);
         dstrect.bottom = (dst_y + copy_height);
         entry_to_update->texture->CopyRectangleFromTexture(entry->texture.get(), srcrect, dstrect);
+        // Scaling the texture from RAM again would drop the update.
+        CancelScaleJob(entry_to_update);
+        CancelCompressJob(entry_to_update);
 
         if (isPaletteTexture)
         {
           // Remove the temporary converted texture, it won't be used anywhere else
           // TODO: It would be nice to convert and copy in one step, but this code path isn't common
-          InvalidateTexture(GetTexCacheIter(entry));
+          InvalidateTexture(entry);
         }
         else
         {
@@ -456,33 +727,48 @@ TextureCacheBase::DoPartialTextureUpdates(TCacheEntry* entry_to_update, u32 tlut
       else
       {
         // If the hash does not match, this EFB copy will not be used for anything, so remove it
-        iter.first = InvalidateTexture(iter.first);
-        continue;
+        InvalidateTexture(entry);
       }
     }
-    ++iter.first;
   }
   return entry_to_update;
 }
 
-void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, u32 level)
+void TextureCacheBase::DumpTexture(TCacheEntry* entry, std::string basename, u32 level,
+                                   const u8* rgba, u32 row_length)
 {
   std::string szDir = File::GetUserPath(D_DUMPTEXTURES_IDX) + SConfig::GetInstance().GetGameID();
 
-  // make sure that the directory exists
-  if (!File::Exists(szDir) || !File::IsDirectory(szDir))
-    File::CreateDir(szDir);
-
   if (level > 0)
   {
     basename += StringFromFormat("_mip%i", level);
   }
 
-  std::string filename = szDir + "/" + basename +
-                         (TexDecoder::IsCompressed(entry->GetConfig().pcformat) ? ".dds" : ".png");
+  const bool compressed = TexDecoder::IsCompressed(entry->GetConfig().pcformat);
+  std::string filename = szDir + "/" + basename + (compressed ? ".dds" : ".png");
+
+  // Textures come back with the same hash all the time, each is only written once.
+  if (!m_texture_dumper->Claim(filename))
+    return;
 
-  if (!File::Exists(filename))
+  // make sure that the directory exists
+  if (!File::Exists(szDir) || !File::IsDirectory(szDir))
+    File::CreateDir(szDir);
+
+  if (File::Exists(filename))
+    return;
+  if (compressed || !rgba)
+  {
     entry->texture->Save(filename, level);
+    return;
+  }
+  auto job = std::make_unique<AsyncTextureDumper::Job>();
+  job->filename = std::move(filename);
+  job->width = TextureUtil::CalculateLevelSize(entry->native_width, level);
+  job->height = TextureUtil::CalculateLevelSize(entry->native_height, level);
+  job->row_stride = row_length * 4;
+  job->data.assign(rgba, rgba + job->row_stride * job->height);
+  m_texture_dumper->Queue(std::move(job));
 }
 
 // Used by TextureCacheBase::Load
@@ -611,6 +897,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     return ReturnEntry(stage, bound_textures[stage]);
   }
 
+  TRACE_SCOPE("GPU", "Texture load");
   const FourTexUnits& tex = bpmem.tex[stage >> 2];
   const u32 id = stage & 3;
   const u32 address = (tex.texImage3[id].image_base /* & 0x1FFFFF*/) << 5;
@@ -689,6 +976,8 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
         address);
     return nullptr;
   }
+  if (!from_tmem)
+    FlushDeferredEFBCopies(address, texture_size + additional_mips_size);
 
   // If we are recording a FifoLog, keep track of what memory we read.
   // FifiRecorder does it's own memory modification tracking independant of the texture hashing
@@ -697,19 +986,25 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
     FifoRecorder::GetInstance().UseMemory(address, texture_size + additional_mips_size,
                                           MemoryUpdate::TEXTURE_MAP);
 
-  // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
-  // from the low tmem bank than it should)
-  tex_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
   u32 palette_size = std::min(TexDecoder::GetPaletteSize(texformat), TMEM_SIZE - tlutaddr);
-  if (isPaletteTexture)
-  {
-    tlut_hash =
-        GetHash64(&texMem[tlutaddr], palette_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
-    full_hash = tex_hash ^ tlut_hash;
-  }
-  else
   {
-    full_hash = tex_hash;
+    TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Hash);
+    // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more
+    // data from the low tmem bank than it should)
+    if (from_tmem)
+      tex_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
+    else
+      tex_hash = HashTextureData(address, src_data, texture_size);
+    if (isPaletteTexture)
+    {
+      tlut_hash = GetHash64(&texMem[tlutaddr], palette_size,
+                            g_ActiveConfig.iSafeTextureCache_ColorSamples);
+      full_hash = tex_hash ^ tlut_hash;
+    }
+    else
+    {
+      full_hash = tex_hash;
+    }
   }
   // Search the texture cache for textures by address
   //
@@ -738,19 +1033,18 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   //
   // For efb copies, the entry created in CopyRenderTargetToTexture always has to be used, or else
   // it was done in vain.
-  auto iter_range = textures_by_address.equal_range(address);
-  TexAddrCache::iterator iter = iter_range.first;
-  TexAddrCache::iterator oldest_entry = iter;
+  std::vector<TCacheEntry*>& candidates = entries_at_address;
+  candidates.clear();
+  textures_by_address.FindAt(address, &candidates);
+  TCacheEntry* oldest_entry = nullptr;
   s32 temp_frameCount = 0x7fffffff;
-  TexAddrCache::iterator unconverted_copy = textures_by_address.end();
+  TCacheEntry* unconverted_copy = nullptr;
 
-  while (iter != iter_range.second)
+  for (TCacheEntry* entry : candidates)
   {
-    TCacheEntry* entry = iter->second;
     // Skip entries that are only left in our texture cache for the tmem cache emulation
     if (entry->tmem_only)
     {
-      ++iter;
       continue;
     }
     // Do not load strided EFB copies, they are not meant to be used directly
@@ -768,12 +1062,16 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
         // texture formats. I'm not sure what effect checking width/height/levels
         // would have.
         if (!isPaletteTexture)
+        {
+          TextureCacheStats::AddLookup(texformat, true);
+          TextureCacheStats::AddEFBCopyReuse();
           return ReturnEntry(stage, entry);
+        }
         // Note that we found an unconverted EFB copy, then continue. We'll
         // perform the conversion later. Currently, we only convert EFB copies to
         // palette textures; we could do other conversions if it proved to be
         // beneficial.
-        unconverted_copy = iter;
+        unconverted_copy = entry;
       }
       else
       {
@@ -781,7 +1079,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
         // never be useful again. It's theoretically possible for a game to do
         // something weird where the copy could become useful in the future, but in
         // practice it doesn't happen.
-        iter = InvalidateTexture(iter);
+        InvalidateTexture(entry);
         continue;
       }
     }
@@ -792,7 +1090,8 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
           entry->native_levels >= tex_levels && entry->native_width == nativeW &&
           entry->native_height == nativeH)
       {
-        entry = DoPartialTextureUpdates(iter->second, tlutaddr, tlutfmt, palette_size);
+        entry = DoPartialTextureUpdates(entry, tlutaddr, tlutfmt, palette_size);
+        TextureCacheStats::AddLookup(texformat, true);
         return ReturnEntry(stage, entry);
       }
     }
@@ -805,20 +1104,21 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
         !entry->IsEfbCopy() && !(isPaletteTexture && entry->base_hash == tex_hash))
     {
       temp_frameCount = entry->frameCount;
-      oldest_entry = iter;
+      oldest_entry = entry;
     }
-    ++iter;
   }
   std::string basename;
-  if (unconverted_copy != textures_by_address.end())
+  if (unconverted_copy)
   {
     g_texture_cache->LoadLut(tlutfmt, &texMem[tlutaddr], palette_size);
     // Perform palette decoding.
     TCacheEntry* decoded_entry =
-        ApplyPaletteToEntry(unconverted_copy->second, tlutaddr, tlutfmt, palette_size);
+        ApplyPaletteToEntry(unconverted_copy, tlutaddr, tlutfmt, palette_size);
 
     if (decoded_entry)
     {
+      TextureCacheStats::AddLookup(texformat, true);
+      TextureCacheStats::AddEFBCopyReuse();
       return ReturnEntry(stage, decoded_entry);
     }
   }
@@ -828,7 +1128,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   // If the texture was fully hashed, the address does not need to match. Identical duplicate
   // textures cause unnecessary slowdowns Example: Tales of Symphonia (GC) uses over 500 small
   // textures in menus, but only around 70 different ones
-  if (g_ActiveConfig.iSafeTextureCache_ColorSamples == 0 ||
+  if (!DoesHash64Sample() || g_ActiveConfig.iSafeTextureCache_ColorSamples == 0 ||
       std::max(texture_size, palette_size) <=
           (u32)g_ActiveConfig.iSafeTextureCache_ColorSamples * 8)
   {
@@ -842,6 +1142,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
           entry->native_width == nativeW && entry->native_height == nativeH)
       {
         entry = DoPartialTextureUpdates(hash_iter->second, tlutaddr, tlutfmt, palette_size);
+        TextureCacheStats::AddLookup(texformat, true);
         return ReturnEntry(stage, entry);
       }
       ++hash_iter;
@@ -856,18 +1157,38 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   }
 
   std::shared_ptr<HiresTexture> hires_tex;
-  if (g_ActiveConfig.bHiresTextures || g_ActiveConfig.bDumpTextures)
-  {
-    basename =
-        HiresTexture::GenBaseName(src_data, texture_size, &texMem[tlutaddr], palette_size, width,
-                                  height, texformat, use_mipmaps, g_ActiveConfig.bDumpTextures);
-  }
-  if (g_ActiveConfig.bHiresTextures)
+  // The name the custom texture was found under.
+  std::string hires_name;
   {
-    hires_tex = HiresTexture::Search(basename, [this](size_t required_size) {
+    TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::HiresLookup);
+    const auto request_buffer = [this](size_t required_size) {
       this->CheckTempSize(required_size);
       return this->temp;
-    });
+    };
+    // The newer names first, a pack made with them is unlikely to have older ones as well.
+    for (const HiresTexture::NameVersion version :
+         {HiresTexture::NameVersion::XXH3, HiresTexture::NameVersion::XXH64})
+    {
+      if (!g_ActiveConfig.bHiresTextures || hires_tex || !HiresTexture::HasNameVersion(version))
+        continue;
+      const std::string name =
+          HiresTexture::GenBaseName(src_data, texture_size, &texMem[tlutaddr], palette_size, width,
+                                    height, texformat, use_mipmaps, version);
+      hires_tex = HiresTexture::Search(name, request_buffer);
+      if (hires_tex)
+      {
+        hires_name = name;
+      }
+      else if (palette_size > 0)
+      {
+        hires_name =
+            HiresTexture::GenBaseName(src_data, texture_size, &texMem[tlutaddr], 0, width, height,
+                                      texformat, use_mipmaps, version);
+        hires_tex = HiresTexture::Search(hires_name, request_buffer);
+      }
+      if (hires_tex)
+        basename = name;
+    }
     if (hires_tex)
     {
       if (hires_tex->m_width != width || hires_tex->m_height != height)
@@ -879,26 +1200,16 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       expandedHeight = hires_tex->m_height;
       pcfmt = hires_tex->m_format;
     }
-    else if (palette_size > 0)
+    else
     {
-      std::string tempname =
-          HiresTexture::GenBaseName(src_data, texture_size, &texMem[tlutaddr], 0, width, height,
-                                    texformat, use_mipmaps, g_ActiveConfig.bDumpTextures);
-
-      hires_tex = HiresTexture::Search(tempname, [this](size_t required_size) {
-        this->CheckTempSize(required_size);
-        return this->temp;
-      });
-      if (hires_tex)
+      hires_name.clear();
+      if (g_ActiveConfig.bHiresTextures || g_ActiveConfig.bDumpTextures)
       {
-        if (hires_tex->m_width != width || hires_tex->m_height != height)
-        {
-          width = hires_tex->m_width;
-          height = hires_tex->m_height;
-        }
-        expandedWidth = hires_tex->m_width;
-        expandedHeight = hires_tex->m_height;
-        pcfmt = hires_tex->m_format;
+        basename = HiresTexture::GenBaseName(
+            src_data, texture_size, &texMem[tlutaddr], palette_size, width, height, texformat,
+            use_mipmaps,
+            static_cast<HiresTexture::NameVersion>(g_ActiveConfig.iHiresTextureNameVersion),
+            g_ActiveConfig.bDumpTextures);
       }
     }
   }
@@ -909,18 +1220,63 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
   if (pcfmt == PC_TEX_FMT_NONE)
   {
     pcfmt = g_texture_cache->GetHostTextureFormat(texformat, (TlutFormat)tlutfmt, width, height);
+    // The mips of textures from tmem aren't next to the base level, those aren't checked.
+    if (pcfmt == PC_TEX_FMT_DXT1 && texformat == GX_TF_CMPR &&
+        g_ActiveConfig.backend_info.bSupportedFormats[PC_TEX_FMT_DXT3] &&
+        (from_tmem ||
+         TexDecoder::CMPRHasTransparentTexels(src_data, texture_size + additional_mips_size)))
+    {
+      pcfmt = PC_TEX_FMT_DXT3;
+    }
+    // Dumped textures are written from the decoded data, which has to be RGBA for a PNG.
+    if (g_ActiveConfig.bDumpTextures && !TexDecoder::IsCompressed(pcfmt) &&
+        g_ActiveConfig.backend_info.bSupportedFormats[PC_TEX_FMT_RGBA32])
+    {
+      pcfmt = PC_TEX_FMT_RGBA32;
+    }
   }
   // how many levels the allocated texture shall have
   const u32 texLevels = hires_tex ? hires_tex->m_levels : tex_levels;
   const bool use_scaling =
-      (g_ActiveConfig.iTexScalingType > 0) && !hires_tex && (width < 384) && (height < 384);
+      (g_ActiveConfig.iTexScalingType > 0) && !hires_tex && (width < 384) && (height < 384) &&
+      !memory_pressure;
+  // Textures from RAM scaled in an earlier session come from the disk cache instead. The mips of
+  // textures from tmem don't follow the base level, so those aren't cached.
+  const bool cache_scaled =
+      use_scaling && m_scaled_texture_cache && !from_tmem && !g_ActiveConfig.bDumpTextures;
+  ScaledTexturePack::Key scaled_key = {};
+  ScaledTexturePack::Texture cached_scaled;
+  bool use_cached_scaled = false;
+  if (cache_scaled)
+  {
+    u64 data_hash = XXH64(src_data, texture_size + additional_mips_size, 0);
+    if (isPaletteTexture)
+      data_hash = XXH64(&texMem[tlutaddr], palette_size, data_hash);
+    scaled_key.hash = data_hash;
+    scaled_key.width = width;
+    scaled_key.height = height;
+    scaled_key.levels = texLevels;
+    scaled_key.format = full_format;
+    scaled_key.scaling_type = g_ActiveConfig.iTexScalingType;
+    scaled_key.scaling_factor = g_ActiveConfig.iTexScalingFactor;
+    scaled_key.deposterize = g_ActiveConfig.bTexDeposterize;
+    const ScaledTexturePack::TextureInfo& info = cached_scaled.info;
+    use_cached_scaled = m_scaled_texture_cache->Read(scaled_key, &cached_scaled) &&
+                        info.format < PC_TEX_NUM_FORMATS &&
+                        g_ActiveConfig.backend_info.bSupportedFormats[info.format] &&
+                        info.width == width * g_ActiveConfig.iTexScalingFactor &&
+                        info.height == height * g_ActiveConfig.iTexScalingFactor &&
+                        info.levels == texLevels;
+  }
   // We can decode on the GPU if it is a supported format and the flag is enabled.
   // Currently we don't decode RGBA8 textures from Tmem, as that would require copying from both
   // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
   // there's no conversion between formats. In the future this could be extended with a separate
-  // shader, however.
+  // shader, however. CMPR uploaded as BC1 or DXT3 is only reordered, which is cheaper than any
+  // decode.
   bool decode_on_gpu =
-      !hires_tex && !use_scaling && g_ActiveConfig.UseGPUTextureDecoding() &&
+      !hires_tex && !use_scaling && !TexDecoder::IsCompressed(pcfmt) &&
+      !g_ActiveConfig.bDumpTextures && g_ActiveConfig.UseGPUTextureDecoding() &&
       g_texture_cache->SupportsGPUTextureDecode(static_cast<TextureFormat>(texformat),
                                                 static_cast<TlutFormat>(tlutfmt)) &&
       !(from_tmem && texformat == GX_TF_RGBA8);
@@ -937,17 +1293,38 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       hires_tex && hires_tex->m_lum_levels && g_ActiveConfig.HiresMaterialMapsEnabled();
   config.layers += materialmap ? 1 : 0;
   config.layers += emissivematerial ? 1 : 0;
+  // Custom textures without mips of their own get a full chain generated on the GPU, if the game
+  // samples mips. Only color is filtered that way, so not with material maps.
+  const bool generate_mips = hires_tex && texLevels == 1 && tex_levels > 1 &&
+                             pcfmt == PC_TEX_FMT_RGBA32 && config.layers == 1 &&
+                             g_ActiveConfig.backend_info.bSupportsGPUMipmapGeneration;
+  if (generate_mips)
+    config.levels = IntLog2(std::max(width, height)) + 1;
+  // The scaling shaders don't deposterize, so that the result is the same as on the CPU.
+  const bool scale_on_gpu =
+      use_scaling && !use_cached_scaled && g_ActiveConfig.UseGPUTextureScaling() &&
+      !g_ActiveConfig.bTexDeposterize &&
+      g_texture_cache->SupportsGPUTextureScaling(g_ActiveConfig.iTexScalingType,
+                                                 g_ActiveConfig.iTexScalingFactor);
+  // Textures scaled in the background start out at native resolution.
+  const bool scale_async =
+      use_scaling && !use_cached_scaled && !scale_on_gpu && g_ActiveConfig.bTexScalingAsync;
   if (use_scaling)
   {
-    config.width *= g_ActiveConfig.iTexScalingFactor;
-    config.height *= g_ActiveConfig.iTexScalingFactor;
-    config.pcformat = PC_TEX_FMT_RGBA32;
+    if (!scale_async)
+    {
+      config.width *= g_ActiveConfig.iTexScalingFactor;
+      config.height *= g_ActiveConfig.iTexScalingFactor;
+    }
+    config.pcformat = use_cached_scaled ?
+                          static_cast<HostTextureFormat>(cached_scaled.info.format) :
+                          PC_TEX_FMT_RGBA32;
   }
   TCacheEntry* entry = AllocateCacheEntry(config, materialmap);
   GFX_DEBUGGER_PAUSE_AT(NEXT_NEW_TEXTURE, true);
 
-  iter = textures_by_address.emplace(address, entry);
-  if (g_ActiveConfig.iSafeTextureCache_ColorSamples == 0 ||
+  textures_by_address.Insert(entry, address, texture_size);
+  if (!DoesHash64Sample() || g_ActiveConfig.iSafeTextureCache_ColorSamples == 0 ||
       std::max(texture_size, palette_size) <=
           (u32)g_ActiveConfig.iSafeTextureCache_ColorSamples * 8)
   {
@@ -956,52 +1333,121 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
 
   entry->SetGeneralParameters(address, texture_size, full_format);
   entry->SetDimensions(nativeW, nativeH, tex_levels);
-  entry->SetHiresParams(!!hires_tex, basename, use_scaling, emissivematerial,
+  entry->SetHiresParams(!!hires_tex, basename, use_scaling && !scale_async, emissivematerial,
                         !!hires_tex && hires_tex->has_arbitrary_mips, false);
   entry->SetHashes(full_hash, tex_hash);
   entry->is_efb_copy = false;
 
+  std::unique_ptr<AsyncTextureScaler::Job> scale_job;
+  if (scale_async)
+  {
+    scale_job = std::make_unique<AsyncTextureScaler::Job>();
+    scale_job->id = next_scale_job++;
+    scale_job->factor = g_ActiveConfig.iTexScalingFactor;
+    scale_job->type = g_ActiveConfig.iTexScalingType;
+    scale_job->deposterize = g_ActiveConfig.bTexDeposterize;
+    if (cache_scaled)
+      scale_job_cache_keys.emplace(scale_job->id, scaled_key);
+  }
+  // The CPU scaled levels, for the disk cache.
+  std::vector<ScaledTextureCache::Level> scaled_levels;
+
   // load texture
   if (hires_tex)
   {
     int currentlayer = 0;
-    entry->texture->Load(TextureCacheBase::temp, width, height, expandedWidth, 0, currentlayer);
+    UploadLevel(entry->texture.get(), TextureCacheBase::temp, width, height, expandedWidth, 0,
+                currentlayer);
     u8* Bufferptr = TextureCacheBase::temp;
     Bufferptr += TextureUtil::GetTextureSizeInBytes(width, height, pcfmt);
     for (u32 level = 1; level != texLevels; ++level)
     {
       u32 mip_width = TextureUtil::CalculateLevelSize(width, level);
       u32 mip_height = TextureUtil::CalculateLevelSize(height, level);
-      entry->texture->Load(Bufferptr, mip_width, mip_height, mip_width, level, currentlayer);
+      UploadLevel(entry->texture.get(), Bufferptr, mip_width, mip_height, mip_width, level,
+                  currentlayer);
       Bufferptr += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, pcfmt);
     }
+    if (generate_mips && !entry->texture->GenerateMipmaps())
+    {
+      // Without the mips, the texture goes back to the single level it has.
+      TextureConfig base_config = config;
+      base_config.levels = 1;
+      std::unique_ptr<HostTexture> base_texture = AllocateTexture(base_config);
+      if (base_texture)
+      {
+        UploadLevel(base_texture.get(), TextureCacheBase::temp, width, height, expandedWidth, 0, 0);
+        entry->texture.swap(base_texture);
+        DisposeTexture(base_texture);
+      }
+    }
+    // Textures loaded from images are compressed in the background if asked to, packs already
+    // are. Only color levels that line up with the DXT5 blocks and aren't generated on the GPU.
+    if (g_ActiveConfig.bCompressHiresTextures && pcfmt == PC_TEX_FMT_RGBA32 &&
+        config.layers == 1 && !generate_mips && width % 4 == 0 && height % 4 == 0 &&
+        g_ActiveConfig.backend_info.bSupportedFormats[PC_TEX_FMT_DXT5])
+    {
+      auto job = std::make_unique<AsyncTextureCompressor::Job>();
+      job->id = next_compress_job++;
+      job->name = hires_name;
+      job->width = width;
+      job->height = height;
+      job->levels = texLevels;
+      job->data.assign(TextureCacheBase::temp, Bufferptr);
+      entry->compress_job = job->id;
+      compress_jobs.emplace(job->id, entry);
+      m_async_compressor->Queue(std::move(job));
+    }
     if (materialmap)
     {
       currentlayer++;
-      entry->texture->Load(Bufferptr, width, height, width, 0, currentlayer);
+      UploadLevel(entry->texture.get(), Bufferptr, width, height, width, 0, currentlayer);
       Bufferptr += TextureUtil::GetTextureSizeInBytes(width, height, pcfmt);
       for (u32 level = 1; level != texLevels; ++level)
       {
         u32 mip_width = TextureUtil::CalculateLevelSize(width, level);
         u32 mip_height = TextureUtil::CalculateLevelSize(height, level);
-        entry->texture->Load(Bufferptr, mip_width, mip_height, mip_width, level, currentlayer);
+        UploadLevel(entry->texture.get(), Bufferptr, mip_width, mip_height, mip_width, level,
+                    currentlayer);
         Bufferptr += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, pcfmt);
       }
     }
     if (emissivematerial)
     {
       currentlayer++;
-      entry->texture->Load(Bufferptr, width, height, width, 0, currentlayer);
+      UploadLevel(entry->texture.get(), Bufferptr, width, height, width, 0, currentlayer);
       Bufferptr += TextureUtil::GetTextureSizeInBytes(width, height, pcfmt);
       for (u32 level = 1; level != texLevels; ++level)
       {
         u32 mip_width = TextureUtil::CalculateLevelSize(width, level);
         u32 mip_height = TextureUtil::CalculateLevelSize(height, level);
-        entry->texture->Load(Bufferptr, mip_width, mip_height, mip_width, level, currentlayer);
+        UploadLevel(entry->texture.get(), Bufferptr, mip_width, mip_height, mip_width, level,
+                    currentlayer);
         Bufferptr += TextureUtil::GetTextureSizeInBytes(mip_width, mip_height, pcfmt);
       }
     }
   }
+  else if (use_cached_scaled)
+  {
+    // The levels are the scaled native ones, like when they were scaled.
+    const HostTextureFormat cached_format = config.pcformat;
+    const u8* level_data = cached_scaled.data.data();
+    const u8* data_end = level_data + cached_scaled.data.size();
+    for (u32 level = 0; level != texLevels; ++level)
+    {
+      const u32 level_width =
+          TextureUtil::CalculateLevelSize(width, level) * g_ActiveConfig.iTexScalingFactor;
+      const u32 level_height =
+          TextureUtil::CalculateLevelSize(height, level) * g_ActiveConfig.iTexScalingFactor;
+      const u32 level_size =
+          TextureUtil::GetTextureSizeInBytes(level_width, level_height, cached_format);
+      if (level_data + level_size > data_end)
+        break;
+      UploadLevel(entry->texture.get(), level_data, level_width, level_height, level_width, level,
+                  0);
+      level_data += level_size;
+    }
+  }
   else
   {
     const u8* ptr_even = NULL;
@@ -1015,6 +1461,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
 
     if (decode_on_gpu)
     {
+      TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Decode);
       u32 row_stride = bytes_per_block * (expandedWidth / bsw);
       decode_on_gpu = DecodeTextureOnGPU(entry->texture.get(), 0, src_data, texture_size,
                                          static_cast<TextureFormat>(texformat), width, height,
@@ -1028,31 +1475,51 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       u32 twidth = width;
       u32 theight = height;
       u32 texpandedWidth = expandedWidth;
-      if (texformat == GX_TF_RGBA8 && from_tmem)
       {
-        TexDecoder::DecodeRGBA8FromTmem(reinterpret_cast<u32*>(texturedata), src_data, ptr_odd,
-                                        expandedWidth, expandedHeight);
+        TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Decode);
+        if (texformat == GX_TF_RGBA8 && from_tmem)
+        {
+          TexDecoder::DecodeRGBA8FromTmem(reinterpret_cast<u32*>(texturedata), src_data, ptr_odd,
+                                          expandedWidth, expandedHeight);
+        }
+        else
+        {
+          TexDecoder::Decode(texturedata, src_data, expandedWidth, expandedHeight, texformat,
+                             tlutaddr, static_cast<TlutFormat>(tlutfmt),
+                             PC_TEX_FMT_RGBA32 == config.pcformat, config.pcformat);
+        }
       }
-      else
+      bool scaled_on_gpu = false;
+      if (scale_on_gpu)
+      {
+        TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Scale);
+        scaled_on_gpu =
+            ScaleTextureOnGPU(entry->texture.get(), 0, texturedata, width, height, expandedWidth,
+                              g_ActiveConfig.iTexScalingType, g_ActiveConfig.iTexScalingFactor);
+      }
+      if (scale_job)
       {
-        TexDecoder::Decode(texturedata, src_data, expandedWidth, expandedHeight, texformat,
-                           tlutaddr, static_cast<TlutFormat>(tlutfmt),
-                           PC_TEX_FMT_RGBA32 == config.pcformat,
-                           config.pcformat >= PC_TEX_FMT_DXT1);
+        AddScaleJobLevel(scale_job.get(), texturedata, width, height, expandedWidth);
       }
-      if (use_scaling)
+      else if (use_scaling && !scaled_on_gpu)
       {
+        TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Scale);
         texturedata =
             reinterpret_cast<u8*>(m_scaler->Scale((u32*)texturedata, expandedWidth, height));
         twidth *= g_ActiveConfig.iTexScalingFactor;
         theight *= g_ActiveConfig.iTexScalingFactor;
         texpandedWidth *= g_ActiveConfig.iTexScalingFactor;
+        if (cache_scaled)
+          AddScaledLevel(&scaled_levels, texturedata, twidth, theight, texpandedWidth);
       }
-      entry->texture->Load(texturedata, twidth, theight, texpandedWidth, 0, 0);
+      if (!scaled_on_gpu)
+        UploadLevel(entry->texture.get(), texturedata, twidth, theight, texpandedWidth, 0, 0);
     }
     if (g_ActiveConfig.bDumpTextures)
     {
-      DumpTexture(entry, basename, 0);
+      const bool decoded_rgba = !decode_on_gpu && config.pcformat == PC_TEX_FMT_RGBA32;
+      DumpTexture(entry, basename, 0, decoded_rgba ? TextureCacheBase::temp : nullptr,
+                  expandedWidth);
     }
     src_data += texture_size;
 
@@ -1067,6 +1534,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
       const u8*& mip_src_data = from_tmem ? ((level % 2) ? ptr_odd : ptr_even) : src_data;
       if (decode_on_gpu)
       {
+        TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Decode);
         u32 row_stride = bytes_per_block * (expanded_mip_width / bsw);
         decode_on_gpu = DecodeTextureOnGPU(
             entry->texture.get(), level, mip_src_data, mip_size,
@@ -1079,31 +1547,67 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::Load(const u32 stage)
         u32 twidth = mip_width;
         u32 theight = mip_height;
         u32 texpandedWidth = expanded_mip_width;
-        TexDecoder::Decode(texturedata, mip_src_data, expanded_mip_width, expanded_mip_height,
-                           texformat, tlutaddr, static_cast<TlutFormat>(tlutfmt),
-                           PC_TEX_FMT_RGBA32 == config.pcformat,
-                           config.pcformat >= PC_TEX_FMT_DXT1);
-        if (use_scaling)
         {
-          texturedata =
-              reinterpret_cast<u8*>(m_scaler->Scale((u32*)texturedata, expandedWidth, height));
+          TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Decode);
+          TexDecoder::Decode(texturedata, mip_src_data, expanded_mip_width, expanded_mip_height,
+                             texformat, tlutaddr, static_cast<TlutFormat>(tlutfmt),
+                             PC_TEX_FMT_RGBA32 == config.pcformat, config.pcformat);
+        }
+        bool scaled_on_gpu = false;
+        if (scale_on_gpu)
+        {
+          TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Scale);
+          scaled_on_gpu = ScaleTextureOnGPU(entry->texture.get(), level, texturedata, mip_width,
+                                            mip_height, expanded_mip_width,
+                                            g_ActiveConfig.iTexScalingType,
+                                            g_ActiveConfig.iTexScalingFactor);
+        }
+        if (scale_job)
+        {
+          AddScaleJobLevel(scale_job.get(), texturedata, mip_width, mip_height,
+                           expanded_mip_width);
+        }
+        else if (use_scaling && !scaled_on_gpu)
+        {
+          TextureCacheStats::StageTimer timer(TextureCacheStats::Stage::Scale);
+          texturedata = reinterpret_cast<u8*>(
+              m_scaler->Scale((u32*)texturedata, expanded_mip_width, mip_height));
           twidth *= g_ActiveConfig.iTexScalingFactor;
           theight *= g_ActiveConfig.iTexScalingFactor;
           texpandedWidth *= g_ActiveConfig.iTexScalingFactor;
+          if (cache_scaled)
+            AddScaledLevel(&scaled_levels, texturedata, twidth, theight, texpandedWidth);
         }
-        entry->texture->Load(texturedata, twidth, theight, texpandedWidth, level, 0);
+        if (!scaled_on_gpu)
+          UploadLevel(entry->texture.get(), texturedata, twidth, theight, texpandedWidth, level, 0);
       }
       mip_src_data +=
           TexDecoder::GetTextureSizeInBytes(expanded_mip_width, expanded_mip_height, texformat);
 
       if (g_ActiveConfig.bDumpTextures)
-        DumpTexture(entry, basename, level);
+      {
+        const bool decoded_rgba = !decode_on_gpu && config.pcformat == PC_TEX_FMT_RGBA32;
+        DumpTexture(entry, basename, level, decoded_rgba ? TextureCacheBase::temp : nullptr,
+                    expanded_mip_width);
+      }
     }
   }
 
+  // Levels scaled on the GPU or not decoded at all leave gaps, only whole textures are stored.
+  if (scaled_levels.size() == texLevels)
+    m_scaled_texture_cache->Store(scaled_key, std::move(scaled_levels));
+
+  if (scale_job)
+  {
+    entry->scale_job = scale_job->id;
+    scale_jobs.emplace(scale_job->id, entry);
+    m_async_scaler->Queue(std::move(scale_job));
+  }
+
   INCSTAT(stats.numTexturesCreated);
   SETSTAT(stats.numTexturesAlive, textures_by_address.size());
-  entry = DoPartialTextureUpdates(iter->second, tlutaddr, tlutfmt, palette_size);
+  TextureCacheStats::AddLookup(texformat, false);
+  entry = DoPartialTextureUpdates(entry, tlutaddr, tlutfmt, palette_size);
   return ReturnEntry(stage, entry);
 }
 
@@ -1111,6 +1615,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
                                                  bool is_depth_copy, const EFBRectangle& srcRect,
                                                  bool isIntensity, bool scaleByHalf)
 {
+  FramePassScope profile_pass(FramePass::EFBCopy);
+
   // Emulation methods:
   //
   // - EFB to RAM:
@@ -1460,14 +1966,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
   }
 
   // remove all texture cache entries at dstAddr
-  {
-    auto iter_range = textures_by_address.equal_range(dstAddr);
-    TexAddrCache::iterator iter = iter_range.first;
-    while (iter != iter_range.second)
-    {
-      iter = InvalidateTexture(iter);
-    }
-  }
+  entries_at_address.clear();
+  textures_by_address.FindAt(dstAddr, &entries_at_address);
+  for (TCacheEntry* entry : entries_at_address)
+    InvalidateTexture(entry);
 
   // Get the base (in memory) format of this efb copy.
   u32 baseFormat = TexDecoder::GetEfbCopyBaseFormat(dstFormat);
@@ -1509,23 +2011,43 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
       g_renderer->GetPostProcessor()->OnEFBCopy(&targetSource);
     }
   }
-  if (copy_to_ram)
+  const EFBCopyFormat format(srcFormat, static_cast<TextureFormat>(dstFormat));
+  u64 deferred_id = 0;
+  if (copy_to_ram && g_ActiveConfig.bDeferEFBCopies)
+  {
+    deferred_id = DeferEFBCopy(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride,
+                               is_depth_copy, srcRect, scaleByHalf);
+  }
+  if (deferred_id != 0)
   {
-    EFBCopyFormat format(srcFormat, static_cast<TextureFormat>(dstFormat));
-    CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, is_depth_copy, srcRect,
-            scaleByHalf);
+    // RAM is only written when the copy is read back, WriteWatch hears about it then.
+    deferred_efb_copies.push_back({deferred_id, dstAddr, covered_range});
+    if (deferred_efb_copies.size() >= MAX_DEFERRED_EFB_COPIES)
+      FlushDeferredEFBCopies();
   }
   else
   {
-    // Hack: Most games don't actually need the correct texture data in RAM
-    //       and we can just keep a copy in VRAM. We zero the memory so we
-    //       can check it hasn't changed before using our copy in VRAM.
-    u8* ptr = dst;
-    for (u32 i = 0; i < num_blocks_y; i++)
+    // Older copies to the same memory have to land first.
+    FlushDeferredEFBCopies(dstAddr, covered_range);
+    WriteWatch::BeginWrite(dstAddr, covered_range);
+    if (copy_to_ram)
+    {
+      CopyEFB(dst, format, tex_w, bytes_per_row, num_blocks_y, dstStride, is_depth_copy, srcRect,
+              scaleByHalf);
+    }
+    else
     {
-      memset(ptr, 0, bytes_per_row);
-      ptr += dstStride;
+      // Hack: Most games don't actually need the correct texture data in RAM
+      //       and we can just keep a copy in VRAM. We zero the memory so we
+      //       can check it hasn't changed before using our copy in VRAM.
+      u8* ptr = dst;
+      for (u32 i = 0; i < num_blocks_y; i++)
+      {
+        memset(ptr, 0, bytes_per_row);
+        ptr += dstStride;
+      }
     }
+    WriteWatch::Invalidate(dstAddr, covered_range);
   }
 
   if (g_bRecordFifoData)
@@ -1560,20 +2082,19 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
   // TODO: This also invalidates partial overlaps, which we currently don't have a better way
   //       of dealing with.
   bool invalidate_textures = dstStride == bytes_per_row || !copy_to_vram;
-  auto iter = FindOverlappingTextures(dstAddr, covered_range);
-  while (iter.first != iter.second)
+  overlapping_entries.clear();
+  textures_by_address.FindOverlapping(dstAddr, covered_range, &overlapping_entries);
+  for (TCacheEntry* entry : overlapping_entries)
   {
-    TCacheEntry* entry = iter.first->second;
     if (entry->OverlapsMemoryRange(dstAddr, covered_range))
     {
       if (invalidate_textures)
       {
-        iter.first = InvalidateTexture(iter.first);
+        InvalidateTexture(entry);
         continue;
       }
       entry->may_have_overlapping_textures = true;
     }
-    ++iter.first;
   }
 
   if (copy_to_vram)
@@ -1613,11 +2134,44 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
                              0);
       }
 
-      textures_by_address.emplace(dstAddr, entry);
+      textures_by_address.Insert(entry, dstAddr, entry->size_in_bytes);
     }
   }
 }
 
+void TextureCacheBase::FlushDeferredEFBCopies()
+{
+  if (!deferred_efb_copies.empty())
+    WriteDeferredEFBCopies(deferred_efb_copies.size());
+}
+
+void TextureCacheBase::FlushDeferredEFBCopies(u32 address, u32 size)
+{
+  if (deferred_efb_copies.empty())
+    return;
+
+  // Copies are read back in order, so everything up to the last overlapping one is written.
+  const auto last =
+      std::find_if(deferred_efb_copies.rbegin(), deferred_efb_copies.rend(),
+                   [address, size](const DeferredEFBCopy& copy) {
+                     return copy.address < address + size && address < copy.address + copy.size;
+                   });
+  if (last != deferred_efb_copies.rend())
+    WriteDeferredEFBCopies(deferred_efb_copies.rend() - last);
+}
+
+void TextureCacheBase::WriteDeferredEFBCopies(size_t count)
+{
+  FramePassScope profile_pass(FramePass::EFBCopy);
+  const auto end = deferred_efb_copies.begin() + count;
+  for (auto iter = deferred_efb_copies.begin(); iter != end; ++iter)
+    WriteWatch::BeginWrite(iter->address, iter->size);
+  ReadbackDeferredEFBCopies((end - 1)->id);
+  for (auto iter = deferred_efb_copies.begin(); iter != end; ++iter)
+    WriteWatch::Invalidate(iter->address, iter->size);
+  deferred_efb_copies.erase(deferred_efb_copies.begin(), end);
+}
+
 std::unique_ptr<HostTexture> TextureCacheBase::AllocateTexture(const TextureConfig& config)
 {
   TexPool::iterator iter = FindMatchingTextureFromPool(config);
@@ -1625,6 +2179,7 @@ std::unique_ptr<HostTexture> TextureCacheBase::AllocateTexture(const TextureConf
   if (iter != texture_pool.end())
   {
     entry = std::move(iter->second.texture);
+    texture_pool_idle_memory -= config.GetSizeInBytes();
     texture_pool.erase(iter);
   }
   else
@@ -1655,20 +2210,34 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::AllocateCacheEntry(const Textur
 
 void TextureCacheBase::DisposeTexture(std::unique_ptr<HostTexture>& texture)
 {
+  if (!texture)
+    return;
+
   auto config = texture->GetConfig();
+  texture_pool_idle_memory += config.GetSizeInBytes();
   texture_pool.emplace(config, TexPoolEntry(std::move(texture)));
 }
 
+TextureCacheBase::TexPool::iterator
+TextureCacheBase::ReleasePooledTexture(TexPool::iterator iter)
+{
+  const size_t size = iter->first.GetSizeInBytes();
+  texture_pool_memory_usage -= size;
+  texture_pool_idle_memory -= size;
+  return texture_pool.erase(iter);
+}
+
 void TextureCacheBase::DisposeCacheEntry(TCacheEntry* entry)
 {
+  CancelScaleJob(entry);
+  CancelCompressJob(entry);
   if (entry->textures_by_hash_iter != textures_by_hash.end())
   {
     textures_by_hash.erase(entry->textures_by_hash_iter);
     entry->textures_by_hash_iter = textures_by_hash.end();
   }
 
-  auto config = entry->texture->GetConfig();
-  texture_pool.emplace(config, TexPoolEntry(std::move(entry->texture)));
+  DisposeTexture(entry->texture);
   delete entry;
 }
 
@@ -1687,58 +2256,23 @@ TextureCacheBase::FindMatchingTextureFromPool(const TextureConfig& config)
   return matching_iter != range.second ? matching_iter : texture_pool.end();
 }
 
-TextureCacheBase::TexAddrCache::iterator
-TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
+void TextureCacheBase::InvalidateTexture(TCacheEntry* entry)
 {
-  auto iter_range = textures_by_address.equal_range(entry->addr);
-  TexAddrCache::iterator iter = iter_range.first;
-
-  while (iter != iter_range.second)
-  {
-    if (iter->second == entry)
-    {
-      return iter;
-    }
-    ++iter;
-  }
-  return textures_by_address.end();
-}
-
-TextureCacheBase::TexAddrCache::iterator
-TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter)
-{
-  if (iter == textures_by_address.end())
-    return textures_by_address.end();
+  if (!textures_by_address.Contains(entry))
+    return;
   for (size_t i = 0; i < bound_textures.size(); ++i)
   {
     // If the entry is currently bound and not invalidated, keep it, but mark it as invalidated.
     // This way it can still be used via tmem cache emulation, but nothing else.
     // Spyro: A Hero's Tail is known for using such overwritten textures.
-    if (bound_textures[i] == iter->second && IsValidBindPoint(static_cast<u32>(i)))
+    if (bound_textures[i] == entry && IsValidBindPoint(static_cast<u32>(i)))
     {
       bound_textures[i]->tmem_only = true;
-      return ++iter;
+      return;
     }
   }
-  DisposeCacheEntry(iter->second);
-  return textures_by_address.erase(iter);
-}
-
-std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
-TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
-{
-  // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
-  auto begin = textures_by_address.lower_bound(lower_addr);
-  auto end = textures_by_address.upper_bound(addr + size_in_bytes);
-
-  return std::make_pair(begin, end);
+  textures_by_address.Remove(entry);
+  DisposeCacheEntry(entry);
 }
 
 u32 TextureCacheBase::TCacheEntry::BytesPerRow() const
@@ -1775,6 +2309,37 @@ void TextureCacheBase::TCacheEntry::SetEfbCopy(u32 stride)
   size_in_bytes = memory_stride * NumBlocksY();
 }
 
+// Games bind the same textures every frame, and most of them never change. Their hash is kept
+// while nothing writes to the pages they are in, which WriteWatch tracks.
+u64 TextureCacheBase::HashTextureData(u32 address, const u8* data, u32 size)
+{
+  if (!g_ActiveConfig.bTrackTextureWrites)
+    return GetHash64(data, size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
+
+  auto iter = watched_hashes.find(address);
+  if (iter != watched_hashes.end() && iter->second.size == size &&
+      WriteWatch::IsUnchanged(address, size, iter->second.snapshot))
+  {
+    return iter->second.hash;
+  }
+
+  // The snapshot has to be taken first, writes that land while hashing change it.
+  u64 snapshot;
+  const bool watched = WriteWatch::Snapshot(address, size, &snapshot);
+  const u64 hash = GetHash64(data, size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
+  if (watched)
+  {
+    if (watched_hashes.size() >= MAX_WATCHED_HASHES)
+      watched_hashes.clear();
+    watched_hashes[address] = {size, snapshot, hash};
+  }
+  else if (iter != watched_hashes.end())
+  {
+    watched_hashes.erase(iter);
+  }
+  return hash;
+}
+
 u64 TextureCacheBase::TCacheEntry::CalculateHash() const
 {
   u8* ptr = Memory::GetPointer(addr);
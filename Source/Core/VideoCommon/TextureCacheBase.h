@@ -6,6 +6,7 @@
 
 #include <array>
 #include <bitset>
+#include <deque>
 #include <map>
 #include <memory>
 #include <tuple>
@@ -16,13 +17,18 @@
 #include "Common/CommonTypes.h"
 #include "Common/Thread.h"
 
+#include "VideoCommon/AsyncTextureCompressor.h"
+#include "VideoCommon/AsyncTextureDumper.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/HostTexture.h"
+#include "VideoCommon/ScaledTextureCache.h"
+#include "VideoCommon/TextureAddressIndex.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/VideoCommon.h"
 
 struct VideoConfig;
+class AsyncTextureScaler;
 class TextureScaler;
 
 enum TextureCacheParams
@@ -33,7 +39,9 @@ enum TextureCacheParams
   TEXTURE_KILL_MULTIPLIER = 2,
   TEXTURE_KILL_THRESHOLD = 120,
   TEXTURE_POOL_KILL_THRESHOLD = 3,
-  TEXTURE_POOL_MEMORY_LIMIT = 64 * 1024 * 1024
+  TEXTURE_POOL_MAX_AGE = 600,
+  TEXTURE_POOL_MEMORY_LIMIT = 64 * 1024 * 1024,
+  TEXTURE_POOL_IDLE_MEMORY_LIMIT = 32 * 1024 * 1024
 };
 
 class TextureCacheBase
@@ -63,6 +71,10 @@ public:
     bool emissive = false;
     bool may_have_overlapping_textures = true;
     bool tmem_only = false;  // indicates that this texture only exists in the tmem cache
+    // Id of the job scaling this texture in the background, 0 if there is none.
+    u64 scale_job = 0;
+    // Id of the job compressing this custom texture in the background, 0 if there is none.
+    u64 compress_job = 0;
 
     // Keep an iterator to the entry in textures_by_hash, so it does not need to be searched when
     // removing the cache entry
@@ -148,6 +160,11 @@ public:
   // frameCount is the current frame number.
   void Cleanup(s32 _frameCount);
   void Invalidate();
+  // Called after a savestate is loaded, instead of Invalidate. Textures decoded from RAM are only
+  // reused while the hash of their RAM matches, so they are kept and don't have to be decoded
+  // again when the state is close to the current one. EFB copies and the textures they were
+  // drawn into hold data the savestate doesn't have, those are dropped.
+  void InvalidateForStateLoad();
 
   virtual HostTextureFormat GetHostTextureFormat(const s32 texformat, const TlutFormat tlutfmt,
                                                  u32 width, u32 height) = 0;
@@ -170,6 +187,10 @@ public:
   void LoadEnviromentTexture(std::string basename);
   void CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32 dstStride, bool is_depth_copy,
                                  const EFBRectangle& srcRect, bool isIntensity, bool scaleByHalf);
+  // Writes the EFB copies whose readback was deferred to RAM. With a range, only the ones that
+  // overlap it and the copies made before them.
+  void FlushDeferredEFBCopies();
+  void FlushDeferredEFBCopies(u32 address, u32 size);
   u8* GetTemporalBuffer() { return temp; }
   // Returns true if the texture data and palette formats are supported by the GPU decoder.
   virtual bool SupportsGPUTextureDecode(TextureFormat format, TlutFormat palette_format)
@@ -187,6 +208,16 @@ public:
   {
     return false;
   }
+  // Returns true if the TextureScaler type and factor are supported by the GPU scaler.
+  virtual bool SupportsGPUTextureScaling(int type, int factor) { return false; }
+  // Scales decoded RGBA8 data to the level of dst, which is factor times the size.
+  // width, height are the size of the level in pixels.
+  // row_length is the number of pixels in a row of data, the CPU scaler's width.
+  virtual bool ScaleTextureOnGPU(HostTexture* dst, u32 dst_level, const u8* data, u32 width,
+                                 u32 height, u32 row_length, int type, int factor)
+  {
+    return false;
+  }
   std::unique_ptr<HostTexture> AllocateTexture(const TextureConfig& config);
   void DisposeTexture(std::unique_ptr<HostTexture>& texture);
 
@@ -200,6 +231,16 @@ protected:
 
 private:
   virtual std::unique_ptr<HostTexture> CreateTexture(const TextureConfig& config) = 0;
+  // Like CopyEFB, but keeps the encoded copy on the GPU until ReadbackDeferredEFBCopies. Returns
+  // the id of the copy, or 0 when the backend can't defer it and CopyEFB has to be used.
+  virtual u64 DeferEFBCopy(u8* dst, const EFBCopyFormat& format, u32 native_width,
+                           u32 bytes_per_row, u32 num_blocks_y, u32 memory_stride,
+                           bool is_depth_copy, const EFBRectangle& src_rect, bool scale_by_half)
+  {
+    return 0;
+  }
+  // Writes the deferred copies up to and including id to RAM, in the order they were made.
+  virtual void ReadbackDeferredEFBCopies(u64 id) {}
   virtual void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy,
                                    const EFBRectangle& src_rect, bool scale_by_half,
                                    unsigned int cbuf_id, const float* colmat, u32 width,
@@ -221,39 +262,81 @@ private:
     EnvCacheEntry(TCacheEntry* tex) : envtexture(tex) {}
   };
 
-  using TexAddrCache = std::multimap<u32, TCacheEntry*>;
+  using TexAddrCache = TextureAddressIndex<TCacheEntry>;
   using TexHashCache = std::multimap<u64, TCacheEntry*>;
   using EnviromentCache = std::unordered_map<std::string, EnvCacheEntry>;
   using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry, TextureConfig::Hasher>;
 
+  // Hash of the texture data at an address, valid while WriteWatch sees no write to its pages.
+  struct WatchedHash
+  {
+    u32 size;
+    u64 snapshot;
+    u64 hash;
+  };
+  using WatchedHashCache = std::unordered_map<u32, WatchedHash>;
+
+  // The RAM an EFB copy that is still on the GPU will be written to.
+  struct DeferredEFBCopy
+  {
+    u64 id;
+    u32 address;
+    u32 size;
+  };
+
   void SetBackupConfig(const VideoConfig& config);
+  // Opens the disk cache of scaled textures of the running game, if it is enabled.
+  void CreateScaledTextureCache(const VideoConfig& config);
+  // Swaps in the textures the async scaler finished.
+  void ApplyScaledTextures();
+  void CancelScaleJob(TCacheEntry* entry);
+  // Swaps in the custom textures the async compressor finished.
+  void ApplyCompressedTextures();
+  void CancelCompressJob(TCacheEntry* entry);
   void ScaleTextureCacheEntryTo(TCacheEntry* entry, u32 new_width, u32 new_height);
+  // Uploads a level, counting its time and size in the texture cache statistics.
+  void UploadLevel(HostTexture* texture, const u8* src, u32 width, u32 height, u32 expanded_width,
+                   u32 level, u32 layer);
   void CheckTempSize(size_t required_size);
+  // Writes the first count deferred EFB copies to RAM.
+  void WriteDeferredEFBCopies(size_t count);
 
   TCacheEntry* DoPartialTextureUpdates(TCacheEntry* entry_to_update, u32 tlutaddr, u32 tlutfmt,
                                        u32 palette_size);
   TCacheEntry* ApplyPaletteToEntry(TCacheEntry* entry, u32 tlutaddr, u32 tlutfmt, u32 palette_size);
-  void DumpTexture(TCacheEntry* entry, std::string basename, u32 level);
+  // Writes a level to the dump directory. Levels decoded to RGBA are written from rgba, a
+  // row_length texels wide image, in the background; the others are read back from the texture.
+  void DumpTexture(TCacheEntry* entry, std::string basename, u32 level, const u8* rgba,
+                   u32 row_length);
 
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config, bool materialmap = false,
                                   bool luma = false);
   void DisposeCacheEntry(TCacheEntry* texture);
 
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
-  TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
-  TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter);
+  // Frees a pooled texture, returns the iterator after it.
+  TexPool::iterator ReleasePooledTexture(TexPool::iterator iter);
+  // Evicts textures while the texture memory is over iTextureMemoryBudget.
+  void EnforceMemoryBudget(s32 frame_count);
+  void InvalidateTexture(TCacheEntry* entry);
   TCacheEntry* ReturnEntry(u32 stage, TCacheEntry* entry);
-
-  // Return all possible overlapping textures. As addr+size of the textures is not
-  // indexed, this may return false positives.
-  std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
-  FindOverlappingTextures(u32 addr, u32 size_in_bytes);
+  u64 HashTextureData(u32 address, const u8* data, u32 size);
 
   TexAddrCache textures_by_address;
   TexHashCache textures_by_hash;
+  WatchedHashCache watched_hashes;
+  // In the order they were made.
+  std::deque<DeferredEFBCopy> deferred_efb_copies;
+  // Scratch space for the lookups in textures_by_address.
+  std::vector<TCacheEntry*> entries_at_address;
+  std::vector<TCacheEntry*> overlapping_entries;
   EnviromentCache enviroment_cache;
   TexPool texture_pool;
   size_t texture_pool_memory_usage = {};
+  // Size of the textures waiting in texture_pool.
+  size_t texture_pool_idle_memory = {};
+  // Set while the texture memory is over budget, new textures aren't scaled then.
+  bool memory_pressure = false;
 
   // Backup configuration values
   struct BackupConfig
@@ -263,15 +346,31 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    bool pack_hires_textures;
     bool stereo_3d;
     bool efb_mono_depth;
     s32 scaling_mode;
     s32 scaling_factor;
     bool scaling_deposterize;
     bool gpu_texture_decoding;
+    bool scaling_cache;
+    bool scaling_cache_compress;
+    s32 scaling_cache_size;
   };
   BackupConfig backup_config = {};
   std::unique_ptr<TextureScaler> m_scaler;
+  std::unique_ptr<AsyncTextureScaler> m_async_scaler;
+  // Entries with a scaling job running, by job id.
+  std::unordered_map<u64, TCacheEntry*> scale_jobs;
+  // Disk cache keys of the jobs whose result goes to m_scaled_texture_cache.
+  std::unordered_map<u64, ScaledTexturePack::Key> scale_job_cache_keys;
+  std::unique_ptr<ScaledTextureCache> m_scaled_texture_cache;
+  u64 next_scale_job = 1;
+  std::unique_ptr<AsyncTextureCompressor> m_async_compressor;
+  // Entries with a compression job running, by job id.
+  std::unordered_map<u64, TCacheEntry*> compress_jobs;
+  u64 next_compress_job = 1;
+  std::unique_ptr<AsyncTextureDumper> m_texture_dumper;
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -1089,6 +1089,64 @@ static const std::map<TextureFormat, DecodingShaderInfo> s_decoding_shader_info{
         vec4 norm_color = GetPaletteColorNormalized(index);
         imageStore(output_image, ivec3(ivec2(coords), 0), norm_color);
       }
+      )" } },
+      { GX_TF_CMPR,
+      { BUFFER_FORMAT_R32G32_UINT, 0, 8, 8, false,
+    R"(
+      layout(local_size_x = 8, local_size_y = 8) in;
+
+      void main()
+      {
+        uvec2 coords = gl_GlobalInvocationID.xy;
+
+        // Tiled in 8x8 blocks made of four 4x4 DXT1 blocks, one buffer element each.
+        uint2 block = coords.xy / 8u;
+        uint2 sub_block = (coords.xy / 4u) % 2u;
+        uint buffer_pos = u_src_offset;
+        buffer_pos += block.y * u_src_row_stride;
+        buffer_pos += block.x * 4u;
+        buffer_pos += sub_block.y * 2u + sub_block.x;
+        uvec2 raw_data = texelFetch(s_input_buffer, int(buffer_pos)).xy;
+
+        uint c1 = Swap16(raw_data.x & 0xFFFFu);
+        uint c2 = Swap16(raw_data.x >> 16);
+        uvec3 color1 = uvec3(Convert5To8(bitfieldExtract(c1, 11, 5)),
+                             Convert6To8(bitfieldExtract(c1, 5, 6)),
+                             Convert5To8(bitfieldExtract(c1, 0, 5)));
+        uvec3 color2 = uvec3(Convert5To8(bitfieldExtract(c2, 11, 5)),
+                             Convert6To8(bitfieldExtract(c2, 5, 6)),
+                             Convert5To8(bitfieldExtract(c2, 0, 5)));
+
+        // One byte of indices per row, the leftmost texel in the top bits.
+        uint2 offset = coords.xy % 4u;
+        uint row = bitfieldExtract(raw_data.y, int(offset.y * 8u), 8);
+        uint index = bitfieldExtract(row, int(6u - offset.x * 2u), 2);
+
+        uvec4 color;
+        if (index == 0u)
+        {
+          color = uvec4(color1, 255u);
+        }
+        else if (index == 1u)
+        {
+          color = uvec4(color2, 255u);
+        }
+        else if (c1 > c2)
+        {
+          // The GameCube blends 3/8 of the way instead of 1/3. This wraps like the CPU decoder.
+          uvec3 delta = color2 - color1;
+          uvec3 tier = (delta >> 1u) - (delta >> 3u);
+          color = uvec4((index == 2u ? color1 + tier : color2 - tier) & 0xFFu, 255u);
+        }
+        else
+        {
+          // The average, or color 2 but transparent.
+          color = index == 2u ? uvec4((color1 + color2 + 1u) / 2u, 255u) : uvec4(color2, 0u);
+        }
+
+        vec4 norm_color = vec4(color) / 255.0;
+        imageStore(output_image, ivec3(ivec2(coords), 0), norm_color);
+      }
       )" } } };
 
 static const std::array<u32, BUFFER_FORMAT_COUNT> s_buffer_bytes_per_texel = { {
@@ -124,8 +124,12 @@ u32 GetBlockWidthInTexels(u32 format);
 u32 GetBlockHeightInTexels(u32 format);
 u32 GetPaletteSize(u32 fmt);
 u32 GetEfbCopyBaseFormat(u32 format);
-HostTextureFormat Decode(u8 *dst, const u8 *src, u32 width, u32 height, u32 texformat, u32 tlutaddr, TlutFormat tlutfmt, bool rgbaOnly = false, bool compressed_supported = false);
+// CMPR textures are decoded to compressed_format when it is PC_TEX_FMT_DXT1 or PC_TEX_FMT_DXT3.
+HostTextureFormat Decode(u8 *dst, const u8 *src, u32 width, u32 height, u32 texformat, u32 tlutaddr, TlutFormat tlutfmt, bool rgbaOnly = false, HostTextureFormat compressed_format = PC_TEX_FMT_NONE);
 HostTextureFormat GetHostTextureFormat(u32 texformat, TlutFormat tlutfmt, bool compressed_supported = false);
+// BC1 makes transparent texels black where the GameCube keeps their color, which darkens filtered
+// edges. CMPR textures with those go to the GPU as DXT3 instead.
+bool CMPRHasTransparentTexels(const u8 *src, u32 size);
 HostTextureFormat DecodeRGBA8FromTmem(u32* dst, const u8 *src_ar, const u8 *src_gb, u32 width, u32 height);
 HostTextureFormat DecodeBGRA8FromTmem(u32* dst, const u8 *src_ar, const u8 *src_gb, u32 width, u32 height);
 void DecodeTexel(u8 *dst, const u8 *src, u32 s, u32 t, u32 imageWidth, u32 texformat, const u16 *tlut, TlutFormat tlutfmt);
@@ -21,8 +21,11 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
+#include <functional>
 #include <xbrz.h>
 
 
@@ -32,6 +35,7 @@
 #include "Common/CommonFuncs.h"
 #include "Common/CPUDetect.h"
 #include "Common/Intrinsics.h"
+#include "Common/ThreadPool.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/TextureScalerCommon.h"
 
@@ -401,7 +405,7 @@ void scaleBicubicT(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
   int rc[4][4], gc[4][4], bc[4][4], ac[4][4];
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -483,11 +487,11 @@ void scaleBicubicT(u32* data, u32* out, int w, int h, int l, int u)
 
 // perform jinc scaling by factor f.
 template<int f, int T>
-void scaleJincT(u32* data, u32* out, int w, int h)
+void scaleJincT(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
   int rc[4][4], gc[4][4], bc[4][4], ac[4][4];
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -557,11 +561,11 @@ void scaleJincT(u32* data, u32* out, int w, int h)
 
 // perform DDT-Sharp scaling by factor f.
 template<int f>
-void scaleDDTSharpT(u32* data, u32* out, int w, int h)
+void scaleDDTSharpT(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, offset = -(f >> 1);
   int rc[4][4], gc[4][4], bc[4][4], ac[4][4];
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -652,11 +656,11 @@ void scaleDDTSharpT(u32* data, u32* out, int w, int h)
 
 // perform DDT scaling by factor f.
 template<int f>
-void scaleDDTT(u32* data, u32* out, int w, int h)
+void scaleDDTT(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, offset = -(f >> 1);
   int rc[2][2], gc[2][2], bc[2][2], ac[2][2];
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -742,11 +746,11 @@ void scaleDDTT(u32* data, u32* out, int w, int h)
 
 // perform 3-point scaling by factor f.
 template<int f>
-void scale3PointT(u32* data, u32* out, int w, int h)
+void scale3PointT(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, offset = -(f >> 1);
   int rc[2][2], gc[2][2], bc[2][2], ac[2][2];
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -804,11 +808,11 @@ void scale3PointT(u32* data, u32* out, int w, int h)
 
 // perform smoothstep scaling by factor f.
 template<int f>
-void scaleSmoothstepT(u32* data, u32* out, int w, int h)
+void scaleSmoothstepT(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
   int rc[2][2], gc[2][2], bc[2][2], ac[2][2];
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -865,10 +869,10 @@ void scaleSmoothstepT(u32* data, u32* out, int w, int h)
 
 // perform jinc scaling by factor f.
 template<int f, int T>
-void scaleJincTSSE41(u32* data, u32* out, int w, int h)
+void scaleJincTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -933,7 +937,7 @@ template<int f, int T>
 void scaleBicubicTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -981,10 +985,10 @@ void scaleBicubicTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 }
 
 template<int f>
-void scaleSmoothstepTSSE41(u32* data, u32* out, int w, int h)
+void scaleSmoothstepTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -1032,10 +1036,10 @@ void scaleSmoothstepTSSE41(u32* data, u32* out, int w, int h)
 }
 
 template<int f>
-void scale3PointTSSE41(u32* data, u32* out, int w, int h)
+void scale3PointTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, offset = -(f >> 1);
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -1083,10 +1087,10 @@ void scale3PointTSSE41(u32* data, u32* out, int w, int h)
 
 
 template<int f>
-void scaleDDTSharpTSSE41(u32* data, u32* out, int w, int h)
+void scaleDDTSharpTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, offset = -(f >> 1);
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -1158,10 +1162,10 @@ void scaleDDTSharpTSSE41(u32* data, u32* out, int w, int h)
 }
 
 template<int f>
-void scaleDDTTSSE41(u32* data, u32* out, int w, int h)
+void scaleDDTTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
   int outw = w * f, outh = h * f, offset = -(f >> 1);
-  for (int cy = 0; cy <= h; ++cy)
+  for (int cy = l; cy < u; ++cy)
   {
     for (int cx = 0; cx <= w; ++cx)
     {
@@ -1292,17 +1296,17 @@ void scaleBicubicMitchell(int factor, u32* data, u32* out, int w, int h, int l,
 }
 
 
-void scaleJinc(int factor, u32* data, u32* out, int w, int h)
+void scaleJinc(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
   if (cpu_info.bSSE4_1)
   {
     switch (factor)
     {
-    case 2: scaleJincTSSE41<2, 0>(data, out, w, h); break;
-    case 3: scaleJincTSSE41<3, 0>(data, out, w, h); break;
-    case 4: scaleJincTSSE41<4, 0>(data, out, w, h); break;
-    case 5: scaleJincTSSE41<5, 0>(data, out, w, h); break;
+    case 2: scaleJincTSSE41<2, 0>(data, out, w, h, l, u); break;
+    case 3: scaleJincTSSE41<3, 0>(data, out, w, h, l, u); break;
+    case 4: scaleJincTSSE41<4, 0>(data, out, w, h, l, u); break;
+    case 5: scaleJincTSSE41<5, 0>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
     }
   }
@@ -1311,10 +1315,10 @@ void scaleJinc(int factor, u32* data, u32* out, int w, int h)
 #endif
     switch (factor)
     {
-    case 2: scaleJincT<2, 0>(data, out, w, h); break;
-    case 3: scaleJincT<3, 0>(data, out, w, h); break;
-    case 4: scaleJincT<4, 0>(data, out, w, h); break;
-    case 5: scaleJincT<5, 0>(data, out, w, h); break;
+    case 2: scaleJincT<2, 0>(data, out, w, h, l, u); break;
+    case 3: scaleJincT<3, 0>(data, out, w, h, l, u); break;
+    case 4: scaleJincT<4, 0>(data, out, w, h, l, u); break;
+    case 5: scaleJincT<5, 0>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
     }
 #if _M_SSE >= 0x401
@@ -1322,17 +1326,17 @@ void scaleJinc(int factor, u32* data, u32* out, int w, int h)
 #endif
 }
 
-void scaleJincSharper(int factor, u32* data, u32* out, int w, int h)
+void scaleJincSharper(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
   if (cpu_info.bSSE4_1)
   {
     switch (factor)
     {
-    case 2: scaleJincTSSE41<2, 1>(data, out, w, h); break;
-    case 3: scaleJincTSSE41<3, 1>(data, out, w, h); break;
-    case 4: scaleJincTSSE41<4, 1>(data, out, w, h); break;
-    case 5: scaleJincTSSE41<5, 1>(data, out, w, h); break;
+    case 2: scaleJincTSSE41<2, 1>(data, out, w, h, l, u); break;
+    case 3: scaleJincTSSE41<3, 1>(data, out, w, h, l, u); break;
+    case 4: scaleJincTSSE41<4, 1>(data, out, w, h, l, u); break;
+    case 5: scaleJincTSSE41<5, 1>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
     }
   }
@@ -1341,10 +1345,10 @@ void scaleJincSharper(int factor, u32* data, u32* out, int w, int h)
 #endif
     switch (factor)
     {
-    case 2: scaleJincT<2, 1>(data, out, w, h); break;
-    case 3: scaleJincT<3, 1>(data, out, w, h); break;
-    case 4: scaleJincT<4, 1>(data, out, w, h); break;
-    case 5: scaleJincT<5, 1>(data, out, w, h); break;
+    case 2: scaleJincT<2, 1>(data, out, w, h, l, u); break;
+    case 3: scaleJincT<3, 1>(data, out, w, h, l, u); break;
+    case 4: scaleJincT<4, 1>(data, out, w, h, l, u); break;
+    case 5: scaleJincT<5, 1>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
     }
 #if _M_SSE >= 0x401
@@ -1353,17 +1357,17 @@ void scaleJincSharper(int factor, u32* data, u32* out, int w, int h)
 }
 
 
-void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h)
+void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
   if (cpu_info.bSSE4_1)
   {
     switch (factor)
     {
-    case 2: scaleSmoothstepTSSE41<2>(data, out, w, h); break;
-    case 3: scaleSmoothstepTSSE41<3>(data, out, w, h); break;
-    case 4: scaleSmoothstepTSSE41<4>(data, out, w, h); break;
-    case 5: scaleSmoothstepTSSE41<5>(data, out, w, h); break;
+    case 2: scaleSmoothstepTSSE41<2>(data, out, w, h, l, u); break;
+    case 3: scaleSmoothstepTSSE41<3>(data, out, w, h, l, u); break;
+    case 4: scaleSmoothstepTSSE41<4>(data, out, w, h, l, u); break;
+    case 5: scaleSmoothstepTSSE41<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "Smoothstep upsampling only implemented for factors 2 to 5");
     }
   }
@@ -1372,10 +1376,10 @@ void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h)
 #endif
     switch (factor)
     {
-    case 2: scaleSmoothstepT<2>(data, out, w, h); break;
-    case 3: scaleSmoothstepT<3>(data, out, w, h); break;
-    case 4: scaleSmoothstepT<4>(data, out, w, h); break;
-    case 5: scaleSmoothstepT<5>(data, out, w, h); break;
+    case 2: scaleSmoothstepT<2>(data, out, w, h, l, u); break;
+    case 3: scaleSmoothstepT<3>(data, out, w, h, l, u); break;
+    case 4: scaleSmoothstepT<4>(data, out, w, h, l, u); break;
+    case 5: scaleSmoothstepT<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "Smoothstep upsampling only implemented for factors 2 to 5");
     }
 #if _M_SSE >= 0x401
@@ -1384,17 +1388,17 @@ void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h)
 }
 
 
-void scale3Point(int factor, u32* data, u32* out, int w, int h)
+void scale3Point(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
   if (cpu_info.bSSE4_1)
   {
     switch (factor)
     {
-    case 2: scale3PointTSSE41<2>(data, out, w, h); break;
-    case 3: scale3PointTSSE41<3>(data, out, w, h); break;
-    case 4: scale3PointTSSE41<4>(data, out, w, h); break;
-    case 5: scale3PointTSSE41<5>(data, out, w, h); break;
+    case 2: scale3PointTSSE41<2>(data, out, w, h, l, u); break;
+    case 3: scale3PointTSSE41<3>(data, out, w, h, l, u); break;
+    case 4: scale3PointTSSE41<4>(data, out, w, h, l, u); break;
+    case 5: scale3PointTSSE41<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "3-Point upsampling only implemented for factors 2 to 5");
     }
   }
@@ -1403,10 +1407,10 @@ void scale3Point(int factor, u32* data, u32* out, int w, int h)
 #endif
     switch (factor)
     {
-    case 2: scale3PointT<2>(data, out, w, h); break;
-    case 3: scale3PointT<3>(data, out, w, h); break;
-    case 4: scale3PointT<4>(data, out, w, h); break;
-    case 5: scale3PointT<5>(data, out, w, h); break;
+    case 2: scale3PointT<2>(data, out, w, h, l, u); break;
+    case 3: scale3PointT<3>(data, out, w, h, l, u); break;
+    case 4: scale3PointT<4>(data, out, w, h, l, u); break;
+    case 5: scale3PointT<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "3-Point upsampling only implemented for factors 2 to 5");
     }
 #if _M_SSE >= 0x401
@@ -1414,17 +1418,17 @@ void scale3Point(int factor, u32* data, u32* out, int w, int h)
 #endif
 }
 
-void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h)
+void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
   if (cpu_info.bSSE4_1)
   {
     switch (factor)
     {
-    case 2: scaleDDTSharpTSSE41<2>(data, out, w, h); break;
-    case 3: scaleDDTSharpTSSE41<3>(data, out, w, h); break;
-    case 4: scaleDDTSharpTSSE41<4>(data, out, w, h); break;
-    case 5: scaleDDTSharpTSSE41<5>(data, out, w, h); break;
+    case 2: scaleDDTSharpTSSE41<2>(data, out, w, h, l, u); break;
+    case 3: scaleDDTSharpTSSE41<3>(data, out, w, h, l, u); break;
+    case 4: scaleDDTSharpTSSE41<4>(data, out, w, h, l, u); break;
+    case 5: scaleDDTSharpTSSE41<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "DDT-Sharp upsampling only implemented for factors 2 to 5");
     }
   }
@@ -1433,10 +1437,10 @@ void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h)
 #endif
     switch (factor)
     {
-    case 2: scaleDDTSharpT<2>(data, out, w, h); break;
-    case 3: scaleDDTSharpT<3>(data, out, w, h); break;
-    case 4: scaleDDTSharpT<4>(data, out, w, h); break;
-    case 5: scaleDDTSharpT<5>(data, out, w, h); break;
+    case 2: scaleDDTSharpT<2>(data, out, w, h, l, u); break;
+    case 3: scaleDDTSharpT<3>(data, out, w, h, l, u); break;
+    case 4: scaleDDTSharpT<4>(data, out, w, h, l, u); break;
+    case 5: scaleDDTSharpT<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "DDT-Sharp upsampling only implemented for factors 2 to 5");
     }
 #if _M_SSE >= 0x401
@@ -1444,17 +1448,17 @@ void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h)
 #endif
 }
 
-void scaleDDT(int factor, u32* data, u32* out, int w, int h)
+void scaleDDT(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
   if (cpu_info.bSSE4_1)
   {
     switch (factor)
     {
-    case 2: scaleDDTTSSE41<2>(data, out, w, h); break;
-    case 3: scaleDDTTSSE41<3>(data, out, w, h); break;
-    case 4: scaleDDTTSSE41<4>(data, out, w, h); break;
-    case 5: scaleDDTTSSE41<5>(data, out, w, h); break;
+    case 2: scaleDDTTSSE41<2>(data, out, w, h, l, u); break;
+    case 3: scaleDDTTSSE41<3>(data, out, w, h, l, u); break;
+    case 4: scaleDDTTSSE41<4>(data, out, w, h, l, u); break;
+    case 5: scaleDDTTSSE41<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "DDT upsampling only implemented for factors 2 to 5");
     }
   }
@@ -1463,10 +1467,10 @@ void scaleDDT(int factor, u32* data, u32* out, int w, int h)
 #endif
     switch (factor)
     {
-    case 2: scaleDDTT<2>(data, out, w, h); break;
-    case 3: scaleDDTT<3>(data, out, w, h); break;
-    case 4: scaleDDTT<4>(data, out, w, h); break;
-    case 5: scaleDDTT<5>(data, out, w, h); break;
+    case 2: scaleDDTT<2>(data, out, w, h, l, u); break;
+    case 3: scaleDDTT<3>(data, out, w, h, l, u); break;
+    case 4: scaleDDTT<4>(data, out, w, h, l, u); break;
+    case 5: scaleDDTT<5>(data, out, w, h, l, u); break;
     default: ERROR_LOG(VIDEO, "DDT upsampling only implemented for factors 2 to 5");
     }
 #if _M_SSE >= 0x401
@@ -1611,17 +1615,146 @@ void dbgPGM(int w, int h, u32* pixels, const char* prefix = "dbg")
 #endif
 }
 
+/////////////////////////////////////// Parallel Scaling
+
+namespace {
+// Scaling costs far more per pixel than decoding, so even a 64x64 block is worth a worker. A
+// range also scales the halo rows above and below it again, at 8 rows those are no more than
+// the rows it writes.
+constexpr int PARALLEL_RANGE_MIN_PIXELS = 64 * 64;
+constexpr int PARALLEL_RANGE_MIN_ROWS = 8;
+
+// Source rows the scalers read above and below the rows they write. Two for the 4x4 kernels of
+// xBRZ, bicubic and jinc, and two more the deposterize passes need to get those right.
+constexpr int SCALER_HALO = 2;
+constexpr int DEPOSTERIZE_HALO = 2;
+}
+
+// Runs func(range, l, u) over ranges of the rows [0, count) on the thread pool. The calling
+// thread scales ranges too and returns once they are all done.
+class TextureScaler::RowWorker final : public Common::IWorker
+{
+public:
+  RowWorker()
+  {
+    Common::ThreadPool::RegisterWorker(this);
+  }
+  ~RowWorker()
+  {
+    Common::ThreadPool::UnregisterWorker(this);
+  }
+
+  bool NextTask(size_t ID) override
+  {
+    return RunNextRange();
+  }
+
+  void Run(int count, int width, const std::function<void(int, int, int)>& func)
+  {
+    int num_ranges = std::min(count * width / PARALLEL_RANGE_MIN_PIXELS,
+                              count / PARALLEL_RANGE_MIN_ROWS);
+    num_ranges = std::min(num_ranges, static_cast<int>(Common::ThreadPool::GetThreadCount()) + 1);
+    num_ranges = std::min(num_ranges, MAX_RANGES);
+    if (num_ranges < 2)
+    {
+      func(0, 0, count);
+      return;
+    }
+
+    m_func = &func;
+    m_count = count;
+    m_range_size = (count + num_ranges - 1) / num_ranges;
+    m_pending.store(num_ranges, std::memory_order_relaxed);
+    // Same as ParallelVertexLoader, a worker late for the previous image can't claim a range of
+    // this one against a stale count.
+    m_claim.store(u64(num_ranges) << 32, std::memory_order_release);
+    for (int i = 1; i < num_ranges; i++)
+      Common::ThreadPool::NotifyWorkPending();
+
+    while (RunNextRange())
+    {
+    }
+    size_t loop_count = 0;
+    while (m_pending.load(std::memory_order_acquire) > 0)
+      Common::cYield(loop_count++);
+  }
+
+private:
+  bool RunNextRange()
+  {
+    const u64 claim = m_claim.fetch_add(1, std::memory_order_acquire);
+    const u32 index = static_cast<u32>(claim);
+    if (index >= static_cast<u32>(claim >> 32))
+      return false;
+
+    const int l = static_cast<int>(index) * m_range_size;
+    const int u = std::min(l + m_range_size, m_count);
+    if (l < u)
+      (*m_func)(static_cast<int>(index), l, u);
+    m_pending.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  const std::function<void(int, int, int)>* m_func = nullptr;
+  int m_count = 0;
+  int m_range_size = 0;
+  std::atomic<u32> m_pending{0};
+  // Number of ranges in the upper half, next range to claim in the lower half.
+  std::atomic<u64> m_claim{0};
+};
+
 /////////////////////////////////////// Texture Scaler
 
-TextureScaler::TextureScaler()
+static std::once_flag s_filter_weights_initialized;
+
+TextureScaler::TextureScaler() : m_row_worker(std::make_unique<RowWorker>())
 {
-  initFilterWeights();
+  std::call_once(s_filter_weights_initialized, initFilterWeights);
 }
 
 TextureScaler::~TextureScaler()
 {
 }
 
+std::vector<int> TextureScaler::GetFilterWeights(int type, int factor)
+{
+  std::call_once(s_filter_weights_initialized, initFilterWeights);
+  std::vector<int> weights;
+  if (factor < 2 || factor > 5)
+    return weights;
+  const int kernel_size = type == SMOOTHSTEP ? 2 : 4;
+  for (int y = 0; y < factor; ++y)
+  {
+    for (int x = 0; x < factor; ++x)
+    {
+      for (int sy = 0; sy < kernel_size; ++sy)
+      {
+        for (int sx = 0; sx < kernel_size; ++sx)
+        {
+          switch (type)
+          {
+          case BICUBIC:
+            weights.push_back(bicubicWeights[1][factor - 2][x][y][sx][sy]);
+            break;
+          case JINC:
+            weights.push_back(jincWeights[0][factor - 2][x][y][sx][sy]);
+            break;
+          case JINC_SHARPER:
+            weights.push_back(jincWeights[1][factor - 2][x][y][sx][sy]);
+            break;
+          case SMOOTHSTEP:
+            weights.push_back(smoothstepWeights[factor - 2][x][y][sx][sy]);
+            break;
+          default:
+            return {};
+          }
+        }
+      }
+    }
+  }
+  return weights;
+}
+
 bool TextureScaler::IsEmptyOrFlat(u32* data, int pixels)
 {
   u32 ref = data[0];
@@ -1633,6 +1766,12 @@ bool TextureScaler::IsEmptyOrFlat(u32* data, int pixels)
 }
 
 u32* TextureScaler::Scale(u32* data, int width, int height)
+{
+  return Scale(data, width, height, g_ActiveConfig.iTexScalingFactor,
+               g_ActiveConfig.iTexScalingType, g_ActiveConfig.bTexDeposterize);
+}
+
+u32* TextureScaler::Scale(u32* data, int width, int height, int factor, int type, bool deposterize)
 {
   // prevent processing empty or flat textures (this happens a lot in some games)
   // doesn't hurt the standard case, will be very quick for textures with actual texture
@@ -1644,55 +1783,50 @@ u32* TextureScaler::Scale(u32* data, int width, int height)
 #ifdef SCALING_MEASURE_TIME
   double t_start = real_time_now();
 #endif
-  int factor = g_ActiveConfig.iTexScalingFactor;
   //bufInput.resize(width*height); // used to store the input image image if it needs to be reformatted
   bufOutput.resize(width*height*factor*factor); // used to store the upscaled image
   u32 *inputBuf = data;
   u32 *outputBuf = bufOutput.data();
 
-  // deposterize
-  if (g_ActiveConfig.bTexDeposterize)
-  {
-    bufDeposter.resize(width*height);
-    DePosterize(inputBuf, bufDeposter.data(), width, height);
-    inputBuf = bufDeposter.data();
-  }
-
-  // scale 
-  switch (g_ActiveConfig.iTexScalingType)
+  switch (type)
   {
-  case XBRZ:
-    ScaleXBRZ(factor, inputBuf, outputBuf, width, height);
-    break;
   case HYBRID:
-    ScaleHybrid(factor, inputBuf, outputBuf, width, height);
-    break;
-  case BICUBIC:
-    ScaleBicubicMitchell(factor, inputBuf, outputBuf, width, height);
-    break;
   case HYBRID_BICUBIC:
-    ScaleHybrid(factor, inputBuf, outputBuf, width, height, true);
+    // The hybrid scalers make several passes over the whole image, so they get the deposterized
+    // image up front.
+    if (deposterize)
+    {
+      bufDeposter.resize(width*height);
+      DePosterize(inputBuf, bufDeposter.data(), width, height);
+      inputBuf = bufDeposter.data();
+    }
+    ScaleHybrid(factor, inputBuf, outputBuf, width, height, type == HYBRID_BICUBIC);
     break;
+  case XBRZ:
+  case BICUBIC:
   case JINC:
-    ScaleJinc(factor, inputBuf, outputBuf, width, height);
-    break;
   case JINC_SHARPER:
-    ScaleJincSharper(factor, inputBuf, outputBuf, width, height);
-    break;
   case SMOOTHSTEP:
-    ScaleSmoothstep(factor, inputBuf, outputBuf, width, height);
-    break;
   case THREE_POINT:
-    Scale3Point(factor, inputBuf, outputBuf, width, height);
-    break;
   case DDT:
-    ScaleDDT(factor, inputBuf, outputBuf, width, height);
-    break;
   case DDT_SHARP:
-    ScaleDDTSharp(factor, inputBuf, outputBuf, width, height);
+  {
+    // The others only read the source rows next to the ones they write, so each range
+    // deposterizes and scales its own rows in one go. xBRZ works on the source rows, the
+    // others on the h + 1 rows of pixel corners between them.
+    const int count = type == XBRZ ? height : height + 1;
+    m_row_worker->Run(count, width, [&](int range, int l, int u) {
+      const int first = std::max(l - SCALER_HALO, 0);
+      const int last = std::min(u + SCALER_HALO, height);
+      u32* window = deposterize ? DePosterizeRows(range, inputBuf, width, height, first, last) :
+                                  inputBuf + first * width;
+      ScaleRows(type, factor, window, outputBuf + first * factor * width * factor, width,
+                last - first, l - first, u - first);
+    });
     break;
+  }
   default:
-    ERROR_LOG(VIDEO, "Unknown scaling type: %d", g_ActiveConfig.iTexScalingType);
+    ERROR_LOG(VIDEO, "Unknown scaling type: %d", type);
   }
 #ifdef SCALING_MEASURE_TIME
   if (width*height > 64 * 64 * factor*factor)
@@ -1705,33 +1839,68 @@ u32* TextureScaler::Scale(u32* data, int width, int height)
   return outputBuf;
 }
 
+// A window of rows of an image scales like an image of its own, as long as it includes the rows
+// the scaler reads around [l, u). Past the edges of the window the scalers repeat its first and
+// last rows, which only matters where those are the edges of the image as well.
+void TextureScaler::ScaleRows(int type, int factor, u32* source, u32* dest, int width, int height, int l, int u)
+{
+  switch (type)
+  {
+  case XBRZ:
+  {
+    xbrz::ScalerCfg cfg;
+    xbrz::scale(factor, source, dest, width, height, xbrz::ColorFormat::ARGB, cfg, l, u);
+    break;
+  }
+  case BICUBIC:
+    scaleBicubicMitchell(factor, source, dest, width, height, l, u);
+    break;
+  case JINC:
+    scaleJinc(factor, source, dest, width, height, l, u);
+    break;
+  case JINC_SHARPER:
+    scaleJincSharper(factor, source, dest, width, height, l, u);
+    break;
+  case SMOOTHSTEP:
+    scaleSmoothstep(factor, source, dest, width, height, l, u);
+    break;
+  case THREE_POINT:
+    scale3Point(factor, source, dest, width, height, l, u);
+    break;
+  case DDT:
+    scaleDDT(factor, source, dest, width, height, l, u);
+    break;
+  case DDT_SHARP:
+    scaleDDTSharp(factor, source, dest, width, height, l, u);
+    break;
+  }
+}
+
 void TextureScaler::ScaleXBRZ(int factor, u32* source, u32* dest, int width, int height)
 {
   xbrz::ScalerCfg cfg;
-  //GlobalThreadPool::Loop(std::bind(&xbrz::scale, factor, source, dest, width, height, xbrz::ColorFormat::ARGB, cfg, placeholder::_1, placeholder::_2), 0, height);
-  xbrz::scale(factor, source, dest, width, height, xbrz::ColorFormat::ARGB, cfg, 0, height);
+  m_row_worker->Run(height, width, [&](int range, int l, int u) {
+    xbrz::scale(factor, source, dest, width, height, xbrz::ColorFormat::ARGB, cfg, l, u);
+  });
 }
 
 void TextureScaler::ScaleBilinear(int factor, u32* source, u32* dest, int width, int height)
 {
   bufTmp1.resize(width*height*factor);
   u32 *tmpBuf = bufTmp1.data();
-  //GlobalThreadPool::Loop(std::bind(&bilinearH, factor, source, tmpBuf, width, placeholder::_1, placeholder::_2), 0, height);
-  //GlobalThreadPool::Loop(std::bind(&bilinearV, factor, tmpBuf, dest, width, 0, height, placeholder::_1, placeholder::_2), 0, height);
-  bilinearH(factor, source, tmpBuf, width, 0, height);
-  bilinearV(factor, tmpBuf, dest, width, 0, height, 0, height);
+  m_row_worker->Run(height, width, [&](int range, int l, int u) {
+    bilinearH(factor, source, tmpBuf, width, l, u);
+  });
+  m_row_worker->Run(height, width * factor, [&](int range, int l, int u) {
+    bilinearV(factor, tmpBuf, dest, width, 0, height, l, u);
+  });
 }
 
 void TextureScaler::ScaleBicubicBSpline(int factor, u32* source, u32* dest, int width, int height)
 {
-  //GlobalThreadPool::Loop(std::bind(&scaleBicubicBSpline, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-  scaleBicubicBSpline(factor, source, dest, width, height, 0, height);
-}
-
-void TextureScaler::ScaleBicubicMitchell(int factor, u32* source, u32* dest, int width, int height)
-{
-  //GlobalThreadPool::Loop(std::bind(&scaleBicubicMitchell, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-  scaleBicubicMitchell(factor, source, dest, width, height, 0, height);
+  m_row_worker->Run(height + 1, width, [&](int range, int l, int u) {
+    scaleBicubicBSpline(factor, source, dest, width, height, l, u);
+  });
 }
 
 void TextureScaler::ScaleHybrid(int factor, u32* source, u32* dest, int width, int height, bool bicubic)
@@ -1748,10 +1917,12 @@ void TextureScaler::ScaleHybrid(int factor, u32* source, u32* dest, int width, i
   bufTmp1.resize(width*height);
   bufTmp2.resize(width*height*factor*factor);
   bufTmp3.resize(width*height*factor*factor);
-  //GlobalThreadPool::Loop(std::bind(&generateDistanceMask, source, bufTmp1.data(), width, height, placeholder::_1, placeholder::_2), 0, height);
-  //GlobalThreadPool::Loop(std::bind(&convolve3x3, bufTmp1.data(), bufTmp2.data(), KERNEL_SPLAT, width, height, placeholder::_1, placeholder::_2), 0, height);
-  generateDistanceMask(source, bufTmp1.data(), width, height, 0, height);
-  convolve3x3(bufTmp1.data(), bufTmp2.data(), KERNEL_SPLAT, width, height, 0, height);
+  m_row_worker->Run(height, width, [&](int range, int l, int u) {
+    generateDistanceMask(source, bufTmp1.data(), width, height, l, u);
+  });
+  m_row_worker->Run(height, width, [&](int range, int l, int u) {
+    convolve3x3(bufTmp1.data(), bufTmp2.data(), KERNEL_SPLAT, width, height, l, u);
+  });
 
   ScaleBilinear(factor, bufTmp2.data(), bufTmp3.data(), width, height);
   // mask C is now in bufTmp3
@@ -1765,55 +1936,115 @@ void TextureScaler::ScaleHybrid(int factor, u32* source, u32* dest, int width, i
 
   // Now we can mix it all together
   // The factor 8192 was found through practical testing on a variety of textures
-  //GlobalThreadPool::Loop(std::bind(&mix, dest, bufTmp2.data(), bufTmp3.data(), 8192, width*factor, placeholder::_1, placeholder::_2), 0, height*factor);
-  mix(dest, bufTmp2.data(), bufTmp3.data(), 8192, width*factor, 0, height*factor);
+  m_row_worker->Run(height * factor, width * factor, [&](int range, int l, int u) {
+    mix(dest, bufTmp2.data(), bufTmp3.data(), 8192, width*factor, l, u);
+  });
 }
 
-void TextureScaler::ScaleJinc(int factor, u32* source, u32* dest, int width, int height)
+void TextureScaler::DePosterize(u32* source, u32* dest, int width, int height)
 {
-  //GlobalThreadPool::Loop(std::bind(&scaleJinc, factor, source, dest, width, height), 0, height);
-  scaleJinc(factor, source, dest, width, height);
+  m_row_worker->Run(height, width, [&](int range, int l, int u) {
+    memcpy(dest + l * width, DePosterizeRows(range, source, width, height, l, u),
+           (u - l) * width * sizeof(u32));
+  });
 }
 
-void TextureScaler::ScaleJincSharper(int factor, u32* source, u32* dest, int width, int height)
+// Deposterizes the rows [first, last) of the image into the buffers of the range and returns
+// them. The passes run on a window with DEPOSTERIZE_HALO more rows on each side, since they
+// leave the first and last rows of the window as they are and the next passes spread that.
+u32* TextureScaler::DePosterizeRows(int range, u32* source, int width, int height, int first, int last)
 {
-  //GlobalThreadPool::Loop(std::bind(&scaleJincSharper, factor, source, dest, width, height), 0, height);
-  scaleJincSharper(factor, source, dest, width, height);
+  const int window_first = std::max(first - DEPOSTERIZE_HALO, 0);
+  const int window_height = std::min(last + DEPOSTERIZE_HALO, height) - window_first;
+  u32* window = source + window_first * width;
+  bufRangeDeposter[range].resize(window_height*width);
+  bufRangeTmp[range].resize(window_height*width);
+  u32* out = bufRangeDeposter[range].data();
+  u32* tmp = bufRangeTmp[range].data();
+  deposterizeH(window, tmp, width, 0, window_height);
+  deposterizeV(tmp, out, width, window_height, 0, window_height);
+  deposterizeH(out, tmp, width, 0, window_height);
+  deposterizeV(tmp, out, width, window_height, 0, window_height);
+  return out + (first - window_first) * width;
 }
 
-void TextureScaler::ScaleSmoothstep(int factor, u32* source, u32* dest, int width, int height)
+/////////////////////////////////////// Async Texture Scaler
+
+AsyncTextureScaler::AsyncTextureScaler()
 {
-  //GlobalThreadPool::Loop(std::bind(&scaleSmoothstep, factor, source, dest, width, height), 0, height);
-  scaleSmoothstep(factor, source, dest, width, height);
+  Common::ThreadPool::RegisterWorker(this);
 }
 
-void TextureScaler::Scale3Point(int factor, u32* source, u32* dest, int width, int height)
+AsyncTextureScaler::~AsyncTextureScaler()
 {
-  //GlobalThreadPool::Loop(std::bind(&scale3Point, factor, source, dest, width, height), 0, height);
-  scale3Point(factor, source, dest, width, height);
+  Common::ThreadPool::UnregisterWorker(this);
+  Clear();
+  size_t loop_count = 0;
+  while (m_running.load())
+    Common::cYield(loop_count++);
 }
 
-void TextureScaler::ScaleDDT(int factor, u32* source, u32* dest, int width, int height)
+bool AsyncTextureScaler::NextTask(size_t ID)
 {
-  //GlobalThreadPool::Loop(std::bind(&scaleDDT, factor, source, dest, width, height), 0, height);
-  scaleDDT(factor, source, dest, width, height);
+  // m_scaler keeps its buffers between calls, so only one thread may use it.
+  if (m_running.exchange(true))
+    return false;
+
+  std::unique_ptr<Job> job;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (!m_queued.empty())
+    {
+      job = std::move(m_queued.front());
+      m_queued.pop_front();
+    }
+  }
+  if (!job)
+  {
+    m_running.store(false);
+    return false;
+  }
+
+  for (Level& level : job->levels)
+  {
+    const size_t scaled_size = level.data.size() * job->factor * job->factor;
+    const u32* scaled = m_scaler.Scale(level.data.data(), level.expanded_width, level.height,
+                                       job->factor, job->type, job->deposterize);
+    level.data.assign(scaled, scaled + scaled_size);
+  }
+
+  bool pending;
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_finished.push_back(std::move(job));
+    pending = !m_queued.empty();
+  }
+  m_running.store(false);
+  // Threads turned away while this job ran don't come back on their own.
+  if (pending)
+    Common::ThreadPool::NotifyWorkPending();
+  return true;
 }
 
-void TextureScaler::ScaleDDTSharp(int factor, u32* source, u32* dest, int width, int height)
+void AsyncTextureScaler::Queue(std::unique_ptr<Job> job)
 {
-  //GlobalThreadPool::Loop(std::bind(&scaleDDTSharp, factor, source, dest, width, height), 0, height);
-  scaleDDTSharp(factor, source, dest, width, height);
+  {
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_queued.push_back(std::move(job));
+  }
+  Common::ThreadPool::NotifyWorkPending();
 }
 
-void TextureScaler::DePosterize(u32* source, u32* dest, int width, int height)
+void AsyncTextureScaler::Clear()
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+  m_queued.clear();
+}
+
+void AsyncTextureScaler::TakeFinished(std::vector<std::unique_ptr<Job>>* out)
 {
-  bufTmp3.resize(width*height);
-  //GlobalThreadPool::Loop(std::bind(&deposterizeH, source, bufTmp3.data(), width, placeholder::_1, placeholder::_2), 0, height);
-  //GlobalThreadPool::Loop(std::bind(&deposterizeV, bufTmp3.data(), dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-  //GlobalThreadPool::Loop(std::bind(&deposterizeH, dest, bufTmp3.data(), width, placeholder::_1, placeholder::_2), 0, height);
-  //GlobalThreadPool::Loop(std::bind(&deposterizeV, bufTmp3.data(), dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-  deposterizeH(source, bufTmp3.data(), width, 0, height);
-  deposterizeV(bufTmp3.data(), dest, width, height, 0, height);
-  deposterizeH(dest, bufTmp3.data(), width, 0, height);
-  deposterizeV(bufTmp3.data(), dest, width, height, 0, height);
+  std::lock_guard<std::mutex> guard(m_lock);
+  for (auto& job : m_finished)
+    out->push_back(std::move(job));
+  m_finished.clear();
 }
@@ -19,7 +19,12 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
+#include "Common/ThreadPool.h"
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 class TextureScaler
@@ -28,28 +33,36 @@ public:
   TextureScaler();
   ~TextureScaler();
 
+  // Scales with the current texture scaling settings.
   u32* Scale(u32* data, int width, int height);
+  // The result stays valid until the next call.
+  u32* Scale(u32* data, int width, int height, int factor, int type, bool deposterize);
 
   enum
   {
     NONE = 0, XBRZ = 1, HYBRID = 2, BICUBIC = 3, HYBRID_BICUBIC = 4, JINC = 5, JINC_SHARPER = 6, SMOOTHSTEP = 7, THREE_POINT = 8, DDT = 9, DDT_SHARP = 10
   };
 
+  // The 8.8 fixed point weights the weighted scalers give the source pixels around a corner, for
+  // each of the factor x factor output pixels next to it. Ordered by output row, output column,
+  // source row and source column, 4x4 source pixels per output pixel or 2x2 for SMOOTHSTEP.
+  // Empty for the other types.
+  static std::vector<int> GetFilterWeights(int type, int factor);
+
+  // Most ranges of rows an image is split into for the thread pool.
+  static constexpr int MAX_RANGES = 16;
+
 private:
+  class RowWorker;
 
+  void ScaleRows(int type, int factor, u32* source, u32* dest, int width, int height, int l, int u);
   void ScaleXBRZ(int factor, u32* source, u32* dest, int width, int height);
   void ScaleBilinear(int factor, u32* source, u32* dest, int width, int height);
   void ScaleBicubicBSpline(int factor, u32* source, u32* dest, int width, int height);
-  void ScaleBicubicMitchell(int factor, u32* source, u32* dest, int width, int height);
   void ScaleHybrid(int factor, u32* source, u32* dest, int width, int height, bool bicubic = false);
-  void ScaleJinc(int factor, u32* source, u32* dest, int width, int height);
-  void ScaleJincSharper(int factor, u32* source, u32* dest, int width, int height);
-  void ScaleSmoothstep(int factor, u32* source, u32* dest, int width, int height);
-  void Scale3Point(int factor, u32* source, u32* dest, int width, int height);
-  void ScaleDDT(int factor, u32* source, u32* dest, int width, int height);
-  void ScaleDDTSharp(int factor, u32* source, u32* dest, int width, int height);
 
   void DePosterize(u32* source, u32* dest, int width, int height);
+  u32* DePosterizeRows(int range, u32* source, int width, int height, int first, int last);
 
   bool IsEmptyOrFlat(u32* data, int pixels);
 
@@ -57,4 +70,49 @@ private:
   // maximum is (100 MB total for a 512 by 512 texture with scaling factor 5 and hybrid scaling)
   // of course, scaling factor 5 is totally silly anyway
   Common::SimpleBuf<u32> bufInput, bufDeposter, bufOutput, bufTmp1, bufTmp2, bufTmp3;
+  // Deposterized rows of each range, and the buffer between the passes.
+  Common::SimpleBuf<u32> bufRangeDeposter[MAX_RANGES], bufRangeTmp[MAX_RANGES];
+  std::unique_ptr<RowWorker> m_row_worker;
+};
+
+// Scales textures on the thread pool, one at a time, so that the GPU thread can carry on with
+// the native resolution ones in the meantime.
+class AsyncTextureScaler final : public Common::IWorker
+{
+public:
+  struct Level
+  {
+    // The decoded level, replaced by the scaled one.
+    std::vector<u32> data;
+    int width;
+    int height;
+    int expanded_width;
+  };
+
+  struct Job
+  {
+    u64 id;
+    int factor;
+    int type;
+    bool deposterize;
+    std::vector<Level> levels;
+  };
+
+  AsyncTextureScaler();
+  ~AsyncTextureScaler();
+
+  bool NextTask(size_t ID) override;
+
+  void Queue(std::unique_ptr<Job> job);
+  // Drops the jobs that didn't start yet, the running one still finishes.
+  void Clear();
+  // Moves the finished jobs to out, in the order they were queued.
+  void TakeFinished(std::vector<std::unique_ptr<Job>>* out);
+
+private:
+  TextureScaler m_scaler;
+  std::mutex m_lock;
+  std::deque<std::unique_ptr<Job>> m_queued;
+  std::vector<std::unique_ptr<Job>> m_finished;
+  std::atomic<bool> m_running{false};
 };
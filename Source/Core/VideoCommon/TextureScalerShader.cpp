@@ -0,0 +1,254 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TextureScalerShader.h"
+
+#include <sstream>
+#include <vector>
+
+#include "VideoCommon/TextureScalerCommon.h"
+
+namespace TextureScalerShader
+{
+static constexpr u32 GROUP_SIZE = 8;
+
+static const char scaling_shader_header[] = R"(
+#ifdef VULKAN
+
+layout(std140, push_constant) uniform PushConstants {
+  uvec2 dst_size;
+  uvec2 src_size;
+  uint src_offset;
+} push_constants;
+#define u_dst_size (push_constants.dst_size)
+#define u_src_size (push_constants.src_size)
+#define u_src_offset (push_constants.src_offset)
+
+TEXEL_BUFFER_BINDING(0) uniform usamplerBuffer s_input_buffer;
+
+IMAGE_BINDING(rgba8, 0) uniform writeonly image2DArray output_image;
+
+#else
+
+uniform uvec2 u_dst_size;
+uniform uvec2 u_src_size;
+uniform uint u_src_offset;
+
+SAMPLER_BINDING(9) uniform usamplerBuffer s_input_buffer;
+#ifndef GL_FRAGMENT_PRECISION_HIGH
+#define highp mediump
+#endif
+precision highp image2DArray;
+layout(rgba8, binding = 0) uniform writeonly image2DArray output_image;
+
+#endif
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+// The source pixels the output pixel is computed from, clamped to the image like on the CPU.
+ivec4 samples[KERNEL_SIZE * KERNEL_SIZE];
+#define S(sx, sy) samples[(sy) * KERNEL_SIZE + (sx)]
+
+ivec4 Fetch(int x, int y)
+{
+  x = clamp(x, 0, int(u_src_size.x) - 1);
+  y = clamp(y, 0, int(u_src_size.y) - 1);
+  uint index = u_src_offset + uint(y) * u_src_size.x + uint(x);
+  uvec2 pair = texelFetch(s_input_buffer, int(index >> 1)).xy;
+  uint color = (index & 1u) != 0u ? pair.y : pair.x;
+  return ivec4(uvec4(color, color >> 8, color >> 16, color >> 24) & 0xFFu);
+}
+
+void LoadSamples(int cx, int cy)
+{
+  for (int sy = 0; sy < KERNEL_SIZE; sy++)
+  {
+    for (int sx = 0; sx < KERNEL_SIZE; sx++)
+      S(sx, sy) = Fetch(cx + sx - KERNEL_SIZE / 2, cy + sy - KERNEL_SIZE / 2);
+  }
+}
+
+// The CPU scalers go over the corners between the source pixels and write the FACTOR x FACTOR
+// output pixels around each, clamped to the image. Finds the corner that wrote the final value of
+// an output pixel and the position of the pixel in its block.
+void GetCorner(uint coord, uint src_size, out int corner, out int offset)
+{
+  if (coord == src_size * uint(FACTOR) - 1u)
+  {
+    // The block of the last corner is clamped to the last pixel, so its last pixel wins.
+    corner = int(src_size);
+    offset = FACTOR - 1;
+  }
+  else
+  {
+    corner = (int(coord) + FACTOR / 2) / FACTOR;
+    offset = (int(coord) + FACTOR / 2) % FACTOR;
+  }
+}
+
+// Bilinear using only 3 points.
+ivec4 Linear3P(int p, int q, ivec4 a, ivec4 b, ivec4 c)
+{
+  p = (((p << 1) + 1) << 7) / FACTOR;
+  q = (((q << 1) + 1) << 7) / FACTOR;
+  return (a << 8) + p * (b - a) + q * (c - a);
+}
+
+ivec4 Linear4P(int p, int q, ivec4 a, ivec4 b, ivec4 c, ivec4 d)
+{
+  p = (((p << 1) + 1) << 7) / FACTOR;
+  q = (((q << 1) + 1) << 7) / FACTOR;
+  return (a << 8) + p * (b - a) + q * (c - a) + ((p * q) >> 8) * (a - b - c + d);
+}
+
+#if defined(SCALER_WEIGHTED)
+
+ivec4 Scale(int x, int y)
+{
+  int base = (y * FACTOR + x) * KERNEL_SIZE * KERNEL_SIZE;
+  ivec4 sum = ivec4(0);
+  for (int i = 0; i < KERNEL_SIZE * KERNEL_SIZE; i++)
+    sum += weights[base + i] * samples[i];
+  ivec4 color = clamp(sum >> 8, 0, 255);
+#if defined(SCALER_ANTI_RINGING)
+  ivec4 lo = min(min(S(1, 1), S(2, 1)), min(S(1, 2), S(2, 2)));
+  ivec4 hi = max(max(S(1, 1), S(2, 1)), max(S(1, 2), S(2, 2)));
+  color = (clamp(color, lo, hi) + color) >> 1;
+#endif
+  return color;
+}
+
+#elif defined(SCALER_THREE_POINT)
+
+ivec4 Scale(int x, int y)
+{
+  if (x + y < FACTOR)
+    return clamp(Linear3P(x, y, S(0, 0), S(1, 0), S(0, 1)) >> 8, 0, 255);
+  return clamp(Linear3P(FACTOR - x - 1, FACTOR - y - 1, S(1, 1), S(0, 1), S(1, 0)) >> 8, 0, 255);
+}
+
+#elif defined(SCALER_DDT)
+
+// Splits the square between the four center samples along the diagonal that is more alike.
+ivec4 Scale(int x, int y)
+{
+#if KERNEL_SIZE == 4
+  int wd1 = abs(S(1, 1).g - S(2, 2).g);
+  wd1 += abs(S(1, 0).g - S(2, 1).g) + abs(S(2, 1).g - S(3, 2).g) + abs(S(0, 1).g - S(1, 2).g) +
+         abs(S(1, 2).g - S(2, 3).g);
+  wd1 -= abs(S(1, 0).g - S(3, 2).g) + abs(S(0, 1).g - S(2, 3).g);
+  int wd2 = abs(S(2, 1).g - S(1, 2).g);
+  wd2 += abs(S(2, 0).g - S(1, 1).g) + abs(S(1, 1).g - S(0, 2).g) + abs(S(1, 3).g - S(2, 2).g) +
+         abs(S(2, 2).g - S(3, 1).g);
+  wd2 -= abs(S(2, 0).g - S(0, 2).g) + abs(S(1, 3).g - S(3, 1).g);
+  ivec4 c00 = S(1, 1), c10 = S(2, 1), c01 = S(1, 2), c11 = S(2, 2);
+#else
+  int wd1 = abs(S(0, 0).g - S(1, 1).g);
+  int wd2 = abs(S(1, 0).g - S(0, 1).g);
+  ivec4 c00 = S(0, 0), c10 = S(1, 0), c01 = S(0, 1), c11 = S(1, 1);
+#endif
+
+  ivec4 color;
+  if (wd1 < wd2)
+  {
+    if (x > y)
+      color = Linear3P(FACTOR - x - 1, y, c10, c00, c11);
+    else
+      color = Linear3P(x, FACTOR - y - 1, c01, c11, c00);
+  }
+  else if (wd1 > wd2)
+  {
+    if (x + y < FACTOR)
+      color = Linear3P(x, y, c00, c10, c01);
+    else
+      color = Linear3P(FACTOR - x - 1, FACTOR - y - 1, c11, c01, c10);
+  }
+  else
+  {
+    color = Linear4P(x, y, c00, c10, c01, c11);
+  }
+  return clamp(color >> 8, 0, 255);
+}
+
+#endif
+
+void main()
+{
+  uvec2 coords = gl_GlobalInvocationID.xy;
+  if (coords.x >= u_dst_size.x || coords.y >= u_dst_size.y)
+    return;
+
+  int cx, cy, x, y;
+  GetCorner(coords.x, u_src_size.x, cx, x);
+  GetCorner(coords.y, u_src_size.y, cy, y);
+  LoadSamples(cx, cy);
+  imageStore(output_image, ivec3(ivec2(coords), 0), vec4(Scale(x, y)) / 255.0);
+}
+)";
+
+bool IsSupported(int type, int factor)
+{
+  if (factor < 2 || factor > 5)
+    return false;
+  switch (type)
+  {
+  case TextureScaler::BICUBIC:
+  case TextureScaler::JINC:
+  case TextureScaler::JINC_SHARPER:
+  case TextureScaler::SMOOTHSTEP:
+  case TextureScaler::THREE_POINT:
+  case TextureScaler::DDT:
+  case TextureScaler::DDT_SHARP:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::pair<u32, u32> GetDispatchCount(u32 width, u32 height)
+{
+  return {(width + (GROUP_SIZE - 1)) / GROUP_SIZE, (height + (GROUP_SIZE - 1)) / GROUP_SIZE};
+}
+
+std::string GenerateScalingShader(int type, int factor, API_TYPE ApiType)
+{
+  if (!IsSupported(type, factor))
+    return "";
+
+  std::stringstream ss;
+  ss << "#define FACTOR " << factor << "\n";
+  switch (type)
+  {
+  case TextureScaler::JINC:
+  case TextureScaler::JINC_SHARPER:
+    ss << "#define SCALER_ANTI_RINGING 1\n";
+  // fall through
+  case TextureScaler::BICUBIC:
+  case TextureScaler::SMOOTHSTEP:
+  {
+    ss << "#define SCALER_WEIGHTED 1\n";
+    ss << "#define KERNEL_SIZE " << (type == TextureScaler::SMOOTHSTEP ? 2 : 4) << "\n";
+    // The CPU scalers' own weights, so that the results match.
+    const std::vector<int> weights = TextureScaler::GetFilterWeights(type, factor);
+    ss << "const int weights[" << weights.size() << "] = int[" << weights.size() << "](";
+    for (size_t i = 0; i < weights.size(); i++)
+      ss << (i ? ", " : "") << weights[i];
+    ss << ");\n";
+    break;
+  }
+  case TextureScaler::THREE_POINT:
+    ss << "#define SCALER_THREE_POINT 1\n";
+    ss << "#define KERNEL_SIZE 2\n";
+    break;
+  case TextureScaler::DDT:
+  case TextureScaler::DDT_SHARP:
+    ss << "#define SCALER_DDT 1\n";
+    ss << "#define KERNEL_SIZE " << (type == TextureScaler::DDT_SHARP ? 4 : 2) << "\n";
+    break;
+  }
+
+  ss << scaling_shader_header;
+  return ss.str();
+}
+}
@@ -0,0 +1,30 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/VideoCommon.h"
+
+// Compute shader versions of the TextureScaler filters that only look at the source pixels around
+// each output pixel. They read the decoded RGBA8 texture from a texel buffer viewed as R32G32_UINT
+// and write the scaled one to an rgba8 image, with the same integer math as the CPU scalers.
+namespace TextureScalerShader
+{
+// Whether there is a shader for the TextureScaler type and factor. xBRZ and the hybrid scalers
+// make several passes over the whole image and stay on the CPU, as does deposterizing.
+bool IsSupported(int type, int factor);
+
+// Number of X and Y thread groups for an output image of the specified width/height.
+std::pair<u32, u32> GetDispatchCount(u32 width, u32 height);
+
+// Returns the GLSL string containing the scaling shader for the specified type and factor.
+// u_src_size is the size of the image in the buffer, which starts at pixel u_src_offset, and
+// u_dst_size the part of the scaled image to write. Like on the CPU, the image includes the
+// columns decoded past the width of the texture.
+std::string GenerateScalingShader(int type, int factor, API_TYPE ApiType = API_OPENGL);
+}
@@ -3,7 +3,9 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <utility>
 
 #include "Common/CPUDetect.h"
 #include "Common/Intrinsics.h"
@@ -280,4 +282,135 @@ u32 CalculateLevelSize(u32 level_0_size, u32 level)
 {
   return std::max(level_0_size >> level, 1u);
 }
+
+static u16 ToRGB565(const u8* color)
+{
+  return ((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3);
+}
+
+static void FromRGB565(u16 color, s32* out)
+{
+  const s32 r = (color >> 11) & 0x1F;
+  const s32 g = (color >> 5) & 0x3F;
+  const s32 b = color & 0x1F;
+  out[0] = (r << 3) | (r >> 2);
+  out[1] = (g << 2) | (g >> 4);
+  out[2] = (b << 3) | (b >> 2);
+}
+
+// block holds the 16 pixels of the block as RGBA bytes, row by row.
+static void CompressDXT5Block(u8 *pDst, const u8 *block)
+{
+  u8 lo[4] = { 255, 255, 255, 255 };
+  u8 hi[4] = { 0, 0, 0, 0 };
+  for (s32 i = 0; i < 16; i++)
+  {
+    for (s32 c = 0; c < 4; c++)
+    {
+      lo[c] = std::min(lo[c], block[i * 4 + c]);
+      hi[c] = std::max(hi[c], block[i * 4 + c]);
+    }
+  }
+  // The box spans from lo to hi, but the colors may lie along an other of its diagonals: flip red
+  // and blue where they fall while green rises.
+  s32 covariance[3] = {};
+  for (s32 i = 0; i < 16; i++)
+  {
+    const s32 g = block[i * 4 + 1] * 2 - (lo[1] + hi[1]);
+    covariance[0] += (block[i * 4 + 0] * 2 - (lo[0] + hi[0])) * g;
+    covariance[2] += (block[i * 4 + 2] * 2 - (lo[2] + hi[2])) * g;
+  }
+  // Moving the color endpoints in a bit lowers the error of the colors in between. Alpha keeps
+  // its extremes, many textures only use fully transparent and opaque pixels.
+  for (s32 c = 0; c < 3; c++)
+  {
+    const s32 inset = (hi[c] - lo[c]) >> 4;
+    lo[c] += inset;
+    hi[c] -= inset;
+    if (covariance[c] < 0)
+      std::swap(lo[c], hi[c]);
+  }
+
+  // Alpha: 8 levels between hi and lo, code 0 is hi and 1 is lo.
+  s32 alphas[8] = { hi[3], lo[3] };
+  for (s32 i = 1; i < 7; i++)
+    alphas[i + 1] = ((7 - i) * hi[3] + i * lo[3]) / 7;
+  u64 alpha_bits = 0;
+  for (s32 i = 0; i < 16; i++)
+  {
+    s32 best = 0;
+    s32 best_error = 256;
+    for (s32 code = 0; code < 8 && hi[3] != lo[3]; code++)
+    {
+      const s32 error = std::abs(block[i * 4 + 3] - alphas[code]);
+      if (error < best_error)
+      {
+        best = code;
+        best_error = error;
+      }
+    }
+    alpha_bits |= u64(best) << (i * 3);
+  }
+  pDst[0] = hi[3];
+  pDst[1] = lo[3];
+  for (s32 i = 0; i < 6; i++)
+    pDst[2 + i] = static_cast<u8>(alpha_bits >> (i * 8));
+
+  // Color: DXT5 always interpolates 4 colors, whatever the order of the endpoints.
+  const u16 color0 = ToRGB565(hi);
+  const u16 color1 = ToRGB565(lo);
+  s32 colors[4][3];
+  FromRGB565(color0, colors[0]);
+  FromRGB565(color1, colors[1]);
+  for (s32 c = 0; c < 3; c++)
+  {
+    colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+    colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+  }
+  u32 color_bits = 0;
+  for (s32 i = 0; i < 16; i++)
+  {
+    s32 best = 0;
+    s32 best_error = INT32_MAX;
+    for (s32 code = 0; code < 4; code++)
+    {
+      s32 error = 0;
+      for (s32 c = 0; c < 3; c++)
+      {
+        const s32 d = block[i * 4 + c] - colors[code][c];
+        error += d * d;
+      }
+      if (error < best_error)
+      {
+        best = code;
+        best_error = error;
+      }
+    }
+    color_bits |= u32(best) << (i * 2);
+  }
+  pDst[8] = static_cast<u8>(color0);
+  pDst[9] = static_cast<u8>(color0 >> 8);
+  pDst[10] = static_cast<u8>(color1);
+  pDst[11] = static_cast<u8>(color1 >> 8);
+  std::memcpy(pDst + 12, &color_bits, sizeof(u32));
+}
+
+void CompressRGBA32ToDXT5(u8 *pDst, const u32 *pSrc, const u32 width, const u32 height, const u32 srcpitch)
+{
+  u8 block[64];
+  for (u32 by = 0; by < height; by += 4)
+  {
+    for (u32 bx = 0; bx < width; bx += 4)
+    {
+      for (u32 y = 0; y < 4; y++)
+      {
+        const u32* row = pSrc + std::min(by + y, height - 1) * srcpitch;
+        for (u32 x = 0; x < 4; x++)
+          std::memcpy(block + (y * 4 + x) * 4, row + std::min(bx + x, width - 1), sizeof(u32));
+      }
+      CompressDXT5Block(pDst, block);
+      pDst += 16;
+    }
+  }
+}
 }
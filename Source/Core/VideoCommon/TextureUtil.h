@@ -17,4 +17,7 @@ void ExpandI8Data(u8 *pDst, const u8 *pSrc, const s32 width, const s32 height, c
 void CopyCompressedTextureData(u8 *pDst, const u8 *pSrc, const s32 width, const s32 height, const s32 dstPitch, s32 numBytesPerBlock, const s32 dstpitch);
 s32 GetTextureSizeInBytes(u32 width, u32 height, HostTextureFormat fmt);
 u32 CalculateLevelSize(u32 level_0_size, u32 level);
+// Compresses an RGBA32 image to DXT5, fitting the endpoints of each block to the bounding box of
+// its colors. Fast rather than good, blocks past the edges repeat the last column and row.
+void CompressRGBA32ToDXT5(u8 *pDst, const u32 *pSrc, const u32 width, const u32 height, const u32 srcpitch);
 }
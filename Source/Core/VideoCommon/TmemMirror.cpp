@@ -0,0 +1,74 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TmemMirror.h"
+
+#include <algorithm>
+#include <bitset>
+
+#include "VideoCommon/TextureDecoder.h"
+
+namespace TmemMirror
+{
+namespace
+{
+constexpr u32 NUM_LINES = TMEM_SIZE / TMEM_LINE_SIZE;
+
+std::bitset<NUM_LINES> s_invalid_lines;
+// Bounds of the invalid lines, so that popping a range doesn't scan all of TMEM.
+u32 s_first_invalid = NUM_LINES;
+u32 s_end_invalid = 0;
+}
+
+void Invalidate(u32 address, u32 size)
+{
+  if (address >= TMEM_SIZE || size == 0)
+    return;
+
+  const u32 first = address / TMEM_LINE_SIZE;
+  const u32 end = (std::min<u32>(TMEM_SIZE - address, size) + address + TMEM_LINE_SIZE - 1) /
+                  TMEM_LINE_SIZE;
+  for (u32 line = first; line < end; line++)
+    s_invalid_lines.set(line);
+  s_first_invalid = std::min(s_first_invalid, first);
+  s_end_invalid = std::max(s_end_invalid, end);
+}
+
+void InvalidateAll()
+{
+  Invalidate(0, TMEM_SIZE);
+}
+
+bool PopInvalidRange(u32* address, u32* size)
+{
+  u32 first = s_first_invalid;
+  while (first < s_end_invalid && !s_invalid_lines[first])
+    first++;
+  if (first >= s_end_invalid)
+  {
+    s_first_invalid = NUM_LINES;
+    s_end_invalid = 0;
+    return false;
+  }
+
+  u32 end = first;
+  while (end < s_end_invalid && s_invalid_lines[end])
+    s_invalid_lines.reset(end++);
+  s_first_invalid = end;
+
+  *address = first * TMEM_LINE_SIZE;
+  *size = (end - first) * TMEM_LINE_SIZE;
+  return true;
+}
+
+bool GetOffset(const void* ptr, u32* offset)
+{
+  const u8* byte_ptr = static_cast<const u8*>(ptr);
+  if (byte_ptr < texMem || byte_ptr >= texMem + TMEM_SIZE)
+    return false;
+
+  *offset = static_cast<u32>(byte_ptr - texMem);
+  return true;
+}
+}
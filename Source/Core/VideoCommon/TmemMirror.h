@@ -0,0 +1,23 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+// Tracks which parts of TMEM were written, so that a backend can keep a copy of TMEM on the GPU
+// and decode preloaded textures from it instead of uploading them again each time.
+namespace TmemMirror
+{
+// Marks size bytes of TMEM at address as written.
+void Invalidate(u32 address, u32 size);
+void InvalidateAll();
+
+// Gets the next run of whole TMEM lines written since the last call and marks it as copied.
+// Returns false once the copy is up to date.
+bool PopInvalidRange(u32* address, u32* size);
+
+// Gets the offset of ptr in TMEM, returns false if it doesn't point into TMEM.
+bool GetOffset(const void* ptr, u32* offset);
+}
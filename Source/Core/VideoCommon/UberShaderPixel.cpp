@@ -140,6 +140,21 @@ PixelUberShaderUid GetPixelUberShaderUid(u32 components, const XFMemory &xfr, co
   return out;
 }
 
+PixelUberShaderUid GetPixelUberShaderUid(const PixelShaderUid& uid)
+{
+  const pixel_shader_uid_data& data = uid.GetUidData();
+  PixelUberShaderUid out;
+  out.ClearUID();
+  pixel_ubershader_uid_data& uid_data = out.GetUidData<pixel_ubershader_uid_data>();
+  uid_data.num_texgens = data.genMode_numtexgens;
+  // The uber shaders never test early and write the depth.
+  uid_data.early_depth = data.early_ztest && !data.per_pixel_depth;
+  uid_data.per_pixel_depth = data.per_pixel_depth;
+  uid_data.per_pixel_lighting = data.pixel_lighting != 0;
+  out.CalculateUIDHash();
+  return out;
+}
+
 void ClearUnusedPixelUberShaderUidBits(API_TYPE ApiType, PixelUberShaderUid* uid)
 {
   pixel_ubershader_uid_data& uid_data = uid->GetUidData<pixel_ubershader_uid_data>();
@@ -38,6 +38,8 @@ struct pixel_ubershader_uid_data
 typedef ShaderUid<pixel_ubershader_uid_data> PixelUberShaderUid;
 
 PixelUberShaderUid GetPixelUberShaderUid(u32 components, const XFMemory &xfr, const BPMemory &bpm);
+// The uber shader that draws what the specialized shader of uid does.
+PixelUberShaderUid GetPixelUberShaderUid(const PixelShaderUid& uid);
 
 void GenPixelShader(ShaderCode& out, API_TYPE ApiType, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data& uid_data);
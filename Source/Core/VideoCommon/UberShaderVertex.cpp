@@ -4,6 +4,7 @@
 
 #include "VideoCommon/UberShaderVertex.h"
 #include "VideoCommon/DriverDetails.h"
+#include "VideoCommon/GeometryShaderGen.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/UberShaderCommon.h"
 #include "VideoCommon/VertexShaderGen.h"
@@ -23,6 +24,18 @@ VertexUberShaderUid GetVertexUberShaderUid(u32 components, const XFMemory &xfr)
   return out;
 }
 
+VertexUberShaderUid GetVertexUberShaderUid(const VertexShaderUid& uid)
+{
+  const vertex_shader_uid_data& data = uid.GetUidData();
+  VertexUberShaderUid out;
+  out.ClearUID();
+  vertex_ubershader_uid_data& uid_data = out.GetUidData<vertex_ubershader_uid_data>();
+  uid_data.num_texgens = data.numTexGens;
+  uid_data.per_pixel_lighting = data.pixel_lighting;
+  out.CalculateUIDHash();
+  return out;
+}
+
 static void GenVertexShaderTexGens(API_TYPE ApiType, u32 numTexgen, bool pixel_ligthing_enabled, ShaderCode& out);
 
 void GenVertexShader(ShaderCode& out, API_TYPE ApiType, const ShaderHostConfig& host_config,
@@ -69,7 +82,11 @@ void GenVertexShader(ShaderCode& out, API_TYPE ApiType, const ShaderHostConfig&
       out.Write("VARYING_LOCATION(0) out VertexData {\n");
       GenerateVSOutputMembers(out, ApiType, per_pixel_lighting, numTexgen,
                               GetInterpolationQualifier(ApiType, msaa, ssaa, false, true));
+      if (host_config.vs_stereo)
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
+      if (host_config.vs_stereo)
+        GenerateGeometryShaderConstants(out, ApiType);
     }
     else
     {
@@ -279,7 +296,11 @@ void GenVertexShader(ShaderCode& out, API_TYPE ApiType, const ShaderHostConfig&
   {
     if (host_config.backend_geometry_shaders || ApiType == API_VULKAN)
     {
+      if (host_config.vs_stereo)
+        GenerateVertexShaderStereo(out, "o");
       AssignVSOutputMembers(out, ApiType, "vs", "o", per_pixel_lighting, numTexgen);
+      if (host_config.vs_stereo)
+        out.Write("vs.layer = eye;\ngl_Layer = eye;\n");
     }
     else
     {
@@ -6,6 +6,7 @@
 
 #include <functional>
 #include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/VertexShaderGen.h"
 
 namespace UberShader
 {
@@ -30,6 +31,8 @@ struct vertex_ubershader_uid_data
 typedef ShaderUid<vertex_ubershader_uid_data> VertexUberShaderUid;
 
 VertexUberShaderUid GetVertexUberShaderUid(u32 components, const XFMemory &xfr);
+// The uber shader that draws what the specialized shader of uid does.
+VertexUberShaderUid GetVertexUberShaderUid(const VertexShaderUid& uid);
 
 void GenVertexShader(ShaderCode& code, API_TYPE api_type, const ShaderHostConfig& host_config,
                            const vertex_ubershader_uid_data& uid_data);
@@ -126,6 +126,9 @@ VertexLoaderBase::VertexLoaderBase(const TVtxDesc &vtx_desc, const VAT &vtx_attr
   m_fallback = nullptr;
   m_native_stride = 0;
   m_numLoadedVertices = 0;
+  m_frame_vertices = 0;
+  m_frame_timed_vertices = 0;
+  m_frame_time_ns = 0;
   m_VertexSize = 0;
   m_native_vertex_format = nullptr;
   m_native_components = 0;
@@ -241,7 +244,11 @@ void VertexLoaderBase::AppendToString(std::string *dest) const
   dest->reserve(250);
 
   dest->append(GetName());
-  dest->append(StringFromFormat(" - %zu v\n", m_numLoadedVertices));
+  const char* kind = IsPrecompiled() ? "pvt" : IsJIT() ? "JIT" : "generic";
+  dest->append(StringFromFormat(" (%s) - %u v", kind, m_frame_vertices));
+  if (m_frame_timed_vertices)
+    dest->append(StringFromFormat(", %.1f ns/v", double(m_frame_time_ns) / m_frame_timed_vertices));
+  dest->append(StringFromFormat(" - %" PRIu64 " total\n", m_numLoadedVertices));
 }
 
 // a hacky implementation to compare two vertex loaders
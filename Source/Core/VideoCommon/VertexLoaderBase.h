@@ -72,18 +72,47 @@ public:
   {
     return true;
   }
-  virtual bool IsPrecompiled()
+  virtual bool IsPrecompiled() const
+  {
+    return false;
+  }
+  virtual bool IsJIT() const
   {
     return false;
   }
   virtual s32 RunVertices(const VertexLoaderParameters &parameters) = 0;
 
+  // Loaders that support it can convert disjoint ranges of one draw on several threads at once.
+  // PrepareParallelLoading is called once per draw on the GPU thread, then LoadRange once per
+  // range from any thread. Each range writes its vertices to its own destination, skipped
+  // vertices only compact the range itself.
+  virtual bool SupportsParallelLoading() const
+  {
+    return false;
+  }
+  virtual void PrepareParallelLoading(const VertexLoaderParameters &parameters)
+  {
+  }
+  virtual s32 LoadRange(const VertexLoaderParameters &parameters)
+  {
+    return RunVertices(parameters);
+  }
+
   virtual bool IsInitialized() = 0;
 
   // For debugging / profiling
   void AppendToString(std::string *dest) const;
   std::string GetName() const;
 
+  const TVtxDesc& GetVtxDesc() const
+  {
+    return m_VtxDesc;
+  }
+  const TVtxAttr& GetVtxAttr() const
+  {
+    return m_VtxAttr;
+  }
+
   // per loader public state
   s32 m_VertexSize;      // number of bytes of a raw GC vertex
   s32 m_native_stride;
@@ -93,6 +122,12 @@ public:
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format;
   u64 m_numLoadedVertices;
+  // Statistics of the current frame. Vertices copied from the display list cache or converted on
+  // the GPU count as loaded, only the ones this loader converted are timed, and only while the
+  // statistics overlay is shown.
+  u32 m_frame_vertices;
+  u32 m_frame_timed_vertices;
+  u64 m_frame_time_ns;
 
 protected:
   VertexLoaderBase(const TVtxDesc &vtx_desc, const VAT &vtx_attr);
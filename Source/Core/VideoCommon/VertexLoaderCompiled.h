@@ -12,7 +12,7 @@ public:
   static void Initialize();
   VertexLoaderCompiled(const TVtxDesc &vtx_desc, const VAT &vtx_attr);
   ~VertexLoaderCompiled();
-  bool IsPrecompiled() override
+  bool IsPrecompiled() const override
   {
     return true;
   }
@@ -3,17 +3,31 @@
 // Refer to the license.txt file included.
 // Modified for Ishiiruka by Tino
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
+#include <fstream>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <unordered_map>
 
 
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
 #include "Common/ThreadPool.h"
 #include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 
+#include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/DLCache.h"
+#include "VideoCommon/GPUVertexDecoder.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -70,13 +84,19 @@ void AppendListToString(std::string *dest)
   std::vector<entry> entries;
 
   size_t total_size = 0;
-  for (VertexLoaderMap::const_iterator iter = s_vertex_loader_map.begin(); iter != s_vertex_loader_map.end(); ++iter)
-  {
+  auto add_entry = [&](const VertexLoaderBase* loader) {
+    if (!loader || !loader->m_frame_vertices)
+      return;
     entry e;
-    iter->second->AppendToString(&e.text);
-    e.num_verts = iter->second->m_numLoadedVertices;
+    loader->AppendToString(&e.text);
+    e.num_verts = loader->m_frame_vertices;
     entries.push_back(e);
     total_size += e.text.size() + 1;
+  };
+  for (VertexLoaderMap::const_iterator iter = s_vertex_loader_map.begin(); iter != s_vertex_loader_map.end(); ++iter)
+  {
+    add_entry(iter->second.get());
+    add_entry(iter->second->GetFallback());
   }
   sort(entries.begin(), entries.end());
   dest->reserve(dest->size() + total_size);
@@ -86,6 +106,19 @@ void AppendListToString(std::string *dest)
   }
 }
 
+void ResetFrameStatistics()
+{
+  for (auto& iter : s_vertex_loader_map)
+  {
+    for (VertexLoaderBase* loader = iter.second.get(); loader; loader = loader->GetFallback())
+    {
+      loader->m_frame_vertices = 0;
+      loader->m_frame_timed_vertices = 0;
+      loader->m_frame_time_ns = 0;
+    }
+  }
+}
+
 void Init()
 {
   MarkAllDirty();
@@ -94,8 +127,73 @@ void Init()
   last_game_code = SConfig::GetInstance().GetGameID();
 }
 
+// Adds the number of vertices each format loaded in this session to the game's profile in
+// User/Dump/VertexLoaders/. Tools/gen-precompiled-vertex-loaders.py turns these profiles into
+// precompiled loaders; see VertexLoaderProfiles/ for the ones that are built in.
+static void DumpVertexLoaderProfile()
+{
+  if (last_game_code.empty() || s_vertex_loader_map.empty())
+    return;
+
+  const std::string directory = File::GetUserPath(D_DUMP_IDX) + "VertexLoaders" DIR_SEP;
+  File::CreateFullPath(directory);
+  const std::string filename = directory + last_game_code + ".txt";
+
+  std::map<std::array<u32, 4>, std::pair<u64, std::string>> formats;
+  std::ifstream in;
+  File::OpenFStream(in, filename, std::ios_base::in);
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::istringstream ss(line);
+    std::array<u32, 4> vid;
+    u64 num_verts;
+    std::string name;
+    if (!(ss >> std::hex >> vid[0] >> vid[1] >> vid[2] >> vid[3] >> std::dec >> num_verts))
+      continue;
+    ss >> name;
+    auto& format = formats[vid];
+    format.first += num_verts;
+    format.second = name;
+  }
+  in.close();
+
+  for (const auto& iter : s_vertex_loader_map)
+  {
+    const VertexLoaderBase* loader = iter.second.get();
+    u64 num_verts = loader->m_numLoadedVertices;
+    if (const VertexLoaderBase* fallback = iter.second->GetFallback())
+      num_verts += fallback->m_numLoadedVertices;
+    if (num_verts == 0)
+      continue;
+
+    const std::array<u32, 4> vid = {{iter.first.GetElement(0), iter.first.GetElement(1),
+                                     iter.first.GetElement(2), iter.first.GetElement(3)}};
+    auto& format = formats[vid];
+    format.first += num_verts;
+    format.second = loader->GetName();
+  }
+
+  std::ofstream out;
+  File::OpenFStream(out, filename, std::ios_base::out | std::ios_base::trunc);
+  out << "# Vertex loader profile for " << last_game_code << "\n";
+  for (const auto& format : formats)
+  {
+    out << StringFromFormat("%08x %08x %08x %08x %" PRIu64 " %s\n", format.first[0],
+                            format.first[1], format.first[2], format.first[3],
+                            format.second.first, format.second.second.c_str());
+  }
+}
+
 void Shutdown()
 {
+  if (g_ActiveConfig.bDumpVertexLoaderProfile)
+    DumpVertexLoaderProfile();
+  // The cached vertices refer to the loaders.
+  DLCache::Clear();
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
@@ -241,7 +339,7 @@ inline void UpdateLoader(const VertexLoaderParameters &parameters)
   g_main_cp_state.last_id = parameters.vtx_attr_group;
 }
 
-bool ConvertVertices(VertexLoaderParameters &parameters, u32 &readsize, u32 &writesize)
+static VertexLoaderBase* GetActiveLoader(const VertexLoaderParameters &parameters)
 {
   if (parameters.needloaderrefresh)
   {
@@ -252,15 +350,12 @@ bool ConvertVertices(VertexLoaderParameters &parameters, u32 &readsize, u32 &wri
   {
     loader = loader->GetFallback();
   }
-  readsize = parameters.count * loader->m_VertexSize;
-  if (parameters.buf_size < readsize)
-    return false;
-  if (parameters.skip_draw)
-  {
-    return true;
-  }
-  // Lookup pointers for any vertex arrays.
-  UpdateVertexArrayPointers();
+  return loader;
+}
+
+// Switches to the loader's vertex format and makes room for the vertices in the vertex buffer.
+static void PrepareForVertices(VertexLoaderBase* loader, VertexLoaderParameters &parameters)
+{
   NativeVertexFormat *nativefmt = loader->m_native_vertex_format;
   // Flush if our vertex format is different from the currently set.
   if (s_current_vtx_fmt != nullptr && s_current_vtx_fmt != nativefmt)
@@ -271,12 +366,237 @@ bool ConvertVertices(VertexLoaderParameters &parameters, u32 &readsize, u32 &wri
   g_current_components = loader->m_native_components;
   VertexShaderManager::SetVertexFormat(loader->m_native_components);
   g_vertex_manager->PrepareForAdditionalData(parameters.primitive, parameters.count, loader->m_native_stride);
+  // Matrix indices from the vertices make any matrix write visible to the batch. PosMatIdx and
+  // Tex0MatIdx to Tex7MatIdx are the lowest 9 bits.
+  if (loader->GetVtxDesc().Hex & 0x1FF)
+    g_vertex_manager->SetVertexMatrixIndicesUsed();
   parameters.destination = g_vertex_manager->GetCurrentBufferPointer();
-  s32 finalcount = loader->RunVertices(parameters);
-  writesize = loader->m_native_stride * finalcount;
+}
+
+namespace
+{
+// Loading a vertex takes a few nanoseconds, so a range needs about a thousand of them to
+// outweigh waking a worker for it and waiting on it. Draws are only split once every worker of
+// a four core machine gets such a range.
+constexpr int PARALLEL_MIN_VERTICES = 4096;
+constexpr int PARALLEL_RANGE_MIN_VERTICES = 1024;
+constexpr u32 PARALLEL_MAX_RANGES = 16;
+
+// Splits the vertices of a large draw into ranges that the thread pool converts. The GPU thread
+// converts ranges too and waits for the rest, so nothing changes the state the loader reads in
+// the meantime, and no range is left waiting for a sleeping worker.
+class ParallelVertexLoader final : public Common::IWorker
+{
+public:
+  ParallelVertexLoader()
+  {
+    Common::ThreadPool::RegisterWorker(this);
+  }
+  ~ParallelVertexLoader()
+  {
+    Common::ThreadPool::UnregisterWorker(this);
+  }
+
+  bool NextTask(size_t ID) override
+  {
+    return LoadNextRange();
+  }
+
+  s32 Run(VertexLoaderBase* loader, const VertexLoaderParameters& parameters)
+  {
+    u32 num_ranges = std::min<u32>(parameters.count / PARALLEL_RANGE_MIN_VERTICES,
+                                   static_cast<u32>(Common::ThreadPool::GetThreadCount()) + 1);
+    num_ranges = std::min(num_ranges, PARALLEL_MAX_RANGES);
+    if (num_ranges < 2)
+      return loader->RunVertices(parameters);
+
+    loader->PrepareParallelLoading(parameters);
+    m_loader = loader;
+    m_parameters = parameters;
+    m_range_size = (parameters.count + num_ranges - 1) / num_ranges;
+    m_pending.store(num_ranges, std::memory_order_relaxed);
+    // The number of ranges is part of the claim counter, so that a worker that is late for the
+    // previous draw can't claim a range of this one against a stale count.
+    m_claim.store(u64(num_ranges) << 32, std::memory_order_release);
+    for (u32 i = 1; i < num_ranges; i++)
+      Common::ThreadPool::NotifyWorkPending();
+
+    while (LoadNextRange())
+    {
+    }
+    size_t loop_count = 0;
+    while (m_pending.load(std::memory_order_acquire) > 0)
+      Common::cYield(loop_count++);
+
+    // Ranges that skipped vertices left gaps, close them.
+    const u32 stride = loader->m_native_stride;
+    u32 total = m_loaded[0];
+    for (u32 i = 1; i < num_ranges; i++)
+    {
+      if (total != i * m_range_size && m_loaded[i] > 0)
+      {
+        std::memmove(parameters.destination + total * stride,
+                     parameters.destination + i * m_range_size * stride, m_loaded[i] * stride);
+      }
+      total += m_loaded[i];
+    }
+    return static_cast<s32>(total);
+  }
+
+private:
+  bool LoadNextRange()
+  {
+    const u64 claim = m_claim.fetch_add(1, std::memory_order_acquire);
+    const u32 index = static_cast<u32>(claim);
+    if (index >= static_cast<u32>(claim >> 32))
+      return false;
+
+    const u32 start = index * m_range_size;
+    const u32 end = std::min<u32>(start + m_range_size, m_parameters.count);
+    u32 loaded = 0;
+    if (start < end)
+    {
+      VertexLoaderParameters range = m_parameters;
+      range.source += start * m_loader->m_VertexSize;
+      range.destination += start * m_loader->m_native_stride;
+      range.count = end - start;
+      range.buf_size = range.count * m_loader->m_VertexSize;
+      loaded = m_loader->LoadRange(range);
+    }
+    m_loaded[index] = loaded;
+    m_pending.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+
+  VertexLoaderBase* m_loader = nullptr;
+  VertexLoaderParameters m_parameters = {};
+  u32 m_range_size = 0;
+  std::array<u32, PARALLEL_MAX_RANGES> m_loaded = {};
+  std::atomic<u32> m_pending{0};
+  // Number of ranges in the upper half, next range to claim in the lower half.
+  std::atomic<u64> m_claim{0};
+};
+}
+
+static s32 RunVertices(VertexLoaderBase* loader, const VertexLoaderParameters &parameters)
+{
+  TRACE_SCOPE("GPU", "Vertex load");
+  if (parameters.count < PARALLEL_MIN_VERTICES || !loader->SupportsParallelLoading())
+    return loader->RunVertices(parameters);
+
+  static ParallelVertexLoader s_parallel_loader;
+  return s_parallel_loader.Run(loader, parameters);
+}
+
+static s32 RunVerticesTimed(VertexLoaderBase* loader, const VertexLoaderParameters &parameters)
+{
+  if (!g_ActiveConfig.bOverlayStats)
+    return RunVertices(loader, parameters);
+
+  const auto start = std::chrono::steady_clock::now();
+  s32 count = RunVertices(loader, parameters);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  loader->m_frame_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  loader->m_frame_timed_vertices += parameters.count;
+  return count;
+}
+
+static void AddVertices(VertexLoaderBase* loader, const VertexLoaderParameters &parameters,
+                        s32 finalcount)
+{
+  loader->m_frame_vertices += parameters.count;
   IndexGenerator::AddIndices(parameters.primitive, finalcount);
   ADDSTAT(stats.thisFrame.numPrims, finalcount);
   INCSTAT(stats.thisFrame.numPrimitiveJoins);
+}
+
+bool ConvertVertices(VertexLoaderParameters &parameters, u32 &readsize, u32 &writesize)
+{
+  VertexLoaderBase* loader = GetActiveLoader(parameters);
+  readsize = parameters.count * loader->m_VertexSize;
+  if (parameters.buf_size < readsize)
+    return false;
+  if (parameters.skip_draw)
+  {
+    return true;
+  }
+  // Lookup pointers for any vertex arrays.
+  UpdateVertexArrayPointers();
+  PrepareForVertices(loader, parameters);
+  s32 finalcount;
+  if (parameters.count >= GPUVertexDecoder::MIN_VERTICES && g_ActiveConfig.UseGPUVertexDecoding() &&
+      !(g_ActiveConfig.iBBoxMode == BBoxCPU && BoundingBox::active) &&
+      g_vertex_manager->DecodeVerticesOnGPU(loader, parameters))
+  {
+    const bool decode_slope_vertices = g_vertex_manager->IsZSlopeEnabled();
+    if (decode_slope_vertices)
+      GPUVertexDecoder::DecodeSlopeVertices(loader, parameters);
+    g_vertex_manager->SetSlopeVerticesValid(decode_slope_vertices);
+    finalcount = parameters.count;
+  }
+  else
+  {
+    finalcount = RunVerticesTimed(loader, parameters);
+    g_vertex_manager->SetSlopeVerticesValid(true);
+  }
+  writesize = loader->m_native_stride * finalcount;
+  AddVertices(loader, parameters, finalcount);
+  return true;
+}
+
+bool ConvertVerticesCached(VertexLoaderParameters &parameters, u32 &writesize, CachedVertices &cache)
+{
+  VertexLoaderBase* loader = GetActiveLoader(parameters);
+  const u32 readsize = parameters.count * loader->m_VertexSize;
+  if (parameters.buf_size != readsize)
+    return false;
+  if (parameters.skip_draw)
+  {
+    return true;
+  }
+
+  const u32 matrix_index = g_main_cp_state.matrix_index_a.Hex;
+  if (cache.loader == loader && cache.matrix_index_a == matrix_index)
+  {
+    PrepareForVertices(loader, parameters);
+    std::memcpy(parameters.destination, cache.data.data(), cache.data.size());
+    writesize = static_cast<u32>(cache.data.size());
+    AddVertices(loader, parameters, cache.count);
+    return true;
+  }
+
+  // Indexed attributes read from memory outside of the display list, and a CPU bounding box is
+  // updated while the vertices are converted. Neither can be replayed from a copy.
+  cache.loader = nullptr;
+  cache.data.clear();
+  bool cacheable = !(g_ActiveConfig.iBBoxMode == BBoxCPU && BoundingBox::active);
+  for (int i = 0; i < 12 && cacheable; i++)
+    cacheable = parameters.VtxDesc->GetVertexArrayStatus(i) < INDEX8;
+
+  UpdateVertexArrayPointers();
+  PrepareForVertices(loader, parameters);
+  if (!cacheable)
+  {
+    s32 finalcount = RunVerticesTimed(loader, parameters);
+    writesize = loader->m_native_stride * finalcount;
+    AddVertices(loader, parameters, finalcount);
+    return true;
+  }
+
+  // The destination is usually mapped GPU memory, which is slow to read back. Convert into the
+  // cache and copy from there instead. The loaders can write up to 4 bytes past the end.
+  cache.data.resize(parameters.count * loader->m_native_stride + 4);
+  VertexLoaderParameters cache_parameters = parameters;
+  cache_parameters.destination = cache.data.data();
+  s32 finalcount = RunVerticesTimed(loader, cache_parameters);
+  writesize = loader->m_native_stride * finalcount;
+  cache.data.resize(writesize);
+  std::memcpy(parameters.destination, cache.data.data(), writesize);
+  AddVertices(loader, parameters, finalcount);
+
+  cache.loader = loader;
+  cache.matrix_index_a = matrix_index;
+  cache.count = finalcount;
   return true;
 }
 
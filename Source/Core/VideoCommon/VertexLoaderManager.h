@@ -5,6 +5,7 @@
 #pragma once
 #include <string>
 #include <map>
+#include <vector>
 #include "Common/Common.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -32,10 +33,27 @@ int GetVertexSize(const VertexLoaderParameters &parameters);
 
 bool ConvertVertices(VertexLoaderParameters &parameters, u32 &readsize, u32 &writesize);
 
+// Converted vertices of one draw in a display list, see DLCache. They stay valid as long as the
+// same loader runs on the same bytes with the same default matrix index.
+struct CachedVertices
+{
+  VertexLoaderBase* loader = nullptr;
+  u32 matrix_index_a = 0;
+  s32 count = 0;
+  std::vector<u8> data;
+};
+
+// Like ConvertVertices, but copies the vertices from cache if it matches the current state, and
+// refreshes cache otherwise. Fails if the source isn't exactly count vertices long, which
+// happens when the vertex format changed since the display list was recorded.
+bool ConvertVerticesCached(VertexLoaderParameters &parameters, u32 &writesize, CachedVertices &cache);
+
 void GetVertexSizeAndComponents(const VertexLoaderParameters &parameters, u32 &vertexsize, u32 &components);
 
-// For debugging
+// For the statistics overlay: the loaders used in the current frame with their kind, vertex count
+// and conversion time, busiest first.
 void AppendListToString(std::string *dest);
+void ResetFrameStatistics();
 
 void UpdateVertexArrayPointers();
 
@@ -49,6 +49,46 @@ static __m128 scale_factors[13] = {
     _mm_set_ps1(0.0f)
 };
 
+static const __m128i shuffle_lut[5][3] = {
+    { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),  // 1x u8
+    _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),  // 2x u8
+    _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L) }, // 3x u8
+    { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),  // 1x s8
+    _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),  // 2x s8
+    _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL) }, // 3x s8
+    { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),  // 1x u16
+    _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),  // 2x u16
+    _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L) }, // 3x u16
+    { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),  // 1x s16
+    _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),  // 2x s16
+    _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL) }, // 3x s16
+    { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),  // 1x float
+    _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),  // 2x float
+    _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L) }, // 3x float
+};
+
+// shuffle_lut with every mask repeated in the upper lane, for VPSHUFB on two vertices at once.
+struct WideShuffleLUT
+{
+  u8 masks[5][3][32];
+};
+
+static WideShuffleLUT MakeWideShuffleLUT()
+{
+  WideShuffleLUT lut;
+  for (int format = 0; format < 5; ++format)
+  {
+    for (int count = 0; count < 3; ++count)
+    {
+      memcpy(&lut.masks[format][count][0], &shuffle_lut[format][count], 16);
+      memcpy(&lut.masks[format][count][16], &shuffle_lut[format][count], 16);
+    }
+  }
+  return lut;
+}
+
+static const WideShuffleLUT shuffle_lut_256 = MakeWideShuffleLUT();
+
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att) : VertexLoaderBase(vtx_desc, vtx_att)
 {
   if (!IsInitialized())
@@ -57,12 +97,49 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att) :
   AllocCodeSpace(1024);
   ClearCodeSpace();
   GenerateVertexLoader();
+
+  // The paired loop needs to know the size of a vertex up front, and that's only known once the
+  // single vertex loop has been generated, so generate everything a second time.
+  if (cpu_info.bAVX2 && CanPairVertices())
+  {
+    m_paired_loop = true;
+    m_native_components = 0;
+    ClearCodeSpace();
+    GenerateVertexLoader();
+  }
   WriteProtect();
 
   std::string name = GetName();
   JitRegister::Register(region, GetCodePtr(), name.c_str());
 }
 
+// With AVX2, two vertices can be converted at once. That only pays off for small formats: a
+// position plus at most one more direct normal or texture coordinate, and nothing that has to be
+// loaded with scalar code. Indexed attributes need one address calculation per vertex either way,
+// and on wider formats the interleaved stores of both vertices cost more than the halved
+// conversion work. Everything else keeps using the single vertex loop.
+bool VertexLoaderX64::CanPairVertices() const
+{
+  // Texture matrix indices and colors.
+  if ((m_VtxDesc.Hex & 0x1FE) || m_VtxDesc.Color0 || m_VtxDesc.Color1)
+    return false;
+
+  const u64 attributes[10] = {
+      m_VtxDesc.Position,  m_VtxDesc.Normal,    m_VtxDesc.Tex0Coord, m_VtxDesc.Tex1Coord,
+      m_VtxDesc.Tex2Coord, m_VtxDesc.Tex3Coord, m_VtxDesc.Tex4Coord, m_VtxDesc.Tex5Coord,
+      m_VtxDesc.Tex6Coord, m_VtxDesc.Tex7Coord,
+  };
+  int count = 1;
+  for (int i = 0; i < 10; i++)
+  {
+    if (attributes[i] & MASKINDEXED)
+      return false;
+    if (i && attributes[i])
+      count += i == 1 && m_VtxAttr.NormalElements ? 3 : 1;
+  }
+  return count <= 2;
+}
+
 OpArg VertexLoaderX64::GetVertexAddr(int array, u64 attribute)
 {
   OpArg data = MDisp(src_reg, m_src_ofs);
@@ -87,25 +164,67 @@ OpArg VertexLoaderX64::GetVertexAddr(int array, u64 attribute)
   }
 }
 
+// Like ReadVertex, but converts a direct attribute of two consecutive vertices at once, one in
+// each half of XMM0.
+void VertexLoaderX64::ReadVertexPair(u32 src_ofs, u64 attribute, int format, int count_in,
+                                     int count_out, bool dequantize, X64Reg scaling_register)
+{
+  int elem_size = 1 << (format / 2);
+  int load_bytes = elem_size * count_in;
+  if (attribute == DIRECT)
+    m_src_ofs += load_bytes;
+
+  for (u32 i = 0; i < 2; i++)
+  {
+    OpArg data = MDisp(src_reg, src_ofs + i * m_VertexSize);
+    X64Reg coords = i ? XMM1 : XMM0;
+    if (load_bytes > 8)
+      VMOVDQU(coords, data);
+    else if (load_bytes > 4)
+      VMOVQ_xmm(coords, data);
+    else
+      VMOVD_xmm(coords, data);
+  }
+  VINSERTI128(XMM0, XMM0, R(XMM1), 1);
+
+  VPSHUFB(256, XMM0, XMM0, MPIC(&shuffle_lut_256.masks[format][count_in - 1]));
+  if (format == FORMAT_BYTE)
+    VPSRAD(256, XMM0, XMM0, 24);
+  if (format == FORMAT_SHORT)
+    VPSRAD(256, XMM0, XMM0, 16);
+
+  if (format != FORMAT_FLOAT)
+  {
+    VCVTDQ2PS(256, XMM0, R(XMM0));
+    if (dequantize)
+      VMULPS(256, XMM0, XMM0, R(scaling_register));
+  }
+  OpArg dest = MDisp(dst_reg, m_dst_ofs);
+  OpArg next_dest = MDisp(dst_reg, m_dst_ofs + m_native_stride);
+  m_dst_ofs += sizeof(float) * count_out;
+  if (count_out == 3)
+  {
+    // Both stores write 16 bytes, like MOVUPS in ReadVertex.
+    VMOVUPS(dest, XMM0);
+    VEXTRACTI128(next_dest, XMM0, 1);
+    return;
+  }
+
+  VEXTRACTI128(R(XMM1), XMM0, 1);
+  if (count_out == 1)
+  {
+    VMOVSS(dest, XMM0);
+    VMOVSS(next_dest, XMM1);
+  }
+  else
+  {
+    VMOVLPS(dest, XMM0);
+    VMOVLPS(next_dest, XMM1);
+  }
+}
+
 int VertexLoaderX64::ReadVertex(OpArg data, u64 attribute, int format, int count_in, int count_out, bool dequantize, AttributeFormat* native_format, X64Reg scaling_register)
 {
-  static const __m128i shuffle_lut[5][3] = {
-      { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),  // 1x u8
-      _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),  // 2x u8
-      _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L) }, // 3x u8
-      { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),  // 1x s8
-      _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),  // 2x s8
-      _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL) }, // 3x s8
-      { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),  // 1x u16
-      _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),  // 2x u16
-      _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L) }, // 3x u16
-      { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),  // 1x s16
-      _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),  // 2x s16
-      _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL) }, // 3x s16
-      { _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),  // 1x float
-      _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),  // 2x float
-      _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L) }, // 3x float
-  };
 
   X64Reg coords = XMM0;
   int elem_size = 1 << (format / 2);
@@ -367,6 +486,68 @@ void VertexLoaderX64::ReadColor(OpArg data, u64 attribute, int format)
     m_src_ofs += load_bytes;
 }
 
+// One iteration of the paired loop. The layout of both vertices is exactly what the single vertex
+// loop produces; this relies on m_VertexSize and m_native_stride from the first generation pass.
+void VertexLoaderX64::GenerateVertexPair()
+{
+  const u64 tc[8] = {
+      m_VtxDesc.Tex0Coord, m_VtxDesc.Tex1Coord, m_VtxDesc.Tex2Coord, m_VtxDesc.Tex3Coord,
+      m_VtxDesc.Tex4Coord, m_VtxDesc.Tex5Coord, m_VtxDesc.Tex6Coord, m_VtxDesc.Tex7Coord,
+  };
+
+  if (m_VtxDesc.PosMatIdx)
+    m_src_ofs++;
+
+  ReadVertexPair(m_src_ofs, m_VtxDesc.Position, m_VtxAttr.PosFormat, m_VtxAttr.PosElements + 2, 3,
+                 m_VtxAttr.ByteDequant, XMM2);
+
+  if (m_VtxDesc.Normal)
+  {
+    int load_bytes = (1 << (m_VtxAttr.NormalFormat / 2)) * 3;
+    for (int i = 0; i < (m_VtxAttr.NormalElements ? 3 : 1); i++)
+    {
+      // Same as the single vertex loop, which adds the NormalIndex3 offset to direct normals too.
+      u32 src_ofs = m_src_ofs + (m_VtxAttr.NormalIndex3 ? i * load_bytes : 0);
+      ReadVertexPair(src_ofs, m_VtxDesc.Normal, m_VtxAttr.NormalFormat, 3, 3, true, XMM3);
+    }
+  }
+
+  for (int i = 0; i < 8; i++)
+  {
+    int elements = m_VtxAttr.texCoord[i].Elements + 1;
+    if (tc[i])
+    {
+      ReadVertexPair(m_src_ofs, tc[i], m_VtxAttr.texCoord[i].Format, elements, elements,
+                     m_VtxAttr.ByteDequant, static_cast<X64Reg>(XMM4 + i));
+    }
+  }
+
+  for (u32 v = 0; v < 2; v++)
+    WritePosMatrixIndex(v * m_VertexSize, m_dst_ofs + v * m_native_stride);
+}
+
+void VertexLoaderX64::WritePosMatrixIndex(u32 src_ofs, u32 dst_ofs)
+{
+  if (m_VtxDesc.PosMatIdx)
+  {
+    MOVZX(32, 8, scratch1, MDisp(src_reg, src_ofs));
+  }
+  else
+  {
+    MOV(32, R(scratch1), MPIC(&g_main_cp_state.matrix_index_a));
+  }
+  AND(32, R(scratch1), Imm8(0x3F));
+  MOV(32, MDisp(dst_reg, dst_ofs), R(scratch1));
+}
+
+void VertexLoaderX64::LoadScale(X64Reg reg, const void* scale)
+{
+  if (m_paired_loop)
+    VBROADCASTSS(256, reg, MPIC(scale));
+  else
+    MOVAPD(reg, MPIC(scale));
+}
+
 void VertexLoaderX64::GenerateVertexLoader()
 {
   BitSet32 regs = { src_reg, dst_reg, scratch1, scratch2, scratch3, count_reg, skipped_reg, base_reg };
@@ -383,11 +564,11 @@ void VertexLoaderX64::GenerateVertexLoader()
   // Load Contants into registers outside the main loop to reduce memory overhead
   if (m_VtxAttr.PosFormat != FORMAT_FLOAT && m_VtxAttr.ByteDequant)
   {
-    MOVAPD(XMM2, MPIC(&scale_factors[0]));
+    LoadScale(XMM2, &scale_factors[0]);
   }
   if (m_VtxDesc.Normal)
   {
-    MOVAPD(XMM3, MPIC(&scale_factors[m_VtxAttr.NormalFormat + 1]));
+    LoadScale(XMM3, &scale_factors[m_VtxAttr.NormalFormat + 1]);
   }
 
   const u64 tc[8] = {
@@ -405,7 +586,7 @@ void VertexLoaderX64::GenerateVertexLoader()
     {
       if (tc[i] && m_VtxAttr.texCoord[i].Format != FORMAT_FLOAT)
       {
-        MOVAPD(treg[i], MPIC(&scale_factors[5 + i]));
+        LoadScale(treg[i], &scale_factors[5 + i]);
       }
     }
   }
@@ -413,6 +594,32 @@ void VertexLoaderX64::GenerateVertexLoader()
   if (m_VtxDesc.Position & MASKINDEXED)
     XOR(32, R(skipped_reg), R(skipped_reg));
 
+  m_src_ofs = 0;
+  m_dst_ofs = 0;
+
+  const u8* pair_loop = nullptr;
+  FixupBranch done;
+  if (m_paired_loop)
+  {
+    pair_loop = GetCodePtr();
+    CMP(32, R(count_reg), Imm8(2));
+    FixupBranch to_single = J_CC(CC_L, true);
+
+    GenerateVertexPair();
+
+    ADD(64, R(dst_reg), Imm32(2 * m_native_stride));
+    ADD(64, R(src_reg), Imm32(2 * m_VertexSize));
+    SUB(32, R(count_reg), Imm8(2));
+    J_CC(CC_NZ, pair_loop);
+    VZEROUPPER();
+    done = J(true);
+
+    SetJumpTarget(to_single);
+    VZEROUPPER();
+    m_src_ofs = 0;
+    m_dst_ofs = 0;
+  }
+
   const u8* loop_start = GetCodePtr();
 
   if (m_VtxDesc.PosMatIdx)
@@ -504,16 +711,7 @@ void VertexLoaderX64::GenerateVertexLoader()
       }
     }
   }
-  if (m_VtxDesc.PosMatIdx)
-  {
-    MOVZX(32, 8, scratch1, MDisp(src_reg, 0));
-  }
-  else
-  {
-    MOV(32, R(scratch1), MPIC(&g_main_cp_state.matrix_index_a));
-  }
-  AND(32, R(scratch1), Imm8(0x3F));
-  MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
+  WritePosMatrixIndex(0, m_dst_ofs);
   m_native_vtx_decl.posmtx.components = 4;
   m_native_vtx_decl.posmtx.enable = true;
   m_native_vtx_decl.posmtx.offset = m_dst_ofs;
@@ -527,7 +725,10 @@ void VertexLoaderX64::GenerateVertexLoader()
   ADD(64, R(src_reg), Imm32(m_src_ofs));
 
   SUB(32, R(count_reg), Imm8(1));
-  J_CC(CC_NZ, loop_start);
+  J_CC(CC_NZ, m_paired_loop ? pair_loop : loop_start);
+
+  if (m_paired_loop)
+    SetJumpTarget(done);
 
   // Get the original count.
   POP(32, R(ABI_RETURN));
@@ -558,6 +759,14 @@ bool VertexLoaderX64::EnvironmentIsSupported()
 }
 
 int VertexLoaderX64::RunVertices(const VertexLoaderParameters &parameters)
+{
+  PrepareParallelLoading(parameters);
+  return LoadRange(parameters);
+}
+
+// The generated code only reads the scale factors and the CP state, which don't change while the
+// ranges of a draw are being converted.
+void VertexLoaderX64::PrepareParallelLoading(const VertexLoaderParameters &parameters)
 {
   const VAT &vat = *parameters.VtxAttr;
   scale_factors[0] = _mm_set_ps1(fractionTable[vat.g0.PosFrac]);
@@ -573,5 +782,9 @@ int VertexLoaderX64::RunVertices(const VertexLoaderParameters &parameters)
     scale_factors[12] = _mm_set_ps1(fractionTable[vat.g2.Tex7Frac]);
   }
   m_numLoadedVertices += parameters.count;
+}
+
+s32 VertexLoaderX64::LoadRange(const VertexLoaderParameters &parameters)
+{
   return ((int(*)(const u8* src, u8* dst, int count, const void*))region)(parameters.source, parameters.destination, parameters.count, memory_base_ptr);
 }
@@ -11,14 +11,32 @@ protected:
   {
     return true;
   }
+  bool IsJIT() const override
+  {
+    return true;
+  }
   int RunVertices(const VertexLoaderParameters &parameters) override;
+  bool SupportsParallelLoading() const override
+  {
+    return true;
+  }
+  void PrepareParallelLoading(const VertexLoaderParameters &parameters) override;
+  s32 LoadRange(const VertexLoaderParameters &parameters) override;
   bool EnvironmentIsSupported() override;
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
+  // Set for the AVX2 loop that converts two vertices per iteration.
+  bool m_paired_loop = false;
   Gen::FixupBranch m_skip_vertex;
   Gen::OpArg GetVertexAddr(int array, u64 attribute);
+  bool CanPairVertices() const;
   int ReadVertex(Gen::OpArg data, u64 attribute, int format, int count_in, int count_out, bool dequantize, AttributeFormat* native_format, Gen::X64Reg scaling_register);
+  void ReadVertexPair(u32 src_ofs, u64 attribute, int format, int count_in, int count_out,
+                      bool dequantize, Gen::X64Reg scaling_register);
   void ReadColor(Gen::OpArg data, u64 attribute, int format);
+  void WritePosMatrixIndex(u32 src_ofs, u32 dst_ofs);
+  void LoadScale(Gen::X64Reg reg, const void* scale);
+  void GenerateVertexPair();
   void GenerateVertexLoader();
 };
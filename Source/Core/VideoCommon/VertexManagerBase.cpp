@@ -7,8 +7,10 @@
 #include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
 
+#include "VideoCommon/AsyncRequests.h"
 #include "VideoCommon/BPStructs.h"
 #include "VideoCommon/Debugger.h"
 #include "VideoCommon/GeometryShaderManager.h"
@@ -73,6 +75,17 @@ inline u32 GetRemainingIndices(int prim)
 {
   OpcodeDecoder::GxDrawMode primitive = static_cast<OpcodeDecoder::GxDrawMode>(prim);
   u32 index_len = VertexManagerBase::MAXIBUFFERSIZE - IndexGenerator::GetIndexLen();
+  if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart && primitive <= OpcodeDecoder::GX_DRAW_TRIANGLE_FAN)
+  {
+    // Every strip ends with a restart index, see IndexGenerator.
+    if (primitive == OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP)
+      return index_len - 1;
+    if (primitive == OpcodeDecoder::GX_DRAW_TRIANGLE_FAN)
+      return index_len / 2 + 1;
+    if (primitive == OpcodeDecoder::GX_DRAW_TRIANGLES)
+      return index_len / 4 * 3;
+    return index_len / 5 * 4;
+  }
   if (primitive == OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP || primitive == OpcodeDecoder::GX_DRAW_TRIANGLE_FAN)
   {
     return index_len / 3 + 2;
@@ -130,7 +143,51 @@ void VertexManagerBase::PrepareForAdditionalData(int primitive, u32 count, u32 s
   {
     g_vertex_manager->ResetBuffer(stride);
     m_is_flushed = false;
+    m_vertex_matrix_indices_used = false;
+  }
+}
+
+bool VertexManagerBase::IsXFRangeUsed(u32 start, u32 end) const
+{
+  if (m_is_flushed)
+    return false;
+  if (m_vertex_matrix_indices_used)
+    return true;
+
+  auto overlaps = [start, end](u32 range_start, u32 range_size) {
+    return start < range_start + range_size && range_start < end;
+  };
+
+  // Position matrix of 3 rows of 4 floats, normal matrix of 3 rows of 3 floats.
+  const TMatrixIndexA& ma = g_main_cp_state.matrix_index_a;
+  const TMatrixIndexB& mb = g_main_cp_state.matrix_index_b;
+  if (overlaps(XFMEM_POSMATRICES + ma.PosNormalMtxIdx * 4, 12) ||
+      overlaps(XFMEM_NORMALMATRICES + (ma.PosNormalMtxIdx & 31) * 3, 9))
+  {
+    return true;
+  }
+
+  const u32 tex_matrices[8] = {ma.Tex0MtxIdx, ma.Tex1MtxIdx, ma.Tex2MtxIdx, ma.Tex3MtxIdx,
+                               mb.Tex4MtxIdx, mb.Tex5MtxIdx, mb.Tex6MtxIdx, mb.Tex7MtxIdx};
+  for (u32 i = 0; i < xfmem.numTexGen.numTexGens && i < 8; ++i)
+  {
+    if (overlaps(XFMEM_POSMATRICES + tex_matrices[i] * 4, 12))
+      return true;
   }
+  if (xfmem.dualTexTrans.enabled && overlaps(XFMEM_POSTMATRICES, XFMEM_POSTMATRICES_END - XFMEM_POSTMATRICES))
+    return true;
+
+  // Forced lighting lights everything, regardless of the channels.
+  u32 light_mask = g_ActiveConfig.bForcedLighting ? 0xff : 0;
+  for (u32 i = 0; i < xfmem.numChan.numColorChans && i < 2; ++i)
+    light_mask |= xfmem.color[i].GetFullLightMask() | xfmem.alpha[i].GetFullLightMask();
+  for (u32 i = 0; i < 8; ++i)
+  {
+    if ((light_mask & (1 << i)) && overlaps(XFMEM_LIGHTS + i * 0x10, 0x10))
+      return true;
+  }
+
+  return false;
 }
 
 std::pair<size_t, size_t> VertexManagerBase::ResetFlushAspectRatioCount()
@@ -210,6 +267,10 @@ static void SetSamplerState(u32 index, bool custom_tex, bool has_arbitrary_mips,
 
 void VertexManagerBase::DoFlush()
 {
+  TRACE_SCOPE("GPU", "Flush");
+  AsyncRequests::GetInstance()->FlushEFBPokes();
+  g_renderer->OnEFBModified();
+
   // loading a state will invalidate BP, so check for it
   NativeVertexFormat* current_vertex_format = VertexLoaderManager::GetCurrentVertexFormat();
   g_video_backend->CheckInvalidState();
@@ -338,9 +399,12 @@ void VertexManagerBase::DoFlush()
         m_zslope_refresh_required = false;
       }
     }
-    else if (IndexGenerator::GetIndexLen() >= 3)
+    else if (m_zslope_enabled && m_slope_vertices_valid)
     {
-      CalculateZSlope(vtx_dcl, g_vertex_manager->GetIndexBuffer() + IndexGenerator::GetIndexLen() - 3);
+      // With primitive restart, the last triangle is followed by a restart index.
+      const u32 restart = g_ActiveConfig.backend_info.bSupportsPrimitiveRestart ? 1 : 0;
+      if (IndexGenerator::GetIndexLen() >= 3 + restart)
+        CalculateZSlope(vtx_dcl, g_vertex_manager->GetIndexBuffer() + IndexGenerator::GetIndexLen() - 3 - restart);
     }
 
     // if cull mode is CULL_ALL, ignore triangles and quads
@@ -375,6 +439,8 @@ void VertexManagerBase::DoFlush()
 
 void VertexManagerBase::DoState(PointerWrap& p)
 {
+  if (p.GetMode() == PointerWrap::MODE_READ && bpmem.genMode.zfreeze)
+    m_zslope_enabled = true;
   g_vertex_manager->vDoState(p);
 }
 
@@ -17,6 +17,8 @@
 
 class NativeVertexFormat;
 class PointerWrap;
+class VertexLoaderBase;
+struct VertexLoaderParameters;
 
 struct Slope
 {
@@ -73,17 +75,44 @@ public:
   {
     return m_pEndBufferPointer - m_pCurBufferPointer;
   }
+
+  // Writes to XF memory only have to end the current batch if its vertices can read the written
+  // words. That is known exactly from the matrix indices and lighting state, unless the vertices
+  // carry their own matrix indices.
+  bool IsXFRangeUsed(u32 start, u32 end) const;
+  void SetVertexMatrixIndicesUsed()
+  {
+    m_vertex_matrix_indices_used = true;
+  }
+
+  // Queues the conversion of the vertices at parameters.destination on the GPU, see
+  // GPUVertexDecoder. Returns false if the CPU loader has to convert them.
+  virtual bool DecodeVerticesOnGPU(VertexLoaderBase* loader,
+                                   const VertexLoaderParameters& parameters)
+  {
+    return false;
+  }
+
+  // The depth slope for zfreeze is only tracked once a game enabled zfreeze, most never do.
+  void EnableZSlope() { m_zslope_enabled = true; }
+  bool IsZSlopeEnabled() const { return m_zslope_enabled; }
+  // Whether the CPU copy of the last draw's vertices holds its last triangle.
+  void SetSlopeVerticesValid(bool valid) { m_slope_vertices_valid = valid; }
 protected:
   bool m_is_flushed = true;
   bool m_shader_refresh_required = true;
   bool m_zslope_refresh_required = true;
   Slope m_zslope = { 0.0f, 0.0f, float(0xFFFFFF) };
+  bool m_zslope_enabled = false;
+  bool m_slope_vertices_valid = true;
   PrimitiveType m_current_primitive_type = PrimitiveType::Points;
   u8 *m_pCurBufferPointer = nullptr;
   u8 *m_pBaseBufferPointer = nullptr;
   u8 *m_pEndBufferPointer = nullptr;
 
   bool m_cull_all = false;
+  // Set if a draw of the current batch has per-vertex matrix indices.
+  bool m_vertex_matrix_indices_used = false;
 
   void CalculateZSlope(const PortableVertexDeclaration &vert_decl, const u16* indices);
   virtual void vDoState(PointerWrap& p) {}
@@ -13,6 +13,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DriverDetails.h"
+#include "VideoCommon/GeometryShaderGen.h"
 #include "VideoCommon/LightingShaderGen.h"
 #include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VideoConfig.h"
@@ -153,7 +154,11 @@ inline void GenerateVertexShader(ShaderCode& out, API_TYPE api_type,
       GenerateVSOutputMembers(
           out, api_type, uid_data.pixel_lighting, uid_data.numTexGens,
           GetInterpolationQualifier(api_type, hostconfig.msaa, hostconfig.ssaa, false, true));
+      if (hostconfig.vs_stereo)
+        out.Write("\tflat int layer;\n");
       out.Write("} vs;\n");
+      if (hostconfig.vs_stereo)
+        GenerateGeometryShaderConstants(out, api_type);
     }
     else
     {
@@ -544,7 +549,11 @@ inline void GenerateVertexShader(ShaderCode& out, API_TYPE api_type,
   {
     if (hostconfig.backend_geometry_shaders || api_type == API_VULKAN)
     {
+      if (hostconfig.vs_stereo)
+        GenerateVertexShaderStereo(out, "o");
       AssignVSOutputMembers(out, api_type, "vs", "o", uid_data.pixel_lighting, uid_data.numTexGens);
+      if (hostconfig.vs_stereo)
+        out.Write("vs.layer = eye;\ngl_Layer = eye;\n");
     }
     else
     {
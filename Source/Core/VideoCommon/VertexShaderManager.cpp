@@ -189,7 +189,7 @@ static void ViewportCorrectionMatrix(Matrix44& result)
 void VertexShaderManager::Init()
 {
   Dirty();
-  m_buffer.Clear();
+  m_buffer.MarkAllDirty();
   memset(&xfmem, 0, sizeof(xfmem));
   ResetView();
 
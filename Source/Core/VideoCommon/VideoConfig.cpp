@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
 #include <mutex>
 
@@ -14,6 +15,7 @@
 #include "Core/Movie.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -28,6 +30,7 @@ void UpdateActiveConfig()
     Movie::SetGraphicsConfig();
   std::unique_lock<std::mutex> config_lock(config_mutex);
   g_ActiveConfig = g_Config;
+  InvalidateShaderUids();
 }
 void VideoConfig::ClearFormats()
 {
@@ -56,6 +59,12 @@ VideoConfig::VideoConfig()
   bTexDeposterize = false;
   iTexScalingType = 0;
   iTexScalingFactor = 2;
+  bTexScalingAsync = false;
+  bTexScalingGPU = false;
+  bTexScalingCache = false;
+  bTexScalingCacheCompress = true;
+  iTexScalingCacheSize = 1024;
+  iTextureMemoryBudget = 0;
   backend_info.bSupportsMultithreading = false;
   backend_info.bSupportsInternalResolutionFrameDumps = false;
   bEnableValidationLayer = false;
@@ -80,6 +89,8 @@ void VideoConfig::Refresh()
   }
   std::unique_lock<std::mutex> config_lock(config_mutex);
   bVSync = Config::Get(Config::GFX_VSYNC);
+  bLowLatency = Config::Get(Config::GFX_LOW_LATENCY);
+  bPacePresents = Config::Get(Config::GFX_PACE_PRESENTS);
   iAdapter = Config::Get(Config::GFX_ADAPTER);
 
   bWidescreenHack = Config::Get(Config::GFX_WIDESCREEN_HACK);
@@ -89,30 +100,42 @@ void VideoConfig::Refresh()
   bUseRealXFB = Config::Get(Config::GFX_USE_REAL_XFB);
   bBlackFrameInsertion = Config::Get(Config::GFX_USE_BLACK_FRAME_INSERTION);  
   iSafeTextureCache_ColorSamples = Config::Get(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES);
+  iTextureHashFunction = Config::Get(Config::GFX_TEXTURE_HASH_FUNCTION);
   bShowFPS = Config::Get(Config::GFX_SHOW_FPS);
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
   bLogRenderTimeToFile = Config::Get(Config::GFX_LOG_RENDER_TIME_TO_FILE);
   bOverlayStats = Config::Get(Config::GFX_OVERLAY_STATS);
   bOverlayProjStats = Config::Get(Config::GFX_OVERLAY_PROJ_STATS);
+  bOverlayFrameProfile = Config::Get(Config::GFX_OVERLAY_FRAME_PROFILE);
+  bLogFrameProfileToFile = Config::Get(Config::GFX_LOG_FRAME_PROFILE_TO_FILE);
   bDumpTextures = Config::Get(Config::GFX_DUMP_TEXTURES);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bHiresMaterialMaps = Config::Get(Config::GFX_HIRES_MATERIAL_MAPS);
   bHiresMaterialMapsBuild = Config::Get(Config::GFX_HIRES_MATERIAL_MAPS_BUILD);  
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
   bWaitForCacheHiresTextures = Config::Get(Config::GFX_WAIT_CACHE_HIRES_TEXTURES);
+  bPackHiresTextures = Config::Get(Config::GFX_PACK_HIRES_TEXTURES);
+  bCompressHiresTextures = Config::Get(Config::GFX_COMPRESS_HIRES_TEXTURES);
+  iHiresTextureNameVersion =
+      std::min(std::max(Config::Get(Config::GFX_HIRES_TEXTURE_NAME_VERSION), 1), 2);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
+  bDumpVertexLoaderProfile = Config::Get(Config::GFX_DUMP_VERTEX_LOADER_PROFILE);
+  bDumpShaderCompileStats = Config::Get(Config::GFX_DUMP_SHADER_COMPILE_STATS);
+  bDumpTextureCacheStats = Config::Get(Config::GFX_DUMP_TEXTURE_CACHE_STATS);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
   bFreeLook = Config::Get(Config::GFX_FREE_LOOK);
   bCompileShaderOnStartup = Config::Get(Config::GFX_COMPILE_SHADERS_ON_STARTUP);
   bUseFFV1 = Config::Get(Config::GFX_USE_FFV1);
   sDumpFormat = Config::Get(Config::GFX_DUMP_FORMAT);
   sDumpCodec = Config::Get(Config::GFX_DUMP_CODEC);
+  sDumpEncoder = Config::Get(Config::GFX_DUMP_ENCODER);
   sDumpPath = Config::Get(Config::GFX_DUMP_PATH);
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
   bInternalResolutionFrameDumps = Config::Get(Config::GFX_INTERNAL_RESOLUTION_FRAME_DUMPS);
   bEnableGPUTextureDecoding = Config::Get(Config::GFX_ENABLE_GPU_TEXTURE_DECODING);
   bEnableComputeTextureEncoding = Config::Get(Config::GFX_ENABLE_COMPUTE_TEXTURE_ENCODING);
+  bEnableGPUVertexDecoding = Config::Get(Config::GFX_ENABLE_GPU_VERTEX_DECODING);
   bEnablePixelLighting = Config::Get(Config::GFX_ENABLE_PIXEL_LIGHTING);
   bForcedLighting = Config::Get(Config::GFX_FORCED_LIGHTING);
   bForcePhongShading = Config::Get(Config::GFX_FORCE_PHONG_SHADING);
@@ -130,6 +153,7 @@ void VideoConfig::Refresh()
   bFastDepthCalc = Config::Get(Config::GFX_FAST_DEPTH_CALC);
   iMultisamples = Config::Get(Config::GFX_MSAA);
   bSSAA = Config::Get(Config::GFX_SSAA);
+  bPostProcessingAA = Config::Get(Config::GFX_POST_AA);
   iEFBScale = Config::Get(Config::GFX_EFB_SCALE);
   bTexFmtOverlayEnable = Config::Get(Config::GFX_TEXFMT_OVERLAY_ENABLE);
   bTexFmtOverlayCenter = Config::Get(Config::GFX_TEXFMT_OVERLAY_CENTER);
@@ -162,6 +186,8 @@ void VideoConfig::Refresh()
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
   bPostProcessingEnable = Config::Get(Config::GFX_ENHANCE_POST_ENABLED);
   iPostProcessingTrigger = Config::Get(Config::GFX_ENHANCE_POST_TRIGUER);
+  bPostProcessingBakeOptions = Config::Get(Config::GFX_ENHANCE_POST_BAKE_OPTIONS);
+  bPostProcessingDynamicScale = Config::Get(Config::GFX_ENHANCE_POST_DYNAMIC_SCALE);
   sPostProcessingShaders = Config::Get(Config::GFX_ENHANCE_POST_SHADERS);
   sScalingShader = Config::Get(Config::GFX_ENHANCE_SCALING_SHADER);
   bForceTrueColor = Config::Get(Config::GFX_ENHANCE_FORCE_TRUE_COLOR);
@@ -171,6 +197,13 @@ void VideoConfig::Refresh()
   iTexScalingType = Config::Get(Config::GFX_ENHANCE_TEXTURE_SCALING_TYPE);
   iTexScalingFactor = Config::Get(Config::GFX_ENHANCE_TEXTURE_SCALING_FACTOR);
   bTexDeposterize = Config::Get(Config::GFX_ENHANCE_USE_DEPOSTERIZE);
+  bTexScalingAsync = Config::Get(Config::GFX_ENHANCE_TEXTURE_SCALING_ASYNC);
+  bTexScalingGPU = Config::Get(Config::GFX_ENHANCE_TEXTURE_SCALING_GPU);
+  bTexScalingCache = Config::Get(Config::GFX_ENHANCE_TEXTURE_SCALING_CACHE);
+  bTexScalingCacheCompress = Config::Get(Config::GFX_ENHANCE_TEXTURE_SCALING_CACHE_COMPRESS);
+  iTexScalingCacheSize =
+      std::max(Config::Get(Config::GFX_ENHANCE_TEXTURE_SCALING_CACHE_SIZE), 16);
+  iTextureMemoryBudget = std::max(Config::Get(Config::GFX_ENHANCE_TEXTURE_MEMORY_BUDGET), 0);
 
   bTessellation = Config::Get(Config::GFX_ENHANCE_TESSELLATION);
   bTessellationEarlyCulling = Config::Get(Config::GFX_ENHANCE_TESSELLATION_EARLY_CULLING);
@@ -191,8 +224,10 @@ void VideoConfig::Refresh()
   bEFBAccessEnable = Config::Get(Config::GFX_HACK_EFB_ACCESS_ENABLE);
   bEFBFastAccess = Config::Get(Config::GFX_HACK_EFB_FAST_ACCESS_ENABLE);
   iBBoxMode = Config::Get(Config::GFX_HACK_BBOX_MODE);
+  iBBoxPredictionWindow = Config::Get(Config::GFX_HACK_BBOX_PREDICTION_WINDOW);
   bForceProgressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   bSkipEFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
+  bDeferEFBCopies = Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES);
   bCopyEFBScaled = Config::Get(Config::GFX_HACK_COPY_EFB_SCALED);
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUDING);
@@ -201,9 +236,14 @@ void VideoConfig::Refresh()
   bFullAsyncShaderCompilation = Config::Get(Config::GFX_HACK_FULL_ASYNC_SHADER_COMPILATION);
   bLastStoryEFBToRam = Config::Get(Config::GFX_HACK_LAST_HISTORY_EFBTORAM);
   bForceLogicOpBlend = Config::Get(Config::GFX_HACK_FORCE_LOGICOP_BLEND);
+  bDisplayListCache = Config::Get(Config::GFX_HACK_DISPLAY_LIST_CACHE);
+  bTrackTextureWrites = Config::Get(Config::GFX_HACK_TRACK_TEXTURE_WRITES);
+  bSkipDuplicateFrames = Config::Get(Config::GFX_HACK_SKIP_DUPLICATE_FRAMES);
+  bSkipDrawing = Config::Get(Config::GFX_HACK_SKIP_DRAWING);
 
   bBackgroundShaderCompiling = Config::Get(Config::GFX_BACKGROUND_SHADER_COMPILING);
   bDisableSpecializedShaders = Config::Get(Config::GFX_DISABLE_SPECIALIZED_SHADERS);
+  iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
 
   phack.m_enable = Config::Get(Config::GFX_PROJECTION_HACK) == 1;
   phack.m_sznear = Config::Get(Config::GFX_PROJECTION_HACK_SZNEAR) == 1;
@@ -211,6 +251,7 @@ void VideoConfig::Refresh()
   phack.m_znear = Config::Get(Config::GFX_PROJECTION_HACK_ZNEAR);
   phack.m_zfar = Config::Get(Config::GFX_PROJECTION_HACK_ZFAR);
   bPerfQueriesEnable = Config::Get(Config::GFX_PERF_QUERIES_ENABLE);
+  bPerfQueriesApproximate = Config::Get(Config::GFX_PERF_QUERIES_APPROXIMATE);
 
   if (iEFBScale == SCALE_FORCE_INTEGRAL)
   {
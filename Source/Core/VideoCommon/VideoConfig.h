@@ -112,6 +112,8 @@ struct VideoConfig final
 
   // General
   bool bVSync;
+  bool bLowLatency;
+  bool bPacePresents;
   bool bWidescreenHack;
   int iAspectRatio;
   bool bCrop;   // Aspect ratio controls.
@@ -125,12 +127,17 @@ struct VideoConfig final
   // Enhancements
   u32 iMultisamples;
   bool bSSAA;
+  bool bPostProcessingAA;  // FXAA pass at the head of the post-processing chain
   int iEFBScale;
   FilteringMode eFilteringMode;
   HostCullMode eCullMode;
   int iMaxAnisotropy;
   bool bPostProcessingEnable;
   int iPostProcessingTrigger;
+  // Compiles the post-processing options into the shaders instead of reading a uniform buffer.
+  bool bPostProcessingBakeOptions;
+  // Lowers the scale of the passes declaring a minimum scale to keep the frame time on target.
+  bool bPostProcessingDynamicScale;
   std::string sPostProcessingShaders;
   std::string sScalingShader;
   std::string sStereoShader;
@@ -138,6 +145,15 @@ struct VideoConfig final
   bool bTexDeposterize;
   int iTexScalingType;
   int iTexScalingFactor;
+  bool bTexScalingAsync;
+  bool bTexScalingGPU;
+  // Keeps the scaled textures on disk, in iTexScalingCacheSize MB per game.
+  bool bTexScalingCache;
+  bool bTexScalingCacheCompress;
+  int iTexScalingCacheSize;
+  // Texture memory in MB above which the texture cache evicts textures and stops scaling them,
+  // 0 for no limit.
+  int iTextureMemoryBudget;
   bool bTessellation;
   bool bTessellationEarlyCulling;
   int iTessellationDistance;
@@ -153,6 +169,9 @@ struct VideoConfig final
   bool bShowInputDisplay;
   bool bOverlayStats;
   bool bOverlayProjStats;
+  // CPU and GPU times of the passes of each frame, see FrameProfilerBase.
+  bool bOverlayFrameProfile;
+  bool bLogFrameProfileToFile;
   bool bTexFmtOverlayEnable;
   bool bTexFmtOverlayCenter;
   bool bLogRenderTimeToFile;
@@ -169,10 +188,20 @@ struct VideoConfig final
   bool bHiresMaterialMapsBuild;
   bool bCacheHiresTextures;
   bool bWaitForCacheHiresTextures;
+  bool bPackHiresTextures;
+  bool bCompressHiresTextures;
+  // The version of the names dumped textures get, 1 for the tex1_ names of XXH64 hashes, 2 for
+  // the tex2_ names of XXH3 hashes. Textures of both versions are loaded.
+  int iHiresTextureNameVersion;
   bool bDumpEFBTarget;
+  bool bDumpVertexLoaderProfile;
+  bool bDumpShaderCompileStats;
+  bool bDumpTextureCacheStats;
   bool bDumpFramesAsImages;
   bool bUseFFV1;
   std::string sDumpCodec;
+  // FFmpeg encoder to use by name, like h264_nvenc or hevc_qsv. Overrides sDumpCodec.
+  std::string sDumpEncoder;
   std::string sDumpFormat;
   std::string sDumpPath;
   bool bInternalResolutionFrameDumps;
@@ -187,13 +216,20 @@ struct VideoConfig final
   bool bEFBFastAccess;
   bool bForceProgressive;
   bool bPerfQueriesEnable;
+  // Reads of the perf counters return the previous measurement instead of waiting for the GPU.
+  bool bPerfQueriesApproximate;
   bool bFullAsyncShaderCompilation;
   bool bEnableGPUTextureDecoding;
   bool bEnableComputeTextureEncoding;
+  bool bEnableGPUVertexDecoding;
   bool bEFBEmulateFormatChanges;
   bool bSkipEFBCopyToRam;
+  // Keeps EFB copies to RAM on the GPU until something reads them or the frame ends.
+  bool bDeferEFBCopies;
   bool bCopyEFBScaled;
   int iSafeTextureCache_ColorSamples;
+  // A Hash64Function, XXH3 ignores the color samples.
+  int iTextureHashFunction;
   ProjectionHackConfig phack;
   float fAspectRatioHackW, fAspectRatioHackH;
   bool bEnablePixelLighting;
@@ -205,6 +241,11 @@ struct VideoConfig final
   int iSpecularMultiplier;
   bool bLastStoryEFBToRam;
   bool bForceLogicOpBlend;
+  bool bDisplayListCache;
+  bool bTrackTextureWrites;
+  bool bSkipDuplicateFrames;
+  // Primitives are still decoded but never drawn, for replaying movies without looking at them.
+  bool bSkipDrawing;
   bool bForcedDithering;
   bool bSimBumpEnabled;
   int iSimBumpDetailBlend;
@@ -215,6 +256,9 @@ struct VideoConfig final
   bool bFastDepthCalc;
   bool bVertexRounding;
   int iBBoxMode;
+  // How many video fields old a GPU bounding box value may be when the game reads it, 0 to
+  // always wait for the exact one.
+  int iBBoxPredictionWindow;
   //for dx9-backend
   bool bForceDualSourceBlend;
   int iLog; // CONF_ bits
@@ -244,7 +288,8 @@ struct VideoConfig final
   bool bEnableValidationLayer;
   bool bEnableShaderDebug;
 
-  // Multithreaded submission, currently only supported with Vulkan.
+  // Multithreaded submission with Vulkan and D3D12, draws recorded on a worker thread with D3D11,
+  // texture decoding on the async compute queue with Vulkan.
   bool bBackendMultithreading;
 
   // Early command buffer execution interval in number of draws.
@@ -267,6 +312,10 @@ struct VideoConfig final
 
   // Use ubershaders only, don't compile specialized shaders.
   bool bDisableSpecializedShaders;
+
+  // How many threads may compile shaders at once, 0 uses every thread of the pool.
+  // Currently only used by the HLSL backends.
+  int iShaderCompilerThreads;
   
   // Static config per API
   // TODO: Move this out of VideoConfig
@@ -291,6 +340,7 @@ struct VideoConfig final
     bool bSupportsEarlyZ; // needed by PixelShaderGen, so must stay in VideoCommon
     bool bNeedBlendIndices; // needed by PixelShaderGen, so must stay in VideoCommon
     bool bSupportsOversizedViewports;
+    bool bSupportsPrimitiveRestart;  // Needed by IndexGenerator, so must stay in VideoCommon
     bool bSupportsPostProcessing;
     bool bSupportsGeometryShaders;
     bool bSupportsComputeShaders;
@@ -298,6 +348,7 @@ struct VideoConfig final
     bool bSupportsExclusiveFullscreen;
     bool bSupportsBBox;
     bool bSupportsGSInstancing; // Needed by GeometryShaderGen, so must stay in VideoCommon
+    bool bSupportsVSLayerOutput; // Vertex shaders can select the render target layer
     bool bSupportsPaletteConversion;
     bool bSupportsClipControl; // Needed by VertexShaderGen, so must stay in VideoCommon		
     bool bSupportsSSAA;
@@ -305,7 +356,10 @@ struct VideoConfig final
     bool bSupportsScaling;
     bool bSupportsDepthClamp;  // Needed by VertexShaderGen, so must stay in VideoCommon
     bool bSupportsGPUTextureDecoding;
+    bool bSupportsGPUTextureScaling;
+    bool bSupportsGPUMipmapGeneration;
     bool bSupportsComputeTextureEncoding;
+    bool bSupportsGPUVertexDecoding;
     bool bSupportsMultithreading;
     bool bSupportsValidationLayer;
     bool bSupportsReversedDepthRange;
@@ -340,10 +394,25 @@ struct VideoConfig final
   {
     return backend_info.bSupportsTessellation && bTessellation && bEnablePixelLighting;
   }
+  // Stereo draws are instanced once per eye, the vertex shader offsets the vertices and selects
+  // the layer, so triangles don't need a geometry shader.
+  inline bool UseVertexShaderStereo() const
+  {
+    return iStereoMode > 0 && backend_info.bSupportsGeometryShaders &&
+           backend_info.bSupportsVSLayerOutput && !TessellationEnabled();
+  }
   inline bool UseGPUTextureDecoding() const
   {
     return backend_info.bSupportsGPUTextureDecoding && bEnableGPUTextureDecoding;
   }
+  inline bool UseGPUTextureScaling() const
+  {
+    return backend_info.bSupportsGPUTextureScaling && bTexScalingGPU;
+  }
+  inline bool UseGPUVertexDecoding() const
+  {
+    return backend_info.bSupportsGPUVertexDecoding && bEnableGPUVertexDecoding;
+  }
   inline bool UseHPFrameBuffer()
   {
     return backend_info.bSupportsHighPrecisionFrameBuffer && bHPFrameBuffer;
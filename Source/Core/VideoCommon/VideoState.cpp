@@ -12,7 +12,10 @@
 #include "VideoCommon/TessellationShaderManager.h"
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TmemMirror.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoState.h"
@@ -20,6 +23,10 @@
 
 void VideoCommon_DoState(PointerWrap &p)
 {
+  // RAM is saved after the video state, it has to hold every EFB copy by then.
+  if (g_texture_cache)
+    g_texture_cache->FlushDeferredEFBCopies();
+
   // BP Memory
   p.Do(bpmem);
   p.DoMarker("BP Memory");
@@ -34,6 +41,8 @@ void VideoCommon_DoState(PointerWrap &p)
   // Texture decoder
   p.DoArray(texMem);
   p.DoMarker("texMem");
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    TmemMirror::InvalidateAll();
 
   // FIFO
   Fifo::DoState(p);
@@ -64,6 +73,9 @@ void VideoCommon_DoState(PointerWrap &p)
   BoundingBox::DoState(p);
   p.DoMarker("BoundingBox");
 
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    InvalidateShaderUids();
+
 
   // TODO: search for more data that should be saved and add it here
 }
\ No newline at end of file
@@ -291,5 +291,8 @@ struct XFMemory
 extern XFMemory xfmem;
 
 void LoadXFReg(u32 transferSize, u32 address);
+// Loads count GX_LOAD_XF_REG commands in a row, which write size words of XF memory from address
+// on. The written range is flushed and invalidated once for all of them.
+void LoadXFMemRun(const u8* commands, u32 count, u32 address, u32 size);
 void LoadIndexedXF(u32 val, int array);
 void PreprocessIndexedXF(u32 val, int refarray);
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
@@ -17,14 +19,30 @@
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/ShaderGenCommon.h"
 
 inline void XFMemWritten(u32 transferSize, u32 baseAddress)
 {
-  g_vertex_manager->Flush();
+  if (g_vertex_manager->IsXFRangeUsed(baseAddress, baseAddress + transferSize))
+    g_vertex_manager->Flush();
   VertexShaderManager::InvalidateXFRange(baseAddress, baseAddress + transferSize);
   PixelShaderManager::InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// The end of the registers that are handled together with the one at address.
+static u32 GetXFRegGroupEnd(u32 address)
+{
+  if (address >= XFMEM_SETVIEWPORT && address < XFMEM_SETVIEWPORT + 6)
+    return XFMEM_SETVIEWPORT + 6;
+  if (address >= XFMEM_SETPROJECTION && address < XFMEM_SETPROJECTION + 7)
+    return XFMEM_SETPROJECTION + 7;
+  if (address >= XFMEM_SETTEXMTXINFO && address < XFMEM_SETTEXMTXINFO + 8)
+    return XFMEM_SETTEXMTXINFO + 8;
+  if (address >= XFMEM_SETPOSMTXINFO && address < XFMEM_SETPOSMTXINFO + 8)
+    return XFMEM_SETPOSMTXINFO + 8;
+  return address + 1;
+}
+
 inline void XFRegWritten(int transferSize, u32 baseAddress)
 {
   u32 address = baseAddress;
@@ -35,6 +53,27 @@ inline void XFRegWritten(int transferSize, u32 baseAddress)
     u32 newValue = g_VideoData.Peek<u32>(dataIndex * sizeof(u32));
     u32 nextAddress = address + 1;
 
+    // Games write the same state before most draws, which needs no flush and marks nothing
+    // dirty. The matrix indices are left to VertexShaderManager, which compares them against the
+    // CP state they are shared with.
+    if (address != XFMEM_SETMATRIXINDA && address != XFMEM_SETMATRIXINDB)
+    {
+      const u32 group_end = GetXFRegGroupEnd(address);
+      const u32 written_end = std::min<u32>(group_end, address + transferSize);
+      const u32* current = &((u32*)&xfmem)[address];
+      bool changed = false;
+      for (u32 i = 0; i < written_end - address && !changed; ++i)
+        changed = current[i] != g_VideoData.Peek<u32>((dataIndex + i) * sizeof(u32));
+      if (!changed)
+      {
+        const int skipped = written_end - address;
+        address = written_end;
+        transferSize -= skipped;
+        dataIndex += skipped;
+        continue;
+      }
+    }
+
     switch (address)
     {
     case XFMEM_ERROR:
@@ -238,18 +277,67 @@ void LoadXFReg(u32 transferSize, u32 baseAddress)
       transferSize = 0;
     }
 
-    XFMemWritten(xfMemTransferSize, xfMemBase);
+    // Games upload the same matrices over and over.
+    bool changed = false;
+    for (u32 i = 0; i < xfMemTransferSize && !changed; ++i)
+      changed = ((u32*)&xfmem)[xfMemBase + i] != g_VideoData.Peek<u32>(i * sizeof(u32));
+    if (changed)
+      XFMemWritten(xfMemTransferSize, xfMemBase);
     OpcodeDecoder::DataReadU32xFuncs[xfMemTransferSize - 1](&((u32*)&xfmem)[xfMemBase]);
   }
 
   // write to XF regs
   if (transferSize > 0)
   {
+    for (u32 i = 0; i < transferSize; ++i)
+    {
+      if (((u32*)&xfmem)[baseAddress + i] != g_VideoData.Peek<u32>(i * sizeof(u32)))
+        InvalidateShaderUidsForXFWrite(baseAddress + i, 1);
+    }
     XFRegWritten(transferSize, baseAddress);
     OpcodeDecoder::DataReadU32xFuncs[transferSize - 1](&((u32*)&xfmem)[baseAddress]);
   }
 }
 
+// Calls f(index, value) for each word the GX_LOAD_XF_REG commands write, until it returns false.
+template <typename F>
+static void ForEachXFMemRunWord(const u8* commands, u32 count, F f)
+{
+  const u8* command = commands;
+  u32 index = 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    const u32 words = ((Common::swap32(command + 1) >> 16) & 15) + 1;
+    const u8* values = command + 1 + OpcodeDecoder::GX_LOAD_XF_REG_SIZE;
+    for (u32 j = 0; j < words; ++j, ++index)
+    {
+      if (!f(index, Common::swap32(values + j * sizeof(u32))))
+        return;
+    }
+    command = values + words * sizeof(u32);
+  }
+}
+
+void LoadXFMemRun(const u8* commands, u32 count, u32 address, u32 size)
+{
+  u32* memory = &((u32*)&xfmem)[address];
+
+  // Games upload the same matrices over and over.
+  bool changed = false;
+  ForEachXFMemRunWord(commands, count, [memory, &changed](u32 index, u32 value) {
+    changed = memory[index] != value;
+    return !changed;
+  });
+  if (!changed)
+    return;
+
+  XFMemWritten(size, address);
+  ForEachXFMemRunWord(commands, count, [memory](u32 index, u32 value) {
+    memory[index] = value;
+    return true;
+  });
+}
+
 // TODO - verify that it is correct. Seems to work, though.
 void LoadIndexedXF(u32 val, int refarray)
 {
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <cmath>
+#include <cstring>
 
 #include "Common/Common.h"
 //#include "VideoCommon/VideoCommon.h" // to get debug logs
@@ -1347,10 +1348,11 @@ inline u32 makeRGBA(u32 r, u32 g, u32 b, u32 a)
   return (a << 24) | (b << 16) | (g << 8) | r;
 }
 
-inline void decodeDXTBlock(u32 *dst, const DXT1Block *src, u32 pitch)
+// Builds the four colors of a block, laid out by makecol or makeRGBA.
+template <u32 (*make)(u32, u32, u32, u32)>
+inline void decodeDXTColors(u32 *colors, const DXT1Block *src)
 {
   // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
-  // Needs more speed.
   u16 c1 = Common::swap16(src->color1);
   u16 c2 = Common::swap16(src->color2);
   u32 blue1 = Convert5To8(c1 & 0x1F);
@@ -1359,67 +1361,30 @@ inline void decodeDXTBlock(u32 *dst, const DXT1Block *src, u32 pitch)
   u32 green2 = Convert6To8((c2 >> 5) & 0x3F);
   u32 red1 = Convert5To8((c1 >> 11) & 0x1F);
   u32 red2 = Convert5To8((c2 >> 11) & 0x1F);
-  u32 colors[4];
-  colors[0] = makecol(red1, green1, blue1, 255);
-  colors[1] = makecol(red2, green2, blue2, 255);
+  colors[0] = make(red1, green1, blue1, 255);
+  colors[1] = make(red2, green2, blue2, 255);
   if (c1 > c2)
   {
     u32 blue3 = ((blue2 - blue1) >> 1) - ((blue2 - blue1) >> 3);
     u32 green3 = ((green2 - green1) >> 1) - ((green2 - green1) >> 3);
     u32 red3 = ((red2 - red1) >> 1) - ((red2 - red1) >> 3);
-    colors[2] = makecol(red1 + red3, green1 + green3, blue1 + blue3, 255);
-    colors[3] = makecol(red2 - red3, green2 - green3, blue2 - blue3, 255);
+    colors[2] = make(red1 + red3, green1 + green3, blue1 + blue3, 255);
+    colors[3] = make(red2 - red3, green2 - green3, blue2 - blue3, 255);
   }
   else
   {
-    colors[2] = makecol((red1 + red2 + 1) / 2, // Average
+    colors[2] = make((red1 + red2 + 1) / 2, // Average
       (green1 + green2 + 1) / 2,
       (blue1 + blue2 + 1) / 2, 255);
-    colors[3] = makecol(red2, green2, blue2, 0);  // Color2 but transparent
-  }
-
-  for (u32 y = 0; y < 4; y++)
-  {
-    u32 val = src->lines[y];
-    for (u32 x = 0; x < 4; x++)
-    {
-      dst[x] = colors[(val >> 6) & 3];
-      val <<= 2;
-    }
-    dst += pitch;
+    colors[3] = make(red2, green2, blue2, 0);  // Color2 but transparent
   }
 }
 
-inline void decodeDXTBlockRGBA(u32 *dst, const DXT1Block *src, u32 pitch)
+template <u32 (*make)(u32, u32, u32, u32)>
+inline void decodeDXTBlockWith(u32 *dst, const DXT1Block *src, u32 pitch)
 {
-  // S3TC Decoder (Note: GCN decodes differently from PC so we can't use native support)
-  // Needs more speed.
-  u16 c1 = Common::swap16(src->color1);
-  u16 c2 = Common::swap16(src->color2);
-  u32 blue1 = Convert5To8(c1 & 0x1F);
-  u32 blue2 = Convert5To8(c2 & 0x1F);
-  u32 green1 = Convert6To8((c1 >> 5) & 0x3F);
-  u32 green2 = Convert6To8((c2 >> 5) & 0x3F);
-  u32 red1 = Convert5To8((c1 >> 11) & 0x1F);
-  u32 red2 = Convert5To8((c2 >> 11) & 0x1F);
   u32 colors[4];
-  colors[0] = makeRGBA(red1, green1, blue1, 255);
-  colors[1] = makeRGBA(red2, green2, blue2, 255);
-  if (c1 > c2)
-  {
-    u32 blue3 = ((blue2 - blue1) >> 1) - ((blue2 - blue1) >> 3);
-    u32 green3 = ((green2 - green1) >> 1) - ((green2 - green1) >> 3);
-    u32 red3 = ((red2 - red1) >> 1) - ((red2 - red1) >> 3);
-    colors[2] = makeRGBA(red1 + red3, green1 + green3, blue1 + blue3, 255);
-    colors[3] = makeRGBA(red2 - red3, green2 - green3, blue2 - blue3, 255);
-  }
-  else
-  {
-    colors[2] = makeRGBA((red1 + red2 + 1) / 2, // Average
-      (green1 + green2 + 1) / 2,
-      (blue1 + blue2 + 1) / 2, 255);
-    colors[3] = makeRGBA(red2, green2, blue2, 0);  // Color2 but transparent
-  }
+  decodeDXTColors<make>(colors, src);
 
   for (u32 y = 0; y < 4; y++)
   {
@@ -1433,6 +1398,16 @@ inline void decodeDXTBlockRGBA(u32 *dst, const DXT1Block *src, u32 pitch)
   }
 }
 
+inline void decodeDXTBlock(u32 *dst, const DXT1Block *src, u32 pitch)
+{
+  decodeDXTBlockWith<makecol>(dst, src, pitch);
+}
+
+inline void decodeDXTBlockRGBA(u32 *dst, const DXT1Block *src, u32 pitch)
+{
+  decodeDXTBlockWith<makeRGBA>(dst, src, pitch);
+}
+
 inline void DXT1ToDXT3Block(DXT3Block* dst, const DXT1Block* src)
 {
   DXT3Block result;
@@ -1463,6 +1438,54 @@ inline void DXT1ToDXT3Block(DXT3Block* dst, const DXT1Block* src)
   *dst = result;
 }
 
+// BC1 is the same as CMPR, but with little endian colors and the first texel of a row in the
+// low bits.
+inline void DXT1ToBC1Block(DXT1Block* dst, const DXT1Block* src)
+{
+  DXT1Block result = *src;
+  result.color1 = Common::swap16(result.color1);
+  result.color2 = Common::swap16(result.color2);
+  result.indices = ((result.indices >> 4) & 0x0F0F0F0F) | ((result.indices << 4) & 0xF0F0F0F0);
+  result.indices = ((result.indices >> 2) & 0x33333333) | ((result.indices << 2) & 0xCCCCCCCC);
+  *dst = result;
+}
+
+// Puts the four 4x4 blocks of each 8x8 CMPR block in place for the GPU:
+// 11111111 22222222 55555555 66666666
+// 33333333 44444444 77777777 88888888
+template <typename Block, void (*convert)(Block*, const DXT1Block*)>
+static void ReorderDXTBlocks(Block* dst, const DXT1Block* src, u32 width, u32 height)
+{
+  const u32 bheight = height >> 2;
+  const u32 bwidth = width >> 2;
+  for (u32 y = 0; y < bheight; y += 2)
+  {
+    Block* line1 = dst + y * bwidth;
+    Block* line2 = line1 + bwidth;
+    for (u32 x = 0; x < bwidth; x += 2)
+    {
+      convert(line1++, src++);
+      convert(line1++, src++);
+      convert(line2++, src++);
+      convert(line2++, src++);
+    }
+  }
+}
+
+bool CMPRHasTransparentTexels(const u8* src, u32 size)
+{
+  const DXT1Block* block = (const DXT1Block*)src;
+  for (u32 i = 0; i < size / sizeof(DXT1Block); i++, block++)
+  {
+    if (Common::swap16(block->color1) > Common::swap16(block->color2))
+      continue;
+    // Index 3 is the transparent one in blocks with three colors.
+    if ((block->indices & (block->indices >> 1) & 0x55555555) != 0)
+      return true;
+  }
+  return false;
+}
+
 static HostTextureFormat GetPCFormatFromTLUTFormat(TlutFormat tlutfmt)
 {
   switch (tlutfmt)
@@ -1504,7 +1527,7 @@ HostTextureFormat GetHostTextureFormat(u32 texformat, TlutFormat tlutfmt, bool c
                           // The metroid games use this format almost exclusively.
     if (compressed_supported)
     {
-      fmt = PC_TEX_FMT_DXT3;
+      fmt = PC_TEX_FMT_DXT1;
     }
     else
     {
@@ -1515,8 +1538,471 @@ HostTextureFormat GetHostTextureFormat(u32 texformat, TlutFormat tlutfmt, bool c
   return fmt;
 }
 
+// AVX2 decoders, used when the CPU has it. Every format goes eight texels at a time: a row of the
+// eight texel wide blocks, or two rows of the four texel wide ones. Palettes are decoded once per
+// texture instead of once per texel, C4 looks colors up with a permute and C8 with a gather.
+// Anything not handled here returns PC_TEX_FMT_NONE and goes through the SSE2 decoders.
+
+enum class AVX2Output
+{
+  RGBA,
+  BGRA,
+  Raw16,  // The TLUT entries byteswapped, for IA8 and RGB565 palettes.
+};
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Expand3To8_AVX2(__m256i v)
+{
+  return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(v, 5), _mm256_slli_epi32(v, 2)),
+                         _mm256_srli_epi32(v, 1));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Expand4To8_AVX2(__m256i v)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(v, 4), v);
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Expand5To8_AVX2(__m256i v)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(v, 3), _mm256_srli_epi32(v, 2));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Expand6To8_AVX2(__m256i v)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(v, 2), _mm256_srli_epi32(v, 4));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Field_AVX2(__m256i v, int shift, u32 mask)
+{
+  return _mm256_and_si256(_mm256_srli_epi32(v, shift), _mm256_set1_epi32(mask));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i MakeColor_AVX2(__m256i r, __m256i g, __m256i b, __m256i a, bool bgra)
+{
+  return _mm256_or_si256(_mm256_or_si256(bgra ? b : r, _mm256_slli_epi32(g, 8)),
+                         _mm256_or_si256(_mm256_slli_epi32(bgra ? r : b, 16),
+                                         _mm256_slli_epi32(a, 24)));
+}
+
+// The decoders below take eight byteswapped 16 bit values, one in the low half of each lane.
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodeIA8_AVX2(__m256i v)
+{
+  const __m256i i = _mm256_and_si256(v, _mm256_set1_epi32(0xFF));
+  return _mm256_or_si256(_mm256_mullo_epi32(i, _mm256_set1_epi32(0x010101)),
+                         _mm256_slli_epi32(_mm256_srli_epi32(v, 8), 24));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Decode565_AVX2(__m256i v, bool bgra)
+{
+  return MakeColor_AVX2(Expand5To8_AVX2(Field_AVX2(v, 11, 0x1F)),
+                        Expand6To8_AVX2(Field_AVX2(v, 5, 0x3F)),
+                        Expand5To8_AVX2(Field_AVX2(v, 0, 0x1F)), _mm256_set1_epi32(0xFF), bgra);
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Decode5A3_AVX2(__m256i v, bool bgra)
+{
+  const __m256i opaque = MakeColor_AVX2(
+      Expand5To8_AVX2(Field_AVX2(v, 10, 0x1F)), Expand5To8_AVX2(Field_AVX2(v, 5, 0x1F)),
+      Expand5To8_AVX2(Field_AVX2(v, 0, 0x1F)), _mm256_set1_epi32(0xFF), bgra);
+  const __m256i translucent = MakeColor_AVX2(
+      Expand4To8_AVX2(Field_AVX2(v, 8, 0xF)), Expand4To8_AVX2(Field_AVX2(v, 4, 0xF)),
+      Expand4To8_AVX2(Field_AVX2(v, 0, 0xF)), Expand3To8_AVX2(Field_AVX2(v, 12, 0x7)), bgra);
+  const __m256i is_opaque = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 31);
+  return _mm256_blendv_epi8(translucent, opaque, is_opaque);
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodeTlut_AVX2(__m256i v, TlutFormat tlutfmt, AVX2Output output)
+{
+  if (output == AVX2Output::Raw16)
+    return v;
+  switch (tlutfmt)
+  {
+  case GX_TL_IA8:
+    return DecodeIA8_AVX2(v);
+  case GX_TL_RGB565:
+    return Decode565_AVX2(v, output == AVX2Output::BGRA);
+  default:
+    return Decode5A3_AVX2(v, output == AVX2Output::BGRA);
+  }
+}
+
+// Loads eight big endian 16 bit values, byteswapped and zero extended.
+FUNCTION_TARGET_AVX2
+static inline __m256i Load16_AVX2(const void* src)
+{
+  const __m128i swap = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  return _mm256_cvtepu16_epi32(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), swap));
+}
+
+// Stores eight texels as two rows of four.
+FUNCTION_TARGET_AVX2
+static inline void StoreRows4_AVX2(u32* dst, u32 width, __m256i v)
+{
+  _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(v));
+  _mm_storeu_si128((__m128i*)(dst + width), _mm256_extracti128_si256(v, 1));
+}
+
+FUNCTION_TARGET_AVX2
+static inline void StoreRows4Raw16_AVX2(u16* dst, u32 width, __m256i v)
+{
+  const __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  _mm_storel_epi64((__m128i*)dst, packed);
+  _mm_storel_epi64((__m128i*)(dst + width), _mm_unpackhi_epi64(packed, packed));
+}
+
+// Stores a row of eight texels.
+FUNCTION_TARGET_AVX2
+static inline void StoreRow8_AVX2(u8* dst, __m256i v, AVX2Output output)
+{
+  if (output == AVX2Output::Raw16)
+  {
+    _mm_storeu_si128((__m128i*)dst, _mm_packus_epi32(_mm256_castsi256_si128(v),
+                                                      _mm256_extracti128_si256(v, 1)));
+  }
+  else
+  {
+    _mm256_storeu_si256((__m256i*)dst, v);
+  }
+}
+
+// Decodes a whole palette of 16 or 256 entries.
+FUNCTION_TARGET_AVX2
+static void DecodePalette_AVX2(u32* palette, u32 tlutaddr, u32 count, TlutFormat tlutfmt,
+                               AVX2Output output)
+{
+  const u16* tlut = (const u16*)(texMem + tlutaddr);
+  for (u32 i = 0; i < count; i += 8)
+  {
+    _mm256_storeu_si256((__m256i*)(palette + i),
+                        DecodeTlut_AVX2(Load16_AVX2(tlut + i), tlutfmt, output));
+  }
+}
+
+// Splits four bytes into eight nibbles, the high one first.
+FUNCTION_TARGET_AVX2
+static inline __m256i LoadNibbles_AVX2(const u8* src)
+{
+  u32 bytes;
+  std::memcpy(&bytes, src, sizeof(bytes));
+  const __m128i doubled = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), _mm_cvtsi32_si128(bytes));
+  return _mm256_and_si256(
+      _mm256_srlv_epi32(_mm256_cvtepu8_epi32(doubled), _mm256_setr_epi32(4, 0, 4, 0, 4, 0, 4, 0)),
+      _mm256_set1_epi32(0xF));
+}
+
+// Expands the low nibble of every byte to a full byte, eight rows of four bytes to eight rows of
+// eight.
+FUNCTION_TARGET_AVX2
+static void DecodeI4Block_AVX2(u8* dst, const u8* src, u32 width)
+{
+  const __m256i mask = _mm256_set1_epi8(0xF);
+  const __m256i v = _mm256_loadu_si256((const __m256i*)src);
+  __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+  __m256i lo = _mm256_and_si256(v, mask);
+  hi = _mm256_or_si256(_mm256_slli_epi16(hi, 4), hi);
+  lo = _mm256_or_si256(_mm256_slli_epi16(lo, 4), lo);
+  const __m256i rows[2] = {_mm256_unpacklo_epi8(hi, lo), _mm256_unpackhi_epi8(hi, lo)};
+  for (u32 i = 0; i < 2; i++)
+  {
+    // Lane 0 holds rows 0-3, lane 1 rows 4-7, unpacklo gives the first two of each.
+    const __m128i halves[2] = {_mm256_castsi256_si128(rows[i]), _mm256_extracti128_si256(rows[i], 1)};
+    for (u32 j = 0; j < 2; j++)
+    {
+      u8* row = dst + (j * 4 + i * 2) * width;
+      _mm_storel_epi64((__m128i*)row, halves[j]);
+      _mm_storel_epi64((__m128i*)(row + width), _mm_unpackhi_epi64(halves[j], halves[j]));
+    }
+  }
+}
+
+// IA4 with the alpha in the high byte, four rows of eight.
+FUNCTION_TARGET_AVX2
+static void DecodeIA4Block_AVX2(u16* dst, const u8* src, u32 width)
+{
+  const __m256i mask = _mm256_set1_epi8(0xF);
+  const __m256i v = _mm256_loadu_si256((const __m256i*)src);
+  __m256i a = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask);
+  __m256i i = _mm256_and_si256(v, mask);
+  a = _mm256_or_si256(_mm256_slli_epi16(a, 4), a);
+  i = _mm256_or_si256(_mm256_slli_epi16(i, 4), i);
+  const __m256i rows02 = _mm256_unpacklo_epi8(i, a);
+  const __m256i rows13 = _mm256_unpackhi_epi8(i, a);
+  _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(rows02));
+  _mm_storeu_si128((__m128i*)(dst + width), _mm256_castsi256_si128(rows13));
+  _mm_storeu_si128((__m128i*)(dst + width * 2), _mm256_extracti128_si256(rows02, 1));
+  _mm_storeu_si128((__m128i*)(dst + width * 3), _mm256_extracti128_si256(rows13, 1));
+}
+
+// Byteswaps a block of four rows of four 16 bit texels.
+FUNCTION_TARGET_AVX2
+static void DecodeRaw16Block_AVX2(u16* dst, const u8* src, u32 width)
+{
+  const __m128i swap = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  for (u32 i = 0; i < 4; i += 2)
+  {
+    const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i * 8)), swap);
+    _mm_storel_epi64((__m128i*)(dst + i * width), v);
+    _mm_storel_epi64((__m128i*)(dst + (i + 1) * width), _mm_unpackhi_epi64(v, v));
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void DecodeDXTBlock_AVX2(u32* dst, const DXT1Block* src, u32 width, bool bgra)
+{
+  alignas(16) u32 colors[4];
+  if (bgra)
+    decodeDXTColors<makecol>(colors, src);
+  else
+    decodeDXTColors<makeRGBA>(colors, src);
+  const __m256i palette = _mm256_castsi128_si256(_mm_load_si128((const __m128i*)colors));
+  // Each row is a byte of indices with the first texel in the top bits.
+  const __m256i indices = _mm256_set1_epi32(src->indices);
+  const __m256i three = _mm256_set1_epi32(3);
+  const __m256i rows01 = _mm256_and_si256(
+      _mm256_srlv_epi32(indices, _mm256_setr_epi32(6, 4, 2, 0, 14, 12, 10, 8)), three);
+  const __m256i rows23 = _mm256_and_si256(
+      _mm256_srlv_epi32(indices, _mm256_setr_epi32(22, 20, 18, 16, 30, 28, 26, 24)), three);
+  StoreRows4_AVX2(dst, width, _mm256_permutevar8x32_epi32(palette, rows01));
+  StoreRows4_AVX2(dst + width * 2, width, _mm256_permutevar8x32_epi32(palette, rows23));
+}
+
+FUNCTION_TARGET_AVX2
+static HostTextureFormat Decode_AVX2(u8* dst, const u8* src, u32 width, u32 height, u32 texformat,
+                                     u32 tlutaddr, TlutFormat tlutfmt, bool rgba,
+                                     HostTextureFormat compressed_format)
+{
+  const AVX2Output color_output = rgba ? AVX2Output::RGBA : AVX2Output::BGRA;
+  const AVX2Output tlut_output =
+      (rgba || tlutfmt == GX_TL_RGB5A3) ? color_output : AVX2Output::Raw16;
+  const u32 tlut_texel_size = tlut_output == AVX2Output::Raw16 ? 2 : 4;
+  u32* dst32 = (u32*)dst;
+  u16* dst16 = (u16*)dst;
+
+  switch (texformat)
+  {
+  case GX_TF_I4:
+    for (u32 y = 0; y < height; y += 8)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        if (!rgba)
+        {
+          DecodeI4Block_AVX2(dst + y * width + x, src, width);
+          continue;
+        }
+        for (u32 iy = 0; iy < 8; iy++)
+        {
+          const __m256i i = LoadNibbles_AVX2(src + iy * 4);
+          _mm256_storeu_si256((__m256i*)(dst32 + (y + iy) * width + x),
+                              _mm256_mullo_epi32(i, _mm256_set1_epi32(0x11111111)));
+        }
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_I4_AS_I8;
+
+  case GX_TF_I8:
+    // The native format is a plain copy, the SSE2 decoder does that.
+    if (!rgba)
+      return PC_TEX_FMT_NONE;
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const __m256i i = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + iy * 8)));
+          _mm256_storeu_si256((__m256i*)(dst32 + (y + iy) * width + x),
+                              _mm256_mullo_epi32(i, _mm256_set1_epi32(0x01010101)));
+        }
+      }
+    }
+    return PC_TEX_FMT_RGBA32;
+
+  case GX_TF_IA4:
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        if (!rgba)
+        {
+          DecodeIA4Block_AVX2(dst16 + y * width + x, src, width);
+          continue;
+        }
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + iy * 8)));
+          const __m256i i = _mm256_and_si256(v, _mm256_set1_epi32(0xF));
+          const __m256i a = _mm256_srli_epi32(v, 4);
+          _mm256_storeu_si256(
+              (__m256i*)(dst32 + (y + iy) * width + x),
+              _mm256_or_si256(_mm256_mullo_epi32(i, _mm256_set1_epi32(0x111111)),
+                              _mm256_slli_epi32(_mm256_mullo_epi32(a, _mm256_set1_epi32(0x11)), 24)));
+        }
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_IA4_AS_IA8;
+
+  case GX_TF_IA8:
+  case GX_TF_RGB565:
+  case GX_TF_RGB5A3:
+  {
+    const bool raw = !rgba && texformat != GX_TF_RGB5A3;
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 4, src += 32)
+      {
+        if (raw)
+        {
+          DecodeRaw16Block_AVX2(dst16 + y * width + x, src, width);
+          continue;
+        }
+        for (u32 iy = 0; iy < 4; iy += 2)
+        {
+          const __m256i v = Load16_AVX2(src + iy * 8);
+          __m256i texels;
+          if (texformat == GX_TF_IA8)
+            texels = DecodeIA8_AVX2(v);
+          else if (texformat == GX_TF_RGB565)
+            texels = Decode565_AVX2(v, false);
+          else
+            texels = Decode5A3_AVX2(v, !rgba);
+          StoreRows4_AVX2(dst32 + (y + iy) * width + x, width, texels);
+        }
+      }
+    }
+    if (raw)
+      return texformat == GX_TF_IA8 ? PC_TEX_FMT_IA8 : PC_TEX_FMT_RGB565;
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_BGRA32;
+  }
+
+  case GX_TF_RGBA8:
+  {
+    // Each block is 16 AR pairs followed by 16 GB pairs.
+    const __m128i order = rgba ? _mm_set_epi8(12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1) :
+                                 _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    const __m256i shuffle = _mm256_broadcastsi128_si256(order);
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 4, src += 64)
+      {
+        for (u32 iy = 0; iy < 4; iy += 2)
+        {
+          const __m256i ar = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + iy * 8)));
+          const __m256i gb =
+              _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + 32 + iy * 8)));
+          // A R G B in memory order, one texel per lane.
+          const __m256i argb = _mm256_or_si256(ar, _mm256_slli_epi32(gb, 16));
+          StoreRows4_AVX2(dst32 + (y + iy) * width + x, width, _mm256_shuffle_epi8(argb, shuffle));
+        }
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_BGRA32;
+  }
+
+  case GX_TF_C4:
+  {
+    alignas(32) u32 palette[16];
+    DecodePalette_AVX2(palette, tlutaddr, 16, tlutfmt, tlut_output);
+    const __m256i low = _mm256_load_si256((const __m256i*)palette);
+    const __m256i high = _mm256_load_si256((const __m256i*)(palette + 8));
+    for (u32 y = 0; y < height; y += 8)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        for (u32 iy = 0; iy < 8; iy++)
+        {
+          const __m256i index = LoadNibbles_AVX2(src + iy * 4);
+          const __m256i is_high = _mm256_cmpgt_epi32(index, _mm256_set1_epi32(7));
+          const __m256i texels = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(low, index),
+                                                    _mm256_permutevar8x32_epi32(high, index), is_high);
+          StoreRow8_AVX2(dst + ((y + iy) * width + x) * tlut_texel_size, texels, tlut_output);
+        }
+      }
+    }
+    break;
+  }
+
+  case GX_TF_C8:
+  {
+    alignas(32) u32 palette[256];
+    DecodePalette_AVX2(palette, tlutaddr, 256, tlutfmt, tlut_output);
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 8, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy++)
+        {
+          const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + iy * 8)));
+          const __m256i texels = _mm256_i32gather_epi32((const int*)palette, index, 4);
+          StoreRow8_AVX2(dst + ((y + iy) * width + x) * tlut_texel_size, texels, tlut_output);
+        }
+      }
+    }
+    break;
+  }
+
+  case GX_TF_C14X2:
+  {
+    // Too many entries to decode them up front, so the loads stay scalar.
+    const u16* tlut = (const u16*)(texMem + tlutaddr);
+    for (u32 y = 0; y < height; y += 4)
+    {
+      for (u32 x = 0; x < width; x += 4, src += 32)
+      {
+        for (u32 iy = 0; iy < 4; iy += 2)
+        {
+          const u16* index = (const u16*)(src + iy * 8);
+          alignas(16) u16 entries[8];
+          for (u32 i = 0; i < 8; i++)
+            entries[i] = tlut[Common::swap16(index[i]) & 0x3FFF];
+          const __m256i texels = DecodeTlut_AVX2(Load16_AVX2(entries), tlutfmt, tlut_output);
+          if (tlut_output == AVX2Output::Raw16)
+            StoreRows4Raw16_AVX2(dst16 + (y + iy) * width + x, width, texels);
+          else
+            StoreRows4_AVX2(dst32 + (y + iy) * width + x, width, texels);
+        }
+      }
+    }
+    break;
+  }
+
+  case GX_TF_CMPR:
+    // Converting to BC1 or DXT3 for the GPU stays on the SSE2 path.
+    if (!rgba &&
+        (compressed_format == PC_TEX_FMT_DXT1 || compressed_format == PC_TEX_FMT_DXT3))
+      return PC_TEX_FMT_NONE;
+    for (u32 y = 0; y < height; y += 8)
+    {
+      for (u32 x = 0; x < width; x += 8)
+      {
+        const DXT1Block* block = (const DXT1Block*)src;
+        DecodeDXTBlock_AVX2(dst32 + y * width + x, block, width, !rgba);
+        DecodeDXTBlock_AVX2(dst32 + y * width + x + 4, block + 1, width, !rgba);
+        DecodeDXTBlock_AVX2(dst32 + (y + 4) * width + x, block + 2, width, !rgba);
+        DecodeDXTBlock_AVX2(dst32 + (y + 4) * width + x + 4, block + 3, width, !rgba);
+        src += sizeof(DXT1Block) * 4;
+      }
+    }
+    return rgba ? PC_TEX_FMT_RGBA32 : PC_TEX_FMT_BGRA32;
+
+  default:
+    return PC_TEX_FMT_NONE;
+  }
+
+  return rgba ? PC_TEX_FMT_RGBA32 : GetPCFormatFromTLUTFormat(tlutfmt);
+}
+
 //switch endianness, unswizzle
-static HostTextureFormat Decode_real(u8 *dst, const u8 *src, u32 width, u32 height, u32 texformat, u32 tlutaddr, TlutFormat tlutfmt, bool compressed_supported)
+static HostTextureFormat Decode_real(u8 *dst, const u8 *src, u32 width, u32 height, u32 texformat, u32 tlutaddr, TlutFormat tlutfmt, HostTextureFormat compressed_format)
 {
   const u32 Wsteps4 = (width + 3) / 4;
   const u32 Wsteps8 = (width + 7) / 8;
@@ -1718,29 +2204,17 @@ static HostTextureFormat Decode_real(u8 *dst, const u8 *src, u32 width, u32 heig
   case GX_TF_CMPR:  // speed critical
       // The metroid games use this format almost exclusively.
   {
-    if (compressed_supported)
+    if (compressed_format == PC_TEX_FMT_DXT1)
     {
-      // Transfor dxt1 to dxt3 to allow compatibility and minimize space
-      // 11111111 22222222 55555555 66666666
-      // 33333333 44444444 77777777 88888888
-      DXT3Block* bdst = (DXT3Block*)dst;
-      const DXT1Block* bsrc = (DXT1Block*)src;
-      u32 bheight = height >> 2;
-      u32 bwidth = width >> 2;
-      for (u32 y = 0; y < bheight; y += 2)
-      {
-        u32 yStep = y * bwidth;
-        const DXT1Block* src2 = bsrc + yStep;
-        DXT3Block* line1 = bdst + yStep;
-        DXT3Block* line2 = line1 + bwidth;
-        for (u32 x = 0; x < bwidth; x += 2)
-        {
-          DXT1ToDXT3Block(line1++, src2++);
-          DXT1ToDXT3Block(line1++, src2++);
-          DXT1ToDXT3Block(line2++, src2++);
-          DXT1ToDXT3Block(line2++, src2++);
-        }
-      }
+      ReorderDXTBlocks<DXT1Block, DXT1ToBC1Block>((DXT1Block*)dst, (const DXT1Block*)src, width,
+                                                  height);
+      return PC_TEX_FMT_DXT1;
+    }
+    else if (compressed_format == PC_TEX_FMT_DXT3)
+    {
+      // DXT3 keeps the color of transparent texels, BC1 makes them black
+      ReorderDXTBlocks<DXT3Block, DXT1ToDXT3Block>((DXT3Block*)dst, (const DXT1Block*)src, width,
+                                                   height);
       return PC_TEX_FMT_DXT3;
     }
     else
@@ -2151,7 +2625,7 @@ static HostTextureFormat Decode_RGBA(u32 * dst, const u8 * src, u32 width, u32 h
       for (u32 y = 0; y < height; y += 4)
         for (u32 x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
           for (u32 iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
-            decodebytesC14X2_5A3_To_BGRA32(dst + (y + iy) * width + x, (u16*)(src + 8 * xStep), tlutaddr);
+            decodebytesC14X2_5A3_To_RGBA(dst + (y + iy) * width + x, (u16*)(src + 8 * xStep), tlutaddr);
     }
     else if (tlutfmt == GX_TL_IA8)
     {
@@ -2830,17 +3304,26 @@ void SetTexFmtOverlayOptions(bool enable, bool center)
   TexFmt_Overlay_Center = center;
 }
 
-HostTextureFormat Decode(u8 *dst, const u8 *src, u32 width, u32 height, u32 texformat, u32 tlutaddr, TlutFormat tlutfmt, bool rgbaOnly, bool compressed_supported)
+HostTextureFormat Decode(u8 *dst, const u8 *src, u32 width, u32 height, u32 texformat, u32 tlutaddr, TlutFormat tlutfmt, bool rgbaOnly, HostTextureFormat compressed_format)
 {
   HostTextureFormat retval = PC_TEX_FMT_NONE;
 
-  if (rgbaOnly)
+  if (cpu_info.bAVX2)
+  {
+    retval = Decode_AVX2(dst, src, width, height, texformat, tlutaddr, tlutfmt, rgbaOnly,
+                         compressed_format);
+  }
+  if (retval != PC_TEX_FMT_NONE)
+  {
+    // Done above.
+  }
+  else if (rgbaOnly)
   {
     retval = Decode_RGBA((u32*)dst, src, width, height, texformat, tlutaddr, tlutfmt);
   }
   else
   {
-    retval = Decode_real(dst, src, width, height, texformat, tlutaddr, tlutfmt, compressed_supported);
+    retval = Decode_real(dst, src, width, height, texformat, tlutaddr, tlutfmt, compressed_format);
   }
   if ((!TexFmt_Overlay_Enable) || (retval == PC_TEX_FMT_NONE))
     return retval;
@@ -0,0 +1,46 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <mbedtls/aes.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+
+TEST(AES, DecryptCBCMatchesMbedTLS)
+{
+  std::array<u8, 16> key;
+  for (size_t i = 0; i < key.size(); ++i)
+    key[i] = static_cast<u8>(i * 13 + 1);
+  mbedtls_aes_context context;
+  mbedtls_aes_setkey_dec(&context, key.data(), 128);
+
+  // Sizes that do and don't fill the blocks that are decrypted in parallel
+  for (size_t size : {16, 48, 128, 0x410, 0x7C00})
+  {
+    std::vector<u8> encrypted(size);
+    for (size_t i = 0; i < size; ++i)
+      encrypted[i] = static_cast<u8>(i * 31 + 7);
+
+    std::array<u8, 16> expected_iv{};
+    std::vector<u8> expected(size);
+    mbedtls_aes_crypt_cbc(&context, MBEDTLS_AES_DECRYPT, size, expected_iv.data(),
+                          encrypted.data(), expected.data());
+
+    std::array<u8, 16> iv{};
+    std::vector<u8> decrypted(size);
+    Common::AES::DecryptCBC(&context, iv.data(), encrypted.data(), decrypted.data(), size);
+    EXPECT_EQ(expected, decrypted);
+    EXPECT_EQ(expected_iv, iv);
+
+    std::array<u8, 16> in_place_iv{};
+    std::vector<u8> in_place = encrypted;
+    Common::AES::DecryptCBC(&context, in_place_iv.data(), in_place.data(), in_place.data(), size);
+    EXPECT_EQ(expected, in_place);
+  }
+}
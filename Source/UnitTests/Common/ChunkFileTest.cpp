@@ -0,0 +1,64 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+
+TEST(ChunkFile, ContainerLayout)
+{
+  std::vector<u16> values = {1, 2, 3};
+  std::vector<u8> buffer(sizeof(u32) + values.size() * sizeof(u16));
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+  p.Do(values);
+  EXPECT_EQ(buffer.data() + buffer.size(), ptr);
+
+  // The same as writing the size and every element on its own.
+  std::vector<u8> expected(buffer.size());
+  ptr = expected.data();
+  PointerWrap q(&ptr, PointerWrap::MODE_WRITE);
+  u32 size = static_cast<u32>(values.size());
+  q.Do(size);
+  for (u16& value : values)
+    q.Do(value);
+  EXPECT_EQ(expected, buffer);
+}
+
+TEST(ChunkFile, ReadReusesStorage)
+{
+  std::vector<u32> values = {1, 2, 3, 4};
+  std::string text = "state";
+  std::vector<u8> buffer(64);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, PointerWrap::MODE_WRITE);
+  p.Do(values);
+  p.Do(text);
+
+  std::vector<u32> read_values = {5, 6, 7, 8};
+  const u32* storage = read_values.data();
+  std::string read_text;
+  ptr = buffer.data();
+  p = PointerWrap(&ptr, PointerWrap::MODE_READ);
+  p.Do(read_values);
+  p.Do(read_text);
+  EXPECT_EQ(values, read_values);
+  EXPECT_EQ(storage, read_values.data());
+  EXPECT_EQ(text, read_text);
+}
+
+TEST(ChunkFile, BoundedWriteOverflow)
+{
+  std::vector<u8> values(16, 0xAB);
+  std::vector<u8> buffer(8);
+  u8* ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::MODE_WRITE);
+  p.Do(values);
+  EXPECT_TRUE(p.IsOverflowed());
+  EXPECT_EQ(PointerWrap::MODE_MEASURE, p.GetMode());
+  EXPECT_EQ(sizeof(u32) + values.size(), static_cast<size_t>(ptr - buffer.data()));
+}
@@ -0,0 +1,75 @@
+// Copyright 2014 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/ConstantBuffer.h"
+
+namespace
+{
+std::vector<std::pair<u32, u32>> DirtyRanges(const ConstatBuffer& buffer)
+{
+  std::vector<std::pair<u32, u32>> ranges;
+  buffer.ForEachDirtyRange([&](u32 first, u32 count) { ranges.emplace_back(first, count); });
+  return ranges;
+}
+}
+
+TEST(ConstantBuffer, UnchangedValuesAreNotDirty)
+{
+  std::array<float, 4 * 8> data{};
+  ConstatBuffer buffer(data.data(), data.size());
+
+  buffer.SetConstant4<float>(2, 0.0f, 0.0f, 0.0f, 0.0f);
+  buffer.SetConstant<float>(3, 1, 0.0f);
+  EXPECT_FALSE(buffer.IsDirty());
+
+  buffer.SetConstant<float>(3, 1, 2.0f);
+  EXPECT_TRUE(buffer.IsDirty());
+  EXPECT_TRUE(buffer.IsRegisterDirty(3));
+  EXPECT_FALSE(buffer.IsRegisterDirty(2));
+  EXPECT_EQ(2.0f, data[3 * 4 + 1]);
+
+  buffer.Clear();
+  EXPECT_FALSE(buffer.IsDirty());
+  EXPECT_EQ(0u, buffer.GetDirtyRegisterCount());
+}
+
+TEST(ConstantBuffer, OnlyChangedRegistersOfARangeAreDirty)
+{
+  std::array<float, 4 * 8> data{};
+  ConstatBuffer buffer(data.data(), data.size());
+
+  std::array<float, 4 * 3> matrix{};
+  matrix[4 * 1 + 2] = 1.0f;
+  buffer.SetMultiConstant4v(4, 3, matrix.data());
+  EXPECT_EQ(1u, buffer.GetDirtyRegisterCount());
+  EXPECT_TRUE(buffer.IsRegisterDirty(5));
+}
+
+TEST(ConstantBuffer, DirtyRangesAcrossWords)
+{
+  std::array<float, 4 * 200> data{};
+  ConstatBuffer buffer(data.data(), data.size());
+
+  buffer.GetBufferToUpdate<float>(1, 2);
+  buffer.GetBufferToUpdate<float>(60, 70);
+  buffer.GetBufferToUpdate<float>(199, 1);
+  std::vector<std::pair<u32, u32>> expected = {{1, 2}, {60, 70}, {199, 1}};
+  EXPECT_EQ(expected, DirtyRanges(buffer));
+
+  const regionvector& regions = buffer.GetRegions();
+  ASSERT_EQ(3u, regions.size());
+  EXPECT_EQ(60u, regions[1].first);
+  EXPECT_EQ(129u, regions[1].second);
+
+  buffer.Clear();
+  buffer.MarkAllDirty();
+  expected = {{0, 200}};
+  EXPECT_EQ(expected, DirtyRanges(buffer));
+}
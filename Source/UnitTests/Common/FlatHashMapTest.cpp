@@ -0,0 +1,74 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/FlatHashMap.h"
+
+namespace
+{
+// Sends every key to the same slot.
+struct CollidingHasher
+{
+  size_t operator()(int) const { return 0; }
+};
+}
+
+TEST(FlatHashMap, InsertAndFind)
+{
+  FlatHashMap<int, int, std::hash<int>> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(nullptr, map.find(1));
+
+  for (int i = 0; i < 1000; ++i)
+    map[i] = i * 2;
+  EXPECT_EQ(1000u, map.size());
+  for (int i = 0; i < 1000; ++i)
+  {
+    ASSERT_NE(nullptr, map.find(i));
+    EXPECT_EQ(i * 2, map.find(i)->second);
+  }
+  EXPECT_EQ(nullptr, map.find(1000));
+
+  // operator[] finds the existing element instead of adding one.
+  map[10]++;
+  EXPECT_EQ(21, map[10]);
+  EXPECT_EQ(1000u, map.size());
+}
+
+TEST(FlatHashMap, ReferencesSurviveGrowth)
+{
+  FlatHashMap<int, int, std::hash<int>> map;
+  int* first = &map[0];
+  *first = 42;
+  for (int i = 1; i < 10000; ++i)
+    map[i] = i;
+  EXPECT_EQ(first, &map[0]);
+  EXPECT_EQ(42, *first);
+}
+
+TEST(FlatHashMap, CollisionsAndIterationOrder)
+{
+  FlatHashMap<int, int, CollidingHasher> map;
+  for (int i = 0; i < 100; ++i)
+    map[100 - i] = i;
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i, map.find(100 - i)->second);
+
+  std::vector<int> keys;
+  for (const auto& item : map)
+    keys.push_back(item.first);
+  ASSERT_EQ(100u, keys.size());
+  EXPECT_EQ(100, keys.front());
+  EXPECT_EQ(1, keys.back());
+
+  map.clear();
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(nullptr, map.find(50));
+  map[50] = 1;
+  EXPECT_EQ(1, map.find(50)->second);
+}
@@ -0,0 +1,142 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+namespace
+{
+struct XXH3Vector
+{
+  size_t length;
+  u64 seed;
+  u64 hash64;
+  u64 hash128_low;
+  u64 hash128_high;
+};
+
+// From the reference implementation. The lengths cover both ends of each of the input size
+// paths: 0-16, 17-128, 129-240 and longer.
+constexpr XXH3Vector XXH3_VECTORS[] = {
+    {0, 0x0000000000000000ULL, 0x2d06800538d394c2ULL,
+     0x6001c324468d497fULL, 0x99aa06d3014798d8ULL},
+    {1, 0x0000000000000000ULL, 0x8a21d78b1538b1c0ULL,
+     0x8a21d78b1538b1c0ULL, 0x79d2c79e874f72cdULL},
+    {3, 0x0000000000000000ULL, 0x5e9146ec277d0470ULL,
+     0x5e9146ec277d0470ULL, 0x78b75db2656d1cd2ULL},
+    {4, 0x0000000000000000ULL, 0xe47ce4db63c22a40ULL,
+     0x4c8675a6ed2d845fULL, 0x800082b3ae278670ULL},
+    {8, 0x0000000000000000ULL, 0x74cbeab03ffd0146ULL,
+     0x3387471c4557d8f6ULL, 0xf0fdb81a9ad516c4ULL},
+    {9, 0x0000000000000000ULL, 0xdb5eb7f891978961ULL,
+     0x92c4df98a6b83f8dULL, 0x367111edc6caf5e9ULL},
+    {16, 0x0000000000000000ULL, 0x7cbde139eab7d529ULL,
+     0x277e5923685e926aULL, 0x9160243430560421ULL},
+    {17, 0x0000000000000000ULL, 0x7c34a05bdc4a9d0fULL,
+     0xbf43698fe0a85e2aULL, 0x5d6ce165479eae6cULL},
+    {100, 0x0000000000000000ULL, 0x9b9f54422d02a492ULL,
+     0x65bc1ba323443a9fULL, 0xaf5eed3070130e11ULL},
+    {128, 0x0000000000000000ULL, 0xb13d5a176045071dULL,
+     0x67e878ed29a2be9aULL, 0xc3e7d4f9a0c564acULL},
+    {129, 0x0000000000000000ULL, 0xdccf95711a2b47d0ULL,
+     0x5c6ee733781d18d6ULL, 0x6ec30f38cf0b3394ULL},
+    {200, 0x0000000000000000ULL, 0x5265494f94a54178ULL,
+     0x5dd6f05385ea92caULL, 0xcdadcca32ed57450ULL},
+    {240, 0x0000000000000000ULL, 0x6752a73c1f560679ULL,
+     0x4cf0408220a5b0c3ULL, 0xe28af2358fadbb3fULL},
+    {241, 0x0000000000000000ULL, 0x7773082c303f6d02ULL,
+     0x7773082c303f6d02ULL, 0xf87616f7dc5c307dULL},
+    {1000, 0x0000000000000000ULL, 0x1ac7a871d119558cULL,
+     0x1ac7a871d119558cULL, 0xaca37b15470b23a3ULL},
+    {5000, 0x0000000000000000ULL, 0xb92c0cc2712a8d44ULL,
+     0xb92c0cc2712a8d44ULL, 0xf3cfb72299d83378ULL},
+    {0, 0x9e3779b185ebca8dULL, 0xa8a6b918b2f0364aULL,
+     0xa986dfc5d7605bfeULL, 0x00feaa732a3ce25eULL},
+    {1, 0x9e3779b185ebca8dULL, 0x2a78bb5976584331ULL,
+     0x2a78bb5976584331ULL, 0xe48033618f77941cULL},
+    {3, 0x9e3779b185ebca8dULL, 0x0863348002e0d9f1ULL,
+     0x0863348002e0d9f1ULL, 0x9962e3a0ab6e58a5ULL},
+    {4, 0x9e3779b185ebca8dULL, 0xa8673a3866eae52fULL,
+     0x2c55effd19991f63ULL, 0xe3938da3ed3034acULL},
+    {8, 0x9e3779b185ebca8dULL, 0x5af3161168681dc6ULL,
+     0x90de12dc468a8ac7ULL, 0xa10a2e5eed84c211ULL},
+    {9, 0x9e3779b185ebca8dULL, 0xc0c1ce1578336665ULL,
+     0xaa1d4a75f981532dULL, 0xe3e4a939ef4e933cULL},
+    {16, 0x9e3779b185ebca8dULL, 0x9cb22f184d1310c9ULL,
+     0x269f5bbf5d661808ULL, 0xa2c907a6974f09d7ULL},
+    {17, 0x9e3779b185ebca8dULL, 0xff20e08ae5386047ULL,
+     0x0b38db61184e6825ULL, 0x816f3b3936e6113cULL},
+    {100, 0x9e3779b185ebca8dULL, 0xe76dacdc44979dd3ULL,
+     0xa635f6d0b19a15f7ULL, 0xdcbbe5d89da79793ULL},
+    {128, 0x9e3779b185ebca8dULL, 0x2636d659bf461e8aULL,
+     0xc9accea3efc2b6b8ULL, 0xfd1f21598603b4ebULL},
+    {129, 0x9e3779b185ebca8dULL, 0x2e32bdf6a2543310ULL,
+     0x8e108006b0a67eceULL, 0x63fb4a7681fa8c20ULL},
+    {200, 0x9e3779b185ebca8dULL, 0x305373de0df371eaULL,
+     0x52bbbfd8a3f29003ULL, 0xe7e99329d3bf1b31ULL},
+    {240, 0x9e3779b185ebca8dULL, 0xc6f158cdcbe573d7ULL,
+     0x01b2fb7df444db15ULL, 0xcf59d3080c8b7a46ULL},
+    {241, 0x9e3779b185ebca8dULL, 0x489f627e305d83bfULL,
+     0x489f627e305d83bfULL, 0x131ec043e1a33f39ULL},
+    {1000, 0x9e3779b185ebca8dULL, 0x0dbf4a6cb19587ceULL,
+     0x0dbf4a6cb19587ceULL, 0x67b84d93c3f23abdULL},
+    {5000, 0x9e3779b185ebca8dULL, 0xe636a849d1b4becaULL,
+     0xe636a849d1b4becaULL, 0x614e665ec7a66be9ULL},
+};
+
+std::vector<u8> GetTestData()
+{
+  std::vector<u8> data(5000);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = static_cast<u8>((i * i * 31 + i * 7 + 13) ^ (i >> 8));
+  return data;
+}
+}  // namespace
+
+TEST(Hash, XXH3_64)
+{
+  const std::vector<u8> data = GetTestData();
+  for (const XXH3Vector& vector : XXH3_VECTORS)
+    EXPECT_EQ(vector.hash64, GetXXH3_64(data.data(), vector.length, vector.seed));
+}
+
+TEST(Hash, XXH3_128)
+{
+  const std::vector<u8> data = GetTestData();
+  for (const XXH3Vector& vector : XXH3_VECTORS)
+  {
+    const Hash128 hash = GetXXH3_128(data.data(), vector.length, vector.seed);
+    EXPECT_EQ(vector.hash128_low, hash.low);
+    EXPECT_EQ(vector.hash128_high, hash.high);
+  }
+}
+
+TEST(Hash, XXH3Unaligned)
+{
+  const std::vector<u8> data = GetTestData();
+  const std::vector<u8> shifted(data.begin() + 1, data.end());
+  std::vector<u8> copy(shifted.size() + 1);
+  for (size_t length : {7, 100, 200, 1000, 4000})
+  {
+    std::copy(shifted.begin(), shifted.begin() + length, copy.begin() + 1);
+    EXPECT_EQ(GetXXH3_64(shifted.data(), length), GetXXH3_64(copy.data() + 1, length));
+  }
+}
+
+TEST(Hash, SetHash64Function)
+{
+  const std::vector<u8> data = GetTestData();
+  SetHash64Function(Hash64Function::XXH3);
+  EXPECT_FALSE(DoesHash64Sample());
+  // XXH3 hashes all of the data whatever the samples.
+  EXPECT_EQ(GetXXH3_64(data.data(), data.size()),
+            GetHash64(data.data(), static_cast<u32>(data.size()), 128));
+  SetHash64Function(Hash64Function::Legacy);
+  EXPECT_TRUE(DoesHash64Sample());
+}
@@ -0,0 +1,119 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "Common/IniFile.h"
+
+namespace
+{
+class IniFileTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    m_filename = m_dir + "/test.ini";
+  }
+  void TearDown() override { File::DeleteDirRecursively(m_dir); }
+
+  std::string m_dir;
+  std::string m_filename;
+};
+}
+
+TEST_F(IniFileTest, Parse)
+{
+  ASSERT_TRUE(File::WriteStringToFile("\xEF\xBB\xBF"
+                                      "ignored = 1\r\n"
+                                      "[Core]\r\n"
+                                      "  CPUThread = \"True\" \r\n"
+                                      "#Comment = 1\n"
+                                      "$Cheat\n"
+                                      "[core]\n"
+                                      "GFXBackend = OGL\n",
+                                      m_filename));
+  IniFile ini;
+  ASSERT_TRUE(ini.Load(m_filename));
+  ASSERT_EQ(1u, ini.GetSections().size());
+
+  std::string value;
+  EXPECT_TRUE(ini.GetIfExists("Core", "CPUThread", &value));
+  EXPECT_EQ("True", value);
+  EXPECT_TRUE(ini.GetIfExists("Core", "GFXBackend", &value));
+  EXPECT_EQ("OGL", value);
+  std::vector<std::string> lines;
+  EXPECT_TRUE(ini.GetLines("Core", &lines, false));
+  EXPECT_EQ((std::vector<std::string>{"#Comment = 1", "$Cheat"}), lines);
+}
+
+TEST_F(IniFileTest, LoadOnTop)
+{
+  const std::string user_filename = m_dir + "/user.ini";
+  ASSERT_TRUE(File::WriteStringToFile("[Video]\nA = 1\nB = 2\n$Default\n", m_filename));
+  ASSERT_TRUE(File::WriteStringToFile("[Video]\nB = 3\nC = 4\n$User\n", user_filename));
+  IniFile ini;
+  ASSERT_TRUE(ini.Load(m_filename));
+  ASSERT_TRUE(ini.Load(user_filename, true));
+
+  std::vector<std::string> keys;
+  EXPECT_TRUE(ini.GetKeys("Video", &keys));
+  EXPECT_EQ((std::vector<std::string>{"A", "B", "C"}), keys);
+  int value = 0;
+  EXPECT_TRUE(ini.GetIfExists("Video", "B", &value));
+  EXPECT_EQ(3, value);
+  std::vector<std::string> lines;
+  EXPECT_TRUE(ini.GetLines("Video", &lines));
+  EXPECT_EQ((std::vector<std::string>{"$Default", "$User"}), lines);
+
+  // The first file loaded again is unaffected by the changes to the merged one.
+  IniFile defaults;
+  ASSERT_TRUE(defaults.Load(m_filename));
+  EXPECT_FALSE(defaults.Exists("Video", "C"));
+}
+
+TEST_F(IniFileTest, ChangesAreNotShared)
+{
+  ASSERT_TRUE(File::WriteStringToFile("[Core]\nA = 1\n", m_filename));
+  IniFile first;
+  ASSERT_TRUE(first.Load(m_filename));
+  IniFile second = first;
+  first.GetOrCreateSection("Core")->Set("A", 2);
+
+  int value = 0;
+  EXPECT_TRUE(second.GetIfExists("Core", "A", &value));
+  EXPECT_EQ(1, value);
+  IniFile reloaded;
+  ASSERT_TRUE(reloaded.Load(m_filename));
+  EXPECT_TRUE(reloaded.GetIfExists("Core", "A", &value));
+  EXPECT_EQ(1, value);
+}
+
+TEST_F(IniFileTest, SaveReplacesCachedFile)
+{
+  IniFile ini;
+  ini.GetOrCreateSection("Core")->Set("A", 1);
+  ASSERT_TRUE(ini.Save(m_filename));
+  IniFile loaded;
+  ASSERT_TRUE(loaded.Load(m_filename));
+
+  // Saved again within the same second and with the same size.
+  ini.GetOrCreateSection("Core")->Set("A", 2);
+  ASSERT_TRUE(ini.Save(m_filename));
+  ASSERT_TRUE(loaded.Load(m_filename));
+  int value = 0;
+  EXPECT_TRUE(loaded.GetIfExists("Core", "A", &value));
+  EXPECT_EQ(2, value);
+}
+
+TEST_F(IniFileTest, MissingFile)
+{
+  IniFile ini;
+  EXPECT_FALSE(ini.Load(m_dir + "/missing.ini"));
+  EXPECT_TRUE(ini.GetSections().empty());
+}
@@ -0,0 +1,205 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+struct Key
+{
+  u32 a;
+  u32 b;
+};
+
+class Collector : public LinearDiskCacheReader<Key, u32>
+{
+public:
+  void Read(const Key& key, const u32* value, u32 value_size) override
+  {
+    entries.emplace_back(key.a, std::vector<u32>(value, value + value_size));
+  }
+
+  std::vector<std::pair<u32, std::vector<u32>>> entries;
+};
+
+class LinearDiskCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    m_filename = m_dir + "/test.cache";
+  }
+  void TearDown() override { File::DeleteDirRecursively(m_dir); }
+
+  void AppendEntries(LinearDiskCache<Key, u32>* cache, u32 count, u32 first_value)
+  {
+    for (u32 i = 0; i < count; i++)
+    {
+      const std::vector<u32> value(i % 5, first_value + i);
+      cache->Append({i, ~i}, value.data(), static_cast<u32>(value.size()));
+    }
+  }
+
+  std::string m_dir;
+  std::string m_filename;
+};
+}
+
+TEST_F(LinearDiskCacheTest, AppendAndRead)
+{
+  LinearDiskCache<Key, u32> cache;
+  Collector empty;
+  EXPECT_EQ(0u, cache.OpenAndRead(m_filename, empty));
+  AppendEntries(&cache, 100, 1000);
+  cache.Close();
+
+  Collector collector;
+  EXPECT_EQ(100u, cache.OpenAndRead(m_filename, collector));
+  ASSERT_EQ(100u, collector.entries.size());
+  for (u32 i = 0; i < 100; i++)
+  {
+    EXPECT_EQ(i, collector.entries[i].first);
+    EXPECT_EQ(std::vector<u32>(i % 5, 1000 + i), collector.entries[i].second);
+  }
+}
+
+TEST_F(LinearDiskCacheTest, VersionMismatchClears)
+{
+  LinearDiskCache<Key, u32> cache;
+  Collector empty;
+  cache.OpenAndRead(m_filename, empty, "one");
+  AppendEntries(&cache, 10, 0);
+  cache.Close();
+
+  Collector collector;
+  EXPECT_EQ(0u, cache.OpenAndRead(m_filename, collector, "two"));
+  EXPECT_TRUE(collector.entries.empty());
+}
+
+TEST_F(LinearDiskCacheTest, LookupThroughIndex)
+{
+  LinearDiskCache<Key, u32> cache;
+  EXPECT_EQ(0u, cache.Open(m_filename));
+  AppendEntries(&cache, 50, 0);
+
+  // Entries appended since opening are found before the index is written.
+  std::vector<u32> value;
+  ASSERT_TRUE(cache.Get({7, ~7u}, &value));
+  EXPECT_EQ(std::vector<u32>(2, 7), value);
+  cache.Close();
+  EXPECT_TRUE(File::Exists(m_filename + ".idx"));
+
+  EXPECT_EQ(50u, cache.Open(m_filename));
+  for (u32 i = 0; i < 50; i++)
+  {
+    ASSERT_TRUE(cache.Get({i, ~i}, &value));
+    EXPECT_EQ(std::vector<u32>(i % 5, i), value);
+  }
+  EXPECT_FALSE(cache.Find({50, ~50u}));
+  EXPECT_FALSE(cache.Get({3, 3}, &value));
+
+  // A newer copy replaces the indexed one.
+  const u32 replacement[] = {42};
+  cache.Append({3, ~3u}, replacement, 1);
+  ASSERT_TRUE(cache.Get({3, ~3u}, &value));
+  EXPECT_EQ(std::vector<u32>(1, 42), value);
+  cache.Close();
+
+  EXPECT_EQ(50u, cache.Open(m_filename));
+  ASSERT_TRUE(cache.Get({3, ~3u}, &value));
+  EXPECT_EQ(std::vector<u32>(1, 42), value);
+}
+
+TEST_F(LinearDiskCacheTest, StaleIndexIsIgnored)
+{
+  LinearDiskCache<Key, u32> cache;
+  cache.Open(m_filename);
+  AppendEntries(&cache, 20, 0);
+  cache.Close();
+  File::Copy(m_filename + ".idx", m_dir + "/old.idx");
+
+  cache.Open(m_filename);
+  AppendEntries(&cache, 30, 100);
+  cache.Close();
+  // An index from before the last entries were appended still works for the entries it covers.
+  File::Copy(m_dir + "/old.idx", m_filename + ".idx");
+  EXPECT_EQ(30u, cache.Open(m_filename));
+  std::vector<u32> value;
+  ASSERT_TRUE(cache.Get({25, ~25u}, &value));
+  EXPECT_EQ(std::vector<u32>(0), value);
+  ASSERT_TRUE(cache.Get({4, ~4u}, &value));
+  EXPECT_EQ(std::vector<u32>(4, 104), value);
+  cache.Close();
+
+  // An index of another file is not used at all.
+  File::Delete(m_filename);
+  Collector empty;
+  cache.OpenAndRead(m_filename, empty);
+  AppendEntries(&cache, 5, 0);
+  cache.Close();
+  File::Copy(m_dir + "/old.idx", m_filename + ".idx");
+  EXPECT_EQ(5u, cache.Open(m_filename));
+  EXPECT_FALSE(cache.Find({10, ~10u}));
+}
+
+TEST_F(LinearDiskCacheTest, CorruptEntriesAreDropped)
+{
+  LinearDiskCache<Key, u32> cache;
+  Collector empty;
+  cache.OpenAndRead(m_filename, empty);
+  AppendEntries(&cache, 10, 0);
+  cache.Close();
+
+  // Flip a bit in the value of the third entry and cut the last one short.
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(m_filename, data));
+  size_t offset = 48;
+  for (u32 i = 0; i < 2; i++)
+    offset += 4 + sizeof(Key) + (i % 5) * 4 + 4;
+  data[offset + 4 + sizeof(Key)] ^= 1;
+  data.resize(data.size() - 2);
+  ASSERT_TRUE(File::WriteStringToFile(data, m_filename));
+
+  Collector collector;
+  EXPECT_EQ(8u, cache.OpenAndRead(m_filename, collector));
+  ASSERT_EQ(8u, collector.entries.size());
+  EXPECT_EQ(1u, collector.entries[1].first);
+  EXPECT_EQ(3u, collector.entries[2].first);
+  EXPECT_EQ(8u, collector.entries[7].first);
+  cache.Close();
+
+  // The file was rewritten without them.
+  EXPECT_LT(File::GetSize(m_filename), data.size());
+  Collector reread;
+  EXPECT_EQ(8u, cache.OpenAndRead(m_filename, reread));
+}
+
+TEST_F(LinearDiskCacheTest, SupersededEntriesAreCompacted)
+{
+  LinearDiskCache<Key, u32> cache;
+  Collector empty;
+  cache.OpenAndRead(m_filename, empty);
+  for (u32 round = 0; round < 4; round++)
+    AppendEntries(&cache, 10, round * 100);
+  cache.Close();
+  const u64 full_size = File::GetSize(m_filename);
+
+  Collector collector;
+  EXPECT_EQ(10u, cache.OpenAndRead(m_filename, collector));
+  ASSERT_EQ(10u, collector.entries.size());
+  for (u32 i = 0; i < 10; i++)
+    EXPECT_EQ(std::vector<u32>(i % 5, 300 + i), collector.entries[i].second);
+  cache.Close();
+  EXPECT_LT(File::GetSize(m_filename), full_size);
+}
@@ -0,0 +1,67 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32, 16> q;
+
+  u32 v;
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order, several laps around the ring.
+  for (u32 lap = 0; lap < 4; ++lap)
+  {
+    for (u32 i = 0; i < 16; ++i)
+      EXPECT_TRUE(q.TryPush(lap * 16 + i));
+    EXPECT_FALSE(q.TryPush(0));
+
+    for (u32 i = 0; i < 16; ++i)
+    {
+      ASSERT_TRUE(q.Pop(v));
+      EXPECT_EQ(lap * 16 + i, v);
+    }
+    EXPECT_FALSE(q.Pop(v));
+  }
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 PRODUCERS = 4;
+  constexpr u32 COUNT = 20000;
+  Common::MPSCQueue<u32, 256> q;
+
+  std::vector<std::thread> producers;
+  for (u32 p = 0; p < PRODUCERS; ++p)
+  {
+    producers.emplace_back([&q, p]() {
+      for (u32 i = 0; i < COUNT; ++i)
+        q.Push(p << 24 | i);
+    });
+  }
+
+  // Every producer's values must come out complete and in the order they were pushed.
+  std::array<u32, PRODUCERS> next{};
+  for (u32 received = 0; received < PRODUCERS * COUNT;)
+  {
+    u32 v;
+    if (!q.Pop(v))
+      continue;
+
+    const u32 p = v >> 24;
+    ASSERT_LT(p, PRODUCERS);
+    EXPECT_EQ(next[p], v & 0xFFFFFF);
+    next[p]++;
+    received++;
+  }
+
+  for (std::thread& producer : producers)
+    producer.join();
+}
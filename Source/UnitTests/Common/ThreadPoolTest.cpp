@@ -0,0 +1,59 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/ThreadPool.h"
+
+using Common::TaskGroup;
+using Common::ThreadPool;
+
+TEST(ThreadPool, ParallelForCoversRange)
+{
+  std::vector<std::atomic<u32>> hits(1000);
+  ThreadPool::ParallelFor(3, hits.size(), 7, [&](size_t first, size_t last) {
+    EXPECT_LE(last - first, 7u);
+    for (size_t i = first; i < last; i++)
+      hits[i]++;
+  });
+  for (size_t i = 0; i < hits.size(); i++)
+    EXPECT_EQ(i < 3 ? 0u : 1u, hits[i].load());
+}
+
+TEST(ThreadPool, ParallelForEmptyRange)
+{
+  bool called = false;
+  ThreadPool::ParallelFor(5, 5, 1, [&](size_t, size_t) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(ThreadPool, TaskGroupWaitsForAllTasks)
+{
+  std::atomic<u32> count{0};
+  TaskGroup group;
+  for (u32 i = 0; i < 100; i++)
+    group.Run([&] { count++; });
+  group.Run([&] { count++; }, Common::TaskPriority::Background);
+  group.Wait();
+  EXPECT_EQ(101u, count.load());
+}
+
+TEST(ThreadPool, NestedTaskGroups)
+{
+  std::atomic<u32> count{0};
+  TaskGroup outer;
+  for (u32 i = 0; i < 16; i++)
+  {
+    outer.Run([&] {
+      TaskGroup inner;
+      for (u32 j = 0; j < 16; j++)
+        inner.Run([&] { count++; });
+      inner.Wait();
+    });
+  }
+  outer.Wait();
+  EXPECT_EQ(256u, count.load());
+}
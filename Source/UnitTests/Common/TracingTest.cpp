@@ -0,0 +1,112 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Tracing.h"
+
+namespace
+{
+class TracingTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    m_filename = m_dir + "/trace.json";
+  }
+  void TearDown() override
+  {
+    Common::Tracing::StopRecording();
+    File::DeleteDirRecursively(m_dir);
+  }
+
+  std::string Export()
+  {
+    std::string trace;
+    EXPECT_TRUE(Common::Tracing::ExportChromeTrace(m_filename));
+    EXPECT_TRUE(File::ReadFileToString(m_filename, trace));
+    return trace;
+  }
+
+  std::string m_dir;
+  std::string m_filename;
+};
+}  // namespace
+
+TEST_F(TracingTest, NothingRecordedWhileStopped)
+{
+  {
+    Common::Tracing::ScopedEvent event("Test", "Before recording");
+  }
+  Common::Tracing::StartRecording();
+  Common::Tracing::StopRecording();
+  {
+    Common::Tracing::ScopedEvent event("Test", "After recording");
+  }
+
+  const std::string trace = Export();
+  EXPECT_EQ(std::string::npos, trace.find("Before recording"));
+  EXPECT_EQ(std::string::npos, trace.find("After recording"));
+}
+
+TEST_F(TracingTest, EventsOfAllThreads)
+{
+  Common::Tracing::StartRecording();
+  {
+    Common::Tracing::ScopedEvent event("Test", "Main event");
+    std::thread thread([] {
+      Common::Tracing::SetCurrentThreadName("Test \"worker\"");
+      Common::Tracing::ScopedEvent worker_event("Test", "Worker event");
+      Common::Tracing::AddInstantEvent("Test", "Worker instant");
+    });
+    thread.join();
+  }
+  Common::Tracing::StopRecording();
+
+  const std::string trace = Export();
+  EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"ph\":\"X\",\"cat\":\"Test\",\"name\":\"Main event\""));
+  EXPECT_NE(std::string::npos,
+            trace.find("\"ph\":\"X\",\"cat\":\"Test\",\"name\":\"Worker event\""));
+  EXPECT_NE(std::string::npos,
+            trace.find("\"ph\":\"i\",\"cat\":\"Test\",\"name\":\"Worker instant\""));
+  EXPECT_NE(std::string::npos, trace.find("{\"name\":\"Test \\\"worker\\\"\"}"));
+}
+
+TEST_F(TracingTest, StartingAgainDropsOldEvents)
+{
+  Common::Tracing::StartRecording();
+  {
+    Common::Tracing::ScopedEvent event("Test", "First recording");
+  }
+  Common::Tracing::StartRecording();
+  {
+    Common::Tracing::ScopedEvent event("Test", "Second recording");
+  }
+
+  const std::string trace = Export();
+  EXPECT_EQ(std::string::npos, trace.find("First recording"));
+  EXPECT_NE(std::string::npos, trace.find("Second recording"));
+}
+
+TEST_F(TracingTest, ThreadsWithoutEventsAreLeftOut)
+{
+  std::thread([] { Common::Tracing::SetCurrentThreadName("Idle thread"); }).join();
+  Common::Tracing::StartRecording();
+  Common::Tracing::StopRecording();
+
+  EXPECT_EQ(std::string::npos, Export().find("Idle thread"));
+}
+
+TEST(Tracing, InternName)
+{
+  const char* name = Common::Tracing::InternName(std::string("Interned"));
+  EXPECT_STREQ("Interned", name);
+  EXPECT_EQ(name, Common::Tracing::InternName("Interned"));
+}
@@ -860,6 +860,96 @@ TWO_OP_SSE_TEST(PMOVZXDQ, "qword")
 
 // TODO: AVX
 
+TEST_INSTR_NO_OPERANDS(VZEROUPPER, "vzeroupper")
+
+TEST_F(x64EmitterTest, VEX_MOV_xmm)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VMOVD_xmm(r.reg, MatR(R12));
+    emitter->VMOVQ_xmm(r.reg, MatR(R12));
+    emitter->VMOVDQU(r.reg, MatR(R12));
+    emitter->VMOVSS(MatR(R12), r.reg);
+    emitter->VMOVLPS(MatR(R12), r.reg);
+    emitter->VMOVUPS(MatR(R12), r.reg);
+    ExpectDisassembly("vmovd " + r.name + ", dword ptr ds:[r12] "
+                      "vmovq " + r.name + ", qword ptr ds:[r12] "
+                      "vmovdqu " + r.name + ", dqword ptr ds:[r12] "
+                      "vmovss dword ptr ds:[r12], " + r.name + " "
+                      "vmovlps qword ptr ds:[r12], " + r.name + " "
+                      "vmovups dqword ptr ds:[r12], " + r.name);
+  }
+}
+
+// for 256-bit instructions that take the form op reg, reg, r/m
+#define AVX256_RRM_TEST(Name)                                                                      \
+  TEST_F(x64EmitterTest, Name##_256)                                                               \
+  {                                                                                                \
+    for (const auto& r : ymmnames)                                                                 \
+    {                                                                                              \
+      emitter->Name(256, r.reg, YMM0, R(YMM0));                                                    \
+      emitter->Name(256, YMM0, r.reg, R(YMM0));                                                    \
+      emitter->Name(256, YMM0, YMM0, R(r.reg));                                                    \
+      emitter->Name(256, YMM0, r.reg, MatR(R12));                                                  \
+      ExpectDisassembly(#Name " " + r.name + ", ymm0, ymm0 " #Name " ymm0, " + r.name +            \
+                        ", ymm0 " #Name " ymm0, ymm0, " + r.name + " " #Name " ymm0, " + r.name +  \
+                        ", qqword ptr ds:[r12]");                                                  \
+    }                                                                                              \
+  }
+
+AVX256_RRM_TEST(VMULPS)
+AVX256_RRM_TEST(VPSHUFB)
+
+TEST_F(x64EmitterTest, VCVTDQ2PS_256)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VCVTDQ2PS(256, r.reg, R(YMM1));
+    emitter->VCVTDQ2PS(256, YMM1, R(r.reg));
+    emitter->VCVTDQ2PS(256, r.reg, MatR(R12));
+    ExpectDisassembly("vcvtdq2ps " + r.name + ", ymm1 vcvtdq2ps ymm1, " + r.name +
+                      " vcvtdq2ps " + r.name + ", qqword ptr ds:[r12]");
+  }
+}
+
+// The Bochs disassembler prints every operand of a 256-bit instruction as ymm/qqword, even the
+// ones that are really xmm/dword/dqword.
+TEST_F(x64EmitterTest, VBROADCASTSS_256)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VBROADCASTSS(256, r.reg, R(XMM1));
+    emitter->VBROADCASTSS(256, r.reg, MatR(R12));
+    ExpectDisassembly("vbroadcastss " + r.name + ", ymm1 vbroadcastss " + r.name +
+                      ", dword ptr ds:[r12]");
+  }
+}
+
+TEST_F(x64EmitterTest, VPSRAD_256)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VPSRAD(256, r.reg, YMM1, 16);
+    emitter->VPSRAD(256, YMM1, r.reg, 24);
+    ExpectDisassembly("vpsrad " + r.name + ", ymm1, 0x10 vpsrad ymm1, " + r.name + ", 0x18");
+  }
+}
+
+TEST_F(x64EmitterTest, VINSERTI128_VEXTRACTI128)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VINSERTI128(r.reg, YMM1, R(r.reg), 1);
+    emitter->VINSERTI128(YMM1, r.reg, MatR(R12), 1);
+    emitter->VEXTRACTI128(R(r.reg), YMM1, 1);
+    emitter->VEXTRACTI128(MatR(R12), r.reg, 1);
+    ExpectDisassembly("vinserti128 " + r.name + ", ymm1, " + r.name + ", 0x01 "
+                      "vinserti128 ymm1, " + r.name + ", qqword ptr ds:[r12], 0x01 "
+                      "vextracti128 " + r.name + ", ymm1, 0x01 "
+                      "vextracti128 qqword ptr ds:[r12], " + r.name + ", 0x01");
+  }
+}
+
 // for VEX GPR instructions that take the form op reg, r/m, reg
 #define VEX_RMR_TEST(Name)                                                                         \
   TEST_F(x64EmitterTest, Name)                                                                     \
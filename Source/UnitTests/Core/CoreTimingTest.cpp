@@ -4,15 +4,21 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <chrono>
+#include <random>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "Common/FileUtil.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/TimingWheel.h"
 #include "UICommon/UICommon.h"
 /*
 // Numbers are chosen randomly to make sure the correct one is given.
@@ -346,3 +352,165 @@ TEST(CoreTiming, Overclocking)
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
 */
+
+namespace
+{
+struct TestEvent
+{
+  s64 time;
+  u64 fifo_order;
+  u32 type;
+};
+
+bool operator>(const TestEvent& left, const TestEvent& right)
+{
+  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
+}
+
+// The binary heap CoreTiming used before the timing wheel, kept here as a reference.
+class HeapQueue
+{
+public:
+  bool Empty() const { return m_events.empty(); }
+  void Push(const TestEvent& event)
+  {
+    m_events.push_back(event);
+    std::push_heap(m_events.begin(), m_events.end(), std::greater<TestEvent>());
+  }
+  const TestEvent& Front() const { return m_events.front(); }
+  void PopFront()
+  {
+    std::pop_heap(m_events.begin(), m_events.end(), std::greater<TestEvent>());
+    m_events.pop_back();
+  }
+  template <typename Predicate>
+  void RemoveIf(Predicate pred)
+  {
+    m_events.erase(std::remove_if(m_events.begin(), m_events.end(), pred), m_events.end());
+    std::make_heap(m_events.begin(), m_events.end(), std::greater<TestEvent>());
+  }
+
+private:
+  std::vector<TestEvent> m_events;
+};
+
+// Roughly the periods (in cycles) of the events that keep rescheduling themselves while a game
+// runs: GPU sync, DSP, SI polling, audio DMA, VI half lines, the VI field and a distant timeout.
+constexpr std::array<s64, 7> EVENT_PERIODS{{600, 2700, 5000, 8100, 15445, 8100000, 243000000}};
+constexpr int SLICE_LENGTH = 20000;
+
+// Runs the CoreTiming advance loop over the queue and returns the order the events ran in.
+// Each event type is scheduled `copies` times to model a busier CoreTiming queue.
+template <typename Queue>
+std::vector<u32> RunEventMix(Queue& queue, int slices, u32 copies = 1)
+{
+  std::mt19937 rng(1234);
+  std::vector<u32> order;
+  u64 fifo_order = 0;
+  s64 now = 0;
+  for (u32 copy = 0; copy < copies; ++copy)
+  {
+    for (u32 type = 0; type < EVENT_PERIODS.size(); ++type)
+      queue.Push(TestEvent{EVENT_PERIODS[type] + copy * 97, fifo_order++, type});
+  }
+
+  for (int slice = 0; slice < slices; ++slice)
+  {
+    now += SLICE_LENGTH;
+    while (!queue.Empty() && queue.Front().time <= now)
+    {
+      const TestEvent event = queue.Front();
+      queue.PopFront();
+      order.push_back(event.type);
+
+      // Reschedule with some jitter, occasionally already due (like ScheduleEvent(0, ...)).
+      const s64 jitter = static_cast<s64>(rng() % 64) - 32;
+      const s64 delay = rng() % 16 == 0 ? 0 : EVENT_PERIODS[event.type] + jitter;
+      queue.Push(TestEvent{now + delay, fifo_order++, event.type});
+    }
+
+    // Something occasionally cancels an event type and schedules it again.
+    if (slice % 97 == 0)
+    {
+      const u32 type = rng() % EVENT_PERIODS.size();
+      queue.RemoveIf([type](const TestEvent& event) { return event.type == type; });
+      queue.Push(TestEvent{now + EVENT_PERIODS[type], fifo_order++, type});
+    }
+  }
+  return order;
+}
+}  // namespace
+
+TEST(TimingWheel, OrderMatchesHeap)
+{
+  HeapQueue heap;
+  CoreTiming::TimingWheel<TestEvent> wheel;
+  const std::vector<u32> expected = RunEventMix(heap, 20000, 4);
+  const std::vector<u32> actual = RunEventMix(wheel, 20000, 4);
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(TimingWheel, SameTimeIsFifo)
+{
+  CoreTiming::TimingWheel<TestEvent> wheel;
+  wheel.Push(TestEvent{100, 0, 0});
+  wheel.Push(TestEvent{50, 1, 1});
+  wheel.Push(TestEvent{100, 2, 2});
+  wheel.Push(TestEvent{-10, 3, 3});
+  wheel.Push(TestEvent{CoreTiming::TimingWheel<TestEvent>::HORIZON * 3, 4, 4});
+
+  for (u32 type : {3, 1, 0, 2, 4})
+  {
+    ASSERT_FALSE(wheel.Empty());
+    EXPECT_EQ(type, wheel.Front().type);
+    wheel.PopFront();
+  }
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimingWheel, AssignRestoresOrder)
+{
+  CoreTiming::TimingWheel<TestEvent> wheel;
+  for (u32 i = 0; i < 100; ++i)
+    wheel.Push(TestEvent{static_cast<s64>((i * 7919) % 5000000), i, i});
+
+  std::vector<TestEvent> events = wheel.ToVector();
+  std::reverse(events.begin(), events.end());
+  CoreTiming::TimingWheel<TestEvent> restored;
+  restored.Assign(events);
+
+  EXPECT_EQ(wheel.Size(), restored.Size());
+  while (!wheel.Empty())
+  {
+    EXPECT_EQ(wheel.Front().fifo_order, restored.Front().fifo_order);
+    wheel.PopFront();
+    restored.PopFront();
+  }
+  EXPECT_TRUE(restored.Empty());
+}
+
+template <typename Queue>
+static double TimeEventMix(int slices, u32 copies)
+{
+  Queue queue;
+  const auto start = std::chrono::high_resolution_clock::now();
+  const size_t count = RunEventMix(queue, slices, copies).size();
+  const auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+// Run with --gtest_also_run_disabled_tests, the nanoseconds per event are in the XML output.
+TEST(TimingWheel, DISABLED_Benchmark)
+{
+  constexpr int SLICES = 100000;
+  for (u32 copies : {1, 4, 16})
+  {
+    const std::string pending =
+        std::to_string(copies * static_cast<u32>(EVENT_PERIODS.size())) + "_pending_";
+    testing::Test::RecordProperty(pending + "heap_ns",
+                                  std::to_string(TimeEventMix<HeapQueue>(SLICES, copies)));
+    testing::Test::RecordProperty(
+        pending + "wheel_ns",
+        std::to_string(TimeEventMix<CoreTiming::TimingWheel<TestEvent>>(SLICES, copies)));
+  }
+}
@@ -0,0 +1,60 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+
+#define AX_GC
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+
+namespace
+{
+// The per sample mixing MixAdd has to match.
+void ReferenceMixAdd(int* out, const s16* input, u32 count, u16* pvol, s16* dpop, bool ramp)
+{
+  u16& volume = pvol[0];
+  const u16 volume_delta = ramp ? pvol[1] : 0;
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 sample = MathUtil::Clamp((input[i] * volume) >> 15, -32767, 32767);
+    out[i] += static_cast<s16>(sample);
+    volume += volume_delta;
+    *dpop = static_cast<s16>(sample);
+  }
+}
+}
+
+TEST(AXVoice, MixAddMatchesPerSampleMixing)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> value(-32768, 32767);
+  for (u32 round = 0; round < 2000; ++round)
+  {
+    const u32 count = round % (MAX_SAMPLES_PER_FRAME + 1);
+    std::array<s16, MAX_SAMPLES_PER_FRAME> input;
+    std::array<int, MAX_SAMPLES_PER_FRAME> out, expected_out;
+    for (u32 i = 0; i < count; ++i)
+    {
+      // Full scale samples hit the clamping.
+      input[i] = static_cast<s16>(round % 4 == 0 ? (value(rng) < 0 ? -32768 : 32767) : value(rng));
+      out[i] = expected_out[i] = value(rng) * 4;
+    }
+
+    // Loud volumes and ramps that wrap around.
+    std::array<u16, 2> volume = {{static_cast<u16>(value(rng)), static_cast<u16>(value(rng))}};
+    std::array<u16, 2> expected_volume = volume;
+    s16 dpop = 0, expected_dpop = 0;
+    const bool ramp = round % 3 != 0;
+    DSP::HLE::MixAdd(out.data(), input.data(), count, volume.data(), &dpop, ramp);
+    ReferenceMixAdd(expected_out.data(), input.data(), count, expected_volume.data(),
+                    &expected_dpop, ramp);
+
+    for (u32 i = 0; i < count; ++i)
+      EXPECT_EQ(expected_out[i], out[i]) << "round " << round << ", sample " << i;
+    EXPECT_EQ(expected_volume[0], volume[0]);
+    EXPECT_EQ(expected_dpop, dpop);
+  }
+}
@@ -0,0 +1,156 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+
+#include "Core/HW/DSPHLE/UCodes/Zelda.h"
+
+namespace
+{
+constexpr size_t BUFFER_SIZE = 0x50;
+using Buffer = std::array<s16, BUFFER_SIZE>;
+
+// The per sample loops the renderer used to run.
+s32 ReferenceAddBuffersWithVolumeRamp(Buffer* dst, const Buffer& src, s32 vol, s32 step)
+{
+  if (!vol && !step)
+    return vol;
+
+  for (size_t i = 0; i < BUFFER_SIZE; ++i)
+  {
+    (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
+    vol = static_cast<s32>(static_cast<u32>(vol) + static_cast<u32>(step));
+  }
+  return vol;
+}
+
+void ReferenceAddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  while (count--)
+  {
+    s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
+    *dst++ += MathUtil::Clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
+void ReferenceApplyVolumeInPlace_4_12(Buffer* buf, u16 vol)
+{
+  for (s16& sample : *buf)
+    sample = (s16)MathUtil::Clamp(((s32)((u32)sample * (u32)vol)) >> 12, -0x8000, 0x7FFF);
+}
+
+u32 ReferenceResample(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                      const std::array<s16, 0x100>& coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    const s16* taps = &coeffs[((pos & 0xFFF) >> 6) * 4];
+    const s16* input = &src[pos >> 12];
+    s64 sample = 0;
+    for (size_t j = 0; j < 4; ++j)
+      sample += (s64)2 * taps[j] * input[j];
+    dst[i] = (s16)MathUtil::Clamp<s64>(sample >> 16, -0x8000, 0x7FFF);
+    pos += ratio;
+  }
+  return pos;
+}
+
+// Random samples, full scale every few rounds to hit the clamping.
+Buffer RandomBuffer(std::mt19937& rng, u32 round)
+{
+  std::uniform_int_distribution<int> value(-0x8000, 0x7FFF);
+  Buffer buffer;
+  for (s16& sample : buffer)
+  {
+    const int v = value(rng);
+    sample = static_cast<s16>(round % 4 == 0 ? (v < 0 ? -0x8000 : 0x7FFF) : v);
+  }
+  return buffer;
+}
+}
+
+TEST(ZeldaAudioRenderer, VolumeRampMatchesPerSampleMixing)
+{
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<s32> volume(INT32_MIN, INT32_MAX);
+  for (u32 round = 0; round < 2000; ++round)
+  {
+    const Buffer src = RandomBuffer(rng, round);
+    Buffer dst = RandomBuffer(rng, round + 1);
+    Buffer expected_dst = dst;
+    const s32 vol = volume(rng);
+    // Small steps like the renderer uses, and huge ones that wrap around.
+    const s32 step = round % 2 ? volume(rng) / 0x50 : volume(rng);
+
+    const s32 new_vol = DSP::HLE::AddBuffersWithVolumeRamp(&dst, src, vol, step);
+    const s32 expected_vol = ReferenceAddBuffersWithVolumeRamp(&expected_dst, src, vol, step);
+    EXPECT_EQ(expected_vol, new_vol);
+    EXPECT_EQ(expected_dst, dst) << "round " << round;
+  }
+}
+
+TEST(ZeldaAudioRenderer, VolumeMatchesPerSampleMixing)
+{
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> volume(0, 0xFFFF);
+  for (u32 round = 0; round < 2000; ++round)
+  {
+    const Buffer src = RandomBuffer(rng, round);
+    Buffer dst = RandomBuffer(rng, round + 1);
+    Buffer expected_dst = dst;
+    const u16 vol = static_cast<u16>(volume(rng));
+    // Partial buffers, as the reverb mixing does.
+    const size_t count = round % (BUFFER_SIZE + 1);
+
+    DSP::HLE::AddBuffersWithVolume(dst.data(), src.data(), count, vol);
+    ReferenceAddBuffersWithVolume(expected_dst.data(), src.data(), count, vol);
+    EXPECT_EQ(expected_dst, dst) << "round " << round;
+
+    Buffer buf = src;
+    Buffer expected_buf = src;
+    DSP::HLE::ApplyVolumeInPlace_4_12(&buf, vol);
+    ReferenceApplyVolumeInPlace_4_12(&expected_buf, vol);
+    EXPECT_EQ(expected_buf, buf) << "round " << round;
+  }
+}
+
+TEST(ZeldaAudioRenderer, ResampleMatchesPerSampleFilter)
+{
+  std::mt19937 rng(2);
+  std::uniform_int_distribution<int> value(-0x8000, 0x7FFF);
+  std::uniform_int_distribution<u32> fraction(0, 0xFFF);
+  std::uniform_int_distribution<u32> ratio(0, 0x3FFF);
+  for (u32 round = 0; round < 2000; ++round)
+  {
+    // Without -0x8000 coefficients the vectorized filter is used.
+    const bool coeffs_fit_s32 = round % 5 != 0;
+    std::array<s16, 0x100> coeffs;
+    for (s16& coeff : coeffs)
+    {
+      coeff = static_cast<s16>(value(rng));
+      if (coeffs_fit_s32 && coeff == -0x8000)
+        coeff = -0x7FFF;
+      else if (!coeffs_fit_s32 && round % 10 == 0)
+        coeff = -0x8000;
+    }
+
+    // Enough input for 0x50 samples at the largest ratio, plus the filter taps.
+    std::array<s16, 0x50 * 4 + 4> src;
+    for (s16& sample : src)
+      sample = static_cast<s16>(round % 3 == 0 ? -0x8000 : value(rng));
+
+    Buffer dst, expected_dst;
+    const u32 pos = fraction(rng);
+    const u32 step = ratio(rng);
+    const u32 new_pos = DSP::HLE::ResampleWithCoeffs(dst.data(), dst.size(), src.data(), pos,
+                                                     step, coeffs, coeffs_fit_s32);
+    const u32 expected_pos =
+        ReferenceResample(expected_dst.data(), expected_dst.size(), src.data(), pos, step, coeffs);
+    EXPECT_EQ(expected_pos, new_pos);
+    EXPECT_EQ(expected_dst, dst) << "round " << round;
+  }
+}
@@ -0,0 +1,125 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/AsyncReadbackBase.h"
+
+namespace
+{
+// Copies the texture handle into the slot, the test decides when the GPU finished.
+class FakeReadback final : public AsyncReadbackBase
+{
+public:
+  explicit FakeReadback(size_t ring_size)
+      : AsyncReadbackBase(ring_size), slots(GetSlotCount()), ready(GetSlotCount()),
+        mapped(GetSlotCount())
+  {
+  }
+  ~FakeReadback() { Discard(); }
+
+  void FinishAll()
+  {
+    for (size_t i = 0; i < ready.size(); i++)
+      ready[i] = true;
+  }
+
+  std::vector<u8> slots;
+  std::vector<bool> ready;
+  std::vector<bool> mapped;
+
+protected:
+  bool CopyToSlot(size_t slot, uintptr_t texture, const MathUtil::Rectangle<int>& rect) override
+  {
+    EXPECT_FALSE(mapped[slot]);
+    slots[slot] = static_cast<u8>(texture);
+    ready[slot] = false;
+    return true;
+  }
+  bool IsSlotReady(size_t slot) override { return ready[slot]; }
+  const u8* MapSlot(size_t slot, u32* stride) override
+  {
+    mapped[slot] = true;
+    *stride = 4;
+    return &slots[slot];
+  }
+  void UnmapSlot(size_t slot) override
+  {
+    EXPECT_TRUE(mapped[slot]);
+    mapped[slot] = false;
+  }
+};
+
+const MathUtil::Rectangle<int> RECT(0, 0, 1, 1);
+}
+
+TEST(AsyncReadback, PollOnlyRunsFinishedReadbacksInOrder)
+{
+  FakeReadback readback(3);
+  std::vector<u8> results;
+  auto callback = [&](const u8* data, u32, u32, u32) { results.push_back(*data); };
+  readback.Queue(1, RECT, callback);
+  readback.Queue(2, RECT, callback);
+
+  readback.Poll();
+  EXPECT_TRUE(results.empty());
+
+  readback.FinishAll();
+  readback.Queue(3, RECT, callback);
+  readback.Poll();
+  EXPECT_EQ(std::vector<u8>({1, 2}), results);
+  EXPECT_TRUE(readback.HasPending());
+
+  readback.Flush();
+  EXPECT_EQ(std::vector<u8>({1, 2, 3}), results);
+  EXPECT_FALSE(readback.HasPending());
+}
+
+TEST(AsyncReadback, FullRingReadsBackOldest)
+{
+  FakeReadback readback(2);
+  std::vector<u8> results;
+  auto callback = [&](const u8* data, u32, u32, u32) { results.push_back(*data); };
+  for (u8 i = 1; i <= 5; i++)
+    readback.Queue(i, RECT, callback);
+  EXPECT_EQ(std::vector<u8>({1, 2, 3}), results);
+  readback.Flush();
+  EXPECT_EQ(std::vector<u8>({1, 2, 3, 4, 5}), results);
+}
+
+TEST(AsyncReadback, DataStaysValidUntilNextCallbackReturns)
+{
+  FakeReadback readback(2);
+  const u8* last_data = nullptr;
+  u8 last_value = 0;
+  auto callback = [&](const u8* data, u32, u32, u32) {
+    // The data of the previous callback can still be read here.
+    if (last_data)
+    {
+      EXPECT_EQ(last_value, *last_data);
+    }
+    last_data = data;
+    last_value = *data;
+  };
+  for (u8 i = 1; i <= 8; i++)
+    readback.Queue(i, RECT, callback);
+  readback.Flush();
+  EXPECT_EQ(8, last_value);
+}
+
+TEST(AsyncReadback, DiscardDropsPendingReadbacks)
+{
+  FakeReadback readback(2);
+  int calls = 0;
+  auto callback = [&](const u8*, u32, u32, u32) { calls++; };
+  readback.Queue(1, RECT, callback);
+  readback.Queue(2, RECT, callback);
+  readback.Discard();
+  readback.Flush();
+  EXPECT_EQ(0, calls);
+  EXPECT_FALSE(readback.HasPending());
+}
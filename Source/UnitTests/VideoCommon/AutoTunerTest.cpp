@@ -0,0 +1,87 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/AutoTuner.h"
+
+namespace
+{
+const Config::ConfigLocation SAMPLES{Config::System::GFX, "Settings",
+                                     "SafeTextureCacheColorSamples"};
+const Config::ConfigLocation ASYNC{Config::System::GFX, "Hacks", "FullAsyncShaderCompilation"};
+
+std::vector<AutoTuner::Setting> MakeSettings()
+{
+  return {{"Samples", SAMPLES, "0", {"512", "128"}}, {"Async", ASYNC, "False", {"True"}}};
+}
+}  // namespace
+
+TEST(AutoTuner, FramesMatch)
+{
+  const std::vector<u64> reference(20, 1);
+  EXPECT_TRUE(AutoTuner::FramesMatch(reference, reference));
+  EXPECT_TRUE(AutoTuner::FramesMatch(reference, std::vector<u64>(15, 1)));
+  EXPECT_TRUE(AutoTuner::FramesMatch(reference, std::vector<u64>(25, 1)));
+  EXPECT_FALSE(AutoTuner::FramesMatch(reference, std::vector<u64>(10, 1)));
+  EXPECT_FALSE(AutoTuner::FramesMatch(reference, {}));
+
+  std::vector<u64> frames = reference;
+  frames[3] = 2;
+  EXPECT_FALSE(AutoTuner::FramesMatch(reference, frames));
+}
+
+TEST(AutoTuner, KeepsFastestMatchingValues)
+{
+  const std::vector<AutoTuner::Setting> settings = MakeSettings();
+  std::vector<AutoTuner::Configuration> measured;
+  const auto measure = [&measured](const AutoTuner::Configuration& configuration) {
+    measured.push_back(configuration);
+    AutoTuner::Measurement measurement{100.0, std::vector<u64>(10, 1)};
+    // 128 samples is fastest but draws other frames, async shaders are faster on top of 512.
+    if (configuration.at(SAMPLES) == "512")
+      measurement.fps += 20.0;
+    if (configuration.at(SAMPLES) == "128")
+    {
+      measurement.fps += 50.0;
+      measurement.frame_hashes[5] = 2;
+    }
+    if (configuration.at(ASYNC) == "True")
+      measurement.fps += 10.0;
+    return std::optional<AutoTuner::Measurement>(measurement);
+  };
+
+  const std::optional<AutoTuner::Result> result = AutoTuner::Tune(settings, measure, 3.0);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(4u, measured.size());
+  EXPECT_EQ(3u, result->tried);
+  EXPECT_EQ(1u, result->mismatched);
+  EXPECT_EQ("512", result->best.at(SAMPLES));
+  EXPECT_EQ("True", result->best.at(ASYNC));
+  EXPECT_DOUBLE_EQ(100.0, result->reference_fps);
+  EXPECT_DOUBLE_EQ(130.0, result->best_fps);
+  // The later setting was tried on top of the value kept for the earlier one.
+  EXPECT_EQ("512", measured.back().at(SAMPLES));
+}
+
+TEST(AutoTuner, IgnoresSmallGains)
+{
+  const auto measure = [](const AutoTuner::Configuration& configuration) {
+    const double fps = configuration.at(ASYNC) == "True" ? 102.0 : 100.0;
+    return std::optional<AutoTuner::Measurement>({fps, std::vector<u64>(10, 1)});
+  };
+  const std::optional<AutoTuner::Result> result = AutoTuner::Tune(MakeSettings(), measure, 3.0);
+  ASSERT_TRUE(result);
+  EXPECT_EQ(AutoTuner::GetCurrentConfiguration(MakeSettings()), result->best);
+}
+
+TEST(AutoTuner, FailsWithoutReference)
+{
+  const auto measure = [](const AutoTuner::Configuration&) {
+    return std::optional<AutoTuner::Measurement>();
+  };
+  EXPECT_FALSE(AutoTuner::Tune(MakeSettings(), measure, 3.0));
+}
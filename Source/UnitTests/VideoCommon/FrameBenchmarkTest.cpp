@@ -0,0 +1,123 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/FrameBenchmark.h"
+
+namespace
+{
+FrameBenchmark::FrameSample Sample(float interval_ms, int draw_calls)
+{
+  FrameBenchmark::FrameSample sample{};
+  sample.interval_ms = interval_ms;
+  sample.thread_cpu_ms = interval_ms / 2;
+  sample.counters.numDrawCalls = draw_calls;
+  return sample;
+}
+
+FrameBenchmark::Report MakeReport(double fps, double frame_ms)
+{
+  FrameBenchmark::RunResult run;
+  run.frames = 100;
+  run.fps = fps;
+  run.times["frame_interval_ms"].mean = frame_ms;
+  run.times["gpu_thread_cpu_ms"].mean = 0.05;
+  run.counters["draw_calls"] = 12.5;
+
+  FrameBenchmark::FileResult file;
+  file.name = "test.dff";
+  file.frame_start = 2;
+  file.frame_end = 10;
+  file.runs = {run, run, run};
+
+  FrameBenchmark::Report report;
+  report.revision = "abc";
+  report.backend = "Vulkan";
+  report.files.push_back(file);
+  return report;
+}
+}
+
+TEST(FrameBenchmark, SummarizesTheFramesOfARun)
+{
+  FrameBenchmark::Recording recording;
+  for (int i = 1; i <= 20; i++)
+    recording.frames.push_back(Sample(static_cast<float>(i), i % 2 ? 10 : 20));
+
+  const FrameBenchmark::RunResult result = FrameBenchmark::Summarize(recording);
+  EXPECT_EQ(20u, result.frames);
+  EXPECT_DOUBLE_EQ(20 * 1000.0 / 210.0, result.fps);
+  const FrameBenchmark::Distribution& interval = result.times.at("frame_interval_ms");
+  EXPECT_DOUBLE_EQ(10.5, interval.mean);
+  EXPECT_DOUBLE_EQ(10.5, interval.median);
+  EXPECT_DOUBLE_EQ(19.0, interval.p95);
+  EXPECT_DOUBLE_EQ(20.0, interval.max);
+  EXPECT_DOUBLE_EQ(5.25, result.times.at("gpu_thread_cpu_ms").mean);
+  EXPECT_DOUBLE_EQ(15.0, result.counters.at("draw_calls"));
+  // Without times from the frame profiler, there are no per pass times.
+  EXPECT_EQ(0u, result.times.count("cpu_frame_ms"));
+}
+
+TEST(FrameBenchmark, GPUTimesNeedEveryFrameToHaveThem)
+{
+  FrameBenchmark::Recording recording;
+  recording.frames.push_back(Sample(16.0f, 1));
+  FrameProfilerBase::FrameTimes times;
+  times.cpu_ms[FrameProfilerBase::TIME_FRAME] = 4.0f;
+  times.gpu_ms[FrameProfilerBase::TIME_FRAME] = 8.0f;
+  times.has_gpu = true;
+  recording.times = {times, times};
+
+  FrameBenchmark::RunResult result = FrameBenchmark::Summarize(recording);
+  EXPECT_DOUBLE_EQ(4.0, result.times.at("cpu_frame_ms").mean);
+  EXPECT_DOUBLE_EQ(8.0, result.times.at("gpu_frame_ms").mean);
+
+  recording.times[1].has_gpu = false;
+  result = FrameBenchmark::Summarize(recording);
+  EXPECT_EQ(1u, result.times.count("cpu_frame_ms"));
+  EXPECT_EQ(0u, result.times.count("gpu_frame_ms"));
+}
+
+TEST(FrameBenchmark, ReportsSurviveJSON)
+{
+  const FrameBenchmark::Report report = MakeReport(60.0, 16.5);
+  FrameBenchmark::Report read;
+  ASSERT_TRUE(FrameBenchmark::FromJSON(FrameBenchmark::ToJSON(report), &read));
+  EXPECT_EQ("abc", read.revision);
+  EXPECT_EQ("Vulkan", read.backend);
+  ASSERT_EQ(1u, read.files.size());
+  EXPECT_EQ("test.dff", read.files[0].name);
+  EXPECT_EQ(2u, read.files[0].frame_start);
+  EXPECT_EQ(10u, read.files[0].frame_end);
+  ASSERT_EQ(3u, read.files[0].runs.size());
+  const FrameBenchmark::RunResult& run = read.files[0].runs[2];
+  EXPECT_EQ(100u, run.frames);
+  EXPECT_DOUBLE_EQ(60.0, run.fps);
+  EXPECT_DOUBLE_EQ(16.5, run.times.at("frame_interval_ms").mean);
+  EXPECT_DOUBLE_EQ(12.5, run.counters.at("draw_calls"));
+
+  EXPECT_FALSE(FrameBenchmark::FromJSON("{\"files\": 1}", &read));
+  EXPECT_FALSE(FrameBenchmark::FromJSON("not json", &read));
+}
+
+TEST(FrameBenchmark, ComparesAgainstTheBaseline)
+{
+  const FrameBenchmark::Report baseline = MakeReport(60.0, 16.0);
+  EXPECT_TRUE(FrameBenchmark::Compare(baseline, MakeReport(58.0, 16.5), 5.0).empty());
+
+  const auto regressions = FrameBenchmark::Compare(baseline, MakeReport(50.0, 20.0), 5.0);
+  ASSERT_EQ(2u, regressions.size());
+  EXPECT_EQ("fps", regressions[0].metric);
+  EXPECT_DOUBLE_EQ(50.0, regressions[0].current);
+  EXPECT_EQ("frame_interval_ms", regressions[1].metric);
+  EXPECT_DOUBLE_EQ(25.0, regressions[1].percent);
+
+  // Files played with another frame range aren't compared.
+  FrameBenchmark::Report other_range = MakeReport(30.0, 32.0);
+  other_range.files[0].frame_end = 20;
+  EXPECT_TRUE(FrameBenchmark::Compare(baseline, other_range, 5.0).empty());
+}
@@ -0,0 +1,157 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/FrameProfilerBase.h"
+
+namespace
+{
+// Writes the time the test sets as the timestamps, the test decides when they can be read.
+class FakeProfiler final : public FrameProfilerBase
+{
+public:
+  void AdvanceMs(u64 ms) { now_ns += ms * 1000000; }
+
+  u64 now_ns = 0;
+  bool ready = true;
+
+protected:
+  bool SupportsTimestamps() const override { return true; }
+  void BeginTimestamps(size_t frame) override { m_timestamps[frame].assign(MAX_TIMESTAMPS, 0); }
+  void WriteTimestamp(size_t frame, u32 index) override { m_timestamps[frame][index] = now_ns; }
+  bool ReadTimestamps(size_t frame, u32 count, u64* timestamps_ns) override
+  {
+    if (!ready)
+      return false;
+    std::copy_n(m_timestamps[frame].begin(), count, timestamps_ns);
+    return true;
+  }
+
+private:
+  std::array<std::vector<u64>, FRAME_COUNT> m_timestamps;
+};
+
+float GPUTime(const FrameProfilerBase::FrameTimes& times, FramePass pass)
+{
+  return times.gpu_ms[FrameProfilerBase::TIME_FIRST_PASS + static_cast<size_t>(pass)];
+}
+}
+
+TEST(FrameProfiler, NestedPassesAreTakenOutOfTheirParent)
+{
+  FakeProfiler profiler;
+  profiler.EndFrame(true, false);
+  ASSERT_TRUE(profiler.IsActive());
+
+  profiler.AdvanceMs(1);
+  profiler.BeginPass(FramePass::EFBCopy);
+  profiler.AdvanceMs(2);
+  profiler.EndPass(FramePass::EFBCopy);
+  profiler.AdvanceMs(2);
+  profiler.BeginPass(FramePass::Present);
+  profiler.AdvanceMs(1);
+  profiler.BeginPass(FramePass::Scaling);
+  profiler.AdvanceMs(1);
+  profiler.BeginPass(FramePass::PostProcessing);
+  profiler.AdvanceMs(2);
+  profiler.EndPass(FramePass::PostProcessing);
+  profiler.AdvanceMs(1);
+  profiler.EndPass(FramePass::Scaling);
+  profiler.AdvanceMs(2);
+  profiler.EndPass(FramePass::Present);
+  profiler.EndFrame(true, false);
+
+  const FrameProfilerBase::FrameTimes times = profiler.GetAverageTimes();
+  ASSERT_TRUE(times.has_gpu);
+  EXPECT_FLOAT_EQ(12.0f, times.gpu_ms[FrameProfilerBase::TIME_FRAME]);
+  EXPECT_FLOAT_EQ(3.0f, times.gpu_ms[FrameProfilerBase::TIME_EFB]);
+  EXPECT_FLOAT_EQ(2.0f, GPUTime(times, FramePass::EFBCopy));
+  EXPECT_FLOAT_EQ(3.0f, GPUTime(times, FramePass::Present));
+  EXPECT_FLOAT_EQ(2.0f, GPUTime(times, FramePass::Scaling));
+  EXPECT_FLOAT_EQ(2.0f, GPUTime(times, FramePass::PostProcessing));
+}
+
+TEST(FrameProfiler, PendingFramesAreCollectedInOrder)
+{
+  FakeProfiler profiler;
+  profiler.ready = false;
+  profiler.EndFrame(true, false);
+  for (u64 ms = 1; ms <= 3; ms++)
+  {
+    profiler.AdvanceMs(ms);
+    profiler.EndFrame(true, false);
+  }
+  EXPECT_FALSE(profiler.GetAverageTimes().has_gpu);
+
+  profiler.ready = true;
+  profiler.AdvanceMs(4);
+  profiler.EndFrame(true, false);
+  const FrameProfilerBase::FrameTimes times = profiler.GetAverageTimes();
+  ASSERT_TRUE(times.has_gpu);
+  EXPECT_FLOAT_EQ(2.5f, times.gpu_ms[FrameProfilerBase::TIME_FRAME]);
+}
+
+TEST(FrameProfiler, FramesNotReadyInTimeAreDropped)
+{
+  FakeProfiler profiler;
+  profiler.ready = false;
+  profiler.EndFrame(true, false);
+  for (u64 ms = 1; ms <= FrameProfilerBase::FRAME_COUNT; ms++)
+  {
+    profiler.AdvanceMs(ms);
+    profiler.EndFrame(true, false);
+  }
+
+  // The first frame's queries were needed again for the last one.
+  profiler.ready = true;
+  profiler.AdvanceMs(FrameProfilerBase::FRAME_COUNT + 1);
+  profiler.EndFrame(true, false);
+  const FrameProfilerBase::FrameTimes times = profiler.GetAverageTimes();
+  ASSERT_TRUE(times.has_gpu);
+  EXPECT_FLOAT_EQ(3.5f, times.gpu_ms[FrameProfilerBase::TIME_FRAME]);
+}
+
+TEST(FrameProfiler, PassesBeyondTheTimestampsOnlyHaveCPUTimes)
+{
+  FakeProfiler profiler;
+  profiler.EndFrame(true, false);
+  for (u32 i = 0; i < FrameProfilerBase::MAX_TIMESTAMPS; i++)
+  {
+    profiler.BeginPass(FramePass::EFBCopy);
+    profiler.AdvanceMs(1);
+    profiler.EndPass(FramePass::EFBCopy);
+  }
+  profiler.EndFrame(true, false);
+
+  // Two timestamps are taken by the frame itself.
+  const FrameProfilerBase::FrameTimes times = profiler.GetAverageTimes();
+  ASSERT_TRUE(times.has_gpu);
+  EXPECT_FLOAT_EQ((FrameProfilerBase::MAX_TIMESTAMPS - 2) / 2,
+                  GPUTime(times, FramePass::EFBCopy));
+}
+
+TEST(FrameProfiler, BackendsWithoutTimestampsOnlyHaveCPUTimes)
+{
+  FrameProfilerBase profiler;
+  profiler.BeginPass(FramePass::Present);
+  profiler.EndPass(FramePass::Present);
+  EXPECT_FALSE(profiler.IsActive());
+
+  profiler.EndFrame(true, false);
+  profiler.BeginPass(FramePass::Present);
+  profiler.EndPass(FramePass::Present);
+  profiler.EndFrame(true, false);
+  EXPECT_FALSE(profiler.GetAverageTimes().has_gpu);
+  EXPECT_FALSE(profiler.ToString().empty());
+
+  profiler.EndFrame(false, false);
+  EXPECT_FALSE(profiler.IsActive());
+  EXPECT_TRUE(profiler.ToString().empty());
+}
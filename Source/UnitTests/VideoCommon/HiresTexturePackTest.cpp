@@ -0,0 +1,84 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/HiresTexturePack.h"
+
+namespace
+{
+class HiresTexturePackTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    m_filename = m_dir + "/test.htp";
+  }
+  void TearDown() override { File::DeleteDirRecursively(m_dir); }
+
+  bool WritePack(size_t count)
+  {
+    HiresTexturePack::Writer writer;
+    if (!writer.Open(m_filename))
+      return false;
+    for (size_t i = 0; i < count; i++)
+    {
+      HiresTexturePack::Entry entry = {};
+      entry.width = static_cast<u32>(i + 1);
+      entry.levels = 1;
+      const std::vector<u8> data(i + 3, static_cast<u8>(i));
+      if (!writer.Add("tex1_" + std::to_string(i), HiresTexturePack::TEXTURE, entry, data.data(),
+                      data.size()))
+        return false;
+    }
+    return writer.Finish();
+  }
+
+  std::string m_dir;
+  std::string m_filename;
+};
+}
+
+TEST_F(HiresTexturePackTest, FindsEveryTexture)
+{
+  ASSERT_TRUE(WritePack(100));
+
+  HiresTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_filename));
+  EXPECT_EQ(100u, pack.GetCount());
+  for (size_t i = 0; i < 100; i++)
+  {
+    const HiresTexturePack::Entry* entry =
+        pack.Find("tex1_" + std::to_string(i), HiresTexturePack::TEXTURE);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(i + 1, entry->width);
+    ASSERT_EQ(i + 3, entry->data_size);
+    const u8* data = pack.GetData(*entry);
+    EXPECT_EQ(std::vector<u8>(i + 3, static_cast<u8>(i)), std::vector<u8>(data, data + i + 3));
+  }
+  EXPECT_EQ(nullptr, pack.Find("tex1_100", HiresTexturePack::TEXTURE));
+  // Enviroment maps are looked up separately from the textures of the same name.
+  EXPECT_EQ(nullptr, pack.Find("tex1_0", HiresTexturePack::ENVIROMENT));
+}
+
+TEST_F(HiresTexturePackTest, RejectsTruncatedPack)
+{
+  ASSERT_TRUE(WritePack(10));
+  {
+    File::IOFile file(m_filename, "r+b");
+    file.Resize(file.GetSize() - 8);
+  }
+
+  HiresTexturePack pack;
+  EXPECT_FALSE(pack.Open(m_filename));
+  EXPECT_FALSE(pack.IsOpen());
+  EXPECT_EQ(nullptr, pack.Find("tex1_0", HiresTexturePack::TEXTURE));
+}
@@ -0,0 +1,156 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+using Primitive = std::array<u32, 3>;
+
+// Rotates a triangle so that it starts with its lowest index, which keeps its winding.
+Primitive Normalize(Primitive triangle)
+{
+  std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()),
+              triangle.end());
+  return triangle;
+}
+
+// What the GX draws for count vertices starting at first, in the winding the backends expect.
+void AddExpected(int primitive, u32 first, u32 count, std::vector<Primitive>* out)
+{
+  auto add = [out, first](u32 a, u32 b, u32 c) {
+    out->push_back(Normalize({{first + a, first + b, first + c}}));
+  };
+  switch (primitive)
+  {
+  case OpcodeDecoder::GX_DRAW_QUADS:
+  case OpcodeDecoder::GX_DRAW_QUADS_2:
+    for (u32 i = 0; i + 4 <= count; i += 4)
+    {
+      add(i, i + 1, i + 2);
+      add(i, i + 2, i + 3);
+    }
+    if (count % 4 == 3)
+      add(count - 3, count - 2, count - 1);
+    break;
+  case OpcodeDecoder::GX_DRAW_TRIANGLES:
+    for (u32 i = 0; i + 3 <= count; i += 3)
+      add(i, i + 1, i + 2);
+    break;
+  case OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP:
+    for (u32 i = 0; i + 3 <= count; i++)
+    {
+      if (i & 1)
+        add(i, i + 2, i + 1);
+      else
+        add(i, i + 1, i + 2);
+    }
+    break;
+  case OpcodeDecoder::GX_DRAW_TRIANGLE_FAN:
+    for (u32 i = 2; i < count; i++)
+      add(0, i - 1, i);
+    break;
+  case OpcodeDecoder::GX_DRAW_LINES:
+    for (u32 i = 0; i + 2 <= count; i += 2)
+      out->push_back({{first + i, first + i + 1, 0}});
+    break;
+  case OpcodeDecoder::GX_DRAW_LINE_STRIP:
+    for (u32 i = 0; i + 2 <= count; i++)
+      out->push_back({{first + i, first + i + 1, 0}});
+    break;
+  case OpcodeDecoder::GX_DRAW_POINTS:
+    for (u32 i = 0; i < count; i++)
+      out->push_back({{first + i, 0, 0}});
+    break;
+  }
+}
+
+// Assembles the index list like the host GPU does.
+std::vector<Primitive> Assemble(int primitive, bool restart, const u16* indices, u32 length)
+{
+  std::vector<Primitive> out;
+  if (primitive >= static_cast<int>(OpcodeDecoder::GX_DRAW_LINES))
+  {
+    const u32 size = primitive == OpcodeDecoder::GX_DRAW_POINTS ? 1 : 2;
+    for (u32 i = 0; i + size <= length; i += size)
+      out.push_back({{indices[i], size > 1 ? indices[i + 1] : 0u, 0}});
+    return out;
+  }
+
+  if (!restart)
+  {
+    for (u32 i = 0; i + 3 <= length; i += 3)
+      out.push_back(Normalize({{indices[i], indices[i + 1], indices[i + 2]}}));
+    return out;
+  }
+
+  u32 strip_start = 0;
+  for (u32 i = 0; i < length; i++)
+  {
+    if (indices[i] == IndexGenerator::RESTART_INDEX)
+    {
+      strip_start = i + 1;
+      continue;
+    }
+    const u32 k = i - strip_start;
+    if (k < 2)
+      continue;
+    if (k & 1)
+      out.push_back(Normalize({{indices[i - 2], indices[i], indices[i - 1]}}));
+    else
+      out.push_back(Normalize({{indices[i - 2], indices[i - 1], indices[i]}}));
+  }
+  EXPECT_TRUE(length == 0 || indices[length - 1] == IndexGenerator::RESTART_INDEX);
+  return out;
+}
+}
+
+// The vectorized loops handle whole blocks of primitives, the scalar ones the rest. Every count
+// up to a few blocks has to produce the same primitives, with and without primitive restart.
+TEST(IndexGenerator, AllPrimitivesAndCounts)
+{
+  static const u32 PADDING = 64;
+  static const u16 CANARY = 0xABCD;
+  std::vector<u16> buffer(4096 + PADDING);
+
+  for (bool restart : {false, true})
+  {
+    g_ActiveConfig.backend_info.bSupportsPrimitiveRestart = restart;
+    IndexGenerator::Init();
+    for (int primitive = 0; primitive < 8; primitive++)
+    {
+      for (u32 count = 0; count < 100; count++)
+      {
+        std::fill(buffer.begin(), buffer.end(), CANARY);
+        IndexGenerator::Start(buffer.data());
+
+        // A leading draw makes the vertices of the tested one start at an odd index.
+        std::vector<Primitive> expected;
+        AddExpected(primitive, 0, 7, &expected);
+        IndexGenerator::AddIndices(primitive, 7);
+        AddExpected(primitive, 7, count, &expected);
+        IndexGenerator::AddIndices(primitive, count);
+
+        const u32 length = IndexGenerator::GetIndexLen();
+        ASSERT_LE(length + PADDING, buffer.size());
+        EXPECT_EQ(CANARY, buffer[length]);
+        EXPECT_EQ(7 + count, IndexGenerator::GetNumVerts());
+        EXPECT_EQ(expected, Assemble(primitive, restart, buffer.data(), length))
+            << "primitive " << primitive << ", " << count << " vertices, restart " << restart;
+      }
+    }
+  }
+
+  g_ActiveConfig.backend_info.bSupportsPrimitiveRestart = false;
+  IndexGenerator::Init();
+}
@@ -0,0 +1,84 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/ObjectUsageProfiler.h"
+
+namespace
+{
+using Profile = ObjectUsageProfiler<u32, pKey_t, int, std::hash<u32>>;
+
+constexpr pKey_t CATEGORY = 0x1234;
+constexpr pKey_t VERSION = 7;
+
+class ObjectUsageProfilerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_old_user_dir = File::GetUserPath(D_USER_IDX);
+    m_dir = File::CreateTempDir();
+    File::SetUserPath(D_USER_IDX, m_dir + DIR_SEP);
+    File::CreateFullPath(File::GetUserPath(D_SHADERUIDCACHE_IDX));
+  }
+  void TearDown() override
+  {
+    File::SetUserPath(D_USER_IDX, m_old_user_dir);
+    File::DeleteDirRecursively(m_dir);
+  }
+
+  std::unique_ptr<Profile> Create()
+  {
+    return std::unique_ptr<Profile>(
+        Profile::Create(CATEGORY, VERSION, "Global.test", "GAME01.test"));
+  }
+
+  std::string m_old_user_dir;
+  std::string m_dir;
+};
+}
+
+TEST_F(ObjectUsageProfilerTest, SharedProfileSeedsFirstRun)
+{
+  {
+    auto profile = Create();
+    EXPECT_FALSE(profile->IsSeeded());
+    for (u32 uid = 1; uid <= 3; uid++)
+    {
+      for (u32 i = 0; i < uid; i++)
+        profile->GetOrAdd(uid);
+    }
+    profile->Persist();
+  }
+
+  // Sharing the per game profile makes it seed a fresh install.
+  const std::string shared_dir = m_dir + DIR_SEP SHADERPROFILES_DIR DIR_SEP;
+  ASSERT_TRUE(File::CreateFullPath(shared_dir));
+  ASSERT_TRUE(File::Rename(File::GetUserPath(D_SHADERUIDCACHE_IDX) + "GAME01.test.usage",
+                           shared_dir + "GAME01.test.usage"));
+
+  auto profile = Create();
+  EXPECT_TRUE(profile->IsSeeded());
+  std::vector<u32> most_used;
+  profile->ForEachMostUsedByCategory(CATEGORY,
+                                     [&](const u32& uid, size_t total) {
+                                       most_used.push_back(uid);
+                                       EXPECT_EQ(2u, total);
+                                     },
+                                     {}, true, 3, 2);
+  EXPECT_EQ(std::vector<u32>({3, 2}), most_used);
+
+  // Once the game has a profile of its own, it is read instead.
+  profile->Persist();
+  EXPECT_FALSE(Create()->IsSeeded());
+}
@@ -0,0 +1,62 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+namespace
+{
+void AppendXFLoad(std::vector<u8>* data, u32 address, u32 size)
+{
+  const u32 cmd2 = ((size - 1) << 16) | address;
+  data->push_back(OpcodeDecoder::GX_LOAD_XF_REG);
+  for (int shift = 24; shift >= 0; shift -= 8)
+    data->push_back(static_cast<u8>(cmd2 >> shift));
+  data->resize(data->size() + size * sizeof(u32), 0xAB);
+}
+}
+
+TEST(OpcodeDecoder, FindsXFMemoryWritesThatContinueEachOther)
+{
+  std::vector<u8> data;
+  AppendXFLoad(&data, 0x20, 4);
+  AppendXFLoad(&data, 0x24, 4);
+  AppendXFLoad(&data, 0x28, 4);
+  const size_t run_end = data.size();
+  AppendXFLoad(&data, 0x40, 4);
+
+  const OpcodeDecoder::XFMemRun run = OpcodeDecoder::FindXFMemRun(data.data(), data.data() + data.size());
+  EXPECT_EQ(3u, run.count);
+  EXPECT_EQ(0x20u, run.address);
+  EXPECT_EQ(12u, run.size);
+  EXPECT_EQ(data.data() + run_end, run.end);
+}
+
+TEST(OpcodeDecoder, XFMemoryRunsStopAtTheRegistersAndOtherCommands)
+{
+  std::vector<u8> data;
+  AppendXFLoad(&data, 0xFF8, 4);
+  AppendXFLoad(&data, 0xFFC, 8);
+  EXPECT_EQ(1u, OpcodeDecoder::FindXFMemRun(data.data(), data.data() + data.size()).count);
+
+  data.clear();
+  AppendXFLoad(&data, 0x100, 2);
+  data.push_back(OpcodeDecoder::GX_NOP);
+  AppendXFLoad(&data, 0x102, 2);
+  EXPECT_EQ(1u, OpcodeDecoder::FindXFMemRun(data.data(), data.data() + data.size()).count);
+
+  // A command cut off by the end of the data isn't taken.
+  data.clear();
+  AppendXFLoad(&data, 0x100, 2);
+  AppendXFLoad(&data, 0x102, 2);
+  EXPECT_EQ(1u, OpcodeDecoder::FindXFMemRun(data.data(), data.data() + data.size() - 1).count);
+
+  data.clear();
+  AppendXFLoad(&data, 0x1000, 1);
+  EXPECT_EQ(0u, OpcodeDecoder::FindXFMemRun(data.data(), data.data() + data.size()).count);
+}
@@ -0,0 +1,229 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/File.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/ScaledTextureCache.h"
+#include "VideoCommon/TextureUtil.h"
+
+namespace
+{
+ScaledTexturePack::Key MakeKey(u64 hash)
+{
+  ScaledTexturePack::Key key = {};
+  key.hash = hash;
+  key.width = 32;
+  key.height = 32;
+  key.levels = 1;
+  key.scaling_type = 1;
+  key.scaling_factor = 2;
+  return key;
+}
+
+ScaledTexturePack::Texture MakeTexture(u32 size, u8 fill)
+{
+  ScaledTexturePack::Texture texture;
+  texture.info = {PC_TEX_FMT_RGBA32, 64, 64, 1, size};
+  texture.data.assign(size, fill);
+  return texture;
+}
+
+class ScaledTexturePackTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    m_filename = m_dir + "/test.pack";
+  }
+  void TearDown() override { File::DeleteDirRecursively(m_dir); }
+
+  std::string m_dir;
+  std::string m_filename;
+};
+
+// Reference DXT5 decoder, for the colors of the pixel at index i of the block.
+std::array<s32, 4> DecodeDXT5Pixel(const u8* block, u32 i)
+{
+  const s32 a0 = block[0], a1 = block[1];
+  u64 alpha_bits = 0;
+  for (u32 b = 0; b < 6; b++)
+    alpha_bits |= u64(block[2 + b]) << (b * 8);
+  const u32 alpha_code = (alpha_bits >> (i * 3)) & 7;
+  s32 alpha;
+  if (alpha_code < 2)
+    alpha = alpha_code == 0 ? a0 : a1;
+  else if (a0 > a1)
+    alpha = ((8 - alpha_code) * a0 + (alpha_code - 1) * a1) / 7;
+  else if (alpha_code < 6)
+    alpha = ((6 - alpha_code) * a0 + (alpha_code - 1) * a1) / 5;
+  else
+    alpha = alpha_code == 6 ? 0 : 255;
+
+  s32 colors[4][3];
+  for (u32 e = 0; e < 2; e++)
+  {
+    const u16 c = block[8 + e * 2] | (block[9 + e * 2] << 8);
+    const s32 r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    colors[e][0] = (r << 3) | (r >> 2);
+    colors[e][1] = (g << 2) | (g >> 4);
+    colors[e][2] = (b << 3) | (b >> 2);
+  }
+  for (u32 c = 0; c < 3; c++)
+  {
+    colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+    colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+  }
+  u32 color_bits;
+  std::memcpy(&color_bits, block + 12, sizeof(u32));
+  const u32 code = (color_bits >> (i * 2)) & 3;
+  return {colors[code][0], colors[code][1], colors[code][2], alpha};
+}
+}
+
+TEST_F(ScaledTexturePackTest, ReadsBackAfterReopen)
+{
+  {
+    ScaledTexturePack pack;
+    ASSERT_TRUE(pack.Open(m_filename, UINT64_MAX));
+    EXPECT_TRUE(pack.Append(MakeKey(1), MakeTexture(100, 0x11)));
+    EXPECT_TRUE(pack.Append(MakeKey(2), MakeTexture(200, 0x22)));
+  }
+
+  ScaledTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_filename, UINT64_MAX));
+  EXPECT_EQ(2u, pack.GetCount());
+  ScaledTexturePack::Texture texture;
+  ASSERT_TRUE(pack.Read(MakeKey(2), &texture));
+  EXPECT_EQ(200u, texture.info.data_size);
+  EXPECT_EQ(MakeTexture(200, 0x22).data, texture.data);
+  EXPECT_EQ(64u, texture.info.width);
+  EXPECT_FALSE(pack.Read(MakeKey(3), &texture));
+
+  // Keys differing in the scaler don't match.
+  ScaledTexturePack::Key other_factor = MakeKey(1);
+  other_factor.scaling_factor = 3;
+  EXPECT_FALSE(pack.Contains(other_factor));
+}
+
+TEST_F(ScaledTexturePackTest, DropsTruncatedRecord)
+{
+  {
+    ScaledTexturePack pack;
+    ASSERT_TRUE(pack.Open(m_filename, UINT64_MAX));
+    pack.Append(MakeKey(1), MakeTexture(100, 0x11));
+    pack.Append(MakeKey(2), MakeTexture(100, 0x22));
+  }
+  {
+    File::IOFile file(m_filename, "r+b");
+    file.Resize(file.GetSize() - 10);
+  }
+
+  ScaledTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_filename, UINT64_MAX));
+  EXPECT_TRUE(pack.Contains(MakeKey(1)));
+  EXPECT_FALSE(pack.Contains(MakeKey(2)));
+  EXPECT_TRUE(pack.Append(MakeKey(3), MakeTexture(100, 0x33)));
+
+  ScaledTexturePack reopened;
+  ASSERT_TRUE(reopened.Open(m_filename, UINT64_MAX));
+  ScaledTexturePack::Texture texture;
+  ASSERT_TRUE(reopened.Read(MakeKey(3), &texture));
+  EXPECT_EQ(MakeTexture(100, 0x33).data, texture.data);
+}
+
+TEST_F(ScaledTexturePackTest, CompactDropsLeastRecentlyUsed)
+{
+  const u32 data_size = 1000;
+  {
+    ScaledTexturePack pack;
+    ASSERT_TRUE(pack.Open(m_filename, UINT64_MAX));
+    for (u64 i = 1; i <= 4; i++)
+      pack.Append(MakeKey(i), MakeTexture(data_size, static_cast<u8>(i)));
+
+    // 1 is now the most recently used one, 2 the least.
+    ScaledTexturePack::Texture texture;
+    ASSERT_TRUE(pack.Read(MakeKey(1), &texture));
+    ASSERT_TRUE(pack.Compact(3 * data_size + 200));
+    EXPECT_EQ(3u, pack.GetCount());
+    EXPECT_FALSE(pack.Contains(MakeKey(2)));
+    ASSERT_TRUE(pack.Read(MakeKey(1), &texture));
+    EXPECT_EQ(MakeTexture(data_size, 1).data, texture.data);
+  }
+
+  // The order survives reopening: 3 is the least recently used one now.
+  ScaledTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_filename, 2 * data_size + 200));
+  EXPECT_EQ(2u, pack.GetCount());
+  EXPECT_FALSE(pack.Contains(MakeKey(3)));
+  EXPECT_TRUE(pack.Contains(MakeKey(4)));
+  EXPECT_TRUE(pack.Contains(MakeKey(1)));
+}
+
+TEST_F(ScaledTexturePackTest, CacheWritesStoredTexturesOnShutdown)
+{
+  ScaledTextureCache::Level level0 = {std::vector<u32>(10 * 8, 0xFF00FF00), 8, 8, 10};
+  ScaledTextureCache::Level level1 = {std::vector<u32>(4 * 4, 0xFF0000FF), 4, 4, 4};
+  {
+    ScaledTextureCache cache(m_filename, UINT64_MAX, true);
+    cache.Store(MakeKey(1), {level0, level1});
+  }
+
+  ScaledTexturePack pack;
+  ASSERT_TRUE(pack.Open(m_filename, UINT64_MAX));
+  ScaledTexturePack::Texture texture;
+  ASSERT_TRUE(pack.Read(MakeKey(1), &texture));
+  EXPECT_EQ(static_cast<u32>(PC_TEX_FMT_DXT5), texture.info.format);
+  EXPECT_EQ(8u, texture.info.width);
+  EXPECT_EQ(2u, texture.info.levels);
+  EXPECT_EQ(4u * 16u + 16u, texture.data.size());
+  EXPECT_EQ((std::array<s32, 4>{0, 255, 0, 255}), DecodeDXT5Pixel(texture.data.data(), 5));
+  EXPECT_EQ((std::array<s32, 4>{255, 0, 0, 255}), DecodeDXT5Pixel(&texture.data[4 * 16], 5));
+}
+
+TEST(TextureUtil, CompressRGBA32ToDXT5)
+{
+  // A diagonal gradient from red to green with a transparent corner, 6x6 so the blocks on the
+  // right and bottom get padded.
+  const u32 width = 6, height = 6;
+  std::vector<u32> image(width * height);
+  for (u32 y = 0; y < height; y++)
+  {
+    for (u32 x = 0; x < width; x++)
+    {
+      const u32 alpha = x < 2 && y < 2 ? 0 : 255;
+      const u32 t = (x + y) * 20;
+      image[y * width + x] = (alpha << 24) | (0x40 << 16) | (t << 8) | (255 - t);
+    }
+  }
+
+  std::vector<u8> blocks(TextureUtil::GetTextureSizeInBytes(width, height, PC_TEX_FMT_DXT5));
+  ASSERT_EQ(4u * 16u, blocks.size());
+  TextureUtil::CompressRGBA32ToDXT5(blocks.data(), image.data(), width, height, width);
+  for (u32 y = 0; y < height; y++)
+  {
+    for (u32 x = 0; x < width; x++)
+    {
+      const u8* block = &blocks[((y / 4) * 2 + x / 4) * 16];
+      const std::array<s32, 4> decoded = DecodeDXT5Pixel(block, (y % 4) * 4 + x % 4);
+      const u32 pixel = image[y * width + x];
+      for (u32 c = 0; c < 4; c++)
+      {
+        const s32 expected = (pixel >> (c * 8)) & 0xFF;
+        // Alpha is exact for fully transparent and opaque pixels.
+        EXPECT_LE(std::abs(decoded[c] - expected), c == 3 ? 0 : 24)
+            << "pixel " << x << "," << y << " channel " << c;
+      }
+    }
+  }
+}
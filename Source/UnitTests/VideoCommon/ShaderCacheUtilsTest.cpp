@@ -0,0 +1,109 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/ShaderCacheUtils.h"
+
+namespace
+{
+class CollectingReader : public LinearDiskCacheReader<u32, u32>
+{
+public:
+  void Read(const u32& key, const u32* value, u32 value_size) override
+  {
+    keys.push_back(key);
+    values.emplace_back(value, value + value_size);
+  }
+
+  std::vector<u32> keys;
+  std::vector<std::vector<u32>> values;
+};
+
+class ShaderDiskCacheTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    m_filename = m_dir + "/test.cache";
+  }
+  void TearDown() override { File::DeleteDirRecursively(m_dir); }
+
+  std::string m_dir;
+  std::string m_filename;
+};
+}
+
+TEST(ShaderCacheUtils, CompressionRoundTrip)
+{
+  std::vector<u8> data(5000);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = static_cast<u8>(i % 7);
+
+  std::vector<u8> compressed;
+  std::vector<u8> decompressed;
+  ASSERT_TRUE(ShaderCacheUtils::CompressShaderData(data.data(), static_cast<u32>(data.size()),
+                                                   &compressed));
+  EXPECT_LT(compressed.size(), data.size());
+  ASSERT_TRUE(ShaderCacheUtils::DecompressShaderData(
+      compressed.data(), static_cast<u32>(compressed.size()), &decompressed));
+  EXPECT_EQ(data, decompressed);
+
+  compressed.resize(compressed.size() / 2);
+  EXPECT_FALSE(ShaderCacheUtils::DecompressShaderData(
+      compressed.data(), static_cast<u32>(compressed.size()), &decompressed));
+}
+
+TEST_F(ShaderDiskCacheTest, DuplicatesAreRemovedOnOpen)
+{
+  const std::vector<u32> first = {1, 2, 3};
+  const std::vector<u32> second = {4, 5, 6, 7};
+  {
+    ShaderCacheUtils::ShaderDiskCache<u32, u32> cache;
+    CollectingReader reader;
+    EXPECT_EQ(0u, cache.OpenAndRead(m_filename, reader));
+    cache.Append(10, first.data(), static_cast<u32>(first.size()));
+    cache.Append(20, first.data(), static_cast<u32>(first.size()));
+    cache.Append(10, second.data(), static_cast<u32>(second.size()));
+    cache.Close();
+  }
+  {
+    ShaderCacheUtils::ShaderDiskCache<u32, u32> cache;
+    CollectingReader reader;
+    // Only the newest copy of a key is read.
+    EXPECT_EQ(2u, cache.OpenAndRead(m_filename, reader));
+    cache.Close();
+  }
+  ShaderCacheUtils::ShaderDiskCache<u32, u32> cache;
+  CollectingReader reader;
+  EXPECT_EQ(2u, cache.OpenAndRead(m_filename, reader));
+  ASSERT_EQ(2u, reader.keys.size());
+  EXPECT_EQ(20u, reader.keys[0]);
+  EXPECT_EQ(first, reader.values[0]);
+  EXPECT_EQ(10u, reader.keys[1]);
+  EXPECT_EQ(second, reader.values[1]);
+}
+
+TEST_F(ShaderDiskCacheTest, GetWithoutReading)
+{
+  const std::vector<u32> value = {1, 2, 3};
+  {
+    ShaderCacheUtils::ShaderDiskCache<u32, u32> cache;
+    EXPECT_EQ(0u, cache.Open(m_filename));
+    cache.Append(10, value.data(), static_cast<u32>(value.size()));
+    cache.Close();
+  }
+  ShaderCacheUtils::ShaderDiskCache<u32, u32> cache;
+  EXPECT_EQ(1u, cache.Open(m_filename));
+  std::vector<u32> result;
+  ASSERT_TRUE(cache.Get(10, &result));
+  EXPECT_EQ(value, result);
+  EXPECT_FALSE(cache.Get(20, &result));
+}
@@ -0,0 +1,111 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "VideoCommon/ObjectUsageProfiler.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/VertexShaderGen.h"
+#include "VideoCommon/VideoConfig.h"
+
+TEST(ShaderCode, Write)
+{
+  ShaderCode code;
+  code.Write("float4 ocol0;\n");
+  code.Write("%s = %d.%02d;\n", "x", 1, 5);
+  code.Write("100%%\n");
+  EXPECT_EQ("float4 ocol0;\nx = 1.05;\n100%\n", std::string(code.data(), code.size()));
+}
+
+TEST(ShaderCode, WriteLongLine)
+{
+  const std::string line(5000, 'a');
+  ShaderCode code;
+  code.Write("// %s\n", line.c_str());
+  EXPECT_EQ("// " + line + "\n", std::string(code.data(), code.size()));
+}
+
+TEST(ShaderCode, ReusedBufferStartsEmpty)
+{
+  {
+    ShaderCode code;
+    code.Write("void main() {}\n");
+  }
+  ShaderCode code;
+  EXPECT_EQ(0, code.size());
+  code.Write("%d", 7);
+  EXPECT_EQ("7", std::string(code.data(), code.size()));
+}
+
+namespace
+{
+template <typename Uid>
+using Profile = ObjectUsageProfiler<Uid, pKey_t, int, typename Uid::ShaderUidHasher>;
+
+// Loads every uid in "<user dir>/Cache/ShaderUidCache/<game id>.<type>.usage".
+template <typename Uid>
+std::vector<Uid> LoadRecordedUids(const std::string& game_id, const char* type, pKey_t version)
+{
+  std::unique_ptr<Profile<Uid>> profile(Profile<Uid>::Create(
+      0, version, std::string("Ishiiruka.") + type, game_id + "." + type));
+  std::vector<Uid> uids;
+  profile->ForEachMostUsed([&uids](const Uid& uid) { uids.push_back(uid); });
+  return uids;
+}
+
+template <typename Uid, typename Generate>
+void Benchmark(const char* type, const std::vector<Uid>& uids, Generate generate)
+{
+  size_t total_size = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const Uid& uid : uids)
+  {
+    ShaderCode code;
+    generate(code, uid.GetUidData());
+    total_size += code.size();
+  }
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  std::printf("%s: %zu shaders, %zu bytes in %lld us\n", type, uids.size(), total_size,
+              static_cast<long long>(elapsed.count()));
+}
+}
+
+// Generates the source of every shader a game used. Run with
+// --gtest_also_run_disabled_tests, SHADERGEN_USER_DIR set to a user directory and
+// SHADERGEN_GAME_ID to the game whose usage profiles it holds.
+TEST(ShaderGen, DISABLED_GenerateRecordedProfile)
+{
+  const char* user_dir = std::getenv("SHADERGEN_USER_DIR");
+  const char* game_id = std::getenv("SHADERGEN_GAME_ID");
+  ASSERT_TRUE(user_dir && game_id);
+  const std::string old_user_dir = File::GetUserPath(D_USER_IDX);
+  File::SetUserPath(D_USER_IDX, std::string(user_dir) + DIR_SEP);
+
+  const auto pixel_uids = LoadRecordedUids<PixelShaderUid>(game_id, "ps",
+                                                           PIXELSHADERGEN_UID_VERSION);
+  const auto vertex_uids = LoadRecordedUids<VertexShaderUid>(game_id, "vs",
+                                                             VERTEXSHADERGEN_UID_VERSION);
+  File::SetUserPath(D_USER_IDX, old_user_dir);
+
+  g_ActiveConfig.backend_info.APIType = API_D3D11;
+  const ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
+  Benchmark("ps", pixel_uids, [&](ShaderCode& code, const pixel_shader_uid_data& uid_data) {
+    GeneratePixelShaderCode(code, uid_data, host_config);
+  });
+  Benchmark("vs", vertex_uids, [&](ShaderCode& code, const vertex_shader_uid_data& uid_data) {
+    GenerateVertexShaderCode(code, uid_data, host_config);
+  });
+}
@@ -0,0 +1,55 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/XFMemory.h"
+
+TEST(ShaderUidTracker, DrawInputs)
+{
+  ShaderUidTracker tracker(SHADER_UID_PIXEL);
+  EXPECT_FALSE(tracker.IsUnchanged(1));
+  EXPECT_TRUE(tracker.IsUnchanged(1));
+  EXPECT_FALSE(tracker.IsUnchanged(2));
+  EXPECT_FALSE(tracker.IsUnchanged(2, 1));
+  EXPECT_TRUE(tracker.IsUnchanged(2, 1));
+  tracker.Reset();
+  EXPECT_FALSE(tracker.IsUnchanged(2, 1));
+}
+
+TEST(ShaderUidTracker, RegisterWritesInvalidateTheirStages)
+{
+  ShaderUidTracker pixel(SHADER_UID_PIXEL);
+  ShaderUidTracker vertex(SHADER_UID_VERTEX);
+  pixel.IsUnchanged(0);
+  vertex.IsUnchanged(0);
+
+  InvalidateShaderUidsForBPWrite(BPMEM_TEV_COLOR_ENV + 4);
+  EXPECT_FALSE(pixel.IsUnchanged(0));
+  EXPECT_TRUE(vertex.IsUnchanged(0));
+
+  // Texture and scissor registers don't feed any uid.
+  InvalidateShaderUidsForBPWrite(BPMEM_TX_SETIMAGE3);
+  InvalidateShaderUidsForBPWrite(BPMEM_SCISSORTL);
+  EXPECT_TRUE(pixel.IsUnchanged(0));
+
+  InvalidateShaderUidsForXFWrite(XFMEM_SETTEXMTXINFO + 2, 1);
+  EXPECT_TRUE(pixel.IsUnchanged(0));
+  EXPECT_FALSE(vertex.IsUnchanged(0));
+
+  // Nor do matrix indices and viewports, which most games change every draw.
+  InvalidateShaderUidsForXFWrite(XFMEM_SETMATRIXINDA, 8);
+  EXPECT_TRUE(pixel.IsUnchanged(0));
+  EXPECT_TRUE(vertex.IsUnchanged(0));
+
+  InvalidateShaderUidsForXFWrite(XFMEM_SETNUMTEXGENS, 1);
+  EXPECT_FALSE(pixel.IsUnchanged(0));
+  EXPECT_FALSE(vertex.IsUnchanged(0));
+
+  InvalidateShaderUids();
+  EXPECT_FALSE(pixel.IsUnchanged(0));
+  EXPECT_FALSE(vertex.IsUnchanged(0));
+}
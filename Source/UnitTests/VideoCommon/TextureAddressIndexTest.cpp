@@ -0,0 +1,250 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/FifoPlayer/FifoAnalyzer.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/TextureAddressIndex.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+struct Entry
+{
+  u32 addr;
+  u32 size;
+};
+
+using Index = TextureAddressIndex<Entry>;
+
+std::vector<Entry*> FindAt(const Index& index, u32 address)
+{
+  std::vector<Entry*> found;
+  index.FindAt(address, &found);
+  return found;
+}
+
+std::vector<Entry*> FindOverlapping(const Index& index, u32 address, u32 size)
+{
+  std::vector<Entry*> found;
+  index.FindOverlapping(address, size, &found);
+  return found;
+}
+}
+
+TEST(TextureAddressIndex, FindAtKeepsInsertionOrder)
+{
+  Entry a{0x1000, 0x100}, b{0x1000, 0x200}, c{0x2000, 0x100};
+  Index index;
+  index.Insert(&a, a.addr, a.size);
+  index.Insert(&b, b.addr, b.size);
+  index.Insert(&c, c.addr, c.size);
+
+  EXPECT_EQ(std::vector<Entry*>({&a, &b}), FindAt(index, 0x1000));
+  EXPECT_TRUE(FindAt(index, 0x1100).empty());
+
+  EXPECT_TRUE(index.Remove(&a));
+  EXPECT_FALSE(index.Remove(&a));
+  EXPECT_FALSE(index.Contains(&a));
+  EXPECT_EQ(std::vector<Entry*>({&b}), FindAt(index, 0x1000));
+  EXPECT_EQ(2u, index.size());
+}
+
+TEST(TextureAddressIndex, FindOverlappingReportsEachEntryOnce)
+{
+  // Spans several buckets, and so does the query.
+  Entry big{0x00F000, 0x300000};
+  Entry before{0x00E000, 0x1000};
+  Entry inside{0x100000, 0x40};
+  Entry after{0x30F000, 0x1000};
+  Entry empty{0x200000, 0};
+  Index index;
+  index.Insert(&after, after.addr, after.size);
+  index.Insert(&inside, inside.addr, inside.size);
+  index.Insert(&big, big.addr, big.size);
+  index.Insert(&before, before.addr, before.size);
+  index.Insert(&empty, empty.addr, empty.size);
+
+  EXPECT_EQ(std::vector<Entry*>({&big, &inside, &empty}),
+            FindOverlapping(index, 0x0FFFC0, 0x200000));
+  EXPECT_EQ(std::vector<Entry*>({&before, &big}), FindOverlapping(index, 0x00E800, 0x1000));
+  EXPECT_EQ(std::vector<Entry*>({&after}), FindOverlapping(index, 0x30F000, 0x10));
+
+  index.Remove(&big);
+  EXPECT_EQ(std::vector<Entry*>({&inside, &empty}), FindOverlapping(index, 0x0FFFC0, 0x200000));
+}
+
+namespace
+{
+// The texture loads and EFB copies of a FIFO log, in the order the GPU sees them.
+struct CacheAccess
+{
+  bool efb_copy;
+  u32 address;
+  u32 size;
+};
+
+std::vector<CacheAccess> ReadAccesses(FifoDataFile* file)
+{
+  u32* cp_mem = file->GetCPMem();
+  FifoAnalyzer::LoadCPReg(0x50, cp_mem[0x50], FifoAnalyzer::s_CpMem);
+  FifoAnalyzer::LoadCPReg(0x60, cp_mem[0x60], FifoAnalyzer::s_CpMem);
+  for (u32 i = 0; i < 8; ++i)
+  {
+    FifoAnalyzer::LoadCPReg(0x70 + i, cp_mem[0x70 + i], FifoAnalyzer::s_CpMem);
+    FifoAnalyzer::LoadCPReg(0x80 + i, cp_mem[0x80 + i], FifoAnalyzer::s_CpMem);
+    FifoAnalyzer::LoadCPReg(0x90 + i, cp_mem[0x90 + i], FifoAnalyzer::s_CpMem);
+  }
+
+  std::vector<u32> bp(file->GetBPMem(), file->GetBPMem() + 0x100);
+  std::vector<CacheAccess> accesses;
+  for (u32 frame_index = 0; frame_index < file->GetFrameCount(); ++frame_index)
+  {
+    const std::vector<u8>& data = file->GetFrame(frame_index).fifoData;
+    u32 position = 0;
+    while (position < data.size())
+    {
+      const u32 size = FifoAnalyzer::AnalyzeCommand(&data[position], FifoAnalyzer::DECODE_PLAYBACK);
+      if (size == 0)
+        break;
+      if (data[position] == OpcodeDecoder::GX_LOAD_BP_REG && size >= 5)
+      {
+        const u32 value = Common::swap32(&data[position + 1]);
+        const u32 reg = value >> 24;
+        bp[reg] = value & 0xFFFFFF;
+        const bool set_image3 = (reg >= BPMEM_TX_SETIMAGE3 && reg < BPMEM_TX_SETIMAGE3 + 4) ||
+                                (reg >= BPMEM_TX_SETIMAGE3_4 && reg < BPMEM_TX_SETIMAGE3_4 + 4);
+        if (set_image3)
+        {
+          const u32 image0 = bp[reg - (BPMEM_TX_SETIMAGE3 - BPMEM_TX_SETIMAGE0)];
+          const u32 width = (image0 & 0x3FF) + 1;
+          const u32 height = ((image0 >> 10) & 0x3FF) + 1;
+          const u32 format = (image0 >> 20) & 0xF;
+          const u32 block_width = TexDecoder::GetBlockWidthInTexels(format);
+          const u32 block_height = TexDecoder::GetBlockHeightInTexels(format);
+          const u32 texture_size = TexDecoder::GetTextureSizeInBytes(
+              (width + block_width - 1) / block_width * block_width,
+              (height + block_height - 1) / block_height * block_height, format);
+          accesses.push_back({false, (value & 0xFFFFFF) << 5, texture_size});
+        }
+        else if (reg == BPMEM_TRIGGER_EFB_COPY && !(value & (1 << 14)))
+        {
+          const u32 height = ((bp[BPMEM_EFB_BR] >> 10) & 0x3FF) + 1;
+          const u32 stride = bp[BPMEM_MIPMAP_STRIDE] << 5;
+          accesses.push_back({true, bp[BPMEM_EFB_ADDR] << 5, (height + 3) / 4 * stride});
+        }
+      }
+      position += size;
+    }
+  }
+  return accesses;
+}
+
+// What TextureCacheBase does with the addresses: loads look up the entries at their address and
+// add one if there is none, then look for EFB copies overlapping it. EFB copies drop every entry
+// they overlap and add themselves.
+template <typename FindAtFunc, typename FindOverlappingFunc, typename InsertFunc,
+          typename RemoveFunc>
+double Replay(const std::vector<CacheAccess>& accesses, FindAtFunc find_at,
+              FindOverlappingFunc find_overlapping, InsertFunc insert, RemoveFunc remove)
+{
+  std::deque<Entry> entries;
+  std::vector<Entry*> found;
+  const auto start = std::chrono::steady_clock::now();
+  for (const CacheAccess& access : accesses)
+  {
+    found.clear();
+    if (access.efb_copy)
+    {
+      find_overlapping(access.address, access.size, &found);
+      for (Entry* entry : found)
+      {
+        if (entry->addr < access.address + access.size && access.address < entry->addr + entry->size)
+          remove(entry);
+      }
+    }
+    else
+    {
+      find_at(access.address, &found);
+      if (!found.empty())
+        continue;
+      find_overlapping(access.address, access.size, &found);
+    }
+    entries.push_back({access.address, access.size});
+    insert(&entries.back());
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+}
+
+// Replays the texture cache lookups of a FIFO log against TextureAddressIndex and the multimap it
+// replaced. Run with --gtest_also_run_disabled_tests and TEXTURE_INDEX_FIFO_LOG set to a FIFO log,
+// ideally of a game doing many EFB copies.
+TEST(TextureAddressIndex, DISABLED_ReplayFifoLog)
+{
+  const char* filename = std::getenv("TEXTURE_INDEX_FIFO_LOG");
+  ASSERT_TRUE(filename);
+  std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(filename, false);
+  ASSERT_TRUE(file);
+  FifoAnalyzer::Init();
+  const std::vector<CacheAccess> accesses = ReadAccesses(file.get());
+  size_t efb_copies = 0;
+  for (const CacheAccess& access : accesses)
+    efb_copies += access.efb_copy;
+
+  Index index;
+  const double index_ms = Replay(
+      accesses, [&](u32 address, std::vector<Entry*>* out) { index.FindAt(address, out); },
+      [&](u32 address, u32 size, std::vector<Entry*>* out) {
+        index.FindOverlapping(address, size, out);
+      },
+      [&](Entry* entry) { index.Insert(entry, entry->addr, entry->size); },
+      [&](Entry* entry) { index.Remove(entry); });
+
+  std::multimap<u32, Entry*> map;
+  const double map_ms = Replay(
+      accesses,
+      [&](u32 address, std::vector<Entry*>* out) {
+        auto range = map.equal_range(address);
+        for (auto it = range.first; it != range.second; ++it)
+          out->push_back(it->second);
+      },
+      [&](u32 address, u32 size, std::vector<Entry*>* out) {
+        constexpr u32 max_texture_size = 1024 * 1024 * 4;
+        auto it = map.lower_bound(address > max_texture_size ? address - max_texture_size : 0);
+        auto end = map.upper_bound(address + size);
+        for (; it != end; ++it)
+          out->push_back(it->second);
+      },
+      [&](Entry* entry) { map.emplace(entry->addr, entry); },
+      [&](Entry* entry) {
+        auto range = map.equal_range(entry->addr);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+          if (it->second == entry)
+          {
+            map.erase(it);
+            break;
+          }
+        }
+      });
+
+  EXPECT_EQ(map.size(), index.size());
+  std::printf("%zu texture loads, %zu EFB copies: index %.2f ms, multimap %.2f ms\n",
+              accesses.size() - efb_copies, efb_copies, index_ms, map_ms);
+}
@@ -0,0 +1,289 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+struct Format
+{
+  const char* name;
+  u32 texformat;
+  TlutFormat tlutfmt;
+};
+
+const Format s_formats[] = {
+    {"I4", GX_TF_I4, GX_TL_IA8},
+    {"I8", GX_TF_I8, GX_TL_IA8},
+    {"IA4", GX_TF_IA4, GX_TL_IA8},
+    {"IA8", GX_TF_IA8, GX_TL_IA8},
+    {"RGB565", GX_TF_RGB565, GX_TL_IA8},
+    {"RGB5A3", GX_TF_RGB5A3, GX_TL_IA8},
+    {"RGBA8", GX_TF_RGBA8, GX_TL_IA8},
+    {"C4 IA8", GX_TF_C4, GX_TL_IA8},
+    {"C4 RGB565", GX_TF_C4, GX_TL_RGB565},
+    {"C4 RGB5A3", GX_TF_C4, GX_TL_RGB5A3},
+    {"C8 IA8", GX_TF_C8, GX_TL_IA8},
+    {"C8 RGB565", GX_TF_C8, GX_TL_RGB565},
+    {"C8 RGB5A3", GX_TF_C8, GX_TL_RGB5A3},
+    {"C14X2 IA8", GX_TF_C14X2, GX_TL_IA8},
+    {"C14X2 RGB565", GX_TF_C14X2, GX_TL_RGB565},
+    {"C14X2 RGB5A3", GX_TF_C14X2, GX_TL_RGB5A3},
+    {"CMPR", GX_TF_CMPR, GX_TL_IA8},
+};
+
+// A single block, an odd number of blocks across, and sizes a game would use.
+const u32 s_sizes[][2] = {{1, 1}, {12, 4}, {20, 12}, {64, 32}, {256, 256}};
+
+// Where the palette goes in TMEM, it is only read there.
+const u32 TLUT_ADDRESS = 0x80000;
+
+u32 RoundUp(u32 value, u32 multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+// Expands the decoder output to RGBA, the format DecodeTexel writes.
+u32 ToRGBA(const u8* data, u32 index, HostTextureFormat format)
+{
+  switch (format)
+  {
+  case PC_TEX_FMT_I4_AS_I8:
+  case PC_TEX_FMT_I8:
+    return data[index] * 0x01010101u;
+  case PC_TEX_FMT_IA4_AS_IA8:
+  case PC_TEX_FMT_IA8:
+  {
+    u16 value;
+    std::memcpy(&value, data + index * 2, sizeof(value));
+    return (value & 0xFF) * 0x010101u | (value >> 8) << 24;
+  }
+  case PC_TEX_FMT_RGB565:
+  {
+    u16 value;
+    std::memcpy(&value, data + index * 2, sizeof(value));
+    const u32 r = (value >> 11) & 0x1F, g = (value >> 5) & 0x3F, b = value & 0x1F;
+    return ((r << 3) | (r >> 2)) | ((g << 2) | (g >> 4)) << 8 | ((b << 3) | (b >> 2)) << 16 |
+           0xFF000000u;
+  }
+  case PC_TEX_FMT_BGRA32:
+  {
+    u32 value;
+    std::memcpy(&value, data + index * 4, sizeof(value));
+    return (value & 0xFF00FF00u) | (value >> 16 & 0xFF) | (value & 0xFF) << 16;
+  }
+  default:
+  {
+    u32 value;
+    std::memcpy(&value, data + index * 4, sizeof(value));
+    return value;
+  }
+  }
+}
+
+// DecodeTexel gives the transparent CMPR color the average of both colors, the texture decoders
+// color 2. Only the alpha of those can be compared.
+u32 Comparable(u32 rgba, u32 texformat)
+{
+  return texformat == GX_TF_CMPR && (rgba >> 24) == 0 ? 0 : rgba;
+}
+
+class TextureDecoderTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_had_avx2 = cpu_info.bAVX2;
+    std::mt19937 rng(0x5eed);
+    for (u32 i = 0; i < 0x8000; i++)
+      texMem[TLUT_ADDRESS + i] = static_cast<u8>(rng());
+  }
+  void TearDown() override { cpu_info.bAVX2 = m_had_avx2; }
+
+  // Checks every texel of both outputs of Decode against DecodeTexel.
+  void Check(const Format& format, u32 width, u32 height)
+  {
+    SCOPED_TRACE(testing::Message() << format.name << " " << width << "x" << height);
+    width = RoundUp(width, TexDecoder::GetBlockWidthInTexels(format.texformat));
+    height = RoundUp(height, TexDecoder::GetBlockHeightInTexels(format.texformat));
+    std::mt19937 rng(width * 1000 + height);
+    std::vector<u8> src(TexDecoder::GetTextureSizeInBytes(width, height, format.texformat));
+    for (u8& byte : src)
+      byte = static_cast<u8>(rng());
+
+    const u16* tlut = reinterpret_cast<const u16*>(texMem + TLUT_ADDRESS);
+    std::vector<u32> expected(width * height);
+    for (u32 t = 0; t < height; t++)
+    {
+      for (u32 s = 0; s < width; s++)
+      {
+        TexDecoder::DecodeTexel(reinterpret_cast<u8*>(&expected[t * width + s]), src.data(), s, t,
+                                width - 1, format.texformat, tlut, format.tlutfmt);
+      }
+    }
+
+    std::vector<u8> dst(width * height * 4);
+    ASSERT_EQ(PC_TEX_FMT_RGBA32,
+              TexDecoder::Decode(dst.data(), src.data(), width, height, format.texformat,
+                                 TLUT_ADDRESS, format.tlutfmt, true));
+    for (u32 i = 0; i < width * height; i++)
+    {
+      ASSERT_EQ(Comparable(expected[i], format.texformat),
+                Comparable(ToRGBA(dst.data(), i, PC_TEX_FMT_RGBA32), format.texformat))
+          << "RGBA texel " << i;
+    }
+
+    std::fill(dst.begin(), dst.end(), 0);
+    const HostTextureFormat native =
+        TexDecoder::Decode(dst.data(), src.data(), width, height, format.texformat, TLUT_ADDRESS,
+                           format.tlutfmt, false);
+    ASSERT_NE(PC_TEX_FMT_NONE, native);
+    for (u32 i = 0; i < width * height; i++)
+    {
+      ASSERT_EQ(Comparable(expected[i], format.texformat),
+                Comparable(ToRGBA(dst.data(), i, native), format.texformat))
+          << "native texel " << i;
+    }
+  }
+
+  void CheckAll()
+  {
+    for (const Format& format : s_formats)
+    {
+      for (const auto& size : s_sizes)
+        Check(format, size[0], size[1]);
+    }
+  }
+
+  bool m_had_avx2 = false;
+};
+}
+
+TEST_F(TextureDecoderTest, MatchesDecodeTexel)
+{
+  cpu_info.bAVX2 = false;
+  CheckAll();
+}
+
+#ifdef _M_X86_64
+TEST_F(TextureDecoderTest, AVX2MatchesDecodeTexel)
+{
+  if (!m_had_avx2)
+    return;
+  cpu_info.bAVX2 = true;
+  CheckAll();
+}
+#endif
+
+// BC1 and DXT3 only reorder CMPR, so turning their color blocks back into CMPR has to give the
+// source again.
+TEST_F(TextureDecoderTest, CMPRPassesThroughAsBC1AndDXT3)
+{
+  for (HostTextureFormat format : {PC_TEX_FMT_DXT1, PC_TEX_FMT_DXT3})
+  {
+    for (const auto& size : s_sizes)
+    {
+      const u32 width = RoundUp(size[0], 8), height = RoundUp(size[1], 8);
+      SCOPED_TRACE(testing::Message() << format << " " << width << "x" << height);
+      std::mt19937 rng(width * 1000 + height);
+      std::vector<u8> src(TexDecoder::GetTextureSizeInBytes(width, height, GX_TF_CMPR));
+      for (u8& byte : src)
+        byte = static_cast<u8>(rng());
+
+      const u32 block_size = format == PC_TEX_FMT_DXT1 ? 8 : 16;
+      std::vector<u8> dst(width * height / 16 * block_size);
+      ASSERT_EQ(format, TexDecoder::Decode(dst.data(), src.data(), width, height, GX_TF_CMPR, 0,
+                                           GX_TL_IA8, false, format));
+      for (u32 y = 0; y < height; y += 4)
+      {
+        for (u32 x = 0; x < width; x += 4)
+        {
+          const u8* block = dst.data() + ((y / 4) * (width / 4) + x / 4) * block_size;
+          const u8* color = block + block_size - 8;
+          const u8* expected = src.data() + ((y / 8) * (width / 8) + x / 8) * 32 +
+                               ((y / 4) % 2 * 2 + (x / 4) % 2) * 8;
+          ASSERT_EQ(expected[0], color[1]);
+          ASSERT_EQ(expected[1], color[0]);
+          ASSERT_EQ(expected[2], color[3]);
+          ASSERT_EQ(expected[3], color[2]);
+          const bool three_colors =
+              (expected[0] << 8 | expected[1]) <= (expected[2] << 8 | expected[3]);
+          for (u32 row = 0; row < 4; row++)
+          {
+            for (u32 texel = 0; texel < 4; texel++)
+            {
+              const u32 index = (expected[4 + row] >> (6 - texel * 2)) & 3;
+              ASSERT_EQ(index, (color[4 + row] >> (texel * 2)) & 3u);
+              if (format == PC_TEX_FMT_DXT3)
+              {
+                const u32 i = row * 4 + texel;
+                const u32 alpha = (block[i / 2] >> (i % 2 * 4)) & 0xF;
+                ASSERT_EQ(three_colors && index == 3 ? 0u : 0xFu, alpha);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TextureDecoderTest, CMPRTransparentTexels)
+{
+  // Four colors, then three colors without and with the transparent index.
+  const u8 opaque[] = {0x80, 0x00, 0x10, 0x00, 0xFF, 0xFF, 0xFF, 0xFF};
+  const u8 three_colors[] = {0x10, 0x00, 0x80, 0x00, 0xAA, 0x55, 0x00, 0x66};
+  const u8 transparent[] = {0x10, 0x00, 0x80, 0x00, 0x00, 0x00, 0x0C, 0x00};
+  EXPECT_FALSE(TexDecoder::CMPRHasTransparentTexels(opaque, sizeof(opaque)));
+  EXPECT_FALSE(TexDecoder::CMPRHasTransparentTexels(three_colors, sizeof(three_colors)));
+  EXPECT_TRUE(TexDecoder::CMPRHasTransparentTexels(transparent, sizeof(transparent)));
+}
+
+// Prints how fast each format decodes, with and without AVX2. Run with
+// --gtest_also_run_disabled_tests.
+TEST_F(TextureDecoderTest, DISABLED_Throughput)
+{
+  const u32 width = 1024, height = 1024;
+  const int iterations = 20;
+  std::vector<u8> src(width * height * 4);
+  std::mt19937 rng(0x5eed);
+  for (u8& byte : src)
+    byte = static_cast<u8>(rng());
+  std::vector<u8> dst(width * height * 4);
+
+  for (const Format& format : s_formats)
+  {
+    for (bool rgba : {false, true})
+    {
+      for (bool avx2 : {false, true})
+      {
+        if (avx2 && !m_had_avx2)
+          continue;
+        cpu_info.bAVX2 = avx2;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+          TexDecoder::Decode(dst.data(), src.data(), width, height, format.texformat,
+                             TLUT_ADDRESS, format.tlutfmt, rgba);
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        std::printf("%-13s %-6s %-4s %8.1f Mtexels/s\n", format.name, rgba ? "RGBA" : "native",
+                    avx2 ? "AVX2" : "SSE2",
+                    double(width) * height * iterations / std::max<long long>(elapsed.count(), 1));
+      }
+    }
+  }
+}
@@ -0,0 +1,69 @@
+// Copyright 2017 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TmemMirror.h"
+
+namespace
+{
+std::vector<std::pair<u32, u32>> PopAll()
+{
+  std::vector<std::pair<u32, u32>> ranges;
+  u32 address, size;
+  while (TmemMirror::PopInvalidRange(&address, &size))
+    ranges.emplace_back(address, size);
+  return ranges;
+}
+
+using Ranges = std::vector<std::pair<u32, u32>>;
+}
+
+TEST(TmemMirror, StartsUpToDateAfterPopping)
+{
+  TmemMirror::InvalidateAll();
+  EXPECT_EQ(Ranges({{0u, u32(TMEM_SIZE)}}), PopAll());
+  EXPECT_EQ(Ranges(), PopAll());
+}
+
+TEST(TmemMirror, RoundsToWholeLines)
+{
+  PopAll();
+  TmemMirror::Invalidate(40, 1);
+  TmemMirror::Invalidate(60, 8);
+  EXPECT_EQ(Ranges({{32u, 64u}}), PopAll());
+}
+
+TEST(TmemMirror, SeparateRunsStaySeparate)
+{
+  PopAll();
+  TmemMirror::Invalidate(0x80000, 0x200);
+  TmemMirror::Invalidate(0x100, 0x20);
+  TmemMirror::Invalidate(0x120, 0x20);
+  EXPECT_EQ(Ranges({{0x100u, 0x40u}, {0x80000u, 0x200u}}), PopAll());
+}
+
+TEST(TmemMirror, ClampsToTmem)
+{
+  PopAll();
+  TmemMirror::Invalidate(TMEM_SIZE - 32, 0x1000);
+  TmemMirror::Invalidate(TMEM_SIZE, 32);
+  TmemMirror::Invalidate(0, 0);
+  EXPECT_EQ(Ranges({{u32(TMEM_SIZE - 32), 32u}}), PopAll());
+}
+
+TEST(TmemMirror, GetOffset)
+{
+  u32 offset = 0;
+  EXPECT_TRUE(TmemMirror::GetOffset(texMem + 0x1234, &offset));
+  EXPECT_EQ(0x1234u, offset);
+  EXPECT_FALSE(TmemMirror::GetOffset(texMem + TMEM_SIZE, &offset));
+  const u8 elsewhere = 0;
+  EXPECT_FALSE(TmemMirror::GetOffset(&elsewhere, &offset));
+}
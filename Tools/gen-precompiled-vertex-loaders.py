@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+
+"""
+gen-precompiled-vertex-loaders.py --output-dir <dir> <profile...>
+gen-precompiled-vertex-loaders.py --import <G_xxxxxx_pvt.cpp> --output-dir <dir>
+
+Generates the precompiled vertex loaders in VideoCommon from vertex loader
+usage profiles.
+
+A profile is written to User/Dump/VertexLoaders/<game id>.txt when
+"DumpVertexLoaderProfile" is enabled in the graphics settings. Every line
+describes one vertex format the game used:
+
+    <vid0> <vid1> <vid2> <vid3> <num_verts> <name>
+
+where vid0-3 are the words of the VertexLoaderUID in hex. For every profile
+this script writes G_<game id>_pvt.h/.cpp with a TemplatedLoader instance per
+format, plus PrecompiledVertexLoaders.cpp which registers all of them. Formats
+that are used less than --min-verts times are skipped; the JIT vertex loader
+handles those at runtime like any other format without a precompiled loader.
+
+--import turns one of the old hand-maintained G_*_pvt.cpp files back into a
+profile, so that existing games can be regenerated the same way.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HEADER = """// Copyright 2013 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+// Generated by Tools/gen-precompiled-vertex-loaders.py, do not edit.
+"""
+
+MASK64 = (1 << 64) - 1
+
+
+def loader_hash(vid):
+    '''Same as VertexLoaderUID::CalculateHash.'''
+    h = MASK64
+    for word in vid:
+        h = (h * 137 + word) & MASK64
+    return h
+
+
+def read_profile(path):
+    '''Returns a list of (vid, num_verts, name), merging duplicate formats.'''
+    formats = {}
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            fields = line.split()
+            if len(fields) < 5:
+                sys.exit('%s:%d: expected "<vid0> <vid1> <vid2> <vid3> <num_verts> [name]"' %
+                         (path, lineno))
+            vid = tuple(int(x, 16) for x in fields[:4])
+            num_verts = int(fields[4])
+            name = fields[5] if len(fields) > 5 else ''
+            old = formats.get(vid, (0, name))
+            formats[vid] = (old[0] + num_verts, name or old[1])
+    return sorted(((vid, n, name) for vid, (n, name) in formats.items()),
+                  key=lambda e: (-e[1], e[0]))
+
+
+def write_if_changed(path, text):
+    '''Leaves unchanged files alone so that the build doesn't recompile them.'''
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, 'w') as f:
+        f.write(text)
+
+
+def generate_game(output_dir, game_id, formats):
+    cls = 'G_%s_pvt' % game_id
+    header = HEADER + """#pragma once
+#include <map>
+#include "VideoCommon/NativeVertexFormat.h"
+class %s
+{
+public:
+  static void Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap);
+};
+""" % cls
+
+    body = [HEADER,
+            '#include "VideoCommon/%s.h"\n' % cls,
+            '#include "VideoCommon/VertexLoader_Template.h"\n',
+            '\n',
+            'void %s::Initialize(std::map<u64, TCompiledLoaderFunction> &pvlmap)\n' % cls,
+            '{\n']
+    for vid, num_verts, name in formats:
+        args = ', '.join('0x%08xu' % word for word in vid)
+        key = loader_hash(vid)
+        body.append('  // %s num_verts= %d\n' % (name, num_verts))
+        body.append('#if _M_SSE >= 0x301\n'
+                    '  if (cpu_info.bSSSE3)\n'
+                    '  {\n'
+                    '    pvlmap[%d] = TemplatedLoader<0x301, %s>;\n'
+                    '  }\n'
+                    '  else\n'
+                    '#endif\n'
+                    '  {\n'
+                    '    pvlmap[%d] = TemplatedLoader<0, %s>;\n'
+                    '  }\n' % (key, args, key, args))
+    body.append('}\n')
+
+    write_if_changed(os.path.join(output_dir, cls + '.h'), header)
+    write_if_changed(os.path.join(output_dir, cls + '.cpp'), ''.join(body))
+
+
+def generate_index(output_dir, game_ids):
+    text = [HEADER,
+            '\n',
+            '#include "VideoCommon/PrecompiledVertexLoaders.h"\n',
+            '\n']
+    text += ['#include "VideoCommon/G_%s_pvt.h"\n' % game_id for game_id in game_ids]
+    text.append('\n'
+                'void InitializePrecompiledVertexLoaders('
+                'std::map<u64, TCompiledLoaderFunction>& pvlmap)\n'
+                '{\n')
+    text += ['  G_%s_pvt::Initialize(pvlmap);\n' % game_id for game_id in game_ids]
+    text.append('}\n')
+    write_if_changed(os.path.join(output_dir, 'PrecompiledVertexLoaders.cpp'), ''.join(text))
+
+
+def import_pvt(path, output_dir):
+    '''Recovers a profile from a hand-maintained G_<game id>_pvt.cpp.'''
+    game_id = re.match(r'G_(\w+)_pvt\.cpp$', os.path.basename(path)).group(1)
+    name = ''
+    num_verts = 0
+    lines = []
+    with open(path) as f:
+        for line in f:
+            m = re.search(r'//\s*(P_\w*)', line)
+            if m:
+                name = m.group(1)
+            m = re.search(r'num_verts=\s*(\d+)', line)
+            if m:
+                num_verts = int(m.group(1))
+            m = re.search(r'TemplatedLoader<0,\s*(\w+),\s*(\w+),\s*(\w+),\s*(\w+)>', line)
+            if m:
+                vid = [int(x.rstrip('uU'), 16) for x in m.groups()]
+                lines.append('%08x %08x %08x %08x %d %s\n' % (tuple(vid) + (num_verts, name)))
+                name = ''
+                num_verts = 0
+
+    with open(os.path.join(output_dir, game_id + '.txt'), 'w') as f:
+        f.write('# Vertex loader profile for %s\n' % game_id)
+        f.writelines(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate precompiled vertex loaders.')
+    parser.add_argument('--output-dir', required=True)
+    parser.add_argument('--min-verts', type=int, default=0,
+                        help='skip formats that loaded fewer vertices than this')
+    parser.add_argument('--import', dest='import_files', action='store_true',
+                        help='convert G_*_pvt.cpp files into profiles instead')
+    parser.add_argument('files', nargs='+')
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.output_dir):
+        os.makedirs(args.output_dir)
+
+    if args.import_files:
+        for path in args.files:
+            import_pvt(path, args.output_dir)
+        return
+
+    game_ids = []
+    for path in sorted(args.files):
+        game_id = os.path.splitext(os.path.basename(path))[0]
+        if not re.match(r'^\w+$', game_id):
+            sys.exit('%s: the file name must be the game id' % path)
+        formats = [f for f in read_profile(path) if f[1] >= args.min_verts]
+        generate_game(args.output_dir, game_id, formats)
+        game_ids.append(game_id)
+    generate_index(args.output_dir, game_ids)
+
+
+if __name__ == '__main__':
+    main()